@@ -0,0 +1,52 @@
+# ~~~
+# Copyright 2021 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ~~~
+
+# Log lines below this severity are removed at compile-time, as if they were
+# wrapped in `#if 0`/`#endif`. FATAL log lines cannot be removed.
+set(GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY
+    ""
+    CACHE
+        STRING
+        "The minimum severity for GCP_LOG() lines compiled in (e.g. INFO).")
+set_property(
+    CACHE GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY
+    PROPERTY STRINGS
+             ""
+             "TRACE"
+             "DEBUG"
+             "INFO"
+             "NOTICE"
+             "WARNING"
+             "ERROR"
+             "CRITICAL"
+             "ALERT"
+             "FATAL")
+
+set(GOOGLE_CLOUD_CPP_LOGGING_DEFINITIONS "")
+if (NOT "${GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY}" STREQUAL "")
+    set(_valid TRACE DEBUG INFO NOTICE WARNING ERROR CRITICAL ALERT FATAL)
+    if (NOT "${GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY}" IN_LIST _valid)
+        message(
+            FATAL_ERROR
+                "Invalid value for GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY <"
+                "${GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY}>, expected one of"
+                " ${_valid}")
+    endif ()
+    unset(_valid)
+    set(GOOGLE_CLOUD_CPP_LOGGING_DEFINITIONS
+        "GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY_ENABLED=GCP_LS_${GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY}"
+    )
+endif ()
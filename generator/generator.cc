@@ -14,11 +14,13 @@
 
 #include "generator/generator.h"
 #include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/log.h"
 #include "google/cloud/status_or.h"
 #include "generator/internal/codegen_utils.h"
 #include "generator/internal/descriptor_utils.h"
 #include "generator/internal/generator_interface.h"
 #include <google/api/client.pb.h>
+#include <chrono>
 #include <future>
 #include <string>
 #include <vector>
@@ -49,6 +51,10 @@ bool Generator::Generate(google::protobuf::FileDescriptor const* file,
     return false;
   }
 
+  using Clock = std::chrono::steady_clock;
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  auto const start = Clock::now();
   std::vector<ServiceGenerator> services;
   services.reserve(file->service_count());
   for (int i = 0; i < file->service_count(); ++i) {
@@ -56,6 +62,8 @@ bool Generator::Generate(google::protobuf::FileDescriptor const* file,
         file->service(i), context, *command_line_args));
   }
 
+  auto const created = Clock::now();
+
   std::vector<std::future<Status>> tasks;
   for (auto const& code_generators : services) {
     for (auto const& c : code_generators) {
@@ -71,6 +79,13 @@ bool Generator::Generate(google::protobuf::FileDescriptor const* file,
       absl::StrAppend(&error_message, result.message(), "\n");
     }
   }
+  auto const generated = Clock::now();
+  GCP_LOG(INFO) << file->name() << ": created " << tasks.size()
+                << " generators in "
+                << duration_cast<milliseconds>(created - start).count()
+                << "ms, generated code in "
+                << duration_cast<milliseconds>(generated - created).count()
+                << "ms";
 
   if (!error_message.empty()) {
     *error = error_message;
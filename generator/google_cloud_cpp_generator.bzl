@@ -23,16 +23,19 @@ google_cloud_cpp_generator_hdrs = [
     "internal/codegen_utils.h",
     "internal/connection_generator.h",
     "internal/descriptor_utils.h",
+    "internal/fake_server_generator.h",
     "internal/generator_interface.h",
     "internal/idempotency_policy_generator.h",
     "internal/logging_decorator_generator.h",
     "internal/metadata_decorator_generator.h",
+    "internal/metrics_decorator_generator.h",
     "internal/mock_connection_generator.h",
     "internal/option_defaults_generator.h",
     "internal/options_generator.h",
     "internal/predicate_utils.h",
     "internal/printer.h",
     "internal/retry_policy_generator.h",
+    "internal/round_robin_decorator_generator.h",
     "internal/service_code_generator.h",
     "internal/stub_factory_generator.h",
     "internal/stub_generator.h",
@@ -45,14 +48,17 @@ google_cloud_cpp_generator_srcs = [
     "internal/codegen_utils.cc",
     "internal/connection_generator.cc",
     "internal/descriptor_utils.cc",
+    "internal/fake_server_generator.cc",
     "internal/idempotency_policy_generator.cc",
     "internal/logging_decorator_generator.cc",
     "internal/metadata_decorator_generator.cc",
+    "internal/metrics_decorator_generator.cc",
     "internal/mock_connection_generator.cc",
     "internal/option_defaults_generator.cc",
     "internal/options_generator.cc",
     "internal/predicate_utils.cc",
     "internal/retry_policy_generator.cc",
+    "internal/round_robin_decorator_generator.cc",
     "internal/service_code_generator.cc",
     "internal/stub_factory_generator.cc",
     "internal/stub_generator.cc",
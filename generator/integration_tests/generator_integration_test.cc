@@ -162,8 +162,12 @@ INSTANTIATE_TEST_SUITE_P(
         "internal/golden_thing_admin_logging_decorator.cc",
         "internal/golden_thing_admin_metadata_decorator.h",
         "internal/golden_thing_admin_metadata_decorator.cc",
+        "internal/golden_thing_admin_metrics_decorator.h",
+        "internal/golden_thing_admin_metrics_decorator.cc",
         "internal/golden_thing_admin_option_defaults.h",
         "internal/golden_thing_admin_option_defaults.cc",
+        "internal/golden_thing_admin_round_robin_decorator.h",
+        "internal/golden_thing_admin_round_robin_decorator.cc",
         "internal/golden_thing_admin_stub_factory.h",
         "internal/golden_thing_admin_stub_factory.cc",
         "internal/golden_thing_admin_stub.h",
@@ -178,12 +182,17 @@ INSTANTIATE_TEST_SUITE_P(
         "internal/golden_kitchen_sink_logging_decorator.cc",
         "internal/golden_kitchen_sink_metadata_decorator.h",
         "internal/golden_kitchen_sink_metadata_decorator.cc",
+        "internal/golden_kitchen_sink_metrics_decorator.h",
+        "internal/golden_kitchen_sink_metrics_decorator.cc",
         "internal/golden_kitchen_sink_option_defaults.h",
         "internal/golden_kitchen_sink_option_defaults.cc",
+        "internal/golden_kitchen_sink_round_robin_decorator.h",
+        "internal/golden_kitchen_sink_round_robin_decorator.cc",
         "internal/golden_kitchen_sink_stub_factory.h",
         "internal/golden_kitchen_sink_stub_factory.cc",
         "internal/golden_kitchen_sink_stub.h",
         "internal/golden_kitchen_sink_stub.cc",
+        "mocks/fake_golden_kitchen_sink_server.h",
         "mocks/mock_golden_kitchen_sink_connection.h"),
     [](testing::TestParamInfo<GeneratorIntegrationTest::ParamType> const&
            info) {
@@ -102,6 +102,17 @@ GoldenKitchenSinkClient::TailLogEntries(google::test::admin::database::v1::TailL
   return connection_->TailLogEntries(request);
 }
 
+StreamRange<std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>
+GoldenKitchenSinkClient::TailLogEntriesInArena(google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  return connection_->TailLogEntriesInArena(request);
+}
+
+future<Status>
+GoldenKitchenSinkClient::AsyncTailLogEntries(google::test::admin::database::v1::TailLogEntriesRequest const& request,
+    std::function<future<bool>(google::test::admin::database::v1::TailLogEntriesResponse)> on_read) {
+  return connection_->AsyncTailLogEntries(request, std::move(on_read));
+}
+
 StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
 GoldenKitchenSinkClient::ListServiceAccountKeys(google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) {
   return connection_->ListServiceAccountKeys(request);
@@ -22,11 +22,16 @@
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_stub_factory.h"
 #include "google/cloud/background_threads.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/async_resumable_streaming_read.h"
+#include "google/cloud/internal/grpc_compression.h"
+#include "google/cloud/internal/hedged_call.h"
 #include "google/cloud/internal/pagination_range.h"
 #include "google/cloud/internal/resumable_streaming_read_rpc.h"
 #include "google/cloud/internal/retry_loop.h"
 #include "google/cloud/internal/streaming_read_rpc_logging.h"
+#include <map>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -76,6 +81,34 @@ StreamRange<google::test::admin::database::v1::TailLogEntriesResponse> GoldenKit
       );
 }
 
+StreamRange<std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>
+GoldenKitchenSinkConnection::TailLogEntriesInArena(
+    google::test::admin::database::v1::TailLogEntriesRequest const&) {
+  return google::cloud::internal::MakeStreamRange<
+      std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>(
+      []() -> absl::variant<Status,
+      std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>{
+        return Status(StatusCode::kUnimplemented, "not implemented");}
+      );
+}
+
+future<Status> GoldenKitchenSinkConnection::AsyncTailLogEntries(
+    google::test::admin::database::v1::TailLogEntriesRequest const&,
+    std::function<future<bool>(google::test::admin::database::v1::TailLogEntriesResponse)>) {
+  return google::cloud::make_ready_future(
+    Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::test::admin::database::v1::StreamingReadWriteRequest,
+    google::test::admin::database::v1::StreamingReadWriteResponse>>
+GoldenKitchenSinkConnection::AsyncStreamingReadWrite() {
+  return absl::make_unique<internal::AsyncStreamingReadWriteRpcError<
+      google::test::admin::database::v1::StreamingReadWriteRequest,
+      google::test::admin::database::v1::StreamingReadWriteResponse>>(
+      Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
 StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
 GoldenKitchenSinkConnection::ListServiceAccountKeys(
     google::test::admin::database::v1::ListServiceAccountKeysRequest const&) {
@@ -92,6 +125,10 @@ class GoldenKitchenSinkConnectionImpl : public GoldenKitchenSinkConnection {
       : background_(std::move(background)), stub_(std::move(stub)),
         retry_policy_prototype_(options.get<GoldenKitchenSinkRetryPolicyOption>()->clone()),
         backoff_policy_prototype_(options.get<GoldenKitchenSinkBackoffPolicyOption>()->clone()),
+        page_prefetch_depth_(options.get<GrpcPaginationPrefetchDepthOption>()),
+        attempt_timeout_(options.get<GrpcAttemptTimeoutOption>()),
+        hedging_delays_(options.get<GrpcHedgingDelayOption>()),
+        compression_(options.get<GrpcCompressionOption>()),
         idempotency_policy_(options.get<GoldenKitchenSinkConnectionIdempotencyPolicyOption>()->clone()) {}
 
   ~GoldenKitchenSinkConnectionImpl() override = default;
@@ -99,40 +136,67 @@ class GoldenKitchenSinkConnectionImpl : public GoldenKitchenSinkConnection {
   StatusOr<google::test::admin::database::v1::GenerateAccessTokenResponse>
   GenerateAccessToken(
       google::test::admin::database::v1::GenerateAccessTokenRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GenerateAccessToken(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GenerateAccessToken(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::GenerateAccessTokenRequest const& request) {
-          return stub_->GenerateAccessToken(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenKitchenSink.GenerateAccessToken",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::GenerateAccessTokenRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenKitchenSink.GenerateAccessToken",
+                  request);
+              return stub_->GenerateAccessToken(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StatusOr<google::test::admin::database::v1::GenerateIdTokenResponse>
   GenerateIdToken(
       google::test::admin::database::v1::GenerateIdTokenRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GenerateIdToken(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GenerateIdToken(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::GenerateIdTokenRequest const& request) {
-          return stub_->GenerateIdToken(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenKitchenSink.GenerateIdToken",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::GenerateIdTokenRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenKitchenSink.GenerateIdToken",
+                  request);
+              return stub_->GenerateIdToken(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StatusOr<google::test::admin::database::v1::WriteLogEntriesResponse>
   WriteLogEntries(
       google::test::admin::database::v1::WriteLogEntriesRequest const& request) override {
+    auto const idempotency = idempotency_policy_->WriteLogEntries(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->WriteLogEntries(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::WriteLogEntriesRequest const& request) {
-          return stub_->WriteLogEntries(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenKitchenSink.WriteLogEntries",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::WriteLogEntriesRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenKitchenSink.WriteLogEntries",
+                  request);
+              return stub_->WriteLogEntries(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StreamRange<std::string> ListLogs(
@@ -144,26 +208,30 @@ class GoldenKitchenSinkConnectionImpl : public GoldenKitchenSinkConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListLogs(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<StreamRange<
         std::string>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name]
           (google::test::admin::database::v1::ListLogsRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::test::admin::database::v1::ListLogsRequest const& request) {
                 return stub->ListLogs(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::test::admin::database::v1::ListLogsResponse r) {
           std::vector<std::string> result(r.log_names().size());
           auto& messages = *r.mutable_log_names();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StreamRange<google::test::admin::database::v1::TailLogEntriesResponse> TailLogEntries(
@@ -195,17 +263,84 @@ class GoldenKitchenSinkConnectionImpl : public GoldenKitchenSinkConnection {
         [resumable]{return resumable->Read();}));
   }
 
+  StreamRange<std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>
+  TailLogEntriesInArena(
+      google::test::admin::database::v1::TailLogEntriesRequest const& request) override {
+    auto stub = stub_;
+    auto retry_policy =
+        std::shared_ptr<GoldenKitchenSinkRetryPolicy const>(
+            retry_policy_prototype_->clone());
+    auto backoff_policy = std::shared_ptr<BackoffPolicy const>(
+        backoff_policy_prototype_->clone());
+
+    auto factory = [stub](
+        google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+      return stub->TailLogEntries(absl::make_unique<grpc::ClientContext>(),
+          request);
+    };
+
+    auto resumable =
+        internal::MakeResumableStreamingReadRpc<
+            google::test::admin::database::v1::TailLogEntriesResponse,
+            google::test::admin::database::v1::TailLogEntriesRequest>(
+                retry_policy->clone(), backoff_policy->clone(),
+                [](std::chrono::milliseconds) {}, factory,
+                GoldenKitchenSinkTailLogEntriesStreamingUpdater,
+                request);
+
+    return internal::MakeStreamRange(internal::StreamReader<
+        std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>(
+        [resumable]{return resumable->ReadInArena();}));
+  }
+
+  future<Status> AsyncTailLogEntries(
+      google::test::admin::database::v1::TailLogEntriesRequest const& request,
+      std::function<future<bool>(google::test::admin::database::v1::TailLogEntriesResponse)> on_read) override {
+    auto stub = stub_;
+    return internal::AsyncResumableStreamingRead<
+        google::test::admin::database::v1::TailLogEntriesResponse,
+        google::test::admin::database::v1::TailLogEntriesRequest,
+        GoldenKitchenSinkRetryPolicy, BackoffPolicy>(
+            background_->cq(), retry_policy_prototype_->clone(),
+            backoff_policy_prototype_->clone(),
+            [stub](google::cloud::CompletionQueue& cq,
+                   google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+              return stub->AsyncTailLogEntries(
+                  cq, absl::make_unique<grpc::ClientContext>(), request);
+            },
+            GoldenKitchenSinkTailLogEntriesStreamingUpdater,
+            request, std::move(on_read));
+  }
+
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::test::admin::database::v1::StreamingReadWriteRequest,
+      google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite() override {
+    auto cq = background_->cq();
+    return stub_->AsyncStreamingReadWrite(
+        cq, absl::make_unique<grpc::ClientContext>());
+  }
+
   StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
   ListServiceAccountKeys(
       google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) override {
+    auto const idempotency = idempotency_policy_->ListServiceAccountKeys(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->ListServiceAccountKeys(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) {
-          return stub_->ListServiceAccountKeys(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenKitchenSink.ListServiceAccountKeys",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenKitchenSink.ListServiceAccountKeys",
+                  request);
+              return stub_->ListServiceAccountKeys(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
  private:
@@ -213,6 +348,10 @@ class GoldenKitchenSinkConnectionImpl : public GoldenKitchenSinkConnection {
   std::shared_ptr<golden_internal::GoldenKitchenSinkStub> stub_;
   std::unique_ptr<GoldenKitchenSinkRetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
+  std::size_t page_prefetch_depth_;
+  std::chrono::milliseconds attempt_timeout_;
+  std::map<std::string, std::chrono::milliseconds> hedging_delays_;
+  std::map<std::string, std::size_t> compression_;
   std::unique_ptr<GoldenKitchenSinkConnectionIdempotencyPolicy> idempotency_policy_;
 };
 }  // namespace
@@ -22,10 +22,12 @@
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_stub.h"
 #include "generator/integration_tests/golden/retry_traits.h"
 #include "google/cloud/backoff_policy.h"
+#include "google/cloud/future.h"
 #include "google/cloud/options.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/stream_range.h"
 #include "google/cloud/version.h"
+#include <functional>
 #include <memory>
 
 namespace google {
@@ -66,6 +68,18 @@ class GoldenKitchenSinkConnection {
   virtual StreamRange<google::test::admin::database::v1::TailLogEntriesResponse>
   TailLogEntries(google::test::admin::database::v1::TailLogEntriesRequest const& request);
 
+  virtual StreamRange<std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>
+  TailLogEntriesInArena(google::test::admin::database::v1::TailLogEntriesRequest const& request);
+
+  virtual future<Status>
+  AsyncTailLogEntries(google::test::admin::database::v1::TailLogEntriesRequest const& request,
+      std::function<future<bool>(google::test::admin::database::v1::TailLogEntriesResponse)> on_read);
+
+  virtual std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::test::admin::database::v1::StreamingReadWriteRequest,
+      google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite();
+
   virtual StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
   ListServiceAccountKeys(google::test::admin::database::v1::ListServiceAccountKeysRequest const& request);
 
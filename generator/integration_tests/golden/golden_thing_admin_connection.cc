@@ -23,9 +23,13 @@
 #include "google/cloud/background_threads.h"
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/async_long_running_operation.h"
+#include "google/cloud/internal/grpc_compression.h"
+#include "google/cloud/internal/hedged_call.h"
 #include "google/cloud/internal/pagination_range.h"
 #include "google/cloud/internal/retry_loop.h"
+#include <map>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -183,6 +187,10 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
         retry_policy_prototype_(options.get<GoldenThingAdminRetryPolicyOption>()->clone()),
         backoff_policy_prototype_(options.get<GoldenThingAdminBackoffPolicyOption>()->clone()),
         polling_policy_prototype_(options.get<GoldenThingAdminPollingPolicyOption>()->clone()),
+        page_prefetch_depth_(options.get<GrpcPaginationPrefetchDepthOption>()),
+        attempt_timeout_(options.get<GrpcAttemptTimeoutOption>()),
+        hedging_delays_(options.get<GrpcHedgingDelayOption>()),
+        compression_(options.get<GrpcCompressionOption>()),
         idempotency_policy_(options.get<GoldenThingAdminConnectionIdempotencyPolicyOption>()->clone()) {}
 
   ~GoldenThingAdminConnectionImpl() override = default;
@@ -196,26 +204,30 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListDatabases(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<StreamRange<
         google::test::admin::database::v1::Database>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name]
           (google::test::admin::database::v1::ListDatabasesRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::test::admin::database::v1::ListDatabasesRequest const& request) {
                 return stub->ListDatabases(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::test::admin::database::v1::ListDatabasesResponse r) {
           std::vector<google::test::admin::database::v1::Database> result(r.databases().size());
           auto& messages = *r.mutable_databases();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   future<StatusOr<google::test::admin::database::v1::Database>>
@@ -247,14 +259,23 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
   StatusOr<google::test::admin::database::v1::Database>
   GetDatabase(
       google::test::admin::database::v1::GetDatabaseRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GetDatabase(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetDatabase(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::GetDatabaseRequest const& request) {
-          return stub_->GetDatabase(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.GetDatabase",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::GetDatabaseRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.GetDatabase",
+                  request);
+              return stub_->GetDatabase(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   future<StatusOr<google::test::admin::database::v1::UpdateDatabaseDdlMetadata>>
@@ -286,66 +307,111 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
   Status
   DropDatabase(
       google::test::admin::database::v1::DropDatabaseRequest const& request) override {
+    auto const idempotency = idempotency_policy_->DropDatabase(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->DropDatabase(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::DropDatabaseRequest const& request) {
-          return stub_->DropDatabase(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.DropDatabase",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::DropDatabaseRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.DropDatabase",
+                  request);
+              return stub_->DropDatabase(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StatusOr<google::test::admin::database::v1::GetDatabaseDdlResponse>
   GetDatabaseDdl(
       google::test::admin::database::v1::GetDatabaseDdlRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GetDatabaseDdl(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetDatabaseDdl(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::GetDatabaseDdlRequest const& request) {
-          return stub_->GetDatabaseDdl(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.GetDatabaseDdl",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::GetDatabaseDdlRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.GetDatabaseDdl",
+                  request);
+              return stub_->GetDatabaseDdl(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StatusOr<google::iam::v1::Policy>
   SetIamPolicy(
       google::iam::v1::SetIamPolicyRequest const& request) override {
+    auto const idempotency = idempotency_policy_->SetIamPolicy(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->SetIamPolicy(request),
-        [this](grpc::ClientContext& context,
-            google::iam::v1::SetIamPolicyRequest const& request) {
-          return stub_->SetIamPolicy(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.SetIamPolicy",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::iam::v1::SetIamPolicyRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.SetIamPolicy",
+                  request);
+              return stub_->SetIamPolicy(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StatusOr<google::iam::v1::Policy>
   GetIamPolicy(
       google::iam::v1::GetIamPolicyRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GetIamPolicy(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetIamPolicy(request),
-        [this](grpc::ClientContext& context,
-            google::iam::v1::GetIamPolicyRequest const& request) {
-          return stub_->GetIamPolicy(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.GetIamPolicy",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::iam::v1::GetIamPolicyRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.GetIamPolicy",
+                  request);
+              return stub_->GetIamPolicy(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StatusOr<google::iam::v1::TestIamPermissionsResponse>
   TestIamPermissions(
       google::iam::v1::TestIamPermissionsRequest const& request) override {
+    auto const idempotency = idempotency_policy_->TestIamPermissions(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->TestIamPermissions(request),
-        [this](grpc::ClientContext& context,
-            google::iam::v1::TestIamPermissionsRequest const& request) {
-          return stub_->TestIamPermissions(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.TestIamPermissions",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::iam::v1::TestIamPermissionsRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.TestIamPermissions",
+                  request);
+              return stub_->TestIamPermissions(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   future<StatusOr<google::test::admin::database::v1::Backup>>
@@ -377,40 +443,67 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
   StatusOr<google::test::admin::database::v1::Backup>
   GetBackup(
       google::test::admin::database::v1::GetBackupRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GetBackup(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetBackup(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::GetBackupRequest const& request) {
-          return stub_->GetBackup(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.GetBackup",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::GetBackupRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.GetBackup",
+                  request);
+              return stub_->GetBackup(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StatusOr<google::test::admin::database::v1::Backup>
   UpdateBackup(
       google::test::admin::database::v1::UpdateBackupRequest const& request) override {
+    auto const idempotency = idempotency_policy_->UpdateBackup(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->UpdateBackup(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::UpdateBackupRequest const& request) {
-          return stub_->UpdateBackup(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.UpdateBackup",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::UpdateBackupRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.UpdateBackup",
+                  request);
+              return stub_->UpdateBackup(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   Status
   DeleteBackup(
       google::test::admin::database::v1::DeleteBackupRequest const& request) override {
+    auto const idempotency = idempotency_policy_->DeleteBackup(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->DeleteBackup(request),
-        [this](grpc::ClientContext& context,
-            google::test::admin::database::v1::DeleteBackupRequest const& request) {
-          return stub_->DeleteBackup(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "GoldenThingAdmin.DeleteBackup",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                google::test::admin::database::v1::DeleteBackupRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "GoldenThingAdmin.DeleteBackup",
+                  request);
+              return stub_->DeleteBackup(context, request);
+            }),
+        request, __func__, attempt_timeout_);
 }
 
   StreamRange<google::test::admin::database::v1::Backup> ListBackups(
@@ -422,26 +515,30 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListBackups(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<StreamRange<
         google::test::admin::database::v1::Backup>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name]
           (google::test::admin::database::v1::ListBackupsRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::test::admin::database::v1::ListBackupsRequest const& request) {
                 return stub->ListBackups(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::test::admin::database::v1::ListBackupsResponse r) {
           std::vector<google::test::admin::database::v1::Backup> result(r.backups().size());
           auto& messages = *r.mutable_backups();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   future<StatusOr<google::test::admin::database::v1::Database>>
@@ -479,26 +576,30 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListDatabaseOperations(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<StreamRange<
         google::longrunning::Operation>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name]
           (google::test::admin::database::v1::ListDatabaseOperationsRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::test::admin::database::v1::ListDatabaseOperationsRequest const& request) {
                 return stub->ListDatabaseOperations(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::test::admin::database::v1::ListDatabaseOperationsResponse r) {
           std::vector<google::longrunning::Operation> result(r.operations().size());
           auto& messages = *r.mutable_operations();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StreamRange<google::longrunning::Operation> ListBackupOperations(
@@ -510,26 +611,30 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListBackupOperations(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<StreamRange<
         google::longrunning::Operation>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name]
           (google::test::admin::database::v1::ListBackupOperationsRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::test::admin::database::v1::ListBackupOperationsRequest const& request) {
                 return stub->ListBackupOperations(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::test::admin::database::v1::ListBackupOperationsResponse r) {
           std::vector<google::longrunning::Operation> result(r.operations().size());
           auto& messages = *r.mutable_operations();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
  private:
@@ -538,6 +643,10 @@ class GoldenThingAdminConnectionImpl : public GoldenThingAdminConnection {
   std::unique_ptr<GoldenThingAdminRetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::unique_ptr<PollingPolicy const> polling_policy_prototype_;
+  std::size_t page_prefetch_depth_;
+  std::chrono::milliseconds attempt_timeout_;
+  std::map<std::string, std::chrono::milliseconds> hedging_delays_;
+  std::map<std::string, std::size_t> compression_;
   std::unique_ptr<GoldenThingAdminConnectionIdempotencyPolicy> idempotency_policy_;
 };
 }  // namespace
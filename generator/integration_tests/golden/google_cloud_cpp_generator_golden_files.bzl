@@ -35,8 +35,12 @@ google_cloud_cpp_generator_golden_files = [
     "internal/golden_kitchen_sink_logging_decorator.h",
     "internal/golden_kitchen_sink_metadata_decorator.cc",
     "internal/golden_kitchen_sink_metadata_decorator.h",
+    "internal/golden_kitchen_sink_metrics_decorator.cc",
+    "internal/golden_kitchen_sink_metrics_decorator.h",
     "internal/golden_kitchen_sink_option_defaults.cc",
     "internal/golden_kitchen_sink_option_defaults.h",
+    "internal/golden_kitchen_sink_round_robin_decorator.cc",
+    "internal/golden_kitchen_sink_round_robin_decorator.h",
     "internal/golden_kitchen_sink_stub.cc",
     "internal/golden_kitchen_sink_stub.h",
     "internal/golden_kitchen_sink_stub_factory.cc",
@@ -45,12 +49,18 @@ google_cloud_cpp_generator_golden_files = [
     "internal/golden_thing_admin_logging_decorator.h",
     "internal/golden_thing_admin_metadata_decorator.cc",
     "internal/golden_thing_admin_metadata_decorator.h",
+    "internal/golden_thing_admin_metrics_decorator.cc",
+    "internal/golden_thing_admin_metrics_decorator.h",
     "internal/golden_thing_admin_option_defaults.cc",
     "internal/golden_thing_admin_option_defaults.h",
+    "internal/golden_thing_admin_round_robin_decorator.cc",
+    "internal/golden_thing_admin_round_robin_decorator.h",
     "internal/golden_thing_admin_stub.cc",
     "internal/golden_thing_admin_stub.h",
     "internal/golden_thing_admin_stub_factory.cc",
     "internal/golden_thing_admin_stub_factory.h",
+    "mocks/fake_golden_kitchen_sink_server.h",
+    "mocks/fake_golden_thing_admin_server.h",
     "mocks/mock_golden_kitchen_sink_connection.h",
     "mocks/mock_golden_thing_admin_connection.h",
     "retry_traits.h",
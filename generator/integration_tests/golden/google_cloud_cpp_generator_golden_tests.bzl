@@ -20,10 +20,13 @@ google_cloud_cpp_generator_golden_tests = [
     "tests/golden_kitchen_sink_auth_decorator_test.cc",
     "tests/golden_kitchen_sink_client_test.cc",
     "tests/golden_kitchen_sink_connection_test.cc",
+    "tests/golden_kitchen_sink_fake_server_test.cc",
     "tests/golden_kitchen_sink_idempotency_policy_test.cc",
     "tests/golden_kitchen_sink_logging_decorator_test.cc",
     "tests/golden_kitchen_sink_metadata_decorator_test.cc",
+    "tests/golden_kitchen_sink_metrics_decorator_test.cc",
     "tests/golden_kitchen_sink_option_defaults_test.cc",
+    "tests/golden_kitchen_sink_round_robin_decorator_test.cc",
     "tests/golden_kitchen_sink_stub_factory_test.cc",
     "tests/golden_kitchen_sink_stub_test.cc",
     "tests/golden_thing_admin_auth_decorator_test.cc",
@@ -32,7 +35,9 @@ google_cloud_cpp_generator_golden_tests = [
     "tests/golden_thing_admin_idempotency_policy_test.cc",
     "tests/golden_thing_admin_logging_decorator_test.cc",
     "tests/golden_thing_admin_metadata_decorator_test.cc",
+    "tests/golden_thing_admin_metrics_decorator_test.cc",
     "tests/golden_thing_admin_option_defaults_test.cc",
+    "tests/golden_thing_admin_round_robin_decorator_test.cc",
     "tests/golden_thing_admin_stub_factory_test.cc",
     "tests/golden_thing_admin_stub_test.cc",
 ]
@@ -75,6 +75,32 @@ GoldenKitchenSinkAuth::TailLogEntries(
   return child_->TailLogEntries(std::move(context), request);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+GoldenKitchenSinkAuth::AsyncTailLogEntries(
+   google::cloud::CompletionQueue& cq,
+   std::unique_ptr<grpc::ClientContext> context,
+   google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadRpcError<
+      google::test::admin::database::v1::TailLogEntriesResponse>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
+  return child_->AsyncTailLogEntries(cq, std::move(context), request);
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::test::admin::database::v1::StreamingReadWriteRequest,
+    google::test::admin::database::v1::StreamingReadWriteResponse>>
+GoldenKitchenSinkAuth::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadWriteRpcError<
+      google::test::admin::database::v1::StreamingReadWriteRequest,
+      google::test::admin::database::v1::StreamingReadWriteResponse>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
+  return child_->AsyncStreamingReadWrite(cq, std::move(context));
+}
+
 StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse> GoldenKitchenSinkAuth::ListServiceAccountKeys(
     grpc::ClientContext& context,
     google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) {
@@ -61,6 +61,19 @@ class GoldenKitchenSinkAuth : public GoldenKitchenSinkStub {
       std::unique_ptr<grpc::ClientContext> context,
       google::test::admin::database::v1::TailLogEntriesRequest const& request) override;
 
+  std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+  AsyncTailLogEntries(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::test::admin::database::v1::TailLogEntriesRequest const& request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::test::admin::database::v1::StreamingReadWriteRequest,
+      google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context) override;
+
   StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse> ListServiceAccountKeys(
       grpc::ClientContext& context,
       google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) override;
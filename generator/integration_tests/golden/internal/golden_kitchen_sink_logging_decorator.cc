@@ -103,6 +103,34 @@ GoldenKitchenSinkLogging::TailLogEntries(
       std::move(context), request, __func__, tracing_options_);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+GoldenKitchenSinkLogging::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+        return child_->AsyncTailLogEntries(
+            cq, std::move(context), request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::test::admin::database::v1::StreamingReadWriteRequest,
+    google::test::admin::database::v1::StreamingReadWriteResponse>>
+GoldenKitchenSinkLogging::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  GCP_LOG(DEBUG) << __func__ << "() << (void)";
+  auto stream = child_->AsyncStreamingReadWrite(cq, std::move(context));
+  GCP_LOG(DEBUG) << __func__ << "() >> "
+                 << (stream ? "not null" : "null");
+  return stream;
+}
+
 StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
 GoldenKitchenSinkLogging::ListServiceAccountKeys(
     grpc::ClientContext& context,
@@ -17,6 +17,7 @@
 // source: generator/integration_tests/test.proto
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_metadata_decorator.h"
 #include "google/cloud/internal/api_client_header.h"
+#include "google/cloud/internal/grpc_trace_context.h"
 #include "google/cloud/status_or.h"
 #include <generator/integration_tests/test.grpc.pb.h>
 #include <memory>
@@ -43,7 +44,7 @@ StatusOr<google::test::admin::database::v1::GenerateIdTokenResponse>
 GoldenKitchenSinkMetadata::GenerateIdToken(
     grpc::ClientContext& context,
     google::test::admin::database::v1::GenerateIdTokenRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->GenerateIdToken(context, request);
 }
 
@@ -51,7 +52,7 @@ StatusOr<google::test::admin::database::v1::WriteLogEntriesResponse>
 GoldenKitchenSinkMetadata::WriteLogEntries(
     grpc::ClientContext& context,
     google::test::admin::database::v1::WriteLogEntriesRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->WriteLogEntries(context, request);
 }
 
@@ -67,10 +68,32 @@ std::unique_ptr<internal::StreamingReadRpc<google::test::admin::database::v1::Ta
 GoldenKitchenSinkMetadata::TailLogEntries(
     std::unique_ptr<grpc::ClientContext> context,
     google::test::admin::database::v1::TailLogEntriesRequest const& request) {
-  SetMetadata(*context, {});
+  SetMetadata(*context);
+  internal::InjectTraceContext(*context);
   return child_->TailLogEntries(std::move(context), request);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+GoldenKitchenSinkMetadata::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  SetMetadata(*context);
+  internal::InjectTraceContext(*context);
+  return child_->AsyncTailLogEntries(cq, std::move(context), request);
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::test::admin::database::v1::StreamingReadWriteRequest,
+    google::test::admin::database::v1::StreamingReadWriteResponse>>
+GoldenKitchenSinkMetadata::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  SetMetadata(*context);
+  internal::InjectTraceContext(*context);
+  return child_->AsyncStreamingReadWrite(cq, std::move(context));
+}
+
 StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
 GoldenKitchenSinkMetadata::ListServiceAccountKeys(
     grpc::ClientContext& context,
@@ -81,8 +104,14 @@ GoldenKitchenSinkMetadata::ListServiceAccountKeys(
 
 void GoldenKitchenSinkMetadata::SetMetadata(grpc::ClientContext& context,
                                         std::string const& request_params) {
-  context.AddMetadata("x-goog-request-params", request_params);
-  context.AddMetadata("x-goog-api-client", api_client_header_);
+  context.AddMetadata(google::cloud::internal::RequestParamsKey(),
+                      request_params);
+  SetMetadata(context);
+}
+
+void GoldenKitchenSinkMetadata::SetMetadata(grpc::ClientContext& context) {
+  context.AddMetadata(google::cloud::internal::ApiClientHeaderKey(),
+                      api_client_header_);
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
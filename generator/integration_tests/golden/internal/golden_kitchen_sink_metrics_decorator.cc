@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: generator/integration_tests/test.proto
+#include "generator/integration_tests/golden/internal/golden_kitchen_sink_metrics_decorator.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+#include "google/cloud/status_or.h"
+#include <generator/integration_tests/test.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+GoldenKitchenSinkMetrics::GoldenKitchenSinkMetrics(
+    std::shared_ptr<GoldenKitchenSinkStub> child,
+    std::shared_ptr<RpcMetrics> metrics)
+    : child_(std::move(child)), metrics_(std::move(metrics)) {}
+
+StatusOr<google::test::admin::database::v1::GenerateAccessTokenResponse>
+GoldenKitchenSinkMetrics::GenerateAccessToken(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GenerateAccessTokenRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::test::admin::database::v1::GenerateAccessTokenRequest const& request) {
+        return child_->GenerateAccessToken(context, request);
+      },
+      context, request,
+      metrics_->Method("GoldenKitchenSink.GenerateAccessToken"));
+}
+
+StatusOr<google::test::admin::database::v1::GenerateIdTokenResponse>
+GoldenKitchenSinkMetrics::GenerateIdToken(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GenerateIdTokenRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::test::admin::database::v1::GenerateIdTokenRequest const& request) {
+        return child_->GenerateIdToken(context, request);
+      },
+      context, request,
+      metrics_->Method("GoldenKitchenSink.GenerateIdToken"));
+}
+
+StatusOr<google::test::admin::database::v1::WriteLogEntriesResponse>
+GoldenKitchenSinkMetrics::WriteLogEntries(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::WriteLogEntriesRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::test::admin::database::v1::WriteLogEntriesRequest const& request) {
+        return child_->WriteLogEntries(context, request);
+      },
+      context, request,
+      metrics_->Method("GoldenKitchenSink.WriteLogEntries"));
+}
+
+StatusOr<google::test::admin::database::v1::ListLogsResponse>
+GoldenKitchenSinkMetrics::ListLogs(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListLogsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::test::admin::database::v1::ListLogsRequest const& request) {
+        return child_->ListLogs(context, request);
+      },
+      context, request,
+      metrics_->Method("GoldenKitchenSink.ListLogs"));
+}
+
+std::unique_ptr<internal::StreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+GoldenKitchenSinkMetrics::TailLogEntries(
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](std::unique_ptr<grpc::ClientContext> context,
+             google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+        return child_->TailLogEntries(std::move(context), request);
+      },
+      std::move(context), request,
+      metrics_->Method("GoldenKitchenSink.TailLogEntries"));
+}
+
+std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+GoldenKitchenSinkMetrics::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+        return child_->AsyncTailLogEntries(
+            cq, std::move(context), request);
+      },
+      cq, std::move(context), request,
+      metrics_->Method("GoldenKitchenSink.TailLogEntries"));
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::test::admin::database::v1::StreamingReadWriteRequest,
+    google::test::admin::database::v1::StreamingReadWriteResponse>>
+GoldenKitchenSinkMetrics::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context) {
+        return child_->AsyncStreamingReadWrite(cq, std::move(context));
+      },
+      cq, std::move(context),
+      metrics_->Method("GoldenKitchenSink.StreamingReadWrite"));
+}
+
+StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
+GoldenKitchenSinkMetrics::ListServiceAccountKeys(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) {
+        return child_->ListServiceAccountKeys(context, request);
+      },
+      context, request,
+      metrics_->Method("GoldenKitchenSink.ListServiceAccountKeys"));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
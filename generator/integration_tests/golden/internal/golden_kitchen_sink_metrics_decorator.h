@@ -0,0 +1,85 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: generator/integration_tests/test.proto
+#ifndef GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_INTERNAL_GOLDEN_KITCHEN_SINK_METRICS_DECORATOR_H
+#define GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_INTERNAL_GOLDEN_KITCHEN_SINK_METRICS_DECORATOR_H
+
+#include "generator/integration_tests/golden/internal/golden_kitchen_sink_stub.h"
+#include "google/cloud/rpc_metrics.h"
+#include "google/cloud/version.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+class GoldenKitchenSinkMetrics : public GoldenKitchenSinkStub {
+ public:
+  ~GoldenKitchenSinkMetrics() override = default;
+  GoldenKitchenSinkMetrics(std::shared_ptr<GoldenKitchenSinkStub> child,
+                       std::shared_ptr<RpcMetrics> metrics);
+
+  StatusOr<google::test::admin::database::v1::GenerateAccessTokenResponse> GenerateAccessToken(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GenerateAccessTokenRequest const& request) override;
+
+  StatusOr<google::test::admin::database::v1::GenerateIdTokenResponse> GenerateIdToken(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GenerateIdTokenRequest const& request) override;
+
+  StatusOr<google::test::admin::database::v1::WriteLogEntriesResponse> WriteLogEntries(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::WriteLogEntriesRequest const& request) override;
+
+  StatusOr<google::test::admin::database::v1::ListLogsResponse> ListLogs(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListLogsRequest const& request) override;
+
+  std::unique_ptr<internal::StreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+  TailLogEntries(
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+  AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::test::admin::database::v1::StreamingReadWriteRequest,
+      google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context) override;
+
+  StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse> ListServiceAccountKeys(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) override;
+
+ private:
+  std::shared_ptr<GoldenKitchenSinkStub> child_;
+  std::shared_ptr<RpcMetrics> metrics_;
+};  // GoldenKitchenSinkMetrics
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_INTERNAL_GOLDEN_KITCHEN_SINK_METRICS_DECORATOR_H
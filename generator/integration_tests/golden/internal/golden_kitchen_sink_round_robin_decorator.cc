@@ -0,0 +1,121 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: generator/integration_tests/test.proto
+#include "generator/integration_tests/golden/internal/golden_kitchen_sink_round_robin_decorator.h"
+#include "google/cloud/status_or.h"
+#include <generator/integration_tests/test.grpc.pb.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+GoldenKitchenSinkRoundRobin::GoldenKitchenSinkRoundRobin(
+    std::vector<std::shared_ptr<GoldenKitchenSinkStub>> children,
+    std::shared_ptr<google::cloud::internal::ChannelPicker> picker)
+    : children_(std::move(children)), picker_(std::move(picker)) {}
+
+StatusOr<google::test::admin::database::v1::GenerateAccessTokenResponse>
+GoldenKitchenSinkRoundRobin::GenerateAccessToken(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GenerateAccessTokenRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GenerateAccessToken(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::test::admin::database::v1::GenerateIdTokenResponse>
+GoldenKitchenSinkRoundRobin::GenerateIdToken(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GenerateIdTokenRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GenerateIdToken(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::test::admin::database::v1::WriteLogEntriesResponse>
+GoldenKitchenSinkRoundRobin::WriteLogEntries(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::WriteLogEntriesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->WriteLogEntries(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::test::admin::database::v1::ListLogsResponse>
+GoldenKitchenSinkRoundRobin::ListLogs(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListLogsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListLogs(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+std::unique_ptr<internal::StreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+GoldenKitchenSinkRoundRobin::TailLogEntries(
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto stream = children_[index]->TailLogEntries(std::move(context), request);
+  picker_->Release(index);
+  return stream;
+}
+
+std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+GoldenKitchenSinkRoundRobin::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto stream =
+      children_[index]->AsyncTailLogEntries(cq, std::move(context), request);
+  picker_->Release(index);
+  return stream;
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::test::admin::database::v1::StreamingReadWriteRequest,
+    google::test::admin::database::v1::StreamingReadWriteResponse>>
+GoldenKitchenSinkRoundRobin::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  auto const index = picker_->Acquire();
+  auto stream = children_[index]->AsyncStreamingReadWrite(cq, std::move(context));
+  picker_->Release(index);
+  return stream;
+}
+
+StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
+GoldenKitchenSinkRoundRobin::ListServiceAccountKeys(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListServiceAccountKeysRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListServiceAccountKeys(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
@@ -92,6 +92,35 @@ DefaultGoldenKitchenSinkStub::TailLogEntries(
       std::move(client_context), std::move(stream));
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<google::test::admin::database::v1::TailLogEntriesResponse>>
+DefaultGoldenKitchenSinkStub::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    google::test::admin::database::v1::TailLogEntriesRequest const& request) {
+  return internal::MakeStreamingReadRpc<
+      google::test::admin::database::v1::TailLogEntriesRequest, google::test::admin::database::v1::TailLogEntriesResponse>(
+      cq, std::move(client_context), request,
+      [this](grpc::ClientContext* context,
+             google::test::admin::database::v1::TailLogEntriesRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return grpc_stub_->PrepareAsyncTailLogEntries(context, request, cq);
+      });
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::test::admin::database::v1::StreamingReadWriteRequest,
+    google::test::admin::database::v1::StreamingReadWriteResponse>>
+DefaultGoldenKitchenSinkStub::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context) {
+  return internal::MakeStreamingReadWriteRpc<
+      google::test::admin::database::v1::StreamingReadWriteRequest, google::test::admin::database::v1::StreamingReadWriteResponse>(
+      cq, std::move(client_context),
+      [this](grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+        return grpc_stub_->PrepareAsyncStreamingReadWrite(context, cq);
+      });
+}
+
 StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>
 DefaultGoldenKitchenSinkStub::ListServiceAccountKeys(
   grpc::ClientContext& client_context,
@@ -20,13 +20,19 @@
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_auth_decorator.h"
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_logging_decorator.h"
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_metadata_decorator.h"
+#include "generator/integration_tests/golden/internal/golden_kitchen_sink_metrics_decorator.h"
+#include "generator/integration_tests/golden/internal/golden_kitchen_sink_round_robin_decorator.h"
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_stub.h"
 #include "google/cloud/common_options.h"
+#include "google/cloud/grpc_channel_registry.h"
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/algorithm.h"
+#include "google/cloud/internal/channel_picker.h"
 #include "google/cloud/log.h"
 #include "google/cloud/options.h"
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -46,11 +52,29 @@ CreateDefaultGoldenKitchenSinkStub(
     return google::cloud::internal::CreateAuthenticationStrategy(
         options.get<google::cloud::GrpcCredentialOption>());
   }();
-  auto channel = auth->CreateChannel(
-    options.get<EndpointOption>(), internal::MakeChannelArguments(options));
-  auto service_grpc_stub = google::test::admin::database::v1::GoldenKitchenSink::NewStub(channel);
-  std::shared_ptr<GoldenKitchenSinkStub> stub =
-    std::make_shared<DefaultGoldenKitchenSinkStub>(std::move(service_grpc_stub));
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  std::vector<std::shared_ptr<GoldenKitchenSinkStub>> children;
+  auto const num_channels =
+    (std::max)(1, options.get<GrpcNumChannelsOption>());
+  for (int id = 0; id != num_channels; ++id) {
+    auto arguments = internal::MakeChannelArguments(options);
+    // Use a different channel id, so gRPC does not share connections.
+    arguments.SetInt("grpc.channel_id", id);
+    auto channel = internal::CreateSharedChannel(options, arguments, [&] {
+      return auth->CreateChannel(options.get<EndpointOption>(), arguments);
+    });
+    children.push_back(std::make_shared<DefaultGoldenKitchenSinkStub>(
+      google::test::admin::database::v1::GoldenKitchenSink::NewStub(channel)));
+    channels.push_back(std::move(channel));
+  }
+  std::shared_ptr<GoldenKitchenSinkStub> stub;
+  if (children.size() == 1) {
+    stub = std::move(children.front());
+  } else {
+    stub = std::make_shared<GoldenKitchenSinkRoundRobin>(
+        std::move(children),
+        google::cloud::internal::MakeChannelPicker(channels, options));
+  }
 
   if (auth->RequiresConfigureContext()) {
     stub = std::make_shared<GoldenKitchenSinkAuth>(
@@ -65,6 +89,12 @@ CreateDefaultGoldenKitchenSinkStub(
         options.get<GrpcTracingOptionsOption>(),
         options.get<TracingComponentsOption>());
   }
+  // The metrics decorator is the outermost layer, so the resource accounting
+  // for each call includes the work done by all the other decorators.
+  if (options.has<RpcMetricsOption>()) {
+    stub = std::make_shared<GoldenKitchenSinkMetrics>(
+        std::move(stub), options.get<RpcMetricsOption>());
+  }
   return stub;
 }
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
@@ -186,8 +186,14 @@ future<Status> GoldenThingAdminMetadata::AsyncCancelOperation(
 
 void GoldenThingAdminMetadata::SetMetadata(grpc::ClientContext& context,
                                         std::string const& request_params) {
-  context.AddMetadata("x-goog-request-params", request_params);
-  context.AddMetadata("x-goog-api-client", api_client_header_);
+  context.AddMetadata(google::cloud::internal::RequestParamsKey(),
+                      request_params);
+  SetMetadata(context);
+}
+
+void GoldenThingAdminMetadata::SetMetadata(grpc::ClientContext& context) {
+  context.AddMetadata(google::cloud::internal::ApiClientHeaderKey(),
+                      api_client_header_);
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
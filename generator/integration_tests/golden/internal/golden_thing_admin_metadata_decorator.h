@@ -119,6 +119,7 @@ class GoldenThingAdminMetadata : public GoldenThingAdminStub {
  private:
   void SetMetadata(grpc::ClientContext& context,
                    std::string const& request_params);
+  void SetMetadata(grpc::ClientContext& context);
   std::shared_ptr<GoldenThingAdminStub> child_;
   std::string api_client_header_;
 };  // GoldenThingAdminMetadata
@@ -0,0 +1,232 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: generator/integration_tests/test.proto
+#include "generator/integration_tests/golden/internal/golden_thing_admin_round_robin_decorator.h"
+#include "google/cloud/status_or.h"
+#include <generator/integration_tests/test.grpc.pb.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+GoldenThingAdminRoundRobin::GoldenThingAdminRoundRobin(
+    std::vector<std::shared_ptr<GoldenThingAdminStub>> children,
+    std::shared_ptr<google::cloud::internal::ChannelPicker> picker)
+    : children_(std::move(children)), picker_(std::move(picker)) {}
+
+StatusOr<google::test::admin::database::v1::ListDatabasesResponse>
+GoldenThingAdminRoundRobin::ListDatabases(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListDatabasesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListDatabases(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+future<StatusOr<google::longrunning::Operation>>
+GoldenThingAdminRoundRobin::AsyncCreateDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::CreateDatabaseRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncCreateDatabase(cq, std::move(context), request));
+}
+
+StatusOr<google::test::admin::database::v1::Database>
+GoldenThingAdminRoundRobin::GetDatabase(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GetDatabaseRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetDatabase(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+future<StatusOr<google::longrunning::Operation>>
+GoldenThingAdminRoundRobin::AsyncUpdateDatabaseDdl(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::UpdateDatabaseDdlRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncUpdateDatabaseDdl(cq, std::move(context), request));
+}
+
+Status
+GoldenThingAdminRoundRobin::DropDatabase(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::DropDatabaseRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->DropDatabase(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::test::admin::database::v1::GetDatabaseDdlResponse>
+GoldenThingAdminRoundRobin::GetDatabaseDdl(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GetDatabaseDdlRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetDatabaseDdl(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::v1::Policy>
+GoldenThingAdminRoundRobin::SetIamPolicy(
+    grpc::ClientContext& context,
+    google::iam::v1::SetIamPolicyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->SetIamPolicy(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::v1::Policy>
+GoldenThingAdminRoundRobin::GetIamPolicy(
+    grpc::ClientContext& context,
+    google::iam::v1::GetIamPolicyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetIamPolicy(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::v1::TestIamPermissionsResponse>
+GoldenThingAdminRoundRobin::TestIamPermissions(
+    grpc::ClientContext& context,
+    google::iam::v1::TestIamPermissionsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->TestIamPermissions(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+future<StatusOr<google::longrunning::Operation>>
+GoldenThingAdminRoundRobin::AsyncCreateBackup(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::CreateBackupRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncCreateBackup(cq, std::move(context), request));
+}
+
+StatusOr<google::test::admin::database::v1::Backup>
+GoldenThingAdminRoundRobin::GetBackup(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::GetBackupRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetBackup(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::test::admin::database::v1::Backup>
+GoldenThingAdminRoundRobin::UpdateBackup(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::UpdateBackupRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->UpdateBackup(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+Status
+GoldenThingAdminRoundRobin::DeleteBackup(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::DeleteBackupRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->DeleteBackup(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::test::admin::database::v1::ListBackupsResponse>
+GoldenThingAdminRoundRobin::ListBackups(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListBackupsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListBackups(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+future<StatusOr<google::longrunning::Operation>>
+GoldenThingAdminRoundRobin::AsyncRestoreDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::test::admin::database::v1::RestoreDatabaseRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncRestoreDatabase(cq, std::move(context), request));
+}
+
+StatusOr<google::test::admin::database::v1::ListDatabaseOperationsResponse>
+GoldenThingAdminRoundRobin::ListDatabaseOperations(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListDatabaseOperationsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListDatabaseOperations(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::test::admin::database::v1::ListBackupOperationsResponse>
+GoldenThingAdminRoundRobin::ListBackupOperations(
+    grpc::ClientContext& context,
+    google::test::admin::database::v1::ListBackupOperationsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListBackupOperations(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+future<StatusOr<google::longrunning::Operation>>
+GoldenThingAdminRoundRobin::AsyncGetOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::GetOperationRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncGetOperation(cq, std::move(context), request));
+}
+
+future<Status> GoldenThingAdminRoundRobin::AsyncCancelOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::CancelOperationRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncCancelOperation(cq, std::move(context), request));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,165 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: generator/integration_tests/test.proto
+#ifndef GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_MOCKS_FAKE_GOLDEN_KITCHEN_SINK_SERVER_H
+#define GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_MOCKS_FAKE_GOLDEN_KITCHEN_SINK_SERVER_H
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include "google/cloud/version.h"
+#include <generator/integration_tests/test.grpc.pb.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace golden_mocks {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * An in-process fake for `GoldenKitchenSink`.
+ *
+ * Register this class with a `testing_util::EmbeddedGrpcServer` to
+ * benchmark or test the client library with the full gRPC stack. Each RPC
+ * simulates the latency and errors configured in its
+ * `testing_util::FakeServerBehavior`, and returns a canned response, which
+ * includes a payload of the configured size.
+ *
+ * The canned responses must be changed before the server starts.
+ */
+class FakeGoldenKitchenSinkServer : public google::test::admin::database::v1::GoldenKitchenSink::Service {
+ public:
+  explicit FakeGoldenKitchenSinkServer(testing_util::FakeServerConfig config = {})
+      : behavior_(std::move(config)) {
+    behavior_.FillPayload(generate_access_token_response_);
+    behavior_.FillPayload(generate_id_token_response_);
+    behavior_.FillPayload(write_log_entries_response_);
+    behavior_.FillPayload(list_logs_response_);
+    behavior_.FillPayload(tail_log_entries_response_);
+    behavior_.FillPayload(streaming_read_write_response_);
+    behavior_.FillPayload(list_service_account_keys_response_);
+  }
+
+  testing_util::FakeServerBehavior& behavior() { return behavior_; }
+
+  void set_generate_access_token_response(google::test::admin::database::v1::GenerateAccessTokenResponse response) {
+    generate_access_token_response_ = std::move(response);
+  }
+
+  grpc::Status GenerateAccessToken(
+      grpc::ServerContext*, google::test::admin::database::v1::GenerateAccessTokenRequest const*,
+      google::test::admin::database::v1::GenerateAccessTokenResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = generate_access_token_response_;
+    return status;
+  }
+
+  void set_generate_id_token_response(google::test::admin::database::v1::GenerateIdTokenResponse response) {
+    generate_id_token_response_ = std::move(response);
+  }
+
+  grpc::Status GenerateIdToken(
+      grpc::ServerContext*, google::test::admin::database::v1::GenerateIdTokenRequest const*,
+      google::test::admin::database::v1::GenerateIdTokenResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = generate_id_token_response_;
+    return status;
+  }
+
+  void set_write_log_entries_response(google::test::admin::database::v1::WriteLogEntriesResponse response) {
+    write_log_entries_response_ = std::move(response);
+  }
+
+  grpc::Status WriteLogEntries(
+      grpc::ServerContext*, google::test::admin::database::v1::WriteLogEntriesRequest const*,
+      google::test::admin::database::v1::WriteLogEntriesResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = write_log_entries_response_;
+    return status;
+  }
+
+  void set_list_logs_response(google::test::admin::database::v1::ListLogsResponse response) {
+    list_logs_response_ = std::move(response);
+  }
+
+  grpc::Status ListLogs(
+      grpc::ServerContext*, google::test::admin::database::v1::ListLogsRequest const*,
+      google::test::admin::database::v1::ListLogsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_logs_response_;
+    return status;
+  }
+
+  void set_tail_log_entries_response(google::test::admin::database::v1::TailLogEntriesResponse response) {
+    tail_log_entries_response_ = std::move(response);
+  }
+
+  grpc::Status TailLogEntries(
+      grpc::ServerContext*, google::test::admin::database::v1::TailLogEntriesRequest const*,
+      grpc::ServerWriter<google::test::admin::database::v1::TailLogEntriesResponse>* writer) override {
+    auto status = behavior_.Simulate();
+    if (!status.ok()) return status;
+    for (int i = 0; i != behavior_.config().stream_messages; ++i) {
+      if (!writer->Write(tail_log_entries_response_)) break;
+    }
+    return status;
+  }
+
+  void set_streaming_read_write_response(google::test::admin::database::v1::StreamingReadWriteResponse response) {
+    streaming_read_write_response_ = std::move(response);
+  }
+
+  grpc::Status StreamingReadWrite(
+      grpc::ServerContext*,
+      grpc::ServerReaderWriter<google::test::admin::database::v1::StreamingReadWriteResponse,
+          google::test::admin::database::v1::StreamingReadWriteRequest>* stream) override {
+    google::test::admin::database::v1::StreamingReadWriteRequest request;
+    while (stream->Read(&request)) {
+      auto status = behavior_.Simulate();
+      if (!status.ok()) return status;
+      if (!stream->Write(streaming_read_write_response_)) break;
+    }
+    return grpc::Status::OK;
+  }
+
+  void set_list_service_account_keys_response(google::test::admin::database::v1::ListServiceAccountKeysResponse response) {
+    list_service_account_keys_response_ = std::move(response);
+  }
+
+  grpc::Status ListServiceAccountKeys(
+      grpc::ServerContext*, google::test::admin::database::v1::ListServiceAccountKeysRequest const*,
+      google::test::admin::database::v1::ListServiceAccountKeysResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_service_account_keys_response_;
+    return status;
+  }
+
+ private:
+  testing_util::FakeServerBehavior behavior_;
+  google::test::admin::database::v1::GenerateAccessTokenResponse generate_access_token_response_;
+  google::test::admin::database::v1::GenerateIdTokenResponse generate_id_token_response_;
+  google::test::admin::database::v1::WriteLogEntriesResponse write_log_entries_response_;
+  google::test::admin::database::v1::ListLogsResponse list_logs_response_;
+  google::test::admin::database::v1::TailLogEntriesResponse tail_log_entries_response_;
+  google::test::admin::database::v1::StreamingReadWriteResponse streaming_read_write_response_;
+  google::test::admin::database::v1::ListServiceAccountKeysResponse list_service_account_keys_response_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_mocks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_MOCKS_FAKE_GOLDEN_KITCHEN_SINK_SERVER_H
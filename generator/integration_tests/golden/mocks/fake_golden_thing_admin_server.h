@@ -0,0 +1,313 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: generator/integration_tests/test.proto
+#ifndef GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_MOCKS_FAKE_GOLDEN_THING_ADMIN_SERVER_H
+#define GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_MOCKS_FAKE_GOLDEN_THING_ADMIN_SERVER_H
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include "google/cloud/version.h"
+#include <generator/integration_tests/test.grpc.pb.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace golden_mocks {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * An in-process fake for `GoldenThingAdmin`.
+ *
+ * Register this class with a `testing_util::EmbeddedGrpcServer` to
+ * benchmark or test the client library with the full gRPC stack. Each RPC
+ * simulates the latency and errors configured in its
+ * `testing_util::FakeServerBehavior`, and returns a canned response, which
+ * includes a payload of the configured size.
+ *
+ * The canned responses must be changed before the server starts.
+ */
+class FakeGoldenThingAdminServer : public google::test::admin::database::v1::GoldenThingAdmin::Service {
+ public:
+  explicit FakeGoldenThingAdminServer(testing_util::FakeServerConfig config = {})
+      : behavior_(std::move(config)) {
+    behavior_.FillPayload(list_databases_response_);
+    behavior_.FillPayload(create_database_response_);
+    behavior_.FillPayload(get_database_response_);
+    behavior_.FillPayload(update_database_ddl_response_);
+    behavior_.FillPayload(drop_database_response_);
+    behavior_.FillPayload(get_database_ddl_response_);
+    behavior_.FillPayload(set_iam_policy_response_);
+    behavior_.FillPayload(get_iam_policy_response_);
+    behavior_.FillPayload(test_iam_permissions_response_);
+    behavior_.FillPayload(create_backup_response_);
+    behavior_.FillPayload(get_backup_response_);
+    behavior_.FillPayload(update_backup_response_);
+    behavior_.FillPayload(delete_backup_response_);
+    behavior_.FillPayload(list_backups_response_);
+    behavior_.FillPayload(restore_database_response_);
+    behavior_.FillPayload(list_database_operations_response_);
+    behavior_.FillPayload(list_backup_operations_response_);
+  }
+
+  testing_util::FakeServerBehavior& behavior() { return behavior_; }
+
+  void set_list_databases_response(google::test::admin::database::v1::ListDatabasesResponse response) {
+    list_databases_response_ = std::move(response);
+  }
+
+  grpc::Status ListDatabases(
+      grpc::ServerContext*, google::test::admin::database::v1::ListDatabasesRequest const*,
+      google::test::admin::database::v1::ListDatabasesResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_databases_response_;
+    return status;
+  }
+
+  void set_create_database_response(
+      google::test::admin::database::v1::Database response) {
+    create_database_response_ = std::move(response);
+  }
+
+  grpc::Status CreateDatabase(
+      grpc::ServerContext*, google::test::admin::database::v1::CreateDatabaseRequest const*,
+      google::longrunning::Operation* response) override {
+    auto status = behavior_.Simulate();
+    if (!status.ok()) return status;
+    response->set_name("operations/create_database");
+    response->set_done(true);
+    response->mutable_response()->PackFrom(create_database_response_);
+    return status;
+  }
+
+  void set_get_database_response(google::test::admin::database::v1::Database response) {
+    get_database_response_ = std::move(response);
+  }
+
+  grpc::Status GetDatabase(
+      grpc::ServerContext*, google::test::admin::database::v1::GetDatabaseRequest const*,
+      google::test::admin::database::v1::Database* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_database_response_;
+    return status;
+  }
+
+  void set_update_database_ddl_response(
+      google::test::admin::database::v1::UpdateDatabaseDdlMetadata response) {
+    update_database_ddl_response_ = std::move(response);
+  }
+
+  grpc::Status UpdateDatabaseDdl(
+      grpc::ServerContext*, google::test::admin::database::v1::UpdateDatabaseDdlRequest const*,
+      google::longrunning::Operation* response) override {
+    auto status = behavior_.Simulate();
+    if (!status.ok()) return status;
+    response->set_name("operations/update_database_ddl");
+    response->set_done(true);
+    response->mutable_metadata()->PackFrom(update_database_ddl_response_);
+    return status;
+  }
+
+  void set_drop_database_response(google::protobuf::Empty response) {
+    drop_database_response_ = std::move(response);
+  }
+
+  grpc::Status DropDatabase(
+      grpc::ServerContext*, google::test::admin::database::v1::DropDatabaseRequest const*,
+      google::protobuf::Empty* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = drop_database_response_;
+    return status;
+  }
+
+  void set_get_database_ddl_response(google::test::admin::database::v1::GetDatabaseDdlResponse response) {
+    get_database_ddl_response_ = std::move(response);
+  }
+
+  grpc::Status GetDatabaseDdl(
+      grpc::ServerContext*, google::test::admin::database::v1::GetDatabaseDdlRequest const*,
+      google::test::admin::database::v1::GetDatabaseDdlResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_database_ddl_response_;
+    return status;
+  }
+
+  void set_set_iam_policy_response(google::iam::v1::Policy response) {
+    set_iam_policy_response_ = std::move(response);
+  }
+
+  grpc::Status SetIamPolicy(
+      grpc::ServerContext*, google::iam::v1::SetIamPolicyRequest const*,
+      google::iam::v1::Policy* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = set_iam_policy_response_;
+    return status;
+  }
+
+  void set_get_iam_policy_response(google::iam::v1::Policy response) {
+    get_iam_policy_response_ = std::move(response);
+  }
+
+  grpc::Status GetIamPolicy(
+      grpc::ServerContext*, google::iam::v1::GetIamPolicyRequest const*,
+      google::iam::v1::Policy* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_iam_policy_response_;
+    return status;
+  }
+
+  void set_test_iam_permissions_response(google::iam::v1::TestIamPermissionsResponse response) {
+    test_iam_permissions_response_ = std::move(response);
+  }
+
+  grpc::Status TestIamPermissions(
+      grpc::ServerContext*, google::iam::v1::TestIamPermissionsRequest const*,
+      google::iam::v1::TestIamPermissionsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = test_iam_permissions_response_;
+    return status;
+  }
+
+  void set_create_backup_response(
+      google::test::admin::database::v1::Backup response) {
+    create_backup_response_ = std::move(response);
+  }
+
+  grpc::Status CreateBackup(
+      grpc::ServerContext*, google::test::admin::database::v1::CreateBackupRequest const*,
+      google::longrunning::Operation* response) override {
+    auto status = behavior_.Simulate();
+    if (!status.ok()) return status;
+    response->set_name("operations/create_backup");
+    response->set_done(true);
+    response->mutable_response()->PackFrom(create_backup_response_);
+    return status;
+  }
+
+  void set_get_backup_response(google::test::admin::database::v1::Backup response) {
+    get_backup_response_ = std::move(response);
+  }
+
+  grpc::Status GetBackup(
+      grpc::ServerContext*, google::test::admin::database::v1::GetBackupRequest const*,
+      google::test::admin::database::v1::Backup* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_backup_response_;
+    return status;
+  }
+
+  void set_update_backup_response(google::test::admin::database::v1::Backup response) {
+    update_backup_response_ = std::move(response);
+  }
+
+  grpc::Status UpdateBackup(
+      grpc::ServerContext*, google::test::admin::database::v1::UpdateBackupRequest const*,
+      google::test::admin::database::v1::Backup* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = update_backup_response_;
+    return status;
+  }
+
+  void set_delete_backup_response(google::protobuf::Empty response) {
+    delete_backup_response_ = std::move(response);
+  }
+
+  grpc::Status DeleteBackup(
+      grpc::ServerContext*, google::test::admin::database::v1::DeleteBackupRequest const*,
+      google::protobuf::Empty* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = delete_backup_response_;
+    return status;
+  }
+
+  void set_list_backups_response(google::test::admin::database::v1::ListBackupsResponse response) {
+    list_backups_response_ = std::move(response);
+  }
+
+  grpc::Status ListBackups(
+      grpc::ServerContext*, google::test::admin::database::v1::ListBackupsRequest const*,
+      google::test::admin::database::v1::ListBackupsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_backups_response_;
+    return status;
+  }
+
+  void set_restore_database_response(
+      google::test::admin::database::v1::Database response) {
+    restore_database_response_ = std::move(response);
+  }
+
+  grpc::Status RestoreDatabase(
+      grpc::ServerContext*, google::test::admin::database::v1::RestoreDatabaseRequest const*,
+      google::longrunning::Operation* response) override {
+    auto status = behavior_.Simulate();
+    if (!status.ok()) return status;
+    response->set_name("operations/restore_database");
+    response->set_done(true);
+    response->mutable_response()->PackFrom(restore_database_response_);
+    return status;
+  }
+
+  void set_list_database_operations_response(google::test::admin::database::v1::ListDatabaseOperationsResponse response) {
+    list_database_operations_response_ = std::move(response);
+  }
+
+  grpc::Status ListDatabaseOperations(
+      grpc::ServerContext*, google::test::admin::database::v1::ListDatabaseOperationsRequest const*,
+      google::test::admin::database::v1::ListDatabaseOperationsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_database_operations_response_;
+    return status;
+  }
+
+  void set_list_backup_operations_response(google::test::admin::database::v1::ListBackupOperationsResponse response) {
+    list_backup_operations_response_ = std::move(response);
+  }
+
+  grpc::Status ListBackupOperations(
+      grpc::ServerContext*, google::test::admin::database::v1::ListBackupOperationsRequest const*,
+      google::test::admin::database::v1::ListBackupOperationsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_backup_operations_response_;
+    return status;
+  }
+
+ private:
+  testing_util::FakeServerBehavior behavior_;
+  google::test::admin::database::v1::ListDatabasesResponse list_databases_response_;
+  google::test::admin::database::v1::Database create_database_response_;
+  google::test::admin::database::v1::Database get_database_response_;
+  google::test::admin::database::v1::UpdateDatabaseDdlMetadata update_database_ddl_response_;
+  google::protobuf::Empty drop_database_response_;
+  google::test::admin::database::v1::GetDatabaseDdlResponse get_database_ddl_response_;
+  google::iam::v1::Policy set_iam_policy_response_;
+  google::iam::v1::Policy get_iam_policy_response_;
+  google::iam::v1::TestIamPermissionsResponse test_iam_permissions_response_;
+  google::test::admin::database::v1::Backup create_backup_response_;
+  google::test::admin::database::v1::Backup get_backup_response_;
+  google::test::admin::database::v1::Backup update_backup_response_;
+  google::protobuf::Empty delete_backup_response_;
+  google::test::admin::database::v1::ListBackupsResponse list_backups_response_;
+  google::test::admin::database::v1::Database restore_database_response_;
+  google::test::admin::database::v1::ListDatabaseOperationsResponse list_database_operations_response_;
+  google::test::admin::database::v1::ListBackupOperationsResponse list_backup_operations_response_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_mocks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_MOCKS_FAKE_GOLDEN_THING_ADMIN_SERVER_H
@@ -48,6 +48,20 @@ class MockGoldenKitchenSinkConnection : public golden::GoldenKitchenSinkConnecti
   TailLogEntries,
   (google::test::admin::database::v1::TailLogEntriesRequest const& request), (override));
 
+  MOCK_METHOD(StreamRange<std::shared_ptr<google::test::admin::database::v1::TailLogEntriesResponse const>>,
+  TailLogEntriesInArena,
+  (google::test::admin::database::v1::TailLogEntriesRequest const& request), (override));
+
+  MOCK_METHOD(future<Status>,
+  AsyncTailLogEntries,
+  (google::test::admin::database::v1::TailLogEntriesRequest const& request,
+   std::function<future<bool>(google::test::admin::database::v1::TailLogEntriesResponse)> on_read), (override));
+
+  MOCK_METHOD((std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::test::admin::database::v1::StreamingReadWriteRequest,
+      google::test::admin::database::v1::StreamingReadWriteResponse>>),
+  AsyncStreamingReadWrite, (), (override));
+
   MOCK_METHOD(StatusOr<google::test::admin::database::v1::ListServiceAccountKeysResponse>,
   ListServiceAccountKeys,
   (google::test::admin::database::v1::ListServiceAccountKeysRequest const& request), (override));
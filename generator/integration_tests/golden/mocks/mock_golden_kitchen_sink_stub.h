@@ -58,6 +58,22 @@ class MockGoldenKitchenSinkStub : public GoldenKitchenSinkStub {
       (std::unique_ptr<grpc::ClientContext> context,
        ::google::test::admin::database::v1::TailLogEntriesRequest const&),
       (override));
+  MOCK_METHOD(
+      (std::unique_ptr<internal::AsyncStreamingReadRpc<
+           ::google::test::admin::database::v1::TailLogEntriesResponse>>),
+      AsyncTailLogEntries,
+      (google::cloud::CompletionQueue&,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::TailLogEntriesRequest const&),
+      (override));
+  MOCK_METHOD(
+      (std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+           ::google::test::admin::database::v1::StreamingReadWriteRequest,
+           ::google::test::admin::database::v1::StreamingReadWriteResponse>>),
+      AsyncStreamingReadWrite,
+      (google::cloud::CompletionQueue&,
+       std::unique_ptr<grpc::ClientContext> context),
+      (override));
   MOCK_METHOD(
       StatusOr<
           ::google::test::admin::database::v1::ListServiceAccountKeysResponse>,
@@ -77,6 +93,19 @@ public:
   (const, override));
 };
 
+class MockAsyncTailLogEntriesStreamingReadRpc
+    : public internal::AsyncStreamingReadRpc<
+          ::google::test::admin::database::v1::TailLogEntriesResponse> {
+ public:
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD(future<bool>, Start, (), (override));
+  MOCK_METHOD(
+      future<absl::optional<
+          ::google::test::admin::database::v1::TailLogEntriesResponse>>,
+      Read, (), (override));
+  MOCK_METHOD(future<Status>, Finish, (), (override));
+};
+
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
 }  // namespace golden_internal
 }  // namespace cloud
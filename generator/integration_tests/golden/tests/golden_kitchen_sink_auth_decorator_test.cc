@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "generator/integration_tests/golden/internal/golden_kitchen_sink_auth_decorator.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
 #include "google/cloud/internal/streaming_read_rpc.h"
 #include "google/cloud/testing_util/mock_grpc_authentication_strategy.h"
 #include "google/cloud/testing_util/status_matchers.h"
@@ -27,6 +28,7 @@ namespace golden_internal {
 inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
 namespace {
 
+using ::google::cloud::internal::AsyncStreamingReadWriteRpcError;
 using ::google::cloud::internal::GrpcAuthenticationStrategy;
 using ::google::cloud::internal::StreamingReadRpcError;
 using ::google::cloud::testing_util::MockAuthenticationStrategy;
@@ -150,6 +152,33 @@ TEST(GoldenKitchenSinkAuthDecoratorTest, TailLogEntries) {
   EXPECT_THAT(absl::get<Status>(v), StatusIs(StatusCode::kPermissionDenied));
 }
 
+TEST(GoldenKitchenSinkAuthDecoratorTest, AsyncStreamingReadWrite) {
+  using ::google::test::admin::database::v1::StreamingReadWriteRequest;
+  using ::google::test::admin::database::v1::StreamingReadWriteResponse;
+  using ErrorStream = AsyncStreamingReadWriteRpcError<
+      StreamingReadWriteRequest, StreamingReadWriteResponse>;
+  auto mock = std::make_shared<MockGoldenKitchenSinkStub>();
+  EXPECT_CALL(*mock, AsyncStreamingReadWrite)
+      .WillOnce([](::testing::Unused, ::testing::Unused) {
+        return absl::make_unique<ErrorStream>(
+            Status(StatusCode::kPermissionDenied, "uh-oh"));
+      });
+
+  auto under_test = GoldenKitchenSinkAuth(MakeMockAuth(), mock);
+  google::cloud::CompletionQueue cq;
+  auto auth_failure = under_test.AsyncStreamingReadWrite(
+      cq, absl::make_unique<grpc::ClientContext>());
+  EXPECT_FALSE(auth_failure->Start().get());
+  EXPECT_THAT(auth_failure->Finish().get(),
+              StatusIs(StatusCode::kInvalidArgument));
+
+  auto auth_success = under_test.AsyncStreamingReadWrite(
+      cq, absl::make_unique<grpc::ClientContext>());
+  EXPECT_FALSE(auth_success->Start().get());
+  EXPECT_THAT(auth_success->Finish().get(),
+              StatusIs(StatusCode::kPermissionDenied));
+}
+
 TEST(GoldenKitchenSinkAuthDecoratorTest, ListServiceAccountKeys) {
   auto mock = std::make_shared<MockGoldenKitchenSinkStub>();
   EXPECT_CALL(*mock, ListServiceAccountKeys)
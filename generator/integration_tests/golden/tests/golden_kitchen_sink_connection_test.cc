@@ -27,6 +27,7 @@ namespace golden {
 inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
 namespace {
 
+using ::google::cloud::golden_internal::MockAsyncTailLogEntriesStreamingReadRpc;
 using ::google::cloud::golden_internal::MockGoldenKitchenSinkStub;
 using ::google::cloud::golden_internal::MockTailLogEntriesStreamingReadRpc;
 using ::testing::AtLeast;
@@ -257,6 +258,107 @@ TEST(GoldenKitchenSinkConnectionTest, TailLogEntriesPermanentError) {
   EXPECT_EQ(StatusCode::kPermissionDenied, begin->status().code());
 }
 
+TEST(GoldenKitchenSinkConnectionTest, TailLogEntriesInArena) {
+  using ::google::test::admin::database::v1::TailLogEntriesRequest;
+  using ::google::test::admin::database::v1::TailLogEntriesResponse;
+  auto mock = std::make_shared<MockGoldenKitchenSinkStub>();
+  EXPECT_CALL(*mock, TailLogEntries)
+      .WillOnce([](std::unique_ptr<grpc::ClientContext>,
+                   TailLogEntriesRequest const&) {
+        auto reader = absl::make_unique<MockTailLogEntriesStreamingReadRpc>();
+        TailLogEntriesResponse response;
+        response.add_entries()->set_log_name("log-0");
+        EXPECT_CALL(*reader, Read)
+            .WillOnce(Return(response))
+            .WillOnce(Return(Status{}));
+        return reader;
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  auto range = conn->TailLogEntriesInArena(TailLogEntriesRequest{});
+  auto i = range.begin();
+  ASSERT_NE(i, range.end());
+  ASSERT_STATUS_OK(*i);
+  ASSERT_NE(nullptr, **i);
+  ASSERT_EQ(1, (**i)->entries_size());
+  EXPECT_EQ("log-0", (**i)->entries(0).log_name());
+  EXPECT_EQ(++i, range.end());
+}
+
+/// An asynchronous stream returning @p count responses and then @p status.
+std::unique_ptr<internal::AsyncStreamingReadRpc<
+    ::google::test::admin::database::v1::TailLogEntriesResponse>>
+MakeAsyncReader(int count, Status status) {
+  using ::google::test::admin::database::v1::TailLogEntriesResponse;
+  auto reader = absl::make_unique<MockAsyncTailLogEntriesStreamingReadRpc>();
+  ::testing::InSequence sequence;
+  EXPECT_CALL(*reader, Start).WillOnce([] { return make_ready_future(true); });
+  EXPECT_CALL(*reader, Read)
+      .Times(count)
+      .WillRepeatedly([] {
+        return make_ready_future(
+            absl::make_optional(TailLogEntriesResponse{}));
+      });
+  EXPECT_CALL(*reader, Read).WillOnce([] {
+    return make_ready_future<absl::optional<TailLogEntriesResponse>>(
+        absl::nullopt);
+  });
+  EXPECT_CALL(*reader, Finish).WillOnce([status] {
+    return make_ready_future(status);
+  });
+  return reader;
+}
+
+TEST(GoldenKitchenSinkConnectionTest, AsyncTailLogEntriesResumes) {
+  auto mock = std::make_shared<MockGoldenKitchenSinkStub>();
+  EXPECT_CALL(*mock, AsyncTailLogEntries)
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   ::google::test::admin::database::v1::
+                       TailLogEntriesRequest const&) {
+        return MakeAsyncReader(2,
+                               Status(StatusCode::kUnavailable, "try-again"));
+      })
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   ::google::test::admin::database::v1::
+                       TailLogEntriesRequest const&) {
+        return MakeAsyncReader(1, Status{});
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  ::google::test::admin::database::v1::TailLogEntriesRequest request;
+  int count = 0;
+  auto status =
+      conn->AsyncTailLogEntries(
+              request,
+              [&count](
+                  ::google::test::admin::database::v1::TailLogEntriesResponse) {
+                ++count;
+                return make_ready_future(true);
+              })
+          .get();
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(3, count);
+}
+
+TEST(GoldenKitchenSinkConnectionTest, AsyncTailLogEntriesPermanentError) {
+  auto mock = std::make_shared<MockGoldenKitchenSinkStub>();
+  EXPECT_CALL(*mock, AsyncTailLogEntries)
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   ::google::test::admin::database::v1::
+                       TailLogEntriesRequest const&) {
+        return MakeAsyncReader(
+            0, Status(StatusCode::kPermissionDenied, "Permission Denied."));
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  ::google::test::admin::database::v1::TailLogEntriesRequest request;
+  auto status =
+      conn->AsyncTailLogEntries(
+              request,
+              [](::google::test::admin::database::v1::TailLogEntriesResponse) {
+                return make_ready_future(true);
+              })
+          .get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, status.code());
+}
+
 TEST(GoldenKitchenSinkConnectionTest, ListServiceAccountKeysSuccess) {
   auto mock = std::make_shared<MockGoldenKitchenSinkStub>();
   EXPECT_CALL(*mock, ListServiceAccountKeys)
@@ -0,0 +1,100 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "generator/integration_tests/golden/mocks/fake_golden_kitchen_sink_server.h"
+#include "google/cloud/testing_util/embedded_grpc_server.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "generator/integration_tests/golden/golden_kitchen_sink_connection.h"
+#include "generator/integration_tests/golden/golden_kitchen_sink_options.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace golden_mocks {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::testing_util::EmbeddedGrpcServer;
+using ::google::cloud::testing_util::FakeServerConfig;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::test::admin::database::v1::GenerateAccessTokenRequest;
+using ::google::test::admin::database::v1::TailLogEntriesRequest;
+using ::testing::SizeIs;
+
+std::shared_ptr<golden::GoldenKitchenSinkConnection> CreateTestingConnection(
+    EmbeddedGrpcServer const& server) {
+  auto options = server.ClientOptions();
+  options.set<golden::GoldenKitchenSinkRetryPolicyOption>(
+      golden::GoldenKitchenSinkLimitedErrorCountRetryPolicy(
+          /*maximum_failures=*/2)
+          .clone());
+  options.set<golden::GoldenKitchenSinkBackoffPolicyOption>(
+      ExponentialBackoffPolicy(
+          /*initial_delay=*/std::chrono::microseconds(1),
+          /*maximum_delay=*/std::chrono::microseconds(1),
+          /*scaling=*/2.0)
+          .clone());
+  return golden::MakeGoldenKitchenSinkConnection(std::move(options));
+}
+
+TEST(FakeGoldenKitchenSinkServerTest, UnaryPayload) {
+  FakeServerConfig config;
+  config.payload_size = 1024;
+  FakeGoldenKitchenSinkServer fake(config);
+  EmbeddedGrpcServer server({&fake});
+  auto conn = CreateTestingConnection(server);
+
+  auto response = conn->GenerateAccessToken(GenerateAccessTokenRequest{});
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(response->access_token(), SizeIs(1024));
+  EXPECT_EQ(1, fake.behavior().rpc_count());
+  EXPECT_EQ(0, fake.behavior().error_count());
+}
+
+TEST(FakeGoldenKitchenSinkServerTest, UnaryError) {
+  FakeServerConfig config;
+  config.error_rate = 1.0;
+  config.error_code = grpc::StatusCode::PERMISSION_DENIED;
+  FakeGoldenKitchenSinkServer fake(config);
+  EmbeddedGrpcServer server({&fake});
+  auto conn = CreateTestingConnection(server);
+
+  auto response = conn->GenerateAccessToken(GenerateAccessTokenRequest{});
+  EXPECT_THAT(response, StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_EQ(1, fake.behavior().error_count());
+}
+
+TEST(FakeGoldenKitchenSinkServerTest, StreamingRead) {
+  FakeServerConfig config;
+  config.stream_messages = 3;
+  FakeGoldenKitchenSinkServer fake(config);
+  EmbeddedGrpcServer server({&fake});
+  auto conn = CreateTestingConnection(server);
+
+  int count = 0;
+  for (auto const& response : conn->TailLogEntries(TailLogEntriesRequest{})) {
+    ASSERT_STATUS_OK(response);
+    ++count;
+  }
+  EXPECT_EQ(3, count);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_mocks
+}  // namespace cloud
+}  // namespace google
@@ -153,6 +153,29 @@ TEST_F(MetadataDecoratorTest, TailLogEntries) {
   EXPECT_THAT(absl::get<Status>(response->Read()), Not(IsOk()));
 }
 
+TEST_F(MetadataDecoratorTest, AsyncStreamingReadWrite) {
+  using ::google::test::admin::database::v1::StreamingReadWriteRequest;
+  using ::google::test::admin::database::v1::StreamingReadWriteResponse;
+  using ErrorStream = internal::AsyncStreamingReadWriteRpcError<
+      StreamingReadWriteRequest, StreamingReadWriteResponse>;
+  EXPECT_CALL(*mock_, AsyncStreamingReadWrite)
+      .WillOnce([this](google::cloud::CompletionQueue&,
+                       std::unique_ptr<grpc::ClientContext> context) {
+        EXPECT_STATUS_OK(
+            IsContextMDValid(*context,
+                             "google.test.admin.database.v1.GoldenKitchenSink."
+                             "StreamingReadWrite",
+                             expected_api_client_header_));
+        return absl::make_unique<ErrorStream>(TransientError());
+      });
+  GoldenKitchenSinkMetadata stub(mock_);
+  google::cloud::CompletionQueue cq;
+  auto stream = stub.AsyncStreamingReadWrite(
+      cq, absl::make_unique<grpc::ClientContext>());
+  EXPECT_FALSE(stream->Start().get());
+  EXPECT_EQ(TransientError(), stream->Finish().get());
+}
+
 TEST_F(MetadataDecoratorTest, ListServiceAccountKeys) {
   EXPECT_CALL(*mock_, ListServiceAccountKeys)
       .WillOnce([this](grpc::ClientContext& context,
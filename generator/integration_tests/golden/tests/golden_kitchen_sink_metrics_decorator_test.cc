@@ -0,0 +1,127 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/integration_tests/golden/internal/golden_kitchen_sink_metrics_decorator.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include "generator/integration_tests/golden/mocks/mock_golden_kitchen_sink_stub.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::golden_internal::MockTailLogEntriesStreamingReadRpc;
+using ::testing::ByMove;
+using ::testing::Return;
+
+class MetricsDecoratorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock_ = std::make_shared<MockGoldenKitchenSinkStub>();
+    metrics_ = std::make_shared<RpcMetrics>();
+  }
+
+  static Status TransientError() {
+    return Status(StatusCode::kUnavailable, "try-again");
+  }
+
+  RpcMethodMetricsSnapshot Snapshot(std::string const& method) {
+    for (auto const& s : metrics_->Snapshot()) {
+      if (s.method == method) return s;
+    }
+    ADD_FAILURE() << "missing metrics for " << method;
+    return RpcMethodMetricsSnapshot{};
+  }
+
+  std::shared_ptr<MockGoldenKitchenSinkStub> mock_;
+  std::shared_ptr<RpcMetrics> metrics_;
+};
+
+TEST_F(MetricsDecoratorTest, GenerateAccessToken) {
+  ::google::test::admin::database::v1::GenerateAccessTokenResponse response;
+  response.set_access_token("test-token");
+  EXPECT_CALL(*mock_, GenerateAccessToken).WillOnce(Return(response));
+  GoldenKitchenSinkMetrics stub(mock_, metrics_);
+  grpc::ClientContext context;
+  ::google::test::admin::database::v1::GenerateAccessTokenRequest request;
+  request.set_name("test-name");
+  auto status = stub.GenerateAccessToken(context, request);
+  EXPECT_STATUS_OK(status);
+
+  auto const s = Snapshot("GoldenKitchenSink.GenerateAccessToken");
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(0, s.errors);
+  EXPECT_EQ(request.ByteSizeLong(), s.bytes_sent);
+  EXPECT_EQ(response.ByteSizeLong(), s.bytes_received);
+}
+
+TEST_F(MetricsDecoratorTest, GenerateAccessTokenError) {
+  EXPECT_CALL(*mock_, GenerateAccessToken).WillOnce(Return(TransientError()));
+  GoldenKitchenSinkMetrics stub(mock_, metrics_);
+  grpc::ClientContext context;
+  auto status = stub.GenerateAccessToken(
+      context, google::test::admin::database::v1::GenerateAccessTokenRequest());
+  EXPECT_EQ(TransientError(), status.status());
+
+  auto const s = Snapshot("GoldenKitchenSink.GenerateAccessToken");
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(1, s.errors);
+}
+
+TEST_F(MetricsDecoratorTest, WriteLogEntriesRetry) {
+  EXPECT_CALL(*mock_, WriteLogEntries)
+      .WillOnce(Return(TransientError()))
+      .WillOnce(Return(
+          google::test::admin::database::v1::WriteLogEntriesResponse{}));
+  GoldenKitchenSinkMetrics stub(mock_, metrics_);
+  for (int attempt = 0; attempt != 2; ++attempt) {
+    internal::RetryAttemptScope scope(attempt);
+    grpc::ClientContext context;
+    (void)stub.WriteLogEntries(
+        context, google::test::admin::database::v1::WriteLogEntriesRequest());
+  }
+
+  auto const s = Snapshot("GoldenKitchenSink.WriteLogEntries");
+  EXPECT_EQ(2, s.calls);
+  EXPECT_EQ(1, s.errors);
+  EXPECT_EQ(1, s.retries);
+}
+
+TEST_F(MetricsDecoratorTest, TailLogEntries) {
+  auto mock_response = absl::make_unique<MockTailLogEntriesStreamingReadRpc>();
+  EXPECT_CALL(*mock_, TailLogEntries)
+      .WillOnce(Return(ByMove(
+          std::unique_ptr<internal::StreamingReadRpc<
+              google::test::admin::database::v1::TailLogEntriesResponse>>(
+              mock_response.release()))));
+  GoldenKitchenSinkMetrics stub(mock_, metrics_);
+  auto response = stub.TailLogEntries(
+      absl::make_unique<grpc::ClientContext>(),
+      google::test::admin::database::v1::TailLogEntriesRequest());
+  EXPECT_NE(nullptr, response);
+
+  auto const s = Snapshot("GoldenKitchenSink.TailLogEntries");
+  EXPECT_EQ(1, s.calls);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/integration_tests/golden/internal/golden_kitchen_sink_round_robin_decorator.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include "generator/integration_tests/golden/mocks/mock_golden_kitchen_sink_stub.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::golden_internal::MockTailLogEntriesStreamingReadRpc;
+using ::testing::Return;
+using ::testing::Unused;
+
+class RoundRobinDecoratorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i != 3; ++i) {
+      mocks_.push_back(std::make_shared<MockGoldenKitchenSinkStub>());
+    }
+  }
+
+  std::vector<std::shared_ptr<GoldenKitchenSinkStub>> Children() const {
+    return {mocks_.begin(), mocks_.end()};
+  }
+
+  std::vector<std::shared_ptr<MockGoldenKitchenSinkStub>> mocks_;
+};
+
+TEST_F(RoundRobinDecoratorTest, GenerateAccessToken) {
+  ::google::test::admin::database::v1::GenerateAccessTokenResponse response;
+  response.set_access_token("test-token");
+  for (auto& m : mocks_) {
+    EXPECT_CALL(*m, GenerateAccessToken)
+        .Times(2)
+        .WillRepeatedly(Return(response));
+  }
+  GoldenKitchenSinkRoundRobin stub(
+      Children(), google::cloud::internal::MakeRoundRobinChannelPicker(3));
+  for (int i = 0; i != 6; ++i) {
+    grpc::ClientContext context;
+    auto status = stub.GenerateAccessToken(
+        context,
+        google::test::admin::database::v1::GenerateAccessTokenRequest());
+    ASSERT_STATUS_OK(status);
+    EXPECT_EQ("test-token", status->access_token());
+  }
+}
+
+TEST_F(RoundRobinDecoratorTest, TailLogEntries) {
+  for (auto& m : mocks_) {
+    EXPECT_CALL(*m, TailLogEntries).WillOnce([](Unused, Unused) {
+      return std::unique_ptr<internal::StreamingReadRpc<
+          google::test::admin::database::v1::TailLogEntriesResponse>>(
+          absl::make_unique<MockTailLogEntriesStreamingReadRpc>());
+    });
+  }
+  GoldenKitchenSinkRoundRobin stub(
+      Children(), google::cloud::internal::MakeRoundRobinChannelPicker(3));
+  for (int i = 0; i != 3; ++i) {
+    auto stream = stub.TailLogEntries(
+        absl::make_unique<grpc::ClientContext>(),
+        google::test::admin::database::v1::TailLogEntriesRequest());
+    EXPECT_NE(nullptr, stream);
+  }
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
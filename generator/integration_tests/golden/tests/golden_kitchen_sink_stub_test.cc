@@ -155,6 +155,26 @@ class MockGrpcGoldenKitchenSinkStub : public ::google::test::admin::database::
                    request,
                ::grpc::CompletionQueue* cq),
               (override));
+  MOCK_METHOD(
+      (::grpc::ClientReaderWriterInterface<
+          ::google::test::admin::database::v1::StreamingReadWriteRequest,
+          ::google::test::admin::database::v1::StreamingReadWriteResponse>*),
+      StreamingReadWriteRaw, (::grpc::ClientContext * context), (override));
+  MOCK_METHOD(
+      (::grpc::ClientAsyncReaderWriterInterface<
+          ::google::test::admin::database::v1::StreamingReadWriteRequest,
+          ::google::test::admin::database::v1::StreamingReadWriteResponse>*),
+      AsyncStreamingReadWriteRaw,
+      (::grpc::ClientContext * context, ::grpc::CompletionQueue* cq,
+       void* tag),
+      (override));
+  MOCK_METHOD(
+      (::grpc::ClientAsyncReaderWriterInterface<
+          ::google::test::admin::database::v1::StreamingReadWriteRequest,
+          ::google::test::admin::database::v1::StreamingReadWriteResponse>*),
+      PrepareAsyncStreamingReadWriteRaw,
+      (::grpc::ClientContext * context, ::grpc::CompletionQueue* cq),
+      (override));
   MOCK_METHOD(::grpc::Status, Omitted1,
               (::grpc::ClientContext * context,
                const ::google::protobuf::Empty& request,
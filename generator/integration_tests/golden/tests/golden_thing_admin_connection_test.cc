@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "generator/integration_tests/golden/golden_thing_admin_connection.h"
+#include "google/cloud/grpc_options.h"
 #include "google/cloud/polling_policy.h"
 #include "google/cloud/testing_util/async_sequencer.h"
 #include "google/cloud/testing_util/is_proto_equal.h"
@@ -22,6 +23,9 @@
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -39,7 +43,8 @@ using ::testing::ElementsAre;
 using ::testing::Return;
 
 std::shared_ptr<golden::GoldenThingAdminConnection> CreateTestingConnection(
-    std::shared_ptr<golden_internal::GoldenThingAdminStub> mock) {
+    std::shared_ptr<golden_internal::GoldenThingAdminStub> mock,
+    Options options = {}) {
   golden::GoldenThingAdminLimitedErrorCountRetryPolicy retry(
       /*maximum_failures=*/2);
   ExponentialBackoffPolicy backoff(
@@ -49,7 +54,6 @@ std::shared_ptr<golden::GoldenThingAdminConnection> CreateTestingConnection(
   GenericPollingPolicy<golden::GoldenThingAdminLimitedErrorCountRetryPolicy,
                        ExponentialBackoffPolicy>
       polling(retry, backoff);
-  Options options;
   options.set<golden::GoldenThingAdminRetryPolicyOption>(retry.clone());
   options.set<golden::GoldenThingAdminBackoffPolicyOption>(backoff.clone());
   options.set<golden::GoldenThingAdminPollingPolicyOption>(polling.clone());
@@ -126,6 +130,38 @@ TEST(GoldenThingAdminClientTest, ListDatabases) {
               ::testing::ElementsAre("db-1", "db-2", "db-3", "db-4", "db-5"));
 }
 
+/// @test Verify that the pages are prefetched when configured to do so.
+TEST(GoldenThingAdminClientTest, ListDatabasesPrefetch) {
+  auto mock = std::make_shared<MockGoldenThingAdminStub>();
+  EXPECT_CALL(*mock, ListDatabases)
+      .Times(5)
+      .WillRepeatedly(
+          [](grpc::ClientContext&,
+             ::google::test::admin::database::v1::ListDatabasesRequest const&
+                 request) {
+            auto const page = request.page_token().empty()
+                                  ? 0
+                                  : std::stoi(request.page_token());
+            ::google::test::admin::database::v1::ListDatabasesResponse response;
+            response.add_databases()->set_name("db-" + std::to_string(page));
+            if (page != 4) {
+              response.set_next_page_token(std::to_string(page + 1));
+            }
+            return make_status_or(response);
+          });
+  auto conn = CreateTestingConnection(
+      std::move(mock), Options{}.set<GrpcPaginationPrefetchDepthOption>(2));
+  std::vector<std::string> actual_names;
+  ::google::test::admin::database::v1::ListDatabasesRequest request;
+  request.set_parent("projects/test-project/instances/test-instance");
+  for (auto const& database : conn->ListDatabases(request)) {
+    ASSERT_STATUS_OK(database);
+    actual_names.push_back(database->name());
+  }
+  EXPECT_THAT(actual_names,
+              ElementsAre("db-0", "db-1", "db-2", "db-3", "db-4"));
+}
+
 TEST(GoldenThingAdminClientTest, ListDatabasesPermanentFailure) {
   auto mock = std::make_shared<MockGoldenThingAdminStub>();
   EXPECT_CALL(*mock, ListDatabases)
@@ -279,6 +315,42 @@ TEST(GoldenThingAdminClientTest, GetDatabaseTooManyTransients) {
   EXPECT_EQ(StatusCode::kUnavailable, response.status().code());
 }
 
+/// @test Verify that slow idempotent calls are hedged.
+TEST(GoldenThingAdminClientTest, GetDatabaseHedged) {
+  auto mock = std::make_shared<MockGoldenThingAdminStub>();
+  // The first request blocks until the hedged request completes, and returns
+  // (slowly) a cancellation error.
+  promise<void> hedge_done;
+  auto blocked = hedge_done.get_future();
+  EXPECT_CALL(*mock, GetDatabase)
+      .WillOnce([&blocked](grpc::ClientContext&,
+                           ::google::test::admin::database::v1::
+                               GetDatabaseRequest const&) {
+        blocked.get();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return StatusOr<::google::test::admin::database::v1::Database>(
+            Status(StatusCode::kCancelled, "cancelled"));
+      })
+      .WillOnce([&hedge_done](grpc::ClientContext&,
+                              ::google::test::admin::database::v1::
+                                  GetDatabaseRequest const& request) {
+        ::google::test::admin::database::v1::Database response;
+        response.set_name(request.name());
+        hedge_done.set_value();
+        return make_status_or(response);
+      });
+  auto conn = CreateTestingConnection(
+      std::move(mock),
+      Options{}.set<GrpcHedgingDelayOption>(
+          {{"GoldenThingAdmin.GetDatabase", std::chrono::milliseconds(1)}}));
+  ::google::test::admin::database::v1::GetDatabaseRequest request;
+  request.set_name(
+      "projects/test-project/instances/test-instance/databases/test-database");
+  auto response = conn->GetDatabase(request);
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(request.name(), response->name());
+}
+
 /// @test Verify that successful case works.
 TEST(GoldenThingAdminClientTest, UpdateDatabaseDdlSuccess) {
   auto mock = std::make_shared<MockGoldenThingAdminStub>();
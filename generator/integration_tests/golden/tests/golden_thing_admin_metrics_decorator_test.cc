@@ -0,0 +1,143 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/integration_tests/golden/internal/golden_thing_admin_metrics_decorator.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include "generator/integration_tests/golden/mocks/mock_golden_thing_admin_stub.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::testing::ByMove;
+using ::testing::Return;
+using ::testing::Unused;
+
+class MetricsDecoratorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock_ = std::make_shared<MockGoldenThingAdminStub>();
+    metrics_ = std::make_shared<RpcMetrics>();
+  }
+
+  static Status TransientError() {
+    return Status(StatusCode::kUnavailable, "try-again");
+  }
+
+  static future<StatusOr<google::longrunning::Operation>>
+  LongrunningTransientError(Unused, Unused, Unused) {
+    return make_ready_future(
+        StatusOr<google::longrunning::Operation>(TransientError()));
+  }
+
+  RpcMethodMetricsSnapshot Snapshot(std::string const& method) {
+    for (auto const& s : metrics_->Snapshot()) {
+      if (s.method == method) return s;
+    }
+    ADD_FAILURE() << "missing metrics for " << method;
+    return RpcMethodMetricsSnapshot{};
+  }
+
+  std::shared_ptr<MockGoldenThingAdminStub> mock_;
+  std::shared_ptr<RpcMetrics> metrics_;
+};
+
+TEST_F(MetricsDecoratorTest, GetDatabase) {
+  google::test::admin::database::v1::Database database;
+  database.set_name("my_database");
+  EXPECT_CALL(*mock_, GetDatabase).WillOnce(Return(database));
+
+  GoldenThingAdminMetrics stub(mock_, metrics_);
+  grpc::ClientContext context;
+  auto response = stub.GetDatabase(
+      context, google::test::admin::database::v1::GetDatabaseRequest());
+  EXPECT_STATUS_OK(response);
+
+  auto const s = Snapshot("GoldenThingAdmin.GetDatabase");
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(0, s.errors);
+  EXPECT_EQ(database.ByteSizeLong(), s.bytes_received);
+}
+
+TEST_F(MetricsDecoratorTest, DropDatabase) {
+  EXPECT_CALL(*mock_, DropDatabase).WillOnce(Return(TransientError()));
+
+  GoldenThingAdminMetrics stub(mock_, metrics_);
+  grpc::ClientContext context;
+  auto status = stub.DropDatabase(
+      context, google::test::admin::database::v1::DropDatabaseRequest());
+  EXPECT_EQ(TransientError(), status);
+
+  auto const s = Snapshot("GoldenThingAdmin.DropDatabase");
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(1, s.errors);
+}
+
+TEST_F(MetricsDecoratorTest, CreateDatabase) {
+  EXPECT_CALL(*mock_, AsyncCreateDatabase).WillOnce(LongrunningTransientError);
+
+  GoldenThingAdminMetrics stub(mock_, metrics_);
+  CompletionQueue cq;
+  auto status = stub.AsyncCreateDatabase(
+      cq, absl::make_unique<grpc::ClientContext>(),
+      google::test::admin::database::v1::CreateDatabaseRequest());
+  EXPECT_EQ(TransientError(), status.get().status());
+
+  auto const s = Snapshot("GoldenThingAdmin.CreateDatabase");
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(1, s.errors);
+}
+
+TEST_F(MetricsDecoratorTest, GetOperation) {
+  EXPECT_CALL(*mock_, AsyncGetOperation).WillOnce(LongrunningTransientError);
+
+  GoldenThingAdminMetrics stub(mock_, metrics_);
+  CompletionQueue cq;
+  auto status =
+      stub.AsyncGetOperation(cq, absl::make_unique<grpc::ClientContext>(),
+                             google::longrunning::GetOperationRequest());
+  EXPECT_EQ(TransientError(), status.get().status());
+
+  auto const s = Snapshot("google.longrunning.Operations.GetOperation");
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(1, s.errors);
+}
+
+TEST_F(MetricsDecoratorTest, CancelOperation) {
+  EXPECT_CALL(*mock_, AsyncCancelOperation)
+      .WillOnce(Return(ByMove(make_ready_future(Status{}))));
+
+  GoldenThingAdminMetrics stub(mock_, metrics_);
+  CompletionQueue cq;
+  auto status =
+      stub.AsyncCancelOperation(cq, absl::make_unique<grpc::ClientContext>(),
+                                google::longrunning::CancelOperationRequest());
+  EXPECT_STATUS_OK(status.get());
+
+  auto const s = Snapshot("google.longrunning.Operations.CancelOperation");
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(0, s.errors);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,115 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/integration_tests/golden/internal/golden_thing_admin_round_robin_decorator.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include "generator/integration_tests/golden/mocks/mock_golden_thing_admin_stub.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::testing::Return;
+using ::testing::Unused;
+
+class RoundRobinDecoratorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i != 2; ++i) {
+      mocks_.push_back(std::make_shared<MockGoldenThingAdminStub>());
+    }
+  }
+
+  std::vector<std::shared_ptr<GoldenThingAdminStub>> Children() const {
+    return {mocks_.begin(), mocks_.end()};
+  }
+
+  std::vector<std::shared_ptr<MockGoldenThingAdminStub>> mocks_;
+};
+
+TEST_F(RoundRobinDecoratorTest, GetDatabase) {
+  google::test::admin::database::v1::Database database;
+  database.set_name("my_database");
+  for (auto& m : mocks_) {
+    EXPECT_CALL(*m, GetDatabase).Times(2).WillRepeatedly(Return(database));
+  }
+  GoldenThingAdminRoundRobin stub(
+      Children(), google::cloud::internal::MakeRoundRobinChannelPicker(2));
+  for (int i = 0; i != 4; ++i) {
+    grpc::ClientContext context;
+    auto response = stub.GetDatabase(
+        context, google::test::admin::database::v1::GetDatabaseRequest());
+    ASSERT_STATUS_OK(response);
+    EXPECT_EQ("my_database", response->name());
+  }
+}
+
+TEST_F(RoundRobinDecoratorTest, DropDatabase) {
+  for (auto& m : mocks_) {
+    EXPECT_CALL(*m, DropDatabase).WillOnce(Return(Status()));
+  }
+  GoldenThingAdminRoundRobin stub(
+      Children(), google::cloud::internal::MakeRoundRobinChannelPicker(2));
+  for (int i = 0; i != 2; ++i) {
+    grpc::ClientContext context;
+    auto status = stub.DropDatabase(
+        context, google::test::admin::database::v1::DropDatabaseRequest());
+    EXPECT_STATUS_OK(status);
+  }
+}
+
+// With the least-outstanding picker, a pending long-running operation keeps
+// its channel busy until it completes.
+TEST_F(RoundRobinDecoratorTest, AsyncCreateDatabaseLeastOutstanding) {
+  promise<StatusOr<google::longrunning::Operation>> pending;
+  EXPECT_CALL(*mocks_[0], AsyncCreateDatabase)
+      .WillOnce([&pending](Unused, Unused, Unused) {
+        return pending.get_future();
+      });
+  EXPECT_CALL(*mocks_[1], AsyncCreateDatabase)
+      .Times(2)
+      .WillRepeatedly([](Unused, Unused, Unused) {
+        return make_ready_future(
+            make_status_or(google::longrunning::Operation{}));
+      });
+  GoldenThingAdminRoundRobin stub(
+      Children(),
+      google::cloud::internal::MakeLeastOutstandingChannelPicker(2));
+  CompletionQueue cq;
+  auto first = stub.AsyncCreateDatabase(
+      cq, absl::make_unique<grpc::ClientContext>(),
+      google::test::admin::database::v1::CreateDatabaseRequest());
+  for (int i = 0; i != 2; ++i) {
+    auto response = stub.AsyncCreateDatabase(
+                            cq, absl::make_unique<grpc::ClientContext>(),
+                            google::test::admin::database::v1::
+                                CreateDatabaseRequest())
+                        .get();
+    EXPECT_STATUS_OK(response);
+  }
+  pending.set_value(make_status_or(google::longrunning::Operation{}));
+  EXPECT_STATUS_OK(first.get());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
@@ -96,8 +96,40 @@ class $auth_class_name$ : public $stub_class_name$ {
   $method_name$(
       std::unique_ptr<grpc::ClientContext> context,
       $request_type$ const& request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>
+  Async$method_name$(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      $request_type$ const& request) override;
 )"""}},
-                       IsStreamingRead)},
+                       IsStreamingRead),
+         MethodPattern({{R"""(
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      $request_type$,
+      $response_type$>>
+  Async$method_name$(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context) override;
+)"""}},
+                       IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         R"""(
+  future<Status> Async$method_name$()""",
+                         R"""(
+  future<StatusOr<$response_type$>> Async$method_name$()"""},
+                        {R"""(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      $request_type$ const& request) override;
+)"""}},
+                       And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -202,8 +234,70 @@ $auth_class_name$::$method_name$(
   if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
   return child_->$method_name$(std::move(context), request);
 }
+
+std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>
+$auth_class_name$::Async$method_name$(
+   google::cloud::CompletionQueue& cq,
+   std::unique_ptr<grpc::ClientContext> context,
+   $request_type$ const& request) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadRpcError<
+      $response_type$>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
+  return child_->Async$method_name$(cq, std::move(context), request);
+}
+)"""}},
+                       IsStreamingRead),
+         MethodPattern({{R"""(
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    $request_type$,
+    $response_type$>>
+$auth_class_name$::Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadWriteRpcError<
+      $request_type$,
+      $response_type$>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
+  return child_->Async$method_name$(cq, std::move(context));
+}
+)"""}},
+                       IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         R"""(
+future<Status> $auth_class_name$::Async$method_name$()""",
+                         R"""(
+future<StatusOr<$response_type$>> $auth_class_name$::Async$method_name$()"""},
+                        {R"""(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      $request_type$ const& request) {)"""},
+                        {IsResponseTypeEmpty,
+                         R"""(
+  using ReturnType = Status;)""",
+                         R"""(
+  using ReturnType = StatusOr<$response_type$>;)"""},
+                        {R"""(
+  auto child = child_;
+  return auth_->AsyncConfigureContext(std::move(context)).then(
+      [cq, child, request](
+          future<StatusOr<std::unique_ptr<grpc::ClientContext>>> f) mutable {
+        auto context = f.get();
+        if (!context) {
+          return make_ready_future(ReturnType(std::move(context).status()));
+        }
+        return child->Async$method_name$(cq, *std::move(context), request);
+      });
+}
 )"""}},
-                       IsStreamingRead)},
+                       And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
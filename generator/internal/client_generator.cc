@@ -189,13 +189,57 @@ Status ClientGenerator::GenerateHeader() {
                  {FormatMethodCommentsFromRpcComments(
         method, MethodParameterStyle::kProtobufRequest)},
    {"  StreamRange<$response_type$>\n"
-    "  $method_name$($request_type$ const& request);\n\n"},
+    "  $method_name$($request_type$ const& request);\n\n"
+    "  /**\n"
+    "   * Reads the responses of `$method_name$()`, allocating each response in\n"
+    "   * its own `google::protobuf::Arena`.\n"
+    "   *\n"
+    "   * Each element owns the arena of its response. Releasing the element\n"
+    "   * releases all the memory for the response at once, which is much\n"
+    "   * cheaper than deleting large responses one field at a time.\n"
+    "   */\n"
+    "  StreamRange<std::shared_ptr<$response_type$ const>>\n"
+    "  $method_name$InArena($request_type$ const& request);\n\n"
+    "  /**\n"
+    "   * Asynchronously reads the responses of `$method_name$()`.\n"
+    "   *\n"
+    "   * @p on_read is called for each response, the next response is not read\n"
+    "   * until the future it returns is satisfied. If the value is `false` the\n"
+    "   * stream is cancelled. The stream is resumed on transient failures,\n"
+    "   * using the retry and backoff policies of the connection.\n"
+    "   */\n"
+    "  future<Status>\n"
+    "  Async$method_name$($request_type$ const& request,\n"
+    "      std::function<future<bool>($response_type$)> on_read);\n\n"},
                  // clang-format on
              },
              IsStreamingRead)},
         __FILE__, __LINE__);
   }
 
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                // clang-format off
+   {"  /**\n"
+    "   * Asynchronously calls `$method_name$()`.\n"
+    "   *\n"
+    "   * The call is retried using the policies of the connection, the\n"
+    "   * returned future is satisfied when the call completes.\n"
+    "   */\n"},
+   {IsResponseTypeEmpty,
+    "  future<Status>\n",
+    "  future<StatusOr<$response_type$>>\n"},
+   {"  Async$method_name$($request_type$ const& request);\n"
+        "\n"}
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation)))},
+        __FILE__, __LINE__);
+  }
+
   HeaderPrint(  // clang-format off
     " private:\n"
     "  std::shared_ptr<$connection_class_name$> connection_;\n");
@@ -350,6 +394,15 @@ Status ClientGenerator::GenerateCc() {
    {"StreamRange<$response_type$>\n"
     "$client_class_name$::$method_name$($request_type$ const& request) {\n"
     "  return connection_->$method_name$(request);\n"
+    "}\n\n"
+    "StreamRange<std::shared_ptr<$response_type$ const>>\n"
+    "$client_class_name$::$method_name$InArena($request_type$ const& request) {\n"
+    "  return connection_->$method_name$InArena(request);\n"
+    "}\n\n"
+    "future<Status>\n"
+    "$client_class_name$::Async$method_name$($request_type$ const& request,\n"
+    "    std::function<future<bool>($response_type$)> on_read) {\n"
+    "  return connection_->Async$method_name$(request, std::move(on_read));\n"
     "}\n\n"}
                  // clang-format on
              },
@@ -357,6 +410,24 @@ Status ClientGenerator::GenerateCc() {
         __FILE__, __LINE__);
   }
 
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+   {"$client_class_name$::Async$method_name$($request_type$ const& request) {\n"
+    "  return connection_->Async$method_name$(request);\n"
+    "}\n\n"}
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation)))},
+        __FILE__, __LINE__);
+  }
+
   CcCloseNamespaces();
   return {};
 }
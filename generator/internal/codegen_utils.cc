@@ -86,28 +86,39 @@ void ProcessArgCopyrightYear(
   }
 }
 
-void ProcessArgOmitRpc(
-    std::vector<std::pair<std::string, std::string>>& command_line_args) {
-  absl::flat_hash_set<std::string> omitted_rpcs;
+// Collects all the `single_key=value` arguments into one `plural_key` argument
+// with the values separated by commas.
+void ProcessRepeatedArg(
+    std::vector<std::pair<std::string, std::string>>& command_line_args,
+    std::string const& single_key, std::string const& plural_key) {
+  absl::flat_hash_set<std::string> values;
+  auto matches = [&single_key](std::pair<std::string, std::string> const& p) {
+    return p.first == single_key;
+  };
   auto iter = std::find_if(command_line_args.begin(), command_line_args.end(),
-                           [](std::pair<std::string, std::string> const& p) {
-                             return p.first == "omit_rpc";
-                           });
+                           matches);
   while (iter != command_line_args.end()) {
-    omitted_rpcs.insert(iter->second);
+    values.insert(iter->second);
     command_line_args.erase(iter);
     iter = std::find_if(command_line_args.begin(), command_line_args.end(),
-                        [](std::pair<std::string, std::string> const& p) {
-                          return p.first == "omit_rpc";
-                        });
+                        matches);
   }
-  if (!omitted_rpcs.empty()) {
+  if (!values.empty()) {
     command_line_args.emplace_back(
-        "omitted_rpcs",
-        absl::StrJoin(omitted_rpcs.begin(), omitted_rpcs.end(), ","));
+        plural_key, absl::StrJoin(values.begin(), values.end(), ","));
   }
 }
 
+void ProcessArgOmitRpc(
+    std::vector<std::pair<std::string, std::string>>& command_line_args) {
+  ProcessRepeatedArg(command_line_args, "omit_rpc", "omitted_rpcs");
+}
+
+void ProcessArgGenAsyncRpc(
+    std::vector<std::pair<std::string, std::string>>& command_line_args) {
+  ProcessRepeatedArg(command_line_args, "gen_async_rpc", "gen_async_rpcs");
+}
+
 }  // namespace
 std::string CurrentCopyrightYear() {
   static std::string const kCurrentCopyrightYear =
@@ -197,6 +208,7 @@ ProcessCommandLineArgs(std::string const& parameters) {
 
   ProcessArgCopyrightYear(command_line_args);
   ProcessArgOmitRpc(command_line_args);
+  ProcessArgGenAsyncRpc(command_line_args);
   return command_line_args;
 }
 
@@ -25,7 +25,12 @@ namespace {
 
 using ::google::cloud::testing_util::IsOk;
 using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::AnyOf;
+using ::testing::Contains;
 using ::testing::ElementsAre;
+using ::testing::Not;
+using ::testing::Pair;
 
 TEST(LocalInclude, Success) {
   EXPECT_EQ("#include \"google/cloud/status.h\"\n",
@@ -227,6 +232,17 @@ TEST(ProcessCommandLineArgs, CopyrightYearWithValue) {
   EXPECT_EQ(result->back().second, "1995");
 }
 
+TEST(ProcessCommandLineArgs, GenAsyncRpcs) {
+  auto result = ProcessCommandLineArgs(
+      "product_path=google/cloud/pubsub/,googleapis_commit_hash=foo"
+      ",gen_async_rpc=Publish,gen_async_rpc=Pull,omit_rpc=Acknowledge");
+  ASSERT_THAT(result, IsOk());
+  EXPECT_THAT(*result, Contains(Pair("omitted_rpcs", "Acknowledge")));
+  EXPECT_THAT(*result, Contains(Pair("gen_async_rpcs",
+                                     AnyOf("Publish,Pull", "Pull,Publish"))));
+  EXPECT_THAT(*result, Not(Contains(Pair("gen_async_rpc", _))));
+}
+
 }  // namespace
 }  // namespace generator_internal
 }  // namespace cloud
@@ -20,10 +20,36 @@
 #include "generator/internal/printer.h"
 #include <google/api/client.pb.h>
 #include <google/protobuf/descriptor.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
 namespace generator_internal {
+namespace {
+
+// Returns true if any of the methods uses `google::cloud::internal::RetryLoop`.
+bool HasRetryLoopMethod(
+    std::vector<std::reference_wrapper<
+        google::protobuf::MethodDescriptor const>> const& methods) {
+  return std::any_of(methods.begin(), methods.end(),
+                     [](google::protobuf::MethodDescriptor const& m) {
+                       return IsNonStreaming(m) && !IsLongrunningOperation(m);
+                     });
+}
+
+// Returns true if any of the methods may use hedged requests, these are the
+// `RetryLoop` methods that are not paginated.
+bool HasHedgedMethod(
+    std::vector<std::reference_wrapper<
+        google::protobuf::MethodDescriptor const>> const& methods) {
+  return std::any_of(methods.begin(), methods.end(),
+                     [](google::protobuf::MethodDescriptor const& m) {
+                       return IsNonStreaming(m) && !IsLongrunningOperation(m) &&
+                              !IsPaginated(m);
+                     });
+}
+
+}  // namespace
 
 ConnectionGenerator::ConnectionGenerator(
     google::protobuf::ServiceDescriptor const* service_descriptor,
@@ -49,7 +75,9 @@ Status ConnectionGenerator::GenerateHeader() {
   HeaderLocalIncludes(
       {vars("idempotency_policy_header_path"), vars("stub_header_path"),
        vars("retry_traits_header_path"), "google/cloud/backoff_policy.h",
-       HasLongrunningMethod() ? "google/cloud/future.h" : "",
+       HasLongrunningMethod() || HasStreamingReadMethod() || HasAsyncMethod()
+           ? "google/cloud/future.h"
+           : "",
        "google/cloud/options.h",
        HasLongrunningMethod() ? "google/cloud/polling_policy.h" : "",
        "google/cloud/status_or.h",
@@ -59,7 +87,7 @@ Status ConnectionGenerator::GenerateHeader() {
        "google/cloud/version.h"});
   HeaderSystemIncludes(
       {HasLongrunningMethod() ? "google/longrunning/operations.grpc.pb.h" : "",
-       "memory"});
+       HasStreamingReadMethod() ? "functional" : "", "memory"});
   HeaderPrint("\n");
 
   auto result = HeaderOpenNamespaces();
@@ -138,10 +166,42 @@ Status ConnectionGenerator::GenerateHeader() {
              {
                  // clang-format off
    {"  virtual StreamRange<$response_type$>\n"
-    "  $method_name$($request_type$ const& request);\n\n"},
+    "  $method_name$($request_type$ const& request);\n\n"
+    "  virtual StreamRange<std::shared_ptr<$response_type$ const>>\n"
+    "  $method_name$InArena($request_type$ const& request);\n\n"
+    "  virtual future<Status>\n"
+    "  Async$method_name$($request_type$ const& request,\n"
+    "      std::function<future<bool>($response_type$)> on_read);\n\n"},
+                 // clang-format on
+             },
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  virtual std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$();\n\n"},
                  // clang-format on
              },
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "  virtual future<Status>\n",
+    "  virtual future<StatusOr<$response_type$>>\n"},
+   {"  Async$method_name$($request_type$ const& request);\n"
+        "\n",}
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -191,14 +251,22 @@ Status ConnectionGenerator::GenerateCc() {
        HasLongrunningMethod()
            ? "google/cloud/internal/async_long_running_operation.h"
            : "",
+       HasStreamingReadMethod()
+           ? "google/cloud/internal/async_resumable_streaming_read.h"
+           : "",
        HasStreamingReadMethod()
            ? "google/cloud/internal/resumable_streaming_read_rpc.h"
            : "",
+       HasAsyncMethod() ? "google/cloud/internal/async_retry_loop.h" : "",
+       HasHedgedMethod(methods()) ? "google/cloud/internal/grpc_compression.h"
+                                  : "",
+       HasHedgedMethod(methods()) ? "google/cloud/internal/hedged_call.h" : "",
        "google/cloud/internal/retry_loop.h",
        HasStreamingReadMethod()
            ? "google/cloud/internal/streaming_read_rpc_logging.h"
            : ""});
-  CcSystemIncludes({"memory"});
+  CcSystemIncludes({HasHedgedMethod(methods()) ? "map" : "", "memory",
+                    HasHedgedMethod(methods()) ? "string" : ""});
   CcPrint("\n");
 
   auto result = CcOpenNamespaces();
@@ -272,11 +340,67 @@ Status ConnectionGenerator::GenerateCc() {
     "      $response_type$>{\n"
     "        return Status(StatusCode::kUnimplemented, \"not implemented\");}\n"
     "      );\n"
+    "}\n\n"
+    "StreamRange<std::shared_ptr<$response_type$ const>>\n"
+    "$connection_class_name$::$method_name$InArena(\n"
+    "    $request_type$ const&) {\n"
+    "  return google::cloud::internal::MakeStreamRange<\n"
+    "      std::shared_ptr<$response_type$ const>>(\n"
+    "      []() -> absl::variant<Status,\n"
+    "      std::shared_ptr<$response_type$ const>>{\n"
+    "        return Status(StatusCode::kUnimplemented, \"not implemented\");}\n"
+    "      );\n"
+    "}\n\n"
+    "future<Status> $connection_class_name$::Async$method_name$(\n"
+    "    $request_type$ const&,\n"
+    "    std::function<future<bool>($response_type$)>) {\n"
+    "  return google::cloud::make_ready_future(\n"
+    "    Status(StatusCode::kUnimplemented, \"not implemented\"));\n"
+    "}\n\n"
+                     // clang-format on
+                 },
+             },
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "$connection_class_name$::Async$method_name$() {\n"
+    "  return absl::make_unique<internal::AsyncStreamingReadWriteRpcError<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>(\n"
+    "      Status(StatusCode::kUnimplemented, \"not implemented\"));\n"
     "}\n\n"
                      // clang-format on
                  },
              },
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+   {"$connection_class_name$::Async$method_name$(\n"
+    "    $request_type$ const&) {\n"},
+   {IsResponseTypeEmpty,
+    "  return google::cloud::make_ready_future(\n",
+    "  return google::cloud::make_ready_future<\n"
+    "    StatusOr<$response_type$>>(\n"},
+   {"    Status(StatusCode::kUnimplemented, \"not implemented\"));\n"
+    "}\n\n"
+    },
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -305,6 +429,23 @@ Status ConnectionGenerator::GenerateCc() {
         "polling_policy_prototype_(options.get<$service_name$"
         "PollingPolicyOption>()->clone()),\n",
         ""},
+       {[this] { return HasPaginatedMethod(); },
+        "        "
+        "page_prefetch_depth_(options.get<GrpcPaginationPrefetchDepthOption>"
+        "()),\n",
+        ""},
+       {[this] { return HasRetryLoopMethod(methods()); },
+        "        "
+        "attempt_timeout_(options.get<GrpcAttemptTimeoutOption>()),\n",
+        ""},
+       {[this] { return HasHedgedMethod(methods()); },
+        "        "
+        "hedging_delays_(options.get<GrpcHedgingDelayOption>()),\n",
+        ""},
+       {[this] { return HasHedgedMethod(methods()); },
+        "        "
+        "compression_(options.get<GrpcCompressionOption>()),\n",
+        ""},
        {"        "
         "idempotency_policy_(options.get<$idempotency_class_name$Option>()->"
         "clone()) {}\n"
@@ -323,14 +464,23 @@ Status ConnectionGenerator::GenerateCc() {
     "  StatusOr<$response_type$>\n"},
    {"  $method_name$(\n"
     "      $request_type$ const& request) override {\n"
+    "    auto const idempotency = idempotency_policy_->$method_name$(request);\n"
     "    return google::cloud::internal::RetryLoop(\n"
-    "        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),\n"
-    "        idempotency_policy_->$method_name$(request),\n"
-    "        [this](grpc::ClientContext& context,\n"
-    "            $request_type$ const& request) {\n"
-    "          return stub_->$method_name$(context, request);\n"
-    "        },\n"
-    "        request, __func__);\n"
+    "        retry_policy_prototype_->clone(), *backoff_policy_prototype_,\n"
+    "        idempotency,\n"
+    "        google::cloud::internal::MakeHedgedFunctor(\n"
+    "            background_->cq(),\n"
+    "            google::cloud::internal::HedgingDelay(\n"
+    "                hedging_delays_, \"$service_name$.$method_name$\",\n"
+    "                idempotency),\n"
+    "            [this](grpc::ClientContext& context,\n"
+    "                $request_type$ const& request) {\n"
+    "              google::cloud::internal::ConfigureCompression(\n"
+    "                  context, compression_, \"$service_name$.$method_name$\",\n"
+    "                  request);\n"
+    "              return stub_->$method_name$(context, request);\n"
+    "            }),\n"
+    "        request, __func__, attempt_timeout_);\n"
     "}\n"
     "\n",}
                  // clang-format on
@@ -391,26 +541,30 @@ Status ConnectionGenerator::GenerateCc() {
     "    auto backoff = std::shared_ptr<BackoffPolicy const>(\n"
     "        backoff_policy_prototype_->clone());\n"
     "    auto idempotency = idempotency_policy_->$method_name$(request);\n"
+    "    auto attempt_timeout = attempt_timeout_;\n"
     "    char const* function_name = __func__;\n"
     "    return google::cloud::internal::MakePaginationRange<StreamRange<\n"
     "        $range_output_type$>>(\n"
     "        std::move(request),\n"
-    "        [stub, retry, backoff, idempotency, function_name]\n"
+    "        [stub, retry, backoff, idempotency, attempt_timeout, function_name]\n"
     "          ($request_type$ const& r) {\n"
     "          return google::cloud::internal::RetryLoop(\n"
-    "              retry->clone(), backoff->clone(), idempotency,\n"
+    "              retry->clone(), *backoff, idempotency,\n"
     "              [stub](grpc::ClientContext& context,\n"
     "                     $request_type$ const& request) {\n"
     "                return stub->$method_name$(context, request);\n"
     "              },\n"
-    "              r, function_name);\n"
+    "              r, function_name, attempt_timeout);\n"
     "        },\n"
     "        []($response_type$ r) {\n"
     "          std::vector<$range_output_type$> result(r.$range_output_field_name$().size());\n"
     "          auto& messages = *r.mutable_$range_output_field_name$();\n"
     "          std::move(messages.begin(), messages.end(), result.begin());\n"
     "          return result;\n"
-    "        });\n"
+    "        },\n"
+    "        page_prefetch_depth_,\n"
+    "        google::cloud::internal::MakeCompletionQueueExecutor(\n"
+    "            background_->cq()));\n"
     "  }\n\n"
                      // clang-format on
                  },
@@ -446,11 +600,104 @@ Status ConnectionGenerator::GenerateCc() {
     "    return internal::MakeStreamRange(internal::StreamReader<\n"
     "        $response_type$>(\n"
     "        [resumable]{return resumable->Read();}));\n"
+    "  }\n\n"
+    "  StreamRange<std::shared_ptr<$response_type$ const>>\n"
+    "  $method_name$InArena(\n"
+    "      $request_type$ const& request) override {\n"
+    "    auto stub = stub_;\n"
+    "    auto retry_policy =\n"
+    "        std::shared_ptr<$retry_policy_name$ const>(\n"
+    "            retry_policy_prototype_->clone());\n"
+    "    auto backoff_policy = std::shared_ptr<BackoffPolicy const>(\n"
+    "        backoff_policy_prototype_->clone());\n"
+    "\n"
+    "    auto factory = [stub](\n"
+    "        $request_type$ const& request) {\n"
+    "      return stub->$method_name$(absl::make_unique<grpc::ClientContext>(),\n"
+    "          request);\n"
+    "    };\n"
+    "\n"
+    "    auto resumable =\n"
+    "        internal::MakeResumableStreamingReadRpc<\n"
+    "            $response_type$,\n"
+    "            $request_type$>(\n"
+    "                retry_policy->clone(), backoff_policy->clone(),\n"
+    "                [](std::chrono::milliseconds) {}, factory,\n"
+    "                $service_name$$method_name$StreamingUpdater,\n"
+    "                request);\n"
+    "\n"
+    "    return internal::MakeStreamRange(internal::StreamReader<\n"
+    "        std::shared_ptr<$response_type$ const>>(\n"
+    "        [resumable]{return resumable->ReadInArena();}));\n"
+    "  }\n\n"
+    "  future<Status> Async$method_name$(\n"
+    "      $request_type$ const& request,\n"
+    "      std::function<future<bool>($response_type$)> on_read) override {\n"
+    "    auto stub = stub_;\n"
+    "    return internal::AsyncResumableStreamingRead<\n"
+    "        $response_type$,\n"
+    "        $request_type$,\n"
+    "        $retry_policy_name$, BackoffPolicy>(\n"
+    "            background_->cq(), retry_policy_prototype_->clone(),\n"
+    "            backoff_policy_prototype_->clone(),\n"
+    "            [stub](google::cloud::CompletionQueue& cq,\n"
+    "                   $request_type$ const& request) {\n"
+    "              return stub->Async$method_name$(\n"
+    "                  cq, absl::make_unique<grpc::ClientContext>(), request);\n"
+    "            },\n"
+    "            $service_name$$method_name$StreamingUpdater,\n"
+    "            request, std::move(on_read));\n"
+    "  }\n\n"
+                     // clang-format on
+                 },
+             },
+             IsStreamingRead),
+         // The meaning of the requests and responses in a bidirectional stream
+         // is service specific, so the streams are neither retried nor resumed.
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$() override {\n"
+    "    auto cq = background_->cq();\n"
+    "    return stub_->Async$method_name$(\n"
+    "        cq, absl::make_unique<grpc::ClientContext>());\n"
     "  }\n\n"
                      // clang-format on
                  },
              },
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "  future<Status>\n",
+    "  future<StatusOr<$response_type$>>\n"},
+   {"  Async$method_name$(\n"
+    "      $request_type$ const& request) override {\n"
+    "    auto stub = stub_;\n"
+    "    return google::cloud::internal::AsyncRetryLoop(\n"
+    "        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),\n"
+    "        idempotency_policy_->$method_name$(request), background_->cq(),\n"
+    "        [stub](google::cloud::CompletionQueue& cq,\n"
+    "               std::unique_ptr<grpc::ClientContext> context,\n"
+    "               $request_type$ const& request) {\n"
+    "          return stub->Async$method_name$(cq, std::move(context), request);\n"
+    "        },\n"
+    "        request, __func__, attempt_timeout_);\n"
+    "  }\n"
+    "\n",}
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -466,6 +713,15 @@ Status ConnectionGenerator::GenerateCc() {
     "  std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;\n"},
    {[this]{return HasLongrunningMethod();},
     "  std::unique_ptr<PollingPolicy const> polling_policy_prototype_;\n", ""},
+   {[this]{return HasPaginatedMethod();},
+    "  std::size_t page_prefetch_depth_;\n", ""},
+   {[this]{return HasRetryLoopMethod(methods());},
+    "  std::chrono::milliseconds attempt_timeout_;\n", ""},
+   {[this]{return HasHedgedMethod(methods());},
+    "  std::map<std::string, std::chrono::milliseconds> hedging_delays_;\n",
+    ""},
+   {[this]{return HasHedgedMethod(methods());},
+    "  std::map<std::string, std::size_t> compression_;\n", ""},
    {"  std::unique_ptr<$idempotency_class_name$> idempotency_policy_;\n"
     "};\n"}});
   // clang-format on
@@ -23,14 +23,17 @@
 #include "generator/internal/client_generator.h"
 #include "generator/internal/codegen_utils.h"
 #include "generator/internal/connection_generator.h"
+#include "generator/internal/fake_server_generator.h"
 #include "generator/internal/idempotency_policy_generator.h"
 #include "generator/internal/logging_decorator_generator.h"
 #include "generator/internal/metadata_decorator_generator.h"
+#include "generator/internal/metrics_decorator_generator.h"
 #include "generator/internal/mock_connection_generator.h"
 #include "generator/internal/option_defaults_generator.h"
 #include "generator/internal/options_generator.h"
 #include "generator/internal/predicate_utils.h"
 #include "generator/internal/retry_policy_generator.h"
+#include "generator/internal/round_robin_decorator_generator.h"
 #include "generator/internal/stub_factory_generator.h"
 #include "generator/internal/stub_generator.h"
 #include <google/api/client.pb.h>
@@ -428,6 +431,11 @@ VarsDictionary CreateServiceVars(
       absl::StrCat(descriptor.name(), "ConnectionOptions");
   vars["connection_options_traits_name"] =
       absl::StrCat(descriptor.name(), "ConnectionOptionsTraits");
+  vars["fake_server_class_name"] =
+      absl::StrCat("Fake", descriptor.name(), "Server");
+  vars["fake_server_header_path"] =
+      absl::StrCat(vars["product_path"], "mocks/fake_",
+                   ServiceNameToFilePath(descriptor.name()), "_server.h");
   vars["grpc_stub_fqn"] = ProtoNameToCppName(descriptor.full_name());
   vars["idempotency_class_name"] =
       absl::StrCat(descriptor.name(), "ConnectionIdempotencyPolicy");
@@ -462,6 +470,13 @@ VarsDictionary CreateServiceVars(
   vars["metadata_header_path"] = absl::StrCat(
       vars["product_path"], "internal/",
       ServiceNameToFilePath(descriptor.name()), "_metadata_decorator.h");
+  vars["metrics_class_name"] = absl::StrCat(descriptor.name(), "Metrics");
+  vars["metrics_cc_path"] = absl::StrCat(
+      vars["product_path"], "internal/",
+      ServiceNameToFilePath(descriptor.name()), "_metrics_decorator.cc");
+  vars["metrics_header_path"] = absl::StrCat(
+      vars["product_path"], "internal/",
+      ServiceNameToFilePath(descriptor.name()), "_metrics_decorator.h");
   vars["mock_connection_class_name"] =
       absl::StrCat("Mock", descriptor.name(), "Connection");
   vars["mock_connection_header_path"] =
@@ -486,6 +501,14 @@ VarsDictionary CreateServiceVars(
   vars["retry_traits_name"] = absl::StrCat(descriptor.name(), "RetryTraits");
   vars["retry_traits_header_path"] =
       absl::StrCat(vars["product_path"], "retry_traits", ".h");
+  vars["round_robin_class_name"] =
+      absl::StrCat(descriptor.name(), "RoundRobin");
+  vars["round_robin_cc_path"] = absl::StrCat(
+      vars["product_path"], "internal/",
+      ServiceNameToFilePath(descriptor.name()), "_round_robin_decorator.cc");
+  vars["round_robin_header_path"] = absl::StrCat(
+      vars["product_path"], "internal/",
+      ServiceNameToFilePath(descriptor.name()), "_round_robin_decorator.h");
   vars["service_endpoint"] =
       descriptor.options().GetExtension(google::api::default_host);
   vars["service_endpoint_env_var"] = absl::StrCat(
@@ -552,39 +575,36 @@ std::vector<std::unique_ptr<GeneratorInterface>> MakeGenerators(
     std::vector<std::pair<std::string, std::string>> const& vars) {
   std::vector<std::unique_ptr<GeneratorInterface>> code_generators;
   VarsDictionary service_vars = CreateServiceVars(*service, vars);
+  // The method vars are the same for all the generators, compute them once.
+  auto const method_vars = CreateMethodVars(*service, service_vars);
   code_generators.push_back(absl::make_unique<ClientGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<ConnectionGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<IdempotencyPolicyGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<AuthDecoratorGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<LoggingDecoratorGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<MetadataDecoratorGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
+  code_generators.push_back(absl::make_unique<MetricsDecoratorGenerator>(
+      service, service_vars, method_vars, context));
+  code_generators.push_back(absl::make_unique<RoundRobinDecoratorGenerator>(
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<MockConnectionGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
+  code_generators.push_back(absl::make_unique<FakeServerGenerator>(
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<OptionDefaultsGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<OptionsGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<StubGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   code_generators.push_back(absl::make_unique<StubFactoryGenerator>(
-      service, service_vars, CreateMethodVars(*service, service_vars),
-      context));
+      service, service_vars, method_vars, context));
   return code_generators;
 }
 
@@ -205,6 +205,9 @@ INSTANTIATE_TEST_SUITE_P(
                        "FrobberServiceConnectionOptions"),
         std::make_pair("connection_options_traits_name",
                        "FrobberServiceConnectionOptionsTraits"),
+        std::make_pair("fake_server_class_name", "FakeFrobberServiceServer"),
+        std::make_pair("fake_server_header_path",
+                       "google/cloud/frobber/mocks/fake_frobber_server.h"),
         std::make_pair("grpc_stub_fqn",
                        "google::cloud::frobber::v1::FrobberService"),
         std::make_pair("idempotency_class_name",
@@ -233,6 +236,13 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_pair("metadata_header_path",
                        "google/cloud/frobber/internal/"
                        "frobber_metadata_decorator.h"),
+        std::make_pair("metrics_class_name", "FrobberServiceMetrics"),
+        std::make_pair("metrics_cc_path",
+                       "google/cloud/frobber/internal/"
+                       "frobber_metrics_decorator.cc"),
+        std::make_pair("metrics_header_path",
+                       "google/cloud/frobber/internal/"
+                       "frobber_metrics_decorator.h"),
         std::make_pair("mock_connection_class_name",
                        "MockFrobberServiceConnection"),
         std::make_pair("mock_connection_header_path",
@@ -256,6 +266,13 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_pair("retry_traits_name", "FrobberServiceRetryTraits"),
         std::make_pair("retry_traits_header_path",
                        "google/cloud/frobber/retry_traits.h"),
+        std::make_pair("round_robin_class_name", "FrobberServiceRoundRobin"),
+        std::make_pair("round_robin_cc_path",
+                       "google/cloud/frobber/internal/"
+                       "frobber_round_robin_decorator.cc"),
+        std::make_pair("round_robin_header_path",
+                       "google/cloud/frobber/internal/"
+                       "frobber_round_robin_decorator.h"),
         std::make_pair("service_endpoint", ""),
         std::make_pair("service_endpoint_env_var",
                        "GOOGLE_CLOUD_CPP_FROBBER_SERVICE_ENDPOINT"),
@@ -0,0 +1,229 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/internal/fake_server_generator.h"
+#include "generator/internal/codegen_utils.h"
+#include "generator/internal/descriptor_utils.h"
+#include "generator/internal/predicate_utils.h"
+#include "generator/internal/printer.h"
+#include <google/protobuf/descriptor.h>
+
+namespace google {
+namespace cloud {
+namespace generator_internal {
+
+FakeServerGenerator::FakeServerGenerator(
+    google::protobuf::ServiceDescriptor const* service_descriptor,
+    VarsDictionary service_vars,
+    std::map<std::string, VarsDictionary> service_method_vars,
+    google::protobuf::compiler::GeneratorContext* context)
+    : ServiceCodeGenerator("fake_server_header_path", service_descriptor,
+                           std::move(service_vars),
+                           std::move(service_method_vars), context) {}
+
+Status FakeServerGenerator::GenerateHeader() {
+  HeaderPrint(CopyrightLicenseFileHeader());
+  HeaderPrint(  // clang-format off
+    "// Generated by the Codegen C++ plugin.\n"
+    "// If you make any local changes, they will be lost.\n"
+    "// source: $proto_file_name$\n"
+    "#ifndef $header_include_guard$\n"
+    "#define $header_include_guard$\n"
+    "\n");
+  // clang-format on
+
+  // includes
+  HeaderLocalIncludes({"google/cloud/testing_util/fake_server_behavior.h",
+                       "google/cloud/version.h"});
+  HeaderSystemIncludes({vars("proto_grpc_header_path"), "utility"});
+  HeaderPrint("\n");
+
+  auto result = HeaderOpenNamespaces(NamespaceType::kMocks);
+  if (!result.ok()) return result;
+
+  HeaderPrint(  // clang-format off
+    "/**\n"
+    " * An in-process fake for `$service_name$`.\n"
+    " *\n"
+    " * Register this class with a `testing_util::EmbeddedGrpcServer` to\n"
+    " * benchmark or test the client library with the full gRPC stack. Each RPC\n"
+    " * simulates the latency and errors configured in its\n"
+    " * `testing_util::FakeServerBehavior`, and returns a canned response, which\n"
+    " * includes a payload of the configured size.\n"
+    " *\n"
+    " * The canned responses must be changed before the server starts.\n"
+    " */\n"
+    "class $fake_server_class_name$ : public $grpc_stub_fqn$::Service {\n"
+    " public:\n"
+    "  explicit $fake_server_class_name$(testing_util::FakeServerConfig config = {})\n"
+    "      : behavior_(std::move(config)) {\n");
+  // clang-format on
+
+  for (auto const& method : methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                // clang-format off
+   {"    behavior_.FillPayload($method_name_snake$_response_);\n"},
+                // clang-format on
+            },
+            Any(IsNonStreaming, IsStreamingRead, IsBidirStreaming))},
+        __FILE__, __LINE__);
+  }
+
+  HeaderPrint(  // clang-format off
+    "  }\n\n"
+    "  testing_util::FakeServerBehavior& behavior() { return behavior_; }\n\n");
+  // clang-format on
+
+  for (auto const& method : methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+             {
+                 // clang-format off
+   {"  void set_$method_name_snake$_response($response_type$ response) {\n"
+    "    $method_name_snake$_response_ = std::move(response);\n"
+    "  }\n\n"
+    "  grpc::Status $method_name$(\n"
+    "      grpc::ServerContext*, $request_type$ const*,\n"
+    "      $response_type$* response) override {\n"
+    "    auto status = behavior_.Simulate();\n"
+    "    if (status.ok()) *response = $method_name_snake$_response_;\n"
+    "    return status;\n"
+    "  }\n\n"},
+                 // clang-format on
+             },
+             All(IsNonStreaming, Not(IsLongrunningOperation))),
+         MethodPattern(
+             {
+                 {IsLongrunningMetadataTypeUsedAsResponse,
+                  // clang-format off
+   "  void set_$method_name_snake$_response(\n"
+    "      $longrunning_deduced_response_type$ response) {\n"
+    "    $method_name_snake$_response_ = std::move(response);\n"
+    "  }\n\n"
+    "  grpc::Status $method_name$(\n"
+    "      grpc::ServerContext*, $request_type$ const*,\n"
+    "      google::longrunning::Operation* response) override {\n"
+    "    auto status = behavior_.Simulate();\n"
+    "    if (!status.ok()) return status;\n"
+    "    response->set_name(\"operations/$method_name_snake$\");\n"
+    "    response->set_done(true);\n"
+    "    response->mutable_metadata()->PackFrom($method_name_snake$_response_);\n"
+    "    return status;\n"
+    "  }\n\n",
+   "  void set_$method_name_snake$_response(\n"
+    "      $longrunning_deduced_response_type$ response) {\n"
+    "    $method_name_snake$_response_ = std::move(response);\n"
+    "  }\n\n"
+    "  grpc::Status $method_name$(\n"
+    "      grpc::ServerContext*, $request_type$ const*,\n"
+    "      google::longrunning::Operation* response) override {\n"
+    "    auto status = behavior_.Simulate();\n"
+    "    if (!status.ok()) return status;\n"
+    "    response->set_name(\"operations/$method_name_snake$\");\n"
+    "    response->set_done(true);\n"
+    "    response->mutable_response()->PackFrom($method_name_snake$_response_);\n"
+    "    return status;\n"
+    "  }\n\n"},
+                 // clang-format on
+             },
+             IsLongrunningOperation),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  void set_$method_name_snake$_response($response_type$ response) {\n"
+    "    $method_name_snake$_response_ = std::move(response);\n"
+    "  }\n\n"
+    "  grpc::Status $method_name$(\n"
+    "      grpc::ServerContext*, $request_type$ const*,\n"
+    "      grpc::ServerWriter<$response_type$>* writer) override {\n"
+    "    auto status = behavior_.Simulate();\n"
+    "    if (!status.ok()) return status;\n"
+    "    for (int i = 0; i != behavior_.config().stream_messages; ++i) {\n"
+    "      if (!writer->Write($method_name_snake$_response_)) break;\n"
+    "    }\n"
+    "    return status;\n"
+    "  }\n\n"},
+                 // clang-format on
+             },
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  void set_$method_name_snake$_response($response_type$ response) {\n"
+    "    $method_name_snake$_response_ = std::move(response);\n"
+    "  }\n\n"
+    "  grpc::Status $method_name$(\n"
+    "      grpc::ServerContext*,\n"
+    "      grpc::ServerReaderWriter<$response_type$,\n"
+    "          $request_type$>* stream) override {\n"
+    "    $request_type$ request;\n"
+    "    while (stream->Read(&request)) {\n"
+    "      auto status = behavior_.Simulate();\n"
+    "      if (!status.ok()) return status;\n"
+    "      if (!stream->Write($method_name_snake$_response_)) break;\n"
+    "    }\n"
+    "    return grpc::Status::OK;\n"
+    "  }\n\n"},
+                 // clang-format on
+             },
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  HeaderPrint(  // clang-format off
+    " private:\n"
+    "  testing_util::FakeServerBehavior behavior_;\n");
+  // clang-format on
+
+  for (auto const& method : methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+             {
+                 // clang-format off
+   {"  $longrunning_deduced_response_type$ $method_name_snake$_response_;\n"},
+                 // clang-format on
+             },
+             IsLongrunningOperation),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  $response_type$ $method_name_snake$_response_;\n"},
+                 // clang-format on
+             },
+             Not(IsLongrunningOperation))},
+        __FILE__, __LINE__);
+  }
+
+  HeaderPrint(  // clang-format off
+    "};\n\n");
+  // clang-format on
+
+  HeaderCloseNamespaces();
+  // close header guard
+  HeaderPrint(  // clang-format off
+    "#endif  // $header_include_guard$\n");
+  // clang-format on
+  return {};
+}
+
+Status FakeServerGenerator::GenerateCc() { return {}; }
+
+}  // namespace generator_internal
+}  // namespace cloud
+}  // namespace google
@@ -95,9 +95,42 @@ Status LoggingDecoratorGenerator::GenerateHeader() {
     "  $method_name$(\n"
     "    std::unique_ptr<grpc::ClientContext> context,\n"
     "    $request_type$ const& request) override;\n"
+    "\n"
+    "  std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+               // clang-format on
+               "\n"}},
+             IsStreamingRead),
+         MethodPattern(
+             {// clang-format off
+   {"  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context) override;\n"
                // clang-format on
                "\n"}},
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  future<Status> Async$method_name$(\n",
+    "  future<StatusOr<$response_type$>> Async$method_name$(\n"},
+   {"    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+                         // clang-format on
+                         "\n"}},
+                       And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -228,9 +261,72 @@ $logging_class_name$::Async$method_name$(
                "      std::move(context), request, __func__, "
                "tracing_options_);\n"
                "}\n"
+               "\n"
+               "std::unique_ptr<internal::AsyncStreamingReadRpc<"
+               "$response_type$>>\n"
+               "$logging_class_name$::Async$method_name$(\n"
+               "    google::cloud::CompletionQueue& cq,\n"
+               "    std::unique_ptr<grpc::ClientContext> context,\n"
+               "    $request_type$ const& request) {\n"
+               "  return google::cloud::internal::LogWrapper(\n"
+               "      [this](google::cloud::CompletionQueue& cq,\n"
+               "             std::unique_ptr<grpc::ClientContext> context,\n"
+               "             $request_type$ const& request) {\n"
+               "        return child_->Async$method_name$(\n"
+               "            cq, std::move(context), request);\n"
+               "      },\n"
+               "      cq, std::move(context), request, __func__, "
+               "tracing_options_);\n"
+               "}\n"
                "\n"}},
              // clang-format on
-             IsStreamingRead)},
+             IsStreamingRead),
+         MethodPattern(
+             {// clang-format off
+   {"std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "$logging_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) {\n"
+    // The requests are written after the stream starts, only the start of the
+    // stream is logged.
+    "  GCP_LOG(DEBUG) << __func__ << \"() << (void)\";\n"
+    "  auto stream = child_->Async$method_name$(cq, std::move(context));\n"
+    "  GCP_LOG(DEBUG) << __func__ << \"() >> \"\n"
+    "                 << (stream ? \"not null\" : \"null\");\n"
+    "  return stream;\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+    {
+    "$logging_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return google::cloud::internal::LogWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context,\n"
+    "             $request_type$ const& request) {\n"
+    "        return child_->Async$method_name$(cq, std::move(context), request);\n"
+    "      },\n"
+    "      cq, std::move(context), request, __func__, tracing_options_);\n"
+    "}\n"
+    "\n"}},
+            // clang-format on
+            And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -91,9 +91,42 @@ Status MetadataDecoratorGenerator::GenerateHeader() {
     "    $method_name$(\n"
     "    std::unique_ptr<grpc::ClientContext> context,\n"
     "    $request_type$ const& request) override;\n"
+    "\n"
+    "  std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>\n"
+    "    Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+               // clang-format on
+               "\n"}},
+             IsStreamingRead),
+         MethodPattern(
+             {// clang-format off
+   {"  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context) override;\n"
                // clang-format on
                "\n"}},
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  future<Status> Async$method_name$(\n",
+    "  future<StatusOr<$response_type$>> Async$method_name$(\n"},
+   {"    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+                         // clang-format on
+                         "\n"}},
+                       And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -115,6 +148,7 @@ Status MetadataDecoratorGenerator::GenerateHeader() {
     " private:\n"
     "  void SetMetadata(grpc::ClientContext& context,\n"
     "                   std::string const& request_params);\n"
+    "  void SetMetadata(grpc::ClientContext& context);\n"
     "  std::shared_ptr<$stub_class_name$> child_;\n"
     "  std::string api_client_header_;\n"
     "};  // $metadata_class_name$\n"
@@ -140,6 +174,9 @@ Status MetadataDecoratorGenerator::GenerateCc() {
   // includes
   CcLocalIncludes({vars("metadata_header_path"),
                    "google/cloud/internal/api_client_header.h",
+                   HasStreamingReadMethod() || HasBidirStreamingMethod()
+                       ? "google/cloud/internal/grpc_trace_context.h"
+                       : "",
                    "google/cloud/status_or.h"});
   CcSystemIncludes({vars("proto_grpc_header_path"), "memory"});
   CcPrint("\n");
@@ -171,7 +208,7 @@ Status MetadataDecoratorGenerator::GenerateCc() {
     "    $request_type$ const& request) {\n"},
    {HasRoutingHeader,
     "  SetMetadata(context, \"$method_request_param_key$=\" + request.$method_request_param_value$);\n",
-    "  SetMetadata(context, {});\n"},
+    "  SetMetadata(context);\n"},
    {"  return child_->$method_name$(context, request);\n"
     "}\n"
     "\n",}
@@ -193,7 +230,7 @@ $metadata_class_name$::Async$method_name$(
     google::cloud::CompletionQueue& cq,
     std::unique_ptr<grpc::ClientContext> context,
     $request_type$ const& request) {
-  SetMetadata(*context, {});
+  SetMetadata(*context);
   return child_->$method_name$(cq, std::move(context), request);
 }
 )"""}},
@@ -207,13 +244,70 @@ $metadata_class_name$::Async$method_name$(
     "    $request_type$ const& request) {\n"},
    {HasRoutingHeader,
     "  SetMetadata(*context, \"$method_request_param_key$=\" + request.$method_request_param_value$);\n",
-    "  SetMetadata(*context, {});\n"},
-   {"  return child_->$method_name$(std::move(context), request);\n"
+    "  SetMetadata(*context);\n"},
+   {"  internal::InjectTraceContext(*context);\n"
+    "  return child_->$method_name$(std::move(context), request);\n"
+    "}\n"
+    "\n"
+    "std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>\n"
+    "$metadata_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"},
+   {HasRoutingHeader,
+    "  SetMetadata(*context, \"$method_request_param_key$=\" + request.$method_request_param_value$);\n",
+    "  SetMetadata(*context);\n"},
+   {"  internal::InjectTraceContext(*context);\n"
+    "  return child_->Async$method_name$(cq, std::move(context), request);\n"
     "}\n"
     "\n",}
                  // clang-format on
              },
-             IsStreamingRead)},
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "$metadata_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) {\n"
+    // The routing parameters are in the requests, which are not known until
+    // the stream starts.
+    "  SetMetadata(*context);\n"
+    "  internal::InjectTraceContext(*context);\n"
+    "  return child_->Async$method_name$(cq, std::move(context));\n"
+    "}\n"
+    "\n",}
+                 // clang-format on
+             },
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+   {"$metadata_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"},
+   {HasRoutingHeader,
+    "  SetMetadata(*context, \"$method_request_param_key$=\" + request.$method_request_param_value$);\n",
+    "  SetMetadata(*context);\n"},
+   {"  return child_->Async$method_name$(cq, std::move(context), request);\n"
+    "}\n"
+    "\n",}
+                // clang-format on
+            },
+            And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -243,8 +337,13 @@ future<Status> $metadata_class_name$::AsyncCancelOperation(
     "void $metadata_class_name$::SetMetadata(grpc::ClientContext& context,\n"
     "                                        std::string const& "
     "request_params) {\n"
-    "  context.AddMetadata(\"x-goog-request-params\", request_params);\n"
-    "  context.AddMetadata(\"x-goog-api-client\", api_client_header_);\n"
+    "  context.AddMetadata(google::cloud::internal::RequestParamsKey(),\n"
+    "                      request_params);\n"
+    "  SetMetadata(context);\n"
+    "}\n\n"
+    "void $metadata_class_name$::SetMetadata(grpc::ClientContext& context) {\n"
+    "  context.AddMetadata(google::cloud::internal::ApiClientHeaderKey(),\n"
+    "                      api_client_header_);\n"
     "}\n\n"
             // clang-format on
   );
@@ -99,10 +99,44 @@ Status MockConnectionGenerator::GenerateHeader() {
                  // clang-format off
    {"  MOCK_METHOD(StreamRange<$response_type$>,\n"
     "  $method_name$,\n"
-    "  ($request_type$ const& request), (override));\n\n"},
+    "  ($request_type$ const& request), (override));\n\n"
+    "  MOCK_METHOD(StreamRange<std::shared_ptr<$response_type$ const>>,\n"
+    "  $method_name$InArena,\n"
+    "  ($request_type$ const& request), (override));\n\n"
+    "  MOCK_METHOD(future<Status>,\n"
+    "  Async$method_name$,\n"
+    "  ($request_type$ const& request,\n"
+    "   std::function<future<bool>($response_type$)> on_read), (override));\n\n"},
                  // clang-format on
              },
-             IsStreamingRead)},
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  MOCK_METHOD((std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>),\n"
+    "  Async$method_name$, (), (override));\n\n"},
+                 // clang-format on
+             },
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "  MOCK_METHOD(future<Status>,\n",
+    "  MOCK_METHOD(future<StatusOr<$response_type$>>,\n"},
+   {"  Async$method_name$,\n"
+    "  ($request_type$ const& request), (override));\n\n",}
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -42,6 +42,11 @@ bool IsNonStreaming(google::protobuf::MethodDescriptor const& method);
  */
 bool IsStreamingRead(google::protobuf::MethodDescriptor const& method);
 
+/**
+ * Determines if the given method has a stream request and a stream response.
+ */
+bool IsBidirStreaming(google::protobuf::MethodDescriptor const& method);
+
 /**
  * Determines if the given method is a long running operation.
  */
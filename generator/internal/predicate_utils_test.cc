@@ -711,6 +711,19 @@ TEST_F(StreamingReadTest, IsStreamingRead) {
       IsStreamingRead(*service_file_descriptor->service(0)->method(3)));
 }
 
+TEST_F(StreamingReadTest, IsBidirStreaming) {
+  const FileDescriptor* service_file_descriptor =
+      pool_.FindFileByName("google/cloud/foo/streaming.proto");
+  EXPECT_FALSE(
+      IsBidirStreaming(*service_file_descriptor->service(0)->method(0)));
+  EXPECT_FALSE(
+      IsBidirStreaming(*service_file_descriptor->service(0)->method(1)));
+  EXPECT_TRUE(
+      IsBidirStreaming(*service_file_descriptor->service(0)->method(2)));
+  EXPECT_FALSE(
+      IsBidirStreaming(*service_file_descriptor->service(0)->method(3)));
+}
+
 TEST(PredicateUtilsTest, HasRoutingHeaderSuccess) {
   google::protobuf::FileDescriptorProto service_file;
   /// @cond
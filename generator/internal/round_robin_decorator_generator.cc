@@ -0,0 +1,315 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/internal/round_robin_decorator_generator.h"
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "absl/memory/memory.h"
+#include "generator/internal/codegen_utils.h"
+#include "generator/internal/descriptor_utils.h"
+#include "generator/internal/predicate_utils.h"
+#include "generator/internal/printer.h"
+#include <google/api/client.pb.h>
+#include <google/protobuf/descriptor.h>
+
+namespace google {
+namespace cloud {
+namespace generator_internal {
+
+RoundRobinDecoratorGenerator::RoundRobinDecoratorGenerator(
+    google::protobuf::ServiceDescriptor const* service_descriptor,
+    VarsDictionary service_vars,
+    std::map<std::string, VarsDictionary> service_method_vars,
+    google::protobuf::compiler::GeneratorContext* context)
+    : ServiceCodeGenerator("round_robin_header_path", "round_robin_cc_path",
+                           service_descriptor, std::move(service_vars),
+                           std::move(service_method_vars), context) {}
+
+Status RoundRobinDecoratorGenerator::GenerateHeader() {
+  HeaderPrint(CopyrightLicenseFileHeader());
+  HeaderPrint(  // clang-format off
+    "// Generated by the Codegen C++ plugin.\n"
+    "// If you make any local changes, they will be lost.\n"
+    "// source: $proto_file_name$\n"
+    "#ifndef $header_include_guard$\n"
+    "#define $header_include_guard$\n"
+    "\n");
+  // clang-format on
+
+  // includes
+  HeaderLocalIncludes({vars("stub_header_path"),
+                       "google/cloud/internal/channel_picker.h",
+                       "google/cloud/version.h"});
+  HeaderSystemIncludes(
+      {HasLongrunningMethod() ? "google/longrunning/operations.grpc.pb.h" : "",
+       "memory", "vector"});
+  HeaderPrint("\n");
+
+  auto result = HeaderOpenNamespaces(NamespaceType::kInternal);
+  if (!result.ok()) return result;
+
+  HeaderPrint(R"""(class $round_robin_class_name$ : public $stub_class_name$ {
+ public:
+  ~$round_robin_class_name$() override = default;
+  $round_robin_class_name$(
+      std::vector<std::shared_ptr<$stub_class_name$>> children,
+      std::shared_ptr<google::cloud::internal::ChannelPicker> picker);
+
+)""");
+
+  for (auto const& method : methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         R"""(  Status $method_name$()""",
+                         R"""(  StatusOr<$response_type$> $method_name$()"""},
+                        {R"""(
+    grpc::ClientContext& context,
+    $request_type$ const& request) override;
+
+)"""}},
+                       And(IsNonStreaming, Not(IsLongrunningOperation))),
+         MethodPattern(
+             {{R"""(  future<StatusOr<google::longrunning::Operation>> Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) override;
+
+)"""}},
+             IsLongrunningOperation),
+         MethodPattern(
+             {{R"""(  std::unique_ptr<internal::StreamingReadRpc<$response_type$>>
+  $method_name$(
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>
+  Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) override;
+
+)"""}},
+             IsStreamingRead),
+         MethodPattern(
+             {{R"""(  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      $request_type$,
+      $response_type$>>
+  Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) override;
+
+)"""}},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              R"""(  future<Status> Async$method_name$()""",
+              R"""(  future<StatusOr<$response_type$>> Async$method_name$()"""},
+             {R"""(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) override;
+
+)"""}},
+            And(IsNonStreaming, Not(IsLongrunningOperation)))},
+        __FILE__, __LINE__);
+  }
+
+  if (HasLongrunningMethod()) {
+    HeaderPrint(
+        R"""(  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::GetOperationRequest const& request) override;
+
+  future<Status> AsyncCancelOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::CancelOperationRequest const& request) override;
+
+)""");
+  }
+
+  HeaderPrint(R"""( private:
+  std::vector<std::shared_ptr<$stub_class_name$>> children_;
+  std::shared_ptr<google::cloud::internal::ChannelPicker> picker_;
+};  // $round_robin_class_name$
+
+)""");
+
+  HeaderCloseNamespaces();
+  // close header guard
+  HeaderPrint(  // clang-format off
+      "#endif  // $header_include_guard$\n");
+  // clang-format on
+  return {};
+}
+
+Status RoundRobinDecoratorGenerator::GenerateCc() {
+  CcPrint(CopyrightLicenseFileHeader());
+  CcPrint(  // clang-format off
+    "// Generated by the Codegen C++ plugin.\n"
+    "// If you make any local changes, they will be lost.\n"
+    "// source: $proto_file_name$\n");
+  // clang-format on
+
+  // includes
+  CcLocalIncludes(
+      {vars("round_robin_header_path"), "google/cloud/status_or.h"});
+  CcSystemIncludes({vars("proto_grpc_header_path"), "memory", "vector"});
+  CcPrint("\n");
+
+  auto result = CcOpenNamespaces(NamespaceType::kInternal);
+  if (!result.ok()) return result;
+
+  // constructor
+  CcPrint(R"""($round_robin_class_name$::$round_robin_class_name$(
+    std::vector<std::shared_ptr<$stub_class_name$>> children,
+    std::shared_ptr<google::cloud::internal::ChannelPicker> picker)
+    : children_(std::move(children)), picker_(std::move(picker)) {}
+
+)""");
+
+  // round robin decorator class member methods, the streaming RPCs release
+  // the channel as soon as the stream is created.
+  for (auto const& method : methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty, "Status\n",
+                         "StatusOr<$response_type$>\n"},
+                        {R"""($round_robin_class_name$::$method_name$(
+    grpc::ClientContext& context,
+    $request_type$ const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->$method_name$(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+)"""}},
+                       And(IsNonStreaming, Not(IsLongrunningOperation))),
+         MethodPattern({{R"""(future<StatusOr<google::longrunning::Operation>>
+$round_robin_class_name$::Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->Async$method_name$(cq, std::move(context), request));
+}
+
+)"""}},
+                       IsLongrunningOperation),
+         MethodPattern(
+             {{R"""(std::unique_ptr<internal::StreamingReadRpc<$response_type$>>
+$round_robin_class_name$::$method_name$(
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) {
+  auto const index = picker_->Acquire();
+  auto stream = children_[index]->$method_name$(std::move(context), request);
+  picker_->Release(index);
+  return stream;
+}
+
+std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>
+$round_robin_class_name$::Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) {
+  auto const index = picker_->Acquire();
+  auto stream =
+      children_[index]->Async$method_name$(cq, std::move(context), request);
+  picker_->Release(index);
+  return stream;
+}
+
+)"""}},
+             IsStreamingRead),
+         MethodPattern(
+             {{R"""(std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    $request_type$,
+    $response_type$>>
+$round_robin_class_name$::Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  auto const index = picker_->Acquire();
+  auto stream = children_[index]->Async$method_name$(cq, std::move(context));
+  picker_->Release(index);
+  return stream;
+}
+
+)"""}},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty, "future<Status>\n",
+                         "future<StatusOr<$response_type$>>\n"},
+                        {R"""($round_robin_class_name$::Async$method_name$(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    $request_type$ const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->Async$method_name$(cq, std::move(context), request));
+}
+
+)"""}},
+                       And(IsNonStreaming, Not(IsLongrunningOperation)))},
+        __FILE__, __LINE__);
+  }
+
+  // long running operation support methods
+  if (HasLongrunningMethod()) {
+    CcPrint(R"""(future<StatusOr<google::longrunning::Operation>>
+$round_robin_class_name$::AsyncGetOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::GetOperationRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncGetOperation(cq, std::move(context), request));
+}
+
+future<Status> $round_robin_class_name$::AsyncCancelOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::CancelOperationRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncCancelOperation(cq, std::move(context), request));
+}
+
+)""");
+  }
+
+  CcCloseNamespaces();
+  return {};
+}
+
+}  // namespace generator_internal
+}  // namespace cloud
+}  // namespace google
@@ -43,17 +43,7 @@ ServiceCodeGenerator::ServiceCodeGenerator(
   assert(service_descriptor != nullptr);
   assert(context != nullptr);
   SetVars(service_vars_[header_path_key]);
-  std::vector<std::string> omitted_rpcs;
-  auto iter = service_vars_.find("omitted_rpcs");
-  if (iter != service_vars_.end()) {
-    omitted_rpcs = absl::StrSplit(iter->second, ",");
-  }
-  for (int i = 0; i < service_descriptor_->method_count(); ++i) {
-    if (!internal::Contains(omitted_rpcs,
-                            service_descriptor_->method(i)->name())) {
-      methods_.emplace_back(*service_descriptor_->method(i));
-    }
-  }
+  SetMethods();
 }
 
 ServiceCodeGenerator::ServiceCodeGenerator(
@@ -69,19 +59,37 @@ ServiceCodeGenerator::ServiceCodeGenerator(
   assert(service_descriptor != nullptr);
   assert(context != nullptr);
   SetVars(service_vars_[header_path_key]);
-  std::vector<std::string> omitted_rpcs;
-  auto iter = service_vars_.find("omitted_rpcs");
-  if (iter != service_vars_.end()) {
-    omitted_rpcs = absl::StrSplit(iter->second, ",");
-  }
+  SetMethods();
+}
+
+void ServiceCodeGenerator::SetMethods() {
+  auto split_var = [this](std::string const& key) {
+    std::vector<std::string> names;
+    auto iter = service_vars_.find(key);
+    if (iter != service_vars_.end()) {
+      names = absl::StrSplit(iter->second, ",");
+    }
+    return names;
+  };
+  auto const omitted_rpcs = split_var("omitted_rpcs");
+  auto const gen_async_rpcs = split_var("gen_async_rpcs");
   for (int i = 0; i < service_descriptor_->method_count(); ++i) {
-    if (!internal::Contains(omitted_rpcs,
-                            service_descriptor_->method(i)->name())) {
-      methods_.emplace_back(*service_descriptor_->method(i));
+    auto const& method = *service_descriptor_->method(i);
+    if (internal::Contains(omitted_rpcs, method.name())) continue;
+    methods_.emplace_back(method);
+    // Only unary RPCs get async variants, the long-running and streaming RPCs
+    // already have asynchronous APIs.
+    if (internal::Contains(gen_async_rpcs, method.name()) &&
+        IsNonStreaming(method) && !IsLongrunningOperation(method)) {
+      async_methods_.emplace_back(method);
     }
   }
 }
 
+bool ServiceCodeGenerator::HasAsyncMethod() const {
+  return !async_methods_.empty();
+}
+
 bool ServiceCodeGenerator::HasLongrunningMethod() const {
   return std::any_of(methods_.begin(), methods_.end(),
                      [](google::protobuf::MethodDescriptor const& m) {
@@ -121,6 +129,13 @@ bool ServiceCodeGenerator::HasStreamingReadMethod() const {
                      });
 }
 
+bool ServiceCodeGenerator::HasBidirStreamingMethod() const {
+  return std::any_of(methods_.begin(), methods_.end(),
+                     [](google::protobuf::MethodDescriptor const& m) {
+                       return IsBidirStreaming(m);
+                     });
+}
+
 VarsDictionary const& ServiceCodeGenerator::vars() const {
   return service_vars_;
 }
@@ -139,11 +154,19 @@ ServiceCodeGenerator::methods() const {
   return methods_;
 }
 
-VarsDictionary ServiceCodeGenerator::MergeServiceAndMethodVars(
+std::vector<
+    std::reference_wrapper<google::protobuf::MethodDescriptor const>> const&
+ServiceCodeGenerator::async_methods() const {
+  return async_methods_;
+}
+
+VarsDictionary const& ServiceCodeGenerator::MergeServiceAndMethodVars(
     google::protobuf::MethodDescriptor const& method) const {
-  auto vars = service_vars_;
-  vars.insert(service_method_vars_.at(method.full_name()).begin(),
-              service_method_vars_.at(method.full_name()).end());
+  auto& vars = merged_method_vars_[method.full_name()];
+  if (!vars.empty()) return vars;
+  vars = service_vars_;
+  auto const& method_vars = service_method_vars_.at(method.full_name());
+  vars.insert(method_vars.begin(), method_vars.end());
   return vars;
 }
 
@@ -268,6 +291,7 @@ Status ServiceCodeGenerator::Generate() {
 }
 
 void ServiceCodeGenerator::SetVars(absl::string_view header_path) {
+  merged_method_vars_.clear();
   service_vars_["header_include_guard"] = absl::StrCat(
       "GOOGLE_CLOUD_CPP_", absl::AsciiStrToUpper(absl::StrReplaceAll(
                                header_path, {{"/", "_"}, {".", "_"}})));
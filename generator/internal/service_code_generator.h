@@ -59,8 +59,17 @@ class ServiceCodeGenerator : public GeneratorInterface {
   std::vector<
       std::reference_wrapper<google::protobuf::MethodDescriptor const>> const&
   methods() const;
+  /**
+   * The unary methods listed in the `gen_async_rpcs` option.
+   *
+   * The generators add an `Async<method>()` variant of each of these methods
+   * to every layer, returning a `future<>` instead of blocking.
+   */
+  std::vector<
+      std::reference_wrapper<google::protobuf::MethodDescriptor const>> const&
+  async_methods() const;
   void SetVars(absl::string_view header_path);
-  VarsDictionary MergeServiceAndMethodVars(
+  VarsDictionary const& MergeServiceAndMethodVars(
       google::protobuf::MethodDescriptor const& method) const;
 
   void HeaderLocalIncludes(std::vector<std::string> const& local_includes);
@@ -91,6 +100,12 @@ class ServiceCodeGenerator : public GeneratorInterface {
    */
   bool HasLongrunningMethod() const;
 
+  /**
+   * Determines if the service contains at least one method that needs an
+   * async variant.
+   */
+  bool HasAsyncMethod() const;
+
   /**
    * Determines if the service contains at least one method that is paginated
    * per https://google.aip.dev/client-libraries/4233.
@@ -109,6 +124,12 @@ class ServiceCodeGenerator : public GeneratorInterface {
    */
   bool HasStreamingReadMethod() const;
 
+  /**
+   * Determines if the service contains at least one rpc with a stream request
+   * and a stream response.
+   */
+  bool HasBidirStreamingMethod() const;
+
  private:
   enum class FileType { kHeaderFile, kCcFile };
   static void GenerateLocalIncludes(Printer& p,
@@ -120,13 +141,18 @@ class ServiceCodeGenerator : public GeneratorInterface {
   Status OpenNamespaces(Printer& p,
                         NamespaceType ns_type = NamespaceType::kNormal);
   void CloseNamespaces(Printer& p);
+  void SetMethods();
 
   google::protobuf::ServiceDescriptor const* service_descriptor_;
   VarsDictionary service_vars_;
   std::map<std::string, VarsDictionary> service_method_vars_;
+  // Each method is printed several times, cache the merged vars.
+  mutable std::map<std::string, VarsDictionary> merged_method_vars_;
   std::vector<std::string> namespaces_;
   std::vector<std::reference_wrapper<google::protobuf::MethodDescriptor const>>
       methods_;
+  std::vector<std::reference_wrapper<google::protobuf::MethodDescriptor const>>
+      async_methods_;
   Printer header_;
   Printer cc_;
 };
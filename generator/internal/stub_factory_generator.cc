@@ -78,11 +78,15 @@ Status StubFactoryGenerator::GenerateCc() {
   // includes
   CcLocalIncludes({vars("stub_factory_header_path"), vars("auth_header_path"),
                    vars("logging_header_path"), vars("metadata_header_path"),
-                   vars("stub_header_path"), "google/cloud/common_options.h",
+                   vars("metrics_header_path"),
+                   vars("round_robin_header_path"), vars("stub_header_path"),
+                   "google/cloud/common_options.h",
+                   "google/cloud/grpc_channel_registry.h",
                    "google/cloud/grpc_options.h",
                    "google/cloud/internal/algorithm.h",
+                   "google/cloud/internal/channel_picker.h",
                    "google/cloud/options.h", "google/cloud/log.h"});
-  CcSystemIncludes({"memory"});
+  CcSystemIncludes({"algorithm", "memory", "vector"});
   CcPrint("\n");
 
   auto result = CcOpenNamespaces(NamespaceType::kInternal);
@@ -102,23 +106,39 @@ CreateDefault$stub_class_name$(
     return google::cloud::internal::CreateAuthenticationStrategy(
         options.get<google::cloud::GrpcCredentialOption>());
   }();
-  auto channel = auth->CreateChannel(
-    options.get<EndpointOption>(), internal::MakeChannelArguments(options));
-  auto service_grpc_stub = $grpc_stub_fqn$::NewStub(channel);)""");
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  std::vector<std::shared_ptr<$stub_class_name$>> children;
+  auto const num_channels =
+    (std::max)(1, options.get<GrpcNumChannelsOption>());
+  for (int id = 0; id != num_channels; ++id) {
+    auto arguments = internal::MakeChannelArguments(options);
+    // Use a different channel id, so gRPC does not share connections.
+    arguments.SetInt("grpc.channel_id", id);
+    auto channel = internal::CreateSharedChannel(options, arguments, [&] {
+      return auth->CreateChannel(options.get<EndpointOption>(), arguments);
+    });
+    children.push_back(std::make_shared<Default$stub_class_name$>()""");
 
   if (!HasLongrunningMethod()) {
     CcPrint(R"""(
-  std::shared_ptr<$stub_class_name$> stub =
-    std::make_shared<Default$stub_class_name$>(std::move(service_grpc_stub));
-)""");
+      $grpc_stub_fqn$::NewStub(channel)));)""");
   } else {
     CcPrint(R"""(
-  std::shared_ptr<$stub_class_name$> stub =
-    std::make_shared<Default$stub_class_name$>(
-      std::move(service_grpc_stub),
-      google::longrunning::Operations::NewStub(channel));
-)""");
+      $grpc_stub_fqn$::NewStub(channel),
+      google::longrunning::Operations::NewStub(channel)));)""");
+  }
+  CcPrint(R"""(
+    channels.push_back(std::move(channel));
   }
+  std::shared_ptr<$stub_class_name$> stub;
+  if (children.size() == 1) {
+    stub = std::move(children.front());
+  } else {
+    stub = std::make_shared<$round_robin_class_name$>(
+        std::move(children),
+        google::cloud::internal::MakeChannelPicker(channels, options));
+  }
+)""");
   CcPrint(R"""(
   if (auth->RequiresConfigureContext()) {
     stub = std::make_shared<$auth_class_name$>(
@@ -133,6 +153,12 @@ CreateDefault$stub_class_name$(
         options.get<GrpcTracingOptionsOption>(),
         options.get<TracingComponentsOption>());
   }
+  // The metrics decorator is the outermost layer, so the resource accounting
+  // for each call includes the work done by all the other decorators.
+  if (options.has<RpcMetricsOption>()) {
+    stub = std::make_shared<$metrics_class_name$>(
+        std::move(stub), options.get<RpcMetricsOption>());
+  }
   return stub;
 }
 )""");
@@ -49,9 +49,19 @@ Status StubGenerator::GenerateHeader() {
 
   // includes
   HeaderLocalIncludes(
-      {HasLongrunningMethod() ? "google/cloud/completion_queue.h" : "",
-       HasLongrunningMethod() ? "google/cloud/future.h" : "",
+      {HasLongrunningMethod() || HasStreamingReadMethod() ||
+               HasBidirStreamingMethod() || HasAsyncMethod()
+           ? "google/cloud/completion_queue.h"
+           : "",
+       HasLongrunningMethod() || HasAsyncMethod() ? "google/cloud/future.h"
+                                                  : "",
        "google/cloud/status_or.h",
+       HasBidirStreamingMethod()
+           ? "google/cloud/internal/async_read_write_stream_impl.h"
+           : "",
+       HasStreamingReadMethod()
+           ? "google/cloud/internal/async_streaming_read_rpc.h"
+           : "",
        HasStreamingReadMethod() ? "google/cloud/internal/streaming_read_rpc.h"
                                 : "",
        "google/cloud/version.h"});
@@ -99,9 +109,43 @@ Status StubGenerator::GenerateHeader() {
     "  $method_name$(\n"
     "    std::unique_ptr<grpc::ClientContext> context,\n"
     "    $request_type$ const& request) = 0;\n"
+    "\n"
+    "  virtual std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) = 0;\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {// clang-format off
+   {"  virtual std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) = 0;\n"
     "\n"}},
              // clang-format on
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "  virtual future<Status> Async$method_name$(\n",
+    "  virtual future<StatusOr<$response_type$>> Async$method_name$(\n"},
+   {"    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) = 0;\n"
+              // clang-format on
+              "\n"}},
+            And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -172,9 +216,43 @@ Status StubGenerator::GenerateHeader() {
     "  $method_name$(\n"
     "    std::unique_ptr<grpc::ClientContext> client_context,\n"
     "    $request_type$ const& request) override;\n"
+    "\n"
+    "  std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "    $request_type$ const& request) override;\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {// clang-format off
+   {"  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context) override;\n"
     "\n"}},
              // clang-format on
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  future<Status>\n",
+    "  future<StatusOr<$response_type$>>\n"},
+    {"  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+    "\n"}},
+                       // clang-format on
+                       And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
@@ -292,9 +370,71 @@ Default$stub_class_name$::Async$method_name$(
     "  return absl::make_unique<internal::StreamingReadRpcImpl<\n"
     "      $response_type$>>(\n"
     "      std::move(client_context), std::move(stream));\n"
+    "}\n\n"
+    "std::unique_ptr<internal::AsyncStreamingReadRpc<$response_type$>>\n"
+    "Default$stub_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return internal::MakeStreamingReadRpc<\n"
+    "      $request_type$, $response_type$>(\n"
+    "      cq, std::move(client_context), request,\n"
+    "      [this](grpc::ClientContext* context,\n"
+    "             $request_type$ const& request,\n"
+    "             grpc::CompletionQueue* cq) {\n"
+    "        return grpc_stub_->PrepareAsync$method_name$(context, request, cq);\n"
+    "      });\n"
+    "}\n\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {// clang-format off
+   {"std::unique_ptr<internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "Default$stub_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context) {\n"
+    "  return internal::MakeStreamingReadWriteRpc<\n"
+    "      $request_type$, $response_type$>(\n"
+    "      cq, std::move(client_context),\n"
+    "      [this](grpc::ClientContext* context, grpc::CompletionQueue* cq) {\n"
+    "        return grpc_stub_->PrepareAsync$method_name$(context, cq);\n"
+    "      });\n"
     "}\n\n"}},
              // clang-format on
-             IsStreamingRead)},
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+   {"Default$stub_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return cq.MakeUnaryRpc(\n"
+    "      [this](grpc::ClientContext* context,\n"
+    "             $request_type$ const& request,\n"
+    "             grpc::CompletionQueue* cq) {\n"
+    "        return grpc_stub_->Async$method_name$(context, request, cq);\n"
+    "      },\n"},
+   {IsResponseTypeEmpty,
+    "      request, std::move(context))\n"
+    "      .then([](future<StatusOr<google::protobuf::Empty>> f) {\n"
+    "        return f.get().status();\n"
+    "      });\n",
+    "      request, std::move(context));\n"},
+   {"}\n"
+    "\n"}},
+            // clang-format on
+            And(IsNonStreaming, Not(IsLongrunningOperation)))},
         __FILE__, __LINE__);
   }
 
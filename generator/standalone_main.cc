@@ -21,6 +21,7 @@
 #include "generator/generator_config.pb.h"
 #include <google/protobuf/compiler/command_line_interface.h>
 #include <google/protobuf/text_format.h>
+#include <chrono>
 #include <fstream>
 #include <future>
 #include <iostream>
@@ -89,6 +90,10 @@ int main(int argc, char** argv) {
     GCP_LOG(ERROR) << "Failed to parse config file: " << config_file << "\n";
   }
 
+  using Clock = std::chrono::steady_clock;
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  auto const start = Clock::now();
   std::vector<std::future<google::cloud::Status>> tasks;
   for (auto const& service : config->service()) {
     std::vector<std::string> args;
@@ -106,11 +111,15 @@ int main(int argc, char** argv) {
     for (auto const& omit_rpc : service.omitted_rpcs()) {
       args.emplace_back("--cpp_codegen_opt=omit_rpc=" + omit_rpc);
     }
+    for (auto const& gen_async_rpc : service.gen_async_rpcs()) {
+      args.emplace_back("--cpp_codegen_opt=gen_async_rpc=" + gen_async_rpc);
+    }
     args.emplace_back(service.service_proto_path());
     GCP_LOG(INFO) << "Generating service code using: "
                   << absl::StrJoin(args, ";") << "\n";
 
     tasks.push_back(std::async(std::launch::async, [args] {
+      auto const service_start = Clock::now();
       google::protobuf::compiler::CommandLineInterface cli;
       google::cloud::generator::Generator generator;
       cli.RegisterGenerator("--cpp_codegen_out", "--cpp_codegen_opt",
@@ -126,6 +135,13 @@ int main(int argc, char** argv) {
                                      absl::StrCat("Generating service from ",
                                                   c_args.back(), " failed."));
 
+      // This includes parsing the protos, which is often the slowest stage.
+      GCP_LOG(INFO) << "Generated service code for " << c_args.back()
+                    << " in "
+                    << duration_cast<milliseconds>(Clock::now() -
+                                                   service_start)
+                           .count()
+                    << "ms\n";
       return google::cloud::Status{};
     }));
   }
@@ -138,6 +154,10 @@ int main(int argc, char** argv) {
     }
   }
 
+  GCP_LOG(INFO) << "Generated " << tasks.size() << " services in "
+                << duration_cast<milliseconds>(Clock::now() - start).count()
+                << "ms\n";
+
   if (!error_message.empty()) {
     GCP_LOG(ERROR) << error_message;
     return 1;
@@ -0,0 +1,44 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigquery/append_rows_writer.h"
+#include "google/cloud/bigquery/internal/append_rows_writer_impl.h"
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+AppendRowsWriter::AppendRowsWriter(
+    std::shared_ptr<bigquery_internal::AppendRowsWriterImpl> impl)
+    : impl_(std::move(impl)) {}
+
+AppendRowsWriter::~AppendRowsWriter() {
+  if (impl_) impl_->Cancel();
+}
+
+future<StatusOr<std::int64_t>> AppendRowsWriter::Append(
+    std::string serialized_row) {
+  return impl_->Append(std::move(serialized_row));
+}
+
+void AppendRowsWriter::Flush() { impl_->Flush(); }
+
+future<Status> AppendRowsWriter::Close() { return impl_->Close(); }
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,142 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_APPEND_ROWS_WRITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_APPEND_ROWS_WRITER_H
+
+#include "google/cloud/future.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+class AppendRowsWriterImpl;
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * The size of the batches sent by an `AppendRowsWriter`.
+ *
+ * The writer sends the rows once they add up to this many bytes. A single row
+ * larger than this value is sent in its own batch. The default is 1 MiB, a
+ * value of 0 is treated as 1. The service rejects requests larger than 10 MB.
+ */
+struct AppendRowsMaxBatchBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The maximum number of batches an `AppendRowsWriter` sends before receiving
+ * their responses.
+ *
+ * The default is 8, a value of 0 is treated as 1.
+ */
+struct AppendRowsMaxInFlightOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The offset of the first row written by an `AppendRowsWriter`.
+ *
+ * When set, the writer sends the offset of each batch, and the service rejects
+ * any batch that does not start at the end of the stream. Applications use
+ * this to write each row exactly once: if the stream breaks, create a new
+ * writer with this option set to the offset of the first row that was not
+ * acknowledged.
+ *
+ * The `_default` stream of a table does not support offsets.
+ */
+struct AppendRowsOffsetOption {
+  using Type = std::int64_t;
+};
+
+/**
+ * Writes serialized rows to a BigQuery write stream.
+ *
+ * The writer uses a single `AppendRows` stream. It batches the rows by size
+ * (see `AppendRowsMaxBatchBytesOption`), and keeps several batches in flight
+ * (see `AppendRowsMaxInFlightOption`), so the throughput is not limited by the
+ * round-trip time to the service. The schema is sent only in the first
+ * request of the stream.
+ *
+ * The rows are serialized protos of the message type given when the writer was
+ * created. The writer sends a batch once it is full, applications call
+ * `Flush()` to send a partial batch, and `Close()` sends any remaining rows.
+ *
+ * Destroying the writer before `Close()` completes cancels the stream, and any
+ * pending `Append()` calls fail.
+ *
+ * @par Example
+ * @code
+ * namespace bq = ::google::cloud::bigquery;
+ * auto connection = bq::MakeBigQueryWriteConnection();
+ * auto writer = connection->AppendRows(stream_name, *MyRow::descriptor());
+ * std::vector<google::cloud::future<google::cloud::StatusOr<std::int64_t>>>
+ *     results;
+ * for (auto const& row : rows) {
+ *   results.push_back(writer.Append(row.SerializeAsString()));
+ * }
+ * auto status = writer.Close().get();
+ * @endcode
+ */
+class AppendRowsWriter {
+ public:
+  explicit AppendRowsWriter(
+      std::shared_ptr<bigquery_internal::AppendRowsWriterImpl> impl);
+  ~AppendRowsWriter();
+
+  AppendRowsWriter(AppendRowsWriter&&) = default;
+  AppendRowsWriter& operator=(AppendRowsWriter&&) = default;
+
+  /**
+   * Appends @p serialized_row to the stream.
+   *
+   * The future is satisfied once the service acknowledges the row. Its value is
+   * the offset of the row in the stream, or -1 if the offset is unknown, for
+   * example, in the `_default` stream.
+   */
+  future<StatusOr<std::int64_t>> Append(std::string serialized_row);
+
+  /// Sends the current batch, even if it is not full.
+  void Flush();
+
+  /**
+   * Sends any remaining rows and closes the stream.
+   *
+   * The future is satisfied once all the rows are acknowledged. After this
+   * call, `Append()` fails with `kFailedPrecondition`.
+   */
+  future<Status> Close();
+
+ private:
+  std::shared_ptr<bigquery_internal::AppendRowsWriterImpl> impl_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_APPEND_ROWS_WRITER_H
@@ -63,6 +63,21 @@ BigQueryReadClient::ReadRows(
   return connection_->ReadRows(request);
 }
 
+StreamRange<std::shared_ptr<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse const>>
+BigQueryReadClient::ReadRowsInArena(
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  return connection_->ReadRowsInArena(request);
+}
+
+future<Status> BigQueryReadClient::AsyncReadRows(
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request,
+    std::function<
+        future<bool>(google::cloud::bigquery::storage::v1::ReadRowsResponse)>
+        on_read) {
+  return connection_->AsyncReadRows(request, std::move(on_read));
+}
+
 StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
 BigQueryReadClient::SplitReadStream(
     google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&
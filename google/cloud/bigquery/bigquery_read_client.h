@@ -166,6 +166,33 @@ class BigQueryReadClient {
   StreamRange<google::cloud::bigquery::storage::v1::ReadRowsResponse> ReadRows(
       google::cloud::bigquery::storage::v1::ReadRowsRequest const& request);
 
+  /**
+   * Reads the responses of `ReadRows()`, allocating each response in
+   * its own `google::protobuf::Arena`.
+   *
+   * Each element owns the arena of its response. Releasing the element
+   * releases all the memory for the response at once, which is much
+   * cheaper than deleting large responses one field at a time.
+   */
+  StreamRange<std::shared_ptr<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse const>>
+  ReadRowsInArena(
+      google::cloud::bigquery::storage::v1::ReadRowsRequest const& request);
+
+  /**
+   * Asynchronously reads the responses of `ReadRows()`.
+   *
+   * @p on_read is called for each response, the next response is not read
+   * until the future it returns is satisfied. If the value is `false` the
+   * stream is cancelled. The stream is resumed on transient failures,
+   * using the retry and backoff policies of the connection.
+   */
+  future<Status> AsyncReadRows(
+      google::cloud::bigquery::storage::v1::ReadRowsRequest const& request,
+      std::function<
+          future<bool>(google::cloud::bigquery::storage::v1::ReadRowsResponse)>
+          on_read);
+
   /**
    * Splits a given `ReadStream` into two `ReadStream` objects. These
    * `ReadStream` objects are referred to as the primary and the residual
@@ -22,10 +22,15 @@
 #include "google/cloud/bigquery/internal/bigquery_read_stub_factory.h"
 #include "google/cloud/background_threads.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/async_resumable_streaming_read.h"
+#include "google/cloud/internal/grpc_compression.h"
+#include "google/cloud/internal/hedged_call.h"
 #include "google/cloud/internal/resumable_streaming_read_rpc.h"
 #include "google/cloud/internal/retry_loop.h"
 #include "google/cloud/internal/streaming_read_rpc_logging.h"
+#include <map>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -51,6 +56,27 @@ BigQueryReadConnection::ReadRows(
       });
 }
 
+StreamRange<std::shared_ptr<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse const>>
+BigQueryReadConnection::ReadRowsInArena(
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const&) {
+  return google::cloud::internal::MakeStreamRange<std::shared_ptr<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse const>>(
+      []() -> absl::variant<Status,
+                            std::shared_ptr<google::cloud::bigquery::storage::
+                                                v1::ReadRowsResponse const>> {
+        return Status(StatusCode::kUnimplemented, "not implemented");
+      });
+}
+
+future<Status> BigQueryReadConnection::AsyncReadRows(
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const&,
+    std::function<
+        future<bool>(google::cloud::bigquery::storage::v1::ReadRowsResponse)>) {
+  return google::cloud::make_ready_future(
+      Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
 StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
 BigQueryReadConnection::SplitReadStream(
     google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&) {
@@ -70,6 +96,9 @@ class BigQueryReadConnectionImpl : public BigQueryReadConnection {
             options.get<BigQueryReadRetryPolicyOption>()->clone()),
         backoff_policy_prototype_(
             options.get<BigQueryReadBackoffPolicyOption>()->clone()),
+        attempt_timeout_(options.get<GrpcAttemptTimeoutOption>()),
+        hedging_delays_(options.get<GrpcHedgingDelayOption>()),
+        compression_(options.get<GrpcCompressionOption>()),
         idempotency_policy_(
             options.get<BigQueryReadConnectionIdempotencyPolicyOption>()
                 ->clone()) {}
@@ -79,15 +108,23 @@ class BigQueryReadConnectionImpl : public BigQueryReadConnection {
   StatusOr<google::cloud::bigquery::storage::v1::ReadSession> CreateReadSession(
       google::cloud::bigquery::storage::v1::CreateReadSessionRequest const&
           request) override {
+    auto const idempotency = idempotency_policy_->CreateReadSession(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->CreateReadSession(request),
-        [this](grpc::ClientContext& context,
-               google::cloud::bigquery::storage::v1::
-                   CreateReadSessionRequest const& request) {
-          return stub_->CreateReadSession(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "BigQueryRead.CreateReadSession", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::cloud::bigquery::storage::v1::
+                       CreateReadSessionRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "BigQueryRead.CreateReadSession",
+                  request);
+              return stub_->CreateReadSession(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StreamRange<google::cloud::bigquery::storage::v1::ReadRowsResponse> ReadRows(
@@ -119,18 +156,78 @@ class BigQueryReadConnectionImpl : public BigQueryReadConnection {
             [resumable] { return resumable->Read(); }));
   }
 
+  StreamRange<std::shared_ptr<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse const>>
+  ReadRowsInArena(google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                      request) override {
+    auto stub = stub_;
+    auto retry_policy = std::shared_ptr<BigQueryReadRetryPolicy const>(
+        retry_policy_prototype_->clone());
+    auto backoff_policy = std::shared_ptr<BackoffPolicy const>(
+        backoff_policy_prototype_->clone());
+
+    auto factory =
+        [stub](google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                   request) {
+          return stub->ReadRows(absl::make_unique<grpc::ClientContext>(),
+                                request);
+        };
+
+    auto resumable = internal::MakeResumableStreamingReadRpc<
+        google::cloud::bigquery::storage::v1::ReadRowsResponse,
+        google::cloud::bigquery::storage::v1::ReadRowsRequest>(
+        retry_policy->clone(), backoff_policy->clone(),
+        [](std::chrono::milliseconds) {}, factory,
+        BigQueryReadReadRowsStreamingUpdater, request);
+
+    return internal::MakeStreamRange(
+        internal::StreamReader<std::shared_ptr<
+            google::cloud::bigquery::storage::v1::ReadRowsResponse const>>(
+            [resumable] { return resumable->ReadInArena(); }));
+  }
+
+  future<Status> AsyncReadRows(
+      google::cloud::bigquery::storage::v1::ReadRowsRequest const& request,
+      std::function<
+          future<bool>(google::cloud::bigquery::storage::v1::ReadRowsResponse)>
+          on_read) override {
+    auto stub = stub_;
+    return internal::AsyncResumableStreamingRead<
+        google::cloud::bigquery::storage::v1::ReadRowsResponse,
+        google::cloud::bigquery::storage::v1::ReadRowsRequest,
+        BigQueryReadRetryPolicy, BackoffPolicy>(
+        background_->cq(), retry_policy_prototype_->clone(),
+        backoff_policy_prototype_->clone(),
+        [stub](google::cloud::CompletionQueue& cq,
+               google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                   request) {
+          return stub->AsyncReadRows(
+              cq, absl::make_unique<grpc::ClientContext>(), request);
+        },
+        BigQueryReadReadRowsStreamingUpdater, request, std::move(on_read));
+  }
+
   StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
   SplitReadStream(
       google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&
           request) override {
+    auto const idempotency = idempotency_policy_->SplitReadStream(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->SplitReadStream(request),
-        [this](
-            grpc::ClientContext& context,
-            google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&
-                request) { return stub_->SplitReadStream(context, request); },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "BigQueryRead.SplitReadStream", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::cloud::bigquery::storage::v1::
+                       SplitReadStreamRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "BigQueryRead.SplitReadStream",
+                  request);
+              return stub_->SplitReadStream(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
  private:
@@ -138,6 +235,9 @@ class BigQueryReadConnectionImpl : public BigQueryReadConnection {
   std::shared_ptr<bigquery_internal::BigQueryReadStub> stub_;
   std::unique_ptr<BigQueryReadRetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
+  std::chrono::milliseconds attempt_timeout_;
+  std::map<std::string, std::chrono::milliseconds> hedging_delays_;
+  std::map<std::string, std::size_t> compression_;
   std::unique_ptr<BigQueryReadConnectionIdempotencyPolicy> idempotency_policy_;
 };
 }  // namespace
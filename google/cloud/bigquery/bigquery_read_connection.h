@@ -22,10 +22,12 @@
 #include "google/cloud/bigquery/internal/bigquery_read_stub.h"
 #include "google/cloud/bigquery/retry_traits.h"
 #include "google/cloud/backoff_policy.h"
+#include "google/cloud/future.h"
 #include "google/cloud/options.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/stream_range.h"
 #include "google/cloud/version.h"
+#include <functional>
 #include <memory>
 
 namespace google {
@@ -61,6 +63,17 @@ class BigQueryReadConnection {
   ReadRows(
       google::cloud::bigquery::storage::v1::ReadRowsRequest const& request);
 
+  virtual StreamRange<std::shared_ptr<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse const>>
+  ReadRowsInArena(
+      google::cloud::bigquery::storage::v1::ReadRowsRequest const& request);
+
+  virtual future<Status> AsyncReadRows(
+      google::cloud::bigquery::storage::v1::ReadRowsRequest const& request,
+      std::function<
+          future<bool>(google::cloud::bigquery::storage::v1::ReadRowsResponse)>
+          on_read);
+
   virtual StatusOr<
       google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
   SplitReadStream(
@@ -0,0 +1,161 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigquery/bigquery_write_connection.h"
+#include "google/cloud/bigquery/internal/append_rows_writer_impl.h"
+#include "google/cloud/bigquery/internal/bigquery_write_option_defaults.h"
+#include "google/cloud/bigquery/internal/bigquery_write_stub_factory.h"
+#include "google/cloud/background_threads.h"
+#include "google/cloud/grpc_options.h"
+#include "absl/memory/memory.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+namespace v1beta2 = ::google::cloud::bigquery::storage::v1beta2;
+
+BigQueryWriteConnection::~BigQueryWriteConnection() = default;
+
+StatusOr<v1beta2::WriteStream> BigQueryWriteConnection::CreateWriteStream(
+    v1beta2::CreateWriteStreamRequest const&) {
+  return Status(StatusCode::kUnimplemented, "not implemented");
+}
+
+AppendRowsWriter BigQueryWriteConnection::AppendRows(
+    std::string write_stream, google::protobuf::Descriptor const& descriptor,
+    Options opts) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadWriteRpcError<
+      v1beta2::AppendRowsRequest, v1beta2::AppendRowsResponse>;
+  return AppendRowsWriter(bigquery_internal::AppendRowsWriterImpl::Create(
+      absl::make_unique<ErrorStream>(
+          Status(StatusCode::kUnimplemented, "not implemented")),
+      std::move(write_stream),
+      bigquery_internal::CachedDescriptorProto(descriptor), opts));
+}
+
+StatusOr<v1beta2::WriteStream> BigQueryWriteConnection::GetWriteStream(
+    v1beta2::GetWriteStreamRequest const&) {
+  return Status(StatusCode::kUnimplemented, "not implemented");
+}
+
+StatusOr<v1beta2::FinalizeWriteStreamResponse>
+BigQueryWriteConnection::FinalizeWriteStream(
+    v1beta2::FinalizeWriteStreamRequest const&) {
+  return Status(StatusCode::kUnimplemented, "not implemented");
+}
+
+StatusOr<v1beta2::BatchCommitWriteStreamsResponse>
+BigQueryWriteConnection::BatchCommitWriteStreams(
+    v1beta2::BatchCommitWriteStreamsRequest const&) {
+  return Status(StatusCode::kUnimplemented, "not implemented");
+}
+
+StatusOr<v1beta2::FlushRowsResponse> BigQueryWriteConnection::FlushRows(
+    v1beta2::FlushRowsRequest const&) {
+  return Status(StatusCode::kUnimplemented, "not implemented");
+}
+
+class BigQueryWriteConnectionImpl : public BigQueryWriteConnection {
+ public:
+  BigQueryWriteConnectionImpl(
+      std::unique_ptr<google::cloud::BackgroundThreads> background,
+      std::shared_ptr<bigquery_internal::BigQueryWriteStub> stub)
+      : background_(std::move(background)), stub_(std::move(stub)) {}
+
+  ~BigQueryWriteConnectionImpl() override = default;
+
+  StatusOr<v1beta2::WriteStream> CreateWriteStream(
+      v1beta2::CreateWriteStreamRequest const& request) override {
+    grpc::ClientContext context;
+    return stub_->CreateWriteStream(context, request);
+  }
+
+  AppendRowsWriter AppendRows(std::string write_stream,
+                              google::protobuf::Descriptor const& descriptor,
+                              Options opts) override {
+    // The stub uses the request to set the routing headers.
+    v1beta2::AppendRowsRequest request;
+    request.set_write_stream(write_stream);
+    auto cq = background_->cq();
+    auto stream = stub_->AsyncAppendRows(
+        cq, absl::make_unique<grpc::ClientContext>(), request);
+    return AppendRowsWriter(bigquery_internal::AppendRowsWriterImpl::Create(
+        std::move(stream), std::move(write_stream),
+        bigquery_internal::CachedDescriptorProto(descriptor), opts));
+  }
+
+  StatusOr<v1beta2::WriteStream> GetWriteStream(
+      v1beta2::GetWriteStreamRequest const& request) override {
+    grpc::ClientContext context;
+    return stub_->GetWriteStream(context, request);
+  }
+
+  StatusOr<v1beta2::FinalizeWriteStreamResponse> FinalizeWriteStream(
+      v1beta2::FinalizeWriteStreamRequest const& request) override {
+    grpc::ClientContext context;
+    return stub_->FinalizeWriteStream(context, request);
+  }
+
+  StatusOr<v1beta2::BatchCommitWriteStreamsResponse> BatchCommitWriteStreams(
+      v1beta2::BatchCommitWriteStreamsRequest const& request) override {
+    grpc::ClientContext context;
+    return stub_->BatchCommitWriteStreams(context, request);
+  }
+
+  StatusOr<v1beta2::FlushRowsResponse> FlushRows(
+      v1beta2::FlushRowsRequest const& request) override {
+    grpc::ClientContext context;
+    return stub_->FlushRows(context, request);
+  }
+
+ private:
+  std::unique_ptr<google::cloud::BackgroundThreads> background_;
+  std::shared_ptr<bigquery_internal::BigQueryWriteStub> stub_;
+};
+
+std::shared_ptr<BigQueryWriteConnection> MakeBigQueryWriteConnection(
+    Options options) {
+  options = bigquery_internal::BigQueryWriteDefaultOptions(std::move(options));
+  auto background = internal::MakeBackgroundThreadsFactory(options)();
+  auto stub = bigquery_internal::CreateDefaultBigQueryWriteStub(
+      background->cq(), options);
+  return std::make_shared<BigQueryWriteConnectionImpl>(std::move(background),
+                                                       std::move(stub));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+std::shared_ptr<bigquery::BigQueryWriteConnection> MakeBigQueryWriteConnection(
+    std::shared_ptr<BigQueryWriteStub> stub, Options options) {
+  options = BigQueryWriteDefaultOptions(std::move(options));
+  return std::make_shared<bigquery::BigQueryWriteConnectionImpl>(
+      internal::MakeBackgroundThreadsFactory(options)(), std::move(stub));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,111 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_BIGQUERY_WRITE_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_BIGQUERY_WRITE_CONNECTION_H
+
+#include "google/cloud/bigquery/append_rows_writer.h"
+#include "google/cloud/bigquery/internal/bigquery_write_stub.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <google/protobuf/descriptor.h>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * A connection to the BigQuery Storage Write API.
+ *
+ * The unary RPCs are not retried, `CreateWriteStream()` and
+ * `BatchCommitWriteStreams()` are not idempotent, and applications usually
+ * retry a whole write (or commit) operation when these fail.
+ *
+ * @note This uses the `v1beta2` version of the API.
+ */
+class BigQueryWriteConnection {
+ public:
+  virtual ~BigQueryWriteConnection() = 0;
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  CreateWriteStream(
+      google::cloud::bigquery::storage::v1beta2::CreateWriteStreamRequest const&
+          request);
+
+  /**
+   * Starts an `AppendRows` stream to @p write_stream.
+   *
+   * The rows written to the returned writer are serialized protos, described
+   * by @p descriptor. The conversion of @p descriptor to the schema sent to the
+   * service is cached, creating many writers for the same message type is
+   * cheap.
+   *
+   * @param write_stream the full name of the write stream, e.g.
+   *     `projects/p/datasets/d/tables/t/streams/_default`.
+   * @param descriptor the descriptor of the rows' message type.
+   * @param opts the options for the writer, see `AppendRowsMaxBatchBytesOption`
+   *     and friends.
+   */
+  virtual AppendRowsWriter AppendRows(
+      std::string write_stream, google::protobuf::Descriptor const& descriptor,
+      Options opts);
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  GetWriteStream(
+      google::cloud::bigquery::storage::v1beta2::GetWriteStreamRequest const&
+          request);
+
+  virtual StatusOr<
+      google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse>
+  FinalizeWriteStream(google::cloud::bigquery::storage::v1beta2::
+                          FinalizeWriteStreamRequest const& request);
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::
+                       BatchCommitWriteStreamsResponse>
+  BatchCommitWriteStreams(google::cloud::bigquery::storage::v1beta2::
+                              BatchCommitWriteStreamsRequest const& request);
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::FlushRowsResponse>
+  FlushRows(
+      google::cloud::bigquery::storage::v1beta2::FlushRowsRequest const&
+          request);
+};
+
+std::shared_ptr<BigQueryWriteConnection> MakeBigQueryWriteConnection(
+    Options options = {});
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+std::shared_ptr<bigquery::BigQueryWriteConnection> MakeBigQueryWriteConnection(
+    std::shared_ptr<BigQueryWriteStub> stub, Options options = {});
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_BIGQUERY_WRITE_CONNECTION_H
@@ -17,28 +17,52 @@
 """Automatically generated source lists for google_cloud_cpp_bigquery - DO NOT EDIT."""
 
 google_cloud_cpp_bigquery_hdrs = [
+    "append_rows_writer.h",
     "bigquery_read_client.h",
     "bigquery_read_connection.h",
     "bigquery_read_connection_idempotency_policy.h",
     "bigquery_read_options.h",
+    "bigquery_write_connection.h",
+    "internal/append_rows_writer_impl.h",
     "internal/bigquery_read_auth_decorator.h",
     "internal/bigquery_read_logging_decorator.h",
     "internal/bigquery_read_metadata_decorator.h",
+    "internal/bigquery_read_metrics_decorator.h",
     "internal/bigquery_read_option_defaults.h",
+    "internal/bigquery_read_round_robin_decorator.h",
     "internal/bigquery_read_stub.h",
     "internal/bigquery_read_stub_factory.h",
+    "internal/bigquery_write_auth_decorator.h",
+    "internal/bigquery_write_metadata_decorator.h",
+    "internal/bigquery_write_option_defaults.h",
+    "internal/bigquery_write_stub.h",
+    "internal/bigquery_write_stub_factory.h",
+    "read_session_reader.h",
     "retry_traits.h",
+    "serialized_rows.h",
 ]
 
 google_cloud_cpp_bigquery_srcs = [
+    "append_rows_writer.cc",
     "bigquery_read_client.cc",
     "bigquery_read_connection.cc",
     "bigquery_read_connection_idempotency_policy.cc",
+    "bigquery_write_connection.cc",
+    "internal/append_rows_writer_impl.cc",
     "internal/bigquery_read_auth_decorator.cc",
     "internal/bigquery_read_logging_decorator.cc",
     "internal/bigquery_read_metadata_decorator.cc",
+    "internal/bigquery_read_metrics_decorator.cc",
     "internal/bigquery_read_option_defaults.cc",
+    "internal/bigquery_read_round_robin_decorator.cc",
     "internal/bigquery_read_stub.cc",
     "internal/bigquery_read_stub_factory.cc",
+    "internal/bigquery_write_auth_decorator.cc",
+    "internal/bigquery_write_metadata_decorator.cc",
+    "internal/bigquery_write_option_defaults.cc",
+    "internal/bigquery_write_stub.cc",
+    "internal/bigquery_write_stub_factory.cc",
+    "read_session_reader.cc",
+    "serialized_rows.cc",
     "streaming.cc",
 ]
@@ -17,6 +17,7 @@
 """Automatically generated source lists for google_cloud_cpp_bigquery_mocks - DO NOT EDIT."""
 
 google_cloud_cpp_bigquery_mocks_hdrs = [
+    "mocks/fake_bigquery_read_server.h",
     "mocks/mock_bigquery_read_connection.h",
 ]
 
@@ -0,0 +1,277 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigquery/internal/append_rows_writer_impl.h"
+#include "google/cloud/bigquery/append_rows_writer.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+namespace v1beta2 = ::google::cloud::bigquery::storage::v1beta2;
+
+namespace {
+
+Options DefaultOptions(Options opts) {
+  if (!opts.has<bigquery::AppendRowsMaxBatchBytesOption>()) {
+    opts.set<bigquery::AppendRowsMaxBatchBytesOption>(1024 * 1024);
+  }
+  if (!opts.has<bigquery::AppendRowsMaxInFlightOption>()) {
+    opts.set<bigquery::AppendRowsMaxInFlightOption>(8);
+  }
+  return opts;
+}
+
+}  // namespace
+
+std::shared_ptr<google::protobuf::DescriptorProto const> CachedDescriptorProto(
+    google::protobuf::Descriptor const& descriptor) {
+  // Descriptors live as long as their pool, typically for the lifetime of the
+  // program, so the cache never needs to evict entries.
+  static auto* const kMu = new std::mutex;
+  static auto* const kCache = new std::unordered_map<
+      google::protobuf::Descriptor const*,
+      std::shared_ptr<google::protobuf::DescriptorProto const>>;
+  std::lock_guard<std::mutex> lk(*kMu);
+  auto& entry = (*kCache)[&descriptor];
+  if (!entry) {
+    auto proto = std::make_shared<google::protobuf::DescriptorProto>();
+    descriptor.CopyTo(proto.get());
+    entry = std::move(proto);
+  }
+  return entry;
+}
+
+std::shared_ptr<AppendRowsWriterImpl> AppendRowsWriterImpl::Create(
+    std::unique_ptr<AppendRowsStream> stream, std::string write_stream,
+    std::shared_ptr<google::protobuf::DescriptorProto const> schema,
+    Options const& opts) {
+  auto self = std::shared_ptr<AppendRowsWriterImpl>(
+      new AppendRowsWriterImpl(std::move(stream), std::move(write_stream),
+                               std::move(schema), DefaultOptions(opts)));
+  self->Start();
+  return self;
+}
+
+AppendRowsWriterImpl::AppendRowsWriterImpl(
+    std::unique_ptr<AppendRowsStream> stream, std::string write_stream,
+    std::shared_ptr<google::protobuf::DescriptorProto const> schema,
+    Options const& opts)
+    : stream_(std::move(stream)),
+      write_stream_(std::move(write_stream)),
+      schema_(std::move(schema)),
+      max_batch_bytes_((std::max)(
+          std::size_t{1}, opts.get<bigquery::AppendRowsMaxBatchBytesOption>())),
+      max_in_flight_((std::max)(
+          std::size_t{1}, opts.get<bigquery::AppendRowsMaxInFlightOption>())) {
+  if (opts.has<bigquery::AppendRowsOffsetOption>()) {
+    next_offset_ = opts.get<bigquery::AppendRowsOffsetOption>();
+  }
+}
+
+future<StatusOr<std::int64_t>> AppendRowsWriterImpl::Append(
+    std::string serialized_row) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (closing_ || finished_) {
+    auto status = !status_.ok() ? status_
+                                : Status(StatusCode::kFailedPrecondition,
+                                         "the AppendRows writer is closed");
+    return make_ready_future(StatusOr<std::int64_t>(std::move(status)));
+  }
+  if (current_.bytes != 0 &&
+      current_.bytes + serialized_row.size() > max_batch_bytes_) {
+    Seal(lk);
+  }
+  current_.bytes += serialized_row.size();
+  current_.rows.add_serialized_rows(std::move(serialized_row));
+  current_.promises.emplace_back();
+  auto f = current_.promises.back().get_future();
+  if (current_.bytes >= max_batch_bytes_) Seal(lk);
+  MaybeWrite(std::move(lk));
+  return f;
+}
+
+void AppendRowsWriterImpl::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  Seal(lk);
+  MaybeWrite(std::move(lk));
+}
+
+future<Status> AppendRowsWriterImpl::Close() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (closing_) {
+    return make_ready_future(Status(StatusCode::kFailedPrecondition,
+                                    "Close() was already called"));
+  }
+  closing_ = true;
+  if (finished_) return make_ready_future(status_);
+  Seal(lk);
+  auto f = closed_.get_future();
+  MaybeWrite(std::move(lk));
+  return f;
+}
+
+void AppendRowsWriterImpl::Cancel() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (finished_) return;
+  lk.unlock();
+  stream_->Cancel();
+}
+
+void AppendRowsWriterImpl::Start() {
+  auto self = shared_from_this();
+  stream_->Start().then([self](future<bool> f) { self->OnStart(f.get()); });
+}
+
+void AppendRowsWriterImpl::OnStart(bool ok) {
+  if (!ok) {
+    auto self = shared_from_this();
+    stream_->Finish().then(
+        [self](future<Status> f) { self->OnFinish(f.get()); });
+    return;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  running_ = true;
+  lk.unlock();
+  Read();
+  MaybeWrite(std::unique_lock<std::mutex>(mu_));
+}
+
+void AppendRowsWriterImpl::Read() {
+  auto self = shared_from_this();
+  stream_->Read().then(
+      [self](future<absl::optional<v1beta2::AppendRowsResponse>> f) {
+        self->OnRead(f.get());
+      });
+}
+
+void AppendRowsWriterImpl::OnRead(
+    absl::optional<v1beta2::AppendRowsResponse> response) {
+  if (!response) {
+    auto self = shared_from_this();
+    stream_->Finish().then(
+        [self](future<Status> f) { self->OnFinish(f.get()); });
+    return;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  if (in_flight_.empty()) {
+    // Unexpected, there is no append waiting for this response.
+    lk.unlock();
+    return Read();
+  }
+  auto batch = std::move(in_flight_.front());
+  in_flight_.pop_front();
+  // The batch left the pipeline, start the next one before satisfying the
+  // promises, their continuations may take a while.
+  MaybeWrite(std::move(lk));
+  if (response->has_error()) {
+    auto status = MakeStatusFromRpcError(response->error());
+    for (auto& p : batch.promises) p.set_value(status);
+  } else {
+    auto const& result = response->append_result();
+    auto const base =
+        result.has_offset() ? result.offset().value() : batch.offset;
+    std::int64_t i = 0;
+    for (auto& p : batch.promises) p.set_value(base < 0 ? -1 : base + i++);
+  }
+  Read();
+}
+
+void AppendRowsWriterImpl::OnWrite(bool ok) {
+  std::unique_lock<std::mutex> lk(mu_);
+  writing_ = false;
+  // On failures the pending `Read()` fails too, and `Finish()` reports the
+  // error.
+  if (!ok) return;
+  MaybeWrite(std::move(lk));
+}
+
+void AppendRowsWriterImpl::OnFinish(Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  running_ = false;
+  finished_ = true;
+  std::vector<promise<StatusOr<std::int64_t>>> orphans;
+  auto collect = [&orphans](Batch& b) {
+    for (auto& p : b.promises) orphans.push_back(std::move(p));
+  };
+  for (auto& b : in_flight_) collect(b);
+  for (auto& b : pending_) collect(b);
+  collect(current_);
+  in_flight_.clear();
+  pending_.clear();
+  current_ = Batch{};
+  if (status.ok() && !orphans.empty()) {
+    status = Status(StatusCode::kUnavailable,
+                    "the AppendRows stream closed before all the rows were "
+                    "acknowledged");
+  }
+  status_ = status;
+  auto const closing = closing_;
+  lk.unlock();
+  for (auto& p : orphans) p.set_value(status);
+  if (closing) closed_.set_value(std::move(status));
+}
+
+void AppendRowsWriterImpl::Seal(std::unique_lock<std::mutex> const&) {
+  if (current_.promises.empty()) return;
+  if (next_offset_) {
+    current_.offset = *next_offset_;
+    *next_offset_ += static_cast<std::int64_t>(current_.promises.size());
+  }
+  pending_.push_back(std::move(current_));
+  current_ = Batch{};
+}
+
+void AppendRowsWriterImpl::MaybeWrite(std::unique_lock<std::mutex> lk) {
+  if (!running_ || writing_) return;
+  if (pending_.empty()) {
+    if (!closing_ || writes_done_) return;
+    writes_done_ = true;
+    lk.unlock();
+    auto self = shared_from_this();
+    stream_->WritesDone().then([self](future<bool>) {});
+    return;
+  }
+  if (in_flight_.size() >= max_in_flight_) return;
+
+  v1beta2::AppendRowsRequest request;
+  auto& proto_rows = *request.mutable_proto_rows();
+  if (!schema_sent_) {
+    // Only the first request in the stream needs the stream name and schema.
+    request.set_write_stream(write_stream_);
+    *proto_rows.mutable_writer_schema()->mutable_proto_descriptor() =
+        *schema_;
+    schema_sent_ = true;
+  }
+  auto& batch = pending_.front();
+  if (batch.offset >= 0) request.mutable_offset()->set_value(batch.offset);
+  proto_rows.mutable_rows()->Swap(&batch.rows);
+  in_flight_.push_back(std::move(batch));
+  pending_.pop_front();
+  writing_ = true;
+  lk.unlock();
+  auto self = shared_from_this();
+  stream_->Write(request, grpc::WriteOptions())
+      .then([self](future<bool> f) { self->OnWrite(f.get()); });
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
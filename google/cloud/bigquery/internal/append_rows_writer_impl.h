@@ -0,0 +1,129 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_APPEND_ROWS_WRITER_IMPL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_APPEND_ROWS_WRITER_IMPL_H
+
+#include "google/cloud/future.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <google/cloud/bigquery/storage/v1beta2/storage.pb.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+using AppendRowsStream = ::google::cloud::internal::AsyncStreamingReadWriteRpc<
+    google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+    google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>;
+
+/**
+ * Returns the `DescriptorProto` for @p descriptor.
+ *
+ * The conversion is cached, writers for the same message type share the
+ * result.
+ */
+std::shared_ptr<google::protobuf::DescriptorProto const> CachedDescriptorProto(
+    google::protobuf::Descriptor const& descriptor);
+
+/**
+ * Pipelines the requests of an `AppendRows` stream.
+ *
+ * The rows are batched by size, and up to `AppendRowsMaxInFlightOption`
+ * batches are written before their responses arrive. The responses of an
+ * `AppendRows` stream arrive in the order of the requests, so the writer keeps
+ * a queue of the batches in flight and matches each response to the oldest.
+ *
+ * gRPC allows a single outstanding `Write()` (and a single `Read()`) per
+ * stream, the batches waiting for their turn are kept in `pending_`.
+ */
+class AppendRowsWriterImpl
+    : public std::enable_shared_from_this<AppendRowsWriterImpl> {
+ public:
+  static std::shared_ptr<AppendRowsWriterImpl> Create(
+      std::unique_ptr<AppendRowsStream> stream, std::string write_stream,
+      std::shared_ptr<google::protobuf::DescriptorProto const> schema,
+      Options const& opts);
+
+  future<StatusOr<std::int64_t>> Append(std::string serialized_row);
+  void Flush();
+  future<Status> Close();
+  void Cancel();
+
+ private:
+  AppendRowsWriterImpl(
+      std::unique_ptr<AppendRowsStream> stream, std::string write_stream,
+      std::shared_ptr<google::protobuf::DescriptorProto const> schema,
+      Options const& opts);
+
+  struct Batch {
+    google::cloud::bigquery::storage::v1beta2::ProtoRows rows;
+    std::size_t bytes = 0;
+    std::int64_t offset = -1;
+    std::vector<promise<StatusOr<std::int64_t>>> promises;
+  };
+
+  void Start();
+  void OnStart(bool ok);
+  void Read();
+  void OnRead(absl::optional<
+              google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>
+                  response);
+  void OnWrite(bool ok);
+  void OnFinish(Status status);
+  void Seal(std::unique_lock<std::mutex> const& lk);
+  void MaybeWrite(std::unique_lock<std::mutex> lk);
+
+  std::unique_ptr<AppendRowsStream> const stream_;
+  std::string const write_stream_;
+  std::shared_ptr<google::protobuf::DescriptorProto const> const schema_;
+  std::size_t const max_batch_bytes_;
+  std::size_t const max_in_flight_;
+
+  std::mutex mu_;
+  Batch current_;
+  std::deque<Batch> pending_;
+  std::deque<Batch> in_flight_;
+  absl::optional<std::int64_t> next_offset_;
+  bool running_ = false;
+  bool writing_ = false;
+  bool schema_sent_ = false;
+  bool closing_ = false;
+  bool writes_done_ = false;
+  bool finished_ = false;
+  Status status_;
+  promise<Status> closed_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_APPEND_ROWS_WRITER_IMPL_H
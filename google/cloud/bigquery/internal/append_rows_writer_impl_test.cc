@@ -0,0 +1,246 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigquery/internal/append_rows_writer_impl.h"
+#include "google/cloud/bigquery/append_rows_writer.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/wrappers.pb.h>
+#include <gmock/gmock.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::bigquery::storage::v1beta2::AppendRowsRequest;
+using ::google::cloud::bigquery::storage::v1beta2::AppendRowsResponse;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+class MockAppendRowsStream : public AppendRowsStream {
+ public:
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD(future<bool>, Start, (), (override));
+  MOCK_METHOD(future<absl::optional<AppendRowsResponse>>, Read, (),
+              (override));
+  MOCK_METHOD(future<bool>, Write,
+              (AppendRowsRequest const&, grpc::WriteOptions), (override));
+  MOCK_METHOD(future<bool>, WritesDone, (), (override));
+  MOCK_METHOD(future<Status>, Finish, (), (override));
+};
+
+/**
+ * A fake service: it records the requests and lets the test send the
+ * responses.
+ */
+struct FakeService {
+  std::vector<AppendRowsRequest> requests;
+  std::deque<promise<absl::optional<AppendRowsResponse>>> reads;
+  bool writes_done = false;
+
+  std::unique_ptr<MockAppendRowsStream> MakeStream() {
+    auto stream = absl::make_unique<MockAppendRowsStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Read).WillRepeatedly([this] {
+      reads.emplace_back();
+      return reads.back().get_future();
+    });
+    EXPECT_CALL(*stream, Write)
+        .WillRepeatedly([this](AppendRowsRequest const& r, grpc::WriteOptions) {
+          requests.push_back(r);
+          return make_ready_future(true);
+        });
+    EXPECT_CALL(*stream, WritesDone).WillRepeatedly([this] {
+      writes_done = true;
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Finish).WillRepeatedly([] {
+      return make_ready_future(Status{});
+    });
+    return stream;
+  }
+
+  // Satisfies the oldest pending `Read()`.
+  void Respond(absl::optional<AppendRowsResponse> response) {
+    ASSERT_FALSE(reads.empty());
+    auto p = std::move(reads.front());
+    reads.pop_front();
+    p.set_value(std::move(response));
+  }
+};
+
+AppendRowsResponse MakeResponse(std::int64_t offset) {
+  AppendRowsResponse response;
+  response.mutable_append_result()->mutable_offset()->set_value(offset);
+  return response;
+}
+
+std::vector<std::string> Rows(AppendRowsRequest const& request) {
+  auto const& rows = request.proto_rows().rows().serialized_rows();
+  return {rows.begin(), rows.end()};
+}
+
+std::shared_ptr<AppendRowsWriterImpl> MakeWriter(FakeService& service,
+                                                 Options opts) {
+  return AppendRowsWriterImpl::Create(
+      service.MakeStream(), "test-stream",
+      CachedDescriptorProto(*google::protobuf::StringValue::descriptor()),
+      opts);
+}
+
+TEST(AppendRowsWriterImplTest, CachedDescriptorProto) {
+  auto const& descriptor = *google::protobuf::StringValue::descriptor();
+  auto a = CachedDescriptorProto(descriptor);
+  auto b = CachedDescriptorProto(descriptor);
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_EQ("StringValue", a->name());
+}
+
+TEST(AppendRowsWriterImplTest, PipelinesBatches) {
+  FakeService service;
+  auto writer = MakeWriter(
+      service, Options{}
+                   .set<bigquery::AppendRowsMaxBatchBytesOption>(8)
+                   .set<bigquery::AppendRowsMaxInFlightOption>(2));
+
+  std::vector<future<StatusOr<std::int64_t>>> results;
+  for (auto const* row : {"aaaa", "bbbb", "cccc", "dddd", "eeee", "ffff"}) {
+    results.push_back(writer->Append(row));
+  }
+  // Two batches are in flight, the third waits for a response.
+  ASSERT_EQ(2, service.requests.size());
+  EXPECT_THAT(Rows(service.requests[0]), ElementsAre("aaaa", "bbbb"));
+  EXPECT_THAT(Rows(service.requests[1]), ElementsAre("cccc", "dddd"));
+
+  // Only the first request has the stream name and schema.
+  EXPECT_EQ("test-stream", service.requests[0].write_stream());
+  EXPECT_EQ("StringValue", service.requests[0]
+                               .proto_rows()
+                               .writer_schema()
+                               .proto_descriptor()
+                               .name());
+  EXPECT_TRUE(service.requests[1].write_stream().empty());
+  EXPECT_FALSE(service.requests[1].proto_rows().has_writer_schema());
+  // Without `AppendRowsOffsetOption` the requests have no offsets.
+  EXPECT_FALSE(service.requests[0].has_offset());
+
+  service.Respond(MakeResponse(0));
+  ASSERT_EQ(3, service.requests.size());
+  EXPECT_THAT(Rows(service.requests[2]), ElementsAre("eeee", "ffff"));
+  EXPECT_EQ(0, *results[0].get());
+  EXPECT_EQ(1, *results[1].get());
+
+  auto closed = writer->Close();
+  EXPECT_TRUE(service.writes_done);
+  service.Respond(MakeResponse(2));
+  service.Respond(MakeResponse(4));
+  service.Respond(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+  EXPECT_EQ(3, *results[3].get());
+  EXPECT_EQ(5, *results[5].get());
+
+  EXPECT_THAT(writer->Append("gggg").get(),
+              StatusIs(StatusCode::kFailedPrecondition));
+}
+
+TEST(AppendRowsWriterImplTest, TracksOffsets) {
+  FakeService service;
+  auto writer = MakeWriter(
+      service, Options{}
+                   .set<bigquery::AppendRowsMaxBatchBytesOption>(1024)
+                   .set<bigquery::AppendRowsOffsetOption>(100));
+
+  auto r0 = writer->Append("a");
+  auto r1 = writer->Append("b");
+  EXPECT_TRUE(service.requests.empty());
+  writer->Flush();
+  auto r2 = writer->Append("c");
+  auto closed = writer->Close();
+  ASSERT_EQ(2, service.requests.size());
+  EXPECT_EQ(100, service.requests[0].offset().value());
+  EXPECT_EQ(102, service.requests[1].offset().value());
+
+  // The `_default` stream does not return offsets, the writer uses its own.
+  service.Respond(AppendRowsResponse{});
+  service.Respond(AppendRowsResponse{});
+  service.Respond(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+  EXPECT_EQ(100, *r0.get());
+  EXPECT_EQ(101, *r1.get());
+  EXPECT_EQ(102, *r2.get());
+}
+
+TEST(AppendRowsWriterImplTest, ErrorResponse) {
+  FakeService service;
+  auto writer = MakeWriter(
+      service, Options{}.set<bigquery::AppendRowsMaxBatchBytesOption>(1));
+
+  auto r0 = writer->Append("a");
+  auto r1 = writer->Append("b");
+  AppendRowsResponse error;
+  error.mutable_error()->set_code(grpc::StatusCode::OUT_OF_RANGE);
+  error.mutable_error()->set_message("bad offset");
+  service.Respond(error);
+  service.Respond(MakeResponse(7));
+  EXPECT_THAT(r0.get(), StatusIs(StatusCode::kOutOfRange, "bad offset"));
+  EXPECT_EQ(7, *r1.get());
+
+  auto closed = writer->Close();
+  service.Respond(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+}
+
+TEST(AppendRowsWriterImplTest, StreamClosedEarly) {
+  FakeService service;
+  auto writer = MakeWriter(service, Options{});
+
+  auto r0 = writer->Append("a");
+  writer->Flush();
+  // The stream closes without a response for the batch in flight.
+  service.Respond(absl::nullopt);
+  EXPECT_THAT(r0.get(), StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(writer->Append("b").get(), StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(writer->Close().get(), StatusIs(StatusCode::kUnavailable));
+}
+
+TEST(AppendRowsWriterImplTest, StartFailure) {
+  auto stream = absl::make_unique<MockAppendRowsStream>();
+  EXPECT_CALL(*stream, Start).WillOnce([] { return make_ready_future(false); });
+  EXPECT_CALL(*stream, Finish).WillOnce([] {
+    return make_ready_future(Status(StatusCode::kPermissionDenied, "uh-oh"));
+  });
+  auto writer = AppendRowsWriterImpl::Create(
+      std::move(stream), "test-stream",
+      CachedDescriptorProto(*google::protobuf::StringValue::descriptor()),
+      Options{});
+
+  EXPECT_THAT(writer->Append("a").get(),
+              StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+  EXPECT_THAT(writer->Close().get(),
+              StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
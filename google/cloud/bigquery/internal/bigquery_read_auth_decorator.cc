@@ -52,6 +52,19 @@ BigQueryReadAuth::ReadRows(
   return child_->ReadRows(std::move(context), request);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+BigQueryReadAuth::AsyncReadRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadRpcError<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
+  return child_->AsyncReadRows(cq, std::move(context), request);
+}
+
 StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
 BigQueryReadAuth::SplitReadStream(
     grpc::ClientContext& context,
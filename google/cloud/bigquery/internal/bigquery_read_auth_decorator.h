@@ -49,6 +49,13 @@ class BigQueryReadAuth : public BigQueryReadStub {
            google::cloud::bigquery::storage::v1::ReadRowsRequest const& request)
       override;
 
+  std::unique_ptr<internal::AsyncStreamingReadRpc<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+  AsyncReadRows(google::cloud::CompletionQueue& cq,
+                std::unique_ptr<grpc::ClientContext> context,
+                google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                    request) override;
+
   StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
   SplitReadStream(
       grpc::ClientContext& context,
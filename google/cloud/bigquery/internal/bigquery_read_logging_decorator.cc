@@ -70,6 +70,22 @@ BigQueryReadLogging::ReadRows(
       std::move(context), request, __func__, tracing_options_);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+BigQueryReadLogging::AsyncReadRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                 request) {
+        return child_->AsyncReadRows(cq, std::move(context), request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
+
 StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
 BigQueryReadLogging::SplitReadStream(
     grpc::ClientContext& context,
@@ -17,6 +17,7 @@
 // source: google/cloud/bigquery/storage/v1/storage.proto
 #include "google/cloud/bigquery/internal/bigquery_read_metadata_decorator.h"
 #include "google/cloud/internal/api_client_header.h"
+#include "google/cloud/internal/grpc_trace_context.h"
 #include "google/cloud/status_or.h"
 #include <google/cloud/bigquery/storage/v1/storage.grpc.pb.h>
 #include <memory>
@@ -46,9 +47,21 @@ BigQueryReadMetadata::ReadRows(
     std::unique_ptr<grpc::ClientContext> context,
     google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
   SetMetadata(*context, "read_stream=" + request.read_stream());
+  internal::InjectTraceContext(*context);
   return child_->ReadRows(std::move(context), request);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+BigQueryReadMetadata::AsyncReadRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  SetMetadata(*context, "read_stream=" + request.read_stream());
+  internal::InjectTraceContext(*context);
+  return child_->AsyncReadRows(cq, std::move(context), request);
+}
+
 StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
 BigQueryReadMetadata::SplitReadStream(
     grpc::ClientContext& context,
@@ -60,8 +73,14 @@ BigQueryReadMetadata::SplitReadStream(
 
 void BigQueryReadMetadata::SetMetadata(grpc::ClientContext& context,
                                        std::string const& request_params) {
-  context.AddMetadata("x-goog-request-params", request_params);
-  context.AddMetadata("x-goog-api-client", api_client_header_);
+  context.AddMetadata(google::cloud::internal::RequestParamsKey(),
+                      request_params);
+  SetMetadata(context);
+}
+
+void BigQueryReadMetadata::SetMetadata(grpc::ClientContext& context) {
+  context.AddMetadata(google::cloud::internal::ApiClientHeaderKey(),
+                      api_client_header_);
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
@@ -44,6 +44,13 @@ class BigQueryReadMetadata : public BigQueryReadStub {
            google::cloud::bigquery::storage::v1::ReadRowsRequest const& request)
       override;
 
+  std::unique_ptr<internal::AsyncStreamingReadRpc<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+  AsyncReadRows(google::cloud::CompletionQueue& cq,
+                std::unique_ptr<grpc::ClientContext> context,
+                google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                    request) override;
+
   StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
   SplitReadStream(
       grpc::ClientContext& context,
@@ -53,6 +60,7 @@ class BigQueryReadMetadata : public BigQueryReadStub {
  private:
   void SetMetadata(grpc::ClientContext& context,
                    std::string const& request_params);
+  void SetMetadata(grpc::ClientContext& context);
   std::shared_ptr<BigQueryReadStub> child_;
   std::string api_client_header_;
 };  // BigQueryReadMetadata
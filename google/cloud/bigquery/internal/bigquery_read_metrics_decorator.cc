@@ -0,0 +1,93 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/cloud/bigquery/storage/v1/storage.proto
+#include "google/cloud/bigquery/internal/bigquery_read_metrics_decorator.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+#include "google/cloud/status_or.h"
+#include <google/cloud/bigquery/storage/v1/storage.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+BigQueryReadMetrics::BigQueryReadMetrics(
+    std::shared_ptr<BigQueryReadStub> child,
+    std::shared_ptr<RpcMetrics> metrics)
+    : child_(std::move(child)), metrics_(std::move(metrics)) {}
+
+StatusOr<google::cloud::bigquery::storage::v1::ReadSession>
+BigQueryReadMetrics::CreateReadSession(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1::CreateReadSessionRequest const&
+        request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::cloud::bigquery::storage::v1::CreateReadSessionRequest const&
+              request) { return child_->CreateReadSession(context, request); },
+      context, request, metrics_->Method("BigQueryRead.CreateReadSession"));
+}
+
+std::unique_ptr<internal::StreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+BigQueryReadMetrics::ReadRows(
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](std::unique_ptr<grpc::ClientContext> context,
+             google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                 request) {
+        return child_->ReadRows(std::move(context), request);
+      },
+      std::move(context), request, metrics_->Method("BigQueryRead.ReadRows"));
+}
+
+std::unique_ptr<internal::AsyncStreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+BigQueryReadMetrics::AsyncReadRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                 request) {
+        return child_->AsyncReadRows(cq, std::move(context), request);
+      },
+      cq, std::move(context), request,
+      metrics_->Method("BigQueryRead.ReadRows"));
+}
+
+StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
+BigQueryReadMetrics::SplitReadStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&
+        request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&
+                 request) { return child_->SplitReadStream(context, request); },
+      context, request, metrics_->Method("BigQueryRead.SplitReadStream"));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,83 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/cloud/bigquery/storage/v1/storage.proto
+#include "google/cloud/bigquery/internal/bigquery_read_round_robin_decorator.h"
+#include "google/cloud/status_or.h"
+#include <google/cloud/bigquery/storage/v1/storage.grpc.pb.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+BigQueryReadRoundRobin::BigQueryReadRoundRobin(
+    std::vector<std::shared_ptr<BigQueryReadStub>> children,
+    std::shared_ptr<google::cloud::internal::ChannelPicker> picker)
+    : children_(std::move(children)), picker_(std::move(picker)) {}
+
+StatusOr<google::cloud::bigquery::storage::v1::ReadSession>
+BigQueryReadRoundRobin::CreateReadSession(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1::CreateReadSessionRequest const&
+        request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->CreateReadSession(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+std::unique_ptr<internal::StreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+BigQueryReadRoundRobin::ReadRows(
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto stream = children_[index]->ReadRows(std::move(context), request);
+  picker_->Release(index);
+  return stream;
+}
+
+std::unique_ptr<internal::AsyncStreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+BigQueryReadRoundRobin::AsyncReadRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto stream =
+      children_[index]->AsyncReadRows(cq, std::move(context), request);
+  picker_->Release(index);
+  return stream;
+}
+
+StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
+BigQueryReadRoundRobin::SplitReadStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&
+        request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->SplitReadStream(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,73 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/cloud/bigquery/storage/v1/storage.proto
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_READ_ROUND_ROBIN_DECORATOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_READ_ROUND_ROBIN_DECORATOR_H
+
+#include "google/cloud/bigquery/internal/bigquery_read_stub.h"
+#include "google/cloud/internal/channel_picker.h"
+#include "google/cloud/version.h"
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+class BigQueryReadRoundRobin : public BigQueryReadStub {
+ public:
+  ~BigQueryReadRoundRobin() override = default;
+  BigQueryReadRoundRobin(
+      std::vector<std::shared_ptr<BigQueryReadStub>> children,
+      std::shared_ptr<google::cloud::internal::ChannelPicker> picker);
+
+  StatusOr<google::cloud::bigquery::storage::v1::ReadSession> CreateReadSession(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1::CreateReadSessionRequest const&
+          request) override;
+
+  std::unique_ptr<internal::StreamingReadRpc<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+  ReadRows(std::unique_ptr<grpc::ClientContext> context,
+           google::cloud::bigquery::storage::v1::ReadRowsRequest const& request)
+      override;
+
+  std::unique_ptr<internal::AsyncStreamingReadRpc<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+  AsyncReadRows(google::cloud::CompletionQueue& cq,
+                std::unique_ptr<grpc::ClientContext> context,
+                google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                    request) override;
+
+  StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
+  SplitReadStream(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1::SplitReadStreamRequest const&
+          request) override;
+
+ private:
+  std::vector<std::shared_ptr<BigQueryReadStub>> children_;
+  std::shared_ptr<google::cloud::internal::ChannelPicker> picker_;
+};  // BigQueryReadRoundRobin
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_READ_ROUND_ROBIN_DECORATOR_H
@@ -55,6 +55,24 @@ DefaultBigQueryReadStub::ReadRows(
       std::move(client_context), std::move(stream));
 }
 
+std::unique_ptr<internal::AsyncStreamingReadRpc<
+    google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+DefaultBigQueryReadStub::AsyncReadRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) {
+  return internal::MakeStreamingReadRpc<
+      google::cloud::bigquery::storage::v1::ReadRowsRequest,
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>(
+      cq, std::move(client_context), request,
+      [this](
+          grpc::ClientContext* context,
+          google::cloud::bigquery::storage::v1::ReadRowsRequest const& request,
+          grpc::CompletionQueue* cq) {
+        return grpc_stub_->PrepareAsyncReadRows(context, request, cq);
+      });
+}
+
 StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
 DefaultBigQueryReadStub::SplitReadStream(
     grpc::ClientContext& client_context,
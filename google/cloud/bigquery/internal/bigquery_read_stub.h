@@ -18,6 +18,8 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_READ_STUB_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_READ_STUB_H
 
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/async_streaming_read_rpc.h"
 #include "google/cloud/internal/streaming_read_rpc.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
@@ -45,6 +47,13 @@ class BigQueryReadStub {
       std::unique_ptr<grpc::ClientContext> context,
       google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) = 0;
 
+  virtual std::unique_ptr<internal::AsyncStreamingReadRpc<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+  AsyncReadRows(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::cloud::bigquery::storage::v1::ReadRowsRequest const& request) = 0;
+
   virtual StatusOr<
       google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
   SplitReadStream(
@@ -72,6 +81,13 @@ class DefaultBigQueryReadStub : public BigQueryReadStub {
            google::cloud::bigquery::storage::v1::ReadRowsRequest const& request)
       override;
 
+  std::unique_ptr<internal::AsyncStreamingReadRpc<
+      google::cloud::bigquery::storage::v1::ReadRowsResponse>>
+  AsyncReadRows(google::cloud::CompletionQueue& cq,
+                std::unique_ptr<grpc::ClientContext> client_context,
+                google::cloud::bigquery::storage::v1::ReadRowsRequest const&
+                    request) override;
+
   StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>
   SplitReadStream(
       grpc::ClientContext& client_context,
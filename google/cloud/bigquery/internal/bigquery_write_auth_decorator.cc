@@ -0,0 +1,102 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#include "google/cloud/bigquery/internal/bigquery_write_auth_decorator.h"
+#include "absl/memory/memory.h"
+#include <google/cloud/bigquery/storage/v1beta2/storage.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+BigQueryWriteAuth::BigQueryWriteAuth(
+    std::shared_ptr<google::cloud::internal::GrpcAuthenticationStrategy> auth,
+    std::shared_ptr<BigQueryWriteStub> child)
+    : auth_(std::move(auth)), child_(std::move(child)) {}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+BigQueryWriteAuth::CreateWriteStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::CreateWriteStreamRequest const&
+        request) {
+  auto status = auth_->ConfigureContext(context);
+  if (!status.ok()) return status;
+  return child_->CreateWriteStream(context, request);
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+    google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>>
+BigQueryWriteAuth::AsyncAppendRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1beta2::AppendRowsRequest const&
+        request) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadWriteRpcError<
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
+  return child_->AsyncAppendRows(cq, std::move(context), request);
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+BigQueryWriteAuth::GetWriteStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::GetWriteStreamRequest const&
+        request) {
+  auto status = auth_->ConfigureContext(context);
+  if (!status.ok()) return status;
+  return child_->GetWriteStream(context, request);
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse>
+BigQueryWriteAuth::FinalizeWriteStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamRequest const&
+        request) {
+  auto status = auth_->ConfigureContext(context);
+  if (!status.ok()) return status;
+  return child_->FinalizeWriteStream(context, request);
+}
+
+StatusOr<
+    google::cloud::bigquery::storage::v1beta2::BatchCommitWriteStreamsResponse>
+BigQueryWriteAuth::BatchCommitWriteStreams(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::
+        BatchCommitWriteStreamsRequest const& request) {
+  auto status = auth_->ConfigureContext(context);
+  if (!status.ok()) return status;
+  return child_->BatchCommitWriteStreams(context, request);
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::FlushRowsResponse>
+BigQueryWriteAuth::FlushRows(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::FlushRowsRequest const&
+        request) {
+  auto status = auth_->ConfigureContext(context);
+  if (!status.ok()) return status;
+  return child_->FlushRows(context, request);
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,102 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#include "google/cloud/bigquery/internal/bigquery_write_metadata_decorator.h"
+#include "google/cloud/internal/api_client_header.h"
+#include "google/cloud/internal/grpc_trace_context.h"
+#include "google/cloud/status_or.h"
+#include <google/cloud/bigquery/storage/v1beta2/storage.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+BigQueryWriteMetadata::BigQueryWriteMetadata(
+    std::shared_ptr<BigQueryWriteStub> child)
+    : child_(std::move(child)),
+      api_client_header_(google::cloud::internal::ApiClientHeader()) {}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+BigQueryWriteMetadata::CreateWriteStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::CreateWriteStreamRequest const&
+        request) {
+  SetMetadata(context, "parent=" + request.parent());
+  return child_->CreateWriteStream(context, request);
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+    google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>>
+BigQueryWriteMetadata::AsyncAppendRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::cloud::bigquery::storage::v1beta2::AppendRowsRequest const&
+        request) {
+  SetMetadata(*context, "write_stream=" + request.write_stream());
+  internal::InjectTraceContext(*context);
+  return child_->AsyncAppendRows(cq, std::move(context), request);
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+BigQueryWriteMetadata::GetWriteStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::GetWriteStreamRequest const&
+        request) {
+  SetMetadata(context, "name=" + request.name());
+  return child_->GetWriteStream(context, request);
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse>
+BigQueryWriteMetadata::FinalizeWriteStream(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamRequest const&
+        request) {
+  SetMetadata(context, "name=" + request.name());
+  return child_->FinalizeWriteStream(context, request);
+}
+
+StatusOr<
+    google::cloud::bigquery::storage::v1beta2::BatchCommitWriteStreamsResponse>
+BigQueryWriteMetadata::BatchCommitWriteStreams(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::
+        BatchCommitWriteStreamsRequest const& request) {
+  SetMetadata(context, "parent=" + request.parent());
+  return child_->BatchCommitWriteStreams(context, request);
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::FlushRowsResponse>
+BigQueryWriteMetadata::FlushRows(
+    grpc::ClientContext& context,
+    google::cloud::bigquery::storage::v1beta2::FlushRowsRequest const&
+        request) {
+  SetMetadata(context, "write_stream=" + request.write_stream());
+  return child_->FlushRows(context, request);
+}
+
+void BigQueryWriteMetadata::SetMetadata(grpc::ClientContext& context,
+                                        std::string const& request_params) {
+  context.AddMetadata("x-goog-request-params", request_params);
+  context.AddMetadata("x-goog-api-client", api_client_header_);
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
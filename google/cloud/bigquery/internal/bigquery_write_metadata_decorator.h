@@ -0,0 +1,88 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_WRITE_METADATA_DECORATOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_WRITE_METADATA_DECORATOR_H
+
+#include "google/cloud/bigquery/internal/bigquery_write_stub.h"
+#include "google/cloud/version.h"
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+class BigQueryWriteMetadata : public BigQueryWriteStub {
+ public:
+  ~BigQueryWriteMetadata() override = default;
+  explicit BigQueryWriteMetadata(std::shared_ptr<BigQueryWriteStub> child);
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  CreateWriteStream(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::CreateWriteStreamRequest const&
+          request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>>
+  AsyncAppendRows(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest const&
+          request) override;
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  GetWriteStream(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::GetWriteStreamRequest const&
+          request) override;
+
+  StatusOr<
+      google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse>
+  FinalizeWriteStream(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::
+          FinalizeWriteStreamRequest const& request) override;
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::
+               BatchCommitWriteStreamsResponse>
+  BatchCommitWriteStreams(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::
+          BatchCommitWriteStreamsRequest const& request) override;
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::FlushRowsResponse>
+  FlushRows(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::FlushRowsRequest const&
+          request) override;
+
+ private:
+  void SetMetadata(grpc::ClientContext& context,
+                   std::string const& request_params);
+  std::shared_ptr<BigQueryWriteStub> child_;
+  std::string api_client_header_;
+};  // BigQueryWriteMetadata
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_WRITE_METADATA_DECORATOR_H
@@ -0,0 +1,44 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigquery/internal/bigquery_write_option_defaults.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/user_agent_prefix.h"
+#include "google/cloud/options.h"
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+Options BigQueryWriteDefaultOptions(Options options) {
+  if (!options.has<EndpointOption>()) {
+    auto env = internal::GetEnv("GOOGLE_CLOUD_CPP_BIGQUERY_WRITE_ENDPOINT");
+    options.set<EndpointOption>(env ? *env : "bigquerystorage.googleapis.com");
+  }
+  if (!options.has<GrpcCredentialOption>()) {
+    options.set<GrpcCredentialOption>(grpc::GoogleDefaultCredentials());
+  }
+  auto& products = options.lookup<UserAgentProductsOption>();
+  products.insert(products.begin(), google::cloud::internal::UserAgentPrefix());
+  return options;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
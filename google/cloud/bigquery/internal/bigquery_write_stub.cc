@@ -0,0 +1,119 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigquery/internal/bigquery_write_stub.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/status_or.h"
+#include <google/cloud/bigquery/storage/v1beta2/storage.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+BigQueryWriteStub::~BigQueryWriteStub() = default;
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+DefaultBigQueryWriteStub::CreateWriteStream(
+    grpc::ClientContext& client_context,
+    google::cloud::bigquery::storage::v1beta2::CreateWriteStreamRequest const&
+        request) {
+  google::cloud::bigquery::storage::v1beta2::WriteStream response;
+  auto status =
+      grpc_stub_->CreateWriteStream(&client_context, request, &response);
+  if (!status.ok()) {
+    return google::cloud::MakeStatusFromRpcError(status);
+  }
+  return response;
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+    google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>>
+DefaultBigQueryWriteStub::AsyncAppendRows(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    google::cloud::bigquery::storage::v1beta2::AppendRowsRequest const&) {
+  return internal::MakeStreamingReadWriteRpc<
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>(
+      cq, std::move(client_context),
+      [this](grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+        return grpc_stub_->PrepareAsyncAppendRows(context, cq);
+      });
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+DefaultBigQueryWriteStub::GetWriteStream(
+    grpc::ClientContext& client_context,
+    google::cloud::bigquery::storage::v1beta2::GetWriteStreamRequest const&
+        request) {
+  google::cloud::bigquery::storage::v1beta2::WriteStream response;
+  auto status = grpc_stub_->GetWriteStream(&client_context, request, &response);
+  if (!status.ok()) {
+    return google::cloud::MakeStatusFromRpcError(status);
+  }
+  return response;
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse>
+DefaultBigQueryWriteStub::FinalizeWriteStream(
+    grpc::ClientContext& client_context,
+    google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamRequest const&
+        request) {
+  google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse
+      response;
+  auto status =
+      grpc_stub_->FinalizeWriteStream(&client_context, request, &response);
+  if (!status.ok()) {
+    return google::cloud::MakeStatusFromRpcError(status);
+  }
+  return response;
+}
+
+StatusOr<
+    google::cloud::bigquery::storage::v1beta2::BatchCommitWriteStreamsResponse>
+DefaultBigQueryWriteStub::BatchCommitWriteStreams(
+    grpc::ClientContext& client_context,
+    google::cloud::bigquery::storage::v1beta2::
+        BatchCommitWriteStreamsRequest const& request) {
+  google::cloud::bigquery::storage::v1beta2::BatchCommitWriteStreamsResponse
+      response;
+  auto status =
+      grpc_stub_->BatchCommitWriteStreams(&client_context, request, &response);
+  if (!status.ok()) {
+    return google::cloud::MakeStatusFromRpcError(status);
+  }
+  return response;
+}
+
+StatusOr<google::cloud::bigquery::storage::v1beta2::FlushRowsResponse>
+DefaultBigQueryWriteStub::FlushRows(
+    grpc::ClientContext& client_context,
+    google::cloud::bigquery::storage::v1beta2::FlushRowsRequest const&
+        request) {
+  google::cloud::bigquery::storage::v1beta2::FlushRowsResponse response;
+  auto status = grpc_stub_->FlushRows(&client_context, request, &response);
+  if (!status.ok()) {
+    return google::cloud::MakeStatusFromRpcError(status);
+  }
+  return response;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
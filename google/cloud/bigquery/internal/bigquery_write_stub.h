@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_WRITE_STUB_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_WRITE_STUB_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <google/cloud/bigquery/storage/v1beta2/storage.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * The stub for the BigQuery Storage Write API.
+ *
+ * The code generator does not support bidirectional streaming RPCs, so this
+ * stub (and its decorators) are written by hand, following the layout of the
+ * generated stubs.
+ */
+class BigQueryWriteStub {
+ public:
+  virtual ~BigQueryWriteStub() = 0;
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  CreateWriteStream(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::CreateWriteStreamRequest const&
+          request) = 0;
+
+  /**
+   * Starts an `AppendRows` stream.
+   *
+   * The @p request is the first request the caller will write on the stream,
+   * the decorators use it to set up the @p context. The stub does not write it.
+   */
+  virtual std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>>
+  AsyncAppendRows(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest const&
+          request) = 0;
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  GetWriteStream(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::GetWriteStreamRequest const&
+          request) = 0;
+
+  virtual StatusOr<
+      google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse>
+  FinalizeWriteStream(grpc::ClientContext& context,
+                      google::cloud::bigquery::storage::v1beta2::
+                          FinalizeWriteStreamRequest const& request) = 0;
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::
+                       BatchCommitWriteStreamsResponse>
+  BatchCommitWriteStreams(
+      grpc::ClientContext& context,
+      google::cloud::bigquery::storage::v1beta2::
+          BatchCommitWriteStreamsRequest const& request) = 0;
+
+  virtual StatusOr<google::cloud::bigquery::storage::v1beta2::FlushRowsResponse>
+  FlushRows(grpc::ClientContext& context,
+            google::cloud::bigquery::storage::v1beta2::FlushRowsRequest const&
+                request) = 0;
+};
+
+class DefaultBigQueryWriteStub : public BigQueryWriteStub {
+ public:
+  explicit DefaultBigQueryWriteStub(
+      std::unique_ptr<google::cloud::bigquery::storage::v1beta2::
+                          BigQueryWrite::StubInterface>
+          grpc_stub)
+      : grpc_stub_(std::move(grpc_stub)) {}
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  CreateWriteStream(
+      grpc::ClientContext& client_context,
+      google::cloud::bigquery::storage::v1beta2::CreateWriteStreamRequest const&
+          request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsResponse>>
+  AsyncAppendRows(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::cloud::bigquery::storage::v1beta2::AppendRowsRequest const&
+          request) override;
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::WriteStream>
+  GetWriteStream(
+      grpc::ClientContext& client_context,
+      google::cloud::bigquery::storage::v1beta2::GetWriteStreamRequest const&
+          request) override;
+
+  StatusOr<
+      google::cloud::bigquery::storage::v1beta2::FinalizeWriteStreamResponse>
+  FinalizeWriteStream(grpc::ClientContext& client_context,
+                      google::cloud::bigquery::storage::v1beta2::
+                          FinalizeWriteStreamRequest const& request) override;
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::
+               BatchCommitWriteStreamsResponse>
+  BatchCommitWriteStreams(
+      grpc::ClientContext& client_context,
+      google::cloud::bigquery::storage::v1beta2::
+          BatchCommitWriteStreamsRequest const& request) override;
+
+  StatusOr<google::cloud::bigquery::storage::v1beta2::FlushRowsResponse>
+  FlushRows(grpc::ClientContext& client_context,
+            google::cloud::bigquery::storage::v1beta2::FlushRowsRequest const&
+                request) override;
+
+ private:
+  std::unique_ptr<google::cloud::bigquery::storage::v1beta2::BigQueryWrite::
+                      StubInterface>
+      grpc_stub_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_BIGQUERY_WRITE_STUB_H
@@ -0,0 +1,62 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigquery/internal/bigquery_write_stub_factory.h"
+#include "google/cloud/bigquery/internal/bigquery_write_auth_decorator.h"
+#include "google/cloud/bigquery/internal/bigquery_write_metadata_decorator.h"
+#include "google/cloud/bigquery/internal/bigquery_write_stub.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/unified_grpc_credentials.h"
+#include "google/cloud/options.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigquery_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+std::shared_ptr<BigQueryWriteStub> CreateDefaultBigQueryWriteStub(
+    google::cloud::CompletionQueue cq, Options const& options) {
+  auto auth = [&] {
+    if (options.has<google::cloud::UnifiedCredentialsOption>()) {
+      return google::cloud::internal::CreateAuthenticationStrategy(
+          options.get<google::cloud::UnifiedCredentialsOption>(), std::move(cq),
+          options);
+    }
+    return google::cloud::internal::CreateAuthenticationStrategy(
+        options.get<google::cloud::GrpcCredentialOption>());
+  }();
+  auto channel = auth->CreateChannel(options.get<EndpointOption>(),
+                                     internal::MakeChannelArguments(options));
+  auto service_grpc_stub =
+      google::cloud::bigquery::storage::v1beta2::BigQueryWrite::NewStub(
+          channel);
+  std::shared_ptr<BigQueryWriteStub> stub =
+      std::make_shared<DefaultBigQueryWriteStub>(std::move(service_grpc_stub));
+
+  if (auth->RequiresConfigureContext()) {
+    stub =
+        std::make_shared<BigQueryWriteAuth>(std::move(auth), std::move(stub));
+  }
+  // There is no logging decorator, the `AppendRows` payloads are serialized
+  // rows, and logging them is seldom useful.
+  return std::make_shared<BigQueryWriteMetadata>(std::move(stub));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,116 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/cloud/bigquery/storage/v1/storage.proto
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_MOCKS_FAKE_BIGQUERY_READ_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_MOCKS_FAKE_BIGQUERY_READ_SERVER_H
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include "google/cloud/version.h"
+#include <google/cloud/bigquery/storage/v1/storage.grpc.pb.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigquery_mocks {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * An in-process fake for `BigQueryRead`.
+ *
+ * Register this class with a `testing_util::EmbeddedGrpcServer` to
+ * benchmark or test the client library with the full gRPC stack. Each RPC
+ * simulates the latency and errors configured in its
+ * `testing_util::FakeServerBehavior`, and returns a canned response, which
+ * includes a payload of the configured size.
+ *
+ * The canned responses must be changed before the server starts.
+ */
+class FakeBigQueryReadServer
+    : public google::cloud::bigquery::storage::v1::BigQueryRead::Service {
+ public:
+  explicit FakeBigQueryReadServer(testing_util::FakeServerConfig config = {})
+      : behavior_(std::move(config)) {
+    behavior_.FillPayload(create_read_session_response_);
+    behavior_.FillPayload(read_rows_response_);
+    behavior_.FillPayload(split_read_stream_response_);
+  }
+
+  testing_util::FakeServerBehavior& behavior() { return behavior_; }
+
+  void set_create_read_session_response(
+      google::cloud::bigquery::storage::v1::ReadSession response) {
+    create_read_session_response_ = std::move(response);
+  }
+
+  grpc::Status CreateReadSession(
+      grpc::ServerContext*,
+      google::cloud::bigquery::storage::v1::CreateReadSessionRequest const*,
+      google::cloud::bigquery::storage::v1::ReadSession* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = create_read_session_response_;
+    return status;
+  }
+
+  void set_read_rows_response(
+      google::cloud::bigquery::storage::v1::ReadRowsResponse response) {
+    read_rows_response_ = std::move(response);
+  }
+
+  grpc::Status ReadRows(
+      grpc::ServerContext*,
+      google::cloud::bigquery::storage::v1::ReadRowsRequest const*,
+      grpc::ServerWriter<
+          google::cloud::bigquery::storage::v1::ReadRowsResponse>* writer)
+      override {
+    auto status = behavior_.Simulate();
+    if (!status.ok()) return status;
+    for (int i = 0; i != behavior_.config().stream_messages; ++i) {
+      if (!writer->Write(read_rows_response_)) break;
+    }
+    return status;
+  }
+
+  void set_split_read_stream_response(
+      google::cloud::bigquery::storage::v1::SplitReadStreamResponse response) {
+    split_read_stream_response_ = std::move(response);
+  }
+
+  grpc::Status SplitReadStream(
+      grpc::ServerContext*,
+      google::cloud::bigquery::storage::v1::SplitReadStreamRequest const*,
+      google::cloud::bigquery::storage::v1::SplitReadStreamResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = split_read_stream_response_;
+    return status;
+  }
+
+ private:
+  testing_util::FakeServerBehavior behavior_;
+  google::cloud::bigquery::storage::v1::ReadSession
+      create_read_session_response_;
+  google::cloud::bigquery::storage::v1::ReadRowsResponse read_rows_response_;
+  google::cloud::bigquery::storage::v1::SplitReadStreamResponse
+      split_read_stream_response_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery_mocks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_MOCKS_FAKE_BIGQUERY_READ_SERVER_H
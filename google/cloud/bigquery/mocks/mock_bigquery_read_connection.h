@@ -41,6 +41,21 @@ class MockBigQueryReadConnection : public bigquery::BigQueryReadConnection {
       (google::cloud::bigquery::storage::v1::ReadRowsRequest const& request),
       (override));
 
+  MOCK_METHOD(
+      StreamRange<std::shared_ptr<
+          google::cloud::bigquery::storage::v1::ReadRowsResponse const>>,
+      ReadRowsInArena,
+      (google::cloud::bigquery::storage::v1::ReadRowsRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      future<Status>, AsyncReadRows,
+      (google::cloud::bigquery::storage::v1::ReadRowsRequest const& request,
+       std::function<
+           future<bool>(google::cloud::bigquery::storage::v1::ReadRowsResponse)>
+           on_read),
+      (override));
+
   MOCK_METHOD(
       StatusOr<google::cloud::bigquery::storage::v1::SplitReadStreamResponse>,
       SplitReadStream,
@@ -0,0 +1,261 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/read_session_reader.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+namespace {
+
+using ::google::cloud::bigquery::storage::v1::CreateReadSessionRequest;
+using ::google::cloud::bigquery::storage::v1::ReadRowsRequest;
+using ::google::cloud::bigquery::storage::v1::ReadSession;
+using ::google::cloud::bigquery::storage::v1::SplitReadStreamRequest;
+
+// Streams that have already delivered this fraction of their rows are not
+// worth splitting, the split costs an RPC and a new stream.
+auto constexpr kMaxSplitProgress = 0.5;
+
+Options DefaultOptions(Options opts) {
+  if (!opts.has<ReadSessionMaxStreamsOption>()) {
+    auto constexpr kDefaultMaxStreams = 8;
+    auto const n = std::thread::hardware_concurrency();
+    opts.set<ReadSessionMaxStreamsOption>(n == 0 ? kDefaultMaxStreams : n);
+  }
+  if (!opts.has<ReadSessionMaxBufferedResponsesOption>()) {
+    opts.set<ReadSessionMaxBufferedResponsesOption>(16);
+  }
+  if (!opts.has<ReadSessionSplitStreamsOption>()) {
+    opts.set<ReadSessionSplitStreamsOption>(true);
+  }
+  if (!opts.has<ReadSessionMinStreamBytesOption>()) {
+    opts.set<ReadSessionMinStreamBytesOption>(std::int64_t{64} * 1024 * 1024);
+  }
+  return opts;
+}
+
+}  // namespace
+
+std::int32_t PlanReadStreamCount(Options opts) {
+  opts = DefaultOptions(std::move(opts));
+  auto count = static_cast<std::int64_t>((std::min)(
+      opts.get<ReadSessionMaxStreamsOption>(),
+      static_cast<std::size_t>((std::numeric_limits<std::int32_t>::max)())));
+  auto const bytes = opts.get<ReadSessionEstimatedBytesOption>();
+  if (bytes > 0) {
+    auto const min_bytes = (std::max)(
+        std::int64_t{1}, opts.get<ReadSessionMinStreamBytesOption>());
+    count = (std::min)(count, (bytes - 1) / min_bytes + 1);
+  }
+  return static_cast<std::int32_t>((std::max)(std::int64_t{1}, count));
+}
+
+StatusOr<ReadSession> CreateReadSessionForReader(
+    std::shared_ptr<BigQueryReadConnection> const& connection,
+    CreateReadSessionRequest request, Options opts) {
+  auto count = PlanReadStreamCount(std::move(opts));
+  if (request.max_stream_count() > 0) {
+    count = (std::min)(count, request.max_stream_count());
+  }
+  request.set_max_stream_count(count);
+  return connection->CreateReadSession(request);
+}
+
+std::shared_ptr<ReadSessionReader> ReadSessionReader::Create(
+    std::shared_ptr<BigQueryReadConnection> connection,
+    ReadSession const& session, Options opts) {
+  auto reader = std::shared_ptr<ReadSessionReader>(new ReadSessionReader(
+      std::move(connection), session, DefaultOptions(std::move(opts))));
+  reader->Start();
+  return reader;
+}
+
+ReadSessionReader::ReadSessionReader(
+    std::shared_ptr<BigQueryReadConnection> connection,
+    ReadSession const& session, Options const& opts)
+    : connection_(std::move(connection)),
+      max_streams_(
+          (std::max)(std::size_t{1}, opts.get<ReadSessionMaxStreamsOption>())),
+      max_buffered_((std::max)(
+          std::size_t{1}, opts.get<ReadSessionMaxBufferedResponsesOption>())),
+      split_streams_(opts.get<ReadSessionSplitStreamsOption>()) {
+  for (auto const& s : session.streams()) pending_.push_back(s.name());
+}
+
+ReadSessionReader::~ReadSessionReader() {
+  Cancel();
+  for (auto& t : workers_) t.join();
+}
+
+absl::optional<StatusOr<ReadSessionBatch>> ReadSessionReader::Next() {
+  std::unique_lock<std::mutex> lk(mu_);
+  data_cv_.wait(lk, [this] {
+    return !buffer_.empty() || running_ == 0 || !status_.ok();
+  });
+  // Return any responses received before an error, but stop immediately on
+  // cancellation.
+  if (!buffer_.empty() && status_.code() != StatusCode::kCancelled) {
+    auto batch = std::move(buffer_.front());
+    buffer_.pop_front();
+    lk.unlock();
+    space_cv_.notify_one();
+    return StatusOr<ReadSessionBatch>(std::move(batch));
+  }
+  if (!status_.ok()) return StatusOr<ReadSessionBatch>(status_);
+  return absl::nullopt;
+}
+
+void ReadSessionReader::Cancel() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (stop_ || running_ == 0) return;
+  stop_ = true;
+  status_ = Status(StatusCode::kCancelled, "ReadSessionReader cancelled");
+  lk.unlock();
+  data_cv_.notify_all();
+  space_cv_.notify_all();
+  work_cv_.notify_all();
+}
+
+std::int64_t ReadSessionReader::split_count() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return split_count_;
+}
+
+void ReadSessionReader::Start() {
+  // With splits enabled even a single stream can keep all the threads busy.
+  auto const count =
+      split_streams_ ? max_streams_ : (std::min)(max_streams_, pending_.size());
+  std::unique_lock<std::mutex> lk(mu_);
+  running_ = count;
+  lk.unlock();
+  workers_.reserve(count);
+  for (std::size_t i = 0; i != count; ++i) {
+    workers_.emplace_back([this] { Worker(); });
+  }
+}
+
+void ReadSessionReader::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (!stop_) {
+    std::string name;
+    if (!pending_.empty()) {
+      name = std::move(pending_.front());
+      pending_.pop_front();
+    } else {
+      auto split = split_streams_ ? PickSplit() : active_.end();
+      if (split == active_.end()) {
+        // Without a split candidate this thread can only help once the active
+        // streams make progress, and is done when they are all done.
+        if (active_.empty() || !split_streams_) break;
+        ++idle_;
+        work_cv_.wait(lk);
+        --idle_;
+        continue;
+      }
+      name = SplitStream(lk, split);
+      if (name.empty()) continue;
+    }
+    auto const id = next_id_++;
+    StreamState state;
+    state.name = name;
+    active_.emplace(id, std::move(state));
+    lk.unlock();
+    auto status = ReadStream(id, name);
+    lk.lock();
+    active_.erase(id);
+    if (!status.ok() && !stop_) {
+      stop_ = true;
+      status_ = std::move(status);
+      space_cv_.notify_all();
+    }
+    work_cv_.notify_all();
+  }
+  --running_;
+  lk.unlock();
+  data_cv_.notify_all();
+  work_cv_.notify_all();
+}
+
+Status ReadSessionReader::ReadStream(std::int64_t id, std::string const& name) {
+  ReadRowsRequest request;
+  request.set_read_stream(name);
+  // The connection resumes interrupted streams, starting at the offset after
+  // the last row received, see `BigQueryReadReadRowsStreamingUpdater()`.
+  for (auto& response : connection_->ReadRows(request)) {
+    if (!response) return std::move(response).status();
+    std::unique_lock<std::mutex> lk(mu_);
+    space_cv_.wait(lk,
+                   [this] { return stop_ || buffer_.size() < max_buffered_; });
+    if (stop_) return Status{};
+    auto s = active_.find(id);
+    if (s != active_.end()) {
+      s->second.progress = response->stats().progress().at_response_end();
+      s->second.split_pending = false;
+    }
+    buffer_.push_back(ReadSessionBatch{name, *std::move(response)});
+    auto const notify_idle = idle_ != 0;
+    lk.unlock();
+    data_cv_.notify_one();
+    if (notify_idle) work_cv_.notify_all();
+  }
+  return Status{};
+}
+
+ReadSessionReader::ActiveStreams::iterator ReadSessionReader::PickSplit() {
+  auto best = active_.end();
+  for (auto i = active_.begin(); i != active_.end(); ++i) {
+    auto const& s = i->second;
+    if (!s.splittable || s.split_pending || s.progress >= kMaxSplitProgress) {
+      continue;
+    }
+    if (best == active_.end() || s.progress < best->second.progress) best = i;
+  }
+  return best;
+}
+
+std::string ReadSessionReader::SplitStream(std::unique_lock<std::mutex>& lk,
+                                           ActiveStreams::iterator split) {
+  auto const id = split->first;
+  split->second.split_pending = true;
+  SplitReadStreamRequest request;
+  request.set_name(split->second.name);
+  request.set_fraction(0.5);
+  lk.unlock();
+  auto response = connection_->SplitReadStream(request);
+  lk.lock();
+  // The stream may have finished while the split was in progress. The
+  // residual stream is still valid, but the original stream is gone.
+  auto s = active_.find(id);
+  if (!response || response->residual_stream().name().empty()) {
+    // Splitting is an optimization, ignore the errors. The server returns no
+    // residual stream when it cannot split the stream any further.
+    if (s != active_.end()) s->second.splittable = false;
+    return {};
+  }
+  // Keep `split_pending` until the stream reports its new progress, otherwise
+  // the next idle thread would split it again.
+  ++split_count_;
+  return response->residual_stream().name();
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,236 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_READ_SESSION_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_READ_SESSION_READER_H
+
+#include "google/cloud/bigquery/bigquery_read_connection.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * The maximum number of streams read concurrently by a `ReadSessionReader`.
+ *
+ * Each stream is read by a separate thread. The default is the number of
+ * hardware threads (or 8 if that is unknown), a value of 0 is treated as 1.
+ */
+struct ReadSessionMaxStreamsOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The maximum number of responses buffered by a `ReadSessionReader`.
+ *
+ * The streams stop reading once this many responses are waiting for a
+ * consumer, bounding the memory used by the reader. The default is 16, a value
+ * of 0 is treated as 1.
+ */
+struct ReadSessionMaxBufferedResponsesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Split streams that fall behind.
+ *
+ * When enabled (the default), a `ReadSessionReader` thread that runs out of
+ * streams splits the stream with the least progress using `SplitReadStream()`,
+ * and reads the residual stream.
+ */
+struct ReadSessionSplitStreamsOption {
+  using Type = bool;
+};
+
+/**
+ * The estimated size, in bytes, of the data read by a session.
+ *
+ * `CreateReadSessionForReader()` requests fewer streams for small tables, so
+ * each stream reads at least `ReadSessionMinStreamBytesOption` bytes. The
+ * default is 0, meaning the size is unknown, and the number of streams depends
+ * only on `ReadSessionMaxStreamsOption`.
+ */
+struct ReadSessionEstimatedBytesOption {
+  using Type = std::int64_t;
+};
+
+/**
+ * The minimum number of bytes worth reading in a separate stream.
+ *
+ * Streams are not free: each one holds resources in the service until it is
+ * fully read. The default is 64 MiB, a value of 0 is treated as 1.
+ */
+struct ReadSessionMinStreamBytesOption {
+  using Type = std::int64_t;
+};
+
+/**
+ * Returns the number of streams to request for a `ReadSessionReader`.
+ *
+ * Requesting more streams than there are threads to read them only increases
+ * the load on the service, and a `ReadSessionReader` splits streams when
+ * threads run out of work. The count is thus `ReadSessionMaxStreamsOption`,
+ * reduced for small tables if `ReadSessionEstimatedBytesOption` is set.
+ */
+std::int32_t PlanReadStreamCount(Options opts = {});
+
+/**
+ * Creates a read session sized for a `ReadSessionReader` using @p opts.
+ *
+ * Sets the `max_stream_count` of @p request using `PlanReadStreamCount()`. A
+ * non-zero `max_stream_count` in @p request is an upper bound for the count.
+ * Use the same @p opts to create the `ReadSessionReader`.
+ */
+StatusOr<google::cloud::bigquery::storage::v1::ReadSession>
+CreateReadSessionForReader(
+    std::shared_ptr<BigQueryReadConnection> const& connection,
+    google::cloud::bigquery::storage::v1::CreateReadSessionRequest request,
+    Options opts = {});
+
+/// One response read from a stream in a `ReadSessionReader`.
+struct ReadSessionBatch {
+  /// The name of the stream that returned this response.
+  std::string stream;
+  google::cloud::bigquery::storage::v1::ReadRowsResponse response;
+};
+
+/**
+ * Reads all the streams of a `ReadSession` concurrently.
+ *
+ * The reader starts a thread for each stream (up to
+ * `ReadSessionMaxStreamsOption`), and these threads buffer the responses until
+ * a consumer calls `Next()`. Any number of consumer threads can call `Next()`
+ * concurrently, the responses are returned in the order they were received,
+ * but responses from different streams are interleaved.
+ *
+ * Each stream is read using `BigQueryReadConnection::ReadRows()`, which resumes
+ * interrupted streams from the last offset received. If a stream fails with a
+ * permanent error, or after too many transient errors, the reader stops all the
+ * streams and `Next()` returns the error once the buffered responses are
+ * consumed.
+ *
+ * When a thread runs out of streams to read it splits the stream that lags
+ * behind (see `ReadSessionSplitStreamsOption`), balancing the work across the
+ * threads even if the server assigned more rows to some of the streams.
+ *
+ * The reader only reads @p session while it is created. The same session can
+ * be shared, without locking, by threads that do not modify it.
+ *
+ * @par Example
+ * @code
+ * namespace bq = ::google::cloud::bigquery;
+ * auto connection = bq::MakeBigQueryReadConnection();
+ * auto session = bq::CreateReadSessionForReader(connection, request);
+ * auto reader = bq::ReadSessionReader::Create(connection, *session);
+ * for (auto batch = reader->Next(); batch; batch = reader->Next()) {
+ *   if (!*batch) throw std::runtime_error(batch->status().message());
+ *   ProcessRows((*batch)->response);
+ * }
+ * @endcode
+ */
+class ReadSessionReader {
+ public:
+  static std::shared_ptr<ReadSessionReader> Create(
+      std::shared_ptr<BigQueryReadConnection> connection,
+      google::cloud::bigquery::storage::v1::ReadSession const& session,
+      Options opts = {});
+
+  /// Cancels any pending reads and waits for the threads to finish.
+  ~ReadSessionReader();
+
+  ReadSessionReader(ReadSessionReader const&) = delete;
+  ReadSessionReader& operator=(ReadSessionReader const&) = delete;
+
+  /**
+   * Returns the next response, blocking until one is available.
+   *
+   * Returns `absl::nullopt` once all the streams are fully read, or an error
+   * if any stream failed, or if the reader was cancelled.
+   */
+  absl::optional<StatusOr<ReadSessionBatch>> Next();
+
+  /**
+   * Stops reading the streams.
+   *
+   * Blocked and future calls to `Next()` return a `kCancelled` error. Any
+   * in-flight read completes in the background.
+   */
+  void Cancel();
+
+  /// The number of streams created by `SplitReadStream()`.
+  std::int64_t split_count() const;
+
+ private:
+  ReadSessionReader(std::shared_ptr<BigQueryReadConnection> connection,
+                    google::cloud::bigquery::storage::v1::ReadSession const&
+                        session,
+                    Options const& opts);
+
+  struct StreamState {
+    std::string name;
+    double progress = 0;
+    bool split_pending = false;
+    bool splittable = true;
+  };
+  using ActiveStreams = std::map<std::int64_t, StreamState>;
+
+  void Start();
+  void Worker();
+  Status ReadStream(std::int64_t id, std::string const& name);
+  ActiveStreams::iterator PickSplit();
+  std::string SplitStream(std::unique_lock<std::mutex>& lk,
+                          ActiveStreams::iterator split);
+
+  std::shared_ptr<BigQueryReadConnection> connection_;
+  std::size_t const max_streams_;
+  std::size_t const max_buffered_;
+  bool const split_streams_;
+
+  mutable std::mutex mu_;
+  std::condition_variable data_cv_;
+  std::condition_variable space_cv_;
+  std::condition_variable work_cv_;
+  std::deque<std::string> pending_;
+  std::deque<ReadSessionBatch> buffer_;
+  ActiveStreams active_;
+  std::int64_t next_id_ = 0;
+  std::size_t running_ = 0;
+  std::size_t idle_ = 0;
+  std::int64_t split_count_ = 0;
+  bool stop_ = false;
+  Status status_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_READ_SESSION_READER_H
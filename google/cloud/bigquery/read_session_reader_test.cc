@@ -0,0 +1,290 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/read_session_reader.h"
+#include "google/cloud/bigquery/mocks/mock_bigquery_read_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::bigquery::storage::v1::CreateReadSessionRequest;
+using ::google::cloud::bigquery::storage::v1::ReadRowsRequest;
+using ::google::cloud::bigquery::storage::v1::ReadRowsResponse;
+using ::google::cloud::bigquery::storage::v1::ReadSession;
+using ::google::cloud::bigquery::storage::v1::SplitReadStreamRequest;
+using ::google::cloud::bigquery::storage::v1::SplitReadStreamResponse;
+using ::google::cloud::bigquery_mocks::MockBigQueryReadConnection;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+ReadSession MakeSession(std::vector<std::string> const& streams) {
+  ReadSession session;
+  for (auto const& s : streams) session.add_streams()->set_name(s);
+  return session;
+}
+
+ReadRowsResponse MakeResponse(std::int64_t row_count, double progress) {
+  ReadRowsResponse response;
+  response.set_row_count(row_count);
+  response.mutable_stats()->mutable_progress()->set_at_response_end(progress);
+  return response;
+}
+
+/// Returns @p responses followed by @p last.
+StreamRange<ReadRowsResponse> MakeStream(
+    std::vector<ReadRowsResponse> responses, Status last = Status{}) {
+  auto i = std::make_shared<std::size_t>(0);
+  return internal::MakeStreamRange<ReadRowsResponse>(
+      [responses, last, i]() -> absl::variant<Status, ReadRowsResponse> {
+        if (*i == responses.size()) return last;
+        return responses[(*i)++];
+      });
+}
+
+/// Reads all the responses, returning the total row count for each stream.
+StatusOr<std::map<std::string, std::int64_t>> ReadAll(
+    ReadSessionReader& reader) {
+  std::map<std::string, std::int64_t> rows;
+  for (auto batch = reader.Next(); batch; batch = reader.Next()) {
+    if (!*batch) return std::move(*batch).status();
+    rows[(*batch)->stream] += (*batch)->response.row_count();
+  }
+  return rows;
+}
+
+TEST(ReadSessionReaderTest, ReadsAllStreams) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  EXPECT_CALL(*mock, ReadRows)
+      .Times(3)
+      .WillRepeatedly([](ReadRowsRequest const& request) {
+        auto const n = request.read_stream() == "s0" ? 1 : 2;
+        return MakeStream({MakeResponse(n, 0.5), MakeResponse(n, 1.0)});
+      });
+  EXPECT_CALL(*mock, SplitReadStream).Times(0);
+
+  auto reader = ReadSessionReader::Create(
+      mock, MakeSession({"s0", "s1", "s2"}),
+      Options{}
+          .set<ReadSessionSplitStreamsOption>(false)
+          .set<ReadSessionMaxBufferedResponsesOption>(1));
+  auto rows = ReadAll(*reader);
+  ASSERT_STATUS_OK(rows);
+  EXPECT_THAT(*rows, ElementsAre(Pair("s0", 2), Pair("s1", 4), Pair("s2", 4)));
+  // The reader is done, all calls return the same value.
+  EXPECT_FALSE(reader->Next().has_value());
+}
+
+TEST(ReadSessionReaderTest, MoreStreamsThanThreads) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  EXPECT_CALL(*mock, ReadRows)
+      .Times(5)
+      .WillRepeatedly([](ReadRowsRequest const&) {
+        return MakeStream({MakeResponse(3, 1.0)});
+      });
+
+  auto reader = ReadSessionReader::Create(
+      mock, MakeSession({"s0", "s1", "s2", "s3", "s4"}),
+      Options{}
+          .set<ReadSessionSplitStreamsOption>(false)
+          .set<ReadSessionMaxStreamsOption>(2));
+  auto rows = ReadAll(*reader);
+  ASSERT_STATUS_OK(rows);
+  EXPECT_THAT(*rows, ElementsAre(Pair("s0", 3), Pair("s1", 3), Pair("s2", 3),
+                                 Pair("s3", 3), Pair("s4", 3)));
+}
+
+TEST(ReadSessionReaderTest, EmptySession) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  EXPECT_CALL(*mock, ReadRows).Times(0);
+  EXPECT_CALL(*mock, SplitReadStream).Times(0);
+
+  auto reader = ReadSessionReader::Create(mock, MakeSession({}));
+  EXPECT_FALSE(reader->Next().has_value());
+}
+
+TEST(ReadSessionReaderTest, StreamError) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  EXPECT_CALL(*mock, ReadRows).WillOnce([](ReadRowsRequest const&) {
+    return MakeStream({MakeResponse(1, 0.5)},
+                      Status(StatusCode::kPermissionDenied, "uh-oh"));
+  });
+
+  auto reader = ReadSessionReader::Create(
+      mock, MakeSession({"s0"}),
+      Options{}.set<ReadSessionSplitStreamsOption>(false));
+  // The responses received before the error are returned first.
+  auto batch = reader->Next();
+  ASSERT_TRUE(batch.has_value());
+  ASSERT_STATUS_OK(*batch);
+  EXPECT_EQ(1, (*batch)->response.row_count());
+
+  batch = reader->Next();
+  ASSERT_TRUE(batch.has_value());
+  EXPECT_THAT(*batch, StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(ReadSessionReaderTest, SplitsLaggingStream) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  // Block the original stream until it is split, so the split happens while
+  // the stream is being read.
+  std::promise<void> split_done;
+  auto split_future = split_done.get_future().share();
+  EXPECT_CALL(*mock, ReadRows)
+      .WillRepeatedly([split_future](ReadRowsRequest const& request) {
+        if (request.read_stream() == "s0-residual") {
+          return MakeStream({MakeResponse(7, 1.0)});
+        }
+        split_future.get();
+        return MakeStream({MakeResponse(5, 1.0)});
+      });
+  EXPECT_CALL(*mock, SplitReadStream)
+      .WillOnce([&split_done](SplitReadStreamRequest const& request) {
+        EXPECT_EQ("s0", request.name());
+        EXPECT_EQ(0.5, request.fraction());
+        SplitReadStreamResponse response;
+        response.mutable_primary_stream()->set_name("s0");
+        response.mutable_residual_stream()->set_name("s0-residual");
+        split_done.set_value();
+        return make_status_or(response);
+      })
+      // Any other split is rejected.
+      .WillRepeatedly([](SplitReadStreamRequest const&) {
+        return make_status_or(SplitReadStreamResponse{});
+      });
+
+  auto reader = ReadSessionReader::Create(
+      mock, MakeSession({"s0"}),
+      Options{}.set<ReadSessionMaxStreamsOption>(2));
+  auto rows = ReadAll(*reader);
+  ASSERT_STATUS_OK(rows);
+  EXPECT_THAT(*rows, ElementsAre(Pair("s0", 5), Pair("s0-residual", 7)));
+  EXPECT_EQ(1, reader->split_count());
+}
+
+TEST(ReadSessionReaderTest, SplitErrorsAreIgnored) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  std::promise<void> split_done;
+  auto split_future = split_done.get_future().share();
+  EXPECT_CALL(*mock, ReadRows)
+      .WillOnce([split_future](ReadRowsRequest const&) {
+        split_future.get();
+        return MakeStream({MakeResponse(5, 1.0)});
+      });
+  EXPECT_CALL(*mock, SplitReadStream)
+      .WillOnce([&split_done](SplitReadStreamRequest const&) {
+        split_done.set_value();
+        return StatusOr<SplitReadStreamResponse>(
+            Status(StatusCode::kUnavailable, "try-again"));
+      });
+
+  auto reader = ReadSessionReader::Create(
+      mock, MakeSession({"s0"}),
+      Options{}.set<ReadSessionMaxStreamsOption>(2));
+  auto rows = ReadAll(*reader);
+  ASSERT_STATUS_OK(rows);
+  EXPECT_THAT(*rows, ElementsAre(Pair("s0", 5)));
+  EXPECT_EQ(0, reader->split_count());
+}
+
+TEST(ReadSessionReaderTest, Cancel) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  EXPECT_CALL(*mock, ReadRows).WillOnce([](ReadRowsRequest const&) {
+    // A stream that never ends.
+    return internal::MakeStreamRange<ReadRowsResponse>(
+        []() -> absl::variant<Status, ReadRowsResponse> {
+          return MakeResponse(1, 0.75);
+        });
+  });
+
+  auto reader = ReadSessionReader::Create(
+      mock, MakeSession({"s0"}),
+      Options{}
+          .set<ReadSessionSplitStreamsOption>(false)
+          .set<ReadSessionMaxBufferedResponsesOption>(2));
+  auto batch = reader->Next();
+  ASSERT_TRUE(batch.has_value());
+  ASSERT_STATUS_OK(*batch);
+
+  reader->Cancel();
+  batch = reader->Next();
+  ASSERT_TRUE(batch.has_value());
+  EXPECT_THAT(*batch, StatusIs(StatusCode::kCancelled));
+}
+
+TEST(ReadSessionReaderTest, PlanReadStreamCount) {
+  auto const kMiB = std::int64_t{1024} * 1024;
+  auto with_threads = [](std::size_t n) {
+    return Options{}.set<ReadSessionMaxStreamsOption>(n);
+  };
+  EXPECT_GE(PlanReadStreamCount(), 1);
+  EXPECT_EQ(4, PlanReadStreamCount(with_threads(4)));
+  EXPECT_EQ(1, PlanReadStreamCount(with_threads(0)));
+  // Small tables use fewer streams than threads.
+  EXPECT_EQ(1, PlanReadStreamCount(with_threads(16).set<
+                                   ReadSessionEstimatedBytesOption>(kMiB)));
+  EXPECT_EQ(3, PlanReadStreamCount(
+                   with_threads(16)
+                       .set<ReadSessionEstimatedBytesOption>(130 * kMiB)));
+  EXPECT_EQ(5, PlanReadStreamCount(
+                   with_threads(16)
+                       .set<ReadSessionEstimatedBytesOption>(10 * kMiB)
+                       .set<ReadSessionMinStreamBytesOption>(2 * kMiB)));
+  // Large tables use one stream per thread.
+  EXPECT_EQ(16, PlanReadStreamCount(
+                    with_threads(16)
+                        .set<ReadSessionEstimatedBytesOption>(1024 * kMiB)));
+}
+
+TEST(ReadSessionReaderTest, CreateReadSessionForReader) {
+  auto mock = std::make_shared<MockBigQueryReadConnection>();
+  EXPECT_CALL(*mock, CreateReadSession)
+      .WillOnce([](CreateReadSessionRequest const& request) {
+        EXPECT_EQ("projects/p", request.parent());
+        EXPECT_EQ(6, request.max_stream_count());
+        return make_status_or(MakeSession({"s0"}));
+      })
+      .WillOnce([](CreateReadSessionRequest const& request) {
+        EXPECT_EQ(2, request.max_stream_count());
+        return StatusOr<ReadSession>(
+            Status(StatusCode::kPermissionDenied, "uh-oh"));
+      });
+
+  auto const opts = Options{}.set<ReadSessionMaxStreamsOption>(6);
+  CreateReadSessionRequest request;
+  request.set_parent("projects/p");
+  auto session = CreateReadSessionForReader(mock, request, opts);
+  ASSERT_STATUS_OK(session);
+  EXPECT_EQ(1, session->streams_size());
+
+  // A count set in the request is an upper bound.
+  request.set_max_stream_count(2);
+  session = CreateReadSessionForReader(mock, request, opts);
+  EXPECT_THAT(session, StatusIs(StatusCode::kPermissionDenied));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,47 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/serialized_rows.h"
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+using ::google::cloud::bigquery::storage::v1::ReadRowsResponse;
+
+SerializedRows TakeSerializedRows(ReadRowsResponse response) {
+  SerializedRows rows;
+  rows.row_count = response.row_count();
+  switch (response.rows_case()) {
+    case ReadRowsResponse::kArrowRecordBatch:
+      rows.format = SerializedRowsFormat::kArrow;
+      rows.data = std::move(*response.mutable_arrow_record_batch()
+                                 ->mutable_serialized_record_batch());
+      break;
+    case ReadRowsResponse::kAvroRows:
+      rows.format = SerializedRowsFormat::kAvro;
+      rows.data = std::move(
+          *response.mutable_avro_rows()->mutable_serialized_binary_rows());
+      break;
+    default:
+      break;
+  }
+  return rows;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
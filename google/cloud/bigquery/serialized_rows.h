@@ -0,0 +1,82 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_SERIALIZED_ROWS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_SERIALIZED_ROWS_H
+
+#include "google/cloud/bigquery/bigquery_read_connection.h"
+#include "google/cloud/version.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/// The format of the rows in a `SerializedRows`.
+enum class SerializedRowsFormat {
+  /// The response did not contain any rows.
+  kNone,
+  /// A serialized Arrow `RecordBatch` message, in the IPC format.
+  kArrow,
+  /// A block of Avro rows, in the Avro binary encoding.
+  kAvro,
+};
+
+/**
+ * The serialized rows in a `ReadRowsResponse`.
+ *
+ * A `ReadRowsResponse` can hold up to 100 MiB of rows. Use
+ * `TakeSerializedRows()` to take ownership of these bytes without copying
+ * them. For example, `arrow::Buffer::FromString()` takes ownership of a
+ * `std::string`, so the rows can be decoded in place:
+ *
+ * @code
+ * namespace bq = ::google::cloud::bigquery;
+ * for (auto& response : client.ReadRows(stream_name, 0)) {
+ *   if (!response) throw std::runtime_error(response.status().message());
+ *   auto rows = bq::TakeSerializedRows(*std::move(response));
+ *   auto buffer = arrow::Buffer::FromString(std::move(rows.data));
+ *   auto batch = arrow::ipc::ReadRecordBatch(*buffer, schema, ...);
+ * }
+ * @endcode
+ *
+ * The schema for the rows is in the `ReadSession`, it is small and only needs
+ * to be decoded once per session.
+ */
+struct SerializedRows {
+  SerializedRowsFormat format = SerializedRowsFormat::kNone;
+  /// The number of rows in `data`.
+  std::int64_t row_count = 0;
+  /// The serialized rows, see `format` for their encoding.
+  std::string data;
+};
+
+/**
+ * Moves the serialized rows out of @p response.
+ *
+ * The bytes are moved, not copied, so this is a constant time operation
+ * regardless of the response size. The rest of the response (such as the
+ * stream statistics) is discarded.
+ */
+SerializedRows TakeSerializedRows(
+    google::cloud::bigquery::storage::v1::ReadRowsResponse response);
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_SERIALIZED_ROWS_H
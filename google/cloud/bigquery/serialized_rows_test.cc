@@ -0,0 +1,68 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/serialized_rows.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::bigquery::storage::v1::ReadRowsResponse;
+
+TEST(SerializedRowsTest, Arrow) {
+  ReadRowsResponse response;
+  response.set_row_count(42);
+  auto& batch =
+      *response.mutable_arrow_record_batch()->mutable_serialized_record_batch();
+  batch = std::string(4096, 'a');
+  auto const* const data = batch.data();
+
+  auto rows = TakeSerializedRows(std::move(response));
+  EXPECT_EQ(SerializedRowsFormat::kArrow, rows.format);
+  EXPECT_EQ(42, rows.row_count);
+  EXPECT_EQ(std::string(4096, 'a'), rows.data);
+  // The bytes are moved, not copied.
+  EXPECT_EQ(data, rows.data.data());
+}
+
+TEST(SerializedRowsTest, Avro) {
+  ReadRowsResponse response;
+  response.set_row_count(7);
+  auto& block = *response.mutable_avro_rows()->mutable_serialized_binary_rows();
+  block = std::string(4096, 'b');
+  auto const* const data = block.data();
+
+  auto rows = TakeSerializedRows(std::move(response));
+  EXPECT_EQ(SerializedRowsFormat::kAvro, rows.format);
+  EXPECT_EQ(7, rows.row_count);
+  EXPECT_EQ(std::string(4096, 'b'), rows.data);
+  EXPECT_EQ(data, rows.data.data());
+}
+
+TEST(SerializedRowsTest, NoRows) {
+  auto rows = TakeSerializedRows(ReadRowsResponse{});
+  EXPECT_EQ(SerializedRowsFormat::kNone, rows.format);
+  EXPECT_EQ(0, rows.row_count);
+  EXPECT_TRUE(rows.data.empty());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,322 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ASYNC_ROW_BATCH_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ASYNC_ROW_BATCH_READER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/data_client.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/row_set_cursor.h"
+#include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/rpc_backoff_policy.h"
+#include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/status_or.h"
+#include "absl/memory/memory.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Objects of this class represent the state of reading rows via
+ * `Table::AsyncReadRowBatches()`.
+ *
+ * Unlike `AsyncRowReader`, which invokes the application callback once per
+ * row, this class delivers all the rows parsed from each `ReadRowsResponse`
+ * in a single callback. The stream does not read the next response until the
+ * future returned by the callback is satisfied, so there is at most one
+ * outstanding batch and no additional buffering.
+ */
+template <typename RowsFunctor, typename FinishFunctor>
+class AsyncRowBatchReader
+    : public std::enable_shared_from_this<
+          AsyncRowBatchReader<RowsFunctor, FinishFunctor>> {
+ public:
+  /// Special value to be used as rows_limit indicating no limit.
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  static std::int64_t constexpr NO_ROWS_LIMIT = 0;
+  // Callbacks keep pointers to these objects.
+  AsyncRowBatchReader(AsyncRowBatchReader&&) = delete;
+  AsyncRowBatchReader(AsyncRowBatchReader const&) = delete;
+
+ private:
+  static_assert(google::cloud::internal::is_invocable<RowsFunctor,
+                                                      std::vector<Row>>::value,
+                "RowsFunctor must be invocable with std::vector<Row>.");
+  static_assert(
+      google::cloud::internal::is_invocable<FinishFunctor, Status>::value,
+      "FinishFunctor must be invocable with Status.");
+  static_assert(
+      std::is_same<google::cloud::internal::invoke_result_t<RowsFunctor,
+                                                            std::vector<Row>>,
+                   future<bool>>::value,
+      "RowsFunctor should return a future<bool>.");
+
+  static std::shared_ptr<AsyncRowBatchReader> Create(
+      CompletionQueue cq, std::shared_ptr<DataClient> client,
+      std::string app_profile_id, std::string table_name, RowsFunctor on_rows,
+      FinishFunctor on_finish, RowSet row_set, std::int64_t rows_limit,
+      Filter filter, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory) {
+    std::shared_ptr<AsyncRowBatchReader> res(new AsyncRowBatchReader(
+        std::move(cq), std::move(client), std::move(app_profile_id),
+        std::move(table_name), std::move(on_rows), std::move(on_finish),
+        std::move(row_set), rows_limit, std::move(filter),
+        std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
+        std::move(metadata_update_policy), std::move(parser_factory)));
+    res->MakeRequest();
+    return res;
+  }
+
+  AsyncRowBatchReader(
+      CompletionQueue cq, std::shared_ptr<DataClient> client,
+      std::string app_profile_id, std::string table_name, RowsFunctor on_rows,
+      FinishFunctor on_finish, RowSet row_set, std::int64_t rows_limit,
+      Filter filter, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory)
+      : cq_(std::move(cq)),
+        client_(std::move(client)),
+        app_profile_id_(std::move(app_profile_id)),
+        table_name_(std::move(table_name)),
+        on_rows_(std::move(on_rows)),
+        on_finish_(std::move(on_finish)),
+        row_set_(std::move(row_set)),
+        rows_limit_(rows_limit),
+        filter_(std::move(filter)),
+        rpc_retry_policy_(std::move(rpc_retry_policy)),
+        rpc_backoff_policy_(std::move(rpc_backoff_policy)),
+        metadata_update_policy_(std::move(metadata_update_policy)),
+        parser_factory_(std::move(parser_factory)),
+        rows_count_(0),
+        cancelled_(false) {}
+
+  void MakeRequest() {
+    status_ = Status();
+    google::bigtable::v2::ReadRowsRequest request;
+
+    request.set_app_profile_id(app_profile_id_);
+    request.set_table_name(table_name_);
+    // The remaining rows are swapped into the request, and back out once it
+    // is sent, to avoid copying them.
+    row_set_.Swap(*request.mutable_rows());
+
+    auto filter_proto = filter_.as_proto();
+    request.mutable_filter()->Swap(&filter_proto);
+
+    if (rows_limit_ != NO_ROWS_LIMIT) {
+      request.set_rows_limit(rows_limit_ - rows_count_);
+    }
+    parser_ = parser_factory_->Create();
+
+    auto context = absl::make_unique<grpc::ClientContext>();
+    rpc_retry_policy_->Setup(*context);
+    rpc_backoff_policy_->Setup(*context);
+    metadata_update_policy_.Setup(*context);
+
+    auto client = client_;
+    auto self = this->shared_from_this();
+    cq_.MakeStreamingReadRpc(
+        [client](grpc::ClientContext* context,
+                 google::bigtable::v2::ReadRowsRequest const& request,
+                 grpc::CompletionQueue* cq) {
+          return client->PrepareAsyncReadRows(context, request, cq);
+        },
+        request, std::move(context),
+        [self](google::bigtable::v2::ReadRowsResponse r) {
+          return self->OnDataReceived(std::move(r));
+        },
+        [self](Status s) { self->OnStreamFinished(std::move(s)); });
+    row_set_.Swap(*request.mutable_rows());
+  }
+
+  /**
+   * Called when lower layers provide us with a response.
+   *
+   * The future returned to the stream is satisfied only after the application
+   * consumes the batch, this provides flow control without any buffering.
+   */
+  future<bool> OnDataReceived(google::bigtable::v2::ReadRowsResponse response) {
+    std::vector<Row> rows;
+    status_ = ConsumeResponse(std::move(response), rows);
+    // Even if status_ is not OK, we might have parsed some complete rows,
+    // deliver them before interrupting the stream. The rows already count
+    // toward the limit and the last read row key used in retries.
+    bool const parsed_ok = status_.ok();
+    if (rows.empty()) return make_ready_future(parsed_ok);
+
+    auto self = this->shared_from_this();
+    return on_rows_(std::move(rows))
+        .then([self, parsed_ok](future<bool> fut) -> bool {
+          bool keep_reading;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+          try {
+            keep_reading = fut.get();
+          } catch (std::exception& ex) {
+            self->Cancel(
+                std::string("future<> returned from the user callback threw "
+                            "an exception: ") +
+                ex.what());
+            return false;
+          } catch (...) {
+            self->Cancel(
+                "future<> returned from the user callback threw an unknown "
+                "exception");
+            return false;
+          }
+#else   // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+          keep_reading = fut.get();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+          if (!keep_reading) {
+            self->Cancel("User cancelled");
+            return false;
+          }
+          return parsed_ok;
+        });
+  }
+
+  /// Called when the whole stream finishes.
+  // NOLINTNEXTLINE(performance-unnecessary-value-param)
+  void OnStreamFinished(Status status) {
+    if (cancelled_) {
+      on_finish_(status_);
+      return;
+    }
+    if (status_.ok()) {
+      status_ = std::move(status);
+    }
+    grpc::Status parser_status;
+    parser_->HandleEndOfStream(parser_status);
+    if (!parser_status.ok() && status_.ok()) {
+      // If the stream finished with an error ignore what the parser says.
+      status_ = MakeStatusFromRpcError(parser_status);
+    }
+
+    // In the unlikely case when we have already reached the requested
+    // number of rows and still receive an error (the parser can throw
+    // an error at end of stream for example), there is no need to
+    // retry and we have no good value for rows_limit anyway.
+    if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
+      status_ = Status();
+    }
+
+    if (!last_read_row_key_.empty()) {
+      // We've returned some rows and need to make sure we don't
+      // request them again.
+      row_set_.Advance(last_read_row_key_);
+    }
+
+    // If we receive an error, but the retryable set is empty, consider it a
+    // success.
+    if (row_set_.IsEmpty()) {
+      status_ = Status();
+    }
+
+    if (status_.ok() || !rpc_retry_policy_->OnFailure(status_)) {
+      on_finish_(status_);
+      return;
+    }
+    auto self = this->shared_from_this();
+    cq_.MakeRelativeTimer(rpc_backoff_policy_->OnCompletion(status_))
+        .then([self](future<StatusOr<std::chrono::system_clock::time_point>>
+                         result) {
+          if (auto tp = result.get()) {
+            self->MakeRequest();
+          } else {
+            self->on_finish_(self->status_);
+          }
+        });
+  }
+
+  /// The user satisfied the future returned from the callback with false.
+  void Cancel(std::string const& reason) {
+    cancelled_ = true;
+    status_ = Status(StatusCode::kCancelled, reason);
+  }
+
+  /// Parse the data from the response, appending any complete rows to @p rows.
+  Status ConsumeResponse(google::bigtable::v2::ReadRowsResponse response,
+                         std::vector<Row>& rows) {
+    for (auto& chunk : *response.mutable_chunks()) {
+      grpc::Status status;
+      parser_->HandleChunk(std::move(chunk), status);
+      if (!status.ok()) {
+        return MakeStatusFromRpcError(status);
+      }
+      while (parser_->HasNext()) {
+        Row parsed_row = parser_->Next(status);
+        if (!status.ok()) {
+          return MakeStatusFromRpcError(status);
+        }
+        ++rows_count_;
+        last_read_row_key_ = std::string(parsed_row.row_key());
+        rows.push_back(std::move(parsed_row));
+      }
+    }
+    return Status();
+  }
+
+  friend class Table;
+
+  CompletionQueue cq_;
+  std::shared_ptr<DataClient> client_;
+  std::string app_profile_id_;
+  std::string table_name_;
+  RowsFunctor on_rows_;
+  FinishFunctor on_finish_;
+  /// The rows not yet returned, advanced as rows are received.
+  internal::RowSetCursor row_set_;
+  std::int64_t rows_limit_;
+  Filter filter_;
+  std::unique_ptr<RPCRetryPolicy> rpc_retry_policy_;
+  std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
+  MetadataUpdatePolicy metadata_update_policy_;
+  std::unique_ptr<internal::ReadRowsParserFactory> parser_factory_;
+  std::unique_ptr<internal::ReadRowsParser> parser_;
+  /// Number of rows read so far, used to set row_limit in retries.
+  std::int64_t rows_count_;
+  /// Holds the last read row key, for retries.
+  std::string last_read_row_key_;
+  /// Set if the application stops the read, disables any retries.
+  bool cancelled_;
+  /**
+   * The status of the last retry attempt_.
+   *
+   * It is reset to OK at the beginning of every retry. If an error is
+   * encountered (be it while parsing the response or on stream finish), it is
+   * stored here (unless a different error had already been stored).
+   */
+  Status status_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ASYNC_ROW_BATCH_READER_H
@@ -0,0 +1,310 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/testing/mock_data_client.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+
+using ::google::cloud::bigtable::testing::MockClientAsyncReaderInterface;
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+template <typename T>
+bool Unsatisfied(future<T> const& fut) {
+  return std::future_status::timeout == fut.wait_for(1_ms);
+}
+
+class TableAsyncReadRowBatchesTest
+    : public bigtable::testing::TableTestFixture {
+ protected:
+  TableAsyncReadRowBatchesTest()
+      : TableTestFixture(
+            CompletionQueue(std::make_shared<FakeCompletionQueueImpl>())),
+        stream_status_future_(stream_status_promise_.get_future()) {}
+
+  MockClientAsyncReaderInterface<btproto::ReadRowsResponse>& AddReader(
+      std::function<void(btproto::ReadRowsRequest const&)>
+          request_expectations) {
+    readers_.emplace_back(
+        new MockClientAsyncReaderInterface<btproto::ReadRowsResponse>);
+    auto& reader = *readers_.back();
+    auto request_expectations_ptr =
+        std::make_shared<decltype(request_expectations)>(
+            std::move(request_expectations));
+
+    EXPECT_CALL(*client_, PrepareAsyncReadRows)
+        .WillOnce([&reader, request_expectations_ptr](
+                      grpc::ClientContext*, btproto::ReadRowsRequest const& r,
+                      grpc::CompletionQueue*) {
+          (*request_expectations_ptr)(r);
+          return std::unique_ptr<
+              MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>(
+              &reader);
+        })
+        .RetiresOnSaturation();
+    EXPECT_CALL(reader, StartCall).Times(1);
+    // The last call, to which we'll return ok==false.
+    EXPECT_CALL(reader, Read).WillOnce([](btproto::ReadRowsResponse*, void*) {
+    });
+    return reader;
+  }
+
+  // Start Table::AsyncReadRowBatches.
+  void ReadRowBatches(int row_limit = RowReader::NO_ROWS_LIMIT) {
+    table_.AsyncReadRowBatches(
+        [this](std::vector<Row> rows) {
+          std::vector<RowKeyType> keys;
+          for (auto const& r : rows) keys.push_back(r.row_key());
+          batches_.push_back(std::move(keys));
+          user_promises_.emplace_back();
+          return user_promises_.back().get_future();
+        },
+        [this](Status const& stream_status) {
+          stream_status_promise_.set_value(stream_status);
+        },
+        RowSet(), row_limit, Filter::PassAllFilter());
+  }
+
+  std::vector<MockClientAsyncReaderInterface<btproto::ReadRowsResponse>*>
+      readers_;
+  /// The row keys in each batch received by the callback.
+  std::vector<std::vector<RowKeyType>> batches_;
+  /// The i-th promise corresponds to the future returned by the i-th callback.
+  std::deque<promise<bool>> user_promises_;
+  promise<Status> stream_status_promise_;
+  future<Status> stream_status_future_;
+};
+
+btproto::ReadRowsResponse TwoRowsAndAHalf() {
+  return bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r3"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+      })");
+}
+
+/// @test Verify that all the rows in a response are delivered together.
+TEST_F(TableAsyncReadRowBatchesTest, BatchPerResponse) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(stream, Read)
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(R"(
+            chunks {
+              qualifier { value: "col2" }
+              timestamp_micros: 42000
+              value: "value"
+              commit_row: true
+            })");
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Read)
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = TwoRowsAndAHalf();
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  ReadRowBatches();
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  ASSERT_EQ(1U, batches_.size());
+  EXPECT_THAT(batches_[0], ElementsAre("r1", "r2"));
+
+  // Check that we're not asking for data until the batch is consumed.
+  ASSERT_EQ(0U, cq_impl_->size());
+  user_promises_[0].set_value(true);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  ASSERT_EQ(2U, batches_.size());
+  EXPECT_THAT(batches_[1], ElementsAre("r3"));
+  user_promises_[1].set_value(true);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  EXPECT_TRUE(Unsatisfied(stream_status_future_));
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  ASSERT_STATUS_OK(stream_status_future_.get());
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+/// @test Verify that transient errors are retried after the last batch.
+TEST_F(TableAsyncReadRowBatchesTest, TransientErrorIsRetried) {
+  auto& stream2 = AddReader([](btproto::ReadRowsRequest const& req) {
+    // Verify that we're not asking for the same rows again.
+    ASSERT_EQ(1, req.rows().row_ranges_size());
+    EXPECT_EQ("r2", req.rows().row_ranges(0).start_key_open());
+  });
+  auto& stream1 = AddReader([](btproto::ReadRowsRequest const&) {});
+
+  EXPECT_CALL(stream1, Read)
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = TwoRowsAndAHalf();
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream1, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+  });
+  EXPECT_CALL(stream2, Read)
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(R"(
+            chunks {
+              row_key: "r3"
+              family_name { value: "fam" }
+              qualifier { value: "col" }
+              timestamp_micros: 42000
+              value: "value"
+              commit_row: true
+            })");
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream2, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  ReadRowBatches();
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  ASSERT_EQ(1U, batches_.size());
+  user_promises_[0].set_value(true);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream with failure
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish timer
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  ASSERT_EQ(2U, batches_.size());
+  EXPECT_THAT(batches_[1], ElementsAre("r3"));
+  user_promises_[1].set_value(true);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  ASSERT_STATUS_OK(stream_status_future_.get());
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+/// @test Verify that the application can stop the read.
+TEST_F(TableAsyncReadRowBatchesTest, UserCancels) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(stream, Read)
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = TwoRowsAndAHalf();
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status(grpc::StatusCode::CANCELLED, "cancelled");
+  });
+
+  ReadRowBatches();
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  ASSERT_EQ(1U, batches_.size());
+  ASSERT_EQ(0U, cq_impl_->size());
+  user_promises_[0].set_value(false);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  EXPECT_TRUE(Unsatisfied(stream_status_future_));
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto stream_status = stream_status_future_.get();
+  EXPECT_EQ(StatusCode::kCancelled, stream_status.code());
+  EXPECT_THAT(stream_status.message(), HasSubstr("User cancelled"));
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+/// @test Verify that permanent errors are reported.
+TEST_F(TableAsyncReadRowBatchesTest, PermanentFailure) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(stream, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "noooo");
+  });
+
+  ReadRowBatches();
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  EXPECT_TRUE(batches_.empty());
+  EXPECT_EQ(StatusCode::kPermissionDenied,
+            stream_status_future_.get().code());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -18,7 +18,9 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/read_rows_flow_control.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/row_set_cursor.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
@@ -33,6 +35,8 @@
 #include "absl/types/optional.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 
@@ -78,13 +82,15 @@ class AsyncRowReader : public std::enable_shared_from_this<
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
       // NOLINTNEXTLINE(performance-unnecessary-value-param) TODO(#4112)
       MetadataUpdatePolicy metadata_update_policy,
-      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory) {
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      std::shared_ptr<internal::ReadRowsFlowControl> flow_control = {}) {
     std::shared_ptr<AsyncRowReader> res(new AsyncRowReader(
         std::move(cq), std::move(client), std::move(app_profile_id),
         std::move(table_name), std::move(on_row), std::move(on_finish),
         std::move(row_set), rows_limit, std::move(filter),
         std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
-        std::move(metadata_update_policy), std::move(parser_factory)));
+        std::move(metadata_update_policy), std::move(parser_factory),
+        std::move(flow_control)));
     res->MakeRequest();
     return res;
   }
@@ -96,7 +102,8 @@ class AsyncRowReader : public std::enable_shared_from_this<
       Filter filter, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
       MetadataUpdatePolicy metadata_update_policy,
-      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory)
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      std::shared_ptr<internal::ReadRowsFlowControl> flow_control)
       : cq_(std::move(cq)),
         client_(std::move(client)),
         app_profile_id_(std::move(app_profile_id)),
@@ -105,29 +112,56 @@ class AsyncRowReader : public std::enable_shared_from_this<
         on_finish_(std::move(on_finish)),
         row_set_(std::move(row_set)),
         rows_limit_(rows_limit),
-        filter_(std::move(filter)),
         rpc_retry_policy_(std::move(rpc_retry_policy)),
         rpc_backoff_policy_(std::move(rpc_backoff_policy)),
         metadata_update_policy_(std::move(metadata_update_policy)),
         parser_factory_(std::move(parser_factory)),
+        flow_control_(std::move(flow_control)),
         rows_count_(0),
         whole_op_finished_(),
-        recursion_level_() {}
+        recursion_level_() {
+    request_.set_app_profile_id(app_profile_id_);
+    request_.set_table_name(table_name_);
+    auto filter_proto = std::move(filter).as_proto();
+    request_.mutable_filter()->Swap(&filter_proto);
+  }
 
-  void MakeRequest() {
-    status_ = Status();
-    google::bigtable::v2::ReadRowsRequest request;
+  /**
+   * Cancel the operation, it is safe to call this function from any thread.
+   *
+   * This is used to stop the losing request of a hedged read. The operation
+   * finishes with a `kCancelled` status and is not retried.
+   */
+  void TryCancel() {
+    std::shared_ptr<AsyncOperation> operation;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      cancelled_ = true;
+      operation = operation_.lock();
+    }
+    if (operation) operation->Cancel();
+  }
 
-    request.set_app_profile_id(app_profile_id_);
-    request.set_table_name(table_name_);
-    auto row_set_proto = row_set_.as_proto();
-    request.mutable_rows()->Swap(&row_set_proto);
+  bool cancelled() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return cancelled_;
+  }
 
-    auto filter_proto = filter_.as_proto();
-    request.mutable_filter()->Swap(&filter_proto);
+  void MakeRequest() {
+    if (cancelled()) {
+      status_ = Status(StatusCode::kCancelled, "operation cancelled");
+      whole_op_finished_ = true;
+      TryGiveRowToUser();
+      return;
+    }
+    status_ = Status();
+    // Only the row set and the row limit change between retries, the rest of
+    // the request (including the filter) is reused. The remaining rows are
+    // swapped into the request, and back out once it is sent.
+    row_set_.Swap(*request_.mutable_rows());
 
     if (rows_limit_ != NO_ROWS_LIMIT) {
-      request.set_rows_limit(rows_limit_ - rows_count_);
+      request_.set_rows_limit(rows_limit_ - rows_count_);
     }
     parser_ = parser_factory_->Create();
 
@@ -138,17 +172,24 @@ class AsyncRowReader : public std::enable_shared_from_this<
 
     auto client = client_;
     auto self = this->shared_from_this();
-    cq_.MakeStreamingReadRpc(
+    auto operation = cq_.MakeStreamingReadRpc(
         [client](grpc::ClientContext* context,
                  google::bigtable::v2::ReadRowsRequest const& request,
                  grpc::CompletionQueue* cq) {
           return client->PrepareAsyncReadRows(context, request, cq);
         },
-        request, std::move(context),
+        request_, std::move(context),
         [self](google::bigtable::v2::ReadRowsResponse r) {
           return self->OnDataReceived(std::move(r));
         },
         [self](Status s) { self->OnStreamFinished(std::move(s)); });
+    row_set_.Swap(*request_.mutable_rows());
+    std::unique_lock<std::mutex> lk(mu_);
+    operation_ = operation;
+    // `TryCancel()` may have been called before `operation_` was set.
+    bool const cancelled = cancelled_;
+    lk.unlock();
+    if (cancelled) operation->Cancel();
   }
 
   /**
@@ -197,19 +238,29 @@ class AsyncRowReader : public std::enable_shared_from_this<
             "https://github.com/googleapis/google-cloud-cpp/issues/new");
       }
       // No rows, but we can fetch some.
-      auto continue_reading = std::move(continue_reading_);
-      continue_reading_.reset();
-      continue_reading->set_value(true);
+      if (!flow_control_) {
+        ContinueReading();
+        return;
+      }
+      // Wait until the rows held by all the streams sharing the budget fit in
+      // it. This reader holds no rows at this point, so it cannot deadlock
+      // itself.
+      auto self = this->shared_from_this();
+      flow_control_->WaitForCapacity().then(
+          [self](future<void>) { self->ContinueReading(); });
       return;
     }
 
     // Yay! We have something to give to the user and they want it.
     auto row = std::move(ready_rows_.front());
     ready_rows_.pop();
+    auto const bytes = flow_control_ ? internal::RowBytes(row) : 0;
 
     auto self = this->shared_from_this();
     bool const break_recursion = recursion_level_ >= 100;
-    on_row_(std::move(row)).then([self, break_recursion](future<bool> fut) {
+    on_row_(std::move(row)).then([self, bytes,
+                                  break_recursion](future<bool> fut) {
+      if (self->flow_control_) self->flow_control_->Release(bytes);
       bool should_cancel;
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       try {
@@ -241,6 +292,13 @@ class AsyncRowReader : public std::enable_shared_from_this<
     });
   }
 
+  /// Let the lower layers fetch more data.
+  void ContinueReading() {
+    auto continue_reading = std::move(continue_reading_);
+    continue_reading_.reset();
+    continue_reading->set_value(true);
+  }
+
   /// Called when lower layers provide us with a response chunk.
   future<bool> OnDataReceived(
       google::bigtable::v2::ReadRowsResponse const& response) {
@@ -297,7 +355,7 @@ class AsyncRowReader : public std::enable_shared_from_this<
     if (!last_read_row_key_.empty()) {
       // We've returned some rows and need to make sure we don't
       // request them again.
-      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+      row_set_.Advance(last_read_row_key_);
     }
 
     // If we receive an error, but the retryable set is empty, consider it a
@@ -313,7 +371,7 @@ class AsyncRowReader : public std::enable_shared_from_this<
       return;
     }
 
-    if (!rpc_retry_policy_->OnFailure(status_)) {
+    if (cancelled() || !rpc_retry_policy_->OnFailure(status_)) {
       // Can't retry.
       whole_op_finished_ = true;
       TryGiveRowToUser();
@@ -334,6 +392,11 @@ class AsyncRowReader : public std::enable_shared_from_this<
 
   /// User satisfied the future returned from the row callback with false.
   void Cancel(std::string const& reason) {
+    if (flow_control_) {
+      for (; !ready_rows_.empty(); ready_rows_.pop()) {
+        flow_control_->Release(internal::RowBytes(ready_rows_.front()));
+      }
+    }
     ready_rows_ = std::queue<Row>();
     auto continue_reading = std::move(continue_reading_);
     continue_reading_.reset();
@@ -361,6 +424,7 @@ class AsyncRowReader : public std::enable_shared_from_this<
       }
       ++rows_count_;
       last_read_row_key_ = std::string(parsed_row.row_key());
+      if (flow_control_) flow_control_->Acquire(internal::RowBytes(parsed_row));
       ready_rows_.emplace(std::move(parsed_row));
     }
     return Status();
@@ -385,20 +449,42 @@ class AsyncRowReader : public std::enable_shared_from_this<
   friend class Table;
 
   std::mutex mu_;
+  /**
+   * The current streaming RPC, used by `TryCancel()`, guarded by `mu_`.
+   *
+   * The RPC holds a reference to this object until it finishes, a
+   * `std::shared_ptr<>` would create a cycle.
+   */
+  std::weak_ptr<AsyncOperation> operation_;
+  /// Set by `TryCancel()`, guarded by `mu_`.
+  bool cancelled_ = false;
   CompletionQueue cq_;
   std::shared_ptr<DataClient> client_;
   std::string app_profile_id_;
   std::string table_name_;
   RowFunctor on_row_;
   FinishFunctor on_finish_;
-  RowSet row_set_;
+  /// The rows not yet returned, advanced as rows are received.
+  internal::RowSetCursor row_set_;
   std::int64_t rows_limit_;
-  Filter filter_;
+  /**
+   * The parts of the request that do not change between retries.
+   *
+   * The filter is moved here once instead of being copied into each request.
+   */
+  google::bigtable::v2::ReadRowsRequest request_;
   std::unique_ptr<RPCRetryPolicy> rpc_retry_policy_;
   std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::unique_ptr<internal::ReadRowsParserFactory> parser_factory_;
   std::unique_ptr<internal::ReadRowsParser> parser_;
+  /**
+   * The memory budget shared with other readers, null if disabled.
+   *
+   * Rows are accounted for from the time they are parsed until the future
+   * returned by `on_row_` is satisfied.
+   */
+  std::shared_ptr<internal::ReadRowsFlowControl> flow_control_;
   /// Number of rows read so far, used to set row_limit in retries.
   std::int64_t rows_count_;
   /// Holds the last read row key, for retries.
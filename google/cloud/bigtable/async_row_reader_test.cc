@@ -715,6 +715,56 @@ TEST_F(TableAsyncReadRowsTest, ParserFailure) {
   ASSERT_EQ(0U, cq_impl_->size());
 }
 
+/// @test Verify that rows count against the flow control budget until the
+/// future returned by the callback is satisfied.
+TEST_F(TableAsyncReadRowsTest, FlowControlTracksOutstandingRows) {
+  table_.EnableReadRowsFlowControl(
+      ReadRowsFlowControlOptions{}.SetMaxOutstandingBytes(1024));
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+
+  EXPECT_CALL(stream, Read)
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(
+            R"(
+                chunks {
+                  row_key: "r1"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                })");
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  ExpectRow("r1");
+  ReadRows();
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  row_futures_[0].get();
+
+  // The row key, and the cell's row key, family, qualifier and value.
+  EXPECT_EQ(2U + 2 + 3 + 3 + 5,
+            table_.read_rows_flow_control_stats().outstanding_bytes);
+  promises_from_user_cb_[0].set_value(true);
+  EXPECT_EQ(0U, table_.read_rows_flow_control_stats().outstanding_bytes);
+  EXPECT_EQ(0, table_.read_rows_flow_control_stats().paused_reads);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  ASSERT_STATUS_OK(stream_status_future_.get());
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
 enum class CancelMode {
   kFalseValue,
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
@@ -1074,6 +1124,39 @@ TEST_F(TableAsyncReadRowsTest, ReadRowError) {
   ASSERT_EQ(StatusCode::kPermissionDenied, row.status().code());
 }
 
+TEST_F(TableAsyncReadRowsTest, ReadRowHedgingBudgetExhausted) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+
+  EXPECT_CALL(stream, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  // Without any budget the read is never hedged, and only one request is sent.
+  table_.EnableReadRowHedging(ReadRowHedgingOptions{}.SetMaxBudgetTokens(0));
+  auto row_future = table_.AsyncReadRow("000", Filter::PassAllFilter());
+
+  EXPECT_TRUE(reader_started_[0]);
+
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start() and the hedging timer
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  EXPECT_TRUE(Unsatisfied(row_future));
+
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto row = row_future.get();
+  ASSERT_STATUS_OK(row);
+  ASSERT_FALSE(row->first);
+
+  auto stats = table_.read_row_hedging_stats();
+  EXPECT_EQ(1, stats.reads);
+  EXPECT_EQ(0, stats.hedged);
+  EXPECT_EQ(1, stats.budget_exhausted);
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigtable/benchmarks/benchmark.h"
 #include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include <algorithm>
 #include <cctype>
 #include <chrono>
 #include <future>
@@ -64,6 +65,10 @@
  * - Delete the table.
  * - Report the same results in CSV format to make analysis easier.
  *
+ * If the `--hedged` flag is present the benchmark enables hedged reads (see
+ * `bigtable::Table::EnableReadRowHedging()`) and uses `AsyncReadRow()` instead
+ * of `ReadRow()`. The benchmark also reports how many reads were hedged.
+ *
  * Using a command-line parameter the benchmark can be configured to create a
  * local gRPC server that implements the Cloud Bigtable APIs used by the
  * benchmark.  If this parameter is not used the benchmark uses the default
@@ -87,12 +92,17 @@ using bigtable::benchmarks::OperationResult;
 struct LatencyBenchmarkResult {
   BenchmarkResult apply_results;
   BenchmarkResult read_results;
+  bigtable::ReadRowHedgingStats hedging_stats;
 };
 
+/// Remove the `--hedged` flag from the command-line, return true if present.
+bool ParseHedgedFlag(int& argc, char* argv[]);
+
 /// Run an iteration of the test.
 google::cloud::StatusOr<LatencyBenchmarkResult> RunBenchmark(
     bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
-    std::string const& table_id, std::chrono::seconds test_duration);
+    std::string const& table_id, std::chrono::seconds test_duration,
+    bool hedged);
 
 //@{
 /// @name Test constants.  Defined as requirements in the original bug (#189).
@@ -103,6 +113,7 @@ constexpr int kBenchmarkProgressMarks = 4;
 }  // anonymous namespace
 
 int main(int argc, char* argv[]) {
+  auto const hedged = ParseHedgedFlag(argc, argv);
   auto setup = MakeBenchmarkSetup("perf", argc, argv);
   if (!setup) {
     std::cerr << setup.status() << "\n";
@@ -126,6 +137,7 @@ int main(int argc, char* argv[]) {
   // Start the threads running the latency test.
   std::cout << "Running Latency Benchmark " << std::flush;
   auto latency_test_start = std::chrono::steady_clock::now();
+  auto const usage_start = bigtable::benchmarks::CurrentResourceUsage();
   std::vector<std::future<google::cloud::StatusOr<LatencyBenchmarkResult>>>
       tasks;
   for (int i = 0; i != setup->thread_count(); ++i) {
@@ -136,7 +148,8 @@ int main(int argc, char* argv[]) {
     }
     tasks.emplace_back(std::async(launch_policy, RunBenchmark,
                                   std::ref(benchmark), setup->app_profile_id(),
-                                  setup->table_id(), setup->test_duration()));
+                                  setup->table_id(), setup->test_duration(),
+                                  hedged));
   }
 
   // Wait for the threads and combine all the results.
@@ -151,6 +164,11 @@ int main(int argc, char* argv[]) {
     };
     append_ops(destination.apply_results, source.apply_results);
     append_ops(destination.read_results, source.read_results);
+    destination.hedging_stats.reads += source.hedging_stats.reads;
+    destination.hedging_stats.hedged += source.hedging_stats.hedged;
+    destination.hedging_stats.hedge_wins += source.hedging_stats.hedge_wins;
+    destination.hedging_stats.budget_exhausted +=
+        source.hedging_stats.budget_exhausted;
   };
   for (auto& future : tasks) {
     auto result = future.get();
@@ -165,6 +183,8 @@ int main(int argc, char* argv[]) {
   auto latency_test_elapsed =
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - latency_test_start);
+  auto const latency_test_usage =
+      bigtable::benchmarks::CurrentResourceUsage() - usage_start;
   combined.apply_results.elapsed = latency_test_elapsed;
   combined.read_results.elapsed = latency_test_elapsed;
   std::cout << " DONE. Elapsed=" << FormatDuration(latency_test_elapsed)
@@ -173,23 +193,54 @@ int main(int argc, char* argv[]) {
 
   Benchmark::PrintLatencyResult(std::cout, "perf", "Apply()",
                                 combined.apply_results);
-  Benchmark::PrintLatencyResult(std::cout, "perf", "ReadRow()",
+  char const* read_label = hedged ? "AsyncReadRow(hedged)" : "ReadRow()";
+  Benchmark::PrintLatencyResult(std::cout, "perf", read_label,
                                 combined.read_results);
+  if (hedged) {
+    auto const& stats = combined.hedging_stats;
+    std::cout << "Hedging: Reads=" << stats.reads
+              << ", Hedged=" << stats.hedged
+              << ", HedgeWins=" << stats.hedge_wins
+              << ", BudgetExhausted=" << stats.budget_exhausted << "\n";
+  }
 
   std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << "\n";
   benchmark.PrintResultCsv(std::cout, "perf", "BulkApply()", "Latency",
                            *populate_results);
   benchmark.PrintResultCsv(std::cout, "perf", "Apply()", "Latency",
                            combined.apply_results);
-  benchmark.PrintResultCsv(std::cout, "perf", "ReadRow()", "Latency",
+  benchmark.PrintResultCsv(std::cout, "perf", read_label, "Latency",
                            combined.read_results);
 
+  benchmark.AddToReport("perf", "BulkApply()", *populate_results);
+  benchmark.AddToReport("perf", "Apply()", combined.apply_results);
+  benchmark.AddToReport("perf", read_label, combined.read_results);
+  // The operations run interleaved in the same threads, their costs can only
+  // be reported together.
+  bigtable::benchmarks::ReportRecord mixed;
+  mixed.test_name = "perf";
+  mixed.op_name = std::string("Apply()+") + read_label;
+  AddUsageMetrics(mixed, latency_test_usage,
+                  static_cast<std::int64_t>(
+                      combined.apply_results.operations.size() +
+                      combined.read_results.operations.size()));
+  benchmark.AddToReport(std::move(mixed));
+
   benchmark.DeleteTable();
 
-  return 0;
+  return benchmark.FinishReport(std::cout);
 }
 
 namespace {
+bool ParseHedgedFlag(int& argc, char* argv[]) {
+  auto const end = std::remove_if(argv + 1, argv + argc, [](char const* arg) {
+    return std::string(arg) == "--hedged";
+  });
+  auto const removed = static_cast<int>(argv + argc - end);
+  argc -= removed;
+  return removed != 0;
+}
+
 OperationResult RunOneApply(bigtable::Table& table, std::string row_key,
                             std::mt19937_64& generator) {
   bigtable::SingleRowMutation mutation(std::move(row_key));
@@ -203,24 +254,34 @@ OperationResult RunOneApply(bigtable::Table& table, std::string row_key,
   return Benchmark::TimeOperation(std::move(op));
 }
 
-OperationResult RunOneReadRow(bigtable::Table& table, std::string row_key) {
-  auto op = [&table, &row_key]() -> google::cloud::Status {
-    return table
-        .ReadRow(std::move(row_key), bigtable::Filter::ColumnRangeClosed(
-                                         kColumnFamily, "field0", "field9"))
-        .status();
+OperationResult RunOneReadRow(bigtable::Table& table, std::string row_key,
+                              bool hedged) {
+  auto filter =
+      bigtable::Filter::ColumnRangeClosed(kColumnFamily, "field0", "field9");
+  if (hedged) {
+    auto op = [&table, &row_key, &filter]() -> google::cloud::Status {
+      return table.AsyncReadRow(std::move(row_key), std::move(filter))
+          .get()
+          .status();
+    };
+    return Benchmark::TimeOperation(std::move(op));
+  }
+  auto op = [&table, &row_key, &filter]() -> google::cloud::Status {
+    return table.ReadRow(std::move(row_key), std::move(filter)).status();
   };
   return Benchmark::TimeOperation(std::move(op));
 }
 
 google::cloud::StatusOr<LatencyBenchmarkResult> RunBenchmark(
     bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
-    std::string const& table_id, std::chrono::seconds test_duration) {
+    std::string const& table_id, std::chrono::seconds test_duration,
+    bool hedged) {
   LatencyBenchmarkResult result = {};
 
   auto data_client = benchmark.MakeDataClient();
   bigtable::Table table(std::move(data_client), std::move(app_profile_id),
                         table_id);
+  if (hedged) table.EnableReadRowHedging();
 
   auto generator = google::cloud::internal::MakeDefaultPRNG();
   std::uniform_int_distribution<int> prng_operation(0, 1);
@@ -239,7 +300,7 @@ google::cloud::StatusOr<LatencyBenchmarkResult> RunBenchmark(
       result.apply_results.operations.emplace_back(op_result);
       ++result.apply_results.row_count;
     } else {
-      auto op_result = RunOneReadRow(table, row_key);
+      auto op_result = RunOneReadRow(table, row_key, hedged);
       if (!op_result.status.ok()) {
         return op_result.status;
       }
@@ -251,6 +312,7 @@ google::cloud::StatusOr<LatencyBenchmarkResult> RunBenchmark(
       mark = now + test_duration / kBenchmarkProgressMarks;
     }
   }
+  result.hedging_stats = table.read_row_hedging_stats();
   return result;
 }
 
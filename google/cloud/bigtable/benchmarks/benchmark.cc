@@ -94,6 +94,7 @@ google::cloud::StatusOr<BenchmarkResult> Benchmark::PopulateTable() {
   std::cout << "# Populating table " << setup_.table_id() << " " << std::flush;
   std::vector<std::future<google::cloud::StatusOr<BenchmarkResult>>> tasks;
   auto upload_start = std::chrono::steady_clock::now();
+  auto const usage_start = CurrentResourceUsage();
   auto table_size = setup_.table_size();
   std::int64_t shard_start = 0;
   for (int i = 0; i != kPopulateShardCount; ++i) {
@@ -123,6 +124,7 @@ google::cloud::StatusOr<BenchmarkResult> Benchmark::PopulateTable() {
   using std::chrono::duration_cast;
   result.elapsed = duration_cast<std::chrono::milliseconds>(
       std::chrono::steady_clock::now() - upload_start);
+  result.usage = CurrentResourceUsage() - usage_start;
   std::cout << " DONE. Elapsed=" << FormatDuration(result.elapsed)
             << ", Ops=" << result.operations.size()
             << ", Rows=" << result.row_count << "\n";
@@ -216,6 +218,57 @@ void Benchmark::PrintResultCsv(std::ostream& os, std::string const& test_name,
      << setup_.notes() << "\n";
 }
 
+ReportRecord Benchmark::MakeReportRecord(std::string const& test_name,
+                                         std::string const& op_name,
+                                         BenchmarkResult& result) const {
+  ReportRecord record;
+  record.test_name = test_name;
+  record.op_name = op_name;
+  record.start_time = setup_.start_time();
+  record.notes = setup_.notes();
+  auto const nsamples = static_cast<std::int64_t>(result.operations.size());
+  record.metrics["nsamples"] = static_cast<double>(nsamples);
+  if (result.elapsed.count() != 0) {
+    auto const elapsed_s = static_cast<double>(result.elapsed.count()) / 1000.0;
+    record.metrics["throughput.ops"] =
+        static_cast<double>(nsamples) / elapsed_s;
+    record.metrics["throughput.rows"] =
+        static_cast<double>(result.row_count) / elapsed_s;
+  }
+  if (nsamples != 0) {
+    std::sort(result.operations.begin(), result.operations.end(),
+              [](OperationResult const& lhs, OperationResult const& rhs) {
+                return lhs.latency < rhs.latency;
+              });
+    for (double p : kResultPercentiles) {
+      auto index = static_cast<std::size_t>(
+          std::round(static_cast<double>(nsamples - 1) * p / 100.0));
+      std::ostringstream name;
+      name << "latency.p" << p << "_us";
+      record.metrics[name.str()] =
+          static_cast<double>(result.operations[index].latency.count());
+    }
+  }
+  AddUsageMetrics(record, result.usage, nsamples);
+  return record;
+}
+
+void Benchmark::AddToReport(std::string const& test_name,
+                            std::string const& op_name,
+                            BenchmarkResult& result) {
+  report_.push_back(MakeReportRecord(test_name, op_name, result));
+}
+
+void Benchmark::AddToReport(ReportRecord record) {
+  if (record.start_time.empty()) record.start_time = setup_.start_time();
+  if (record.notes.empty()) record.notes = setup_.notes();
+  report_.push_back(std::move(record));
+}
+
+int Benchmark::FinishReport(std::ostream& os) const {
+  return benchmarks::FinishReport(setup_.report_config(), report_, os);
+}
+
 int Benchmark::create_table_count() const {
   if (!server_) {
     return 0;
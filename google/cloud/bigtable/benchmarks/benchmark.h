@@ -15,15 +15,18 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_H
 
+#include "google/cloud/bigtable/benchmarks/benchmark_report.h"
 #include "google/cloud/bigtable/benchmarks/embedded_server.h"
 #include "google/cloud/bigtable/benchmarks/setup.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/internal/random.h"
 #include "google/cloud/status_or.h"
+#include "google/cloud/testing_util/resource_usage.h"
 #include <chrono>
 #include <deque>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -39,6 +42,8 @@ struct BenchmarkResult {
   std::chrono::milliseconds elapsed;
   std::deque<OperationResult> operations;
   std::int64_t row_count = 0;
+  /// The resources consumed during `elapsed`, by all the threads.
+  ResourceUsage usage;
 };
 
 /**
@@ -101,6 +106,22 @@ class Benchmark {
                       std::string const& measurement,
                       BenchmarkResult& result) const;
 
+  /// Convert @p result to a record for the machine-readable report.
+  ReportRecord MakeReportRecord(std::string const& test_name,
+                                std::string const& op_name,
+                                BenchmarkResult& result) const;
+
+  //@{
+  /// Add a result to the machine-readable report.
+  void AddToReport(std::string const& test_name, std::string const& op_name,
+                   BenchmarkResult& result);
+  void AddToReport(ReportRecord record);
+  //@}
+
+  /// Write the report, and compare it against the baseline, see
+  /// `benchmarks::FinishReport()`.
+  int FinishReport(std::ostream& os) const;
+
   //@{
   /**
    * @name Embedded server counter accessors.
@@ -137,6 +158,7 @@ class Benchmark {
   bigtable::ClientOptions client_options_;
   std::unique_ptr<EmbeddedServer> server_;
   std::thread server_thread_;
+  std::vector<ReportRecord> report_;
 };
 
 /// Helper class to pretty print durations.
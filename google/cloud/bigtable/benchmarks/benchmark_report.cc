@@ -0,0 +1,292 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark_report.h"
+#include "google/cloud/internal/getenv.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <sstream>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+
+char const* const kCostMetrics[] = {"cpu_us_per_op", "allocations_per_op",
+                                    "context_switches_per_op"};
+
+void AppendString(std::ostream& os, std::string const& value) {
+  os << '"';
+  for (auto c : value) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+      os << buf;
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+/// A minimal parser for the flat objects produced by `ToJson()`.
+class Parser {
+ public:
+  explicit Parser(std::string const& text) : text_(text) {}
+
+  google::cloud::StatusOr<ReportRecord> Parse() {
+    ReportRecord record;
+    SkipSpace();
+    if (!Consume('{')) return Error("expected '{'");
+    SkipSpace();
+    if (Consume('}')) return record;
+    while (true) {
+      std::string key;
+      if (!ParseString(key)) return Error("expected a key");
+      SkipSpace();
+      if (!Consume(':')) return Error("expected ':'");
+      SkipSpace();
+      if (Peek() == '"') {
+        std::string value;
+        if (!ParseString(value)) return Error("invalid string");
+        if (key == "name") {
+          record.test_name = std::move(value);
+        } else if (key == "op.name") {
+          record.op_name = std::move(value);
+        } else if (key == "start") {
+          record.start_time = std::move(value);
+        } else if (key == "notes") {
+          record.notes = std::move(value);
+        }
+      } else {
+        double value;
+        if (!ParseNumber(value)) return Error("invalid number");
+        record.metrics[key] = value;
+      }
+      SkipSpace();
+      if (Consume('}')) break;
+      if (!Consume(',')) return Error("expected ',' or '}'");
+      SkipSpace();
+    }
+    SkipSpace();
+    if (pos_ != text_.size()) return Error("unexpected trailing characters");
+    return record;
+  }
+
+ private:
+  char Peek() const { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+  bool Consume(char c) {
+    if (Peek() != c) return false;
+    ++pos_;
+    return true;
+  }
+
+  void SkipSpace() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\r')) {
+      ++pos_;
+    }
+  }
+
+  bool ParseString(std::string& value) {
+    if (!Consume('"')) return false;
+    while (pos_ < text_.size()) {
+      auto c = text_[pos_++];
+      if (c == '"') return true;
+      if (c != '\\') {
+        value.push_back(c);
+        continue;
+      }
+      if (pos_ >= text_.size()) return false;
+      c = text_[pos_++];
+      if (c == 'u') {
+        // `ToJson()` only escapes control characters this way.
+        if (pos_ + 4 > text_.size()) return false;
+        auto code = std::strtol(text_.substr(pos_, 4).c_str(), nullptr, 16);
+        value.push_back(static_cast<char>(code));
+        pos_ += 4;
+      } else {
+        value.push_back(c);
+      }
+    }
+    return false;
+  }
+
+  bool ParseNumber(double& value) {
+    char const* begin = text_.c_str() + pos_;
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    if (end == begin) return false;
+    pos_ += static_cast<std::size_t>(end - begin);
+    return true;
+  }
+
+  google::cloud::Status Error(std::string const& msg) const {
+    std::ostringstream os;
+    os << "cannot parse benchmark report at offset " << pos_ << ": " << msg;
+    return google::cloud::Status(google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str());
+  }
+
+  std::string const& text_;
+  std::size_t pos_ = 0;
+};
+
+}  // namespace
+
+ReportConfig ReportConfigFromEnvironment() {
+  using ::google::cloud::internal::GetEnv;
+  ReportConfig config;
+  config.report_file =
+      GetEnv("GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_REPORT").value_or("");
+  config.baseline_file =
+      GetEnv("GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_BASELINE").value_or("");
+  auto const threshold =
+      GetEnv("GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_REGRESSION_THRESHOLD");
+  if (threshold.has_value()) {
+    config.regression_threshold = std::strtod(threshold->c_str(), nullptr);
+  }
+  return config;
+}
+
+void AddUsageMetrics(ReportRecord& record, ResourceUsage const& usage,
+                     std::int64_t op_count) {
+  if (op_count <= 0) return;
+  auto const n = static_cast<double>(op_count);
+  record.metrics["cpu_us_per_op"] =
+      static_cast<double>(usage.cpu_time.count()) / n;
+  record.metrics["allocations_per_op"] =
+      static_cast<double>(usage.allocations) / n;
+  record.metrics["context_switches_per_op"] =
+      static_cast<double>(usage.voluntary_context_switches +
+                          usage.involuntary_context_switches) /
+      n;
+}
+
+std::string ToJson(ReportRecord const& record) {
+  std::ostringstream os;
+  os << std::setprecision(17);
+  os << "{";
+  AppendString(os, "name");
+  os << ":";
+  AppendString(os, record.test_name);
+  os << ",";
+  AppendString(os, "op.name");
+  os << ":";
+  AppendString(os, record.op_name);
+  os << ",";
+  AppendString(os, "start");
+  os << ":";
+  AppendString(os, record.start_time);
+  for (auto const& kv : record.metrics) {
+    os << ",";
+    AppendString(os, kv.first);
+    os << ":" << kv.second;
+  }
+  os << ",";
+  AppendString(os, "notes");
+  os << ":";
+  AppendString(os, record.notes);
+  os << "}";
+  return std::move(os).str();
+}
+
+google::cloud::StatusOr<ReportRecord> ParseReportRecord(
+    std::string const& line) {
+  return Parser(line).Parse();
+}
+
+google::cloud::StatusOr<std::vector<ReportRecord>> ReadReport(
+    std::istream& is) {
+  std::vector<ReportRecord> records;
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+    auto record = ParseReportRecord(line);
+    if (!record) return std::move(record).status();
+    records.push_back(*std::move(record));
+  }
+  return records;
+}
+
+std::vector<std::string> CompareToBaseline(
+    std::vector<ReportRecord> const& baseline,
+    std::vector<ReportRecord> const& current, double threshold) {
+  std::map<std::pair<std::string, std::string>, ReportRecord const*> index;
+  for (auto const& r : baseline) {
+    index[std::make_pair(r.test_name, r.op_name)] = &r;
+  }
+
+  std::vector<std::string> regressions;
+  for (auto const& r : current) {
+    auto b = index.find(std::make_pair(r.test_name, r.op_name));
+    if (b == index.end()) continue;
+    for (auto const* name : kCostMetrics) {
+      auto old_value = b->second->metrics.find(name);
+      auto new_value = r.metrics.find(name);
+      if (old_value == b->second->metrics.end() ||
+          new_value == r.metrics.end()) {
+        continue;
+      }
+      if (new_value->second <= old_value->second * (1.0 + threshold)) continue;
+      std::ostringstream os;
+      os << r.test_name << "/" << r.op_name << ": " << name << " "
+         << old_value->second << " -> " << new_value->second;
+      regressions.push_back(std::move(os).str());
+    }
+  }
+  return regressions;
+}
+
+int FinishReport(ReportConfig const& config,
+                 std::vector<ReportRecord> const& records, std::ostream& os) {
+  if (!config.report_file.empty()) {
+    std::ofstream report(config.report_file);
+    for (auto const& r : records) report << ToJson(r) << "\n";
+    if (!report) {
+      os << "# Cannot write report to " << config.report_file << "\n";
+      return 1;
+    }
+  }
+  if (config.baseline_file.empty()) return 0;
+
+  std::ifstream is(config.baseline_file);
+  if (!is) {
+    os << "# Cannot open baseline " << config.baseline_file << "\n";
+    return 1;
+  }
+  auto baseline = ReadReport(is);
+  if (!baseline) {
+    os << "# Cannot read baseline " << config.baseline_file << ": "
+       << baseline.status() << "\n";
+    return 1;
+  }
+  auto regressions =
+      CompareToBaseline(*baseline, records, config.regression_threshold);
+  for (auto const& r : regressions) os << "# REGRESSION " << r << "\n";
+  return regressions.empty() ? 0 : 1;
+}
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,118 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_REPORT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_REPORT_H
+
+#include "google/cloud/bigtable/benchmarks/constants.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/testing_util/resource_usage.h"
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+
+using ::google::cloud::testing_util::CurrentResourceUsage;
+using ::google::cloud::testing_util::ResourceUsage;
+
+/**
+ * The machine-readable result for one operation in a benchmark.
+ *
+ * Reports are written as JSON lines, one object per record, e.g.:
+ *
+ * @code
+ * {"name":"perf","op.name":"Apply()","cpu_us_per_op":41.5,...}
+ * @endcode
+ *
+ * The objects are flat, `name`, `op.name`, `start` and `notes` are strings and
+ * all other fields are numbers.
+ */
+struct ReportRecord {
+  std::string test_name;
+  std::string op_name;
+  std::string start_time;
+  std::string notes;
+  std::map<std::string, double> metrics;
+};
+
+/**
+ * Where to write the machine-readable report, and what to compare it against.
+ *
+ * The benchmarks take positional command-line arguments, these are set from the
+ * `GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_REPORT`,
+ * `GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_BASELINE` and
+ * `GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_REGRESSION_THRESHOLD` environment
+ * variables instead. Empty file names disable the corresponding feature.
+ */
+struct ReportConfig {
+  std::string report_file;
+  std::string baseline_file;
+  double regression_threshold = kDefaultRegressionThreshold;
+};
+
+ReportConfig ReportConfigFromEnvironment();
+
+/// Add the per-operation costs (CPU, allocations, context switches).
+void AddUsageMetrics(ReportRecord& record, ResourceUsage const& usage,
+                     std::int64_t op_count);
+
+/// Format @p record as a single line JSON object, without the newline.
+std::string ToJson(ReportRecord const& record);
+
+/// Parse a line produced by `ToJson()`.
+google::cloud::StatusOr<ReportRecord> ParseReportRecord(
+    std::string const& line);
+
+/// Read all the records in @p is, ignoring blank lines.
+google::cloud::StatusOr<std::vector<ReportRecord>> ReadReport(
+    std::istream& is);
+
+/**
+ * Compare the per-operation costs in @p current against @p baseline.
+ *
+ * Only the cost metrics (CPU time, allocations and context switches per
+ * operation) are compared, the latency and throughput depend too much on the
+ * environment. A metric regresses if it grew by more than @p threshold, e.g.
+ * `0.1` for 10%, relative to the record with the same test and operation name
+ * in the baseline. Records missing from either report are ignored.
+ *
+ * @return a description of each regression, empty if there are none.
+ */
+std::vector<std::string> CompareToBaseline(
+    std::vector<ReportRecord> const& baseline,
+    std::vector<ReportRecord> const& current, double threshold);
+
+/**
+ * Write @p records to the report file and compare them against the baseline.
+ *
+ * Any per-operation cost that regressed is printed to @p os.
+ *
+ * @return the exit code for the benchmark, non-zero if the report cannot be
+ *     written, the baseline cannot be read, or the costs regressed.
+ */
+int FinishReport(ReportConfig const& config,
+                 std::vector<ReportRecord> const& records, std::ostream& os);
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_REPORT_H
@@ -0,0 +1,127 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark_report.h"
+#include "google/cloud/testing_util/scoped_environment.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+
+using ::google::cloud::testing_util::ScopedEnvironment;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+ReportRecord MakeRecord(std::string op_name, double cpu, double allocations) {
+  ReportRecord r;
+  r.test_name = "test";
+  r.op_name = std::move(op_name);
+  r.start_time = "2021-01-01T00:00:00Z";
+  r.notes = "notes";
+  r.metrics["cpu_us_per_op"] = cpu;
+  r.metrics["allocations_per_op"] = allocations;
+  return r;
+}
+
+TEST(BenchmarkReport, RoundTrip) {
+  auto record = MakeRecord("Read\"Row\"()", 12.5, 40);
+  record.notes = "line1\nline2;back\\slash";
+  record.metrics["latency.p99.9_us"] = 1234;
+
+  auto json = ToJson(record);
+  EXPECT_EQ(std::string::npos, json.find('\n'));
+  auto parsed = ParseReportRecord(json);
+  ASSERT_STATUS_OK(parsed);
+  EXPECT_EQ(record.test_name, parsed->test_name);
+  EXPECT_EQ(record.op_name, parsed->op_name);
+  EXPECT_EQ(record.start_time, parsed->start_time);
+  EXPECT_EQ(record.notes, parsed->notes);
+  EXPECT_EQ(record.metrics, parsed->metrics);
+}
+
+TEST(BenchmarkReport, ParseErrors) {
+  for (auto const* text : {"", "[]", "{\"a\":}", "{\"a\":1", "{\"a\":1} x",
+                           "{\"a\" 1}", "{\"a\":\"unterminated}"}) {
+    SCOPED_TRACE("Testing with " + std::string(text));
+    EXPECT_THAT(ParseReportRecord(text),
+                StatusIs(StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(BenchmarkReport, ReadReport) {
+  std::istringstream is(ToJson(MakeRecord("a", 1, 2)) + "\n\n" +
+                        ToJson(MakeRecord("b", 3, 4)) + "\n");
+  auto report = ReadReport(is);
+  ASSERT_STATUS_OK(report);
+  ASSERT_EQ(2U, report->size());
+  EXPECT_EQ("a", (*report)[0].op_name);
+  EXPECT_EQ("b", (*report)[1].op_name);
+
+  std::istringstream bad("{}\nnot-json\n");
+  EXPECT_THAT(ReadReport(bad), StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(BenchmarkReport, AddUsageMetrics) {
+  ResourceUsage usage;
+  usage.cpu_time = std::chrono::microseconds(1000);
+  usage.allocations = 500;
+  usage.voluntary_context_switches = 7;
+  usage.involuntary_context_switches = 3;
+  ReportRecord record;
+  AddUsageMetrics(record, usage, 10);
+  EXPECT_EQ(100.0, record.metrics["cpu_us_per_op"]);
+  EXPECT_EQ(50.0, record.metrics["allocations_per_op"]);
+  EXPECT_EQ(1.0, record.metrics["context_switches_per_op"]);
+
+  ReportRecord empty;
+  AddUsageMetrics(empty, usage, 0);
+  EXPECT_THAT(empty.metrics, IsEmpty());
+}
+
+TEST(BenchmarkReport, CompareToBaseline) {
+  std::vector<ReportRecord> baseline{MakeRecord("a", 10, 100),
+                                     MakeRecord("b", 10, 100)};
+  std::vector<ReportRecord> current{MakeRecord("a", 10.5, 100),
+                                    MakeRecord("b", 12, 100),
+                                    MakeRecord("new", 1000, 1000)};
+  EXPECT_THAT(CompareToBaseline(baseline, current, 0.1),
+              ElementsAre(HasSubstr("test/b: cpu_us_per_op")));
+  EXPECT_THAT(CompareToBaseline(baseline, current, 0.5), IsEmpty());
+}
+
+TEST(BenchmarkReport, ReportConfigFromEnvironment) {
+  ScopedEnvironment report("GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_REPORT",
+                           "report.json");
+  ScopedEnvironment baseline("GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_BASELINE",
+                             absl::nullopt);
+  ScopedEnvironment threshold(
+      "GOOGLE_CLOUD_CPP_BIGTABLE_BENCHMARK_REGRESSION_THRESHOLD", "0.25");
+  auto config = ReportConfigFromEnvironment();
+  EXPECT_EQ("report.json", config.report_file);
+  EXPECT_EQ("", config.baseline_file);
+  EXPECT_EQ(0.25, config.regression_threshold);
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -18,6 +18,7 @@
 
 bigtable_benchmark_common_hdrs = [
     "benchmark.h",
+    "benchmark_report.h",
     "constants.h",
     "embedded_server.h",
     "mutation_batcher_throughput_options.h",
@@ -27,6 +28,7 @@ bigtable_benchmark_common_hdrs = [
 
 bigtable_benchmark_common_srcs = [
     "benchmark.cc",
+    "benchmark_report.cc",
     "embedded_server.cc",
     "mutation_batcher_throughput_options.cc",
     "random_mutation.cc",
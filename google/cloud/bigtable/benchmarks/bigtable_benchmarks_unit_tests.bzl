@@ -17,6 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 bigtable_benchmarks_unit_tests = [
+    "benchmark_report_test.cc",
     "bigtable_benchmark_test.cc",
     "embedded_server_test.cc",
     "format_duration_test.cc",
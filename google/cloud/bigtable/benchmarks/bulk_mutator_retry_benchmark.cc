@@ -0,0 +1,164 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/idempotent_mutation_policy.h"
+#include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/command_line_parsing.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace btproto = google::bigtable::v2;
+namespace cbt = google::cloud::bigtable;
+using google::cloud::internal::DefaultPRNG;
+using google::cloud::testing_util::BuildUsage;
+using google::cloud::testing_util::OptionDescriptor;
+using google::cloud::testing_util::OptionsParse;
+
+char const kDescription[] =
+    R"""(A benchmark for the retry loop in `Table::AsyncBulkApply()`.
+
+The program measures the client-side cost of retrying the failed subset of a
+large bulk mutation. It does not contact any server: the responses are
+synthesized, and each pending mutation fails with a transient error with the
+given probability. The retry loop runs until all the mutations succeed.
+
+The program reports the number of attempts, the total number of entries sent,
+and the average time to process each bulk mutation.
+)""";
+
+struct Options {
+  int row_count = 10000;
+  int value_size = 100;
+  double failure_rate = 0.5;
+  int iterations = 10;
+};
+
+btproto::MutateRowsResponse MakeResponse(int size, double failure_rate,
+                                         DefaultPRNG& gen) {
+  std::bernoulli_distribution fails(failure_rate);
+  btproto::MutateRowsResponse response;
+  for (int i = 0; i != size; ++i) {
+    auto& e = *response.add_entries();
+    e.set_index(i);
+    e.mutable_status()->set_code(fails(gen) ? grpc::StatusCode::UNAVAILABLE
+                                            : grpc::StatusCode::OK);
+  }
+  return response;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<OptionDescriptor> desc{
+      {"--help", "print usage information",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print benchmark description",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--row-count", "the number of mutations in each bulk mutation",
+       [&options](std::string const& val) {
+         options.row_count = std::stoi(val);
+       }},
+      {"--value-size", "the size of the value in each mutation",
+       [&options](std::string const& val) {
+         options.value_size = std::stoi(val);
+       }},
+      {"--failure-rate",
+       "the probability that a mutation fails with a transient error in each "
+       "attempt, must be in the [0.0, 1.0) range",
+       [&options](std::string const& val) {
+         options.failure_rate = std::stod(val);
+       }},
+      {"--iterations", "the number of bulk mutations to process",
+       [&options](std::string const& val) {
+         options.iterations = std::stoi(val);
+       }},
+  };
+  auto unparsed = OptionsParse(desc, {argv, argv + argc});
+  if (wants_help) {
+    std::cout << BuildUsage(desc, argv[0]) << "\n";
+    return 0;
+  }
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+    return 0;
+  }
+  if (unparsed.size() != 1) {
+    std::cerr << "Unexpected command-line arguments\n"
+              << BuildUsage(desc, argv[0]) << "\n";
+    return 1;
+  }
+  if (options.row_count <= 0 || options.value_size < 0 ||
+      options.iterations <= 0 || options.failure_rate < 0.0 ||
+      options.failure_rate >= 1.0) {
+    std::cerr << "Invalid options\n" << BuildUsage(desc, argv[0]) << "\n";
+    return 1;
+  }
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto policy = cbt::DefaultIdempotentMutationPolicy();
+  std::string const value(static_cast<std::size_t>(options.value_size), 'v');
+
+  std::int64_t attempts = 0;
+  std::int64_t entries_sent = 0;
+  std::chrono::steady_clock::duration elapsed{};
+  for (int iteration = 0; iteration != options.iterations; ++iteration) {
+    cbt::BulkMutation mut;
+    for (int i = 0; i != options.row_count; ++i) {
+      // Use an explicit timestamp, otherwise the mutations are not retried.
+      mut.emplace_back(cbt::SingleRowMutation(
+          "row" + std::to_string(i),
+          {cbt::SetCell("fam", "col", std::chrono::milliseconds(0), value)}));
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    cbt::internal::BulkMutatorState state("", "test-table", *policy,
+                                          std::move(mut));
+    while (state.HasPendingMutations()) {
+      auto const& request = state.BeforeStart();
+      ++attempts;
+      entries_sent += request.entries_size();
+      auto response =
+          MakeResponse(request.entries_size(), options.failure_rate, generator);
+      state.OnRead(response);
+      state.OnFinish(google::cloud::Status{});
+    }
+    auto failures = std::move(state).OnRetryDone();
+    elapsed += std::chrono::steady_clock::now() - start;
+    if (!failures.empty()) {
+      std::cerr << "Unexpected failures in bulk mutation\n";
+      return 1;
+    }
+  }
+
+  using ms = std::chrono::duration<double, std::milli>;
+  std::cout << "RowCount,ValueSize,FailureRate,Iterations,Attempts,"
+               "EntriesSent,AverageMs\n"
+            << options.row_count << "," << options.value_size << ","
+            << options.failure_rate << "," << options.iterations << ","
+            << attempts << "," << entries_sent << ","
+            << ms(elapsed).count() / options.iterations << "\n";
+  return 0;
+}
@@ -58,6 +58,9 @@ int constexpr kPopulateShardProgressMarks = 4;
 
 /// How many random bytes in the table id.
 int constexpr kTableIdRandomLetters = 8;
+
+/// The tolerated growth in the per-operation costs, relative to a baseline.
+double constexpr kDefaultRegressionThreshold = 0.1;
 //@}
 
 }  // namespace benchmarks
@@ -86,6 +86,7 @@ int main(int argc, char* argv[]) {
   // Start the threads running the latency test.
   std::cout << "# Running Endurance Benchmark:\n";
   auto latency_test_start = std::chrono::steady_clock::now();
+  auto const usage_start = bigtable::benchmarks::CurrentResourceUsage();
   // NOLINTNEXTLINE(google-runtime-int)
   std::vector<std::future<google::cloud::StatusOr<long>>> tasks;
   for (int i = 0; i != setup->thread_count(); ++i) {
@@ -114,14 +115,23 @@ int main(int argc, char* argv[]) {
   }
   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
       std::chrono::steady_clock::now() - latency_test_start);
+  auto const usage = bigtable::benchmarks::CurrentResourceUsage() - usage_start;
   auto throughput = 1000.0 * static_cast<double>(combined) /
                     static_cast<double>(elapsed.count());
   std::cout << "# DONE. Elapsed=" << FormatDuration(elapsed)
             << ", Ops=" << combined << ", Throughput: " << throughput
             << " ops/sec\n";
 
+  bigtable::benchmarks::ReportRecord record;
+  record.test_name = "long";
+  record.op_name = "Op";
+  record.metrics["nsamples"] = static_cast<double>(combined);
+  record.metrics["throughput.ops"] = throughput;
+  AddUsageMetrics(record, usage, combined);
+  benchmark.AddToReport(std::move(record));
+
   benchmark.DeleteTable();
-  return 0;
+  return benchmark.FinishReport(std::cout);
 }
 
 namespace {
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "google/cloud/bigtable/benchmarks/benchmark_report.h"
 #include "google/cloud/bigtable/benchmarks/mutation_batcher_throughput_options.h"
 #include "google/cloud/bigtable/mutation_batcher.h"
 #include "google/cloud/bigtable/table.h"
@@ -24,6 +25,7 @@
 #include "absl/time/time.h"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -49,6 +51,15 @@ maximum concurrent batches in flight. It also tests the performance that can be
 achieved by providing initial splits to the table and having multiple batchers
 send it mutations in parallel.
 
+With --target-batch-latency-ms the batchers run in adaptive mode, where the
+batch size and number of concurrent batches are tuned at run-time. The program
+reports the throughput for every 5% of the mutations, which shows how the
+batcher converges.
+
+With --compression-threshold the `MutateRows` requests of at least that many
+bytes are compressed with gzip. Use --value-size to make the mutations large
+enough, and compare the CPU usage and throughput with and without compression.
+
 The program is designed to be run repeatedly. It can be configured to terminate
 after a set amount of time. It can also be configured to use a pre-existing
 table instead of creating a new one then deleting it when the program is done.
@@ -122,7 +133,8 @@ cbt::SingleRowMutation MakeMutation(
     MutationBatcherThroughputOptions const& options, std::string row_key) {
   return cbt::SingleRowMutation(
       std::move(row_key),
-      {cbt::SetCell(options.column_family, options.column, "value")});
+      {cbt::SetCell(options.column_family, options.column,
+                    std::string(options.value_size, 'x'))});
 }
 
 }  // namespace
@@ -185,6 +197,11 @@ int main(int argc, char* argv[]) {
 
   auto opts = Options{}.set<google::cloud::GrpcBackgroundThreadPoolSizeOption>(
       options->max_batches);
+  if (options->compression_threshold >= 0) {
+    opts.set<google::cloud::GrpcCompressionOption>(
+        {{"Bigtable.MutateRows",
+          static_cast<std::size_t>(options->compression_threshold)}});
+  }
   auto table = cbt::Table(
       cbt::CreateDefaultDataClient(options->project_id, options->instance_id,
                                    cbt::ClientOptions(std::move(opts))),
@@ -199,7 +216,13 @@ int main(int argc, char* argv[]) {
             << "\n# Batcher Thread Count: " << options->batcher_thread_count
             << "\n# Total Mutations: " << options->mutation_count
             << "\n# Mutations per Batch: " << options->batch_size
-            << "\n# Concurrent Batches: " << options->max_batches << std::endl;
+            << "\n# Concurrent Batches: " << options->max_batches
+            << "\n# Target Batch Latency: "
+            << absl::FormatDuration(
+                   absl::FromChrono(options->target_batch_latency))
+            << "\n# Value Size: " << options->value_size
+            << "\n# Compression Threshold: " << options->compression_threshold
+            << std::endl;
 
   // Create the batcher threads
   AutomaticallyCreatedBackgroundThreads batcher_threads(
@@ -229,6 +252,9 @@ int main(int argc, char* argv[]) {
     bool log = write_index == 0;
     if (log) std::cout << "#\n# Writing" << std::flush;
     auto progress_period = std::max<std::int64_t>(1, (end - start) / 20);
+    // The throughput during each progress period, in mutations per second.
+    std::vector<double> throughput;
+    auto period_start = std::chrono::steady_clock::now();
 
     BenchmarkResult result;
     result.successes = end - start;
@@ -236,7 +262,8 @@ int main(int argc, char* argv[]) {
     cbt::MutationBatcher batcher(
         table, cbt::MutationBatcher::Options{}
                    .SetMaxBatches(options->max_batches)
-                   .SetMaxMutationsPerBatch(options->batch_size));
+                   .SetMaxMutationsPerBatch(options->batch_size)
+                   .SetTargetBatchLatency(options->target_batch_latency));
 
     for (auto i = start; i != end; ++i) {
       // Stop writing if we hit the cutoff deadline
@@ -259,9 +286,20 @@ int main(int argc, char* argv[]) {
 
       if (log && (i - start) % progress_period == 0) {
         std::cout << "." << std::flush;
+        auto const now = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = now - period_start;
+        if (i != start && elapsed.count() > 0) {
+          throughput.push_back(static_cast<double>(progress_period) /
+                               elapsed.count());
+        }
+        period_start = now;
       }
     }
-    if (log) std::cout << "\n#" << std::endl;
+    if (log) {
+      std::cout << "\n# Throughput (mutations/s):";
+      for (auto t : throughput) std::cout << " " << std::llround(t);
+      std::cout << "\n#" << std::endl;
+    }
 
     batcher.AsyncWaitForNoPendingRequests().get();
 
@@ -270,6 +308,7 @@ int main(int argc, char* argv[]) {
   };
 
   auto start_time = std::chrono::steady_clock::now();
+  auto const usage_start = cbt::benchmarks::CurrentResourceUsage();
 
   auto write_index = 0;
   std::vector<std::future<BenchmarkResult>> tasks(options->write_thread_count);
@@ -285,18 +324,37 @@ int main(int argc, char* argv[]) {
 
   auto end_time = std::chrono::steady_clock::now();
   std::chrono::duration<double> elapsed = end_time - start_time;
+  auto const usage = cbt::benchmarks::CurrentResourceUsage() - usage_start;
 
   // Shutdown the deadline timer
   timer.cancel();
   timer.get();
 
   std::cout << "MutationCount,BatchSize,MaxBatches,ShardCount,WriteThreadCount,"
-               "BatcherThreadCount,ElapsedSeconds,Successes,Fails\n"
+               "BatcherThreadCount,TargetBatchLatencyMs,ValueSize,"
+               "CompressionThreshold,ElapsedSeconds,Successes,Fails\n"
             << options->mutation_count << "," << options->batch_size << ","
             << options->max_batches << "," << options->shard_count << ","
             << options->write_thread_count << ","
-            << options->batcher_thread_count << "," << elapsed.count() << ","
-            << totals.successes << "," << totals.fails << "\n";
+            << options->batcher_thread_count << ","
+            << options->target_batch_latency.count() << ","
+            << options->value_size << "," << options->compression_threshold
+            << ","
+            << elapsed.count() << "," << totals.successes << ","
+            << totals.fails << "\n";
+
+  // The benchmark stops early if `max_time` is set.
+  auto const mutations = totals.successes + totals.fails;
+  cbt::benchmarks::ReportRecord record;
+  record.test_name = "mutation_batcher";
+  record.op_name = "AsyncApply()";
+  record.metrics["nsamples"] = static_cast<double>(mutations);
+  if (elapsed.count() > 0) {
+    record.metrics["throughput.ops"] =
+        static_cast<double>(totals.successes) / elapsed.count();
+  }
+  record.metrics["value.bytes"] = options->value_size;
+  AddUsageMetrics(record, usage, mutations);
 
   // If we created a table, delete it.
   if (options->table_id.empty()) {
@@ -308,5 +366,6 @@ int main(int argc, char* argv[]) {
     }
   }
 
-  return 0;
+  return cbt::benchmarks::FinishReport(
+      cbt::benchmarks::ReportConfigFromEnvironment(), {record}, std::cout);
 }
@@ -86,6 +86,25 @@ ParseMutationBatcherThroughputOptions(std::vector<std::string> const& argv,
        [&options](std::string const& val) {
          options.batch_size = std::stoi(val);
        }},
+      {"--target-batch-latency-ms",
+       "enable the adaptive mode of the batcher, tuning the batch size and the "
+       "number of outstanding batches to meet this latency. With this option "
+       "--max-batches and --batch-size are upper bounds. A value of 0 "
+       "disables the adaptive mode",
+       [&options](std::string const& val) {
+         options.target_batch_latency =
+             std::chrono::milliseconds(std::stoll(val));
+       }},
+      {"--value-size", "the size of the value in each mutation, in bytes",
+       [&options](std::string const& val) {
+         options.value_size = std::stoi(val);
+       }},
+      {"--compression-threshold",
+       "compress the MutateRows requests of at least this many bytes. A "
+       "negative value disables compression",
+       [&options](std::string const& val) {
+         options.compression_threshold = std::stoll(val);
+       }},
   };
 
   auto usage = BuildUsage(desc, argv[0]);
@@ -171,6 +190,19 @@ ParseMutationBatcherThroughputOptions(std::vector<std::string> const& argv,
           "--batch-size option\n";
     return make_status(os);
   }
+  if (options.target_batch_latency.count() < 0) {
+    std::ostringstream os;
+    os << "Invalid target batch latency ("
+       << options.target_batch_latency.count()
+       << "ms). Check your --target-batch-latency-ms option\n";
+    return make_status(os);
+  }
+  if (options.value_size < 0) {
+    std::ostringstream os;
+    os << "Invalid value size (" << options.value_size
+       << "). Check your --value-size option\n";
+    return make_status(os);
+  }
 
   return options;
 }
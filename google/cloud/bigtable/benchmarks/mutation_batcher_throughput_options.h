@@ -17,6 +17,7 @@
 
 #include "google/cloud/status_or.h"
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,9 @@ struct MutationBatcherThroughputOptions {
   std::int64_t mutation_count = 1000000;
   int max_batches = 10;
   int batch_size = 1000;
+  std::chrono::milliseconds target_batch_latency = std::chrono::milliseconds(0);
+  int value_size = 5;
+  std::int64_t compression_threshold = -1;
   bool exit_after_parse = false;
 };
 
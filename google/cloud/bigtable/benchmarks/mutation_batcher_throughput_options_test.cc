@@ -36,6 +36,9 @@ TEST(MutationBatcherThroughputOptions, Basic) {
           "--mutation-count=2000000",
           "--max-batches=20",
           "--batch-size=2000",
+          "--target-batch-latency-ms=250",
+          "--value-size=1024",
+          "--compression-threshold=4096",
       },
       "");
   ASSERT_STATUS_OK(options);
@@ -50,6 +53,9 @@ TEST(MutationBatcherThroughputOptions, Basic) {
   EXPECT_EQ(2000000, options->mutation_count);
   EXPECT_EQ(20, options->max_batches);
   EXPECT_EQ(2000, options->batch_size);
+  EXPECT_EQ(250, options->target_batch_latency.count());
+  EXPECT_EQ(1024, options->value_size);
+  EXPECT_EQ(4096, options->compression_threshold);
 }
 
 TEST(MutationBatcherThroughputOptions, Defaults) {
@@ -68,6 +74,9 @@ TEST(MutationBatcherThroughputOptions, Defaults) {
   EXPECT_EQ(1000000, options->mutation_count);
   EXPECT_EQ(10, options->max_batches);
   EXPECT_EQ(1000, options->batch_size);
+  EXPECT_EQ(0, options->target_batch_latency.count());
+  EXPECT_EQ(5, options->value_size);
+  EXPECT_EQ(-1, options->compression_threshold);
 }
 
 TEST(MutationBatcherThroughputOptions, Description) {
@@ -137,6 +146,13 @@ TEST(MutationBatcherThroughputOptions, Validate) {
   EXPECT_FALSE(ParseMutationBatcherThroughputOptions(
       {"self-test", "--project-id=a", "--instance-id=b", "--batch-size=100001"},
       ""));
+  EXPECT_FALSE(ParseMutationBatcherThroughputOptions(
+      {"self-test", "--project-id=a", "--instance-id=b",
+       "--target-batch-latency-ms=-1"},
+      ""));
+  EXPECT_FALSE(ParseMutationBatcherThroughputOptions(
+      {"self-test", "--project-id=a", "--instance-id=b", "--value-size=-1"},
+      ""));
 }
 
 }  // namespace
@@ -0,0 +1,159 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_set_cursor.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/command_line_parsing.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace btproto = google::bigtable::v2;
+namespace cbt = google::cloud::bigtable;
+using google::cloud::testing_util::BuildUsage;
+using google::cloud::testing_util::OptionDescriptor;
+using google::cloud::testing_util::OptionsParse;
+
+char const kDescription[] =
+    R"""(A benchmark for resuming interrupted `Table::ReadRows()` streams.
+
+The program measures the client-side cost of computing the rows to request
+when a `ReadRows()` stream is resumed after a failure. It does not contact any
+server: the program reads a set of explicit row keys in order, and the stream
+is interrupted every `--rows-per-attempt` rows, simulating a retry storm.
+
+With `--mode=cursor` the remaining rows are tracked with the cursor used by
+the row readers, with `--mode=intersect` the full `RowSet` is intersected with
+the keys after the last row on each retry, as the readers used to do.
+
+The program reports the number of attempts and the average time to compute
+the requests for each read.
+)""";
+
+struct Options {
+  int row_count = 100000;
+  int rows_per_attempt = 1000;
+  int iterations = 10;
+  std::string mode = "cursor";
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<OptionDescriptor> desc{
+      {"--help", "print usage information",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print benchmark description",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--row-count", "the number of row keys in each read",
+       [&options](std::string const& val) {
+         options.row_count = std::stoi(val);
+       }},
+      {"--rows-per-attempt",
+       "the number of rows received before each stream is interrupted",
+       [&options](std::string const& val) {
+         options.rows_per_attempt = std::stoi(val);
+       }},
+      {"--iterations", "the number of reads to process",
+       [&options](std::string const& val) {
+         options.iterations = std::stoi(val);
+       }},
+      {"--mode", "how to compute the remaining rows, cursor or intersect",
+       [&options](std::string const& val) { options.mode = val; }},
+  };
+  auto unparsed = OptionsParse(desc, {argv, argv + argc});
+  if (wants_help) {
+    std::cout << BuildUsage(desc, argv[0]) << "\n";
+    return 0;
+  }
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+    return 0;
+  }
+  if (unparsed.size() != 1) {
+    std::cerr << "Unexpected command-line arguments\n"
+              << BuildUsage(desc, argv[0]) << "\n";
+    return 1;
+  }
+  if (options.row_count <= 0 || options.rows_per_attempt <= 0 ||
+      options.iterations <= 0 ||
+      (options.mode != "cursor" && options.mode != "intersect")) {
+    std::cerr << "Invalid options\n" << BuildUsage(desc, argv[0]) << "\n";
+    return 1;
+  }
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  std::vector<std::string> keys;
+  keys.reserve(static_cast<std::size_t>(options.row_count));
+  for (int i = 0; i != options.row_count; ++i) {
+    keys.push_back("row" + std::to_string(i));
+  }
+  // The application provides the keys in any order, the stream returns them
+  // in sorted order.
+  std::shuffle(keys.begin(), keys.end(), generator);
+  auto sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+
+  auto const per_attempt = static_cast<std::size_t>(options.rows_per_attempt);
+  std::int64_t attempts = 0;
+  std::int64_t keys_sent = 0;
+  std::chrono::steady_clock::duration elapsed{};
+  for (int iteration = 0; iteration != options.iterations; ++iteration) {
+    cbt::RowSet row_set;
+    for (auto const& k : keys) row_set.Append(k);
+
+    auto const start = std::chrono::steady_clock::now();
+    btproto::ReadRowsRequest request;
+    if (options.mode == "cursor") {
+      cbt::internal::RowSetCursor cursor(std::move(row_set));
+      for (std::size_t next = 0; !cursor.IsEmpty();) {
+        cursor.Swap(*request.mutable_rows());
+        ++attempts;
+        keys_sent += request.rows().row_keys_size();
+        cursor.Swap(*request.mutable_rows());
+        next = (std::min)(next + per_attempt, sorted.size());
+        cursor.Advance(sorted[next - 1]);
+      }
+    } else {
+      for (std::size_t next = 0; !row_set.IsEmpty();) {
+        auto row_set_proto = row_set.as_proto();
+        request.mutable_rows()->Swap(&row_set_proto);
+        ++attempts;
+        keys_sent += request.rows().row_keys_size();
+        next = (std::min)(next + per_attempt, sorted.size());
+        row_set = row_set.Intersect(cbt::RowRange::Open(sorted[next - 1], ""));
+      }
+    }
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+
+  using ms = std::chrono::duration<double, std::milli>;
+  std::cout << "Mode,RowCount,RowsPerAttempt,Iterations,Attempts,KeysSent,"
+               "AverageMs\n"
+            << options.mode << "," << options.row_count << ","
+            << options.rows_per_attempt << "," << options.iterations << ","
+            << attempts << "," << keys_sent << ","
+            << ms(elapsed).count() / options.iterations << "\n";
+  return 0;
+}
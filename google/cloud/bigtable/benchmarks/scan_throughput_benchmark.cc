@@ -94,12 +94,14 @@ int main(int argc, char* argv[]) {
   for (auto scan_size : kScanSizes) {
     std::cout << "# Running benchmark [" << scan_size << "] " << std::flush;
     auto start = std::chrono::steady_clock::now();
+    auto const usage_start = bigtable::benchmarks::CurrentResourceUsage();
     auto combined = RunBenchmark(benchmark, data_client, setup->table_size(),
                                  setup->app_profile_id(), setup->table_id(),
                                  scan_size, setup->test_duration());
     using std::chrono::duration_cast;
     combined.elapsed = duration_cast<std::chrono::milliseconds>(
         std::chrono::steady_clock::now() - start);
+    combined.usage = bigtable::benchmarks::CurrentResourceUsage() - usage_start;
     std::cout << " DONE. Elapsed=" << FormatDuration(combined.elapsed)
               << ", Ops=" << combined.operations.size()
               << ", Rows=" << combined.row_count << "\n";
@@ -116,9 +118,14 @@ int main(int argc, char* argv[]) {
                              kv.second);
   }
 
+  benchmark.AddToReport("scant", "BulkApply()", *populate_results);
+  for (auto& kv : results_by_size) {
+    benchmark.AddToReport("scant", kv.first, kv.second);
+  }
+
   benchmark.DeleteTable();
 
-  return 0;
+  return benchmark.FinishReport(std::cout);
 }
 
 namespace {
@@ -75,6 +75,7 @@ google::cloud::StatusOr<BenchmarkSetup> MakeBenchmarkSetup(
   setup_data.test_duration = std::chrono::seconds(kDefaultTestDuration * 60);
   setup_data.use_embedded_server = false;
   setup_data.parallel_requests = 10;
+  setup_data.report_config = ReportConfigFromEnvironment();
 
   auto usage = [argv](char const* msg) -> google::cloud::Status {
     std::string const cmd = argv[0];
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_SETUP_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_SETUP_H
 
+#include "google/cloud/bigtable/benchmarks/benchmark_report.h"
 #include "google/cloud/bigtable/benchmarks/constants.h"
 #include "google/cloud/status_or.h"
 #include <chrono>
@@ -40,6 +41,8 @@ struct BenchmarkSetupData {
   bool use_embedded_server;
 
   int parallel_requests;
+
+  ReportConfig report_config;
 };
 
 /**
@@ -71,6 +74,10 @@ class BenchmarkSetup {
 
   int parallel_requests() const { return setup_data_.parallel_requests; }
 
+  ReportConfig const& report_config() const {
+    return setup_data_.report_config;
+  }
+
  private:
   BenchmarkSetupData setup_data_;
 };
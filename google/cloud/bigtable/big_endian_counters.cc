@@ -0,0 +1,102 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/big_endian_counters.h"
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+std::size_t constexpr kCounterSize = sizeof(std::int64_t);
+
+template <typename C>
+Status InvalidCounter(C const& cell) {
+  auto const& v = cell.value();
+  auto const& k = cell.row_key();
+  auto const& f = cell.family_name();
+  auto const& q = cell.column_qualifier();
+  return Status(StatusCode::kInvalidArgument,
+                "counter value for row=" + std::string(k.data(), k.size()) +
+                    ", column=" + std::string(f.data(), f.size()) + ":" +
+                    std::string(q.data(), q.size()) + " has " +
+                    std::to_string(v.size()) + " bytes; expected " +
+                    std::to_string(kCounterSize));
+}
+
+/// Return an error for the first cell that does not contain a counter.
+template <typename Cells>
+Status Validate(Cells const& cells) {
+  for (auto const& c : cells) {
+    if (c.value().size() != kCounterSize) return InvalidCounter(c);
+  }
+  return Status{};
+}
+
+// Compilers recognize this pattern, and generate a single (byte-swapping) load
+// for it.
+std::int64_t LoadBigEndian(char const* p) {
+  auto const* b = reinterpret_cast<unsigned char const*>(p);
+  auto const v =
+      (std::uint64_t{b[0]} << 56) | (std::uint64_t{b[1]} << 48) |
+      (std::uint64_t{b[2]} << 40) | (std::uint64_t{b[3]} << 32) |
+      (std::uint64_t{b[4]} << 24) | (std::uint64_t{b[5]} << 16) |
+      (std::uint64_t{b[6]} << 8) | std::uint64_t{b[7]};
+  return static_cast<std::int64_t>(v);
+}
+
+/// Decode the (validated) @p cells into @p out, return the end of the output.
+template <typename Cells>
+std::int64_t* Decode(Cells const& cells, std::int64_t* out) {
+  for (auto const& c : cells) *out++ = LoadBigEndian(c.value().data());
+  return out;
+}
+
+}  // namespace
+
+Status AppendBigEndianCounters(std::vector<Cell> const& cells,
+                               std::vector<std::int64_t>* out) {
+  auto status = Validate(cells);
+  if (!status.ok()) return status;
+  auto const offset = out->size();
+  out->resize(offset + cells.size());
+  Decode(cells, out->data() + offset);
+  return status;
+}
+
+Status AppendBigEndianCounters(Row const& row, std::vector<std::int64_t>* out) {
+  return AppendBigEndianCounters(row.cells(), out);
+}
+
+Status AppendBigEndianCounters(RowBatch const& batch,
+                               std::vector<std::int64_t>* out) {
+  std::size_t count = 0;
+  for (auto const& row : batch.rows()) {
+    auto status = Validate(row.cells());
+    if (!status.ok()) return status;
+    count += row.cells().size();
+  }
+  auto const offset = out->size();
+  out->resize(offset + count);
+  auto* p = out->data() + offset;
+  for (auto const& row : batch.rows()) p = Decode(row.cells(), p);
+  return Status{};
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,71 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BIG_ENDIAN_COUNTERS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BIG_ENDIAN_COUNTERS_H
+
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_batch.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status.h"
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+//@{
+/**
+ * @name Decode the 64-bit counters in many cells at once.
+ *
+ * Counters incremented with `ReadModifyWriteRule::IncrementAmount()` are
+ * stored as 8-byte big-endian integers. `Cell::decode_big_endian_integer()`
+ * decodes one cell, and returns a `StatusOr` for each one. Applications that
+ * scan and aggregate many counters can use these functions instead. They
+ * validate all the cells in a single pass, and then decode their values into
+ * contiguous storage.
+ *
+ * The decoded values are appended to @p out, in the same order as the cells.
+ * If any cell value is not exactly 8 bytes long the functions return a
+ * `kInvalidArgument` error and @p out is not modified.
+ *
+ * @par Example
+ * @code
+ * auto reader = table.ReadRowBatches(cbt::RowSet(), filter);
+ * std::vector<std::int64_t> counters;
+ * for (;;) {
+ *   auto batch = reader.Next();
+ *   if (!batch) throw std::move(batch).status();
+ *   if (batch->empty()) break;
+ *   auto status = cbt::AppendBigEndianCounters(*batch, &counters);
+ *   if (!status.ok()) throw std::move(status);
+ * }
+ * auto total = std::accumulate(counters.begin(), counters.end(),
+ *                              std::int64_t{0});
+ * @endcode
+ */
+Status AppendBigEndianCounters(std::vector<Cell> const& cells,
+                               std::vector<std::int64_t>* out);
+Status AppendBigEndianCounters(Row const& row, std::vector<std::int64_t>* out);
+Status AppendBigEndianCounters(RowBatch const& batch,
+                               std::vector<std::int64_t>* out);
+//@}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BIG_ENDIAN_COUNTERS_H
@@ -0,0 +1,111 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/big_endian_counters.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::internal::EncodeBigEndian;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+Cell MakeCell(std::string const& row_key, std::string value) {
+  return Cell(row_key, "fam", "col", 0, std::move(value));
+}
+
+TEST(BigEndianCountersTest, Row) {
+  auto const min = std::numeric_limits<std::int64_t>::min();
+  Row row("r1", {MakeCell("r1", EncodeBigEndian(std::int64_t{42})),
+                 MakeCell("r1", EncodeBigEndian(std::int64_t{-7})),
+                 MakeCell("r1", EncodeBigEndian(min))});
+  std::vector<std::int64_t> out = {1};
+  ASSERT_STATUS_OK(AppendBigEndianCounters(row, &out));
+  EXPECT_THAT(out, ElementsAre(1, 42, -7, min));
+}
+
+TEST(BigEndianCountersTest, InvalidCellLeavesOutputUnchanged) {
+  Row row("r1", {MakeCell("r1", EncodeBigEndian(std::int64_t{42})),
+                 MakeCell("r1", "short")});
+  std::vector<std::int64_t> out = {1};
+  auto status = AppendBigEndianCounters(row, &out);
+  EXPECT_THAT(status, StatusIs(StatusCode::kInvalidArgument,
+                               HasSubstr("row=r1, column=fam:col has 5")));
+  EXPECT_THAT(out, ElementsAre(1));
+}
+
+/// Create a batch where the row `row_keys[i]` has the cells `values[i]`.
+RowBatch MakeBatch(std::vector<std::string> const& row_keys,
+                   std::vector<std::vector<std::string>> const& values) {
+  auto storage = std::make_shared<internal::RowBatchStorage>();
+  for (std::size_t i = 0; i != row_keys.size(); ++i) {
+    for (auto const& v : values[i]) {
+      storage->values.push_back(absl::make_unique<std::string>(v));
+      storage->cells.emplace_back(row_keys[i], "fam", "col", 0,
+                                  *storage->values.back(),
+                                  std::vector<absl::string_view>{});
+    }
+  }
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i != row_keys.size(); ++i) {
+    storage->rows.emplace_back(
+        row_keys[i], absl::MakeConstSpan(storage->cells.data() + offset,
+                                         values[i].size()));
+    offset += values[i].size();
+  }
+  return RowBatch(std::move(storage));
+}
+
+TEST(BigEndianCountersTest, RowBatch) {
+  std::vector<std::string> const keys = {"r1", "r2"};
+  auto batch = MakeBatch(keys, {{EncodeBigEndian(std::int64_t{1}),
+                                 EncodeBigEndian(std::int64_t{2})},
+                                {EncodeBigEndian(std::int64_t{3})}});
+  std::vector<std::int64_t> out;
+  ASSERT_STATUS_OK(AppendBigEndianCounters(batch, &out));
+  EXPECT_THAT(out, ElementsAre(1, 2, 3));
+
+  ASSERT_STATUS_OK(AppendBigEndianCounters(RowBatch{}, &out));
+  EXPECT_THAT(out, ElementsAre(1, 2, 3));
+}
+
+TEST(BigEndianCountersTest, RowBatchInvalidCell) {
+  std::vector<std::string> const keys = {"r1", "r2"};
+  auto batch =
+      MakeBatch(keys, {{EncodeBigEndian(std::int64_t{1})},
+                       {EncodeBigEndian(std::int32_t{2})}});
+  std::vector<std::int64_t> out;
+  auto status = AppendBigEndianCounters(batch, &out);
+  EXPECT_THAT(status, StatusIs(StatusCode::kInvalidArgument,
+                               HasSubstr("row=r2, column=fam:col has 4")));
+  EXPECT_TRUE(out.empty());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
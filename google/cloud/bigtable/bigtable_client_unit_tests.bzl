@@ -20,7 +20,9 @@ bigtable_client_unit_tests = [
     "admin_client_test.cc",
     "app_profile_config_test.cc",
     "async_read_stream_test.cc",
+    "async_row_batch_reader_test.cc",
     "async_row_reader_test.cc",
+    "big_endian_counters_test.cc",
     "bigtable_version_test.cc",
     "cell_test.cc",
     "client_options_test.cc",
@@ -33,12 +35,15 @@ bigtable_client_unit_tests = [
     "iam_binding_test.cc",
     "iam_policy_test.cc",
     "idempotent_mutation_policy_test.cc",
+    "increment_combiner_test.cc",
     "instance_admin_client_test.cc",
     "instance_admin_test.cc",
     "instance_config_test.cc",
     "instance_update_config_test.cc",
+    "internal/adaptive_batch_sizer_test.cc",
     "internal/async_bulk_apply_test.cc",
     "internal/async_longrunning_op_test.cc",
+    "internal/async_parallel_row_reader_test.cc",
     "internal/async_poll_op_test.cc",
     "internal/async_retry_multi_page_test.cc",
     "internal/async_retry_unary_rpc_and_poll_test.cc",
@@ -46,21 +51,33 @@ bigtable_client_unit_tests = [
     "internal/bulk_mutator_test.cc",
     "internal/common_client_test.cc",
     "internal/google_bytes_traits_test.cc",
+    "internal/key_range_router_test.cc",
     "internal/logging_admin_client_test.cc",
     "internal/logging_data_client_test.cc",
     "internal/logging_instance_admin_client_test.cc",
+    "internal/metrics_data_client_test.cc",
+    "internal/mutation_admission_budget_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/read_row_hedger_test.cc",
+    "internal/read_rows_flow_control_test.cc",
+    "internal/row_cache_test.cc",
+    "internal/row_set_cursor_test.cc",
+    "internal/sample_rows_cache_test.cc",
     "metadata_update_policy_test.cc",
     "mutation_batcher_test.cc",
     "mutations_test.cc",
     "polling_policy_test.cc",
     "read_modify_write_rule_test.cc",
+    "read_row_batcher_test.cc",
+    "row_batch_reader_test.cc",
+    "row_mutation_pipeline_test.cc",
     "row_range_test.cc",
     "row_reader_test.cc",
     "row_set_test.cc",
     "row_test.cc",
     "rpc_backoff_policy_test.cc",
     "rpc_retry_policy_test.cc",
+    "sharded_mutation_batcher_test.cc",
     "table_admin_test.cc",
     "table_apply_test.cc",
     "table_bulk_apply_test.cc",
@@ -23,12 +23,14 @@
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/algorithm.h"
 #include "google/cloud/options.h"
+#include "google/cloud/rpc_metrics.h"
 #include "google/cloud/status.h"
 #include "google/cloud/tracing_options.h"
 #include "absl/strings/str_split.h"
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/resource_quota.h>
 #include <chrono>
+#include <map>
 #include <set>
 #include <string>
 
@@ -367,6 +369,17 @@ class ClientOptions {
     return opts_.get<GrpcTracingOptionsOption>();
   }
 
+  /// Return the RPC metrics collector, if any, set via `RpcMetricsOption`.
+  std::shared_ptr<RpcMetrics> rpc_metrics() const {
+    return opts_.has<RpcMetricsOption>() ? opts_.get<RpcMetricsOption>()
+                                         : nullptr;
+  }
+
+  /// Return the request size thresholds to compress RPCs, keyed by method.
+  std::map<std::string, std::size_t> const& compression() const {
+    return opts_.get<GrpcCompressionOption>();
+  }
+
   /**
    * Maximum connection refresh period, as set via `set_max_conn_refresh_period`
    */
@@ -417,6 +430,47 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Connect all the channels when a data client is created.
+   *
+   * @see `ChannelPrimingOption`
+   */
+  ClientOptions& set_channel_priming(bool enabled) {
+    opts_.set<ChannelPrimingOption>(enabled);
+    return *this;
+  }
+
+  bool channel_priming() const { return opts_.get<ChannelPrimingOption>(); }
+
+  /**
+   * Prime the channels with a `SampleRowKeys` request on @p table_id.
+   *
+   * @see `ChannelPrimingTableOption`
+   */
+  ClientOptions& set_channel_priming_table(std::string table_id) {
+    opts_.set<ChannelPrimingTableOption>(std::move(table_id));
+    return *this;
+  }
+
+  std::string const& channel_priming_table() const {
+    return opts_.get<ChannelPrimingTableOption>();
+  }
+
+  /**
+   * Wait up to @p timeout for the channels to be primed.
+   *
+   * @see `ChannelPrimingTimeoutOption`
+   */
+  ClientOptions& set_channel_priming_timeout(
+      std::chrono::milliseconds timeout) {
+    opts_.set<ChannelPrimingTimeoutOption>(timeout);
+    return *this;
+  }
+
+  std::chrono::milliseconds channel_priming_timeout() const {
+    return opts_.get<ChannelPrimingTimeoutOption>();
+  }
+
   /**
    * Set the number of background threads.
    *
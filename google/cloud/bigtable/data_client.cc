@@ -15,8 +15,12 @@
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/internal/common_client.h"
 #include "google/cloud/bigtable/internal/logging_data_client.h"
+#include "google/cloud/bigtable/internal/metrics_data_client.h"
+#include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/internal/grpc_compression.h"
 #include "google/cloud/internal/log_wrapper.h"
 #include "google/cloud/log.h"
+#include "absl/memory/memory.h"
 
 namespace btproto = google::bigtable::v2;
 
@@ -57,6 +61,7 @@ class DefaultDataClient : public DataClient {
                     ClientOptions options)
       : project_(std::move(project)),
         instance_(std::move(instance)),
+        compression_(options.compression()),
         impl_(std::move(options)) {}
 
   DefaultDataClient(std::string project, std::string instance)
@@ -66,12 +71,18 @@ class DefaultDataClient : public DataClient {
   std::string const& project_id() const override;
   std::string const& instance_id() const override;
 
+  /// Connect, and optionally prime, all the channels in the pool.
+  future<Status> PrimeChannels(std::string const& table_id,
+                               std::chrono::system_clock::time_point deadline);
+
   std::shared_ptr<grpc::Channel> Channel() override { return impl_.Channel(); }
   void reset() override { impl_.reset(); }
 
   grpc::Status MutateRow(grpc::ClientContext* context,
                          btproto::MutateRowRequest const& request,
                          btproto::MutateRowResponse* response) override {
+    google::cloud::internal::ConfigureCompression(
+        *context, compression_, "Bigtable.MutateRow", request);
     return impl_.Stub()->MutateRow(context, request, response);
   }
 
@@ -80,6 +91,8 @@ class DefaultDataClient : public DataClient {
   AsyncMutateRow(grpc::ClientContext* context,
                  btproto::MutateRowRequest const& request,
                  grpc::CompletionQueue* cq) override {
+    google::cloud::internal::ConfigureCompression(
+        *context, compression_, "Bigtable.MutateRow", request);
     return impl_.Stub()->AsyncMutateRow(context, request, cq);
   }
 
@@ -163,6 +176,8 @@ class DefaultDataClient : public DataClient {
   std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
   MutateRows(grpc::ClientContext* context,
              btproto::MutateRowsRequest const& request) override {
+    google::cloud::internal::ConfigureCompression(
+        *context, compression_, "Bigtable.MutateRows", request);
     return impl_.Stub()->MutateRows(context, request);
   }
 
@@ -171,6 +186,8 @@ class DefaultDataClient : public DataClient {
   AsyncMutateRows(::grpc::ClientContext* context,
                   ::google::bigtable::v2::MutateRowsRequest const& request,
                   ::grpc::CompletionQueue* cq, void* tag) override {
+    google::cloud::internal::ConfigureCompression(
+        *context, compression_, "Bigtable.MutateRows", request);
     return impl_.Stub()->AsyncMutateRows(context, request, cq, tag);
   }
 
@@ -180,6 +197,8 @@ class DefaultDataClient : public DataClient {
       ::grpc::ClientContext* context,
       ::google::bigtable::v2::MutateRowsRequest const& request,
       ::grpc::CompletionQueue* cq) override {
+    google::cloud::internal::ConfigureCompression(
+        *context, compression_, "Bigtable.MutateRows", request);
     return impl_.Stub()->PrepareAsyncMutateRows(context, request, cq);
   }
 
@@ -191,6 +210,7 @@ class DefaultDataClient : public DataClient {
 
   std::string project_;
   std::string instance_;
+  std::map<std::string, std::size_t> compression_;
   Impl impl_;
 };
 
@@ -198,16 +218,72 @@ std::string const& DefaultDataClient::project_id() const { return project_; }
 
 std::string const& DefaultDataClient::instance_id() const { return instance_; }
 
+future<Status> DefaultDataClient::PrimeChannels(
+    std::string const& table_id,
+    std::chrono::system_clock::time_point deadline) {
+  if (table_id.empty()) return impl_.PrimeChannels(deadline, {});
+  auto table_name =
+      "projects/" + project_ + "/instances/" + instance_ + "/tables/" + table_id;
+  return impl_.PrimeChannels(
+      deadline, [table_name, deadline](CompletionQueue& cq,
+                                       Impl::StubPtr const& stub) {
+        btproto::SampleRowKeysRequest request;
+        request.set_table_name(table_name);
+        auto context = absl::make_unique<grpc::ClientContext>();
+        context->set_deadline(deadline);
+        MetadataUpdatePolicy(table_name, MetadataParamTypes::TABLE_NAME)
+            .Setup(*context);
+        auto done = std::make_shared<promise<Status>>();
+        auto f = done->get_future();
+        cq.MakeStreamingReadRpc(
+            [stub](grpc::ClientContext* context,
+                   btproto::SampleRowKeysRequest const& request,
+                   grpc::CompletionQueue* cq) {
+              return stub->PrepareAsyncSampleRowKeys(context, request, cq);
+            },
+            request, std::move(context),
+            [](btproto::SampleRowKeysResponse) {
+              return make_ready_future(true);
+            },
+            [done](Status status) { done->set_value(std::move(status)); });
+        return f;
+      });
+}
+
 std::shared_ptr<DataClient> CreateDefaultDataClient(
     std::string project_id, std::string instance_id,
     ClientOptions options) {  // NOLINT(performance-unnecessary-value-param)
-  std::shared_ptr<DataClient> client = std::make_shared<DefaultDataClient>(
+  auto impl = std::make_shared<DefaultDataClient>(
       std::move(project_id), std::move(instance_id), options);
+  if (options.channel_priming()) {
+    auto const timeout = options.channel_priming_timeout();
+    auto const deadline =
+        std::chrono::system_clock::now() +
+        (timeout.count() > 0
+             ? timeout
+             : std::chrono::milliseconds(internal::kConnectionReadyTimeout));
+    auto primed =
+        impl->PrimeChannels(options.channel_priming_table(), deadline)
+            .then([](future<Status> f) {
+              auto status = f.get();
+              if (!status.ok()) {
+                GCP_LOG(WARNING) << "Failed to prime channels: " << status;
+              }
+            });
+    if (timeout.count() > 0) primed.wait_for(timeout);
+  }
+  std::shared_ptr<DataClient> client = std::move(impl);
   if (options.tracing_enabled("rpc")) {
     GCP_LOG(INFO) << "Enabled logging for gRPC calls";
     client = std::make_shared<internal::LoggingDataClient>(
         std::move(client), options.tracing_options());
   }
+  // The metrics decorator is the outermost layer, so the resource accounting
+  // for each call includes the work done by all the other decorators.
+  if (auto metrics = options.rpc_metrics()) {
+    client = std::make_shared<internal::MetricsDataClient>(std::move(client),
+                                                           std::move(metrics));
+  }
   return client;
 }
 
@@ -176,7 +176,16 @@ class DataClient {
   //@}
 };
 
-/// Create the default implementation of ClientInterface.
+/**
+ * Create the default implementation of ClientInterface.
+ *
+ * If `options.channel_priming()` is set, all the channels in the pool start
+ * connecting immediately, and, if `options.channel_priming_table()` is not
+ * empty, each channel sends a `SampleRowKeys` request for that table. With a
+ * positive `options.channel_priming_timeout()` this function blocks until the
+ * channels are primed, or the timeout expires. Priming errors are logged, but
+ * they do not prevent the creation of the client.
+ */
 std::shared_ptr<DataClient> CreateDefaultDataClient(std::string project_id,
                                                     std::string instance_id,
                                                     ClientOptions options);
@@ -19,6 +19,7 @@
 #include "absl/meta/type_traits.h"
 #include <google/bigtable/v2/data.pb.h>
 #include <chrono>
+#include <initializer_list>
 #include <string>
 
 namespace google {
@@ -548,6 +549,10 @@ class Filter {
    * The filter returned by this function acts like a pipeline.  The output
    * row from each stage is passed on as input for the next stage.
    *
+   * The arguments passed as rvalues are moved into the result, so nested
+   * filter expressions, such as `Chain(Interleave(a, b), c)`, are built without
+   * copying the inner filters.
+   *
    * @tparam FilterTypes the type of the filter arguments.  They must all be
    *    convertible to Filter.
    * @param stages the filter stages.  The filter must contain at least two
@@ -567,10 +572,11 @@ class Filter {
         "The arguments passed to Chain(...) must be convertible to Filter");
     Filter tmp;
     auto& chain = *tmp.filter_.mutable_chain();
-    std::initializer_list<Filter> list{std::forward<FilterTypes>(stages)...};
-    for (Filter const& f : list) {
-      *chain.add_filters() = f.as_proto();
-    }
+    chain.mutable_filters()->Reserve(static_cast<int>(sizeof...(stages)));
+    // Expand the arguments in order, moving (not copying) any rvalues.
+    (void)std::initializer_list<int>{
+        (Assign(*chain.add_filters(), std::forward<FilterTypes>(stages)),
+         0)...};
     return tmp;
   }
 
@@ -580,6 +586,9 @@ class Filter {
    * The filter returned by this function acts like a pipeline.  The output
    * row from each stage is passed on as input for the next stage.
    *
+   * Use `std::make_move_iterator()` to move the filters instead of copying
+   * them.
+   *
    * @tparam Iterator an InputIterator whose `value_type` is `Filter`.
    * @param begin the start of the range.
    * @param end the end of the range.
@@ -594,7 +603,7 @@ class Filter {
     Filter tmp;
     auto& chain = *tmp.filter_.mutable_chain();
     for (auto it = begin; it != end; ++it) {
-      *chain.add_filters() = it->as_proto();
+      Assign(*chain.add_filters(), *it);
     }
     return tmp;
   }
@@ -615,6 +624,9 @@ class Filter {
    * where some of the Si(c_j) values may be empty if the filter discards the
    * cell altogether.
    *
+   * As with `Chain()`, the arguments passed as rvalues are moved into the
+   * result.
+   *
    * @tparam FilterTypes the type of the filter arguments.  They must all be
    *    convertible for Filter.
    * @param streams the filters to interleave. The filter must contain at least
@@ -632,10 +644,11 @@ class Filter {
         " to Filter");
     Filter tmp;
     auto& interleave = *tmp.filter_.mutable_interleave();
-    std::initializer_list<Filter> list{std::forward<FilterTypes>(streams)...};
-    for (Filter const& f : list) {
-      *interleave.add_filters() = f.as_proto();
-    }
+    interleave.mutable_filters()->Reserve(static_cast<int>(sizeof...(streams)));
+    // Expand the arguments in order, moving (not copying) any rvalues.
+    (void)std::initializer_list<int>{
+        (Assign(*interleave.add_filters(), std::forward<FilterTypes>(streams)),
+         0)...};
     return tmp;
   }
 
@@ -643,7 +656,8 @@ class Filter {
    * Return a filter that interleaves the results of a range of filters.
    *
    * Similar to #Interleave(), except this function accepts a pair of
-   * Iterators.
+   * Iterators. Use `std::make_move_iterator()` to move the filters instead of
+   * copying them.
    *
    * @param begin the begin iterator of the range.
    * @param end the end iterator of the range.
@@ -658,7 +672,7 @@ class Filter {
     Filter tmp;
     auto& interleave = *tmp.filter_.mutable_interleave();
     for (auto it = begin; it != end; ++it) {
-      *interleave.add_filters() = it->as_proto();
+      Assign(*interleave.add_filters(), *it);
     }
     return tmp;
   }
@@ -692,6 +706,16 @@ class Filter {
   /// An empty filter, discards all data.
   Filter() = default;
 
+  //@{
+  /// @name Set @p dest to the value of a nested filter, moving rvalues.
+  static void Assign(google::bigtable::v2::RowFilter& dest, Filter&& f) {
+    dest.Swap(&f.filter_);
+  }
+  static void Assign(google::bigtable::v2::RowFilter& dest, Filter const& f) {
+    dest = f.filter_;
+  }
+  //@}
+
   google::bigtable::v2::RowFilter filter_;
 };
 
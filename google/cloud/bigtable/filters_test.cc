@@ -16,6 +16,7 @@
 #include "google/cloud/testing_util/chrono_literals.h"
 #include "google/cloud/testing_util/is_proto_equal.h"
 #include <gmock/gmock.h>
+#include <iterator>
 
 namespace google {
 namespace cloud {
@@ -254,6 +255,44 @@ TEST(FiltersTest, ChainOneArg) {
   EXPECT_EQ(2, chain.filters(0).cells_per_column_limit_filter());
 }
 
+/// @test Verify that `bigtable::Filter::Chain` moves its rvalue arguments.
+TEST(FiltersTest, ChainMovesArguments) {
+  using F = Filter;
+  auto family = F::FamilyRegex("fam");
+  auto column = F::ColumnRegex("col");
+  auto nested = F::Interleave(F::Latest(1), F::CellsRowOffset(2));
+  // Mix lvalues and rvalues, the lvalues must remain unchanged.
+  auto filter = F::Chain(family, std::move(column), std::move(nested));
+  EXPECT_EQ("fam", family.as_proto().family_name_regex_filter());
+
+  auto const& proto = filter.as_proto();
+  ASSERT_TRUE(proto.has_chain());
+  auto const& chain = proto.chain();
+  ASSERT_EQ(3, chain.filters_size());
+  EXPECT_EQ("fam", chain.filters(0).family_name_regex_filter());
+  EXPECT_EQ("col", chain.filters(1).column_qualifier_regex_filter());
+  ASSERT_TRUE(chain.filters(2).has_interleave());
+  auto const& interleave = chain.filters(2).interleave();
+  ASSERT_EQ(2, interleave.filters_size());
+  EXPECT_EQ(1, interleave.filters(0).cells_per_column_limit_filter());
+  EXPECT_EQ(2, interleave.filters(1).cells_per_row_offset_filter());
+}
+
+/// @test Verify that `bigtable::Filter::ChainFromRange` works with moves.
+TEST(FiltersTest, ChainFromRangeMoveIterator) {
+  using F = Filter;
+  std::vector<F> filter_collection{F::FamilyRegex("fam"), F::Latest(1)};
+  auto filter =
+      F::ChainFromRange(std::make_move_iterator(filter_collection.begin()),
+                        std::make_move_iterator(filter_collection.end()));
+  auto const& proto = filter.as_proto();
+  ASSERT_TRUE(proto.has_chain());
+  auto const& chain = proto.chain();
+  ASSERT_EQ(2, chain.filters_size());
+  EXPECT_EQ("fam", chain.filters(0).family_name_regex_filter());
+  EXPECT_EQ(1, chain.filters(1).cells_per_column_limit_filter());
+}
+
 /// @test Verify that `bigtable::Filter::ChainFromRange` works as expected.
 TEST(FiltersTest, ChainFromRangeMany) {
   using F = Filter;
@@ -19,7 +19,9 @@
 google_cloud_cpp_bigtable_hdrs = [
     "admin_client.h",
     "app_profile_config.h",
+    "async_row_batch_reader.h",
     "async_row_reader.h",
+    "big_endian_counters.h",
     "cell.h",
     "client_options.h",
     "cluster_config.h",
@@ -32,13 +34,16 @@ google_cloud_cpp_bigtable_hdrs = [
     "iam_binding.h",
     "iam_policy.h",
     "idempotent_mutation_policy.h",
+    "increment_combiner.h",
     "instance_admin.h",
     "instance_admin_client.h",
     "instance_config.h",
     "instance_list_responses.h",
     "instance_update_config.h",
+    "internal/adaptive_batch_sizer.h",
     "internal/async_bulk_apply.h",
     "internal/async_longrunning_op.h",
+    "internal/async_parallel_row_reader.h",
     "internal/async_poll_op.h",
     "internal/async_retry_multi_page.h",
     "internal/async_retry_op.h",
@@ -49,30 +54,49 @@ google_cloud_cpp_bigtable_hdrs = [
     "internal/common_client.h",
     "internal/defaults.h",
     "internal/google_bytes_traits.h",
+    "internal/key_range_router.h",
     "internal/logging_admin_client.h",
     "internal/logging_data_client.h",
     "internal/logging_instance_admin_client.h",
+    "internal/metrics_data_client.h",
+    "internal/mutation_admission_budget.h",
     "internal/prefix_range_end.h",
+    "internal/read_row_hedger.h",
+    "internal/read_rows_flow_control.h",
+    "internal/readrowsbatchparser.h",
     "internal/readrowsparser.h",
+    "internal/row_cache.h",
+    "internal/row_set_cursor.h",
     "internal/rowreaderiterator.h",
     "internal/rpc_policy_parameters.h",
     "internal/rpc_policy_parameters.inc",
+    "internal/sample_rows_cache.h",
     "internal/unary_client_utils.h",
     "metadata_update_policy.h",
     "mutation_batcher.h",
     "mutations.h",
     "options.h",
+    "parallel_read_rows_options.h",
     "polling_policy.h",
     "read_modify_write_rule.h",
+    "read_row_batcher.h",
+    "read_row_hedging_options.h",
+    "read_rows_flow_control_options.h",
     "resource_names.h",
     "row.h",
+    "row_batch.h",
+    "row_batch_reader.h",
+    "row_cache_options.h",
     "row_key.h",
     "row_key_sample.h",
+    "row_mutation_pipeline.h",
     "row_range.h",
     "row_reader.h",
     "row_set.h",
     "rpc_backoff_policy.h",
     "rpc_retry_policy.h",
+    "sample_rows_cache_options.h",
+    "sharded_mutation_batcher.h",
     "table.h",
     "table_admin.h",
     "table_config.h",
@@ -83,6 +107,7 @@ google_cloud_cpp_bigtable_hdrs = [
 google_cloud_cpp_bigtable_srcs = [
     "admin_client.cc",
     "app_profile_config.cc",
+    "big_endian_counters.cc",
     "client_options.cc",
     "cluster_config.cc",
     "data_client.cc",
@@ -90,32 +115,49 @@ google_cloud_cpp_bigtable_srcs = [
     "iam_binding.cc",
     "iam_policy.cc",
     "idempotent_mutation_policy.cc",
+    "increment_combiner.cc",
     "instance_admin.cc",
     "instance_admin_client.cc",
     "instance_config.cc",
     "instance_update_config.cc",
+    "internal/adaptive_batch_sizer.cc",
     "internal/async_bulk_apply.cc",
+    "internal/async_parallel_row_reader.cc",
     "internal/async_row_sampler.cc",
     "internal/bulk_mutator.cc",
     "internal/common_client.cc",
     "internal/defaults.cc",
     "internal/google_bytes_traits.cc",
+    "internal/key_range_router.cc",
     "internal/logging_admin_client.cc",
     "internal/logging_data_client.cc",
     "internal/logging_instance_admin_client.cc",
+    "internal/metrics_data_client.cc",
+    "internal/mutation_admission_budget.cc",
     "internal/prefix_range_end.cc",
+    "internal/read_row_hedger.cc",
+    "internal/read_rows_flow_control.cc",
+    "internal/readrowsbatchparser.cc",
     "internal/readrowsparser.cc",
+    "internal/row_cache.cc",
+    "internal/row_set_cursor.cc",
     "internal/rowreaderiterator.cc",
+    "internal/sample_rows_cache.cc",
     "metadata_update_policy.cc",
     "mutation_batcher.cc",
     "mutations.cc",
     "polling_policy.cc",
+    "read_row_batcher.cc",
     "resource_names.cc",
+    "row_batch.cc",
+    "row_batch_reader.cc",
+    "row_mutation_pipeline.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
     "rpc_backoff_policy.cc",
     "rpc_retry_policy.cc",
+    "sharded_mutation_batcher.cc",
     "table.cc",
     "table_admin.cc",
     "table_config.cc",
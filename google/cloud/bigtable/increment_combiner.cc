@@ -0,0 +1,149 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/increment_combiner.h"
+#include "google/cloud/bigtable/read_modify_write_rule.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+auto constexpr kDefaultMaxPendingIncrements = 1000;
+auto constexpr kDefaultMaxDelayMicroseconds = 1000;
+
+IncrementCombiner::Options::Options()
+    : max_pending_increments(kDefaultMaxPendingIncrements),
+      max_delay(kDefaultMaxDelayMicroseconds) {}
+
+IncrementCombiner::Options& IncrementCombiner::Options::SetMaxPendingIncrements(
+    std::size_t max_pending_increments_arg) {
+  max_pending_increments =
+      (std::max)(std::size_t{1}, max_pending_increments_arg);
+  return *this;
+}
+
+future<StatusOr<std::int64_t>> IncrementCombiner::AsyncIncrementAmount(
+    CompletionQueue& cq, std::string row_key, std::string family_name,
+    std::string column_qualifier, std::int64_t amount) {
+  promise<Result> p;
+  auto f = p.get_future();
+
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const new_window = !current_;
+  if (new_window) current_ = std::make_shared<Batch>();
+  std::weak_ptr<Batch> window = current_;
+  auto& counter =
+      current_->rows[std::move(row_key)][std::make_pair(
+          std::move(family_name), std::move(column_qualifier))];
+  counter.total += amount;
+  counter.increments.emplace_back(amount, std::move(p));
+  std::shared_ptr<Batch> full;
+  if (++current_->pending >= options_.max_pending_increments) {
+    full = std::move(current_);
+    current_.reset();
+    full->sent = true;
+  }
+  lk.unlock();
+
+  if (full) {
+    Send(full);
+  } else if (new_window) {
+    // The batch may be sent, and this object deleted, before the timer
+    // fires. Only touch `this` while the batch is waiting in `current_`.
+    cq.MakeRelativeTimer(options_.max_delay)
+        .then([this, window](
+                  future<StatusOr<std::chrono::system_clock::time_point>>) {
+          auto batch = window.lock();
+          if (!batch || batch->sent) return;
+          OnTimer(batch);
+        });
+  }
+  return f;
+}
+
+future<StatusOr<Row>> IncrementCombiner::AsyncReadModifyWriteRowImpl(
+    Table& table, google::bigtable::v2::ReadModifyWriteRowRequest request) {
+  return table.AsyncReadModifyWriteRowImpl(std::move(request));
+}
+
+void IncrementCombiner::OnTimer(std::shared_ptr<Batch> const& batch) {
+  std::unique_lock<std::mutex> lk(mu_);
+  // The batch may have filled up, and been sent, after the caller checked.
+  if (current_ != batch) return;
+  current_.reset();
+  batch->sent = true;
+  lk.unlock();
+  Send(batch);
+}
+
+void IncrementCombiner::Send(std::shared_ptr<Batch> const& batch) {
+  for (auto& kv : batch->rows) {
+    google::bigtable::v2::ReadModifyWriteRowRequest request;
+    request.set_row_key(kv.first);
+    for (auto const& c : kv.second) {
+      *request.add_rules() = ReadModifyWriteRule::IncrementAmount(
+                                 c.first.first, c.first.second, c.second.total)
+                                 .as_proto();
+    }
+    // The batch is not modified once it is sent, the counters for this row
+    // live as long as `batch`.
+    auto* counters = &kv.second;
+    AsyncReadModifyWriteRowImpl(table_, std::move(request))
+        .then([batch, counters](future<StatusOr<Row>> f) {
+          OnReadModifyWriteDone(*counters, f.get());
+        });
+  }
+}
+
+void IncrementCombiner::OnReadModifyWriteDone(RowCounters& counters,
+                                              StatusOr<Row> row) {
+  if (!row) {
+    for (auto& kv : counters) {
+      for (auto& i : kv.second.increments) i.second.set_value(row.status());
+    }
+    return;
+  }
+  for (auto const& cell : row->cells()) {
+    auto c = counters.find(
+        std::make_pair(cell.family_name(), cell.column_qualifier()));
+    if (c == counters.end()) continue;
+    auto value = cell.decode_big_endian_integer<std::int64_t>();
+    auto& counter = c->second;
+    if (!value) {
+      for (auto& i : counter.increments) i.second.set_value(value.status());
+    } else {
+      // Report the values as if the increments were applied one at a time.
+      auto current = *value - counter.total;
+      for (auto& i : counter.increments) {
+        current += i.first;
+        i.second.set_value(current);
+      }
+    }
+    counters.erase(c);
+  }
+  for (auto& kv : counters) {
+    for (auto& i : kv.second.increments) {
+      i.second.set_value(Status(StatusCode::kInternal,
+                                "the ReadModifyWriteRow response is missing "
+                                "the incremented column"));
+    }
+  }
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
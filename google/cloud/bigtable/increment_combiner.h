@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INCREMENT_COMBINER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INCREMENT_COMBINER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Combine concurrent counter increments into fewer `ReadModifyWriteRow` calls.
+ *
+ * Applications using `Table::AsyncReadModifyWriteRow()` to increment hot
+ * counters send one RPC per increment, and all these RPCs contend for the same
+ * row on the server. This class merges the increments for the same row
+ * received within a short window (see `Options::SetMaxDelay()`): the amounts
+ * for each column are added, and a single `ReadModifyWriteRow` request is sent
+ * for each row.
+ *
+ * Each caller receives the value of the counter right after its own increment,
+ * as if the increments in the window were applied one at a time, in the order
+ * they were received. The value is computed from the result of the combined
+ * request.
+ *
+ * Applications must provide a `CompletionQueue` to run the timers for each
+ * window. The `ReadModifyWriteRow` requests run in the background threads of
+ * the `Table`.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ */
+class IncrementCombiner {
+ public:
+  /// Configuration for `IncrementCombiner`.
+  struct Options {
+    Options();
+
+    /// Send the pending requests once there are this many increments.
+    Options& SetMaxPendingIncrements(std::size_t max_pending_increments_arg);
+
+    /// Wait at most this long for more increments before sending the requests.
+    Options& SetMaxDelay(std::chrono::microseconds max_delay_arg) {
+      max_delay = max_delay_arg;
+      return *this;
+    }
+
+    std::size_t max_pending_increments;
+    std::chrono::microseconds max_delay;
+  };
+
+  explicit IncrementCombiner(Table table, Options options = Options())
+      : table_(std::move(table)), options_(std::move(options)) {}
+
+  virtual ~IncrementCombiner() = default;
+
+  /**
+   * Asynchronously increment a counter.
+   *
+   * @param cq the completion queue that will run the timer for the current
+   *     window, the application must ensure that one or more threads are
+   *     blocked on `cq.Run()`.
+   * @param row_key the row containing the counter.
+   * @param family_name the column family of the counter.
+   * @param column_qualifier the column of the counter.
+   * @param amount the value added to the counter.
+   * @returns the value of the counter after this increment. If the request
+   *     fails all the increments in the same request fail with the same error.
+   */
+  future<StatusOr<std::int64_t>> AsyncIncrementAmount(
+      CompletionQueue& cq, std::string row_key, std::string family_name,
+      std::string column_qualifier, std::int64_t amount);
+
+ protected:
+  // Wrap calling underlying operation in a virtual function to ease testing.
+  virtual future<StatusOr<Row>> AsyncReadModifyWriteRowImpl(
+      Table& table, google::bigtable::v2::ReadModifyWriteRowRequest request);
+
+ private:
+  using Result = StatusOr<std::int64_t>;
+
+  /// The increments for a single column, in the order they were received.
+  struct Counter {
+    std::int64_t total = 0;
+    std::vector<std::pair<std::int64_t, promise<Result>>> increments;
+  };
+  /// The counters for a row, keyed by column family and column qualifier.
+  using RowCounters = std::map<std::pair<std::string, std::string>, Counter>;
+
+  /// The increments received in a window, keyed by row.
+  struct Batch {
+    std::map<std::string, RowCounters> rows;
+    std::size_t pending = 0;
+    /// Set once the batch is sent, the timer may fire afterwards.
+    std::atomic<bool> sent{false};
+  };
+
+  void OnTimer(std::shared_ptr<Batch> const& batch);
+  void Send(std::shared_ptr<Batch> const& batch);
+  static void OnReadModifyWriteDone(RowCounters& counters,
+                                    StatusOr<Row> row);
+
+  Table table_;
+  Options const options_;
+
+  std::mutex mu_;
+  /// The batch for the current window, null if there are no pending increments.
+  std::shared_ptr<Batch> current_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INCREMENT_COMBINER_H
@@ -0,0 +1,165 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/increment_combiner.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = ::google::bigtable::v2;
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+
+template <typename T>
+bool Unsatisfied(future<T> const& fut) {
+  return std::future_status::timeout == fut.wait_for(1_ms);
+}
+
+/// Capture the requests instead of calling the service.
+class TestIncrementCombiner : public IncrementCombiner {
+ public:
+  TestIncrementCombiner(Table table, Options options)
+      : IncrementCombiner(std::move(table), std::move(options)) {}
+
+  std::vector<btproto::ReadModifyWriteRowRequest> requests;
+  /// The i-th promise satisfies the i-th request.
+  std::deque<promise<StatusOr<Row>>> responses;
+
+ protected:
+  future<StatusOr<Row>> AsyncReadModifyWriteRowImpl(
+      Table&, btproto::ReadModifyWriteRowRequest request) override {
+    requests.push_back(std::move(request));
+    responses.emplace_back();
+    return responses.back().get_future();
+  }
+};
+
+class IncrementCombinerTest : public bigtable::testing::TableTestFixture {
+ protected:
+  IncrementCombinerTest()
+      : TableTestFixture(
+            CompletionQueue(std::make_shared<FakeCompletionQueueImpl>())) {}
+
+  static Cell MakeCell(std::string const& row_key, std::string const& column,
+                       std::int64_t value) {
+    return Cell(row_key, "fam", column, 0,
+                google::cloud::internal::EncodeBigEndian(value));
+  }
+};
+
+TEST_F(IncrementCombinerTest, CombineWithinWindow) {
+  TestIncrementCombiner combiner(table_, IncrementCombiner::Options{});
+  auto i1 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c1", 1);
+  auto i2 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c1", 2);
+  auto i3 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c2", 5);
+  EXPECT_TRUE(combiner.requests.empty());
+
+  // Fire the timer for the window.
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(1U, combiner.requests.size());
+  auto const& request = combiner.requests[0];
+  EXPECT_EQ("r1", request.row_key());
+  ASSERT_EQ(2, request.rules_size());
+  EXPECT_EQ("c1", request.rules(0).column_qualifier());
+  EXPECT_EQ(3, request.rules(0).increment_amount());
+  EXPECT_EQ("c2", request.rules(1).column_qualifier());
+  EXPECT_EQ(5, request.rules(1).increment_amount());
+  EXPECT_TRUE(Unsatisfied(i1));
+
+  combiner.responses[0].set_value(
+      Row("r1", {MakeCell("r1", "c1", 13), MakeCell("r1", "c2", 105)}));
+  // The values are reported as if the increments were applied in order.
+  auto v1 = i1.get();
+  ASSERT_STATUS_OK(v1);
+  EXPECT_EQ(11, *v1);
+  auto v2 = i2.get();
+  ASSERT_STATUS_OK(v2);
+  EXPECT_EQ(13, *v2);
+  auto v3 = i3.get();
+  ASSERT_STATUS_OK(v3);
+  EXPECT_EQ(105, *v3);
+}
+
+TEST_F(IncrementCombinerTest, OneRequestPerRow) {
+  TestIncrementCombiner combiner(table_, IncrementCombiner::Options{});
+  auto i1 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c1", 1);
+  auto i2 = combiner.AsyncIncrementAmount(cq_, "r2", "fam", "c1", 1);
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(2U, combiner.requests.size());
+  EXPECT_EQ("r1", combiner.requests[0].row_key());
+  EXPECT_EQ("r2", combiner.requests[1].row_key());
+
+  combiner.responses[0].set_value(Row("r1", {MakeCell("r1", "c1", 7)}));
+  combiner.responses[1].set_value(
+      Status(StatusCode::kPermissionDenied, "uh-oh"));
+  auto v1 = i1.get();
+  ASSERT_STATUS_OK(v1);
+  EXPECT_EQ(7, *v1);
+  EXPECT_THAT(i2.get(), StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST_F(IncrementCombinerTest, MaxPendingIncrements) {
+  TestIncrementCombiner combiner(
+      table_, IncrementCombiner::Options{}.SetMaxPendingIncrements(2));
+  auto i1 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c1", 1);
+  auto i2 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c1", 1);
+  // The request is sent as soon as the batch is full.
+  ASSERT_EQ(1U, combiner.requests.size());
+  EXPECT_EQ(2, combiner.requests[0].rules(0).increment_amount());
+
+  auto i3 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c1", 1);
+  // Both the timer for the first window, which does nothing, and the timer for
+  // the second window fire.
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(2U, combiner.requests.size());
+  EXPECT_EQ(1, combiner.requests[1].rules(0).increment_amount());
+
+  combiner.responses[0].set_value(Row("r1", {MakeCell("r1", "c1", 2)}));
+  combiner.responses[1].set_value(Row("r1", {MakeCell("r1", "c1", 3)}));
+  EXPECT_EQ(1, i1.get().value());
+  EXPECT_EQ(2, i2.get().value());
+  EXPECT_EQ(3, i3.get().value());
+}
+
+TEST_F(IncrementCombinerTest, MissingColumn) {
+  TestIncrementCombiner combiner(table_, IncrementCombiner::Options{});
+  auto i1 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c1", 1);
+  auto i2 = combiner.AsyncIncrementAmount(cq_, "r1", "fam", "c2", 1);
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(1U, combiner.requests.size());
+
+  combiner.responses[0].set_value(Row("r1", {MakeCell("r1", "c1", 1)}));
+  EXPECT_THAT(i1.get(), IsOk());
+  EXPECT_THAT(i2.get(), StatusIs(StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
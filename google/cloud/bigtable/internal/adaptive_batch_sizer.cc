@@ -0,0 +1,100 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/adaptive_batch_sizer.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+namespace {
+// The batches never shrink below this fraction of the configured maximums.
+auto constexpr kMinFraction = 0.01;
+auto constexpr kInitialFraction = 0.1;
+auto constexpr kAdditiveIncrease = 0.1;
+auto constexpr kLatencyDecrease = 0.75;
+auto constexpr kResourceExhaustedDecrease = 0.5;
+
+std::size_t Scale(double fraction, std::size_t max) {
+  auto const scaled = fraction * static_cast<double>(max);
+  return (std::max)(std::size_t{1}, static_cast<std::size_t>(scaled));
+}
+}  // namespace
+
+AdaptiveBatchSizer::AdaptiveBatchSizer(std::chrono::microseconds target_latency,
+                                       std::size_t max_mutations_per_batch,
+                                       std::size_t max_size_per_batch,
+                                       std::size_t max_batches)
+    : target_latency_(target_latency),
+      max_mutations_per_batch_(max_mutations_per_batch),
+      max_size_per_batch_(max_size_per_batch),
+      max_batches_((std::max)(std::size_t{1}, max_batches)),
+      fraction_(kInitialFraction),
+      batches_(1) {}
+
+void AdaptiveBatchSizer::OnBatchComplete(std::size_t num_mutations,
+                                         std::size_t size,
+                                         std::chrono::microseconds latency,
+                                         bool resource_exhausted) {
+  if (resource_exhausted) {
+    fraction_ =
+        (std::max)(kMinFraction, fraction_ * kResourceExhaustedDecrease);
+    batches_ = (std::max)(std::size_t{1}, batches_ / 2);
+    return;
+  }
+  if (latency > target_latency_) {
+    Shrink();
+    return;
+  }
+  // A batch that was mostly empty says little about how larger batches would
+  // perform, so it does not justify growing the limits.
+  if (num_mutations * 2 < max_mutations_per_batch() &&
+      size * 2 < max_size_per_batch()) {
+    return;
+  }
+  Grow();
+}
+
+std::size_t AdaptiveBatchSizer::max_mutations_per_batch() const {
+  return Scale(fraction_, max_mutations_per_batch_);
+}
+
+std::size_t AdaptiveBatchSizer::max_size_per_batch() const {
+  return Scale(fraction_, max_size_per_batch_);
+}
+
+void AdaptiveBatchSizer::Grow() {
+  if (fraction_ < 1.0) {
+    fraction_ = (std::min)(1.0, fraction_ + kAdditiveIncrease);
+    return;
+  }
+  if (batches_ < max_batches_) ++batches_;
+}
+
+void AdaptiveBatchSizer::Shrink() {
+  if (fraction_ > kMinFraction) {
+    fraction_ = (std::max)(kMinFraction, fraction_ * kLatencyDecrease);
+    return;
+  }
+  if (batches_ > 1) --batches_;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,91 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ADAPTIVE_BATCH_SIZER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ADAPTIVE_BATCH_SIZER_H
+
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Tune the batch limits of a `MutationBatcher` to meet a target latency.
+ *
+ * The sizer keeps the mutations per batch, bytes per batch, and the number of
+ * outstanding batches between 1 and the configured maximums. It implements an
+ * additive-increase / multiplicative-decrease loop over a single "ladder":
+ *
+ * - A batch that completes within the target latency, and was at least half
+ *   full, grows the batch size. Once the batches are at their maximum size the
+ *   number of outstanding batches grows instead.
+ * - A batch slower than the target shrinks the batch size. Once the batches
+ *   are at their minimum size the number of outstanding batches shrinks.
+ * - A batch with `RESOURCE_EXHAUSTED` failures halves both the batch size and
+ *   the number of outstanding batches.
+ *
+ * The sizer starts with small batches and a single outstanding batch, so the
+ * load on the service ramps up over the first few batches.
+ *
+ * Objects of this class are not thread-safe, `MutationBatcher` uses them
+ * while holding its mutex.
+ */
+class AdaptiveBatchSizer {
+ public:
+  AdaptiveBatchSizer(std::chrono::microseconds target_latency,
+                     std::size_t max_mutations_per_batch,
+                     std::size_t max_size_per_batch, std::size_t max_batches);
+
+  /**
+   * Update the limits based on a completed batch.
+   *
+   * @param num_mutations the number of mutations in the batch.
+   * @param size the size of the requests in the batch, in bytes.
+   * @param latency the time from sending the batch until it completed.
+   * @param resource_exhausted if any mutation failed with
+   *     `RESOURCE_EXHAUSTED`.
+   */
+  void OnBatchComplete(std::size_t num_mutations, std::size_t size,
+                       std::chrono::microseconds latency,
+                       bool resource_exhausted);
+
+  std::size_t max_mutations_per_batch() const;
+  std::size_t max_size_per_batch() const;
+  std::size_t max_batches() const { return batches_; }
+
+ private:
+  void Grow();
+  void Shrink();
+
+  std::chrono::microseconds target_latency_;
+  std::size_t max_mutations_per_batch_;
+  std::size_t max_size_per_batch_;
+  std::size_t max_batches_;
+  /// The current batch limits, as a fraction of the configured maximums.
+  double fraction_;
+  std::size_t batches_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ADAPTIVE_BATCH_SIZER_H
@@ -0,0 +1,127 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/adaptive_batch_sizer.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ms = std::chrono::milliseconds;
+
+auto constexpr kMaxMutations = 1000;
+auto constexpr kMaxSize = 100000;
+auto constexpr kMaxBatches = 4;
+
+AdaptiveBatchSizer MakeSizer() {
+  return AdaptiveBatchSizer(ms(100), kMaxMutations, kMaxSize, kMaxBatches);
+}
+
+void CompleteFullBatch(AdaptiveBatchSizer& sizer, ms latency) {
+  sizer.OnBatchComplete(sizer.max_mutations_per_batch(),
+                        sizer.max_size_per_batch(), latency, false);
+}
+
+void GrowToMaximum(AdaptiveBatchSizer& sizer) {
+  for (int i = 0; i != 20; ++i) CompleteFullBatch(sizer, ms(10));
+}
+
+TEST(AdaptiveBatchSizerTest, StartsSmall) {
+  auto sizer = MakeSizer();
+  EXPECT_EQ(100, sizer.max_mutations_per_batch());
+  EXPECT_EQ(10000, sizer.max_size_per_batch());
+  EXPECT_EQ(1, sizer.max_batches());
+}
+
+TEST(AdaptiveBatchSizerTest, GrowsBatchesThenConcurrency) {
+  auto sizer = MakeSizer();
+  CompleteFullBatch(sizer, ms(10));
+  EXPECT_EQ(200, sizer.max_mutations_per_batch());
+  EXPECT_EQ(20000, sizer.max_size_per_batch());
+  EXPECT_EQ(1, sizer.max_batches());
+
+  GrowToMaximum(sizer);
+  EXPECT_EQ(kMaxMutations, sizer.max_mutations_per_batch());
+  EXPECT_EQ(kMaxSize, sizer.max_size_per_batch());
+  EXPECT_EQ(kMaxBatches, sizer.max_batches());
+}
+
+TEST(AdaptiveBatchSizerTest, SizeAloneJustifiesGrowth) {
+  auto sizer = MakeSizer();
+  // Few mutations, but they fill the batch.
+  sizer.OnBatchComplete(1, sizer.max_size_per_batch(), ms(10), false);
+  EXPECT_EQ(200, sizer.max_mutations_per_batch());
+}
+
+TEST(AdaptiveBatchSizerTest, MostlyEmptyBatchesDoNotGrow) {
+  auto sizer = MakeSizer();
+  sizer.OnBatchComplete(10, 100, ms(10), false);
+  EXPECT_EQ(100, sizer.max_mutations_per_batch());
+  EXPECT_EQ(1, sizer.max_batches());
+}
+
+TEST(AdaptiveBatchSizerTest, SlowBatchesShrink) {
+  auto sizer = MakeSizer();
+  GrowToMaximum(sizer);
+
+  CompleteFullBatch(sizer, ms(200));
+  EXPECT_EQ(750, sizer.max_mutations_per_batch());
+  EXPECT_EQ(75000, sizer.max_size_per_batch());
+  EXPECT_EQ(kMaxBatches, sizer.max_batches());
+
+  // Once the batches reach their minimum size the concurrency goes down.
+  for (int i = 0; i != 50; ++i) CompleteFullBatch(sizer, ms(200));
+  EXPECT_EQ(10, sizer.max_mutations_per_batch());
+  EXPECT_EQ(1000, sizer.max_size_per_batch());
+  EXPECT_EQ(1, sizer.max_batches());
+}
+
+TEST(AdaptiveBatchSizerTest, SlowBatchesShrinkEvenIfNotFull) {
+  auto sizer = MakeSizer();
+  sizer.OnBatchComplete(1, 10, ms(200), false);
+  EXPECT_EQ(75, sizer.max_mutations_per_batch());
+}
+
+TEST(AdaptiveBatchSizerTest, ResourceExhaustedBacksOff) {
+  auto sizer = MakeSizer();
+  GrowToMaximum(sizer);
+
+  sizer.OnBatchComplete(1, 10, ms(10), true);
+  EXPECT_EQ(500, sizer.max_mutations_per_batch());
+  EXPECT_EQ(50000, sizer.max_size_per_batch());
+  EXPECT_EQ(2, sizer.max_batches());
+
+  sizer.OnBatchComplete(1, 10, ms(10), true);
+  EXPECT_EQ(250, sizer.max_mutations_per_batch());
+  EXPECT_EQ(1, sizer.max_batches());
+}
+
+TEST(AdaptiveBatchSizerTest, LimitsNeverReachZero) {
+  AdaptiveBatchSizer sizer(ms(100), 1, 1, 0);
+  for (int i = 0; i != 10; ++i) sizer.OnBatchComplete(1, 1, ms(10), true);
+  EXPECT_EQ(1, sizer.max_mutations_per_batch());
+  EXPECT_EQ(1, sizer.max_size_per_batch());
+  EXPECT_EQ(1, sizer.max_batches());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -34,11 +34,31 @@ future<std::vector<FailedMutation>> AsyncRetryBulkApply::Create(
   std::shared_ptr<AsyncRetryBulkApply> bulk_apply(new AsyncRetryBulkApply(
       std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
       idempotent_policy, std::move(metadata_update_policy), std::move(client),
-      app_profile_id, table_name, std::move(mut)));
+      app_profile_id, table_name, std::move(mut), EntryCallback{}));
   bulk_apply->StartIteration(std::move(cq));
   return bulk_apply->promise_.get_future();
 }
 
+future<void> AsyncRetryBulkApply::CreateStreaming(
+    CompletionQueue cq, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+    IdempotentMutationPolicy& idempotent_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::shared_ptr<bigtable::DataClient> client,
+    std::string const& app_profile_id, std::string const& table_name,
+    BulkMutation mut, EntryCallback on_entry) {
+  if (mut.empty()) return make_ready_future();
+
+  std::shared_ptr<AsyncRetryBulkApply> bulk_apply(new AsyncRetryBulkApply(
+      std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
+      idempotent_policy, std::move(metadata_update_policy), std::move(client),
+      app_profile_id, table_name, std::move(mut), std::move(on_entry)));
+  bulk_apply->StartIteration(std::move(cq));
+  // All the failures were already reported, the vector is always empty.
+  return bulk_apply->promise_.get_future().then(
+      [](future<std::vector<FailedMutation>> f) { f.get(); });
+}
+
 AsyncRetryBulkApply::AsyncRetryBulkApply(
     std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
     std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
@@ -46,12 +66,13 @@ AsyncRetryBulkApply::AsyncRetryBulkApply(
     MetadataUpdatePolicy metadata_update_policy,
     std::shared_ptr<bigtable::DataClient> client,
     std::string const& app_profile_id, std::string const& table_name,
-    BulkMutation mut)
+    BulkMutation mut, EntryCallback on_entry)
     : rpc_retry_policy_(std::move(rpc_retry_policy)),
       rpc_backoff_policy_(std::move(rpc_backoff_policy)),
       metadata_update_policy_(std::move(metadata_update_policy)),
       client_(std::move(client)),
-      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
+      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)),
+      on_entry_(std::move(on_entry)) {}
 
 void AsyncRetryBulkApply::StartIteration(CompletionQueue cq) {
   auto context = absl::make_unique<grpc::ClientContext>();
@@ -76,12 +97,17 @@ void AsyncRetryBulkApply::StartIteration(CompletionQueue cq) {
 
 void AsyncRetryBulkApply::OnRead(
     google::bigtable::v2::MutateRowsResponse response) {
-  state_.OnRead(response);
+  auto succeeded = state_.OnRead(response);
+  if (!on_entry_) return;
+  Status const ok;
+  for (auto index : succeeded) on_entry_(index, ok);
+  ReportFailures(state_.ConsumeAccumulatedFailures());
 }
 
 void AsyncRetryBulkApply::OnFinish(CompletionQueue cq, Status const& status) {
   auto const is_retryable = status.ok() || rpc_retry_policy_->OnFailure(status);
   state_.OnFinish(status);
+  if (on_entry_) ReportFailures(state_.ConsumeAccumulatedFailures());
   if (!state_.HasPendingMutations() || !is_retryable) {
     SetPromise();
     return;
@@ -100,8 +126,17 @@ void AsyncRetryBulkApply::OnFinish(CompletionQueue cq, Status const& status) {
       });
 }
 
+void AsyncRetryBulkApply::ReportFailures(std::vector<FailedMutation> failures) {
+  for (auto const& f : failures) on_entry_(f.original_index(), f.status());
+}
+
 void AsyncRetryBulkApply::SetPromise() {
-  promise_.set_value(std::move(state_).OnRetryDone());
+  auto failures = std::move(state_).OnRetryDone();
+  if (on_entry_) {
+    ReportFailures(std::move(failures));
+    failures.clear();
+  }
+  promise_.set_value(std::move(failures));
 }
 
 }  // namespace internal
@@ -23,6 +23,7 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "absl/memory/memory.h"
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,25 @@ class AsyncRetryBulkApply
       std::string const& app_profile_id, std::string const& table_name,
       BulkMutation mut);
 
+  /// Called with the original index and the final status of a mutation.
+  using EntryCallback = std::function<void(int, Status const&)>;
+
+  /**
+   * Like `Create()`, but reports the result of each mutation when it is known.
+   *
+   * @p on_entry is called exactly once for each mutation in @p mut, as soon as
+   * the mutation succeeds or fails permanently, without waiting for the other
+   * mutations. The returned future is satisfied after the last call.
+   */
+  static future<void> CreateStreaming(
+      CompletionQueue cq, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      IdempotentMutationPolicy& idempotent_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::shared_ptr<bigtable::DataClient> client,
+      std::string const& app_profile_id, std::string const& table_name,
+      BulkMutation mut, EntryCallback on_entry);
+
  private:
   AsyncRetryBulkApply(std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
                       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
@@ -58,11 +78,13 @@ class AsyncRetryBulkApply
                       MetadataUpdatePolicy metadata_update_policy,
                       std::shared_ptr<bigtable::DataClient> client,
                       std::string const& app_profile_id,
-                      std::string const& table_name, BulkMutation mut);
+                      std::string const& table_name, BulkMutation mut,
+                      EntryCallback on_entry);
 
   void StartIteration(CompletionQueue cq);
   void OnRead(google::bigtable::v2::MutateRowsResponse response);
   void OnFinish(CompletionQueue cq, google::cloud::Status const& status);
+  void ReportFailures(std::vector<FailedMutation> failures);
   void SetPromise();
 
   std::unique_ptr<RPCRetryPolicy> rpc_retry_policy_;
@@ -70,6 +92,8 @@ class AsyncRetryBulkApply
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<bigtable::DataClient> client_;
   BulkMutatorState state_;
+  /// If set, the results are reported as they arrive, see `CreateStreaming()`.
+  EntryCallback on_entry_;
   promise<std::vector<FailedMutation>> promise_;
 };
 
@@ -25,6 +25,8 @@
 #include <gmock/gmock.h>
 #include <algorithm>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -39,6 +41,8 @@ using ::google::cloud::bigtable::testing::MockClientAsyncReaderInterface;
 using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
 using ::google::cloud::testing_util::FakeCompletionQueueImpl;
 using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Pair;
 
 class AsyncBulkApplyTest : public bigtable::testing::TableTestFixture {
  protected:
@@ -215,6 +219,103 @@ TEST_F(AsyncBulkApplyTest, PartialSuccessRetry) {
   EXPECT_TRUE(cq_impl_->empty());
 }
 
+TEST_F(AsyncBulkApplyTest, StreamingResults) {
+  bigtable::BulkMutation mut{
+      bigtable::SingleRowMutation("foo1",
+                                  {bigtable::SetCell("f", "c", 0_ms, "v1")}),
+      bigtable::SingleRowMutation("foo2",
+                                  {bigtable::SetCell("f", "c", 0_ms, "v2")}),
+      bigtable::SingleRowMutation("foo3",
+                                  {bigtable::SetCell("f", "c", 0_ms, "v3")}),
+  };
+
+  auto* reader0 =
+      new MockClientAsyncReaderInterface<btproto::MutateRowsResponse>;
+  auto* reader1 =
+      new MockClientAsyncReaderInterface<btproto::MutateRowsResponse>;
+
+  EXPECT_CALL(*reader0, Read)
+      .WillOnce([](btproto::MutateRowsResponse* r, void*) {
+        auto& r0 = *r->add_entries();
+        r0.set_index(0);
+        r0.mutable_status()->set_code(grpc::StatusCode::OK);
+        auto& r1 = *r->add_entries();
+        r1.set_index(1);
+        r1.mutable_status()->set_code(grpc::StatusCode::PERMISSION_DENIED);
+        auto& r2 = *r->add_entries();
+        r2.set_index(2);
+        r2.mutable_status()->set_code(grpc::StatusCode::UNAVAILABLE);
+      })
+      .WillOnce([](btproto::MutateRowsResponse*, void*) {});
+
+  EXPECT_CALL(*reader1, Read)
+      .WillOnce([](btproto::MutateRowsResponse* r, void*) {
+        auto& r0 = *r->add_entries();
+        r0.set_index(0);
+        r0.mutable_status()->set_code(grpc::StatusCode::OK);
+      })
+      .WillOnce([](btproto::MutateRowsResponse*, void*) {});
+
+  EXPECT_CALL(*reader0, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  EXPECT_CALL(*reader1, Finish).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  EXPECT_CALL(*reader0, StartCall).Times(1);
+  EXPECT_CALL(*reader1, StartCall).Times(1);
+
+  EXPECT_CALL(*client_, PrepareAsyncMutateRows)
+      .WillOnce([reader0](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ(3, request.entries_size());
+        return std::unique_ptr<
+            MockClientAsyncReaderInterface<btproto::MutateRowsResponse>>(
+            reader0);
+      })
+      .WillOnce([reader1](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ(1, request.entries_size());
+        EXPECT_EQ("foo3", request.entries(0).row_key());
+        return std::unique_ptr<
+            MockClientAsyncReaderInterface<btproto::MutateRowsResponse>>(
+            reader1);
+      });
+
+  std::vector<std::pair<int, StatusCode>> results;
+  auto bulk_apply_future = internal::AsyncRetryBulkApply::CreateStreaming(
+      cq_, rpc_retry_policy_->clone(), rpc_backoff_policy_->clone(),
+      *idempotent_mutation_policy_, metadata_update_policy_, client_,
+      "my-app-profile", "my-table", std::move(mut),
+      [&results](int index, Status const& status) {
+        results.emplace_back(index, status.code());
+      });
+
+  SimulateIteration();
+  // The completed mutations are reported before the retry.
+  EXPECT_THAT(results,
+              ElementsAre(Pair(0, StatusCode::kOk),
+                          Pair(1, StatusCode::kPermissionDenied)));
+  // simulate the backoff timer
+  cq_impl_->SimulateCompletion(true);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+
+  SimulateIteration();
+
+  bulk_apply_future.get();
+  EXPECT_THAT(results, ElementsAre(Pair(0, StatusCode::kOk),
+                                   Pair(1, StatusCode::kPermissionDenied),
+                                   Pair(2, StatusCode::kOk)));
+
+  ASSERT_EQ(0U, cq_impl_->size());
+  EXPECT_TRUE(cq_impl_->empty());
+}
+
 TEST_F(AsyncBulkApplyTest, DefaultFailureRetry) {
   bigtable::BulkMutation mut{
       bigtable::SingleRowMutation("foo2",
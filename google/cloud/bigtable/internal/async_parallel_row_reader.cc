@@ -0,0 +1,192 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/async_parallel_row_reader.h"
+#include "absl/types/optional.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+future<Status> AsyncParallelRowReader::Create(
+    std::vector<RowSet> shards, StreamFactory factory, RowCallback on_row,
+    ParallelReadRowsOptions const& options) {
+  if (shards.empty()) return make_ready_future(Status{});
+  std::shared_ptr<AsyncParallelRowReader> reader(new AsyncParallelRowReader(
+      std::move(shards), std::move(factory), std::move(on_row), options));
+  auto f = reader->promise_.get_future();
+  reader->Drain(std::unique_lock<std::mutex>(reader->mu_));
+  return f;
+}
+
+AsyncParallelRowReader::AsyncParallelRowReader(
+    std::vector<RowSet> shards, StreamFactory factory, RowCallback on_row,
+    ParallelReadRowsOptions const& options)
+    : factory_(std::move(factory)),
+      on_row_(std::move(on_row)),
+      max_streams_((std::max)(std::size_t{1}, options.max_streams)),
+      max_buffered_rows_((std::max)(std::size_t{1}, options.max_buffered_rows)),
+      preserve_order_(options.preserve_order) {
+  shards_.reserve(shards.size());
+  for (auto& s : shards) shards_.emplace_back(std::move(s));
+}
+
+future<bool> AsyncParallelRowReader::OnRow(std::size_t index, Row row) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (cancelled_) return make_ready_future(false);
+  auto& shard = shards_[index];
+  shard.rows.push_back(std::move(row));
+  ++buffered_;
+  if (!preserve_order_) arrivals_.push_back(index);
+  auto result = make_ready_future(true);
+  if (shard.rows.size() >= max_buffered_rows_) {
+    shard.paused = true;
+    shard.resume = promise<bool>();
+    result = shard.resume.get_future();
+  }
+  Drain(std::move(lk));
+  return result;
+}
+
+void AsyncParallelRowReader::OnFinish(std::size_t index, Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& shard = shards_[index];
+  shard.finished = true;
+  --running_;
+  if (!status.ok() && !cancelled_) {
+    status_ = std::move(status);
+    Cancel();
+  }
+  if (shard.rows.empty()) --active_;
+  Drain(std::move(lk));
+}
+
+void AsyncParallelRowReader::OnDelivered(bool keep_reading) {
+  std::unique_lock<std::mutex> lk(mu_);
+  delivering_ = false;
+  if (!keep_reading) Cancel();
+  Drain(std::move(lk));
+}
+
+void AsyncParallelRowReader::Drain(std::unique_lock<std::mutex> lk) {
+  for (;;) {
+    std::vector<std::pair<std::size_t, RowSet>> start;
+    while (!cancelled_ && active_ < max_streams_ &&
+           next_start_ < shards_.size()) {
+      auto const index = next_start_++;
+      ++active_;
+      ++running_;
+      start.emplace_back(index, std::move(shards_[index].row_set));
+    }
+
+    absl::optional<Row> row;
+    if (!delivering_) {
+      auto const index = NextDeliverable();
+      if (index != shards_.size()) {
+        auto& shard = shards_[index];
+        row.emplace(std::move(shard.rows.front()));
+        shard.rows.pop_front();
+        --buffered_;
+        if (!preserve_order_) arrivals_.pop_front();
+        if (shard.paused && shard.rows.size() < max_buffered_rows_) {
+          shard.paused = false;
+          pending_resumes_.emplace_back(std::move(shard.resume), true);
+        }
+        if (shard.finished && shard.rows.empty()) --active_;
+        delivering_ = true;
+      }
+    }
+
+    auto resumes = std::move(pending_resumes_);
+    pending_resumes_.clear();
+    if (start.empty() && resumes.empty() && !row) {
+      if (done_ || delivering_ || running_ != 0 || buffered_ != 0 ||
+          next_start_ != shards_.size()) {
+        return;
+      }
+      done_ = true;
+      auto status = status_;
+      lk.unlock();
+      promise_.set_value(std::move(status));
+      return;
+    }
+
+    // Satisfy the promises and call the application without holding the
+    // lock, any of these may call back into this object.
+    lk.unlock();
+    for (auto& r : resumes) r.first.set_value(r.second);
+    for (auto& s : start) StartStream(s.first, std::move(s.second));
+    if (row) {
+      auto delivered = on_row_(*std::move(row));
+      if (!delivered.is_ready()) {
+        auto self = shared_from_this();
+        delivered.then(
+            [self](future<bool> f) { self->OnDelivered(f.get()); });
+        return;
+      }
+      auto const keep_reading = delivered.get();
+      lk.lock();
+      delivering_ = false;
+      if (!keep_reading) Cancel();
+      continue;
+    }
+    lk.lock();
+  }
+}
+
+std::size_t AsyncParallelRowReader::NextDeliverable() {
+  if (!preserve_order_) {
+    return arrivals_.empty() ? shards_.size() : arrivals_.front();
+  }
+  while (head_ != shards_.size() && shards_[head_].finished &&
+         shards_[head_].rows.empty()) {
+    ++head_;
+  }
+  if (head_ == shards_.size() || shards_[head_].rows.empty()) {
+    return shards_.size();
+  }
+  return head_;
+}
+
+void AsyncParallelRowReader::Cancel() {
+  cancelled_ = true;
+  next_start_ = shards_.size();
+  for (auto& shard : shards_) {
+    shard.rows.clear();
+    if (!shard.paused) continue;
+    shard.paused = false;
+    pending_resumes_.emplace_back(std::move(shard.resume), false);
+  }
+  arrivals_.clear();
+  buffered_ = 0;
+}
+
+void AsyncParallelRowReader::StartStream(std::size_t index, RowSet row_set) {
+  auto self = shared_from_this();
+  factory_(
+      std::move(row_set),
+      [self, index](Row row) { return self->OnRow(index, std::move(row)); },
+      [self, index](Status status) {
+        self->OnFinish(index, std::move(status));
+      });
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
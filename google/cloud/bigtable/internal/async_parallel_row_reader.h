@@ -0,0 +1,137 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_PARALLEL_ROW_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_PARALLEL_ROW_READER_H
+
+#include "google/cloud/bigtable/parallel_read_rows_options.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status.h"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Objects of this class represent the state of a `Table::ParallelReadRows()`
+ * call.
+ *
+ * The class reads each shard with a separate stream, created using the
+ * `StreamFactory`, and delivers the rows to a single callback. The callback is
+ * never invoked concurrently, the next row is delivered only after the future
+ * returned by the previous invocation is satisfied.
+ *
+ * At most `options.max_streams` shards are read at a time, and each one of
+ * them buffers at most `options.max_buffered_rows`. When a buffer is full the
+ * future returned to the stream is satisfied only after the application
+ * consumes some of its rows, which stops the stream from reading more data.
+ */
+class AsyncParallelRowReader
+    : public std::enable_shared_from_this<AsyncParallelRowReader> {
+ public:
+  using RowCallback = std::function<future<bool>(Row)>;
+  using FinishCallback = std::function<void(Status)>;
+  /// Start reading @p row_set, invoking the callbacks as `AsyncReadRows()`.
+  using StreamFactory =
+      std::function<void(RowSet row_set, RowCallback on_row,
+                         FinishCallback on_finish)>;
+
+  /**
+   * Start reading all the @p shards.
+   *
+   * @returns a future satisfied once all the streams are closed and all the
+   *     rows delivered, or once the operation is cancelled. If @p on_row
+   *     returns `false` the remaining rows are discarded and the future is
+   *     satisfied with an OK status. If any stream fails the remaining rows
+   *     are discarded and the future is satisfied with the stream error.
+   */
+  static future<Status> Create(std::vector<RowSet> shards,
+                               StreamFactory factory, RowCallback on_row,
+                               ParallelReadRowsOptions const& options);
+
+ private:
+  struct Shard {
+    explicit Shard(RowSet r) : row_set(std::move(r)) {}
+
+    RowSet row_set;
+    std::deque<Row> rows;
+    bool finished = false;
+    bool paused = false;
+    promise<bool> resume;
+  };
+
+  AsyncParallelRowReader(std::vector<RowSet> shards, StreamFactory factory,
+                         RowCallback on_row,
+                         ParallelReadRowsOptions const& options);
+
+  future<bool> OnRow(std::size_t index, Row row);
+  void OnFinish(std::size_t index, Status status);
+  void OnDelivered(bool keep_reading);
+
+  /// Start streams, resume streams, and deliver rows until blocked.
+  void Drain(std::unique_lock<std::mutex> lk);
+  /// Returns the shard with the next row to deliver, or `shards_.size()`.
+  std::size_t NextDeliverable();
+  /// Discard any buffered rows and stop any new streams.
+  void Cancel();
+  void StartStream(std::size_t index, RowSet row_set);
+
+  StreamFactory factory_;
+  RowCallback on_row_;
+  std::size_t const max_streams_;
+  std::size_t const max_buffered_rows_;
+  bool const preserve_order_;
+
+  std::mutex mu_;
+  std::vector<Shard> shards_;
+  // Shard indices, one per buffered row, in arrival order. Only used when the
+  // rows are delivered as they arrive.
+  std::deque<std::size_t> arrivals_;
+  // The next shard to start, and the next shard to deliver when preserving
+  // the key order.
+  std::size_t next_start_ = 0;
+  std::size_t head_ = 0;
+  // The shards started but not fully delivered, these use a stream slot even
+  // after their stream finishes. This bounds the number of buffered rows.
+  std::size_t active_ = 0;
+  // The streams started but not yet finished.
+  std::size_t running_ = 0;
+  std::size_t buffered_ = 0;
+  bool delivering_ = false;
+  bool cancelled_ = false;
+  bool done_ = false;
+  Status status_;
+  std::vector<std::pair<promise<bool>, bool>> pending_resumes_;
+  promise<Status> promise_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_PARALLEL_ROW_READER_H
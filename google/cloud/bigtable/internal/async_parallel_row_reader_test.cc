@@ -0,0 +1,221 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/async_parallel_row_reader.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+/// Captures the streams created by `AsyncParallelRowReader`.
+class FakeStreams {
+ public:
+  struct Stream {
+    RowSet row_set;
+    AsyncParallelRowReader::RowCallback on_row;
+    AsyncParallelRowReader::FinishCallback on_finish;
+  };
+
+  AsyncParallelRowReader::StreamFactory Factory() {
+    return [this](RowSet row_set, AsyncParallelRowReader::RowCallback on_row,
+                  AsyncParallelRowReader::FinishCallback on_finish) {
+      streams.push_back(
+          Stream{std::move(row_set), std::move(on_row), std::move(on_finish)});
+    };
+  }
+
+  /// Send a row on stream @p index, returns the result of the callback.
+  future<bool> Send(std::size_t index, std::string const& key) {
+    return streams[index].on_row(Row(key, {}));
+  }
+
+  void Finish(std::size_t index, Status status = {}) {
+    streams[index].on_finish(std::move(status));
+  }
+
+  std::vector<Stream> streams;
+};
+
+std::vector<RowSet> MakeShards(int count) {
+  std::vector<RowSet> shards;
+  for (int i = 0; i != count; ++i) {
+    shards.emplace_back(RowRange::Prefix("shard-" + std::to_string(i)));
+  }
+  return shards;
+}
+
+TEST(AsyncParallelRowReaderTest, NoShards) {
+  FakeStreams streams;
+  auto f = AsyncParallelRowReader::Create(
+      {}, streams.Factory(), [](Row) { return make_ready_future(true); },
+      ParallelReadRowsOptions{});
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_STATUS_OK(f.get());
+  EXPECT_THAT(streams.streams, IsEmpty());
+}
+
+TEST(AsyncParallelRowReaderTest, LimitsStreams) {
+  FakeStreams streams;
+  std::vector<std::string> keys;
+  auto f = AsyncParallelRowReader::Create(
+      MakeShards(3), streams.Factory(),
+      [&keys](Row row) {
+        keys.push_back(row.row_key());
+        return make_ready_future(true);
+      },
+      ParallelReadRowsOptions{}.SetMaxStreams(2));
+  ASSERT_EQ(2, streams.streams.size());
+  auto const& first = streams.streams[0].row_set.as_proto();
+  EXPECT_EQ("shard-0", first.row_ranges(0).start_key_closed());
+
+  EXPECT_TRUE(streams.Send(1, "r1").get());
+  EXPECT_TRUE(streams.Send(0, "r0").get());
+  EXPECT_THAT(keys, ElementsAre("r1", "r0"));
+
+  streams.Finish(0);
+  ASSERT_EQ(3, streams.streams.size());
+  EXPECT_TRUE(streams.Send(2, "r2").get());
+  streams.Finish(2);
+  EXPECT_FALSE(f.is_ready());
+  streams.Finish(1);
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_STATUS_OK(f.get());
+  EXPECT_THAT(keys, ElementsAre("r1", "r0", "r2"));
+}
+
+TEST(AsyncParallelRowReaderTest, PreserveOrder) {
+  FakeStreams streams;
+  std::vector<std::string> keys;
+  auto f = AsyncParallelRowReader::Create(
+      MakeShards(2), streams.Factory(),
+      [&keys](Row row) {
+        keys.push_back(row.row_key());
+        return make_ready_future(true);
+      },
+      ParallelReadRowsOptions{}.SetPreserveOrder(true).SetMaxBufferedRows(2));
+  ASSERT_EQ(2, streams.streams.size());
+
+  EXPECT_TRUE(streams.Send(1, "b0").get());
+  // The buffer for the second shard is full, the stream must wait.
+  auto paused = streams.Send(1, "b1");
+  EXPECT_FALSE(paused.is_ready());
+  EXPECT_THAT(keys, IsEmpty());
+
+  EXPECT_TRUE(streams.Send(0, "a0").get());
+  EXPECT_THAT(keys, ElementsAre("a0"));
+  streams.Finish(0);
+  EXPECT_THAT(keys, ElementsAre("a0", "b0", "b1"));
+  ASSERT_TRUE(paused.is_ready());
+  EXPECT_TRUE(paused.get());
+
+  EXPECT_TRUE(streams.Send(1, "b2").get());
+  streams.Finish(1);
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_STATUS_OK(f.get());
+  EXPECT_THAT(keys, ElementsAre("a0", "b0", "b1", "b2"));
+}
+
+TEST(AsyncParallelRowReaderTest, SlowConsumer) {
+  FakeStreams streams;
+  std::vector<std::string> keys;
+  std::vector<promise<bool>> pending;
+  auto f = AsyncParallelRowReader::Create(
+      MakeShards(1), streams.Factory(),
+      [&](Row row) {
+        keys.push_back(row.row_key());
+        pending.emplace_back();
+        return pending.back().get_future();
+      },
+      ParallelReadRowsOptions{}.SetMaxBufferedRows(1));
+  ASSERT_EQ(1, streams.streams.size());
+
+  // The first row is delivered immediately.
+  EXPECT_TRUE(streams.Send(0, "r0").get());
+  ASSERT_EQ(1, pending.size());
+  // The second row is buffered until the application is ready.
+  auto paused = streams.Send(0, "r1");
+  EXPECT_FALSE(paused.is_ready());
+  EXPECT_THAT(keys, ElementsAre("r0"));
+
+  pending[0].set_value(true);
+  EXPECT_THAT(keys, ElementsAre("r0", "r1"));
+  ASSERT_TRUE(paused.is_ready());
+  EXPECT_TRUE(paused.get());
+
+  streams.Finish(0);
+  EXPECT_FALSE(f.is_ready());
+  pending[1].set_value(true);
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_STATUS_OK(f.get());
+}
+
+TEST(AsyncParallelRowReaderTest, ApplicationStops) {
+  FakeStreams streams;
+  std::vector<std::string> keys;
+  auto f = AsyncParallelRowReader::Create(
+      MakeShards(3), streams.Factory(),
+      [&keys](Row row) {
+        keys.push_back(row.row_key());
+        return make_ready_future(false);
+      },
+      ParallelReadRowsOptions{}.SetMaxStreams(2));
+  ASSERT_EQ(2, streams.streams.size());
+
+  EXPECT_TRUE(streams.Send(0, "r0").get());
+  EXPECT_FALSE(streams.Send(1, "r1").get());
+  streams.Finish(0, Status(StatusCode::kCancelled, "cancelled"));
+  streams.Finish(1, Status(StatusCode::kCancelled, "cancelled"));
+  // The third shard is never started.
+  EXPECT_EQ(2, streams.streams.size());
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_STATUS_OK(f.get());
+  EXPECT_THAT(keys, ElementsAre("r0"));
+}
+
+TEST(AsyncParallelRowReaderTest, StreamError) {
+  FakeStreams streams;
+  auto f = AsyncParallelRowReader::Create(
+      MakeShards(3), streams.Factory(),
+      [](Row) { return make_ready_future(true); },
+      ParallelReadRowsOptions{}.SetMaxStreams(2).SetMaxBufferedRows(1));
+  ASSERT_EQ(2, streams.streams.size());
+
+  EXPECT_TRUE(streams.Send(1, "r1").get());
+  streams.Finish(0, Status(StatusCode::kPermissionDenied, "uh-oh"));
+  // The other stream is told to stop, and no new streams start.
+  EXPECT_EQ(2, streams.streams.size());
+  EXPECT_FALSE(streams.Send(1, "r2").get());
+  EXPECT_FALSE(f.is_ready());
+  streams.Finish(1);
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_THAT(f.get(), StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -16,7 +16,9 @@
 #include "google/cloud/bigtable/rpc_retry_policy.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/log.h"
+#include <algorithm>
 #include <numeric>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -32,26 +34,23 @@ BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
                                    std::string const& table_name,
                                    IdempotentMutationPolicy& idempotent_policy,
                                    BulkMutation mut) {
-  // Every time the client library calls MakeOneRequest(), the data in the
-  // "pending_*" variables initializes the next request.  So in the constructor
-  // we start by putting the data on the "pending_*" variables.
-  // Move the mutations to the "pending" request proto, this is a zero copy
-  // optimization.
-  mut.MoveTo(&pending_mutations_);
-  pending_mutations_.set_app_profile_id(app_profile_id);
-  pending_mutations_.set_table_name(table_name);
+  // Move the mutations to the request proto, this is a zero copy
+  // optimization. All the retries reuse this proto.
+  mut.MoveTo(&mutations_);
+  mutations_.set_app_profile_id(app_profile_id);
+  mutations_.set_table_name(table_name);
 
   // As we receive successful responses, we shrink the size of the request (only
   // those pending are resent).  But if any fails we want to report their index
-  // in the original sequence provided by the user. This vector maps from the
-  // index in the current sequence of mutations to the index in the original
-  // sequence of mutations.
-  pending_annotations_.reserve(pending_mutations_.entries_size());
+  // in the original sequence provided by the user. The annotations map from
+  // the index in the current sequence of mutations to the index in the
+  // original sequence of mutations.
+  annotations_.reserve(mutations_.entries_size());
 
   // We save the idempotency of each mutation, to be used later as we decide if
   // they should be retried or not.
   int index = 0;
-  for (auto const& e : pending_mutations_.entries()) {
+  for (auto const& e : mutations_.entries()) {
     // This is a giant && across all the mutations for each row.
     auto is_idempotent =
         std::all_of(e.mutations().begin(), e.mutations().end(),
@@ -60,20 +59,35 @@ BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
                     });
     auto idempotency =
         is_idempotent ? Idempotency::kIdempotent : Idempotency::kNonIdempotent;
-    pending_annotations_.push_back(Annotations{index++, idempotency, false});
+    annotations_.push_back(Annotations{index++, idempotency, false, true});
   }
+  pending_count_ = annotations_.size();
 }
 
 google::bigtable::v2::MutateRowsRequest const& BulkMutatorState::BeforeStart() {
-  mutations_.Swap(&pending_mutations_);
-  annotations_.swap(pending_annotations_);
+  // Move the pending mutations to the front of the request, preserving their
+  // relative order. Swapping the elements of a repeated field only swaps
+  // pointers, the entries are never copied.
+  auto& entries = *mutations_.mutable_entries();
+  int size = 0;
+  for (int i = 0; i != entries.size(); ++i) {
+    auto const index = static_cast<std::size_t>(i);
+    if (!annotations_[index].is_pending) continue;
+    if (i != size) {
+      entries.SwapElements(i, size);
+      std::swap(annotations_[index],
+                annotations_[static_cast<std::size_t>(size)]);
+    }
+    ++size;
+  }
+  // The remaining entries have succeeded or failed permanently.
+  entries.DeleteSubrange(size, entries.size() - size);
+  annotations_.resize(static_cast<std::size_t>(size));
   for (auto& a : annotations_) {
     a.has_mutation_result = false;
+    a.is_pending = false;
   }
-  pending_mutations_ = {};
-  pending_mutations_.set_app_profile_id(mutations_.app_profile_id());
-  pending_mutations_.set_table_name(mutations_.table_name());
-  pending_annotations_ = {};
+  pending_count_ = 0;
 
   return mutations_;
 }
@@ -105,23 +119,22 @@ std::vector<int> BulkMutatorState::OnRead(
     // this class takes ownership in the constructor.
     if (grpc::StatusCode::OK == code) {
       res.push_back(annotation.original_index);
+      ReleaseEntry(index);
       continue;
     }
-    auto& original = *mutations_.mutable_entries(static_cast<int>(index));
     // Failed responses are handled according to the current policies.
     if (SafeGrpcRetry::IsTransientFailure(code) &&
         (annotation.idempotency == Idempotency::kIdempotent)) {
-      // Retryable requests are saved in the pending mutations, along with the
-      // mapping from their index in pending_mutations_ to the original
-      // vector and other miscellanea.
-      pending_mutations_.add_entries()->Swap(&original);
-      pending_annotations_.push_back(annotation);
+      // Retryable requests are marked as pending, `BeforeStart()` keeps them
+      // in the next request.
+      MarkPending(annotation);
     } else {
       // Failures are saved for reporting, notice that we avoid copying, and
       // we use the original index in the first request, not the one where it
       // failed.
       failures_.emplace_back(std::move(*entry.mutable_status()),
                              annotation.original_index);
+      ReleaseEntry(index);
     }
   }
   return res;
@@ -130,19 +143,13 @@ std::vector<int> BulkMutatorState::OnRead(
 void BulkMutatorState::OnFinish(google::cloud::Status finish_status) {
   last_status_ = std::move(finish_status);
 
-  int index = 0;
-  for (auto const& annotation : annotations_) {
-    if (annotation.has_mutation_result) {
-      ++index;
-      continue;
-    }
+  for (std::size_t index = 0; index != annotations_.size(); ++index) {
+    auto& annotation = annotations_[index];
+    if (annotation.has_mutation_result) continue;
     // If there are any mutations with unknown state, they need to be handled.
-    auto& original = *mutations_.mutable_entries(index);
     if (annotation.idempotency == Idempotency::kIdempotent) {
-      // If the mutation was retryable, move it to the pending mutations to try
-      // again, along with their index.
-      pending_mutations_.add_entries()->Swap(&original);
-      pending_annotations_.push_back(annotation);
+      // If the mutation was retryable, mark it as pending to try again.
+      MarkPending(annotation);
     } else {
       if (last_status_.ok()) {
         google::cloud::Status status(
@@ -157,11 +164,26 @@ void BulkMutatorState::OnFinish(google::cloud::Status finish_status) {
         failures_.emplace_back(
             FailedMutation(last_status_, annotation.original_index));
       }
+      ReleaseEntry(index);
     }
-    ++index;
   }
 }
 
+void BulkMutatorState::ReleaseEntry(std::size_t index) {
+  // The request was serialized when the stream started, so the entries of
+  // completed mutations are no longer needed. Swapping with an empty entry
+  // frees their memory now, instead of when the next attempt starts.
+  btproto::MutateRowsRequest::Entry{}.Swap(
+      mutations_.mutable_entries(static_cast<int>(index)));
+}
+
+void BulkMutatorState::MarkPending(Annotations& annotation) {
+  // Guard against the server reporting the same index more than once.
+  if (annotation.is_pending) return;
+  annotation.is_pending = true;
+  ++pending_count_;
+}
+
 std::vector<FailedMutation> BulkMutatorState::ConsumeAccumulatedFailures() {
   std::vector<FailedMutation> res;
   res.swap(failures_);
@@ -171,9 +193,9 @@ std::vector<FailedMutation> BulkMutatorState::ConsumeAccumulatedFailures() {
 std::vector<FailedMutation> BulkMutatorState::OnRetryDone() && {
   std::vector<FailedMutation> result(std::move(failures_));
 
-  auto size = pending_mutations_.mutable_entries()->size();
-  for (int idx = 0; idx != size; idx++) {
-    int original_index = pending_annotations_[idx].original_index;
+  for (auto const& annotation : annotations_) {
+    if (!annotation.is_pending) continue;
+    int original_index = annotation.original_index;
     if (last_status_.ok()) {
       google::cloud::Status status(
           google::cloud::StatusCode::kInternal,
@@ -22,6 +22,7 @@
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/retry_policy.h"
 #include "absl/memory/memory.h"
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -37,9 +38,7 @@ class BulkMutatorState {
                    IdempotentMutationPolicy& idempotent_policy,
                    BulkMutation mut);
 
-  bool HasPendingMutations() const {
-    return pending_mutations_.entries_size() != 0;
-  }
+  bool HasPendingMutations() const { return pending_count_ != 0; }
 
   /// Returns the Request parameter for the next MutateRows() RPC.
   google::bigtable::v2::MutateRowsRequest const& BeforeStart();
@@ -68,7 +67,12 @@ class BulkMutatorState {
   std::vector<FailedMutation> OnRetryDone() &&;
 
  private:
-  /// The current request proto.
+  /**
+   * The current request proto.
+   *
+   * The retries reuse this proto: `BeforeStart()` moves the pending entries to
+   * the front and drops the rest, without copying or allocating any entries.
+   */
   google::bigtable::v2::MutateRowsRequest mutations_;
 
   /**
@@ -101,16 +105,21 @@ class BulkMutatorState {
     google::cloud::internal::Idempotency idempotency;
     /// Set to `false` if the result is unknown.
     bool has_mutation_result;
+    /// Set to `true` if the mutation should be included in the next request.
+    bool is_pending;
   };
 
-  /// The annotations about the current bulk request.
+  /// The annotations about the current bulk request, in the same order.
   std::vector<Annotations> annotations_;
 
-  /// Accumulate mutations for the next request.
-  google::bigtable::v2::MutateRowsRequest pending_mutations_;
+  /// The number of mutations with `is_pending` set.
+  std::size_t pending_count_ = 0;
+
+  /// Include the mutation in the next request.
+  void MarkPending(Annotations& annotation);
 
-  /// Accumulate annotations for the next request.
-  std::vector<Annotations> pending_annotations_;
+  /// Free the request entry of a mutation that will not be retried.
+  void ReleaseEntry(std::size_t index);
 };
 
 /// Keep the state in the Table::BulkApply() member function.
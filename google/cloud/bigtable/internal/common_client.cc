@@ -12,12 +12,97 @@
 // See the License for the specific language governing permissions and
 
 #include "google/cloud/bigtable/internal/common_client.h"
+#include <atomic>
+#include <mutex>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
+namespace {
+
+class OutstandingRequestInterceptor : public grpc::experimental::Interceptor {
+ public:
+  OutstandingRequestInterceptor(
+      std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> picker,
+      std::size_t index)
+      : picker_(std::move(picker)), index_(index) {
+    picker_->StartRequest(index_);
+  }
+  ~OutstandingRequestInterceptor() override { Finish(); }
+
+  void Intercept(
+      grpc::experimental::InterceptorBatchMethods* methods) override {
+    // The application may hold on to the call long after it completes, the
+    // request is no longer outstanding once it receives its final status.
+    if (methods->QueryInterceptionHookPoint(
+            grpc::experimental::InterceptionHookPoints::POST_RECV_STATUS)) {
+      Finish();
+    }
+    methods->Proceed();
+  }
+
+ private:
+  void Finish() {
+    if (finished_.exchange(true)) return;
+    picker_->FinishRequest(index_);
+  }
+
+  std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> picker_;
+  std::size_t index_;
+  std::atomic<bool> finished_{false};
+};
+
+}  // namespace
+
+grpc::experimental::Interceptor*
+OutstandingRequestInterceptorFactory::CreateClientInterceptor(
+    grpc::experimental::ClientRpcInfo*) {
+  return new OutstandingRequestInterceptor(picker_, index_);
+}
+
+future<Status> PrimeChannels(
+    CompletionQueue cq,
+    std::vector<std::shared_ptr<grpc::Channel>> const& channels,
+    std::chrono::system_clock::time_point deadline,
+    std::function<future<Status>(std::size_t)> const& prime) {
+  struct State {
+    std::mutex mu;
+    std::size_t pending;
+    Status status;
+    promise<Status> done;
+  };
+  auto state = std::make_shared<State>();
+  state->pending = channels.size();
+  auto result = state->done.get_future();
+  if (channels.empty()) {
+    state->done.set_value(Status{});
+    return result;
+  }
+
+  auto on_primed = [state](future<Status> f) {
+    auto status = f.get();
+    std::unique_lock<std::mutex> lk(state->mu);
+    if (!status.ok() && state->status.ok()) state->status = std::move(status);
+    if (--state->pending != 0) return;
+    status = std::move(state->status);
+    lk.unlock();
+    state->done.set_value(std::move(status));
+  };
+  for (std::size_t i = 0; i != channels.size(); ++i) {
+    cq.AsyncWaitConnectionReady(channels[i], deadline)
+        .then([prime, i](future<Status> f) {
+          auto status = f.get();
+          if (!status.ok() || !prime) {
+            return make_ready_future(std::move(status));
+          }
+          return prime(i);
+        })
+        .then(on_primed);
+  }
+  return result;
+}
 
 ConnectionRefreshState::ConnectionRefreshState(
     std::shared_ptr<CompletionQueue> const& cq,
@@ -39,38 +124,45 @@ std::chrono::milliseconds ConnectionRefreshState::RandomizedRefreshDelay() {
 void ScheduleChannelRefresh(
     std::shared_ptr<CompletionQueue> const& cq,
     std::shared_ptr<ConnectionRefreshState> const& state,
-    std::shared_ptr<grpc::Channel> const& channel) {
-  // The timers will only hold weak pointers to the channel or to the
-  // completion queue, so if either of them are destroyed, the timer chain
-  // will simply not continue.
-  std::weak_ptr<grpc::Channel> weak_channel(channel);
+    std::weak_ptr<RefreshableChannelPool> pool, std::size_t index) {
+  // The timers will only hold weak pointers to the pool or to the completion
+  // queue, so if either of them are destroyed, the timer chain will simply not
+  // continue.
   std::weak_ptr<CompletionQueue> weak_cq(cq);
   using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
   auto timer_future =
       cq->MakeRelativeTimer(state->RandomizedRefreshDelay())
-          .then([weak_channel, weak_cq, state](TimerFuture fut) {
+          .then([weak_cq, state, pool, index](TimerFuture fut) {
             if (!fut.get()) {
               // Timer cancelled.
               return;
             }
-            auto channel = weak_channel.lock();
-            if (!channel) return;
             auto cq = weak_cq.lock();
             if (!cq) return;
+            auto p = pool.lock();
+            if (!p) return;
+            auto replacement = p->CreateReplacement(index);
+            if (!replacement) return;
+            // Do not keep the pool alive while the replacement connects.
+            p.reset();
             cq->AsyncWaitConnectionReady(
-                  channel,
+                  replacement,
                   std::chrono::system_clock::now() + kConnectionReadyTimeout)
-                .then([weak_channel, weak_cq, state](future<Status> fut) {
+                .then([weak_cq, state, pool, index,
+                       replacement](future<Status> fut) {
                   auto conn_status = fut.get();
-                  if (!conn_status.ok()) {
-                    GCP_LOG(WARNING) << "Failed to refresh connection. Error: "
+                  auto p = pool.lock();
+                  if (!p) return;
+                  if (conn_status.ok()) {
+                    p->ReplaceChannel(index, replacement);
+                  } else {
+                    GCP_LOG(WARNING) << "Failed to refresh connection, the "
+                                     << "current channel is kept. Error: "
                                      << conn_status;
                   }
-                  auto channel = weak_channel.lock();
-                  if (!channel) return;
                   auto cq = weak_cq.lock();
                   if (!cq) return;
-                  ScheduleChannelRefresh(cq, state, channel);
+                  ScheduleChannelRefresh(cq, state, pool, index);
                 });
           });
   state->timers().RegisterTimer(std::move(timer_future));
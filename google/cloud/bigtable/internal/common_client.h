@@ -19,11 +19,14 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/connection_options.h"
 #include "google/cloud/internal/absl_flat_hash_map_quiet.h"
+#include "google/cloud/internal/outstanding_request_picker.h"
 #include "google/cloud/internal/random.h"
 #include "google/cloud/log.h"
 #include "google/cloud/status_or.h"
 #include <grpcpp/grpcpp.h>
+#include <grpcpp/support/client_interceptor.h>
 #include <chrono>
+#include <functional>
 #include <list>
 #include <vector>
 
@@ -90,20 +93,99 @@ class ConnectionRefreshState {
 };
 
 /**
- * Schedule a chain of timers to refresh the connection.
+ * The channels of a pool, as seen by the timers that refresh them.
+ *
+ * The timers might outlive the pool, they only hold weak pointers to objects
+ * of this class.
+ */
+class RefreshableChannelPool {
+ public:
+  virtual ~RefreshableChannelPool() = default;
+
+  /**
+   * Create a new channel to replace the channel at @p index.
+   *
+   * The new channel is not used until `ReplaceChannel()` is called. Returns
+   * `nullptr` if the channel at @p index should no longer be refreshed.
+   */
+  virtual std::shared_ptr<grpc::Channel> CreateReplacement(
+      std::size_t index) = 0;
+
+  /// Use @p channel, returned by `CreateReplacement()`, for new requests.
+  virtual void ReplaceChannel(std::size_t index,
+                              std::shared_ptr<grpc::Channel> channel) = 0;
+};
+
+/**
+ * Schedule a chain of timers to refresh the channel at @p index in @p pool.
+ *
+ * The refresh is "make-before-break": when a timer expires a replacement
+ * channel is created and connected, while the current channel keeps serving
+ * requests. Only a connected replacement is swapped into the pool, so new
+ * requests never wait for a connection. The calls already using the old
+ * channel hold a reference to it, and the old channel is released once they
+ * complete. If the replacement fails to connect the pool keeps its current
+ * channel.
  */
 void ScheduleChannelRefresh(
     std::shared_ptr<CompletionQueue> const& cq,
     std::shared_ptr<ConnectionRefreshState> const& state,
-    std::shared_ptr<grpc::Channel> const& channel);
+    std::weak_ptr<RefreshableChannelPool> pool, std::size_t index);
+
+/**
+ * Connect all the @p channels, and call @p prime for each connected channel.
+ *
+ * @param cq the completion queue used to wait for the connections.
+ * @param channels the channels to connect.
+ * @param deadline give up on connecting the channels after this time.
+ * @param prime if set, it is called with the index of each channel once it is
+ *     connected. It typically sends a cheap request on the channel.
+ * @returns a future satisfied once all the channels are connected and primed.
+ *     It contains the first error, if any.
+ */
+future<Status> PrimeChannels(
+    CompletionQueue cq,
+    std::vector<std::shared_ptr<grpc::Channel>> const& channels,
+    std::chrono::system_clock::time_point deadline,
+    std::function<future<Status>(std::size_t)> const& prime);
+
+/**
+ * Count the outstanding RPCs on a channel.
+ *
+ * gRPC creates an interceptor for each call made on a channel. The
+ * interceptors created by this factory increment the outstanding request
+ * count for the channel when the call starts, and decrement it when the call
+ * receives its final status (or is destroyed). This works for unary,
+ * streaming, synchronous, and asynchronous calls alike, without changing the
+ * code that makes the calls.
+ */
+class OutstandingRequestInterceptorFactory
+    : public grpc::experimental::ClientInterceptorFactoryInterface {
+ public:
+  OutstandingRequestInterceptorFactory(
+      std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> picker,
+      std::size_t index)
+      : picker_(std::move(picker)), index_(index) {}
+
+  grpc::experimental::Interceptor* CreateClientInterceptor(
+      grpc::experimental::ClientRpcInfo* info) override;
+
+ private:
+  std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> picker_;
+  std::size_t index_;
+};
 
 /**
  * Refactor implementation of `bigtable::{Data,Admin,InstanceAdmin}Client`.
  *
  * All the clients need to keep a collection (sometimes with a single element)
- * of channels, update the collection when needed and round-robin across the
- * channels. At least `bigtable::DataClient` needs to optimize the creation of
- * the stub objects.
+ * of channels, update the collection when needed and balance the load across
+ * the channels. At least `bigtable::DataClient` needs to optimize the creation
+ * of the stub objects.
+ *
+ * The load is balanced using the "power of two choices": each call samples two
+ * channels and uses the one with fewer outstanding RPCs. Channels are
+ * refreshed by replacing them with new, already connected, channels.
  *
  * The class exposes the channels because they are needed for clients that
  * use more than one type of Stub.
@@ -123,7 +205,6 @@ class CommonClient {
 
   explicit CommonClient(bigtable::ClientOptions options)
       : options_(std::move(options)),
-        current_index_(0),
         background_threads_(
             google::cloud::internal::DefaultBackgroundThreads(1)),
         refresh_cq_(
@@ -134,6 +215,7 @@ class CommonClient {
 
   ~CommonClient() {
     // This will stop the refresh of the channels.
+    if (refresh_handle_) refresh_handle_->Detach();
     channels_.clear();
     // This will cancel all pending timers.
     refresh_state_->timers().CancelAll();
@@ -147,8 +229,11 @@ class CommonClient {
    * and/or when the credentials require explicit refresh.
    */
   void reset() {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::unique_lock<std::mutex> lk(mu_);
     stubs_.clear();
+    auto handle = std::move(refresh_handle_);
+    lk.unlock();
+    if (handle) handle->Detach();
   }
 
   /// Return the next Stub to make a call.
@@ -169,7 +254,72 @@ class CommonClient {
 
   ClientOptions& Options() { return options_; }
 
+  /**
+   * Create and connect all the channels, without waiting for the first call.
+   *
+   * If @p prime is set, it is called with each stub once its channel is
+   * connected, and can send a cheap request to finish warming up the channel.
+   *
+   * @see `internal::PrimeChannels()`
+   */
+  future<Status> PrimeChannels(
+      std::chrono::system_clock::time_point deadline,
+      std::function<future<Status>(CompletionQueue&, StubPtr const&)> prime) {
+    std::unique_lock<std::mutex> lk(mu_);
+    CheckConnections(lk);
+    auto channels = channels_;
+    auto stubs = stubs_;
+    lk.unlock();
+    std::function<future<Status>(std::size_t)> prime_index;
+    if (prime) {
+      auto cq = refresh_cq_;
+      prime_index = [cq, stubs, prime](std::size_t index) {
+        return prime(*cq, stubs[index]);
+      };
+    }
+    return internal::PrimeChannels(*refresh_cq_, channels, deadline,
+                                   prime_index);
+  }
+
  private:
+  /**
+   * Lets the refresh timers replace the channels of one pool.
+   *
+   * The timers might outlive the client. `Detach()` ensures they stop using
+   * it.
+   */
+  class RefreshHandle : public RefreshableChannelPool {
+   public:
+    RefreshHandle(
+        CommonClient* client,
+        std::shared_ptr<google::cloud::internal::OutstandingRequestPicker>
+            picker)
+        : client_(client), picker_(std::move(picker)) {}
+
+    void Detach() {
+      std::lock_guard<std::mutex> lk(mu_);
+      client_ = nullptr;
+    }
+
+    ChannelPtr CreateReplacement(std::size_t index) override {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (client_ == nullptr) return nullptr;
+      return client_->CreateReplacement(index, picker_);
+    }
+
+    void ReplaceChannel(std::size_t index, ChannelPtr channel) override {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (client_ == nullptr) return;
+      client_->ReplaceChannel(index, picker_, std::move(channel));
+    }
+
+   private:
+    std::mutex mu_;
+    CommonClient* client_;  // GUARDED_BY(mu_)
+    std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> const
+        picker_;
+  };
+
   /// Make sure the connections exit, and create them if needed.
   void CheckConnections(std::unique_lock<std::mutex>& lk) {
     if (!stubs_.empty()) {
@@ -186,7 +336,11 @@ class CommonClient {
     // introduce attributes in the implementation of CreateChannelPool() to
     // create one socket per element in the pool.
     lk.unlock();
-    auto channels = CreateChannelPool();
+    auto picker =
+        std::make_shared<google::cloud::internal::OutstandingRequestPicker>(
+            options_.connection_pool_size());
+    auto channels = CreateChannelPool(picker);
+    auto const channels_size = channels.size();
     std::vector<StubPtr> tmp;
     std::transform(channels.begin(), channels.end(), std::back_inserter(tmp),
                    [](std::shared_ptr<grpc::Channel> ch) {
@@ -196,7 +350,19 @@ class CommonClient {
     if (stubs_.empty()) {
       channels.swap(channels_);
       tmp.swap(stubs_);
-      current_index_ = 0;
+      picker.swap(picker_);
+      if (options_.max_conn_refresh_period().count() == 0) return;
+      auto handle = std::make_shared<RefreshHandle>(this, picker_);
+      auto previous = std::move(refresh_handle_);
+      refresh_handle_ = handle;
+      lk.unlock();
+      // The handle locks its own mutex before calling into this object, so
+      // detach the handle of the previous pool, if any, without holding `mu_`.
+      if (previous) previous->Detach();
+      for (std::size_t i = 0; i != channels_size; ++i) {
+        ScheduleChannelRefresh(refresh_cq_, refresh_state_, handle, i);
+      }
+      lk.lock();
     } else {
       // Some other thread created the pool and saved it in `stubs_`. The work
       // in this thread was superfluous. We release the lock while clearing the
@@ -208,46 +374,82 @@ class CommonClient {
     }
   }
 
-  ChannelPtr CreateChannel(std::size_t idx) {
+  ChannelPtr CreateChannel(
+      std::size_t idx,
+      std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> const&
+          picker,
+      int generation = 0) {
     auto args = options_.channel_arguments();
     if (!options_.connection_pool_name().empty()) {
       args.SetString("cbt-c++/connection-pool-name",
                      options_.connection_pool_name());
     }
     args.SetInt("cbt-c++/connection-pool-id", static_cast<int>(idx));
-    auto res = grpc::CreateCustomChannel(Traits::Endpoint(options_),
-                                         options_.credentials(), args);
-    if (options_.max_conn_refresh_period().count() == 0) {
-      return res;
+    // gRPC shares the connections of channels with the same arguments, a
+    // replacement channel needs different arguments to get a new connection.
+    if (generation != 0) {
+      args.SetInt("cbt-c++/connection-generation", generation);
     }
-    ScheduleChannelRefresh(refresh_cq_, refresh_state_, res);
-    return res;
+    std::vector<
+        std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
+        interceptors;
+    interceptors.emplace_back(
+        new OutstandingRequestInterceptorFactory(picker, idx));
+    return grpc::experimental::CreateCustomChannelWithInterceptors(
+        Traits::Endpoint(options_), options_.credentials(), args,
+        std::move(interceptors));
   }
 
-  std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool() {
+  ChannelPtr CreateReplacement(
+      std::size_t idx,
+      std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> const&
+          picker) {
+    std::unique_lock<std::mutex> lk(mu_);
+    // The pool was reset, its refresh timers are no longer needed.
+    if (picker != picker_) return nullptr;
+    auto const generation = ++channel_generation_;
+    lk.unlock();
+    // The replacement counts its requests in the same slot of the picker as
+    // the channel it replaces.
+    return CreateChannel(idx, picker, generation);
+  }
+
+  void ReplaceChannel(
+      std::size_t idx,
+      std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> const&
+          picker,
+      ChannelPtr channel) {
+    StubPtr stub = Interface::NewStub(channel);
+    std::unique_lock<std::mutex> lk(mu_);
+    if (picker != picker_ || idx >= stubs_.size()) return;
+    channels_[idx].swap(channel);
+    stubs_[idx].swap(stub);
+    lk.unlock();
+    // Any calls started on the old channel keep a reference to it, the channel
+    // is closed once they complete and these references are released.
+  }
+
+  std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
+      std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> const&
+          picker) {
     std::vector<std::shared_ptr<grpc::Channel>> result;
-    for (std::size_t i = 0; i != options_.connection_pool_size(); ++i) {
-      result.emplace_back(CreateChannel(i));
+    for (std::size_t i = 0; i != picker->size(); ++i) {
+      result.emplace_back(CreateChannel(i, picker));
     }
     return result;
   }
 
-  /// Get the current index for round-robin over connections.
-  std::size_t GetIndex() {
-    std::size_t current = current_index_++;
-    // Round robin through the connections.
-    if (current_index_ >= stubs_.size()) {
-      current_index_ = 0;
-    }
-    return current;
-  }
+  /// Get the index of the least loaded (of two sampled) connections.
+  std::size_t GetIndex() { return picker_->Pick(); }
 
   std::mutex mu_;
   std::size_t num_pending_refreshes_{};
   ClientOptions options_;
   std::vector<ChannelPtr> channels_;
   std::vector<StubPtr> stubs_;
-  std::size_t current_index_;
+  std::shared_ptr<google::cloud::internal::OutstandingRequestPicker> picker_;
+  std::shared_ptr<RefreshHandle> refresh_handle_;
+  int channel_generation_ = 0;
   std::unique_ptr<BackgroundThreads> background_threads_;
   // Timers, which we schedule for refreshes, need to reference the completion
   // queue. We cannot make the completion queue's underlying implementation
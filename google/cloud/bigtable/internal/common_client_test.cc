@@ -14,6 +14,12 @@
 #include "google/cloud/bigtable/internal/common_client.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/server_builder.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -107,6 +113,117 @@ TEST_F(OutstandingTimersTest, TimerRegisteredAfterCancelAllGetCancelled) {
   continuation_promise.get_future().get();
 }
 
+using PrimeChannelsTest = OutstandingTimersTest;
+
+TEST_F(PrimeChannelsTest, NoChannels) {
+  auto status = PrimeChannels(cq_, {}, std::chrono::system_clock::now(),
+                              [](std::size_t) {
+                                ADD_FAILURE() << "unexpected call to prime()";
+                                return make_ready_future(Status{});
+                              })
+                    .get();
+  EXPECT_STATUS_OK(status);
+}
+
+TEST_F(PrimeChannelsTest, UnreachableChannels) {
+  // Nothing listens on this port, the channels never become ready.
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  for (int i = 0; i != 2; ++i) {
+    grpc::ChannelArguments args;
+    args.SetInt("test-channel-id", i);
+    channels.push_back(grpc::CreateCustomChannel(
+        "localhost:1", grpc::InsecureChannelCredentials(), args));
+  }
+  auto status =
+      PrimeChannels(
+          cq_, channels,
+          std::chrono::system_clock::now() + std::chrono::milliseconds(50),
+          [](std::size_t) {
+            ADD_FAILURE() << "unexpected call to prime()";
+            return make_ready_future(Status{});
+          })
+          .get();
+  EXPECT_FALSE(status.ok());
+}
+
+class FakePool : public RefreshableChannelPool {
+ public:
+  explicit FakePool(std::string target) : target_(std::move(target)) {}
+
+  std::shared_ptr<grpc::Channel> CreateReplacement(std::size_t) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (replacements_ == 2) return nullptr;
+    grpc::ChannelArguments args;
+    args.SetInt("test-channel-id", ++replacements_);
+    return grpc::CreateCustomChannel(target_,
+                                     grpc::InsecureChannelCredentials(), args);
+  }
+
+  void ReplaceChannel(std::size_t index,
+                      std::shared_ptr<grpc::Channel> channel) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    EXPECT_EQ(GRPC_CHANNEL_READY, channel->GetState(false));
+    replaced_.push_back(index);
+    if (replaced_.size() == 2) done_.set_value();
+  }
+
+  future<void> done() { return done_.get_future(); }
+
+ private:
+  std::string target_;
+  std::mutex mu_;
+  int replacements_ = 0;
+  std::vector<std::size_t> replaced_;
+  promise<void> done_;
+};
+
+using ScheduleChannelRefreshTest = OutstandingTimersTest;
+
+TEST_F(ScheduleChannelRefreshTest, ReplacesWithConnectedChannels) {
+  // The server handles no calls, the channels only need to connect to it.
+  grpc::ServerBuilder builder;
+  grpc::AsyncGenericService generic_service;
+  builder.RegisterAsyncGenericService(&generic_service);
+  int port = 0;
+  builder.AddListeningPort("localhost:0", grpc::InsecureServerCredentials(),
+                           &port);
+  auto srv_cq = builder.AddCompletionQueue();
+  std::thread srv_thread([&srv_cq] {
+    bool ok;
+    void* placeholder;
+    while (srv_cq->Next(&placeholder, &ok))
+      ;
+  });
+  auto server = builder.BuildAndStart();
+  ASSERT_NE(0, port);
+
+  auto cq = std::make_shared<CompletionQueue>(cq_);
+  auto state = std::make_shared<ConnectionRefreshState>(
+      cq, std::chrono::milliseconds(1), std::chrono::milliseconds(5));
+  auto pool = std::make_shared<FakePool>("localhost:" + std::to_string(port));
+  auto done = pool->done();
+  ScheduleChannelRefresh(cq, state, pool, 3);
+  EXPECT_EQ(std::future_status::ready, done.wait_for(std::chrono::seconds(5)));
+  state->timers().CancelAll();
+  server->Shutdown();
+  srv_cq->Shutdown();
+  srv_thread.join();
+}
+
+TEST_F(ScheduleChannelRefreshTest, StopsWithPool) {
+  auto cq = std::make_shared<CompletionQueue>(cq_);
+  auto state = std::make_shared<ConnectionRefreshState>(
+      cq, std::chrono::milliseconds(1), std::chrono::milliseconds(5));
+  auto pool = std::make_shared<FakePool>("localhost:1");
+  ScheduleChannelRefresh(cq, state, pool, 0);
+  // The timer does not keep the pool alive, and the chain of timers stops
+  // once it is gone.
+  std::weak_ptr<FakePool> weak = pool;
+  pool.reset();
+  EXPECT_TRUE(weak.expired());
+  state->timers().CancelAll();
+}
+
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -0,0 +1,87 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/key_range_router.h"
+#include <algorithm>
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+KeyRangeRouter::KeyRangeRouter(std::size_t num_buckets,
+                               std::chrono::milliseconds period)
+    : num_buckets_((std::max)(std::size_t{1}, num_buckets)),
+      period_(period),
+      next_refresh_((std::numeric_limits<std::int64_t>::min)()) {}
+
+absl::optional<std::size_t> KeyRangeRouter::Bucket(
+    std::string const& row_key) const {
+  auto boundaries = std::atomic_load(&boundaries_);
+  if (!boundaries || boundaries->empty()) return absl::nullopt;
+  // Each boundary is the (exclusive) end of a bucket.
+  auto const it =
+      std::upper_bound(boundaries->begin(), boundaries->end(), row_key);
+  return static_cast<std::size_t>(std::distance(boundaries->begin(), it));
+}
+
+void KeyRangeRouter::Update(std::vector<RowKeySample> const& samples) {
+  // The service returns the samples in order, the last one usually has an
+  // empty key to represent the end of the table.
+  std::vector<RowKeySample const*> splits;
+  for (auto const& s : samples) {
+    if (!s.row_key.empty()) splits.push_back(&s);
+  }
+  auto const total_bytes = samples.empty() ? 0 : samples.back().offset_bytes;
+  // Without size estimates treat all the tablets as equal.
+  auto const use_bytes = total_bytes > 0;
+  auto const total = use_bytes ? static_cast<double>(total_bytes)
+                               : static_cast<double>(splits.size() + 1);
+  auto weight = [&](std::size_t i) {
+    return use_bytes ? static_cast<double>(splits[i]->offset_bytes)
+                     : static_cast<double>(i + 1);
+  };
+
+  auto boundaries = std::make_shared<Boundaries>();
+  std::size_t i = 0;
+  for (std::size_t b = 1; b != num_buckets_ && i != splits.size(); ++b) {
+    auto const target = total * static_cast<double>(b) /
+                        static_cast<double>(num_buckets_);
+    while (i != splits.size() && weight(i) < target) ++i;
+    if (i == splits.size()) break;
+    auto const& key = splits[i]->row_key;
+    if (boundaries->empty() || boundaries->back() < key) {
+      boundaries->push_back(key);
+    }
+    ++i;
+  }
+  std::atomic_store(&boundaries_,
+                    std::shared_ptr<Boundaries const>(std::move(boundaries)));
+}
+
+bool KeyRangeRouter::StartRefresh(std::chrono::steady_clock::time_point now) {
+  auto const ticks = static_cast<std::int64_t>(now.time_since_epoch().count());
+  auto next = next_refresh_.load();
+  if (ticks < next) return false;
+  return next_refresh_.compare_exchange_strong(
+      next, ticks + static_cast<std::int64_t>(period_.count()));
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,88 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_KEY_RANGE_ROUTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_KEY_RANGE_ROUTER_H
+
+#include "google/cloud/bigtable/row_key_sample.h"
+#include "google/cloud/bigtable/version.h"
+#include "absl/types/optional.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Map row keys to a fixed number of buckets of contiguous key ranges.
+ *
+ * The bucket boundaries are chosen among the split points returned by
+ * `Table::SampleRows()`, so each bucket covers complete tablets, and the
+ * buckets hold roughly the same amount of data. Mutations in the same bucket
+ * touch fewer tablets than mutations in arrival order.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use concurrently from multiple threads.
+ * `Bucket()` does not block while the boundaries are updated.
+ */
+class KeyRangeRouter {
+ public:
+  KeyRangeRouter(std::size_t num_buckets, std::chrono::milliseconds period);
+
+  /**
+   * Return the bucket for @p row_key.
+   *
+   * Returns an unset value until the first call to `Update()`, or if the
+   * samples did not contain any split points.
+   */
+  absl::optional<std::size_t> Bucket(std::string const& row_key) const;
+
+  /// Replace the bucket boundaries using new samples.
+  void Update(std::vector<RowKeySample> const& samples);
+
+  /**
+   * Return true if the caller should refresh the samples.
+   *
+   * Returns true at most once per refresh period, even if called
+   * concurrently.
+   */
+  bool StartRefresh(std::chrono::steady_clock::time_point now);
+
+  std::size_t num_buckets() const { return num_buckets_; }
+
+ private:
+  using Boundaries = std::vector<std::string>;
+
+  std::size_t const num_buckets_;
+  std::chrono::steady_clock::duration const period_;
+  /// The time for the next refresh, as ticks of `std::chrono::steady_clock`.
+  std::atomic<std::int64_t> next_refresh_;
+  /// Use `std::atomic_load()` and `std::atomic_store()` to access.
+  std::shared_ptr<Boundaries const> boundaries_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_KEY_RANGE_ROUTER_H
@@ -0,0 +1,102 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/key_range_router.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ms = std::chrono::milliseconds;
+
+TEST(KeyRangeRouterTest, NoBucketsBeforeUpdate) {
+  KeyRangeRouter router(4, ms(1000));
+  EXPECT_EQ(4, router.num_buckets());
+  EXPECT_FALSE(router.Bucket("a").has_value());
+}
+
+TEST(KeyRangeRouterTest, BalancedBySize) {
+  KeyRangeRouter router(4, ms(1000));
+  router.Update({{"b", 100},
+                 {"d", 200},
+                 {"f", 300},
+                 {"h", 400},
+                 {"j", 500},
+                 {"l", 600},
+                 {"n", 700},
+                 {"", 800}});
+  EXPECT_EQ(0, router.Bucket("").value());
+  EXPECT_EQ(0, router.Bucket("a").value());
+  EXPECT_EQ(0, router.Bucket("c").value());
+  // The split point is the first key in the next bucket.
+  EXPECT_EQ(1, router.Bucket("d").value());
+  EXPECT_EQ(1, router.Bucket("g").value());
+  EXPECT_EQ(2, router.Bucket("h").value());
+  EXPECT_EQ(3, router.Bucket("m").value());
+  EXPECT_EQ(3, router.Bucket("zzz").value());
+}
+
+TEST(KeyRangeRouterTest, SkewedTabletsUseFewerBuckets) {
+  KeyRangeRouter router(4, ms(1000));
+  router.Update({{"b", 10}, {"c", 20}, {"x", 1000}, {"", 1010}});
+  EXPECT_EQ(0, router.Bucket("a").value());
+  EXPECT_EQ(0, router.Bucket("w").value());
+  EXPECT_EQ(1, router.Bucket("x").value());
+  EXPECT_EQ(1, router.Bucket("z").value());
+}
+
+TEST(KeyRangeRouterTest, NoSizeEstimates) {
+  KeyRangeRouter router(2, ms(1000));
+  router.Update({{"b", 0}, {"d", 0}, {"f", 0}, {"", 0}});
+  EXPECT_EQ(0, router.Bucket("c").value());
+  EXPECT_EQ(1, router.Bucket("d").value());
+  EXPECT_EQ(1, router.Bucket("z").value());
+}
+
+TEST(KeyRangeRouterTest, SingleTabletHasNoBuckets) {
+  KeyRangeRouter router(4, ms(1000));
+  router.Update({{"", 100}});
+  EXPECT_FALSE(router.Bucket("a").has_value());
+  router.Update({});
+  EXPECT_FALSE(router.Bucket("a").has_value());
+}
+
+TEST(KeyRangeRouterTest, UpdateReplacesBoundaries) {
+  KeyRangeRouter router(2, ms(1000));
+  router.Update({{"m", 100}, {"", 200}});
+  EXPECT_EQ(0, router.Bucket("c").value());
+  router.Update({{"b", 100}, {"", 200}});
+  EXPECT_EQ(1, router.Bucket("c").value());
+}
+
+TEST(KeyRangeRouterTest, StartRefreshOncePerPeriod) {
+  KeyRangeRouter router(2, ms(1000));
+  auto const t0 = std::chrono::steady_clock::now();
+  EXPECT_TRUE(router.StartRefresh(t0));
+  EXPECT_FALSE(router.StartRefresh(t0));
+  EXPECT_FALSE(router.StartRefresh(t0 + ms(999)));
+  EXPECT_TRUE(router.StartRefresh(t0 + ms(1000)));
+  EXPECT_FALSE(router.StartRefresh(t0 + ms(1001)));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,210 @@
+// Copyright 2020 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/metrics_data_client.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+namespace btproto = google::bigtable::v2;
+using ::google::cloud::internal::MetricsEndCall;
+using ::google::cloud::internal::MetricsResourceScope;
+using ::google::cloud::internal::MetricsStartCall;
+
+namespace {
+
+// The `DataClient` interface predates `StatusOr<>`, the generic
+// `MetricsWrapper()` functions do not work with its out-parameters.
+template <typename Functor, typename Request, typename Response>
+grpc::Status MetricsUnary(Functor&& functor, Request const& request,
+                          Response* response, RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  auto const start = MetricsStartCall(metrics, request);
+  auto status = functor();
+  if (status.ok()) {
+    metrics.RecordBytesReceived(
+        static_cast<std::uint64_t>(response->ByteSizeLong()));
+  }
+  MetricsEndCall(metrics, start, MakeStatusFromRpcError(status));
+  return status;
+}
+
+// Streaming and asynchronous calls only record the work to start the call.
+template <typename Functor, typename Request>
+auto MetricsStart(Functor&& functor, Request const& request,
+                  RpcMethodMetrics& metrics) -> decltype(functor()) {
+  MetricsResourceScope scope(metrics);
+  auto const start = MetricsStartCall(metrics, request);
+  auto result = functor();
+  MetricsEndCall(metrics, start, Status{});
+  return result;
+}
+
+}  // namespace
+
+grpc::Status MetricsDataClient::MutateRow(
+    grpc::ClientContext* context, btproto::MutateRowRequest const& request,
+    btproto::MutateRowResponse* response) {
+  return MetricsUnary(
+      [&] { return child_->MutateRow(context, request, response); },
+      request, response, metrics_->Method("Bigtable.MutateRow"));
+}
+
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<btproto::MutateRowResponse>>
+MetricsDataClient::AsyncMutateRow(grpc::ClientContext* context,
+                                  btproto::MutateRowRequest const& request,
+                                  grpc::CompletionQueue* cq) {
+  return MetricsStart(
+      [&] { return child_->AsyncMutateRow(context, request, cq); },
+      request, metrics_->Method("Bigtable.MutateRow"));
+}
+
+grpc::Status MetricsDataClient::CheckAndMutateRow(
+    grpc::ClientContext* context,
+    btproto::CheckAndMutateRowRequest const& request,
+    btproto::CheckAndMutateRowResponse* response) {
+  return MetricsUnary(
+      [&] { return child_->CheckAndMutateRow(context, request, response); },
+      request, response, metrics_->Method("Bigtable.CheckAndMutateRow"));
+}
+
+std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+    google::bigtable::v2::CheckAndMutateRowResponse>>
+MetricsDataClient::AsyncCheckAndMutateRow(
+    grpc::ClientContext* context,
+    google::bigtable::v2::CheckAndMutateRowRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return MetricsStart(
+      [&] { return child_->AsyncCheckAndMutateRow(context, request, cq); },
+      request, metrics_->Method("Bigtable.CheckAndMutateRow"));
+}
+
+grpc::Status MetricsDataClient::ReadModifyWriteRow(
+    grpc::ClientContext* context,
+    btproto::ReadModifyWriteRowRequest const& request,
+    btproto::ReadModifyWriteRowResponse* response) {
+  return MetricsUnary(
+      [&] { return child_->ReadModifyWriteRow(context, request, response); },
+      request, response, metrics_->Method("Bigtable.ReadModifyWriteRow"));
+}
+
+std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+    google::bigtable::v2::ReadModifyWriteRowResponse>>
+MetricsDataClient::AsyncReadModifyWriteRow(
+    grpc::ClientContext* context,
+    google::bigtable::v2::ReadModifyWriteRowRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return MetricsStart(
+      [&] { return child_->AsyncReadModifyWriteRow(context, request, cq); },
+      request, metrics_->Method("Bigtable.ReadModifyWriteRow"));
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
+MetricsDataClient::ReadRows(grpc::ClientContext* context,
+                            btproto::ReadRowsRequest const& request) {
+  return MetricsStart([&] { return child_->ReadRows(context, request); },
+                      request, metrics_->Method("Bigtable.ReadRows"));
+}
+
+std::unique_ptr<grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>>
+MetricsDataClient::AsyncReadRows(
+    grpc::ClientContext* context,
+    google::bigtable::v2::ReadRowsRequest const& request,
+    grpc::CompletionQueue* cq, void* tag) {
+  return MetricsStart(
+      [&] { return child_->AsyncReadRows(context, request, cq, tag); },
+      request, metrics_->Method("Bigtable.ReadRows"));
+}
+
+std::unique_ptr<::grpc::ClientAsyncReaderInterface<
+    ::google::bigtable::v2::ReadRowsResponse>>
+MetricsDataClient::PrepareAsyncReadRows(
+    ::grpc::ClientContext* context,
+    ::google::bigtable::v2::ReadRowsRequest const& request,
+    ::grpc::CompletionQueue* cq) {
+  return MetricsStart(
+      [&] { return child_->PrepareAsyncReadRows(context, request, cq); },
+      request, metrics_->Method("Bigtable.ReadRows"));
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<btproto::SampleRowKeysResponse>>
+MetricsDataClient::SampleRowKeys(grpc::ClientContext* context,
+                                 btproto::SampleRowKeysRequest const& request) {
+  return MetricsStart([&] { return child_->SampleRowKeys(context, request); },
+                      request, metrics_->Method("Bigtable.SampleRowKeys"));
+}
+
+std::unique_ptr<::grpc::ClientAsyncReaderInterface<
+    ::google::bigtable::v2::SampleRowKeysResponse>>
+MetricsDataClient::AsyncSampleRowKeys(
+    ::grpc::ClientContext* context,
+    ::google::bigtable::v2::SampleRowKeysRequest const& request,
+    ::grpc::CompletionQueue* cq, void* tag) {
+  return MetricsStart(
+      [&] { return child_->AsyncSampleRowKeys(context, request, cq, tag); },
+      request, metrics_->Method("Bigtable.SampleRowKeys"));
+}
+
+std::unique_ptr<::grpc::ClientAsyncReaderInterface<
+    ::google::bigtable::v2::SampleRowKeysResponse>>
+MetricsDataClient::PrepareAsyncSampleRowKeys(
+    ::grpc::ClientContext* context,
+    ::google::bigtable::v2::SampleRowKeysRequest const& request,
+    ::grpc::CompletionQueue* cq) {
+  return MetricsStart(
+      [&] { return child_->PrepareAsyncSampleRowKeys(context, request, cq); },
+      request, metrics_->Method("Bigtable.SampleRowKeys"));
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
+MetricsDataClient::MutateRows(grpc::ClientContext* context,
+                              btproto::MutateRowsRequest const& request) {
+  return MetricsStart([&] { return child_->MutateRows(context, request); },
+                      request, metrics_->Method("Bigtable.MutateRows"));
+}
+
+std::unique_ptr<::grpc::ClientAsyncReaderInterface<
+    ::google::bigtable::v2::MutateRowsResponse>>
+MetricsDataClient::AsyncMutateRows(
+    ::grpc::ClientContext* context,
+    ::google::bigtable::v2::MutateRowsRequest const& request,
+    ::grpc::CompletionQueue* cq, void* tag) {
+  return MetricsStart(
+      [&] { return child_->AsyncMutateRows(context, request, cq, tag); },
+      request, metrics_->Method("Bigtable.MutateRows"));
+}
+
+std::unique_ptr<::grpc::ClientAsyncReaderInterface<
+    ::google::bigtable::v2::MutateRowsResponse>>
+MetricsDataClient::PrepareAsyncMutateRows(
+    ::grpc::ClientContext* context,
+    ::google::bigtable::v2::MutateRowsRequest const& request,
+    ::grpc::CompletionQueue* cq) {
+  return MetricsStart(
+      [&] { return child_->PrepareAsyncMutateRows(context, request, cq); },
+      request, metrics_->Method("Bigtable.MutateRows"));
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,133 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/metrics_data_client.h"
+#include "google/cloud/bigtable/testing/mock_data_client.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Return;
+
+namespace btproto = google::bigtable::v2;
+
+class FakeAllocationCounter : public RpcAllocationCounter {
+ public:
+  std::int64_t Count() override { return count; }
+  std::int64_t count = 0;
+};
+
+TEST(MetricsDataClientTest, MutateRow) {
+  auto mock = std::make_shared<testing::MockDataClient>();
+  EXPECT_CALL(*mock, MutateRow).WillOnce(Return(grpc::Status()));
+
+  auto metrics = std::make_shared<RpcMetrics>();
+  internal::MetricsDataClient stub(mock, metrics);
+  grpc::ClientContext context;
+  btproto::MutateRowRequest request;
+  request.set_table_name("test-table");
+  btproto::MutateRowResponse response;
+  auto status = stub.MutateRow(&context, request, &response);
+  EXPECT_TRUE(status.ok());
+  EXPECT_THAT(
+      metrics->Snapshot(),
+      ElementsAre(AllOf(
+          Field(&RpcMethodMetricsSnapshot::method, "Bigtable.MutateRow"),
+          Field(&RpcMethodMetricsSnapshot::calls, 1),
+          Field(&RpcMethodMetricsSnapshot::errors, 0),
+          Field(&RpcMethodMetricsSnapshot::bytes_sent,
+                request.ByteSizeLong()))));
+}
+
+TEST(MetricsDataClientTest, CheckAndMutateRowError) {
+  auto mock = std::make_shared<testing::MockDataClient>();
+  EXPECT_CALL(*mock, CheckAndMutateRow)
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "uh-oh")));
+
+  auto metrics = std::make_shared<RpcMetrics>();
+  internal::MetricsDataClient stub(mock, metrics);
+  grpc::ClientContext context;
+  btproto::CheckAndMutateRowRequest request;
+  btproto::CheckAndMutateRowResponse response;
+  auto status = stub.CheckAndMutateRow(&context, request, &response);
+  EXPECT_EQ(grpc::StatusCode::UNAVAILABLE, status.error_code());
+  EXPECT_THAT(metrics->Snapshot(),
+              ElementsAre(AllOf(Field(&RpcMethodMetricsSnapshot::method,
+                                      "Bigtable.CheckAndMutateRow"),
+                                Field(&RpcMethodMetricsSnapshot::calls, 1),
+                                Field(&RpcMethodMetricsSnapshot::errors, 1))));
+}
+
+TEST(MetricsDataClientTest, StreamingAndAsyncCalls) {
+  auto mock = std::make_shared<testing::MockDataClient>();
+  EXPECT_CALL(*mock, ReadRows)
+      .WillOnce([](grpc::ClientContext*, btproto::ReadRowsRequest const&) {
+        return nullptr;
+      });
+  EXPECT_CALL(*mock, AsyncMutateRow)
+      .WillOnce([](grpc::ClientContext*, btproto::MutateRowRequest const&,
+                   grpc::CompletionQueue*) { return nullptr; });
+
+  auto metrics = std::make_shared<RpcMetrics>();
+  internal::MetricsDataClient stub(mock, metrics);
+  grpc::ClientContext c0;
+  stub.ReadRows(&c0, btproto::ReadRowsRequest{});
+  grpc::ClientContext c1;
+  grpc::CompletionQueue cq;
+  stub.AsyncMutateRow(&c1, btproto::MutateRowRequest{}, &cq);
+  EXPECT_THAT(
+      metrics->Snapshot(),
+      ElementsAre(
+          AllOf(Field(&RpcMethodMetricsSnapshot::method, "Bigtable.MutateRow"),
+                Field(&RpcMethodMetricsSnapshot::calls, 1)),
+          AllOf(Field(&RpcMethodMetricsSnapshot::method, "Bigtable.ReadRows"),
+                Field(&RpcMethodMetricsSnapshot::calls, 1))));
+}
+
+TEST(MetricsDataClientTest, ResourceAccounting) {
+  auto counter = std::make_shared<FakeAllocationCounter>();
+  auto mock = std::make_shared<testing::MockDataClient>();
+  EXPECT_CALL(*mock, ReadModifyWriteRow)
+      .WillOnce([&counter](grpc::ClientContext*,
+                           btproto::ReadModifyWriteRowRequest const&,
+                           btproto::ReadModifyWriteRowResponse*) {
+        counter->count += 3;
+        return grpc::Status();
+      });
+
+  auto metrics = std::make_shared<RpcMetrics>(RpcResourceAccounting{counter});
+  internal::MetricsDataClient stub(mock, metrics);
+  grpc::ClientContext context;
+  btproto::ReadModifyWriteRowResponse response;
+  auto status = stub.ReadModifyWriteRow(
+      &context, btproto::ReadModifyWriteRowRequest{}, &response);
+  EXPECT_TRUE(status.ok());
+  EXPECT_THAT(metrics->Snapshot(),
+              ElementsAre(Field(&RpcMethodMetricsSnapshot::allocations, 3)));
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,69 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/mutation_admission_budget.h"
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+MutationAdmissionBudget::MutationAdmissionBudget(
+    std::size_t max_outstanding_size, std::size_t max_outstanding_mutations,
+    std::shared_ptr<google::cloud::MemoryAccount> memory_account)
+    : max_outstanding_size_(max_outstanding_size),
+      max_outstanding_mutations_(max_outstanding_mutations),
+      memory_(std::move(memory_account)) {}
+
+bool MutationAdmissionBudget::TryAcquire(std::size_t request_size,
+                                         std::size_t num_mutations) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (outstanding_size_ + request_size > max_outstanding_size_ ||
+      outstanding_mutations_ + num_mutations > max_outstanding_mutations_) {
+    return false;
+  }
+  // Admit at least one mutation, otherwise the batcher would never make
+  // progress.
+  if (outstanding_size_ != 0 && memory_.OverSoftLimit()) return false;
+  outstanding_size_ += request_size;
+  outstanding_mutations_ += num_mutations;
+  memory_.Resize(static_cast<std::int64_t>(outstanding_size_));
+  return true;
+}
+
+void MutationAdmissionBudget::Release(std::size_t request_size,
+                                      std::size_t num_mutations) {
+  std::lock_guard<std::mutex> lk(mu_);
+  outstanding_size_ -= request_size;
+  outstanding_mutations_ -= num_mutations;
+  memory_.Resize(static_cast<std::int64_t>(outstanding_size_));
+}
+
+std::size_t MutationAdmissionBudget::outstanding_size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return outstanding_size_;
+}
+
+std::size_t MutationAdmissionBudget::outstanding_mutations() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return outstanding_mutations_;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
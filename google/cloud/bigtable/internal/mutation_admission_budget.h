@@ -0,0 +1,75 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MUTATION_ADMISSION_BUDGET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MUTATION_ADMISSION_BUDGET_H
+
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/memory_accountant.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Track the mutations admitted by one or more `MutationBatcher` objects.
+ *
+ * A `MutationBatcher` admits a mutation only if it fits the outstanding size
+ * and mutation count limits. When several batchers share the same budget the
+ * limits apply to their combined mutations.
+ *
+ * The outstanding size is also reported to the memory account, if any. While
+ * its accountant is over the soft limit only the first mutation is admitted.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use concurrently from multiple threads.
+ * The critical sections are small, so they are cheaper than the lock of a
+ * `MutationBatcher`.
+ */
+class MutationAdmissionBudget {
+ public:
+  MutationAdmissionBudget(
+      std::size_t max_outstanding_size, std::size_t max_outstanding_mutations,
+      std::shared_ptr<google::cloud::MemoryAccount> memory_account = {});
+
+  /// Reserve space for a mutation, returns false if it does not fit.
+  bool TryAcquire(std::size_t request_size, std::size_t num_mutations);
+
+  /// Return the space reserved by one or more calls to `TryAcquire()`.
+  void Release(std::size_t request_size, std::size_t num_mutations);
+
+  std::size_t outstanding_size() const;
+  std::size_t outstanding_mutations() const;
+
+ private:
+  std::size_t const max_outstanding_size_;
+  std::size_t const max_outstanding_mutations_;
+  mutable std::mutex mu_;
+  std::size_t outstanding_size_ = 0;
+  std::size_t outstanding_mutations_ = 0;
+  google::cloud::internal::MemoryReservation memory_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MUTATION_ADMISSION_BUDGET_H
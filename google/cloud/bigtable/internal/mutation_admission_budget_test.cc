@@ -0,0 +1,93 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/mutation_admission_budget.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(MutationAdmissionBudgetTest, SizeLimit) {
+  MutationAdmissionBudget budget(100, 10);
+  EXPECT_TRUE(budget.TryAcquire(60, 1));
+  EXPECT_FALSE(budget.TryAcquire(60, 1));
+  EXPECT_TRUE(budget.TryAcquire(40, 1));
+  EXPECT_EQ(100, budget.outstanding_size());
+  EXPECT_EQ(2, budget.outstanding_mutations());
+
+  budget.Release(60, 1);
+  EXPECT_EQ(40, budget.outstanding_size());
+  EXPECT_EQ(1, budget.outstanding_mutations());
+  EXPECT_TRUE(budget.TryAcquire(60, 1));
+}
+
+TEST(MutationAdmissionBudgetTest, MutationsLimit) {
+  MutationAdmissionBudget budget(100, 3);
+  EXPECT_TRUE(budget.TryAcquire(1, 2));
+  // A failed call does not reserve anything.
+  EXPECT_FALSE(budget.TryAcquire(1, 2));
+  EXPECT_EQ(1, budget.outstanding_size());
+  EXPECT_EQ(2, budget.outstanding_mutations());
+  EXPECT_TRUE(budget.TryAcquire(1, 1));
+  EXPECT_FALSE(budget.TryAcquire(0, 1));
+}
+
+TEST(MutationAdmissionBudgetTest, MemorySoftLimit) {
+  auto accountant = std::make_shared<MemoryAccountant>(100);
+  auto other = accountant->CreateAccount("other");
+  MutationAdmissionBudget budget(1000, 10, accountant->CreateAccount("test"));
+  EXPECT_TRUE(budget.TryAcquire(60, 1));
+  EXPECT_EQ(60, accountant->bytes());
+  other->Add(50);
+  EXPECT_FALSE(budget.TryAcquire(10, 1));
+  // The first mutation is admitted even over the soft limit.
+  budget.Release(60, 1);
+  EXPECT_TRUE(budget.TryAcquire(200, 1));
+  EXPECT_EQ(250, accountant->bytes());
+  budget.Release(200, 1);
+  EXPECT_EQ(50, accountant->bytes());
+}
+
+TEST(MutationAdmissionBudgetTest, ConcurrentUsersNeverExceedTheLimits) {
+  auto constexpr kThreads = 8;
+  auto constexpr kIterations = 10000;
+  MutationAdmissionBudget budget(5, 5);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&budget] {
+      for (int i = 0; i != kIterations; ++i) {
+        if (!budget.TryAcquire(1, 1)) continue;
+        EXPECT_LE(budget.outstanding_size(), 5);
+        EXPECT_LE(budget.outstanding_mutations(), 5);
+        budget.Release(1, 1);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(0, budget.outstanding_size());
+  EXPECT_EQ(0, budget.outstanding_mutations());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,91 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/read_row_hedger.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+ReadRowHedger::ReadRowHedger(ReadRowHedgingOptions options)
+    : options_(std::move(options)),
+      // Computing the percentile is O(n), do it after each 10% of the window
+      // is replaced, not after every read.
+      update_period_((std::max)(std::size_t{1}, options_.sample_size / 10)),
+      delay_(options_.delay.count() != 0 ? options_.delay
+                                          : options_.initial_delay),
+      tokens_(options_.max_budget_tokens) {
+  samples_.reserve(options_.sample_size);
+}
+
+std::chrono::microseconds ReadRowHedger::StartRead() {
+  std::lock_guard<std::mutex> lk(mu_);
+  ++stats_.reads;
+  tokens_ = (std::min)(options_.max_budget_tokens,
+                       tokens_ + options_.budget_ratio);
+  return delay_;
+}
+
+bool ReadRowHedger::TryHedge() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (tokens_ < 1.0) {
+    ++stats_.budget_exhausted;
+    return false;
+  }
+  tokens_ -= 1.0;
+  ++stats_.hedged;
+  return true;
+}
+
+void ReadRowHedger::OnReadComplete(std::chrono::microseconds latency,
+                                   bool hedge_won) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (hedge_won) ++stats_.hedge_wins;
+  if (options_.delay.count() != 0 || options_.sample_size == 0) return;
+  if (samples_.size() < options_.sample_size) {
+    samples_.push_back(latency);
+  } else {
+    samples_[next_sample_] = latency;
+    next_sample_ = (next_sample_ + 1) % samples_.size();
+  }
+  if (++since_update_ < update_period_) return;
+  since_update_ = 0;
+  UpdateDelay();
+}
+
+ReadRowHedgingStats ReadRowHedger::stats() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto stats = stats_;
+  stats.current_delay = delay_;
+  return stats;
+}
+
+void ReadRowHedger::UpdateDelay() {
+  auto sorted = samples_;
+  auto const p = (std::min)(100.0, (std::max)(0.0, options_.percentile));
+  auto const index = (std::min)(
+      sorted.size() - 1,
+      static_cast<std::size_t>(p / 100.0 * static_cast<double>(sorted.size())));
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  delay_ = (std::max)(options_.min_delay, sorted[index]);
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
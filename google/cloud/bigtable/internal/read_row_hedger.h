@@ -0,0 +1,78 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROW_HEDGER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROW_HEDGER_H
+
+#include "google/cloud/bigtable/read_row_hedging_options.h"
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Decide when, and if, `Table::AsyncReadRow()` sends a hedged request.
+ *
+ * The hedger keeps a window with the latencies of the most recent reads, and
+ * periodically recomputes the configured percentile of these latencies. It
+ * also keeps the token bucket used to bound the number of hedged requests.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use concurrently from multiple threads.
+ */
+class ReadRowHedger {
+ public:
+  explicit ReadRowHedger(ReadRowHedgingOptions options);
+
+  /// Start a new read, return how long to wait before hedging it.
+  std::chrono::microseconds StartRead();
+
+  /// Return true if the budget allows sending a hedged request.
+  bool TryHedge();
+
+  /// Record the latency of a read, and whether the hedged request won.
+  void OnReadComplete(std::chrono::microseconds latency, bool hedge_won);
+
+  ReadRowHedgingStats stats() const;
+
+ private:
+  void UpdateDelay();
+
+  ReadRowHedgingOptions const options_;
+  std::size_t const update_period_;
+  mutable std::mutex mu_;
+  /// A circular buffer with the most recent latencies.
+  std::vector<std::chrono::microseconds> samples_;
+  std::size_t next_sample_ = 0;
+  std::size_t since_update_ = 0;
+  std::chrono::microseconds delay_;
+  double tokens_;
+  ReadRowHedgingStats stats_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROW_HEDGER_H
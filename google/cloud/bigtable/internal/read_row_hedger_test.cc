@@ -0,0 +1,102 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/read_row_hedger.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using us = std::chrono::microseconds;
+
+TEST(ReadRowHedgerTest, FixedDelay) {
+  ReadRowHedger hedger(ReadRowHedgingOptions{}.SetDelay(us(2000)));
+  EXPECT_EQ(us(2000), hedger.StartRead());
+  for (int i = 0; i != 1000; ++i) hedger.OnReadComplete(us(10), false);
+  EXPECT_EQ(us(2000), hedger.StartRead());
+}
+
+TEST(ReadRowHedgerTest, LearnsPercentile) {
+  ReadRowHedger hedger(ReadRowHedgingOptions{}
+                           .SetInitialDelay(us(5000))
+                           .SetMinDelay(us(1))
+                           .SetPercentile(90.0)
+                           .SetSampleSize(100));
+  EXPECT_EQ(us(5000), hedger.StartRead());
+  // Latencies 1, 2, ..., 100 microseconds, the p90 is 91.
+  for (int i = 1; i <= 100; ++i) hedger.OnReadComplete(us(i), false);
+  EXPECT_EQ(us(91), hedger.StartRead());
+  EXPECT_EQ(us(91), hedger.stats().current_delay);
+
+  // The old samples are replaced as new reads complete.
+  for (int i = 0; i != 100; ++i) hedger.OnReadComplete(us(7), false);
+  EXPECT_EQ(us(7), hedger.StartRead());
+}
+
+TEST(ReadRowHedgerTest, MinDelay) {
+  ReadRowHedger hedger(
+      ReadRowHedgingOptions{}.SetMinDelay(us(300)).SetSampleSize(10));
+  for (int i = 0; i != 10; ++i) hedger.OnReadComplete(us(5), false);
+  EXPECT_EQ(us(300), hedger.StartRead());
+}
+
+TEST(ReadRowHedgerTest, BudgetLimitsHedges) {
+  ReadRowHedger hedger(ReadRowHedgingOptions{}
+                           .SetBudgetRatio(0.1)
+                           .SetMaxBudgetTokens(2.0));
+  // The initial budget allows a short burst.
+  EXPECT_TRUE(hedger.TryHedge());
+  EXPECT_TRUE(hedger.TryHedge());
+  EXPECT_FALSE(hedger.TryHedge());
+
+  // Each read earns 0.1 tokens, so 10 reads allow one more hedge.
+  for (int i = 0; i != 9; ++i) hedger.StartRead();
+  EXPECT_FALSE(hedger.TryHedge());
+  hedger.StartRead();
+  hedger.StartRead();
+  EXPECT_TRUE(hedger.TryHedge());
+
+  // The budget never exceeds the maximum number of tokens.
+  for (int i = 0; i != 1000; ++i) hedger.StartRead();
+  EXPECT_TRUE(hedger.TryHedge());
+  EXPECT_TRUE(hedger.TryHedge());
+  EXPECT_FALSE(hedger.TryHedge());
+}
+
+TEST(ReadRowHedgerTest, Stats) {
+  ReadRowHedger hedger(ReadRowHedgingOptions{}.SetMaxBudgetTokens(1.0));
+  hedger.StartRead();
+  hedger.StartRead();
+  EXPECT_TRUE(hedger.TryHedge());
+  EXPECT_FALSE(hedger.TryHedge());
+  hedger.OnReadComplete(us(10), true);
+  hedger.OnReadComplete(us(10), false);
+
+  auto stats = hedger.stats();
+  EXPECT_EQ(2, stats.reads);
+  EXPECT_EQ(1, stats.hedged);
+  EXPECT_EQ(1, stats.hedge_wins);
+  EXPECT_EQ(1, stats.budget_exhausted);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,72 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/read_rows_flow_control.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+void ReadRowsFlowControl::Acquire(std::size_t bytes) {
+  std::lock_guard<std::mutex> lk(mu_);
+  outstanding_bytes_ += bytes;
+}
+
+void ReadRowsFlowControl::Release(std::size_t bytes) {
+  std::unique_lock<std::mutex> lk(mu_);
+  outstanding_bytes_ -= (std::min)(bytes, outstanding_bytes_);
+  if (outstanding_bytes_ >= options_.max_outstanding_bytes) return;
+  auto waiters = std::move(waiters_);
+  waiters_.clear();
+  lk.unlock();
+  // The streams resume reading from the continuations, do not hold the lock.
+  for (auto& w : waiters) w.set_value();
+}
+
+future<void> ReadRowsFlowControl::WaitForCapacity() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (outstanding_bytes_ < options_.max_outstanding_bytes) {
+    return make_ready_future();
+  }
+  ++paused_reads_;
+  waiters_.emplace_back();
+  return waiters_.back().get_future();
+}
+
+ReadRowsFlowControlStats ReadRowsFlowControl::stats() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  ReadRowsFlowControlStats stats;
+  stats.outstanding_bytes = outstanding_bytes_;
+  stats.paused_reads = paused_reads_;
+  return stats;
+}
+
+std::size_t RowBytes(Row const& row) {
+  auto bytes = row.row_key().size();
+  for (auto const& cell : row.cells()) {
+    bytes += cell.row_key().size() + cell.family_name().size() +
+             cell.column_qualifier().size() + cell.value().size();
+    for (auto const& label : cell.labels()) bytes += label.size();
+  }
+  return bytes;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,72 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROWS_FLOW_CONTROL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROWS_FLOW_CONTROL_H
+
+#include "google/cloud/bigtable/read_rows_flow_control_options.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * The memory budget shared by the `AsyncReadRows()` streams of a `Table`.
+ *
+ * The streams call `Acquire()` for each row they parse, and `Release()` once
+ * the application is done with it. Before reading the next response they wait
+ * on `WaitForCapacity()`.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use concurrently from multiple threads.
+ */
+class ReadRowsFlowControl {
+ public:
+  explicit ReadRowsFlowControl(ReadRowsFlowControlOptions options)
+      : options_(std::move(options)) {}
+
+  void Acquire(std::size_t bytes);
+  void Release(std::size_t bytes);
+
+  /// Satisfied once the outstanding rows fit in the budget.
+  future<void> WaitForCapacity();
+
+  ReadRowsFlowControlStats stats() const;
+
+ private:
+  ReadRowsFlowControlOptions const options_;
+  mutable std::mutex mu_;
+  std::size_t outstanding_bytes_ = 0;
+  std::int64_t paused_reads_ = 0;
+  std::vector<promise<void>> waiters_;
+};
+
+/// The approximate memory used by @p row, for flow control.
+std::size_t RowBytes(Row const& row);
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROWS_FLOW_CONTROL_H
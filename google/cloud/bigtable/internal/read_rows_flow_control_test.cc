@@ -0,0 +1,78 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/read_rows_flow_control.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+auto constexpr kNoWait = std::chrono::seconds(0);
+
+TEST(ReadRowsFlowControlTest, ReadyWithinBudget) {
+  ReadRowsFlowControl fc(
+      ReadRowsFlowControlOptions{}.SetMaxOutstandingBytes(10));
+  fc.Acquire(9);
+  auto f = fc.WaitForCapacity();
+  EXPECT_EQ(std::future_status::ready, f.wait_for(kNoWait));
+  EXPECT_EQ(9U, fc.stats().outstanding_bytes);
+  EXPECT_EQ(0, fc.stats().paused_reads);
+}
+
+TEST(ReadRowsFlowControlTest, PausedUntilRelease) {
+  ReadRowsFlowControl fc(
+      ReadRowsFlowControlOptions{}.SetMaxOutstandingBytes(10));
+  fc.Acquire(6);
+  fc.Acquire(6);
+  auto f1 = fc.WaitForCapacity();
+  auto f2 = fc.WaitForCapacity();
+  EXPECT_EQ(std::future_status::timeout, f1.wait_for(kNoWait));
+  EXPECT_EQ(std::future_status::timeout, f2.wait_for(kNoWait));
+  EXPECT_EQ(2, fc.stats().paused_reads);
+
+  // Still at the limit, the readers remain paused.
+  fc.Release(2);
+  EXPECT_EQ(std::future_status::timeout, f1.wait_for(kNoWait));
+
+  fc.Release(6);
+  EXPECT_EQ(std::future_status::ready, f1.wait_for(kNoWait));
+  EXPECT_EQ(std::future_status::ready, f2.wait_for(kNoWait));
+  EXPECT_EQ(4U, fc.stats().outstanding_bytes);
+}
+
+TEST(ReadRowsFlowControlTest, ReleaseDoesNotUnderflow) {
+  ReadRowsFlowControl fc(
+      ReadRowsFlowControlOptions{}.SetMaxOutstandingBytes(10));
+  fc.Acquire(3);
+  fc.Release(5);
+  EXPECT_EQ(0U, fc.stats().outstanding_bytes);
+}
+
+TEST(ReadRowsFlowControlTest, RowBytes) {
+  Row row("key", {Cell("key", "fam", "col", 0, "value", {"l1"}),
+                  Cell("key", "f", "c", 0, "v")});
+  // Row key, then each cell's row key, family, qualifier, value and labels.
+  EXPECT_EQ(3U + (3 + 3 + 3 + 5 + 2) + (3 + 1 + 1 + 1), RowBytes(row));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,245 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/readrowsbatchparser.h"
+#include "absl/memory/memory.h"
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+using google::bigtable::v2::ReadRowsResponse_CellChunk;
+
+void ReadRowsBatchParser::HandleResponse(ResponsePtr response,
+                                         grpc::Status& status) {
+  if (end_of_stream_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleResponse after end of stream");
+    return;
+  }
+  if (response->chunks().empty()) return;
+  storage_->responses.push_back(response);
+  if (row_in_progress_) row_responses_.push_back(response);
+  for (auto const& chunk : response->chunks()) {
+    HandleChunk(response, chunk, status);
+    if (!status.ok()) return;
+  }
+}
+
+void ReadRowsBatchParser::HandleChunk(ResponsePtr const& owner,
+                                      ReadRowsResponse_CellChunk const& chunk,
+                                      grpc::Status& status) {
+  if (!row_in_progress_) {
+    // The first cell may reuse the column family and qualifier from the
+    // previous row, keep them alive with the rest of the row.
+    row_in_progress_ = true;
+    if (family_owner_) row_responses_.push_back(family_owner_);
+    if (column_owner_) row_responses_.push_back(column_owner_);
+    row_responses_.push_back(owner);
+  }
+
+  if (!chunk.row_key().empty()) {
+    if (last_seen_row_key_.compare(chunk.row_key()) >= 0) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Row keys are expected in increasing order");
+      return;
+    }
+    cell_row_ = chunk.row_key();
+    row_owner_ = owner;
+  }
+
+  if (chunk.has_family_name()) {
+    if (!chunk.has_qualifier()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "New column family must specify qualifier");
+      return;
+    }
+    cell_family_ = chunk.family_name().value();
+    family_owner_ = owner;
+  }
+
+  if (chunk.has_qualifier()) {
+    cell_column_ = chunk.qualifier().value();
+    column_owner_ = owner;
+  }
+
+  if (cell_first_chunk_) {
+    cell_timestamp_ = chunk.timestamp_micros();
+  }
+
+  for (auto const& label : chunk.labels()) cell_labels_.emplace_back(label);
+
+  if (cell_first_chunk_ && chunk.value_size() == 0) {
+    // Most common case, the value is contained in a single chunk.
+    cell_value_ = chunk.value();
+  } else {
+    if (!cell_value_buffer_) {
+      cell_value_buffer_ = absl::make_unique<std::string>();
+      // This is a hint we get about the total size, use it to avoid
+      // reallocating the buffer.
+      if (chunk.value_size() > 0) {
+        cell_value_buffer_->reserve(
+            static_cast<std::size_t>(chunk.value_size()));
+      }
+    }
+    cell_value_buffer_->append(chunk.value());
+  }
+
+  cell_first_chunk_ = false;
+
+  // Last chunk in the cell has zero for value size
+  if (chunk.value_size() == 0) {
+    if (cells_.empty()) {
+      if (cell_row_.empty()) {
+        status = grpc::Status(grpc::StatusCode::INTERNAL,
+                              "Missing row key at last chunk in cell");
+        return;
+      }
+      row_key_ = cell_row_;
+    } else {
+      if (row_key_ != cell_row_) {
+        status = grpc::Status(grpc::StatusCode::INTERNAL,
+                              "Different row key in cell chunk");
+        return;
+      }
+    }
+    FinishCell();
+  }
+
+  if (chunk.reset_row()) {
+    bool const unfinished_cell = !cell_first_chunk_;
+    Reset();
+    if (unfinished_cell) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Reset row with an unfinished cell");
+      return;
+    }
+  } else if (chunk.commit_row()) {
+    if (!cell_first_chunk_) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Commit row with an unfinished cell");
+      return;
+    }
+    if (cells_.empty()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Commit row missing the row key");
+      return;
+    }
+    CommitRow();
+  }
+}
+
+void ReadRowsBatchParser::HandleEndOfStream(grpc::Status& status) {
+  if (end_of_stream_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleEndOfStream called twice");
+    return;
+  }
+  end_of_stream_ = true;
+
+  if (!cell_first_chunk_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "end of stream with unfinished cell");
+    return;
+  }
+
+  if (!cells_.empty()) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "end of stream with unfinished row");
+    return;
+  }
+}
+
+bool ReadRowsBatchParser::HasRows() const { return !row_ends_.empty(); }
+
+RowBatch ReadRowsBatchParser::TakeBatch() {
+  auto& cells = storage_->cells;
+  storage_->rows.reserve(row_ends_.size());
+  std::size_t begin = 0;
+  for (auto const end : row_ends_) {
+    storage_->rows.emplace_back(
+        cells[begin].row_key(),
+        absl::MakeConstSpan(cells.data() + begin, end - begin));
+    begin = end;
+  }
+  row_ends_.clear();
+  RowBatch batch(std::move(storage_));
+
+  // The next batch must keep alive any responses referenced by the partial
+  // row, or by the column family and qualifier the next row may reuse.
+  storage_ = std::make_shared<internal::RowBatchStorage>();
+  if (row_in_progress_) {
+    storage_->responses = row_responses_;
+  } else {
+    if (family_owner_) storage_->responses.push_back(family_owner_);
+    if (column_owner_) storage_->responses.push_back(column_owner_);
+  }
+  return batch;
+}
+
+void ReadRowsBatchParser::FinishCell() {
+  if (cell_value_buffer_) {
+    cell_value_ = *cell_value_buffer_;
+    values_.push_back(std::move(cell_value_buffer_));
+  }
+  cells_.emplace_back(cell_row_, cell_family_, cell_column_, cell_timestamp_,
+                      cell_value_, std::move(cell_labels_));
+  cell_value_ = {};
+  cell_labels_ = {};
+  cell_first_chunk_ = true;
+}
+
+void ReadRowsBatchParser::Reset() {
+  cells_.clear();
+  values_.clear();
+  row_responses_.clear();
+  row_in_progress_ = false;
+  row_key_ = {};
+  cell_row_ = {};
+  cell_family_ = {};
+  cell_column_ = {};
+  cell_timestamp_ = 0;
+  cell_value_ = {};
+  cell_value_buffer_.reset();
+  cell_labels_.clear();
+  family_owner_.reset();
+  column_owner_.reset();
+  row_owner_.reset();
+}
+
+void ReadRowsBatchParser::CommitRow() {
+  auto& s = *storage_;
+  s.cells.insert(s.cells.end(), std::make_move_iterator(cells_.begin()),
+                 std::make_move_iterator(cells_.end()));
+  s.values.insert(s.values.end(), std::make_move_iterator(values_.begin()),
+                  std::make_move_iterator(values_.end()));
+  row_ends_.push_back(s.cells.size());
+  cells_.clear();
+  values_.clear();
+  row_responses_.clear();
+  row_in_progress_ = false;
+
+  last_seen_row_key_ = row_key_;
+  last_seen_owner_ = std::move(row_owner_);
+  row_key_ = {};
+  cell_row_ = {};
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,141 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READROWSBATCHPARSER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READROWSBATCHPARSER_H
+
+#include "google/cloud/bigtable/row_batch.h"
+#include "google/cloud/bigtable/version.h"
+#include "absl/strings/string_view.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Transforms a stream of ReadRows responses into batches of row views.
+ *
+ * This parser applies the same rules as `ReadRowsParser`, but it does not copy
+ * the row keys, column families, qualifiers, or values out of the chunks.
+ * Instead, the `RowBatch` returned by `TakeBatch()` shares ownership of the
+ * responses and its `CellView` objects refer to the strings in them. Only the
+ * values split across multiple chunks are copied, as they must be reassembled.
+ *
+ * A simplified example of correctly using this class:
+ *
+ * @code
+ * while (stream.Read(response)) {
+ *   parser.HandleResponse(std::move(response), status);
+ *   if (parser.HasRows()) {
+ *     batch = parser.TakeBatch();  // the batch keeps `response` alive
+ *   }
+ * }
+ * parser.HandleEndOfStream(status);
+ * @endcode
+ *
+ * As with `ReadRowsParser`, a separate parser must be used for each stream.
+ */
+class ReadRowsBatchParser {
+ public:
+  using ResponsePtr =
+      std::shared_ptr<google::bigtable::v2::ReadRowsResponse const>;
+
+  ReadRowsBatchParser()
+      : storage_(std::make_shared<internal::RowBatchStorage>()) {}
+
+  virtual ~ReadRowsBatchParser() = default;
+
+  /// Parse all the chunks in @p response.
+  virtual void HandleResponse(ResponsePtr response, grpc::Status& status);
+
+  /// Signal that the input stream reached the end.
+  virtual void HandleEndOfStream(grpc::Status& status);
+
+  /// True if the data parsed since the last `TakeBatch()` has complete rows.
+  virtual bool HasRows() const;
+
+  /**
+   * Extract the complete rows parsed since the last call.
+   *
+   * Any partial row remains in the parser, and it is returned by a future
+   * call once its last chunk is received.
+   */
+  virtual RowBatch TakeBatch();
+
+  /// The key of the last complete row, empty if there is none.
+  absl::string_view last_row_key() const { return last_seen_row_key_; }
+
+ private:
+  void HandleChunk(
+      ResponsePtr const& owner,
+      google::bigtable::v2::ReadRowsResponse_CellChunk const& chunk,
+      grpc::Status& status);
+
+  /// Move the cell fields into a `CellView` in the current row.
+  void FinishCell();
+  void Reset();
+  void CommitRow();
+
+  /// Holds the complete rows and the buffers they reference.
+  std::shared_ptr<internal::RowBatchStorage> storage_;
+  /// The end of each complete row in `storage_->cells`.
+  std::vector<std::size_t> row_ends_;
+
+  /// Parsed cells of a yet unfinished row.
+  std::vector<CellView> cells_;
+  /// The reassembled values referenced by `cells_`.
+  std::vector<std::unique_ptr<std::string>> values_;
+  /// The responses referenced by `cells_` and the current cell.
+  std::vector<ResponsePtr> row_responses_;
+  bool row_in_progress_{false};
+  absl::string_view row_key_;
+
+  /// The fields of the current cell, these are views into the responses.
+  absl::string_view cell_row_;
+  absl::string_view cell_family_;
+  absl::string_view cell_column_;
+  std::int64_t cell_timestamp_{0};
+  absl::string_view cell_value_;
+  std::unique_ptr<std::string> cell_value_buffer_;
+  std::vector<absl::string_view> cell_labels_;
+  /// The responses holding `cell_family_` and `cell_column_`, these may be
+  /// reused by the next row.
+  ResponsePtr family_owner_;
+  ResponsePtr column_owner_;
+  ResponsePtr row_owner_;
+
+  /// Is the next incoming chunk the first in a cell?
+  bool cell_first_chunk_{true};
+
+  /// The key of the last complete row, and the response holding it.
+  absl::string_view last_seen_row_key_;
+  ResponsePtr last_seen_owner_;
+
+  /// Have we received the end of stream call?
+  bool end_of_stream_{false};
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READROWSBATCHPARSER_H
@@ -0,0 +1,282 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/readrowsbatchparser.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/arena.h>
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <sstream>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::bigtable::v2::ReadRowsResponse;
+using ::google::bigtable::v2::ReadRowsResponse_CellChunk;
+using ::google::cloud::testing_util::IsOk;
+using ::testing::ElementsAre;
+using ::testing::Not;
+
+using ResponsePtr = ReadRowsBatchParser::ResponsePtr;
+
+/// Create a response in its own arena, as `RowBatchReader` does.
+ResponsePtr MakeResponse(std::vector<std::string> const& chunk_strings) {
+  using google::protobuf::TextFormat;
+  auto arena = std::make_shared<google::protobuf::Arena>();
+  auto* response =
+      google::protobuf::Arena::CreateMessage<ReadRowsResponse>(arena.get());
+  for (auto const& s : chunk_strings) {
+    if (!TextFormat::ParseFromString(s, response->add_chunks())) return {};
+  }
+  return ResponsePtr(std::move(arena), response);
+}
+
+std::string CellToString(CellView const& c) {
+  std::ostringstream os;
+  os << "rk: " << c.row_key() << "\n";
+  os << "fm: " << c.family_name() << "\n";
+  os << "qual: " << c.column_qualifier() << "\n";
+  os << "ts: " << c.timestamp().count() << "\n";
+  os << "value: " << c.value() << "\n";
+  os << "label: ";
+  char const* del = "";
+  for (auto const& label : c.labels()) {
+    os << del << label;
+    del = ",";
+  }
+  os << "\n";
+  return os.str();
+}
+
+TEST(ReadRowsBatchParserTest, NoChunksNoRowsSucceeds) {
+  grpc::Status status;
+  ReadRowsBatchParser parser;
+
+  EXPECT_FALSE(parser.HasRows());
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_FALSE(parser.HasRows());
+  EXPECT_TRUE(parser.TakeBatch().empty());
+}
+
+TEST(ReadRowsBatchParserTest, HandleEndOfStreamCalledTwiceFails) {
+  ReadRowsBatchParser parser;
+  grpc::Status status;
+  parser.HandleEndOfStream(status);
+  parser.HandleEndOfStream(status);
+  EXPECT_FALSE(status.ok());
+}
+
+TEST(ReadRowsBatchParserTest, HandleResponseAfterEndOfStreamFails) {
+  ReadRowsBatchParser parser;
+  grpc::Status status;
+  parser.HandleEndOfStream(status);
+  parser.HandleResponse(MakeResponse({R"(value_size: 1)"}), status);
+  EXPECT_FALSE(status.ok());
+  EXPECT_FALSE(parser.HasRows());
+}
+
+TEST(ReadRowsBatchParserTest, ManyRowsInOneResponse) {
+  auto response = MakeResponse({
+      R"(row_key: "r1" family_name: < value: "F"> qualifier: < value: "C1">
+         timestamp_micros: 10 value: "v1" commit_row: true)",
+      R"(row_key: "r2" qualifier: < value: "C2">
+         timestamp_micros: 20 value: "v2")",
+      R"(qualifier: < value: "C3"> timestamp_micros: 30 value: "v3"
+         labels: "L1" labels: "L2" commit_row: true)",
+  });
+  ASSERT_TRUE(response);
+  auto const* buffer = response->chunks(0).value().data();
+
+  ReadRowsBatchParser parser;
+  grpc::Status status;
+  parser.HandleResponse(std::move(response), status);
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasRows());
+  EXPECT_EQ("r2", parser.last_row_key());
+  auto batch = parser.TakeBatch();
+  EXPECT_FALSE(parser.HasRows());
+
+  ASSERT_EQ(2, batch.size());
+  auto const& r1 = batch.rows()[0];
+  EXPECT_EQ("r1", r1.row_key());
+  ASSERT_EQ(1, r1.cells().size());
+  EXPECT_EQ("v1", r1.cells()[0].value());
+  // The value is not copied out of the response.
+  EXPECT_EQ(buffer, r1.cells()[0].value().data());
+
+  auto const& r2 = batch.rows()[1];
+  EXPECT_EQ("r2", r2.row_key());
+  ASSERT_EQ(2, r2.cells().size());
+  EXPECT_EQ("F", r2.cells()[0].family_name());
+  EXPECT_EQ("C2", r2.cells()[0].column_qualifier());
+  EXPECT_EQ(20, r2.cells()[0].timestamp().count());
+  EXPECT_EQ("F", r2.cells()[1].family_name());
+  EXPECT_EQ("C3", r2.cells()[1].column_qualifier());
+  EXPECT_THAT(r2.cells()[1].labels(), ElementsAre("L1", "L2"));
+
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(ReadRowsBatchParserTest, RowSpansResponsesAndOutlivesParser) {
+  RowBatch batch;
+  {
+    ReadRowsBatchParser parser;
+    grpc::Status status;
+    parser.HandleResponse(
+        MakeResponse({R"(row_key: "r1" family_name: < value: "F">
+                         qualifier: < value: "C"> value: "v1"
+                         commit_row: true)",
+                      R"(row_key: "r2" qualifier: < value: "C1">
+                         value: "v2")"}),
+        status);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(parser.HasRows());
+    auto first = parser.TakeBatch();
+    ASSERT_EQ(1, first.size());
+    EXPECT_EQ("r1", first.rows()[0].row_key());
+
+    // The second row starts in the first response, including its first cell,
+    // and the last cell reuses the column family from the first row.
+    parser.HandleResponse(
+        MakeResponse({R"(qualifier: < value: "C2"> value: "part1-"
+                         value_size: 11)",
+                      R"(value: "part2" commit_row: true)"}),
+        status);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(parser.HasRows());
+    batch = parser.TakeBatch();
+    parser.HandleEndOfStream(status);
+    EXPECT_TRUE(status.ok());
+  }
+
+  ASSERT_EQ(1, batch.size());
+  auto const& row = batch.rows()[0];
+  EXPECT_EQ("r2", row.row_key());
+  ASSERT_EQ(2, row.cells().size());
+  EXPECT_EQ("F", row.cells()[0].family_name());
+  EXPECT_EQ("C1", row.cells()[0].column_qualifier());
+  EXPECT_EQ("v2", row.cells()[0].value());
+  EXPECT_EQ("r2", row.cells()[1].row_key());
+  EXPECT_EQ("F", row.cells()[1].family_name());
+  EXPECT_EQ("C2", row.cells()[1].column_qualifier());
+  EXPECT_EQ("part1-part2", row.cells()[1].value());
+
+  auto rows = batch.ToRows();
+  ASSERT_EQ(1, rows.size());
+  EXPECT_EQ("r2", rows[0].row_key());
+  ASSERT_EQ(2, rows[0].cells().size());
+  EXPECT_EQ("part1-part2", rows[0].cells()[1].value());
+}
+
+TEST(ReadRowsBatchParserTest, ResetRowDiscardsPartialRow) {
+  ReadRowsBatchParser parser;
+  grpc::Status status;
+  parser.HandleResponse(
+      MakeResponse({R"(row_key: "r1" family_name: < value: "F">
+                       qualifier: < value: "C"> value: "v1")",
+                    R"(reset_row: true)",
+                    R"(row_key: "r1" family_name: < value: "F">
+                       qualifier: < value: "C"> value: "v2"
+                       commit_row: true)"}),
+      status);
+  ASSERT_TRUE(status.ok());
+  auto batch = parser.TakeBatch();
+  ASSERT_EQ(1, batch.size());
+  ASSERT_EQ(1, batch.rows()[0].cells().size());
+  EXPECT_EQ("v2", batch.rows()[0].cells()[0].value());
+}
+
+TEST(ReadRowsBatchParserTest, FactoryCreatesBatchParser) {
+  ReadRowsParserFactory factory;
+  auto parser = factory.CreateBatchParser();
+  ASSERT_NE(nullptr, parser);
+  EXPECT_FALSE(parser->HasRows());
+}
+
+// **** Acceptance tests helpers ****
+class AcceptanceTest : public ::testing::Test {
+ protected:
+  std::vector<std::string> ExtractCells() {
+    std::vector<std::string> cells;
+    for (auto const& batch : batches_) {
+      for (auto const& r : batch.rows()) {
+        for (auto const& c : r.cells()) cells.push_back(CellToString(c));
+      }
+    }
+    return cells;
+  }
+
+  static std::vector<ReadRowsResponse_CellChunk> ConvertChunks(
+      std::vector<std::string> const& chunk_strings) {
+    using google::protobuf::TextFormat;
+
+    std::vector<ReadRowsResponse_CellChunk> chunks;
+    for (std::string const& chunk_string : chunk_strings) {
+      ReadRowsResponse_CellChunk chunk;
+      if (!TextFormat::ParseFromString(chunk_string, &chunk)) {
+        return {};
+      }
+      chunks.emplace_back(std::move(chunk));
+    }
+
+    return chunks;
+  }
+
+  // Send each chunk in a separate response, this exercises the code to keep
+  // the responses alive for rows that span multiple responses.
+  google::cloud::Status FeedChunks(
+      std::vector<ReadRowsResponse_CellChunk> const& chunks) {
+    grpc::Status status;
+    for (auto const& chunk : chunks) {
+      auto arena = std::make_shared<google::protobuf::Arena>();
+      auto* response =
+          google::protobuf::Arena::CreateMessage<ReadRowsResponse>(arena.get());
+      *response->add_chunks() = chunk;
+      parser_.HandleResponse(ResponsePtr(std::move(arena), response), status);
+      if (!status.ok()) {
+        return ::google::cloud::MakeStatusFromRpcError(status);
+      }
+      if (parser_.HasRows()) batches_.push_back(parser_.TakeBatch());
+    }
+    parser_.HandleEndOfStream(status);
+    if (!status.ok()) {
+      return ::google::cloud::MakeStatusFromRpcError(status);
+    }
+    return google::cloud::Status{};
+  }
+
+ private:
+  ReadRowsBatchParser parser_;
+  std::vector<RowBatch> batches_;
+};
+
+// Auto-generated acceptance tests
+#include "google/cloud/bigtable/internal/readrowsparser_acceptance_tests.inc"
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READROWSPARSER_H
 
 #include "google/cloud/bigtable/cell.h"
+#include "google/cloud/bigtable/internal/readrowsbatchparser.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/version.h"
 #include "absl/memory/memory.h"
@@ -131,6 +132,11 @@ class ReadRowsParserFactory {
   virtual std::unique_ptr<ReadRowsParser> Create() {
     return absl::make_unique<ReadRowsParser>();
   }
+
+  /// Returns a newly created parser for `RowBatchReader`.
+  virtual std::unique_ptr<ReadRowsBatchParser> CreateBatchParser() {
+    return absl::make_unique<ReadRowsBatchParser>();
+  }
 };
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
@@ -0,0 +1,103 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_cache.h"
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+RowCache::RowCache(RowCacheOptions options, Clock clock)
+    : options_(std::move(options)), clock_(std::move(clock)) {}
+
+absl::optional<std::pair<bool, Row>> RowCache::Lookup(
+    std::string const& row_key, std::string const& filter) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto row = index_.find(row_key);
+  if (row != index_.end()) {
+    auto f = row->second.find(filter);
+    if (f != row->second.end()) {
+      auto e = f->second;
+      if (clock_() < e->expiration) {
+        entries_.splice(entries_.begin(), entries_, e);
+        ++hits_;
+        return e->result;
+      }
+      Erase(e);
+    }
+  }
+  ++misses_;
+  return absl::nullopt;
+}
+
+std::uint64_t RowCache::generation() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return generation_;
+}
+
+void RowCache::Insert(std::string const& row_key, std::string const& filter,
+                      std::pair<bool, Row> result, std::uint64_t generation) {
+  if (options_.max_entries == 0) return;
+  auto const expiration = clock_() + options_.ttl;
+  std::lock_guard<std::mutex> lk(mu_);
+  if (generation != generation_) return;
+  auto& filters = index_[row_key];
+  auto f = filters.find(filter);
+  if (f != filters.end()) {
+    auto e = f->second;
+    e->result = std::move(result);
+    e->expiration = expiration;
+    entries_.splice(entries_.begin(), entries_, e);
+    return;
+  }
+  entries_.push_front(Entry{row_key, filter, std::move(result), expiration});
+  filters.emplace(filter, entries_.begin());
+  while (entries_.size() > options_.max_entries) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+void RowCache::Invalidate(std::string const& row_key) {
+  std::lock_guard<std::mutex> lk(mu_);
+  ++generation_;
+  auto row = index_.find(row_key);
+  if (row == index_.end()) return;
+  for (auto& f : row->second) entries_.erase(f.second);
+  index_.erase(row);
+}
+
+RowCacheStats RowCache::stats() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  RowCacheStats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.size = entries_.size();
+  return stats;
+}
+
+void RowCache::Erase(Entries::iterator e) {
+  auto row = index_.find(e->row_key);
+  row->second.erase(e->filter);
+  if (row->second.empty()) index_.erase(row);
+  entries_.erase(e);
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,105 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_CACHE_H
+
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_cache_options.h"
+#include "google/cloud/bigtable/version.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A LRU cache for the results of `Table::ReadRow()`.
+ *
+ * The results are keyed by the row key and a fingerprint of the filter, which
+ * is usually the serialized filter proto.
+ *
+ * A read that starts before a write to the same row may complete after the
+ * write, and its result would be stale. To prevent this, the caller captures
+ * `generation()` before starting a read, and `Insert()` discards the result if
+ * any row was invalidated since.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use concurrently from multiple threads.
+ */
+class RowCache {
+ public:
+  using Clock = std::function<std::chrono::steady_clock::time_point()>;
+
+  explicit RowCache(RowCacheOptions options,
+                    Clock clock = std::chrono::steady_clock::now);
+
+  /// Return the cached result, if present and not expired.
+  absl::optional<std::pair<bool, Row>> Lookup(std::string const& row_key,
+                                              std::string const& filter);
+
+  /// The value to pass to `Insert()` for reads started now.
+  std::uint64_t generation() const;
+
+  /// Cache the result of a read started at @p generation.
+  void Insert(std::string const& row_key, std::string const& filter,
+              std::pair<bool, Row> result, std::uint64_t generation);
+
+  /// Remove all the cached results for @p row_key.
+  void Invalidate(std::string const& row_key);
+
+  RowCacheStats stats() const;
+
+ private:
+  struct Entry {
+    std::string row_key;
+    std::string filter;
+    std::pair<bool, Row> result;
+    std::chrono::steady_clock::time_point expiration;
+  };
+  /// The most recently used entries are at the front.
+  using Entries = std::list<Entry>;
+  using Index = std::unordered_map<
+      std::string, std::unordered_map<std::string, Entries::iterator>>;
+
+  void Erase(Entries::iterator e);
+
+  RowCacheOptions const options_;
+  Clock const clock_;
+  mutable std::mutex mu_;
+  Entries entries_;
+  /// Map the row keys to the entries for each filter.
+  Index index_;
+  std::uint64_t generation_ = 0;
+  std::int64_t hits_ = 0;
+  std::int64_t misses_ = 0;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_CACHE_H
@@ -0,0 +1,131 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_cache.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ms = std::chrono::milliseconds;
+
+class RowCacheTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<RowCache> MakeCache(RowCacheOptions options) {
+    return absl::make_unique<RowCache>(std::move(options),
+                                       [this] { return now_; });
+  }
+
+  static std::pair<bool, Row> MakeResult(std::string row_key) {
+    return std::make_pair(
+        true, Row(row_key, {Cell(row_key, "fam", "col", 0, "value")}));
+  }
+
+  std::chrono::steady_clock::time_point now_ =
+      std::chrono::steady_clock::time_point{} + std::chrono::hours(1);
+};
+
+TEST_F(RowCacheTest, HitAfterInsert) {
+  auto cache = MakeCache(RowCacheOptions{});
+  EXPECT_FALSE(cache->Lookup("r1", "f").has_value());
+  cache->Insert("r1", "f", MakeResult("r1"), cache->generation());
+  auto cached = cache->Lookup("r1", "f");
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_TRUE(cached->first);
+  EXPECT_EQ("r1", cached->second.row_key());
+  ASSERT_EQ(1, cached->second.cells().size());
+
+  auto stats = cache->stats();
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(1, stats.misses);
+  EXPECT_EQ(1, stats.size);
+}
+
+TEST_F(RowCacheTest, MissingRowsAreCached) {
+  auto cache = MakeCache(RowCacheOptions{});
+  cache->Insert("r1", "f", std::make_pair(false, Row("", {})),
+               cache->generation());
+  auto cached = cache->Lookup("r1", "f");
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_FALSE(cached->first);
+}
+
+TEST_F(RowCacheTest, KeyedByFilter) {
+  auto cache = MakeCache(RowCacheOptions{});
+  cache->Insert("r1", "f1", MakeResult("r1"), cache->generation());
+  EXPECT_FALSE(cache->Lookup("r1", "f2").has_value());
+  EXPECT_TRUE(cache->Lookup("r1", "f1").has_value());
+}
+
+TEST_F(RowCacheTest, Expiration) {
+  auto cache = MakeCache(RowCacheOptions{}.SetTtl(ms(100)));
+  cache->Insert("r1", "f", MakeResult("r1"), cache->generation());
+  now_ += ms(99);
+  EXPECT_TRUE(cache->Lookup("r1", "f").has_value());
+  now_ += ms(1);
+  EXPECT_FALSE(cache->Lookup("r1", "f").has_value());
+  EXPECT_EQ(0, cache->stats().size);
+}
+
+TEST_F(RowCacheTest, EvictLeastRecentlyUsed) {
+  auto cache = MakeCache(RowCacheOptions{}.SetMaxEntries(2));
+  cache->Insert("r1", "f", MakeResult("r1"), cache->generation());
+  cache->Insert("r2", "f", MakeResult("r2"), cache->generation());
+  // Using "r1" makes "r2" the least recently used entry.
+  EXPECT_TRUE(cache->Lookup("r1", "f").has_value());
+  cache->Insert("r3", "f", MakeResult("r3"), cache->generation());
+  EXPECT_EQ(2, cache->stats().size);
+  EXPECT_TRUE(cache->Lookup("r1", "f").has_value());
+  EXPECT_FALSE(cache->Lookup("r2", "f").has_value());
+  EXPECT_TRUE(cache->Lookup("r3", "f").has_value());
+}
+
+TEST_F(RowCacheTest, DisabledWithZeroEntries) {
+  auto cache = MakeCache(RowCacheOptions{}.SetMaxEntries(0));
+  cache->Insert("r1", "f", MakeResult("r1"), cache->generation());
+  EXPECT_FALSE(cache->Lookup("r1", "f").has_value());
+}
+
+TEST_F(RowCacheTest, InvalidateRemovesAllFilters) {
+  auto cache = MakeCache(RowCacheOptions{});
+  cache->Insert("r1", "f1", MakeResult("r1"), cache->generation());
+  cache->Insert("r1", "f2", MakeResult("r1"), cache->generation());
+  cache->Insert("r2", "f1", MakeResult("r2"), cache->generation());
+  cache->Invalidate("r1");
+  EXPECT_FALSE(cache->Lookup("r1", "f1").has_value());
+  EXPECT_FALSE(cache->Lookup("r1", "f2").has_value());
+  EXPECT_TRUE(cache->Lookup("r2", "f1").has_value());
+  EXPECT_EQ(1, cache->stats().size);
+}
+
+TEST_F(RowCacheTest, DiscardReadsStartedBeforeInvalidate) {
+  auto cache = MakeCache(RowCacheOptions{});
+  auto const generation = cache->generation();
+  cache->Invalidate("r1");
+  cache->Insert("r1", "f", MakeResult("r1"), generation);
+  EXPECT_FALSE(cache->Lookup("r1", "f").has_value());
+  cache->Insert("r1", "f", MakeResult("r1"), cache->generation());
+  EXPECT_TRUE(cache->Lookup("r1", "f").has_value());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
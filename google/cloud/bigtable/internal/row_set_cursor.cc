@@ -0,0 +1,129 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_set_cursor.h"
+#include "google/cloud/bigtable/internal/google_bytes_traits.h"
+#include "google/cloud/bigtable/row_range.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+namespace btproto = ::google::bigtable::v2;
+
+bool HasEnd(btproto::RowRange const& r) {
+  return r.end_key_case() != btproto::RowRange::END_KEY_NOT_SET;
+}
+
+std::string const& EndKey(btproto::RowRange const& r) {
+  return r.end_key_case() == btproto::RowRange::kEndKeyOpen
+             ? r.end_key_open()
+             : r.end_key_closed();
+}
+
+/// Return true if the range @p r contains no keys after @p key.
+bool EndsAtOrBefore(btproto::RowRange const& r, RowKeyType const& key) {
+  return HasEnd(r) && CompareRowKey(EndKey(r), key) <= 0;
+}
+
+/// Return true if the range @p r may contain keys at or before @p key.
+bool StartsAtOrBefore(btproto::RowRange const& r, RowKeyType const& key) {
+  switch (r.start_key_case()) {
+    case btproto::RowRange::kStartKeyClosed:
+      return CompareRowKey(r.start_key_closed(), key) <= 0;
+    case btproto::RowRange::kStartKeyOpen:
+      return CompareRowKey(r.start_key_open(), key) < 0;
+    case btproto::RowRange::START_KEY_NOT_SET:
+      break;
+  }
+  return true;
+}
+
+}  // namespace
+
+RowSetCursor::RowSetCursor(RowSet row_set) {
+  // Sort the keys and ranges, and merge any overlapping ranges.
+  row_set.Normalize();
+  rows_ = std::move(row_set).as_proto();
+  auto& keys = *rows_.mutable_row_keys();
+  auto& ranges = *rows_.mutable_row_ranges();
+  if (keys.empty() && ranges.empty()) {
+    all_rows_ = true;
+    return;
+  }
+  if (keys.empty() && RowRange(ranges.Get(0)).IsEmpty()) {
+    SetEmpty();
+    return;
+  }
+
+  // Reverse the order, the rows already returned are at the end. Only the
+  // pointers are moved, the strings are not copied.
+  std::reverse(keys.pointer_begin(), keys.pointer_end());
+  std::reverse(ranges.pointer_begin(), ranges.pointer_end());
+}
+
+void RowSetCursor::Advance(RowKeyType const& last_key) {
+  if (empty_) return;
+  if (all_rows_) {
+    all_rows_ = false;
+    rows_.add_row_ranges()->set_start_key_open(last_key);
+    return;
+  }
+
+  auto& keys = *rows_.mutable_row_keys();
+  auto k = std::partition_point(
+      keys.begin(), keys.end(),
+      [&last_key](std::string const& key) {
+        return CompareRowKey(key, last_key) > 0;
+      });
+  auto const keys_left = static_cast<int>(std::distance(keys.begin(), k));
+  keys.DeleteSubrange(keys_left, keys.size() - keys_left);
+
+  auto& ranges = *rows_.mutable_row_ranges();
+  auto r = std::partition_point(
+      ranges.begin(), ranges.end(), [&last_key](btproto::RowRange const& r) {
+        return !EndsAtOrBefore(r, last_key);
+      });
+  auto const ranges_left = static_cast<int>(std::distance(ranges.begin(), r));
+  ranges.DeleteSubrange(ranges_left, ranges.size() - ranges_left);
+
+  // Trim the ranges that start before `last_key`. The ranges do not overlap,
+  // so only the last range can start before `last_key`.
+  if (!ranges.empty()) {
+    auto& range = *ranges.Mutable(ranges.size() - 1);
+    if (StartsAtOrBefore(range, last_key)) {
+      range.set_start_key_open(last_key);
+      if (RowRange(range).IsEmpty()) ranges.RemoveLast();
+    }
+  }
+
+  if (keys.empty() && ranges.empty()) SetEmpty();
+}
+
+void RowSetCursor::SetEmpty() {
+  empty_ = true;
+  rows_.Clear();
+  // An empty `RowSet` means "all rows", use an empty range instead.
+  *rows_.add_row_ranges() = RowRange::Empty().as_proto();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,78 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_SET_CURSOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_SET_CURSOR_H
+
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/version.h"
+#include <google/bigtable/v2/data.pb.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * The rows not yet returned by a `ReadRows()` stream.
+ *
+ * When a stream is interrupted it is resumed with the rows after the last row
+ * received. `RowSet::Intersect()` copies and scans every key and range to
+ * compute this set, which is expensive for sets with many keys, and it must be
+ * done on each retry.
+ *
+ * This class normalizes the row set once (see `RowSet::Normalize()`), and
+ * keeps the keys and ranges in the reverse order of the stream. The keys and
+ * ranges already returned are at the end of the repeated fields, they are
+ * found with a binary search and removed without any copies. The ranges do not
+ * overlap, so at most one range needs to be trimmed.
+ */
+class RowSetCursor {
+ public:
+  explicit RowSetCursor(RowSet row_set);
+
+  /// Remove the keys, and parts of ranges, up to and including @p last_key.
+  void Advance(RowKeyType const& last_key);
+
+  /// Returns true if no rows remain, see `RowSet::IsEmpty()`.
+  bool IsEmpty() const { return empty_; }
+
+  /// The remaining rows, in the format used by `ReadRowsRequest`.
+  ::google::bigtable::v2::RowSet const& as_proto() const { return rows_; }
+
+  /**
+   * Exchange the remaining rows with @p rows.
+   *
+   * The readers swap the rows into the request before starting a stream, and
+   * back once the request is sent, to avoid copying them.
+   */
+  void Swap(::google::bigtable::v2::RowSet& rows) { rows_.Swap(&rows); }
+
+ private:
+  void SetEmpty();
+
+  ::google::bigtable::v2::RowSet rows_;
+  /// A default constructed `RowSet` represents all the rows in the table.
+  bool all_rows_ = false;
+  bool empty_ = false;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_SET_CURSOR_H
@@ -0,0 +1,153 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_set_cursor.h"
+#include <gmock/gmock.h>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+namespace btproto = ::google::bigtable::v2;
+
+/// Return the keys in @p keys that would be returned by a read of @p rows.
+std::vector<std::string> Filter(btproto::RowSet const& rows,
+                                std::vector<std::string> const& keys) {
+  std::set<std::string> result;
+  for (auto const& k : keys) {
+    if (rows.row_keys().empty() && rows.row_ranges().empty()) {
+      result.insert(k);
+      continue;
+    }
+    for (auto const& r : rows.row_keys()) {
+      if (r == k) result.insert(k);
+    }
+    for (auto const& r : rows.row_ranges()) {
+      if (RowRange(r).Contains(k)) result.insert(k);
+    }
+  }
+  return {result.begin(), result.end()};
+}
+
+TEST(RowSetCursorTest, AllRows) {
+  RowSetCursor cursor{RowSet()};
+  EXPECT_FALSE(cursor.IsEmpty());
+  EXPECT_EQ(0, cursor.as_proto().row_keys_size());
+  EXPECT_EQ(0, cursor.as_proto().row_ranges_size());
+
+  cursor.Advance("b");
+  EXPECT_FALSE(cursor.IsEmpty());
+  ASSERT_EQ(1, cursor.as_proto().row_ranges_size());
+  EXPECT_EQ("b", cursor.as_proto().row_ranges(0).start_key_open());
+
+  cursor.Advance("c");
+  EXPECT_FALSE(cursor.IsEmpty());
+  ASSERT_EQ(1, cursor.as_proto().row_ranges_size());
+  EXPECT_EQ("c", cursor.as_proto().row_ranges(0).start_key_open());
+}
+
+TEST(RowSetCursorTest, Keys) {
+  RowSetCursor cursor(RowSet("d", "a", "c", "b", "e"));
+  EXPECT_FALSE(cursor.IsEmpty());
+  EXPECT_EQ(5, cursor.as_proto().row_keys_size());
+
+  cursor.Advance("b");
+  EXPECT_THAT(cursor.as_proto().row_keys(),
+              ::testing::UnorderedElementsAre("c", "d", "e"));
+  cursor.Advance("c0");
+  EXPECT_THAT(cursor.as_proto().row_keys(),
+              ::testing::UnorderedElementsAre("d", "e"));
+  EXPECT_FALSE(cursor.IsEmpty());
+  cursor.Advance("e");
+  EXPECT_TRUE(cursor.IsEmpty());
+  EXPECT_TRUE(RowRange(cursor.as_proto().row_ranges(0)).IsEmpty());
+}
+
+TEST(RowSetCursorTest, DisjointRanges) {
+  RowSetCursor cursor(RowSet(RowRange::Range("m", "p"),
+                             RowRange::Closed("a", "c"),
+                             RowRange::StartingAt("x"), "e"));
+  cursor.Advance("b");
+  auto const& rows = cursor.as_proto();
+  EXPECT_THAT(rows.row_keys(), ::testing::ElementsAre("e"));
+  ASSERT_EQ(3, rows.row_ranges_size());
+  std::vector<std::string> const keys{"a",  "b", "b0", "c",  "c0", "e",
+                                      "m",  "o", "p",  "p0", "x",  "z"};
+  EXPECT_THAT(Filter(rows, keys),
+              ::testing::ElementsAre("b0", "c", "e", "m", "o", "x", "z"));
+
+  cursor.Advance("n");
+  EXPECT_THAT(Filter(cursor.as_proto(), keys),
+              ::testing::ElementsAre("o", "x", "z"));
+  EXPECT_EQ(0, cursor.as_proto().row_keys_size());
+  EXPECT_EQ(2, cursor.as_proto().row_ranges_size());
+
+  cursor.Advance("y");
+  EXPECT_FALSE(cursor.IsEmpty());
+  EXPECT_THAT(Filter(cursor.as_proto(), keys), ::testing::ElementsAre("z"));
+}
+
+TEST(RowSetCursorTest, OverlappingRanges) {
+  RowSetCursor cursor(RowSet(RowRange::Closed("a", "m"),
+                             RowRange::Closed("c", "e"),
+                             RowRange::RightOpen("b", "z")));
+  std::vector<std::string> const keys{"a", "b", "c", "d", "e",
+                                      "f", "m", "n", "z"};
+  cursor.Advance("c");
+  EXPECT_THAT(Filter(cursor.as_proto(), keys),
+              ::testing::ElementsAre("d", "e", "f", "m", "n"));
+  cursor.Advance("m");
+  EXPECT_THAT(Filter(cursor.as_proto(), keys), ::testing::ElementsAre("n"));
+  EXPECT_EQ(1, cursor.as_proto().row_ranges_size());
+  cursor.Advance("y");
+  EXPECT_FALSE(cursor.IsEmpty());
+  cursor.Advance("z");
+  EXPECT_TRUE(cursor.IsEmpty());
+}
+
+TEST(RowSetCursorTest, TrimmedRangeBecomesEmpty) {
+  RowSetCursor cursor(RowSet(RowRange::RightOpen("a", std::string("b\0", 2))));
+  EXPECT_FALSE(cursor.IsEmpty());
+  cursor.Advance("b");
+  EXPECT_TRUE(cursor.IsEmpty());
+}
+
+TEST(RowSetCursorTest, OnlyEmptyRanges) {
+  RowSetCursor cursor(RowSet(RowRange::Empty()));
+  EXPECT_TRUE(cursor.IsEmpty());
+  ASSERT_EQ(1, cursor.as_proto().row_ranges_size());
+  EXPECT_TRUE(RowRange(cursor.as_proto().row_ranges(0)).IsEmpty());
+}
+
+TEST(RowSetCursorTest, Swap) {
+  RowSetCursor cursor(RowSet("a", "b"));
+  btproto::RowSet rows;
+  cursor.Swap(rows);
+  EXPECT_EQ(2, rows.row_keys_size());
+  EXPECT_EQ(0, cursor.as_proto().row_keys_size());
+  cursor.Swap(rows);
+  EXPECT_EQ(0, rows.row_keys_size());
+  EXPECT_EQ(2, cursor.as_proto().row_keys_size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
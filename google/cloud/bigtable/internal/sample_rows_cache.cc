@@ -0,0 +1,114 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/sample_rows_cache.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+std::shared_ptr<SampleRowsCache> SampleRowsCache::Create(
+    CompletionQueue cq, Fetcher fetcher, SampleRowsCacheOptions options,
+    Clock clock) {
+  std::shared_ptr<SampleRowsCache> cache(
+      new SampleRowsCache(std::move(cq), std::move(fetcher),
+                          std::move(options), std::move(clock)));
+  cache->Refresh();
+  return cache;
+}
+
+SampleRowsCache::SampleRowsCache(CompletionQueue cq, Fetcher fetcher,
+                                 SampleRowsCacheOptions options, Clock clock)
+    : cq_(std::move(cq)),
+      fetcher_(std::move(fetcher)),
+      options_(std::move(options)),
+      clock_(std::move(clock)) {}
+
+future<StatusOr<SampleRowsCache::Samples>> SampleRowsCache::AsyncGet() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (has_samples_ && clock_() - fetched_at_ <= options_.max_age) {
+    ++stats_.hits;
+    return make_ready_future(StatusOr<Samples>(samples_));
+  }
+  ++stats_.misses;
+  waiters_.emplace_back();
+  auto f = waiters_.back().get_future();
+  lk.unlock();
+  Refresh();
+  return f;
+}
+
+SampleRowsCacheStats SampleRowsCache::stats() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return stats_;
+}
+
+void SampleRowsCache::Refresh() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (refreshing_) return;
+  refreshing_ = true;
+  lk.unlock();
+  // The request completes in a bounded time, holding a strong reference keeps
+  // the waiters alive until then.
+  auto self = shared_from_this();
+  fetcher_().then([self](future<StatusOr<Samples>> f) {
+    self->OnRefresh(f.get());
+  });
+}
+
+void SampleRowsCache::OnRefresh(StatusOr<Samples> result) {
+  std::vector<promise<StatusOr<Samples>>> waiters;
+  std::unique_lock<std::mutex> lk(mu_);
+  refreshing_ = false;
+  waiters.swap(waiters_);
+  if (result) {
+    samples_ = *result;
+    has_samples_ = true;
+    fetched_at_ = clock_();
+    ++stats_.refreshes;
+  } else {
+    ++stats_.refresh_failures;
+  }
+  lk.unlock();
+  for (auto& w : waiters) w.set_value(result);
+  ScheduleRefresh();
+}
+
+void SampleRowsCache::ScheduleRefresh() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (timer_pending_) return;
+  timer_pending_ = true;
+  lk.unlock();
+  std::weak_ptr<SampleRowsCache> w = shared_from_this();
+  cq_.MakeRelativeTimer(options_.refresh_period)
+      .then([w](future<StatusOr<std::chrono::system_clock::time_point>> f) {
+        auto self = w.lock();
+        if (!self) return;
+        {
+          std::lock_guard<std::mutex> lk(self->mu_);
+          self->timer_pending_ = false;
+        }
+        // The timer is cancelled if the completion queue is shut down.
+        if (!f.get()) return;
+        self->Refresh();
+      });
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
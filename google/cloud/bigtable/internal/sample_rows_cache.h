@@ -0,0 +1,98 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_SAMPLE_ROWS_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_SAMPLE_ROWS_CACHE_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/row_key_sample.h"
+#include "google/cloud/bigtable/sample_rows_cache_options.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Cache the results of `Table::AsyncSampleRows()`.
+ *
+ * The samples are fetched when the cache is created, and then refreshed every
+ * `SampleRowsCacheOptions::refresh_period` using timers on the completion
+ * queue. Concurrent callers that find no usable samples share a single
+ * request.
+ *
+ * The timers only hold a weak reference to the cache, the refresh loop stops
+ * once all the owners release the cache.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use concurrently from multiple threads.
+ */
+class SampleRowsCache : public std::enable_shared_from_this<SampleRowsCache> {
+ public:
+  using Samples = std::vector<RowKeySample>;
+  using Fetcher = std::function<future<StatusOr<Samples>>()>;
+  using Clock = std::function<std::chrono::steady_clock::time_point()>;
+
+  /// Create a cache and start fetching the samples.
+  static std::shared_ptr<SampleRowsCache> Create(
+      CompletionQueue cq, Fetcher fetcher, SampleRowsCacheOptions options,
+      Clock clock = std::chrono::steady_clock::now);
+
+  /// Return the cached samples, or wait for a new request if they are too old.
+  future<StatusOr<Samples>> AsyncGet();
+
+  SampleRowsCacheStats stats() const;
+
+ private:
+  SampleRowsCache(CompletionQueue cq, Fetcher fetcher,
+                  SampleRowsCacheOptions options, Clock clock);
+
+  /// Start a request unless one is already running.
+  void Refresh();
+  void OnRefresh(StatusOr<Samples> result);
+  void ScheduleRefresh();
+
+  CompletionQueue cq_;
+  Fetcher const fetcher_;
+  SampleRowsCacheOptions const options_;
+  Clock const clock_;
+
+  mutable std::mutex mu_;
+  Samples samples_;
+  bool has_samples_ = false;
+  std::chrono::steady_clock::time_point fetched_at_;
+  bool refreshing_ = false;
+  bool timer_pending_ = false;
+  /// The callers waiting for the running request.
+  std::vector<promise<StatusOr<Samples>>> waiters_;
+  SampleRowsCacheStats stats_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_SAMPLE_ROWS_CACHE_H
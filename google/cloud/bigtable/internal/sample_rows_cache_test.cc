@@ -0,0 +1,148 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/sample_rows_cache.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+using Samples = SampleRowsCache::Samples;
+
+template <typename T>
+bool Unsatisfied(future<T> const& fut) {
+  return std::future_status::timeout == fut.wait_for(1_ms);
+}
+
+Samples MakeSamples(std::string const& key) {
+  RowKeySample s;
+  s.row_key = key;
+  s.offset_bytes = 100;
+  return {s};
+}
+
+class SampleRowsCacheTest : public ::testing::Test {
+ protected:
+  SampleRowsCacheTest()
+      : cq_impl_(std::make_shared<FakeCompletionQueueImpl>()), cq_(cq_impl_) {}
+
+  std::shared_ptr<SampleRowsCache> CreateCache() {
+    return SampleRowsCache::Create(
+        cq_,
+        [this] {
+          requests_.emplace_back();
+          return requests_.back().get_future();
+        },
+        SampleRowsCacheOptions{}
+            .SetRefreshPeriod(std::chrono::minutes(1))
+            .SetMaxAge(std::chrono::minutes(10)),
+        [this] { return now_; });
+  }
+
+  std::shared_ptr<FakeCompletionQueueImpl> cq_impl_;
+  CompletionQueue cq_;
+  /// The i-th promise satisfies the i-th request.
+  std::deque<promise<StatusOr<Samples>>> requests_;
+  std::chrono::steady_clock::time_point now_;
+};
+
+TEST_F(SampleRowsCacheTest, FetchOnCreate) {
+  auto cache = CreateCache();
+  ASSERT_EQ(1U, requests_.size());
+  requests_[0].set_value(MakeSamples("k1"));
+
+  auto samples = cache->AsyncGet().get();
+  ASSERT_STATUS_OK(samples);
+  ASSERT_EQ(1U, samples->size());
+  EXPECT_EQ("k1", (*samples)[0].row_key);
+  EXPECT_EQ(1U, requests_.size());
+  auto stats = cache->stats();
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(0, stats.misses);
+  EXPECT_EQ(1, stats.refreshes);
+}
+
+TEST_F(SampleRowsCacheTest, WaitersShareRequest) {
+  auto cache = CreateCache();
+  auto f1 = cache->AsyncGet();
+  auto f2 = cache->AsyncGet();
+  EXPECT_TRUE(Unsatisfied(f1));
+  EXPECT_TRUE(Unsatisfied(f2));
+  ASSERT_EQ(1U, requests_.size());
+
+  requests_[0].set_value(MakeSamples("k1"));
+  EXPECT_EQ("k1", f1.get().value()[0].row_key);
+  EXPECT_EQ("k1", f2.get().value()[0].row_key);
+  EXPECT_EQ(2, cache->stats().misses);
+}
+
+TEST_F(SampleRowsCacheTest, RefreshInBackground) {
+  auto cache = CreateCache();
+  requests_[0].set_value(MakeSamples("k1"));
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(2U, requests_.size());
+
+  // The old samples are used until the refresh completes.
+  EXPECT_EQ("k1", cache->AsyncGet().get().value()[0].row_key);
+  requests_[1].set_value(MakeSamples("k2"));
+  EXPECT_EQ("k2", cache->AsyncGet().get().value()[0].row_key);
+  EXPECT_EQ(2, cache->stats().refreshes);
+}
+
+TEST_F(SampleRowsCacheTest, ExpiredAfterFailures) {
+  auto cache = CreateCache();
+  requests_[0].set_value(MakeSamples("k1"));
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(2U, requests_.size());
+  requests_[1].set_value(Status(StatusCode::kUnavailable, "try-again"));
+  EXPECT_EQ(1, cache->stats().refresh_failures);
+
+  // The samples are still usable.
+  EXPECT_EQ("k1", cache->AsyncGet().get().value()[0].row_key);
+
+  now_ += std::chrono::minutes(11);
+  auto f = cache->AsyncGet();
+  EXPECT_TRUE(Unsatisfied(f));
+  ASSERT_EQ(3U, requests_.size());
+  requests_[2].set_value(Status(StatusCode::kUnavailable, "try-again"));
+  EXPECT_THAT(f.get(), StatusIs(StatusCode::kUnavailable));
+}
+
+TEST_F(SampleRowsCacheTest, RefreshStopsAfterRelease) {
+  auto cache = CreateCache();
+  requests_[0].set_value(MakeSamples("k1"));
+  ASSERT_EQ(1U, cq_impl_->size());
+  cache.reset();
+  cq_impl_->SimulateCompletion(true);
+  EXPECT_EQ(1U, requests_.size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
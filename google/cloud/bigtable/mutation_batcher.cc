@@ -41,7 +41,9 @@ MutationBatcher::Options::Options()
       max_size_per_batch(kDefaultMaxSizePerBatch),
       max_batches(kDefaultMaxBatches),
       max_outstanding_size(kDefaultMaxOutstandingSize),
-      max_outstanding_mutations(kBigtableOutstandingMutationLimit) {}
+      max_outstanding_mutations(kBigtableOutstandingMutationLimit),
+      target_batch_latency(0),
+      coalesce_set_cells(false) {}
 
 MutationBatcher::Options& MutationBatcher::Options::SetMaxMutationsPerBatch(
     size_t max_mutations_per_batch_arg) {
@@ -63,9 +65,9 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
   CompletionPromise completion_promise;
   auto res = std::make_pair(admission_promise.get_future(),
                             completion_promise.get_future());
-  PendingSingleRowMutation pending(std::move(mut),
-                                   std::move(completion_promise),
-                                   std::move(admission_promise));
+  PendingSingleRowMutation pending(
+      std::move(mut), std::move(completion_promise),
+      std::move(admission_promise), options_.coalesce_set_cells);
   std::unique_lock<std::mutex> lk(mu_);
 
   grpc::Status mutation_status = IsValid(pending);
@@ -83,13 +85,24 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
   }
   ++num_requests_pending_;
 
+  if (options_.coalesce_set_cells && TryCoalesce(pending)) {
+    // The mutation replaced an unsent one, it does not need more space.
+    std::vector<AdmissionPromise> admission_promises_to_satisfy;
+    admission_promises_to_satisfy.emplace_back(
+        std::move(pending.admission_promise));
+    SatisfyPromises(std::move(admission_promises_to_satisfy), lk);
+    return res;
+  }
+
   if (!CanAppendToBatch(pending)) {
-    pending_mutations_.push(std::move(pending));
+    RememberCell(pending, true, pending_popped_ + pending_mutations_.size());
+    pending_mutations_.push_back(std::move(pending));
     return res;
   }
   std::vector<AdmissionPromise> admission_promises_to_satisfy;
   admission_promises_to_satisfy.emplace_back(
       std::move(pending.admission_promise));
+  RememberCell(pending, false, cur_batch_->mutations.size());
   Admit(std::move(pending));
   FlushIfPossible(cq);
   SatisfyPromises(std::move(admission_promises_to_satisfy), lk);
@@ -107,7 +120,7 @@ future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
 
 MutationBatcher::PendingSingleRowMutation::PendingSingleRowMutation(
     SingleRowMutation mut_arg, CompletionPromise completion_promise,
-    AdmissionPromise admission_promise)
+    AdmissionPromise admission_promise, bool coalesce_set_cells)
     : mut(std::move(mut_arg)),
       completion_promise(std::move(completion_promise)),
       admission_promise(std::move(admission_promise)) {
@@ -116,9 +129,24 @@ MutationBatcher::PendingSingleRowMutation::PendingSingleRowMutation(
   // This operation might not be cheap, so let's cache it.
   request_size = tmp.ByteSizeLong();
   num_mutations = static_cast<std::size_t>(tmp.mutations_size());
+  if (coalesce_set_cells && tmp.mutations_size() == 1 &&
+      tmp.mutations(0).has_set_cell() &&
+      tmp.mutations(0).set_cell().timestamp_micros() != ServerSetTimestamp()) {
+    auto const& set_cell = tmp.mutations(0).set_cell();
+    coalescable = true;
+    cell = CellKey(tmp.row_key(), set_cell.family_name(),
+                   set_cell.column_qualifier());
+    timestamp_micros = set_cell.timestamp_micros();
+  }
   mut = SingleRowMutation(std::move(tmp));
 }
 
+void MutationBatcher::MutationData::SetValue(Status const& status) {
+  for (auto& p : coalesced_promises) p.set_value(status);
+  completion_promise.set_value(status);
+  done = true;
+}
+
 grpc::Status MutationBatcher::IsValid(PendingSingleRowMutation& mut) const {
   // Objects of this class need to be aware of the maximum allowed number of
   // mutations in a batch because it should not pack more. If we have this
@@ -148,14 +176,48 @@ grpc::Status MutationBatcher::IsValid(PendingSingleRowMutation& mut) const {
 }
 
 bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
-  return outstanding_size_ + mut.request_size <=
-             options_.max_outstanding_size &&
-         outstanding_mutations_ + mut.num_mutations <=
-             options_.max_outstanding_mutations &&
-         cur_batch_->requests_size + mut.request_size <=
-             options_.max_size_per_batch &&
+  // `IsValid()` guarantees that any mutation fits the configured limits. The
+  // adaptive limits may be smaller, so an empty batch accepts any mutation,
+  // otherwise large mutations would starve.
+  if (cur_batch_->num_mutations == 0) return true;
+  return cur_batch_->requests_size + mut.request_size <= MaxSizePerBatch() &&
          cur_batch_->num_mutations + mut.num_mutations <=
-             options_.max_mutations_per_batch;
+             MaxMutationsPerBatch();
+}
+
+std::shared_ptr<internal::MutationAdmissionBudget> MutationBatcher::MakeBudget(
+    Table const& table, Options const& options) {
+  std::shared_ptr<MemoryAccount> account;
+  if (options.memory_accountant) {
+    account = options.memory_accountant->CreateAccount(
+        "bigtable.MutationBatcher/" + table.table_name());
+  }
+  return std::make_shared<internal::MutationAdmissionBudget>(
+      options.max_outstanding_size, options.max_outstanding_mutations,
+      std::move(account));
+}
+
+std::unique_ptr<internal::AdaptiveBatchSizer> MutationBatcher::MakeSizer(
+    Options const& options) {
+  if (options.target_batch_latency.count() <= 0) return nullptr;
+  return absl::make_unique<internal::AdaptiveBatchSizer>(
+      options.target_batch_latency, options.max_mutations_per_batch,
+      options.max_size_per_batch, options.max_batches);
+}
+
+size_t MutationBatcher::MaxMutationsPerBatch() const {
+  if (!sizer_) return options_.max_mutations_per_batch;
+  return sizer_->max_mutations_per_batch();
+}
+
+size_t MutationBatcher::MaxSizePerBatch() const {
+  if (!sizer_) return options_.max_size_per_batch;
+  return sizer_->max_size_per_batch();
+}
+
+size_t MutationBatcher::MaxBatches() const {
+  if (!sizer_) return options_.max_batches;
+  return sizer_->max_batches();
 }
 
 future<std::vector<FailedMutation>> MutationBatcher::AsyncBulkApplyImpl(
@@ -165,12 +227,18 @@ future<std::vector<FailedMutation>> MutationBatcher::AsyncBulkApplyImpl(
 
 bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
   if (cur_batch_->num_mutations > 0 &&
-      num_outstanding_batches_ < options_.max_batches) {
+      num_outstanding_batches_ < MaxBatches()) {
     ++num_outstanding_batches_;
 
     auto batch = std::make_shared<Batch>();
     cur_batch_.swap(batch);
-    AsyncBulkApplyImpl(table_, std::move(batch->requests))
+    batch_cells_.clear();
+    BulkMutation requests;
+    requests.reserve(batch->mutations.size());
+    for (auto& m : batch->mutations) requests.emplace_back(std::move(m));
+    batch->mutations.clear();
+    batch->send_time = std::chrono::steady_clock::now();
+    AsyncBulkApplyImpl(table_, std::move(requests))
         .then([this, cq,
                batch](future<std::vector<FailedMutation>> failed) mutable {
           // Calling OnBulkApplyDone here might lead to a deadlock if the
@@ -199,6 +267,9 @@ bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
 void MutationBatcher::OnBulkApplyDone(
     CompletionQueue cq, MutationBatcher::Batch batch,
     std::vector<FailedMutation> const& failed) {
+  auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - batch.send_time);
+  bool resource_exhausted = false;
   // First process all the failures, marking the mutations as done after
   // processing them.
   for (auto const& f : failed) {
@@ -212,25 +283,33 @@ void MutationBatcher::OnBulkApplyDone(
          << batch.mutation_data.size() << ")";
       google::cloud::internal::ThrowRuntimeError(std::move(os).str());
     }
-    MutationData& data = batch.mutation_data[idx];
-    data.completion_promise.set_value(f.status());
-    data.done = true;
+    if (f.status().code() == StatusCode::kResourceExhausted) {
+      resource_exhausted = true;
+    }
+    batch.mutation_data[idx].SetValue(f.status());
   }
-  // Any remaining mutations are treated as successful.
+  // Any remaining mutations are treated as successful, and count the
+  // mutations they replaced as completed too.
+  std::size_t num_mutations = 0;
   for (auto& data : batch.mutation_data) {
-    if (!data.done) {
-      data.completion_promise.set_value(Status());
-      data.done = true;
-    }
+    num_mutations += 1 + data.coalesced_promises.size();
+    if (!data.done) data.SetValue(Status());
   }
-  auto const num_mutations = batch.mutation_data.size();
   batch.mutation_data.clear();
 
+  budget_->Release(batch.requests_size, batch.num_mutations);
+  // Let other batchers sharing the budget use the space. This happens before
+  // updating `num_requests_pending_`, so this object cannot be considered
+  // idle (and deleted) while the callback runs.
+  if (on_budget_released_) on_budget_released_(cq);
+
   std::unique_lock<std::mutex> lk(mu_);
-  outstanding_size_ -= batch.requests_size;
-  outstanding_mutations_ -= batch.num_mutations;
   num_requests_pending_ -= num_mutations;
   num_outstanding_batches_--;
+  if (sizer_) {
+    sizer_->OnBatchComplete(batch.num_mutations, batch.requests_size, latency,
+                            resource_exhausted);
+  }
   SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
 }
 
@@ -241,25 +320,108 @@ std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
 
   do {
     while (!pending_mutations_.empty() &&
-           HasSpaceFor(pending_mutations_.front())) {
+           TryReserve(pending_mutations_.front())) {
       auto& mut = pending_mutations_.front();
       admission_promises.emplace_back(std::move(mut.admission_promise));
+      if (mut.coalescable) {
+        // Keep coalescing into this mutation only if nothing else claimed its
+        // cell since it was queued.
+        auto p = pending_cells_.find(mut.cell);
+        if (p != pending_cells_.end() &&
+            p->second.position == pending_popped_) {
+          auto slot = p->second;
+          slot.position = cur_batch_->mutations.size();
+          batch_cells_[mut.cell] = slot;
+          pending_cells_.erase(p);
+        }
+      }
       Admit(std::move(mut));
-      pending_mutations_.pop();
+      pending_mutations_.pop_front();
+      ++pending_popped_;
     }
   } while (FlushIfPossible(cq));
   return admission_promises;
 }
 
 void MutationBatcher::Admit(PendingSingleRowMutation mut) {
-  outstanding_size_ += mut.request_size;
-  outstanding_mutations_ += mut.num_mutations;
   cur_batch_->requests_size += mut.request_size;
   cur_batch_->num_mutations += mut.num_mutations;
-  cur_batch_->requests.emplace_back(std::move(mut.mut));
+  cur_batch_->mutations.emplace_back(std::move(mut.mut));
   cur_batch_->mutation_data.emplace_back(MutationData(std::move(mut)));
 }
 
+bool MutationBatcher::TryCoalesce(PendingSingleRowMutation& mut) {
+  if (!mut.coalescable) {
+    ForgetCells(mut.mut.row_key());
+    return false;
+  }
+  auto p = pending_cells_.find(mut.cell);
+  if (p != pending_cells_.end()) {
+    if (mut.timestamp_micros < p->second.timestamp_micros) return false;
+    // Pending mutations have not reserved any space yet.
+    auto& target = pending_mutations_[p->second.position - pending_popped_];
+    target.mut = std::move(mut.mut);
+    target.request_size = mut.request_size;
+    target.timestamp_micros = mut.timestamp_micros;
+    target.coalesced_promises.push_back(std::move(mut.completion_promise));
+    p->second.timestamp_micros = mut.timestamp_micros;
+    return true;
+  }
+  auto b = batch_cells_.find(mut.cell);
+  if (b == batch_cells_.end()) return false;
+  if (mut.timestamp_micros < b->second.timestamp_micros) return false;
+  auto& data = cur_batch_->mutation_data[b->second.position];
+  if (mut.request_size > data.request_size) {
+    // The replacement is larger, it needs space in the batch and the budget.
+    auto const extra = mut.request_size - data.request_size;
+    if (cur_batch_->requests_size + extra > MaxSizePerBatch()) return false;
+    if (!budget_->TryAcquire(extra, 0)) return false;
+  } else {
+    budget_->Release(data.request_size - mut.request_size, 0);
+  }
+  cur_batch_->requests_size =
+      cur_batch_->requests_size - data.request_size + mut.request_size;
+  cur_batch_->mutations[b->second.position] = std::move(mut.mut);
+  data.request_size = mut.request_size;
+  data.coalesced_promises.push_back(std::move(mut.completion_promise));
+  b->second.timestamp_micros = mut.timestamp_micros;
+  return true;
+}
+
+void MutationBatcher::RememberCell(PendingSingleRowMutation const& mut,
+                                   bool pending, std::size_t position) {
+  if (!mut.coalescable) return;
+  auto p = pending_cells_.find(mut.cell);
+  if (p != pending_cells_.end()) {
+    if (p->second.timestamp_micros > mut.timestamp_micros) return;
+    pending_cells_.erase(p);
+  }
+  auto b = batch_cells_.find(mut.cell);
+  if (b != batch_cells_.end()) {
+    if (b->second.timestamp_micros > mut.timestamp_micros) return;
+    batch_cells_.erase(b);
+  }
+  auto& cells = pending ? pending_cells_ : batch_cells_;
+  cells[mut.cell] = CellSlot{position, mut.timestamp_micros};
+}
+
+void MutationBatcher::ForgetCells(std::string const& row_key) {
+  auto forget = [&row_key](std::map<CellKey, CellSlot>& cells) {
+    auto i = cells.lower_bound(CellKey(row_key, std::string(), std::string()));
+    while (i != cells.end() && std::get<0>(i->first) == row_key) {
+      i = cells.erase(i);
+    }
+  };
+  forget(pending_cells_);
+  forget(batch_cells_);
+}
+
+void MutationBatcher::RetryPending(CompletionQueue& cq) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (pending_mutations_.empty()) return;
+  SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+}
+
 void MutationBatcher::SatisfyPromises(
     std::vector<AdmissionPromise> admission_promises,
     std::unique_lock<std::mutex>& lk) {
@@ -17,16 +17,23 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/adaptive_batch_sizer.h"
+#include "google/cloud/bigtable/internal/mutation_admission_budget.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/memory_accountant.h"
 #include "google/cloud/status.h"
 #include "absl/memory/memory.h"
 #include <google/bigtable/v2/bigtable.pb.h>
+#include <chrono>
+#include <cstdint>
 #include <deque>
 #include <functional>
+#include <map>
 #include <memory>
-#include <queue>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace google {
@@ -84,21 +91,66 @@ class MutationBatcher {
     /// MutationBatcher will at most admit this many mutations.
     Options& SetMaxOutstandingMutations(size_t max_outstanding_mutations_arg);
 
+    /**
+     * Adapt the batch sizes and the number of outstanding batches to meet
+     * this latency for each batch.
+     *
+     * In this mode `max_mutations_per_batch`, `max_size_per_batch` and
+     * `max_batches` are upper bounds. The batcher starts with small batches
+     * and a single outstanding batch, grows them while the batches complete
+     * within @p target_batch_latency_arg, and shrinks them when the batches
+     * are slower or the service responds with `RESOURCE_EXHAUSTED`. A zero
+     * latency, the default, disables the adaptive mode.
+     */
+    Options& SetTargetBatchLatency(
+        std::chrono::milliseconds target_batch_latency_arg) {
+      target_batch_latency = target_batch_latency_arg;
+      return *this;
+    }
+
+    /**
+     * Replace unsent writes to a cell with newer writes to the same cell.
+     *
+     * When enabled, a `SingleRowMutation` holding a single `SetCell` with an
+     * explicit timestamp replaces a similar mutation for the same row, family
+     * and column that is not admitted or not sent yet, as long as its
+     * timestamp is not older. The replaced mutation is never sent, its
+     * completion future is satisfied with the result of the mutation that
+     * replaced it. Any other mutation for the row stops the coalescing of the
+     * previous writes to that row, so the mutations still apply in order.
+     *
+     * If the timestamps differ only the newest version of the cell is
+     * written. Do not enable this if the application reads older versions.
+     */
+    Options& SetCoalesceSetCells(bool coalesce_set_cells_arg) {
+      coalesce_set_cells = coalesce_set_cells_arg;
+      return *this;
+    }
+
+    /**
+     * Report the size of the admitted mutations to @p accountant.
+     *
+     * While the accountant is over its soft limit the batcher admits no new
+     * mutations, other than the first one when none are outstanding.
+     */
+    Options& SetMemoryAccountant(
+        std::shared_ptr<google::cloud::MemoryAccountant> accountant) {
+      memory_accountant = std::move(accountant);
+      return *this;
+    }
+
     std::size_t max_mutations_per_batch;
     std::size_t max_size_per_batch;
     std::size_t max_batches;
     std::size_t max_outstanding_size;
     std::size_t max_outstanding_mutations;
+    std::chrono::milliseconds target_batch_latency;
+    bool coalesce_set_cells;
+    std::shared_ptr<google::cloud::MemoryAccountant> memory_accountant;
   };
 
   explicit MutationBatcher(Table table, Options options = Options())
-      : table_(std::move(table)),
-        options_(options),
-        num_outstanding_batches_(),
-        outstanding_size_(),
-        outstanding_mutations_(),
-        num_requests_pending_(),
-        cur_batch_(std::make_shared<Batch>()) {}
+      : MutationBatcher(std::move(table), std::move(options), nullptr) {}
 
   virtual ~MutationBatcher() = default;
 
@@ -171,24 +223,51 @@ class MutationBatcher {
       Table& table, BulkMutation&& mut);
 
  private:
+  friend class ShardedMutationBatcher;
+
+  /**
+   * Create a batcher whose outstanding mutations are limited by `budget`.
+   *
+   * Without a @p budget the batcher creates its own.
+   */
+  MutationBatcher(Table table, Options options,
+                  std::shared_ptr<internal::MutationAdmissionBudget> budget)
+      : table_(std::move(table)),
+        options_(std::move(options)),
+        budget_(budget ? std::move(budget) : MakeBudget(table_, options_)),
+        num_outstanding_batches_(),
+        num_requests_pending_(),
+        cur_batch_(std::make_shared<Batch>()),
+        sizer_(MakeSizer(options_)) {}
+
   using CompletionPromise = promise<Status>;
   using AdmissionPromise = promise<void>;
   using NoMorePendingPromise = promise<void>;
   struct Batch;
 
+  /// Identifies a cell by its row key, column family and column qualifier.
+  using CellKey = std::tuple<std::string, std::string, std::string>;
+
   /**
    * This structure represents a single mutation before it is admitted.
    */
   struct PendingSingleRowMutation {
     PendingSingleRowMutation(SingleRowMutation mut_arg,
                              CompletionPromise completion_promise,
-                             AdmissionPromise admission_promise);
+                             AdmissionPromise admission_promise,
+                             bool coalesce_set_cells);
 
     SingleRowMutation mut;
     size_t num_mutations;
     size_t request_size;
     CompletionPromise completion_promise;
     AdmissionPromise admission_promise;
+    /// Set if `mut` may be replaced by a newer write to `cell`.
+    bool coalescable = false;
+    CellKey cell;
+    std::int64_t timestamp_micros = 0;
+    /// The completion promises of the mutations replaced by this one.
+    std::vector<CompletionPromise> coalesced_promises;
   };
 
   /**
@@ -201,8 +280,16 @@ class MutationBatcher {
   struct MutationData {
     explicit MutationData(PendingSingleRowMutation pending)
         : completion_promise(std::move(pending.completion_promise)),
+          coalesced_promises(std::move(pending.coalesced_promises)),
+          request_size(pending.request_size),
           done(false) {}
+
+    /// Satisfy the promises of this mutation and the ones it replaced.
+    void SetValue(Status const& status);
+
     CompletionPromise completion_promise;
+    std::vector<CompletionPromise> coalesced_promises;
+    size_t request_size;
     bool done;
   };
 
@@ -227,10 +314,27 @@ class MutationBatcher {
 
     size_t num_mutations{};
     size_t requests_size{};
-    BulkMutation requests;
+    /**
+     * The mutations, moved into a `BulkMutation` when the batch is sent.
+     *
+     * Until then a mutation may be replaced by a newer write to the same cell.
+     */
+    std::vector<SingleRowMutation> mutations;
     std::vector<MutationData> mutation_data;
+    /// When the batch was sent, used to tune the batch sizes.
+    std::chrono::steady_clock::time_point send_time;
   };
 
+  static std::unique_ptr<internal::AdaptiveBatchSizer> MakeSizer(
+      Options const& options);
+  static std::shared_ptr<internal::MutationAdmissionBudget> MakeBudget(
+      Table const& table, Options const& options);
+
+  /// The current per-batch limits, adjusted by `sizer_` if enabled.
+  size_t MaxMutationsPerBatch() const;
+  size_t MaxSizePerBatch() const;
+  size_t MaxBatches() const;
+
   /// Check if a mutation doesn't exceed allowed limits.
   grpc::Status IsValid(PendingSingleRowMutation& mut) const;
 
@@ -241,15 +345,26 @@ class MutationBatcher {
   bool HasSpaceFor(PendingSingleRowMutation const& mut) const;
 
   /**
-   * Check if one can append a mutation to the currently constructed batch.
-   * Even if there is space for the mutation, we shouldn't append mutations if
-   * some other are not admitted yet.
+   * Reserve space for the passed mutation in the currently constructed batch
+   * and in the outstanding mutations budget.
+   *
+   * If the mutation does not fit nothing is reserved.
+   */
+  bool TryReserve(PendingSingleRowMutation const& mut) {
+    return HasSpaceFor(mut) &&
+           budget_->TryAcquire(mut.request_size, mut.num_mutations);
+  }
+
+  /**
+   * Check if one can append a mutation to the currently constructed batch,
+   * and reserve space for it if so. Even if there is space for the mutation,
+   * we shouldn't append mutations if some other are not admitted yet.
    */
-  bool CanAppendToBatch(PendingSingleRowMutation const& mut) const {
+  bool CanAppendToBatch(PendingSingleRowMutation const& mut) {
     // If some mutations are already subject to flow control, don't admit any
     // new, even if there's space for them. Otherwise we might starve big
     // mutations.
-    return pending_mutations_.empty() && HasSpaceFor(mut);
+    return pending_mutations_.empty() && TryReserve(mut);
   }
 
   /**
@@ -272,9 +387,38 @@ class MutationBatcher {
 
   /**
    * Append mutation `mut` to the currently constructed batch.
+   *
+   * The caller must have reserved space for it with `TryReserve()`.
    */
   void Admit(PendingSingleRowMutation mut);
 
+  /**
+   * Replace an unsent write to the same cell with @p mut, if possible.
+   *
+   * Only used when `Options::coalesce_set_cells` is set. On success the
+   * completion promise of @p mut is moved to the replaced mutation.
+   */
+  bool TryCoalesce(PendingSingleRowMutation& mut);
+
+  /**
+   * Record that @p mut is the newest unsent write to its cell, unless a write
+   * with a newer timestamp is already recorded.
+   *
+   * @param position the sequence number in `pending_mutations_` if @p pending,
+   *     the index in `cur_batch_` otherwise.
+   */
+  void RememberCell(PendingSingleRowMutation const& mut, bool pending,
+                    std::size_t position);
+
+  /// Stop coalescing the writes to @p row_key.
+  void ForgetCells(std::string const& row_key);
+
+  /**
+   * Try to admit the pending mutations after another batcher sharing the same
+   * budget released some space.
+   */
+  void RetryPending(CompletionQueue& cq);
+
   /**
    * Satisfies passed admission promises and potentially the promises of no more
    * pending requests. Unlocks `lk`.
@@ -286,24 +430,43 @@ class MutationBatcher {
   Table table_;
   Options options_;
 
+  /// Size and number of admitted but uncompleted mutations, maybe shared.
+  std::shared_ptr<internal::MutationAdmissionBudget> budget_;
+  /**
+   * Called, without holding `mu_`, after a batch releases its part of a shared
+   * `budget_`.
+   */
+  std::function<void(CompletionQueue&)> on_budget_released_;
+
   /// Num batches sent but not completed.
   size_t num_outstanding_batches_;
-  /// Size of admitted but uncompleted mutations.
-  size_t outstanding_size_;
-  /// Number of admitted but uncompleted mutations.
-  size_t outstanding_mutations_;
   // Number of uncompleted SingleRowMutations (including not admitted).
   size_t num_requests_pending_;
 
   /// Currently constructed batch of mutations.
   std::shared_ptr<Batch> cur_batch_;
 
+  /// Tunes the batch limits, null unless `target_batch_latency` is set.
+  std::unique_ptr<internal::AdaptiveBatchSizer> sizer_;
+
   /**
    * These are the mutations which have not been admitted yet. If the user is
    * properly reacting to `admission_promise`s, there should be very few of
    * these (likely no more than one).
    */
-  std::queue<PendingSingleRowMutation> pending_mutations_;
+  std::deque<PendingSingleRowMutation> pending_mutations_;
+  /// The number of mutations removed from `pending_mutations_` so far.
+  std::size_t pending_popped_ = 0;
+
+  /// The location of the newest unsent write to each cell.
+  struct CellSlot {
+    std::size_t position;
+    std::int64_t timestamp_micros;
+  };
+  /// Writes in `pending_mutations_`, by sequence number.
+  std::map<CellKey, CellSlot> pending_cells_;
+  /// Writes in `cur_batch_`, by index.
+  std::map<CellKey, CellSlot> batch_cells_;
 
   /**
    * The list of promises made to this point.
@@ -253,6 +253,8 @@ TEST(OptionsTest, Defaults) {
   MutationBatcher::Options opt = MutationBatcher::Options();
   ASSERT_EQ(1000, opt.max_mutations_per_batch);
   ASSERT_EQ(4, opt.max_batches);
+  ASSERT_EQ(0, opt.target_batch_latency.count());
+  ASSERT_FALSE(opt.coalesce_set_cells);
 }
 
 TEST(OptionsTest, Trivial) {
@@ -333,6 +335,138 @@ TEST_F(MutationBatcherTest, BatchIsFlushedImmediately) {
   EXPECT_EQ(0, NumOperationsOutstanding());
 }
 
+TEST_F(MutationBatcherTest, AdaptiveBatchesStartSmallAndGrow) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo3", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  // The adaptive mode starts with 10% of the maximum batch size (a single
+  // mutation here) and only one outstanding batch.
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options()
+                  .SetMaxMutationsPerBatch(10)
+                  .SetMaxBatches(4)
+                  .SetTargetBatchLatency(std::chrono::hours(1))));
+
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[1], mutations[2]}, {ResultPiece({0, 1}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  EXPECT_TRUE(state0->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  auto state1 = Apply(mutations[1]);
+  EXPECT_TRUE(state1->admitted);
+  auto state2 = Apply(mutations[2]);
+  EXPECT_FALSE(state2->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // The first batch completes well within the target latency, the next batch
+  // has room for both remaining mutations.
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state0->completed);
+  EXPECT_TRUE(state2->admitted);
+  EXPECT_FALSE(state1->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state1->completed);
+  EXPECT_TRUE(state2->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+TEST_F(MutationBatcherTest, CoalesceSetCellsInCurrentBatch) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 10_ms, "v1")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 10_ms, "v2")}),
+       // An older version is not coalesced.
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 5_ms, "v3")})});
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetMaxBatches(1).SetCoalesceSetCells(true)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[2], mutations[3]}, {ResultPiece({0, 1}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  auto state1 = ApplyMany(mutations.begin() + 1, mutations.end());
+  EXPECT_TRUE(state1.AllAdmitted());
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  EXPECT_TRUE(state1.NoneCompleted());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1.AllCompleted());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+  EXPECT_TRUE(batcher_->AsyncWaitForNoPendingRequests().is_ready());
+}
+
+TEST_F(MutationBatcherTest, CoalesceSetCellsStopsAtOtherMutations) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 10_ms, "v1")}),
+       SingleRowMutation("bar", {bt::DeleteFromRow()}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 10_ms, "v2")})});
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetMaxBatches(1).SetCoalesceSetCells(true)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[1], mutations[2], mutations[3]},
+                {ResultPiece({0, 1, 2}, {}, {})})});
+
+  auto state = ApplyMany(mutations.begin(), mutations.end());
+  EXPECT_TRUE(state.AllAdmitted());
+
+  FinishSingleItemStream();
+  FinishSingleItemStream();
+  EXPECT_TRUE(state.AllCompleted());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+TEST_F(MutationBatcherTest, CoalesceSetCellsWhilePending) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("baz", {bt::SetCell("fam", "col", 10_ms, "v1")}),
+       SingleRowMutation("baz", {bt::SetCell("fam", "col", 20_ms, "v2")})});
+  batcher_.reset(new MutationBatcher(table_, MutationBatcher::Options()
+                                                 .SetMaxBatches(1)
+                                                 .SetMaxOutstandingMutations(2)
+                                                 .SetCoalesceSetCells(true)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[1], mutations[3]}, {ResultPiece({0, 1}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  auto state1 = Apply(mutations[1]);
+  auto state2 = Apply(mutations[2]);
+  EXPECT_FALSE(state2->admitted);
+  // The newer write replaces the pending one and needs no extra space.
+  auto state3 = Apply(mutations[3]);
+  EXPECT_TRUE(state3->admitted);
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  EXPECT_TRUE(state2->admitted);
+  EXPECT_FALSE(state2->completed);
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1->completed);
+  EXPECT_TRUE(state2->completed);
+  EXPECT_TRUE(state3->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
 class MutationBatcherBoolParamTest : public MutationBatcherTest,
                                      public WithParamInterface<bool> {};
 
@@ -42,6 +42,72 @@ Mutation SetCell(Cell cell) {
   return m;
 }
 
+Status BulkMutation::AppendSetCells(SetCellColumns columns) {
+  auto const rows = columns.row_keys.size();
+  auto const cells = columns.qualifiers.size();
+  auto invalid = [](char const* msg) {
+    return Status(StatusCode::kInvalidArgument,
+                  std::string("BulkMutation::AppendSetCells(): ") + msg);
+  };
+  if (columns.values.size() != cells) {
+    return invalid("the number of values and qualifiers must be equal");
+  }
+  if (columns.families.size() != 1 && columns.families.size() != cells) {
+    return invalid("there must be one family, or one family per cell");
+  }
+  if (columns.timestamps.size() > 1 && columns.timestamps.size() != cells) {
+    return invalid("there must be zero, one, or one per cell timestamps");
+  }
+  std::size_t uniform = 0;
+  if (columns.cells_per_row.empty()) {
+    if (rows == 0 ? cells != 0 : cells % rows != 0) {
+      return invalid("all rows must have the same number of cells");
+    }
+    uniform = rows == 0 ? 0 : cells / rows;
+  } else {
+    if (columns.cells_per_row.size() != rows) {
+      return invalid("there must be one cells_per_row value per row");
+    }
+    std::size_t total = 0;
+    for (auto n : columns.cells_per_row) total += n;
+    if (total != cells) {
+      return invalid("the cells_per_row values must add up to the cells");
+    }
+  }
+
+  auto const shared_family = columns.families.size() == 1 && cells != 1;
+  auto timestamp_micros = [&columns](std::size_t c) -> std::int64_t {
+    if (columns.timestamps.empty()) return ServerSetTimestamp();
+    auto const& ts = columns.timestamps.size() == 1 ? columns.timestamps[0]
+                                                    : columns.timestamps[c];
+    return std::chrono::duration_cast<std::chrono::microseconds>(ts).count();
+  };
+
+  auto& entries = *request_.mutable_entries();
+  entries.Reserve(entries.size() + static_cast<int>(rows));
+  std::size_t c = 0;
+  for (std::size_t r = 0; r != rows; ++r) {
+    auto& entry = *entries.Add();
+    entry.set_row_key(std::move(columns.row_keys[r]));
+    auto const n =
+        columns.cells_per_row.empty() ? uniform : columns.cells_per_row[r];
+    auto& mutations = *entry.mutable_mutations();
+    mutations.Reserve(static_cast<int>(n));
+    for (std::size_t end = c + n; c != end; ++c) {
+      auto& set_cell = *mutations.Add()->mutable_set_cell();
+      if (shared_family) {
+        set_cell.set_family_name(columns.families[0]);
+      } else {
+        set_cell.set_family_name(std::move(columns.families[c]));
+      }
+      set_cell.set_column_qualifier(std::move(columns.qualifiers[c]));
+      set_cell.set_timestamp_micros(timestamp_micros(c));
+      set_cell.set_value(std::move(columns.values[c]));
+    }
+  }
+  return Status{};
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -458,6 +458,40 @@ class PermanentMutationFailure : public std::runtime_error {
   grpc::Status status_;
 };
 
+/**
+ * Columnar input to build many `SetCell` mutations at once.
+ *
+ * Ingest pipelines often have their data in columns: a vector of row keys, and
+ * vectors with the family, column, and value for each cell. Building a
+ * `SingleRowMutation` for each row, and a `Mutation` for each cell, allocates
+ * and copies each string more than once. `BulkMutation::AppendSetCells()`
+ * moves the strings from these vectors directly into the request.
+ *
+ * The cells are stored row by row, row `i` has `cells_per_row[i]` cells, or,
+ * if `cells_per_row` is empty, all rows have the same number of cells.
+ *
+ * @see `BulkMutation::AppendSetCells()`
+ */
+struct SetCellColumns {
+  /// The row key for each row.
+  std::vector<std::string> row_keys;
+  /// The number of cells in each row, empty if all rows have the same number.
+  std::vector<std::size_t> cells_per_row;
+  /// The family for each cell, or a single family used by all the cells.
+  std::vector<std::string> families;
+  /// The column qualifier for each cell.
+  std::vector<std::string> qualifiers;
+  /// The value for each cell.
+  std::vector<std::string> values;
+  /**
+   * The timestamp for each cell, or a single timestamp used by all the cells.
+   *
+   * If empty, the server sets the timestamps. Such mutations are not
+   * idempotent and not retried by default.
+   */
+  std::vector<std::chrono::milliseconds> timestamps;
+};
+
 /**
  * Represent a set of mutations across multiple rows.
  *
@@ -524,6 +558,23 @@ class BulkMutation {
     return *this;
   }
 
+  /// Reserve space for @p n mutations (rows) in this set.
+  BulkMutation& reserve(std::size_t n) {
+    request_.mutable_entries()->Reserve(static_cast<int>(n));
+    return *this;
+  }
+
+  /**
+   * Append one `SetCell` mutation per cell in @p columns.
+   *
+   * The repeated fields in the request are sized once, and the strings are
+   * moved (not copied) into the request.
+   *
+   * @returns an `kInvalidArgument` error, without modifying this object, if
+   *     the sizes of the vectors in @p columns are not consistent.
+   */
+  google::cloud::Status AppendSetCells(SetCellColumns columns);
+
   /// Move the contents into a bigtable::v2::MutateRowsRequest
   void MoveTo(google::bigtable::v2::MutateRowsRequest* request) {
     request_.Swap(request);
@@ -550,6 +601,7 @@ class BulkMutation {
 
   void emplace_many(SingleRowMutation m) { emplace_back(std::move(m)); }
 
+  friend class Table;
   google::bigtable::v2::MutateRowsRequest request_;
 };
 
@@ -226,6 +226,107 @@ TEST(MutationsTest, MutipleRowMutations) {
   EXPECT_EQ("foo3", request.entries(1).row_key());
 }
 
+/// @test Verify that BulkMutation::AppendSetCells() works as expected.
+TEST(MutationsTest, AppendSetCellsUniform) {
+  BulkMutation actual;
+  actual.emplace_back(
+      SingleRowMutation("foo0", {SetCell("f", "c", 0_ms, "v0")}));
+  SetCellColumns columns;
+  columns.row_keys = {"foo1", "foo2"};
+  columns.families = {"f"};
+  columns.qualifiers = {"c1", "c2", "c3", "c4"};
+  columns.values = {"v1", "v2", "v3", "v4"};
+  columns.timestamps = {10_ms};
+  ASSERT_STATUS_OK(actual.AppendSetCells(std::move(columns)));
+  ASSERT_EQ(3, actual.size());
+
+  btproto::MutateRowsRequest request;
+  actual.MoveTo(&request);
+  ASSERT_EQ(3, request.entries_size());
+  EXPECT_EQ("foo0", request.entries(0).row_key());
+  auto const& e1 = request.entries(1);
+  EXPECT_EQ("foo1", e1.row_key());
+  ASSERT_EQ(2, e1.mutations_size());
+  EXPECT_EQ("f", e1.mutations(0).set_cell().family_name());
+  EXPECT_EQ("c1", e1.mutations(0).set_cell().column_qualifier());
+  EXPECT_EQ("v1", e1.mutations(0).set_cell().value());
+  EXPECT_EQ(10000, e1.mutations(0).set_cell().timestamp_micros());
+  EXPECT_EQ("c2", e1.mutations(1).set_cell().column_qualifier());
+  auto const& e2 = request.entries(2);
+  EXPECT_EQ("foo2", e2.row_key());
+  ASSERT_EQ(2, e2.mutations_size());
+  EXPECT_EQ("f", e2.mutations(1).set_cell().family_name());
+  EXPECT_EQ("c4", e2.mutations(1).set_cell().column_qualifier());
+  EXPECT_EQ("v4", e2.mutations(1).set_cell().value());
+}
+
+/// @test Verify BulkMutation::AppendSetCells() with variable row sizes.
+TEST(MutationsTest, AppendSetCellsPerRow) {
+  BulkMutation actual;
+  SetCellColumns columns;
+  columns.row_keys = {"foo1", "foo2"};
+  columns.cells_per_row = {1, 2};
+  columns.families = {"f1", "f2", "f3"};
+  columns.qualifiers = {"c1", "c2", "c3"};
+  columns.values = {"v1", "v2", "v3"};
+  ASSERT_STATUS_OK(actual.AppendSetCells(std::move(columns)));
+
+  btproto::MutateRowsRequest request;
+  actual.MoveTo(&request);
+  ASSERT_EQ(2, request.entries_size());
+  ASSERT_EQ(1, request.entries(0).mutations_size());
+  ASSERT_EQ(2, request.entries(1).mutations_size());
+  auto const& cell = request.entries(1).mutations(1).set_cell();
+  EXPECT_EQ("f3", cell.family_name());
+  EXPECT_EQ("c3", cell.column_qualifier());
+  EXPECT_EQ("v3", cell.value());
+  EXPECT_EQ(ServerSetTimestamp(), cell.timestamp_micros());
+}
+
+/// @test Verify BulkMutation::AppendSetCells() rejects inconsistent input.
+TEST(MutationsTest, AppendSetCellsInvalid) {
+  auto make_columns = [] {
+    SetCellColumns columns;
+    columns.row_keys = {"foo1", "foo2"};
+    columns.families = {"f"};
+    columns.qualifiers = {"c1", "c2"};
+    columns.values = {"v1", "v2"};
+    return columns;
+  };
+  BulkMutation actual;
+  ASSERT_STATUS_OK(actual.AppendSetCells(make_columns()));
+  ASSERT_EQ(2, actual.size());
+
+  auto columns = make_columns();
+  columns.values.pop_back();
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            actual.AppendSetCells(std::move(columns)).code());
+
+  columns = make_columns();
+  columns.families = {"f1", "f2", "f3"};
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            actual.AppendSetCells(std::move(columns)).code());
+
+  columns = make_columns();
+  columns.qualifiers.emplace_back("c3");
+  columns.values.emplace_back("v3");
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            actual.AppendSetCells(std::move(columns)).code());
+
+  columns = make_columns();
+  columns.cells_per_row = {2, 1};
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            actual.AppendSetCells(std::move(columns)).code());
+
+  columns = make_columns();
+  columns.timestamps = {1_ms, 2_ms, 3_ms};
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument,
+            actual.AppendSetCells(std::move(columns)).code());
+
+  // The failed calls do not modify the mutation.
+  EXPECT_EQ(2, actual.size());
+}
+
 /// @test Verify variadic Mutations for SingleRowMutations.
 TEST(MutationsTest, SingleRowMutationMultipleVariadic) {
   std::string const row_key = "row-key-1";
@@ -87,11 +87,46 @@ struct MaxConnectionRefreshOption {
   using Type = std::chrono::milliseconds;
 };
 
+/**
+ * Connect all the channels in the pool when a data client is created.
+ *
+ * By default the channels connect on their first RPC, which then pays for the
+ * name resolution, TLS, and HTTP/2 setup. With this option
+ * `CreateDefaultDataClient()` starts connecting all the channels immediately.
+ */
+struct ChannelPrimingOption {
+  using Type = bool;
+};
+
+/**
+ * Prime each channel with a `SampleRowKeys` request on this table.
+ *
+ * This is the table id, not the full table name. Ignored unless
+ * `ChannelPrimingOption` is set. If not set, the channels are connected but
+ * no priming requests are sent.
+ */
+struct ChannelPrimingTableOption {
+  using Type = std::string;
+};
+
+/**
+ * Block the creation of a data client until the channels are primed.
+ *
+ * `CreateDefaultDataClient()` waits at most this long for the channels to
+ * connect (and for the priming requests to complete). With the default, zero,
+ * the channels are primed in the background and the creation does not block.
+ * Ignored unless `ChannelPrimingOption` is set.
+ */
+struct ChannelPrimingTimeoutOption {
+  using Type = std::chrono::milliseconds;
+};
+
 /// The complete list of options accepted by `bigtable::*Client`
 using ClientOptionList =
     OptionList<DataEndpointOption, AdminEndpointOption,
                InstanceAdminEndpointOption, MinConnectionRefreshOption,
-               MaxConnectionRefreshOption>;
+               MaxConnectionRefreshOption, ChannelPrimingOption,
+               ChannelPrimingTableOption, ChannelPrimingTimeoutOption>;
 
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
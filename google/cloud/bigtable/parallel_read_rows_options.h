@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_READ_ROWS_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_READ_ROWS_OPTIONS_H
+
+#include "google/cloud/bigtable/internal/defaults.h"
+#include "google/cloud/bigtable/version.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configure the behavior of `Table::ParallelReadRows()`.
+ *
+ * The table is split into shards using the results of `Table::SampleRows()`,
+ * and each shard is read using a separate `ReadRows` stream. The streams are
+ * distributed over the channels in the `DataClient` connection pool.
+ */
+struct ParallelReadRowsOptions {
+  ParallelReadRowsOptions()
+      : max_streams(static_cast<std::size_t>(
+            (std::max)(1, internal::DefaultConnectionPoolSize()))),
+        max_buffered_rows(kDefaultMaxBufferedRows),
+        preserve_order(false) {}
+
+  /**
+   * There will be no more `ReadRows` streams outstanding than this.
+   *
+   * The default matches the default size of the connection pool. Applications
+   * that change `ClientOptions::set_connection_pool_size()` may want to use a
+   * multiple of that value.
+   */
+  ParallelReadRowsOptions& SetMaxStreams(std::size_t max_streams_arg) {
+    max_streams = (std::max)(std::size_t{1}, max_streams_arg);
+    return *this;
+  }
+
+  /**
+   * Each stream buffers at most this many rows not yet delivered to the
+   * application.
+   *
+   * Once the buffer is full the stream stops reading from the service until
+   * the application consumes some of the rows.
+   */
+  ParallelReadRowsOptions& SetMaxBufferedRows(std::size_t max_buffered_arg) {
+    max_buffered_rows = (std::max)(std::size_t{1}, max_buffered_arg);
+    return *this;
+  }
+
+  /**
+   * Deliver the rows in key order.
+   *
+   * By default the rows are delivered in the order they are received from the
+   * different streams. If set, the rows of each shard are delivered only after
+   * all the rows of the previous shards, the rows received out of order are
+   * buffered (see `SetMaxBufferedRows()`).
+   */
+  ParallelReadRowsOptions& SetPreserveOrder(bool preserve_order_arg) {
+    preserve_order = preserve_order_arg;
+    return *this;
+  }
+
+  static std::size_t constexpr kDefaultMaxBufferedRows = 1024;
+
+  std::size_t max_streams;
+  std::size_t max_buffered_rows;
+  bool preserve_order;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_READ_ROWS_OPTIONS_H
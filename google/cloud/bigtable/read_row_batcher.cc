@@ -0,0 +1,160 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_row_batcher.h"
+#include <algorithm>
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+auto constexpr kDefaultMaxKeysPerRequest = 100;
+auto constexpr kDefaultMaxDelayMicroseconds = 1000;
+
+ReadRowBatcher::Options::Options()
+    : max_keys_per_request(kDefaultMaxKeysPerRequest),
+      max_delay(kDefaultMaxDelayMicroseconds) {}
+
+ReadRowBatcher::Options& ReadRowBatcher::Options::SetMaxKeysPerRequest(
+    std::size_t max_keys_per_request_arg) {
+  max_keys_per_request = (std::max)(std::size_t{1}, max_keys_per_request_arg);
+  return *this;
+}
+
+future<StatusOr<std::pair<bool, Row>>> ReadRowBatcher::AsyncReadRow(
+    CompletionQueue& cq, std::string row_key) {
+  promise<Result> p;
+  auto f = p.get_future();
+
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const new_window = !current_;
+  if (new_window) current_ = std::make_shared<Batch>();
+  std::weak_ptr<Batch> window = current_;
+  current_->lookups[std::move(row_key)].push_back(std::move(p));
+  std::shared_ptr<Batch> full;
+  if (current_->lookups.size() >= options_.max_keys_per_request) {
+    full = std::move(current_);
+    current_.reset();
+    full->sent = true;
+  }
+  lk.unlock();
+
+  if (full) {
+    Send(std::move(full));
+  } else if (new_window) {
+    // The batch may be sent, and this object deleted, before the timer
+    // fires. Only touch `this` while the batch is waiting in `current_`.
+    cq.MakeRelativeTimer(options_.max_delay)
+        .then([this, window](
+                  future<StatusOr<std::chrono::system_clock::time_point>>) {
+          auto batch = window.lock();
+          if (!batch || batch->sent) return;
+          OnTimer(batch);
+        });
+  }
+  return f;
+}
+
+future<std::vector<StatusOr<std::pair<bool, Row>>>>
+ReadRowBatcher::AsyncReadRows(CompletionQueue& cq,
+                              std::vector<std::string> row_keys) {
+  struct State {
+    explicit State(std::size_t n) : results(n), remaining(n) {}
+    std::vector<Result> results;
+    std::atomic<std::size_t> remaining;
+    promise<std::vector<Result>> done;
+  };
+  if (row_keys.empty()) return make_ready_future(std::vector<Result>{});
+
+  auto state = std::make_shared<State>(row_keys.size());
+  auto f = state->done.get_future();
+  for (std::size_t i = 0; i != row_keys.size(); ++i) {
+    AsyncReadRow(cq, std::move(row_keys[i])).then([state, i](future<Result> r) {
+      state->results[i] = r.get();
+      if (--state->remaining == 0) {
+        state->done.set_value(std::move(state->results));
+      }
+    });
+  }
+  return f;
+}
+
+future<StatusOr<std::vector<Row>>> ReadRowBatcher::AsyncReadRowsImpl(
+    Table& table, RowSet row_set, Filter filter) {
+  struct State {
+    std::vector<Row> rows;
+    promise<StatusOr<std::vector<Row>>> done;
+  };
+  auto state = std::make_shared<State>();
+  auto f = state->done.get_future();
+  table.AsyncReadRowBatches(
+      [state](std::vector<Row> rows) {
+        std::move(rows.begin(), rows.end(), std::back_inserter(state->rows));
+        return make_ready_future(true);
+      },
+      [state](Status status) {
+        if (!status.ok()) {
+          state->done.set_value(std::move(status));
+          return;
+        }
+        state->done.set_value(std::move(state->rows));
+      },
+      std::move(row_set), std::move(filter));
+  return f;
+}
+
+void ReadRowBatcher::OnTimer(std::shared_ptr<Batch> const& batch) {
+  std::unique_lock<std::mutex> lk(mu_);
+  // The batch may have filled up, and been sent, after the caller checked.
+  if (current_ != batch) return;
+  current_.reset();
+  batch->sent = true;
+  lk.unlock();
+  Send(batch);
+}
+
+void ReadRowBatcher::Send(std::shared_ptr<Batch> batch) {
+  RowSet row_set;
+  for (auto const& kv : batch->lookups) row_set.Append(kv.first);
+  AsyncReadRowsImpl(table_, std::move(row_set), filter_)
+      .then([batch](future<StatusOr<std::vector<Row>>> f) {
+        OnReadDone(*batch, f.get());
+      });
+}
+
+void ReadRowBatcher::OnReadDone(Batch& batch, StatusOr<std::vector<Row>> rows) {
+  if (!rows) {
+    for (auto& kv : batch.lookups) {
+      for (auto& p : kv.second) p.set_value(rows.status());
+    }
+    return;
+  }
+  for (auto& row : *rows) {
+    auto l = batch.lookups.find(row.row_key());
+    if (l == batch.lookups.end()) continue;
+    for (auto& p : l->second) p.set_value(std::make_pair(true, row));
+    batch.lookups.erase(l);
+  }
+  // The rows not returned by the service do not exist.
+  for (auto& kv : batch.lookups) {
+    for (auto& p : kv.second) p.set_value(std::make_pair(false, Row("", {})));
+  }
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,144 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_BATCHER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Coalesce point reads into `ReadRows` requests for many rows.
+ *
+ * Each call to `Table::AsyncReadRow()` starts a separate streaming RPC.
+ * Applications issuing many concurrent point reads can use this class
+ * instead: the row keys requested within a short window (see
+ * `Options::SetMaxDelay()`) are sent in a single `ReadRows` request, and the
+ * results are delivered to each caller. A request is sent as soon as it has
+ * `Options::max_keys_per_request` different keys. Reads of the same row in the
+ * same window share the request and the result.
+ *
+ * All the reads use the filter provided in the constructor.
+ *
+ * Applications must provide a `CompletionQueue` to run the timers for each
+ * window. The `ReadRows` requests run in the background threads of the
+ * `Table`.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ */
+class ReadRowBatcher {
+ public:
+  /// Configuration for `ReadRowBatcher`.
+  struct Options {
+    Options();
+
+    /// A single request will not ask for more rows than this.
+    Options& SetMaxKeysPerRequest(std::size_t max_keys_per_request_arg);
+
+    /// Wait at most this long for more keys before sending a request.
+    Options& SetMaxDelay(std::chrono::microseconds max_delay_arg) {
+      max_delay = max_delay_arg;
+      return *this;
+    }
+
+    std::size_t max_keys_per_request;
+    std::chrono::microseconds max_delay;
+  };
+
+  ReadRowBatcher(Table table, Filter filter, Options options = Options())
+      : table_(std::move(table)),
+        filter_(std::move(filter)),
+        options_(std::move(options)) {}
+
+  virtual ~ReadRowBatcher() = default;
+
+  /**
+   * Asynchronously read a single row.
+   *
+   * @param cq the completion queue that will run the timer for the current
+   *     window, the application must ensure that one or more threads are
+   *     blocked on `cq.Run()`.
+   * @param row_key the row to read.
+   * @returns a future with the same semantics as `Table::AsyncReadRow()`. If
+   *     the request fails all the reads in the same request fail with the same
+   *     error.
+   */
+  future<StatusOr<std::pair<bool, Row>>> AsyncReadRow(CompletionQueue& cq,
+                                                      std::string row_key);
+
+  /**
+   * Asynchronously read several rows.
+   *
+   * The rows are read as if `AsyncReadRow()` was called for each key. The
+   * returned future is satisfied once all the reads complete, and the results
+   * are in the same order as @p row_keys.
+   */
+  future<std::vector<StatusOr<std::pair<bool, Row>>>> AsyncReadRows(
+      CompletionQueue& cq, std::vector<std::string> row_keys);
+
+ protected:
+  // Wrap calling underlying operation in a virtual function to ease testing.
+  virtual future<StatusOr<std::vector<Row>>> AsyncReadRowsImpl(
+      Table& table, RowSet row_set, Filter filter);
+
+ private:
+  using Result = StatusOr<std::pair<bool, Row>>;
+
+  /// The keys requested in a window, with the promises for each key.
+  struct Batch {
+    std::unordered_map<std::string, std::vector<promise<Result>>> lookups;
+    /// Set once the batch is sent, the timer may fire afterwards.
+    std::atomic<bool> sent{false};
+  };
+
+  void OnTimer(std::shared_ptr<Batch> const& batch);
+  void Send(std::shared_ptr<Batch> batch);
+  static void OnReadDone(Batch& batch, StatusOr<std::vector<Row>> rows);
+
+  Table table_;
+  Filter const filter_;
+  Options const options_;
+
+  std::mutex mu_;
+  /// The batch for the current window, null if there are no pending keys.
+  std::shared_ptr<Batch> current_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_BATCHER_H
@@ -0,0 +1,161 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_row_batcher.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+using ::testing::UnorderedElementsAre;
+
+template <typename T>
+bool Unsatisfied(future<T> const& fut) {
+  return std::future_status::timeout == fut.wait_for(1_ms);
+}
+
+/// Capture the requests instead of calling the service.
+class TestReadRowBatcher : public ReadRowBatcher {
+ public:
+  TestReadRowBatcher(Table table, Options options)
+      : ReadRowBatcher(std::move(table), Filter::PassAllFilter(),
+                       std::move(options)) {}
+
+  /// The row keys in each request.
+  std::vector<std::vector<std::string>> requests;
+  /// The i-th promise satisfies the i-th request.
+  std::deque<promise<StatusOr<std::vector<Row>>>> responses;
+
+ protected:
+  future<StatusOr<std::vector<Row>>> AsyncReadRowsImpl(Table&, RowSet row_set,
+                                                       Filter) override {
+    auto const& keys = row_set.as_proto().row_keys();
+    requests.emplace_back(keys.begin(), keys.end());
+    responses.emplace_back();
+    return responses.back().get_future();
+  }
+};
+
+class ReadRowBatcherTest : public bigtable::testing::TableTestFixture {
+ protected:
+  ReadRowBatcherTest()
+      : TableTestFixture(
+            CompletionQueue(std::make_shared<FakeCompletionQueueImpl>())) {}
+
+  static Row MakeRow(std::string row_key) {
+    return Row(row_key, {Cell(row_key, "fam", "col", 0, "value")});
+  }
+};
+
+TEST_F(ReadRowBatcherTest, CoalesceWithinWindow) {
+  TestReadRowBatcher batcher(table_, ReadRowBatcher::Options{});
+  auto r1 = batcher.AsyncReadRow(cq_, "r1");
+  auto r2 = batcher.AsyncReadRow(cq_, "r2");
+  EXPECT_TRUE(batcher.requests.empty());
+
+  // Fire the timer for the window.
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(1U, batcher.requests.size());
+  EXPECT_THAT(batcher.requests[0], UnorderedElementsAre("r1", "r2"));
+  EXPECT_TRUE(Unsatisfied(r1));
+
+  batcher.responses[0].set_value(std::vector<Row>{MakeRow("r1")});
+  auto v1 = r1.get();
+  ASSERT_STATUS_OK(v1);
+  EXPECT_TRUE(v1->first);
+  EXPECT_EQ("r1", v1->second.row_key());
+  auto v2 = r2.get();
+  ASSERT_STATUS_OK(v2);
+  EXPECT_FALSE(v2->first);
+}
+
+TEST_F(ReadRowBatcherTest, MaxKeysPerRequest) {
+  TestReadRowBatcher batcher(
+      table_, ReadRowBatcher::Options{}.SetMaxKeysPerRequest(2));
+  auto r1 = batcher.AsyncReadRow(cq_, "r1");
+  auto r2 = batcher.AsyncReadRow(cq_, "r2");
+  // The request is sent as soon as it is full.
+  ASSERT_EQ(1U, batcher.requests.size());
+  EXPECT_THAT(batcher.requests[0], UnorderedElementsAre("r1", "r2"));
+
+  auto r3 = batcher.AsyncReadRow(cq_, "r3");
+  // Both the timer for the first window, which does nothing, and the timer for
+  // the second window fire.
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(2U, batcher.requests.size());
+  EXPECT_THAT(batcher.requests[1], UnorderedElementsAre("r3"));
+
+  batcher.responses[0].set_value(
+      std::vector<Row>{MakeRow("r1"), MakeRow("r2")});
+  batcher.responses[1].set_value(std::vector<Row>{MakeRow("r3")});
+  for (auto* f : {&r1, &r2, &r3}) {
+    auto v = f->get();
+    ASSERT_STATUS_OK(v);
+    EXPECT_TRUE(v->first);
+  }
+}
+
+TEST_F(ReadRowBatcherTest, DuplicateKeysShareTheResult) {
+  TestReadRowBatcher batcher(table_, ReadRowBatcher::Options{});
+  auto r1 = batcher.AsyncReadRow(cq_, "r1");
+  auto r1_again = batcher.AsyncReadRow(cq_, "r1");
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(1U, batcher.requests.size());
+  EXPECT_THAT(batcher.requests[0], UnorderedElementsAre("r1"));
+
+  batcher.responses[0].set_value(
+      Status(StatusCode::kPermissionDenied, "uh-oh"));
+  EXPECT_THAT(r1.get(), StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_THAT(r1_again.get(), StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST_F(ReadRowBatcherTest, AsyncReadRowsKeepsTheOrder) {
+  TestReadRowBatcher batcher(table_, ReadRowBatcher::Options{});
+  auto rows = batcher.AsyncReadRows(cq_, {"r3", "r1", "r2"});
+  cq_impl_->SimulateCompletion(true);
+  ASSERT_EQ(1U, batcher.requests.size());
+  EXPECT_THAT(batcher.requests[0], UnorderedElementsAre("r1", "r2", "r3"));
+  batcher.responses[0].set_value(
+      std::vector<Row>{MakeRow("r1"), MakeRow("r3")});
+
+  auto results = rows.get();
+  ASSERT_EQ(3U, results.size());
+  ASSERT_STATUS_OK(results[0]);
+  EXPECT_EQ("r3", results[0]->second.row_key());
+  ASSERT_STATUS_OK(results[1]);
+  EXPECT_EQ("r1", results[1]->second.row_key());
+  ASSERT_STATUS_OK(results[2]);
+  EXPECT_FALSE(results[2]->first);
+
+  EXPECT_TRUE(batcher.AsyncReadRows(cq_, {}).get().empty());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
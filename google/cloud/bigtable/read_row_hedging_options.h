@@ -0,0 +1,135 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_HEDGING_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_HEDGING_OPTIONS_H
+
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configure hedged reads for `Table::AsyncReadRow()`.
+ *
+ * A hedged read sends a second, identical, request if the first one has not
+ * completed after a delay. The first response is returned to the application,
+ * and the other request is cancelled. Each request picks its own channel from
+ * the connection pool, and the pool prefers the channels with fewer
+ * outstanding requests, so the second request usually avoids the channel used
+ * by the first one.
+ *
+ * The delay is either fixed, or (the default) a percentile of the latency of
+ * recent reads. Until enough reads have completed to estimate the percentile
+ * the `initial_delay` is used.
+ *
+ * The extra load is bounded by a budget: each read earns `budget_ratio`
+ * tokens, up to `max_budget_tokens`, and each hedged request spends one token.
+ * Once the budget is exhausted reads are not hedged. With the default values
+ * at most 5% of the reads are hedged over the long run.
+ *
+ * @see `Table::EnableReadRowHedging()`
+ */
+struct ReadRowHedgingOptions {
+  ReadRowHedgingOptions()
+      : delay(0),
+        initial_delay(std::chrono::milliseconds(10)),
+        min_delay(std::chrono::milliseconds(1)),
+        percentile(95.0),
+        sample_size(kDefaultSampleSize),
+        budget_ratio(0.05),
+        max_budget_tokens(10.0) {}
+
+  /**
+   * Use a fixed delay before sending the second request.
+   *
+   * A zero value (the default) uses a percentile of the recent latencies.
+   */
+  ReadRowHedgingOptions& SetDelay(std::chrono::microseconds delay_arg) {
+    delay = delay_arg;
+    return *this;
+  }
+
+  /// The delay used until enough latency samples are available.
+  ReadRowHedgingOptions& SetInitialDelay(
+      std::chrono::microseconds initial_delay_arg) {
+    initial_delay = initial_delay_arg;
+    return *this;
+  }
+
+  /// The learned delay is never shorter than this value.
+  ReadRowHedgingOptions& SetMinDelay(std::chrono::microseconds min_delay_arg) {
+    min_delay = min_delay_arg;
+    return *this;
+  }
+
+  /// The latency percentile, in the (0, 100) range, used as the delay.
+  ReadRowHedgingOptions& SetPercentile(double percentile_arg) {
+    percentile = percentile_arg;
+    return *this;
+  }
+
+  /// The number of recent latencies used to estimate the percentile.
+  ReadRowHedgingOptions& SetSampleSize(std::size_t sample_size_arg) {
+    sample_size = sample_size_arg;
+    return *this;
+  }
+
+  /// The fraction of reads that can be hedged over the long run.
+  ReadRowHedgingOptions& SetBudgetRatio(double budget_ratio_arg) {
+    budget_ratio = budget_ratio_arg;
+    return *this;
+  }
+
+  /// The number of hedged requests allowed in a burst.
+  ReadRowHedgingOptions& SetMaxBudgetTokens(double max_budget_tokens_arg) {
+    max_budget_tokens = max_budget_tokens_arg;
+    return *this;
+  }
+
+  static std::size_t constexpr kDefaultSampleSize = 1000;
+
+  std::chrono::microseconds delay;
+  std::chrono::microseconds initial_delay;
+  std::chrono::microseconds min_delay;
+  double percentile;
+  std::size_t sample_size;
+  double budget_ratio;
+  double max_budget_tokens;
+};
+
+/// Counters for hedged reads, see `Table::read_row_hedging_stats()`.
+struct ReadRowHedgingStats {
+  /// The number of reads using the hedging policy.
+  std::int64_t reads = 0;
+  /// The number of reads that sent a second request.
+  std::int64_t hedged = 0;
+  /// The number of hedged reads where the second request answered first.
+  std::int64_t hedge_wins = 0;
+  /// The number of reads that could not be hedged because of the budget.
+  std::int64_t budget_exhausted = 0;
+  /// The current delay before sending a second request.
+  std::chrono::microseconds current_delay{0};
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_HEDGING_OPTIONS_H
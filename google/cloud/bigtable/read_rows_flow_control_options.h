@@ -0,0 +1,68 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROWS_FLOW_CONTROL_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROWS_FLOW_CONTROL_OPTIONS_H
+
+#include "google/cloud/bigtable/version.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configure the memory budget for `Table::AsyncReadRows()`.
+ *
+ * The rows received by all the streams share a budget. A row is outstanding
+ * from the moment it is parsed until the future returned by the `on_row`
+ * callback is satisfied. While the outstanding rows use more than
+ * `max_outstanding_bytes` the streams do not read any more responses.
+ *
+ * Each stream parses a whole response before it is accounted for, so the
+ * memory used can exceed the budget by up to one response per stream.
+ *
+ * @see `Table::EnableReadRowsFlowControl()`
+ */
+struct ReadRowsFlowControlOptions {
+  ReadRowsFlowControlOptions()
+      : max_outstanding_bytes(kDefaultMaxOutstandingBytes) {}
+
+  /// Stop reading once the outstanding rows use this many bytes.
+  ReadRowsFlowControlOptions& SetMaxOutstandingBytes(
+      std::size_t max_outstanding_bytes_arg) {
+    max_outstanding_bytes = max_outstanding_bytes_arg;
+    return *this;
+  }
+
+  static std::size_t constexpr kDefaultMaxOutstandingBytes = 64 * 1024 * 1024;
+
+  std::size_t max_outstanding_bytes;
+};
+
+/// Counters for the flow control, see `Table::read_rows_flow_control_stats()`.
+struct ReadRowsFlowControlStats {
+  /// The size of the rows received but not released by the application.
+  std::size_t outstanding_bytes = 0;
+  /// The number of reads delayed because the budget was exhausted.
+  std::int64_t paused_reads = 0;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROWS_FLOW_CONTROL_OPTIONS_H
@@ -0,0 +1,56 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_batch.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+Cell CellView::ToCell() const {
+  std::vector<std::string> labels;
+  labels.reserve(labels_.size());
+  for (auto const& l : labels_) labels.emplace_back(l.data(), l.size());
+  return Cell(RowKeyType(row_key_.data(), row_key_.size()),
+              std::string(family_name_.data(), family_name_.size()),
+              ColumnQualifierType(column_qualifier_.data(),
+                                  column_qualifier_.size()),
+              timestamp_, CellValueType(value_.data(), value_.size()),
+              std::move(labels));
+}
+
+Row RowView::ToRow() const {
+  std::vector<Cell> cells;
+  cells.reserve(cells_.size());
+  for (auto const& c : cells_) cells.push_back(c.ToCell());
+  return Row(RowKeyType(row_key_.data(), row_key_.size()), std::move(cells));
+}
+
+std::vector<RowView> const& RowBatch::rows() const {
+  static auto const* const kEmpty = new std::vector<RowView>;
+  return storage_ ? storage_->rows : *kEmpty;
+}
+
+std::vector<Row> RowBatch::ToRows() const {
+  std::vector<Row> result;
+  result.reserve(size());
+  for (auto const& r : rows()) result.push_back(r.ToRow());
+  return result;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,167 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_H
+
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A read-only view of a Bigtable cell in a `RowBatch`.
+ *
+ * The accessors return views into the `ReadRowsResponse` messages received
+ * from the service, the data is not copied. The views are valid only while the
+ * `RowBatch` containing this cell, or a copy of it, is alive.
+ */
+class CellView {
+ public:
+  CellView(absl::string_view row_key, absl::string_view family_name,
+           absl::string_view column_qualifier, std::int64_t timestamp,
+           absl::string_view value, std::vector<absl::string_view> labels)
+      : row_key_(row_key),
+        family_name_(family_name),
+        column_qualifier_(column_qualifier),
+        timestamp_(timestamp),
+        value_(value),
+        labels_(std::move(labels)) {}
+
+  /// Return the row key this cell belongs to.
+  absl::string_view row_key() const { return row_key_; }
+
+  /// Return the family this cell belongs to.
+  absl::string_view family_name() const { return family_name_; }
+
+  /// Return the column this cell belongs to.
+  absl::string_view column_qualifier() const { return column_qualifier_; }
+
+  /// Return the timestamp of this cell.
+  std::chrono::microseconds timestamp() const {
+    return std::chrono::microseconds(timestamp_);
+  }
+
+  /// Return the contents of this cell.
+  absl::string_view value() const { return value_; }
+
+  /// Return the labels applied to this cell by label transformer read filters.
+  std::vector<absl::string_view> const& labels() const { return labels_; }
+
+  /// Copy the contents of this view into a `Cell` that owns its data.
+  Cell ToCell() const;
+
+ private:
+  absl::string_view row_key_;
+  absl::string_view family_name_;
+  absl::string_view column_qualifier_;
+  std::int64_t timestamp_;
+  absl::string_view value_;
+  std::vector<absl::string_view> labels_;
+};
+
+/**
+ * A read-only view of a Bigtable row in a `RowBatch`.
+ *
+ * As with `CellView`, the row key and cells are valid only while the
+ * `RowBatch` containing this row is alive.
+ */
+class RowView {
+ public:
+  RowView(absl::string_view row_key, absl::Span<CellView const> cells)
+      : row_key_(row_key), cells_(cells) {}
+
+  /// Return the row key.
+  absl::string_view row_key() const { return row_key_; }
+
+  /// Return all cells.
+  absl::Span<CellView const> cells() const { return cells_; }
+
+  /// Copy the contents of this view into a `Row` that owns its data.
+  Row ToRow() const;
+
+ private:
+  absl::string_view row_key_;
+  absl::Span<CellView const> cells_;
+};
+
+namespace internal {
+/**
+ * Holds the data referenced by the views in a `RowBatch`.
+ *
+ * The responses are typically allocated in a `google::protobuf::Arena`, and
+ * the `std::shared_ptr<>` keeps the arena alive. The values split across
+ * multiple chunks are reassembled in `values`, all other strings are views
+ * into the responses.
+ */
+struct RowBatchStorage {
+  std::vector<std::shared_ptr<google::bigtable::v2::ReadRowsResponse const>>
+      responses;
+  std::vector<std::unique_ptr<std::string>> values;
+  std::vector<CellView> cells;
+  std::vector<RowView> rows;
+};
+}  // namespace internal
+
+/**
+ * A group of rows returned by `RowBatchReader`, stored without copies.
+ *
+ * Parsing a `ReadRowsResponse` into `Row` objects copies the row key, column
+ * family, and column qualifier into each `Cell`. Applications that scan large
+ * tables may prefer to examine the data in place: the `RowView` and `CellView`
+ * objects in a batch refer directly to the buffers of the responses received
+ * from the service.
+ *
+ * The batch shares ownership of these buffers, copying a `RowBatch` is cheap,
+ * and the views remain valid as long as any copy is alive. Use `ToRows()` to
+ * obtain rows that do not depend on the batch.
+ */
+class RowBatch {
+ public:
+  RowBatch() = default;
+  explicit RowBatch(std::shared_ptr<internal::RowBatchStorage const> storage)
+      : storage_(std::move(storage)) {}
+
+  /// The rows in this batch, in the order returned by the service.
+  std::vector<RowView> const& rows() const;
+
+  /// The number of rows in this batch.
+  std::size_t size() const { return rows().size(); }
+
+  /// True if the batch has no rows.
+  bool empty() const { return rows().empty(); }
+
+  /// Copy all the rows into objects that own their data.
+  std::vector<Row> ToRows() const;
+
+ private:
+  std::shared_ptr<internal::RowBatchStorage const> storage_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_H
@@ -0,0 +1,178 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_batch_reader.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/arena.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+RowBatchReader::RowBatchReader(
+    std::shared_ptr<DataClient> client, std::string app_profile_id,
+    std::string table_name, RowSet row_set, std::int64_t rows_limit,
+    Filter filter, std::unique_ptr<RPCRetryPolicy> retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> backoff_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::unique_ptr<internal::ReadRowsParserFactory> parser_factory)
+    : client_(std::move(client)),
+      app_profile_id_(std::move(app_profile_id)),
+      table_name_(std::move(table_name)),
+      row_set_(std::move(row_set)),
+      rows_limit_(rows_limit),
+      filter_(std::move(filter)),
+      retry_policy_(std::move(retry_policy)),
+      backoff_policy_(std::move(backoff_policy)),
+      metadata_update_policy_(std::move(metadata_update_policy)),
+      parser_factory_(std::move(parser_factory)),
+      stream_is_open_(false),
+      operation_cancelled_(false),
+      finished_(false),
+      rows_count_(0) {}
+
+void RowBatchReader::MakeRequest() {
+  google::bigtable::v2::ReadRowsRequest request;
+  request.set_table_name(table_name_);
+  request.set_app_profile_id(app_profile_id_);
+
+  // The remaining rows are swapped into the request, and back out once it is
+  // sent, to avoid copying them.
+  row_set_.Swap(*request.mutable_rows());
+
+  auto filter_proto = filter_.as_proto();
+  request.mutable_filter()->Swap(&filter_proto);
+
+  if (rows_limit_ != NO_ROWS_LIMIT) {
+    request.set_rows_limit(rows_limit_ - rows_count_);
+  }
+
+  context_ = absl::make_unique<grpc::ClientContext>();
+  retry_policy_->Setup(*context_);
+  backoff_policy_->Setup(*context_);
+  metadata_update_policy_.Setup(*context_);
+  stream_ = client_->ReadRows(context_.get(), request);
+  row_set_.Swap(*request.mutable_rows());
+  stream_is_open_ = true;
+
+  parser_ = parser_factory_->CreateBatchParser();
+}
+
+RowBatchReader::ResponsePtr RowBatchReader::ReadResponse() {
+  // Parsing into an arena allocates the strings in a few large blocks, and
+  // the arena is released only when the last batch referencing it is deleted.
+  auto arena = std::make_shared<google::protobuf::Arena>();
+  auto* response = google::protobuf::Arena::CreateMessage<
+      google::bigtable::v2::ReadRowsResponse>(arena.get());
+  if (!stream_->Read(response)) return nullptr;
+  return ResponsePtr(std::move(arena), response);
+}
+
+StatusOr<RowBatch> RowBatchReader::Next() {
+  if (operation_cancelled_) {
+    return Status(StatusCode::kCancelled, "Operation cancelled.");
+  }
+  while (true) {
+    RowBatch batch;
+    grpc::Status status = NextOrFail(batch);
+    if (status.ok()) return batch;
+
+    // See RowReader::Advance(), there is nothing left to read if the limit
+    // is reached or all the rows were returned.
+    if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
+      finished_ = true;
+      return RowBatch{};
+    }
+
+    if (!last_read_row_key_.empty()) {
+      // We've returned some rows and need to make sure we don't
+      // request them again.
+      row_set_.Advance(last_read_row_key_);
+    }
+
+    if (row_set_.IsEmpty()) {
+      finished_ = true;
+      return RowBatch{};
+    }
+
+    if (!retry_policy_->OnFailure(status)) {
+      return MakeStatusFromRpcError(status);
+    }
+
+    auto delay = backoff_policy_->OnCompletion(status);
+    std::this_thread::sleep_for(delay);
+
+    // If we reach this place, we failed and need to restart the call.
+    MakeRequest();
+  }
+}
+
+grpc::Status RowBatchReader::NextOrFail(RowBatch& batch) {
+  grpc::Status status;
+  if (finished_) return status;
+  if (!stream_) MakeRequest();
+  while (!parser_->HasRows()) {
+    auto response = ReadResponse();
+    if (response) {
+      parser_->HandleResponse(std::move(response), status);
+      if (!status.ok()) return status;
+      continue;
+    }
+
+    // Here, there are no more responses. Close the stream, finalize the
+    // parser and return OK with no rows unless something fails during
+    // cleanup.
+    stream_is_open_ = false;
+    status = stream_->Finish();
+    if (!status.ok()) return status;
+    parser_->HandleEndOfStream(status);
+    if (status.ok()) finished_ = true;
+    return status;
+  }
+
+  batch = parser_->TakeBatch();
+  rows_count_ += static_cast<std::int64_t>(batch.size());
+  auto const last = parser_->last_row_key();
+  last_read_row_key_.assign(last.data(), last.size());
+  return status;
+}
+
+void RowBatchReader::Cancel() {
+  operation_cancelled_ = true;
+  if (!stream_is_open_) {
+    return;
+  }
+  context_->TryCancel();
+
+  // Also drain any data left unread
+  google::bigtable::v2::ReadRowsResponse response;
+  while (stream_->Read(&response)) {
+  }
+
+  stream_is_open_ = false;
+  (void)stream_->Finish();  // ignore errors
+}
+
+RowBatchReader::~RowBatchReader() {
+  // Make sure we don't leave open streams.
+  Cancel();
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,142 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_READER_H
+
+#include "google/cloud/bigtable/data_client.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/row_set_cursor.h"
+#include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/bigtable/row_batch.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/rpc_backoff_policy.h"
+#include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <cinttypes>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Object returned by Table::ReadRowBatches(), enumerates rows in batches.
+ *
+ * Each `ReadRowsResponse` is parsed into a `google::protobuf::Arena`, and the
+ * `RowBatch` objects returned by `Next()` refer to the data in those arenas
+ * without copying it. This avoids most per-cell allocations when scanning
+ * large tables, at the cost of tying the lifetime of the data to the batch.
+ *
+ * @par Thread-safety
+ * Two threads operating concurrently on the same instance of this class are
+ * **not** guaranteed to work. The `RowBatch` objects returned by `Next()` are
+ * immutable and can be shared between threads.
+ *
+ * @par Example
+ * @code
+ * auto reader = table.ReadRowBatches(bigtable::RowSet(), filter);
+ * for (;;) {
+ *   auto batch = reader.Next();
+ *   if (!batch) return batch.status();
+ *   if (batch->empty()) break;  // all the rows have been read
+ *   for (auto const& row : batch->rows()) {
+ *     // row.row_key() and row.cells() are valid while `*batch` is alive.
+ *   }
+ * }
+ * @endcode
+ */
+class RowBatchReader {
+ public:
+  /// A constant for the magic value that means "no limit, get all rows".
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  static std::int64_t constexpr NO_ROWS_LIMIT = 0;
+
+  RowBatchReader(
+      std::shared_ptr<DataClient> client, std::string app_profile_id,
+      std::string table_name, RowSet row_set, std::int64_t rows_limit,
+      Filter filter, std::unique_ptr<RPCRetryPolicy> retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> backoff_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory);
+
+  RowBatchReader(RowBatchReader&&) noexcept = default;
+
+  ~RowBatchReader();
+
+  /**
+   * Read the next batch of rows.
+   *
+   * This call blocks until at least one complete row is received, or the
+   * stream reaches its end. Retry and backoff policies are honored.
+   *
+   * @returns the rows received since the previous call, an empty batch
+   *     indicates that all the rows have been read.
+   */
+  StatusOr<RowBatch> Next();
+
+  /// Gracefully terminate a streaming read.
+  void Cancel();
+
+ private:
+  using ResponsePtr = internal::ReadRowsBatchParser::ResponsePtr;
+
+  /// Called by Next(), does not handle retries.
+  grpc::Status NextOrFail(RowBatch& batch);
+
+  /// Read the next response into its own arena, returns null at end of stream.
+  ResponsePtr ReadResponse();
+
+  /// Sends the ReadRows request to the stub.
+  void MakeRequest();
+
+  std::shared_ptr<DataClient> client_;
+  std::string app_profile_id_;
+  std::string table_name_;
+  /// The rows not yet returned, advanced as rows are received.
+  internal::RowSetCursor row_set_;
+  std::int64_t rows_limit_;
+  Filter filter_;
+  std::unique_ptr<RPCRetryPolicy> retry_policy_;
+  std::unique_ptr<RPCBackoffPolicy> backoff_policy_;
+  MetadataUpdatePolicy metadata_update_policy_;
+
+  std::unique_ptr<grpc::ClientContext> context_;
+
+  std::unique_ptr<internal::ReadRowsParserFactory> parser_factory_;
+  std::unique_ptr<internal::ReadRowsBatchParser> parser_;
+  std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>>
+      stream_;
+  bool stream_is_open_;
+  bool operation_cancelled_;
+  bool finished_;
+
+  /// Number of rows read so far, used to set row_limit in retries.
+  std::int64_t rows_count_;
+  /// Holds the last read row key, for retries.
+  RowKeyType last_read_row_key_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_READER_H
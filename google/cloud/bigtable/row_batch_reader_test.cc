@@ -0,0 +1,277 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_batch_reader.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+using ::google::bigtable::v2::ReadRowsRequest;
+using ::google::cloud::bigtable::testing::MockReadRowsReader;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Matcher;
+using ::testing::Property;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+// Match the number of row ranges in a request in EXPECT_CALL
+Matcher<ReadRowsRequest const&> RequestWithRowRangesCount(int n) {
+  return Property(
+      &ReadRowsRequest::rows,
+      Property(&google::bigtable::v2::RowSet::row_ranges_size, Eq(n)));
+}
+
+// Match a request for a single range starting after `key`
+Matcher<ReadRowsRequest const&> RequestStartingAfter(std::string key) {
+  return Property(
+      &ReadRowsRequest::rows,
+      Property(&google::bigtable::v2::RowSet::row_ranges,
+               ElementsAre(Property(&google::bigtable::v2::RowRange::
+                                        start_key_open,
+                                    Eq(std::move(key))))));
+}
+
+// Match the row limit in a request
+Matcher<ReadRowsRequest const&> RequestWithRowsLimit(std::int64_t n) {
+  return Property(&ReadRowsRequest::rows_limit, Eq(n));
+}
+
+class RowBatchReaderTest : public bigtable::testing::TableTestFixture {
+ public:
+  RowBatchReaderTest() : TableTestFixture(CompletionQueue{}) {}
+};
+
+TEST_F(RowBatchReaderTest, EmptyTable) {
+  // must be a new pointer, it is wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows).WillOnce(stream->MakeMockReturner());
+
+  auto reader = table_.ReadRowBatches(bigtable::RowSet(),
+                                      bigtable::Filter::PassAllFilter());
+  auto batch = reader.Next();
+  ASSERT_STATUS_OK(batch);
+  EXPECT_TRUE(batch->empty());
+  // Calling Next() after the end is harmless.
+  batch = reader.Next();
+  ASSERT_STATUS_OK(batch);
+  EXPECT_TRUE(batch->empty());
+}
+
+TEST_F(RowBatchReaderTest, ReadsOneBatchPerResponse) {
+  auto r1 = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "v1"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "v2"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r3"
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "v3"
+      }
+      )");
+  auto r2 = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        qualifier { value: "qual2" }
+        timestamp_micros: 42000
+        value: "v4"
+        commit_row: true
+      }
+      )");
+
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read)
+      .WillOnce(DoAll(SetArgPointee<0>(r1), Return(true)))
+      .WillOnce(DoAll(SetArgPointee<0>(r2), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows).WillOnce(stream->MakeMockReturner());
+
+  auto reader = table_.ReadRowBatches(bigtable::RowSet(),
+                                      bigtable::Filter::PassAllFilter());
+  auto first = reader.Next();
+  ASSERT_STATUS_OK(first);
+  ASSERT_EQ(2, first->size());
+  EXPECT_EQ("r1", first->rows()[0].row_key());
+  EXPECT_EQ("v1", first->rows()[0].cells()[0].value());
+  EXPECT_EQ("r2", first->rows()[1].row_key());
+  EXPECT_EQ("fam", first->rows()[1].cells()[0].family_name());
+
+  auto second = reader.Next();
+  ASSERT_STATUS_OK(second);
+  ASSERT_EQ(1, second->size());
+  auto const& row = second->rows()[0];
+  EXPECT_EQ("r3", row.row_key());
+  ASSERT_EQ(2, row.cells().size());
+  EXPECT_EQ("v3", row.cells()[0].value());
+  EXPECT_EQ("qual2", row.cells()[1].column_qualifier());
+  EXPECT_EQ("v4", row.cells()[1].value());
+
+  auto last = reader.Next();
+  ASSERT_STATUS_OK(last);
+  EXPECT_TRUE(last->empty());
+
+  // The first batch remains valid after reading the rest of the stream.
+  EXPECT_EQ("v2", first->rows()[1].cells()[0].value());
+}
+
+TEST_F(RowBatchReaderTest, RetrySkipsReturnedRows) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      )");
+  auto response_retry = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      )");
+
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto* stream_retry =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowRangesCount(1)))
+        .WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read)
+        .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(
+            Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")));
+
+    // The retry starts after the last row returned to the application.
+    EXPECT_CALL(*client_, ReadRows(_, RequestStartingAfter("r1")))
+        .WillOnce(stream_retry->MakeMockReturner());
+    EXPECT_CALL(*stream_retry, Read)
+        .WillOnce(DoAll(SetArgPointee<0>(response_retry), Return(true)))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  auto reader = table_.ReadRowBatches(
+      bigtable::RowSet(bigtable::RowRange::InfiniteRange()),
+      bigtable::Filter::PassAllFilter());
+  auto batch = reader.Next();
+  ASSERT_STATUS_OK(batch);
+  ASSERT_EQ(1, batch->size());
+  EXPECT_EQ("r1", batch->rows()[0].row_key());
+
+  batch = reader.Next();
+  ASSERT_STATUS_OK(batch);
+  ASSERT_EQ(1, batch->size());
+  EXPECT_EQ("r2", batch->rows()[0].row_key());
+
+  batch = reader.Next();
+  ASSERT_STATUS_OK(batch);
+  EXPECT_TRUE(batch->empty());
+}
+
+TEST_F(RowBatchReaderTest, RetryUsesRemainingRowsLimit) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      )");
+
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto* stream_retry =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowsLimit(3)))
+        .WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read)
+        .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(
+            Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")));
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowsLimit(2)))
+        .WillOnce(stream_retry->MakeMockReturner());
+    EXPECT_CALL(*stream_retry, Read).WillOnce(Return(false));
+    EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  auto reader = table_.ReadRowBatches(bigtable::RowSet(), 3,
+                                      bigtable::Filter::PassAllFilter());
+  auto batch = reader.Next();
+  ASSERT_STATUS_OK(batch);
+  ASSERT_EQ(1, batch->size());
+
+  batch = reader.Next();
+  ASSERT_STATUS_OK(batch);
+  EXPECT_TRUE(batch->empty());
+}
+
+TEST_F(RowBatchReaderTest, PermanentError) {
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh")));
+  EXPECT_CALL(*client_, ReadRows).WillOnce(stream->MakeMockReturner());
+
+  auto reader = table_.ReadRowBatches(bigtable::RowSet(),
+                                      bigtable::Filter::PassAllFilter());
+  auto batch = reader.Next();
+  EXPECT_THAT(batch, StatusIs(StatusCode::kPermissionDenied));
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
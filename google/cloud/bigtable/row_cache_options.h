@@ -0,0 +1,80 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_OPTIONS_H
+
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configure the client-side row cache used by `Table::ReadRow()`.
+ *
+ * The cache keeps the results of recent `ReadRow()` and `AsyncReadRow()`
+ * calls, keyed by the row key and the filter. Entries expire after a fixed
+ * time, and the least recently used entries are evicted once the cache is
+ * full. Writes made through the same `Table`, or through its copies, remove
+ * any cached results for the rows they modify. Writes made by other clients
+ * are only visible once the cached results expire.
+ *
+ * @see `Table::EnableRowCache()`
+ */
+struct RowCacheOptions {
+  RowCacheOptions()
+      : max_entries(kDefaultMaxEntries), ttl(std::chrono::seconds(1)) {}
+
+  /**
+   * The cache keeps at most this many results.
+   *
+   * The same row read with different filters uses one entry for each filter.
+   */
+  RowCacheOptions& SetMaxEntries(std::size_t max_entries_arg) {
+    max_entries = max_entries_arg;
+    return *this;
+  }
+
+  /// The cached results are discarded after this time.
+  RowCacheOptions& SetTtl(std::chrono::milliseconds ttl_arg) {
+    ttl = ttl_arg;
+    return *this;
+  }
+
+  static std::size_t constexpr kDefaultMaxEntries = 10000;
+
+  std::size_t max_entries;
+  std::chrono::milliseconds ttl;
+};
+
+/// Counters for the client-side row cache, see `Table::row_cache_stats()`.
+struct RowCacheStats {
+  /// The number of reads returned from the cache.
+  std::int64_t hits = 0;
+  /// The number of reads sent to the service.
+  std::int64_t misses = 0;
+  /// The number of results currently in the cache.
+  std::size_t size = 0;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_OPTIONS_H
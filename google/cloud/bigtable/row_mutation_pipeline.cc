@@ -0,0 +1,134 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/row_mutation_pipeline.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/// The arguments of a queued `AsyncCheckAndMutateRow()` call.
+struct CheckAndMutateArgs {
+  std::string row_key;
+  Filter filter;
+  std::vector<Mutation> true_mutations;
+  std::vector<Mutation> false_mutations;
+};
+
+}  // namespace
+
+future<StatusOr<MutationBranch>> RowMutationPipeline::AsyncCheckAndMutateRow(
+    std::string row_key, Filter filter, std::vector<Mutation> true_mutations,
+    std::vector<Mutation> false_mutations) {
+  auto args = std::make_shared<CheckAndMutateArgs>(CheckAndMutateArgs{
+      std::move(row_key), std::move(filter), std::move(true_mutations),
+      std::move(false_mutations)});
+  auto p = std::make_shared<promise<StatusOr<MutationBranch>>>();
+  auto f = p->get_future();
+  // Each operation runs once, it can consume its arguments.
+  Schedule(args->row_key, [this, args, p] {
+    return AsyncCheckAndMutateRowImpl(table_, args->row_key,
+                                      std::move(args->filter),
+                                      std::move(args->true_mutations),
+                                      std::move(args->false_mutations))
+        .then([p](future<StatusOr<MutationBranch>> g) {
+          p->set_value(g.get());
+        });
+  });
+  return f;
+}
+
+std::size_t RowMutationPipeline::active_rows() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return rows_.size();
+}
+
+future<StatusOr<MutationBranch>>
+RowMutationPipeline::AsyncCheckAndMutateRowImpl(
+    Table& table, std::string row_key, Filter filter,
+    std::vector<Mutation> true_mutations,
+    std::vector<Mutation> false_mutations) {
+  return table.AsyncCheckAndMutateRow(std::move(row_key), std::move(filter),
+                                      std::move(true_mutations),
+                                      std::move(false_mutations));
+}
+
+future<StatusOr<Row>> RowMutationPipeline::AsyncReadModifyWriteRowImpl(
+    Table& table, google::bigtable::v2::ReadModifyWriteRowRequest request) {
+  return table.AsyncReadModifyWriteRowImpl(std::move(request));
+}
+
+future<StatusOr<Row>> RowMutationPipeline::ScheduleReadModifyWriteRow(
+    google::bigtable::v2::ReadModifyWriteRowRequest request) {
+  auto r = std::make_shared<google::bigtable::v2::ReadModifyWriteRowRequest>(
+      std::move(request));
+  auto p = std::make_shared<promise<StatusOr<Row>>>();
+  auto f = p->get_future();
+  Schedule(r->row_key(), [this, r, p] {
+    return AsyncReadModifyWriteRowImpl(table_, std::move(*r))
+        .then([p](future<StatusOr<Row>> g) { p->set_value(g.get()); });
+  });
+  return f;
+}
+
+void RowMutationPipeline::Schedule(std::string const& row_key, Operation op) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto ins = rows_.emplace(row_key, std::deque<Operation>{});
+  if (!ins.second) {
+    ins.first->second.push_back(std::move(op));
+    return;
+  }
+  lk.unlock();
+  Run(row_key, std::move(op));
+}
+
+void RowMutationPipeline::Run(std::string const& row_key, Operation op) {
+  // Operations that complete immediately are handled in this loop, a long
+  // queue of them would otherwise recurse once per operation.
+  for (;;) {
+    auto done = op();
+    if (!done.is_ready()) {
+      done.then([this, row_key](future<void>) {
+        auto next = PopNext(row_key);
+        if (next) Run(row_key, *std::move(next));
+      });
+      return;
+    }
+    auto next = PopNext(row_key);
+    if (!next) return;
+    op = *std::move(next);
+  }
+}
+
+absl::optional<RowMutationPipeline::Operation> RowMutationPipeline::PopNext(
+    std::string const& row_key) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto i = rows_.find(row_key);
+  if (i->second.empty()) {
+    rows_.erase(i);
+    return absl::nullopt;
+  }
+  absl::optional<Operation> op(std::move(i->second.front()));
+  i->second.pop_front();
+  return op;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_MUTATION_PIPELINE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_MUTATION_PIPELINE_H
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include "absl/meta/type_traits.h"
+#include "absl/types/optional.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Run the conditional mutations for each row in the order they are received.
+ *
+ * `Table::AsyncCheckAndMutateRow()` and `Table::AsyncReadModifyWriteRow()`
+ * start a new RPC for each call, concurrent calls for the same row may be
+ * applied in any order. Applications that implement a state machine on a row
+ * with a chain of conditional updates need each update to see the result of
+ * the previous one. This class starts the operations for each row one at a
+ * time, in the order they were received, while the operations for different
+ * rows run concurrently.
+ *
+ * None of the member functions block: if there is an operation in progress
+ * for the row the new operation is queued, and it starts once the previous
+ * operations complete. Operations that fail do not stop the queue, the
+ * application decides how to handle each result, for example, via the
+ * predicate of the next `AsyncCheckAndMutateRow()`.
+ *
+ * The RPCs run in the background threads of the `Table`, with its retry and
+ * backoff policies. The application must not delete this object while there
+ * are operations pending, i.e., while some of the returned futures are not
+ * satisfied.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ */
+class RowMutationPipeline {
+ public:
+  explicit RowMutationPipeline(Table table) : table_(std::move(table)) {}
+
+  virtual ~RowMutationPipeline() = default;
+
+  /**
+   * Conditionally mutate a row, after the pending operations for the row.
+   *
+   * @see `Table::AsyncCheckAndMutateRow()` for the description of the
+   *     parameters.
+   */
+  future<StatusOr<MutationBranch>> AsyncCheckAndMutateRow(
+      std::string row_key, Filter filter, std::vector<Mutation> true_mutations,
+      std::vector<Mutation> false_mutations);
+
+  /**
+   * Atomically read and modify a row, after the pending operations for the
+   * row.
+   *
+   * @see `Table::AsyncReadModifyWriteRow()` for the description of the
+   *     parameters.
+   */
+  template <typename... Args>
+  future<StatusOr<Row>> AsyncReadModifyWriteRow(std::string row_key,
+                                                ReadModifyWriteRule rule,
+                                                Args&&... rules) {
+    static_assert(
+        absl::conjunction<
+            std::is_convertible<Args, ReadModifyWriteRule>...>::value,
+        "The arguments passed to AsyncReadModifyWriteRow(row_key,...) must be "
+        "convertible to bigtable::ReadModifyWriteRule");
+
+    google::bigtable::v2::ReadModifyWriteRowRequest request;
+    request.set_row_key(std::move(row_key));
+    *request.add_rules() = std::move(rule).as_proto();
+    std::vector<ReadModifyWriteRule> more{std::forward<Args>(rules)...};
+    for (auto& r : more) *request.add_rules() = std::move(r).as_proto();
+    return ScheduleReadModifyWriteRow(std::move(request));
+  }
+
+  /// The number of rows with operations in progress.
+  std::size_t active_rows() const;
+
+ protected:
+  // Wrap calling underlying operations in virtual functions to ease testing.
+  virtual future<StatusOr<MutationBranch>> AsyncCheckAndMutateRowImpl(
+      Table& table, std::string row_key, Filter filter,
+      std::vector<Mutation> true_mutations,
+      std::vector<Mutation> false_mutations);
+  virtual future<StatusOr<Row>> AsyncReadModifyWriteRowImpl(
+      Table& table, google::bigtable::v2::ReadModifyWriteRowRequest request);
+
+ private:
+  /// Starts an operation, the future is satisfied once it completes.
+  using Operation = std::function<future<void>()>;
+
+  future<StatusOr<Row>> ScheduleReadModifyWriteRow(
+      google::bigtable::v2::ReadModifyWriteRowRequest request);
+  void Schedule(std::string const& row_key, Operation op);
+  void Run(std::string const& row_key, Operation op);
+  absl::optional<Operation> PopNext(std::string const& row_key);
+
+  Table table_;
+
+  mutable std::mutex mu_;
+  /// A row has an entry while it has an operation in progress, the queue
+  /// holds the operations waiting for it.
+  std::unordered_map<std::string, std::deque<Operation>> rows_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_MUTATION_PIPELINE_H
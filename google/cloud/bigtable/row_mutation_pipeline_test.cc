@@ -0,0 +1,197 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/row_mutation_pipeline.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = ::google::bigtable::v2;
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+using ::testing::ElementsAre;
+
+template <typename T>
+bool Unsatisfied(future<T> const& fut) {
+  return std::future_status::timeout == fut.wait_for(1_ms);
+}
+
+/// Capture the requests instead of calling the service.
+class TestRowMutationPipeline : public RowMutationPipeline {
+ public:
+  explicit TestRowMutationPipeline(Table table)
+      : RowMutationPipeline(std::move(table)) {}
+
+  /// The row key and operation name for each request, in the order started.
+  std::vector<std::string> requests;
+  /// The i-th promise satisfies the i-th `CheckAndMutateRow` request.
+  std::deque<promise<StatusOr<MutationBranch>>> check_and_mutate;
+  /// The i-th promise satisfies the i-th `ReadModifyWriteRow` request.
+  std::deque<promise<StatusOr<Row>>> read_modify_write;
+
+ protected:
+  future<StatusOr<MutationBranch>> AsyncCheckAndMutateRowImpl(
+      Table&, std::string row_key, Filter, std::vector<Mutation>,
+      std::vector<Mutation>) override {
+    requests.push_back(row_key + "/check-and-mutate");
+    check_and_mutate.emplace_back();
+    return check_and_mutate.back().get_future();
+  }
+
+  future<StatusOr<Row>> AsyncReadModifyWriteRowImpl(
+      Table&, btproto::ReadModifyWriteRowRequest request) override {
+    requests.push_back(request.row_key() + "/read-modify-write");
+    read_modify_write.emplace_back();
+    return read_modify_write.back().get_future();
+  }
+};
+
+/// Complete all the operations, except the first, immediately.
+class ImmediateRowMutationPipeline : public RowMutationPipeline {
+ public:
+  explicit ImmediateRowMutationPipeline(Table table)
+      : RowMutationPipeline(std::move(table)) {}
+
+  int calls = 0;
+  promise<StatusOr<MutationBranch>> first;
+
+ protected:
+  future<StatusOr<MutationBranch>> AsyncCheckAndMutateRowImpl(
+      Table&, std::string, Filter, std::vector<Mutation>,
+      std::vector<Mutation>) override {
+    if (calls++ == 0) return first.get_future();
+    return make_ready_future(
+        StatusOr<MutationBranch>(MutationBranch::kPredicateMatched));
+  }
+};
+
+class RowMutationPipelineTest : public bigtable::testing::TableTestFixture {
+ protected:
+  RowMutationPipelineTest()
+      : TableTestFixture(
+            CompletionQueue(std::make_shared<FakeCompletionQueueImpl>())) {}
+
+  static future<StatusOr<MutationBranch>> CheckAndMutate(
+      RowMutationPipeline& pipeline, std::string row_key) {
+    return pipeline.AsyncCheckAndMutateRow(
+        std::move(row_key), Filter::PassAllFilter(),
+        {SetCell("fam", "col", 0_ms, "true")},
+        {SetCell("fam", "col", 0_ms, "false")});
+  }
+};
+
+TEST_F(RowMutationPipelineTest, SerializeSameRow) {
+  TestRowMutationPipeline pipeline(table_);
+  auto f1 = CheckAndMutate(pipeline, "r1");
+  auto f2 = pipeline.AsyncReadModifyWriteRow(
+      "r1", ReadModifyWriteRule::IncrementAmount("fam", "counter", 1));
+  auto f3 = CheckAndMutate(pipeline, "r1");
+  // Only the first operation for the row is started.
+  EXPECT_THAT(pipeline.requests, ElementsAre("r1/check-and-mutate"));
+  EXPECT_EQ(1, pipeline.active_rows());
+
+  pipeline.check_and_mutate[0].set_value(MutationBranch::kPredicateMatched);
+  EXPECT_EQ(MutationBranch::kPredicateMatched, f1.get().value());
+  EXPECT_THAT(pipeline.requests,
+              ElementsAre("r1/check-and-mutate", "r1/read-modify-write"));
+  EXPECT_TRUE(Unsatisfied(f2));
+
+  // Errors do not stop the operations queued after them.
+  pipeline.read_modify_write[0].set_value(
+      Status(StatusCode::kFailedPrecondition, "uh-oh"));
+  EXPECT_THAT(f2.get(), StatusIs(StatusCode::kFailedPrecondition));
+  EXPECT_THAT(pipeline.requests,
+              ElementsAre("r1/check-and-mutate", "r1/read-modify-write",
+                          "r1/check-and-mutate"));
+
+  pipeline.check_and_mutate[1].set_value(MutationBranch::kPredicateNotMatched);
+  EXPECT_EQ(MutationBranch::kPredicateNotMatched, f3.get().value());
+  EXPECT_EQ(0, pipeline.active_rows());
+}
+
+TEST_F(RowMutationPipelineTest, PipelineDifferentRows) {
+  TestRowMutationPipeline pipeline(table_);
+  auto f1 = CheckAndMutate(pipeline, "r1");
+  auto f2 = CheckAndMutate(pipeline, "r2");
+  auto f3 = CheckAndMutate(pipeline, "r1");
+  EXPECT_THAT(pipeline.requests,
+              ElementsAre("r1/check-and-mutate", "r2/check-and-mutate"));
+  EXPECT_EQ(2, pipeline.active_rows());
+
+  // The rows are independent, the operations may complete in any order.
+  pipeline.check_and_mutate[1].set_value(MutationBranch::kPredicateMatched);
+  EXPECT_EQ(MutationBranch::kPredicateMatched, f2.get().value());
+  EXPECT_EQ(2, pipeline.requests.size());
+  EXPECT_EQ(1, pipeline.active_rows());
+
+  pipeline.check_and_mutate[0].set_value(MutationBranch::kPredicateMatched);
+  ASSERT_EQ(3, pipeline.requests.size());
+  EXPECT_EQ("r1/check-and-mutate", pipeline.requests[2]);
+  pipeline.check_and_mutate[2].set_value(MutationBranch::kPredicateMatched);
+  EXPECT_EQ(MutationBranch::kPredicateMatched, f1.get().value());
+  EXPECT_EQ(MutationBranch::kPredicateMatched, f3.get().value());
+  EXPECT_EQ(0, pipeline.active_rows());
+}
+
+TEST_F(RowMutationPipelineTest, ChainFromCallback) {
+  TestRowMutationPipeline pipeline(table_);
+  auto f1 = CheckAndMutate(pipeline, "r1");
+  // Start the next operation in the chain from the callback, it runs after
+  // the operation in progress completes.
+  future<StatusOr<MutationBranch>> f2;
+  auto done = f1.then([&](future<StatusOr<MutationBranch>> f) {
+    f2 = CheckAndMutate(pipeline, "r1");
+    return f.get();
+  });
+  pipeline.check_and_mutate[0].set_value(MutationBranch::kPredicateMatched);
+  EXPECT_EQ(MutationBranch::kPredicateMatched, done.get().value());
+  ASSERT_EQ(2, pipeline.requests.size());
+
+  pipeline.check_and_mutate[1].set_value(MutationBranch::kPredicateMatched);
+  EXPECT_EQ(MutationBranch::kPredicateMatched, f2.get().value());
+  EXPECT_EQ(0, pipeline.active_rows());
+}
+
+TEST_F(RowMutationPipelineTest, ImmediateCompletion) {
+  ImmediateRowMutationPipeline pipeline(table_);
+  auto constexpr kCount = 100000;
+  std::vector<future<StatusOr<MutationBranch>>> results;
+  for (int i = 0; i != kCount; ++i) {
+    results.push_back(CheckAndMutate(pipeline, "r1"));
+  }
+  EXPECT_EQ(1, pipeline.calls);
+  // The queued operations complete immediately, without recursing once for
+  // each operation.
+  pipeline.first.set_value(MutationBranch::kPredicateMatched);
+  EXPECT_EQ(kCount, pipeline.calls);
+  for (auto& f : results) EXPECT_STATUS_OK(f.get());
+  EXPECT_EQ(0, pipeline.active_rows());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
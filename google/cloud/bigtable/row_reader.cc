@@ -83,7 +83,6 @@ RowReader::RowReader(
       table_name_(std::move(table_name)),
       row_set_(std::move(row_set)),
       rows_limit_(rows_limit),
-      filter_(std::move(filter)),
       retry_policy_(std::move(retry_policy)),
       backoff_policy_(std::move(backoff_policy)),
       metadata_update_policy_(std::move(metadata_update_policy)),
@@ -92,7 +91,12 @@ RowReader::RowReader(
       stream_is_open_(false),
       operation_cancelled_(false),
       processed_chunks_count_(0),
-      rows_count_(0) {}
+      rows_count_(0) {
+  request_.set_table_name(table_name_);
+  request_.set_app_profile_id(app_profile_id_);
+  auto filter_proto = std::move(filter).as_proto();
+  request_.mutable_filter()->Swap(&filter_proto);
+}
 
 // The name must be all lowercase to work with range-for loops.
 RowReader::iterator RowReader::begin() {
@@ -107,25 +111,21 @@ void RowReader::MakeRequest() {
   response_ = {};
   processed_chunks_count_ = 0;
 
-  google::bigtable::v2::ReadRowsRequest request;
-  request.set_table_name(table_name_);
-  request.set_app_profile_id(app_profile_id_);
-
-  auto row_set_proto = row_set_.as_proto();
-  request.mutable_rows()->Swap(&row_set_proto);
-
-  auto filter_proto = filter_.as_proto();
-  request.mutable_filter()->Swap(&filter_proto);
+  // Only the row set and the row limit change between retries, the rest of
+  // the request (including the filter) is reused. The remaining rows are
+  // swapped into the request, and back out once it is sent.
+  row_set_.Swap(*request_.mutable_rows());
 
   if (rows_limit_ != NO_ROWS_LIMIT) {
-    request.set_rows_limit(rows_limit_ - rows_count_);
+    request_.set_rows_limit(rows_limit_ - rows_count_);
   }
 
   context_ = absl::make_unique<grpc::ClientContext>();
   retry_policy_->Setup(*context_);
   backoff_policy_->Setup(*context_);
   metadata_update_policy_.Setup(*context_);
-  stream_ = client_->ReadRows(context_.get(), request);
+  stream_ = client_->ReadRows(context_.get(), request_);
+  row_set_.Swap(*request_.mutable_rows());
   stream_is_open_ = true;
 
   parser_ = parser_factory_->Create();
@@ -148,10 +148,15 @@ StatusOr<RowReader::OptionalRow> RowReader::Advance() {
   if (operation_cancelled_) {
     return Status(StatusCode::kCancelled, "Operation cancelled.");
   }
+  // The stream was closed when the last row was returned.
+  if (RowsLimitReached()) return OptionalRow{};
   while (true) {
     OptionalRow row;
     grpc::Status status = AdvanceOrFail(row);
     if (status.ok()) {
+      // Do not wait for the server to close the stream once the application
+      // has all the rows it asked for, cancel it right away.
+      if (row && RowsLimitReached()) CloseStream();
       return row;
     }
     row.reset();
@@ -160,14 +165,12 @@ StatusOr<RowReader::OptionalRow> RowReader::Advance() {
     // number of rows and still receive an error (the parser can throw
     // an error at end of stream for example), there is no need to
     // retry and we have no good value for rows_limit anyway.
-    if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
-      return row;
-    }
+    if (RowsLimitReached()) return row;
 
     if (!last_read_row_key_.empty()) {
       // We've returned some rows and need to make sure we don't
       // request them again.
-      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+      row_set_.Advance(last_read_row_key_);
     }
 
     // If we receive an error, but the retryable set is empty, stop.
@@ -230,6 +233,10 @@ grpc::Status RowReader::AdvanceOrFail(OptionalRow& row) {
 
 void RowReader::Cancel() {
   operation_cancelled_ = true;
+  CloseStream();
+}
+
+void RowReader::CloseStream() {
   if (!stream_is_open_) {
     return;
   }
@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/row_set_cursor.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
@@ -135,12 +136,27 @@ class RowReader {
   /// Sends the ReadRows request to the stub.
   void MakeRequest();
 
+  /// True if the application received all the rows in `rows_limit_`.
+  bool RowsLimitReached() const {
+    return rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_;
+  }
+
+  /// Cancels the RPC (if it is open), drains any unread data, and finishes it.
+  void CloseStream();
+
   std::shared_ptr<DataClient> client_;
   std::string app_profile_id_;
   std::string table_name_;
-  RowSet row_set_;
+  /// The rows not yet returned, advanced as rows are received.
+  internal::RowSetCursor row_set_;
   std::int64_t rows_limit_;
-  Filter filter_;
+  /**
+   * The parts of the request that do not change between retries.
+   *
+   * The filter can be large, it is moved here once instead of being copied
+   * into each request.
+   */
+  google::bigtable::v2::ReadRowsRequest request_;
   std::unique_ptr<RPCRetryPolicy> retry_policy_;
   std::unique_ptr<RPCBackoffPolicy> backoff_policy_;
   MetadataUpdatePolicy metadata_update_policy_;
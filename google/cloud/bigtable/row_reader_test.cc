@@ -660,6 +660,44 @@ TEST_F(RowReaderTest, RowLimitIsNotDecreasedToZero) {
   EXPECT_EQ(++it, reader.end());
 }
 
+TEST_F(RowReaderTest, RowLimitReachedClosesStream) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1", "r2"});
+  ::testing::MockFunction<void()> checkpoint;
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowsLimit(2)))
+        .WillOnce(stream->MakeMockReturner());
+
+    // The stream is cancelled, drained, and finished as soon as the last row
+    // is returned, without waiting for the application to ask for more.
+    EXPECT_CALL(*stream, Read).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(grpc::Status(grpc::StatusCode::CANCELLED, "")));
+    EXPECT_CALL(checkpoint, Call);
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), 2, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+
+  auto it = reader.begin();
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  ++it;
+  ASSERT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r2");
+  checkpoint.Call();
+  // The stream ends without an error, even though it was cancelled.
+  EXPECT_EQ(++it, reader.end());
+}
+
 TEST_F(RowReaderTest, BeginThrowsAfterCancelClosesStreamNoExcept) {
   auto parser = absl::make_unique<ReadRowsParserMock>();
   parser->SetRows({"r1"});
@@ -13,11 +13,109 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/row_set.h"
+#include <algorithm>
+#include <string>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = ::google::bigtable::v2;
+
+bool HasStart(btproto::RowRange const& r) {
+  return r.start_key_case() != btproto::RowRange::START_KEY_NOT_SET;
+}
+
+std::string const& StartKey(btproto::RowRange const& r) {
+  return r.start_key_case() == btproto::RowRange::kStartKeyOpen
+             ? r.start_key_open()
+             : r.start_key_closed();
+}
+
+bool HasEnd(btproto::RowRange const& r) {
+  return r.end_key_case() != btproto::RowRange::END_KEY_NOT_SET;
+}
+
+std::string const& EndKey(btproto::RowRange const& r) {
+  return r.end_key_case() == btproto::RowRange::kEndKeyOpen
+             ? r.end_key_open()
+             : r.end_key_closed();
+}
+
+/// Return true if the range @p lhs starts before @p rhs.
+bool StartsBefore(btproto::RowRange const& lhs, btproto::RowRange const& rhs) {
+  if (!HasStart(rhs)) return false;
+  if (!HasStart(lhs)) return true;
+  auto const cmp = internal::CompareRowKey(StartKey(lhs), StartKey(rhs));
+  if (cmp != 0) return cmp < 0;
+  // [k, a) starts before (k, b)
+  return lhs.start_key_case() == btproto::RowRange::kStartKeyClosed &&
+         rhs.start_key_case() == btproto::RowRange::kStartKeyOpen;
+}
+
+/// Return true if the range @p lhs ends after @p rhs.
+bool EndsAfter(btproto::RowRange const& lhs, btproto::RowRange const& rhs) {
+  if (!HasEnd(rhs)) return false;
+  if (!HasEnd(lhs)) return true;
+  auto const cmp = internal::CompareRowKey(EndKey(lhs), EndKey(rhs));
+  if (cmp != 0) return cmp > 0;
+  // [a, k] ends after [b, k)
+  return lhs.end_key_case() == btproto::RowRange::kEndKeyClosed &&
+         rhs.end_key_case() == btproto::RowRange::kEndKeyOpen;
+}
+
+/// Return true if the range @p r ends before @p key.
+bool EndsBefore(btproto::RowRange const& r, std::string const& key) {
+  if (!HasEnd(r)) return false;
+  auto const cmp = internal::CompareRowKey(EndKey(r), key);
+  if (cmp != 0) return cmp < 0;
+  return r.end_key_case() == btproto::RowRange::kEndKeyOpen;
+}
+
+/// Return true if the range @p r starts after @p key.
+bool StartsAfter(btproto::RowRange const& r, std::string const& key) {
+  if (!HasStart(r)) return false;
+  auto const cmp = internal::CompareRowKey(StartKey(r), key);
+  if (cmp != 0) return cmp > 0;
+  return r.start_key_case() == btproto::RowRange::kStartKeyOpen;
+}
+
+/**
+ * Return true if the union of @p lo and @p hi is a single range.
+ *
+ * The ranges must be non-empty, and @p hi must not start before @p lo.
+ */
+bool CanMerge(btproto::RowRange const& lo, btproto::RowRange const& hi) {
+  if (std::get<0>(RowRange(lo).Intersect(RowRange(hi)))) return true;
+  // Ranges without a common key can still be adjacent, [a, k) and [k, b), or
+  // [a, k] and (k, b).
+  if (!HasEnd(lo) || !HasStart(hi) || EndKey(lo) != StartKey(hi)) {
+    return false;
+  }
+  return (lo.end_key_case() == btproto::RowRange::kEndKeyOpen) !=
+         (hi.start_key_case() == btproto::RowRange::kStartKeyOpen);
+}
+
+/// Extend the end of @p lo to the end of @p hi, if that is later.
+void MergeInto(btproto::RowRange& lo, btproto::RowRange const& hi) {
+  if (!EndsAfter(hi, lo)) return;
+  switch (hi.end_key_case()) {
+    case btproto::RowRange::END_KEY_NOT_SET:
+      lo.clear_end_key();
+      break;
+    case btproto::RowRange::kEndKeyClosed:
+      lo.set_end_key_closed(hi.end_key_closed());
+      break;
+    case btproto::RowRange::kEndKeyOpen:
+      lo.set_end_key_open(hi.end_key_open());
+      break;
+  }
+}
+
+}  // namespace
+
 RowSet RowSet::Intersect(bigtable::RowRange const& range) const {
   // Special case: "all rows", return the argument range.
   if (row_set_.row_keys().empty() && row_set_.row_ranges().empty()) {
@@ -46,6 +144,84 @@ RowSet RowSet::Intersect(bigtable::RowRange const& range) const {
   return result;
 }
 
+std::vector<RowSet> RowSet::SplitBy(
+    std::vector<RowKeySample> const& samples) const {
+  std::vector<RowSet> result;
+  auto add_subset = [&](RowRange const& range) {
+    auto subset = Intersect(range);
+    if (!subset.IsEmpty()) result.push_back(std::move(subset));
+  };
+
+  RowKeyType start;
+  for (auto const& sample : samples) {
+    // The service returns the samples in key order, skip anything that would
+    // create an empty or overlapping subset, including the empty key that
+    // represents the end of the table.
+    if (internal::IsEmptyRowKey(sample.row_key) ||
+        internal::CompareRowKey(sample.row_key, start) <= 0) {
+      continue;
+    }
+    add_subset(RowRange::RightOpen(start, sample.row_key));
+    start = sample.row_key;
+  }
+  add_subset(RowRange::StartingAt(std::move(start)));
+  return result;
+}
+
+void RowSet::Normalize() {
+  auto& keys = *row_set_.mutable_row_keys();
+  auto& ranges = *row_set_.mutable_row_ranges();
+  // A set without keys or ranges represents all the rows in the table.
+  if (keys.empty() && ranges.empty()) return;
+
+  // Only the pointers are sorted and swapped, the strings are not copied.
+  int count = 0;
+  for (int i = 0; i != ranges.size(); ++i) {
+    if (RowRange(ranges.Get(i)).IsEmpty()) continue;
+    if (i != count) ranges.SwapElements(i, count);
+    ++count;
+  }
+  ranges.DeleteSubrange(count, ranges.size() - count);
+  if (keys.empty() && ranges.empty()) {
+    // Keep an empty range, an empty set would read all the rows.
+    *ranges.Add() = RowRange::Empty().as_proto();
+    return;
+  }
+
+  std::sort(ranges.pointer_begin(), ranges.pointer_end(),
+            [](btproto::RowRange const* a, btproto::RowRange const* b) {
+              return StartsBefore(*a, *b);
+            });
+  count = 0;
+  for (int i = 0; i != ranges.size(); ++i) {
+    if (count != 0 && CanMerge(ranges.Get(count - 1), ranges.Get(i))) {
+      MergeInto(*ranges.Mutable(count - 1), ranges.Get(i));
+      continue;
+    }
+    if (i != count) ranges.SwapElements(i, count);
+    ++count;
+  }
+  ranges.DeleteSubrange(count, ranges.size() - count);
+
+  std::sort(keys.pointer_begin(), keys.pointer_end(),
+            [](std::string const* a, std::string const* b) {
+              return internal::CompareRowKey(*a, *b) < 0;
+            });
+  // The keys and ranges are sorted, find the range that may contain each key
+  // with a single pass over both.
+  count = 0;
+  int r = 0;
+  for (int i = 0; i != keys.size(); ++i) {
+    auto const& key = keys.Get(i);
+    if (count != 0 && keys.Get(count - 1) == key) continue;
+    while (r != ranges.size() && EndsBefore(ranges.Get(r), key)) ++r;
+    if (r != ranges.size() && !StartsAfter(ranges.Get(r), key)) continue;
+    if (i != count) keys.SwapElements(i, count);
+    ++count;
+  }
+  keys.DeleteSubrange(count, keys.size() - count);
+}
+
 bool RowSet::IsEmpty() const {
   if (row_set_.row_keys_size() > 0) {
     return false;
@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_SET_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_SET_H
 
+#include "google/cloud/bigtable/row_key_sample.h"
 #include "google/cloud/bigtable/row_range.h"
 #include "google/cloud/bigtable/version.h"
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -65,6 +67,33 @@ class RowSet {
    */
   RowSet Intersect(bigtable::RowRange const& range) const;
 
+  /**
+   * Split this set into disjoint subsets using the split points in @p samples.
+   *
+   * The samples are usually the result of `Table::SampleRows()`, and each
+   * subset only contains rows from a single tablet, so the subsets can be read
+   * in parallel.
+   *
+   * The subsets are returned in key order, and subsets that do not contain any
+   * rows are omitted. The samples may include the empty row key, representing
+   * the end of the table, such samples are ignored.
+   */
+  std::vector<RowSet> SplitBy(std::vector<RowKeySample> const& samples) const;
+
+  /**
+   * Sort and simplify the keys and ranges in this set.
+   *
+   * This function removes empty ranges, merges overlapping or adjacent ranges,
+   * sorts the row keys, and removes duplicate keys and any keys contained in a
+   * range. The set contains the same rows after this call, but the request to
+   * read them is smaller, and the service does not scan any row twice.
+   *
+   * `Table::ReadRows()` and `Table::AsyncReadRows()` normalize the row set
+   * automatically, calling this function is only useful to inspect the
+   * result.
+   */
+  void Normalize();
+
   /**
    * Returns true if the set is empty.
    *
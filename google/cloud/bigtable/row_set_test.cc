@@ -14,6 +14,8 @@
 
 #include "google/cloud/bigtable/row_set.h"
 #include <gmock/gmock.h>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -21,6 +23,9 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace {
 
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
 TEST(RowSetTest, DefaultConstructor) {
   auto proto = RowSet().as_proto();
   EXPECT_EQ(0, proto.row_keys_size());
@@ -115,6 +120,130 @@ TEST(RowSetTest, IntersectWithDisjointIsEmpty) {
       RowSet("a", R::Range("a", "b")).Intersect(R::Range("c", "d")).IsEmpty());
 }
 
+std::vector<RowKeySample> MakeSamples(std::vector<std::string> const& keys) {
+  std::vector<RowKeySample> samples;
+  std::int64_t offset = 0;
+  for (auto const& k : keys) {
+    offset += 1000;
+    samples.push_back(RowKeySample{k, offset});
+  }
+  return samples;
+}
+
+TEST(RowSetTest, SplitByAllRows) {
+  auto shards = RowSet().SplitBy(MakeSamples({"b", "d", ""}));
+  ASSERT_EQ(3, shards.size());
+  for (auto const& s : shards) ASSERT_EQ(1, s.as_proto().row_ranges_size());
+  EXPECT_EQ("", shards[0].as_proto().row_ranges(0).start_key_closed());
+  EXPECT_EQ("b", shards[0].as_proto().row_ranges(0).end_key_open());
+  EXPECT_EQ("b", shards[1].as_proto().row_ranges(0).start_key_closed());
+  EXPECT_EQ("d", shards[1].as_proto().row_ranges(0).end_key_open());
+  EXPECT_EQ("d", shards[2].as_proto().row_ranges(0).start_key_closed());
+  EXPECT_FALSE(shards[2].as_proto().row_ranges(0).has_end_key_open());
+  EXPECT_FALSE(shards[2].as_proto().row_ranges(0).has_end_key_closed());
+}
+
+TEST(RowSetTest, SplitByNoSamples) {
+  auto shards = RowSet().SplitBy({});
+  ASSERT_EQ(1, shards.size());
+  ASSERT_EQ(1, shards[0].as_proto().row_ranges_size());
+  EXPECT_EQ("", shards[0].as_proto().row_ranges(0).start_key_closed());
+}
+
+TEST(RowSetTest, SplitBySkipsDuplicateAndUnsortedSamples) {
+  auto shards = RowSet().SplitBy(MakeSamples({"b", "b", "a", "c"}));
+  ASSERT_EQ(3, shards.size());
+  EXPECT_EQ("b", shards[0].as_proto().row_ranges(0).end_key_open());
+  EXPECT_EQ("c", shards[1].as_proto().row_ranges(0).end_key_open());
+  EXPECT_EQ("c", shards[2].as_proto().row_ranges(0).start_key_closed());
+}
+
+TEST(RowSetTest, SplitByIntersectsRowSet) {
+  RowSet row_set(RowRange::Range("a1", "c1"), "b0", "d0");
+  auto shards = row_set.SplitBy(MakeSamples({"b", "c", "d", "e"}));
+  ASSERT_EQ(4, shards.size());
+
+  // [a1, b)
+  EXPECT_THAT(shards[0].as_proto().row_keys(), IsEmpty());
+  ASSERT_EQ(1, shards[0].as_proto().row_ranges_size());
+  EXPECT_EQ("a1", shards[0].as_proto().row_ranges(0).start_key_closed());
+  EXPECT_EQ("b", shards[0].as_proto().row_ranges(0).end_key_open());
+
+  // [b, c) includes the "b0" key.
+  EXPECT_THAT(shards[1].as_proto().row_keys(), ElementsAre("b0"));
+  ASSERT_EQ(1, shards[1].as_proto().row_ranges_size());
+  EXPECT_EQ("b", shards[1].as_proto().row_ranges(0).start_key_closed());
+  EXPECT_EQ("c", shards[1].as_proto().row_ranges(0).end_key_open());
+
+  // [c, d)
+  EXPECT_THAT(shards[2].as_proto().row_keys(), IsEmpty());
+  ASSERT_EQ(1, shards[2].as_proto().row_ranges_size());
+  EXPECT_EQ("c", shards[2].as_proto().row_ranges(0).start_key_closed());
+  EXPECT_EQ("c1", shards[2].as_proto().row_ranges(0).end_key_open());
+
+  // [d, e) includes only the "d0" key, and [e, ...) is empty.
+  EXPECT_THAT(shards[3].as_proto().row_keys(), ElementsAre("d0"));
+  EXPECT_EQ(0, shards[3].as_proto().row_ranges_size());
+}
+
+TEST(RowSetTest, NormalizeAllRows) {
+  RowSet row_set;
+  row_set.Normalize();
+  EXPECT_THAT(row_set.as_proto().row_keys(), IsEmpty());
+  EXPECT_THAT(row_set.as_proto().row_ranges(), IsEmpty());
+}
+
+TEST(RowSetTest, NormalizeOnlyEmptyRanges) {
+  RowSet row_set(RowRange::Empty(), RowRange::Range("b", "a"));
+  row_set.Normalize();
+  EXPECT_TRUE(row_set.IsEmpty());
+  ASSERT_EQ(1, row_set.as_proto().row_ranges_size());
+  EXPECT_EQ(RowRange::Empty(), RowRange(row_set.as_proto().row_ranges(0)));
+}
+
+TEST(RowSetTest, NormalizeKeys) {
+  RowSet row_set("d", "b", "a", "d", "c", "b");
+  row_set.Normalize();
+  EXPECT_THAT(row_set.as_proto().row_keys(), ElementsAre("a", "b", "c", "d"));
+  EXPECT_THAT(row_set.as_proto().row_ranges(), IsEmpty());
+}
+
+TEST(RowSetTest, NormalizeMergesRanges) {
+  RowSet row_set(RowRange::Range("m", "p"), RowRange::Closed("a", "c"),
+                 RowRange::Range("b", "d"), RowRange::Closed("k", "m"),
+                 RowRange::Open("p", "q"), RowRange::StartingAt("x"),
+                 RowRange::Range("y", "z"), RowRange::Empty());
+  row_set.Normalize();
+  auto const& ranges = row_set.as_proto().row_ranges();
+  ASSERT_EQ(4, ranges.size());
+  // [a, c] and [b, d) overlap.
+  EXPECT_EQ(RowRange::Range("a", "d"), RowRange(ranges.Get(0)));
+  // [k, m] and [m, p) overlap at "m".
+  EXPECT_EQ(RowRange::Range("k", "p"), RowRange(ranges.Get(1)));
+  // [k, p) and (p, q) do not include "p".
+  EXPECT_EQ(RowRange::Open("p", "q"), RowRange(ranges.Get(2)));
+  // [x, '') contains [y, z).
+  EXPECT_EQ(RowRange::StartingAt("x"), RowRange(ranges.Get(3)));
+}
+
+TEST(RowSetTest, NormalizeMergesAdjacentRanges) {
+  RowSet row_set(RowRange::Range("a", "b"), RowRange::Range("b", "c"),
+                 RowRange::Closed("c", "d"), RowRange::Open("d", "e"));
+  row_set.Normalize();
+  ASSERT_EQ(1, row_set.as_proto().row_ranges_size());
+  EXPECT_EQ(RowRange::Range("a", "e"),
+            RowRange(row_set.as_proto().row_ranges(0)));
+}
+
+TEST(RowSetTest, NormalizeRemovesKeysInRanges) {
+  RowSet row_set(RowRange::Range("b", "d"), RowRange::LeftOpen("f", "h"), "a",
+                 "b", "c", "d", "e", "f", "g", "h", "i");
+  row_set.Normalize();
+  EXPECT_THAT(row_set.as_proto().row_keys(),
+              ElementsAre("a", "d", "e", "f", "i"));
+  EXPECT_EQ(2, row_set.as_proto().row_ranges_size());
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
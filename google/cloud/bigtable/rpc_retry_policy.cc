@@ -64,6 +64,33 @@ bool LimitedTimeRetryPolicy::OnFailure(grpc::Status const& status) {
   return impl_.OnFailure(MakeStatusFromRpcError(status));
 }
 
+RetryBudgetPolicy::~RetryBudgetPolicy() {
+  // The operations call `Setup()` before each attempt, unused copies (such as
+  // prototypes) do not count as successful calls.
+  if (attempted_ && !gave_up_) budget_->OnSuccess();
+}
+
+std::unique_ptr<RPCRetryPolicy> RetryBudgetPolicy::clone() const {
+  return std::unique_ptr<RPCRetryPolicy>(new RetryBudgetPolicy(*this));
+}
+
+void RetryBudgetPolicy::Setup(grpc::ClientContext& context) const {
+  attempted_ = true;
+  child_->Setup(context);
+}
+
+bool RetryBudgetPolicy::OnFailure(google::cloud::Status const& status) {
+  if (!child_->OnFailure(status) || !budget_->OnFailure()) {
+    gave_up_ = true;
+    return false;
+  }
+  return true;
+}
+
+bool RetryBudgetPolicy::OnFailure(grpc::Status const& status) {
+  return OnFailure(MakeStatusFromRpcError(status));
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/internal/rpc_policy_parameters.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/retry_budget.h"
 #include "google/cloud/status.h"
 #include <grpcpp/grpcpp.h>
 #include <memory>
@@ -163,6 +164,36 @@ class LimitedTimeRetryPolicy : public RPCRetryPolicy {
   Impl impl_;
 };
 
+/**
+ * Decorates a retry policy with a `google::cloud::RetryBudget`.
+ *
+ * The retries of all the calls using this policy (or any other policy sharing
+ * the same budget) are limited to a fraction of the successful calls.
+ *
+ * @see `google::cloud::RetryBudget` for details.
+ */
+class RetryBudgetPolicy : public RPCRetryPolicy {
+ public:
+  RetryBudgetPolicy(std::shared_ptr<RetryBudget> budget,
+                    RPCRetryPolicy const& child)
+      : budget_(std::move(budget)), child_(child.clone()) {}
+  RetryBudgetPolicy(RetryBudgetPolicy const& rhs)
+      : budget_(rhs.budget_), child_(rhs.child_->clone()) {}
+  ~RetryBudgetPolicy() override;
+
+  std::unique_ptr<RPCRetryPolicy> clone() const override;
+  void Setup(grpc::ClientContext& context) const override;
+  bool OnFailure(google::cloud::Status const& status) override;
+  // TODO(#2344) - remove ::grpc::Status version.
+  bool OnFailure(grpc::Status const& status) override;
+
+ private:
+  std::shared_ptr<RetryBudget> budget_;
+  std::unique_ptr<RPCRetryPolicy> child_;
+  mutable bool attempted_ = false;
+  bool gave_up_ = false;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -109,6 +109,45 @@ TEST(LimitedErrorCountRetryPolicy, OnNonRetryable) {
   EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
 }
 
+/// @test Verify that RetryBudgetPolicy stops retrying when the budget is low.
+TEST(RetryBudgetPolicy, Throttled) {
+  auto budget = std::make_shared<RetryBudget>(4.0, 1.0);
+  RetryBudgetPolicy prototype(budget, LimitedErrorCountRetryPolicy(10));
+  auto tested = prototype.clone();
+  grpc::ClientContext context;
+  tested->Setup(context);
+  EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(tested->OnFailure(CreateTransientError()));
+  auto const metrics = budget->Metrics();
+  EXPECT_EQ(1, metrics.retries);
+  EXPECT_EQ(1, metrics.throttled);
+}
+
+/// @test Verify that RetryBudgetPolicy refills the budget on success.
+TEST(RetryBudgetPolicy, SuccessRefillsBudget) {
+  auto budget = std::make_shared<RetryBudget>(4.0, 1.0);
+  RetryBudgetPolicy prototype(budget, LimitedErrorCountRetryPolicy(10));
+  {
+    auto tested = prototype.clone();
+    grpc::ClientContext context;
+    tested->Setup(context);
+    EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+  }
+  // The prototype and unused clones do not count as successes.
+  { auto unused = prototype.clone(); }
+  auto const metrics = budget->Metrics();
+  EXPECT_EQ(1, metrics.successes);
+  EXPECT_DOUBLE_EQ(4.0, metrics.tokens);
+}
+
+/// @test Verify that RetryBudgetPolicy does not retry permanent errors.
+TEST(RetryBudgetPolicy, OnNonRetryable) {
+  auto budget = std::make_shared<RetryBudget>();
+  RetryBudgetPolicy tested(budget, LimitedErrorCountRetryPolicy(10));
+  EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
+  EXPECT_EQ(0, budget->Metrics().throttled);
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
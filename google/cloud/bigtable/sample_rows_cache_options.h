@@ -0,0 +1,76 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SAMPLE_ROWS_CACHE_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SAMPLE_ROWS_CACHE_OPTIONS_H
+
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configure the client-side cache of `Table::SampleRows()` results.
+ *
+ * The tablet boundaries change slowly, and many operations (such as
+ * `Table::ParallelReadRows()` or `RowSet::SplitBy()`) only need recent split
+ * points. The cache keeps the last result of `SampleRowKeys`, and refreshes it
+ * in the background every `refresh_period`. Results older than `max_age`, for
+ * example because the refreshes fail, are not used.
+ *
+ * @see `Table::EnableSampleRowsCache()`
+ */
+struct SampleRowsCacheOptions {
+  SampleRowsCacheOptions()
+      : refresh_period(std::chrono::minutes(5)),
+        max_age(std::chrono::minutes(30)) {}
+
+  /// Fetch the samples again after this time.
+  SampleRowsCacheOptions& SetRefreshPeriod(
+      std::chrono::milliseconds refresh_period_arg) {
+    refresh_period = refresh_period_arg;
+    return *this;
+  }
+
+  /// The cached samples are discarded after this time.
+  SampleRowsCacheOptions& SetMaxAge(std::chrono::milliseconds max_age_arg) {
+    max_age = max_age_arg;
+    return *this;
+  }
+
+  std::chrono::milliseconds refresh_period;
+  std::chrono::milliseconds max_age;
+};
+
+/// Counters for the samples cache, see `Table::sample_rows_cache_stats()`.
+struct SampleRowsCacheStats {
+  /// The number of calls returned from the cache.
+  std::int64_t hits = 0;
+  /// The number of calls that waited for a `SampleRowKeys` request.
+  std::int64_t misses = 0;
+  /// The number of successful `SampleRowKeys` requests.
+  std::int64_t refreshes = 0;
+  /// The number of failed `SampleRowKeys` requests.
+  std::int64_t refresh_failures = 0;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SAMPLE_ROWS_CACHE_OPTIONS_H
@@ -0,0 +1,104 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/sharded_mutation_batcher.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+ShardedMutationBatcher::ShardedMutationBatcher(
+    Table table, std::size_t num_shards, MutationBatcher::Options options,
+    std::chrono::milliseconds split_points_refresh_period)
+    : table_(std::move(table)), next_shard_(0) {
+  num_shards = (std::max)(std::size_t{1}, num_shards);
+  auto budget = MutationBatcher::MakeBudget(table_, options);
+  auto shard_options = options;
+  shard_options.max_batches =
+      (std::max)(std::size_t{1}, options.max_batches / num_shards);
+
+  shards_.reserve(num_shards);
+  for (std::size_t i = 0; i != num_shards; ++i) {
+    // The constructor is private, `absl::make_unique` cannot use it.
+    shards_.emplace_back(new MutationBatcher(table_, shard_options, budget));
+  }
+  if (num_shards == 1) return;
+
+  if (split_points_refresh_period.count() > 0) {
+    router_ = std::make_shared<internal::KeyRangeRouter>(
+        num_shards, split_points_refresh_period);
+    MaybeRefreshSplitPoints();
+  }
+
+  for (std::size_t i = 0; i != num_shards; ++i) {
+    // Start with the next shard, so the space released by a shard is not
+    // always offered to the same shard first.
+    shards_[i]->on_budget_released_ = [this, i](CompletionQueue& cq) {
+      for (std::size_t j = 1; j != shards_.size(); ++j) {
+        shards_[(i + j) % shards_.size()]->RetryPending(cq);
+      }
+    };
+  }
+}
+
+std::pair<future<void>, future<Status>> ShardedMutationBatcher::AsyncApply(
+    CompletionQueue& cq, SingleRowMutation mut) {
+  auto const shard = PickShard(mut);
+  return shards_[shard]->AsyncApply(cq, std::move(mut));
+}
+
+future<void> ShardedMutationBatcher::AsyncWaitForNoPendingRequests() {
+  auto remaining = std::make_shared<std::atomic<std::size_t>>(shards_.size());
+  auto done = std::make_shared<promise<void>>();
+  auto f = done->get_future();
+  for (auto& shard : shards_) {
+    shard->AsyncWaitForNoPendingRequests().then(
+        [remaining, done](future<void>) {
+          if (--*remaining == 0) done->set_value();
+        });
+  }
+  return f;
+}
+
+std::size_t ShardedMutationBatcher::PickShard(SingleRowMutation const& mut) {
+  if (router_) {
+    MaybeRefreshSplitPoints();
+    auto bucket = router_->Bucket(mut.row_key());
+    if (bucket) return *bucket;
+  }
+  auto const n = next_shard_.fetch_add(1, std::memory_order_relaxed);
+  return n % shards_.size();
+}
+
+void ShardedMutationBatcher::MaybeRefreshSplitPoints() {
+  if (!router_->StartRefresh(std::chrono::steady_clock::now())) return;
+  // The refresh may complete after this object is deleted.
+  std::weak_ptr<internal::KeyRangeRouter> w = router_;
+  table_.AsyncSampleRows().then(
+      [w](future<StatusOr<std::vector<RowKeySample>>> f) {
+        auto samples = f.get();
+        auto router = w.lock();
+        // On errors keep the current split points, the next refresh period
+        // tries again.
+        if (!router || !samples) return;
+        router->Update(*samples);
+      });
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,121 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SHARDED_MUTATION_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SHARDED_MUTATION_BATCHER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/key_range_router.h"
+#include "google/cloud/bigtable/internal/mutation_admission_budget.h"
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Pack single row mutations into bulk mutations using several independent
+ * `MutationBatcher` shards.
+ *
+ * A `MutationBatcher` serializes all calls to `AsyncApply()` on a single
+ * mutex. With many producer threads that mutex becomes a bottleneck. This
+ * class distributes the mutations, round-robin, over `num_shards` batchers,
+ * each with its own mutex and its own batch under construction.
+ *
+ * The shards share the outstanding size and mutation limits in
+ * `MutationBatcher::Options`, so the flow control works as if there was a
+ * single batcher: when a batch completes, its space is available to
+ * mutations waiting in any shard. The `max_batches` limit is divided between
+ * the shards, with at least one outstanding batch per shard. The per-batch
+ * limits, and the adaptive mode if enabled, apply to each shard.
+ *
+ * Each batch is sent with a separate `Table::AsyncBulkApply()` call, and the
+ * `DataClient` picks a different channel for each call. Setting `num_shards`
+ * to the number of channels in the client (see `GrpcNumChannelsOption`)
+ * spreads the concurrent batches over all the channels.
+ *
+ * @par Key range routing
+ * A bulk mutation touching many tablets is as slow as the slowest tablet.
+ * With a positive `split_points_refresh_period` the shards hold contiguous
+ * row key ranges instead. The ranges are computed from `Table::SampleRows()`
+ * to cover whole tablets with roughly the same amount of data, so each batch
+ * touches fewer tablets. The split points are refreshed in the background,
+ * at most once per period, as mutations are applied. Until the first refresh
+ * completes, or if the table has a single tablet, the mutations are
+ * distributed round-robin.
+ *
+ * As with `MutationBatcher`, there are no guarantees about the order in which
+ * mutations are applied.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ */
+class ShardedMutationBatcher {
+ public:
+  ShardedMutationBatcher(
+      Table table, std::size_t num_shards,
+      MutationBatcher::Options options = MutationBatcher::Options(),
+      std::chrono::milliseconds split_points_refresh_period =
+          std::chrono::milliseconds(0));
+
+  ShardedMutationBatcher(ShardedMutationBatcher const&) = delete;
+  ShardedMutationBatcher& operator=(ShardedMutationBatcher const&) = delete;
+
+  /**
+   * Asynchronously apply mutation.
+   *
+   * The semantics of the returned *admission* and *completion* futures are
+   * the same as in `MutationBatcher::AsyncApply()`.
+   */
+  std::pair<future<void>, future<Status>> AsyncApply(CompletionQueue& cq,
+                                                     SingleRowMutation mut);
+
+  /**
+   * Asynchronously wait until all submitted mutations complete.
+   *
+   * @return a future which will be satisfied once all mutations submitted
+   *     before calling this function finish in all the shards.
+   */
+  future<void> AsyncWaitForNoPendingRequests();
+
+  std::size_t num_shards() const { return shards_.size(); }
+
+ private:
+  std::size_t PickShard(SingleRowMutation const& mut);
+  void MaybeRefreshSplitPoints();
+
+  Table table_;
+  std::vector<std::unique_ptr<MutationBatcher>> shards_;
+  std::atomic<std::size_t> next_shard_;
+  /// Null unless routing by key range, shared with pending refreshes.
+  std::shared_ptr<internal::KeyRangeRouter> router_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SHARDED_MUTATION_BATCHER_H
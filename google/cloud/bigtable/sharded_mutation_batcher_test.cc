@@ -0,0 +1,265 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/sharded_mutation_batcher.h"
+#include "google/cloud/bigtable/testing/mock_mutate_rows_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+namespace bt = ::google::cloud::bigtable;
+
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+using ::google::cloud::bigtable::testing::MockClientAsyncReaderInterface;
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+
+struct MutationState {
+  bool admitted{false};
+  bool completed{false};
+  google::cloud::Status completion_status;
+};
+
+SingleRowMutation MakeMutation(std::string row_key) {
+  return SingleRowMutation(std::move(row_key),
+                           {bt::SetCell("fam", "col", 0_ms, "baz")});
+}
+
+class ShardedMutationBatcherTest : public bigtable::testing::TableTestFixture {
+ protected:
+  ShardedMutationBatcherTest()
+      : TableTestFixture(
+            CompletionQueue(std::make_shared<FakeCompletionQueueImpl>())) {}
+
+  /// Expect one MutateRows call per entry in `row_keys`, in order, where all
+  /// the mutations succeed.
+  void ExpectBatches(std::vector<std::vector<std::string>> const& row_keys) {
+    // gMock expectation matching starts from the latest added, so we need to
+    // add them in the reverse order.
+    for (auto it = row_keys.crbegin(); it != row_keys.crend(); ++it) {
+      auto keys = *it;
+      auto* reader =
+          new MockClientAsyncReaderInterface<btproto::MutateRowsResponse>;
+      EXPECT_CALL(*reader, Read)
+          .WillOnce([keys](btproto::MutateRowsResponse* r, void*) {
+            for (std::size_t i = 0; i != keys.size(); ++i) {
+              auto& e = *r->add_entries();
+              e.set_index(static_cast<std::int64_t>(i));
+              e.mutable_status()->set_code(grpc::StatusCode::OK);
+            }
+          })
+          .WillOnce([](btproto::MutateRowsResponse*, void*) {});
+      EXPECT_CALL(*reader, Finish).WillOnce([](grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      });
+      EXPECT_CALL(*reader, StartCall).Times(1);
+
+      EXPECT_CALL(*client_, PrepareAsyncMutateRows)
+          .WillOnce([reader, keys](grpc::ClientContext*,
+                                   btproto::MutateRowsRequest const& r,
+                                   grpc::CompletionQueue*) {
+            EXPECT_EQ(keys.size(), r.entries_size());
+            for (int i = 0; i != r.entries_size(); ++i) {
+              EXPECT_EQ(keys[static_cast<std::size_t>(i)],
+                        r.entries(i).row_key());
+            }
+            return std::unique_ptr<
+                MockClientAsyncReaderInterface<btproto::MutateRowsResponse>>(
+                reader);
+          })
+          .RetiresOnSaturation();
+    }
+  }
+
+  void FinishStreams() {
+    cq_impl_->SimulateCompletion(true);
+    // state == PROCESSING
+    cq_impl_->SimulateCompletion(true);
+    // state == PROCESSING, 1 read
+    cq_impl_->SimulateCompletion(false);
+    // state == FINISHING
+    cq_impl_->SimulateCompletion(true);
+    // RunAsync
+    cq_impl_->SimulateCompletion(true);
+  }
+
+  std::shared_ptr<MutationState> Apply(ShardedMutationBatcher& batcher,
+                                       SingleRowMutation mut) {
+    auto res = std::make_shared<MutationState>();
+    auto admission_and_completion = batcher.AsyncApply(cq_, std::move(mut));
+    admission_and_completion.first.then([res](future<void> f) {
+      f.get();
+      res->admitted = true;
+    });
+    admission_and_completion.second.then(
+        [res](future<google::cloud::Status> status) {
+          res->completed = true;
+          res->completion_status = status.get();
+        });
+    return res;
+  }
+
+  std::size_t NumOperationsOutstanding() { return cq_impl_->size(); }
+};
+
+TEST_F(ShardedMutationBatcherTest, AtLeastOneShard) {
+  ShardedMutationBatcher batcher(table_, 0);
+  EXPECT_EQ(1, batcher.num_shards());
+}
+
+TEST_F(ShardedMutationBatcherTest, ShardsSendBatchesInParallel) {
+  // Each shard may have one outstanding batch.
+  ShardedMutationBatcher batcher(
+      table_, 2,
+      MutationBatcher::Options().SetMaxMutationsPerBatch(10).SetMaxBatches(2));
+  EXPECT_EQ(2, batcher.num_shards());
+
+  ExpectBatches({{"r0"}, {"r1"}, {"r2"}, {"r3"}});
+
+  auto s0 = Apply(batcher, MakeMutation("r0"));
+  auto s1 = Apply(batcher, MakeMutation("r1"));
+  EXPECT_EQ(2, NumOperationsOutstanding());
+  // These wait in the batch under construction of each shard.
+  auto s2 = Apply(batcher, MakeMutation("r2"));
+  auto s3 = Apply(batcher, MakeMutation("r3"));
+  EXPECT_TRUE(s2->admitted);
+  EXPECT_TRUE(s3->admitted);
+  EXPECT_EQ(2, NumOperationsOutstanding());
+
+  auto no_more_pending = batcher.AsyncWaitForNoPendingRequests();
+  EXPECT_EQ(std::future_status::timeout, no_more_pending.wait_for(1_ms));
+
+  FinishStreams();
+  EXPECT_TRUE(s0->completed);
+  EXPECT_TRUE(s1->completed);
+  EXPECT_FALSE(s2->completed);
+  EXPECT_FALSE(s3->completed);
+  EXPECT_EQ(2, NumOperationsOutstanding());
+  EXPECT_EQ(std::future_status::timeout, no_more_pending.wait_for(1_ms));
+
+  FinishStreams();
+  EXPECT_TRUE(s2->completed);
+  EXPECT_TRUE(s3->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+  EXPECT_EQ(std::future_status::ready, no_more_pending.wait_for(1_ms));
+}
+
+TEST_F(ShardedMutationBatcherTest, ShardsShareTheBudget) {
+  ShardedMutationBatcher batcher(table_, 2,
+                                 MutationBatcher::Options()
+                                     .SetMaxMutationsPerBatch(10)
+                                     .SetMaxBatches(2)
+                                     .SetMaxOutstandingMutations(1));
+
+  ExpectBatches({{"r0"}, {"r1"}});
+
+  auto s0 = Apply(batcher, MakeMutation("r0"));
+  EXPECT_TRUE(s0->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // The second shard has no outstanding batches, but the budget is used by
+  // the first shard.
+  auto s1 = Apply(batcher, MakeMutation("r1"));
+  EXPECT_FALSE(s1->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // Completing the first batch releases the budget for the second shard.
+  FinishStreams();
+  EXPECT_TRUE(s0->completed);
+  EXPECT_TRUE(s1->admitted);
+  EXPECT_FALSE(s1->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishStreams();
+  EXPECT_TRUE(s1->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+  EXPECT_EQ(std::future_status::ready,
+            batcher.AsyncWaitForNoPendingRequests().wait_for(1_ms));
+}
+
+TEST_F(ShardedMutationBatcherTest, RoutesByKeyRange) {
+  EXPECT_CALL(*client_, PrepareAsyncSampleRowKeys)
+      .WillOnce([](grpc::ClientContext*, btproto::SampleRowKeysRequest const&,
+                   grpc::CompletionQueue*) {
+        auto reader = absl::make_unique<
+            MockClientAsyncReaderInterface<btproto::SampleRowKeysResponse>>();
+        EXPECT_CALL(*reader, StartCall);
+        EXPECT_CALL(*reader, Read)
+            .WillOnce([](btproto::SampleRowKeysResponse* r, void*) {
+              r->set_row_key("m");
+              r->set_offset_bytes(100);
+            })
+            .WillOnce([](btproto::SampleRowKeysResponse* r, void*) {
+              r->set_row_key("");
+              r->set_offset_bytes(200);
+            })
+            .WillOnce([](btproto::SampleRowKeysResponse*, void*) {});
+        EXPECT_CALL(*reader, Finish).WillOnce([](grpc::Status* status, void*) {
+          *status = grpc::Status::OK;
+        });
+        return reader;
+      });
+
+  // Each shard may have one outstanding batch.
+  ShardedMutationBatcher batcher(
+      table_, 2,
+      MutationBatcher::Options().SetMaxMutationsPerBatch(10).SetMaxBatches(2),
+      std::chrono::hours(1));
+
+  // Start()
+  cq_impl_->SimulateCompletion(true);
+  // Return both samples
+  cq_impl_->SimulateCompletion(true);
+  cq_impl_->SimulateCompletion(true);
+  // End stream
+  cq_impl_->SimulateCompletion(false);
+  // Finish()
+  cq_impl_->SimulateCompletion(true);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+
+  ExpectBatches({{"a"}, {"z"}, {"b"}});
+
+  // "a" and "b" are in the first tablet, so they use the same shard even
+  // though the second shard is idle.
+  auto sa = Apply(batcher, MakeMutation("a"));
+  auto sb = Apply(batcher, MakeMutation("b"));
+  EXPECT_TRUE(sb->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+  auto sz = Apply(batcher, MakeMutation("z"));
+  EXPECT_EQ(2, NumOperationsOutstanding());
+
+  FinishStreams();
+  EXPECT_TRUE(sa->completed);
+  EXPECT_TRUE(sz->completed);
+  EXPECT_FALSE(sb->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishStreams();
+  EXPECT_TRUE(sb->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -14,10 +14,12 @@
 
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
+#include "google/cloud/bigtable/internal/async_parallel_row_reader.h"
 #include "google/cloud/bigtable/internal/async_row_sampler.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
 #include "google/cloud/internal/async_retry_unary_rpc.h"
+#include <mutex>
 #include <thread>
 #include <type_traits>
 
@@ -61,6 +63,81 @@ Row TransformReadModifyWriteRowResponse(Response& response) {
   return Row(std::move(*row.mutable_key()), std::move(cells));
 }
 
+using ReadRowResult = StatusOr<std::pair<bool, Row>>;
+
+/**
+ * The state shared by the requests of a hedged `Table::AsyncReadRow()`.
+ *
+ * The first successful request satisfies the future, and the other request is
+ * cancelled. A failed request only satisfies the future if no other request is
+ * pending.
+ */
+class HedgedReadRow {
+ public:
+  using Reader = AsyncRowReader<std::function<future<bool>(Row)>,
+                                std::function<void(Status)>>;
+
+  explicit HedgedReadRow(std::shared_ptr<bigtable::internal::ReadRowHedger> h)
+      : hedger_(std::move(h)), start_(std::chrono::steady_clock::now()) {}
+
+  future<ReadRowResult> GetFuture() { return promise_.get_future(); }
+
+  bool done() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return done_;
+  }
+
+  /// Reserve a slot for a new request, returns false if the read is done.
+  bool StartRequest() {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (done_) return false;
+    ++pending_;
+    readers_.emplace_back();
+    return true;
+  }
+
+  /// Save the reader for request @p index, so it can be cancelled.
+  void SetReader(std::size_t index, std::shared_ptr<Reader> reader) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!done_) {
+      readers_[index] = std::move(reader);
+      return;
+    }
+    lk.unlock();
+    // The read completed before the reader was saved.
+    reader->TryCancel();
+  }
+
+  void OnFinished(std::size_t index, ReadRowResult result) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (done_) return;
+    --pending_;
+    if (!result && pending_ != 0) return;
+    done_ = true;
+    auto readers = std::move(readers_);
+    lk.unlock();
+    for (std::size_t i = 0; i != readers.size(); ++i) {
+      if (i != index && readers[i]) readers[i]->TryCancel();
+    }
+    if (result) {
+      hedger_->OnReadComplete(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start_),
+          index != 0);
+    }
+    promise_.set_value(std::move(result));
+  }
+
+ private:
+  std::shared_ptr<bigtable::internal::ReadRowHedger> hedger_;
+  std::chrono::steady_clock::time_point const start_;
+  promise<ReadRowResult> promise_;
+  std::mutex mu_;
+  bool done_ = false;
+  int pending_ = 0;
+  std::vector<std::shared_ptr<Reader>> readers_;
+};
+
 }  // namespace
 
 using ClientUtils = bigtable::internal::UnaryClientUtils<DataClient>;
@@ -81,6 +158,7 @@ Status Table::Apply(SingleRowMutation mut) {
   SetCommonTableOperationRequest<btproto::MutateRowRequest>(
       request, app_profile_id_, table_name_);
   mut.MoveTo(request);
+  InvalidateRowCache(request.row_key());
 
   bool const is_idempotent =
       std::all_of(request.mutations().begin(), request.mutations().end(),
@@ -98,11 +176,14 @@ Status Table::Apply(SingleRowMutation mut) {
     status = client_->MutateRow(&client_context, request, &response);
 
     if (status.ok()) {
+      InvalidateRowCache(request.row_key());
       return google::cloud::Status{};
     }
     // It is up to the policy to terminate this loop, it could run
     // forever, but that would be a bad policy (pun intended).
     if (!rpc_policy->OnFailure(status) || !is_idempotent) {
+      // The mutation may have been applied even if the RPC failed.
+      InvalidateRowCache(request.row_key());
       return MakeStatusFromRpcError(status);
     }
     auto delay = backoff_policy->OnCompletion(status);
@@ -115,6 +196,7 @@ future<Status> Table::AsyncApply(SingleRowMutation mut) {
   SetCommonTableOperationRequest<google::bigtable::v2::MutateRowRequest>(
       request, app_profile_id_, table_name_);
   mut.MoveTo(request);
+  InvalidateRowCache(request.row_key());
   auto context = absl::make_unique<grpc::ClientContext>();
 
   // Determine if all the mutations are idempotent. The idempotency of the
@@ -133,6 +215,8 @@ future<Status> Table::AsyncApply(SingleRowMutation mut) {
   auto cq = background_threads_->cq();
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
+  auto cache = row_cache_;
+  auto row_key = cache ? request.row_key() : std::string{};
   return google::cloud::internal::StartRetryAsyncUnaryRpc(
              cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
              idempotency,
@@ -144,7 +228,9 @@ future<Status> Table::AsyncApply(SingleRowMutation mut) {
                return client->AsyncMutateRow(context, request, cq);
              },
              std::move(request))
-      .then([](future<StatusOr<google::bigtable::v2::MutateRowResponse>> r) {
+      .then([cache, row_key](
+                future<StatusOr<google::bigtable::v2::MutateRowResponse>> r) {
+        if (cache) cache->Invalidate(row_key);
         return r.get().status();
       });
 }
@@ -159,6 +245,8 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
   auto retry_policy = clone_rpc_retry_policy();
   auto idempotent_policy = clone_idempotent_mutation_policy();
 
+  auto const row_keys = CachedRowKeys(mut);
+  InvalidateRowCache(row_keys);
   bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
                                           *idempotent_policy, std::move(mut));
   while (mutator.HasPendingMutations()) {
@@ -173,16 +261,43 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
     auto delay = backoff_policy->OnCompletion(status);
     std::this_thread::sleep_for(delay);
   }
+  InvalidateRowCache(row_keys);
   return std::move(mutator).OnRetryDone();
 }
 
 future<std::vector<FailedMutation>> Table::AsyncBulkApply(BulkMutation mut) {
   auto cq = background_threads_->cq();
   auto mutation_policy = clone_idempotent_mutation_policy();
-  return internal::AsyncRetryBulkApply::Create(
+  auto row_keys = CachedRowKeys(mut);
+  InvalidateRowCache(row_keys);
+  auto f = internal::AsyncRetryBulkApply::Create(
       cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
       *mutation_policy, clone_metadata_update_policy(), client_,
       app_profile_id_, table_name(), std::move(mut));
+  if (!row_cache_) return f;
+  auto cache = row_cache_;
+  return f.then([cache, row_keys](future<std::vector<FailedMutation>> r) {
+    for (auto const& k : row_keys) cache->Invalidate(k);
+    return r.get();
+  });
+}
+
+future<void> Table::AsyncBulkApply(
+    BulkMutation mut, std::function<void(int, Status const&)> on_entry_done) {
+  auto cq = background_threads_->cq();
+  auto mutation_policy = clone_idempotent_mutation_policy();
+  auto row_keys = CachedRowKeys(mut);
+  InvalidateRowCache(row_keys);
+  auto f = internal::AsyncRetryBulkApply::CreateStreaming(
+      cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      *mutation_policy, clone_metadata_update_policy(), client_,
+      app_profile_id_, table_name(), std::move(mut), std::move(on_entry_done));
+  if (!row_cache_) return f;
+  auto cache = row_cache_;
+  return f.then([cache, row_keys](future<void> r) {
+    for (auto const& k : row_keys) cache->Invalidate(k);
+    r.get();
+  });
 }
 
 RowReader Table::ReadRows(RowSet row_set, Filter filter) {
@@ -202,8 +317,36 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
       absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
 }
 
+RowBatchReader Table::ReadRowBatches(RowSet row_set, Filter filter) {
+  return ReadRowBatches(std::move(row_set), RowBatchReader::NO_ROWS_LIMIT,
+                        std::move(filter));
+}
+
+RowBatchReader Table::ReadRowBatches(RowSet row_set, std::int64_t rows_limit,
+                                     Filter filter) {
+  return RowBatchReader(
+      client_, app_profile_id_, table_name_, std::move(row_set), rows_limit,
+      std::move(filter), clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      metadata_update_policy_,
+      absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
+}
+
 StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
                                               Filter filter) {
+  if (!row_cache_) {
+    return ReadRowUncached(std::move(row_key), std::move(filter));
+  }
+  auto const fingerprint = filter.as_proto().SerializeAsString();
+  auto cached = row_cache_->Lookup(row_key, fingerprint);
+  if (cached) return *std::move(cached);
+  auto const generation = row_cache_->generation();
+  auto result = ReadRowUncached(row_key, std::move(filter));
+  if (result) row_cache_->Insert(row_key, fingerprint, *result, generation);
+  return result;
+}
+
+StatusOr<std::pair<bool, Row>> Table::ReadRowUncached(std::string row_key,
+                                                      Filter filter) {
   RowSet row_set(std::move(row_key));
   std::int64_t const rows_limit = 1;
   RowReader reader =
@@ -242,10 +385,12 @@ StatusOr<MutationBranch> Table::CheckAndMutateRow(
   auto const idempotency = idempotent_mutation_policy_->is_idempotent(request)
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
+  InvalidateRowCache(request.row_key());
   auto response = ClientUtils::MakeCall(
       *client_, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
       metadata_update_policy_, &DataClient::CheckAndMutateRow, request,
       "Table::CheckAndMutateRow", status, idempotency);
+  InvalidateRowCache(request.row_key());
 
   if (!status.ok()) {
     return MakeStatusFromRpcError(status);
@@ -272,9 +417,12 @@ future<StatusOr<MutationBranch>> Table::AsyncCheckAndMutateRow(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
 
+  InvalidateRowCache(request.row_key());
   auto cq = background_threads_->cq();
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
+  auto cache = row_cache_;
+  auto row_key = cache ? request.row_key() : std::string{};
   return google::cloud::internal::StartRetryAsyncUnaryRpc(
              cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
              idempotency,
@@ -286,8 +434,10 @@ future<StatusOr<MutationBranch>> Table::AsyncCheckAndMutateRow(
                return client->AsyncCheckAndMutateRow(context, request, cq);
              },
              std::move(request))
-      .then([](future<StatusOr<btproto::CheckAndMutateRowResponse>> f)
+      .then([cache, row_key](
+                future<StatusOr<btproto::CheckAndMutateRowResponse>> f)
                 -> StatusOr<MutationBranch> {
+        if (cache) cache->Invalidate(row_key);
         auto response = f.get();
         if (!response) {
           return response.status();
@@ -304,6 +454,7 @@ future<StatusOr<MutationBranch>> Table::AsyncCheckAndMutateRow(
 // policies in effect tell us to stop. Note that each retry must clear the
 // samples otherwise the result is an inconsistent set of sample row keys.
 StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows() {
+  if (sample_rows_cache_) return sample_rows_cache_->AsyncGet().get();
   // Copy the policies in effect for this operation.
   auto backoff_policy = clone_rpc_backoff_policy();
   auto retry_policy = clone_rpc_retry_policy();
@@ -345,23 +496,61 @@ StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows() {
 }
 
 future<StatusOr<std::vector<bigtable::RowKeySample>>> Table::AsyncSampleRows() {
+  if (sample_rows_cache_) return sample_rows_cache_->AsyncGet();
   auto cq = background_threads_->cq();
   return internal::AsyncRowSampler::Create(
       cq, client_, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
       metadata_update_policy_, app_profile_id_, table_name_);
 }
 
+future<Status> Table::AsyncParallelReadRows(
+    std::function<future<bool>(Row)> on_row, RowSet row_set, Filter filter,
+    ParallelReadRowsOptions options) {
+  using Samples = StatusOr<std::vector<bigtable::RowKeySample>>;
+  auto table = *this;
+  return AsyncSampleRows().then(
+      [table, on_row, row_set, filter, options](
+          future<Samples> f) -> future<Status> {
+        auto samples = f.get();
+        if (!samples) return make_ready_future(std::move(samples).status());
+        // Each stream uses its own copy of the table, the streams are started
+        // from different threads.
+        using Reader = internal::AsyncParallelRowReader;
+        auto factory = [table, filter](RowSet shard, Reader::RowCallback row_cb,
+                                       Reader::FinishCallback finish_cb) {
+          auto t = table;
+          t.AsyncReadRows(std::move(row_cb), std::move(finish_cb),
+                          std::move(shard), filter);
+        };
+        return Reader::Create(row_set.SplitBy(*samples),
+                              std::move(factory), on_row, options);
+      });
+}
+
+Status Table::ParallelReadRows(std::function<bool(Row)> on_row,
+                               RowSet row_set, Filter filter,
+                               ParallelReadRowsOptions options) {
+  return AsyncParallelReadRows(
+             [on_row](Row row) {
+               return make_ready_future(on_row(std::move(row)));
+             },
+             std::move(row_set), std::move(filter), std::move(options))
+      .get();
+}
+
 StatusOr<Row> Table::ReadModifyWriteRowImpl(
     btproto::ReadModifyWriteRowRequest request) {
   SetCommonTableOperationRequest<
       ::google::bigtable::v2::ReadModifyWriteRowRequest>(
       request, app_profile_id_, table_name_);
 
+  InvalidateRowCache(request.row_key());
   grpc::Status status;
   auto response = ClientUtils::MakeNonIdempotentCall(
       *(client_), clone_rpc_retry_policy(), clone_metadata_update_policy(),
       &DataClient::ReadModifyWriteRow, request, "ReadModifyWriteRowRequest",
       status);
+  InvalidateRowCache(request.row_key());
   if (!status.ok()) {
     return MakeStatusFromRpcError(status);
   }
@@ -375,9 +564,12 @@ future<StatusOr<Row>> Table::AsyncReadModifyWriteRowImpl(
       ::google::bigtable::v2::ReadModifyWriteRowRequest>(
       request, app_profile_id_, table_name_);
 
+  InvalidateRowCache(request.row_key());
   auto cq = background_threads_->cq();
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
+  auto cache = row_cache_;
+  auto row_key = cache ? request.row_key() : std::string{};
   return google::cloud::internal::StartRetryAsyncUnaryRpc(
              cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
              Idempotency::kNonIdempotent,
@@ -389,8 +581,10 @@ future<StatusOr<Row>> Table::AsyncReadModifyWriteRowImpl(
                return client->AsyncReadModifyWriteRow(context, request, cq);
              },
              std::move(request))
-      .then([](future<StatusOr<btproto::ReadModifyWriteRowResponse>> fut)
+      .then([cache, row_key](
+                future<StatusOr<btproto::ReadModifyWriteRowResponse>> fut)
                 -> StatusOr<Row> {
+        if (cache) cache->Invalidate(row_key);
         auto result = fut.get();
         if (!result) {
           return result.status();
@@ -402,6 +596,31 @@ future<StatusOr<Row>> Table::AsyncReadModifyWriteRowImpl(
 
 future<StatusOr<std::pair<bool, Row>>> Table::AsyncReadRow(std::string row_key,
                                                            Filter filter) {
+  if (!row_cache_) {
+    return AsyncReadRowUncached(std::move(row_key), std::move(filter));
+  }
+  auto fingerprint = filter.as_proto().SerializeAsString();
+  auto cached = row_cache_->Lookup(row_key, fingerprint);
+  if (cached) {
+    return make_ready_future(
+        StatusOr<std::pair<bool, Row>>(*std::move(cached)));
+  }
+  auto const generation = row_cache_->generation();
+  auto cache = row_cache_;
+  return AsyncReadRowUncached(row_key, std::move(filter))
+      .then([cache, row_key, fingerprint,
+             generation](future<StatusOr<std::pair<bool, Row>>> f) {
+        auto result = f.get();
+        if (result) cache->Insert(row_key, fingerprint, *result, generation);
+        return result;
+      });
+}
+
+future<StatusOr<std::pair<bool, Row>>> Table::AsyncReadRowUncached(
+    std::string row_key, Filter filter) {
+  if (read_row_hedger_) {
+    return AsyncReadRowHedged(std::move(row_key), std::move(filter));
+  }
   class AsyncReadRowHandler {
    public:
     AsyncReadRowHandler() : row_("", {}) {}
@@ -454,6 +673,134 @@ future<StatusOr<std::pair<bool, Row>>> Table::AsyncReadRow(std::string row_key,
   return handler->GetFuture();
 }
 
+future<StatusOr<std::pair<bool, Row>>> Table::AsyncReadRowHedged(
+    std::string row_key, Filter filter) {
+  auto hedger = read_row_hedger_;
+  auto state = std::make_shared<HedgedReadRow>(hedger);
+  auto cq = background_threads_->cq();
+  // The hedged request may start after this object is gone, capture copies of
+  // everything needed to start a request.
+  auto client = client_;
+  auto app_profile_id = app_profile_id_;
+  auto table_name = table_name_;
+  auto retry = rpc_retry_policy_prototype_;
+  auto backoff = rpc_backoff_policy_prototype_;
+  auto metadata_update_policy = metadata_update_policy_;
+  auto start_request = [state, cq, row_key, filter, client, app_profile_id,
+                        table_name, retry, backoff,
+                        metadata_update_policy](std::size_t index) {
+    if (!state->StartRequest()) return;
+    struct Received {
+      Row row{"", {}};
+      bool found = false;
+    };
+    auto received = std::make_shared<Received>();
+    auto reader = HedgedReadRow::Reader::Create(
+        cq, client, app_profile_id, table_name,
+        [received](Row row) {
+          received->row = std::move(row);
+          received->found = true;
+          // Stop the stream once the row is received.
+          return make_ready_future(false);
+        },
+        [state, received, index](Status status) {
+          if (received->found) {
+            state->OnFinished(index,
+                              std::make_pair(true, std::move(received->row)));
+          } else if (status.ok()) {
+            state->OnFinished(index, std::make_pair(false, Row("", {})));
+          } else {
+            state->OnFinished(index, std::move(status));
+          }
+        },
+        RowSet(row_key), 1, filter, retry->clone(), backoff->clone(),
+        metadata_update_policy,
+        absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
+    state->SetReader(index, std::move(reader));
+  };
+
+  start_request(0);
+  using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
+  cq.MakeRelativeTimer(hedger->StartRead())
+      .then([state, hedger, start_request](TimerFuture f) {
+        if (!f.get() || state->done() || !hedger->TryHedge()) return;
+        start_request(1);
+      });
+  return state->GetFuture();
+}
+
+void Table::EnableReadRowHedging(ReadRowHedgingOptions options) {
+  read_row_hedger_ =
+      std::make_shared<bigtable::internal::ReadRowHedger>(std::move(options));
+}
+
+ReadRowHedgingStats Table::read_row_hedging_stats() const {
+  if (!read_row_hedger_) return ReadRowHedgingStats{};
+  return read_row_hedger_->stats();
+}
+
+void Table::EnableSampleRowsCache(SampleRowsCacheOptions options) {
+  auto cq = background_threads_->cq();
+  // The refreshes outlive any particular copy of this object. Capture what the
+  // requests need, but not `background_threads_`, the last reference to the
+  // cache may be released in one of its threads.
+  auto client = client_;
+  auto retry = rpc_retry_policy_prototype_;
+  auto backoff = rpc_backoff_policy_prototype_;
+  auto metadata_update_policy = metadata_update_policy_;
+  auto app_profile_id = app_profile_id_;
+  auto table_name = table_name_;
+  auto fetcher = [cq, client, retry, backoff, metadata_update_policy,
+                  app_profile_id, table_name]() {
+    return internal::AsyncRowSampler::Create(
+        cq, client, retry->clone(), backoff->clone(), metadata_update_policy,
+        app_profile_id, table_name);
+  };
+  sample_rows_cache_ = internal::SampleRowsCache::Create(
+      std::move(cq), std::move(fetcher), std::move(options));
+}
+
+SampleRowsCacheStats Table::sample_rows_cache_stats() const {
+  if (!sample_rows_cache_) return SampleRowsCacheStats{};
+  return sample_rows_cache_->stats();
+}
+
+void Table::EnableReadRowsFlowControl(ReadRowsFlowControlOptions options) {
+  read_rows_flow_control_ =
+      std::make_shared<internal::ReadRowsFlowControl>(std::move(options));
+}
+
+ReadRowsFlowControlStats Table::read_rows_flow_control_stats() const {
+  if (!read_rows_flow_control_) return ReadRowsFlowControlStats{};
+  return read_rows_flow_control_->stats();
+}
+
+void Table::EnableRowCache(RowCacheOptions options) {
+  row_cache_ = std::make_shared<internal::RowCache>(std::move(options));
+}
+
+RowCacheStats Table::row_cache_stats() const {
+  if (!row_cache_) return RowCacheStats{};
+  return row_cache_->stats();
+}
+
+void Table::InvalidateRowCache(std::string const& row_key) {
+  if (row_cache_) row_cache_->Invalidate(row_key);
+}
+
+void Table::InvalidateRowCache(std::vector<std::string> const& row_keys) {
+  if (!row_cache_) return;
+  for (auto const& k : row_keys) row_cache_->Invalidate(k);
+}
+
+std::vector<std::string> Table::CachedRowKeys(BulkMutation const& mut) const {
+  std::vector<std::string> row_keys;
+  if (!row_cache_) return row_keys;
+  row_keys.reserve(mut.size());
+  for (auto const& e : mut.request_.entries()) row_keys.push_back(e.row_key());
+  return row_keys;
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -15,24 +15,37 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TABLE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TABLE_H
 
+#include "google/cloud/bigtable/async_row_batch_reader.h"
 #include "google/cloud/bigtable/async_row_reader.h"
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
+#include "google/cloud/bigtable/internal/read_row_hedger.h"
+#include "google/cloud/bigtable/internal/read_rows_flow_control.h"
+#include "google/cloud/bigtable/internal/row_cache.h"
+#include "google/cloud/bigtable/internal/sample_rows_cache.h"
 #include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/parallel_read_rows_options.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/read_row_hedging_options.h"
+#include "google/cloud/bigtable/read_rows_flow_control_options.h"
+#include "google/cloud/bigtable/row_batch_reader.h"
+#include "google/cloud/bigtable/row_cache_options.h"
 #include "google/cloud/bigtable/row_key_sample.h"
 #include "google/cloud/bigtable/row_reader.h"
 #include "google/cloud/bigtable/row_set.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/sample_rows_cache_options.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/future.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "absl/meta/type_traits.h"
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -455,6 +468,41 @@ class Table {
    */
   future<std::vector<FailedMutation>> AsyncBulkApply(BulkMutation mut);
 
+  /**
+   * Makes asynchronous attempts to apply mutations to multiple rows, reporting
+   * the result of each mutation as soon as it is known.
+   *
+   * Unlike `AsyncBulkApply(BulkMutation)`, the mutations that succeed are not
+   * held back until the other mutations complete their retries. The library
+   * also frees the data of each mutation once its result is reported.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param mut the mutations, note that this function takes ownership (and
+   *     then discards) the data in the mutation.
+   * @param on_entry_done called exactly once for each mutation, with its index
+   *     in @p mut and its final status. The calls happen in the thread that
+   *     received the corresponding response, and they are not serialized with
+   *     respect to other calls to this function.
+   *
+   * @return a future satisfied after the last call to @p on_entry_done.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent. Note
+   * that `google::cloud::bigtable::SetCell()` without an explicit timestamp is
+   * **not** an idempotent operation.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. Consider copying the object
+   * and using different copies in each thread.
+   */
+  future<void> AsyncBulkApply(
+      BulkMutation mut,
+      std::function<void(int, Status const&)> on_entry_done);
+
   /**
    * Reads a set of rows from the table.
    *
@@ -500,6 +548,49 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Reads a set of rows from the table, returning them in zero-copy batches.
+   *
+   * This is an alternative to `ReadRows()` for applications that scan large
+   * amounts of data. The `RowView` and `CellView` objects in each batch refer
+   * to the responses received from the service, and are only valid while the
+   * `RowBatch` is alive.
+   *
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. Consider copying the object
+   * and using different copies in each thread. Please see the `RowBatchReader`
+   * documentation for more details.
+   */
+  RowBatchReader ReadRowBatches(RowSet row_set, Filter filter);
+
+  /**
+   * Reads a limited set of rows from the table, in zero-copy batches.
+   *
+   * @param row_set the rows to read from.
+   * @param rows_limit the maximum number of rows to read. Cannot be a negative
+   *     number or zero. Use `ReadRowBatches(RowSet, Filter)` to read all
+   *     matching rows.
+   * @param filter is applied on the server-side to data in the rows.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. Consider copying the object
+   * and using different copies in each thread. Please see the `RowBatchReader`
+   * documentation for more details.
+   */
+  RowBatchReader ReadRowBatches(RowSet row_set, std::int64_t rows_limit,
+                                Filter filter);
+
   /**
    * Read and return a single row from the table.
    *
@@ -807,6 +898,79 @@ class Table {
         std::move(on_row), std::move(on_finish), std::move(row_set), rows_limit,
         std::move(filter), clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
         metadata_update_policy_,
+        absl::make_unique<bigtable::internal::ReadRowsParserFactory>(),
+        read_rows_flow_control_);
+  }
+
+  /**
+   * Asynchronously reads a set of rows from the table, in batches.
+   *
+   * This is similar to `AsyncReadRows()`, but @p on_rows receives all the rows
+   * parsed from each response in a single call. Applications reading many
+   * small rows avoid the cost of a callback and a future per row.
+   *
+   * @param on_rows the callback to be invoked with each batch of rows; it
+   *     should be invocable with `std::vector<Row>` and return a
+   *     `future<bool>`; the returned future should be satisfied with `true`
+   *     when the user is ready to receive the next batch and with `false` when
+   *     the user doesn't want any more rows. The stream does not read more
+   *     data until this future is satisfied.
+   * @param on_finish the callback to be invoked when the stream is closed; it
+   *     should be invocable with `Status` and not return anything; it will
+   *     always be called as the last callback.
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   *
+   * @tparam RowsFunctor the type of the @p on_rows callback.
+   * @tparam FinishFunctor the type of the @p on_finish callback.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. Consider copying the object
+   * and using different copies in each thread. The callbacks passed to this
+   * function may be executed on any thread running the provided completion
+   * queue.
+   */
+  template <typename RowsFunctor, typename FinishFunctor>
+  void AsyncReadRowBatches(RowsFunctor on_rows, FinishFunctor on_finish,
+                           RowSet row_set, Filter filter) {
+    AsyncReadRowBatches(
+        std::move(on_rows), std::move(on_finish), std::move(row_set),
+        AsyncRowBatchReader<RowsFunctor, FinishFunctor>::NO_ROWS_LIMIT,
+        std::move(filter));
+  }
+
+  /**
+   * Asynchronously reads a limited set of rows from the table, in batches.
+   *
+   * @param on_rows the callback to be invoked with each batch of rows, see
+   *     `AsyncReadRowBatches(RowSet, Filter)` for details.
+   * @param on_finish the callback to be invoked when the stream is closed.
+   * @param row_set the rows to read from.
+   * @param rows_limit the maximum number of rows to read. Cannot be a negative
+   *     number or zero. Use `AsyncReadRowBatches(RowSet, Filter)` to read all
+   *     matching rows.
+   * @param filter is applied on the server-side to data in the rows.
+   *
+   * @tparam RowsFunctor the type of the @p on_rows callback.
+   * @tparam FinishFunctor the type of the @p on_finish callback.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. Consider copying the object
+   * and using different copies in each thread. The callbacks passed to this
+   * function may be executed on any thread running the provided completion
+   * queue.
+   */
+  template <typename RowsFunctor, typename FinishFunctor>
+  void AsyncReadRowBatches(RowsFunctor on_rows, FinishFunctor on_finish,
+                           RowSet row_set, std::int64_t rows_limit,
+                           Filter filter) {
+    AsyncRowBatchReader<RowsFunctor, FinishFunctor>::Create(
+        background_threads_->cq(), client_, app_profile_id_, table_name_,
+        std::move(on_rows), std::move(on_finish), std::move(row_set),
+        rows_limit, std::move(filter), clone_rpc_retry_policy(),
+        clone_rpc_backoff_policy(), metadata_update_policy_,
         absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
   }
 
@@ -842,7 +1006,178 @@ class Table {
   future<StatusOr<std::pair<bool, Row>>> AsyncReadRow(std::string row_key,
                                                       Filter filter);
 
+  /**
+   * Asynchronously reads a set of rows using multiple concurrent streams.
+   *
+   * This function splits @p row_set into disjoint shards using the results of
+   * `AsyncSampleRows()`, and then reads each shard with a separate stream. The
+   * streams are distributed over the channels in the connection pool, which
+   * can greatly improve the throughput of large scans.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param on_row the callback to be invoked on each successfully read row; it
+   *     should return a `future<bool>` satisfied with `true` when the
+   *     application is ready to receive the next row, and with `false` when
+   *     it does not want any more rows. The callback is never invoked
+   *     concurrently, but it may be invoked from any thread running the
+   *     completion queue.
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param options control the number of concurrent streams, the number of
+   *     rows buffered for each stream, and whether the rows are delivered in
+   *     key order.
+   * @returns a future satisfied once all the rows are delivered, once
+   *     @p on_row returns `false`, or once any stream fails. In the last case
+   *     the future contains the error, and some rows may not have been
+   *     delivered.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent. Each
+   * stream is retried using the table retry and backoff policies.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. Consider copying the object
+   * and using different copies in each thread.
+   */
+  future<Status> AsyncParallelReadRows(
+      std::function<future<bool>(Row)> on_row, RowSet row_set, Filter filter,
+      ParallelReadRowsOptions options = ParallelReadRowsOptions());
+
+  /**
+   * Reads a set of rows using multiple concurrent streams.
+   *
+   * This is the blocking version of `AsyncParallelReadRows()`. The @p on_row
+   * callback returns `false` to stop the scan. It is never invoked
+   * concurrently, but it is invoked from the threads running the completion
+   * queue, not from the calling thread.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. Consider copying the object
+   * and using different copies in each thread.
+   */
+  Status ParallelReadRows(
+      std::function<bool(Row)> on_row, RowSet row_set, Filter filter,
+      ParallelReadRowsOptions options = ParallelReadRowsOptions());
+
+  /**
+   * Cache the results of `ReadRow()` and `AsyncReadRow()` in the client.
+   *
+   * Applications that read the same rows many times can avoid most of the
+   * requests to the service. The results are keyed by the row key and the
+   * filter, and expire after `RowCacheOptions::ttl`. The writes through this
+   * object, or any copies made after this call, remove the cached results for
+   * the rows they modify. The cache does not see writes made by other clients,
+   * which are visible once the cached results expire.
+   *
+   * Calling this function again replaces the cache with an empty one.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. The copies of this object
+   * share the cache, and are safe to use from different threads.
+   */
+  void EnableRowCache(RowCacheOptions options = RowCacheOptions());
+
+  /// The hit and miss counters for the row cache, all zeros if not enabled.
+  RowCacheStats row_cache_stats() const;
+
+  /**
+   * Send hedged requests for slow `AsyncReadRow()` calls.
+   *
+   * If a read has not completed after a delay a second request for the same
+   * row is sent, on a (usually) different channel in the connection pool. The
+   * first response is returned and the other request is cancelled. This
+   * reduces the tail latency caused by a slow server or channel, at the cost
+   * of some extra load. The extra load is bounded by the budget in
+   * @p options. `ReadRow()` is not affected.
+   *
+   * Calling this function again replaces the policy, and resets its learned
+   * latencies and budget.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. The copies of this object
+   * share the policy, and are safe to use from different threads.
+   */
+  void EnableReadRowHedging(
+      ReadRowHedgingOptions options = ReadRowHedgingOptions());
+
+  /// The counters for hedged reads, all zeros if not enabled.
+  ReadRowHedgingStats read_row_hedging_stats() const;
+
+  /**
+   * Cache the results of `SampleRows()` and `AsyncSampleRows()` in the client.
+   *
+   * The tablet boundaries change slowly, and applications that split their
+   * work by the row key samples, for example with `RowSet::SplitBy()` or
+   * `ParallelReadRows()`, rarely need the latest ones. The cache fetches the
+   * samples immediately, and refreshes them in the background every
+   * `SampleRowsCacheOptions::refresh_period`, using the completion queue of
+   * this object.
+   *
+   * Calling this function again replaces the cache with a new one.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. The copies of this object
+   * share the cache, and are safe to use from different threads.
+   */
+  void EnableSampleRowsCache(
+      SampleRowsCacheOptions options = SampleRowsCacheOptions());
+
+  /// The counters for the samples cache, all zeros if not enabled.
+  SampleRowsCacheStats sample_rows_cache_stats() const;
+
+  /**
+   * Bound the memory used by the rows received in `AsyncReadRows()`.
+   *
+   * The streams started by this object and its copies share a budget of
+   * `ReadRowsFlowControlOptions::max_outstanding_bytes`. A row counts against
+   * the budget until the future returned by the `on_row` callback is
+   * satisfied. While the budget is exhausted the streams do not read more
+   * responses from the service, so applications running many concurrent
+   * scans, including `ParallelReadRows()`, keep a bounded amount of data in
+   * memory.
+   *
+   * Only the streams started after this call are affected. Calling this
+   * function again creates a new budget for the streams started afterwards.
+   *
+   * @par Thread-safety
+   * Two threads concurrently calling this member function on the same instance
+   * of this class are **not** guaranteed to work. The copies of this object
+   * share the budget, and are safe to use from different threads.
+   */
+  void EnableReadRowsFlowControl(
+      ReadRowsFlowControlOptions options = ReadRowsFlowControlOptions());
+
+  /// The counters for the `AsyncReadRows()` budget, all zeros if not enabled.
+  ReadRowsFlowControlStats read_rows_flow_control_stats() const;
+
  private:
+  StatusOr<std::pair<bool, Row>> ReadRowUncached(std::string row_key,
+                                                 Filter filter);
+  future<StatusOr<std::pair<bool, Row>>> AsyncReadRowUncached(
+      std::string row_key, Filter filter);
+  future<StatusOr<std::pair<bool, Row>>> AsyncReadRowHedged(
+      std::string row_key, Filter filter);
+
+  //@{
+  /// @name Remove any cached results for the rows modified by a write.
+  void InvalidateRowCache(std::string const& row_key);
+  void InvalidateRowCache(std::vector<std::string> const& row_keys);
+  //@}
+
+  /// Return the row keys in @p mut if the row cache is enabled.
+  std::vector<std::string> CachedRowKeys(BulkMutation const& mut) const;
+
   /**
    * Send request ReadModifyWriteRowRequest to modify the row and get it back
    */
@@ -901,7 +1236,9 @@ class Table {
   void ChangePolicies() {}
   //@}
 
+  friend class IncrementCombiner;
   friend class MutationBatcher;
+  friend class RowMutationPipeline;
   std::shared_ptr<DataClient> client_;
   std::string app_profile_id_;
   std::string table_name_;
@@ -911,6 +1248,16 @@ class Table {
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<IdempotentMutationPolicy> idempotent_mutation_policy_;
   std::shared_ptr<BackgroundThreads> background_threads_;
+  /// Null unless the row cache is enabled, shared by the copies of this object.
+  std::shared_ptr<internal::RowCache> row_cache_;
+  /// Null unless hedged reads are enabled, shared by the copies of this object.
+  std::shared_ptr<internal::ReadRowHedger> read_row_hedger_;
+  /// Null unless the samples cache is enabled, shared by the copies of this
+  /// object.
+  std::shared_ptr<internal::SampleRowsCache> sample_rows_cache_;
+  /// Null unless `AsyncReadRows()` flow control is enabled, shared by the
+  /// copies of this object.
+  std::shared_ptr<internal::ReadRowsFlowControl> read_rows_flow_control_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
 #include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/chrono_literals.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include "absl/memory/memory.h"
 
@@ -27,6 +28,7 @@ namespace {
 namespace btproto = ::google::bigtable::v2;
 using ::google::cloud::bigtable::testing::MockReadRowsReader;
 using ::google::cloud::testing_util::IsContextMDValid;
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
 using ::testing::Return;
 
 class TableReadRowTest : public bigtable::testing::TableTestFixture {
@@ -121,6 +123,61 @@ TEST_F(TableReadRowTest, UnrecoverableFailure) {
   EXPECT_FALSE(row);
 }
 
+TEST_F(TableReadRowTest, RowCache) {
+  auto const response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+  auto make_stream = [&response](grpc::ClientContext*,
+                                 btproto::ReadRowsRequest const&) {
+    auto stream = absl::make_unique<MockReadRowsReader>(
+        "google.bigtable.v2.Bigtable.ReadRows");
+    EXPECT_CALL(*stream, Read)
+        .WillOnce([response](btproto::ReadRowsResponse* r) {
+          *r = response;
+          return true;
+        })
+        .WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish).WillOnce(Return(grpc::Status::OK));
+    return stream;
+  };
+  // The first read, a read with a different filter, and the read after the
+  // write are sent to the service.
+  EXPECT_CALL(*client_, ReadRows)
+      .WillOnce(make_stream)
+      .WillOnce(make_stream)
+      .WillOnce(make_stream);
+  EXPECT_CALL(*client_, MutateRow).WillOnce(Return(grpc::Status::OK));
+
+  table_.EnableRowCache();
+  auto const filter = bigtable::Filter::PassAllFilter();
+  for (int i = 0; i != 3; ++i) {
+    auto result = table_.ReadRow("r1", filter);
+    ASSERT_STATUS_OK(result);
+    EXPECT_TRUE(result->first);
+    EXPECT_EQ("r1", result->second.row_key());
+  }
+  ASSERT_STATUS_OK(table_.ReadRow("r1", bigtable::Filter::Latest(1)));
+  auto stats = table_.row_cache_stats();
+  EXPECT_EQ(2, stats.hits);
+  EXPECT_EQ(2, stats.misses);
+  EXPECT_EQ(2, stats.size);
+
+  ASSERT_STATUS_OK(table_.Apply(
+      SingleRowMutation("r1", {SetCell("fam", "col", 0_ms, "new-value")})));
+  EXPECT_EQ(0, table_.row_cache_stats().size);
+  ASSERT_STATUS_OK(table_.ReadRow("r1", filter));
+  stats = table_.row_cache_stats();
+  EXPECT_EQ(2, stats.hits);
+  EXPECT_EQ(3, stats.misses);
+}
+
 }  // anonymous namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
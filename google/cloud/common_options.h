@@ -15,7 +15,9 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_COMMON_OPTIONS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_COMMON_OPTIONS_H
 
+#include "google/cloud/memory_accountant.h"
 #include "google/cloud/options.h"
+#include "google/cloud/rpc_metrics.h"
 #include "google/cloud/version.h"
 #include <set>
 #include <string>
@@ -68,8 +70,9 @@ struct TracingComponentsOption {
 /**
  * A list of all the common options.
  */
-using CommonOptionList = OptionList<EndpointOption, UserAgentProductsOption,
-                                    TracingComponentsOption>;
+using CommonOptionList =
+    OptionList<EndpointOption, UserAgentProductsOption, TracingComponentsOption,
+               RpcMetricsOption, MemoryAccountantOption>;
 
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -16,6 +16,7 @@
 #include "google/cloud/options.h"
 #include "google/cloud/testing_util/scoped_log.h"
 #include <gmock/gmock.h>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -42,6 +43,7 @@ TEST(CommonOptionList, RegularOptions) {
   TestOption<EndpointOption>("foo.googleapis.com");
   TestOption<UserAgentProductsOption>({"foo", "bar"});
   TestOption<TracingComponentsOption>({"foo", "bar", "baz"});
+  TestOption<RpcMetricsOption>(std::make_shared<RpcMetrics>());
 }
 
 TEST(CommonOptionList, Expected) {
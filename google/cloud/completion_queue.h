@@ -24,6 +24,8 @@
 #include "absl/memory/memory.h"
 #include "absl/meta/type_traits.h"
 #include <chrono>
+#include <functional>
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -99,6 +101,34 @@ class CompletionQueue {
         std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
   }
 
+  /**
+   * Create a timer that fires after the @p duration, rounded up to @p tick.
+   *
+   * Timers created with this function expire at the end of the @p tick
+   * containing `now + duration`. All the timers expiring in the same tick may
+   * share a single underlying alarm, and a single wake up of the completion
+   * queue. Use this function when many operations wait for similar periods,
+   * and a delay of up to @p tick is acceptable, for example, when polling
+   * long-running operations.
+   *
+   * @param duration when should the timer expire relative to the current time.
+   * @param tick the granularity used to coalesce timers, zero or negative
+   *     values disable coalescing.
+   *
+   * @return a future that becomes satisfied after @p duration time has elapsed.
+   *     The result of the future is the time at which it expired, or an error
+   *     Status if the timer did not run to expiration (e.g. it was cancelled).
+   *     Note that cancelling the future does not cancel the underlying alarm.
+   */
+  template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+  future<StatusOr<std::chrono::system_clock::time_point>>
+  MakeCoalescedRelativeTimer(std::chrono::duration<Rep1, Period1> duration,
+                             std::chrono::duration<Rep2, Period2> tick) {
+    return impl_->MakeCoalescedRelativeTimer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(tick));
+  }
+
   /**
    * Make an asynchronous unary RPC.
    *
@@ -261,6 +291,24 @@ inline std::shared_ptr<CompletionQueueImpl> GetCompletionQueueImpl(
   return cq.impl_;
 }
 
+/**
+ * Returns a function that runs its argument in the threads of @p cq.
+ *
+ * The returned function does not extend the lifetime of the queue, once the
+ * queue is deleted its arguments are dropped without running them. This is
+ * used to prefetch pages in `MakePaginationRange()`, a range does not keep the
+ * background threads of a (deleted) connection alive.
+ */
+inline std::function<void(std::function<void()>)> MakeCompletionQueueExecutor(
+    CompletionQueue cq) {
+  std::weak_ptr<CompletionQueueImpl> weak = GetCompletionQueueImpl(cq);
+  return [weak](std::function<void()> f) {
+    auto impl = weak.lock();
+    if (!impl) return;
+    CompletionQueue(std::move(impl)).RunAsync(std::move(f));
+  };
+}
+
 }  // namespace internal
 
 }  // namespace GOOGLE_CLOUD_CPP_NS
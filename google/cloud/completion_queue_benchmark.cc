@@ -15,10 +15,13 @@
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/default_completion_queue_impl.h"
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <mutex>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -51,6 +54,11 @@ auto constexpr kMaxThreads = 16;
 auto constexpr kMinExecutions = 1 << 9;
 auto constexpr kMaxExecutions = 1 << 11;
 
+// The scaling benchmarks run from a single thread up to one thread per core.
+std::int64_t MaxScalingThreads() {
+  return (std::max)(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
 class Wait {
  public:
   explicit Wait(std::int64_t count) : count_(count) {}
@@ -98,8 +106,7 @@ BENCHMARK(BM_Baseline)
     ->Ranges({{kMinThreads, kMaxThreads}, {kMinExecutions, kMaxExecutions}})
     ->Complexity(benchmark::oN);
 
-void BM_CompletionQueueRunAsync(benchmark::State& state) {
-  CompletionQueue cq;
+void RunAsyncBenchmark(benchmark::State& state, CompletionQueue cq) {
   std::vector<std::thread> tasks(static_cast<std::size_t>(state.range(0)));
   std::generate(tasks.begin(), tasks.end(), [&cq] {
     return std::thread{[](CompletionQueue cq) { cq.Run(); }, cq};
@@ -121,11 +128,80 @@ void BM_CompletionQueueRunAsync(benchmark::State& state) {
   cq.Shutdown();
   for (auto& t : tasks) t.join();
 }
+
+void BM_CompletionQueueRunAsync(benchmark::State& state) {
+  RunAsyncBenchmark(state, CompletionQueue{});
+}
 BENCHMARK(BM_CompletionQueueRunAsync)
     ->RangeMultiplier(2)
     ->Ranges({{kMinThreads, kMaxThreads}, {kMinExecutions, kMaxExecutions}})
     ->Complexity(benchmark::oN);
 
+// Compare against the batched wakeups, where a burst of `RunAsync()` calls
+// only wakes up the event loop once.
+void BM_CompletionQueueRunAsyncBatched(benchmark::State& state) {
+  RunAsyncBenchmark(
+      state, CompletionQueue(
+                 std::make_shared<internal::DefaultCompletionQueueImpl>(true)));
+}
+BENCHMARK(BM_CompletionQueueRunAsyncBatched)
+    ->RangeMultiplier(2)
+    ->Ranges({{kMinThreads, kMaxThreads}, {kMinExecutions, kMaxExecutions}})
+    ->Complexity(benchmark::oN);
+
+// Measure how `RunAsync()` scales when all the threads share a single
+// completion queue.
+BENCHMARK(BM_CompletionQueueRunAsync)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, MaxScalingThreads()}, {kMaxExecutions, kMaxExecutions}})
+    ->UseRealTime();
+
+// Timers go through the `grpc::CompletionQueue`, measure how they scale when
+// all the threads block on a single `grpc::CompletionQueue`, and when each
+// thread blocks on its own shard.
+void TimerBenchmark(benchmark::State& state, std::size_t shard_count) {
+  CompletionQueue cq(std::make_shared<internal::DefaultCompletionQueueImpl>(
+      false, shard_count));
+  std::vector<std::thread> tasks(static_cast<std::size_t>(state.range(0)));
+  std::generate(tasks.begin(), tasks.end(), [&cq] {
+    return std::thread{[](CompletionQueue cq) { cq.Run(); }, cq};
+  });
+
+  using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
+  auto runner = [&](std::int64_t n) {
+    Wait wait(n);
+    for (std::int64_t i = 0; i != n; ++i) {
+      cq.MakeRelativeTimer(std::chrono::nanoseconds(0))
+          .then([&wait](TimerFuture) { wait.OneDone(); });
+    }
+    wait.BlockUntilDone();
+    return 0;
+  };
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(runner(state.range(1)));
+  }
+  state.SetComplexityN(state.range(1));
+  cq.Shutdown();
+  for (auto& t : tasks) t.join();
+}
+
+void BM_CompletionQueueTimers(benchmark::State& state) {
+  TimerBenchmark(state, 1);
+}
+BENCHMARK(BM_CompletionQueueTimers)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, MaxScalingThreads()}, {kMaxExecutions, kMaxExecutions}})
+    ->UseRealTime();
+
+void BM_ShardedCompletionQueueTimers(benchmark::State& state) {
+  TimerBenchmark(state, static_cast<std::size_t>(state.range(0)));
+}
+BENCHMARK(BM_ShardedCompletionQueueTimers)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, MaxScalingThreads()}, {kMaxExecutions, kMaxExecutions}})
+    ->UseRealTime();
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -25,6 +25,7 @@
 #include <chrono>
 #include <deque>
 #include <memory>
+#include <set>
 #include <thread>
 
 namespace google {
@@ -451,6 +452,31 @@ TEST(CompletionQueueTest, RunAsyncMoveOnlyVoid) {
   t.join();
 }
 
+TEST(CompletionQueueTest, CompletionQueueExecutor) {
+  CompletionQueue cq;
+  std::thread t{[&cq] { cq.Run(); }};
+  auto executor = internal::MakeCompletionQueueExecutor(cq);
+
+  promise<std::thread::id> p;
+  auto done = p.get_future();
+  executor([&p] { p.set_value(std::this_thread::get_id()); });
+  EXPECT_EQ(t.get_id(), done.get());
+  cq.Shutdown();
+  t.join();
+}
+
+TEST(CompletionQueueTest, CompletionQueueExecutorDeleted) {
+  auto executor = [] {
+    CompletionQueue cq;
+    return internal::MakeCompletionQueueExecutor(cq);
+  }();
+  // The queue is deleted, the function is dropped without running.
+  auto called = std::make_shared<bool>(false);
+  executor([called] { *called = true; });
+  EXPECT_FALSE(*called);
+  EXPECT_EQ(1, called.use_count());
+}
+
 TEST(CompletionQueueTest, RunAsyncThread) {
   CompletionQueue cq;
 
@@ -709,6 +735,156 @@ TEST_P(RunAsyncTest, TortureBursts) {
 INSTANTIATE_TEST_SUITE_P(RunAsyncTest, RunAsyncTest,
                          ::testing::Values(1, 4, 16));
 
+TEST(CompletionQueueTest, RunAsyncBatchedBursts) {
+  auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>(
+      /*batch_run_async=*/true);
+  CompletionQueue cq(impl);
+
+  auto constexpr kThreads = 4;
+  std::vector<std::thread> tasks(kThreads);
+  std::generate(tasks.begin(), tasks.end(), [&cq] {
+    return std::thread{[](CompletionQueue cq) { cq.Run(); }, cq};
+  });
+
+  auto constexpr kBurstCount = 50;
+  auto constexpr kBurstSize = 1000;
+  std::mutex mu;
+  std::condition_variable cv;
+  std::int64_t remaining = kBurstCount * kBurstSize;
+  auto on_async = [&] {
+    std::unique_lock<std::mutex> lk(mu);
+    if (--remaining == 0) cv.notify_one();
+  };
+  for (int i = 0; i != kBurstCount; ++i) {
+    for (int j = 0; j != kBurstSize; ++j) cq.RunAsync(on_async);
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return remaining == 0; });
+  }
+  cq.Shutdown();
+  for (auto& t : tasks) t.join();
+
+  // Each burst should need far fewer wakeups than functions.
+  EXPECT_GE(impl->notify_counter(), 1);
+  EXPECT_LT(impl->notify_counter(), kBurstCount * kBurstSize / 4);
+  EXPECT_LE(impl->run_async_pool_hwm(), kThreads - 1);
+}
+
+TEST(CompletionQueueTest, RunAsyncBatchedPreservesOrder) {
+  auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>(
+      /*batch_run_async=*/true);
+  CompletionQueue cq(impl);
+  std::thread t{[&cq] { cq.Run(); }};
+
+  auto constexpr kCount = 1000;
+  std::vector<int> values;
+  promise<void> done;
+  for (int i = 0; i != kCount; ++i) {
+    cq.RunAsync([&values, &done, i] {
+      values.push_back(i);
+      if (i == kCount - 1) done.set_value();
+    });
+  }
+  done.get_future().get();
+  cq.Shutdown();
+  t.join();
+
+  ASSERT_EQ(kCount, values.size());
+  for (int i = 0; i != kCount; ++i) EXPECT_EQ(i, values[i]);
+}
+
+TEST(CompletionQueueTest, RunAsyncBatchedAfterShutdown) {
+  auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>(
+      /*batch_run_async=*/true);
+  CompletionQueue cq(impl);
+  std::thread t{[&cq] { cq.Run(); }};
+  cq.Shutdown();
+  t.join();
+
+  // The function is never called, but it is released with the queue.
+  auto flag = std::make_shared<int>(0);
+  std::weak_ptr<int> weak = flag;
+  cq.RunAsync([flag] { ++*flag; });
+  flag.reset();
+  EXPECT_FALSE(weak.expired());
+  cq = CompletionQueue{};
+  impl.reset();
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(CompletionQueueTest, ShardedRotatesQueues) {
+  auto constexpr kShardCount = 3;
+  auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>(
+      /*batch_run_async=*/false, kShardCount);
+  EXPECT_EQ(kShardCount, impl->shard_count());
+  std::set<grpc::CompletionQueue*> queues;
+  for (int i = 0; i != kShardCount; ++i) queues.insert(&impl->cq());
+  EXPECT_EQ(kShardCount, queues.size());
+  EXPECT_THAT(queues, Contains(&impl->cq()));
+}
+
+TEST(CompletionQueueTest, ShardedTimersAndRunAsync) {
+  auto constexpr kShardCount = 4;
+  auto constexpr kRunners = 8;
+  auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>(
+      /*batch_run_async=*/false, kShardCount);
+  CompletionQueue cq(impl);
+  std::vector<std::thread> runners(kRunners);
+  std::generate(runners.begin(), runners.end(),
+                [&cq] { return std::thread{[&cq] { cq.Run(); }}; });
+
+  auto constexpr kIterations = 1000;
+  std::mutex mu;
+  std::condition_variable cv;
+  int timer_count = kIterations;
+  int async_count = kIterations;
+  for (int i = 0; i != kIterations; ++i) {
+    cq.MakeRelativeTimer(std::chrono::microseconds(1))
+        .then([&](future<StatusOr<std::chrono::system_clock::time_point>>) {
+          std::lock_guard<std::mutex> lk(mu);
+          if (--timer_count == 0) cv.notify_one();
+        });
+    cq.RunAsync([&] {
+      std::lock_guard<std::mutex> lk(mu);
+      if (--async_count == 0) cv.notify_one();
+    });
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return timer_count == 0 && async_count == 0; });
+  }
+  cq.Shutdown();
+  for (auto& t : runners) t.join();
+
+  EXPECT_EQ(kRunners, impl->thread_pool_hwm());
+  // Each shard leaves one of its threads for I/O.
+  EXPECT_GE(impl->run_async_pool_hwm(), 1);
+  EXPECT_LE(impl->run_async_pool_hwm(), kRunners - kShardCount);
+}
+
+TEST(CompletionQueueTest, ShardedRunAsyncOneThreadPerShard) {
+  auto constexpr kShardCount = 4;
+  auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>(
+      /*batch_run_async=*/false, kShardCount);
+  CompletionQueue cq(impl);
+  std::vector<std::thread> runners(kShardCount);
+  std::generate(runners.begin(), runners.end(),
+                [&cq] { return std::thread{[&cq] { cq.Run(); }}; });
+
+  // Each shard has a single thread, which runs the functions between I/O
+  // events. The functions still run in parallel across the shards.
+  RunAsyncBlocker blocker;
+  auto on_run_async = [&blocker] { blocker.PushBack().get(); };
+  for (int i = 0; i != kShardCount; ++i) cq.RunAsync(on_run_async);
+  for (int i = 0; i != kShardCount; ++i) blocker.PopFront().set_value();
+  EXPECT_LE(blocker.MaxSize(), kShardCount);
+
+  cq.Shutdown();
+  for (auto& t : runners) t.join();
+  EXPECT_LE(impl->run_async_pool_hwm(), kShardCount);
+}
+
 // Sets up a timer that reschedules itself and verifies we can shut down
 // cleanly whether we call `CancelAll()` on the queue first or not.
 namespace {
@@ -803,6 +979,47 @@ TEST(CompletionQueueTest, CancelTimerContinuation) {
   t.join();
 }
 
+TEST(CompletionQueueTest, CoalescedTimers) {
+  auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>();
+  CompletionQueue cq(impl);
+
+  using ms = std::chrono::milliseconds;
+  auto const start = std::chrono::system_clock::now();
+  auto f0 = cq.MakeCoalescedRelativeTimer(ms(10), ms(200));
+  auto f1 = cq.MakeCoalescedRelativeTimer(ms(10), ms(200));
+  // Both timers fall in the same tick, unless we crossed a tick boundary
+  // between the calls, which is extremely unlikely.
+  EXPECT_EQ(1, impl->load().pending_operations);
+  // Timers without coalescing always use a separate alarm.
+  auto f2 = cq.MakeCoalescedRelativeTimer(ms(10), ms(0));
+  EXPECT_EQ(2, impl->load().pending_operations);
+
+  std::thread t([&cq] { cq.Run(); });
+  auto t0 = f0.get();
+  auto t1 = f1.get();
+  ASSERT_THAT(t0, IsOk());
+  ASSERT_THAT(t1, IsOk());
+  EXPECT_EQ(*t0, *t1);
+  EXPECT_GE(*t0, start + ms(10));
+  EXPECT_THAT(f2.get(), IsOk());
+  cq.Shutdown();
+  t.join();
+}
+
+TEST(CompletionQueueTest, CoalescedTimersCancelAll) {
+  CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+
+  using ms = std::chrono::milliseconds;
+  auto f0 = cq.MakeCoalescedRelativeTimer(ms(20000), ms(1000));
+  auto f1 = cq.MakeCoalescedRelativeTimer(ms(20000), ms(1000));
+  cq.CancelAll();
+  EXPECT_THAT(f0.get(), Not(IsOk()));
+  EXPECT_THAT(f1.get(), Not(IsOk()));
+  cq.Shutdown();
+  t.join();
+}
+
 TEST(CompletionQueueTest, ImplStartOperationDuplicate) {
   auto impl = std::make_shared<internal::DefaultCompletionQueueImpl>();
   auto op = std::make_shared<MockOperation>();
@@ -141,6 +141,17 @@ class ConnectionOptions {
     return *this;
   }
 
+  /**
+   * Report the memory buffered by clients configured with this object.
+   *
+   * @see `MemoryAccountantOption`
+   */
+  ConnectionOptions& set_memory_accountant(
+      std::shared_ptr<MemoryAccountant> accountant) {
+    opts_.set<MemoryAccountantOption>(std::move(accountant));
+    return *this;
+  }
+
   /// Return the set of tracing components.
   std::set<std::string> const& components() const {
     return opts_.get<TracingComponentsOption>();
@@ -44,7 +44,9 @@ std::shared_ptr<Credentials> MakeImpersonateServiceAccountCredentials(
       Options{}
           .set<ScopesOption>({"https://www.googleapis.com/auth/cloud-platform"})
           .set<AccessTokenLifetimeOption>(
-              std::chrono::seconds(std::chrono::hours(1))));
+              std::chrono::seconds(std::chrono::hours(1)))
+          .set<AccessTokenRefreshLeadTimeOption>(
+              std::chrono::seconds(std::chrono::minutes(5))));
   return std::make_shared<internal::ImpersonateServiceAccountConfig>(
       std::move(base_credentials), std::move(target_service_account),
       std::move(opts));
@@ -198,6 +198,19 @@ struct AccessTokenLifetimeOption {
   using Type = std::chrono::seconds;
 };
 
+/**
+ * Configure how early impersonated access tokens are refreshed.
+ *
+ * Clients using `MakeImpersonateServiceAccountCredentials()` refresh the access
+ * token in the background, between this long and half this long before the
+ * token expires. The refresh time is randomized to spread the refresh requests
+ * from different processes. RPCs continue to use the current token while the
+ * refresh is in progress, so they do not wait for it. The default is 5 minutes.
+ */
+struct AccessTokenRefreshLeadTimeOption {
+  using Type = std::chrono::seconds;
+};
+
 /// A wrapper to store credentials into an options
 struct UnifiedCredentialsOption {
   using Type = std::shared_ptr<Credentials>;
@@ -0,0 +1,200 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/bulk_writer.h"
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace firestore {
+namespace {
+
+Options DefaultOptions(Options opts) {
+  if (!opts.has<BulkWriterMaxBatchSizeOption>()) {
+    opts.set<BulkWriterMaxBatchSizeOption>(20);
+  }
+  if (!opts.has<BulkWriterMaxBatchBytesOption>()) {
+    opts.set<BulkWriterMaxBatchBytesOption>(10 * 1024 * 1024);
+  }
+  if (!opts.has<BulkWriterMaxAttemptsOption>()) {
+    opts.set<BulkWriterMaxAttemptsOption>(10);
+  }
+  if (!opts.has<BulkWriterInitialBackoffOption>()) {
+    opts.set<BulkWriterInitialBackoffOption>(std::chrono::milliseconds(500));
+  }
+  if (!opts.has<BulkWriterMaximumBackoffOption>()) {
+    opts.set<BulkWriterMaximumBackoffOption>(std::chrono::seconds(60));
+  }
+  if (!opts.has<BulkWriterDocumentRateOption>()) {
+    opts.set<BulkWriterDocumentRateOption>(1.0);
+  }
+  return opts;
+}
+
+std::chrono::steady_clock::duration DocumentInterval(double rate) {
+  if (rate <= 0) return {};
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / rate));
+}
+
+bool IsTransient(Status const& status) {
+  return status.code() == StatusCode::kUnavailable ||
+         status.code() == StatusCode::kAborted ||
+         status.code() == StatusCode::kResourceExhausted;
+}
+
+}  // namespace
+
+BulkWriter::BulkWriter(BatchWriteFunction batch_write, Options opts)
+    : batch_write_(std::move(batch_write)) {
+  opts = DefaultOptions(std::move(opts));
+  max_batch_size_ =
+      (std::max)(std::size_t{1}, opts.get<BulkWriterMaxBatchSizeOption>());
+  max_batch_bytes_ = opts.get<BulkWriterMaxBatchBytesOption>();
+  max_attempts_ = opts.get<BulkWriterMaxAttemptsOption>();
+  initial_backoff_ = opts.get<BulkWriterInitialBackoffOption>();
+  maximum_backoff_ = opts.get<BulkWriterMaximumBackoffOption>();
+  document_interval_ =
+      DocumentInterval(opts.get<BulkWriterDocumentRateOption>());
+}
+
+BulkWriter::~BulkWriter() { Flush(); }
+
+future<Status> BulkWriter::Write(DocumentWrite write) {
+  if (!write.document.valid() || write.document.size() == 0) {
+    return make_ready_future(
+        Status(StatusCode::kInvalidArgument, "invalid document path"));
+  }
+  promise<Status> done;
+  auto f = done.get_future();
+  std::unique_lock<std::mutex> lk(mu_);
+  queued_bytes_ += write.data.size();
+  queue_.push_back(Pending{std::move(write), std::move(done), 0, Clock::now()});
+  auto const full =
+      queue_.size() >= max_batch_size_ || queued_bytes_ >= max_batch_bytes_;
+  // Do not block this caller if another thread is already sending a batch,
+  // this also avoids recursion when a continuation calls `Write()`.
+  if (!full || sending_) return f;
+  sending_ = true;
+  lk.unlock();
+  Clock::time_point unused;
+  SendBatch(unused);
+  lk.lock();
+  sending_ = false;
+  cv_.notify_all();
+  return f;
+}
+
+void BulkWriter::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return !sending_; });
+  sending_ = true;
+  lk.unlock();
+  for (;;) {
+    Clock::time_point next;
+    if (SendBatch(next)) continue;
+    lk.lock();
+    if (queue_.empty()) break;
+    lk.unlock();
+    std::this_thread::sleep_until(next);
+  }
+  sending_ = false;
+  cv_.notify_all();
+}
+
+bool BulkWriter::SendBatch(Clock::time_point& next) {
+  std::vector<Pending> batch;
+  std::vector<DocumentWrite> request;
+  auto const now = Clock::now();
+  next = Clock::time_point::max();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::unordered_set<FieldPath> documents;
+    std::size_t bytes = 0;
+    for (auto i = queue_.begin(); i != queue_.end();) {
+      if (batch.size() >= max_batch_size_) break;
+      auto const& key = i->write.document;
+      auto const size = i->write.data.size();
+      auto ready = i->not_before;
+      auto const l = next_write_.find(key);
+      if (l != next_write_.end()) ready = (std::max)(ready, l->second);
+      if (ready > now || documents.count(key) != 0 ||
+          (!batch.empty() && bytes + size > max_batch_bytes_)) {
+        if (ready > now) next = (std::min)(next, ready);
+        ++i;
+        continue;
+      }
+      documents.insert(key);
+      bytes += size;
+      queued_bytes_ -= size;
+      if (document_interval_ != Clock::duration::zero()) {
+        next_write_[key] = now + document_interval_;
+      }
+      batch.push_back(std::move(*i));
+      i = queue_.erase(i);
+    }
+    // Drop the rate limits that no longer apply, so the map does not grow
+    // with every document ever written.
+    for (auto i = next_write_.begin(); i != next_write_.end();) {
+      i = i->second <= now ? next_write_.erase(i) : std::next(i);
+    }
+    if (next == Clock::time_point::max()) next = now;
+  }
+  if (batch.empty()) return false;
+
+  request.reserve(batch.size());
+  for (auto const& p : batch) request.push_back(p.write);
+  auto results = batch_write_(request);
+
+  std::vector<std::pair<promise<Status>, Status>> completed;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const retry_start = Clock::now();
+    for (std::size_t i = 0; i != batch.size(); ++i) {
+      auto& p = batch[i];
+      auto status = i < results.size()
+                        ? std::move(results[i])
+                        : Status(StatusCode::kUnknown,
+                                 "missing status in BatchWrite response");
+      ++p.attempts;
+      if (!status.ok() && IsTransient(status) && p.attempts < max_attempts_) {
+        p.not_before = retry_start + Backoff(p.attempts);
+        queued_bytes_ += p.write.data.size();
+        queue_.push_back(std::move(p));
+        continue;
+      }
+      completed.emplace_back(std::move(p.done), std::move(status));
+    }
+  }
+  // Satisfy the futures without holding any locks, their continuations may
+  // call `Write()`.
+  for (auto& c : completed) c.first.set_value(std::move(c.second));
+  return true;
+}
+
+std::chrono::milliseconds BulkWriter::Backoff(int attempts) const {
+  auto backoff = initial_backoff_;
+  for (int i = 1; i < attempts && backoff < maximum_backoff_; ++i) {
+    backoff *= 2;
+  }
+  return (std::min)(backoff, maximum_backoff_);
+}
+
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
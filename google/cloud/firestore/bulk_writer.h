@@ -0,0 +1,174 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_BULK_WRITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_BULK_WRITER_H
+
+#include "google/cloud/firestore/field_path.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace firestore {
+
+/// The maximum number of documents in each `BatchWrite` request.
+struct BulkWriterMaxBatchSizeOption {
+  using Type = std::size_t;
+};
+
+/// The maximum size, in bytes, of the writes in each `BatchWrite` request.
+struct BulkWriterMaxBatchBytesOption {
+  using Type = std::size_t;
+};
+
+/// The maximum number of attempts to write each document.
+struct BulkWriterMaxAttemptsOption {
+  using Type = int;
+};
+
+/// The backoff after the first failed attempt to write a document.
+struct BulkWriterInitialBackoffOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/// The maximum backoff between attempts to write a document.
+struct BulkWriterMaximumBackoffOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * The maximum rate of writes to each document, in writes per second.
+ *
+ * Firestore limits the sustained write rate to a single document, the
+ * `BulkWriter` spreads repeated writes to the same document over several
+ * batches. Zero disables this limit.
+ */
+struct BulkWriterDocumentRateOption {
+  using Type = double;
+};
+
+/**
+ * A write to a single document.
+ *
+ * The `BulkWriter` does not interpret @p data, it only uses its size to limit
+ * the size of each batch. Typically this is a serialized
+ * `google.firestore.v1.Write` proto.
+ */
+struct DocumentWrite {
+  /// The path to the document, e.g. `FieldPath({"users", "alice"})`.
+  FieldPath document;
+  std::string data;
+};
+
+/**
+ * Sends a batch of writes to the service.
+ *
+ * Returns the status of each write, in the same order as the request. Like
+ * the `BatchWrite` RPC, the writes are not applied atomically, each write may
+ * succeed or fail independently.
+ */
+using BatchWriteFunction =
+    std::function<std::vector<Status>(std::vector<DocumentWrite> const&)>;
+
+/**
+ * Batches many independent document writes into `BatchWrite` requests.
+ *
+ * Writes are grouped into batches limited by the number of documents and their
+ * total size. A batch is sent as soon as enough writes are pending to fill
+ * it, and `Flush()` sends any remaining writes.
+ *
+ * Failed writes are retried individually, with exponential backoff, if the
+ * error is transient (`kUnavailable`, `kAborted`, or `kResourceExhausted`).
+ * Writes to the same document are never sent in the same batch, and are rate
+ * limited with `BulkWriterDocumentRateOption`.
+ *
+ * @par Thread-safety
+ * Instances of this class are thread-safe, the batches are sent by the
+ * threads calling `Write()` and `Flush()`, one batch at a time.
+ */
+class BulkWriter {
+ public:
+  explicit BulkWriter(BatchWriteFunction batch_write, Options opts = {});
+
+  /// Flushes any pending writes.
+  ~BulkWriter();
+
+  BulkWriter(BulkWriter const&) = delete;
+  BulkWriter& operator=(BulkWriter const&) = delete;
+
+  /**
+   * Queues a write, the returned future is satisfied once the write succeeds
+   * or fails permanently.
+   *
+   * An invalid document path fails immediately with `kInvalidArgument`.
+   */
+  future<Status> Write(DocumentWrite write);
+
+  /**
+   * Sends all pending writes, including retries, and waits until they finish.
+   *
+   * Do not call this function from a continuation attached to the futures
+   * returned by `Write()`, it would deadlock.
+   */
+  void Flush();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Pending {
+    DocumentWrite write;
+    promise<Status> done;
+    int attempts;
+    Clock::time_point not_before;
+  };
+
+  // Sends at most one batch, returns false if there was nothing to send, and
+  // sets @p next to the time when the next pending write becomes ready.
+  bool SendBatch(Clock::time_point& next);
+
+  std::chrono::milliseconds Backoff(int attempts) const;
+
+  BatchWriteFunction batch_write_;
+  std::size_t max_batch_size_;
+  std::size_t max_batch_bytes_;
+  int max_attempts_;
+  std::chrono::milliseconds initial_backoff_;
+  std::chrono::milliseconds maximum_backoff_;
+  Clock::duration document_interval_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  // Only one thread calls `batch_write_` at a time.
+  bool sending_ = false;
+  std::list<Pending> queue_;
+  std::size_t queued_bytes_ = 0;
+  std::unordered_map<FieldPath, Clock::time_point> next_write_;
+};
+
+}  // namespace firestore
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_BULK_WRITER_H
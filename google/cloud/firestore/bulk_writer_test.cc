@@ -0,0 +1,198 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/firestore/bulk_writer.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace firestore = google::cloud::firestore;
+using ::google::cloud::Options;
+using ::google::cloud::Status;
+using ::google::cloud::StatusCode;
+using ::testing::ElementsAre;
+
+namespace {
+
+firestore::DocumentWrite MakeWrite(std::string const& id,
+                                   std::string data = "data") {
+  return firestore::DocumentWrite{firestore::FieldPath({"users", id}),
+                                  std::move(data)};
+}
+
+Options TestOptions() {
+  return Options{}
+      .set<firestore::BulkWriterInitialBackoffOption>(
+          std::chrono::milliseconds(1))
+      .set<firestore::BulkWriterMaximumBackoffOption>(
+          std::chrono::milliseconds(4))
+      .set<firestore::BulkWriterDocumentRateOption>(0);
+}
+
+}  // namespace
+
+TEST(BulkWriter, BatchesByCount) {
+  std::vector<std::size_t> sizes;
+  firestore::BulkWriter writer(
+      [&sizes](std::vector<firestore::DocumentWrite> const& r) {
+        sizes.push_back(r.size());
+        return std::vector<Status>(r.size());
+      },
+      TestOptions().set<firestore::BulkWriterMaxBatchSizeOption>(2));
+  std::vector<google::cloud::future<Status>> results;
+  for (auto const* id : {"a", "b", "c", "d", "e"}) {
+    results.push_back(writer.Write(MakeWrite(id)));
+  }
+  // Full batches are sent without waiting for `Flush()`.
+  EXPECT_THAT(sizes, ElementsAre(2, 2));
+  writer.Flush();
+  EXPECT_THAT(sizes, ElementsAre(2, 2, 1));
+  for (auto& r : results) EXPECT_TRUE(r.get().ok());
+}
+
+TEST(BulkWriter, BatchesByBytes) {
+  std::vector<std::size_t> sizes;
+  firestore::BulkWriter writer(
+      [&sizes](std::vector<firestore::DocumentWrite> const& r) {
+        sizes.push_back(r.size());
+        return std::vector<Status>(r.size());
+      },
+      TestOptions().set<firestore::BulkWriterMaxBatchBytesOption>(10));
+  auto a = writer.Write(MakeWrite("a", std::string(4, 'x')));
+  auto b = writer.Write(MakeWrite("b", std::string(4, 'x')));
+  auto c = writer.Write(MakeWrite("c", std::string(4, 'x')));
+  writer.Flush();
+  EXPECT_THAT(sizes, ElementsAre(2, 1));
+  EXPECT_TRUE(a.get().ok());
+  EXPECT_TRUE(b.get().ok());
+  EXPECT_TRUE(c.get().ok());
+}
+
+TEST(BulkWriter, RetriesTransientFailures) {
+  int calls = 0;
+  firestore::BulkWriter writer(
+      [&calls](std::vector<firestore::DocumentWrite> const& r) {
+        std::vector<Status> result(r.size());
+        // Fail "b" the first two times it is sent.
+        for (std::size_t i = 0; i != r.size(); ++i) {
+          if (r[i].document.ToApiRepr() == "users.b" && calls < 2) {
+            result[i] = Status(StatusCode::kUnavailable, "try-again");
+          }
+        }
+        ++calls;
+        return result;
+      },
+      TestOptions());
+  auto a = writer.Write(MakeWrite("a"));
+  auto b = writer.Write(MakeWrite("b"));
+  writer.Flush();
+  EXPECT_EQ(3, calls);
+  EXPECT_TRUE(a.get().ok());
+  EXPECT_TRUE(b.get().ok());
+}
+
+TEST(BulkWriter, TooManyTransientFailures) {
+  int calls = 0;
+  firestore::BulkWriter writer(
+      [&calls](std::vector<firestore::DocumentWrite> const& r) {
+        ++calls;
+        return std::vector<Status>(
+            r.size(), Status(StatusCode::kUnavailable, "try-again"));
+      },
+      TestOptions().set<firestore::BulkWriterMaxAttemptsOption>(3));
+  auto a = writer.Write(MakeWrite("a"));
+  writer.Flush();
+  EXPECT_EQ(3, calls);
+  EXPECT_EQ(StatusCode::kUnavailable, a.get().code());
+}
+
+TEST(BulkWriter, PermanentFailure) {
+  int calls = 0;
+  firestore::BulkWriter writer(
+      [&calls](std::vector<firestore::DocumentWrite> const& r) {
+        ++calls;
+        return std::vector<Status>(
+            r.size(), Status(StatusCode::kPermissionDenied, "uh-oh"));
+      },
+      TestOptions());
+  auto a = writer.Write(MakeWrite("a"));
+  writer.Flush();
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(StatusCode::kPermissionDenied, a.get().code());
+}
+
+TEST(BulkWriter, MissingResults) {
+  firestore::BulkWriter writer(
+      [](std::vector<firestore::DocumentWrite> const&) {
+        return std::vector<Status>{};
+      },
+      TestOptions());
+  auto a = writer.Write(MakeWrite("a"));
+  writer.Flush();
+  EXPECT_EQ(StatusCode::kUnknown, a.get().code());
+}
+
+TEST(BulkWriter, SameDocumentInSeparateBatches) {
+  std::vector<std::vector<std::string>> batches;
+  firestore::BulkWriter writer(
+      [&batches](std::vector<firestore::DocumentWrite> const& r) {
+        std::vector<std::string> data;
+        for (auto const& w : r) data.push_back(w.data);
+        batches.push_back(std::move(data));
+        return std::vector<Status>(r.size());
+      },
+      TestOptions().set<firestore::BulkWriterDocumentRateOption>(1000.0));
+  auto a1 = writer.Write(MakeWrite("a", "1"));
+  auto a2 = writer.Write(MakeWrite("a", "2"));
+  auto b = writer.Write(MakeWrite("b", "3"));
+  writer.Flush();
+  // The writes to each document are sent in order.
+  ASSERT_EQ(2, batches.size());
+  EXPECT_THAT(batches[0], ElementsAre("1", "3"));
+  EXPECT_THAT(batches[1], ElementsAre("2"));
+  EXPECT_TRUE(a1.get().ok());
+  EXPECT_TRUE(a2.get().ok());
+  EXPECT_TRUE(b.get().ok());
+}
+
+TEST(BulkWriter, InvalidDocument) {
+  int calls = 0;
+  firestore::BulkWriter writer(
+      [&calls](std::vector<firestore::DocumentWrite> const& r) {
+        ++calls;
+        return std::vector<Status>(r.size());
+      },
+      TestOptions());
+  auto a = writer.Write(firestore::DocumentWrite{
+      firestore::FieldPath::InvalidFieldPath(), "data"});
+  EXPECT_EQ(StatusCode::kInvalidArgument, a.get().code());
+  writer.Flush();
+  EXPECT_EQ(0, calls);
+}
+
+TEST(BulkWriter, DestructorFlushes) {
+  int calls = 0;
+  google::cloud::future<Status> a;
+  {
+    firestore::BulkWriter writer(
+        [&calls](std::vector<firestore::DocumentWrite> const& r) {
+          ++calls;
+          return std::vector<Status>(r.size());
+        },
+        TestOptions());
+    a = writer.Write(MakeWrite("a"));
+  }
+  EXPECT_EQ(1, calls);
+  EXPECT_TRUE(a.get().ok());
+}
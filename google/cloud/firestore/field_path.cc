@@ -14,7 +14,7 @@
 
 #include "google/cloud/firestore/field_path.h"
 #include <algorithm>
-#include <cctype>
+#include <iterator>
 
 namespace google {
 namespace cloud {
@@ -31,61 +31,93 @@ FieldPath FieldPath::InvalidFieldPath() {
   return FieldPath(parts);
 }
 
-FieldPath FieldPath::FromString(std::string const& string) {
-  if (InvalidCharacters(string)) {
-    return FieldPath::InvalidFieldPath();
+FieldPath FieldPath::FromString(absl::string_view string) {
+  // Validate and split the string in a single pass.
+  std::vector<std::string> parts;
+  auto start = string.begin();
+  for (auto i = string.begin(); i != string.end(); ++i) {
+    switch (*i) {
+      case '~':
+      case '*':
+      case '/':
+      case '[':
+      case ']':
+        return FieldPath::InvalidFieldPath();
+      case '.':
+        parts.emplace_back(start, i);
+        start = std::next(i);
+        break;
+      default:
+        break;
+    }
   }
-  return FieldPath(Split(string));
+  parts.emplace_back(start, string.end());
+  return FieldPath(std::move(parts));
 }
 
-FieldPath FieldPath::Append(std::string const& string) const {
-  std::vector<std::string> parts(this->parts_);
-  auto const field_path = FieldPath::FromString(string);
-  return this->Append(field_path);
+FieldPath FieldPath::Append(absl::string_view string) const {
+  return this->Append(FieldPath::FromString(string));
 }
 
 FieldPath FieldPath::Append(FieldPath const& field_path) const {
   if (valid_ && field_path.valid_) {
-    std::vector<std::string> parts(this->parts_);
-    for (auto const& part : field_path.parts_) {
-      parts.push_back(part);
-    }
-    return FieldPath(parts);
+    std::vector<std::string> parts;
+    parts.reserve(parts_.size() + field_path.parts_.size());
+    parts.insert(parts.end(), parts_.begin(), parts_.end());
+    parts.insert(parts.end(), field_path.parts_.begin(),
+                 field_path.parts_.end());
+    return FieldPath(std::move(parts));
   }
   return FieldPath::InvalidFieldPath();
 }
 
 std::string FieldPath::ToApiRepr() const {
-  // gcc-4.8 ships with a broken regex library (sigh), so don't use it.
-  auto is_simple_field_name = [](std::string const& part) {
-    if (part.empty()) {
-      return false;
-    }
-    if (part[0] != '_' && std::isalpha(part[0]) == 0) {
-      return false;
-    }
-    return std::all_of(part.begin(), part.end(),
-                       [](char c) { return c == '_' || std::isalnum(c) != 0; });
+  // gcc-4.8 ships with a broken regex library (sigh), so don't use it. The
+  // checks are ASCII-only, any other character requires quoting.
+  auto is_alpha = [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+  };
+  auto is_simple_field_name = [&is_alpha](std::string const& part) {
+    if (part.empty() || !is_alpha(part[0])) return false;
+    return std::all_of(part.begin(), part.end(), [&is_alpha](char c) {
+      return is_alpha(c) || (c >= '0' && c <= '9');
+    });
   };
   std::string s;
   if (valid_) {
-    for (auto part : parts_) {
-      auto const match = is_simple_field_name(part);
-      if (match) {
-        s += part + '.';
-      } else {
-        ReplaceAll(part, "\\", "\\\\");
-        ReplaceAll(part, "`", "\\`");
-        s += '`' + part + "`.";
+    for (auto const& part : parts_) {
+      if (!s.empty()) s += '.';  // the first part cannot be empty
+      if (is_simple_field_name(part)) {
+        s += part;
+        continue;
+      }
+      s += '`';
+      for (auto c : part) {
+        if (c == '\\' || c == '`') s += '\\';
+        s += c;
       }
+      s += '`';
     }
-    s.resize(s.size() - 1);  // cannot be empty and remove final period
   }
   return s;  // let the server catch the empty string error for invalid
 }
 
+std::size_t FieldPath::hash() const {
+  // All the invalid paths are equal, so they must have the same hash.
+  if (!valid_) return 0;
+  std::hash<std::string> hasher;
+  auto h = parts_.size();
+  for (auto const& part : parts_) {
+    h ^= hasher(part) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  }
+  return h;
+}
+
 bool operator==(FieldPath const& lhs, FieldPath const& rhs) {
-  return lhs.ToApiRepr() == rhs.ToApiRepr();
+  // Compare the components, which is equivalent to comparing `ToApiRepr()`
+  // without building the strings. `ToApiRepr()` is empty for all invalid paths.
+  if (!lhs.valid_ || !rhs.valid_) return lhs.valid_ == rhs.valid_;
+  return lhs.parts_ == rhs.parts_;
 }
 
 bool operator<(FieldPath const& lhs, FieldPath const& rhs) {
@@ -114,32 +146,6 @@ std::ostream& operator<<(std::ostream& os, FieldPath const& field_path) {
   return os;
 }
 
-bool FieldPath::InvalidCharacters(std::string const& string) {
-  return string.find_first_of("~*/[]") != std::string::npos;
-}
-
-std::vector<std::string> FieldPath::Split(std::string string) {
-  std::vector<std::string> parts;
-  auto index = string.find('.');
-  while (index != std::string::npos) {
-    parts.push_back(string.substr(0, index));
-    string = string.substr(index + 1);
-    index = string.find('.');
-  }
-  parts.push_back(string);
-  return parts;
-}
-
-void FieldPath::ReplaceAll(std::string& string, std::string const& find,
-                           std::string const& replace) {
-  auto found = string.find(find);
-  while (found != std::string::npos) {
-    string = string.replace(found, find.size(), replace);
-    found += replace.size();
-    found = string.find(find, found);
-  }
-}
-
 }  // namespace firestore
 }  // namespace cloud
 }  // namespace google
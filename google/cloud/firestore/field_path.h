@@ -15,6 +15,9 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIELD_PATH_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIELD_PATH_H
 
+#include "absl/strings/string_view.h"
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <regex>
 #include <string>
@@ -48,11 +51,14 @@ class FieldPath {
   /**
    * Construct FieldPath from a field path string @p string.
    *
+   * The string is validated and split in a single pass, copying each
+   * component only once.
+   *
    * @param string A const field path string for creating a FieldPath.
    * @return Either an invalid field path if a valid string cannot be created
    *     or a field path created from the field path string.
    */
-  static FieldPath FromString(std::string const& string);
+  static FieldPath FromString(absl::string_view string);
 
   /**
    * Construct a new FieldPath by appending a field path string @p string.
@@ -61,7 +67,7 @@ class FieldPath {
    * @return A new field path created from appending the field path string.
    */
 
-  FieldPath Append(std::string const& string) const;
+  FieldPath Append(absl::string_view string) const;
 
   /**
    * Construct a new FieldPath by appending a FieldPath @p field_path.
@@ -89,6 +95,14 @@ class FieldPath {
    */
   bool valid() const { return valid_; }
 
+  /**
+   * Returns a hash of this FieldPath, consistent with `operator==`.
+   *
+   * Computing the hash does not allocate, so FieldPaths are cheap keys for
+   * `std::unordered_map` and `std::unordered_set`.
+   */
+  std::size_t hash() const;
+
  private:
   /**
    * The representation of this FieldPath @p field_path for ostream @p os.
@@ -100,35 +114,10 @@ class FieldPath {
   friend std::ostream& operator<<(std::ostream& os,
                                   const FieldPath& field_path);
 
-  // This is a friend because it accesses parts_ directly.
+  // These are friends because they access parts_ directly.
+  friend bool operator==(FieldPath const& lhs, FieldPath const& rhs);
   friend bool operator<(FieldPath const& lhs, FieldPath const& rhs);
 
-  /**
-   * Ensures @p string has no invalid characters.
-   *
-   * @param string A const string to write to.
-   * @return Whether the string contains invalid characters or not.
-   */
-  static bool InvalidCharacters(std::string const& string);
-
-  /**
-   * Splits @p string via field path delimiter '.'.
-   *
-   * @param string A const string to write to.
-   * @return The vector of string after splitting via delimiter
-   */
-  static std::vector<std::string> Split(std::string string);
-
-  /**
-   * Replace all occurrences of @p find in @p string with @p replace.
-   *
-   * @param string A string to search and replace
-   * @param find A const String to find and replace with @p replace
-   * @param replace A const String to replace @p find with.
-   */
-  static void ReplaceAll(std::string& string, std::string const& find,
-                         std::string const& replace);
-
   /**
    * The components of this FieldPath.
    */
@@ -163,4 +152,15 @@ inline bool operator>=(FieldPath const& lhs, FieldPath const& rhs) {
 }  // namespace cloud
 }  // namespace google
 
+namespace std {
+/// Hash FieldPaths with `FieldPath::hash()`.
+template <>
+struct hash<google::cloud::firestore::FieldPath> {
+  std::size_t operator()(
+      google::cloud::firestore::FieldPath const& field_path) const {
+    return field_path.hash();
+  }
+};
+}  // namespace std
+
 #endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FIRESTORE_FIELD_PATH_H
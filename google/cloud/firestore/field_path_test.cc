@@ -14,6 +14,7 @@
 
 #include "google/cloud/firestore/field_path.h"
 #include <gtest/gtest.h>
+#include <unordered_map>
 
 namespace firestore = google::cloud::firestore;
 
@@ -209,3 +210,29 @@ TEST(FieldPath, Size) {
   ASSERT_TRUE(field_path.valid());
   EXPECT_EQ(3, field_path.size());
 }
+
+TEST(FieldPath, EqualMatchesApiRepr) {
+  auto const a = firestore::FieldPath::FromString("a.`b`");
+  auto const b = firestore::FieldPath({"a", "`b`"});
+  auto const c = firestore::FieldPath({"a.`b`"});
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(firestore::FieldPath::InvalidFieldPath(),
+            firestore::FieldPath::FromString("a..b"));
+  EXPECT_NE(firestore::FieldPath::InvalidFieldPath(), a);
+}
+
+TEST(FieldPath, Hash) {
+  std::hash<firestore::FieldPath> hasher;
+  auto const a = firestore::FieldPath::FromString("a.b.c");
+  EXPECT_EQ(hasher(a), hasher(firestore::FieldPath({"a", "b", "c"})));
+  EXPECT_EQ(hasher(firestore::FieldPath::InvalidFieldPath()),
+            hasher(firestore::FieldPath::FromString("a/b")));
+
+  std::unordered_map<firestore::FieldPath, int> map;
+  map[a] = 1;
+  map[firestore::FieldPath::FromString("a.b")] = 2;
+  map[firestore::FieldPath({"a", "b", "c"})] += 2;
+  EXPECT_EQ(2, map.size());
+  EXPECT_EQ(3, map[a]);
+}
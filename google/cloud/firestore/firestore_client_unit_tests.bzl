@@ -17,5 +17,6 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 firestore_client_unit_tests = [
+    "bulk_writer_test.cc",
     "field_path_test.cc",
 ]
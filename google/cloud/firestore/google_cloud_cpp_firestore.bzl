@@ -17,9 +17,11 @@
 """Automatically generated source lists for google_cloud_cpp_firestore - DO NOT EDIT."""
 
 google_cloud_cpp_firestore_hdrs = [
+    "bulk_writer.h",
     "field_path.h",
 ]
 
 google_cloud_cpp_firestore_srcs = [
+    "bulk_writer.cc",
     "field_path.cc",
 ]
@@ -0,0 +1,137 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/expect_future_error.h"
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+future<int> AddOne(future<int> f) { co_return co_await std::move(f) + 1; }
+
+future<void> Touch(future<void> f, int& counter) {
+  co_await std::move(f);
+  ++counter;
+}
+
+TEST(FutureCoroutinesTest, AwaitReady) {
+  auto r = AddOne(make_ready_future(41));
+  ASSERT_TRUE(r.is_ready());
+  EXPECT_EQ(42, r.get());
+}
+
+TEST(FutureCoroutinesTest, AwaitPending) {
+  promise<int> p;
+  auto r = AddOne(p.get_future());
+  EXPECT_FALSE(r.is_ready());
+  p.set_value(41);
+  ASSERT_TRUE(r.is_ready());
+  EXPECT_EQ(42, r.get());
+}
+
+TEST(FutureCoroutinesTest, AwaitVoid) {
+  promise<void> p;
+  int counter = 0;
+  auto r = Touch(p.get_future(), counter);
+  EXPECT_EQ(0, counter);
+  p.set_value();
+  ASSERT_TRUE(r.is_ready());
+  r.get();
+  EXPECT_EQ(1, counter);
+}
+
+TEST(FutureCoroutinesTest, AwaitChain) {
+  promise<int> p;
+  auto r = AddOne(AddOne(AddOne(p.get_future())));
+  p.set_value(0);
+  EXPECT_EQ(3, r.get());
+}
+
+TEST(FutureCoroutinesTest, ResumesInSatisfyingThread) {
+  promise<int> p;
+  std::thread::id resumed;
+  auto coro = [&resumed](future<int> f) -> future<int> {
+    auto v = co_await std::move(f);
+    resumed = std::this_thread::get_id();
+    co_return v;
+  };
+  auto r = coro(p.get_future());
+  std::thread::id setter;
+  std::thread t([&p, &setter] {
+    setter = std::this_thread::get_id();
+    p.set_value(7);
+  });
+  t.join();
+  EXPECT_EQ(7, r.get());
+  EXPECT_EQ(setter, resumed);
+}
+
+TEST(FutureCoroutinesTest, RaceWithSatisfy) {
+  for (int i = 0; i != 1000; ++i) {
+    promise<int> p;
+    std::thread t([&p, i] { p.set_value(i); });
+    auto r = AddOne(p.get_future());
+    t.join();
+    EXPECT_EQ(i + 1, r.get());
+  }
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(FutureCoroutinesTest, PropagatesException) {
+  promise<int> p;
+  auto r = AddOne(p.get_future());
+  p.set_exception(std::make_exception_ptr(std::runtime_error("uh-oh")));
+  EXPECT_THROW(r.get(), std::runtime_error);
+}
+
+TEST(FutureCoroutinesTest, UnhandledException) {
+  auto coro = []() -> future<std::string> {
+    throw std::runtime_error("uh-oh");
+    co_return std::string("unused");
+  };
+  auto r = coro();
+  ASSERT_TRUE(r.is_ready());
+  EXPECT_THROW(r.get(), std::runtime_error);
+}
+
+TEST(FutureCoroutinesTest, InvalidFuture) {
+  auto coro = [](future<int> f) -> future<int> {
+    co_return co_await std::move(f);
+  };
+  future<int> f;
+  auto r = coro(std::move(f));
+  testing_util::ExpectFutureError([&] { r.get(); }, std::future_errc::no_state);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+#else
+
+TEST(FutureCoroutinesTest, NotSupported) {
+  GTEST_SKIP() << "C++20 coroutines are not available";
+}
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,94 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+// Measure the cost to create a promise/future pair and use it once.
+void BM_FutureGenericSetGet(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<int> p;
+    auto f = p.get_future();
+    p.set_value(42);
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureGenericSetGet);
+
+// Measure the cost of `make_ready_future()`.
+void BM_FutureGenericMakeReady(benchmark::State& state) {
+  for (auto _ : state) {
+    auto f = make_ready_future(std::string("value"));
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureGenericMakeReady);
+
+// Measure the cost of attaching a continuation to an already satisfied future.
+void BM_FutureGenericThenReady(benchmark::State& state) {
+  for (auto _ : state) {
+    auto f = make_ready_future(42).then(
+        [](future<int> g) { return g.get() + 1; });
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureGenericThenReady);
+
+// Measure the cost of a chain of continuations, similar to what the retry
+// loops create.
+void BM_FutureGenericThenChain(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<StatusOr<int>> p;
+    auto f = p.get_future();
+    for (std::int64_t i = 0; i != state.range(0); ++i) {
+      f = f.then([](future<StatusOr<int>> g) {
+        auto v = g.get();
+        if (!v) return v;
+        return StatusOr<int>(*v + 1);
+      });
+    }
+    p.set_value(0);
+    benchmark::DoNotOptimize(f.get());
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FutureGenericThenChain)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Complexity(benchmark::oN);
+
+// Measure the cost of a continuation returning a future, which must be
+// unwrapped.
+void BM_FutureGenericThenUnwrap(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<int> p;
+    auto f = p.get_future().then(
+        [](future<int> g) { return make_ready_future(g.get() + 1); });
+    p.set_value(0);
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureGenericThenUnwrap);
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -122,6 +122,8 @@ class future<void> final : private internal::future_base<void> {
 
   template <typename U>
   friend class future;
+  template <typename U>
+  friend class internal::FutureAwaiter;
 };
 
 /**
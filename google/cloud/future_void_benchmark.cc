@@ -0,0 +1,78 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/future.h"
+#include <benchmark/benchmark.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+// Measure the cost to create a promise/future pair and use it once.
+void BM_FutureVoidSetGet(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<void> p;
+    auto f = p.get_future();
+    p.set_value();
+    f.get();
+  }
+}
+BENCHMARK(BM_FutureVoidSetGet);
+
+// Measure the cost of attaching a continuation to an already satisfied future.
+void BM_FutureVoidThenReady(benchmark::State& state) {
+  for (auto _ : state) {
+    auto f = make_ready_future().then([](future<void> g) { g.get(); });
+    f.get();
+  }
+}
+BENCHMARK(BM_FutureVoidThenReady);
+
+// Measure the cost of a chain of continuations.
+void BM_FutureVoidThenChain(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<void> p;
+    auto f = p.get_future();
+    for (std::int64_t i = 0; i != state.range(0); ++i) {
+      f = f.then([](future<void> g) { g.get(); });
+    }
+    p.set_value();
+    f.get();
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FutureVoidThenChain)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Complexity(benchmark::oN);
+
+// Measure the cost of blocking in `.get()` until another thread satisfies the
+// future.
+void BM_FutureVoidBlockingGet(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<void> p;
+    auto f = p.get_future();
+    std::thread t([&p] { p.set_value(); });
+    f.get();
+    t.join();
+  }
+}
+BENCHMARK(BM_FutureVoidBlockingGet);
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -36,6 +36,7 @@ google_cloud_cpp_common_hdrs = [
     "internal/backoff_policy.h",
     "internal/base64_transforms.h",
     "internal/big_endian.h",
+    "internal/bounded_queue.h",
     "internal/build_info.h",
     "internal/compiler_info.h",
     "internal/credentials_impl.h",
@@ -43,9 +44,11 @@ google_cloud_cpp_common_hdrs = [
     "internal/diagnostics_push.inc",
     "internal/disable_deprecation_warnings.inc",
     "internal/disable_msvc_crt_secure_warnings.inc",
+    "internal/expiring_cache.h",
     "internal/filesystem.h",
     "internal/format_time_point.h",
     "internal/future_base.h",
+    "internal/future_coroutines.h",
     "internal/future_fwd.h",
     "internal/future_impl.h",
     "internal/future_then_impl.h",
@@ -54,13 +57,16 @@ google_cloud_cpp_common_hdrs = [
     "internal/invoke_result.h",
     "internal/ios_flags_saver.h",
     "internal/log_impl.h",
+    "internal/outstanding_request_picker.h",
     "internal/pagination_range.h",
     "internal/parse_rfc3339.h",
     "internal/port_platform.h",
     "internal/random.h",
     "internal/retry_policy.h",
     "internal/setenv.h",
+    "internal/small_object_pool.h",
     "internal/strerror.h",
+    "internal/thread_affinity.h",
     "internal/throw_delegate.h",
     "internal/tuple.h",
     "internal/type_list.h",
@@ -69,9 +75,13 @@ google_cloud_cpp_common_hdrs = [
     "internal/version_info.h",
     "kms_key_name.h",
     "log.h",
+    "memory_accountant.h",
     "optional.h",
     "options.h",
     "polling_policy.h",
+    "retry_budget.h",
+    "rpc_metrics.h",
+    "rpc_tracing.h",
     "status.h",
     "status_or.h",
     "stream_range.h",
@@ -94,15 +104,22 @@ google_cloud_cpp_common_srcs = [
     "internal/future_impl.cc",
     "internal/getenv.cc",
     "internal/log_impl.cc",
+    "internal/outstanding_request_picker.cc",
     "internal/parse_rfc3339.cc",
     "internal/random.cc",
     "internal/setenv.cc",
+    "internal/small_object_pool.cc",
     "internal/strerror.cc",
+    "internal/thread_affinity.cc",
     "internal/throw_delegate.cc",
     "internal/user_agent_prefix.cc",
     "kms_key_name.cc",
     "log.cc",
+    "memory_accountant.cc",
     "options.cc",
+    "retry_budget.cc",
+    "rpc_metrics.cc",
+    "rpc_tracing.cc",
     "status.cc",
     "terminate_handler.cc",
     "tracing_options.cc",
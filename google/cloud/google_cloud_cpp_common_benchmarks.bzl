@@ -17,4 +17,10 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 google_cloud_cpp_common_benchmarks = [
+    "future_generic_benchmark.cc",
+    "future_void_benchmark.cc",
+    "internal/base64_transforms_benchmark.cc",
+    "internal/parse_rfc3339_benchmark.cc",
+    "options_benchmark.cc",
+    "status_or_benchmark.cc",
 ]
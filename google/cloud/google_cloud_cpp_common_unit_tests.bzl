@@ -18,6 +18,7 @@
 
 google_cloud_cpp_common_unit_tests = [
     "common_options_test.cc",
+    "future_coroutines_test.cc",
     "future_generic_test.cc",
     "future_generic_then_test.cc",
     "future_void_test.cc",
@@ -28,19 +29,24 @@ google_cloud_cpp_common_unit_tests = [
     "internal/backoff_policy_test.cc",
     "internal/base64_transforms_test.cc",
     "internal/big_endian_test.cc",
+    "internal/bounded_queue_test.cc",
     "internal/compiler_info_test.cc",
     "internal/credentials_impl_test.cc",
     "internal/env_test.cc",
+    "internal/expiring_cache_test.cc",
     "internal/filesystem_test.cc",
     "internal/format_time_point_test.cc",
     "internal/future_impl_test.cc",
     "internal/invoke_result_test.cc",
     "internal/log_impl_test.cc",
+    "internal/outstanding_request_picker_test.cc",
     "internal/pagination_range_test.cc",
     "internal/parse_rfc3339_test.cc",
     "internal/random_test.cc",
     "internal/retry_policy_test.cc",
+    "internal/small_object_pool_test.cc",
     "internal/strerror_test.cc",
+    "internal/thread_affinity_test.cc",
     "internal/throw_delegate_test.cc",
     "internal/tuple_test.cc",
     "internal/type_list_test.cc",
@@ -48,7 +54,11 @@ google_cloud_cpp_common_unit_tests = [
     "internal/utility_test.cc",
     "kms_key_name_test.cc",
     "log_test.cc",
+    "memory_accountant_test.cc",
     "options_test.cc",
+    "retry_budget_test.cc",
+    "rpc_metrics_test.cc",
+    "rpc_tracing_test.cc",
     "status_or_test.cc",
     "status_test.cc",
     "stream_range_test.cc",
@@ -21,30 +21,42 @@ google_cloud_cpp_grpc_utils_hdrs = [
     "background_threads.h",
     "completion_queue.h",
     "connection_options.h",
+    "grpc_channel_registry.h",
     "grpc_error_delegate.h",
     "grpc_options.h",
     "grpc_utils/async_operation.h",
     "grpc_utils/completion_queue.h",
     "grpc_utils/grpc_error_delegate.h",
     "grpc_utils/version.h",
+    "iam_policy_delta.h",
+    "internal/arena_allocated.h",
     "internal/async_connection_ready.h",
     "internal/async_long_running_operation.h",
     "internal/async_polling_loop.h",
     "internal/async_read_stream_impl.h",
     "internal/async_read_write_stream_impl.h",
+    "internal/async_resumable_streaming_read.h",
     "internal/async_retry_loop.h",
     "internal/async_retry_unary_rpc.h",
     "internal/async_rpc_details.h",
+    "internal/async_streaming_read_rpc.h",
     "internal/background_threads_impl.h",
+    "internal/channel_picker.h",
     "internal/completion_queue_impl.h",
     "internal/default_completion_queue_impl.h",
     "internal/extract_long_running_result.h",
     "internal/grpc_access_token_authentication.h",
     "internal/grpc_async_access_token_cache.h",
     "internal/grpc_channel_credentials_authentication.h",
+    "internal/grpc_compression.h",
     "internal/grpc_impersonate_service_account.h",
+    "internal/grpc_impersonation_manager.h",
     "internal/grpc_service_account_authentication.h",
+    "internal/grpc_trace_context.h",
+    "internal/hedged_call.h",
+    "internal/iam_read_modify_write.h",
     "internal/log_wrapper.h",
+    "internal/metrics_wrapper.h",
     "internal/minimal_iam_credentials_stub.h",
     "internal/polling_loop.h",
     "internal/resumable_streaming_read_rpc.h",
@@ -61,18 +73,24 @@ google_cloud_cpp_grpc_utils_hdrs = [
 google_cloud_cpp_grpc_utils_srcs = [
     "completion_queue.cc",
     "connection_options.cc",
+    "grpc_channel_registry.cc",
     "grpc_error_delegate.cc",
     "grpc_options.cc",
+    "iam_policy_delta.cc",
     "internal/async_connection_ready.cc",
     "internal/async_polling_loop.cc",
     "internal/background_threads_impl.cc",
+    "internal/channel_picker.cc",
     "internal/default_completion_queue_impl.cc",
     "internal/extract_long_running_result.cc",
     "internal/grpc_access_token_authentication.cc",
     "internal/grpc_async_access_token_cache.cc",
     "internal/grpc_channel_credentials_authentication.cc",
+    "internal/grpc_compression.cc",
     "internal/grpc_impersonate_service_account.cc",
+    "internal/grpc_impersonation_manager.cc",
     "internal/grpc_service_account_authentication.cc",
+    "internal/iam_read_modify_write.cc",
     "internal/log_wrapper.cc",
     "internal/minimal_iam_credentials_stub.cc",
     "internal/retry_loop_helpers.cc",
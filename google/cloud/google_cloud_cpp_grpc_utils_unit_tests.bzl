@@ -19,21 +19,31 @@
 google_cloud_cpp_grpc_utils_unit_tests = [
     "completion_queue_test.cc",
     "connection_options_test.cc",
+    "grpc_channel_registry_test.cc",
     "grpc_error_delegate_test.cc",
     "grpc_options_test.cc",
+    "iam_policy_delta_test.cc",
+    "internal/arena_allocated_test.cc",
     "internal/async_connection_ready_test.cc",
     "internal/async_long_running_operation_test.cc",
     "internal/async_polling_loop_test.cc",
     "internal/async_read_write_stream_impl_test.cc",
+    "internal/async_resumable_streaming_read_test.cc",
     "internal/async_retry_loop_test.cc",
     "internal/async_retry_unary_rpc_test.cc",
     "internal/background_threads_impl_test.cc",
+    "internal/channel_picker_test.cc",
     "internal/extract_long_running_result_test.cc",
     "internal/grpc_access_token_authentication_test.cc",
     "internal/grpc_async_access_token_cache_test.cc",
     "internal/grpc_channel_credentials_authentication_test.cc",
+    "internal/grpc_compression_test.cc",
+    "internal/grpc_impersonation_manager_test.cc",
     "internal/grpc_service_account_authentication_test.cc",
+    "internal/hedged_call_test.cc",
+    "internal/iam_read_modify_write_test.cc",
     "internal/log_wrapper_test.cc",
+    "internal/metrics_wrapper_test.cc",
     "internal/minimal_iam_credentials_stub_test.cc",
     "internal/polling_loop_test.cc",
     "internal/resumable_streaming_read_rpc_test.cc",
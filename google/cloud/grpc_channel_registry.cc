@@ -0,0 +1,132 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/grpc_channel_registry.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/grpc_options.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+std::shared_ptr<GrpcChannelRegistry> GrpcChannelRegistry::Create(
+    std::size_t max_idle_channels) {
+  return std::shared_ptr<GrpcChannelRegistry>(
+      new GrpcChannelRegistry(max_idle_channels));
+}
+
+std::shared_ptr<grpc::Channel> GrpcChannelRegistry::GetChannel(
+    std::string const& key,
+    absl::FunctionRef<std::shared_ptr<grpc::Channel>()> factory) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto l = channels_.find(key);
+  if (l == channels_.end()) {
+    l = channels_.emplace(key, Entry{factory(), 0, idle_.end()}).first;
+  }
+  auto& entry = l->second;
+  if (entry.idle != idle_.end()) {
+    idle_.erase(entry.idle);
+    entry.idle = idle_.end();
+  }
+  ++entry.users;
+  // The deleter keeps the channel alive, even if the registry is deleted.
+  std::weak_ptr<GrpcChannelRegistry> w = shared_from_this();
+  auto channel = entry.channel;
+  return std::shared_ptr<grpc::Channel>(
+      channel.get(), [w, channel, key](grpc::Channel*) {
+        if (auto self = w.lock()) self->Release(key);
+      });
+}
+
+std::size_t GrpcChannelRegistry::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return channels_.size();
+}
+
+std::size_t GrpcChannelRegistry::idle_size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return idle_.size();
+}
+
+void GrpcChannelRegistry::Release(std::string const& key) {
+  // Close evicted channels after releasing the lock.
+  std::shared_ptr<grpc::Channel> evicted;
+  std::lock_guard<std::mutex> lk(mu_);
+  auto l = channels_.find(key);
+  if (l == channels_.end() || --l->second.users != 0) return;
+  l->second.idle = idle_.insert(idle_.begin(), key);
+  if (idle_.size() <= max_idle_channels_) return;
+  auto const lru = channels_.find(idle_.back());
+  evicted = std::move(lru->second.channel);
+  channels_.erase(lru);
+  idle_.pop_back();
+}
+
+namespace internal {
+
+std::string GrpcChannelKey(std::string const& endpoint,
+                           void const* credentials,
+                           grpc::ChannelArguments const& arguments) {
+  auto const c_args = arguments.c_channel_args();
+  std::vector<std::string> args;
+  args.reserve(c_args.num_args);
+  for (std::size_t i = 0; i != c_args.num_args; ++i) {
+    auto const& a = c_args.args[i];
+    std::string arg = a.key;
+    arg += '=';
+    switch (a.type) {
+      case GRPC_ARG_STRING:
+        arg += a.value.string;
+        break;
+      case GRPC_ARG_INTEGER:
+        arg += std::to_string(a.value.integer);
+        break;
+      case GRPC_ARG_POINTER:
+        arg += "@" + std::to_string(reinterpret_cast<std::uintptr_t>(
+                         a.value.pointer.p));
+        break;
+    }
+    args.push_back(std::move(arg));
+  }
+  // The order in which the arguments were set does not matter.
+  std::sort(args.begin(), args.end());
+  auto key = endpoint;
+  key += "\n@" + std::to_string(reinterpret_cast<std::uintptr_t>(credentials));
+  for (auto const& a : args) key += "\n" + a;
+  return key;
+}
+
+std::shared_ptr<grpc::Channel> CreateSharedChannel(
+    Options const& options, grpc::ChannelArguments const& arguments,
+    absl::FunctionRef<std::shared_ptr<grpc::Channel>()> factory) {
+  auto registry = options.get<GrpcChannelRegistryOption>();
+  if (!registry) return factory();
+  void const* credentials =
+      options.has<UnifiedCredentialsOption>()
+          ? static_cast<void const*>(
+                options.get<UnifiedCredentialsOption>().get())
+          : static_cast<void const*>(options.get<GrpcCredentialOption>().get());
+  return registry->GetChannel(
+      GrpcChannelKey(options.get<EndpointOption>(), credentials, arguments),
+      factory);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
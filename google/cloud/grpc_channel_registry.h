@@ -0,0 +1,125 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_GRPC_CHANNEL_REGISTRY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_GRPC_CHANNEL_REGISTRY_H
+
+#include "google/cloud/options.h"
+#include "google/cloud/version.h"
+#include "absl/functional/function_ref.h"
+#include <grpcpp/grpcpp.h>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * Shares gRPC channels across clients.
+ *
+ * Applications that create many clients, for one or several services, may end
+ * up with many channels (and HTTP/2 connections) to the same endpoint. Set
+ * `GrpcChannelRegistryOption` to the same registry in all these clients, and
+ * they share the channels when their endpoint, credentials, and channel
+ * arguments are the same.
+ *
+ * The registry counts the clients using each channel. Once no client uses a
+ * channel it becomes idle, but the registry keeps it, so a new client can
+ * reuse its connections. The registry keeps at most @p max_idle_channels idle
+ * channels, and closes the least recently used ones beyond that limit.
+ *
+ * @par Example
+ * @code
+ * auto registry = google::cloud::GrpcChannelRegistry::Create();
+ * auto options = google::cloud::Options{}
+ *     .set<google::cloud::GrpcChannelRegistryOption>(registry);
+ * // Use `options` with all the clients that should share channels.
+ * @endcode
+ */
+class GrpcChannelRegistry
+    : public std::enable_shared_from_this<GrpcChannelRegistry> {
+ public:
+  static std::shared_ptr<GrpcChannelRegistry> Create(
+      std::size_t max_idle_channels = 16);
+
+  /**
+   * Returns the channel for @p key, calling @p factory to create it if needed.
+   *
+   * The channel is in use until all the copies of the returned pointer are
+   * deleted.
+   */
+  std::shared_ptr<grpc::Channel> GetChannel(
+      std::string const& key,
+      absl::FunctionRef<std::shared_ptr<grpc::Channel>()> factory);
+
+  /// The number of channels, including idle channels.
+  std::size_t size() const;
+
+  /// The number of idle channels.
+  std::size_t idle_size() const;
+
+ private:
+  explicit GrpcChannelRegistry(std::size_t max_idle_channels)
+      : max_idle_channels_(max_idle_channels) {}
+
+  struct Entry {
+    std::shared_ptr<grpc::Channel> channel;
+    int users;
+    std::list<std::string>::iterator idle;
+  };
+
+  void Release(std::string const& key);
+
+  std::size_t const max_idle_channels_;
+  mutable std::mutex mu_;
+  std::unordered_map<std::string, Entry> channels_;
+  // The keys of the idle channels, the most recently used first.
+  std::list<std::string> idle_;
+};
+
+namespace internal {
+
+/**
+ * Returns a key for channels with the given @p endpoint, @p credentials and
+ * @p arguments.
+ *
+ * The credentials are compared by address.
+ */
+std::string GrpcChannelKey(std::string const& endpoint,
+                           void const* credentials,
+                           grpc::ChannelArguments const& arguments);
+
+/**
+ * Creates a channel with @p factory, unless the registry in
+ * `GrpcChannelRegistryOption` has a matching channel.
+ *
+ * The channel is keyed by the `EndpointOption`, the `UnifiedCredentialsOption`
+ * (or `GrpcCredentialOption`) in @p options, and by @p arguments.
+ */
+std::shared_ptr<grpc::Channel> CreateSharedChannel(
+    Options const& options, grpc::ChannelArguments const& arguments,
+    absl::FunctionRef<std::shared_ptr<grpc::Channel>()> factory);
+
+}  // namespace internal
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_GRPC_CHANNEL_REGISTRY_H
@@ -0,0 +1,148 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/grpc_channel_registry.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/grpc_options.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+std::shared_ptr<grpc::Channel> MakeTestChannel() {
+  // Channels connect lazily, this does not need a server.
+  return grpc::CreateChannel("localhost:1", grpc::InsecureChannelCredentials());
+}
+
+TEST(GrpcChannelRegistry, SharesChannels) {
+  auto registry = GrpcChannelRegistry::Create();
+  int created = 0;
+  auto factory = [&created] {
+    ++created;
+    return MakeTestChannel();
+  };
+  auto a1 = registry->GetChannel("a", factory);
+  auto a2 = registry->GetChannel("a", factory);
+  auto b = registry->GetChannel("b", factory);
+  EXPECT_EQ(a1.get(), a2.get());
+  EXPECT_NE(a1.get(), b.get());
+  EXPECT_EQ(2, created);
+  EXPECT_EQ(2, registry->size());
+  EXPECT_EQ(0, registry->idle_size());
+}
+
+TEST(GrpcChannelRegistry, ReusesIdleChannels) {
+  auto registry = GrpcChannelRegistry::Create();
+  int created = 0;
+  auto factory = [&created] {
+    ++created;
+    return MakeTestChannel();
+  };
+  auto a = registry->GetChannel("a", factory);
+  auto* raw = a.get();
+  auto copy = a;
+  a.reset();
+  EXPECT_EQ(0, registry->idle_size());
+  copy.reset();
+  EXPECT_EQ(1, registry->idle_size());
+
+  a = registry->GetChannel("a", factory);
+  EXPECT_EQ(raw, a.get());
+  EXPECT_EQ(1, created);
+  EXPECT_EQ(0, registry->idle_size());
+}
+
+TEST(GrpcChannelRegistry, EvictsLeastRecentlyUsed) {
+  auto registry = GrpcChannelRegistry::Create(2);
+  int created = 0;
+  auto factory = [&created] {
+    ++created;
+    return MakeTestChannel();
+  };
+  auto a = registry->GetChannel("a", factory);
+  auto b = registry->GetChannel("b", factory);
+  auto c = registry->GetChannel("c", factory);
+  a.reset();
+  b.reset();
+  c.reset();
+  // "a" became idle first, it is evicted.
+  EXPECT_EQ(2, registry->size());
+  EXPECT_EQ(2, registry->idle_size());
+  created = 0;
+  b = registry->GetChannel("b", factory);
+  c = registry->GetChannel("c", factory);
+  EXPECT_EQ(0, created);
+  a = registry->GetChannel("a", factory);
+  EXPECT_EQ(1, created);
+}
+
+TEST(GrpcChannelRegistry, ChannelOutlivesRegistry) {
+  auto registry = GrpcChannelRegistry::Create();
+  auto a = registry->GetChannel("a", MakeTestChannel);
+  registry.reset();
+  EXPECT_EQ(GRPC_CHANNEL_IDLE, a->GetState(false));
+}
+
+TEST(GrpcChannelRegistry, ChannelKey) {
+  grpc::ChannelArguments args1;
+  args1.SetInt("grpc.channel_id", 1);
+  args1.SetString("test-key", "test-value");
+  grpc::ChannelArguments args2;
+  args2.SetString("test-key", "test-value");
+  args2.SetInt("grpc.channel_id", 1);
+  grpc::ChannelArguments args3;
+  args3.SetString("test-key", "test-value");
+  args3.SetInt("grpc.channel_id", 2);
+  int credentials1 = 0;
+  int credentials2 = 0;
+
+  auto const key = internal::GrpcChannelKey("e1", &credentials1, args1);
+  EXPECT_EQ(key, internal::GrpcChannelKey("e1", &credentials1, args2));
+  EXPECT_NE(key, internal::GrpcChannelKey("e1", &credentials1, args3));
+  EXPECT_NE(key, internal::GrpcChannelKey("e2", &credentials1, args1));
+  EXPECT_NE(key, internal::GrpcChannelKey("e1", &credentials2, args1));
+}
+
+TEST(GrpcChannelRegistry, CreateSharedChannel) {
+  int created = 0;
+  auto factory = [&created] {
+    ++created;
+    return MakeTestChannel();
+  };
+  auto const credentials = grpc::InsecureChannelCredentials();
+  auto options = Options{}
+                     .set<EndpointOption>("localhost:1")
+                     .set<GrpcCredentialOption>(credentials);
+  grpc::ChannelArguments args;
+
+  // Without a registry each call creates a new channel.
+  auto c1 = internal::CreateSharedChannel(options, args, factory);
+  auto c2 = internal::CreateSharedChannel(options, args, factory);
+  EXPECT_NE(c1.get(), c2.get());
+  EXPECT_EQ(2, created);
+
+  created = 0;
+  options.set<GrpcChannelRegistryOption>(GrpcChannelRegistry::Create());
+  c1 = internal::CreateSharedChannel(options, args, factory);
+  c2 = internal::CreateSharedChannel(options, args, factory);
+  EXPECT_EQ(c1.get(), c2.get());
+  EXPECT_EQ(1, created);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -16,11 +16,30 @@
 #include "google/cloud/common_options.h"
 #include "google/cloud/internal/absl_str_join_quiet.h"
 #include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/default_completion_queue_impl.h"
+#include "google/cloud/internal/thread_affinity.h"
+#include "google/cloud/log.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 
+BackgroundThreadsFactory MakeSharedBackgroundThreadsFactory(
+    std::shared_ptr<BackgroundThreads> threads) {
+  return [threads] {
+    return absl::make_unique<internal::SharedBackgroundThreads>(threads);
+  };
+}
+
+BackgroundThreadsFactory MakeSharedBackgroundThreadsFactory(
+    CompletionQueue cq) {
+  return [cq] {
+    return absl::make_unique<internal::CustomerSuppliedBackgroundThreads>(cq);
+  };
+}
+
 namespace internal {
 
 grpc::ChannelArguments MakeChannelArguments(Options const& opts) {
@@ -38,10 +57,72 @@ grpc::ChannelArguments MakeChannelArguments(Options const& opts) {
 BackgroundThreadsFactory MakeBackgroundThreadsFactory(Options const& opts) {
   if (opts.has<GrpcBackgroundThreadsFactoryOption>())
     return opts.get<GrpcBackgroundThreadsFactoryOption>();
+  if (opts.get<GrpcSharedBackgroundThreadsOption>()) {
+    return [] {
+      return absl::make_unique<SharedBackgroundThreads>(
+          ProcessBackgroundThreads());
+    };
+  }
   auto const s = opts.get<GrpcBackgroundThreadPoolSizeOption>();
-  return [s] {
+  auto const batch = opts.get<GrpcBatchRunAsyncOption>();
+  auto make_cq = [batch] {
+    return CompletionQueue(
+        std::make_shared<::google::cloud::internal::DefaultCompletionQueueImpl>(
+            batch));
+  };
+  auto shards = opts.get<GrpcCompletionQueueShardCountOption>();
+
+  std::vector<std::vector<int>> shard_cpus;
+  auto const& nodes = opts.get<GrpcBackgroundThreadsNumaNodesOption>();
+  for (auto node : nodes) {
+    auto cpus = NumaNodeCpus(node);
+    if (!cpus) {
+      GCP_LOG(WARNING) << "Cannot find CPUs for NUMA node " << node << ": "
+                       << cpus.status();
+      shard_cpus.emplace_back();
+      continue;
+    }
+    shard_cpus.push_back(*std::move(cpus));
+  }
+  if (!nodes.empty() && shards == 0) shards = nodes.size();
+  if (shard_cpus.empty()) {
+    auto const& cpus = opts.get<GrpcBackgroundThreadsCpuAffinityOption>();
+    if (!cpus.empty()) shard_cpus.push_back(cpus);
+  }
+
+  if (shards > 1) {
+    // The threads are divided across the shards, with at least one thread
+    // per shard.
+    return [s, batch, shards, shard_cpus] {
+      return absl::make_unique<
+          ::google::cloud::internal::AutomaticallyCreatedBackgroundThreads>(
+          s,
+          std::make_shared<
+              ::google::cloud::internal::DefaultCompletionQueueImpl>(batch,
+                                                                     shards),
+          shard_cpus);
+    };
+  }
+  auto cpus = shard_cpus.empty() ? std::vector<int>{} : shard_cpus.front();
+  auto const max_size = opts.get<GrpcBackgroundThreadPoolMaxSizeOption>();
+  if (max_size > s) {
+    ElasticBackgroundThreads::Config config;
+    config.min_threads = s;
+    config.max_threads = max_size;
+    if (opts.has<GrpcBackgroundThreadIdleTimeoutOption>()) {
+      config.idle_timeout = opts.get<GrpcBackgroundThreadIdleTimeoutOption>();
+    }
+    config.batch_run_async = batch;
+    config.cpus = std::move(cpus);
+    return [config] {
+      return absl::make_unique<
+          ::google::cloud::internal::ElasticBackgroundThreads>(config);
+    };
+  }
+  return [s, make_cq, cpus] {
     return absl::make_unique<
-        ::google::cloud::internal::AutomaticallyCreatedBackgroundThreads>(s);
+        ::google::cloud::internal::AutomaticallyCreatedBackgroundThreads>(
+        s, make_cq(), cpus);
   };
 }
 
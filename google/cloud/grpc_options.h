@@ -20,13 +20,18 @@
 #include "google/cloud/tracing_options.h"
 #include "google/cloud/version.h"
 #include <grpcpp/grpcpp.h>
+#include <chrono>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 
+class GrpcChannelRegistry;
+
 /**
  * The gRPC credentials used by clients configured with this object.
  */
@@ -75,6 +80,110 @@ struct GrpcBackgroundThreadPoolSizeOption {
   using Type = std::size_t;
 };
 
+/**
+ * The maximum size of an elastic background thread pool.
+ *
+ * If this value is larger than `GrpcBackgroundThreadPoolSizeOption` the
+ * background thread pool is elastic: it starts with
+ * `GrpcBackgroundThreadPoolSizeOption` threads, adds threads (up to this
+ * value) when all the threads are busy or when functions scheduled with
+ * `CompletionQueue::RunAsync()` are waiting for a thread, and retires threads
+ * that are idle for `GrpcBackgroundThreadIdleTimeoutOption`.
+ *
+ * @note this is ignored if `GrpcBackgroundThreadsFactoryOption` is set, or if
+ *     the pool has more than one completion queue shard.
+ */
+struct GrpcBackgroundThreadPoolMaxSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * How long a thread in an elastic background thread pool can be idle before
+ * it is retired.
+ *
+ * @see `GrpcBackgroundThreadPoolMaxSizeOption`.
+ */
+struct GrpcBackgroundThreadIdleTimeoutOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * The number of completion queue shards in the background thread pool.
+ *
+ * By default all the background threads share a single `grpc::CompletionQueue`.
+ * With many threads the contention on that queue can increase the latency of
+ * each operation. Setting this option to a value greater than 1 creates a
+ * `CompletionQueue` with multiple `grpc::CompletionQueue` shards. Each new
+ * operation (or stream) is started on the next shard in round-robin order, so
+ * the operations from a single connection are spread across all the shards.
+ *
+ * The threads configured via `GrpcBackgroundThreadPoolSizeOption` are divided
+ * across the shards, with at least one thread per shard. Each thread blocks on
+ * a single shard. Each shard reserves one of its threads for I/O, so at most
+ * `GrpcBackgroundThreadPoolSizeOption - shards` threads run functions
+ * scheduled via `CompletionQueue::RunAsync()`. Shards with a single thread
+ * run these functions between I/O events.
+ *
+ * @note this is ignored if `GrpcBackgroundThreadsFactoryOption` is set.
+ */
+struct GrpcCompletionQueueShardCountOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Batch the wakeups for `CompletionQueue::RunAsync()` calls.
+ *
+ * By default each call to `RunAsync()` may wake up an additional background
+ * thread, which maximizes the parallelism for long-running functions. When
+ * this option is `true` only the call that finds the queue empty wakes up a
+ * background thread, and the rest of a burst is drained by that thread. This
+ * reduces the overhead for applications that schedule many short functions,
+ * for example, as `future<T>::then()` continuations.
+ *
+ * @note this is ignored if `GrpcBackgroundThreadsFactoryOption` is set.
+ */
+struct GrpcBatchRunAsyncOption {
+  using Type = bool;
+};
+
+/**
+ * Restrict the background threads to a set of CPUs.
+ *
+ * The value is a list of CPU ids, as reported by the operating system. All the
+ * threads in the background thread pool are pinned to these CPUs. An empty
+ * list (the default) leaves the threads unpinned. Pinning the I/O threads to
+ * the same CPUs as the application threads that consume the results can
+ * reduce cross-socket memory traffic on multi-socket machines.
+ *
+ * Failures to set the affinity are logged and the threads run unpinned. This
+ * option is only supported on Linux.
+ *
+ * @note this is ignored if `GrpcBackgroundThreadsFactoryOption` or
+ *     `GrpcBackgroundThreadsNumaNodesOption` are set.
+ */
+struct GrpcBackgroundThreadsCpuAffinityOption {
+  using Type = std::vector<int>;
+};
+
+/**
+ * Place the background threads on a set of NUMA nodes.
+ *
+ * Each completion queue shard (see `GrpcCompletionQueueShardCountOption`) is
+ * pinned to the CPUs of one NUMA node, assigning the nodes to shards in
+ * round-robin order. If the shard count is not set, one shard is created for
+ * each node in this list. This keeps the completions for each shard on a
+ * single node.
+ *
+ * The CPUs for each node are discovered from `/sys/devices/system/node`. This
+ * option is only supported on Linux, on other platforms, or if a node cannot
+ * be found, the threads for that shard run unpinned.
+ *
+ * @note this is ignored if `GrpcBackgroundThreadsFactoryOption` is set.
+ */
+struct GrpcBackgroundThreadsNumaNodesOption {
+  using Type = std::vector<int>;
+};
+
 using BackgroundThreadsFactory =
     std::function<std::unique_ptr<BackgroundThreads>()>;
 /**
@@ -91,13 +200,170 @@ struct GrpcBackgroundThreadsFactoryOption {
   using Type = BackgroundThreadsFactory;
 };
 
+/**
+ * Use the process-wide background thread pool.
+ *
+ * By default each connection creates its own background threads, so an
+ * application with many clients may end up with many idle threads and
+ * completion queues. Connections configured with this option share a single
+ * pool, created on first use with one thread per CPU, and deleted once no
+ * connection uses it.
+ *
+ * @note this is ignored if `GrpcBackgroundThreadsFactoryOption` is set. When
+ *     set, the options that configure the size, shards, and affinity of the
+ *     background threads are ignored.
+ */
+struct GrpcSharedBackgroundThreadsOption {
+  using Type = bool;
+};
+
+/**
+ * Prefetch pages in the `List*()` functions of generated connections.
+ *
+ * Paginated RPCs return a `StreamRange<T>`, which normally fetches each page
+ * when the application reaches the end of the previous page. With this option
+ * the range fetches up to this many pages ahead of the current page, in the
+ * connection's background threads. This hides the latency of the RPCs when
+ * the application processes each page slowly, at the cost of keeping more
+ * pages in memory. The default is 0, which disables prefetching.
+ */
+struct GrpcPaginationPrefetchDepthOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Limit the duration of each attempt in the retry loops of generated
+ * connections.
+ *
+ * The retry policy limits the total duration of a call, for example,
+ * `LimitedTimeRetryPolicy` stops retrying after some time. Each attempt of the
+ * call has a deadline that is the earliest of the retry policy deadline and
+ * this timeout, so a slow attempt does not use the full retry budget when a
+ * new attempt could succeed. The default is 0, which sets the deadline of
+ * each attempt only from the retry policy.
+ *
+ * @note Use this option only with idempotent operations, or with timeouts
+ *     much larger than the expected latency of the RPC. An attempt that times
+ *     out may still complete in the service.
+ */
+struct GrpcAttemptTimeoutOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * Send a duplicate ("hedged") request if an attempt is slower than a delay.
+ *
+ * The keys are the names of the RPCs, as `"<Service>.<Method>"`, for example
+ * `"BigQueryRead.CreateReadSession"`, the values are the delay before sending
+ * the hedged request. The generated connections use the first successful
+ * response and cancel the other request. Set the delay to about the p95
+ * latency of the RPC, so only the slowest requests are duplicated.
+ *
+ * Only unary RPCs that the connection idempotency policy deems idempotent are
+ * hedged, any other RPC ignores its entry. The default is an empty map, which
+ * disables hedging.
+ *
+ * @note the service may receive, and execute, both requests.
+ */
+struct GrpcHedgingDelayOption {
+  using Type = std::map<std::string, std::chrono::milliseconds>;
+};
+
+/**
+ * Compress large requests with gzip.
+ *
+ * The keys are the names of the RPCs, as `"<Service>.<Method>"`, for example
+ * `"LoggingServiceV2.WriteLogEntries"`, `"Spanner.Commit"`, or
+ * `"Bigtable.MutateRows"`, the values are the minimum size, in bytes, of the
+ * serialized request to compress it. Compressing small requests costs more CPU
+ * than it saves in bandwidth, RPCs without an entry, and requests below their
+ * threshold, are not compressed. The default is an empty map, which disables
+ * compression.
+ *
+ * The service may compress its responses regardless of this option, the client
+ * accepts any compression algorithm supported by gRPC.
+ */
+struct GrpcCompressionOption {
+  using Type = std::map<std::string, std::size_t>;
+};
+
+/// The policies to pick a channel for each RPC, see
+/// `GrpcChannelSelectionOption`.
+enum class ChannelSelection {
+  /// Use each channel in turn.
+  kRoundRobin,
+  /// Use the channel with the fewest RPCs in progress.
+  kLeastOutstanding,
+  /// Use each channel in turn, skipping channels that cannot connect.
+  kChannelState,
+};
+
+/**
+ * Select how generated clients pick one of their `GrpcNumChannelsOption`
+ * channels for each RPC.
+ *
+ * The default, `kRoundRobin`, is the cheapest. `kLeastOutstanding` spreads the
+ * load better when the latency of the RPCs varies a lot. `kChannelState` avoids
+ * channels in the `TRANSIENT_FAILURE` state, for example, while a backend is
+ * restarting.
+ *
+ * @note this has no effect unless `GrpcNumChannelsOption` is greater than 1.
+ */
+struct GrpcChannelSelectionOption {
+  using Type = ChannelSelection;
+};
+
+/**
+ * Share gRPC channels through a `GrpcChannelRegistry`.
+ *
+ * Clients configured with the same registry reuse each other's channels if
+ * their endpoint, credentials, and channel arguments match. This includes
+ * clients for different services, as long as they use the same endpoint. The
+ * credentials match only if the clients use the same `Credentials` (or
+ * `grpc::ChannelCredentials`) object.
+ *
+ * Unset by default, each client creates its own channels.
+ */
+struct GrpcChannelRegistryOption {
+  using Type = std::shared_ptr<GrpcChannelRegistry>;
+};
+
+/**
+ * Returns a factory that shares @p threads across connections.
+ *
+ * Use this with `GrpcBackgroundThreadsFactoryOption` to share the same
+ * background threads across clients, including clients for different
+ * services. The threads are deleted once the application and all the
+ * connections release them.
+ */
+BackgroundThreadsFactory MakeSharedBackgroundThreadsFactory(
+    std::shared_ptr<BackgroundThreads> threads);
+
+/**
+ * Returns a factory that shares @p cq across connections.
+ *
+ * The application is responsible for running threads blocked on
+ * `cq.Run()`, and for shutting down @p cq once all the connections are
+ * deleted.
+ */
+BackgroundThreadsFactory MakeSharedBackgroundThreadsFactory(CompletionQueue cq);
+
 /**
  * A list of all the gRPC options.
  */
 using GrpcOptionList =
     OptionList<GrpcCredentialOption, GrpcNumChannelsOption,
                GrpcChannelArgumentsOption, GrpcTracingOptionsOption,
-               GrpcBackgroundThreadsFactoryOption>;
+               GrpcBackgroundThreadsFactoryOption,
+               GrpcCompletionQueueShardCountOption, GrpcBatchRunAsyncOption,
+               GrpcBackgroundThreadsCpuAffinityOption,
+               GrpcBackgroundThreadsNumaNodesOption,
+               GrpcBackgroundThreadPoolMaxSizeOption,
+               GrpcBackgroundThreadIdleTimeoutOption,
+               GrpcPaginationPrefetchDepthOption, GrpcAttemptTimeoutOption,
+               GrpcHedgingDelayOption, GrpcCompressionOption,
+               GrpcChannelSelectionOption, GrpcChannelRegistryOption,
+               GrpcSharedBackgroundThreadsOption>;
 
 namespace internal {
 
@@ -107,7 +373,8 @@ grpc::ChannelArguments MakeChannelArguments(Options const& opts);
 /**
  * Returns a factory for generating `BackgroundThreads`. If
  * `GrpcBackgroundThreadsFactoryOption` is unset, it will return a thread pool
- * of size `GrpcBackgroundThreadPoolSizeOption`.
+ * of size `GrpcBackgroundThreadPoolSizeOption`, blocked on a completion queue
+ * with `GrpcCompletionQueueShardCountOption` shards.
  */
 BackgroundThreadsFactory MakeBackgroundThreadsFactory(Options const& opts = {});
 
@@ -13,12 +13,20 @@
 // limitations under the License.
 
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/grpc_channel_registry.h"
 #include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/default_completion_queue_impl.h"
 #include "google/cloud/testing_util/scoped_log.h"
 #include "absl/memory/memory.h"
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -31,6 +39,14 @@ using ::testing::ContainsRegex;
 using ::testing::NotNull;
 using ThreadPool = internal::AutomaticallyCreatedBackgroundThreads;
 
+// Returns the number of shards in the completion queue used by @p threads.
+std::size_t ShardCount(BackgroundThreads const& threads) {
+  auto cq = threads.cq();
+  auto impl = std::dynamic_pointer_cast<internal::DefaultCompletionQueueImpl>(
+      internal::GetCompletionQueueImpl(cq));
+  return impl ? impl->shard_count() : 0;
+}
+
 // Tests a generic option by setting it, then getting it.
 template <typename T, typename ValueType = typename T::Type>
 void TestGrpcOption(ValueType const& expected) {
@@ -46,6 +62,12 @@ TEST(GrpcOptionList, RegularOptions) {
   TestGrpcOption<GrpcNumChannelsOption>(42);
   TestGrpcOption<GrpcChannelArgumentsOption>({{"foo", "bar"}, {"baz", "quux"}});
   TestGrpcOption<GrpcTracingOptionsOption>(TracingOptions{});
+  TestGrpcOption<GrpcChannelSelectionOption>(
+      ChannelSelection::kLeastOutstanding);
+  TestGrpcOption<GrpcHedgingDelayOption>(
+      {{"Service.Method", std::chrono::milliseconds(50)}});
+  TestGrpcOption<GrpcCompressionOption>({{"Service.Method", 1024}});
+  TestGrpcOption<GrpcChannelRegistryOption>(GrpcChannelRegistry::Create());
 }
 
 TEST(GrpcOptionList, GrpcBackgroundThreadsFactoryOption) {
@@ -95,6 +117,170 @@ TEST(GrpcOptionList, GrpcBackgroundThreadPoolSizeIgnored) {
   EXPECT_EQ(kThreadPoolSize, tp->pool_size());
 }
 
+TEST(GrpcOptionList, GrpcCompletionQueueShardCountOption) {
+  auto threads = internal::MakeBackgroundThreadsFactory(
+      Options{}
+          .set<GrpcBackgroundThreadPoolSizeOption>(8)
+          .set<GrpcCompletionQueueShardCountOption>(4))();
+  auto* tp = dynamic_cast<ThreadPool*>(threads.get());
+  ASSERT_THAT(tp, NotNull());
+  EXPECT_EQ(4U, ShardCount(*tp));
+  // The threads are divided across the shards.
+  EXPECT_EQ(8U, tp->pool_size());
+}
+
+TEST(GrpcOptionList, GrpcCompletionQueueShardUsesAllThreads) {
+  auto constexpr kThreadPoolSize = 4;
+  auto threads = internal::MakeBackgroundThreadsFactory(
+      Options{}
+          .set<GrpcBackgroundThreadPoolSizeOption>(kThreadPoolSize)
+          .set<GrpcCompletionQueueShardCountOption>(2))();
+  // Connections call `cq()` once and keep the queue, verify the operations
+  // started on a single queue can keep all the configured threads busy. Each
+  // timer is started on the next shard, and its callback runs in one of the
+  // threads serving that shard.
+  auto cq = threads->cq();
+  std::mutex mu;
+  std::condition_variable cv;
+  int running = 0;
+  std::vector<promise<bool>> done(kThreadPoolSize);
+  for (auto& p : done) {
+    cq.MakeRelativeTimer(std::chrono::milliseconds(50))
+        .then([&mu, &cv, &running, &p](
+                  future<StatusOr<std::chrono::system_clock::time_point>>) {
+          std::unique_lock<std::mutex> lk(mu);
+          ++running;
+          cv.notify_all();
+          auto const all = cv.wait_for(
+              lk, std::chrono::seconds(10),
+              [&running] { return running == kThreadPoolSize; });
+          p.set_value(all);
+        });
+  }
+  for (auto& p : done) EXPECT_TRUE(p.get_future().get());
+}
+
+TEST(GrpcOptionList, GrpcCompletionQueueShardCountAtLeastOneThread) {
+  auto threads = internal::MakeBackgroundThreadsFactory(
+      Options{}.set<GrpcCompletionQueueShardCountOption>(3))();
+  auto* tp = dynamic_cast<ThreadPool*>(threads.get());
+  ASSERT_THAT(tp, NotNull());
+  EXPECT_EQ(3U, ShardCount(*tp));
+  EXPECT_EQ(3U, tp->pool_size());
+}
+
+TEST(GrpcOptionList, GrpcBackgroundThreadsNumaNodesOption) {
+  testing_util::ScopedLog log;
+  // Use node ids that cannot exist, the shards should be created anyway, with
+  // one shard per node.
+  auto threads = internal::MakeBackgroundThreadsFactory(
+      Options{}.set<GrpcBackgroundThreadsNumaNodesOption>({-1, -2}))();
+  auto* tp = dynamic_cast<ThreadPool*>(threads.get());
+  ASSERT_THAT(tp, NotNull());
+  EXPECT_EQ(2U, ShardCount(*tp));
+  EXPECT_THAT(log.ExtractLines(),
+              Contains(ContainsRegex("Cannot find CPUs for NUMA node -1")));
+
+  std::vector<promise<void>> done(2);
+  for (auto& p : done) tp->cq().RunAsync([&p] { p.set_value(); });
+  for (auto& p : done) p.get_future().get();
+}
+
+TEST(GrpcOptionList, GrpcBackgroundThreadsCpuAffinityOption) {
+  auto threads = internal::MakeBackgroundThreadsFactory(
+      Options{}
+          .set<GrpcBackgroundThreadPoolSizeOption>(2)
+          .set<GrpcBackgroundThreadsCpuAffinityOption>({0}))();
+  auto* tp = dynamic_cast<ThreadPool*>(threads.get());
+  ASSERT_THAT(tp, NotNull());
+  EXPECT_EQ(2U, tp->pool_size());
+
+  // The affinity may be rejected in some environments, but the threads must
+  // run regardless.
+  promise<void> done;
+  tp->cq().RunAsync([&done] { done.set_value(); });
+  done.get_future().get();
+}
+
+TEST(GrpcOptionList, GrpcBackgroundThreadPoolMaxSizeOption) {
+  auto threads = internal::MakeBackgroundThreadsFactory(
+      Options{}
+          .set<GrpcBackgroundThreadPoolSizeOption>(2)
+          .set<GrpcBackgroundThreadPoolMaxSizeOption>(8)
+          .set<GrpcBackgroundThreadIdleTimeoutOption>(
+              std::chrono::milliseconds(100)))();
+  auto* tp = dynamic_cast<internal::ElasticBackgroundThreads*>(threads.get());
+  ASSERT_THAT(tp, NotNull());
+  EXPECT_EQ(2U, tp->pool_size());
+}
+
+TEST(GrpcOptionList, GrpcBackgroundThreadPoolMaxSizeIgnoredIfSmaller) {
+  auto threads = internal::MakeBackgroundThreadsFactory(
+      Options{}
+          .set<GrpcBackgroundThreadPoolSizeOption>(4)
+          .set<GrpcBackgroundThreadPoolMaxSizeOption>(2))();
+  auto* tp = dynamic_cast<ThreadPool*>(threads.get());
+  ASSERT_THAT(tp, NotNull());
+  EXPECT_EQ(4U, tp->pool_size());
+}
+
+TEST(GrpcOptionList, GrpcSharedBackgroundThreadsOption) {
+  auto factory = internal::MakeBackgroundThreadsFactory(
+      Options{}
+          .set<GrpcSharedBackgroundThreadsOption>(true)
+          // Ignored, the process-wide pool has one thread per CPU.
+          .set<GrpcBackgroundThreadPoolSizeOption>(64));
+  auto t1 = factory();
+  auto t2 = factory();
+  auto* s1 = dynamic_cast<internal::SharedBackgroundThreads*>(t1.get());
+  auto* s2 = dynamic_cast<internal::SharedBackgroundThreads*>(t2.get());
+  ASSERT_THAT(s1, NotNull());
+  ASSERT_THAT(s2, NotNull());
+  EXPECT_EQ(s1->impl(), s2->impl());
+  auto* tp = dynamic_cast<ThreadPool*>(s1->impl().get());
+  ASSERT_THAT(tp, NotNull());
+  EXPECT_EQ((std::max)(1U, std::thread::hardware_concurrency()),
+            tp->pool_size());
+
+  promise<void> done;
+  t1->cq().RunAsync([&done] { done.set_value(); });
+  done.get_future().get();
+}
+
+TEST(GrpcOptionList, ProcessBackgroundThreadsReleased) {
+  std::weak_ptr<BackgroundThreads> w = internal::ProcessBackgroundThreads();
+  EXPECT_TRUE(w.expired());
+  auto threads = internal::ProcessBackgroundThreads();
+  EXPECT_EQ(threads, internal::ProcessBackgroundThreads());
+}
+
+TEST(GrpcOptionList, MakeSharedBackgroundThreadsFactory) {
+  std::shared_ptr<BackgroundThreads> shared = std::make_shared<ThreadPool>(2);
+  auto factory = MakeSharedBackgroundThreadsFactory(shared);
+  auto t1 = factory();
+  auto t2 = factory();
+  auto* s1 = dynamic_cast<internal::SharedBackgroundThreads*>(t1.get());
+  ASSERT_THAT(s1, NotNull());
+  EXPECT_EQ(shared, s1->impl());
+  t1.reset();
+  t2.reset();
+  factory = nullptr;
+  EXPECT_EQ(1, shared.use_count());
+}
+
+TEST(GrpcOptionList, MakeSharedBackgroundThreadsFactoryCompletionQueue) {
+  ThreadPool pool(1);
+  auto factory = MakeSharedBackgroundThreadsFactory(pool.cq());
+  auto threads = factory();
+  auto* tp = dynamic_cast<internal::CustomerSuppliedBackgroundThreads*>(
+      threads.get());
+  ASSERT_THAT(tp, NotNull());
+
+  promise<void> done;
+  threads->cq().RunAsync([&done] { done.set_value(); });
+  done.get_future().get();
+}
+
 TEST(GrpcOptionList, Expected) {
   testing_util::ScopedLog log;
   Options opts;
@@ -17,6 +17,7 @@
 """Automatically generated source lists for google_cloud_cpp_iam - DO NOT EDIT."""
 
 google_cloud_cpp_iam_hdrs = [
+    "iam_cache_connection.h",
     "iam_client.h",
     "iam_connection.h",
     "iam_connection_idempotency_policy.h",
@@ -29,18 +30,23 @@ google_cloud_cpp_iam_hdrs = [
     "internal/iam_credentials_auth_decorator.h",
     "internal/iam_credentials_logging_decorator.h",
     "internal/iam_credentials_metadata_decorator.h",
+    "internal/iam_credentials_metrics_decorator.h",
     "internal/iam_credentials_option_defaults.h",
+    "internal/iam_credentials_round_robin_decorator.h",
     "internal/iam_credentials_stub.h",
     "internal/iam_credentials_stub_factory.h",
     "internal/iam_logging_decorator.h",
     "internal/iam_metadata_decorator.h",
+    "internal/iam_metrics_decorator.h",
     "internal/iam_option_defaults.h",
+    "internal/iam_round_robin_decorator.h",
     "internal/iam_stub.h",
     "internal/iam_stub_factory.h",
     "retry_traits.h",
 ]
 
 google_cloud_cpp_iam_srcs = [
+    "iam_cache_connection.cc",
     "iam_client.cc",
     "iam_connection.cc",
     "iam_connection_idempotency_policy.cc",
@@ -51,12 +57,16 @@ google_cloud_cpp_iam_srcs = [
     "internal/iam_credentials_auth_decorator.cc",
     "internal/iam_credentials_logging_decorator.cc",
     "internal/iam_credentials_metadata_decorator.cc",
+    "internal/iam_credentials_metrics_decorator.cc",
     "internal/iam_credentials_option_defaults.cc",
+    "internal/iam_credentials_round_robin_decorator.cc",
     "internal/iam_credentials_stub.cc",
     "internal/iam_credentials_stub_factory.cc",
     "internal/iam_logging_decorator.cc",
     "internal/iam_metadata_decorator.cc",
+    "internal/iam_metrics_decorator.cc",
     "internal/iam_option_defaults.cc",
+    "internal/iam_round_robin_decorator.cc",
     "internal/iam_stub.cc",
     "internal/iam_stub_factory.cc",
 ]
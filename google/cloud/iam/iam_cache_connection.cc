@@ -0,0 +1,255 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/iam/iam_cache_connection.h"
+#include "google/cloud/internal/expiring_cache.h"
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace iam {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+namespace admin = ::google::iam::admin::v1;
+namespace v1 = ::google::iam::v1;
+
+// Resource names cannot contain a newline, so all the keys for a resource
+// start with this prefix.
+std::string ResourcePrefix(std::string const& resource) {
+  return resource + "\n";
+}
+
+std::string PolicyKey(v1::GetIamPolicyRequest const& request) {
+  return ResourcePrefix(request.resource()) +
+         std::to_string(request.options().requested_policy_version());
+}
+
+std::string PermissionsKey(v1::TestIamPermissionsRequest const& request) {
+  auto key = ResourcePrefix(request.resource());
+  for (auto const& p : request.permissions()) key += "\n" + p;
+  return key;
+}
+
+std::function<bool(std::string const&)> HasPrefix(std::string prefix) {
+  return [prefix](std::string const& key) {
+    return key.compare(0, prefix.size(), prefix) == 0;
+  };
+}
+
+class IAMCacheConnection : public IAMConnection {
+ public:
+  IAMCacheConnection(std::shared_ptr<IAMConnection> child,
+                     Options const& options)
+      : child_(std::move(child)),
+        policies_(options.get<IAMCacheSizeOption>(),
+                  options.get<IAMCacheTtlOption>()),
+        permissions_(options.get<IAMCacheSizeOption>(),
+                     options.get<IAMCacheTtlOption>()) {}
+  ~IAMCacheConnection() override = default;
+
+  StreamRange<admin::ServiceAccount> ListServiceAccounts(
+      admin::ListServiceAccountsRequest request) override {
+    return child_->ListServiceAccounts(std::move(request));
+  }
+
+  StatusOr<admin::ServiceAccount> GetServiceAccount(
+      admin::GetServiceAccountRequest const& request) override {
+    return child_->GetServiceAccount(request);
+  }
+
+  StatusOr<admin::ServiceAccount> CreateServiceAccount(
+      admin::CreateServiceAccountRequest const& request) override {
+    return child_->CreateServiceAccount(request);
+  }
+
+  StatusOr<admin::ServiceAccount> PatchServiceAccount(
+      admin::PatchServiceAccountRequest const& request) override {
+    return child_->PatchServiceAccount(request);
+  }
+
+  Status DeleteServiceAccount(
+      admin::DeleteServiceAccountRequest const& request) override {
+    return CallAndInvalidate(request.name(),
+                             &IAMConnection::DeleteServiceAccount, request);
+  }
+
+  StatusOr<admin::UndeleteServiceAccountResponse> UndeleteServiceAccount(
+      admin::UndeleteServiceAccountRequest const& request) override {
+    return CallAndInvalidate(request.name(),
+                             &IAMConnection::UndeleteServiceAccount, request);
+  }
+
+  Status EnableServiceAccount(
+      admin::EnableServiceAccountRequest const& request) override {
+    return CallAndInvalidate(request.name(),
+                             &IAMConnection::EnableServiceAccount, request);
+  }
+
+  Status DisableServiceAccount(
+      admin::DisableServiceAccountRequest const& request) override {
+    return CallAndInvalidate(request.name(),
+                             &IAMConnection::DisableServiceAccount, request);
+  }
+
+  StatusOr<admin::ListServiceAccountKeysResponse> ListServiceAccountKeys(
+      admin::ListServiceAccountKeysRequest const& request) override {
+    return child_->ListServiceAccountKeys(request);
+  }
+
+  StatusOr<admin::ServiceAccountKey> GetServiceAccountKey(
+      admin::GetServiceAccountKeyRequest const& request) override {
+    return child_->GetServiceAccountKey(request);
+  }
+
+  StatusOr<admin::ServiceAccountKey> CreateServiceAccountKey(
+      admin::CreateServiceAccountKeyRequest const& request) override {
+    return child_->CreateServiceAccountKey(request);
+  }
+
+  StatusOr<admin::ServiceAccountKey> UploadServiceAccountKey(
+      admin::UploadServiceAccountKeyRequest const& request) override {
+    return child_->UploadServiceAccountKey(request);
+  }
+
+  Status DeleteServiceAccountKey(
+      admin::DeleteServiceAccountKeyRequest const& request) override {
+    return child_->DeleteServiceAccountKey(request);
+  }
+
+  StatusOr<v1::Policy> GetIamPolicy(
+      v1::GetIamPolicyRequest const& request) override {
+    auto const key = PolicyKey(request);
+    auto stale = policies_.Peek(key);
+    auto policy = policies_.GetOrFetch(
+        key, [this, &request] { return child_->GetIamPolicy(request); });
+    // A different ETag means the policy changed, and the cached permission
+    // checks for this resource may be stale.
+    if (policy && stale && stale->etag() != policy->etag()) {
+      permissions_.InvalidateIf(HasPrefix(ResourcePrefix(request.resource())));
+    }
+    return policy;
+  }
+
+  StatusOr<v1::Policy> SetIamPolicy(
+      v1::SetIamPolicyRequest const& request) override {
+    return CallAndInvalidate(request.resource(),
+                             &IAMConnection::SetIamPolicy, request);
+  }
+
+  StatusOr<v1::TestIamPermissionsResponse> TestIamPermissions(
+      v1::TestIamPermissionsRequest const& request) override {
+    return permissions_.GetOrFetch(PermissionsKey(request), [this, &request] {
+      return child_->TestIamPermissions(request);
+    });
+  }
+
+  StreamRange<admin::Role> QueryGrantableRoles(
+      admin::QueryGrantableRolesRequest request) override {
+    return child_->QueryGrantableRoles(std::move(request));
+  }
+
+  StreamRange<admin::Role> ListRoles(admin::ListRolesRequest request) override {
+    return child_->ListRoles(std::move(request));
+  }
+
+  StatusOr<admin::Role> GetRole(admin::GetRoleRequest const& request) override {
+    return child_->GetRole(request);
+  }
+
+  StatusOr<admin::Role> CreateRole(
+      admin::CreateRoleRequest const& request) override {
+    return child_->CreateRole(request);
+  }
+
+  StatusOr<admin::Role> UpdateRole(
+      admin::UpdateRoleRequest const& request) override {
+    return child_->UpdateRole(request);
+  }
+
+  StatusOr<admin::Role> DeleteRole(
+      admin::DeleteRoleRequest const& request) override {
+    return child_->DeleteRole(request);
+  }
+
+  StatusOr<admin::Role> UndeleteRole(
+      admin::UndeleteRoleRequest const& request) override {
+    return child_->UndeleteRole(request);
+  }
+
+  StreamRange<admin::Permission> QueryTestablePermissions(
+      admin::QueryTestablePermissionsRequest request) override {
+    return child_->QueryTestablePermissions(std::move(request));
+  }
+
+  StatusOr<admin::QueryAuditableServicesResponse> QueryAuditableServices(
+      admin::QueryAuditableServicesRequest const& request) override {
+    return child_->QueryAuditableServices(request);
+  }
+
+  StatusOr<admin::LintPolicyResponse> LintPolicy(
+      admin::LintPolicyRequest const& request) override {
+    return child_->LintPolicy(request);
+  }
+
+ private:
+  /**
+   * Call a member function that may change the permissions on a resource.
+   *
+   * The entries are discarded before and after the call: a concurrent lookup
+   * may refresh them while the request is in flight.
+   */
+  template <typename Request, typename Response>
+  Response CallAndInvalidate(std::string const& resource,
+                             Response (IAMConnection::*function)(
+                                 Request const&),
+                             Request const& request) {
+    Invalidate(resource);
+    auto response = ((*child_).*function)(request);
+    Invalidate(resource);
+    return response;
+  }
+
+  void Invalidate(std::string const& resource) {
+    auto pred = HasPrefix(ResourcePrefix(resource));
+    policies_.InvalidateIf(pred);
+    permissions_.InvalidateIf(pred);
+  }
+
+  std::shared_ptr<IAMConnection> child_;
+  google::cloud::internal::ExpiringCache<v1::Policy> policies_;
+  google::cloud::internal::ExpiringCache<v1::TestIamPermissionsResponse>
+      permissions_;
+};
+
+}  // namespace
+
+std::shared_ptr<IAMConnection> MakeIAMCacheConnection(
+    std::shared_ptr<IAMConnection> connection, Options options) {
+  if (!options.has<IAMCacheSizeOption>()) {
+    options.set<IAMCacheSizeOption>(1000);
+  }
+  if (!options.has<IAMCacheTtlOption>()) {
+    options.set<IAMCacheTtlOption>(std::chrono::seconds(10));
+  }
+  return std::make_shared<IAMCacheConnection>(std::move(connection), options);
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam
+}  // namespace cloud
+}  // namespace google
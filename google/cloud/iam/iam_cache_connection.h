@@ -0,0 +1,85 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_IAM_CACHE_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_IAM_CACHE_CONNECTION_H
+
+#include "google/cloud/iam/iam_connection.h"
+#include "google/cloud/options.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace iam {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * Cache up to this many IAM policies, and up to this many permission checks.
+ *
+ * Used by `MakeIAMCacheConnection()`. The default is 1,000.
+ */
+struct IAMCacheSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * How long the entries in the IAM cache remain valid.
+ *
+ * Used by `MakeIAMCacheConnection()`. The default is 10 seconds.
+ */
+struct IAMCacheTtlOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * Returns a connection that caches IAM policies and permission checks.
+ *
+ * `GetIamPolicy()` and `TestIamPermissions()` requests are served from
+ * size-bounded LRU caches, the entries expire after a fixed time-to-live.
+ * Concurrent identical requests that miss the cache share a single call to
+ * @p connection. Errors are not cached.
+ *
+ * The permission checks for a resource are discarded when a refreshed policy
+ * has a different ETag than the cached one, and when this connection changes
+ * the IAM policy of the resource, or deletes, undeletes, enables, or disables
+ * the service account. Changes made by other clients are only observed once
+ * the entries expire, or when the policy is refreshed.
+ *
+ * @par Example
+ * @code
+ * namespace iam = ::google::cloud::iam;
+ * auto connection = iam::MakeIAMCacheConnection(
+ *     iam::MakeIAMConnection(),
+ *     Options{}.set<iam::IAMCacheTtlOption>(std::chrono::seconds(5)));
+ * auto client = iam::IAMClient(std::move(connection));
+ * @endcode
+ *
+ * @param connection the connection used to make the requests that miss the
+ *     cache.
+ * @param options configure the cache, see `IAMCacheSizeOption` and
+ *     `IAMCacheTtlOption`.
+ */
+std::shared_ptr<IAMConnection> MakeIAMCacheConnection(
+    std::shared_ptr<IAMConnection> connection, Options options = {});
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_IAM_CACHE_CONNECTION_H
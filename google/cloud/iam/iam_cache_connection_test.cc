@@ -0,0 +1,158 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/iam/iam_cache_connection.h"
+#include "google/cloud/iam/mocks/mock_iam_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace iam {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::iam_mocks::MockIAMConnection;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::iam::v1::GetIamPolicyRequest;
+using ::google::iam::v1::Policy;
+using ::google::iam::v1::SetIamPolicyRequest;
+using ::google::iam::v1::TestIamPermissionsRequest;
+using ::google::iam::v1::TestIamPermissionsResponse;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+auto constexpr kResource = "projects/p/serviceAccounts/sa@p.com";
+
+Policy MakePolicy(std::string const& etag) {
+  Policy policy;
+  policy.set_etag(etag);
+  return policy;
+}
+
+TestIamPermissionsResponse MakePermissions(std::string const& permission) {
+  TestIamPermissionsResponse response;
+  response.add_permissions(permission);
+  return response;
+}
+
+GetIamPolicyRequest PolicyRequest() {
+  GetIamPolicyRequest request;
+  request.set_resource(kResource);
+  return request;
+}
+
+TestIamPermissionsRequest PermissionsRequest() {
+  TestIamPermissionsRequest request;
+  request.set_resource(kResource);
+  request.add_permissions("iam.serviceAccounts.actAs");
+  return request;
+}
+
+TEST(IAMCacheConnectionTest, CachesPermissions) {
+  auto mock = std::make_shared<MockIAMConnection>();
+  EXPECT_CALL(*mock, TestIamPermissions)
+      .WillOnce(Return(MakePermissions("iam.serviceAccounts.actAs")));
+
+  auto connection = MakeIAMCacheConnection(mock);
+  for (int i = 0; i != 3; ++i) {
+    auto actual = connection->TestIamPermissions(PermissionsRequest());
+    ASSERT_STATUS_OK(actual);
+    EXPECT_THAT(actual->permissions(),
+                ElementsAre("iam.serviceAccounts.actAs"));
+  }
+}
+
+TEST(IAMCacheConnectionTest, DifferentPermissionsMiss) {
+  auto mock = std::make_shared<MockIAMConnection>();
+  EXPECT_CALL(*mock, TestIamPermissions)
+      .Times(2)
+      .WillRepeatedly(Return(TestIamPermissionsResponse{}));
+
+  auto connection = MakeIAMCacheConnection(mock);
+  auto request = PermissionsRequest();
+  ASSERT_STATUS_OK(connection->TestIamPermissions(request));
+  request.add_permissions("iam.serviceAccounts.get");
+  ASSERT_STATUS_OK(connection->TestIamPermissions(request));
+}
+
+TEST(IAMCacheConnectionTest, ErrorsAreNotCached) {
+  auto mock = std::make_shared<MockIAMConnection>();
+  EXPECT_CALL(*mock, TestIamPermissions)
+      .WillOnce(Return(StatusOr<TestIamPermissionsResponse>(
+          Status(StatusCode::kUnavailable, "try-again"))))
+      .WillOnce(Return(TestIamPermissionsResponse{}));
+
+  auto connection = MakeIAMCacheConnection(mock);
+  EXPECT_THAT(connection->TestIamPermissions(PermissionsRequest()),
+              StatusIs(StatusCode::kUnavailable));
+  EXPECT_STATUS_OK(connection->TestIamPermissions(PermissionsRequest()));
+}
+
+TEST(IAMCacheConnectionTest, EntriesExpire) {
+  auto mock = std::make_shared<MockIAMConnection>();
+  EXPECT_CALL(*mock, GetIamPolicy)
+      .Times(2)
+      .WillRepeatedly(Return(MakePolicy("etag-1")));
+
+  auto connection = MakeIAMCacheConnection(
+      mock, Options{}.set<IAMCacheTtlOption>(std::chrono::milliseconds(0)));
+  ASSERT_STATUS_OK(connection->GetIamPolicy(PolicyRequest()));
+  ASSERT_STATUS_OK(connection->GetIamPolicy(PolicyRequest()));
+}
+
+TEST(IAMCacheConnectionTest, SetIamPolicyInvalidates) {
+  auto mock = std::make_shared<MockIAMConnection>();
+  EXPECT_CALL(*mock, GetIamPolicy)
+      .WillOnce(Return(MakePolicy("etag-1")))
+      .WillOnce(Return(MakePolicy("etag-2")));
+  EXPECT_CALL(*mock, TestIamPermissions)
+      .Times(2)
+      .WillRepeatedly(Return(TestIamPermissionsResponse{}));
+  EXPECT_CALL(*mock, SetIamPolicy).WillOnce(Return(MakePolicy("etag-2")));
+
+  auto connection = MakeIAMCacheConnection(mock);
+  for (int i = 0; i != 2; ++i) {
+    auto policy = connection->GetIamPolicy(PolicyRequest());
+    ASSERT_STATUS_OK(policy);
+    ASSERT_STATUS_OK(connection->TestIamPermissions(PermissionsRequest()));
+    if (i != 0) continue;
+    SetIamPolicyRequest request;
+    request.set_resource(kResource);
+    *request.mutable_policy() = *policy;
+    ASSERT_STATUS_OK(connection->SetIamPolicy(request));
+  }
+}
+
+TEST(IAMCacheConnectionTest, DisableServiceAccountInvalidates) {
+  auto mock = std::make_shared<MockIAMConnection>();
+  EXPECT_CALL(*mock, TestIamPermissions)
+      .Times(2)
+      .WillRepeatedly(Return(TestIamPermissionsResponse{}));
+  EXPECT_CALL(*mock, DisableServiceAccount).WillOnce(Return(Status{}));
+
+  auto connection = MakeIAMCacheConnection(mock);
+  ASSERT_STATUS_OK(connection->TestIamPermissions(PermissionsRequest()));
+  google::iam::admin::v1::DisableServiceAccountRequest request;
+  request.set_name(kResource);
+  ASSERT_STATUS_OK(connection->DisableServiceAccount(request));
+  ASSERT_STATUS_OK(connection->TestIamPermissions(PermissionsRequest()));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam
+}  // namespace cloud
+}  // namespace google
@@ -22,9 +22,13 @@
 #include "google/cloud/iam/internal/iam_stub_factory.h"
 #include "google/cloud/background_threads.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/grpc_compression.h"
+#include "google/cloud/internal/hedged_call.h"
 #include "google/cloud/internal/pagination_range.h"
 #include "google/cloud/internal/retry_loop.h"
+#include <map>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -219,6 +223,10 @@ class IAMConnectionImpl : public IAMConnection {
         retry_policy_prototype_(options.get<IAMRetryPolicyOption>()->clone()),
         backoff_policy_prototype_(
             options.get<IAMBackoffPolicyOption>()->clone()),
+        page_prefetch_depth_(options.get<GrpcPaginationPrefetchDepthOption>()),
+        attempt_timeout_(options.get<GrpcAttemptTimeoutOption>()),
+        hedging_delays_(options.get<GrpcHedgingDelayOption>()),
+        compression_(options.get<GrpcCompressionOption>()),
         idempotency_policy_(
             options.get<IAMConnectionIdempotencyPolicyOption>()->clone()) {}
 
@@ -233,20 +241,21 @@ class IAMConnectionImpl : public IAMConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListServiceAccounts(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<
         StreamRange<google::iam::admin::v1::ServiceAccount>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name](
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name](
             google::iam::admin::v1::ListServiceAccountsRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::iam::admin::v1::ListServiceAccountsRequest const&
                          request) {
                 return stub->ListServiceAccounts(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::iam::admin::v1::ListServiceAccountsResponse r) {
           std::vector<google::iam::admin::v1::ServiceAccount> result(
@@ -254,213 +263,330 @@ class IAMConnectionImpl : public IAMConnection {
           auto& messages = *r.mutable_accounts();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StatusOr<google::iam::admin::v1::ServiceAccount> GetServiceAccount(
       google::iam::admin::v1::GetServiceAccountRequest const& request)
       override {
+    auto const idempotency = idempotency_policy_->GetServiceAccount(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetServiceAccount(request),
-        [this](
-            grpc::ClientContext& context,
-            google::iam::admin::v1::GetServiceAccountRequest const& request) {
-          return stub_->GetServiceAccount(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.GetServiceAccount", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::GetServiceAccountRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.GetServiceAccount", request);
+              return stub_->GetServiceAccount(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::ServiceAccount> CreateServiceAccount(
       google::iam::admin::v1::CreateServiceAccountRequest const& request)
       override {
+    auto const idempotency = idempotency_policy_->CreateServiceAccount(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->CreateServiceAccount(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::CreateServiceAccountRequest const&
-                   request) {
-          return stub_->CreateServiceAccount(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.CreateServiceAccount", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::CreateServiceAccountRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.CreateServiceAccount", request);
+              return stub_->CreateServiceAccount(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::ServiceAccount> PatchServiceAccount(
       google::iam::admin::v1::PatchServiceAccountRequest const& request)
       override {
+    auto const idempotency = idempotency_policy_->PatchServiceAccount(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->PatchServiceAccount(request),
-        [this](
-            grpc::ClientContext& context,
-            google::iam::admin::v1::PatchServiceAccountRequest const& request) {
-          return stub_->PatchServiceAccount(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.PatchServiceAccount", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::PatchServiceAccountRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.PatchServiceAccount", request);
+              return stub_->PatchServiceAccount(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   Status DeleteServiceAccount(
       google::iam::admin::v1::DeleteServiceAccountRequest const& request)
       override {
+    auto const idempotency = idempotency_policy_->DeleteServiceAccount(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->DeleteServiceAccount(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::DeleteServiceAccountRequest const&
-                   request) {
-          return stub_->DeleteServiceAccount(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.DeleteServiceAccount", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::DeleteServiceAccountRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.DeleteServiceAccount", request);
+              return stub_->DeleteServiceAccount(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::UndeleteServiceAccountResponse>
   UndeleteServiceAccount(
       google::iam::admin::v1::UndeleteServiceAccountRequest const& request)
       override {
+    auto const idempotency =
+        idempotency_policy_->UndeleteServiceAccount(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->UndeleteServiceAccount(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::UndeleteServiceAccountRequest const&
-                   request) {
-          return stub_->UndeleteServiceAccount(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.UndeleteServiceAccount", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::UndeleteServiceAccountRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.UndeleteServiceAccount", request);
+              return stub_->UndeleteServiceAccount(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   Status EnableServiceAccount(
       google::iam::admin::v1::EnableServiceAccountRequest const& request)
       override {
+    auto const idempotency = idempotency_policy_->EnableServiceAccount(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->EnableServiceAccount(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::EnableServiceAccountRequest const&
-                   request) {
-          return stub_->EnableServiceAccount(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.EnableServiceAccount", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::EnableServiceAccountRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.EnableServiceAccount", request);
+              return stub_->EnableServiceAccount(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   Status DisableServiceAccount(
       google::iam::admin::v1::DisableServiceAccountRequest const& request)
       override {
+    auto const idempotency =
+        idempotency_policy_->DisableServiceAccount(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->DisableServiceAccount(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::DisableServiceAccountRequest const&
-                   request) {
-          return stub_->DisableServiceAccount(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.DisableServiceAccount", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::DisableServiceAccountRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.DisableServiceAccount", request);
+              return stub_->DisableServiceAccount(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::ListServiceAccountKeysResponse>
   ListServiceAccountKeys(
       google::iam::admin::v1::ListServiceAccountKeysRequest const& request)
       override {
+    auto const idempotency =
+        idempotency_policy_->ListServiceAccountKeys(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->ListServiceAccountKeys(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::ListServiceAccountKeysRequest const&
-                   request) {
-          return stub_->ListServiceAccountKeys(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.ListServiceAccountKeys", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::ListServiceAccountKeysRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.ListServiceAccountKeys", request);
+              return stub_->ListServiceAccountKeys(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::ServiceAccountKey> GetServiceAccountKey(
       google::iam::admin::v1::GetServiceAccountKeyRequest const& request)
       override {
+    auto const idempotency = idempotency_policy_->GetServiceAccountKey(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetServiceAccountKey(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::GetServiceAccountKeyRequest const&
-                   request) {
-          return stub_->GetServiceAccountKey(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.GetServiceAccountKey", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::GetServiceAccountKeyRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.GetServiceAccountKey", request);
+              return stub_->GetServiceAccountKey(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::ServiceAccountKey> CreateServiceAccountKey(
       google::iam::admin::v1::CreateServiceAccountKeyRequest const& request)
       override {
+    auto const idempotency =
+        idempotency_policy_->CreateServiceAccountKey(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->CreateServiceAccountKey(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::CreateServiceAccountKeyRequest const&
-                   request) {
-          return stub_->CreateServiceAccountKey(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.CreateServiceAccountKey", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::CreateServiceAccountKeyRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.CreateServiceAccountKey",
+                  request);
+              return stub_->CreateServiceAccountKey(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::ServiceAccountKey> UploadServiceAccountKey(
       google::iam::admin::v1::UploadServiceAccountKeyRequest const& request)
       override {
+    auto const idempotency =
+        idempotency_policy_->UploadServiceAccountKey(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->UploadServiceAccountKey(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::UploadServiceAccountKeyRequest const&
-                   request) {
-          return stub_->UploadServiceAccountKey(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.UploadServiceAccountKey", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::UploadServiceAccountKeyRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.UploadServiceAccountKey",
+                  request);
+              return stub_->UploadServiceAccountKey(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   Status DeleteServiceAccountKey(
       google::iam::admin::v1::DeleteServiceAccountKeyRequest const& request)
       override {
+    auto const idempotency =
+        idempotency_policy_->DeleteServiceAccountKey(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->DeleteServiceAccountKey(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::DeleteServiceAccountKeyRequest const&
-                   request) {
-          return stub_->DeleteServiceAccountKey(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.DeleteServiceAccountKey", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::DeleteServiceAccountKeyRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.DeleteServiceAccountKey",
+                  request);
+              return stub_->DeleteServiceAccountKey(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::v1::Policy> GetIamPolicy(
       google::iam::v1::GetIamPolicyRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GetIamPolicy(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetIamPolicy(request),
-        [this](grpc::ClientContext& context,
-               google::iam::v1::GetIamPolicyRequest const& request) {
-          return stub_->GetIamPolicy(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.GetIamPolicy", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::v1::GetIamPolicyRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.GetIamPolicy", request);
+              return stub_->GetIamPolicy(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::v1::Policy> SetIamPolicy(
       google::iam::v1::SetIamPolicyRequest const& request) override {
+    auto const idempotency = idempotency_policy_->SetIamPolicy(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->SetIamPolicy(request),
-        [this](grpc::ClientContext& context,
-               google::iam::v1::SetIamPolicyRequest const& request) {
-          return stub_->SetIamPolicy(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.SetIamPolicy", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::v1::SetIamPolicyRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.SetIamPolicy", request);
+              return stub_->SetIamPolicy(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::v1::TestIamPermissionsResponse> TestIamPermissions(
       google::iam::v1::TestIamPermissionsRequest const& request) override {
+    auto const idempotency = idempotency_policy_->TestIamPermissions(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->TestIamPermissions(request),
-        [this](grpc::ClientContext& context,
-               google::iam::v1::TestIamPermissionsRequest const& request) {
-          return stub_->TestIamPermissions(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.TestIamPermissions", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::v1::TestIamPermissionsRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.TestIamPermissions", request);
+              return stub_->TestIamPermissions(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StreamRange<google::iam::admin::v1::Role> QueryGrantableRoles(
@@ -472,27 +598,31 @@ class IAMConnectionImpl : public IAMConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->QueryGrantableRoles(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<
         StreamRange<google::iam::admin::v1::Role>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name](
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name](
             google::iam::admin::v1::QueryGrantableRolesRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::iam::admin::v1::QueryGrantableRolesRequest const&
                          request) {
                 return stub->QueryGrantableRoles(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::iam::admin::v1::QueryGrantableRolesResponse r) {
           std::vector<google::iam::admin::v1::Role> result(r.roles().size());
           auto& messages = *r.mutable_roles();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StreamRange<google::iam::admin::v1::Role> ListRoles(
@@ -504,86 +634,125 @@ class IAMConnectionImpl : public IAMConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListRoles(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<
         StreamRange<google::iam::admin::v1::Role>>(
         std::move(request),
-        [stub, retry, backoff, idempotency,
+        [stub, retry, backoff, idempotency, attempt_timeout,
          function_name](google::iam::admin::v1::ListRolesRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::iam::admin::v1::ListRolesRequest const& request) {
                 return stub->ListRoles(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::iam::admin::v1::ListRolesResponse r) {
           std::vector<google::iam::admin::v1::Role> result(r.roles().size());
           auto& messages = *r.mutable_roles();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StatusOr<google::iam::admin::v1::Role> GetRole(
       google::iam::admin::v1::GetRoleRequest const& request) override {
+    auto const idempotency = idempotency_policy_->GetRole(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GetRole(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::GetRoleRequest const& request) {
-          return stub_->GetRole(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(hedging_delays_,
+                                                  "IAM.GetRole", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::GetRoleRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.GetRole", request);
+              return stub_->GetRole(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::Role> CreateRole(
       google::iam::admin::v1::CreateRoleRequest const& request) override {
+    auto const idempotency = idempotency_policy_->CreateRole(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->CreateRole(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::CreateRoleRequest const& request) {
-          return stub_->CreateRole(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.CreateRole", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::CreateRoleRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.CreateRole", request);
+              return stub_->CreateRole(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::Role> UpdateRole(
       google::iam::admin::v1::UpdateRoleRequest const& request) override {
+    auto const idempotency = idempotency_policy_->UpdateRole(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->UpdateRole(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::UpdateRoleRequest const& request) {
-          return stub_->UpdateRole(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.UpdateRole", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::UpdateRoleRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.UpdateRole", request);
+              return stub_->UpdateRole(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::Role> DeleteRole(
       google::iam::admin::v1::DeleteRoleRequest const& request) override {
+    auto const idempotency = idempotency_policy_->DeleteRole(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->DeleteRole(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::DeleteRoleRequest const& request) {
-          return stub_->DeleteRole(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.DeleteRole", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::DeleteRoleRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.DeleteRole", request);
+              return stub_->DeleteRole(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::Role> UndeleteRole(
       google::iam::admin::v1::UndeleteRoleRequest const& request) override {
+    auto const idempotency = idempotency_policy_->UndeleteRole(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->UndeleteRole(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::UndeleteRoleRequest const& request) {
-          return stub_->UndeleteRole(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.UndeleteRole", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::UndeleteRoleRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.UndeleteRole", request);
+              return stub_->UndeleteRole(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StreamRange<google::iam::admin::v1::Permission> QueryTestablePermissions(
@@ -596,21 +765,22 @@ class IAMConnectionImpl : public IAMConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->QueryTestablePermissions(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<
         StreamRange<google::iam::admin::v1::Permission>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name](
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name](
             google::iam::admin::v1::QueryTestablePermissionsRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](
                   grpc::ClientContext& context,
                   google::iam::admin::v1::QueryTestablePermissionsRequest const&
                       request) {
                 return stub->QueryTestablePermissions(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::iam::admin::v1::QueryTestablePermissionsResponse r) {
           std::vector<google::iam::admin::v1::Permission> result(
@@ -618,34 +788,52 @@ class IAMConnectionImpl : public IAMConnection {
           auto& messages = *r.mutable_permissions();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StatusOr<google::iam::admin::v1::QueryAuditableServicesResponse>
   QueryAuditableServices(
       google::iam::admin::v1::QueryAuditableServicesRequest const& request)
       override {
+    auto const idempotency =
+        idempotency_policy_->QueryAuditableServices(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->QueryAuditableServices(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::QueryAuditableServicesRequest const&
-                   request) {
-          return stub_->QueryAuditableServices(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.QueryAuditableServices", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::QueryAuditableServicesRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.QueryAuditableServices", request);
+              return stub_->QueryAuditableServices(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::admin::v1::LintPolicyResponse> LintPolicy(
       google::iam::admin::v1::LintPolicyRequest const& request) override {
+    auto const idempotency = idempotency_policy_->LintPolicy(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->LintPolicy(request),
-        [this](grpc::ClientContext& context,
-               google::iam::admin::v1::LintPolicyRequest const& request) {
-          return stub_->LintPolicy(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAM.LintPolicy", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::admin::v1::LintPolicyRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAM.LintPolicy", request);
+              return stub_->LintPolicy(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
  private:
@@ -653,6 +841,10 @@ class IAMConnectionImpl : public IAMConnection {
   std::shared_ptr<iam_internal::IAMStub> stub_;
   std::unique_ptr<IAMRetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
+  std::size_t page_prefetch_depth_;
+  std::chrono::milliseconds attempt_timeout_;
+  std::map<std::string, std::chrono::milliseconds> hedging_delays_;
+  std::map<std::string, std::size_t> compression_;
   std::unique_ptr<IAMConnectionIdempotencyPolicy> idempotency_policy_;
 };
 }  // namespace
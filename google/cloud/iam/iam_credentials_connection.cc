@@ -22,8 +22,12 @@
 #include "google/cloud/iam/internal/iam_credentials_stub_factory.h"
 #include "google/cloud/background_threads.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/grpc_compression.h"
+#include "google/cloud/internal/hedged_call.h"
 #include "google/cloud/internal/retry_loop.h"
+#include <map>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -69,6 +73,9 @@ class IAMCredentialsConnectionImpl : public IAMCredentialsConnection {
             options.get<IAMCredentialsRetryPolicyOption>()->clone()),
         backoff_policy_prototype_(
             options.get<IAMCredentialsBackoffPolicyOption>()->clone()),
+        attempt_timeout_(options.get<GrpcAttemptTimeoutOption>()),
+        hedging_delays_(options.get<GrpcHedgingDelayOption>()),
+        compression_(options.get<GrpcCompressionOption>()),
         idempotency_policy_(
             options.get<IAMCredentialsConnectionIdempotencyPolicyOption>()
                 ->clone()) {}
@@ -79,53 +86,87 @@ class IAMCredentialsConnectionImpl : public IAMCredentialsConnection {
   GenerateAccessToken(
       google::iam::credentials::v1::GenerateAccessTokenRequest const& request)
       override {
+    auto const idempotency = idempotency_policy_->GenerateAccessToken(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GenerateAccessToken(request),
-        [this](grpc::ClientContext& context,
-               google::iam::credentials::v1::GenerateAccessTokenRequest const&
-                   request) {
-          return stub_->GenerateAccessToken(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAMCredentials.GenerateAccessToken",
+                idempotency),
+            [this](
+                grpc::ClientContext& context,
+                google::iam::credentials::v1::GenerateAccessTokenRequest const&
+                    request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAMCredentials.GenerateAccessToken",
+                  request);
+              return stub_->GenerateAccessToken(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::credentials::v1::GenerateIdTokenResponse>
   GenerateIdToken(google::iam::credentials::v1::GenerateIdTokenRequest const&
                       request) override {
+    auto const idempotency = idempotency_policy_->GenerateIdToken(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->GenerateIdToken(request),
-        [this](grpc::ClientContext& context,
-               google::iam::credentials::v1::GenerateIdTokenRequest const&
-                   request) {
-          return stub_->GenerateIdToken(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAMCredentials.GenerateIdToken", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::iam::credentials::v1::GenerateIdTokenRequest const&
+                       request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAMCredentials.GenerateIdToken",
+                  request);
+              return stub_->GenerateIdToken(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::credentials::v1::SignBlobResponse> SignBlob(
       google::iam::credentials::v1::SignBlobRequest const& request) override {
+    auto const idempotency = idempotency_policy_->SignBlob(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->SignBlob(request),
-        [this](grpc::ClientContext& context,
-               google::iam::credentials::v1::SignBlobRequest const& request) {
-          return stub_->SignBlob(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAMCredentials.SignBlob", idempotency),
+            [this](
+                grpc::ClientContext& context,
+                google::iam::credentials::v1::SignBlobRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAMCredentials.SignBlob", request);
+              return stub_->SignBlob(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::iam::credentials::v1::SignJwtResponse> SignJwt(
       google::iam::credentials::v1::SignJwtRequest const& request) override {
+    auto const idempotency = idempotency_policy_->SignJwt(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->SignJwt(request),
-        [this](grpc::ClientContext& context,
-               google::iam::credentials::v1::SignJwtRequest const& request) {
-          return stub_->SignJwt(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "IAMCredentials.SignJwt", idempotency),
+            [this](
+                grpc::ClientContext& context,
+                google::iam::credentials::v1::SignJwtRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "IAMCredentials.SignJwt", request);
+              return stub_->SignJwt(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
  private:
@@ -133,6 +174,9 @@ class IAMCredentialsConnectionImpl : public IAMCredentialsConnection {
   std::shared_ptr<iam_internal::IAMCredentialsStub> stub_;
   std::unique_ptr<IAMCredentialsRetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
+  std::chrono::milliseconds attempt_timeout_;
+  std::map<std::string, std::chrono::milliseconds> hedging_delays_;
+  std::map<std::string, std::size_t> compression_;
   std::unique_ptr<IAMCredentialsConnectionIdempotencyPolicy>
       idempotency_policy_;
 };
@@ -65,8 +65,14 @@ IAMCredentialsMetadata::SignJwt(
 
 void IAMCredentialsMetadata::SetMetadata(grpc::ClientContext& context,
                                          std::string const& request_params) {
-  context.AddMetadata("x-goog-request-params", request_params);
-  context.AddMetadata("x-goog-api-client", api_client_header_);
+  context.AddMetadata(google::cloud::internal::RequestParamsKey(),
+                      request_params);
+  SetMetadata(context);
+}
+
+void IAMCredentialsMetadata::SetMetadata(grpc::ClientContext& context) {
+  context.AddMetadata(google::cloud::internal::ApiClientHeaderKey(),
+                      api_client_header_);
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
@@ -55,6 +55,7 @@ class IAMCredentialsMetadata : public IAMCredentialsStub {
  private:
   void SetMetadata(grpc::ClientContext& context,
                    std::string const& request_params);
+  void SetMetadata(grpc::ClientContext& context);
   std::shared_ptr<IAMCredentialsStub> child_;
   std::string api_client_header_;
 };  // IAMCredentialsMetadata
@@ -0,0 +1,87 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/iam/credentials/v1/iamcredentials.proto
+#include "google/cloud/iam/internal/iam_credentials_metrics_decorator.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+#include "google/cloud/status_or.h"
+#include <google/iam/credentials/v1/iamcredentials.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace iam_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+IAMCredentialsMetrics::IAMCredentialsMetrics(
+    std::shared_ptr<IAMCredentialsStub> child,
+    std::shared_ptr<RpcMetrics> metrics)
+    : child_(std::move(child)), metrics_(std::move(metrics)) {}
+
+StatusOr<google::iam::credentials::v1::GenerateAccessTokenResponse>
+IAMCredentialsMetrics::GenerateAccessToken(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::GenerateAccessTokenRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::credentials::v1::GenerateAccessTokenRequest const&
+                 request) {
+        return child_->GenerateAccessToken(context, request);
+      },
+      context, request, metrics_->Method("IAMCredentials.GenerateAccessToken"));
+}
+
+StatusOr<google::iam::credentials::v1::GenerateIdTokenResponse>
+IAMCredentialsMetrics::GenerateIdToken(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::GenerateIdTokenRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::credentials::v1::GenerateIdTokenRequest const& request) {
+        return child_->GenerateIdToken(context, request);
+      },
+      context, request, metrics_->Method("IAMCredentials.GenerateIdToken"));
+}
+
+StatusOr<google::iam::credentials::v1::SignBlobResponse>
+IAMCredentialsMetrics::SignBlob(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::SignBlobRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::credentials::v1::SignBlobRequest const& request) {
+        return child_->SignBlob(context, request);
+      },
+      context, request, metrics_->Method("IAMCredentials.SignBlob"));
+}
+
+StatusOr<google::iam::credentials::v1::SignJwtResponse>
+IAMCredentialsMetrics::SignJwt(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::SignJwtRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::credentials::v1::SignJwtRequest const& request) {
+        return child_->SignJwt(context, request);
+      },
+      context, request, metrics_->Method("IAMCredentials.SignJwt"));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,77 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/iam/credentials/v1/iamcredentials.proto
+#include "google/cloud/iam/internal/iam_credentials_round_robin_decorator.h"
+#include "google/cloud/status_or.h"
+#include <google/iam/credentials/v1/iamcredentials.grpc.pb.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace iam_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+IAMCredentialsRoundRobin::IAMCredentialsRoundRobin(
+    std::vector<std::shared_ptr<IAMCredentialsStub>> children,
+    std::shared_ptr<google::cloud::internal::ChannelPicker> picker)
+    : children_(std::move(children)), picker_(std::move(picker)) {}
+
+StatusOr<google::iam::credentials::v1::GenerateAccessTokenResponse>
+IAMCredentialsRoundRobin::GenerateAccessToken(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::GenerateAccessTokenRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GenerateAccessToken(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::credentials::v1::GenerateIdTokenResponse>
+IAMCredentialsRoundRobin::GenerateIdToken(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::GenerateIdTokenRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GenerateIdToken(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::credentials::v1::SignBlobResponse>
+IAMCredentialsRoundRobin::SignBlob(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::SignBlobRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->SignBlob(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::credentials::v1::SignJwtResponse>
+IAMCredentialsRoundRobin::SignJwt(
+    grpc::ClientContext& context,
+    google::iam::credentials::v1::SignJwtRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->SignJwt(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam_internal
+}  // namespace cloud
+}  // namespace google
@@ -156,14 +156,14 @@ StatusOr<google::iam::admin::v1::QueryGrantableRolesResponse>
 IAMMetadata::QueryGrantableRoles(
     grpc::ClientContext& context,
     google::iam::admin::v1::QueryGrantableRolesRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->QueryGrantableRoles(context, request);
 }
 
 StatusOr<google::iam::admin::v1::ListRolesResponse> IAMMetadata::ListRoles(
     grpc::ClientContext& context,
     google::iam::admin::v1::ListRolesRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->ListRoles(context, request);
 }
 
@@ -206,7 +206,7 @@ StatusOr<google::iam::admin::v1::QueryTestablePermissionsResponse>
 IAMMetadata::QueryTestablePermissions(
     grpc::ClientContext& context,
     google::iam::admin::v1::QueryTestablePermissionsRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->QueryTestablePermissions(context, request);
 }
 
@@ -214,21 +214,27 @@ StatusOr<google::iam::admin::v1::QueryAuditableServicesResponse>
 IAMMetadata::QueryAuditableServices(
     grpc::ClientContext& context,
     google::iam::admin::v1::QueryAuditableServicesRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->QueryAuditableServices(context, request);
 }
 
 StatusOr<google::iam::admin::v1::LintPolicyResponse> IAMMetadata::LintPolicy(
     grpc::ClientContext& context,
     google::iam::admin::v1::LintPolicyRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->LintPolicy(context, request);
 }
 
 void IAMMetadata::SetMetadata(grpc::ClientContext& context,
                               std::string const& request_params) {
-  context.AddMetadata("x-goog-request-params", request_params);
-  context.AddMetadata("x-goog-api-client", api_client_header_);
+  context.AddMetadata(google::cloud::internal::RequestParamsKey(),
+                      request_params);
+  SetMetadata(context);
+}
+
+void IAMMetadata::SetMetadata(grpc::ClientContext& context) {
+  context.AddMetadata(google::cloud::internal::ApiClientHeaderKey(),
+                      api_client_header_);
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
@@ -159,6 +159,7 @@ class IAMMetadata : public IAMStub {
  private:
   void SetMetadata(grpc::ClientContext& context,
                    std::string const& request_params);
+  void SetMetadata(grpc::ClientContext& context);
   std::shared_ptr<IAMStub> child_;
   std::string api_client_header_;
 };  // IAMMetadata
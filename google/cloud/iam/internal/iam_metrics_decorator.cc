@@ -0,0 +1,349 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/iam/admin/v1/iam.proto
+#include "google/cloud/iam/internal/iam_metrics_decorator.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+#include "google/cloud/status_or.h"
+#include <google/iam/admin/v1/iam.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace iam_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+IAMMetrics::IAMMetrics(std::shared_ptr<IAMStub> child,
+                       std::shared_ptr<RpcMetrics> metrics)
+    : child_(std::move(child)), metrics_(std::move(metrics)) {}
+
+StatusOr<google::iam::admin::v1::ListServiceAccountsResponse>
+IAMMetrics::ListServiceAccounts(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::ListServiceAccountsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::ListServiceAccountsRequest const& request) {
+        return child_->ListServiceAccounts(context, request);
+      },
+      context, request, metrics_->Method("IAM.ListServiceAccounts"));
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccount> IAMMetrics::GetServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::GetServiceAccountRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::GetServiceAccountRequest const& request) {
+        return child_->GetServiceAccount(context, request);
+      },
+      context, request, metrics_->Method("IAM.GetServiceAccount"));
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccount>
+IAMMetrics::CreateServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::CreateServiceAccountRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::CreateServiceAccountRequest const& request) {
+        return child_->CreateServiceAccount(context, request);
+      },
+      context, request, metrics_->Method("IAM.CreateServiceAccount"));
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccount>
+IAMMetrics::PatchServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::PatchServiceAccountRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::PatchServiceAccountRequest const& request) {
+        return child_->PatchServiceAccount(context, request);
+      },
+      context, request, metrics_->Method("IAM.PatchServiceAccount"));
+}
+
+Status IAMMetrics::DeleteServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DeleteServiceAccountRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::DeleteServiceAccountRequest const& request) {
+        return child_->DeleteServiceAccount(context, request);
+      },
+      context, request, metrics_->Method("IAM.DeleteServiceAccount"));
+}
+
+StatusOr<google::iam::admin::v1::UndeleteServiceAccountResponse>
+IAMMetrics::UndeleteServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UndeleteServiceAccountRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::UndeleteServiceAccountRequest const&
+                 request) {
+        return child_->UndeleteServiceAccount(context, request);
+      },
+      context, request, metrics_->Method("IAM.UndeleteServiceAccount"));
+}
+
+Status IAMMetrics::EnableServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::EnableServiceAccountRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::EnableServiceAccountRequest const& request) {
+        return child_->EnableServiceAccount(context, request);
+      },
+      context, request, metrics_->Method("IAM.EnableServiceAccount"));
+}
+
+Status IAMMetrics::DisableServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DisableServiceAccountRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::DisableServiceAccountRequest const& request) {
+        return child_->DisableServiceAccount(context, request);
+      },
+      context, request, metrics_->Method("IAM.DisableServiceAccount"));
+}
+
+StatusOr<google::iam::admin::v1::ListServiceAccountKeysResponse>
+IAMMetrics::ListServiceAccountKeys(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::ListServiceAccountKeysRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::ListServiceAccountKeysRequest const&
+                 request) {
+        return child_->ListServiceAccountKeys(context, request);
+      },
+      context, request, metrics_->Method("IAM.ListServiceAccountKeys"));
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccountKey>
+IAMMetrics::GetServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::GetServiceAccountKeyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::GetServiceAccountKeyRequest const& request) {
+        return child_->GetServiceAccountKey(context, request);
+      },
+      context, request, metrics_->Method("IAM.GetServiceAccountKey"));
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccountKey>
+IAMMetrics::CreateServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::CreateServiceAccountKeyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::CreateServiceAccountKeyRequest const&
+                 request) {
+        return child_->CreateServiceAccountKey(context, request);
+      },
+      context, request, metrics_->Method("IAM.CreateServiceAccountKey"));
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccountKey>
+IAMMetrics::UploadServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UploadServiceAccountKeyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::UploadServiceAccountKeyRequest const&
+                 request) {
+        return child_->UploadServiceAccountKey(context, request);
+      },
+      context, request, metrics_->Method("IAM.UploadServiceAccountKey"));
+}
+
+Status IAMMetrics::DeleteServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DeleteServiceAccountKeyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::DeleteServiceAccountKeyRequest const&
+                 request) {
+        return child_->DeleteServiceAccountKey(context, request);
+      },
+      context, request, metrics_->Method("IAM.DeleteServiceAccountKey"));
+}
+
+StatusOr<google::iam::v1::Policy> IAMMetrics::GetIamPolicy(
+    grpc::ClientContext& context,
+    google::iam::v1::GetIamPolicyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::v1::GetIamPolicyRequest const& request) {
+        return child_->GetIamPolicy(context, request);
+      },
+      context, request, metrics_->Method("IAM.GetIamPolicy"));
+}
+
+StatusOr<google::iam::v1::Policy> IAMMetrics::SetIamPolicy(
+    grpc::ClientContext& context,
+    google::iam::v1::SetIamPolicyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::v1::SetIamPolicyRequest const& request) {
+        return child_->SetIamPolicy(context, request);
+      },
+      context, request, metrics_->Method("IAM.SetIamPolicy"));
+}
+
+StatusOr<google::iam::v1::TestIamPermissionsResponse>
+IAMMetrics::TestIamPermissions(
+    grpc::ClientContext& context,
+    google::iam::v1::TestIamPermissionsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::v1::TestIamPermissionsRequest const& request) {
+        return child_->TestIamPermissions(context, request);
+      },
+      context, request, metrics_->Method("IAM.TestIamPermissions"));
+}
+
+StatusOr<google::iam::admin::v1::QueryGrantableRolesResponse>
+IAMMetrics::QueryGrantableRoles(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::QueryGrantableRolesRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](
+          grpc::ClientContext& context,
+          google::iam::admin::v1::QueryGrantableRolesRequest const& request) {
+        return child_->QueryGrantableRoles(context, request);
+      },
+      context, request, metrics_->Method("IAM.QueryGrantableRoles"));
+}
+
+StatusOr<google::iam::admin::v1::ListRolesResponse> IAMMetrics::ListRoles(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::ListRolesRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::ListRolesRequest const& request) {
+        return child_->ListRoles(context, request);
+      },
+      context, request, metrics_->Method("IAM.ListRoles"));
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMMetrics::GetRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::GetRoleRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::GetRoleRequest const& request) {
+        return child_->GetRole(context, request);
+      },
+      context, request, metrics_->Method("IAM.GetRole"));
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMMetrics::CreateRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::CreateRoleRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::CreateRoleRequest const& request) {
+        return child_->CreateRole(context, request);
+      },
+      context, request, metrics_->Method("IAM.CreateRole"));
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMMetrics::UpdateRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UpdateRoleRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::UpdateRoleRequest const& request) {
+        return child_->UpdateRole(context, request);
+      },
+      context, request, metrics_->Method("IAM.UpdateRole"));
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMMetrics::DeleteRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DeleteRoleRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::DeleteRoleRequest const& request) {
+        return child_->DeleteRole(context, request);
+      },
+      context, request, metrics_->Method("IAM.DeleteRole"));
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMMetrics::UndeleteRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UndeleteRoleRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::UndeleteRoleRequest const& request) {
+        return child_->UndeleteRole(context, request);
+      },
+      context, request, metrics_->Method("IAM.UndeleteRole"));
+}
+
+StatusOr<google::iam::admin::v1::QueryTestablePermissionsResponse>
+IAMMetrics::QueryTestablePermissions(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::QueryTestablePermissionsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::QueryTestablePermissionsRequest const&
+                 request) {
+        return child_->QueryTestablePermissions(context, request);
+      },
+      context, request, metrics_->Method("IAM.QueryTestablePermissions"));
+}
+
+StatusOr<google::iam::admin::v1::QueryAuditableServicesResponse>
+IAMMetrics::QueryAuditableServices(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::QueryAuditableServicesRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::QueryAuditableServicesRequest const&
+                 request) {
+        return child_->QueryAuditableServices(context, request);
+      },
+      context, request, metrics_->Method("IAM.QueryAuditableServices"));
+}
+
+StatusOr<google::iam::admin::v1::LintPolicyResponse> IAMMetrics::LintPolicy(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::LintPolicyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::iam::admin::v1::LintPolicyRequest const& request) {
+        return child_->LintPolicy(context, request);
+      },
+      context, request, metrics_->Method("IAM.LintPolicy"));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,284 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/iam/admin/v1/iam.proto
+#include "google/cloud/iam/internal/iam_round_robin_decorator.h"
+#include "google/cloud/status_or.h"
+#include <google/iam/admin/v1/iam.grpc.pb.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace iam_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+IAMRoundRobin::IAMRoundRobin(
+    std::vector<std::shared_ptr<IAMStub>> children,
+    std::shared_ptr<google::cloud::internal::ChannelPicker> picker)
+    : children_(std::move(children)), picker_(std::move(picker)) {}
+
+StatusOr<google::iam::admin::v1::ListServiceAccountsResponse>
+IAMRoundRobin::ListServiceAccounts(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::ListServiceAccountsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListServiceAccounts(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccount>
+IAMRoundRobin::GetServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::GetServiceAccountRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetServiceAccount(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccount>
+IAMRoundRobin::CreateServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::CreateServiceAccountRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->CreateServiceAccount(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccount>
+IAMRoundRobin::PatchServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::PatchServiceAccountRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->PatchServiceAccount(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+Status IAMRoundRobin::DeleteServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DeleteServiceAccountRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->DeleteServiceAccount(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::UndeleteServiceAccountResponse>
+IAMRoundRobin::UndeleteServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UndeleteServiceAccountRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->UndeleteServiceAccount(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+Status IAMRoundRobin::EnableServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::EnableServiceAccountRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->EnableServiceAccount(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+Status IAMRoundRobin::DisableServiceAccount(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DisableServiceAccountRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->DisableServiceAccount(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ListServiceAccountKeysResponse>
+IAMRoundRobin::ListServiceAccountKeys(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::ListServiceAccountKeysRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListServiceAccountKeys(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccountKey>
+IAMRoundRobin::GetServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::GetServiceAccountKeyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetServiceAccountKey(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccountKey>
+IAMRoundRobin::CreateServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::CreateServiceAccountKeyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->CreateServiceAccountKey(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ServiceAccountKey>
+IAMRoundRobin::UploadServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UploadServiceAccountKeyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->UploadServiceAccountKey(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+Status IAMRoundRobin::DeleteServiceAccountKey(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DeleteServiceAccountKeyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->DeleteServiceAccountKey(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::v1::Policy> IAMRoundRobin::GetIamPolicy(
+    grpc::ClientContext& context,
+    google::iam::v1::GetIamPolicyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetIamPolicy(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::v1::Policy> IAMRoundRobin::SetIamPolicy(
+    grpc::ClientContext& context,
+    google::iam::v1::SetIamPolicyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->SetIamPolicy(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::v1::TestIamPermissionsResponse>
+IAMRoundRobin::TestIamPermissions(
+    grpc::ClientContext& context,
+    google::iam::v1::TestIamPermissionsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->TestIamPermissions(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::QueryGrantableRolesResponse>
+IAMRoundRobin::QueryGrantableRoles(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::QueryGrantableRolesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->QueryGrantableRoles(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::ListRolesResponse> IAMRoundRobin::ListRoles(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::ListRolesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListRoles(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMRoundRobin::GetRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::GetRoleRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->GetRole(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMRoundRobin::CreateRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::CreateRoleRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->CreateRole(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMRoundRobin::UpdateRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UpdateRoleRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->UpdateRole(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMRoundRobin::DeleteRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::DeleteRoleRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->DeleteRole(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::Role> IAMRoundRobin::UndeleteRole(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::UndeleteRoleRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->UndeleteRole(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::QueryTestablePermissionsResponse>
+IAMRoundRobin::QueryTestablePermissions(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::QueryTestablePermissionsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->QueryTestablePermissions(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::QueryAuditableServicesResponse>
+IAMRoundRobin::QueryAuditableServices(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::QueryAuditableServicesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->QueryAuditableServices(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::iam::admin::v1::LintPolicyResponse> IAMRoundRobin::LintPolicy(
+    grpc::ClientContext& context,
+    google::iam::admin::v1::LintPolicyRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->LintPolicy(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam_internal
+}  // namespace cloud
+}  // namespace google
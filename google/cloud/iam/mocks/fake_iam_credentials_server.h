@@ -0,0 +1,127 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/iam/credentials/v1/iamcredentials.proto
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_MOCKS_FAKE_IAM_CREDENTIALS_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_MOCKS_FAKE_IAM_CREDENTIALS_SERVER_H
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include "google/cloud/version.h"
+#include <google/iam/credentials/v1/iamcredentials.grpc.pb.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace iam_mocks {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * An in-process fake for `IAMCredentials`.
+ *
+ * Register this class with a `testing_util::EmbeddedGrpcServer` to
+ * benchmark or test the client library with the full gRPC stack. Each RPC
+ * simulates the latency and errors configured in its
+ * `testing_util::FakeServerBehavior`, and returns a canned response, which
+ * includes a payload of the configured size.
+ *
+ * The canned responses must be changed before the server starts.
+ */
+class FakeIAMCredentialsServer
+    : public google::iam::credentials::v1::IAMCredentials::Service {
+ public:
+  explicit FakeIAMCredentialsServer(testing_util::FakeServerConfig config = {})
+      : behavior_(std::move(config)) {
+    behavior_.FillPayload(generate_access_token_response_);
+    behavior_.FillPayload(generate_id_token_response_);
+    behavior_.FillPayload(sign_blob_response_);
+    behavior_.FillPayload(sign_jwt_response_);
+  }
+
+  testing_util::FakeServerBehavior& behavior() { return behavior_; }
+
+  void set_generate_access_token_response(
+      google::iam::credentials::v1::GenerateAccessTokenResponse response) {
+    generate_access_token_response_ = std::move(response);
+  }
+
+  grpc::Status GenerateAccessToken(
+      grpc::ServerContext*,
+      google::iam::credentials::v1::GenerateAccessTokenRequest const*,
+      google::iam::credentials::v1::GenerateAccessTokenResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = generate_access_token_response_;
+    return status;
+  }
+
+  void set_generate_id_token_response(
+      google::iam::credentials::v1::GenerateIdTokenResponse response) {
+    generate_id_token_response_ = std::move(response);
+  }
+
+  grpc::Status GenerateIdToken(
+      grpc::ServerContext*,
+      google::iam::credentials::v1::GenerateIdTokenRequest const*,
+      google::iam::credentials::v1::GenerateIdTokenResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = generate_id_token_response_;
+    return status;
+  }
+
+  void set_sign_blob_response(
+      google::iam::credentials::v1::SignBlobResponse response) {
+    sign_blob_response_ = std::move(response);
+  }
+
+  grpc::Status SignBlob(
+      grpc::ServerContext*,
+      google::iam::credentials::v1::SignBlobRequest const*,
+      google::iam::credentials::v1::SignBlobResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = sign_blob_response_;
+    return status;
+  }
+
+  void set_sign_jwt_response(
+      google::iam::credentials::v1::SignJwtResponse response) {
+    sign_jwt_response_ = std::move(response);
+  }
+
+  grpc::Status SignJwt(
+      grpc::ServerContext*, google::iam::credentials::v1::SignJwtRequest const*,
+      google::iam::credentials::v1::SignJwtResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = sign_jwt_response_;
+    return status;
+  }
+
+ private:
+  testing_util::FakeServerBehavior behavior_;
+  google::iam::credentials::v1::GenerateAccessTokenResponse
+      generate_access_token_response_;
+  google::iam::credentials::v1::GenerateIdTokenResponse
+      generate_id_token_response_;
+  google::iam::credentials::v1::SignBlobResponse sign_blob_response_;
+  google::iam::credentials::v1::SignJwtResponse sign_jwt_response_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam_mocks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_MOCKS_FAKE_IAM_CREDENTIALS_SERVER_H
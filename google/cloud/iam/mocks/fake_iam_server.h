@@ -0,0 +1,467 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/iam/admin/v1/iam.proto
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_MOCKS_FAKE_IAM_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_MOCKS_FAKE_IAM_SERVER_H
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include "google/cloud/version.h"
+#include <google/iam/admin/v1/iam.grpc.pb.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace iam_mocks {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * An in-process fake for `IAM`.
+ *
+ * Register this class with a `testing_util::EmbeddedGrpcServer` to
+ * benchmark or test the client library with the full gRPC stack. Each RPC
+ * simulates the latency and errors configured in its
+ * `testing_util::FakeServerBehavior`, and returns a canned response, which
+ * includes a payload of the configured size.
+ *
+ * The canned responses must be changed before the server starts.
+ */
+class FakeIAMServer : public google::iam::admin::v1::IAM::Service {
+ public:
+  explicit FakeIAMServer(testing_util::FakeServerConfig config = {})
+      : behavior_(std::move(config)) {
+    behavior_.FillPayload(list_service_accounts_response_);
+    behavior_.FillPayload(get_service_account_response_);
+    behavior_.FillPayload(create_service_account_response_);
+    behavior_.FillPayload(patch_service_account_response_);
+    behavior_.FillPayload(delete_service_account_response_);
+    behavior_.FillPayload(undelete_service_account_response_);
+    behavior_.FillPayload(enable_service_account_response_);
+    behavior_.FillPayload(disable_service_account_response_);
+    behavior_.FillPayload(list_service_account_keys_response_);
+    behavior_.FillPayload(get_service_account_key_response_);
+    behavior_.FillPayload(create_service_account_key_response_);
+    behavior_.FillPayload(upload_service_account_key_response_);
+    behavior_.FillPayload(delete_service_account_key_response_);
+    behavior_.FillPayload(get_iam_policy_response_);
+    behavior_.FillPayload(set_iam_policy_response_);
+    behavior_.FillPayload(test_iam_permissions_response_);
+    behavior_.FillPayload(query_grantable_roles_response_);
+    behavior_.FillPayload(list_roles_response_);
+    behavior_.FillPayload(get_role_response_);
+    behavior_.FillPayload(create_role_response_);
+    behavior_.FillPayload(update_role_response_);
+    behavior_.FillPayload(delete_role_response_);
+    behavior_.FillPayload(undelete_role_response_);
+    behavior_.FillPayload(query_testable_permissions_response_);
+    behavior_.FillPayload(query_auditable_services_response_);
+    behavior_.FillPayload(lint_policy_response_);
+  }
+
+  testing_util::FakeServerBehavior& behavior() { return behavior_; }
+
+  void set_list_service_accounts_response(
+      google::iam::admin::v1::ListServiceAccountsResponse response) {
+    list_service_accounts_response_ = std::move(response);
+  }
+
+  grpc::Status ListServiceAccounts(
+      grpc::ServerContext*,
+      google::iam::admin::v1::ListServiceAccountsRequest const*,
+      google::iam::admin::v1::ListServiceAccountsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_service_accounts_response_;
+    return status;
+  }
+
+  void set_get_service_account_response(
+      google::iam::admin::v1::ServiceAccount response) {
+    get_service_account_response_ = std::move(response);
+  }
+
+  grpc::Status GetServiceAccount(
+      grpc::ServerContext*,
+      google::iam::admin::v1::GetServiceAccountRequest const*,
+      google::iam::admin::v1::ServiceAccount* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_service_account_response_;
+    return status;
+  }
+
+  void set_create_service_account_response(
+      google::iam::admin::v1::ServiceAccount response) {
+    create_service_account_response_ = std::move(response);
+  }
+
+  grpc::Status CreateServiceAccount(
+      grpc::ServerContext*,
+      google::iam::admin::v1::CreateServiceAccountRequest const*,
+      google::iam::admin::v1::ServiceAccount* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = create_service_account_response_;
+    return status;
+  }
+
+  void set_patch_service_account_response(
+      google::iam::admin::v1::ServiceAccount response) {
+    patch_service_account_response_ = std::move(response);
+  }
+
+  grpc::Status PatchServiceAccount(
+      grpc::ServerContext*,
+      google::iam::admin::v1::PatchServiceAccountRequest const*,
+      google::iam::admin::v1::ServiceAccount* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = patch_service_account_response_;
+    return status;
+  }
+
+  void set_delete_service_account_response(google::protobuf::Empty response) {
+    delete_service_account_response_ = std::move(response);
+  }
+
+  grpc::Status DeleteServiceAccount(
+      grpc::ServerContext*,
+      google::iam::admin::v1::DeleteServiceAccountRequest const*,
+      google::protobuf::Empty* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = delete_service_account_response_;
+    return status;
+  }
+
+  void set_undelete_service_account_response(
+      google::iam::admin::v1::UndeleteServiceAccountResponse response) {
+    undelete_service_account_response_ = std::move(response);
+  }
+
+  grpc::Status UndeleteServiceAccount(
+      grpc::ServerContext*,
+      google::iam::admin::v1::UndeleteServiceAccountRequest const*,
+      google::iam::admin::v1::UndeleteServiceAccountResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = undelete_service_account_response_;
+    return status;
+  }
+
+  void set_enable_service_account_response(google::protobuf::Empty response) {
+    enable_service_account_response_ = std::move(response);
+  }
+
+  grpc::Status EnableServiceAccount(
+      grpc::ServerContext*,
+      google::iam::admin::v1::EnableServiceAccountRequest const*,
+      google::protobuf::Empty* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = enable_service_account_response_;
+    return status;
+  }
+
+  void set_disable_service_account_response(google::protobuf::Empty response) {
+    disable_service_account_response_ = std::move(response);
+  }
+
+  grpc::Status DisableServiceAccount(
+      grpc::ServerContext*,
+      google::iam::admin::v1::DisableServiceAccountRequest const*,
+      google::protobuf::Empty* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = disable_service_account_response_;
+    return status;
+  }
+
+  void set_list_service_account_keys_response(
+      google::iam::admin::v1::ListServiceAccountKeysResponse response) {
+    list_service_account_keys_response_ = std::move(response);
+  }
+
+  grpc::Status ListServiceAccountKeys(
+      grpc::ServerContext*,
+      google::iam::admin::v1::ListServiceAccountKeysRequest const*,
+      google::iam::admin::v1::ListServiceAccountKeysResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_service_account_keys_response_;
+    return status;
+  }
+
+  void set_get_service_account_key_response(
+      google::iam::admin::v1::ServiceAccountKey response) {
+    get_service_account_key_response_ = std::move(response);
+  }
+
+  grpc::Status GetServiceAccountKey(
+      grpc::ServerContext*,
+      google::iam::admin::v1::GetServiceAccountKeyRequest const*,
+      google::iam::admin::v1::ServiceAccountKey* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_service_account_key_response_;
+    return status;
+  }
+
+  void set_create_service_account_key_response(
+      google::iam::admin::v1::ServiceAccountKey response) {
+    create_service_account_key_response_ = std::move(response);
+  }
+
+  grpc::Status CreateServiceAccountKey(
+      grpc::ServerContext*,
+      google::iam::admin::v1::CreateServiceAccountKeyRequest const*,
+      google::iam::admin::v1::ServiceAccountKey* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = create_service_account_key_response_;
+    return status;
+  }
+
+  void set_upload_service_account_key_response(
+      google::iam::admin::v1::ServiceAccountKey response) {
+    upload_service_account_key_response_ = std::move(response);
+  }
+
+  grpc::Status UploadServiceAccountKey(
+      grpc::ServerContext*,
+      google::iam::admin::v1::UploadServiceAccountKeyRequest const*,
+      google::iam::admin::v1::ServiceAccountKey* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = upload_service_account_key_response_;
+    return status;
+  }
+
+  void set_delete_service_account_key_response(
+      google::protobuf::Empty response) {
+    delete_service_account_key_response_ = std::move(response);
+  }
+
+  grpc::Status DeleteServiceAccountKey(
+      grpc::ServerContext*,
+      google::iam::admin::v1::DeleteServiceAccountKeyRequest const*,
+      google::protobuf::Empty* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = delete_service_account_key_response_;
+    return status;
+  }
+
+  void set_get_iam_policy_response(google::iam::v1::Policy response) {
+    get_iam_policy_response_ = std::move(response);
+  }
+
+  grpc::Status GetIamPolicy(grpc::ServerContext*,
+                            google::iam::v1::GetIamPolicyRequest const*,
+                            google::iam::v1::Policy* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_iam_policy_response_;
+    return status;
+  }
+
+  void set_set_iam_policy_response(google::iam::v1::Policy response) {
+    set_iam_policy_response_ = std::move(response);
+  }
+
+  grpc::Status SetIamPolicy(grpc::ServerContext*,
+                            google::iam::v1::SetIamPolicyRequest const*,
+                            google::iam::v1::Policy* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = set_iam_policy_response_;
+    return status;
+  }
+
+  void set_test_iam_permissions_response(
+      google::iam::v1::TestIamPermissionsResponse response) {
+    test_iam_permissions_response_ = std::move(response);
+  }
+
+  grpc::Status TestIamPermissions(
+      grpc::ServerContext*, google::iam::v1::TestIamPermissionsRequest const*,
+      google::iam::v1::TestIamPermissionsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = test_iam_permissions_response_;
+    return status;
+  }
+
+  void set_query_grantable_roles_response(
+      google::iam::admin::v1::QueryGrantableRolesResponse response) {
+    query_grantable_roles_response_ = std::move(response);
+  }
+
+  grpc::Status QueryGrantableRoles(
+      grpc::ServerContext*,
+      google::iam::admin::v1::QueryGrantableRolesRequest const*,
+      google::iam::admin::v1::QueryGrantableRolesResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = query_grantable_roles_response_;
+    return status;
+  }
+
+  void set_list_roles_response(
+      google::iam::admin::v1::ListRolesResponse response) {
+    list_roles_response_ = std::move(response);
+  }
+
+  grpc::Status ListRoles(
+      grpc::ServerContext*, google::iam::admin::v1::ListRolesRequest const*,
+      google::iam::admin::v1::ListRolesResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_roles_response_;
+    return status;
+  }
+
+  void set_get_role_response(google::iam::admin::v1::Role response) {
+    get_role_response_ = std::move(response);
+  }
+
+  grpc::Status GetRole(grpc::ServerContext*,
+                       google::iam::admin::v1::GetRoleRequest const*,
+                       google::iam::admin::v1::Role* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = get_role_response_;
+    return status;
+  }
+
+  void set_create_role_response(google::iam::admin::v1::Role response) {
+    create_role_response_ = std::move(response);
+  }
+
+  grpc::Status CreateRole(grpc::ServerContext*,
+                          google::iam::admin::v1::CreateRoleRequest const*,
+                          google::iam::admin::v1::Role* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = create_role_response_;
+    return status;
+  }
+
+  void set_update_role_response(google::iam::admin::v1::Role response) {
+    update_role_response_ = std::move(response);
+  }
+
+  grpc::Status UpdateRole(grpc::ServerContext*,
+                          google::iam::admin::v1::UpdateRoleRequest const*,
+                          google::iam::admin::v1::Role* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = update_role_response_;
+    return status;
+  }
+
+  void set_delete_role_response(google::iam::admin::v1::Role response) {
+    delete_role_response_ = std::move(response);
+  }
+
+  grpc::Status DeleteRole(grpc::ServerContext*,
+                          google::iam::admin::v1::DeleteRoleRequest const*,
+                          google::iam::admin::v1::Role* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = delete_role_response_;
+    return status;
+  }
+
+  void set_undelete_role_response(google::iam::admin::v1::Role response) {
+    undelete_role_response_ = std::move(response);
+  }
+
+  grpc::Status UndeleteRole(grpc::ServerContext*,
+                            google::iam::admin::v1::UndeleteRoleRequest const*,
+                            google::iam::admin::v1::Role* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = undelete_role_response_;
+    return status;
+  }
+
+  void set_query_testable_permissions_response(
+      google::iam::admin::v1::QueryTestablePermissionsResponse response) {
+    query_testable_permissions_response_ = std::move(response);
+  }
+
+  grpc::Status QueryTestablePermissions(
+      grpc::ServerContext*,
+      google::iam::admin::v1::QueryTestablePermissionsRequest const*,
+      google::iam::admin::v1::QueryTestablePermissionsResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = query_testable_permissions_response_;
+    return status;
+  }
+
+  void set_query_auditable_services_response(
+      google::iam::admin::v1::QueryAuditableServicesResponse response) {
+    query_auditable_services_response_ = std::move(response);
+  }
+
+  grpc::Status QueryAuditableServices(
+      grpc::ServerContext*,
+      google::iam::admin::v1::QueryAuditableServicesRequest const*,
+      google::iam::admin::v1::QueryAuditableServicesResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = query_auditable_services_response_;
+    return status;
+  }
+
+  void set_lint_policy_response(
+      google::iam::admin::v1::LintPolicyResponse response) {
+    lint_policy_response_ = std::move(response);
+  }
+
+  grpc::Status LintPolicy(
+      grpc::ServerContext*, google::iam::admin::v1::LintPolicyRequest const*,
+      google::iam::admin::v1::LintPolicyResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = lint_policy_response_;
+    return status;
+  }
+
+ private:
+  testing_util::FakeServerBehavior behavior_;
+  google::iam::admin::v1::ListServiceAccountsResponse
+      list_service_accounts_response_;
+  google::iam::admin::v1::ServiceAccount get_service_account_response_;
+  google::iam::admin::v1::ServiceAccount create_service_account_response_;
+  google::iam::admin::v1::ServiceAccount patch_service_account_response_;
+  google::protobuf::Empty delete_service_account_response_;
+  google::iam::admin::v1::UndeleteServiceAccountResponse
+      undelete_service_account_response_;
+  google::protobuf::Empty enable_service_account_response_;
+  google::protobuf::Empty disable_service_account_response_;
+  google::iam::admin::v1::ListServiceAccountKeysResponse
+      list_service_account_keys_response_;
+  google::iam::admin::v1::ServiceAccountKey get_service_account_key_response_;
+  google::iam::admin::v1::ServiceAccountKey
+      create_service_account_key_response_;
+  google::iam::admin::v1::ServiceAccountKey
+      upload_service_account_key_response_;
+  google::protobuf::Empty delete_service_account_key_response_;
+  google::iam::v1::Policy get_iam_policy_response_;
+  google::iam::v1::Policy set_iam_policy_response_;
+  google::iam::v1::TestIamPermissionsResponse test_iam_permissions_response_;
+  google::iam::admin::v1::QueryGrantableRolesResponse
+      query_grantable_roles_response_;
+  google::iam::admin::v1::ListRolesResponse list_roles_response_;
+  google::iam::admin::v1::Role get_role_response_;
+  google::iam::admin::v1::Role create_role_response_;
+  google::iam::admin::v1::Role update_role_response_;
+  google::iam::admin::v1::Role delete_role_response_;
+  google::iam::admin::v1::Role undelete_role_response_;
+  google::iam::admin::v1::QueryTestablePermissionsResponse
+      query_testable_permissions_response_;
+  google::iam::admin::v1::QueryAuditableServicesResponse
+      query_auditable_services_response_;
+  google::iam::admin::v1::LintPolicyResponse lint_policy_response_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace iam_mocks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_MOCKS_FAKE_IAM_SERVER_H
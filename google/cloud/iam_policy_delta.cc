@@ -0,0 +1,152 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/iam_policy_delta.h"
+#include "absl/strings/string_view.h"
+#include <algorithm>
+#include <utility>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+// Views into the members of the unconditional bindings, without copies.
+using MemberViews = std::map<absl::string_view, std::set<absl::string_view>>;
+
+MemberViews UnconditionalMembers(google::iam::v1::Policy const& policy) {
+  MemberViews result;
+  for (auto const& b : policy.bindings()) {
+    if (b.has_condition()) continue;
+    auto& members = result[b.role()];
+    members.insert(b.members().begin(), b.members().end());
+  }
+  return result;
+}
+
+}  // namespace
+
+IamPolicyDelta IamPolicyDelta::Diff(google::iam::v1::Policy const& from,
+                                    google::iam::v1::Policy const& to) {
+  IamPolicyDelta delta;
+  auto const old_members = UnconditionalMembers(from);
+  auto const new_members = UnconditionalMembers(to);
+  std::set<absl::string_view> const empty;
+  auto members = [&empty](MemberViews const& m, absl::string_view role)
+      -> std::set<absl::string_view> const& {
+    auto const l = m.find(role);
+    return l == m.end() ? empty : l->second;
+  };
+  auto diff = [](std::set<absl::string_view> const& a,
+                 std::set<absl::string_view> const& b, std::string const& role,
+                 Members& out) {
+    for (auto const& m : a) {
+      if (b.count(m) == 0) out[role].insert(std::string(m));
+    }
+  };
+  for (auto const& kv : new_members) {
+    diff(kv.second, members(old_members, kv.first), std::string(kv.first),
+         delta.additions_);
+  }
+  for (auto const& kv : old_members) {
+    diff(kv.second, members(new_members, kv.first), std::string(kv.first),
+         delta.removals_);
+  }
+  return delta;
+}
+
+IamPolicyDelta& IamPolicyDelta::AddMember(std::string const& role,
+                                          std::string member) {
+  auto const l = removals_.find(role);
+  if (l != removals_.end() && l->second.erase(member) != 0) {
+    if (l->second.empty()) removals_.erase(l);
+    return *this;
+  }
+  additions_[role].insert(std::move(member));
+  return *this;
+}
+
+IamPolicyDelta& IamPolicyDelta::RemoveMember(std::string const& role,
+                                             std::string member) {
+  auto const l = additions_.find(role);
+  if (l != additions_.end() && l->second.erase(member) != 0) {
+    if (l->second.empty()) additions_.erase(l);
+    return *this;
+  }
+  removals_[role].insert(std::move(member));
+  return *this;
+}
+
+bool IamPolicyDelta::ApplyTo(google::iam::v1::Policy& policy) const {
+  if (empty()) return false;
+  bool changed = false;
+  auto& bindings = *policy.mutable_bindings();
+
+  // The bindings and existing members for the roles that gain members. The
+  // protos hold each binding and member by pointer, so these remain valid as
+  // members and bindings are added below.
+  std::map<absl::string_view, google::iam::v1::Binding*> targets;
+  MemberViews existing;
+  for (auto& b : bindings) {
+    if (b.has_condition()) continue;
+    auto const r = removals_.find(b.role());
+    if (r != removals_.end()) {
+      auto& members = *b.mutable_members();
+      auto const end = std::remove_if(
+          members.begin(), members.end(),
+          [&r](std::string const& m) { return r->second.count(m) != 0; });
+      if (end != members.end()) {
+        members.erase(end, members.end());
+        changed = true;
+      }
+    }
+    if (additions_.count(b.role()) == 0) continue;
+    targets.emplace(b.role(), &b);
+    existing[b.role()].insert(b.members().begin(), b.members().end());
+  }
+
+  for (auto const& kv : additions_) {
+    auto const& seen = existing[kv.first];
+    google::iam::v1::Binding* target = nullptr;
+    auto const l = targets.find(kv.first);
+    if (l != targets.end()) target = l->second;
+    for (auto const& m : kv.second) {
+      if (seen.count(m) != 0) continue;
+      if (target == nullptr) {
+        target = bindings.Add();
+        target->set_role(kv.first);
+      }
+      target->add_members(m);
+      changed = true;
+    }
+  }
+
+  if (!removals_.empty()) {
+    auto const end = std::remove_if(
+        bindings.begin(), bindings.end(),
+        [this](google::iam::v1::Binding const& b) {
+          return b.members().empty() && !b.has_condition() &&
+                 removals_.count(b.role()) != 0;
+        });
+    if (end != bindings.end()) {
+      bindings.erase(end, bindings.end());
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,96 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_POLICY_DELTA_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_POLICY_DELTA_H
+
+#include "google/cloud/version.h"
+#include <google/iam/v1/policy.pb.h>
+#include <map>
+#include <set>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * A set of changes to the members of the roles in an IAM policy.
+ *
+ * Applications that update IAM policies concurrently typically read the
+ * policy, change a few members, and write it back, retrying if the policy
+ * changed in between. A delta records only the changes, so it can be applied
+ * (and re-applied after a conflict) to the current policy in place, without
+ * converting or copying the rest of the policy.
+ *
+ * Only bindings without conditions are modified, conditional bindings are
+ * preserved as-is.
+ *
+ * @par Example
+ * @code
+ * auto delta = google::cloud::IamPolicyDelta()
+ *     .AddMember("roles/spanner.databaseReader", "user:alice@example.com")
+ *     .RemoveMember("roles/spanner.databaseUser", "user:bob@example.com");
+ * bool changed = delta.ApplyTo(policy);
+ * @endcode
+ */
+class IamPolicyDelta {
+ public:
+  IamPolicyDelta() = default;
+
+  /// Computes the changes to the unconditional bindings of @p from to get @p to
+  static IamPolicyDelta Diff(google::iam::v1::Policy const& from,
+                             google::iam::v1::Policy const& to);
+
+  /// Grants @p role to @p member, cancelling any pending removal.
+  IamPolicyDelta& AddMember(std::string const& role, std::string member);
+
+  /// Revokes @p role from @p member, cancelling any pending addition.
+  IamPolicyDelta& RemoveMember(std::string const& role, std::string member);
+
+  /// Returns true if the delta has no changes.
+  bool empty() const { return additions_.empty() && removals_.empty(); }
+
+  /**
+   * Applies the changes to @p policy.
+   *
+   * Members are added to the first unconditional binding for their role, or
+   * to a new binding, and removed from all the unconditional bindings for
+   * their role. Bindings left without members are removed. The policy `etag`
+   * is unchanged, so writing back the result fails if the policy was modified
+   * since it was read.
+   *
+   * @return true if @p policy was modified.
+   */
+  bool ApplyTo(google::iam::v1::Policy& policy) const;
+
+  friend bool operator==(IamPolicyDelta const& a, IamPolicyDelta const& b) {
+    return a.additions_ == b.additions_ && a.removals_ == b.removals_;
+  }
+  friend bool operator!=(IamPolicyDelta const& a, IamPolicyDelta const& b) {
+    return !(a == b);
+  }
+
+ private:
+  // Ordered containers keep the bindings created by `ApplyTo()` stable.
+  using Members = std::map<std::string, std::set<std::string>>;
+  Members additions_;
+  Members removals_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_IAM_POLICY_DELTA_H
@@ -0,0 +1,138 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/iam_policy_delta.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+using ::testing::ElementsAre;
+
+google::iam::v1::Binding* AddBinding(
+    google::iam::v1::Policy& policy, std::string const& role,
+    std::initializer_list<char const*> members) {
+  auto* b = policy.add_bindings();
+  b->set_role(role);
+  for (auto const* m : members) b->add_members(m);
+  return b;
+}
+
+std::vector<std::string> Members(google::iam::v1::Binding const& b) {
+  return {b.members().begin(), b.members().end()};
+}
+
+TEST(IamPolicyDelta, Empty) {
+  google::iam::v1::Policy policy;
+  AddBinding(policy, "roles/viewer", {"user:a"});
+  IamPolicyDelta delta;
+  EXPECT_TRUE(delta.empty());
+  EXPECT_FALSE(delta.ApplyTo(policy));
+  ASSERT_EQ(1, policy.bindings_size());
+}
+
+TEST(IamPolicyDelta, AddToExistingBinding) {
+  google::iam::v1::Policy policy;
+  policy.set_etag("test-etag");
+  AddBinding(policy, "roles/viewer", {"user:a"});
+  auto delta = IamPolicyDelta()
+                   .AddMember("roles/viewer", "user:b")
+                   .AddMember("roles/viewer", "user:a");
+  EXPECT_TRUE(delta.ApplyTo(policy));
+  ASSERT_EQ(1, policy.bindings_size());
+  EXPECT_THAT(Members(policy.bindings(0)), ElementsAre("user:a", "user:b"));
+  EXPECT_EQ("test-etag", policy.etag());
+
+  // Applying the same delta again is a no-op.
+  EXPECT_FALSE(delta.ApplyTo(policy));
+}
+
+TEST(IamPolicyDelta, AddNewBinding) {
+  google::iam::v1::Policy policy;
+  AddBinding(policy, "roles/viewer", {"user:a"});
+  auto delta = IamPolicyDelta().AddMember("roles/editor", "user:b");
+  EXPECT_TRUE(delta.ApplyTo(policy));
+  ASSERT_EQ(2, policy.bindings_size());
+  EXPECT_EQ("roles/editor", policy.bindings(1).role());
+  EXPECT_THAT(Members(policy.bindings(1)), ElementsAre("user:b"));
+}
+
+TEST(IamPolicyDelta, RemoveMembers) {
+  google::iam::v1::Policy policy;
+  AddBinding(policy, "roles/viewer", {"user:a", "user:b", "user:c"});
+  AddBinding(policy, "roles/viewer", {"user:b"});
+  AddBinding(policy, "roles/editor", {"user:a"});
+  auto delta = IamPolicyDelta()
+                   .RemoveMember("roles/viewer", "user:b")
+                   .RemoveMember("roles/editor", "user:a");
+  EXPECT_TRUE(delta.ApplyTo(policy));
+  // Bindings without members are removed.
+  ASSERT_EQ(1, policy.bindings_size());
+  EXPECT_EQ("roles/viewer", policy.bindings(0).role());
+  EXPECT_THAT(Members(policy.bindings(0)), ElementsAre("user:a", "user:c"));
+  EXPECT_FALSE(delta.ApplyTo(policy));
+}
+
+TEST(IamPolicyDelta, ConditionalBindingsUnchanged) {
+  google::iam::v1::Policy policy;
+  auto* b = AddBinding(policy, "roles/viewer", {"user:a"});
+  b->mutable_condition()->set_expression("request.time < timestamp(\"x\")");
+  auto delta = IamPolicyDelta()
+                   .RemoveMember("roles/viewer", "user:a")
+                   .AddMember("roles/viewer", "user:b");
+  EXPECT_TRUE(delta.ApplyTo(policy));
+  ASSERT_EQ(2, policy.bindings_size());
+  EXPECT_TRUE(policy.bindings(0).has_condition());
+  EXPECT_THAT(Members(policy.bindings(0)), ElementsAre("user:a"));
+  EXPECT_FALSE(policy.bindings(1).has_condition());
+  EXPECT_THAT(Members(policy.bindings(1)), ElementsAre("user:b"));
+}
+
+TEST(IamPolicyDelta, AddCancelsRemove) {
+  auto delta = IamPolicyDelta()
+                   .RemoveMember("roles/viewer", "user:a")
+                   .AddMember("roles/viewer", "user:a");
+  EXPECT_TRUE(delta.empty());
+  delta.AddMember("roles/viewer", "user:a")
+      .RemoveMember("roles/viewer", "user:a");
+  EXPECT_TRUE(delta.empty());
+}
+
+TEST(IamPolicyDelta, Diff) {
+  google::iam::v1::Policy from;
+  AddBinding(from, "roles/viewer", {"user:a", "user:b"});
+  AddBinding(from, "roles/owner", {"user:c"});
+  google::iam::v1::Policy to;
+  AddBinding(to, "roles/viewer", {"user:b", "user:d"});
+  AddBinding(to, "roles/editor", {"user:e"});
+
+  auto const delta = IamPolicyDelta::Diff(from, to);
+  auto const expected = IamPolicyDelta()
+                            .AddMember("roles/viewer", "user:d")
+                            .AddMember("roles/editor", "user:e")
+                            .RemoveMember("roles/viewer", "user:a")
+                            .RemoveMember("roles/owner", "user:c");
+  EXPECT_EQ(expected, delta);
+
+  EXPECT_TRUE(delta.ApplyTo(from));
+  EXPECT_TRUE(IamPolicyDelta::Diff(from, to).empty());
+  EXPECT_TRUE(IamPolicyDelta::Diff(to, to).empty());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
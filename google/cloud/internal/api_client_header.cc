@@ -28,6 +28,16 @@ std::string ApiClientHeader() {
          version_string();
 }
 
+std::string const& ApiClientHeaderKey() {
+  static auto const* const kKey = new std::string("x-goog-api-client");
+  return *kKey;
+}
+
+std::string const& RequestParamsKey() {
+  static auto const* const kKey = new std::string("x-goog-request-params");
+  return *kKey;
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
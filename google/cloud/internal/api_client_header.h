@@ -26,6 +26,17 @@ namespace internal {
 /// Return the value for the x-goog-api-client header (aka metadata).
 std::string ApiClientHeader();
 
+/**
+ * The key for the `ApiClientHeader()` metadata.
+ *
+ * gRPC takes the metadata keys as `std::string`, returning a reference to a
+ * string allocated once avoids creating a temporary string for each call.
+ */
+std::string const& ApiClientHeaderKey();
+
+/// The key for the request routing parameters (x-goog-request-params).
+std::string const& RequestParamsKey();
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
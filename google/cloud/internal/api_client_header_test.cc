@@ -35,6 +35,14 @@ TEST(ApiClientHeaderTest, Basic) {
                         google::cloud::internal::LanguageVersion()));
 }
 
+TEST(ApiClientHeaderTest, Keys) {
+  EXPECT_EQ("x-goog-api-client", ApiClientHeaderKey());
+  EXPECT_EQ("x-goog-request-params", RequestParamsKey());
+  // The keys are allocated once.
+  EXPECT_EQ(&ApiClientHeaderKey(), &ApiClientHeaderKey());
+  EXPECT_EQ(&RequestParamsKey(), &RequestParamsKey());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -0,0 +1,64 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ARENA_ALLOCATED_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ARENA_ALLOCATED_H
+
+#include "google/cloud/version.h"
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message_lite.h>
+#include <memory>
+#include <type_traits>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+template <typename T>
+T* CreateInArena(google::protobuf::Arena* arena, std::true_type) {
+  return google::protobuf::Arena::CreateMessage<T>(arena);
+}
+
+template <typename T>
+T* CreateInArena(google::protobuf::Arena* arena, std::false_type) {
+  return google::protobuf::Arena::Create<T>(arena);
+}
+
+/**
+ * Creates a default-initialized `T` in a new `google::protobuf::Arena`.
+ *
+ * The returned pointer owns the arena. Protobuf messages allocate their
+ * strings, repeated fields, and sub-messages in the arena, and all these
+ * allocations are released at once, when the last copy of the pointer is
+ * deleted. This is much cheaper than deleting a large message one field at a
+ * time.
+ *
+ * Other types are supported too (this simplifies testing), but only the object
+ * itself is allocated in the arena.
+ */
+template <typename T>
+std::shared_ptr<T> MakeArenaAllocated() {
+  auto arena = std::make_shared<google::protobuf::Arena>();
+  auto* object = CreateInArena<T>(
+      arena.get(), std::is_base_of<google::protobuf::MessageLite, T>{});
+  return std::shared_ptr<T>(std::move(arena), object);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ARENA_ALLOCATED_H
@@ -0,0 +1,55 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/arena_allocated.h"
+#include <google/protobuf/struct.pb.h>
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+TEST(ArenaAllocated, Message) {
+  auto message = MakeArenaAllocated<google::protobuf::Struct>();
+  ASSERT_NE(nullptr, message);
+  EXPECT_NE(nullptr, message->GetArena());
+
+  // The sub-messages are allocated in the same arena.
+  auto& value = (*message->mutable_fields())["key"];
+  value.set_string_value("value");
+  EXPECT_EQ(message->GetArena(), value.GetArena());
+
+  // Copies of the pointer share the arena, which outlives the original.
+  auto copy = message;
+  message.reset();
+  EXPECT_EQ("value", copy->fields().at("key").string_value());
+}
+
+TEST(ArenaAllocated, NotAMessage) {
+  struct Fake {
+    std::string value = "default";
+  };
+  auto fake = MakeArenaAllocated<Fake>();
+  ASSERT_NE(nullptr, fake);
+  EXPECT_EQ("default", fake->value);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/internal/async_polling_loop.h"
+#include <chrono>
 #include <mutex>
 #include <string>
 
@@ -23,6 +24,10 @@ namespace internal {
 
 using ::google::longrunning::Operation;
 
+// The polling periods are typically measured in seconds, a small delay is
+// acceptable in exchange for fewer timers.
+auto constexpr kPollingTimerTick = std::chrono::milliseconds(100);
+
 class AsyncPollingLoopImpl
     : public std::enable_shared_from_this<AsyncPollingLoopImpl> {
  public:
@@ -95,7 +100,10 @@ class AsyncPollingLoopImpl
 
   void Wait() {
     auto self = shared_from_this();
-    cq_.MakeRelativeTimer(polling_policy_->WaitPeriod())
+    // Many operations may be polled at the same time, share the timers that
+    // expire at about the same time.
+    cq_.MakeCoalescedRelativeTimer(polling_policy_->WaitPeriod(),
+                                   kPollingTimerTick)
         .then([self](TimerResult f) { self->OnTimer(std::move(f)); });
   }
 
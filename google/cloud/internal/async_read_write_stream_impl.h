@@ -152,6 +152,34 @@ class AsyncStreamingReadWriteRpcImpl
       stream_;
 };
 
+/**
+ * An `AsyncStreamingReadWriteRpc` that fails immediately.
+ *
+ * Decorators use this class to report errors detected before the RPC starts,
+ * for example, when configuring the client context fails.
+ */
+template <typename Request, typename Response>
+class AsyncStreamingReadWriteRpcError
+    : public AsyncStreamingReadWriteRpc<Request, Response> {
+ public:
+  explicit AsyncStreamingReadWriteRpcError(Status status)
+      : status_(std::move(status)) {}
+
+  void Cancel() override {}
+  future<bool> Start() override { return make_ready_future(false); }
+  future<absl::optional<Response>> Read() override {
+    return make_ready_future<absl::optional<Response>>(absl::nullopt);
+  }
+  future<bool> Write(Request const&, grpc::WriteOptions) override {
+    return make_ready_future(false);
+  }
+  future<bool> WritesDone() override { return make_ready_future(false); }
+  future<Status> Finish() override { return make_ready_future(status_); }
+
+ private:
+  Status status_;
+};
+
 template <typename Request, typename Response>
 using PrepareAsyncReadWriteRpc = absl::FunctionRef<
     std::unique_ptr<grpc::ClientAsyncReaderWriterInterface<Request, Response>>(
@@ -31,6 +31,7 @@ namespace {
 
 using ::google::cloud::testing_util::IsOk;
 using ::google::cloud::testing_util::MockCompletionQueueImpl;
+using ::google::cloud::testing_util::StatusIs;
 using ::testing::_;
 using ::testing::ReturnRef;
 
@@ -162,6 +163,17 @@ TEST(AsyncReadWriteStreamingRpcTest, Basic) {
   EXPECT_THAT(finish.get(), IsOk());
 }
 
+TEST(AsyncReadWriteStreamingRpcTest, Error) {
+  AsyncStreamingReadWriteRpcError<FakeRequest, FakeResponse> stream(
+      Status(StatusCode::kPermissionDenied, "uh-oh"));
+  EXPECT_FALSE(stream.Start().get());
+  EXPECT_FALSE(stream.Read().get().has_value());
+  EXPECT_FALSE(stream.Write(FakeRequest{}, grpc::WriteOptions{}).get());
+  EXPECT_FALSE(stream.WritesDone().get());
+  EXPECT_THAT(stream.Finish().get(),
+              StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -0,0 +1,207 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_RESUMABLE_STREAMING_READ_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_RESUMABLE_STREAMING_READ_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/async_streaming_read_rpc.h"
+#include "google/cloud/internal/resumable_streaming_read_rpc.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <functional>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * `AsyncResumableStreamingRead()` uses callables compatible with this
+ * `std::function<>` to create new streams.
+ */
+template <typename ResponseType, typename RequestType>
+using AsyncStreamFactory =
+    std::function<std::unique_ptr<AsyncStreamingReadRpc<ResponseType>>(
+        CompletionQueue&, RequestType const&)>;
+
+/**
+ * The callback for each response in `AsyncResumableStreamingRead()`.
+ *
+ * The next response is not read until the returned future is satisfied. If
+ * the value is `false` the stream is cancelled.
+ */
+template <typename ResponseType>
+using AsyncStreamingReadHandler = std::function<future<bool>(ResponseType)>;
+
+/**
+ * Implements `AsyncResumableStreamingRead()`.
+ *
+ * Each step of the loop is started from the callback of the previous step, so
+ * at most one operation is pending at a time and no locking is needed. The
+ * object keeps itself alive (via `shared_from_this()`) until the loop ends.
+ */
+template <typename ResponseType, typename RequestType, typename RetryPolicy,
+          typename BackoffPolicy>
+class AsyncResumableStreamingReadImpl
+    : public std::enable_shared_from_this<AsyncResumableStreamingReadImpl<
+          ResponseType, RequestType, RetryPolicy, BackoffPolicy>> {
+ public:
+  AsyncResumableStreamingReadImpl(
+      CompletionQueue cq, std::unique_ptr<RetryPolicy> retry_policy,
+      std::unique_ptr<BackoffPolicy> backoff_policy,
+      AsyncStreamFactory<ResponseType, RequestType> stream_factory,
+      RequestUpdater<ResponseType, RequestType> updater, RequestType request,
+      AsyncStreamingReadHandler<ResponseType> on_read)
+      : cq_(std::move(cq)),
+        retry_policy_prototype_(std::move(retry_policy)),
+        backoff_policy_prototype_(std::move(backoff_policy)),
+        retry_policy_(retry_policy_prototype_->clone()),
+        backoff_policy_(backoff_policy_prototype_->clone()),
+        stream_factory_(std::move(stream_factory)),
+        updater_(std::move(updater)),
+        request_(std::move(request)),
+        on_read_(std::move(on_read)) {}
+
+  future<Status> Start() {
+    auto f = result_.get_future();
+    StartStream();
+    return f;
+  }
+
+ private:
+  void StartStream() {
+    stream_ = stream_factory_(cq_, request_);
+    auto self = this->shared_from_this();
+    stream_->Start().then([self](future<bool> f) {
+      if (!f.get()) return self->Finish();
+      self->Read();
+    });
+  }
+
+  void Read() {
+    auto self = this->shared_from_this();
+    stream_->Read().then([self](future<absl::optional<ResponseType>> f) {
+      self->OnRead(f.get());
+    });
+  }
+
+  void OnRead(absl::optional<ResponseType> response) {
+    if (!response) return Finish();
+    updater_(*response, request_);
+    has_received_data_ = true;
+    auto self = this->shared_from_this();
+    on_read_(*std::move(response)).then([self](future<bool> f) {
+      if (f.get()) return self->Read();
+      // The caller is done with the stream, cancel it and discard any pending
+      // responses, gRPC requires this before calling `Finish()`.
+      self->cancelled_ = true;
+      self->stream_->Cancel();
+      self->Discard();
+    });
+  }
+
+  void Discard() {
+    auto self = this->shared_from_this();
+    stream_->Read().then([self](future<absl::optional<ResponseType>> f) {
+      if (!f.get()) return self->Finish();
+      self->Discard();
+    });
+  }
+
+  void Finish() {
+    auto self = this->shared_from_this();
+    stream_->Finish().then([self](future<Status> f) { self->OnFinish(f.get()); });
+  }
+
+  void OnFinish(Status status) {
+    stream_.reset();
+    if (cancelled_) return result_.set_value(Status{});
+    if (status.ok()) return result_.set_value(std::move(status));
+    // As in `ResumableStreamingReadRpc`, the retry policy limits the attempts
+    // to *start* a stream. Once a stream makes progress the read *resumes*
+    // with fresh retry and backoff policies.
+    if (has_received_data_) {
+      retry_policy_ = retry_policy_prototype_->clone();
+      backoff_policy_ = backoff_policy_prototype_->clone();
+    }
+    if (retry_policy_->IsExhausted() ||
+        (!has_received_data_ && !retry_policy_->OnFailure(status))) {
+      return result_.set_value(std::move(status));
+    }
+    has_received_data_ = false;
+    auto self = this->shared_from_this();
+    cq_.MakeRelativeTimer(backoff_policy_->OnCompletion())
+        .then([self](future<StatusOr<std::chrono::system_clock::time_point>>
+                         f) {
+          auto t = f.get();
+          if (!t) return self->result_.set_value(std::move(t).status());
+          self->StartStream();
+        });
+  }
+
+  CompletionQueue cq_;
+  std::unique_ptr<RetryPolicy> const retry_policy_prototype_;
+  std::unique_ptr<BackoffPolicy> const backoff_policy_prototype_;
+  std::unique_ptr<RetryPolicy> retry_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+  AsyncStreamFactory<ResponseType, RequestType> const stream_factory_;
+  RequestUpdater<ResponseType, RequestType> const updater_;
+  RequestType request_;
+  AsyncStreamingReadHandler<ResponseType> const on_read_;
+  std::unique_ptr<AsyncStreamingReadRpc<ResponseType>> stream_;
+  bool has_received_data_ = false;
+  bool cancelled_ = false;
+  promise<Status> result_;
+};
+
+/**
+ * Reads a streaming RPC asynchronously, resuming on transient failures.
+ *
+ * This is the asynchronous analog of `ResumableStreamingReadRpc`: @p on_read is
+ * called for each response, after @p updater has recorded the response in the
+ * request. If the stream fails with a transient error it is restarted, using
+ * the updated request, and the same retry and backoff policies.
+ *
+ * No thread is blocked while the stream is active, all the work runs in the
+ * threads of @p cq.
+ *
+ * @return the final status of the stream. The status is OK if the stream
+ *     completed successfully, or if @p on_read returned `false`.
+ */
+template <typename ResponseType, typename RequestType, typename RetryPolicy,
+          typename BackoffPolicy>
+future<Status> AsyncResumableStreamingRead(
+    CompletionQueue cq, std::unique_ptr<RetryPolicy> retry_policy,
+    std::unique_ptr<BackoffPolicy> backoff_policy,
+    AsyncStreamFactory<ResponseType, RequestType> stream_factory,
+    RequestUpdater<ResponseType, RequestType> updater, RequestType request,
+    AsyncStreamingReadHandler<ResponseType> on_read) {
+  auto loop = std::make_shared<AsyncResumableStreamingReadImpl<
+      ResponseType, RequestType, RetryPolicy, BackoffPolicy>>(
+      std::move(cq), std::move(retry_policy), std::move(backoff_policy),
+      std::move(stream_factory), std::move(updater), std::move(request),
+      std::move(on_read));
+  return loop->Start();
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_RESUMABLE_STREAMING_READ_H
@@ -0,0 +1,261 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_resumable_streaming_read.h"
+#include "google/cloud/internal/backoff_policy.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::InSequence;
+
+struct FakeRequest {
+  std::string key;
+  std::string token;
+};
+
+struct FakeResponse {
+  std::string value;
+  std::string token;
+};
+
+class MockAsyncReadStream : public AsyncStreamingReadRpc<FakeResponse> {
+ public:
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD(future<bool>, Start, (), (override));
+  MOCK_METHOD(future<absl::optional<FakeResponse>>, Read, (), (override));
+  MOCK_METHOD(future<Status>, Finish, (), (override));
+};
+
+struct TestRetryablePolicy {
+  static bool IsPermanentFailure(Status const& s) {
+    return !s.ok() && s.code() == StatusCode::kPermissionDenied;
+  }
+};
+
+using RetryPolicyForTest = TraitBasedRetryPolicy<TestRetryablePolicy>;
+
+auto constexpr kMaxRetries = 3;
+std::unique_ptr<RetryPolicyForTest> TestRetryPolicy() {
+  return LimitedErrorCountRetryPolicy<TestRetryablePolicy>(kMaxRetries).clone();
+}
+
+std::unique_ptr<BackoffPolicy> TestBackoffPolicy() {
+  return ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                  std::chrono::microseconds(5), 2.0)
+      .clone();
+}
+
+void UpdateRequest(FakeResponse const& response, FakeRequest& request) {
+  request.token = response.token;
+}
+
+future<absl::optional<FakeResponse>> MakeResponse(std::string value,
+                                                  std::string token) {
+  return make_ready_future(
+      absl::make_optional(FakeResponse{std::move(value), std::move(token)}));
+}
+
+future<absl::optional<FakeResponse>> EndOfStream() {
+  return make_ready_future<absl::optional<FakeResponse>>(absl::nullopt);
+}
+
+/// A stream that returns @p values, and then finishes with @p status.
+std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>> MakeStream(
+    std::vector<std::string> const& values, Status status) {
+  auto stream = absl::make_unique<MockAsyncReadStream>();
+  InSequence sequence;
+  EXPECT_CALL(*stream, Start).WillOnce([] { return make_ready_future(true); });
+  for (auto const& v : values) {
+    EXPECT_CALL(*stream, Read).WillOnce([v] {
+      return MakeResponse(v, "token-" + v);
+    });
+  }
+  EXPECT_CALL(*stream, Read).WillOnce(EndOfStream);
+  EXPECT_CALL(*stream, Finish).WillOnce([status] {
+    return make_ready_future(status);
+  });
+  return stream;
+}
+
+class AsyncResumableStreamingReadTest : public ::testing::Test {
+ protected:
+  future<Status> Run(AsyncStreamFactory<FakeResponse, FakeRequest> factory) {
+    return AsyncResumableStreamingRead(
+        background_.cq(), TestRetryPolicy(), TestBackoffPolicy(),
+        std::move(factory),
+        RequestUpdater<FakeResponse, FakeRequest>(UpdateRequest),
+        FakeRequest{"test-key", {}},
+        AsyncStreamingReadHandler<FakeResponse>(
+            [this](FakeResponse const& r) {
+              values_.push_back(r.value);
+              return make_ready_future(true);
+            }));
+  }
+
+  AutomaticallyCreatedBackgroundThreads background_;
+  std::vector<std::string> values_;
+};
+
+TEST_F(AsyncResumableStreamingReadTest, Success) {
+  ::testing::MockFunction<std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+      CompletionQueue&, FakeRequest const&)>
+      factory;
+  EXPECT_CALL(factory, Call).WillOnce([](CompletionQueue&, FakeRequest const&) {
+    return MakeStream({"v0", "v1", "v2"}, Status{});
+  });
+
+  auto status = Run(factory.AsStdFunction()).get();
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(values_, ElementsAre("v0", "v1", "v2"));
+}
+
+TEST_F(AsyncResumableStreamingReadTest, ResumesWithUpdatedRequest) {
+  ::testing::MockFunction<std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+      CompletionQueue&, FakeRequest const&)>
+      factory;
+  auto const transient = Status(StatusCode::kUnavailable, "try-again");
+  ::testing::Sequence sequence;
+  EXPECT_CALL(factory, Call)
+      .InSequence(sequence)
+      .WillOnce([&](CompletionQueue&, FakeRequest const& request) {
+        EXPECT_EQ("test-key", request.key);
+        EXPECT_EQ("", request.token);
+        return MakeStream({"v0", "v1"}, transient);
+      });
+  // Without progress the retry policy applies.
+  EXPECT_CALL(factory, Call)
+      .InSequence(sequence)
+      .WillOnce([&](CompletionQueue&, FakeRequest const& request) {
+        EXPECT_EQ("token-v1", request.token);
+        return MakeStream({}, transient);
+      });
+  EXPECT_CALL(factory, Call)
+      .InSequence(sequence)
+      .WillOnce([&](CompletionQueue&, FakeRequest const& request) {
+        EXPECT_EQ("token-v1", request.token);
+        return MakeStream({"v2"}, Status{});
+      });
+
+  auto status = Run(factory.AsStdFunction()).get();
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(values_, ElementsAre("v0", "v1", "v2"));
+}
+
+TEST_F(AsyncResumableStreamingReadTest, PermanentError) {
+  ::testing::MockFunction<std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+      CompletionQueue&, FakeRequest const&)>
+      factory;
+  EXPECT_CALL(factory, Call).WillOnce([](CompletionQueue&, FakeRequest const&) {
+    return MakeStream({}, Status(StatusCode::kPermissionDenied, "uh-oh"));
+  });
+
+  auto status = Run(factory.AsStdFunction()).get();
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_TRUE(values_.empty());
+}
+
+TEST_F(AsyncResumableStreamingReadTest, TooManyTransients) {
+  ::testing::MockFunction<std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+      CompletionQueue&, FakeRequest const&)>
+      factory;
+  EXPECT_CALL(factory, Call)
+      .Times(kMaxRetries + 1)
+      .WillRepeatedly([](CompletionQueue&, FakeRequest const&) {
+        return MakeStream({}, Status(StatusCode::kUnavailable, "try-again"));
+      });
+
+  auto status = Run(factory.AsStdFunction()).get();
+  EXPECT_THAT(status, StatusIs(StatusCode::kUnavailable));
+}
+
+TEST_F(AsyncResumableStreamingReadTest, StartFailure) {
+  ::testing::MockFunction<std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+      CompletionQueue&, FakeRequest const&)>
+      factory;
+  EXPECT_CALL(factory, Call).WillOnce([](CompletionQueue&, FakeRequest const&) {
+    auto stream = absl::make_unique<MockAsyncReadStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(false);
+    });
+    EXPECT_CALL(*stream, Read).Times(0);
+    EXPECT_CALL(*stream, Finish).WillOnce([] {
+      return make_ready_future(
+          Status(StatusCode::kPermissionDenied, "uh-oh"));
+    });
+    return std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+        std::move(stream));
+  });
+
+  auto status = Run(factory.AsStdFunction()).get();
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST_F(AsyncResumableStreamingReadTest, HandlerStopsStream) {
+  ::testing::MockFunction<std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+      CompletionQueue&, FakeRequest const&)>
+      factory;
+  EXPECT_CALL(factory, Call).WillOnce([](CompletionQueue&, FakeRequest const&) {
+    auto stream = absl::make_unique<MockAsyncReadStream>();
+    InSequence sequence;
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Read).WillOnce([] { return MakeResponse("v0", ""); });
+    EXPECT_CALL(*stream, Cancel).Times(1);
+    // The pending responses are discarded before calling `Finish()`.
+    EXPECT_CALL(*stream, Read).WillOnce([] { return MakeResponse("v1", ""); });
+    EXPECT_CALL(*stream, Read).WillOnce(EndOfStream);
+    EXPECT_CALL(*stream, Finish).WillOnce([] {
+      return make_ready_future(Status(StatusCode::kCancelled, "cancelled"));
+    });
+    return std::unique_ptr<AsyncStreamingReadRpc<FakeResponse>>(
+        std::move(stream));
+  });
+
+  std::vector<std::string> values;
+  auto status =
+      AsyncResumableStreamingRead(
+          background_.cq(), TestRetryPolicy(), TestBackoffPolicy(),
+          AsyncStreamFactory<FakeResponse, FakeRequest>(
+              factory.AsStdFunction()),
+          RequestUpdater<FakeResponse, FakeRequest>(UpdateRequest),
+          FakeRequest{"test-key", {}},
+          AsyncStreamingReadHandler<FakeResponse>(
+              [&values](FakeResponse const& r) {
+                values.push_back(r.value);
+                return make_ready_future(false);
+              }))
+          .get();
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(values, ElementsAre("v0"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -18,10 +18,13 @@
 #include "google/cloud/backoff_policy.h"
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/future.h"
+#include "google/cloud/internal/grpc_trace_context.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/retry_loop_helpers.h"
 #include "google/cloud/internal/retry_policy.h"
 #include "google/cloud/internal/setup_context.h"
+#include "google/cloud/rpc_metrics.h"
+#include "google/cloud/rpc_tracing.h"
 #include "google/cloud/version.h"
 #include "absl/meta/type_traits.h"
 #include <grpcpp/grpcpp.h>
@@ -68,14 +71,17 @@ class AsyncRetryLoopImpl
   AsyncRetryLoopImpl(std::unique_ptr<RetryPolicyType> retry_policy,
                      std::unique_ptr<BackoffPolicy> backoff_policy,
                      Idempotency idempotency, google::cloud::CompletionQueue cq,
-                     Functor&& functor, Request request, char const* location)
+                     Functor&& functor, Request request, char const* location,
+                     std::chrono::milliseconds attempt_timeout)
       : retry_policy_(std::move(retry_policy)),
         backoff_policy_(std::move(backoff_policy)),
         idempotency_(idempotency),
         cq_(std::move(cq)),
         functor_(std::forward<Functor>(functor)),
         request_(std::move(request)),
-        location_(location) {}
+        location_(location),
+        attempt_timeout_(attempt_timeout),
+        tracer_(location) {}
 
   using ReturnType = google::cloud::internal::invoke_result_t<
       Functor, google::cloud::CompletionQueue&,
@@ -108,6 +114,11 @@ class AsyncRetryLoopImpl
     auto self = this->shared_from_this();
     auto context = absl::make_unique<grpc::ClientContext>();
     SetupContext<RetryPolicyType>::Setup(*retry_policy_, *context);
+    SetupAttemptDeadline(*retry_policy_, *context, attempt_timeout_);
+    RetryAttemptScope scope(attempt_);
+    attempt_span_ = tracer_.StartAttempt(attempt_++);
+    RpcSpanScope span_scope(attempt_span_.get());
+    InjectTraceContext(attempt_span_.get(), *context);
     auto op =
         functor_(cq_, std::move(context), request_).then([self](future<T> f) {
           self->OnAttempt(f.get());
@@ -117,6 +128,7 @@ class AsyncRetryLoopImpl
 
   void OnAttempt(T result) {
     SetIdle();
+    tracer_.EndAttempt(std::move(attempt_span_), result);
     // A successful attempt, set the value and finish the loop.
     if (result.ok()) {
       SetDone(std::move(result));
@@ -140,13 +152,12 @@ class AsyncRetryLoopImpl
     }
     if (Cancelled()) return;
     auto self = this->shared_from_this();
-    auto op =
-        cq_.MakeRelativeTimer(backoff_policy_->OnCompletion())
-            .then(
-                [self](
-                    future<StatusOr<std::chrono::system_clock::time_point>> f) {
-                  self->OnBackoffTimer(f.get());
-                });
+    auto const delay = backoff_policy_->OnCompletion();
+    tracer_.Backoff(delay);
+    auto op = cq_.MakeRelativeTimer(delay).then(
+        [self](future<StatusOr<std::chrono::system_clock::time_point>> f) {
+          self->OnBackoffTimer(f.get());
+        });
     SetWaiting(std::move(op));
   }
 
@@ -193,6 +204,7 @@ class AsyncRetryLoopImpl
     if (state_ == kDone) return;
     state_ = kDone;
     lk.unlock();
+    tracer_.End(value);
     result_.set_value(std::move(value));
   }
 
@@ -211,8 +223,10 @@ class AsyncRetryLoopImpl
     if (!cancelled_) return false;
     state_ = kDone;
     lk.unlock();
-    result_.set_value(
-        RetryLoopError("Retry loop cancelled", location_, last_status_));
+    auto status =
+        RetryLoopError("Retry loop cancelled", location_, last_status_);
+    tracer_.End(status);
+    result_.set_value(std::move(status));
     return true;
   }
 
@@ -223,7 +237,11 @@ class AsyncRetryLoopImpl
   absl::decay_t<Functor> functor_;
   Request request_;
   char const* location_ = "unknown";
+  std::chrono::milliseconds attempt_timeout_;
   Status last_status_ = Status(StatusCode::kUnknown, "Retry policy exhausted");
+  int attempt_ = 0;
+  RetryLoopTracer tracer_;
+  std::shared_ptr<RpcSpan> attempt_span_;
   promise<T> result_;
   std::mutex mu_;
   State state_ = kIdle;
@@ -233,6 +251,10 @@ class AsyncRetryLoopImpl
 
 /**
  * Create the right AsyncRetryLoopImpl object and start the retry loop on it.
+ *
+ * Each attempt's deadline is the earliest of the retry policy deadline and
+ * @p attempt_timeout from the start of the attempt. An @p attempt_timeout of
+ * zero means the attempts have no individual timeout.
  */
 template <typename Functor, typename Request, typename RetryPolicyType,
           typename std::enable_if<
@@ -243,7 +265,9 @@ template <typename Functor, typename Request, typename RetryPolicyType,
 auto AsyncRetryLoop(std::unique_ptr<RetryPolicyType> retry_policy,
                     std::unique_ptr<BackoffPolicy> backoff_policy,
                     Idempotency idempotency, google::cloud::CompletionQueue cq,
-                    Functor&& functor, Request request, char const* location)
+                    Functor&& functor, Request request, char const* location,
+                    std::chrono::milliseconds attempt_timeout =
+                        std::chrono::milliseconds(0))
     -> google::cloud::internal::invoke_result_t<
         Functor, google::cloud::CompletionQueue&,
         std::unique_ptr<grpc::ClientContext>, Request const&> {
@@ -251,7 +275,7 @@ auto AsyncRetryLoop(std::unique_ptr<RetryPolicyType> retry_policy,
       std::make_shared<AsyncRetryLoopImpl<Functor, Request, RetryPolicyType>>(
           std::move(retry_policy), std::move(backoff_policy), idempotency,
           std::move(cq), std::forward<Functor>(functor), std::move(request),
-          location);
+          location, attempt_timeout);
   return loop->Start();
 }
 
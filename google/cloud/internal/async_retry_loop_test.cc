@@ -15,6 +15,7 @@
 #include "google/cloud/internal/async_retry_loop.h"
 #include "google/cloud/internal/background_threads_impl.h"
 #include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/fake_rpc_tracer.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <deque>
@@ -306,6 +307,37 @@ TEST(AsyncRetryLoopTest, SetsTimeout) {
   ASSERT_THAT(actual.status(), StatusIs(StatusCode::kUnavailable));
 }
 
+TEST(AsyncRetryLoopTest, SetsAttemptDeadline) {
+  auto const attempt_timeout = std::chrono::seconds(10);
+  auto policy =
+      LimitedTimeRetryPolicy<TestRetryablePolicy>(std::chrono::minutes(5))
+          .clone();
+  auto const overall = policy->deadline();
+
+  AutomaticallyCreatedBackgroundThreads background;
+  int counter = 0;
+  StatusOr<int> actual =
+      AsyncRetryLoop(
+          std::move(policy), TestBackoffPolicy(), Idempotency::kIdempotent,
+          background.cq(),
+          [&](google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext> context, int request) {
+            auto const now = std::chrono::system_clock::now();
+            EXPECT_LE(context->deadline(), now + attempt_timeout);
+            EXPECT_GT(context->deadline(), now + attempt_timeout / 2);
+            EXPECT_LT(context->deadline(), overall);
+            if (++counter < 3) {
+              return make_ready_future(StatusOr<int>(
+                  Status(StatusCode::kUnavailable, "try again")));
+            }
+            return make_ready_future(StatusOr<int>(2 * request));
+          },
+          42, "error message", attempt_timeout)
+          .get();
+  ASSERT_THAT(actual, IsOk());
+  EXPECT_EQ(84, *actual);
+}
+
 TEST_F(AsyncRetryLoopCancelTest, CancelAndSuccess) {
   using ms = std::chrono::milliseconds;
 
@@ -435,6 +467,43 @@ TEST_F(AsyncRetryLoopCancelTest, ShutdownDuringTimer) {
                                     HasSubstr("test-location"))));
 }
 
+TEST(AsyncRetryLoopTest, TracingSpans) {
+  testing_util::ScopedFakeRpcTracer fake;
+  AutomaticallyCreatedBackgroundThreads background;
+  int counter = 0;
+  StatusOr<int> actual =
+      AsyncRetryLoop(
+          TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+          background.cq(),
+          [&](google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext>,
+              int request) -> future<StatusOr<int>> {
+            EXPECT_NE(nullptr, CurrentRpcSpan());
+            if (++counter < 3) {
+              return make_ready_future(
+                  StatusOr<int>(Status(StatusCode::kUnavailable, "try again")));
+            }
+            return make_ready_future(StatusOr<int>(2 * request));
+          },
+          42, "test-location")
+          .get();
+  ASSERT_THAT(actual.status(), IsOk());
+
+  auto const spans = fake.Spans();
+  ASSERT_EQ(4, spans.size());
+  EXPECT_EQ("test-location", spans[0].name);
+  EXPECT_TRUE(spans[0].ended);
+  EXPECT_THAT(spans[0].status, IsOk());
+  EXPECT_EQ(2, spans[0].events.size());
+  for (int i = 1; i != 4; ++i) {
+    EXPECT_EQ("attempt", spans[i].name);
+    EXPECT_EQ("test-location", spans[i].parent);
+    EXPECT_TRUE(spans[i].ended);
+  }
+  EXPECT_THAT(spans[1].status, StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(spans[3].status, IsOk());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -0,0 +1,189 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_STREAMING_READ_RPC_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_STREAMING_READ_RPC_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/completion_queue_impl.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/functional/function_ref.h"
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include <grpcpp/support/async_stream.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Defines the interface for wrappers around asynchronous streaming read RPCs.
+ *
+ * This is the asynchronous analog of `StreamingReadRpc<Response>`, it allows
+ * us to mock and decorate the streaming RPCs. The canonical implementation is
+ * `AsyncStreamingReadRpcImpl<Response>`.
+ *
+ * Callers must wait for each operation to complete before starting the next
+ * one, and must call `Finish()` once `Start()` returns `false` or `Read()`
+ * returns an empty value.
+ */
+template <typename Response>
+class AsyncStreamingReadRpc {
+ public:
+  virtual ~AsyncStreamingReadRpc() = default;
+
+  /// Cancel the RPC, this is needed to terminate the RPC "early".
+  virtual void Cancel() = 0;
+
+  /// Start the RPC, returns `false` if the RPC cannot be started.
+  virtual future<bool> Start() = 0;
+
+  /// Read the next response, returns an empty value at the end of the stream.
+  virtual future<absl::optional<Response>> Read() = 0;
+
+  /// Return the final status of the RPC.
+  virtual future<Status> Finish() = 0;
+};
+
+/**
+ * Wrapper for asynchronous streaming read RPCs.
+ *
+ * A wrapper for gRPC's asynchronous streaming read APIs, which can be combined
+ * with `google::cloud::CompletionQueue` and `google::cloud::future<>` to
+ * provide easier-to-use abstractions.
+ */
+template <typename Response>
+class AsyncStreamingReadRpcImpl : public AsyncStreamingReadRpc<Response> {
+ public:
+  AsyncStreamingReadRpcImpl(
+      std::shared_ptr<CompletionQueueImpl> cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> stream)
+      : cq_(std::move(cq)),
+        context_(std::move(context)),
+        stream_(std::move(stream)) {}
+
+  void Cancel() override { context_->TryCancel(); }
+
+  future<bool> Start() override {
+    struct OnStart : public AsyncGrpcOperation {
+      promise<bool> p;
+      bool Notify(bool ok) override {
+        p.set_value(ok);
+        return true;
+      }
+      void Cancel() override {}
+    };
+    auto op = std::make_shared<OnStart>();
+    cq_->StartOperation(op, [&](void* tag) { stream_->StartCall(tag); });
+    return op->p.get_future();
+  }
+
+  future<absl::optional<Response>> Read() override {
+    struct OnRead : public AsyncGrpcOperation {
+      promise<absl::optional<Response>> p;
+      Response response;
+      bool Notify(bool ok) override {
+        if (!ok) {
+          p.set_value({});
+          return true;
+        }
+        p.set_value(std::move(response));
+        return true;
+      }
+      void Cancel() override {}
+    };
+    auto op = std::make_shared<OnRead>();
+    cq_->StartOperation(op,
+                        [&](void* tag) { stream_->Read(&op->response, tag); });
+    return op->p.get_future();
+  }
+
+  future<Status> Finish() override {
+    struct OnFinish : public AsyncGrpcOperation {
+      promise<Status> p;
+      grpc::Status status;
+      bool Notify(bool /*ok*/) override {
+        p.set_value(MakeStatusFromRpcError(std::move(status)));
+        return true;
+      }
+      void Cancel() override {}
+    };
+    auto op = std::make_shared<OnFinish>();
+    cq_->StartOperation(op,
+                        [&](void* tag) { stream_->Finish(&op->status, tag); });
+    return op->p.get_future();
+  }
+
+ private:
+  std::shared_ptr<CompletionQueueImpl> cq_;
+  std::unique_ptr<grpc::ClientContext> context_;
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> stream_;
+};
+
+/**
+ * An `AsyncStreamingReadRpc` that fails immediately.
+ *
+ * Decorators use this class to report errors detected before the RPC starts,
+ * for example, when configuring the client context fails.
+ */
+template <typename Response>
+class AsyncStreamingReadRpcError : public AsyncStreamingReadRpc<Response> {
+ public:
+  explicit AsyncStreamingReadRpcError(Status status)
+      : status_(std::move(status)) {}
+
+  void Cancel() override {}
+  future<bool> Start() override { return make_ready_future(false); }
+  future<absl::optional<Response>> Read() override {
+    return make_ready_future<absl::optional<Response>>(absl::nullopt);
+  }
+  future<Status> Finish() override { return make_ready_future(status_); }
+
+ private:
+  Status status_;
+};
+
+template <typename Request, typename Response>
+using PrepareAsyncReadRpc = absl::FunctionRef<
+    std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>>(
+        grpc::ClientContext*, Request const&, grpc::CompletionQueue*)>;
+
+/**
+ * Make an asynchronous streaming read RPC using `CompletionQueue`.
+ *
+ * @see `MakeStreamingReadWriteRpc()` for the reasons this is not a member
+ *     function of `CompletionQueue`.
+ */
+template <typename Request, typename Response>
+std::unique_ptr<AsyncStreamingReadRpc<Response>> MakeStreamingReadRpc(
+    CompletionQueue& cq, std::unique_ptr<grpc::ClientContext> context,
+    Request const& request, PrepareAsyncReadRpc<Request, Response> async_call) {
+  auto cq_impl = GetCompletionQueueImpl(cq);
+  auto stream = async_call(context.get(), request, &cq_impl->cq());
+  return absl::make_unique<AsyncStreamingReadRpcImpl<Response>>(
+      std::move(cq_impl), std::move(context), std::move(stream));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_STREAMING_READ_RPC_H
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/thread_affinity.h"
+#include "google/cloud/log.h"
+#include "absl/memory/memory.h"
 #include <algorithm>
 
 namespace google {
@@ -20,11 +23,42 @@ namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
+namespace {
+void SetAffinity(std::vector<int> const& cpus) {
+  auto status = SetCurrentThreadAffinity(cpus);
+  if (!status.ok()) {
+    GCP_LOG(WARNING) << "Cannot set background thread affinity: " << status;
+  }
+}
+}  // namespace
+
 AutomaticallyCreatedBackgroundThreads::AutomaticallyCreatedBackgroundThreads(
-    std::size_t thread_count)
-    : pool_(thread_count == 0 ? 1 : thread_count) {
-  std::generate_n(pool_.begin(), pool_.size(), [this] {
-    return std::thread([](CompletionQueue cq) { cq.Run(); }, cq_);
+    std::size_t thread_count, CompletionQueue cq, std::vector<int> cpus)
+    : cq_(std::move(cq)), pool_(thread_count == 0 ? 1 : thread_count) {
+  auto run = [](CompletionQueue cq, std::vector<int> const& cpus) {
+    SetAffinity(cpus);
+    cq.Run();
+  };
+  std::generate_n(pool_.begin(), pool_.size(),
+                  [&] { return std::thread(run, cq_, cpus); });
+}
+
+AutomaticallyCreatedBackgroundThreads::AutomaticallyCreatedBackgroundThreads(
+    std::size_t thread_count,
+    std::shared_ptr<DefaultCompletionQueueImpl> const& impl,
+    std::vector<std::vector<int>> const& shard_cpus)
+    : cq_(impl), pool_((std::max)(thread_count, impl->shard_count())) {
+  auto run = [](std::shared_ptr<DefaultCompletionQueueImpl> const& impl,
+                std::size_t shard, std::vector<int> const& cpus) {
+    SetAffinity(cpus);
+    impl->RunShard(shard);
+  };
+  std::size_t index = 0;
+  std::generate_n(pool_.begin(), pool_.size(), [&] {
+    auto const shard = index++ % impl->shard_count();
+    auto cpus = shard_cpus.empty() ? std::vector<int>{}
+                                   : shard_cpus[shard % shard_cpus.size()];
+    return std::thread(run, impl, shard, std::move(cpus));
   });
 }
 
@@ -39,6 +73,123 @@ void AutomaticallyCreatedBackgroundThreads::Shutdown() {
   pool_.clear();
 }
 
+std::shared_ptr<BackgroundThreads> ProcessBackgroundThreads() {
+  // Never deleted, clients may be released during static destruction.
+  static auto* const kMu = new std::mutex;
+  static auto* const kThreads = new std::weak_ptr<BackgroundThreads>;
+  std::lock_guard<std::mutex> lk(*kMu);
+  auto threads = kThreads->lock();
+  if (threads) return threads;
+  auto const cpus = std::thread::hardware_concurrency();
+  threads = std::make_shared<AutomaticallyCreatedBackgroundThreads>(
+      cpus == 0 ? 1 : cpus);
+  *kThreads = threads;
+  return threads;
+}
+
+ElasticBackgroundThreads::ElasticBackgroundThreads(Config config)
+    : config_(std::move(config)),
+      impl_(std::make_shared<DefaultCompletionQueueImpl>(
+          config_.batch_run_async)),
+      cq_(impl_) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const initial = (std::max)(std::size_t{1}, config_.min_threads);
+  for (std::size_t i = 0; i != initial; ++i) AddThread(lk);
+  monitor_ = std::thread([this] { Monitor(); });
+}
+
+ElasticBackgroundThreads::~ElasticBackgroundThreads() { Shutdown(); }
+
+void ElasticBackgroundThreads::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (shutdown_) return;
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  monitor_.join();
+  cq_.Shutdown();
+  // No threads are added or retired after `shutdown_` is set, so it is safe
+  // to join them without holding the lock.
+  for (auto& kv : pool_) kv.second.join();
+  std::lock_guard<std::mutex> lk(mu_);
+  pool_.clear();
+  retired_.clear();
+  pool_size_ = 0;
+}
+
+std::size_t ElasticBackgroundThreads::pool_size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return pool_size_;
+}
+
+std::size_t ElasticBackgroundThreads::pool_hwm() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return pool_hwm_;
+}
+
+void ElasticBackgroundThreads::AddThread(std::unique_lock<std::mutex> const&) {
+  std::thread t([this] { Worker(); });
+  auto const id = t.get_id();
+  pool_.emplace(id, std::move(t));
+  ++pool_size_;
+  pool_hwm_ = (std::max)(pool_hwm_, pool_size_);
+}
+
+void ElasticBackgroundThreads::Worker() {
+  SetAffinity(config_.cpus);
+  impl_->RunUntilIdle(config_.idle_timeout, [this] { return Retire(); });
+}
+
+bool ElasticBackgroundThreads::Retire() {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto const min_threads = (std::max)(std::size_t{1}, config_.min_threads);
+  if (shutdown_ || pool_size_ <= min_threads) return false;
+  --pool_size_;
+  // The thread exits as soon as this function returns, the monitor thread
+  // joins it.
+  retired_.push_back(std::this_thread::get_id());
+  return true;
+}
+
+void ElasticBackgroundThreads::JoinRetired(std::unique_lock<std::mutex>& lk) {
+  if (retired_.empty()) return;
+  std::vector<std::thread> threads;
+  for (auto const& id : retired_) {
+    auto loc = pool_.find(id);
+    if (loc == pool_.end()) continue;
+    threads.push_back(std::move(loc->second));
+    pool_.erase(loc);
+  }
+  retired_.clear();
+  lk.unlock();
+  for (auto& t : threads) t.join();
+  lk.lock();
+}
+
+void ElasticBackgroundThreads::Monitor() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (!shutdown_) {
+    cv_.wait_for(lk, config_.check_interval, [this] { return shutdown_; });
+    if (shutdown_) break;
+    JoinRetired(lk);
+    if (shutdown_ || pool_size_ >= config_.max_threads) continue;
+    lk.unlock();
+    auto const load = impl_->load();
+    lk.lock();
+    if (shutdown_ || pool_size_ >= config_.max_threads) continue;
+    auto const saturated = load.thread_pool_size != 0 &&
+                           load.busy_threads >= load.thread_pool_size;
+    // The completion queue reserves one thread for I/O, `RunAsync()`
+    // functions can starve if all the other threads are busy.
+    auto const starved = load.run_async_backlog != 0 &&
+                         load.busy_threads + 1 >= load.thread_pool_size;
+    auto const backlog =
+        load.run_async_backlog > config_.run_async_backlog_threshold;
+    if (saturated || starved || backlog) AddThread(lk);
+  }
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
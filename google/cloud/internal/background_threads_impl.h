@@ -17,7 +17,15 @@
 
 #include "google/cloud/background_threads.h"
 #include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/default_completion_queue_impl.h"
 #include "google/cloud/version.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -39,10 +47,65 @@ class CustomerSuppliedBackgroundThreads : public BackgroundThreads {
   CompletionQueue cq_;
 };
 
+/**
+ * Shares a `BackgroundThreads` object across clients.
+ *
+ * Each client owns one of these objects, the shared threads are deleted (and
+ * shutdown) when the last client using them is deleted.
+ */
+class SharedBackgroundThreads : public BackgroundThreads {
+ public:
+  explicit SharedBackgroundThreads(std::shared_ptr<BackgroundThreads> impl)
+      : impl_(std::move(impl)) {}
+  ~SharedBackgroundThreads() override = default;
+
+  CompletionQueue cq() const override { return impl_->cq(); }
+  std::shared_ptr<BackgroundThreads> const& impl() const { return impl_; }
+
+ private:
+  std::shared_ptr<BackgroundThreads> impl_;
+};
+
+/**
+ * Returns the process-wide background threads.
+ *
+ * The threads are created on first use, with one thread per CPU. They are
+ * deleted when no client uses them, and created again if needed.
+ */
+std::shared_ptr<BackgroundThreads> ProcessBackgroundThreads();
+
 /// Create a background thread to perform background operations.
 class AutomaticallyCreatedBackgroundThreads : public BackgroundThreads {
  public:
-  explicit AutomaticallyCreatedBackgroundThreads(std::size_t thread_count = 1U);
+  explicit AutomaticallyCreatedBackgroundThreads(std::size_t thread_count = 1U)
+      : AutomaticallyCreatedBackgroundThreads(thread_count,
+                                              CompletionQueue{}) {}
+  AutomaticallyCreatedBackgroundThreads(std::size_t thread_count,
+                                        CompletionQueue cq)
+      : AutomaticallyCreatedBackgroundThreads(thread_count, std::move(cq),
+                                              std::vector<int>{}) {}
+  /**
+   * Create @p thread_count threads blocked on @p cq.
+   *
+   * If @p cpus is not empty, each thread is restricted to run on those CPUs.
+   * Failures to set the affinity are logged, and the thread runs unpinned.
+   */
+  AutomaticallyCreatedBackgroundThreads(std::size_t thread_count,
+                                        CompletionQueue cq,
+                                        std::vector<int> cpus);
+  /**
+   * Create @p thread_count threads for a sharded completion queue.
+   *
+   * Thread `i` serves shard `i % impl->shard_count()`, at least one thread is
+   * created for each shard. If @p shard_cpus is not empty, the threads
+   * serving shard `s` are restricted to the CPUs in
+   * `shard_cpus[s % shard_cpus.size()]`, for example, the CPUs in one NUMA
+   * node.
+   */
+  AutomaticallyCreatedBackgroundThreads(
+      std::size_t thread_count,
+      std::shared_ptr<DefaultCompletionQueueImpl> const& impl,
+      std::vector<std::vector<int>> const& shard_cpus);
   ~AutomaticallyCreatedBackgroundThreads() override;
 
   CompletionQueue cq() const override { return cq_; }
@@ -54,6 +117,61 @@ class AutomaticallyCreatedBackgroundThreads : public BackgroundThreads {
   std::vector<std::thread> pool_;
 };
 
+/**
+ * A background thread pool that grows and shrinks with the completion queue
+ * load.
+ *
+ * The pool starts with `min_threads` threads. A monitor thread samples the
+ * load on the completion queue every `check_interval`, and adds a thread (up
+ * to `max_threads`) when all the threads are busy processing events, when
+ * functions scheduled via `RunAsync()` are waiting and only the I/O thread is
+ * free, or when more than `run_async_backlog_threshold` such functions are
+ * waiting. Threads that receive no events for `idle_timeout`
+ * exit, as long as the pool stays at or above `min_threads`.
+ */
+class ElasticBackgroundThreads : public BackgroundThreads {
+ public:
+  struct Config {
+    std::size_t min_threads = 1;
+    std::size_t max_threads = 1;
+    std::chrono::milliseconds idle_timeout = std::chrono::seconds(30);
+    std::chrono::milliseconds check_interval = std::chrono::milliseconds(10);
+    std::size_t run_async_backlog_threshold = 16;
+    bool batch_run_async = false;
+    std::vector<int> cpus;
+  };
+
+  explicit ElasticBackgroundThreads(Config config);
+  ~ElasticBackgroundThreads() override;
+
+  CompletionQueue cq() const override { return cq_; }
+  void Shutdown();
+
+  /// The current number of threads in the pool.
+  std::size_t pool_size() const;
+  /// The largest number of threads in the pool.
+  std::size_t pool_hwm() const;
+
+ private:
+  void AddThread(std::unique_lock<std::mutex> const& lk);
+  void Worker();
+  bool Retire();
+  void Monitor();
+  void JoinRetired(std::unique_lock<std::mutex>& lk);
+
+  Config const config_;
+  std::shared_ptr<DefaultCompletionQueueImpl> impl_;
+  CompletionQueue cq_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  bool shutdown_ = false;                          // GUARDED_BY(mu_)
+  std::size_t pool_size_ = 0;                      // GUARDED_BY(mu_)
+  std::size_t pool_hwm_ = 0;                       // GUARDED_BY(mu_)
+  std::map<std::thread::id, std::thread> pool_;    // GUARDED_BY(mu_)
+  std::vector<std::thread::id> retired_;           // GUARDED_BY(mu_)
+  std::thread monitor_;
+};
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
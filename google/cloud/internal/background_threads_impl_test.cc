@@ -15,6 +15,9 @@
 #include "google/cloud/internal/background_threads_impl.h"
 #include "google/cloud/testing_util/scoped_thread.h"
 #include <gmock/gmock.h>
+#ifdef __linux__
+#include <sched.h>
+#endif  // __linux__
 
 namespace google {
 namespace cloud {
@@ -123,6 +126,160 @@ TEST(AutomaticallyCreatedBackgroundThreads, ManualShutdown) {
   actual.Shutdown();
 }
 
+/// @test Verify that sharded completion queues get a thread for each shard.
+TEST(AutomaticallyCreatedBackgroundThreads, ShardedNoEmptyShards) {
+  auto constexpr kShardCount = 3;
+  AutomaticallyCreatedBackgroundThreads actual(
+      0, std::make_shared<DefaultCompletionQueueImpl>(false, kShardCount), {});
+  EXPECT_EQ(kShardCount, actual.pool_size());
+
+  // Each timer starts on the next shard, they all must complete.
+  std::vector<future<StatusOr<std::chrono::system_clock::time_point>>> timers;
+  for (int i = 0; i != 2 * kShardCount; ++i) {
+    timers.push_back(
+        actual.cq().MakeRelativeTimer(std::chrono::milliseconds(1)));
+  }
+  for (auto& t : timers) EXPECT_TRUE(t.get().ok());
+}
+
+/// @test Verify that the operations in one queue use all the shards.
+TEST(AutomaticallyCreatedBackgroundThreads, ShardedRoundRobin) {
+  auto constexpr kShardCount = 4;
+  AutomaticallyCreatedBackgroundThreads actual(
+      kShardCount,
+      std::make_shared<DefaultCompletionQueueImpl>(false, kShardCount), {});
+  EXPECT_EQ(kShardCount, actual.pool_size());
+
+  auto cq = actual.cq();
+  std::vector<future<std::thread::id>> ids;
+  for (int i = 0; i != kShardCount; ++i) {
+    ids.push_back(cq.MakeRelativeTimer(std::chrono::milliseconds(50))
+                      .then([](future<StatusOr<
+                                   std::chrono::system_clock::time_point>>) {
+                        return std::this_thread::get_id();
+                      }));
+  }
+  std::set<std::thread::id> actual_ids;
+  for (auto& id : ids) actual_ids.insert(id.get());
+  EXPECT_EQ(kShardCount, actual_ids.size());
+  EXPECT_THAT(actual_ids, Not(Contains(std::this_thread::get_id())));
+}
+
+/// @test Verify that sharded background threads can be shutdown explicitly.
+TEST(AutomaticallyCreatedBackgroundThreads, ShardedManualShutdown) {
+  auto constexpr kShardCount = 2;
+  AutomaticallyCreatedBackgroundThreads actual(
+      2 * kShardCount,
+      std::make_shared<DefaultCompletionQueueImpl>(false, kShardCount), {});
+  EXPECT_EQ(2 * kShardCount, actual.pool_size());
+
+  std::vector<promise<void>> promises(4 * kShardCount);
+  for (auto& p : promises) {
+    actual.cq().RunAsync([&p] { p.set_value(); });
+  }
+  for (auto& p : promises) p.get_future().get();
+
+  actual.Shutdown();
+  EXPECT_EQ(0, actual.pool_size());
+}
+
+/// @test Verify that elastic pools grow under load and shrink when idle.
+TEST(ElasticBackgroundThreads, GrowAndShrink) {
+  using ms = std::chrono::milliseconds;
+  ElasticBackgroundThreads::Config config;
+  config.min_threads = 1;
+  config.max_threads = 4;
+  config.idle_timeout = ms(50);
+  config.check_interval = ms(1);
+  ElasticBackgroundThreads actual(config);
+  EXPECT_EQ(1, actual.pool_size());
+
+  // Block enough threads to saturate the pool, it should grow to the maximum.
+  // The completion queue reserves one thread for I/O, so only
+  // `max_threads - 1` functions can run in parallel.
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::vector<promise<void>> started(config.max_threads - 1);
+  for (auto& p : started) {
+    actual.cq().RunAsync([&p, released] {
+      p.set_value();
+      released.get();
+    });
+  }
+  for (auto& p : started) p.get_future().get();
+  EXPECT_EQ(config.max_threads, actual.pool_hwm());
+  EXPECT_LE(actual.pool_size(), config.max_threads);
+  release.set_value();
+
+  // Once idle, the pool shrinks back to its minimum size.
+  for (int i = 0; i != 200 && actual.pool_size() != config.min_threads; ++i) {
+    std::this_thread::sleep_for(ms(10));
+  }
+  EXPECT_EQ(config.min_threads, actual.pool_size());
+
+  // The pool is still usable.
+  promise<void> done;
+  actual.cq().RunAsync([&done] { done.set_value(); });
+  done.get_future().get();
+}
+
+/// @test Verify that elastic pools never drop below the minimum size.
+TEST(ElasticBackgroundThreads, KeepsMinimum) {
+  using ms = std::chrono::milliseconds;
+  ElasticBackgroundThreads::Config config;
+  config.min_threads = 2;
+  config.max_threads = 4;
+  config.idle_timeout = ms(1);
+  config.check_interval = ms(1);
+  ElasticBackgroundThreads actual(config);
+  std::this_thread::sleep_for(ms(20));
+  EXPECT_EQ(2, actual.pool_size());
+  EXPECT_EQ(2, actual.pool_hwm());
+
+  actual.Shutdown();
+  EXPECT_EQ(0, actual.pool_size());
+}
+
+#ifdef __linux__
+/// @test Verify that the threads for each shard are pinned to its CPU set.
+TEST(AutomaticallyCreatedBackgroundThreads, ShardedCpuAffinity) {
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  std::vector<std::vector<int>> shard_cpus;
+  for (int cpu = 0; cpu != CPU_SETSIZE && shard_cpus.size() != 2; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) shard_cpus.push_back({cpu});
+  }
+  ASSERT_FALSE(shard_cpus.empty());
+
+  AutomaticallyCreatedBackgroundThreads actual(
+      shard_cpus.size(),
+      std::make_shared<DefaultCompletionQueueImpl>(false, shard_cpus.size()),
+      shard_cpus);
+  // Each timer starts on the next shard, and runs its callback in the thread
+  // serving that shard.
+  auto cq = actual.cq();
+  std::vector<future<cpu_set_t>> sets;
+  for (std::size_t i = 0; i != shard_cpus.size(); ++i) {
+    sets.push_back(
+        cq.MakeRelativeTimer(std::chrono::milliseconds(50))
+            .then([](future<StatusOr<std::chrono::system_clock::time_point>>) {
+              cpu_set_t set;
+              sched_getaffinity(0, sizeof(set), &set);
+              return set;
+            }));
+  }
+  std::set<int> pinned;
+  for (auto& f : sets) {
+    auto set = f.get();
+    ASSERT_EQ(1, CPU_COUNT(&set));
+    for (auto const& cpus : shard_cpus) {
+      if (CPU_ISSET(cpus.front(), &set)) pinned.insert(cpus.front());
+    }
+  }
+  EXPECT_EQ(shard_cpus.size(), pinned.size());
+}
+#endif  // __linux__
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
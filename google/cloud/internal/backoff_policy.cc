@@ -28,24 +28,16 @@ std::chrono::milliseconds ExponentialBackoffPolicy::OnCompletion() {
   using std::chrono::duration_cast;
   using std::chrono::microseconds;
   using std::chrono::milliseconds;
-  // We do not want to copy the seed in `clone()` because then all operations
-  // will have the same sequence of backoffs. Nor do we want to use a shared
-  // PRNG because that would require locking and some more complicated lifecycle
-  // management of the shared PRNG.
-  //
-  // Instead we exploit the following observation: most requests never need to
-  // backoff, they succeed on the first call.
-  //
-  // So we delay the initialization of the PRNG until the first call that needs
-  // to, that is here:
-  if (!generator_) {
-    generator_ = google::cloud::internal::MakeDefaultPRNG();
-  }
+  // Each thread seeds its PRNG once, the first time any policy in that thread
+  // needs to backoff. Cloning a policy is cheap, and the copies in different
+  // operations still get uncorrelated delays. Most operations never need to
+  // backoff, so most threads never seed a PRNG.
+  thread_local auto generator = google::cloud::internal::MakeDefaultPRNG();
   std::uniform_int_distribution<microseconds::rep> rng_distribution(
       current_delay_range_.count() / 2, current_delay_range_.count());
   // Randomized sleep period because it is possible that after some time all
   // client have same sleep period if we use only exponential backoff policy.
-  auto delay = microseconds(rng_distribution(*generator_));
+  auto delay = microseconds(rng_distribution(generator));
   current_delay_range_ = microseconds(static_cast<microseconds::rep>(
       static_cast<double>(current_delay_range_.count()) * scaling_));
   if (current_delay_range_ >= maximum_delay_) {
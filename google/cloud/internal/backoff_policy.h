@@ -18,9 +18,9 @@
 #include "google/cloud/internal/random.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/version.h"
-#include "absl/types/optional.h"
 #include <chrono>
 #include <memory>
+#include <type_traits>
 
 namespace google {
 namespace cloud {
@@ -138,14 +138,10 @@ class ExponentialBackoffPolicy : public BackoffPolicy {
     }
   }
 
-  // Do not copy the PRNG, we get two benefits:
-  //  - This works around a bug triggered by MSVC + `absl::optional` (we do not
-  //    know specifically which one is at fault)
-  //  - We want uncorrelated data streams for each copy anyway.
-  ExponentialBackoffPolicy(ExponentialBackoffPolicy const& rhs) noexcept
-      : current_delay_range_(rhs.current_delay_range_),
-        maximum_delay_(rhs.maximum_delay_),
-        scaling_(rhs.scaling_) {}
+  // The policy has no PRNG, copies are cheap and they never need to seed a
+  // PRNG. The jitter comes from a thread-local PRNG, see `OnCompletion()`.
+  ExponentialBackoffPolicy(ExponentialBackoffPolicy const& rhs) noexcept =
+      default;
 
   std::unique_ptr<BackoffPolicy> clone() const override;
   std::chrono::milliseconds OnCompletion() override;
@@ -154,7 +150,38 @@ class ExponentialBackoffPolicy : public BackoffPolicy {
   std::chrono::microseconds current_delay_range_;
   std::chrono::microseconds maximum_delay_;
   double scaling_;
-  absl::optional<DefaultPRNG> generator_;
+};
+
+/**
+ * Clones a backoff policy prototype on first use.
+ *
+ * Most operations succeed on the first attempt, and never backoff. The retry
+ * loops use this class to clone the backoff policy only when an operation
+ * needs to backoff. The prototype must outlive this object.
+ *
+ * The constructors are implicit, so the retry loops accept either a
+ * (previously cloned) policy or a reference to the prototype.
+ */
+class LazyBackoffPolicy {
+ public:
+  template <typename Policy,
+            typename std::enable_if<
+                std::is_base_of<BackoffPolicy, Policy>::value, int>::type = 0>
+  LazyBackoffPolicy(  // NOLINT(google-explicit-constructor)
+      std::unique_ptr<Policy> policy)
+      : policy_(std::move(policy)) {}
+  LazyBackoffPolicy(  // NOLINT(google-explicit-constructor)
+      BackoffPolicy const& prototype)
+      : prototype_(&prototype) {}
+
+  std::chrono::milliseconds OnCompletion() {
+    if (!policy_) policy_ = prototype_->clone();
+    return policy_->OnCompletion();
+  }
+
+ private:
+  BackoffPolicy const* prototype_ = nullptr;
+  std::unique_ptr<BackoffPolicy> policy_;
 };
 
 }  // namespace internal
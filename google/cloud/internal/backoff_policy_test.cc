@@ -137,3 +137,37 @@ TEST(ExponentialBackoffPolicy, ClonesHaveDifferentSequences) {
 
   EXPECT_THAT(sequence_1, Not(ElementsAreArray(sequence_2)));
 }
+
+/// @test Verify that the lazy policy clones the prototype only when needed.
+TEST(LazyBackoffPolicy, ClonesOnFirstUse) {
+  class CountingPolicy : public google::cloud::internal::BackoffPolicy {
+   public:
+    explicit CountingPolicy(int& clones) : clones_(clones) {}
+    std::unique_ptr<BackoffPolicy> clone() const override {
+      ++clones_;
+      return std::unique_ptr<BackoffPolicy>(new CountingPolicy(clones_));
+    }
+    std::chrono::milliseconds OnCompletion() override { return ms(++calls_); }
+
+   private:
+    int& clones_;
+    int calls_ = 0;
+  };
+
+  int clones = 0;
+  CountingPolicy prototype(clones);
+  {
+    google::cloud::internal::LazyBackoffPolicy unused(prototype);
+  }
+  EXPECT_EQ(0, clones);
+
+  google::cloud::internal::LazyBackoffPolicy tested(prototype);
+  EXPECT_EQ(ms(1), tested.OnCompletion());
+  EXPECT_EQ(ms(2), tested.OnCompletion());
+  EXPECT_EQ(1, clones);
+
+  google::cloud::internal::LazyBackoffPolicy owner(prototype.clone());
+  EXPECT_EQ(2, clones);
+  EXPECT_EQ(ms(1), owner.OnCompletion());
+  EXPECT_EQ(2, clones);
+}
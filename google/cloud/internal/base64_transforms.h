@@ -98,6 +98,46 @@ struct Base64Decoder {
 
 Status ValidateBase64String(std::string const& input);
 
+/// The number of characters needed to base64-encode @p size octets.
+std::size_t Base64EncodedSize(std::size_t size);
+
+/**
+ * Base64-encodes the @p size octets starting at @p data into the
+ * `Base64EncodedSize(size)` characters starting at @p out.
+ *
+ * Uses SSSE3 instructions when the CPU supports them.
+ */
+void Base64EncodeTo(unsigned char const* data, std::size_t size, char* out);
+
+/**
+ * Base64-encodes the @p size octets starting at @p data.
+ *
+ * The result is the same as pushing each octet into a `Base64Encoder`, but the
+ * output is allocated once and produced many octets at a time, which is
+ * considerably faster for large buffers.
+ */
+std::string Base64Encode(unsigned char const* data, std::size_t size);
+
+/// The number of octets encoded by the @p size characters starting at @p rep.
+std::size_t Base64DecodedSize(char const* rep, std::size_t size);
+
+/// The number of octets encoded by @p rep, which must be valid base64.
+std::size_t Base64DecodedSize(std::string const& rep);
+
+/**
+ * Decodes the @p size characters starting at @p rep, which must be valid
+ * base64, into the `Base64DecodedSize(rep, size)` octets starting at @p out.
+ *
+ * Uses SSSE3 instructions when the CPU supports them.
+ */
+void Base64DecodeTo(char const* rep, std::size_t size, unsigned char* out);
+
+/**
+ * Decodes @p rep, which must be valid base64, into the
+ * `Base64DecodedSize(rep)` octets starting at @p out.
+ */
+void Base64DecodeTo(std::string const& rep, unsigned char* out);
+
 StatusOr<std::vector<std::uint8_t>> Base64DecodeToBytes(
     std::string const& input);
 
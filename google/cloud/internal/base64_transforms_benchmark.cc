@@ -0,0 +1,98 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/base64_transforms.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+// Run on (1 X 2100 MHz CPU )
+// Before, with scalar code only:
+// ------------------------------------------------------------------
+// Benchmark                           Time             CPU   Iterations
+// ------------------------------------------------------------------
+// BM_Base64Encode/64                117 ns          116 ns      6117400
+// BM_Base64Encode/4096             5455 ns         5392 ns       130808
+// BM_Base64Encode/1048576       1249446 ns      1221861 ns          511
+// BM_Base64Decode/64               36.5 ns         36.3 ns     19215524
+// BM_Base64Decode/4096             2241 ns         2228 ns       319333
+// BM_Base64Decode/1048576        578221 ns       559588 ns         1259
+// BM_Base64DecodeToBytes/64         214 ns          212 ns      3314795
+// BM_Base64DecodeToBytes/4096      4833 ns         4801 ns       147464
+// BM_Base64DecodeToBytes/1048576 1221321 ns     1204522 ns          572
+//
+// After, with the SSSE3 fast paths:
+// ------------------------------------------------------------------
+// Benchmark                           Time             CPU   Iterations
+// ------------------------------------------------------------------
+// BM_Base64Encode/64               30.9 ns         30.7 ns     22498484
+// BM_Base64Encode/4096              676 ns          669 ns      1036250
+// BM_Base64Encode/1048576        200605 ns       199132 ns         3623
+// BM_Base64Decode/64               16.5 ns         16.3 ns     42222980
+// BM_Base64Decode/4096              708 ns          703 ns      1006827
+// BM_Base64Decode/1048576        252076 ns       186347 ns         3732
+// BM_Base64DecodeToBytes/64        78.7 ns         78.2 ns      8697638
+// BM_Base64DecodeToBytes/4096      2839 ns         2813 ns       258676
+// BM_Base64DecodeToBytes/1048576  807654 ns       797177 ns         1022
+
+std::vector<unsigned char> MakePlain(std::size_t size) {
+  std::vector<unsigned char> plain(size);
+  for (std::size_t i = 0; i != size; ++i) {
+    plain[i] = static_cast<unsigned char>(i * 73 + i / 256);
+  }
+  return plain;
+}
+
+void BM_Base64Encode(benchmark::State& state) {
+  auto const plain = MakePlain(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Base64Encode(plain.data(), plain.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Base64Encode)->Range(64, 1 << 20);
+
+void BM_Base64Decode(benchmark::State& state) {
+  auto const plain = MakePlain(static_cast<std::size_t>(state.range(0)));
+  auto const rep = Base64Encode(plain.data(), plain.size());
+  std::vector<unsigned char> decoded(plain.size());
+  for (auto _ : state) {
+    Base64DecodeTo(rep, decoded.data());
+    benchmark::DoNotOptimize(decoded.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Base64Decode)->Range(64, 1 << 20);
+
+void BM_Base64DecodeToBytes(benchmark::State& state) {
+  auto const plain = MakePlain(static_cast<std::size_t>(state.range(0)));
+  auto const rep = Base64Encode(plain.data(), plain.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Base64DecodeToBytes(rep));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Base64DecodeToBytes)->Range(64, 1 << 20);
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -112,6 +112,77 @@ TEST(Base64, WikiExample) {
   EXPECT_EQ(plain, decoded);
 }
 
+TEST(Base64, BulkMatchesIncremental) {
+  std::string plain;
+  for (int i = 0; i != 300; ++i) {
+    plain.push_back(static_cast<char>(i * 7));
+    Base64Encoder enc;
+    for (auto c : plain) enc.PushBack(c);
+    auto const expected = std::move(enc).FlushAndPad();
+    auto const actual = Base64Encode(
+        reinterpret_cast<unsigned char const*>(plain.data()), plain.size());
+    EXPECT_EQ(expected, actual);
+
+    ASSERT_EQ(plain.size(), Base64DecodedSize(actual));
+    std::string decoded(plain.size(), '\0');
+    Base64DecodeTo(actual, reinterpret_cast<unsigned char*>(&decoded[0]));
+    EXPECT_EQ(plain, decoded);
+  }
+}
+
+TEST(Base64, BulkToBuffer) {
+  // Use every octet value, and every base64 character, in each position of
+  // the blocks encoded and decoded at a time.
+  std::vector<unsigned char> plain;
+  for (int i = 0; i != 4 * 256; ++i) {
+    plain.push_back(static_cast<unsigned char>(i * 73 + i / 256));
+  }
+  for (std::size_t offset = 0; offset != 16; ++offset) {
+    auto const size = plain.size() - offset;
+    auto const* data = plain.data() + offset;
+    Base64Encoder enc;
+    for (std::size_t i = 0; i != size; ++i) enc.PushBack(data[i]);
+    auto const expected = std::move(enc).FlushAndPad();
+
+    ASSERT_EQ(expected.size(), Base64EncodedSize(size));
+    std::string actual(Base64EncodedSize(size), '\0');
+    Base64EncodeTo(data, size, &actual[0]);
+    EXPECT_EQ(expected, actual);
+
+    ASSERT_EQ(size, Base64DecodedSize(actual.data(), actual.size()));
+    std::vector<unsigned char> decoded(size);
+    Base64DecodeTo(actual.data(), actual.size(), decoded.data());
+    EXPECT_EQ(std::vector<unsigned char>(data, data + size), decoded);
+  }
+}
+
+TEST(Base64, DecodeToBytesLarge) {
+  std::string plain;
+  for (int i = 0; i != 1000; ++i) plain.push_back(static_cast<char>(i * 13));
+  auto const rep = Base64Encode(
+      reinterpret_cast<unsigned char const*>(plain.data()), plain.size());
+  auto bytes = Base64DecodeToBytes(rep);
+  ASSERT_STATUS_OK(bytes);
+  EXPECT_EQ(plain, std::string(bytes->begin(), bytes->end()));
+
+  // Invalid characters are detected anywhere in the input.
+  for (std::size_t offset : {std::size_t{0}, std::size_t{17}, rep.size() / 2,
+                             rep.size() - 5}) {
+    auto bad = rep;
+    bad[offset] = '.';
+    EXPECT_THAT(Base64DecodeToBytes(bad),
+                StatusIs(StatusCode::kInvalidArgument,
+                         ContainsRegex("Invalid base64.*at offset " +
+                                       std::to_string(offset / 4 * 4))));
+  }
+}
+
+TEST(Base64, BulkEmpty) {
+  EXPECT_EQ("", Base64Encode(nullptr, 0));
+  EXPECT_EQ(0, Base64DecodedSize(""));
+  Base64DecodeTo("", nullptr);
+}
+
 TEST(Base64, ValidateBase64StringFailures) {
   // Bad lengths.
   for (std::string const base64 : {"x", "xx", "xxx"}) {
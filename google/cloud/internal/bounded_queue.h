@@ -0,0 +1,266 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BOUNDED_QUEUE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BOUNDED_QUEUE_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/stream_range.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * A bounded multi-producer, multi-consumer queue.
+ *
+ * The queue is a ring buffer where each slot carries a sequence number, as
+ * described in [Vyukov's bounded MPMC queue][vyukov]. Producers and consumers
+ * claim slots with a single compare-and-swap on separate counters, so they
+ * only contend with threads of the same kind, and never hold a lock while
+ * moving the elements.
+ *
+ * `TryPush()` and `TryPop()` never block. `Push()` blocks while the queue is
+ * full, which provides backpressure to the producers, and `Pop()` blocks while
+ * it is empty. The blocking functions only take a mutex when they need to
+ * wait, or to wake up a waiting thread.
+ *
+ * `Shutdown()` wakes up all the waiting threads. After it is called pushes
+ * fail, and pops return the remaining elements, and then an empty optional.
+ *
+ * [vyukov]: https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  /// Creates a queue holding at least @p capacity elements.
+  explicit BoundedQueue(std::size_t capacity)
+      : mask_(RoundUp(capacity) - 1), cells_(new Cell[mask_ + 1]) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~BoundedQueue() {
+    while (TryPop()) continue;
+  }
+
+  BoundedQueue(BoundedQueue const&) = delete;
+  BoundedQueue& operator=(BoundedQueue const&) = delete;
+
+  /// The maximum number of elements in the queue.
+  std::size_t capacity() const { return mask_ + 1; }
+
+  /// Adds @p value, returns false if the queue is full or shutdown.
+  bool TryPush(T& value) {
+    if (shutdown_.load(std::memory_order_acquire)) return false;
+    if (!Enqueue(value)) return false;
+    Notify(pop_waiters_, pop_cv_);
+    return true;
+  }
+
+  /// Removes the oldest element, if any.
+  absl::optional<T> TryPop() {
+    auto value = Dequeue();
+    if (value) Notify(push_waiters_, push_cv_);
+    return value;
+  }
+
+  /**
+   * Adds @p value, blocking while the queue is full.
+   *
+   * Returns false, discarding @p value, if the queue is shutdown.
+   */
+  bool Push(T value) {
+    for (;;) {
+      if (TryPush(value)) return true;
+      std::unique_lock<std::mutex> lk(mu_);
+      push_waiters_.fetch_add(1);
+      auto const shutdown = shutdown_.load();
+      auto const pushed = !shutdown && Enqueue(value);
+      if (!shutdown && !pushed) push_cv_.wait(lk);
+      push_waiters_.fetch_sub(1);
+      if (shutdown) return false;
+      if (!pushed) continue;
+      lk.unlock();
+      Notify(pop_waiters_, pop_cv_);
+      return true;
+    }
+  }
+
+  /**
+   * Removes the oldest element, blocking while the queue is empty.
+   *
+   * Returns an empty optional once the queue is shutdown and empty.
+   */
+  absl::optional<T> Pop() {
+    for (;;) {
+      if (auto value = TryPop()) return value;
+      std::unique_lock<std::mutex> lk(mu_);
+      pop_waiters_.fetch_add(1);
+      auto value = Dequeue();
+      auto const done = value || shutdown_.load();
+      if (!done) pop_cv_.wait(lk);
+      pop_waiters_.fetch_sub(1);
+      if (!done) continue;
+      lk.unlock();
+      if (value) Notify(push_waiters_, push_cv_);
+      return value;
+    }
+  }
+
+  /// Fails any pending and future pushes, and wakes up all the waiters.
+  void Shutdown() {
+    std::unique_lock<std::mutex> lk(mu_);
+    shutdown_.store(true);
+    lk.unlock();
+    push_cv_.notify_all();
+    pop_cv_.notify_all();
+  }
+
+  bool IsShutdown() const { return shutdown_.load(); }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  // Avoid false sharing between the producer and consumer counters.
+  struct PaddedCounter {
+    char padding[64];
+    std::atomic<std::size_t> value{0};
+  };
+
+  // The algorithm requires a power of two, and at least two slots.
+  static std::size_t RoundUp(std::size_t n) {
+    std::size_t r = 2;
+    while (r < n) r <<= 1;
+    return r;
+  }
+
+  bool Enqueue(T& value) {
+    auto pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = cells_[pos & mask_];
+      auto const seq = cell.sequence.load();
+      auto const diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff < 0) return false;  // full
+      if (diff > 0) {
+        pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (enqueue_pos_.value.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed)) {
+        ::new (&cell.storage) T(std::move(value));
+        cell.sequence.store(pos + 1);
+        return true;
+      }
+    }
+  }
+
+  absl::optional<T> Dequeue() {
+    auto pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = cells_[pos & mask_];
+      auto const seq = cell.sequence.load();
+      auto const diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff < 0) return absl::nullopt;  // empty
+      if (diff > 0) {
+        pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (dequeue_pos_.value.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed)) {
+        auto* p = reinterpret_cast<T*>(&cell.storage);
+        absl::optional<T> value(std::move(*p));
+        p->~T();
+        cell.sequence.store(pos + mask_ + 1);
+        return value;
+      }
+    }
+  }
+
+  // A waiter increments its counter, then checks the queue again, while
+  // holding `mu_`. The slot sequence numbers and the counters use sequentially
+  // consistent operations, so either the waiter finds the new element (or
+  // free slot), or this function finds the waiter. In the latter case the
+  // mutex guarantees the waiter is blocked in the condition variable before it
+  // is notified.
+  void Notify(std::atomic<int>& waiters, std::condition_variable& cv) {
+    if (waiters.load() == 0) return;
+    std::unique_lock<std::mutex> lk(mu_);
+    lk.unlock();
+    cv.notify_one();
+  }
+
+  std::size_t const mask_;
+  std::unique_ptr<Cell[]> cells_;
+  PaddedCounter enqueue_pos_;
+  PaddedCounter dequeue_pos_;
+  std::atomic<bool> shutdown_{false};
+  std::atomic<int> push_waiters_{0};
+  std::atomic<int> pop_waiters_{0};
+  std::mutex mu_;
+  std::condition_variable push_cv_;
+  std::condition_variable pop_cv_;
+};
+
+/**
+ * Reads @p range in a new thread, pushing each element into @p queue.
+ *
+ * The thread blocks while the queue is full, so the range is only read as fast
+ * as the consumers pop the elements. The thread shuts down the queue after
+ * pushing the last element, which is an error if the range ends with one.
+ * Consumers can stop the thread early by shutting down the queue, the thread
+ * then discards the rest of the range.
+ *
+ * The queue must not be shared with other producers. The caller must join the
+ * returned thread.
+ */
+template <typename T>
+std::thread DrainStreamRange(StreamRange<T> range,
+                             std::shared_ptr<BoundedQueue<StatusOr<T>>> queue) {
+  return std::thread(
+      [](StreamRange<T> range,
+         std::shared_ptr<BoundedQueue<StatusOr<T>>> const& queue) {
+        for (auto& value : range) {
+          auto const ok = value.ok();
+          if (!queue->Push(std::move(value)) || !ok) break;
+        }
+        queue->Shutdown();
+      },
+      std::move(range), std::move(queue));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BOUNDED_QUEUE_H
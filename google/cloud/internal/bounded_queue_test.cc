@@ -0,0 +1,177 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/bounded_queue.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+TEST(BoundedQueue, TryPushTryPop) {
+  BoundedQueue<int> queue(3);
+  EXPECT_EQ(4, queue.capacity());
+  for (int i = 0; i != 4; ++i) EXPECT_TRUE(queue.TryPush(i));
+  int v = 4;
+  EXPECT_FALSE(queue.TryPush(v));
+  std::vector<int> values;
+  while (auto value = queue.TryPop()) values.push_back(*value);
+  EXPECT_THAT(values, ElementsAre(0, 1, 2, 3));
+  // The slots are reused after wrapping around.
+  EXPECT_TRUE(queue.TryPush(v));
+  EXPECT_EQ(4, queue.TryPop().value_or(-1));
+}
+
+TEST(BoundedQueue, ShutdownDrains) {
+  BoundedQueue<int> queue(4);
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  queue.Shutdown();
+  EXPECT_TRUE(queue.IsShutdown());
+  EXPECT_FALSE(queue.Push(3));
+  EXPECT_EQ(1, queue.Pop().value_or(-1));
+  EXPECT_EQ(2, queue.Pop().value_or(-1));
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+TEST(BoundedQueue, DestroysRemainingElements) {
+  auto counter = std::make_shared<int>(0);
+  {
+    BoundedQueue<std::shared_ptr<int>> queue(4);
+    queue.Push(counter);
+    queue.Push(counter);
+    EXPECT_EQ(3, counter.use_count());
+  }
+  EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(BoundedQueue, PushBlocksWhileFull) {
+  BoundedQueue<int> queue(1);
+  EXPECT_EQ(2, queue.capacity());
+  EXPECT_TRUE(queue.Push(0));
+  EXPECT_TRUE(queue.Push(1));
+  std::atomic<bool> pushed{false};
+  std::thread producer([&] {
+    EXPECT_TRUE(queue.Push(2));
+    pushed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(pushed.load());
+  EXPECT_EQ(0, queue.Pop().value_or(-1));
+  EXPECT_EQ(1, queue.Pop().value_or(-1));
+  EXPECT_EQ(2, queue.Pop().value_or(-1));
+  producer.join();
+  EXPECT_TRUE(pushed.load());
+}
+
+TEST(BoundedQueue, ShutdownWakesUpWaiters) {
+  BoundedQueue<int> queue(2);
+  EXPECT_TRUE(queue.Push(0));
+  EXPECT_TRUE(queue.Push(1));
+  std::thread producer([&] { EXPECT_FALSE(queue.Push(2)); });
+  BoundedQueue<int> empty(1);
+  std::thread consumer([&] { EXPECT_FALSE(empty.Pop().has_value()); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.Shutdown();
+  empty.Shutdown();
+  producer.join();
+  consumer.join();
+}
+
+TEST(BoundedQueue, MultipleProducersAndConsumers) {
+  auto constexpr kThreads = 4;
+  auto constexpr kCount = 20000;
+  BoundedQueue<int> queue(16);
+  std::vector<std::thread> producers;
+  for (int t = 0; t != kThreads; ++t) {
+    producers.emplace_back([&queue] {
+      for (int i = 1; i <= kCount; ++i) queue.Push(i);
+    });
+  }
+  std::atomic<std::int64_t> sum{0};
+  std::atomic<int> count{0};
+  std::vector<std::thread> consumers;
+  for (int t = 0; t != kThreads; ++t) {
+    consumers.emplace_back([&] {
+      for (auto v = queue.Pop(); v; v = queue.Pop()) {
+        sum += *v;
+        ++count;
+      }
+    });
+  }
+  for (auto& t : producers) t.join();
+  queue.Shutdown();
+  for (auto& t : consumers) t.join();
+  EXPECT_EQ(kThreads * kCount, count.load());
+  EXPECT_EQ(std::int64_t{kThreads} * kCount * (kCount + 1) / 2, sum.load());
+}
+
+StreamRange<int> MakeRange(int n, Status last) {
+  auto counter = std::make_shared<int>(0);
+  return MakeStreamRange<int>(
+      [counter, n, last]() -> absl::variant<Status, int> {
+        if (*counter < n) return (*counter)++;
+        return last;
+      });
+}
+
+TEST(BoundedQueue, DrainStreamRange) {
+  auto queue = std::make_shared<BoundedQueue<StatusOr<int>>>(2);
+  auto drain = DrainStreamRange(MakeRange(10, Status{}), queue);
+  std::vector<int> values;
+  for (auto v = queue->Pop(); v; v = queue->Pop()) {
+    ASSERT_STATUS_OK(*v);
+    values.push_back(**v);
+  }
+  drain.join();
+  EXPECT_THAT(values, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(BoundedQueue, DrainStreamRangeError) {
+  auto queue = std::make_shared<BoundedQueue<StatusOr<int>>>(2);
+  auto drain = DrainStreamRange(
+      MakeRange(3, Status(StatusCode::kUnavailable, "try-again")), queue);
+  std::vector<StatusOr<int>> values;
+  for (auto v = queue->Pop(); v; v = queue->Pop()) values.push_back(*v);
+  drain.join();
+  ASSERT_EQ(4, values.size());
+  EXPECT_THAT(values.back(), StatusIs(StatusCode::kUnavailable));
+}
+
+TEST(BoundedQueue, DrainStreamRangeStopsOnShutdown) {
+  auto queue = std::make_shared<BoundedQueue<StatusOr<int>>>(2);
+  auto drain = DrainStreamRange(MakeRange(1000000, Status{}), queue);
+  auto v = queue->Pop();
+  ASSERT_TRUE(v.has_value());
+  queue->Shutdown();
+  drain.join();
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
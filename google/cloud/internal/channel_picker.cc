@@ -0,0 +1,144 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/channel_picker.h"
+#include "google/cloud/grpc_options.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+// The pickers only need to spread the load, they do not need to agree on the
+// order of the RPCs, so all the counters use relaxed atomics instead of locks.
+class RoundRobinChannelPicker : public ChannelPicker {
+ public:
+  explicit RoundRobinChannelPicker(std::size_t size)
+      : size_((std::max)(size, std::size_t{1})) {}
+
+  std::size_t Acquire() override {
+    return next_.fetch_add(1, std::memory_order_relaxed) % size_;
+  }
+
+ private:
+  std::size_t const size_;
+  std::atomic<std::size_t> next_{0};
+};
+
+class LeastOutstandingChannelPicker : public ChannelPicker {
+ public:
+  explicit LeastOutstandingChannelPicker(std::size_t size)
+      : outstanding_((std::max)(size, std::size_t{1})) {}
+
+  std::size_t Acquire() override {
+    auto const size = outstanding_.size();
+    // Start the scan at a different channel each time, so ties are broken in
+    // round robin order.
+    auto const start = next_.fetch_add(1, std::memory_order_relaxed) % size;
+    auto best = start;
+    auto best_count = outstanding_[start].load(std::memory_order_relaxed);
+    for (std::size_t i = 1; i != size && best_count != 0; ++i) {
+      auto const index = (start + i) % size;
+      auto const count = outstanding_[index].load(std::memory_order_relaxed);
+      if (count < best_count) {
+        best = index;
+        best_count = count;
+      }
+    }
+    outstanding_[best].fetch_add(1, std::memory_order_relaxed);
+    return best;
+  }
+
+  void Release(std::size_t index) override {
+    outstanding_[index].fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  bool TracksOutstanding() const override { return true; }
+
+ private:
+  std::vector<std::atomic<std::int64_t>> outstanding_;
+  std::atomic<std::size_t> next_{0};
+};
+
+class ChannelStatePicker : public ChannelPicker {
+ public:
+  explicit ChannelStatePicker(std::vector<ChannelStateFunction> states)
+      : states_(std::move(states)) {}
+
+  std::size_t Acquire() override {
+    auto const size = states_.size();
+    auto const start = next_.fetch_add(1, std::memory_order_relaxed) % size;
+    for (std::size_t i = 0; i != size; ++i) {
+      auto const index = (start + i) % size;
+      auto const state = states_[index]();
+      if (state != GRPC_CHANNEL_TRANSIENT_FAILURE &&
+          state != GRPC_CHANNEL_SHUTDOWN) {
+        return index;
+      }
+    }
+    return start;
+  }
+
+ private:
+  std::vector<ChannelStateFunction> const states_;
+  std::atomic<std::size_t> next_{0};
+};
+
+}  // namespace
+
+std::shared_ptr<ChannelPicker> MakeRoundRobinChannelPicker(std::size_t size) {
+  return std::make_shared<RoundRobinChannelPicker>(size);
+}
+
+std::shared_ptr<ChannelPicker> MakeLeastOutstandingChannelPicker(
+    std::size_t size) {
+  return std::make_shared<LeastOutstandingChannelPicker>(size);
+}
+
+std::shared_ptr<ChannelPicker> MakeChannelStatePicker(
+    std::vector<ChannelStateFunction> states) {
+  if (states.empty()) return MakeRoundRobinChannelPicker(1);
+  return std::make_shared<ChannelStatePicker>(std::move(states));
+}
+
+std::shared_ptr<ChannelPicker> MakeChannelPicker(
+    std::vector<std::shared_ptr<grpc::Channel>> const& channels,
+    Options const& options) {
+  switch (options.get<GrpcChannelSelectionOption>()) {
+    case ChannelSelection::kLeastOutstanding:
+      return MakeLeastOutstandingChannelPicker(channels.size());
+    case ChannelSelection::kChannelState: {
+      std::vector<ChannelStateFunction> states;
+      states.reserve(channels.size());
+      for (auto const& c : channels) {
+        // Do not try to connect idle channels, the next RPC does that.
+        states.emplace_back([c] { return c->GetState(false); });
+      }
+      return MakeChannelStatePicker(std::move(states));
+    }
+    case ChannelSelection::kRoundRobin:
+    default:
+      break;
+  }
+  return MakeRoundRobinChannelPicker(channels.size());
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,94 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_CHANNEL_PICKER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_CHANNEL_PICKER_H
+
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/version.h"
+#include <grpcpp/channel.h>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Picks the channel (and stub) used by each RPC in the `*RoundRobin` stubs.
+ *
+ * The stubs call `Acquire()` before each RPC and `Release()` with the same
+ * index once the RPC completes. Streaming RPCs are released as soon as the
+ * stream is created.
+ */
+class ChannelPicker {
+ public:
+  virtual ~ChannelPicker() = default;
+
+  /// Returns the index of the channel for the next RPC.
+  virtual std::size_t Acquire() = 0;
+
+  /// Called when the RPC started by `Acquire()` on @p index completes.
+  virtual void Release(std::size_t /*index*/) {}
+
+  /// If false, `Release()` does nothing and the callers may skip it.
+  virtual bool TracksOutstanding() const { return false; }
+};
+
+/// Cycles through @p size channels.
+std::shared_ptr<ChannelPicker> MakeRoundRobinChannelPicker(std::size_t size);
+
+/// Picks the channel with the fewest outstanding RPCs out of @p size.
+std::shared_ptr<ChannelPicker> MakeLeastOutstandingChannelPicker(
+    std::size_t size);
+
+/// Returns the connectivity state of one channel, without connecting it.
+using ChannelStateFunction = std::function<grpc_connectivity_state()>;
+
+/**
+ * Cycles through the channels, skipping any channels in the
+ * `GRPC_CHANNEL_TRANSIENT_FAILURE` or `GRPC_CHANNEL_SHUTDOWN` states.
+ *
+ * If all the channels are failing this behaves like round robin.
+ */
+std::shared_ptr<ChannelPicker> MakeChannelStatePicker(
+    std::vector<ChannelStateFunction> states);
+
+/// Creates the picker for @p channels selected by `GrpcChannelSelectionOption`.
+std::shared_ptr<ChannelPicker> MakeChannelPicker(
+    std::vector<std::shared_ptr<grpc::Channel>> const& channels,
+    Options const& options);
+
+/// Releases @p index in @p picker once @p f is satisfied.
+template <typename T>
+future<T> ReleaseOnCompletion(std::shared_ptr<ChannelPicker> const& picker,
+                              std::size_t index, future<T> f) {
+  if (!picker->TracksOutstanding()) return f;
+  auto p = picker;
+  return f.then([p, index](future<T> g) {
+    p->Release(index);
+    return g.get();
+  });
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_CHANNEL_PICKER_H
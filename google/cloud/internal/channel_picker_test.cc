@@ -0,0 +1,127 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/channel_picker.h"
+#include "google/cloud/grpc_options.h"
+#include <gmock/gmock.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<std::size_t> AcquireN(ChannelPicker& picker, int n) {
+  std::vector<std::size_t> result;
+  for (int i = 0; i != n; ++i) result.push_back(picker.Acquire());
+  return result;
+}
+
+TEST(ChannelPickerTest, RoundRobin) {
+  auto picker = MakeRoundRobinChannelPicker(3);
+  EXPECT_FALSE(picker->TracksOutstanding());
+  EXPECT_THAT(AcquireN(*picker, 7), ElementsAre(0, 1, 2, 0, 1, 2, 0));
+}
+
+TEST(ChannelPickerTest, RoundRobinEmpty) {
+  auto picker = MakeRoundRobinChannelPicker(0);
+  EXPECT_THAT(AcquireN(*picker, 2), ElementsAre(0, 0));
+}
+
+TEST(ChannelPickerTest, LeastOutstanding) {
+  auto picker = MakeLeastOutstandingChannelPicker(3);
+  EXPECT_TRUE(picker->TracksOutstanding());
+  // With no outstanding RPCs this behaves like round robin.
+  EXPECT_THAT(AcquireN(*picker, 3), ElementsAre(0, 1, 2));
+  // Channel 1 is the only channel with fewer RPCs.
+  picker->Release(1);
+  EXPECT_THAT(AcquireN(*picker, 1), ElementsAre(1));
+  picker->Release(2);
+  picker->Release(0);
+  // Channels 0 and 2 are idle, the ties are broken in round robin order.
+  EXPECT_THAT(AcquireN(*picker, 2), ElementsAre(2, 0));
+}
+
+TEST(ChannelPickerTest, ChannelStateSkipsFailures) {
+  std::vector<grpc_connectivity_state> states = {
+      GRPC_CHANNEL_READY, GRPC_CHANNEL_TRANSIENT_FAILURE, GRPC_CHANNEL_IDLE,
+      GRPC_CHANNEL_SHUTDOWN};
+  std::vector<ChannelStateFunction> functions;
+  for (std::size_t i = 0; i != states.size(); ++i) {
+    functions.emplace_back([&states, i] { return states[i]; });
+  }
+  auto picker = MakeChannelStatePicker(std::move(functions));
+  EXPECT_FALSE(picker->TracksOutstanding());
+  EXPECT_THAT(AcquireN(*picker, 4), ElementsAre(0, 2, 2, 0));
+
+  // Channels recover, and are used again.
+  states[1] = GRPC_CHANNEL_CONNECTING;
+  EXPECT_THAT(AcquireN(*picker, 2), ElementsAre(0, 1));
+}
+
+TEST(ChannelPickerTest, ChannelStateAllFailing) {
+  std::vector<ChannelStateFunction> functions(
+      3, [] { return GRPC_CHANNEL_TRANSIENT_FAILURE; });
+  auto picker = MakeChannelStatePicker(std::move(functions));
+  EXPECT_THAT(AcquireN(*picker, 4), ElementsAre(0, 1, 2, 0));
+}
+
+TEST(ChannelPickerTest, MakeChannelPicker) {
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  for (int i = 0; i != 2; ++i) {
+    channels.push_back(grpc::CreateChannel(
+        "localhost:1", grpc::InsecureChannelCredentials()));
+  }
+  auto picker = MakeChannelPicker(channels, Options{});
+  EXPECT_FALSE(picker->TracksOutstanding());
+  EXPECT_THAT(AcquireN(*picker, 3), ElementsAre(0, 1, 0));
+
+  picker = MakeChannelPicker(
+      channels, Options{}.set<GrpcChannelSelectionOption>(
+                    ChannelSelection::kLeastOutstanding));
+  EXPECT_TRUE(picker->TracksOutstanding());
+
+  // The channels are idle, they are not skipped.
+  picker = MakeChannelPicker(channels,
+                             Options{}.set<GrpcChannelSelectionOption>(
+                                 ChannelSelection::kChannelState));
+  EXPECT_FALSE(picker->TracksOutstanding());
+  EXPECT_THAT(AcquireN(*picker, 3), ElementsAre(0, 1, 0));
+}
+
+TEST(ChannelPickerTest, ReleaseOnCompletion) {
+  auto picker = MakeLeastOutstandingChannelPicker(2);
+  EXPECT_EQ(0, picker->Acquire());
+  promise<int> p;
+  auto f = ReleaseOnCompletion(picker, 0, p.get_future());
+  // Channel 0 is still busy.
+  EXPECT_EQ(1, picker->Acquire());
+  picker->Release(1);
+  EXPECT_EQ(1, picker->Acquire());
+  picker->Release(1);
+  p.set_value(42);
+  EXPECT_EQ(42, f.get());
+  // Both channels are idle, the ties are broken in round robin order.
+  EXPECT_THAT(AcquireN(*picker, 2), ElementsAre(1, 0));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -18,6 +18,7 @@
 #include "google/cloud/async_operation.h"
 #include "google/cloud/future.h"
 #include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/small_object_pool.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
@@ -33,6 +34,19 @@ namespace internal {
 struct RunAsyncBase {
   virtual ~RunAsyncBase() = default;
   virtual void exec() = 0;
+
+  // These objects are created (and destroyed) at a very high rate, use a pool
+  // to amortize the cost of allocating them.
+  static void* operator new(std::size_t size) {
+    return SmallObjectPoolAllocate(size);
+  }
+  static void operator delete(void* p, std::size_t size) {
+    SmallObjectPoolDeallocate(p, size);
+  }
+
+  // Allows implementations to queue these objects without any additional
+  // allocations.
+  RunAsyncBase* next_run_async = nullptr;
 };
 
 /**
@@ -64,6 +78,19 @@ class CompletionQueueImpl {
   virtual future<StatusOr<std::chrono::system_clock::time_point>>
   MakeRelativeTimer(std::chrono::nanoseconds duration) = 0;
 
+  /**
+   * Create a new timer, sharing the underlying alarm with similar timers.
+   *
+   * The timer expires at the end of the @p tick containing `now + duration`.
+   * Implementations may use a single alarm for all the timers expiring at the
+   * same time. The default implementation does not coalesce timers.
+   */
+  virtual future<StatusOr<std::chrono::system_clock::time_point>>
+  MakeCoalescedRelativeTimer(std::chrono::nanoseconds duration,
+                             std::chrono::nanoseconds /*tick*/) {
+    return MakeRelativeTimer(duration);
+  }
+
   /// Enqueue a new asynchronous function.
   virtual void RunAsync(std::unique_ptr<RunAsyncBase> function) = 0;
 
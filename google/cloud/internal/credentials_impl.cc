@@ -30,8 +30,10 @@ ImpersonateServiceAccountConfig::ImpersonateServiceAccountConfig(
     : base_credentials_(std::move(base_credentials)),
       target_service_account_(std::move(target_service_account)),
       lifetime_(opts.get<AccessTokenLifetimeOption>()),
+      refresh_lead_time_(opts.get<AccessTokenRefreshLeadTimeOption>()),
       scopes_(std::move(opts.lookup<ScopesOption>())),
-      delegates_(std::move(opts.lookup<DelegatesOption>())) {}
+      delegates_(std::move(opts.lookup<DelegatesOption>())),
+      caches_(std::make_shared<SharedCaches>()) {}
 
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
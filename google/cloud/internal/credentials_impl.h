@@ -22,8 +22,11 @@
 #include "absl/types/optional.h"
 #include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace google {
@@ -98,17 +101,59 @@ class ImpersonateServiceAccountConfig : public Credentials {
     return target_service_account_;
   }
   std::chrono::seconds lifetime() const { return lifetime_; }
+  std::chrono::seconds refresh_lead_time() const { return refresh_lead_time_; }
   std::vector<std::string> const& scopes() const { return scopes_; }
   std::vector<std::string> const& delegates() const { return delegates_; }
 
+  /**
+   * Returns the token cache shared by all the clients using these credentials.
+   *
+   * Clients created from the same `Credentials` object share a single cache,
+   * and thus make a single request to refresh the token. The cache is created
+   * by @p factory on first use, and deleted once no client uses it. Each
+   * transport (gRPC or REST) uses a different type of cache, @p T selects it.
+   *
+   * The cache is created with the configuration of the first client that uses
+   * it, e.g., the IAM Credentials endpoint. Callers must encode in @p key any
+   * client configuration used by @p factory, so clients with a different
+   * configuration get a different cache.
+   *
+   * @note The key cannot capture resources owned by the first client, such as
+   *     its completion queue, and the cache may outlive that client. Caches
+   *     that depend on those resources must not be shared. For example, the
+   *     gRPC transport does not share the cache when the base credentials are
+   *     also impersonated, because the base credentials refresh their tokens
+   *     using the completion queue of the client that created them.
+   */
+  template <typename T>
+  std::shared_ptr<T> SharedCache(
+      std::string const& key,
+      std::function<std::shared_ptr<T>()> const& factory) const {
+    static char const kType = 0;
+    std::lock_guard<std::mutex> lk(caches_->mu);
+    auto& slot = caches_->caches[std::make_pair(&kType, key)];
+    auto cache = std::static_pointer_cast<T>(slot.lock());
+    if (cache) return cache;
+    cache = factory();
+    slot = cache;
+    return cache;
+  }
+
  private:
+  struct SharedCaches {
+    std::mutex mu;
+    std::map<std::pair<void const*, std::string>, std::weak_ptr<void>> caches;
+  };
+
   void dispatch(CredentialsVisitor& v) override { v.visit(*this); }
 
   std::shared_ptr<Credentials> base_credentials_;
   std::string target_service_account_;
   std::chrono::seconds lifetime_;
+  std::chrono::seconds refresh_lead_time_;
   std::vector<std::string> scopes_;
   std::vector<std::string> delegates_;
+  std::shared_ptr<SharedCaches> caches_;
 };
 
 class ServiceAccountConfig : public Credentials {
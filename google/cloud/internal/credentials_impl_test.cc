@@ -14,6 +14,9 @@
 
 #include "google/cloud/internal/credentials_impl.h"
 #include <gmock/gmock.h>
+#include <functional>
+#include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -87,6 +90,7 @@ TEST(Credentials, ImpersonateServiceAccountCredentialsDefault) {
   EXPECT_EQ("invalid-test-only@invalid.address",
             visitor.impersonate->target_service_account());
   EXPECT_EQ(std::chrono::hours(1), visitor.impersonate->lifetime());
+  EXPECT_EQ(std::chrono::minutes(5), visitor.impersonate->refresh_lead_time());
   EXPECT_THAT(visitor.impersonate->scopes(),
               ElementsAre("https://www.googleapis.com/auth/cloud-platform"));
   EXPECT_THAT(visitor.impersonate->delegates(), IsEmpty());
@@ -97,6 +101,7 @@ TEST(Credentials, ImpersonateServiceAccountCredentialsDefaultWithOptions) {
       MakeGoogleDefaultCredentials(), "invalid-test-only@invalid.address",
       Options{}
           .set<AccessTokenLifetimeOption>(std::chrono::minutes(15))
+          .set<AccessTokenRefreshLeadTimeOption>(std::chrono::minutes(2))
           .set<ScopesOption>({"scope1", "scope2"})
           .set<DelegatesOption>({"delegate1", "delegate2"}));
   Visitor visitor;
@@ -105,11 +110,49 @@ TEST(Credentials, ImpersonateServiceAccountCredentialsDefaultWithOptions) {
   EXPECT_EQ("invalid-test-only@invalid.address",
             visitor.impersonate->target_service_account());
   EXPECT_EQ(std::chrono::minutes(15), visitor.impersonate->lifetime());
+  EXPECT_EQ(std::chrono::minutes(2), visitor.impersonate->refresh_lead_time());
   EXPECT_THAT(visitor.impersonate->scopes(), ElementsAre("scope1", "scope2"));
   EXPECT_THAT(visitor.impersonate->delegates(),
               ElementsAre("delegate1", "delegate2"));
 }
 
+TEST(Credentials, ImpersonateServiceAccountSharedCache) {
+  auto credentials = MakeImpersonateServiceAccountCredentials(
+      MakeGoogleDefaultCredentials(), "invalid-test-only@invalid.address");
+  Visitor visitor;
+  CredentialsVisitor::dispatch(*credentials, visitor);
+  ASSERT_THAT(visitor.impersonate, Not(IsNull()));
+  auto const& config = *visitor.impersonate;
+
+  int created = 0;
+  std::function<std::shared_ptr<int>()> int_factory = [&created] {
+    ++created;
+    return std::make_shared<int>(42);
+  };
+  auto c0 = config.SharedCache("k", int_factory);
+  auto c1 = config.SharedCache("k", int_factory);
+  EXPECT_EQ(c0, c1);
+  EXPECT_EQ(1, created);
+
+  // Clients with a different configuration do not share the cache.
+  auto other = config.SharedCache("other", int_factory);
+  EXPECT_NE(c0, other);
+  EXPECT_EQ(2, created);
+  other.reset();
+
+  // Each type of cache is independent.
+  std::function<std::shared_ptr<std::string>()> string_factory = [] {
+    return std::make_shared<std::string>("cache");
+  };
+  EXPECT_EQ("cache", *config.SharedCache("k", string_factory));
+
+  // The cache is recreated once no client uses it.
+  c0.reset();
+  c1.reset();
+  auto c2 = config.SharedCache("k", int_factory);
+  EXPECT_EQ(3, created);
+}
+
 TEST(Credentials, ServiceAccount) {
   auto credentials = MakeServiceAccountCredentials("test-only-invalid");
   Visitor visitor;
@@ -16,6 +16,9 @@
 #include "google/cloud/internal/throw_delegate.h"
 #include "absl/memory/memory.h"
 #include <grpcpp/alarm.h>
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <sstream>
 
 // There is no way to unblock the gRPC event loop, not even calling Shutdown(),
@@ -23,6 +26,9 @@
 // shutdown the run.
 std::chrono::milliseconds constexpr kLoopTimeout(50);
 
+// Threads started via `Run()` pick the shard with the fewest threads.
+auto constexpr kAnyShard = std::numeric_limits<std::size_t>::max();
+
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
@@ -94,8 +100,9 @@ class AsyncTimerFuture : public internal::AsyncGrpcOperation {
 class DefaultCompletionQueueImpl::WakeUpRunAsyncLoop
     : public internal::AsyncGrpcOperation {
  public:
-  explicit WakeUpRunAsyncLoop(std::weak_ptr<DefaultCompletionQueueImpl> w)
-      : weak_(std::move(w)) {}
+  WakeUpRunAsyncLoop(std::weak_ptr<DefaultCompletionQueueImpl> w,
+                     std::size_t shard)
+      : weak_(std::move(w)), shard_(shard) {}
 
   void Set(grpc::CompletionQueue& cq, void* tag) {
     alarm_.Set(&cq, std::chrono::system_clock::now(), tag);
@@ -106,11 +113,12 @@ class DefaultCompletionQueueImpl::WakeUpRunAsyncLoop
  private:
   bool Notify(bool ok) override {
     if (!ok) return true;  // do not run async operations on shutdown CQs
-    if (auto self = weak_.lock()) self->DrainRunAsyncLoop();
+    if (auto self = weak_.lock()) self->DrainRunAsyncLoop(shard_);
     return true;
   }
 
   std::weak_ptr<DefaultCompletionQueueImpl> weak_;
+  std::size_t shard_;
   grpc::Alarm alarm_;
 };
 
@@ -119,8 +127,9 @@ class DefaultCompletionQueueImpl::WakeUpRunAsyncLoop
 class DefaultCompletionQueueImpl::WakeUpRunAsyncOnIdle
     : public internal::AsyncGrpcOperation {
  public:
-  explicit WakeUpRunAsyncOnIdle(std::weak_ptr<DefaultCompletionQueueImpl> w)
-      : weak_(std::move(w)) {}
+  WakeUpRunAsyncOnIdle(std::weak_ptr<DefaultCompletionQueueImpl> w,
+                       std::size_t shard)
+      : weak_(std::move(w)), shard_(shard) {}
 
   void Set(grpc::CompletionQueue& cq, void* tag) {
     alarm_.Set(&cq, std::chrono::system_clock::now(), tag);
@@ -131,52 +140,117 @@ class DefaultCompletionQueueImpl::WakeUpRunAsyncOnIdle
  private:
   bool Notify(bool ok) override {
     if (!ok) return true;  // do not run async operations on shutdown CQs
-    if (auto self = weak_.lock()) self->DrainRunAsyncOnIdle();
+    if (auto self = weak_.lock()) self->DrainRunAsyncOnIdle(shard_);
     return true;
   }
 
   std::weak_ptr<DefaultCompletionQueueImpl> weak_;
+  std::size_t shard_;
   grpc::Alarm alarm_;
 };
 
-DefaultCompletionQueueImpl::DefaultCompletionQueueImpl()
-    : shutdown_guard_(
+DefaultCompletionQueueImpl::DefaultCompletionQueueImpl(bool batch_run_async,
+                                                       std::size_t shard_count)
+    : batch_run_async_(batch_run_async),
+      shards_(shard_count == 0 ? 1 : shard_count),
+      shutdown_guard_(
           // Capturing `this` here is safe because the lifetime of copies of
           // this member do not outlive `StartOperation`.
-          std::shared_ptr<void>(reinterpret_cast<void*>(this),
-                                [this](void*) { cq_.Shutdown(); })) {}
+          std::shared_ptr<void>(reinterpret_cast<void*>(this), [this](void*) {
+            for (auto& s : shards_) s->cq.Shutdown();
+          })) {
+  for (auto& s : shards_) s = absl::make_unique<Shard>();
+}
+
+DefaultCompletionQueueImpl::~DefaultCompletionQueueImpl() {
+  // Release any functions scheduled after the queue was shutdown.
+  auto* head = run_async_head_.exchange(nullptr);
+  while (head != nullptr) {
+    std::unique_ptr<RunAsyncBase> f(head);
+    head = head->next_run_async;
+  }
+}
 
 void DefaultCompletionQueueImpl::Run() {
+  RunImpl(kAnyShard, kLoopTimeout, nullptr);
+}
+
+void DefaultCompletionQueueImpl::RunShard(std::size_t shard) {
+  RunImpl(shard % shards_.size(), kLoopTimeout, nullptr);
+}
+
+void DefaultCompletionQueueImpl::RunUntilIdle(
+    std::chrono::milliseconds idle_timeout,
+    std::function<bool()> const& retire) {
+  RunImpl(kAnyShard, idle_timeout, &retire);
+}
+
+DefaultCompletionQueueImpl::LoadStats DefaultCompletionQueueImpl::load() {
+  std::lock_guard<std::mutex> lk(mu_);
+  std::size_t backlog = run_async_queue_.size();
+  // Functions can only be removed from the stack with `mu_` held, so walking
+  // the stack is safe. New functions may be pushed while we count, so this is
+  // only an estimate.
+  for (auto* p = run_async_head_.load(std::memory_order_acquire); p != nullptr;
+       p = p->next_run_async) {
+    ++backlog;
+  }
+  return LoadStats{thread_pool_size_, busy_threads_.load(), pending_ops_.size(),
+                   backlog};
+}
+
+void DefaultCompletionQueueImpl::RunImpl(std::size_t shard,
+                                         std::chrono::milliseconds idle_timeout,
+                                         std::function<bool()> const* retire) {
   class ThreadPoolCount {
    public:
-    explicit ThreadPoolCount(DefaultCompletionQueueImpl* self) : self_(self) {
-      self_->RunStart();
-    }
-    ~ThreadPoolCount() { self_->RunStop(); }
+    ThreadPoolCount(DefaultCompletionQueueImpl* self, std::size_t shard)
+        : self_(self), shard_(self_->RunStart(shard)) {}
+    ~ThreadPoolCount() { self_->RunStop(shard_); }
+
+    std::size_t shard() const { return shard_; }
 
    private:
     DefaultCompletionQueueImpl* self_;
-  } count(this);
-
-  auto deadline = [] {
-    return std::chrono::system_clock::now() + kLoopTimeout;
+    std::size_t shard_;
+  } count(this, shard);
+  auto& cq = shards_[count.shard()]->cq;
+  // Functions scheduled via `RunAsync()` may be waiting for a thread, for
+  // example, if this thread was added to an elastic pool because the existing
+  // threads are blocked.
+  WakeUpRunAsyncThread(std::unique_lock<std::mutex>(mu_));
+
+  auto const timeout = (std::min)(idle_timeout, kLoopTimeout);
+  auto deadline = [timeout] {
+    return std::chrono::system_clock::now() + timeout;
   };
 
+  auto last_event = std::chrono::steady_clock::now();
   void* tag;
   bool ok;
-  for (auto status = cq_.AsyncNext(&tag, &ok, deadline());
+  for (auto status = cq.AsyncNext(&tag, &ok, deadline());
        status != grpc::CompletionQueue::SHUTDOWN;
-       status = cq_.AsyncNext(&tag, &ok, deadline())) {
-    if (status == grpc::CompletionQueue::TIMEOUT) continue;
+       status = cq.AsyncNext(&tag, &ok, deadline())) {
+    if (status == grpc::CompletionQueue::TIMEOUT) {
+      if (retire == nullptr) continue;
+      auto const now = std::chrono::steady_clock::now();
+      if (now - last_event < idle_timeout) continue;
+      if ((*retire)()) return;
+      last_event = now;
+      continue;
+    }
     if (status != grpc::CompletionQueue::GOT_EVENT) {
       google::cloud::internal::ThrowRuntimeError(
           "unexpected status from AsyncNext()");
     }
+    ++busy_threads_;
     auto op = FindOperation(tag);
     ++notify_counter_;
     if (op->Notify(ok)) {
       ForgetOperation(tag);
     }
+    --busy_threads_;
+    if (retire != nullptr) last_event = std::chrono::steady_clock::now();
   }
 }
 
@@ -219,11 +293,41 @@ DefaultCompletionQueueImpl::MakeRelativeTimer(
   return MakeDeadlineTimer(system_clock::now() + d);
 }
 
+future<StatusOr<std::chrono::system_clock::time_point>>
+DefaultCompletionQueueImpl::MakeCoalescedRelativeTimer(
+    std::chrono::nanoseconds duration, std::chrono::nanoseconds tick) {
+  using std::chrono::system_clock;
+  auto const t = std::chrono::duration_cast<system_clock::duration>(tick);
+  if (t <= system_clock::duration::zero()) return MakeRelativeTimer(duration);
+  auto const d = std::chrono::duration_cast<system_clock::duration>(duration);
+  auto const since_epoch = (system_clock::now() + d).time_since_epoch();
+  auto const deadline = system_clock::time_point(
+      (since_epoch + t - system_clock::duration(1)) / t * t);
+
+  TimerPromise p;
+  auto f = p.get_future();
+  std::unique_lock<std::mutex> lk(timers_mu_);
+  auto& waiters = coalesced_timers_[deadline];
+  waiters.push_back(std::move(p));
+  if (waiters.size() != 1) return f;
+  lk.unlock();
+
+  // Only the first timer in each tick creates an alarm.
+  auto w = std::weak_ptr<DefaultCompletionQueueImpl>(shared_from_this());
+  MakeDeadlineTimer(deadline).then(
+      [w, deadline](future<StatusOr<system_clock::time_point>> g) {
+        if (auto self = w.lock()) self->OnCoalescedTimer(deadline, g.get());
+      });
+  return f;
+}
+
 void DefaultCompletionQueueImpl::RunAsync(
     std::unique_ptr<internal::RunAsyncBase> function) {
-  std::unique_lock<std::mutex> lk(mu_);
-  run_async_queue_.push_back(std::move(function));
-  WakeUpRunAsyncThread(std::move(lk));
+  auto const was_empty = PushRunAsync(std::move(function));
+  // When batching, whichever thread is draining the queue will pick up this
+  // function.
+  if (batch_run_async_ && !was_empty) return;
+  WakeUpRunAsyncThread(std::unique_lock<std::mutex>(mu_));
 }
 
 void DefaultCompletionQueueImpl::StartOperation(
@@ -233,7 +337,33 @@ void DefaultCompletionQueueImpl::StartOperation(
                  std::move(start));
 }
 
-grpc::CompletionQueue& DefaultCompletionQueueImpl::cq() { return cq_; }
+grpc::CompletionQueue& DefaultCompletionQueueImpl::cq() {
+  if (shards_.size() == 1) return shards_.front()->cq;
+  auto const i = next_shard_.fetch_add(1, std::memory_order_relaxed);
+  return shards_[i % shards_.size()]->cq;
+}
+
+std::size_t DefaultCompletionQueueImpl::RunStart(std::size_t shard) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (shard == kAnyShard) {
+    auto loc = std::min_element(
+        shards_.begin(), shards_.end(),
+        [](std::unique_ptr<Shard> const& a, std::unique_ptr<Shard> const& b) {
+          return a->thread_count < b->thread_count;
+        });
+    shard = static_cast<std::size_t>(std::distance(shards_.begin(), loc));
+  }
+  ++shards_[shard]->thread_count;
+  ++thread_pool_size_;
+  thread_pool_hwm_ = (std::max)(thread_pool_hwm_, thread_pool_size_);
+  return shard;
+}
+
+void DefaultCompletionQueueImpl::RunStop(std::size_t shard) {
+  std::lock_guard<std::mutex> lk(mu_);
+  --shards_[shard]->thread_count;
+  --thread_pool_size_;
+}
 
 void DefaultCompletionQueueImpl::StartOperation(
     std::unique_lock<std::mutex> lk, std::shared_ptr<AsyncGrpcOperation> op,
@@ -287,51 +417,128 @@ void DefaultCompletionQueueImpl::ForgetOperation(void* tag) {
   }
 }
 
-void DefaultCompletionQueueImpl::DrainRunAsyncLoop() {
+bool DefaultCompletionQueueImpl::PushRunAsync(
+    std::unique_ptr<RunAsyncBase> function) {
+  auto* node = function.release();
+  auto* head = run_async_head_.load(std::memory_order_relaxed);
+  do {
+    node->next_run_async = head;
+  } while (!run_async_head_.compare_exchange_weak(
+      head, node, std::memory_order_release, std::memory_order_relaxed));
+  return head == nullptr;
+}
+
+void DefaultCompletionQueueImpl::SpliceRunAsync() {
+  auto* head = run_async_head_.exchange(nullptr, std::memory_order_acquire);
+  // The stack is in LIFO order, reverse it to preserve the submission order.
+  RunAsyncBase* reversed = nullptr;
+  while (head != nullptr) {
+    auto* next = head->next_run_async;
+    head->next_run_async = reversed;
+    reversed = head;
+    head = next;
+  }
+  while (reversed != nullptr) {
+    auto* next = reversed->next_run_async;
+    reversed->next_run_async = nullptr;
+    run_async_queue_.emplace_back(reversed);
+    reversed = next;
+  }
+}
+
+void DefaultCompletionQueueImpl::OnCoalescedTimer(
+    std::chrono::system_clock::time_point deadline,
+    StatusOr<std::chrono::system_clock::time_point> result) {
+  std::vector<TimerPromise> waiters;
+  {
+    std::lock_guard<std::mutex> lk(timers_mu_);
+    auto i = coalesced_timers_.find(deadline);
+    if (i == coalesced_timers_.end()) return;
+    waiters = std::move(i->second);
+    coalesced_timers_.erase(i);
+  }
+  for (auto& w : waiters) w.set_value(result);
+}
+
+void DefaultCompletionQueueImpl::DrainRunAsyncLoop(std::size_t shard) {
   std::unique_lock<std::mutex> lk(mu_);
+  SpliceRunAsync();
   while (!run_async_queue_.empty() && !shutdown_) {
     auto f = std::move(run_async_queue_.front());
     run_async_queue_.pop_front();
     lk.unlock();
     f->exec();
+    f.reset();
     lk.lock();
+    if (run_async_queue_.empty()) SpliceRunAsync();
   }
   --run_async_pool_size_;
+  --shards_[shard]->run_async_count;
 }
 
-void DefaultCompletionQueueImpl::DrainRunAsyncOnIdle() {
+void DefaultCompletionQueueImpl::DrainRunAsyncOnIdle(std::size_t shard) {
   std::unique_lock<std::mutex> lk(mu_);
+  if (run_async_queue_.empty()) SpliceRunAsync();
   if (run_async_queue_.empty()) return;
   auto f = std::move(run_async_queue_.front());
   run_async_queue_.pop_front();
   lk.unlock();
   f->exec();
+  f.reset();
   lk.lock();
+  if (run_async_queue_.empty()) SpliceRunAsync();
   if (run_async_queue_.empty()) {
     --run_async_pool_size_;
+    --shards_[shard]->run_async_count;
     return;
   }
-  auto op = std::make_shared<WakeUpRunAsyncOnIdle>(shared_from_this());
-  StartOperation(std::move(lk), op, [&](void* tag) { op->Set(cq(), tag); });
+  auto op = std::make_shared<WakeUpRunAsyncOnIdle>(shared_from_this(), shard);
+  auto& cq = shards_[shard]->cq;
+  StartOperation(std::move(lk), op, [&](void* tag) { op->Set(cq, tag); });
+}
+
+std::size_t DefaultCompletionQueueImpl::RunAsyncCapacity(Shard const& shard) {
+  // A shard with a single thread runs the functions one at a time, between
+  // I/O events. Otherwise the shard always leaves one thread for I/O.
+  if (shard.thread_count <= 1) return shard.run_async_count == 0 ? 1 : 0;
+  auto const available = shard.thread_count - 1;
+  return available > shard.run_async_count
+             ? available - shard.run_async_count
+             : 0;
 }
 
 void DefaultCompletionQueueImpl::WakeUpRunAsyncThread(
     std::unique_lock<std::mutex> lk) {
-  if (run_async_queue_.empty() || shutdown_) return;
-  if (thread_pool_size_ <= 1) {
-    if (run_async_pool_size_ > 0) return;
-    ++run_async_pool_size_;
-    run_async_pool_hwm_ = (std::max)(run_async_pool_hwm_, run_async_pool_size_);
-    auto op = std::make_shared<WakeUpRunAsyncOnIdle>(shared_from_this());
-    StartOperation(std::move(lk), op, [&](void* tag) { op->Set(cq(), tag); });
-    return;
+  auto const empty = run_async_queue_.empty() &&
+                     run_async_head_.load(std::memory_order_acquire) == nullptr;
+  if (empty || shutdown_) return;
+  // Use the shard with the most threads available, starting the search at a
+  // different shard each time to break ties.
+  auto const n = shards_.size();
+  auto const offset =
+      n == 1 ? 0 : next_shard_.fetch_add(1, std::memory_order_relaxed);
+  auto best = n;
+  std::size_t best_capacity = 0;
+  for (std::size_t i = 0; i != n; ++i) {
+    auto const s = (offset + i) % n;
+    auto const capacity = RunAsyncCapacity(*shards_[s]);
+    if (capacity <= best_capacity) continue;
+    best = s;
+    best_capacity = capacity;
   }
-  // Always leave one thread for I/O
-  if (run_async_pool_size_ >= thread_pool_size_ - 1) return;
-  auto op = std::make_shared<WakeUpRunAsyncLoop>(shared_from_this());
+  if (best == n) return;
+  auto& shard = *shards_[best];
+  ++shard.run_async_count;
   ++run_async_pool_size_;
   run_async_pool_hwm_ = (std::max)(run_async_pool_hwm_, run_async_pool_size_);
-  StartOperation(std::move(lk), op, [&](void* tag) { op->Set(cq(), tag); });
+  if (shard.thread_count <= 1) {
+    auto op = std::make_shared<WakeUpRunAsyncOnIdle>(shared_from_this(), best);
+    StartOperation(std::move(lk), op,
+                   [&](void* tag) { op->Set(shard.cq, tag); });
+    return;
+  }
+  auto op = std::make_shared<WakeUpRunAsyncLoop>(shared_from_this(), best);
+  StartOperation(std::move(lk), op, [&](void* tag) { op->Set(shard.cq, tag); });
 }
 
 }  // namespace internal
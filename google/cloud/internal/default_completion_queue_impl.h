@@ -21,7 +21,11 @@
 #include <chrono>
 #include <cinttypes>
 #include <deque>
+#include <functional>
+#include <map>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -30,17 +34,68 @@ namespace internal {
 
 /**
  * The default implementation for `CompletionQueue`.
+ *
+ * Functions scheduled via `RunAsync()` are pushed into a lock-free stack, and
+ * moved to the `run_async_queue_` by the threads draining the queue. That
+ * keeps the submission path free of locks when the queue can absorb a burst.
+ *
+ * By default each `RunAsync()` call may wake up an additional thread to drain
+ * the queue, up to the number of threads in the pool minus one. With
+ * @p batch_run_async set, only the submission that finds an empty queue wakes
+ * up a thread, and the remaining submissions in a burst are drained by that
+ * thread (and any threads already draining the queue).
+ *
+ * With @p shard_count greater than one the implementation owns that many
+ * `grpc::CompletionQueue` objects. Each call to `cq()` returns the next shard
+ * in round-robin order, so each new operation (or stream) is started in a
+ * different shard, and each thread in `Run()` only blocks on one shard. The
+ * threads are spread evenly across the shards. All the shards share the table
+ * of pending operations, so the events for any operation can be delivered on
+ * any shard. Each shard needs at least one thread, otherwise the operations
+ * started on that shard never complete.
  */
 class DefaultCompletionQueueImpl
     : public CompletionQueueImpl,
       public std::enable_shared_from_this<DefaultCompletionQueueImpl> {
  public:
-  DefaultCompletionQueueImpl();
-  ~DefaultCompletionQueueImpl() override = default;
+  DefaultCompletionQueueImpl() : DefaultCompletionQueueImpl(false) {}
+  explicit DefaultCompletionQueueImpl(bool batch_run_async)
+      : DefaultCompletionQueueImpl(batch_run_async, 1) {}
+  DefaultCompletionQueueImpl(bool batch_run_async, std::size_t shard_count);
+  ~DefaultCompletionQueueImpl() override;
 
   /// Run the event loop until Shutdown() is called.
   void Run() override;
 
+  /// Run the event loop for shard @p shard until Shutdown() is called.
+  void RunShard(std::size_t shard);
+
+  /// The number of `grpc::CompletionQueue` shards.
+  std::size_t shard_count() const { return shards_.size(); }
+
+  /**
+   * Run the event loop until Shutdown() is called, or the thread is retired.
+   *
+   * If the calling thread receives no events for @p idle_timeout it calls
+   * @p retire, and returns if that returns `true`. Elastic thread pools use
+   * this function to shrink when the load on the queue decreases.
+   */
+  void RunUntilIdle(std::chrono::milliseconds idle_timeout,
+                    std::function<bool()> const& retire);
+
+  /// A snapshot of the load on the completion queue.
+  struct LoadStats {
+    /// The number of threads blocked in (or running) the event loop.
+    std::size_t thread_pool_size;
+    /// The number of threads processing an event.
+    std::size_t busy_threads;
+    /// The number of pending asynchronous operations, including timers.
+    std::size_t pending_operations;
+    /// The number of `RunAsync()` functions waiting for a thread.
+    std::size_t run_async_backlog;
+  };
+  LoadStats load();
+
   /// Terminate the event loop.
   void Shutdown() override;
 
@@ -55,6 +110,18 @@ class DefaultCompletionQueueImpl
   future<StatusOr<std::chrono::system_clock::time_point>> MakeRelativeTimer(
       std::chrono::nanoseconds duration) override;
 
+  /**
+   * Create a new timer, sharing the alarm with timers expiring at the same
+   * time.
+   *
+   * The deadline is rounded up to a multiple of @p tick, and all the timers
+   * with the same rounded deadline share a single gRPC alarm, and a single
+   * wake up of the completion queue.
+   */
+  future<StatusOr<std::chrono::system_clock::time_point>>
+  MakeCoalescedRelativeTimer(std::chrono::nanoseconds duration,
+                             std::chrono::nanoseconds tick) override;
+
   /// Enqueue a new asynchronous function.
   void RunAsync(std::unique_ptr<RunAsyncBase> function) override;
 
@@ -62,7 +129,7 @@ class DefaultCompletionQueueImpl
   void StartOperation(std::shared_ptr<AsyncGrpcOperation> op,
                       absl::FunctionRef<void(void*)> start) override;
 
-  /// The underlying gRPC completion queue.
+  /// The underlying gRPC completion queue, rotating over the shards.
   grpc::CompletionQueue& cq() override;
 
   /// Some counters for testing and debugging.
@@ -82,26 +149,44 @@ class DefaultCompletionQueueImpl
   /// Unregister @p tag from pending operations.
   void ForgetOperation(void* tag);
 
-  void RunStart() {
-    std::lock_guard<std::mutex> lk(mu_);
-    ++thread_pool_size_;
-    thread_pool_hwm_ = (std::max)(thread_pool_hwm_, thread_pool_size_);
-  }
+  void RunImpl(std::size_t shard, std::chrono::milliseconds idle_timeout,
+               std::function<bool()> const* retire);
+
+  /// Count a new thread in @p shard, or in the shard with fewest threads.
+  std::size_t RunStart(std::size_t shard);
+  void RunStop(std::size_t shard);
+
+  /// Push @p function into the lock-free stack, return true if it was empty.
+  bool PushRunAsync(std::unique_ptr<RunAsyncBase> function);
 
-  void RunStop() {
-    std::lock_guard<std::mutex> lk(mu_);
-    --thread_pool_size_;
-  }
+  /// Move any pushed functions into `run_async_queue_`, with `mu_` held.
+  void SpliceRunAsync();
 
-  void DrainRunAsyncLoop();
-  void DrainRunAsyncOnIdle();
+  /// Satisfy all the coalesced timers expiring at @p deadline.
+  void OnCoalescedTimer(std::chrono::system_clock::time_point deadline,
+                        StatusOr<std::chrono::system_clock::time_point> result);
+
+  void DrainRunAsyncLoop(std::size_t shard);
+  void DrainRunAsyncOnIdle(std::size_t shard);
   void WakeUpRunAsyncThread(std::unique_lock<std::mutex> lk);
 
   class WakeUpRunAsyncLoop;
   class WakeUpRunAsyncOnIdle;
 
+  struct Shard {
+    grpc::CompletionQueue cq;
+    std::size_t thread_count = 0;     // GUARDED_BY(mu_)
+    std::size_t run_async_count = 0;  // GUARDED_BY(mu_)
+  };
+
+  /// The number of new `RunAsync()` drain loops @p shard can accept.
+  static std::size_t RunAsyncCapacity(Shard const& shard);
+
+  bool const batch_run_async_;
+  std::atomic<RunAsyncBase*> run_async_head_{nullptr};
   std::mutex mu_;
-  grpc::CompletionQueue cq_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<std::size_t> next_shard_{0};
   std::size_t thread_pool_size_ = 0;
   std::size_t run_async_pool_size_ = 0;
   std::deque<std::unique_ptr<internal::RunAsyncBase>> run_async_queue_;
@@ -109,11 +194,18 @@ class DefaultCompletionQueueImpl
   std::unordered_map<void*, std::shared_ptr<AsyncGrpcOperation>>
       pending_ops_;  // GUARDED_BY(mu_)
   // This member acts as a ref counter. When it drops to 0, it calls
-  // `cq_.Shutdown()`. Look into `StartOperation` for why it is necessary.
+  // `Shutdown()` on each shard. Look into `StartOperation` for why it is
+  // necessary.
   std::shared_ptr<void> shutdown_guard_;
 
+  using TimerPromise = promise<StatusOr<std::chrono::system_clock::time_point>>;
+  std::mutex timers_mu_;
+  std::map<std::chrono::system_clock::time_point, std::vector<TimerPromise>>
+      coalesced_timers_;  // GUARDED_BY(timers_mu_)
+
   // These are metrics used in testing.
   std::atomic<std::int64_t> notify_counter_{0};
+  std::atomic<std::size_t> busy_threads_{0};
   std::size_t thread_pool_hwm_ = 0;
   std::size_t run_async_pool_hwm_ = 0;
 };
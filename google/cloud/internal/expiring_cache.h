@@ -0,0 +1,243 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_EXPIRING_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_EXPIRING_CACHE_H
+
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * A size-bounded LRU cache where the entries expire after a fixed TTL.
+ *
+ * `GetOrFetch()` deduplicates concurrent misses: the first caller for a key
+ * runs the fetch function, any other callers for the same key block until it
+ * completes, and receive the same result. Errors are returned to all these
+ * callers, but they are not cached.
+ *
+ * Expired entries are not returned by `Lookup()` or `GetOrFetch()`, but they
+ * remain in the cache (until they are replaced or evicted) so `Peek()` can
+ * return them. Callers use this to revalidate dependent entries, e.g., by
+ * comparing the ETag in the stale and the refreshed values.
+ */
+template <typename T>
+class ExpiringCache {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using ClockFunction = std::function<Clock::time_point()>;
+
+  ExpiringCache(std::size_t max_entries, std::chrono::milliseconds ttl,
+                ClockFunction clock = &Clock::now)
+      : max_entries_(max_entries), ttl_(ttl), clock_(std::move(clock)) {}
+
+  /// Returns the cached value, if present and not expired.
+  absl::optional<T> Lookup(std::string const& key) {
+    auto const now = clock_();
+    std::unique_lock<std::mutex> lk(mu_);
+    return Fresh(lk, key, now);
+  }
+
+  /// Returns the cached value, even if it has expired.
+  absl::optional<T> Peek(std::string const& key) const {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto i = index_.find(key);
+    if (i == index_.end()) return absl::nullopt;
+    return i->second->value;
+  }
+
+  /**
+   * Returns the cached value for @p key, calling @p fetch on a miss.
+   *
+   * @p fetch must return a `StatusOr<T>`, successful results are cached.
+   */
+  template <typename Fetch>
+  StatusOr<T> GetOrFetch(std::string const& key, Fetch&& fetch) {
+    auto const now = clock_();
+    std::unique_lock<std::mutex> lk(mu_);
+    if (auto value = Fresh(lk, key, now)) return *std::move(value);
+    auto p = pending_.find(key);
+    if (p != pending_.end()) {
+      auto pending = p->second;
+      cv_.wait(lk, [&pending] { return pending->done; });
+      if (pending->value) return *pending->value;
+      return pending->status;
+    }
+    auto pending = std::make_shared<Pending>();
+    pending_.emplace(key, pending);
+    lk.unlock();
+    // Wake up any waiters even if `fetch` throws.
+    Completion completion{this, key, pending};
+    auto result = std::forward<Fetch>(fetch)();
+    completion.Complete(result);
+    return result;
+  }
+
+  /// Adds (or replaces) the value for @p key.
+  void Insert(std::string key, T value) {
+    auto const expiration = clock_() + ttl_;
+    std::unique_lock<std::mutex> lk(mu_);
+    Insert(lk, std::move(key), std::move(value), expiration);
+  }
+
+  /// Discards the value for @p key, including any fetch in progress.
+  void Invalidate(std::string const& key) {
+    std::unique_lock<std::mutex> lk(mu_);
+    auto i = index_.find(key);
+    if (i != index_.end()) Erase(lk, i->second);
+    auto p = pending_.find(key);
+    if (p == pending_.end()) return;
+    p->second->invalidated = true;
+    pending_.erase(p);
+  }
+
+  /// Discards all the values, and fetches in progress, where @p pred is true.
+  void InvalidateIf(std::function<bool(std::string const&)> const& pred) {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (auto i = entries_.begin(); i != entries_.end();) {
+      auto e = i++;
+      if (pred(e->key)) Erase(lk, e);
+    }
+    for (auto p = pending_.begin(); p != pending_.end();) {
+      if (!pred(p->first)) {
+        ++p;
+        continue;
+      }
+      p->second->invalidated = true;
+      p = pending_.erase(p);
+    }
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    T value;
+    Clock::time_point expiration;
+  };
+  using EntryList = std::list<Entry>;
+
+  struct Pending {
+    bool done = false;
+    bool invalidated = false;
+    Status status;
+    absl::optional<T> value;
+  };
+
+  // Publishes the result of a fetch, or an error if the fetch did not finish.
+  struct Completion {
+    ExpiringCache* self;
+    std::string const& key;
+    std::shared_ptr<Pending> pending;
+
+    ~Completion() {
+      if (pending->done) return;
+      std::unique_lock<std::mutex> lk(self->mu_);
+      pending->status =
+          Status(StatusCode::kUnknown, "cache fetch did not complete");
+      Done(std::move(lk));
+    }
+
+    void Complete(StatusOr<T> const& result) {
+      auto const expiration = self->clock_() + self->ttl_;
+      std::unique_lock<std::mutex> lk(self->mu_);
+      if (result) {
+        pending->value = *result;
+        if (!pending->invalidated) self->Insert(lk, key, *result, expiration);
+      } else {
+        pending->status = result.status();
+      }
+      Done(std::move(lk));
+    }
+
+    void Done(std::unique_lock<std::mutex> lk) {
+      auto p = self->pending_.find(key);
+      if (p != self->pending_.end() && p->second == pending) {
+        self->pending_.erase(p);
+      }
+      pending->done = true;
+      lk.unlock();
+      self->cv_.notify_all();
+    }
+  };
+
+  absl::optional<T> Fresh(std::unique_lock<std::mutex> const&,
+                          std::string const& key, Clock::time_point now) {
+    auto i = index_.find(key);
+    if (i == index_.end()) return absl::nullopt;
+    auto e = i->second;
+    if (e->expiration <= now) return absl::nullopt;
+    entries_.splice(entries_.begin(), entries_, e);
+    return e->value;
+  }
+
+  void Insert(std::unique_lock<std::mutex> const& lk, std::string key, T value,
+              Clock::time_point expiration) {
+    if (max_entries_ == 0) return;
+    auto i = index_.find(key);
+    if (i != index_.end()) Erase(lk, i->second);
+    while (entries_.size() >= max_entries_) {
+      Erase(lk, std::prev(entries_.end()));
+    }
+    entries_.push_front(Entry{key, std::move(value), expiration});
+    index_.emplace(std::move(key), entries_.begin());
+  }
+
+  void Erase(std::unique_lock<std::mutex> const&,
+             typename EntryList::iterator i) {
+    index_.erase(i->key);
+    entries_.erase(i);
+  }
+
+  std::size_t const max_entries_;
+  std::chrono::milliseconds const ttl_;
+  ClockFunction clock_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  // The most recently used entries are at the front.
+  EntryList entries_;  // GUARDED_BY(mu_)
+  // Map each key to its position in `entries_`.
+  std::unordered_map<std::string, typename EntryList::iterator>
+      index_;  // GUARDED_BY(mu_)
+  std::unordered_map<std::string, std::shared_ptr<Pending>>
+      pending_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_EXPIRING_CACHE_H
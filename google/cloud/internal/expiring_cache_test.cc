@@ -0,0 +1,157 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/expiring_cache.h"
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using Cache = ExpiringCache<std::string>;
+
+class FakeClock {
+ public:
+  Cache::ClockFunction AsFunction() {
+    return [this] { return now_; };
+  }
+  void Advance(std::chrono::milliseconds d) { now_ += d; }
+
+ private:
+  Cache::Clock::time_point now_ = Cache::Clock::now();
+};
+
+TEST(ExpiringCache, LookupAndExpire) {
+  FakeClock clock;
+  Cache cache(4, std::chrono::milliseconds(100), clock.AsFunction());
+  EXPECT_FALSE(cache.Lookup("k").has_value());
+  cache.Insert("k", "v");
+  EXPECT_EQ("v", cache.Lookup("k").value_or(""));
+  clock.Advance(std::chrono::milliseconds(100));
+  EXPECT_FALSE(cache.Lookup("k").has_value());
+  // Expired entries are still available to `Peek()`.
+  EXPECT_EQ("v", cache.Peek("k").value_or(""));
+  EXPECT_EQ(1, cache.size());
+}
+
+TEST(ExpiringCache, EvictsLeastRecentlyUsed) {
+  Cache cache(2, std::chrono::milliseconds(1000));
+  cache.Insert("a", "1");
+  cache.Insert("b", "2");
+  EXPECT_TRUE(cache.Lookup("a").has_value());
+  cache.Insert("c", "3");
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.Lookup("a").has_value());
+  EXPECT_FALSE(cache.Lookup("b").has_value());
+  EXPECT_TRUE(cache.Lookup("c").has_value());
+}
+
+TEST(ExpiringCache, GetOrFetchCachesSuccess) {
+  Cache cache(4, std::chrono::milliseconds(1000));
+  int calls = 0;
+  auto fetch = [&calls] {
+    ++calls;
+    return make_status_or(std::string("v"));
+  };
+  EXPECT_EQ("v", cache.GetOrFetch("k", fetch).value());
+  EXPECT_EQ("v", cache.GetOrFetch("k", fetch).value());
+  EXPECT_EQ(1, calls);
+}
+
+TEST(ExpiringCache, GetOrFetchDoesNotCacheErrors) {
+  Cache cache(4, std::chrono::milliseconds(1000));
+  int calls = 0;
+  auto fetch = [&calls] {
+    ++calls;
+    return StatusOr<std::string>(Status(StatusCode::kUnavailable, "try"));
+  };
+  EXPECT_THAT(cache.GetOrFetch("k", fetch), StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(cache.GetOrFetch("k", fetch), StatusIs(StatusCode::kUnavailable));
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST(ExpiringCache, GetOrFetchDeduplicates) {
+  Cache cache(4, std::chrono::milliseconds(1000));
+  promise<void> started;
+  promise<void> release;
+  std::atomic<int> calls{0};
+  auto fetch = [&] {
+    ++calls;
+    started.set_value();
+    release.get_future().get();
+    return make_status_or(std::string("v"));
+  };
+  std::thread first(
+      [&] { EXPECT_EQ("v", cache.GetOrFetch("k", fetch).value()); });
+  started.get_future().get();
+  std::vector<std::thread> waiters;
+  for (int i = 0; i != 4; ++i) {
+    waiters.emplace_back(
+        [&] { EXPECT_EQ("v", cache.GetOrFetch("k", fetch).value()); });
+  }
+  // Give the waiters a chance to block, this is not needed for correctness.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  release.set_value();
+  first.join();
+  for (auto& t : waiters) t.join();
+  EXPECT_EQ(1, calls.load());
+}
+
+TEST(ExpiringCache, InvalidateDuringFetch) {
+  Cache cache(4, std::chrono::milliseconds(1000));
+  auto fetch = [&cache] {
+    cache.Invalidate("k");
+    return make_status_or(std::string("stale"));
+  };
+  EXPECT_EQ("stale", cache.GetOrFetch("k", fetch).value());
+  // The result of a fetch that was invalidated is not cached.
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST(ExpiringCache, InvalidateIf) {
+  Cache cache(8, std::chrono::milliseconds(1000));
+  cache.Insert("a/1", "1");
+  cache.Insert("a/2", "2");
+  cache.Insert("b/1", "3");
+  cache.InvalidateIf(
+      [](std::string const& key) { return key.rfind("a/", 0) == 0; });
+  EXPECT_EQ(1, cache.size());
+  EXPECT_TRUE(cache.Lookup("b/1").has_value());
+}
+
+TEST(ExpiringCache, ZeroEntriesDisablesCaching) {
+  Cache cache(0, std::chrono::milliseconds(1000));
+  cache.Insert("k", "v");
+  EXPECT_EQ(0, cache.size());
+  auto value = cache.GetOrFetch(
+      "k", [] { return make_status_or(std::string("v")); });
+  EXPECT_EQ("v", value.value());
+  EXPECT_EQ(0, cache.size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -19,30 +19,156 @@ namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+namespace {
+
+struct CivilTime {
+  int year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int second;
+};
+
+// Converts the @p seconds since 1970-01-01T00:00:00Z to civil time in UTC,
+// returns false if the year is outside [0000, 9999]. See
+//   http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+bool ToCivil(std::int64_t seconds, CivilTime& ct) {
+  auto days = seconds / 86400;
+  auto secs = seconds % 86400;
+  if (secs < 0) {
+    secs += 86400;
+    --days;
+  }
+  auto const z = days + 719468;
+  auto const era = (z >= 0 ? z : z - 146096) / 146097;
+  auto const doe = z - era * 146097;
+  auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  auto const mp = (5 * doy + 2) / 153;
+  auto const month = mp < 10 ? mp + 3 : mp - 9;
+  auto const year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+  if (year < 0 || year > 9999) return false;
+  ct.year = static_cast<int>(year);
+  ct.month = static_cast<int>(month);
+  ct.day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  ct.hour = static_cast<int>(secs / 3600);
+  ct.minute = static_cast<int>(secs / 60 % 60);
+  ct.second = static_cast<int>(secs % 60);
+  return true;
+}
+
+// Splits @p tp into seconds since the epoch and nanoseconds in [0, 1e9).
+void SplitTimePoint(std::chrono::system_clock::time_point tp,
+                    std::int64_t& seconds, std::int32_t& nanos) {
+  using std::chrono::system_clock;
+  auto const d = tp.time_since_epoch();
+  auto s = std::chrono::duration_cast<std::chrono::seconds>(d);
+  // Compute the remainder in the clock's units, this cannot overflow.
+  auto rem = d - std::chrono::duration_cast<system_clock::duration>(s);
+  if (rem < system_clock::duration::zero()) {
+    rem += std::chrono::seconds(1);
+    s -= std::chrono::seconds(1);
+  }
+  seconds = s.count();
+  nanos = static_cast<std::int32_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(rem).count());
+}
+
+char* Put2(char* p, int v) {
+  *p++ = static_cast<char>('0' + v / 10);
+  *p++ = static_cast<char>('0' + v % 10);
+  return p;
+}
+
+char* PutDate(char* p, CivilTime const& ct, char const* separator) {
+  p = Put2(p, ct.year / 100);
+  p = Put2(p, ct.year % 100);
+  if (*separator != '\0') *p++ = *separator;
+  p = Put2(p, ct.month);
+  if (*separator != '\0') *p++ = *separator;
+  return Put2(p, ct.day);
+}
+
+char* PutTime(char* p, CivilTime const& ct, char const* separator) {
+  p = Put2(p, ct.hour);
+  if (*separator != '\0') *p++ = *separator;
+  p = Put2(p, ct.minute);
+  if (*separator != '\0') *p++ = *separator;
+  return Put2(p, ct.second);
+}
+
+std::string FormatAbsl(char const* format,
+                       std::chrono::system_clock::time_point tp) {
+  return absl::FormatTime(format, absl::FromChrono(tp), absl::UTCTimeZone());
+}
+
+}  // namespace
+
+std::size_t FormatRfc3339To(std::int64_t seconds, std::int32_t nanos,
+                            char* buffer) {
+  CivilTime ct;
+  if (!ToCivil(seconds, ct)) return 0;
+  auto* p = PutDate(buffer, ct, "-");
+  *p++ = 'T';
+  p = PutTime(p, ct, ":");
+  if (nanos != 0) {
+    *p++ = '.';
+    // Print all the digits, then drop the trailing zeros.
+    for (int scale = 100000000; scale != 0; scale /= 10) {
+      *p++ = static_cast<char>('0' + nanos / scale % 10);
+    }
+    while (p[-1] == '0') --p;
+  }
+  *p++ = 'Z';
+  return static_cast<std::size_t>(p - buffer);
+}
 
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  std::int64_t seconds;
+  std::int32_t nanos;
+  SplitTimePoint(tp, seconds, nanos);
+  char buffer[kFormatRfc3339BufferSize];
+  auto const n = FormatRfc3339To(seconds, nanos, buffer);
+  if (n != 0) return std::string(buffer, n);
+  return FormatAbsl("%E4Y-%m-%dT%H:%M:%E*SZ", tp);
 }
 
 std::string FormatUtcDate(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y-%m-%d";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  std::int64_t seconds;
+  std::int32_t nanos;
+  SplitTimePoint(tp, seconds, nanos);
+  CivilTime ct;
+  if (!ToCivil(seconds, ct)) return FormatAbsl("%E4Y-%m-%d", tp);
+  char buffer[sizeof("YYYY-MM-DD")];
+  auto* p = PutDate(buffer, ct, "-");
+  return std::string(buffer, p);
 }
 
 std::string FormatV4SignedUrlTimestamp(
     std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y%m%dT%H%M%SZ";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  std::int64_t seconds;
+  std::int32_t nanos;
+  SplitTimePoint(tp, seconds, nanos);
+  CivilTime ct;
+  if (!ToCivil(seconds, ct)) return FormatAbsl("%E4Y%m%dT%H%M%SZ", tp);
+  char buffer[sizeof("YYYYMMDDTHHMMSSZ")];
+  auto* p = PutDate(buffer, ct, "");
+  *p++ = 'T';
+  p = PutTime(p, ct, "");
+  *p++ = 'Z';
+  return std::string(buffer, p);
 }
 
 std::string FormatV4SignedUrlScope(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y%m%d";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  std::int64_t seconds;
+  std::int32_t nanos;
+  SplitTimePoint(tp, seconds, nanos);
+  CivilTime ct;
+  if (!ToCivil(seconds, ct)) return FormatAbsl("%E4Y%m%d", tp);
+  char buffer[sizeof("YYYYMMDD")];
+  auto* p = PutDate(buffer, ct, "");
+  return std::string(buffer, p);
 }
 
 }  // namespace internal
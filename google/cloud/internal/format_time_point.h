@@ -17,6 +17,8 @@
 
 #include "google/cloud/version.h"
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -42,6 +44,25 @@ namespace internal {
  */
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp);
 
+/// The buffer size needed by `FormatRfc3339To()`.
+std::size_t constexpr kFormatRfc3339BufferSize =
+    sizeof("YYYY-MM-DDTHH:MM:SS.123456789Z") - 1;
+
+/**
+ * Formats a timestamp as RFC-3339, without allocating memory.
+ *
+ * The timestamp is given as @p seconds since the Unix epoch and @p nanos, in
+ * `[0, 999999999]`. The output uses the same format as `FormatRfc3339()`,
+ * omitting any trailing zeros in the fractional seconds. @p buffer must have
+ * room for `kFormatRfc3339BufferSize` characters.
+ *
+ * Returns the number of characters written, or 0 if the year is outside
+ * `[0000, 9999]`, callers should fall back to a general purpose formatter in
+ * that case.
+ */
+std::size_t FormatRfc3339To(std::int64_t seconds, std::int32_t nanos,
+                            char* buffer);
+
 /// Format a time point as YYYY-MM-DD.
 std::string FormatUtcDate(std::chrono::system_clock::time_point tp);
 
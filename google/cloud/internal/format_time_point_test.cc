@@ -14,6 +14,7 @@
 
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/parse_rfc3339.h"
+#include "absl/time/time.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -72,6 +73,40 @@ TEST(FormatRfc3339Test, FractionalNanos) {
   }
 }
 
+TEST(FormatRfc3339Test, BeforeEpoch) {
+  auto const timestamp = std::chrono::system_clock::from_time_t(0) -
+                         std::chrono::milliseconds(750);
+  EXPECT_EQ("1969-12-31T23:59:59.25Z", FormatRfc3339(timestamp));
+}
+
+TEST(FormatRfc3339Test, MatchesGeneral) {
+  // Compare against the general purpose formatter over a wide range of
+  // dates, including leap years and century boundaries.
+  auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
+  std::int64_t const start = -62167219200;  // 0000-01-01T00:00:00Z
+  std::int64_t const end = 253402300799;    // 9999-12-31T23:59:59Z
+  std::int64_t const step = 86400 * 37 + 3671;
+  char buffer[kFormatRfc3339BufferSize];
+  for (auto s = start; s < end; s += step) {
+    auto const millis = (s % 1000 + 1000) % 1000;
+    auto const nanos = static_cast<std::int32_t>(millis * 1000000);
+    auto const expected = absl::FormatTime(
+        kFormat, absl::FromUnixSeconds(s) + absl::Nanoseconds(nanos),
+        absl::UTCTimeZone());
+    auto const n = FormatRfc3339To(s, nanos, buffer);
+    ASSERT_EQ(expected, std::string(buffer, n)) << "seconds=" << s;
+  }
+  EXPECT_EQ("9999-12-31T23:59:59.999999999Z",
+            std::string(buffer, FormatRfc3339To(end, 999999999, buffer)));
+  EXPECT_EQ(0, FormatRfc3339To(end + 1, 0, buffer));
+  EXPECT_EQ(0, FormatRfc3339To(start - 1, 0, buffer));
+}
+
+TEST(FormatUtcDateTest, Base) {
+  auto timestamp = ParseRfc3339("2019-08-02T01:02:03Z").value();
+  EXPECT_EQ("2019-08-02", FormatUtcDate(timestamp));
+}
+
 TEST(FormatV4SignedUrlTimestampTest, Base) {
   auto timestamp = ParseRfc3339("2019-08-02T01:02:03Z").value();
   std::string actual = FormatV4SignedUrlTimestamp(timestamp);
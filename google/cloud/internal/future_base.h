@@ -162,7 +162,7 @@ class promise_base {  // NOLINT(readability-identifier-naming)
   /// Initialize the common components of a promise
   explicit promise_base(std::function<void()> cancellation_callback)
       : shared_state_(
-            std::make_shared<shared_state_type>(cancellation_callback)) {}
+            make_future_shared_state<T>(std::move(cancellation_callback))) {}
   promise_base(promise_base&&) noexcept = default;
 
   ~promise_base() {
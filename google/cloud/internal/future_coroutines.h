@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
+/**
+ * @file
+ *
+ * Integrate `google::cloud::future<T>` with C++20 coroutines.
+ *
+ * When the compiler supports coroutines (see `GOOGLE_CLOUD_CPP_HAVE_COROUTINES`
+ * in `port_platform.h`) applications can `co_await` on any `future<T>`, and
+ * `future<T>` can be used as the return type of a coroutine. Awaiting a future
+ * attaches a single continuation to its shared state, the coroutine resumes on
+ * the thread that satisfies the future, typically a thread blocked in
+ * `CompletionQueue::Run()`.
+ */
+
+#include "google/cloud/future_generic.h"
+#include "google/cloud/future_void.h"
+#include "google/cloud/internal/port_platform.h"
+#include "google/cloud/version.h"
+
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include <atomic>
+#include <coroutine>
+#include <exception>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Implements `co_await` for `future<T>`.
+ *
+ * The awaiter takes ownership of the future's shared state. If the state is
+ * not satisfied the coroutine is suspended, and a continuation that resumes
+ * the coroutine is attached directly to the shared state. Unlike `.then()`,
+ * this does not create a new shared state for each suspension.
+ */
+template <typename T>
+class FutureAwaiter {
+ public:
+  explicit FutureAwaiter(future<T> f) : state_(std::move(f.shared_state_)) {
+    if (!state_) ThrowFutureError(std::future_errc::no_state, __func__);
+  }
+
+  bool await_ready() const { return state_->is_ready(); }
+
+  bool await_suspend(std::coroutine_handle<> h) {
+    handle_ = h;
+    state_->set_continuation(absl::make_unique<Resume>(this));
+    // If the continuation already ran, the state was satisfied while we were
+    // attaching the continuation. Do not suspend in that case.
+    return !ready_.exchange(true);
+  }
+
+  T await_resume() { return state_->get(); }
+
+ private:
+  struct Resume : public continuation_base {
+    explicit Resume(FutureAwaiter* a) : awaiter(a) {}
+    void execute() override {
+      // Only resume the coroutine if `await_suspend()` has decided to suspend.
+      if (awaiter->ready_.exchange(true)) awaiter->handle_.resume();
+    }
+    FutureAwaiter* awaiter;
+  };
+
+  std::shared_ptr<future_shared_state<T>> state_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> ready_{false};
+};
+
+/// The functions common to all the coroutine promise types.
+template <typename T>
+class FuturePromiseTypeBase {
+ public:
+  future<T> get_return_object() { return promise_.get_future(); }
+  std::suspend_never initial_suspend() noexcept { return {}; }
+  std::suspend_never final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    promise_.set_exception(std::current_exception());
+#else
+    google::cloud::Terminate("unhandled exception in future<T> coroutine");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+
+ protected:
+  promise<T> promise_;
+};
+
+/// The promise type for coroutines returning `future<T>`.
+template <typename T>
+class FuturePromiseType : public FuturePromiseTypeBase<T> {
+ public:
+  void return_value(T value) { this->promise_.set_value(std::move(value)); }
+};
+
+/// The promise type for coroutines returning `future<void>`.
+template <>
+class FuturePromiseType<void> : public FuturePromiseTypeBase<void> {
+ public:
+  void return_void() { this->promise_.set_value(); }
+};
+
+}  // namespace internal
+
+/**
+ * Suspends the calling coroutine until @p f is satisfied.
+ *
+ * The coroutine resumes in the thread that satisfies the future. Any exception
+ * stored in the future is rethrown in the coroutine.
+ */
+template <typename T>
+internal::FutureAwaiter<T> operator co_await(future<T> f) {
+  return internal::FutureAwaiter<T>(std::move(f));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+/// Use `google::cloud::future<T>` as the return type of coroutines.
+template <typename T, typename... Args>
+struct std::coroutine_traits<google::cloud::future<T>, Args...> {
+  using promise_type = google::cloud::internal::FuturePromiseType<T>;
+};
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
@@ -39,6 +39,12 @@ template <>
 class promise<void>;
 template <>
 class future<void>;
+
+namespace internal {
+// Forward declare the type used to `co_await` on futures.
+template <typename R>
+class FutureAwaiter;
+}  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
 }  // namespace google
@@ -21,9 +21,11 @@
  */
 
 #include "google/cloud/internal/future_then_meta.h"
+#include "google/cloud/internal/small_object_pool.h"
 #include "google/cloud/terminate_handler.h"
 #include "google/cloud/version.h"
 #include "absl/memory/memory.h"
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <exception>
@@ -53,6 +55,15 @@ class continuation_base {  // NOLINT(readability-identifier-naming)
 
   /// Invoke the continuation.
   virtual void execute() = 0;
+
+  // Continuations are created (and destroyed) for each `.then()` call, use a
+  // pool to amortize the cost of allocating them.
+  static void* operator new(std::size_t size) {
+    return SmallObjectPoolAllocate(size);
+  }
+  static void operator delete(void* p, std::size_t size) {
+    SmallObjectPoolDeallocate(p, size);
+  }
 };
 
 /**
@@ -76,8 +87,7 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
         cancellation_callback_(std::move(cancellation_callback)) {}
   /// Return true if the shared state has a value or an exception.
   bool is_ready() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return is_ready_unlocked();
+    return current_state_.load(std::memory_order_acquire) != state::not_ready;
   }
 
   /// Return true if the shared state can be cancelled.
@@ -86,7 +96,8 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   /// Block until is_ready() returns true ...
   void wait() {
     std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
+    if (is_ready_unlocked()) return;
+    cv(lk).wait(lk, [this] { return is_ready_unlocked(); });
   }
 
   /**
@@ -114,8 +125,9 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   template <typename Rep, typename Period>
   std::future_status wait_for(std::chrono::duration<Rep, Period> duration) {
     std::unique_lock<std::mutex> lk(mu_);
-    bool result =
-        cv_.wait_for(lk, duration, [this] { return is_ready_unlocked(); });
+    bool result = is_ready_unlocked() ||
+                  cv(lk).wait_for(lk, duration,
+                                  [this] { return is_ready_unlocked(); });
     if (result) {
       return std::future_status::ready;
     }
@@ -147,8 +159,9 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
     if (!lk.owns_lock()) {
       return std::future_status::timeout;
     }
-    bool result =
-        cv_.wait_until(lk, deadline, [this] { return is_ready_unlocked(); });
+    bool result = is_ready_unlocked() ||
+                  cv(lk).wait_until(lk, deadline,
+                                    [this] { return is_ready_unlocked(); });
     if (result) {
       return std::future_status::ready;
     }
@@ -185,7 +198,7 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
 #else
     set_exception(nullptr, lk);
 #endif
-    cv_.notify_all();
+    if (cv_) cv_->notify_all();
   }
 
   void set_continuation(std::unique_ptr<continuation_base> c) {
@@ -213,7 +226,7 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
     if (!cancellable()) {
       return false;
     }
-    cancellation_callback_();
+    if (cancellation_callback_) cancellation_callback_();
     // If the callback fails with an exception we assume it had no effect.
     // Incidentally this means we provide the strong exception guarantee for
     // this function.
@@ -222,7 +235,21 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   }
 
  protected:
-  bool is_ready_unlocked() const { return current_state_ != state::not_ready; }
+  bool is_ready_unlocked() const {
+    return current_state_.load(std::memory_order_relaxed) != state::not_ready;
+  }
+
+  /**
+   * Return the condition variable used to block in `wait()` and `get()`.
+   *
+   * Most shared states are satisfied via continuations, or are already
+   * satisfied when `get()` is called. The condition variable is only created
+   * when some thread needs to block.
+   */
+  std::condition_variable& cv(std::unique_lock<std::mutex> const&) {
+    if (!cv_) cv_ = absl::make_unique<std::condition_variable>();
+    return *cv_;
+  }
 
   /// Satisfy the shared state using an exception.
   void set_exception(std::exception_ptr ex, std::unique_lock<std::mutex>&) {
@@ -230,7 +257,7 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
       ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
     }
     exception_ = std::move(ex);
-    current_state_ = state::has_exception;
+    current_state_.store(state::has_exception, std::memory_order_release);
   }
 
   /// If needed, notify any waiting threads that the shared state is satisfied.
@@ -245,7 +272,7 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
       // without notifying any other threads.
       return;
     }
-    cv_.notify_all();
+    if (cv_) cv_->notify_all();
   }
 
   /**
@@ -286,13 +313,15 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   std::atomic_flag retrieved_ = ATOMIC_FLAG_INIT;
 
   mutable std::mutex mu_;
-  std::condition_variable cv_;
+  std::unique_ptr<std::condition_variable> cv_;  // GUARDED_BY(mu_)
   enum class state {
     not_ready,      // NOLINT(readability-identifier-naming)
     has_exception,  // NOLINT(readability-identifier-naming)
     has_value,      // NOLINT(readability-identifier-naming)
   };
-  state current_state_;
+  // Only modified with `mu_` held, but may be read without the lock to
+  // implement `is_ready()`.
+  std::atomic<state> current_state_;
   std::exception_ptr exception_;
 
   /**
@@ -361,7 +390,9 @@ class future_shared_state final : private future_shared_state_base {
   /// The implementation details for `future<T>::get()`
   T get() {
     std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
+    if (!is_ready_unlocked()) {
+      cv(lk).wait(lk, [this] { return is_ready_unlocked(); });
+    }
     if (current_state_ == state::has_exception) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       std::rethrow_exception(exception_);
@@ -400,7 +431,7 @@ class future_shared_state final : private future_shared_state_base {
     // That could result in a deadlock (or at least unbounded priority
     // inversions) if the move constructor for `T` takes a long time to execute.
     new (reinterpret_cast<T*>(&buffer_)) T(std::move(value));
-    current_state_ = state::has_value;
+    current_state_.store(state::has_value, std::memory_order_release);
     notify_now(std::move(lk));
   }
 
@@ -490,7 +521,9 @@ class future_shared_state<void> final : private future_shared_state_base {
   /// The implementation details for `future<void>::get()`
   void get() {
     std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
+    if (!is_ready_unlocked()) {
+      cv(lk).wait(lk, [this] { return is_ready_unlocked(); });
+    }
     if (current_state_ == state::has_exception) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       std::rethrow_exception(exception_);
@@ -575,10 +608,24 @@ class future_shared_state<void> final : private future_shared_state_base {
     if (is_ready_unlocked()) {
       ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
     }
-    current_state_ = state::has_value;
+    current_state_.store(state::has_value, std::memory_order_release);
   }
 };
 
+/**
+ * Create a new shared state, allocated from the small object pool.
+ *
+ * Most programs using futures create (and release) many shared states. Using
+ * the pool amortizes the cost of these allocations.
+ */
+template <typename T, typename... Args>
+std::shared_ptr<future_shared_state<T>> make_future_shared_state(
+    Args&&... a) {
+  return std::allocate_shared<future_shared_state<T>>(
+      SmallObjectPoolAllocator<future_shared_state<T>>{},
+      std::forward<Args>(a)...);
+}
+
 /**
  * Calls a functor passing `future<T>` as an argument and stores the results in
  * a `future_shared_state<R>`.
@@ -674,7 +721,7 @@ struct continuation : public continuation_base {
   continuation(Functor&& f, std::shared_ptr<input_shared_state_t> s)
       : functor(std::move(f)),
         input(std::move(s)),
-        output(std::make_shared<future_shared_state<result_t>>(
+        output(make_future_shared_state<result_t>(
             input.lock()->release_cancellation_callback())) {}
 
   continuation(Functor&& f, std::shared_ptr<input_shared_state_t> s,
@@ -731,7 +778,7 @@ struct unwrapping_continuation : public continuation_base {
       : functor(std::move(f)),
         input(std::move(s)),
         intermediate(),
-        output(std::make_shared<output_shared_state_t>(
+        output(make_future_shared_state<R>(
             input.lock()->release_cancellation_callback())) {}
 
   void execute() override {
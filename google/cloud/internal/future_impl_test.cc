@@ -18,6 +18,8 @@
 #include "google/cloud/testing_util/testing_types.h"
 #include "absl/memory/memory.h"
 #include <gmock/gmock.h>
+#include <cstdint>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -337,6 +339,37 @@ TEST(FutureImplInt, SetValue) {
   EXPECT_EQ(42, shared_state.get());
 }
 
+TEST(FutureImplInt, SetValueWakesUpBlockedGet) {
+  auto shared_state = make_future_shared_state<int>();
+  std::thread t([shared_state] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    shared_state->set_value(42);
+  });
+  EXPECT_EQ(42, shared_state->get());
+  t.join();
+}
+
+struct alignas(64) OverAlignedValue {
+  int value;
+};
+
+TEST(FutureImplOverAligned, SharedStateIsAligned) {
+  for (int i = 0; i != 8; ++i) {
+    auto shared_state = make_future_shared_state<OverAlignedValue>();
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(shared_state.get()) % 64);
+    shared_state->set_value(OverAlignedValue{i});
+    EXPECT_EQ(i, shared_state->get().value);
+  }
+}
+
+TEST(FutureImplInt, CancelWithoutCallback) {
+  auto shared_state = make_future_shared_state<int>(std::function<void()>{});
+  EXPECT_TRUE(shared_state->cancel());
+  shared_state->set_value(42);
+  EXPECT_FALSE(shared_state->cancel());
+  EXPECT_EQ(42, shared_state->get());
+}
+
 TEST(FutureImplInt, SetValueCanBeCalledOnlyOnce) {
   future_shared_state<int> shared_state;
   EXPECT_FALSE(shared_state.is_ready());
@@ -0,0 +1,96 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/grpc_access_token_authentication.h"
+#include "google/cloud/internal/grpc_channel_credentials_authentication.h"
+#include "absl/memory/memory.h"
+#include <benchmark/benchmark.h>
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+// Measure the overhead added to each RPC by the `*AuthDecorator` classes,
+// that is, creating a `grpc::ClientContext` and calling `ConfigureContext()`
+// or `AsyncConfigureContext()` on it.
+
+AccessToken MakeToken() {
+  // A typical OAuth2 access token is a few hundred bytes long.
+  return AccessToken{"ya29." + std::string(200, 'x'),
+                     std::chrono::system_clock::now() + std::chrono::hours(1)};
+}
+
+// The cost of creating a `grpc::ClientContext`, any RPC pays this cost.
+void BM_Baseline(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc::ClientContext context;
+    benchmark::DoNotOptimize(context.credentials());
+  }
+}
+BENCHMARK(BM_Baseline);
+
+// Channel credentials do not configure each context.
+void BM_ChannelCredentials(benchmark::State& state) {
+  GrpcChannelCredentialsAuthentication auth(grpc::InsecureChannelCredentials());
+  for (auto _ : state) {
+    grpc::ClientContext context;
+    if (auth.RequiresConfigureContext()) auth.ConfigureContext(context);
+    benchmark::DoNotOptimize(context.credentials());
+  }
+}
+BENCHMARK(BM_ChannelCredentials);
+
+// Create new call credentials for each RPC, this is what caching the call
+// credentials saves.
+void BM_AccessTokenUncached(benchmark::State& state) {
+  auto const token = MakeToken();
+  for (auto _ : state) {
+    grpc::ClientContext context;
+    context.set_credentials(grpc::AccessTokenCredentials(token.token));
+    benchmark::DoNotOptimize(context.credentials());
+  }
+}
+BENCHMARK(BM_AccessTokenUncached);
+
+void BM_AccessTokenConfigureContext(benchmark::State& state) {
+  GrpcAccessTokenAuthentication auth(MakeToken(), Options{});
+  for (auto _ : state) {
+    grpc::ClientContext context;
+    auth.ConfigureContext(context);
+    benchmark::DoNotOptimize(context.credentials());
+  }
+}
+BENCHMARK(BM_AccessTokenConfigureContext);
+
+void BM_AccessTokenAsyncConfigureContext(benchmark::State& state) {
+  GrpcAccessTokenAuthentication auth(MakeToken(), Options{});
+  for (auto _ : state) {
+    auto context = auth.AsyncConfigureContext(
+                           absl::make_unique<grpc::ClientContext>())
+                       .get();
+    benchmark::DoNotOptimize(context);
+  }
+}
+BENCHMARK(BM_AccessTokenAsyncConfigureContext);
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
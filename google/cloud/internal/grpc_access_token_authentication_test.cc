@@ -33,6 +33,7 @@ TEST(GrpcAccessTokenAuthenticationTest, Simple) {
   auto channel = auth.CreateChannel("localhost:1", grpc::ChannelArguments{});
   EXPECT_NE(nullptr, channel.get());
 
+  std::shared_ptr<grpc::CallCredentials> first;
   for (auto attempt : {1, 2, 3}) {
     SCOPED_TRACE("Running attempt " + std::to_string(attempt));
     grpc::ClientContext context;
@@ -40,6 +41,9 @@ TEST(GrpcAccessTokenAuthenticationTest, Simple) {
     auto status = auth.ConfigureContext(context);
     EXPECT_THAT(status, IsOk());
     EXPECT_NE(nullptr, context.credentials());
+    // All the RPCs share the same call credentials.
+    if (!first) first = context.credentials();
+    EXPECT_EQ(first, context.credentials());
   }
 }
 
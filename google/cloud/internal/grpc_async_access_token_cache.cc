@@ -20,55 +20,70 @@ inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
 auto constexpr kUseSlack = std::chrono::seconds(30);
-auto constexpr kRefreshSlack = std::chrono::minutes(5);
 
 std::shared_ptr<GrpcAsyncAccessTokenCache> GrpcAsyncAccessTokenCache::Create(
-    CompletionQueue cq, AsyncAccessTokenSource source) {
+    AsyncAccessTokenSource source, std::chrono::seconds refresh_lead_time) {
   return std::shared_ptr<GrpcAsyncAccessTokenCache>(
-      new GrpcAsyncAccessTokenCache(std::move(cq), std::move(source)));
+      new GrpcAsyncAccessTokenCache(std::move(source), refresh_lead_time));
 }
 
 StatusOr<AccessToken> GrpcAsyncAccessTokenCache::GetAccessToken(
-    std::chrono::system_clock::time_point now) {
+    CompletionQueue& cq, std::chrono::system_clock::time_point now) {
   std::unique_lock<std::mutex> lk(mu_);
-  if (now + kUseSlack > token_.expiration) return Refresh(std::move(lk));
+  if (now + kUseSlack > token_.expiration) return Refresh(std::move(lk), cq);
   auto tmp = token_;
-  if (now + kRefreshSlack >= token_.expiration) StartRefresh(std::move(lk));
+  if (now + refresh_lead_time_ >= token_.expiration) {
+    StartRefresh(std::move(lk), cq);
+  }
   return tmp;
 }
 
 future<StatusOr<AccessToken>> GrpcAsyncAccessTokenCache::AsyncGetAccessToken(
-    std::chrono::system_clock::time_point now) {
+    CompletionQueue& cq, std::chrono::system_clock::time_point now) {
   std::unique_lock<std::mutex> lk(mu_);
-  if (now + kUseSlack > token_.expiration) return AsyncRefresh(std::move(lk));
+  if (now + kUseSlack > token_.expiration) {
+    return AsyncRefresh(std::move(lk), cq);
+  }
   auto tmp = token_;
-  if (now + kRefreshSlack >= token_.expiration) StartRefresh(std::move(lk));
+  if (now + refresh_lead_time_ >= token_.expiration) {
+    StartRefresh(std::move(lk), cq);
+  }
   return make_ready_future(make_status_or(tmp));
 }
 
+future<StatusOr<AccessToken>> GrpcAsyncAccessTokenCache::AsyncRefreshIfExpiring(
+    CompletionQueue& cq, std::chrono::system_clock::time_point now) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (refreshing_ || now + refresh_lead_time_ >= token_.expiration) {
+    return AsyncRefresh(std::move(lk), cq);
+  }
+  return make_ready_future(make_status_or(token_));
+}
+
 GrpcAsyncAccessTokenCache::GrpcAsyncAccessTokenCache(
-    CompletionQueue cq, AsyncAccessTokenSource source)
-    : cq_(std::move(cq)), source_(std::move(source)) {}
+    AsyncAccessTokenSource source, std::chrono::seconds refresh_lead_time)
+    : source_(std::move(source)), refresh_lead_time_(refresh_lead_time) {}
 
 StatusOr<AccessToken> GrpcAsyncAccessTokenCache::Refresh(
-    std::unique_lock<std::mutex> lk) {
-  return AsyncRefresh(std::move(lk)).get();
+    std::unique_lock<std::mutex> lk, CompletionQueue& cq) {
+  return AsyncRefresh(std::move(lk), cq).get();
 }
 
 future<StatusOr<AccessToken>> GrpcAsyncAccessTokenCache::AsyncRefresh(
-    std::unique_lock<std::mutex> lk) {
-  waiting_.emplace_back();
-  auto result = waiting_.back().get_future();
-  StartRefresh(std::move(lk));
+    std::unique_lock<std::mutex> lk, CompletionQueue& cq) {
+  waiting_.push_back(Waiter{{}, cq});
+  auto result = waiting_.back().p.get_future();
+  StartRefresh(std::move(lk), cq);
   return result;
 }
 
-void GrpcAsyncAccessTokenCache::StartRefresh(std::unique_lock<std::mutex> lk) {
+void GrpcAsyncAccessTokenCache::StartRefresh(std::unique_lock<std::mutex> lk,
+                                             CompletionQueue& cq) {
   if (refreshing_) return;
   refreshing_ = true;
   auto w = WeakFromThis();
   lk.unlock();
-  source_(cq_).then([w](future<StatusOr<AccessToken>> f) {
+  source_(cq).then([w](future<StatusOr<AccessToken>> f) {
     if (auto self = w.lock()) self->OnRefresh(std::move(f));
   });
 }
@@ -76,7 +91,7 @@ void GrpcAsyncAccessTokenCache::StartRefresh(std::unique_lock<std::mutex> lk) {
 void GrpcAsyncAccessTokenCache::OnRefresh(future<StatusOr<AccessToken>> f) {
   std::unique_lock<std::mutex> lk(mu_);
   refreshing_ = false;
-  std::vector<WaiterType> waiting;
+  std::vector<Waiter> waiting;
   waiting.swap(waiting_);
   auto result = f.get();
   StatusOr<AccessToken> value;
@@ -86,13 +101,15 @@ void GrpcAsyncAccessTokenCache::OnRefresh(future<StatusOr<AccessToken>> f) {
   } else {
     value = std::move(result).status();
   }
-  // Run the waiters asynchronously to avoid blocking
+  lk.unlock();
+  // Run the waiters asynchronously to avoid blocking. Each waiter uses its own
+  // queue, the queue used for the refresh may belong to a different client.
   struct SetStatus {
-    WaiterType p;
+    promise<StatusOr<AccessToken>> p;
     StatusOr<AccessToken> value;
     void operator()() { p.set_value(std::move(value)); }
   };
-  for (auto& p : waiting) cq_.RunAsync(SetStatus{std::move(p), value});
+  for (auto& w : waiting) w.cq.RunAsync(SetStatus{std::move(w.p), value});
 }
 
 }  // namespace internal
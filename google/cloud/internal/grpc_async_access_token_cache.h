@@ -48,42 +48,72 @@ using AsyncAccessTokenSource =
  * Splitting this functionality to a separate class (instead of the
  * GrpcAuthenticationStrategy for service account impersonation) makes for
  * easier testing.
+ *
+ * A single cache is shared by all the clients created from the same
+ * `Credentials` object, and these clients may use different
+ * `CompletionQueue`s. Therefore the cache does not hold a `CompletionQueue`,
+ * each call receives the queue used to refresh the token and to satisfy the
+ * returned futures.
+ *
+ * The cache returns the current token, and starts a refresh in the background,
+ * once the token is within @p refresh_lead_time of its expiration. Only one
+ * refresh is in flight at a time. The callers block (or their futures are not
+ * satisfied) only if the token has actually expired.
  */
 class GrpcAsyncAccessTokenCache
     : public std::enable_shared_from_this<GrpcAsyncAccessTokenCache> {
  public:
   static std::shared_ptr<GrpcAsyncAccessTokenCache> Create(
-      CompletionQueue cq, AsyncAccessTokenSource source);
+      AsyncAccessTokenSource source,
+      std::chrono::seconds refresh_lead_time = std::chrono::minutes(5));
 
   StatusOr<AccessToken> GetAccessToken(
-      std::chrono::system_clock::time_point now =
-          std::chrono::system_clock::now());
+      CompletionQueue& cq, std::chrono::system_clock::time_point now =
+                               std::chrono::system_clock::now());
   future<StatusOr<AccessToken>> AsyncGetAccessToken(
-      std::chrono::system_clock::time_point now =
-          std::chrono::system_clock::now());
+      CompletionQueue& cq, std::chrono::system_clock::time_point now =
+                               std::chrono::system_clock::now());
+
+  /**
+   * Refreshes the token if it is within the refresh lead time of expiring.
+   *
+   * Use this to refresh tokens before any RPC needs them. The returned future
+   * is satisfied with the current token, or with the refreshed token if a
+   * refresh was needed (or already in progress).
+   */
+  future<StatusOr<AccessToken>> AsyncRefreshIfExpiring(
+      CompletionQueue& cq, std::chrono::system_clock::time_point now =
+                               std::chrono::system_clock::now());
+
+  std::chrono::seconds refresh_lead_time() const { return refresh_lead_time_; }
 
  private:
-  using WaiterType = promise<StatusOr<AccessToken>>;
-  explicit GrpcAsyncAccessTokenCache(CompletionQueue cq,
-                                     AsyncAccessTokenSource source);
+  struct Waiter {
+    promise<StatusOr<AccessToken>> p;
+    CompletionQueue cq;
+  };
+
+  GrpcAsyncAccessTokenCache(AsyncAccessTokenSource source,
+                            std::chrono::seconds refresh_lead_time);
 
-  StatusOr<AccessToken> Refresh(std::unique_lock<std::mutex> lk);
-  future<StatusOr<AccessToken>> AsyncRefresh(std::unique_lock<std::mutex> lk);
+  StatusOr<AccessToken> Refresh(std::unique_lock<std::mutex> lk,
+                                CompletionQueue& cq);
+  future<StatusOr<AccessToken>> AsyncRefresh(std::unique_lock<std::mutex> lk,
+                                             CompletionQueue& cq);
 
-  void StartRefresh(std::unique_lock<std::mutex> lk);
+  void StartRefresh(std::unique_lock<std::mutex> lk, CompletionQueue& cq);
   void OnRefresh(future<StatusOr<AccessToken>>);
 
   std::weak_ptr<GrpcAsyncAccessTokenCache> WeakFromThis() {
     return std::weak_ptr<GrpcAsyncAccessTokenCache>(shared_from_this());
   }
 
-  CompletionQueue cq_;
   AsyncAccessTokenSource source_;
+  std::chrono::seconds const refresh_lead_time_;
   std::mutex mu_;
   AccessToken token_;
   bool refreshing_ = false;
-  future<StatusOr<AccessToken>> pending_;
-  std::vector<WaiterType> waiting_;
+  std::vector<Waiter> waiting_;
 };
 
 }  // namespace internal
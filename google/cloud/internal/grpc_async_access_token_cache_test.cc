@@ -49,31 +49,32 @@ TEST(GrpcAsyncAccessTokenCacheTest, Simple) {
       });
 
   AutomaticallyCreatedBackgroundThreads background;
-  auto under_test = GrpcAsyncAccessTokenCache::Create(
-      background.cq(), mock_source.AsStdFunction());
+  auto cq = background.cq();
+  auto under_test =
+      GrpcAsyncAccessTokenCache::Create(mock_source.AsStdFunction());
 
-  auto pending = under_test->AsyncGetAccessToken(start);
+  auto pending = under_test->AsyncGetAccessToken(cq, start);
   async.PopFront().set_value();
   EXPECT_THAT(pending.get(), IsOk());
 
   // For the next few minutes the cache makes no further calls.
   for (auto m : {minutes(1), minutes(2), minutes(3)}) {
     SCOPED_TRACE("Testing at start + " + std::to_string(m.count()) + "m");
-    auto r = under_test->GetAccessToken(start + m);
+    auto r = under_test->GetAccessToken(cq, start + m);
     ASSERT_THAT(r, IsOk());
     EXPECT_EQ(t1.token, r->token);
     EXPECT_EQ(t1.expiration, r->expiration);
   }
 
   // At start+6m the cache makes a call, but still returns the cached value.
-  auto r = under_test->GetAccessToken(start + minutes(6));
+  auto r = under_test->GetAccessToken(cq, start + minutes(6));
   ASSERT_THAT(r, IsOk());
   EXPECT_EQ(t1.token, r->token);
   EXPECT_EQ(t1.expiration, r->expiration);
 
   // Have the async operation complete and test at start+11m
   async.PopFront().set_value();
-  r = under_test->GetAccessToken(start + minutes(11));
+  r = under_test->GetAccessToken(cq, start + minutes(11));
   ASSERT_THAT(r, IsOk());
   EXPECT_EQ(t2.token, r->token);
   EXPECT_EQ(t2.expiration, r->expiration);
@@ -99,31 +100,32 @@ TEST(GrpcAsyncAccessTokenCacheTest, SimpleAsync) {
       });
 
   AutomaticallyCreatedBackgroundThreads background;
-  auto under_test = GrpcAsyncAccessTokenCache::Create(
-      background.cq(), mock_source.AsStdFunction());
+  auto cq = background.cq();
+  auto under_test =
+      GrpcAsyncAccessTokenCache::Create(mock_source.AsStdFunction());
 
-  auto pending = under_test->AsyncGetAccessToken(start);
+  auto pending = under_test->AsyncGetAccessToken(cq, start);
   async.PopFront().set_value();
   EXPECT_THAT(pending.get(), IsOk());
 
   // For the next few minutes the cache makes no further calls.
   for (auto m : {minutes(1), minutes(2), minutes(3)}) {
     SCOPED_TRACE("Testing at start + " + std::to_string(m.count()) + "m");
-    auto r = under_test->AsyncGetAccessToken(start + m).get();
+    auto r = under_test->AsyncGetAccessToken(cq, start + m).get();
     ASSERT_THAT(r, IsOk());
     EXPECT_EQ(t1.token, r->token);
     EXPECT_EQ(t1.expiration, r->expiration);
   }
 
   // At start+6m the cache makes a call, but still returns the cached value.
-  auto r = under_test->AsyncGetAccessToken(start + minutes(6)).get();
+  auto r = under_test->AsyncGetAccessToken(cq, start + minutes(6)).get();
   ASSERT_THAT(r, IsOk());
   EXPECT_EQ(t1.token, r->token);
   EXPECT_EQ(t1.expiration, r->expiration);
 
   // Have the async operation complete and test at start+11m
   async.PopFront().set_value();
-  r = under_test->AsyncGetAccessToken(start + minutes(11)).get();
+  r = under_test->AsyncGetAccessToken(cq, start + minutes(11)).get();
   ASSERT_THAT(r, IsOk());
   EXPECT_EQ(t2.token, r->token);
   EXPECT_EQ(t2.expiration, r->expiration);
@@ -155,10 +157,11 @@ TEST(GrpcAsyncAccessTokenCacheTest, IgnoreErrorsOnPreCaching) {
       });
 
   AutomaticallyCreatedBackgroundThreads background;
-  auto under_test = GrpcAsyncAccessTokenCache::Create(
-      background.cq(), mock_source.AsStdFunction());
+  auto cq = background.cq();
+  auto under_test =
+      GrpcAsyncAccessTokenCache::Create(mock_source.AsStdFunction());
 
-  auto pending = under_test->AsyncGetAccessToken(start);
+  auto pending = under_test->AsyncGetAccessToken(cq, start);
   async.PopFront().set_value();
   EXPECT_THAT(pending.get(), IsOk());
 
@@ -168,7 +171,7 @@ TEST(GrpcAsyncAccessTokenCacheTest, IgnoreErrorsOnPreCaching) {
   for (auto s : {seconds(1), seconds(2), seconds(3)}) {
     auto i = minutes(5) + s;
     SCOPED_TRACE("Testing at start + " + std::to_string(i.count()) + "s");
-    auto r = under_test->GetAccessToken(start + i);
+    auto r = under_test->GetAccessToken(cq, start + i);
     ASSERT_THAT(r, IsOk());
     EXPECT_EQ(r->token, t1.token);
   }
@@ -179,7 +182,7 @@ TEST(GrpcAsyncAccessTokenCacheTest, IgnoreErrorsOnPreCaching) {
   for (auto s : {seconds(4), seconds(5), seconds(6)}) {
     auto i = minutes(5) + s;
     SCOPED_TRACE("Testing at start + " + std::to_string(i.count()) + "s");
-    auto r = under_test->GetAccessToken(start + i);
+    auto r = under_test->GetAccessToken(cq, start + i);
     ASSERT_THAT(r, IsOk());
     EXPECT_EQ(r->token, t1.token);
   }
@@ -190,7 +193,7 @@ TEST(GrpcAsyncAccessTokenCacheTest, IgnoreErrorsOnPreCaching) {
   for (auto s : {seconds(7), seconds(8)}) {
     auto i = minutes(5) + s;
     SCOPED_TRACE("Testing at start + " + std::to_string(i.count()) + "s");
-    auto r = under_test->GetAccessToken(start + i);
+    auto r = under_test->GetAccessToken(cq, start + i);
     ASSERT_THAT(r, IsOk());
     EXPECT_EQ(t2.token, r->token);
   }
@@ -209,10 +212,11 @@ TEST(GrpcAsyncAccessTokenCacheTest, ReturnError) {
   });
 
   AutomaticallyCreatedBackgroundThreads background;
-  auto under_test = GrpcAsyncAccessTokenCache::Create(
-      background.cq(), mock_source.AsStdFunction());
+  auto cq = background.cq();
+  auto under_test =
+      GrpcAsyncAccessTokenCache::Create(mock_source.AsStdFunction());
 
-  auto pending = under_test->AsyncGetAccessToken(start);
+  auto pending = under_test->AsyncGetAccessToken(cq, start);
   async.PopFront().set_value();
   EXPECT_THAT(pending.get(), StatusIs(StatusCode::kUnavailable, "try-again"));
 }
@@ -231,12 +235,13 @@ TEST(GrpcAsyncAccessTokenCacheTest, SatisfyMany) {
   });
 
   AutomaticallyCreatedBackgroundThreads background;
-  auto under_test = GrpcAsyncAccessTokenCache::Create(
-      background.cq(), mock_source.AsStdFunction());
+  auto cq = background.cq();
+  auto under_test =
+      GrpcAsyncAccessTokenCache::Create(mock_source.AsStdFunction());
 
   std::vector<future<StatusOr<AccessToken>>> results(3);
   std::generate(results.begin(), results.end(),
-                [&] { return under_test->AsyncGetAccessToken(start); });
+                [&] { return under_test->AsyncGetAccessToken(cq, start); });
 
   // Making multiple requests creates one refresh attempt, simulate its
   // completion, that should satisfy all the pending requests.
@@ -261,15 +266,98 @@ TEST(GrpcAsyncAccessTokenCacheTest, BlockingRefresh) {
   });
 
   AutomaticallyCreatedBackgroundThreads background;
-  auto under_test = GrpcAsyncAccessTokenCache::Create(
-      background.cq(), mock_source.AsStdFunction());
+  auto cq = background.cq();
+  auto under_test =
+      GrpcAsyncAccessTokenCache::Create(mock_source.AsStdFunction());
 
-  auto r = under_test->GetAccessToken(start);
+  auto r = under_test->GetAccessToken(cq, start);
   EXPECT_THAT(r, IsOk());
   EXPECT_EQ(t1.token, r->token);
   EXPECT_EQ(t1.expiration, r->expiration);
 }
 
+TEST(GrpcAsyncAccessTokenCacheTest, RefreshLeadTime) {
+  ::testing::MockFunction<future<StatusOr<AccessToken>>(CompletionQueue&)>
+      mock_source;
+  auto const start = std::chrono::system_clock::now();
+  using minutes = std::chrono::minutes;
+  auto const t1 = AccessToken{"token1", start + minutes(10)};
+  auto const t2 = AccessToken{"token2", start + minutes(20)};
+
+  AsyncSequencer<void> async;
+  EXPECT_CALL(mock_source, Call)
+      .WillOnce([&](CompletionQueue&) {
+        return async.PushBack().then(
+            [&](future<void>) { return make_status_or(t1); });
+      })
+      .WillOnce([&](CompletionQueue&) {
+        return async.PushBack().then(
+            [&](future<void>) { return make_status_or(t2); });
+      });
+
+  AutomaticallyCreatedBackgroundThreads background;
+  auto cq = background.cq();
+  auto under_test = GrpcAsyncAccessTokenCache::Create(
+      mock_source.AsStdFunction(), std::chrono::minutes(2));
+
+  auto pending = under_test->AsyncGetAccessToken(cq, start);
+  async.PopFront().set_value();
+  EXPECT_THAT(pending.get(), IsOk());
+
+  // With a shorter lead time the cache makes no calls at start+6m.
+  auto r = under_test->GetAccessToken(cq, start + minutes(6));
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t1.token, r->token);
+
+  // A refresh before the token is needed makes no calls either.
+  r = under_test->AsyncRefreshIfExpiring(cq, start + minutes(7)).get();
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t1.token, r->token);
+
+  // Within the lead time the refresh makes a call, and returns the new value.
+  auto refresh = under_test->AsyncRefreshIfExpiring(cq, start + minutes(9));
+  // Other callers do not wait for the refresh.
+  r = under_test->GetAccessToken(cq, start + minutes(9));
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t1.token, r->token);
+
+  async.PopFront().set_value();
+  r = refresh.get();
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t2.token, r->token);
+}
+
+TEST(GrpcAsyncAccessTokenCacheTest, SatisfyInCallerQueue) {
+  ::testing::MockFunction<future<StatusOr<AccessToken>>(CompletionQueue&)>
+      mock_source;
+  auto const start = std::chrono::system_clock::now();
+  auto const t1 = AccessToken{"token1", start + std::chrono::minutes(10)};
+
+  AsyncSequencer<void> async;
+  EXPECT_CALL(mock_source, Call).WillOnce([&](CompletionQueue&) {
+    return async.PushBack().then(
+        [&](future<void>) { return make_status_or(t1); });
+  });
+
+  // Simulate two clients sharing the same cache, but using different queues.
+  AutomaticallyCreatedBackgroundThreads b0;
+  AutomaticallyCreatedBackgroundThreads b1;
+  auto cq0 = b0.cq();
+  auto cq1 = b1.cq();
+  auto under_test =
+      GrpcAsyncAccessTokenCache::Create(mock_source.AsStdFunction());
+
+  auto f0 = under_test->AsyncGetAccessToken(cq0, start);
+  auto f1 = under_test->AsyncGetAccessToken(cq1, start);
+  // The first client is shutdown before the refresh completes, the second
+  // client still receives the token.
+  b0.Shutdown();
+  async.PopFront().set_value();
+  auto r = f1.get();
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t1.token, r->token);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -0,0 +1,37 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/internal/grpc_compression.h"
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+void ConfigureCompression(grpc::ClientContext& context,
+                          std::map<std::string, std::size_t> const& thresholds,
+                          std::string const& method,
+                          google::protobuf::Message const& request) {
+  if (thresholds.empty()) return;
+  auto const l = thresholds.find(method);
+  if (l == thresholds.end()) return;
+  if (request.ByteSizeLong() < l->second) return;
+  context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
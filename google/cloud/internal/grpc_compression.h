@@ -0,0 +1,49 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_COMPRESSION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_COMPRESSION_H
+
+#include "google/cloud/version.h"
+#include <google/protobuf/message.h>
+#include <grpcpp/grpcpp.h>
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Compresses @p request with gzip if it is at least as large as the threshold
+ * for @p method.
+ *
+ * The thresholds come from `GrpcCompressionOption`. If @p method does not
+ * appear in @p thresholds the context is not modified, and the size of
+ * @p request is not computed.
+ */
+void ConfigureCompression(grpc::ClientContext& context,
+                          std::map<std::string, std::size_t> const& thresholds,
+                          std::string const& method,
+                          google::protobuf::Message const& request);
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_COMPRESSION_H
@@ -0,0 +1,62 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/internal/grpc_compression.h"
+#include <google/protobuf/wrappers.pb.h>
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+google::protobuf::StringValue MakeRequest(std::size_t size) {
+  google::protobuf::StringValue request;
+  request.set_value(std::string(size, 'x'));
+  return request;
+}
+
+TEST(GrpcCompression, Disabled) {
+  grpc::ClientContext context;
+  ConfigureCompression(context, {}, "Service.Method", MakeRequest(4096));
+  EXPECT_EQ(GRPC_COMPRESS_NONE, context.compression_algorithm());
+}
+
+TEST(GrpcCompression, OtherMethod) {
+  grpc::ClientContext context;
+  ConfigureCompression(context, {{"Service.Other", 0}}, "Service.Method",
+                       MakeRequest(4096));
+  EXPECT_EQ(GRPC_COMPRESS_NONE, context.compression_algorithm());
+}
+
+TEST(GrpcCompression, Threshold) {
+  std::map<std::string, std::size_t> const thresholds{
+      {"Service.Method", 1024}};
+  grpc::ClientContext small;
+  ConfigureCompression(small, thresholds, "Service.Method", MakeRequest(16));
+  EXPECT_EQ(GRPC_COMPRESS_NONE, small.compression_algorithm());
+
+  grpc::ClientContext large;
+  ConfigureCompression(large, thresholds, "Service.Method", MakeRequest(4096));
+  EXPECT_EQ(GRPC_COMPRESS_GZIP, large.compression_algorithm());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -13,9 +13,20 @@
 // limitations under the License.
 
 #include "google/cloud/internal/grpc_impersonate_service_account.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/algorithm.h"
+#include "google/cloud/internal/credentials_impl.h"
+#include "google/cloud/internal/grpc_impersonation_manager.h"
 #include "google/cloud/internal/minimal_iam_credentials_stub.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/internal/time_utils.h"
 #include "google/cloud/internal/unified_grpc_credentials.h"
+#include "absl/strings/str_cat.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -56,11 +67,45 @@ AsyncAccessTokenSource MakeSource(ImpersonateServiceAccountConfig const& config,
   };
 }
 
+// The options used to create the IAM Credentials stub in `MakeSource()`.
+std::string SharedCacheKey(Options const& options) {
+  auto const stub_options = MakeMinimalIamCredentialsOptions(options);
+  std::string key = stub_options.get<EndpointOption>();
+  key += '\n';
+  if (stub_options.has<CARootsFilePathOption>()) {
+    key += stub_options.get<CARootsFilePathOption>();
+  }
+  key += '\n';
+  if (Contains(stub_options.get<TracingComponentsOption>(), "rpc")) {
+    auto const& tracing = stub_options.get<GrpcTracingOptionsOption>();
+    key += absl::StrCat("rpc,", tracing.single_line_mode(), ",",
+                        tracing.use_short_repeated_primitives(), ",",
+                        tracing.truncate_string_field_longer_than());
+  }
+  return key;
+}
+
 std::shared_ptr<GrpcAsyncAccessTokenCache> MakeCache(
     CompletionQueue cq, ImpersonateServiceAccountConfig const& config,
     Options const& options) {
-  auto source = MakeSource(config, cq, options);
-  return GrpcAsyncAccessTokenCache::Create(std::move(cq), std::move(source));
+  if (options.has<GrpcImpersonationManagerOption>()) {
+    return options.get<GrpcImpersonationManagerOption>()->Cache(config);
+  }
+  std::function<std::shared_ptr<GrpcAsyncAccessTokenCache>()> factory = [&] {
+    return GrpcAsyncAccessTokenCache::Create(MakeSource(config, cq, options),
+                                             config.refresh_lead_time());
+  };
+  // Impersonated base credentials refresh their own tokens using the queue
+  // they are created with. A shared cache would stop working when the client
+  // that created it shuts down its queue, so these caches are not shared.
+  if (dynamic_cast<ImpersonateServiceAccountConfig const*>(
+          config.base_credentials().get()) != nullptr) {
+    return factory();
+  }
+  // All the clients created from the same `Credentials`, and with the same
+  // IAM Credentials stub configuration, share the cache. The first of these
+  // clients creates the stub used by all of them.
+  return config.SharedCache(SharedCacheKey(options), factory);
 }
 
 }  // namespace
@@ -76,12 +121,19 @@ GrpcImpersonateServiceAccount::Create(
 GrpcImpersonateServiceAccount::GrpcImpersonateServiceAccount(
     CompletionQueue cq, ImpersonateServiceAccountConfig const& config,
     Options const& opts)
-    : cache_(MakeCache(std::move(cq), config, opts)) {
+    : cq_(cq),
+      managed_(opts.has<GrpcImpersonationManagerOption>()),
+      cache_(MakeCache(std::move(cq), config, opts)),
+      generator_(MakeDefaultPRNG()) {
   auto cainfo = LoadCAInfo(opts);
   if (cainfo) ssl_options_.pem_root_certs = std::move(*cainfo);
 }
 
-GrpcImpersonateServiceAccount::~GrpcImpersonateServiceAccount() = default;
+GrpcImpersonateServiceAccount::~GrpcImpersonateServiceAccount() {
+  // Timers run to completion even after the `CompletionQueue` is shutdown,
+  // cancel the refresh timer, or the client would wait for it on shutdown.
+  if (timer_.valid()) timer_.cancel();
+}
 
 std::shared_ptr<grpc::Channel> GrpcImpersonateServiceAccount::CreateChannel(
     std::string const& endpoint, grpc::ChannelArguments const& arguments) {
@@ -95,9 +147,9 @@ bool GrpcImpersonateServiceAccount::RequiresConfigureContext() const {
 
 Status GrpcImpersonateServiceAccount::ConfigureContext(
     grpc::ClientContext& context) {
-  auto token = cache_->GetAccessToken();
+  auto token = cache_->GetAccessToken(cq_);
   if (!token) return std::move(token).status();
-  context.set_credentials(UpdateCallCredentials(std::move(token->token)));
+  context.set_credentials(UpdateCallCredentials(*std::move(token)));
   return Status{};
 }
 
@@ -115,18 +167,22 @@ GrpcImpersonateServiceAccount::AsyncConfigureContext(
       return self->OnGetCallCredentials(std::move(context), f.get());
     }
   };
-  return cache_->AsyncGetAccessToken().then(
+  return cache_->AsyncGetAccessToken(cq_).then(
       Capture{WeakFromThis(), std::move(context)});
 }
 
 std::shared_ptr<grpc::CallCredentials>
-GrpcImpersonateServiceAccount::UpdateCallCredentials(std::string token) {
-  std::lock_guard<std::mutex> lk(mu_);
-  if (access_token_ != token) {
-    credentials_ = grpc::AccessTokenCredentials(token);
-    access_token_ = std::move(token);
+GrpcImpersonateServiceAccount::UpdateCallCredentials(AccessToken token) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (access_token_ != token.token) {
+    credentials_ = grpc::AccessTokenCredentials(token.token);
+    access_token_ = std::move(token.token);
   }
-  return credentials_;
+  auto credentials = credentials_;
+  // A `GrpcImpersonationManager` refreshes its tokens, there is no need for a
+  // timer in each client.
+  if (!managed_) ScheduleRefresh(std::move(lk), token.expiration);
+  return credentials;
 }
 
 StatusOr<std::unique_ptr<grpc::ClientContext>>
@@ -134,10 +190,61 @@ GrpcImpersonateServiceAccount::OnGetCallCredentials(
     std::unique_ptr<grpc::ClientContext> context,
     StatusOr<AccessToken> result) {
   if (!result) return std::move(result).status();
-  context->set_credentials(UpdateCallCredentials(std::move(result->token)));
+  context->set_credentials(UpdateCallCredentials(*std::move(result)));
   return make_status_or(std::move(context));
 }
 
+void GrpcImpersonateServiceAccount::ScheduleRefresh(
+    std::unique_lock<std::mutex> lk,
+    std::chrono::system_clock::time_point expiration) {
+  auto const now = std::chrono::system_clock::now();
+  if (expiration <= refresh_scheduled_for_ || expiration <= now) return;
+  refresh_scheduled_for_ = expiration;
+  // Refresh between the lead time and half the lead time before the token
+  // expires. The jitter spreads the refresh requests from many processes. Use
+  // at most half the remaining lifetime, short-lived tokens would be refreshed
+  // in a loop otherwise.
+  auto const lead = (std::min)(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          cache_->refresh_lead_time()),
+      std::chrono::duration_cast<std::chrono::milliseconds>(expiration - now) /
+          2);
+  std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(
+      0, lead.count() / 2);
+  auto const deadline =
+      expiration - lead + std::chrono::milliseconds(jitter(generator_));
+  lk.unlock();
+
+  auto w = WeakFromThis();
+  auto timer = cq_.MakeDeadlineTimer(deadline).then(
+      [w](future<StatusOr<std::chrono::system_clock::time_point>> f) {
+        if (!f.get()) return;  // cancelled
+        if (auto self = w.lock()) self->OnRefreshTimer();
+      });
+
+  lk.lock();
+  // A newer token may have scheduled a newer timer while the lock was
+  // released, cancel whichever timer is obsolete.
+  if (refresh_scheduled_for_ == expiration) std::swap(timer_, timer);
+  lk.unlock();
+  if (timer.valid()) timer.cancel();
+}
+
+void GrpcImpersonateServiceAccount::OnRefreshTimer() {
+  auto w = WeakFromThis();
+  cache_->AsyncRefreshIfExpiring(cq_).then(
+      [w](future<StatusOr<AccessToken>> f) {
+        auto token = f.get();
+        // On errors the next RPC starts a new refresh, which reschedules the
+        // timer.
+        if (!token) return;
+        if (auto self = w.lock()) {
+          self->ScheduleRefresh(std::unique_lock<std::mutex>(self->mu_),
+                                token->expiration);
+        }
+      });
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -17,11 +17,13 @@
 
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/grpc_async_access_token_cache.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/internal/unified_grpc_credentials.h"
 #include "google/cloud/options.h"
 #include "google/cloud/version.h"
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -55,20 +57,31 @@ class GrpcImpersonateServiceAccount
                                 Options const& opts);
 
   std::shared_ptr<grpc::CallCredentials> UpdateCallCredentials(
-      std::string token);
+      AccessToken token);
   StatusOr<std::unique_ptr<grpc::ClientContext>> OnGetCallCredentials(
       std::unique_ptr<grpc::ClientContext> context,
       StatusOr<AccessToken> result);
 
+  // Refresh the token in the background, before it expires and before any RPC
+  // needs to wait for it.
+  void ScheduleRefresh(std::unique_lock<std::mutex> lk,
+                       std::chrono::system_clock::time_point expiration);
+  void OnRefreshTimer();
+
   std::weak_ptr<GrpcImpersonateServiceAccount> WeakFromThis() {
     return shared_from_this();
   }
 
+  CompletionQueue cq_;
+  bool const managed_;
   std::shared_ptr<GrpcAsyncAccessTokenCache> cache_;
   std::mutex mu_;
   std::string access_token_;
   std::shared_ptr<grpc::CallCredentials> credentials_;
   grpc::SslCredentialsOptions ssl_options_;
+  DefaultPRNG generator_;
+  std::chrono::system_clock::time_point refresh_scheduled_for_;
+  future<void> timer_;
 };
 
 }  // namespace internal
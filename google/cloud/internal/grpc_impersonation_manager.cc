@@ -0,0 +1,213 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/grpc_impersonation_manager.h"
+#include "google/cloud/internal/minimal_iam_credentials_stub.h"
+#include "google/cloud/internal/time_utils.h"
+#include "google/cloud/internal/unified_grpc_credentials.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::iam::credentials::v1::GenerateAccessTokenResponse;
+
+std::string CacheKey(ImpersonateServiceAccountConfig const& config) {
+  // The components cannot contain newlines, so the key is unambiguous.
+  std::string key = config.target_service_account();
+  key += '\n';
+  key += std::to_string(config.lifetime().count());
+  key += '\n';
+  for (auto const& d : config.delegates()) key += d + ',';
+  key += '\n';
+  for (auto const& s : config.scopes()) key += s + ',';
+  return key;
+}
+
+}  // namespace
+
+std::shared_ptr<GrpcImpersonationManager> GrpcImpersonationManager::Create(
+    CompletionQueue cq, std::shared_ptr<Credentials> const& base_credentials,
+    Options const& options) {
+  auto stub = MakeMinimalIamCredentialsStub(
+      CreateAuthenticationStrategy(base_credentials, cq, options),
+      MakeMinimalIamCredentialsOptions(options));
+  return Create(std::move(cq), std::move(stub), options);
+}
+
+std::shared_ptr<GrpcImpersonationManager> GrpcImpersonationManager::Create(
+    CompletionQueue cq, std::shared_ptr<MinimalIamCredentialsStub> stub,
+    Options const& options) {
+  auto manager =
+      std::shared_ptr<GrpcImpersonationManager>(new GrpcImpersonationManager(
+          std::move(cq), std::move(stub), options));
+  manager->ScheduleTimer();
+  return manager;
+}
+
+GrpcImpersonationManager::GrpcImpersonationManager(
+    CompletionQueue cq, std::shared_ptr<MinimalIamCredentialsStub> stub,
+    Options const& options)
+    : cq_(std::move(cq)),
+      stub_(std::move(stub)),
+      refresh_window_(
+          options.has<GrpcImpersonationRefreshWindowOption>()
+              ? options.get<GrpcImpersonationRefreshWindowOption>()
+              : std::chrono::milliseconds(std::chrono::seconds(30))),
+      max_concurrent_refreshes_((std::max)(
+          1, options.has<GrpcImpersonationMaxConcurrentRefreshesOption>()
+                 ? options.get<GrpcImpersonationMaxConcurrentRefreshesOption>()
+                 : 16)) {}
+
+GrpcImpersonationManager::~GrpcImpersonationManager() {
+  // Timers run to completion even after the `CompletionQueue` is shutdown,
+  // cancel the refresh timer, or the application would wait for it.
+  std::unique_lock<std::mutex> lk(mu_);
+  shutdown_ = true;
+  auto timer = std::move(timer_);
+  lk.unlock();
+  if (timer.valid()) timer.cancel();
+}
+
+std::shared_ptr<GrpcAsyncAccessTokenCache> GrpcImpersonationManager::Cache(
+    ImpersonateServiceAccountConfig const& config) {
+  auto key = CacheKey(config);
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& slot = caches_[key];
+  auto cache = slot.lock();
+  if (cache) return cache;
+
+  Request request;
+  request.set_name("projects/-/serviceAccounts/" +
+                   config.target_service_account());
+  *request.mutable_delegates() = {config.delegates().begin(),
+                                  config.delegates().end()};
+  *request.mutable_scope() = {config.scopes().begin(), config.scopes().end()};
+  request.mutable_lifetime()->set_seconds(config.lifetime().count());
+
+  auto w = WeakFromThis();
+  auto source = [w, request](CompletionQueue& cq) {
+    auto self = w.lock();
+    if (!self) {
+      return make_ready_future(StatusOr<AccessToken>(
+          Status(StatusCode::kUnavailable, "impersonation manager deleted")));
+    }
+    return self->GenerateAccessToken(cq, request);
+  };
+  cache = GrpcAsyncAccessTokenCache::Create(std::move(source),
+                                            config.refresh_lead_time());
+  slot = cache;
+  return cache;
+}
+
+future<StatusOr<AccessToken>> GrpcImpersonationManager::GenerateAccessToken(
+    CompletionQueue& cq, Request const& request) {
+  Pending pending{request, {}, cq};
+  auto f = pending.p.get_future();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (in_flight_ >= max_concurrent_refreshes_) {
+    pending_.push_back(std::move(pending));
+    return f;
+  }
+  ++in_flight_;
+  lk.unlock();
+  StartRequest(std::move(pending));
+  return f;
+}
+
+void GrpcImpersonationManager::StartRequest(Pending pending) {
+  struct OnResponse {
+    std::shared_ptr<GrpcImpersonationManager> self;
+    promise<StatusOr<AccessToken>> p;
+
+    void operator()(future<StatusOr<GenerateAccessTokenResponse>> f) {
+      // Start the next queued request before satisfying the promise, its
+      // continuations may take a while.
+      self->OnRequestDone();
+      auto response = f.get();
+      if (!response) return p.set_value(std::move(response).status());
+      auto expiration = ToChronoTimePoint(response->expire_time());
+      p.set_value(AccessToken{std::move(*response->mutable_access_token()),
+                              expiration});
+    }
+  };
+  stub_
+      ->AsyncGenerateAccessToken(pending.cq,
+                                 absl::make_unique<grpc::ClientContext>(),
+                                 pending.request)
+      .then(OnResponse{shared_from_this(), std::move(pending.p)});
+}
+
+void GrpcImpersonationManager::OnRequestDone() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (pending_.empty()) {
+    --in_flight_;
+    return;
+  }
+  auto next = std::move(pending_.front());
+  pending_.pop_front();
+  lk.unlock();
+  StartRequest(std::move(next));
+}
+
+void GrpcImpersonationManager::ScheduleTimer() {
+  using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
+  auto w = WeakFromThis();
+  auto timer =
+      cq_.MakeRelativeTimer(refresh_window_).then([w](TimerFuture f) {
+        if (!f.get()) return;  // cancelled
+        if (auto self = w.lock()) self->OnTimer();
+      });
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!shutdown_) {
+    timer_ = std::move(timer);
+    return;
+  }
+  lk.unlock();
+  timer.cancel();
+}
+
+void GrpcImpersonationManager::OnTimer() {
+  std::vector<std::shared_ptr<GrpcAsyncAccessTokenCache>> caches;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    caches.reserve(caches_.size());
+    for (auto i = caches_.begin(); i != caches_.end();) {
+      auto cache = i->second.lock();
+      if (!cache) {
+        i = caches_.erase(i);
+        continue;
+      }
+      caches.push_back(std::move(cache));
+      ++i;
+    }
+  }
+  // Refresh every token that would need a refresh before the next tick. The
+  // refreshes due within the same window are started together, and queued if
+  // there are too many.
+  auto const horizon = std::chrono::system_clock::now() + refresh_window_;
+  for (auto& c : caches) c->AsyncRefreshIfExpiring(cq_, horizon);
+  ScheduleTimer();
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,143 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_IMPERSONATION_MANAGER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_IMPERSONATION_MANAGER_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/internal/credentials_impl.h"
+#include "google/cloud/internal/grpc_async_access_token_cache.h"
+#include "google/cloud/options.h"
+#include "google/cloud/version.h"
+#include <google/iam/credentials/v1/common.pb.h>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+class MinimalIamCredentialsStub;
+class GrpcImpersonationManager;
+
+/**
+ * Use a shared `GrpcImpersonationManager` for service account impersonation.
+ *
+ * When set, the clients using `MakeImpersonateServiceAccountCredentials()`
+ * get their access tokens from this manager, instead of creating an IAM
+ * Credentials stub and refresh timer for each impersonated service account.
+ */
+struct GrpcImpersonationManagerOption {
+  using Type = std::shared_ptr<GrpcImpersonationManager>;
+};
+
+/// Refreshes all the tokens expiring within this window together.
+struct GrpcImpersonationRefreshWindowOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/// The maximum number of concurrent `GenerateAccessToken` requests.
+struct GrpcImpersonationMaxConcurrentRefreshesOption {
+  using Type = int;
+};
+
+/**
+ * Manages the access tokens for many impersonated service accounts.
+ *
+ * Multi-tenant applications may impersonate hundreds of service accounts.
+ * Without this class each one gets its own IAM Credentials stub (and gRPC
+ * channel) and its own refresh timer, and the refresh requests are neither
+ * coordinated nor limited.
+ *
+ * The manager multiplexes all the `GenerateAccessToken` requests over a single
+ * stub, created with the manager's base credentials (the base credentials in
+ * each `ImpersonateServiceAccountConfig` are ignored). A single timer fires
+ * once per refresh window, and refreshes all the tokens that would need a
+ * refresh before the next tick, so refreshes due at about the same time are
+ * coalesced. At most `GrpcImpersonationMaxConcurrentRefreshesOption` requests
+ * are in flight at a time, any others are queued.
+ */
+class GrpcImpersonationManager
+    : public std::enable_shared_from_this<GrpcImpersonationManager> {
+ public:
+  static std::shared_ptr<GrpcImpersonationManager> Create(
+      CompletionQueue cq, std::shared_ptr<Credentials> const& base_credentials,
+      Options const& options = {});
+
+  /// Mostly used for unit testing, uses the given @p stub.
+  static std::shared_ptr<GrpcImpersonationManager> Create(
+      CompletionQueue cq, std::shared_ptr<MinimalIamCredentialsStub> stub,
+      Options const& options = {});
+
+  ~GrpcImpersonationManager();
+
+  /**
+   * Returns the token cache for the service account in @p config.
+   *
+   * All the callers impersonating the same service account, with the same
+   * delegates, scopes, and lifetime, share a cache.
+   */
+  std::shared_ptr<GrpcAsyncAccessTokenCache> Cache(
+      ImpersonateServiceAccountConfig const& config);
+
+ private:
+  using Request = ::google::iam::credentials::v1::GenerateAccessTokenRequest;
+
+  struct Pending {
+    Request request;
+    promise<StatusOr<AccessToken>> p;
+    CompletionQueue cq;
+  };
+
+  GrpcImpersonationManager(CompletionQueue cq,
+                           std::shared_ptr<MinimalIamCredentialsStub> stub,
+                           Options const& options);
+
+  future<StatusOr<AccessToken>> GenerateAccessToken(CompletionQueue& cq,
+                                                    Request const& request);
+  void StartRequest(Pending pending);
+  void OnRequestDone();
+
+  void ScheduleTimer();
+  void OnTimer();
+
+  std::weak_ptr<GrpcImpersonationManager> WeakFromThis() {
+    return shared_from_this();
+  }
+
+  CompletionQueue cq_;
+  std::shared_ptr<MinimalIamCredentialsStub> stub_;
+  std::chrono::milliseconds const refresh_window_;
+  int const max_concurrent_refreshes_;
+
+  std::mutex mu_;
+  std::map<std::string, std::weak_ptr<GrpcAsyncAccessTokenCache>> caches_;
+  int in_flight_ = 0;
+  std::deque<Pending> pending_;
+  future<void> timer_;
+  bool shutdown_ = false;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_IMPERSONATION_MANAGER_H
@@ -0,0 +1,194 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/grpc_impersonation_manager.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/minimal_iam_credentials_stub.h"
+#include "google/cloud/internal/time_utils.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <google/iam/credentials/v1/iamcredentials.grpc.pb.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::iam::credentials::v1::GenerateAccessTokenRequest;
+using ::google::iam::credentials::v1::GenerateAccessTokenResponse;
+using ::testing::ElementsAre;
+
+class MockMinimalIamCredentialsStub : public MinimalIamCredentialsStub {
+ public:
+  MOCK_METHOD(future<StatusOr<GenerateAccessTokenResponse>>,
+              AsyncGenerateAccessToken,
+              (CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+               GenerateAccessTokenRequest const&),
+              (override));
+};
+
+ImpersonateServiceAccountConfig MakeConfig(std::string const& target) {
+  return ImpersonateServiceAccountConfig(MakeInsecureCredentials(), target,
+                                         Options{});
+}
+
+GenerateAccessTokenResponse MakeResponse(
+    std::string const& token, std::chrono::system_clock::time_point expiration =
+                                  std::chrono::system_clock::now() +
+                                  std::chrono::hours(1)) {
+  GenerateAccessTokenResponse response;
+  response.set_access_token(token);
+  *response.mutable_expire_time() = ToProtoTimestamp(expiration);
+  return response;
+}
+
+Options TestOptions() {
+  return Options{}.set<GrpcImpersonationRefreshWindowOption>(
+      std::chrono::hours(1));
+}
+
+TEST(GrpcImpersonationManager, SharedCachePerPrincipal) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<MockMinimalIamCredentialsStub>();
+  auto manager =
+      GrpcImpersonationManager::Create(background.cq(), mock, TestOptions());
+  auto a1 = manager->Cache(MakeConfig("a@example.com"));
+  auto a2 = manager->Cache(MakeConfig("a@example.com"));
+  auto b = manager->Cache(MakeConfig("b@example.com"));
+  EXPECT_EQ(a1, a2);
+  EXPECT_NE(a1, b);
+}
+
+TEST(GrpcImpersonationManager, MultiplexesPrincipals) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<MockMinimalIamCredentialsStub>();
+  std::vector<std::string> names;
+  EXPECT_CALL(*mock, AsyncGenerateAccessToken)
+      .Times(2)
+      .WillRepeatedly([&names](CompletionQueue&,
+                               std::unique_ptr<grpc::ClientContext>,
+                               GenerateAccessTokenRequest const& request) {
+        names.push_back(request.name());
+        return make_ready_future(
+            make_status_or(MakeResponse("token-" + request.name())));
+      });
+  auto manager =
+      GrpcImpersonationManager::Create(background.cq(), mock, TestOptions());
+  auto cq = background.cq();
+  auto a = manager->Cache(MakeConfig("a@example.com"))->GetAccessToken(cq);
+  ASSERT_STATUS_OK(a);
+  EXPECT_EQ("token-projects/-/serviceAccounts/a@example.com", a->token);
+  auto b = manager->Cache(MakeConfig("b@example.com"))->GetAccessToken(cq);
+  ASSERT_STATUS_OK(b);
+  EXPECT_EQ("token-projects/-/serviceAccounts/b@example.com", b->token);
+  EXPECT_THAT(names, ElementsAre("projects/-/serviceAccounts/a@example.com",
+                                 "projects/-/serviceAccounts/b@example.com"));
+}
+
+TEST(GrpcImpersonationManager, LimitsConcurrentRequests) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<MockMinimalIamCredentialsStub>();
+  std::vector<promise<StatusOr<GenerateAccessTokenResponse>>> requests;
+  std::mutex mu;
+  EXPECT_CALL(*mock, AsyncGenerateAccessToken)
+      .Times(2)
+      .WillRepeatedly([&](CompletionQueue&,
+                          std::unique_ptr<grpc::ClientContext>,
+                          GenerateAccessTokenRequest const&) {
+        std::lock_guard<std::mutex> lk(mu);
+        requests.emplace_back();
+        return requests.back().get_future();
+      });
+  auto manager = GrpcImpersonationManager::Create(
+      background.cq(), mock,
+      TestOptions().set<GrpcImpersonationMaxConcurrentRefreshesOption>(1));
+  auto cq = background.cq();
+  auto a = manager->Cache(MakeConfig("a@example.com"));
+  auto b = manager->Cache(MakeConfig("b@example.com"));
+  auto fa = a->AsyncGetAccessToken(cq);
+  auto fb = b->AsyncGetAccessToken(cq);
+
+  // Only the first request starts, the second waits for it.
+  promise<StatusOr<GenerateAccessTokenResponse>> first;
+  {
+    std::lock_guard<std::mutex> lk(mu);
+    ASSERT_EQ(1, requests.size());
+    first = std::move(requests[0]);
+  }
+  first.set_value(MakeResponse("token-a"));
+  auto ta = fa.get();
+  ASSERT_STATUS_OK(ta);
+  EXPECT_EQ("token-a", ta->token);
+
+  promise<StatusOr<GenerateAccessTokenResponse>> second;
+  {
+    std::lock_guard<std::mutex> lk(mu);
+    ASSERT_EQ(2, requests.size());
+    second = std::move(requests[1]);
+  }
+  second.set_value(MakeResponse("token-b"));
+  auto tb = fb.get();
+  ASSERT_STATUS_OK(tb);
+  EXPECT_EQ("token-b", tb->token);
+}
+
+TEST(GrpcImpersonationManager, TimerRefreshesExpiringTokens) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<MockMinimalIamCredentialsStub>();
+  std::atomic<int> calls{0};
+  // The tokens are always within the refresh lead time, so each tick of the
+  // refresh timer refreshes them.
+  EXPECT_CALL(*mock, AsyncGenerateAccessToken)
+      .WillRepeatedly([&calls](CompletionQueue&,
+                               std::unique_ptr<grpc::ClientContext>,
+                               GenerateAccessTokenRequest const&) {
+        ++calls;
+        return make_ready_future(make_status_or(MakeResponse(
+            "token",
+            std::chrono::system_clock::now() + std::chrono::minutes(2))));
+      });
+  auto manager = GrpcImpersonationManager::Create(
+      background.cq(), mock,
+      Options{}.set<GrpcImpersonationRefreshWindowOption>(
+          std::chrono::milliseconds(10)));
+  auto cq = background.cq();
+  auto cache = manager->Cache(MakeConfig("a@example.com"));
+  ASSERT_STATUS_OK(cache->GetAccessToken(cq));
+  for (int i = 0; i != 100 && calls.load() < 3; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_GE(calls.load(), 3);
+}
+
+TEST(GrpcImpersonationManager, ManagerDeleted) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<MockMinimalIamCredentialsStub>();
+  EXPECT_CALL(*mock, AsyncGenerateAccessToken).Times(0);
+  auto manager =
+      GrpcImpersonationManager::Create(background.cq(), mock, TestOptions());
+  auto cache = manager->Cache(MakeConfig("a@example.com"));
+  manager.reset();
+  auto cq = background.cq();
+  auto token = cache->GetAccessToken(cq);
+  EXPECT_EQ(StatusCode::kUnavailable, token.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,46 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_TRACE_CONTEXT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_TRACE_CONTEXT_H
+
+#include "google/cloud/rpc_tracing.h"
+#include "google/cloud/version.h"
+#include <grpcpp/grpcpp.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/// Add the context headers for @p span (if not null) to @p context.
+inline void InjectTraceContext(RpcSpan const* span,
+                               grpc::ClientContext& context) {
+  if (span == nullptr) return;
+  for (auto const& kv : span->ContextHeaders()) {
+    context.AddMetadata(kv.first, kv.second);
+  }
+}
+
+/// Add the context headers for the current span to @p context.
+inline void InjectTraceContext(grpc::ClientContext& context) {
+  InjectTraceContext(CurrentRpcSpan(), context);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_TRACE_CONTEXT_H
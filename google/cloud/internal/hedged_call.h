@@ -0,0 +1,157 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_HEDGED_CALL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_HEDGED_CALL_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Returns the hedging delay for @p method.
+ *
+ * Only idempotent operations are hedged, for any other operation, or if the
+ * method does not appear in @p delays, this returns zero, which disables
+ * hedging.
+ */
+inline std::chrono::milliseconds HedgingDelay(
+    std::map<std::string, std::chrono::milliseconds> const& delays,
+    std::string const& method, Idempotency idempotency) {
+  if (idempotency != Idempotency::kIdempotent) return {};
+  auto const l = delays.find(method);
+  if (l == delays.end()) return {};
+  return l->second;
+}
+
+/**
+ * Calls @p functor, and sends a duplicate (or "hedged") request if the first
+ * one has not completed after @p delay.
+ *
+ * The hedged request runs in a @p cq thread, with a new `grpc::ClientContext`.
+ * The first successful response wins, and the loser is cancelled. A failed
+ * hedged request does not cancel the original request, the result of the
+ * original request is returned instead.
+ *
+ * This function does not return until both requests complete, so the caller's
+ * @p functor and @p request outlive both of them. Cancelled requests return
+ * quickly, so this only adds a short wait to the winning response.
+ *
+ * @warning only use this with idempotent operations, the service may receive
+ *     (and execute) both requests.
+ */
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor&, grpc::ClientContext&, Request const&>>
+Result HedgedCall(CompletionQueue cq, std::chrono::milliseconds delay,
+                  Functor& functor, grpc::ClientContext& context,
+                  Request const& request) {
+  if (delay.count() <= 0) return functor(context, request);
+
+  struct State {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done = false;
+    bool hedge_running = false;
+    std::unique_ptr<grpc::ClientContext> hedge_context;
+    absl::optional<Result> hedge_result;
+  };
+  auto state = std::make_shared<State>();
+  auto* primary = &context;
+  auto timer = cq.MakeRelativeTimer(delay).then(
+      [state, primary, &functor, &request](
+          future<StatusOr<std::chrono::system_clock::time_point>> f) {
+        if (!f.get().ok()) return;
+        std::unique_lock<std::mutex> lk(state->mu);
+        if (state->done) return;
+        state->hedge_running = true;
+        state->hedge_context = absl::make_unique<grpc::ClientContext>();
+        auto& hedge_context = *state->hedge_context;
+        lk.unlock();
+        auto result = functor(hedge_context, request);
+        lk.lock();
+        state->hedge_running = false;
+        if (result.ok() && !state->done) {
+          state->hedge_result = std::move(result);
+          primary->TryCancel();
+        }
+        state->cv.notify_all();
+      });
+
+  auto result = functor(context, request);
+  std::unique_lock<std::mutex> lk(state->mu);
+  state->done = true;
+  if (state->hedge_running) state->hedge_context->TryCancel();
+  state->cv.wait(lk, [&state] { return !state->hedge_running; });
+  lk.unlock();
+  timer.cancel();
+  if (state->hedge_result) return *std::move(state->hedge_result);
+  return result;
+}
+
+/**
+ * Wraps a functor used in `RetryLoop()` with `HedgedCall()`.
+ *
+ * Each attempt in the retry loop is hedged independently.
+ */
+template <typename Functor>
+class HedgedFunctor {
+ public:
+  HedgedFunctor(CompletionQueue cq, std::chrono::milliseconds delay,
+                Functor functor)
+      : cq_(std::move(cq)), delay_(delay), functor_(std::move(functor)) {}
+
+  template <typename Request>
+  auto operator()(grpc::ClientContext& context, Request const& request)
+      -> google::cloud::internal::invoke_result_t<
+          Functor&, grpc::ClientContext&, Request const&> {
+    return HedgedCall(cq_, delay_, functor_, context, request);
+  }
+
+ private:
+  CompletionQueue cq_;
+  std::chrono::milliseconds delay_;
+  Functor functor_;
+};
+
+/// Creates a `HedgedFunctor`, a zero @p delay disables hedging.
+template <typename Functor>
+HedgedFunctor<typename std::decay<Functor>::type> MakeHedgedFunctor(
+    CompletionQueue cq, std::chrono::milliseconds delay, Functor&& functor) {
+  return HedgedFunctor<typename std::decay<Functor>::type>(
+      std::move(cq), delay, std::forward<Functor>(functor));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_HEDGED_CALL_H
@@ -0,0 +1,133 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/hedged_call.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::std::chrono::milliseconds;
+
+TEST(HedgedCallTest, HedgingDelay) {
+  std::map<std::string, milliseconds> const delays{
+      {"Service.Get", milliseconds(10)}};
+  EXPECT_EQ(milliseconds(10),
+            HedgingDelay(delays, "Service.Get", Idempotency::kIdempotent));
+  EXPECT_EQ(milliseconds(0),
+            HedgingDelay(delays, "Service.Get", Idempotency::kNonIdempotent));
+  EXPECT_EQ(milliseconds(0),
+            HedgingDelay(delays, "Service.List", Idempotency::kIdempotent));
+}
+
+TEST(HedgedCallTest, Disabled) {
+  AutomaticallyCreatedBackgroundThreads background;
+  std::atomic<int> calls{0};
+  auto functor = [&calls](grpc::ClientContext&, int request) {
+    ++calls;
+    return StatusOr<int>(request);
+  };
+  auto hedged = MakeHedgedFunctor(background.cq(), milliseconds(0), functor);
+  grpc::ClientContext context;
+  auto result = hedged(context, 42);
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(42, *result);
+  EXPECT_EQ(1, calls.load());
+}
+
+TEST(HedgedCallTest, PrimaryWins) {
+  AutomaticallyCreatedBackgroundThreads background;
+  std::atomic<int> calls{0};
+  auto functor = [&calls](grpc::ClientContext&, int request) {
+    ++calls;
+    return StatusOr<int>(request);
+  };
+  auto hedged = MakeHedgedFunctor(background.cq(), std::chrono::hours(1),
+                                  std::move(functor));
+  grpc::ClientContext context;
+  auto result = hedged(context, 42);
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(42, *result);
+  EXPECT_EQ(1, calls.load());
+}
+
+TEST(HedgedCallTest, HedgeWins) {
+  AutomaticallyCreatedBackgroundThreads background;
+  // The first call blocks until the second (hedged) call completes, and then
+  // some more, simulating an RPC that returns slowly after it is cancelled.
+  promise<void> hedge_done;
+  auto blocked = hedge_done.get_future();
+  std::atomic<int> calls{0};
+  auto functor = [&](grpc::ClientContext&, int request) {
+    if (++calls == 1) {
+      blocked.get();
+      std::this_thread::sleep_for(milliseconds(100));
+      return StatusOr<int>(Status(StatusCode::kCancelled, "cancelled"));
+    }
+    hedge_done.set_value();
+    return StatusOr<int>(2 * request);
+  };
+  grpc::ClientContext context;
+  auto result =
+      HedgedCall(background.cq(), milliseconds(1), functor, context, 21);
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(42, *result);
+  EXPECT_EQ(2, calls.load());
+}
+
+TEST(HedgedCallTest, HedgeFailureIgnored) {
+  AutomaticallyCreatedBackgroundThreads background;
+  promise<void> hedge_done;
+  auto blocked = hedge_done.get_future();
+  std::atomic<int> calls{0};
+  auto functor = [&](grpc::ClientContext&, int request) {
+    if (++calls == 1) {
+      blocked.get();
+      return StatusOr<int>(request);
+    }
+    hedge_done.set_value();
+    return StatusOr<int>(Status(StatusCode::kUnavailable, "try-again"));
+  };
+  grpc::ClientContext context;
+  auto result =
+      HedgedCall(background.cq(), milliseconds(1), functor, context, 42);
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(42, *result);
+  EXPECT_EQ(2, calls.load());
+}
+
+TEST(HedgedCallTest, PrimaryFailureReturned) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto functor = [](grpc::ClientContext&, int) {
+    return Status(StatusCode::kPermissionDenied, "uh-oh");
+  };
+  grpc::ClientContext context;
+  auto status =
+      HedgedCall(background.cq(), std::chrono::hours(1), functor, context, 42);
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,65 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/iam_read_modify_write.h"
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+StatusOr<google::iam::v1::Policy> IamReadModifyWrite(
+    absl::FunctionRef<StatusOr<google::iam::v1::Policy>()> get,
+    absl::FunctionRef<
+        StatusOr<google::iam::v1::Policy>(google::iam::v1::Policy)>
+        set,
+    absl::FunctionRef<bool(google::iam::v1::Policy&)> update,
+    RetryPolicy& rerun_policy, BackoffPolicy& backoff_policy) {
+  Status last_status;
+  do {
+    auto policy = get();
+    if (!policy) {
+      last_status = std::move(policy).status();
+    } else {
+      if (!update(*policy)) return policy;
+      auto result = set(*std::move(policy));
+      if (result) return result;
+      last_status = std::move(result).status();
+    }
+    if (!rerun_policy.OnFailure(last_status)) break;
+    std::this_thread::sleep_for(backoff_policy.OnCompletion());
+  } while (!rerun_policy.IsExhausted());
+  return last_status;
+}
+
+StatusOr<google::iam::v1::Policy> IamReadModifyWrite(
+    absl::FunctionRef<StatusOr<google::iam::v1::Policy>()> get,
+    absl::FunctionRef<
+        StatusOr<google::iam::v1::Policy>(google::iam::v1::Policy)>
+        set,
+    IamPolicyDelta const& delta, RetryPolicy& rerun_policy,
+    BackoffPolicy& backoff_policy) {
+  return IamReadModifyWrite(
+      get, set,
+      [&delta](google::iam::v1::Policy& policy) {
+        return delta.ApplyTo(policy);
+      },
+      rerun_policy, backoff_policy);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,68 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_IAM_READ_MODIFY_WRITE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_IAM_READ_MODIFY_WRITE_H
+
+#include "google/cloud/iam_policy_delta.h"
+#include "google/cloud/internal/backoff_policy.h"
+#include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/functional/function_ref.h"
+#include <google/iam/v1/policy.pb.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Updates an IAM policy using optimistic concurrency control.
+ *
+ * Reads the current policy with @p get, modifies it in place with @p update,
+ * and writes it back with @p set. The policy `etag` is preserved, so the
+ * write fails (typically with `kAborted`) if the policy changed after it was
+ * read. In that case, or if either request fails, the loop backs off and
+ * starts over with a fresh copy of the policy, until @p rerun_policy is
+ * exhausted.
+ *
+ * The policy is moved, never copied, between the three steps.
+ *
+ * @param update modifies the policy, and returns false if no change is needed,
+ *     in which case the current policy is returned without writing it.
+ */
+StatusOr<google::iam::v1::Policy> IamReadModifyWrite(
+    absl::FunctionRef<StatusOr<google::iam::v1::Policy>()> get,
+    absl::FunctionRef<
+        StatusOr<google::iam::v1::Policy>(google::iam::v1::Policy)>
+        set,
+    absl::FunctionRef<bool(google::iam::v1::Policy&)> update,
+    RetryPolicy& rerun_policy, BackoffPolicy& backoff_policy);
+
+/// Applies @p delta with `IamReadModifyWrite()`.
+StatusOr<google::iam::v1::Policy> IamReadModifyWrite(
+    absl::FunctionRef<StatusOr<google::iam::v1::Policy>()> get,
+    absl::FunctionRef<
+        StatusOr<google::iam::v1::Policy>(google::iam::v1::Policy)>
+        set,
+    IamPolicyDelta const& delta, RetryPolicy& rerun_policy,
+    BackoffPolicy& backoff_policy);
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_IAM_READ_MODIFY_WRITE_H
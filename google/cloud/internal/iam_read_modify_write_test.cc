@@ -0,0 +1,164 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/iam_read_modify_write.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+struct TestRerunTraits {
+  static bool IsPermanentFailure(Status const& s) {
+    return !s.ok() && s.code() != StatusCode::kAborted &&
+           s.code() != StatusCode::kUnavailable;
+  }
+};
+
+LimitedErrorCountRetryPolicy<TestRerunTraits> TestRerunPolicy() {
+  return LimitedErrorCountRetryPolicy<TestRerunTraits>(3);
+}
+
+ExponentialBackoffPolicy TestBackoffPolicy() {
+  return ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                  std::chrono::microseconds(5), 2.0);
+}
+
+/// A fake service, returning `kAborted` if the etag does not match.
+struct FakeService {
+  google::iam::v1::Policy policy;
+  int version = 0;
+  int get_calls = 0;
+  int set_calls = 0;
+  // Simulates a concurrent update after each of the first N reads.
+  int concurrent_updates = 0;
+
+  StatusOr<google::iam::v1::Policy> Get() {
+    ++get_calls;
+    policy.set_etag("v" + std::to_string(version));
+    auto result = policy;
+    if (concurrent_updates > 0) {
+      --concurrent_updates;
+      ++version;
+    }
+    return result;
+  }
+
+  StatusOr<google::iam::v1::Policy> Set(google::iam::v1::Policy p) {
+    ++set_calls;
+    if (p.etag() != "v" + std::to_string(version)) {
+      return Status(StatusCode::kAborted, "etag mismatch");
+    }
+    ++version;
+    policy = std::move(p);
+    policy.set_etag("v" + std::to_string(version));
+    return policy;
+  }
+};
+
+TEST(IamReadModifyWrite, Success) {
+  FakeService service;
+  auto rerun = TestRerunPolicy();
+  auto backoff = TestBackoffPolicy();
+  auto const delta = IamPolicyDelta().AddMember("roles/viewer", "user:a");
+  auto result = IamReadModifyWrite(
+      [&service] { return service.Get(); },
+      [&service](google::iam::v1::Policy p) {
+        return service.Set(std::move(p));
+      },
+      delta, rerun, backoff);
+  ASSERT_STATUS_OK(result);
+  ASSERT_EQ(1, result->bindings_size());
+  EXPECT_THAT(result->bindings(0).members(), ElementsAre("user:a"));
+  EXPECT_EQ(1, service.get_calls);
+  EXPECT_EQ(1, service.set_calls);
+}
+
+TEST(IamReadModifyWrite, NoChange) {
+  FakeService service;
+  auto rerun = TestRerunPolicy();
+  auto backoff = TestBackoffPolicy();
+  auto result = IamReadModifyWrite(
+      [&service] { return service.Get(); },
+      [&service](google::iam::v1::Policy p) {
+        return service.Set(std::move(p));
+      },
+      IamPolicyDelta(), rerun, backoff);
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(1, service.get_calls);
+  EXPECT_EQ(0, service.set_calls);
+}
+
+TEST(IamReadModifyWrite, RetryOnConflict) {
+  FakeService service;
+  service.concurrent_updates = 2;
+  auto rerun = TestRerunPolicy();
+  auto backoff = TestBackoffPolicy();
+  auto const delta = IamPolicyDelta().AddMember("roles/viewer", "user:a");
+  auto result = IamReadModifyWrite(
+      [&service] { return service.Get(); },
+      [&service](google::iam::v1::Policy p) {
+        return service.Set(std::move(p));
+      },
+      delta, rerun, backoff);
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(3, service.get_calls);
+  EXPECT_EQ(3, service.set_calls);
+}
+
+TEST(IamReadModifyWrite, TooManyConflicts) {
+  FakeService service;
+  service.concurrent_updates = 10;
+  auto rerun = TestRerunPolicy();
+  auto backoff = TestBackoffPolicy();
+  auto const delta = IamPolicyDelta().AddMember("roles/viewer", "user:a");
+  auto result = IamReadModifyWrite(
+      [&service] { return service.Get(); },
+      [&service](google::iam::v1::Policy p) {
+        return service.Set(std::move(p));
+      },
+      delta, rerun, backoff);
+  EXPECT_THAT(result, StatusIs(StatusCode::kAborted));
+  EXPECT_EQ(4, service.get_calls);
+}
+
+TEST(IamReadModifyWrite, PermanentGetFailure) {
+  int set_calls = 0;
+  auto rerun = TestRerunPolicy();
+  auto backoff = TestBackoffPolicy();
+  auto result = IamReadModifyWrite(
+      [] {
+        return StatusOr<google::iam::v1::Policy>(
+            Status(StatusCode::kPermissionDenied, "uh-oh"));
+      },
+      [&set_calls](google::iam::v1::Policy p) {
+        ++set_calls;
+        return StatusOr<google::iam::v1::Policy>(std::move(p));
+      },
+      [](google::iam::v1::Policy&) { return true; }, rerun, backoff);
+  EXPECT_THAT(result, StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_EQ(0, set_calls);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
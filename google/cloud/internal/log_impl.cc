@@ -14,6 +14,7 @@
 
 #include "google/cloud/internal/log_impl.h"
 #include "google/cloud/internal/getenv.h"
+#include <unordered_map>
 
 namespace google {
 namespace cloud {
@@ -53,6 +54,205 @@ void CircularBufferBackend::FlushImpl(std::unique_lock<std::mutex> /*lk*/) {
   backend_->Flush();
 }
 
+namespace {
+
+// The writer thread wakes up at least this often, even if no thread notifies
+// it. Threads only notify the writer when they need it to make progress.
+auto constexpr kAsyncBackendPollPeriod = std::chrono::milliseconds(10);
+
+std::uint64_t NextAsyncBackendId() {
+  static std::atomic<std::uint64_t> generator{0};
+  return ++generator;
+}
+
+}  // namespace
+
+/**
+ * A single-producer, single-consumer ring buffer.
+ *
+ * Only the thread that owns the ring pushes records, and only the writer
+ * thread pops them.
+ */
+class AsyncBackend::Ring {
+ public:
+  explicit Ring(std::size_t size) : buffer_(size) {}
+
+  bool TryPush(LogRecord& lr) {
+    auto const tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == buffer_.size()) {
+      return false;
+    }
+    buffer_[tail % buffer_.size()] = std::move(lr);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(LogRecord& lr) {
+    auto const head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    lr = std::move(buffer_[head % buffer_.size()]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool full() const {
+    return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire) ==
+           buffer_.size();
+  }
+
+  /// Set once the backend that owns this ring is deleted.
+  void orphan() { orphaned_.store(true, std::memory_order_relaxed); }
+  bool orphaned() const { return orphaned_.load(std::memory_order_relaxed); }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::vector<LogRecord> buffer_;
+  std::atomic<std::size_t> head_{0};
+  std::atomic<std::size_t> tail_{0};
+  std::atomic<bool> orphaned_{false};
+};
+
+AsyncBackend::AsyncBackend(std::size_t buffer_size, OverflowPolicy policy,
+                           Severity min_flush_severity,
+                           std::shared_ptr<LogBackend> backend)
+    : buffer_size_((std::max)(std::size_t{1}, buffer_size)),
+      policy_(policy),
+      min_flush_severity_(min_flush_severity),
+      backend_(std::move(backend)),
+      id_(NextAsyncBackendId()) {
+  writer_ = std::thread([this] { WriterLoop(); });
+}
+
+AsyncBackend::~AsyncBackend() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  writer_cv_.notify_one();
+  space_cv_.notify_all();
+  writer_.join();
+  for (auto& r : rings_) r->orphan();
+}
+
+void AsyncBackend::ProcessWithOwnership(LogRecord lr) {
+  // Avoid deadlocks if the backend logs from the writer thread.
+  if (std::this_thread::get_id() == writer_.get_id()) {
+    backend_->ProcessWithOwnership(std::move(lr));
+    return;
+  }
+  auto const needs_flush = lr.severity >= min_flush_severity_;
+  auto ring = ThreadRing();
+  while (!ring->TryPush(lr)) {
+    if (policy_ == OverflowPolicy::kDropNewest) {
+      ++dropped_;
+      return;
+    }
+    // The writer notifies `space_cv_` while holding `mu_` after it drains a
+    // ring, checking `full()` under the same lock cannot miss that.
+    std::unique_lock<std::mutex> lk(mu_);
+    ++blocked_;
+    writer_cv_.notify_one();
+    space_cv_.wait(lk, [&] { return !ring->full() || shutdown_; });
+    --blocked_;
+    if (shutdown_ && ring->full()) {
+      ++dropped_;
+      return;
+    }
+  }
+  if (needs_flush) Flush();
+}
+
+void AsyncBackend::Flush() {
+  if (std::this_thread::get_id() == writer_.get_id()) {
+    backend_->Flush();
+    return;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const target = ++flush_requested_;
+  writer_cv_.notify_one();
+  flush_cv_.wait(lk, [&] { return flush_completed_ >= target || shutdown_; });
+}
+
+std::shared_ptr<AsyncBackend::Ring> AsyncBackend::ThreadRing() {
+  // Each thread keeps the rings for all the backends it has used. The ring
+  // outlives the thread until the writer drains it.
+  thread_local std::unordered_map<std::uint64_t, std::shared_ptr<Ring>> rings;
+  auto loc = rings.find(id_);
+  if (loc != rings.end()) return loc->second;
+  // Release the rings of any deleted backends before adding a new one.
+  for (auto i = rings.begin(); i != rings.end();) {
+    i = i->second->orphaned() ? rings.erase(i) : std::next(i);
+  }
+  auto ring = std::make_shared<Ring>(buffer_size_);
+  rings.emplace(id_, ring);
+  std::lock_guard<std::mutex> lk(mu_);
+  rings_.push_back(ring);
+  return ring;
+}
+
+void AsyncBackend::WriterLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    auto const requested = flush_requested_;
+    auto const shutdown = shutdown_;
+    auto rings = rings_;
+    lk.unlock();
+    auto const progress = Drain(rings);
+    ReportDropped();
+    if (requested != flush_completed_ || shutdown) backend_->Flush();
+    rings.clear();
+    lk.lock();
+    // Forget the rings of threads that have exited, once they are empty.
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](std::shared_ptr<Ring> const& r) {
+                                  return r.use_count() == 1 && r->empty();
+                                }),
+                 rings_.end());
+    if (requested != flush_completed_) {
+      flush_completed_ = requested;
+      flush_cv_.notify_all();
+    }
+    if (shutdown && !progress) break;
+    if (progress || flush_requested_ != requested || shutdown_) continue;
+    writer_cv_.wait_for(lk, kAsyncBackendPollPeriod);
+  }
+  flush_cv_.notify_all();
+}
+
+bool AsyncBackend::Drain(std::vector<std::shared_ptr<Ring>> const& rings) {
+  bool progress = false;
+  LogRecord lr;
+  for (auto const& r : rings) {
+    bool drained = false;
+    while (r->TryPop(lr)) {
+      drained = true;
+      backend_->ProcessWithOwnership(std::move(lr));
+    }
+    if (!drained) continue;
+    progress = true;
+    std::lock_guard<std::mutex> lk(mu_);
+    if (blocked_ != 0) space_cv_.notify_all();
+  }
+  return progress;
+}
+
+void AsyncBackend::ReportDropped() {
+  auto const dropped = dropped_.load();
+  if (dropped == reported_dropped_) return;
+  auto const count = dropped - reported_dropped_;
+  reported_dropped_ = dropped;
+  backend_->ProcessWithOwnership(LogRecord{
+      Severity::GCP_LS_WARNING, __func__, __FILE__, __LINE__,
+      std::this_thread::get_id(), std::chrono::system_clock::now(),
+      "AsyncBackend dropped " + std::to_string(count) +
+          " log records, the ring buffers are full"});
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
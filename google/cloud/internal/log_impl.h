@@ -18,6 +18,13 @@
 #include "google/cloud/log.h"
 #include "google/cloud/version.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace google {
@@ -72,6 +79,75 @@ class CircularBufferBackend : public LogBackend {
   std::shared_ptr<LogBackend> backend_;
 };
 
+/**
+ * A backend that writes log records from a dedicated thread.
+ *
+ * Each thread that logs through this backend gets its own fixed-size ring
+ * buffer. `ProcessWithOwnership()` moves the record into the calling thread's
+ * ring without taking any locks, and a writer thread moves the records from
+ * all the rings to @p backend. This keeps slow backends, such as
+ * `StdClogBackend`, off the critical path of the threads that log.
+ *
+ * If a ring is full the record is discarded, and the writer periodically logs
+ * the number of discarded records, or (with `OverflowPolicy::kBlock`) the
+ * calling thread waits for the writer to make space. Records at or above
+ * @p min_flush_severity are written before `ProcessWithOwnership()` returns,
+ * so messages logged immediately before a crash, including `GCP_LOG(FATAL)`,
+ * are not lost.
+ *
+ * Records from different threads are not guaranteed to reach @p backend in
+ * timestamp order.
+ */
+class AsyncBackend : public LogBackend {
+ public:
+  enum class OverflowPolicy { kDropNewest, kBlock };
+
+  AsyncBackend(std::size_t buffer_size, OverflowPolicy policy,
+               Severity min_flush_severity,
+               std::shared_ptr<LogBackend> backend);
+  ~AsyncBackend() override;
+
+  std::size_t buffer_size() const { return buffer_size_; }
+  OverflowPolicy policy() const { return policy_; }
+  Severity min_flush_severity() const { return min_flush_severity_; }
+  std::shared_ptr<LogBackend> backend() const { return backend_; }
+  /// The total number of records discarded because a ring was full.
+  std::uint64_t dropped_count() const { return dropped_.load(); }
+
+  void Process(LogRecord const& lr) override { ProcessWithOwnership(lr); }
+  void ProcessWithOwnership(LogRecord lr) override;
+  /// Block until all the records logged so far are written to the backend.
+  void Flush() override;
+
+ private:
+  class Ring;
+
+  std::shared_ptr<Ring> ThreadRing();
+  void WriterLoop();
+  bool Drain(std::vector<std::shared_ptr<Ring>> const& rings);
+  void ReportDropped();
+
+  std::size_t const buffer_size_;
+  OverflowPolicy const policy_;
+  Severity const min_flush_severity_;
+  std::shared_ptr<LogBackend> const backend_;
+  std::uint64_t const id_;
+
+  std::atomic<std::uint64_t> dropped_{0};
+  std::uint64_t reported_dropped_ = 0;  // only used by the writer thread
+
+  std::mutex mu_;
+  std::condition_variable writer_cv_;
+  std::condition_variable flush_cv_;
+  std::condition_variable space_cv_;
+  std::vector<std::shared_ptr<Ring>> rings_;  // GUARDED_BY(mu_)
+  std::uint64_t flush_requested_ = 0;         // GUARDED_BY(mu_)
+  std::uint64_t flush_completed_ = 0;         // GUARDED_BY(mu_)
+  std::size_t blocked_ = 0;                   // GUARDED_BY(mu_)
+  bool shutdown_ = false;                     // GUARDED_BY(mu_)
+  std::thread writer_;
+};
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
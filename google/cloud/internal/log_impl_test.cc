@@ -16,6 +16,12 @@
 #include "google/cloud/testing_util/scoped_environment.h"
 #include "google/cloud/testing_util/scoped_log.h"
 #include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -25,7 +31,9 @@ namespace {
 
 using ::google::cloud::testing_util::ScopedEnvironment;
 using ::google::cloud::testing_util::ScopedLog;
+using ::testing::Contains;
 using ::testing::ElementsAre;
+using ::testing::HasSubstr;
 using ::testing::IsEmpty;
 using ::testing::NotNull;
 
@@ -61,6 +69,158 @@ TEST(CircularBufferBackend, Basic) {
   EXPECT_THAT(be->ExtractLines(), ElementsAre("msg 9", "msg 10"));
 }
 
+LogRecord TestLogRecord(Severity severity, std::string msg) {
+  return LogRecord{severity, "test_function()", "file", 1,
+                   std::this_thread::get_id(), {}, std::move(msg)};
+}
+
+TEST(AsyncBackend, Basic) {
+  auto be = std::make_shared<ScopedLog::Backend>();
+  AsyncBackend async(16, AsyncBackend::OverflowPolicy::kBlock,
+                     Severity::GCP_LS_FATAL, be);
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_INFO, "msg 1"));
+  async.Process(TestLogRecord(Severity::GCP_LS_INFO, "msg 2"));
+  async.Flush();
+  EXPECT_THAT(be->ExtractLines(), ElementsAre("msg 1", "msg 2"));
+  EXPECT_EQ(0, async.dropped_count());
+}
+
+TEST(AsyncBackend, FlushOnSeverity) {
+  auto be = std::make_shared<ScopedLog::Backend>();
+  AsyncBackend async(16, AsyncBackend::OverflowPolicy::kDropNewest,
+                     Severity::GCP_LS_ERROR, be);
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_INFO, "msg 1"));
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_ERROR, "msg 2"));
+  // No explicit Flush(), the ERROR record must be written on return.
+  EXPECT_THAT(be->ExtractLines(), ElementsAre("msg 1", "msg 2"));
+}
+
+TEST(AsyncBackend, ManyThreads) {
+  auto constexpr kThreads = 8;
+  auto constexpr kRecords = 1000;
+  auto be = std::make_shared<ScopedLog::Backend>();
+  {
+    AsyncBackend async(8, AsyncBackend::OverflowPolicy::kBlock,
+                       Severity::GCP_LS_FATAL, be);
+    std::vector<std::thread> threads(kThreads);
+    for (auto& t : threads) {
+      t = std::thread([&async] {
+        for (int i = 0; i != kRecords; ++i) {
+          async.ProcessWithOwnership(
+              TestLogRecord(Severity::GCP_LS_INFO, std::to_string(i)));
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(0, async.dropped_count());
+  }
+  // The destructor drains any pending records.
+  EXPECT_EQ(kThreads * kRecords, be->ExtractLines().size());
+}
+
+/// A backend that blocks until released, to fill the AsyncBackend rings.
+class BlockingBackend : public LogBackend {
+ public:
+  void Process(LogRecord const& lr) override {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return released_; });
+    messages_.push_back(lr.message);
+  }
+  void ProcessWithOwnership(LogRecord lr) override { Process(lr); }
+
+  void Release() {
+    std::lock_guard<std::mutex> lk(mu_);
+    released_ = true;
+    cv_.notify_all();
+  }
+  std::vector<std::string> messages() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return messages_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool released_ = false;
+  std::vector<std::string> messages_;
+};
+
+TEST(AsyncBackend, DropNewest) {
+  auto be = std::make_shared<BlockingBackend>();
+  {
+    AsyncBackend async(4, AsyncBackend::OverflowPolicy::kDropNewest,
+                       Severity::GCP_LS_FATAL, be);
+    // The writer blocks on (at most) one record, the ring holds 4 more, any
+    // other records must be dropped.
+    for (int i = 0; i != 100; ++i) {
+      async.ProcessWithOwnership(
+          TestLogRecord(Severity::GCP_LS_INFO, std::to_string(i)));
+    }
+    EXPECT_LE(95, async.dropped_count());
+    be->Release();
+    async.Flush();
+  }
+  EXPECT_THAT(be->messages(),
+              Contains(HasSubstr("log records, the ring buffers are full")));
+}
+
+TEST(AsyncBackend, BlockWaitsForSpace) {
+  auto constexpr kRecords = 100;
+  auto be = std::make_shared<BlockingBackend>();
+  {
+    AsyncBackend async(4, AsyncBackend::OverflowPolicy::kBlock,
+                       Severity::GCP_LS_FATAL, be);
+    std::atomic<bool> done{false};
+    std::thread producer([&async, &done] {
+      for (int i = 0; i != kRecords; ++i) {
+        async.ProcessWithOwnership(
+            TestLogRecord(Severity::GCP_LS_INFO, std::to_string(i)));
+      }
+      done = true;
+    });
+    // The writer blocks on the first record, once the ring is full the
+    // producer must wait for space instead of discarding records.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(done.load());
+    be->Release();
+    producer.join();
+    EXPECT_EQ(0, async.dropped_count());
+    async.Flush();
+  }
+  EXPECT_EQ(kRecords, be->messages().size());
+}
+
+TEST(DefaultLogBackend, Async) {
+  ScopedEnvironment config(kLogConfig, "async,128,block");
+  ScopedEnvironment clog(kEnableClog, absl::nullopt);
+  auto be = DefaultLogBackend();
+  auto const* async = dynamic_cast<AsyncBackend*>(be.get());
+  ASSERT_THAT(async, NotNull());
+  EXPECT_EQ(128, async->buffer_size());
+  EXPECT_EQ(AsyncBackend::OverflowPolicy::kBlock, async->policy());
+  auto const* clog_be = dynamic_cast<StdClogBackend*>(async->backend().get());
+  ASSERT_THAT(clog_be, NotNull());
+  EXPECT_EQ(Severity::GCP_LS_DEBUG, clog_be->min_severity());
+}
+
+TEST(DefaultLogBackend, AsyncDefaultPolicy) {
+  ScopedEnvironment config(kLogConfig, "async,64");
+  ScopedEnvironment clog(kEnableClog, absl::nullopt);
+  auto be = DefaultLogBackend();
+  auto const* async = dynamic_cast<AsyncBackend*>(be.get());
+  ASSERT_THAT(async, NotNull());
+  EXPECT_EQ(AsyncBackend::OverflowPolicy::kDropNewest, async->policy());
+}
+
+TEST(DefaultLogBackend, AsyncInvalidPolicy) {
+  ScopedEnvironment config(kLogConfig, "async,64,invalid");
+  ScopedEnvironment clog(kEnableClog, absl::nullopt);
+  auto be = DefaultLogBackend();
+  auto const* clog_be = dynamic_cast<StdClogBackend*>(be.get());
+  ASSERT_THAT(clog_be, NotNull());
+  EXPECT_EQ(Severity::GCP_LS_FATAL, clog_be->min_severity());
+}
+
 TEST(DefaultLogBackend, CircularBuffer) {
   ScopedEnvironment config(kLogConfig, "lastN,5,WARNING");
   ScopedEnvironment clog(kEnableClog, absl::nullopt);
@@ -123,6 +123,22 @@ Result LogWrapper(Functor&& functor,
   return response;
 }
 
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext>, Request const&>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
+                  std::unique_ptr<grpc::ClientContext> context,
+                  Request const& request, char const* where,
+                  TracingOptions const& options) {
+  GCP_LOG(DEBUG) << where << "() << " << DebugString(request, options);
+  auto response = functor(cq, std::move(context), request);
+  GCP_LOG(DEBUG) << where << "() >> " << (response ? "not null" : "null")
+                 << " stream";
+  return response;
+}
+
 template <
     typename Functor, typename Request,
     typename Result = google::cloud::internal::invoke_result_t<
@@ -15,6 +15,7 @@
 #include "google/cloud/internal/log_wrapper.h"
 #include "google/cloud/testing_util/scoped_log.h"
 #include "google/cloud/tracing_options.h"
+#include "absl/memory/memory.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <google/protobuf/text_format.h>
 #include <google/spanner/v1/mutation.pb.h>
@@ -334,6 +335,27 @@ TEST(LogWrapper, UniquePointerClientReaderInterface) {
               Contains(AllOf(HasSubstr("in-test("), HasSubstr(" << "))));
 }
 
+/// @test the overload for functions returning asynchronous streams
+TEST(LogWrapper, UniquePointerWithContextAndCQ) {
+  auto mock = [](google::cloud::CompletionQueue&,
+                 std::unique_ptr<grpc::ClientContext>,
+                 btproto::ReadRowsRequest const&) {
+    return absl::make_unique<btproto::ReadRowsResponse>();
+  };
+
+  testing_util::ScopedLog log;
+  CompletionQueue cq;
+  btproto::ReadRowsRequest request;
+  LogWrapper(mock, cq, absl::make_unique<grpc::ClientContext>(), request,
+             "in-test", {});
+
+  auto const log_lines = log.ExtractLines();
+  EXPECT_THAT(log_lines,
+              Contains(AllOf(HasSubstr("in-test("), HasSubstr(" << "))));
+  EXPECT_THAT(log_lines,
+              Contains(AllOf(HasSubstr("in-test("), HasSubstr("not null"))));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
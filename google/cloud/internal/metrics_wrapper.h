@@ -0,0 +1,238 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_WRAPPER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_WRAPPER_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/log_wrapper.h"
+#include "google/cloud/rpc_metrics.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <google/protobuf/message.h>
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Records the client resources used while this object is in scope.
+ *
+ * The metrics wrappers create one of these objects around each call. When the
+ * `RpcMetrics` were created without resource accounting this only tests a
+ * pointer.
+ */
+class MetricsResourceScope {
+ public:
+  explicit MetricsResourceScope(RpcMethodMetrics& metrics)
+      : metrics_(metrics), accounting_(metrics.resource_accounting()) {
+    if (accounting_ == nullptr) return;
+    if (accounting_->allocation_counter) {
+      allocations_ = accounting_->allocation_counter->Count();
+    }
+    cpu_time_ = ThreadCpuTime();
+  }
+
+  ~MetricsResourceScope() {
+    if (accounting_ == nullptr) return;
+    auto const cpu_time = ThreadCpuTime() - cpu_time_;
+    auto allocations = std::int64_t{0};
+    if (accounting_->allocation_counter) {
+      allocations = accounting_->allocation_counter->Count() - allocations_;
+    }
+    metrics_.RecordResources(cpu_time, allocations);
+  }
+
+  MetricsResourceScope(MetricsResourceScope const&) = delete;
+  MetricsResourceScope& operator=(MetricsResourceScope const&) = delete;
+
+ private:
+  RpcMethodMetrics& metrics_;
+  RpcResourceAccounting const* accounting_;
+  std::chrono::nanoseconds cpu_time_{0};
+  std::int64_t allocations_ = 0;
+};
+
+/// Records the bytes sent and the retries for a call that is starting.
+inline std::chrono::steady_clock::time_point MetricsStartCall(
+    RpcMethodMetrics& metrics, google::protobuf::Message const& request) {
+  if (CurrentRetryAttempt() != 0) metrics.RecordRetry();
+  metrics.RecordBytesSent(static_cast<std::uint64_t>(request.ByteSizeLong()));
+  return std::chrono::steady_clock::now();
+}
+
+inline void MetricsEndCall(RpcMethodMetrics& metrics,
+                           std::chrono::steady_clock::time_point start,
+                           Status const& response) {
+  metrics.RecordCall(std::chrono::steady_clock::now() - start, response);
+}
+
+template <typename T>
+void MetricsEndCall(RpcMethodMetrics& metrics,
+                    std::chrono::steady_clock::time_point start,
+                    StatusOr<T> const& response) {
+  if (response) {
+    metrics.RecordBytesReceived(
+        static_cast<std::uint64_t>(response->ByteSizeLong()));
+  }
+  MetricsEndCall(metrics, start, response.status());
+}
+
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, grpc::ClientContext&, Request const&>,
+          typename std::enable_if<
+              std::is_same<Result, google::cloud::Status>::value ||
+                  IsStatusOr<Result>::value,
+              int>::type = 0>
+Result MetricsWrapper(Functor&& functor, grpc::ClientContext& context,
+                      Request const& request, RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  auto const start = MetricsStartCall(metrics, request);
+  auto response = functor(context, request);
+  MetricsEndCall(metrics, start, response);
+  return response;
+}
+
+/**
+ * Records the metrics for a call that starts a stream.
+ *
+ * Only the request and the time to create the stream are recorded, the
+ * messages received through the stream are not counted.
+ */
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, grpc::ClientContext&, Request const&>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result MetricsWrapper(Functor&& functor, grpc::ClientContext& context,
+                      Request const& request, RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  auto const start = MetricsStartCall(metrics, request);
+  auto response = functor(context, request);
+  MetricsEndCall(metrics, start, Status{});
+  return response;
+}
+
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, std::unique_ptr<grpc::ClientContext>, Request const&>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result MetricsWrapper(Functor&& functor,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      Request const& request, RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  auto const start = MetricsStartCall(metrics, request);
+  auto response = functor(std::move(context), request);
+  MetricsEndCall(metrics, start, Status{});
+  return response;
+}
+
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext>, Request const&>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result MetricsWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      Request const& request, RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  auto const start = MetricsStartCall(metrics, request);
+  auto response = functor(cq, std::move(context), request);
+  MetricsEndCall(metrics, start, Status{});
+  return response;
+}
+
+/**
+ * Records the metrics for a call that starts a client streaming RPC.
+ *
+ * The requests are written after the stream starts, so only the time to
+ * create the stream is recorded.
+ */
+template <typename Functor,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, std::unique_ptr<grpc::ClientContext>>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result MetricsWrapper(Functor&& functor,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  if (CurrentRetryAttempt() != 0) metrics.RecordRetry();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = functor(std::move(context));
+  MetricsEndCall(metrics, start, Status{});
+  return response;
+}
+
+/**
+ * Records the metrics for a call that starts a bidirectional stream.
+ *
+ * The requests are written after the stream starts, so only the time to
+ * create the stream is recorded.
+ */
+template <typename Functor,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext>>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result MetricsWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  if (CurrentRetryAttempt() != 0) metrics.RecordRetry();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = functor(cq, std::move(context));
+  MetricsEndCall(metrics, start, Status{});
+  return response;
+}
+
+/**
+ * Records the metrics for an asynchronous call.
+ *
+ * The resource accounting only includes the work to start the call, the
+ * response is processed in a different thread.
+ */
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext>, Request const&>,
+          typename std::enable_if<IsFutureStatusOr<Result>::value ||
+                                      IsFutureStatus<Result>::value,
+                                  int>::type = 0>
+Result MetricsWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      Request const& request, RpcMethodMetrics& metrics) {
+  MetricsResourceScope scope(metrics);
+  auto const start = MetricsStartCall(metrics, request);
+  auto* m = &metrics;
+  return functor(cq, std::move(context), request)
+      .then([m, start](Result f) {
+        auto response = f.get();
+        MetricsEndCall(*m, start, response);
+        return response;
+      });
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_WRAPPER_H
@@ -0,0 +1,233 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/metrics_wrapper.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/wrappers.pb.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::google::protobuf::StringValue;
+
+StringValue MakeRequest() {
+  StringValue request;
+  request.set_value("test-request-value");
+  return request;
+}
+
+StringValue MakeResponse() {
+  StringValue response;
+  response.set_value("test-response-value-longer");
+  return response;
+}
+
+TEST(MetricsWrapper, StatusOrSuccess) {
+  RpcMethodMetrics metrics;
+  grpc::ClientContext context;
+  auto const request = MakeRequest();
+  auto functor = [](grpc::ClientContext&, StringValue const&) {
+    return make_status_or(MakeResponse());
+  };
+  auto response = MetricsWrapper(functor, context, request, metrics);
+  ASSERT_STATUS_OK(response);
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(0, s.errors);
+  EXPECT_EQ(0, s.retries);
+  EXPECT_EQ(request.ByteSizeLong(), s.bytes_sent);
+  EXPECT_EQ(response->ByteSizeLong(), s.bytes_received);
+}
+
+TEST(MetricsWrapper, StatusOrError) {
+  RpcMethodMetrics metrics;
+  grpc::ClientContext context;
+  auto functor = [](grpc::ClientContext&, StringValue const&) {
+    return StatusOr<StringValue>(Status(StatusCode::kUnavailable, "uh-oh"));
+  };
+  auto response = MetricsWrapper(functor, context, MakeRequest(), metrics);
+  EXPECT_THAT(response, StatusIs(StatusCode::kUnavailable));
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(1, s.errors);
+  EXPECT_EQ(0, s.bytes_received);
+}
+
+TEST(MetricsWrapper, StatusWithRetry) {
+  RpcMethodMetrics metrics;
+  auto functor = [](grpc::ClientContext&, StringValue const&) {
+    return Status{};
+  };
+  for (int attempt = 0; attempt != 3; ++attempt) {
+    RetryAttemptScope scope(attempt);
+    grpc::ClientContext context;
+    auto status = MetricsWrapper(functor, context, MakeRequest(), metrics);
+    EXPECT_STATUS_OK(status);
+  }
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(3, s.calls);
+  EXPECT_EQ(2, s.retries);
+}
+
+TEST(MetricsWrapper, Stream) {
+  struct Stream {};
+  RpcMethodMetrics metrics;
+  grpc::ClientContext context;
+  auto const request = MakeRequest();
+  auto functor = [](grpc::ClientContext&, StringValue const&) {
+    return std::unique_ptr<Stream>(new Stream);
+  };
+  auto stream = MetricsWrapper(functor, context, request, metrics);
+  EXPECT_NE(nullptr, stream);
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(request.ByteSizeLong(), s.bytes_sent);
+}
+
+TEST(MetricsWrapper, AsyncStream) {
+  struct Stream {};
+  RpcMethodMetrics metrics;
+  CompletionQueue cq;
+  auto const request = MakeRequest();
+  auto functor = [](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                    StringValue const&) {
+    return std::unique_ptr<Stream>(new Stream);
+  };
+  auto stream = MetricsWrapper(
+      functor, cq, absl::make_unique<grpc::ClientContext>(), request, metrics);
+  EXPECT_NE(nullptr, stream);
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(request.ByteSizeLong(), s.bytes_sent);
+}
+
+TEST(MetricsWrapper, WriteStream) {
+  struct Stream {};
+  RpcMethodMetrics metrics;
+  auto functor = [](std::unique_ptr<grpc::ClientContext>) {
+    return std::unique_ptr<Stream>(new Stream);
+  };
+  RetryAttemptScope attempt(1);
+  auto stream =
+      MetricsWrapper(functor, absl::make_unique<grpc::ClientContext>(), metrics);
+  EXPECT_NE(nullptr, stream);
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(1, s.retries);
+  EXPECT_EQ(0, s.bytes_sent);
+}
+
+TEST(MetricsWrapper, AsyncReadWriteStream) {
+  struct Stream {};
+  RpcMethodMetrics metrics;
+  CompletionQueue cq;
+  auto functor = [](CompletionQueue&, std::unique_ptr<grpc::ClientContext>) {
+    return std::unique_ptr<Stream>(new Stream);
+  };
+  auto stream = MetricsWrapper(
+      functor, cq, absl::make_unique<grpc::ClientContext>(), metrics);
+  EXPECT_NE(nullptr, stream);
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(0, s.bytes_sent);
+}
+
+class FakeAllocationCounter : public RpcAllocationCounter {
+ public:
+  std::int64_t Count() override { return count; }
+  std::int64_t count = 0;
+};
+
+TEST(MetricsWrapper, ResourceAccounting) {
+  auto counter = std::make_shared<FakeAllocationCounter>();
+  RpcResourceAccounting accounting{counter};
+  RpcMethodMetrics metrics(&accounting);
+  grpc::ClientContext context;
+  auto functor = [&counter](grpc::ClientContext&, StringValue const&) {
+    counter->count += 3;
+    // Burn some CPU, in a way the optimizer cannot remove.
+    volatile std::uint64_t sink = 0;
+    for (std::uint64_t i = 0; i != 1000000; ++i) sink = sink + i;
+    return make_status_or(MakeResponse());
+  };
+  auto response = MetricsWrapper(functor, context, MakeRequest(), metrics);
+  ASSERT_STATUS_OK(response);
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(3, s.allocations);
+  if (ThreadCpuTime() != std::chrono::nanoseconds(0)) {
+    EXPECT_GT(s.cpu_time, std::chrono::nanoseconds(0));
+  }
+}
+
+TEST(MetricsWrapper, ResourceAccountingDisabled) {
+  RpcMethodMetrics metrics;
+  grpc::ClientContext context;
+  auto functor = [](grpc::ClientContext&, StringValue const&) {
+    return make_status_or(MakeResponse());
+  };
+  auto response = MetricsWrapper(functor, context, MakeRequest(), metrics);
+  ASSERT_STATUS_OK(response);
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(std::chrono::nanoseconds(0), s.cpu_time);
+  EXPECT_EQ(0, s.allocations);
+}
+
+TEST(MetricsWrapper, FutureStatusOr) {
+  RpcMethodMetrics metrics;
+  CompletionQueue cq;
+  promise<StatusOr<StringValue>> p;
+  auto functor = [&p](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                      StringValue const&) { return p.get_future(); };
+  auto f = MetricsWrapper(functor, cq, absl::make_unique<grpc::ClientContext>(),
+                          MakeRequest(), metrics);
+  EXPECT_EQ(0, metrics.Snapshot().calls);
+  p.set_value(MakeResponse());
+  ASSERT_STATUS_OK(f.get());
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(MakeResponse().ByteSizeLong(), s.bytes_received);
+}
+
+TEST(MetricsWrapper, FutureStatus) {
+  RpcMethodMetrics metrics;
+  CompletionQueue cq;
+  auto functor = [](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                    StringValue const&) {
+    return make_ready_future(Status(StatusCode::kNotFound, "not found"));
+  };
+  auto status =
+      MetricsWrapper(functor, cq, absl::make_unique<grpc::ClientContext>(),
+                     MakeRequest(), metrics)
+          .get();
+  EXPECT_THAT(status, StatusIs(StatusCode::kNotFound));
+  auto const s = metrics.Snapshot();
+  EXPECT_EQ(1, s.calls);
+  EXPECT_EQ(1, s.errors);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,91 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/outstanding_request_picker.h"
+#include <algorithm>
+#include <random>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+OutstandingRequestPicker::OutstandingRequestPicker(std::size_t size)
+    : size_((std::max)(std::size_t{1}, size)),
+      slots_(new Slot[size_]),
+      state_([] {
+        std::random_device rd;
+        return (std::uint64_t{rd()} << 32) | std::uint64_t{rd()};
+      }()) {}
+
+std::size_t OutstandingRequestPicker::Pick() {
+  if (size_ == 1) return 0;
+  auto const r = NextRandom();
+  auto const a = static_cast<std::size_t>(r % size_);
+  // Pick a second candidate, distinct from the first one.
+  auto const offset = 1 + static_cast<std::size_t>((r >> 32) % (size_ - 1));
+  auto const b = (a + offset) % size_;
+  auto const a_available = available(a);
+  auto const b_available = available(b);
+  if (a_available && b_available) return Better(b, a) ? b : a;
+  if (a_available) return a;
+  if (b_available) return b;
+  // Both candidates are unavailable, fallback to the first available channel,
+  // or to the first candidate if all the channels are unavailable.
+  for (std::size_t i = 1; i != size_; ++i) {
+    auto const c = (a + i) % size_;
+    if (available(c)) return c;
+  }
+  return a;
+}
+
+void OutstandingRequestPicker::StartRequest(std::size_t index) {
+  slots_[index].outstanding.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OutstandingRequestPicker::FinishRequest(std::size_t index) {
+  slots_[index].outstanding.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void OutstandingRequestPicker::SetAvailable(std::size_t index,
+                                            bool available) {
+  slots_[index].available.store(available, std::memory_order_relaxed);
+}
+
+std::int64_t OutstandingRequestPicker::outstanding(std::size_t index) const {
+  return slots_[index].outstanding.load(std::memory_order_relaxed);
+}
+
+bool OutstandingRequestPicker::available(std::size_t index) const {
+  return slots_[index].available.load(std::memory_order_relaxed);
+}
+
+std::uint64_t OutstandingRequestPicker::NextRandom() {
+  // The picker only needs a fast, well distributed, sequence. A `SplitMix64`
+  // generator over an atomic counter provides that without any locks.
+  auto z = state_.fetch_add(0x9E3779B97F4A7C15ULL, std::memory_order_relaxed) +
+           0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+bool OutstandingRequestPicker::Better(std::size_t lhs, std::size_t rhs) const {
+  return outstanding(lhs) < outstanding(rhs);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
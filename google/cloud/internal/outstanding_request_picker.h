@@ -0,0 +1,89 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_OUTSTANDING_REQUEST_PICKER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_OUTSTANDING_REQUEST_PICKER_H
+
+#include "google/cloud/version.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Pick one of N channels (or stubs) using the "power of two choices".
+ *
+ * The picker keeps a count of the outstanding requests on each channel. To
+ * pick a channel it samples two distinct channels at random and returns the
+ * one with fewer outstanding requests. Compared to round-robin this avoids
+ * sending a fixed fraction of the requests to a slow or congested channel,
+ * and compared to a full scan it does not need to examine (or lock) all the
+ * counters.
+ *
+ * Channels can be marked as unavailable, for example, while their connection
+ * is being refreshed. Unavailable channels are skipped unless all the
+ * channels are unavailable.
+ *
+ * All the member functions are thread-safe and lock-free.
+ */
+class OutstandingRequestPicker {
+ public:
+  /// Create a picker for @p size channels, @p size must be at least 1.
+  explicit OutstandingRequestPicker(std::size_t size);
+
+  std::size_t size() const { return size_; }
+
+  /// Return the index of the channel to use for the next request.
+  std::size_t Pick();
+
+  /// Record that a request started on channel @p index.
+  void StartRequest(std::size_t index);
+
+  /// Record that a request finished on channel @p index.
+  void FinishRequest(std::size_t index);
+
+  /// Mark channel @p index as available, or unavailable, for new requests.
+  void SetAvailable(std::size_t index, bool available);
+
+  /// The number of outstanding requests on channel @p index.
+  std::int64_t outstanding(std::size_t index) const;
+
+  /// Returns true if the channel @p index is available for new requests.
+  bool available(std::size_t index) const;
+
+ private:
+  struct Slot {
+    std::atomic<std::int64_t> outstanding{0};
+    std::atomic<bool> available{true};
+  };
+
+  std::uint64_t NextRandom();
+  bool Better(std::size_t lhs, std::size_t rhs) const;
+
+  std::size_t const size_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<std::uint64_t> state_;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_OUTSTANDING_REQUEST_PICKER_H
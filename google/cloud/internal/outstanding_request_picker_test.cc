@@ -0,0 +1,118 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/outstanding_request_picker.h"
+#include <gmock/gmock.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+TEST(OutstandingRequestPicker, SingleChannel) {
+  OutstandingRequestPicker picker(1);
+  EXPECT_EQ(1, picker.size());
+  picker.StartRequest(0);
+  picker.SetAvailable(0, false);
+  for (int i = 0; i != 10; ++i) EXPECT_EQ(0, picker.Pick());
+}
+
+TEST(OutstandingRequestPicker, ZeroSizeIsOne) {
+  OutstandingRequestPicker picker(0);
+  EXPECT_EQ(1, picker.size());
+  EXPECT_EQ(0, picker.Pick());
+}
+
+TEST(OutstandingRequestPicker, UsesAllChannels) {
+  OutstandingRequestPicker picker(4);
+  std::set<std::size_t> picked;
+  for (int i = 0; i != 1000; ++i) picked.insert(picker.Pick());
+  EXPECT_EQ(4, picked.size());
+}
+
+TEST(OutstandingRequestPicker, AvoidsLoadedChannel) {
+  OutstandingRequestPicker picker(2);
+  for (int i = 0; i != 5; ++i) picker.StartRequest(0);
+  // With two channels both are always sampled, so the least loaded wins.
+  for (int i = 0; i != 100; ++i) EXPECT_EQ(1, picker.Pick());
+  for (int i = 0; i != 5; ++i) picker.FinishRequest(0);
+  picker.StartRequest(1);
+  for (int i = 0; i != 100; ++i) EXPECT_EQ(0, picker.Pick());
+}
+
+TEST(OutstandingRequestPicker, BalancesLoad) {
+  auto constexpr kChannels = 8;
+  OutstandingRequestPicker picker(kChannels);
+  // Start many requests without ever finishing them, the outstanding counts
+  // should remain close to each other.
+  for (int i = 0; i != 8000; ++i) picker.StartRequest(picker.Pick());
+  for (std::size_t i = 0; i != kChannels; ++i) {
+    EXPECT_GE(picker.outstanding(i), 950);
+    EXPECT_LE(picker.outstanding(i), 1050);
+  }
+}
+
+TEST(OutstandingRequestPicker, SkipsUnavailable) {
+  OutstandingRequestPicker picker(4);
+  picker.SetAvailable(1, false);
+  picker.SetAvailable(2, false);
+  EXPECT_FALSE(picker.available(1));
+  EXPECT_TRUE(picker.available(0));
+  // Make the available channels more loaded than the unavailable ones.
+  for (int i = 0; i != 5; ++i) {
+    picker.StartRequest(0);
+    picker.StartRequest(3);
+  }
+  std::set<std::size_t> picked;
+  for (int i = 0; i != 1000; ++i) picked.insert(picker.Pick());
+  EXPECT_EQ(std::set<std::size_t>({0, 3}), picked);
+
+  picker.SetAvailable(0, false);
+  picker.SetAvailable(3, false);
+  // With all the channels unavailable the picker still returns a channel.
+  picked.clear();
+  for (int i = 0; i != 1000; ++i) picked.insert(picker.Pick());
+  EXPECT_EQ(4, picked.size());
+
+  picker.SetAvailable(2, true);
+  for (int i = 0; i != 100; ++i) EXPECT_EQ(2, picker.Pick());
+}
+
+TEST(OutstandingRequestPicker, ThreadSafe) {
+  auto constexpr kChannels = 4;
+  OutstandingRequestPicker picker(kChannels);
+  auto worker = [&picker] {
+    for (int i = 0; i != 10000; ++i) {
+      auto const index = picker.Pick();
+      picker.StartRequest(index);
+      picker.FinishRequest(index);
+    }
+  };
+  std::vector<std::thread> threads(4);
+  for (auto& t : threads) t = std::thread(worker);
+  for (auto& t : threads) t.join();
+  for (std::size_t i = 0; i != kChannels; ++i) {
+    EXPECT_EQ(0, picker.outstanding(i));
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
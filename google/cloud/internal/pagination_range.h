@@ -19,8 +19,13 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/stream_range.h"
 #include "google/cloud/version.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -52,9 +57,9 @@ using PaginationRange = StreamRange<T>;
  * Returns `T`s one at a time from pages of responses.
  *
  * This class is an implementation detail. An instance of this class is wrapped
- * in a lambda and passed as the `StreamReader<T>` to the `PaginationRange<T>`
- * constructor. This class is responsible for loading pages and returning the
- * next `T`.
+ * in a lambda and passed as the `BatchStreamReader<T>` to the
+ * `PaginationRange<T>` constructor. This class is responsible for loading pages
+ * and returning them as batches of `T`.
  *
  * Users should not use this class directly. Use the `MakePaginationRange()`
  * function (defined below) instead.
@@ -107,6 +112,35 @@ class PagedStreamReader {
     return std::move(*current_++);
   }
 
+  /**
+   * Fetches (or returns if already fetched) the next page from the stream.
+   *
+   * The page is moved into @p batch, without copying the elements. Any
+   * elements not yet returned by `GetNext()` are returned first.
+   *
+   * @return an OK `Status` with a non-empty @p batch if more elements may
+   *   follow, an OK `Status` with an empty @p batch to indicate a successful
+   *   end of stream, or a non-OK `Status` to indicate an error.
+   */
+  Status GetNextBatch(std::vector<T>& batch) {
+    if (current_ == page_.end()) {
+      if (last_page_) return Status{};
+      request_.set_page_token(std::move(token_));
+      auto response = loader_(request_);
+      if (!response.ok()) return std::move(response).status();
+      token_ = ExtractPageToken(*response);
+      if (token_.empty()) last_page_ = true;
+      batch = extractor_(*std::move(response));
+      // An empty page ends the stream, as in `GetNext()`.
+      if (batch.empty()) last_page_ = true;
+      return Status{};
+    }
+    batch.assign(std::make_move_iterator(current_),
+                 std::make_move_iterator(page_.end()));
+    current_ = page_.end();
+    return Status{};
+  }
+
  private:
   /**
    * ExtractPageToken() extracts (i.e., "moves") the page token out of the
@@ -135,6 +169,188 @@ class PagedStreamReader {
   bool last_page_;
 };
 
+/**
+ * Runs a function in the background.
+ *
+ * The function may be dropped without running it, for example, if the
+ * `CompletionQueue` used to run it is deleted.
+ */
+using PaginationExecutor = std::function<void(std::function<void()>)>;
+
+/**
+ * Returns `T`s one at a time from pages of responses, prefetching pages.
+ *
+ * Like `PagedStreamReader`, but this class fetches up to `prefetch_depth` pages
+ * ahead of the page returned by `GetNext()`. The pages are loaded one at a
+ * time, as each request needs the token from the previous response, in the
+ * background, using @p executor. This overlaps the latency of the `List` RPCs
+ * with the application processing the items.
+ *
+ * The first page is loaded in the calling thread. If the executor drops a
+ * request, `GetNext()` loads the page in the calling thread too.
+ */
+template <typename T, typename Request, typename Response>
+class PrefetchingPagedStreamReader
+    : public std::enable_shared_from_this<
+          PrefetchingPagedStreamReader<T, Request, Response>> {
+ public:
+  PrefetchingPagedStreamReader(
+      Request request, std::function<StatusOr<Response>(Request const&)> loader,
+      std::function<std::vector<T>(Response)> extractor,
+      std::size_t prefetch_depth, PaginationExecutor executor)
+      : loader_(std::move(loader)),
+        extractor_(std::move(extractor)),
+        prefetch_depth_(prefetch_depth),
+        executor_(std::move(executor)),
+        request_(std::move(request)) {
+    current_ = page_.begin();
+  }
+
+  /// @copydoc PagedStreamReader::GetNext()
+  typename StreamReader<T>::result_type GetNext() {
+    if (current_ == page_.end()) {
+      if (last_page_) return Status{};
+      auto response = NextResponse();
+      if (!response.ok()) {
+        last_page_ = true;
+        return std::move(response).status();
+      }
+      page_ = extractor_(*std::move(response));
+      current_ = page_.begin();
+      if (current_ == page_.end()) return Status{};
+    }
+    return std::move(*current_++);
+  }
+
+  /// @copydoc PagedStreamReader::GetNextBatch()
+  Status GetNextBatch(std::vector<T>& batch) {
+    if (current_ == page_.end()) {
+      if (last_page_) return Status{};
+      auto response = NextResponse();
+      if (!response.ok()) {
+        last_page_ = true;
+        return std::move(response).status();
+      }
+      batch = extractor_(*std::move(response));
+      if (batch.empty()) last_page_ = true;
+      return Status{};
+    }
+    batch.assign(std::make_move_iterator(current_),
+                 std::make_move_iterator(page_.end()));
+    current_ = page_.end();
+    return Status{};
+  }
+
+ private:
+  using SelfType = PrefetchingPagedStreamReader<T, Request, Response>;
+
+  // Loads one page in the background. Copies of this function share the same
+  // `Task`, which reports if the executor drops the function without running
+  // it.
+  struct Task {
+    std::weak_ptr<SelfType> weak;
+    Request request;
+    bool done = false;
+
+    ~Task() {
+      if (done) return;
+      if (auto self = weak.lock()) self->OnAbandoned();
+    }
+
+    void Run() {
+      done = true;
+      auto self = weak.lock();
+      if (!self) return;
+      auto response = self->loader_(request);
+      self->OnResponse(std::unique_lock<std::mutex>(self->mu_),
+                       std::move(response));
+    }
+  };
+
+  StatusOr<Response> NextResponse() {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (ready_.empty()) {
+      if (fetching_) {
+        cv_.wait(lk);
+        continue;
+      }
+      // Nothing is in flight, this is the first page, or the executor dropped
+      // the last request.
+      fetching_ = true;
+      auto request = request_;
+      lk.unlock();
+      auto response = loader_(request);
+      OnResponse(std::unique_lock<std::mutex>(mu_), std::move(response));
+      lk.lock();
+    }
+    auto response = std::move(ready_.front());
+    ready_.pop_front();
+    last_page_ = exhausted_ && ready_.empty();
+    MaybePrefetch(std::move(lk));
+    return response;
+  }
+
+  void OnResponse(std::unique_lock<std::mutex> lk,
+                  StatusOr<Response> response) {
+    fetching_ = false;
+    if (response.ok()) {
+      auto token = ExtractPageToken(*response);
+      if (token.empty()) exhausted_ = true;
+      request_.set_page_token(std::move(token));
+    } else {
+      exhausted_ = true;
+    }
+    ready_.push_back(std::move(response));
+    cv_.notify_all();
+    MaybePrefetch(std::move(lk));
+  }
+
+  void OnAbandoned() {
+    std::unique_lock<std::mutex> lk(mu_);
+    fetching_ = false;
+    cv_.notify_all();
+  }
+
+  void MaybePrefetch(std::unique_lock<std::mutex> lk) {
+    if (fetching_ || exhausted_ || ready_.size() >= prefetch_depth_) return;
+    fetching_ = true;
+    auto task = std::make_shared<Task>();
+    task->weak = this->shared_from_this();
+    task->request = request_;
+    lk.unlock();
+    executor_([task] { task->Run(); });
+  }
+
+  // See `PagedStreamReader::ExtractPageToken()`.
+  template <typename U>
+  static constexpr auto ExtractPageToken(U& u)
+      -> decltype(std::move(*u.mutable_next_page_token())) {
+    return std::move(*u.mutable_next_page_token());
+  }
+  template <typename U>
+  static constexpr auto ExtractPageToken(U& u)
+      -> decltype(std::move(u.next_page_token)) {
+    return std::move(u.next_page_token);
+  }
+
+  std::function<StatusOr<Response>(Request const&)> const loader_;
+  std::function<std::vector<T>(Response)> const extractor_;
+  std::size_t const prefetch_depth_;
+  PaginationExecutor const executor_;
+
+  // Only used by `GetNext()` and `GetNextBatch()`.
+  std::vector<T> page_;
+  typename std::vector<T>::iterator current_;
+  bool last_page_ = false;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  Request request_;
+  std::deque<StatusOr<Response>> ready_;
+  bool fetching_ = false;
+  bool exhausted_ = false;
+};
+
 /**
  * A factory function for creating `PaginationRange<T>` instances.
  *
@@ -171,8 +387,39 @@ Range MakePaginationRange(Request request, Loader loader, Extractor extractor) {
   using ReaderType = PagedStreamReader<ValueType, Request, Response>;
   auto reader = std::make_shared<ReaderType>(
       std::move(request), std::move(loader), std::move(extractor));
-  return MakeStreamRange<ValueType>(
-      {[reader]() mutable { return reader->GetNext(); }});
+  return MakeBatchStreamRange<ValueType>(
+      [reader](std::vector<ValueType>& batch) {
+        return reader->GetNextBatch(batch);
+      });
+}
+
+/**
+ * Creates a `PaginationRange<T>` that prefetches pages in the background.
+ *
+ * The range fetches up to @p prefetch_depth pages ahead of the page consumed by
+ * the application, using @p executor to make the requests. A
+ * @p prefetch_depth of 0 disables prefetching, the range is then identical to
+ * the range created by the previous overload.
+ */
+template <typename Range, typename Request, typename Loader, typename Extractor>
+Range MakePaginationRange(Request request, Loader loader, Extractor extractor,
+                          std::size_t prefetch_depth,
+                          PaginationExecutor executor) {
+  if (prefetch_depth == 0) {
+    return MakePaginationRange<Range>(std::move(request), std::move(loader),
+                                      std::move(extractor));
+  }
+  using ValueType = typename Range::value_type::value_type;
+  using LoaderResult = invoke_result_t<Loader, Request>;
+  using Response = typename LoaderResult::value_type;
+  using ReaderType = PrefetchingPagedStreamReader<ValueType, Request, Response>;
+  auto reader = std::make_shared<ReaderType>(
+      std::move(request), std::move(loader), std::move(extractor),
+      prefetch_depth, std::move(executor));
+  return MakeBatchStreamRange<ValueType>(
+      [reader](std::vector<ValueType>& batch) {
+        return reader->GetNextBatch(batch);
+      });
 }
 
 /**
@@ -15,6 +15,8 @@
 #include "google/cloud/internal/pagination_range.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -24,6 +26,7 @@ namespace {
 
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::HasSubstr;
 
 struct Item {
@@ -249,6 +252,179 @@ TYPED_TEST(PaginationRangeTest, IteratorCoverage) {
   EXPECT_TRUE(i1 == range.end());
 }
 
+TYPED_TEST(PaginationRangeTest, GetNextBatch) {
+  using ResponseType = TypeParam;
+  MockRpc<ResponseType> mock;
+  EXPECT_CALL(mock, Loader)
+      .WillOnce([](Request const&) {
+        ResponseType response;
+        response.testonly_set_page_token("t1");
+        response.testonly_items = {Item{"p1"}, Item{"p2"}, Item{"p3"}};
+        return response;
+      })
+      .WillOnce([](Request const& request) {
+        EXPECT_EQ("t1", request.testonly_page_token);
+        ResponseType response;
+        response.testonly_items = {Item{"p4"}};
+        return response;
+      });
+
+  PagedStreamReader<Item, Request, ResponseType> reader(
+      Request{}, [&mock](Request const& r) { return mock.Loader(r); },
+      [](ResponseType const& r) { return r.testonly_items; });
+  auto names = [](std::vector<Item> const& batch) {
+    std::vector<std::string> names;
+    for (auto const& i : batch) names.push_back(i.data);
+    return names;
+  };
+  // Mixing the two functions returns the rest of the current page first.
+  auto first = reader.GetNext();
+  ASSERT_TRUE(absl::holds_alternative<Item>(first));
+  EXPECT_EQ("p1", absl::get<Item>(first).data);
+  std::vector<Item> batch;
+  ASSERT_STATUS_OK(reader.GetNextBatch(batch));
+  EXPECT_THAT(names(batch), ElementsAre("p2", "p3"));
+  batch.clear();
+  ASSERT_STATUS_OK(reader.GetNextBatch(batch));
+  EXPECT_THAT(names(batch), ElementsAre("p4"));
+  batch.clear();
+  ASSERT_STATUS_OK(reader.GetNextBatch(batch));
+  EXPECT_TRUE(batch.empty());
+}
+
+/// Returns page @p n of @p count pages, page `n` contains a single item.
+template <typename ResponseType>
+ResponseType MakePage(int n, int count) {
+  ResponseType response;
+  response.testonly_items.push_back(Item{"p" + std::to_string(n)});
+  if (n + 1 < count) response.testonly_set_page_token(std::to_string(n + 1));
+  return response;
+}
+
+/// Returns the index of the page requested by @p request.
+int PageIndex(Request const& request) {
+  if (request.testonly_page_token.empty()) return 0;
+  return std::stoi(request.testonly_page_token);
+}
+
+std::vector<std::string> ExpectedItems(int count) {
+  std::vector<std::string> items;
+  for (int i = 0; i != count; ++i) items.push_back("p" + std::to_string(i));
+  return items;
+}
+
+TYPED_TEST(PaginationRangeTest, PrefetchDepth) {
+  using ResponseType = TypeParam;
+  auto constexpr kPageCount = 5;
+  int loaded = 0;
+  auto loader = [&loaded](Request const& request) {
+    EXPECT_EQ(loaded, PageIndex(request));
+    return StatusOr<ResponseType>(MakePage<ResponseType>(loaded++, kPageCount));
+  };
+  // Run the prefetch requests immediately, to make the test deterministic.
+  auto executor = [](std::function<void()> f) { f(); };
+
+  auto range = MakePaginationRange<ItemRange>(
+      Request{}, loader,
+      [](ResponseType const& r) { return r.testonly_items; },
+      /*prefetch_depth=*/2, executor);
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) break;
+    // The range loads the current page, plus the two pages after it.
+    EXPECT_EQ((std::min)(static_cast<int>(names.size()) + 3, kPageCount),
+              loaded);
+    names.push_back(p->data);
+  }
+  EXPECT_THAT(names, ElementsAreArray(ExpectedItems(kPageCount)));
+}
+
+TYPED_TEST(PaginationRangeTest, PrefetchError) {
+  using ResponseType = TypeParam;
+  int loaded = 0;
+  auto loader = [&loaded](Request const& request) -> StatusOr<ResponseType> {
+    EXPECT_EQ(loaded, PageIndex(request));
+    if (loaded == 2) return Status(StatusCode::kAborted, "bad-luck");
+    return MakePage<ResponseType>(loaded++, 5);
+  };
+  auto executor = [](std::function<void()> f) { f(); };
+
+  auto range = MakePaginationRange<ItemRange>(
+      Request{}, loader,
+      [](ResponseType const& r) { return r.testonly_items; },
+      /*prefetch_depth=*/4, executor);
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) {
+      EXPECT_THAT(p, StatusIs(StatusCode::kAborted, HasSubstr("bad-luck")));
+      break;
+    }
+    names.push_back(p->data);
+  }
+  EXPECT_THAT(names, ElementsAre("p0", "p1"));
+}
+
+TYPED_TEST(PaginationRangeTest, PrefetchDropped) {
+  using ResponseType = TypeParam;
+  auto constexpr kPageCount = 3;
+  int loaded = 0;
+  auto loader = [&loaded](Request const& request) {
+    EXPECT_EQ(loaded, PageIndex(request));
+    return StatusOr<ResponseType>(MakePage<ResponseType>(loaded++, kPageCount));
+  };
+  // An executor that drops all the functions, as a `CompletionQueue` does
+  // after it is shutdown. The range should load the pages on demand.
+  auto executor = [](std::function<void()>) {};
+
+  auto range = MakePaginationRange<ItemRange>(
+      Request{}, loader,
+      [](ResponseType const& r) { return r.testonly_items; },
+      /*prefetch_depth=*/1, executor);
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) break;
+    names.push_back(p->data);
+  }
+  EXPECT_THAT(names, ElementsAreArray(ExpectedItems(kPageCount)));
+  EXPECT_EQ(kPageCount, loaded);
+}
+
+TYPED_TEST(PaginationRangeTest, PrefetchInThreads) {
+  using ResponseType = TypeParam;
+  auto constexpr kPageCount = 100;
+  std::atomic<int> loaded(0);
+  auto loader = [&loaded](Request const& request) {
+    auto const n = PageIndex(request);
+    EXPECT_EQ(loaded.load(), n);
+    auto response = MakePage<ResponseType>(n, kPageCount);
+    ++loaded;
+    return StatusOr<ResponseType>(std::move(response));
+  };
+  std::mutex mu;
+  std::vector<std::thread> threads;
+  auto executor = [&mu, &threads](std::function<void()> f) {
+    std::lock_guard<std::mutex> lk(mu);
+    threads.emplace_back(std::move(f));
+  };
+
+  {
+    auto range = MakePaginationRange<ItemRange>(
+        Request{}, loader,
+        [](ResponseType const& r) { return r.testonly_items; },
+        /*prefetch_depth=*/3, executor);
+    std::vector<std::string> names;
+    for (auto& p : range) {
+      if (!p) break;
+      names.push_back(p->data);
+    }
+    EXPECT_THAT(names, ElementsAreArray(ExpectedItems(kPageCount)));
+  }
+  std::unique_lock<std::mutex> lk(mu);
+  auto joinable = std::move(threads);
+  lk.unlock();
+  for (auto& t : joinable) t.join();
+}
+
 TEST(RangeFromPagination, Unimplemented) {
   using NonProtoRange = PaginationRange<std::string>;
   auto range = MakeUnimplementedPaginationRange<NonProtoRange>();
@@ -19,8 +19,117 @@ namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+namespace {
+
+// Parses exactly @p n decimal digits starting at @p p.
+bool ParseDigits(char const*& p, int n, int& value) {
+  value = 0;
+  for (int i = 0; i != n; ++i, ++p) {
+    if (*p < '0' || *p > '9') return false;
+    value = value * 10 + (*p - '0');
+  }
+  return true;
+}
+
+bool IsLeapYear(int y) { return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0); }
+
+int DaysInMonth(int y, int m) {
+  static int const kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return m == 2 && IsLeapYear(y) ? 29 : kDays[m - 1];
+}
+
+// The number of days from 1970-01-01 to the given date, see
+//   http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+std::int64_t DaysFromCivil(int y, int m, int d) {
+  y -= m <= 2 ? 1 : 0;
+  std::int64_t const era = (y >= 0 ? y : y - 399) / 400;
+  std::int64_t const yoe = y - era * 400;
+  std::int64_t const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  std::int64_t const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+}  // namespace
+
+bool ParseRfc3339Fast(std::string const& timestamp, std::int64_t* seconds,
+                      std::int32_t* nanos) {
+  // The shortest timestamp is `YYYY-MM-DDTHH:MM:SSZ`, checking the size first
+  // makes all the accesses before the fractional seconds safe.
+  if (timestamp.size() < 20) return false;
+  char const* p = timestamp.data();
+  char const* const end = p + timestamp.size();
+  int year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int second;
+  if (!ParseDigits(p, 4, year) || *p++ != '-') return false;
+  if (!ParseDigits(p, 2, month) || *p++ != '-') return false;
+  if (!ParseDigits(p, 2, day)) return false;
+  if (*p != 'T' && *p != 't') return false;
+  ++p;
+  if (!ParseDigits(p, 2, hour) || *p++ != ':') return false;
+  if (!ParseDigits(p, 2, minute) || *p++ != ':') return false;
+  if (!ParseDigits(p, 2, second)) return false;
+  if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month)) {
+    return false;
+  }
+  if (hour > 23 || minute > 59 || second > 59) return false;
+
+  std::int32_t ns = 0;
+  if (*p == '.') {
+    auto const* const digits = ++p;
+    std::int32_t scale = 100000000;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p, scale /= 10) {
+      ns += (*p - '0') * scale;
+    }
+    if (p == digits) return false;
+  }
+
+  int offset = 0;
+  if (p != end && (*p == 'Z' || *p == 'z')) {
+    ++p;
+  } else if (end - p == 6 && (*p == '+' || *p == '-')) {
+    auto const sign = *p++ == '-' ? -1 : 1;
+    int offset_hour;
+    int offset_minute;
+    if (!ParseDigits(p, 2, offset_hour) || *p++ != ':') return false;
+    if (!ParseDigits(p, 2, offset_minute)) return false;
+    if (offset_hour > 23 || offset_minute > 59) return false;
+    offset = sign * (offset_hour * 3600 + offset_minute * 60);
+  } else {
+    return false;
+  }
+  if (p != end) return false;
+
+  *seconds = DaysFromCivil(year, month, day) * 86400 + hour * 3600 +
+             minute * 60 + second - offset;
+  *nanos = ns;
+  return true;
+}
+
 StatusOr<std::chrono::system_clock::time_point> ParseRfc3339(
     std::string const& timestamp) {
+  using std::chrono::system_clock;
+  std::int64_t seconds;
+  std::int32_t nanos;
+  // Avoid overflows on platforms where `system_clock` has a limited range,
+  // the general purpose parser handles those cases.
+  auto const max = std::chrono::duration_cast<std::chrono::seconds>(
+                       system_clock::duration::max())
+                       .count();
+  auto const min = std::chrono::duration_cast<std::chrono::seconds>(
+                       system_clock::duration::min())
+                       .count();
+  if (ParseRfc3339Fast(timestamp, &seconds, &nanos) && seconds < max &&
+      seconds > min) {
+    return system_clock::time_point(
+        std::chrono::duration_cast<system_clock::duration>(
+            std::chrono::seconds(seconds)) +
+        std::chrono::duration_cast<system_clock::duration>(
+            std::chrono::nanoseconds(nanos)));
+  }
   std::string err;
   absl::Time t;
   if (!absl::ParseTime(absl::RFC3339_full, timestamp, &t, &err)) {
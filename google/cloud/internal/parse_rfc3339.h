@@ -18,6 +18,7 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -41,6 +42,22 @@ namespace internal {
 StatusOr<std::chrono::system_clock::time_point> ParseRfc3339(
     std::string const& timestamp);
 
+/**
+ * Parses the common forms of RFC-3339 timestamps, without allocating memory.
+ *
+ * Google Cloud services produce timestamps as `YYYY-MM-DDTHH:MM:SS`, followed
+ * by optional fractional seconds and by `Z` or a `+HH:MM`/`-HH:MM` offset.
+ * This function parses such timestamps into @p seconds since the Unix epoch
+ * and @p nanos (in `[0, 999999999]`), truncating any digits beyond
+ * nanoseconds.
+ *
+ * Returns `false`, without modifying the outputs, for anything else. That
+ * includes some valid, but unusual, timestamps such as leap seconds, callers
+ * should fall back to a general purpose parser in that case.
+ */
+bool ParseRfc3339Fast(std::string const& timestamp, std::int64_t* seconds,
+                      std::int32_t* nanos);
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -0,0 +1,85 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/parse_rfc3339.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+// Each object in a Cloud Storage `ListObjects` response has (at least) three
+// timestamps: `timeCreated`, `updated`, and `timeStorageClassUpdated`. The
+// timestamps below are representative of those returned by the service.
+//
+// Run on (1 X 2100 MHz CPU )
+// Before, using `absl::ParseTime()` and `absl::FormatTime()`:
+// ----------------------------------------------------------------------
+// Benchmark                            Time             CPU   Iterations
+// ----------------------------------------------------------------------
+// BM_ParseRfc3339                    293 ns          289 ns      2403693
+// BM_ParseRfc3339WithOffset          370 ns          368 ns      1873459
+// BM_FormatRfc3339                   281 ns          279 ns      2368318
+// BM_FormatV4SignedUrlTimestamp      226 ns          225 ns      3094987
+//
+// After, using the fixed-format parser and formatter:
+// ----------------------------------------------------------------------
+// Benchmark                            Time             CPU   Iterations
+// ----------------------------------------------------------------------
+// BM_ParseRfc3339                   29.4 ns         29.1 ns     24322963
+// BM_ParseRfc3339WithOffset         80.0 ns         79.0 ns     10574575
+// BM_FormatRfc3339                  65.9 ns         65.3 ns     10662164
+// BM_FormatV4SignedUrlTimestamp     69.2 ns         68.5 ns     14600425
+
+void BM_ParseRfc3339(benchmark::State& state) {
+  std::string const timestamp = "2021-04-26T17:03:11.123Z";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseRfc3339(timestamp));
+  }
+}
+BENCHMARK(BM_ParseRfc3339);
+
+void BM_ParseRfc3339WithOffset(benchmark::State& state) {
+  std::string const timestamp = "2021-04-26T17:03:11.123456789-07:00";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseRfc3339(timestamp));
+  }
+}
+BENCHMARK(BM_ParseRfc3339WithOffset);
+
+void BM_FormatRfc3339(benchmark::State& state) {
+  auto const tp = ParseRfc3339("2021-04-26T17:03:11.123Z").value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FormatRfc3339(tp));
+  }
+}
+BENCHMARK(BM_FormatRfc3339);
+
+void BM_FormatV4SignedUrlTimestamp(benchmark::State& state) {
+  auto const tp = ParseRfc3339("2021-04-26T17:03:11Z").value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FormatV4SignedUrlTimestamp(tp));
+  }
+}
+BENCHMARK(BM_FormatV4SignedUrlTimestamp);
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -14,6 +14,7 @@
 
 #include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/testing_util/status_matchers.h"
+#include "absl/time/time.h"
 #include <gtest/gtest.h>
 #include <ctime>
 
@@ -158,6 +159,78 @@ TEST(ParseRfc3339Test, ParseFull) {
   EXPECT_EQ(500, actual_milliseconds.count());
 }
 
+TEST(ParseRfc3339Test, ParseBeforeEpoch) {
+  auto timestamp = ParseRfc3339("1969-12-31T23:59:59.25Z").value();
+  EXPECT_EQ(duration_cast<milliseconds>(timestamp.time_since_epoch()).count(),
+            -750);
+  // Use `date -u +%s --date='1900-02-28T12:00:00'` to get the magic value.
+  timestamp = ParseRfc3339("1900-02-28T12:00:00Z").value();
+  EXPECT_EQ(-2203934400L,
+            duration_cast<seconds>(timestamp.time_since_epoch()).count());
+}
+
+TEST(ParseRfc3339Test, ParseLeapSecond) {
+  // Leap seconds are not handled by the fast path, but they are still valid.
+  auto timestamp = ParseRfc3339("2016-12-31T23:59:60Z");
+  ASSERT_STATUS_OK(timestamp);
+  // Use `date -u +%s --date='2017-01-01T00:00:00'` to get the magic value.
+  EXPECT_EQ(1483228800L,
+            duration_cast<seconds>(timestamp->time_since_epoch()).count());
+}
+
+TEST(ParseRfc3339Test, FastMatchesGeneral) {
+  std::string const tests[] = {
+      "0000-01-01T00:00:00Z",
+      "0001-01-01T00:00:00Z",
+      "1600-02-29T01:02:03.4Z",
+      "1969-12-31T23:59:59.999999999Z",
+      "1970-01-01T00:00:00Z",
+      "2000-02-29T23:59:59.000000001Z",
+      "2018-05-18t14:42:03.123456z",
+      "2018-05-18T14:42:03+08:00",
+      "2018-05-18T14:42:03.5-01:05",
+      "2018-05-18T00:00:00.1234567890123-23:59",
+      "9999-12-31T23:59:59.999999999Z",
+  };
+  for (auto const& input : tests) {
+    SCOPED_TRACE("Testing with " + input);
+    std::int64_t seconds;
+    std::int32_t nanos;
+    ASSERT_TRUE(ParseRfc3339Fast(input, &seconds, &nanos));
+    absl::Time expected;
+    std::string err;
+    ASSERT_TRUE(absl::ParseTime(absl::RFC3339_full, input, &expected, &err));
+    auto const expected_seconds = absl::ToUnixSeconds(expected);
+    EXPECT_EQ(expected_seconds, seconds);
+    EXPECT_EQ(absl::ToInt64Nanoseconds(expected -
+                                       absl::FromUnixSeconds(expected_seconds)),
+              nanos);
+  }
+}
+
+TEST(ParseRfc3339Test, FastRejects) {
+  std::string const tests[] = {
+      "",
+      "2018-05-18T14:42:03",
+      "2018-05-18T14:42:03.Z",
+      "2018-05-18T14:42:03+08",
+      "2018-05-18T14:42:03+08:00Z",
+      "2018-05-18T14:42:03Zx",
+      "2018-05-18 14:42:03Z",
+      "2018-5-18T14:42:03.000Z",
+      "2018-00-18T14:42:03Z",
+      "2018-05-00T14:42:03Z",
+      "2016-12-31T23:59:60Z",
+      "12018-05-18T14:42:03Z",
+  };
+  for (auto const& input : tests) {
+    SCOPED_TRACE("Testing with " + input);
+    std::int64_t seconds = 0;
+    std::int32_t nanos = 0;
+    EXPECT_FALSE(ParseRfc3339Fast(input, &seconds, &nanos));
+  }
+}
+
 TEST(ParseRfc3339Test, DetectInvalidSeparator) {
   EXPECT_THAT(ParseRfc3339("2018-05-18x14:42:03Z"),
               StatusIs(StatusCode::kInvalidArgument));
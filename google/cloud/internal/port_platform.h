@@ -89,6 +89,19 @@
 #  define GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS 1
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 
+// Discover if C++20 coroutines are available. Applications can define
+// GOOGLE_CLOUD_CPP_DISABLE_COROUTINES to skip this support even if the compiler
+// has it.
+#ifdef GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#  error "GOOGLE_CLOUD_CPP_HAVE_COROUTINES should not be set directly."
+#elif defined(GOOGLE_CLOUD_CPP_DISABLE_COROUTINES)
+   // Coroutine support explicitly disabled.
+#elif defined(__cpp_impl_coroutine) && defined(__has_include)
+#  if __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#    define GOOGLE_CLOUD_CPP_HAVE_COROUTINES 1
+#  endif  // __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
 // clang-format on
 
 #endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_PORT_PLATFORM_H
@@ -16,6 +16,8 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RESUMABLE_STREAMING_READ_RPC_H
 
 #include "google/cloud/internal/streaming_read_rpc.h"
+#include "google/cloud/rpc_metrics.h"
+#include "google/cloud/rpc_tracing.h"
 #include "google/cloud/version.h"
 #include <chrono>
 #include <memory>
@@ -83,7 +85,15 @@ class ResumableStreamingReadRpc : public StreamingReadRpc<ResponseType> {
         stream_factory_(std::move(stream_factory)),
         updater_(std::move(updater)),
         request_(std::move(request)),
-        impl_(stream_factory_(request_)) {}
+        tracer_("ResumableStreamingReadRpc"),
+        impl_(StartStream()) {}
+
+  ~ResumableStreamingReadRpc() override {
+    // No-ops unless the stream is destroyed before it completes.
+    Status const status(StatusCode::kCancelled, "stream destroyed");
+    tracer_.EndAttempt(std::move(attempt_span_), status);
+    tracer_.End(status);
+  }
 
   ResumableStreamingReadRpc(ResumableStreamingReadRpc&&) = delete;
   ResumableStreamingReadRpc& operator=(ResumableStreamingReadRpc&&) = delete;
@@ -91,14 +101,41 @@ class ResumableStreamingReadRpc : public StreamingReadRpc<ResponseType> {
   void Cancel() override { impl_->Cancel(); }
 
   absl::variant<Status, ResponseType> Read() override {
-    auto response = impl_->Read();
-    if (absl::holds_alternative<ResponseType>(response)) {
-      updater_(absl::get<ResponseType>(response), request_);
+    return ResumeLoop(&StreamingReadRpc<ResponseType>::Read);
+  }
+
+  absl::variant<Status, std::shared_ptr<ResponseType const>> ReadInArena()
+      override {
+    return ResumeLoop(&StreamingReadRpc<ResponseType>::ReadInArena);
+  }
+
+  StreamingRpcMetadata GetRequestMetadata() const override {
+    return impl_ ? impl_->GetRequestMetadata() : StreamingRpcMetadata{};
+  }
+
+ private:
+  static ResponseType const& Value(ResponseType const& r) { return r; }
+  static ResponseType const& Value(
+      std::shared_ptr<ResponseType const> const& r) {
+    return *r;
+  }
+
+  /// Implements `Read()` and `ReadInArena()`, using @p read on each stream.
+  template <typename T>
+  absl::variant<Status, T> ResumeLoop(
+      absl::variant<Status, T> (StreamingReadRpc<ResponseType>::*read)()) {
+    auto response = (impl_.get()->*read)();
+    if (absl::holds_alternative<T>(response)) {
+      updater_(Value(absl::get<T>(response)), request_);
       has_received_data_ = true;
       return response;
     }
     auto last_status = absl::get<Status>(std::move(response));
-    if (last_status.ok()) return last_status;
+    tracer_.EndAttempt(std::move(attempt_span_), last_status);
+    if (last_status.ok()) {
+      tracer_.End(last_status);
+      return last_status;
+    }
     // Need to start a retry loop to connect again. Note that we *retry* to
     // start a streaming read, but once the streaming read succeeds at least
     // once we *resume* the read using *fresh* retry and backoff policies.
@@ -113,31 +150,40 @@ class ResumableStreamingReadRpc : public StreamingReadRpc<ResponseType> {
     auto const backoff_policy = backoff_policy_prototype_->clone();
     while (!retry_policy->IsExhausted() &&
            (has_received_data_ || retry_policy->OnFailure(last_status))) {
-      sleeper_(backoff_policy->OnCompletion());
+      auto const delay = backoff_policy->OnCompletion();
+      tracer_.Backoff(delay);
+      sleeper_(delay);
       has_received_data_ = false;
-      impl_ = stream_factory_(request_);
-      auto r = impl_->Read();
-      if (absl::holds_alternative<ResponseType>(r)) {
-        updater_(absl::get<ResponseType>(r), request_);
+      impl_ = StartStream();
+      auto r = (impl_.get()->*read)();
+      if (absl::holds_alternative<T>(r)) {
+        updater_(Value(absl::get<T>(r)), request_);
         has_received_data_ = true;
         return r;
       }
       last_status = absl::get<Status>(std::move(r));
+      tracer_.EndAttempt(std::move(attempt_span_), last_status);
     }
+    tracer_.End(last_status);
     return last_status;
   }
 
-  StreamingRpcMetadata GetRequestMetadata() const override {
-    return impl_ ? impl_->GetRequestMetadata() : StreamingRpcMetadata{};
+  std::unique_ptr<StreamingReadRpc<ResponseType>> StartStream() {
+    RetryAttemptScope scope(attempt_);
+    attempt_span_ = tracer_.StartAttempt(attempt_++);
+    RpcSpanScope span_scope(attempt_span_.get());
+    return stream_factory_(request_);
   }
 
- private:
   std::unique_ptr<RetryPolicy const> const retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> const backoff_policy_prototype_;
   Sleeper sleeper_;
   StreamFactory<ResponseType, RequestType> const stream_factory_;
   RequestUpdater<ResponseType, RequestType> const updater_;
   RequestType request_;
+  RetryLoopTracer tracer_;
+  std::shared_ptr<RpcSpan> attempt_span_;
+  int attempt_ = 0;
   std::unique_ptr<StreamingReadRpc<ResponseType>> impl_;
   bool has_received_data_ = false;
 };
@@ -15,6 +15,7 @@
 #include "google/cloud/internal/resumable_streaming_read_rpc.h"
 #include "google/cloud/backoff_policy.h"
 #include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/testing_util/fake_rpc_tracer.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include "absl/memory/memory.h"
 #include <gmock/gmock.h>
@@ -146,6 +147,47 @@ TEST(ResumableStreamingReadRpc, ResumeWithPartials) {
   EXPECT_THAT(values, ElementsAre("value-0", "value-1", "value-2"));
 }
 
+TEST(ResumableStreamingReadRpc, ResumeWithPartialsInArena) {
+  MockStub mock;
+  EXPECT_CALL(mock, StreamingRead)
+      .WillOnce([](FakeRequest const& request) {
+        EXPECT_THAT(request.token, IsEmpty());
+        auto stream = absl::make_unique<MockStreamingReadRpc>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(Return(AsReadReturn(FakeResponse{"value-0", "token-1"})))
+            .WillOnce(Return(TransientFailure()));
+        return stream;
+      })
+      .WillOnce([](FakeRequest const& request) {
+        EXPECT_THAT(request.token, "token-1");
+        auto stream = absl::make_unique<MockStreamingReadRpc>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(Return(AsReadReturn(FakeResponse{"value-1", "token-2"})))
+            .WillOnce(Return(StreamSuccess()));
+        return stream;
+      });
+  auto reader = MakeResumableStreamingReadRpc<FakeResponse, FakeRequest>(
+      DefaultRetryPolicy(), DefaultBackoffPolicy(),
+      [](std::chrono::milliseconds) {},
+      [&mock](FakeRequest const& request) {
+        return mock.StreamingRead(request);
+      },
+      DefaultUpdater, FakeRequest{"test-key", {}});
+
+  using ArenaResponse = std::shared_ptr<FakeResponse const>;
+  std::vector<std::string> values;
+  for (;;) {
+    auto v = reader->ReadInArena();
+    if (absl::holds_alternative<ArenaResponse>(v)) {
+      values.push_back(absl::get<ArenaResponse>(v)->value);
+      continue;
+    }
+    EXPECT_THAT(absl::get<Status>(std::move(v)), IsOk());
+    break;
+  }
+  EXPECT_THAT(values, ElementsAre("value-0", "value-1"));
+}
+
 TEST(ResumableStreamingReadRpc, TooManyTransientFailures) {
   MockStub mock;
   EXPECT_CALL(mock, StreamingRead)
@@ -273,6 +315,80 @@ TEST(ResumableStreamingReadRpc, PermanentFailureAtStart) {
   EXPECT_THAT(values, IsEmpty());
 }
 
+TEST(ResumableStreamingReadRpc, TracingSpans) {
+  testing_util::ScopedFakeRpcTracer fake;
+  MockStub mock;
+  EXPECT_CALL(mock, StreamingRead)
+      .WillOnce([](FakeRequest const&) {
+        EXPECT_NE(nullptr, CurrentRpcSpan());
+        auto stream = absl::make_unique<MockStreamingReadRpc>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(Return(AsReadReturn(FakeResponse{"value-0", "token-1"})))
+            .WillOnce(Return(TransientFailure()));
+        return stream;
+      })
+      .WillOnce([](FakeRequest const&) {
+        EXPECT_NE(nullptr, CurrentRpcSpan());
+        auto stream = absl::make_unique<MockStreamingReadRpc>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(Return(AsReadReturn(FakeResponse{"value-1", "token-2"})))
+            .WillOnce(Return(StreamSuccess()));
+        return stream;
+      });
+  auto reader = MakeResumableStreamingReadRpc<FakeResponse, FakeRequest>(
+      DefaultRetryPolicy(), DefaultBackoffPolicy(),
+      [](std::chrono::milliseconds) {},
+      [&mock](FakeRequest const& request) {
+        return mock.StreamingRead(request);
+      },
+      DefaultUpdater, FakeRequest{"test-key", {}});
+
+  for (;;) {
+    auto v = reader->Read();
+    if (absl::holds_alternative<FakeResponse>(v)) continue;
+    EXPECT_THAT(absl::get<Status>(std::move(v)), IsOk());
+    break;
+  }
+
+  auto const spans = fake.Spans();
+  ASSERT_EQ(3, spans.size());
+  EXPECT_EQ("ResumableStreamingReadRpc", spans[0].name);
+  EXPECT_TRUE(spans[0].ended);
+  EXPECT_THAT(spans[0].status, IsOk());
+  EXPECT_THAT(spans[0].events, ElementsAre("backoff"));
+  EXPECT_EQ("attempt", spans[1].name);
+  EXPECT_THAT(spans[1].status, StatusIs(StatusCode::kUnavailable));
+  EXPECT_EQ("attempt", spans[2].name);
+  EXPECT_THAT(spans[2].status, IsOk());
+}
+
+TEST(ResumableStreamingReadRpc, TracingDestroyedEarly) {
+  testing_util::ScopedFakeRpcTracer fake;
+  MockStub mock;
+  EXPECT_CALL(mock, StreamingRead).WillOnce([](FakeRequest const&) {
+    auto stream = absl::make_unique<MockStreamingReadRpc>();
+    EXPECT_CALL(*stream, Read)
+        .WillOnce(Return(AsReadReturn(FakeResponse{"value-0", "token-1"})));
+    return stream;
+  });
+  {
+    auto reader = MakeResumableStreamingReadRpc<FakeResponse, FakeRequest>(
+        DefaultRetryPolicy(), DefaultBackoffPolicy(),
+        [](std::chrono::milliseconds) {},
+        [&mock](FakeRequest const& request) {
+          return mock.StreamingRead(request);
+        },
+        DefaultUpdater, FakeRequest{"test-key", {}});
+    (void)reader->Read();
+  }
+  auto const spans = fake.Spans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_TRUE(spans[0].ended);
+  EXPECT_THAT(spans[0].status, StatusIs(StatusCode::kCancelled));
+  EXPECT_TRUE(spans[1].ended);
+  EXPECT_THAT(spans[1].status, StatusIs(StatusCode::kCancelled));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -16,9 +16,13 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RETRY_LOOP_H
 
 #include "google/cloud/backoff_policy.h"
+#include "google/cloud/internal/grpc_trace_context.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/retry_loop_helpers.h"
 #include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/internal/setup_context.h"
+#include "google/cloud/rpc_metrics.h"
+#include "google/cloud/rpc_tracing.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <grpcpp/grpcpp.h>
@@ -37,7 +41,8 @@ namespace internal {
  *
  * @param retry_policy controls the duration of the retry loop.
  * @param backoff_policy controls how the loop backsoff from a recoverable
- *     failure.
+ *     failure. Callers can pass a reference to the backoff policy prototype,
+ *     the loop only clones it if the operation needs to backoff.
  * @param idempotency if `Idempotency::kNonIdempotent`, the operation is not
  *     retried even on transient errors.
  * @param functor the operation to retry, typically a lambda that encapsulates
@@ -46,6 +51,8 @@ namespace internal {
  *     stack can set timeouts and metadata through this context.
  * @param request the parameters for the request.
  * @param location a string to annotate any error returned by this function.
+ * @param attempt_timeout the maximum duration of each attempt, zero means the
+ *     attempts are only limited by the @p retry_policy deadline, if any.
  * @tparam Functor the type of @p functor.
  * @tparam Request the type of @p request.
  * @tparam Sleeper a dependency injection point to verify (in tests) that the
@@ -59,22 +66,33 @@ template <typename Functor, typename Request, typename Sleeper,
                   Functor, grpc::ClientContext&, Request const&>::value,
               int>::type = 0>
 auto RetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
-                   std::unique_ptr<BackoffPolicy> backoff_policy,
+                   LazyBackoffPolicy backoff_policy,
                    Idempotency idempotency, Functor&& functor,
                    Request const& request, char const* location,
-                   Sleeper sleeper)
+                   Sleeper sleeper,
+                   std::chrono::milliseconds attempt_timeout =
+                       std::chrono::milliseconds(0))
     -> google::cloud::internal::invoke_result_t<Functor, grpc::ClientContext&,
                                                 Request const&> {
   Status last_status;
-  while (!retry_policy->IsExhausted()) {
+  RetryLoopTracer tracer(location);
+  for (int attempt = 0; !retry_policy->IsExhausted(); ++attempt) {
     // Need to create a new context for each retry.
     grpc::ClientContext context;
+    SetupAttemptDeadline(*retry_policy, context, attempt_timeout);
+    RetryAttemptScope scope(attempt);
+    auto span = tracer.StartAttempt(attempt);
+    RpcSpanScope span_scope(span.get());
+    InjectTraceContext(span.get(), context);
     auto result = functor(context, request);
+    tracer.EndAttempt(std::move(span), result);
     if (result.ok()) {
+      tracer.End(Status{});
       return result;
     }
     last_status = GetResultStatus(std::move(result));
     if (idempotency == Idempotency::kNonIdempotent) {
+      tracer.End(last_status);
       return RetryLoopError("Error in non-idempotent operation", location,
                             last_status);
     }
@@ -83,8 +101,11 @@ auto RetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
       // way, exit the loop.
       break;
     }
-    sleeper(backoff_policy->OnCompletion());
+    auto const delay = backoff_policy.OnCompletion();
+    tracer.Backoff(delay);
+    sleeper(delay);
   }
+  tracer.End(last_status);
   if (!retry_policy->IsExhausted()) {
     // The last error cannot be retried, but it is not because the retry
     // policy is exhausted, we call these "permanent errors", and they
@@ -101,15 +122,18 @@ template <typename Functor, typename Request,
                   Functor, grpc::ClientContext&, Request const&>::value,
               int>::type = 0>
 auto RetryLoop(std::unique_ptr<RetryPolicy> retry_policy,
-               std::unique_ptr<BackoffPolicy> backoff_policy,
+               LazyBackoffPolicy backoff_policy,
                Idempotency idempotency, Functor&& functor,
-               Request const& request, char const* location)
+               Request const& request, char const* location,
+               std::chrono::milliseconds attempt_timeout =
+                   std::chrono::milliseconds(0))
     -> google::cloud::internal::invoke_result_t<Functor, grpc::ClientContext&,
                                                 Request const&> {
   return RetryLoopImpl(
       std::move(retry_policy), std::move(backoff_policy), idempotency,
       std::forward<Functor>(functor), request, location,
-      [](std::chrono::milliseconds p) { std::this_thread::sleep_for(p); });
+      [](std::chrono::milliseconds p) { std::this_thread::sleep_for(p); },
+      attempt_timeout);
 }
 
 }  // namespace internal
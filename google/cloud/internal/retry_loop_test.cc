@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/internal/retry_loop.h"
+#include "google/cloud/testing_util/fake_rpc_tracer.h"
 #include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -83,6 +85,57 @@ TEST(RetryLoopTest, ReturnJustStatus) {
   EXPECT_STATUS_OK(actual);
 }
 
+TEST(RetryLoopTest, NoDeadlineByDefault) {
+  StatusOr<int> actual = RetryLoop(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      [](grpc::ClientContext& context, int request) {
+        EXPECT_EQ((std::chrono::system_clock::time_point::max)(),
+                  context.deadline());
+        return StatusOr<int>(2 * request);
+      },
+      42, "error message");
+  EXPECT_STATUS_OK(actual);
+}
+
+TEST(RetryLoopTest, DeadlineFromRetryPolicy) {
+  auto policy =
+      LimitedTimeRetryPolicy<TestRetryablePolicy>(std::chrono::minutes(5))
+          .clone();
+  auto const expected = policy->deadline();
+  StatusOr<int> actual = RetryLoop(
+      std::move(policy), TestBackoffPolicy(), Idempotency::kIdempotent,
+      [&](grpc::ClientContext& context, int request) {
+        // gRPC may round the deadline.
+        EXPECT_LE(context.deadline() - expected, std::chrono::milliseconds(1));
+        EXPECT_LE(expected - context.deadline(), std::chrono::milliseconds(1));
+        return StatusOr<int>(2 * request);
+      },
+      42, "error message");
+  EXPECT_STATUS_OK(actual);
+}
+
+TEST(RetryLoopTest, DeadlineFromAttemptTimeout) {
+  auto const attempt_timeout = std::chrono::seconds(10);
+  int counter = 0;
+  StatusOr<int> actual = RetryLoop(
+      LimitedTimeRetryPolicy<TestRetryablePolicy>(std::chrono::minutes(5))
+          .clone(),
+      TestBackoffPolicy(), Idempotency::kIdempotent,
+      [&](grpc::ClientContext& context, int request) {
+        // Each attempt gets a new deadline.
+        auto const now = std::chrono::system_clock::now();
+        EXPECT_LE(context.deadline(), now + attempt_timeout);
+        EXPECT_GT(context.deadline(), now + attempt_timeout / 2);
+        if (++counter < 3) {
+          return StatusOr<int>(Status(StatusCode::kUnavailable, "try again"));
+        }
+        return StatusOr<int>(2 * request);
+      },
+      42, "error message", attempt_timeout);
+  EXPECT_STATUS_OK(actual);
+  EXPECT_EQ(3, counter);
+}
+
 class MockBackoffPolicy : public BackoffPolicy {
  public:
   MOCK_METHOD(std::unique_ptr<BackoffPolicy>, clone, (), (const, override));
@@ -120,6 +173,42 @@ TEST(RetryLoopTest, UsesBackoffPolicy) {
               ElementsAre(ms(10), std::chrono::milliseconds(20), ms(30)));
 }
 
+/// @test Verify the backoff policy prototype is only cloned on failures.
+TEST(RetryLoopTest, ClonesBackoffPrototypeOnFailure) {
+  using ms = std::chrono::milliseconds;
+
+  MockBackoffPolicy prototype;
+  EXPECT_CALL(prototype, clone).WillOnce([] {
+    auto clone = absl::make_unique<MockBackoffPolicy>();
+    EXPECT_CALL(*clone, OnCompletion)
+        .WillOnce(Return(ms(10)))
+        .WillOnce(Return(ms(20)));
+    return std::unique_ptr<BackoffPolicy>(std::move(clone));
+  });
+
+  auto success = RetryLoop(
+      TestRetryPolicy(), prototype, Idempotency::kIdempotent,
+      [](grpc::ClientContext&, int request) {
+        return StatusOr<int>(2 * request);
+      },
+      42, "error message");
+  EXPECT_STATUS_OK(success);
+
+  int counter = 0;
+  std::vector<ms> sleep_for;
+  StatusOr<int> actual = RetryLoopImpl(
+      TestRetryPolicy(), prototype, Idempotency::kIdempotent,
+      [&counter](grpc::ClientContext&, int request) {
+        if (++counter <= 2) {
+          return StatusOr<int>(Status(StatusCode::kUnavailable, "try again"));
+        }
+        return StatusOr<int>(2 * request);
+      },
+      42, "error message", [&sleep_for](ms p) { sleep_for.push_back(p); });
+  EXPECT_STATUS_OK(actual);
+  EXPECT_THAT(sleep_for, ElementsAre(ms(10), ms(20)));
+}
+
 TEST(RetryLoopTest, TransientFailureNonIdempotent) {
   StatusOr<int> actual = RetryLoop(
       TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kNonIdempotent,
@@ -159,6 +248,55 @@ TEST(RetryLoopTest, TooManyTransientFailuresIdempotent) {
   EXPECT_THAT(actual.status().message(), HasSubstr("Retry policy exhausted"));
 }
 
+TEST(RetryLoopTest, TracingSpans) {
+  testing_util::ScopedFakeRpcTracer fake;
+  int counter = 0;
+  StatusOr<int> actual = RetryLoop(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      [&counter](grpc::ClientContext&, int request) {
+        EXPECT_NE(nullptr, CurrentRpcSpan());
+        EXPECT_EQ(counter, CurrentRetryAttempt());
+        if (++counter < 3) {
+          return StatusOr<int>(Status(StatusCode::kUnavailable, "try again"));
+        }
+        return StatusOr<int>(2 * request);
+      },
+      42, "test-location");
+  EXPECT_STATUS_OK(actual);
+  EXPECT_EQ(nullptr, CurrentRpcSpan());
+
+  auto const spans = fake.Spans();
+  ASSERT_EQ(4, spans.size());
+  EXPECT_EQ("test-location", spans[0].name);
+  EXPECT_TRUE(spans[0].ended);
+  EXPECT_STATUS_OK(spans[0].status);
+  EXPECT_THAT(spans[0].events, ElementsAre("backoff", "backoff"));
+  for (int i = 1; i != 4; ++i) {
+    EXPECT_EQ("attempt", spans[i].name);
+    EXPECT_EQ("test-location", spans[i].parent);
+    EXPECT_TRUE(spans[i].ended);
+  }
+  EXPECT_EQ(StatusCode::kUnavailable, spans[1].status.code());
+  EXPECT_STATUS_OK(spans[3].status);
+}
+
+TEST(RetryLoopTest, TracingPermanentError) {
+  testing_util::ScopedFakeRpcTracer fake;
+  StatusOr<int> actual = RetryLoop(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      [](grpc::ClientContext&, int) {
+        return StatusOr<int>(Status(StatusCode::kPermissionDenied, "uh oh"));
+      },
+      42, "test-location");
+  EXPECT_EQ(StatusCode::kPermissionDenied, actual.status().code());
+
+  auto const spans = fake.Spans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_TRUE(spans[0].ended);
+  EXPECT_EQ(StatusCode::kPermissionDenied, spans[0].status.code());
+  EXPECT_TRUE(spans[0].events.empty());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
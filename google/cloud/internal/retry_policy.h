@@ -65,6 +65,17 @@ class RetryPolicy {
   virtual bool IsExhausted() const = 0;
   virtual bool IsPermanentFailure(Status const&) const = 0;
   //@}
+
+  /**
+   * The time when the policy expires.
+   *
+   * The retry loops use this to set the deadline of each attempt, so the last
+   * attempt does not run past the policy's deadline. Policies that are not
+   * limited by time return `time_point::max()`.
+   */
+  virtual std::chrono::system_clock::time_point deadline() const {
+    return (std::chrono::system_clock::time_point::max)();
+  }
 };
 
 /**
@@ -194,7 +205,9 @@ class LimitedTimeRetryPolicy : public TraitBasedRetryPolicy<RetryablePolicy> {
     return std::chrono::system_clock::now() >= deadline_;
   }
 
-  std::chrono::system_clock::time_point deadline() const { return deadline_; }
+  std::chrono::system_clock::time_point deadline() const override {
+    return deadline_;
+  }
 
  protected:
   void OnFailureImpl() override {}
@@ -63,6 +63,24 @@ TEST(LimitedTimeRetryPolicy, Simple) {
   CheckLimitedTime(tested);
 }
 
+/// @test Verify the deadline is available through the base class.
+TEST(LimitedTimeRetryPolicy, Deadline) {
+  auto const start = std::chrono::system_clock::now();
+  std::unique_ptr<RetryPolicy> tested =
+      LimitedTimeRetryPolicyForTest(std::chrono::minutes(5)).clone();
+  EXPECT_GE(tested->deadline(), start + std::chrono::minutes(5));
+  EXPECT_LE(tested->deadline(),
+            std::chrono::system_clock::now() + std::chrono::minutes(5));
+}
+
+/// @test Verify that policies without a time limit have no deadline.
+TEST(LimitedErrorCountRetryPolicy, Deadline) {
+  std::unique_ptr<RetryPolicy> tested =
+      LimitedErrorCountRetryPolicyForTest(3).clone();
+  EXPECT_EQ((std::chrono::system_clock::time_point::max)(),
+            tested->deadline());
+}
+
 /// @test Test cloning for LimitedTimeRetryPolicy.
 TEST(LimitedTimeRetryPolicy, Clone) {
   LimitedTimeRetryPolicyForTest original(kLimitedTimeTestPeriod);
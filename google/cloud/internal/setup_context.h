@@ -18,6 +18,8 @@
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/version.h"
 #include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -38,6 +40,41 @@ struct SetupContext<Policy, void_t<decltype(std::declval<Policy>().Setup(
   }
 };
 
+/// Uses SFINAE to call Policy.deadline() when possible.
+template <typename Policy, typename = void>
+struct PolicyDeadline {
+  static std::chrono::system_clock::time_point Get(Policy const&) {
+    return (std::chrono::system_clock::time_point::max)();
+  }
+};
+
+template <typename Policy>
+struct PolicyDeadline<
+    Policy, void_t<decltype(std::declval<Policy const&>().deadline())>> {
+  static std::chrono::system_clock::time_point Get(Policy const& p) {
+    return p.deadline();
+  }
+};
+
+/**
+ * Sets the deadline for one attempt of a retry loop.
+ *
+ * The deadline is the earliest of the current deadline in @p context, the
+ * deadline of the retry policy, and @p attempt_timeout from now. An
+ * @p attempt_timeout of zero means the attempts have no individual timeout.
+ */
+template <typename Policy>
+void SetupAttemptDeadline(Policy const& policy, grpc::ClientContext& context,
+                          std::chrono::milliseconds attempt_timeout) {
+  auto const current = context.deadline();
+  auto deadline = (std::min)(current, PolicyDeadline<Policy>::Get(policy));
+  if (attempt_timeout.count() > 0) {
+    deadline = (std::min)(deadline,
+                          std::chrono::system_clock::now() + attempt_timeout);
+  }
+  if (deadline < current) context.set_deadline(deadline);
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -0,0 +1,239 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/small_object_pool.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+// The size classes are multiples of 16 bytes, so every block returned by
+// `::operator new` for a size class is suitably aligned for any object that
+// fits in it.
+std::size_t constexpr kSizeClasses[] = {32, 64, 128, 256};
+std::size_t constexpr kSizeClassCount =
+    sizeof(kSizeClasses) / sizeof(kSizeClasses[0]);
+
+// Bound the memory held by each thread. Blocks released beyond this limit are
+// moved to the shared depot, in batches of `kTransferBatchSize` blocks.
+std::size_t constexpr kMaxCachedBlocksPerClass = 256;
+std::size_t constexpr kTransferBatchSize = 64;
+
+// Bound the memory held by the shared depot. Batches released beyond this
+// limit are returned to the global allocator.
+std::size_t constexpr kMaxDepotBatchesPerClass = 32;
+
+std::size_t SizeClass(std::size_t size) {
+  for (std::size_t i = 0; i != kSizeClassCount; ++i) {
+    if (size <= kSizeClasses[i]) return i;
+  }
+  return kSizeClassCount;
+}
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct FreeList {
+  FreeBlock* head = nullptr;
+  std::size_t count = 0;
+};
+
+void DeleteBlocks(FreeBlock* head) {
+  while (head != nullptr) {
+    auto* block = head;
+    head = block->next;
+    ::operator delete(block);
+  }
+}
+
+/**
+ * Batches of free blocks shared by all threads.
+ *
+ * Blocks are often allocated in one thread and released in another, e.g., a
+ * `RunAsync()` callback is allocated by the application thread and released by
+ * the thread running the completion queue. Without the depot the releasing
+ * thread's cache fills up, while the allocating thread always misses its
+ * cache. Threads move whole batches to and from the depot, so the lock is
+ * acquired at most once every `kTransferBatchSize` operations.
+ */
+class Depot {
+ public:
+  void Push(std::size_t size_class, FreeList batch) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      auto& batches = batches_[size_class];
+      if (batches.size() < kMaxDepotBatchesPerClass) {
+        batches.push_back(batch);
+        return;
+      }
+    }
+    DeleteBlocks(batch.head);
+  }
+
+  FreeList Pop(std::size_t size_class) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto& batches = batches_[size_class];
+    if (batches.empty()) return FreeList{};
+    auto batch = batches.back();
+    batches.pop_back();
+    return batch;
+  }
+
+  std::size_t CachedBlocks() {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::size_t count = 0;
+    for (auto const& batches : batches_) {
+      for (auto const& b : batches) count += b.count;
+    }
+    return count;
+  }
+
+ private:
+  std::mutex mu_;
+  std::array<std::vector<FreeList>, kSizeClassCount> batches_;
+};
+
+// Threads may release blocks while the program is exiting, so the depot is
+// never deleted.
+Depot& GetDepot() {
+  static auto* const depot = new Depot;
+  return *depot;
+}
+
+class ThreadCache {
+ public:
+  ThreadCache() = default;
+  ThreadCache(ThreadCache const&) = delete;
+  ThreadCache& operator=(ThreadCache const&) = delete;
+  ~ThreadCache();
+
+  void* Allocate(std::size_t size_class) {
+    auto& list = lists_[size_class];
+    if (list.head == nullptr) list = GetDepot().Pop(size_class);
+    if (list.head == nullptr) return ::operator new(kSizeClasses[size_class]);
+    auto* block = list.head;
+    list.head = block->next;
+    --list.count;
+    return block;
+  }
+
+  void Deallocate(void* p, std::size_t size_class) {
+    auto& list = lists_[size_class];
+    if (list.count >= kMaxCachedBlocksPerClass) {
+      GetDepot().Push(size_class, SplitBatch(list));
+    }
+    list.head = new (p) FreeBlock{list.head};
+    ++list.count;
+  }
+
+  std::size_t CachedBlocks() const {
+    std::size_t count = 0;
+    for (auto const& l : lists_) count += l.count;
+    return count;
+  }
+
+ private:
+  // Remove the first `kTransferBatchSize` blocks from @p list.
+  static FreeList SplitBatch(FreeList& list) {
+    FreeList batch;
+    batch.head = list.head;
+    batch.count = kTransferBatchSize;
+    auto* last = list.head;
+    for (std::size_t i = 1; i != kTransferBatchSize; ++i) last = last->next;
+    list.head = last->next;
+    list.count -= kTransferBatchSize;
+    last->next = nullptr;
+    return batch;
+  }
+
+  std::array<FreeList, kSizeClassCount> lists_;
+};
+
+// Objects may be released while the thread is exiting, after the thread-local
+// cache is destroyed. This flag is trivially destructible, so it remains valid
+// until the thread terminates.
+thread_local bool cache_destroyed = false;
+
+ThreadCache::~ThreadCache() {
+  cache_destroyed = true;
+  for (std::size_t i = 0; i != kSizeClassCount; ++i) {
+    auto& l = lists_[i];
+    if (l.head != nullptr) GetDepot().Push(i, l);
+    l = FreeList{};
+  }
+}
+
+ThreadCache* GetThreadCache() {
+  if (cache_destroyed) return nullptr;
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+}  // namespace
+
+void* SmallObjectPoolAllocate(std::size_t size) {
+  auto const size_class = SizeClass(size);
+  if (size_class == kSizeClassCount) return ::operator new(size);
+  auto* cache = GetThreadCache();
+  if (cache == nullptr) return ::operator new(kSizeClasses[size_class]);
+  return cache->Allocate(size_class);
+}
+
+void SmallObjectPoolDeallocate(void* p, std::size_t size) noexcept {
+  if (p == nullptr) return;
+  auto const size_class = SizeClass(size);
+  auto* cache = size_class == kSizeClassCount ? nullptr : GetThreadCache();
+  if (cache == nullptr) {
+    ::operator delete(p);
+    return;
+  }
+  cache->Deallocate(p, size_class);
+}
+
+void* OverAlignedAllocate(std::size_t size, std::size_t alignment) {
+  // Reserve room to align the block, and to store the original pointer just
+  // before the aligned block.
+  auto const extra = alignment + sizeof(void*);
+  auto* raw = ::operator new(size + extra);
+  auto const base = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+  auto const aligned = (base + alignment - 1) & ~(alignment - 1);
+  auto* p = reinterpret_cast<void*>(aligned);
+  static_cast<void**>(p)[-1] = raw;
+  return p;
+}
+
+void OverAlignedDeallocate(void* p) noexcept {
+  if (p == nullptr) return;
+  ::operator delete(static_cast<void**>(p)[-1]);
+}
+
+std::size_t SmallObjectPoolCachedBlocks() {
+  auto* cache = GetThreadCache();
+  return cache == nullptr ? 0 : cache->CachedBlocks();
+}
+
+std::size_t SmallObjectPoolSharedBlocks() { return GetDepot().CachedBlocks(); }
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,120 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_SMALL_OBJECT_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_SMALL_OBJECT_POOL_H
+
+#include "google/cloud/version.h"
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Allocate @p size bytes from a per-thread pool of small blocks.
+ *
+ * Some objects in the library, such as the wrappers for
+ * `CompletionQueue::RunAsync()` callbacks, are allocated and released at a very
+ * high rate. These functions keep a small per-thread cache of released blocks,
+ * grouped in a few size classes, to amortize the cost of these allocations.
+ * When a thread's cache is full, or empty, blocks move in batches between the
+ * cache and a depot shared by all threads. Blocks released by one thread (say,
+ * a completion queue thread) are thus reused by the threads allocating them.
+ *
+ * Requests larger than the largest size class go directly to
+ * `::operator new`. The memory returned by this function must be released
+ * using `SmallObjectPoolDeallocate()` with the same @p size, but it can be
+ * released from any thread.
+ */
+void* SmallObjectPoolAllocate(std::size_t size);
+
+/// Release a block obtained via `SmallObjectPoolAllocate(size)`.
+void SmallObjectPoolDeallocate(void* p, std::size_t size) noexcept;
+
+/// The number of blocks cached by the calling thread, used in tests.
+std::size_t SmallObjectPoolCachedBlocks();
+
+/// The number of blocks in the shared depot, used in tests.
+std::size_t SmallObjectPoolSharedBlocks();
+
+/**
+ * Allocate @p size bytes aligned to @p alignment.
+ *
+ * The pool (like `::operator new` before C++17) only guarantees the alignment
+ * of `std::max_align_t`. Over-aligned objects are allocated with this function
+ * instead, which does not use the pool. @p alignment must be a power of two.
+ * The memory must be released using `OverAlignedDeallocate()`.
+ */
+void* OverAlignedAllocate(std::size_t size, std::size_t alignment);
+
+/// Release a block obtained via `OverAlignedAllocate()`.
+void OverAlignedDeallocate(void* p) noexcept;
+
+/**
+ * A minimal allocator using the small object pool.
+ *
+ * Use with `std::allocate_shared()` to create objects (and their control
+ * blocks) from the pool. Over-aligned types are allocated outside the pool,
+ * using `OverAlignedAllocate()`.
+ */
+template <typename T>
+class SmallObjectPoolAllocator {
+ public:
+  using value_type = T;
+
+  SmallObjectPoolAllocator() = default;
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  SmallObjectPoolAllocator(SmallObjectPoolAllocator<U> const&) {}
+
+  T* allocate(std::size_t n) {
+    if (OverAligned()) {
+      return static_cast<T*>(OverAlignedAllocate(n * sizeof(T), alignof(T)));
+    }
+    return static_cast<T*>(SmallObjectPoolAllocate(n * sizeof(T)));
+  }
+  void deallocate(T* p, std::size_t n) noexcept {
+    if (OverAligned()) {
+      OverAlignedDeallocate(p);
+      return;
+    }
+    SmallObjectPoolDeallocate(p, n * sizeof(T));
+  }
+
+ private:
+  static constexpr bool OverAligned() {
+    return alignof(T) > alignof(std::max_align_t);
+  }
+};
+
+template <typename T, typename U>
+bool operator==(SmallObjectPoolAllocator<T> const&,
+                SmallObjectPoolAllocator<U> const&) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(SmallObjectPoolAllocator<T> const&,
+                SmallObjectPoolAllocator<U> const&) {
+  return false;
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_SMALL_OBJECT_POOL_H
@@ -0,0 +1,131 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/small_object_pool.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+TEST(SmallObjectPool, ReusesBlocks) {
+  auto* p = SmallObjectPoolAllocate(48);
+  ASSERT_NE(p, nullptr);
+  std::memset(p, 0xAB, 48);
+  auto const cached = SmallObjectPoolCachedBlocks();
+  SmallObjectPoolDeallocate(p, 48);
+  EXPECT_EQ(cached + 1, SmallObjectPoolCachedBlocks());
+
+  // Any size in the same size class reuses the block.
+  auto* q = SmallObjectPoolAllocate(40);
+  EXPECT_EQ(p, q);
+  EXPECT_EQ(cached, SmallObjectPoolCachedBlocks());
+  SmallObjectPoolDeallocate(q, 40);
+}
+
+TEST(SmallObjectPool, LargeBlocksNotCached) {
+  auto const cached = SmallObjectPoolCachedBlocks();
+  auto* p = SmallObjectPoolAllocate(4096);
+  ASSERT_NE(p, nullptr);
+  std::memset(p, 0xAB, 4096);
+  SmallObjectPoolDeallocate(p, 4096);
+  EXPECT_EQ(cached, SmallObjectPoolCachedBlocks());
+}
+
+TEST(SmallObjectPool, CacheIsBounded) {
+  std::vector<void*> blocks(4096);
+  for (auto& b : blocks) b = SmallObjectPoolAllocate(100);
+  for (auto* b : blocks) SmallObjectPoolDeallocate(b, 100);
+  EXPECT_LT(SmallObjectPoolCachedBlocks(), blocks.size());
+}
+
+TEST(SmallObjectPool, ReleaseFromOtherThread) {
+  std::vector<void*> blocks(64);
+  for (auto& b : blocks) b = SmallObjectPoolAllocate(16);
+  std::size_t other_cached = 0;
+  std::thread t([&] {
+    for (auto* b : blocks) SmallObjectPoolDeallocate(b, 16);
+    other_cached = SmallObjectPoolCachedBlocks();
+  });
+  t.join();
+  EXPECT_EQ(blocks.size(), other_cached);
+}
+
+TEST(SmallObjectPool, ReuseAcrossThreads) {
+  // Allocate in one thread and release in another, as the completion queue
+  // does with `RunAsync()` callbacks. The blocks released beyond the releasing
+  // thread's cache must be available to the allocating thread.
+  std::vector<void*> blocks(4096);
+  std::thread allocator([&] {
+    for (auto& b : blocks) b = SmallObjectPoolAllocate(200);
+  });
+  allocator.join();
+  auto const shared = SmallObjectPoolSharedBlocks();
+  std::thread releaser([&] {
+    for (auto* b : blocks) SmallObjectPoolDeallocate(b, 200);
+  });
+  releaser.join();
+  EXPECT_GT(SmallObjectPoolSharedBlocks(), shared);
+
+  std::set<void*> released(blocks.begin(), blocks.end());
+  std::thread consumer([&] {
+    EXPECT_EQ(0U, SmallObjectPoolCachedBlocks());
+    auto* p = SmallObjectPoolAllocate(200);
+    EXPECT_GT(SmallObjectPoolCachedBlocks(), 0U);
+    EXPECT_EQ(1U, released.count(p));
+    SmallObjectPoolDeallocate(p, 200);
+  });
+  consumer.join();
+}
+
+struct alignas(64) OverAligned {
+  char data[8];
+};
+
+TEST(SmallObjectPool, AllocatorOverAligned) {
+  SmallObjectPoolAllocator<OverAligned> allocator;
+  std::vector<OverAligned*> blocks(16);
+  for (auto& b : blocks) {
+    b = allocator.allocate(1);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(b) % alignof(OverAligned));
+    std::memset(b, 0xAB, sizeof(OverAligned));
+  }
+  for (auto* b : blocks) allocator.deallocate(b, 1);
+}
+
+TEST(SmallObjectPool, AllocateSharedOverAligned) {
+  auto p = std::allocate_shared<OverAligned>(
+      SmallObjectPoolAllocator<OverAligned>{});
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p.get()) % 64);
+}
+
+TEST(SmallObjectPool, NullIsIgnored) {
+  auto const cached = SmallObjectPoolCachedBlocks();
+  SmallObjectPoolDeallocate(nullptr, 32);
+  EXPECT_EQ(cached, SmallObjectPoolCachedBlocks());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_STREAMING_READ_RPC_H
 
 #include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/arena_allocated.h"
 #include "google/cloud/status.h"
 #include "google/cloud/version.h"
 #include "absl/types/variant.h"
@@ -60,6 +61,27 @@ class StreamingReadRpc {
   /// Return the next element, or the final RPC status.
   virtual absl::variant<Status, ResponseType> Read() = 0;
 
+  /**
+   * Return the next element allocated in a `google::protobuf::Arena`, or the
+   * final RPC status.
+   *
+   * The returned pointer owns the arena, releasing the last copy of the
+   * pointer releases all the memory for the element at once. Large responses,
+   * with many strings and sub-messages, are much cheaper to release this way.
+   *
+   * The default implementation moves the result of `Read()` to the heap,
+   * decorators and implementations backed by gRPC streams override it.
+   */
+  virtual absl::variant<Status, std::shared_ptr<ResponseType const>>
+  ReadInArena() {
+    auto response = Read();
+    if (absl::holds_alternative<Status>(response)) {
+      return absl::get<Status>(std::move(response));
+    }
+    return std::shared_ptr<ResponseType const>(std::make_shared<ResponseType>(
+        absl::get<ResponseType>(std::move(response))));
+  }
+
   /**
    * Return the request metadata.
    *
@@ -105,6 +127,15 @@ class StreamingReadRpcImpl : public StreamingReadRpc<ResponseType> {
     return Finish();
   }
 
+  absl::variant<Status, std::shared_ptr<ResponseType const>> ReadInArena()
+      override {
+    auto response = MakeArenaAllocated<ResponseType>();
+    if (stream_->Read(response.get())) {
+      return std::shared_ptr<ResponseType const>(std::move(response));
+    }
+    return Finish();
+  }
+
   StreamingRpcMetadata GetRequestMetadata() const override {
     if (!context_) return {};
     return GetRequestMetadataFromContext(*context_);
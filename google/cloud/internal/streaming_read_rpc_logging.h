@@ -62,6 +62,15 @@ class StreamingReadRpcLogging : public StreamingReadRpc<ResponseType> {
                    << absl::visit(ResultVisitor(tracing_options_), result);
     return result;
   }
+  absl::variant<Status, std::shared_ptr<ResponseType const>> ReadInArena()
+      override {
+    auto const prefix = std::string(__func__) + "(" + request_id_ + ")";
+    GCP_LOG(DEBUG) << prefix << "() >> (void)";
+    auto result = reader_->ReadInArena();
+    GCP_LOG(DEBUG) << prefix << "() >> "
+                   << absl::visit(ResultVisitor(tracing_options_), result);
+    return result;
+  }
   StreamingRpcMetadata GetRequestMetadata() const override {
     auto metadata = reader_->GetRequestMetadata();
     GCP_LOG(DEBUG) << __func__ << "() >> metadata={" << FormatMetadata(metadata)
@@ -83,6 +92,10 @@ class StreamingReadRpcLogging : public StreamingReadRpc<ResponseType> {
     std::string operator()(ResponseType const& response) {
       return DebugString(response, tracing_options_);
     }
+    std::string operator()(
+        std::shared_ptr<ResponseType const> const& response) {
+      return DebugString(*response, tracing_options_);
+    }
 
    private:
     TracingOptions tracing_options_;
@@ -84,6 +84,39 @@ TEST(StreamingReadRpcImpl, SuccessfulStream) {
   EXPECT_THAT(values, ElementsAre("value-0", "value-1", "value-2"));
 }
 
+TEST(StreamingReadRpcImpl, SuccessfulStreamInArena) {
+  auto mock = absl::make_unique<MockReader>();
+  EXPECT_CALL(*mock, Read)
+      .WillOnce([](FakeResponse* r) {
+        r->value = "value-0";
+        return true;
+      })
+      .WillOnce([](FakeResponse* r) {
+        r->value = "value-1";
+        return true;
+      })
+      .WillOnce(Return(false));
+  EXPECT_CALL(*mock, Finish).WillOnce(Return(grpc::Status::OK));
+
+  StreamingReadRpcImpl<FakeResponse> impl(
+      absl::make_unique<grpc::ClientContext>(), std::move(mock));
+  using ArenaResponse = std::shared_ptr<FakeResponse const>;
+  std::vector<ArenaResponse> responses;
+  for (;;) {
+    auto v = impl.ReadInArena();
+    if (absl::holds_alternative<ArenaResponse>(v)) {
+      responses.push_back(absl::get<ArenaResponse>(std::move(v)));
+      continue;
+    }
+    EXPECT_THAT(absl::get<Status>(std::move(v)), IsOk());
+    break;
+  }
+  // Each response owns a separate arena, so they remain valid independently.
+  std::vector<std::string> values;
+  for (auto const& r : responses) values.push_back(r->value);
+  EXPECT_THAT(values, ElementsAre("value-0", "value-1"));
+}
+
 TEST(StreamingReadRpcImpl, EmptyStream) {
   auto mock = absl::make_unique<MockReader>();
   EXPECT_CALL(*mock, Read).WillOnce(Return(false));
@@ -0,0 +1,117 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/thread_affinity.h"
+#include "google/cloud/internal/strerror.h"
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#ifdef __linux__
+#include <sched.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+bool ParseCpu(std::string const& s, int& cpu) {
+  if (s.empty() || s.size() > 6) return false;
+  int v = 0;
+  for (auto c : s) {
+    if (c < '0' || c > '9') return false;
+    v = v * 10 + (c - '0');
+  }
+  cpu = v;
+  return true;
+}
+
+Status InvalidCpuList(std::string const& list) {
+  return Status(StatusCode::kInvalidArgument,
+                "invalid CPU list <" + list + ">");
+}
+
+}  // namespace
+
+StatusOr<std::vector<int>> ParseCpuList(std::string const& list) {
+  std::vector<int> cpus;
+  std::istringstream is(list);
+  std::string range;
+  while (std::getline(is, range, ',')) {
+    // Tolerate the trailing newline in the sysfs files.
+    while (!range.empty() && (range.back() == '\n' || range.back() == ' ')) {
+      range.pop_back();
+    }
+    if (range.empty()) continue;
+    auto const dash = range.find('-');
+    int lo;
+    int hi;
+    if (dash == std::string::npos) {
+      if (!ParseCpu(range, lo)) return InvalidCpuList(list);
+      hi = lo;
+    } else if (!ParseCpu(range.substr(0, dash), lo) ||
+               !ParseCpu(range.substr(dash + 1), hi) || hi < lo) {
+      return InvalidCpuList(list);
+    }
+    for (int cpu = lo; cpu <= hi; ++cpu) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+StatusOr<std::vector<int>> NumaNodeCpus(int node) {
+#ifdef __linux__
+  auto const path = "/sys/devices/system/node/node" + std::to_string(node) +
+                    "/cpulist";
+  std::ifstream is(path);
+  std::string list;
+  if (!is || !std::getline(is, list)) {
+    return Status(StatusCode::kNotFound,
+                  "cannot read NUMA node CPU list from " + path);
+  }
+  return ParseCpuList(list);
+#else
+  return Status(StatusCode::kUnimplemented,
+                "NUMA topology is not available on this platform, node=" +
+                    std::to_string(node));
+#endif  // __linux__
+}
+
+Status SetCurrentThreadAffinity(std::vector<int> const& cpus) {
+  if (cpus.empty()) return Status{};
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return Status(StatusCode::kInvalidArgument,
+                    "CPU id out of range: " + std::to_string(cpu));
+    }
+    CPU_SET(cpu, &set);
+  }
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    return Status(StatusCode::kInvalidArgument,
+                  "sched_setaffinity() failed: " + strerror(errno));
+  }
+  return Status{};
+#else
+  return Status(StatusCode::kUnimplemented,
+                "thread affinity is not supported on this platform");
+#endif  // __linux__
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,57 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_THREAD_AFFINITY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_THREAD_AFFINITY_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Parses a Linux CPU list, e.g. "0-3,8,10-11".
+ *
+ * This is the format used in `/sys/devices/system/node/nodeN/cpulist` and
+ * by tools such as `taskset -c`.
+ */
+StatusOr<std::vector<int>> ParseCpuList(std::string const& list);
+
+/**
+ * Returns the CPUs attached to NUMA node @p node.
+ *
+ * Returns an error on platforms where the NUMA topology is not available.
+ */
+StatusOr<std::vector<int>> NumaNodeCpus(int node);
+
+/**
+ * Restricts the calling thread to run on the CPUs in @p cpus.
+ *
+ * An empty set is a no-op. Returns an error on platforms without support for
+ * thread affinity, or if the operating system rejects the CPU set.
+ */
+Status SetCurrentThreadAffinity(std::vector<int> const& cpus);
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_THREAD_AFFINITY_H
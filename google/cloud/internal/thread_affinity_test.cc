@@ -0,0 +1,102 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/thread_affinity.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <thread>
+#ifdef __linux__
+#include <sched.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+
+TEST(ThreadAffinity, ParseCpuList) {
+  struct Test {
+    std::string list;
+    std::vector<int> expected;
+  } cases[] = {
+      {"", {}},
+      {"0", {0}},
+      {"0-3", {0, 1, 2, 3}},
+      {"0-1,4,6-7", {0, 1, 4, 6, 7}},
+      {"2,3\n", {2, 3}},
+  };
+  for (auto const& t : cases) {
+    SCOPED_TRACE("Testing with " + t.list);
+    auto actual = ParseCpuList(t.list);
+    ASSERT_STATUS_OK(actual);
+    EXPECT_EQ(t.expected, *actual);
+  }
+}
+
+TEST(ThreadAffinity, ParseCpuListInvalid) {
+  for (std::string list : {"a", "1-", "-1", "3-1", "1,,x", "0-1-2"}) {
+    SCOPED_TRACE("Testing with " + list);
+    EXPECT_THAT(ParseCpuList(list), StatusIs(StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(ThreadAffinity, NumaNodeNotFound) {
+  auto actual = NumaNodeCpus(-1);
+  EXPECT_FALSE(actual.ok());
+}
+
+TEST(ThreadAffinity, EmptyIsNoop) {
+  EXPECT_STATUS_OK(SetCurrentThreadAffinity({}));
+}
+
+#ifdef __linux__
+TEST(ThreadAffinity, SetCurrentThread) {
+  // Pick one of the CPUs the process is allowed to run on.
+  cpu_set_t set;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(set), &set));
+  int cpu = 0;
+  while (cpu != CPU_SETSIZE && !CPU_ISSET(cpu, &set)) ++cpu;
+  ASSERT_NE(CPU_SETSIZE, cpu);
+
+  std::thread t([cpu] {
+    ASSERT_STATUS_OK(SetCurrentThreadAffinity({cpu}));
+    cpu_set_t actual;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(actual), &actual));
+    EXPECT_EQ(1, CPU_COUNT(&actual));
+    EXPECT_TRUE(CPU_ISSET(cpu, &actual));
+  });
+  t.join();
+}
+
+TEST(ThreadAffinity, SetCurrentThreadOutOfRange) {
+  EXPECT_THAT(SetCurrentThreadAffinity({-1}),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(SetCurrentThreadAffinity({CPU_SETSIZE}),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+#else
+TEST(ThreadAffinity, Unimplemented) {
+  EXPECT_THAT(SetCurrentThreadAffinity({0}),
+              StatusIs(StatusCode::kUnimplemented));
+}
+#endif  // __linux__
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
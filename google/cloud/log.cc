@@ -194,6 +194,47 @@ LogSink::CopyBackends() {
 }
 
 namespace internal {
+namespace {
+
+struct ThreadLogStream {
+  ThreadLogStream() : in_use(false) {}
+  ~ThreadLogStream();
+
+  std::ostringstream os;
+  bool in_use;
+};
+
+// Log lines may appear in the destructors of other thread-local objects, after
+// the stream is destroyed. This flag is trivially destructible, so it remains
+// usable until the very end of the thread.
+thread_local bool thread_log_stream_destroyed = false;
+
+ThreadLogStream::~ThreadLogStream() { thread_log_stream_destroyed = true; }
+
+ThreadLogStream& GetThreadLogStream() {
+  thread_local ThreadLogStream stream;
+  return stream;
+}
+
+}  // namespace
+
+std::ostringstream* AcquireThreadLogStream() {
+  if (thread_log_stream_destroyed) return nullptr;
+  auto& stream = GetThreadLogStream();
+  if (stream.in_use) return nullptr;
+  stream.in_use = true;
+  return &stream.os;
+}
+
+void ReleaseThreadLogStream(std::ostringstream* os) {
+  // Keep the buffer capacity, but reset any state set by the last message.
+  static auto const* const kDefaultFormat = new std::ostringstream;
+  os->str(std::string{});
+  os->clear();
+  os->copyfmt(*kDefaultFormat);
+  if (thread_log_stream_destroyed) return;
+  GetThreadLogStream().in_use = false;
+}
 
 std::shared_ptr<LogBackend> DefaultLogBackend() {
   auto constexpr kLogConfig = "GOOGLE_CLOUD_CPP_EXPERIMENTAL_LOG_CONFIG";
@@ -212,6 +253,20 @@ std::shared_ptr<LogBackend> DefaultLogBackend() {
             std::make_shared<StdClogBackend>(min_severity));
       }
     }
+    if (fields[0] == "async" && (fields.size() == 2 || fields.size() == 3)) {
+      auto size = ParseSize(fields[1]);
+      auto policy = AsyncBackend::OverflowPolicy::kDropNewest;
+      auto valid_policy = true;
+      if (fields.size() == 3) {
+        valid_policy = fields[2] == "drop" || fields[2] == "block";
+        if (fields[2] == "block") policy = AsyncBackend::OverflowPolicy::kBlock;
+      }
+      if (size.has_value() && valid_policy) {
+        return std::make_shared<AsyncBackend>(
+            *size, policy, Severity::GCP_LS_CRITICAL,
+            std::make_shared<StdClogBackend>(min_severity));
+      }
+    }
     if (fields[0] == "clog" && fields.size() == 1) {
       return std::make_shared<StdClogBackend>(min_severity);
     }
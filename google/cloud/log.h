@@ -165,6 +165,13 @@ inline namespace GOOGLE_CLOUD_CPP_NS {
 #define GCP_LOG(level) \
   GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_##level, ::google::cloud::LogSink::Instance())
 
+/**
+ * The lowest severity compiled in, `GCP_LOG()` lines below it are removed.
+ *
+ * CMake builds can set this with `-DGOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY=INFO`
+ * (or any other severity name). The definition is part of the public compile
+ * flags of the library, so applications use the same value.
+ */
 #ifndef GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY_ENABLED
 #define GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY_ENABLED GCP_LS_DEBUG
 #endif  // GOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY_ENABLED
@@ -372,6 +379,22 @@ struct NullStream {
   }
 };
 
+namespace internal {
+/**
+ * Returns the calling thread's stream to format log messages.
+ *
+ * Formatting each log message into a new `std::ostringstream` requires at
+ * least one heap allocation for the stream and more as the message grows.
+ * Instead, each thread reuses a single stream, keeping its buffer across
+ * messages. Returns `nullptr` if the stream is already in use, for example,
+ * when a streaming operator logs, or while the thread is exiting.
+ */
+std::ostringstream* AcquireThreadLogStream();
+
+/// Resets @p os and releases it for the next message in this thread.
+void ReleaseThreadLogStream(std::ostringstream* os);
+}  // namespace internal
+
 /**
  * Define the class to capture a log message.
  *
@@ -391,6 +414,9 @@ class Logger {
         lineno_(lineno) {}
 
   ~Logger() {
+    if (stream_ != nullptr && !owned_) {
+      internal::ReleaseThreadLogStream(stream_);
+    }
     if (severity_ >= Severity::GCP_LS_FATAL) std::abort();
   }
 
@@ -398,7 +424,7 @@ class Logger {
 
   /// Send the log record captured by this object to @p sink.
   void LogTo(LogSink& sink) {
-    if (!stream_ || !enabled_) {
+    if (stream_ == nullptr || !enabled_) {
       return;
     }
     enabled_ = false;
@@ -415,8 +441,12 @@ class Logger {
 
   /// Return the iostream that captures the log message.
   std::ostream& Stream() {
-    if (!stream_) {
-      stream_.reset(new std::ostringstream);
+    if (stream_ == nullptr) {
+      stream_ = internal::AcquireThreadLogStream();
+    }
+    if (stream_ == nullptr) {
+      owned_.reset(new std::ostringstream);
+      stream_ = owned_.get();
     }
     return *stream_;
   }
@@ -427,7 +457,8 @@ class Logger {
   char const* function_;
   char const* filename_;
   int lineno_;
-  std::unique_ptr<std::ostringstream> stream_;
+  std::ostringstream* stream_ = nullptr;
+  std::unique_ptr<std::ostringstream> owned_;
 };
 
 /**
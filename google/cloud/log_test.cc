@@ -16,7 +16,10 @@
 #include "google/cloud/testing_util/scoped_environment.h"
 #include <gmock/gmock.h>
 #include <chrono>
+#include <iomanip>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -24,6 +27,7 @@ inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace {
 
 using ::google::cloud::testing_util::ScopedEnvironment;
+using ::testing::ElementsAre;
 using ::testing::ExitedWithCode;
 using ::testing::HasSubstr;
 
@@ -117,6 +121,47 @@ TEST(LogSinkTest, LogEnabled) {
   GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, sink) << "test message";
 }
 
+TEST(LogSinkTest, ReusedStreamResetsState) {
+  LogSink sink;
+  auto backend = std::make_shared<MockLogBackend>();
+  std::vector<std::string> messages;
+  EXPECT_CALL(*backend, ProcessWithOwnership)
+      .WillRepeatedly(
+          [&messages](LogRecord const& lr) { messages.push_back(lr.message); });
+  sink.AddBackend(backend);
+
+  GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, sink)
+      << std::hex << std::setw(8) << std::setfill('*') << 255 << " "
+      << std::string(128, 'a');
+  GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, sink) << 255;
+  EXPECT_THAT(messages,
+              ElementsAre("******ff " + std::string(128, 'a'), "255"));
+}
+
+struct LogsWhenStreamed {
+  LogSink* sink;
+};
+
+std::ostream& operator<<(std::ostream& os, LogsWhenStreamed const& rhs) {
+  GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, *rhs.sink) << "inner message";
+  return os << "outer value";
+}
+
+TEST(LogSinkTest, NestedLogs) {
+  LogSink sink;
+  auto backend = std::make_shared<MockLogBackend>();
+  std::vector<std::string> messages;
+  EXPECT_CALL(*backend, ProcessWithOwnership)
+      .WillRepeatedly(
+          [&messages](LogRecord const& lr) { messages.push_back(lr.message); });
+  sink.AddBackend(backend);
+
+  GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, sink)
+      << "outer message: " << LogsWhenStreamed{&sink};
+  EXPECT_THAT(messages,
+              ElementsAre("inner message", "outer message: outer value"));
+}
+
 TEST(LogSinkTest, LogEnabledMultipleBackends) {
   LogSink sink;
   auto be1 = std::make_shared<MockLogBackend>();
@@ -20,9 +20,14 @@ google_cloud_cpp_logging_hdrs = [
     "internal/logging_service_v2_auth_decorator.h",
     "internal/logging_service_v2_logging_decorator.h",
     "internal/logging_service_v2_metadata_decorator.h",
+    "internal/logging_service_v2_metrics_decorator.h",
     "internal/logging_service_v2_option_defaults.h",
+    "internal/logging_service_v2_round_robin_decorator.h",
     "internal/logging_service_v2_stub.h",
     "internal/logging_service_v2_stub_factory.h",
+    "log_entry_batcher.h",
+    "log_entry_page_reader.h",
+    "log_entry_tail.h",
     "logging_service_v2_client.h",
     "logging_service_v2_connection.h",
     "logging_service_v2_connection_idempotency_policy.h",
@@ -34,9 +39,14 @@ google_cloud_cpp_logging_srcs = [
     "internal/logging_service_v2_auth_decorator.cc",
     "internal/logging_service_v2_logging_decorator.cc",
     "internal/logging_service_v2_metadata_decorator.cc",
+    "internal/logging_service_v2_metrics_decorator.cc",
     "internal/logging_service_v2_option_defaults.cc",
+    "internal/logging_service_v2_round_robin_decorator.cc",
     "internal/logging_service_v2_stub.cc",
     "internal/logging_service_v2_stub_factory.cc",
+    "log_entry_batcher.cc",
+    "log_entry_page_reader.cc",
+    "log_entry_tail.cc",
     "logging_service_v2_client.cc",
     "logging_service_v2_connection.cc",
     "logging_service_v2_connection_idempotency_policy.cc",
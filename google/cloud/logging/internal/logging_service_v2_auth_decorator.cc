@@ -73,6 +73,39 @@ StatusOr<google::logging::v2::ListLogsResponse> LoggingServiceV2Auth::ListLogs(
   if (!status.ok()) return status;
   return child_->ListLogs(context, request);
 }
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::logging::v2::TailLogEntriesRequest,
+    google::logging::v2::TailLogEntriesResponse>>
+LoggingServiceV2Auth::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  using ErrorStream = google::cloud::internal::AsyncStreamingReadWriteRpcError<
+      google::logging::v2::TailLogEntriesRequest,
+      google::logging::v2::TailLogEntriesResponse>;
+  auto status = auth_->ConfigureContext(*context);
+  if (!status.ok()) return absl::make_unique<ErrorStream>(std::move(status));
+  return child_->AsyncTailLogEntries(cq, std::move(context));
+}
+
+future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+LoggingServiceV2Auth::AsyncListLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::logging::v2::ListLogEntriesRequest const& request) {
+  using ReturnType = StatusOr<google::logging::v2::ListLogEntriesResponse>;
+  auto child = child_;
+  return auth_->AsyncConfigureContext(std::move(context))
+      .then([cq, child,
+             request](future<StatusOr<std::unique_ptr<grpc::ClientContext>>>
+                          f) mutable {
+        auto context = f.get();
+        if (!context) {
+          return make_ready_future(ReturnType(std::move(context).status()));
+        }
+        return child->AsyncListLogEntries(cq, *std::move(context), request);
+      });
+}
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
 }  // namespace logging_internal
 }  // namespace cloud
@@ -60,6 +60,18 @@ class LoggingServiceV2Auth : public LoggingServiceV2Stub {
       grpc::ClientContext& context,
       google::logging::v2::ListLogsRequest const& request) override;
 
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::logging::v2::TailLogEntriesRequest,
+      google::logging::v2::TailLogEntriesResponse>>
+  AsyncTailLogEntries(google::cloud::CompletionQueue& cq,
+                      std::unique_ptr<grpc::ClientContext> context) override;
+
+  future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+  AsyncListLogEntries(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::logging::v2::ListLogEntriesRequest const& request) override;
+
  private:
   std::shared_ptr<google::cloud::internal::GrpcAuthenticationStrategy> auth_;
   std::shared_ptr<LoggingServiceV2Stub> child_;
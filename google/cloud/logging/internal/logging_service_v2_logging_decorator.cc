@@ -94,6 +94,32 @@ LoggingServiceV2Logging::ListLogs(
       context, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::logging::v2::TailLogEntriesRequest,
+    google::logging::v2::TailLogEntriesResponse>>
+LoggingServiceV2Logging::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  GCP_LOG(DEBUG) << __func__ << "() << (void)";
+  auto stream = child_->AsyncTailLogEntries(cq, std::move(context));
+  GCP_LOG(DEBUG) << __func__ << "() >> " << (stream ? "not null" : "null");
+  return stream;
+}
+
+future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+LoggingServiceV2Logging::AsyncListLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::logging::v2::ListLogEntriesRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::logging::v2::ListLogEntriesRequest const& request) {
+        return child_->AsyncListLogEntries(cq, std::move(context), request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
 }  // namespace logging_internal
 }  // namespace cloud
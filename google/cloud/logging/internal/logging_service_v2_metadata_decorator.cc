@@ -17,6 +17,7 @@
 // source: google/logging/v2/logging.proto
 #include "google/cloud/logging/internal/logging_service_v2_metadata_decorator.h"
 #include "google/cloud/internal/api_client_header.h"
+#include "google/cloud/internal/grpc_trace_context.h"
 #include "google/cloud/status_or.h"
 #include <google/logging/v2/logging.grpc.pb.h>
 #include <memory>
@@ -42,7 +43,7 @@ StatusOr<google::logging::v2::WriteLogEntriesResponse>
 LoggingServiceV2Metadata::WriteLogEntries(
     grpc::ClientContext& context,
     google::logging::v2::WriteLogEntriesRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->WriteLogEntries(context, request);
 }
 
@@ -50,7 +51,7 @@ StatusOr<google::logging::v2::ListLogEntriesResponse>
 LoggingServiceV2Metadata::ListLogEntries(
     grpc::ClientContext& context,
     google::logging::v2::ListLogEntriesRequest const& request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->ListLogEntries(context, request);
 }
 
@@ -59,7 +60,7 @@ LoggingServiceV2Metadata::ListMonitoredResourceDescriptors(
     grpc::ClientContext& context,
     google::logging::v2::ListMonitoredResourceDescriptorsRequest const&
         request) {
-  SetMetadata(context, {});
+  SetMetadata(context);
   return child_->ListMonitoredResourceDescriptors(context, request);
 }
 
@@ -71,10 +72,36 @@ LoggingServiceV2Metadata::ListLogs(
   return child_->ListLogs(context, request);
 }
 
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::logging::v2::TailLogEntriesRequest,
+    google::logging::v2::TailLogEntriesResponse>>
+LoggingServiceV2Metadata::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  SetMetadata(*context);
+  internal::InjectTraceContext(*context);
+  return child_->AsyncTailLogEntries(cq, std::move(context));
+}
+
+future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+LoggingServiceV2Metadata::AsyncListLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::logging::v2::ListLogEntriesRequest const& request) {
+  SetMetadata(*context);
+  return child_->AsyncListLogEntries(cq, std::move(context), request);
+}
+
 void LoggingServiceV2Metadata::SetMetadata(grpc::ClientContext& context,
                                            std::string const& request_params) {
-  context.AddMetadata("x-goog-request-params", request_params);
-  context.AddMetadata("x-goog-api-client", api_client_header_);
+  context.AddMetadata(google::cloud::internal::RequestParamsKey(),
+                      request_params);
+  SetMetadata(context);
+}
+
+void LoggingServiceV2Metadata::SetMetadata(grpc::ClientContext& context) {
+  context.AddMetadata(google::cloud::internal::ApiClientHeaderKey(),
+                      api_client_header_);
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
@@ -0,0 +1,81 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/logging/v2/logging.proto
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_INTERNAL_LOGGING_SERVICE_V2_METRICS_DECORATOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_INTERNAL_LOGGING_SERVICE_V2_METRICS_DECORATOR_H
+
+#include "google/cloud/logging/internal/logging_service_v2_stub.h"
+#include "google/cloud/rpc_metrics.h"
+#include "google/cloud/version.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace logging_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+class LoggingServiceV2Metrics : public LoggingServiceV2Stub {
+ public:
+  ~LoggingServiceV2Metrics() override = default;
+  LoggingServiceV2Metrics(std::shared_ptr<LoggingServiceV2Stub> child,
+                          std::shared_ptr<RpcMetrics> metrics);
+
+  Status DeleteLog(
+      grpc::ClientContext& context,
+      google::logging::v2::DeleteLogRequest const& request) override;
+
+  StatusOr<google::logging::v2::WriteLogEntriesResponse> WriteLogEntries(
+      grpc::ClientContext& context,
+      google::logging::v2::WriteLogEntriesRequest const& request) override;
+
+  StatusOr<google::logging::v2::ListLogEntriesResponse> ListLogEntries(
+      grpc::ClientContext& context,
+      google::logging::v2::ListLogEntriesRequest const& request) override;
+
+  StatusOr<google::logging::v2::ListMonitoredResourceDescriptorsResponse>
+  ListMonitoredResourceDescriptors(
+      grpc::ClientContext& context,
+      google::logging::v2::ListMonitoredResourceDescriptorsRequest const&
+          request) override;
+
+  StatusOr<google::logging::v2::ListLogsResponse> ListLogs(
+      grpc::ClientContext& context,
+      google::logging::v2::ListLogsRequest const& request) override;
+
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::logging::v2::TailLogEntriesRequest,
+      google::logging::v2::TailLogEntriesResponse>>
+  AsyncTailLogEntries(google::cloud::CompletionQueue& cq,
+                      std::unique_ptr<grpc::ClientContext> context) override;
+
+  future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+  AsyncListLogEntries(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::logging::v2::ListLogEntriesRequest const& request) override;
+
+ private:
+  std::shared_ptr<LoggingServiceV2Stub> child_;
+  std::shared_ptr<RpcMetrics> metrics_;
+};  // LoggingServiceV2Metrics
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_INTERNAL_LOGGING_SERVICE_V2_METRICS_DECORATOR_H
@@ -0,0 +1,111 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/logging/v2/logging.proto
+#include "google/cloud/logging/internal/logging_service_v2_round_robin_decorator.h"
+#include "google/cloud/status_or.h"
+#include <google/logging/v2/logging.grpc.pb.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace logging_internal {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+LoggingServiceV2RoundRobin::LoggingServiceV2RoundRobin(
+    std::vector<std::shared_ptr<LoggingServiceV2Stub>> children,
+    std::shared_ptr<google::cloud::internal::ChannelPicker> picker)
+    : children_(std::move(children)), picker_(std::move(picker)) {}
+
+Status LoggingServiceV2RoundRobin::DeleteLog(
+    grpc::ClientContext& context,
+    google::logging::v2::DeleteLogRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->DeleteLog(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::logging::v2::WriteLogEntriesResponse>
+LoggingServiceV2RoundRobin::WriteLogEntries(
+    grpc::ClientContext& context,
+    google::logging::v2::WriteLogEntriesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->WriteLogEntries(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::logging::v2::ListLogEntriesResponse>
+LoggingServiceV2RoundRobin::ListLogEntries(
+    grpc::ClientContext& context,
+    google::logging::v2::ListLogEntriesRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListLogEntries(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::logging::v2::ListMonitoredResourceDescriptorsResponse>
+LoggingServiceV2RoundRobin::ListMonitoredResourceDescriptors(
+    grpc::ClientContext& context,
+    google::logging::v2::ListMonitoredResourceDescriptorsRequest const&
+        request) {
+  auto const index = picker_->Acquire();
+  auto result =
+      children_[index]->ListMonitoredResourceDescriptors(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+StatusOr<google::logging::v2::ListLogsResponse>
+LoggingServiceV2RoundRobin::ListLogs(
+    grpc::ClientContext& context,
+    google::logging::v2::ListLogsRequest const& request) {
+  auto const index = picker_->Acquire();
+  auto result = children_[index]->ListLogs(context, request);
+  picker_->Release(index);
+  return result;
+}
+
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::logging::v2::TailLogEntriesRequest,
+    google::logging::v2::TailLogEntriesResponse>>
+LoggingServiceV2RoundRobin::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  auto const index = picker_->Acquire();
+  auto stream = children_[index]->AsyncTailLogEntries(cq, std::move(context));
+  picker_->Release(index);
+  return stream;
+}
+
+future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+LoggingServiceV2RoundRobin::AsyncListLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::logging::v2::ListLogEntriesRequest const& request) {
+  auto const index = picker_->Acquire();
+  return google::cloud::internal::ReleaseOnCompletion(
+      picker_, index,
+      children_[index]->AsyncListLogEntries(cq, std::move(context), request));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging_internal
+}  // namespace cloud
+}  // namespace google
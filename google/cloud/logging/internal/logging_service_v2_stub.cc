@@ -91,6 +91,35 @@ DefaultLoggingServiceV2Stub::ListLogs(
   return response;
 }
 
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::logging::v2::TailLogEntriesRequest,
+    google::logging::v2::TailLogEntriesResponse>>
+DefaultLoggingServiceV2Stub::AsyncTailLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context) {
+  return internal::MakeStreamingReadWriteRpc<
+      google::logging::v2::TailLogEntriesRequest,
+      google::logging::v2::TailLogEntriesResponse>(
+      cq, std::move(client_context),
+      [this](grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+        return grpc_stub_->PrepareAsyncTailLogEntries(context, cq);
+      });
+}
+
+future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+DefaultLoggingServiceV2Stub::AsyncListLogEntries(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::logging::v2::ListLogEntriesRequest const& request) {
+  return cq.MakeUnaryRpc(
+      [this](grpc::ClientContext* context,
+             google::logging::v2::ListLogEntriesRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return grpc_stub_->AsyncListLogEntries(context, request, cq);
+      },
+      request, std::move(context));
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
 }  // namespace logging_internal
 }  // namespace cloud
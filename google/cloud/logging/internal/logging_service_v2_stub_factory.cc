@@ -20,13 +20,19 @@
 #include "google/cloud/logging/internal/logging_service_v2_auth_decorator.h"
 #include "google/cloud/logging/internal/logging_service_v2_logging_decorator.h"
 #include "google/cloud/logging/internal/logging_service_v2_metadata_decorator.h"
+#include "google/cloud/logging/internal/logging_service_v2_metrics_decorator.h"
+#include "google/cloud/logging/internal/logging_service_v2_round_robin_decorator.h"
 #include "google/cloud/logging/internal/logging_service_v2_stub.h"
 #include "google/cloud/common_options.h"
+#include "google/cloud/grpc_channel_registry.h"
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/algorithm.h"
+#include "google/cloud/internal/channel_picker.h"
 #include "google/cloud/log.h"
 #include "google/cloud/options.h"
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -44,13 +50,28 @@ std::shared_ptr<LoggingServiceV2Stub> CreateDefaultLoggingServiceV2Stub(
     return google::cloud::internal::CreateAuthenticationStrategy(
         options.get<google::cloud::GrpcCredentialOption>());
   }();
-  auto channel = auth->CreateChannel(options.get<EndpointOption>(),
-                                     internal::MakeChannelArguments(options));
-  auto service_grpc_stub =
-      google::logging::v2::LoggingServiceV2::NewStub(channel);
-  std::shared_ptr<LoggingServiceV2Stub> stub =
-      std::make_shared<DefaultLoggingServiceV2Stub>(
-          std::move(service_grpc_stub));
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  std::vector<std::shared_ptr<LoggingServiceV2Stub>> children;
+  auto const num_channels = (std::max)(1, options.get<GrpcNumChannelsOption>());
+  for (int id = 0; id != num_channels; ++id) {
+    auto arguments = internal::MakeChannelArguments(options);
+    // Use a different channel id, so gRPC does not share connections.
+    arguments.SetInt("grpc.channel_id", id);
+    auto channel = internal::CreateSharedChannel(options, arguments, [&] {
+      return auth->CreateChannel(options.get<EndpointOption>(), arguments);
+    });
+    children.push_back(std::make_shared<DefaultLoggingServiceV2Stub>(
+        google::logging::v2::LoggingServiceV2::NewStub(channel)));
+    channels.push_back(std::move(channel));
+  }
+  std::shared_ptr<LoggingServiceV2Stub> stub;
+  if (children.size() == 1) {
+    stub = std::move(children.front());
+  } else {
+    stub = std::make_shared<LoggingServiceV2RoundRobin>(
+        std::move(children),
+        google::cloud::internal::MakeChannelPicker(channels, options));
+  }
 
   if (auth->RequiresConfigureContext()) {
     stub = std::make_shared<LoggingServiceV2Auth>(std::move(auth),
@@ -63,6 +84,12 @@ std::shared_ptr<LoggingServiceV2Stub> CreateDefaultLoggingServiceV2Stub(
         std::move(stub), options.get<GrpcTracingOptionsOption>(),
         options.get<TracingComponentsOption>());
   }
+  // The metrics decorator is the outermost layer, so the resource accounting
+  // for each call includes the work done by all the other decorators.
+  if (options.has<RpcMetricsOption>()) {
+    stub = std::make_shared<LoggingServiceV2Metrics>(
+        std::move(stub), options.get<RpcMetricsOption>());
+  }
   return stub;
 }
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
@@ -0,0 +1,240 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/logging/log_entry_batcher.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+namespace {
+
+using ::google::logging::v2::LogEntry;
+using ::google::logging::v2::WriteLogEntriesRequest;
+
+// Keep a few cleared batches around, their entries are reused by the next
+// batches. More spares than in-flight batches would never be used.
+std::size_t constexpr kMaxSpareBatches = 4;
+
+Options DefaultOptions(Options opts) {
+  if (!opts.has<LogEntryBatcherMaxEntriesOption>()) {
+    opts.set<LogEntryBatcherMaxEntriesOption>(1000);
+  }
+  if (!opts.has<LogEntryBatcherMaxBytesOption>()) {
+    opts.set<LogEntryBatcherMaxBytesOption>(1024 * 1024L);
+  }
+  if (!opts.has<LogEntryBatcherMaxHoldTimeOption>()) {
+    opts.set<LogEntryBatcherMaxHoldTimeOption>(std::chrono::seconds(1));
+  }
+  if (!opts.has<LogEntryBatcherMaxPendingBytesOption>()) {
+    opts.set<LogEntryBatcherMaxPendingBytesOption>(64 * 1024 * 1024L);
+  }
+  return opts;
+}
+
+}  // namespace
+
+// Sends one batch, it is a bit large for a lambda, and we need move-capture
+// anyways.
+struct LogEntryBatcher::WriteBatch {
+  std::shared_ptr<LoggingServiceV2Connection> connection;
+  WriteLogEntriesRequest request;
+  std::vector<promise<Status>> waiters;
+  std::size_t bytes;
+  std::weak_ptr<LogEntryBatcher> weak;
+
+  void operator()() {
+    auto status = connection->WriteLogEntries(request).status();
+    for (auto& w : waiters) w.set_value(status);
+    if (auto self = weak.lock()) {
+      self->OnBatchDone(bytes, std::move(*request.mutable_entries()));
+    }
+  }
+};
+
+std::shared_ptr<LogEntryBatcher> LogEntryBatcher::Create(
+    std::shared_ptr<LoggingServiceV2Connection> connection, CompletionQueue cq,
+    WriteLogEntriesRequest defaults, Options opts) {
+  defaults.clear_entries();
+  auto batcher = std::shared_ptr<LogEntryBatcher>(new LogEntryBatcher(
+      std::move(connection), std::move(cq), std::move(defaults),
+      DefaultOptions(std::move(opts))));
+  batcher->self_ = batcher;
+  return batcher;
+}
+
+LogEntryBatcher::LogEntryBatcher(
+    std::shared_ptr<LoggingServiceV2Connection> connection, CompletionQueue cq,
+    WriteLogEntriesRequest defaults, Options const& opts)
+    : connection_(std::move(connection)),
+      cq_(std::move(cq)),
+      defaults_(std::move(defaults)),
+      max_entries_((std::max)(std::size_t{1},
+                              opts.get<LogEntryBatcherMaxEntriesOption>())),
+      max_bytes_(opts.get<LogEntryBatcherMaxBytesOption>()),
+      max_hold_time_(opts.get<LogEntryBatcherMaxHoldTimeOption>()),
+      max_pending_bytes_(opts.get<LogEntryBatcherMaxPendingBytesOption>()) {
+  batch_.mutable_entries()->Reserve(static_cast<int>(max_entries_));
+}
+
+LogEntryBatcher::~LogEntryBatcher() {
+  // The batch runs in the background, `self_` is already expired, so the
+  // batch does not call back into this object.
+  FlushImpl(std::unique_lock<std::mutex>(mu_));
+}
+
+future<Status> LogEntryBatcher::Write(LogEntry entry) {
+  // Entries that match the defaults inherit these fields from the request,
+  // there is no need to send them more than once.
+  if (!defaults_.log_name().empty() &&
+      entry.log_name() == defaults_.log_name()) {
+    entry.clear_log_name();
+  }
+  if (entry.has_resource() && defaults_.has_resource() &&
+      google::protobuf::util::MessageDifferencer::Equals(
+          entry.resource(), defaults_.resource())) {
+    entry.clear_resource();
+  }
+  // The service merges the request labels into each entry, the labels with
+  // the same value do not need to be repeated either.
+  if (!defaults_.labels().empty() && !entry.labels().empty()) {
+    auto& labels = *entry.mutable_labels();
+    for (auto const& kv : defaults_.labels()) {
+      auto l = labels.find(kv.first);
+      if (l != labels.end() && l->second == kv.second) labels.erase(l);
+    }
+  }
+  auto const bytes = entry.ByteSizeLong();
+
+  std::unique_lock<std::mutex> lk(mu_);
+  // Always accept an entry when nothing is pending, otherwise an entry larger
+  // than the limit could never be written.
+  if (pending_bytes_ != 0 && pending_bytes_ + bytes > max_pending_bytes_) {
+    return make_ready_future(
+        Status(StatusCode::kFailedPrecondition, "LogEntryBatcher is full"));
+  }
+  // Flush the current batch if the entry does not fit. The entry starts a new
+  // batch even if it is larger than the limit, otherwise it would be dropped.
+  if (!waiters_.empty() && batch_bytes_ + bytes > max_bytes_) {
+    FlushImpl(std::move(lk));
+    lk = std::unique_lock<std::mutex>(mu_);
+  }
+
+  waiters_.emplace_back();
+  auto f = waiters_.back().get_future();
+  // Swap the entry into the request, without temporaries or copies. If the
+  // batch reuses the entries of a previous batch this does not allocate.
+  batch_.add_entries()->Swap(&entry);
+  batch_bytes_ += bytes;
+  pending_bytes_ += bytes;
+  MaybeFlush(std::move(lk));
+  return f;
+}
+
+future<void> LogEntryBatcher::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (waiters_.empty() && in_flight_ == 0) return make_ready_future();
+  flush_waiters_.emplace_back();
+  auto f = flush_waiters_.back().get_future();
+  FlushImpl(std::move(lk));
+  return f;
+}
+
+void LogEntryBatcher::MaybeFlush(std::unique_lock<std::mutex> lk) {
+  if (waiters_.size() >= max_entries_ || batch_bytes_ >= max_bytes_) {
+    FlushImpl(std::move(lk));
+    return;
+  }
+  // Only the first entry in a batch needs to start a timer.
+  if (waiters_.size() != 1) return;
+  auto const expiration = batch_expiration_ =
+      std::chrono::system_clock::now() + max_hold_time_;
+  lk.unlock();
+  // Use a weak pointer, the timer should not extend the lifetime of this
+  // object.
+  auto weak = self_;
+  using TimerResult = future<StatusOr<std::chrono::system_clock::time_point>>;
+  auto timer = cq_.MakeDeadlineTimer(expiration).then([weak](TimerResult) {
+    if (auto self = weak.lock()) self->OnTimer();
+  });
+  // Keep the timer, it is cancelled when the batch is flushed. A pending timer
+  // would also prevent the completion queue from shutting down.
+  lk.lock();
+  if (waiters_.empty() || expiration != batch_expiration_) {
+    // The batch was flushed while the timer was created.
+    lk.unlock();
+    timer.cancel();
+    return;
+  }
+  timer_ = std::move(timer);
+}
+
+void LogEntryBatcher::OnTimer() {
+  std::unique_lock<std::mutex> lk(mu_);
+  // Cancelled timers, and timers for batches flushed while the timer was
+  // created, simply find a newer (or empty) batch.
+  if (std::chrono::system_clock::now() < batch_expiration_) return;
+  // This timer has expired, there is no need to cancel it.
+  timer_ = future<void>();
+  FlushImpl(std::move(lk));
+}
+
+void LogEntryBatcher::FlushImpl(std::unique_lock<std::mutex> lk) {
+  if (waiters_.empty()) return;
+
+  auto timer = std::move(timer_);
+  WriteBatch batch;
+  batch.connection = connection_;
+  batch.request = defaults_;
+  batch.request.set_partial_success(true);
+  batch.request.mutable_entries()->Swap(batch_.mutable_entries());
+  if (!spare_entries_.empty()) {
+    batch_.mutable_entries()->Swap(&spare_entries_.back());
+    spare_entries_.pop_back();
+  }
+  // Reserve enough capacity for the next batch.
+  batch_.mutable_entries()->Reserve(static_cast<int>(max_entries_));
+  batch.waiters.swap(waiters_);
+  batch.bytes = batch_bytes_;
+  batch.weak = self_;
+  batch_bytes_ = 0;
+  ++in_flight_;
+  lk.unlock();
+
+  if (timer.valid()) timer.cancel();
+  cq_.RunAsync(std::move(batch));
+}
+
+void LogEntryBatcher::OnBatchDone(std::size_t bytes, LogEntries entries) {
+  // `Clear()` keeps the (cleared) entries, `add_entries()` reuses them.
+  entries.Clear();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (spare_entries_.size() < kMaxSpareBatches) {
+    spare_entries_.push_back(std::move(entries));
+  }
+  pending_bytes_ -= bytes;
+  if (--in_flight_ != 0) return;
+  std::vector<promise<void>> waiters;
+  waiters.swap(flush_waiters_);
+  lk.unlock();
+  for (auto& w : waiters) w.set_value();
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
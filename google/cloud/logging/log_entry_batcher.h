@@ -0,0 +1,183 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_BATCHER_H
+
+#include "google/cloud/logging/logging_service_v2_connection.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <google/logging/v2/logging.pb.h>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * Flush a `LogEntryBatcher` batch once it has this many entries.
+ *
+ * The default is 1000 entries, a value of 0 is treated as 1.
+ */
+struct LogEntryBatcherMaxEntriesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Flush a `LogEntryBatcher` batch once its entries use this many bytes.
+ *
+ * The default is 1 MiB. The service rejects requests larger than 10 MB.
+ */
+struct LogEntryBatcherMaxBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Flush a `LogEntryBatcher` batch once its first entry is this old.
+ *
+ * The default is 1 second.
+ */
+struct LogEntryBatcherMaxHoldTimeOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * Bound the memory used by a `LogEntryBatcher`.
+ *
+ * `LogEntryBatcher::Write()` rejects entries once the pending (batched or
+ * in-flight) entries use this many bytes. The default is 64 MiB.
+ */
+struct LogEntryBatcherMaxPendingBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Batches `LogEntry` messages into `WriteLogEntries()` requests.
+ *
+ * `WriteLogEntries()` is a blocking RPC. Sending each entry in a separate
+ * request wastes a thread per entry, and is much slower than sending the same
+ * entries in a few large requests. This class collects the entries passed to
+ * `Write()` and flushes them as a single request when the batch reaches
+ * `LogEntryBatcherMaxEntriesOption` entries, `LogEntryBatcherMaxBytesOption`
+ * bytes, or `LogEntryBatcherMaxHoldTimeOption` elapses. The requests run in
+ * the threads of the `CompletionQueue`, so `Write()` never blocks.
+ *
+ * The fields of @p defaults, such as the log name, the monitored resource, and
+ * the labels, are shared by all the entries in each request. `Write()` clears
+ * the log name and resource of any entry that matches these defaults, and
+ * removes the entry labels with the same value as a default label, which
+ * reduces the size of the requests. The entries are moved into the request,
+ * and the entries of completed requests are reused by later batches, so
+ * batching allocates few `LogEntry` messages once it reaches a steady state.
+ *
+ * The requests set `partial_success`, so a bad entry does not prevent the rest
+ * of the batch from being written. The service reports per-entry failures as a
+ * single error for the request, and the futures for all the entries in the
+ * batch are satisfied with that error.
+ *
+ * @par Example
+ * @code
+ * namespace logging = ::google::cloud::logging;
+ * google::cloud::CompletionQueue cq = ...;
+ * google::logging::v2::WriteLogEntriesRequest defaults;
+ * defaults.set_log_name("projects/my-project/logs/my-log");
+ * defaults.mutable_resource()->set_type("global");
+ * auto batcher = logging::LogEntryBatcher::Create(
+ *     logging::MakeLoggingServiceV2Connection(), cq, std::move(defaults));
+ * google::logging::v2::LogEntry entry;
+ * entry.set_text_payload("Hello World");
+ * batcher->Write(std::move(entry));
+ * @endcode
+ */
+class LogEntryBatcher {
+ public:
+  static std::shared_ptr<LogEntryBatcher> Create(
+      std::shared_ptr<LoggingServiceV2Connection> connection,
+      CompletionQueue cq,
+      google::logging::v2::WriteLogEntriesRequest defaults,
+      Options opts = {});
+
+  /// Flushes any pending entries.
+  ~LogEntryBatcher();
+
+  LogEntryBatcher(LogEntryBatcher const&) = delete;
+  LogEntryBatcher& operator=(LogEntryBatcher const&) = delete;
+
+  /**
+   * Adds @p entry to the current batch.
+   *
+   * The returned future is satisfied once the batch is written. It is
+   * satisfied immediately with a `kFailedPrecondition` error if the pending
+   * entries already use `LogEntryBatcherMaxPendingBytesOption` bytes.
+   */
+  future<Status> Write(google::logging::v2::LogEntry entry);
+
+  /**
+   * Sends the current batch, without waiting for it to fill up.
+   *
+   * The returned future is satisfied once all the batches sent so far have
+   * completed.
+   */
+  future<void> Flush();
+
+ private:
+  struct WriteBatch;
+  using LogEntries =
+      google::protobuf::RepeatedPtrField<google::logging::v2::LogEntry>;
+
+  LogEntryBatcher(std::shared_ptr<LoggingServiceV2Connection> connection,
+                  CompletionQueue cq,
+                  google::logging::v2::WriteLogEntriesRequest defaults,
+                  Options const& opts);
+
+  void MaybeFlush(std::unique_lock<std::mutex> lk);
+  void FlushImpl(std::unique_lock<std::mutex> lk);
+  void OnTimer();
+  void OnBatchDone(std::size_t bytes, LogEntries entries);
+
+  std::shared_ptr<LoggingServiceV2Connection> const connection_;
+  CompletionQueue cq_;
+  google::logging::v2::WriteLogEntriesRequest const defaults_;
+  std::size_t const max_entries_;
+  std::size_t const max_bytes_;
+  std::chrono::milliseconds const max_hold_time_;
+  std::size_t const max_pending_bytes_;
+  std::weak_ptr<LogEntryBatcher> self_;
+
+  std::mutex mu_;
+  google::logging::v2::WriteLogEntriesRequest batch_;
+  std::vector<promise<Status>> waiters_;
+  std::size_t batch_bytes_ = 0;
+  std::chrono::system_clock::time_point batch_expiration_;
+  future<void> timer_;
+  std::size_t pending_bytes_ = 0;
+  std::size_t in_flight_ = 0;
+  std::vector<promise<void>> flush_waiters_;
+  std::vector<LogEntries> spare_entries_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_BATCHER_H
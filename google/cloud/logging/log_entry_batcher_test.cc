@@ -0,0 +1,276 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/logging/log_entry_batcher.h"
+#include "google/cloud/logging/mocks/mock_logging_service_v2_connection.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::logging_mocks::MockLoggingServiceV2Connection;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::logging::v2::LogEntry;
+using ::google::logging::v2::WriteLogEntriesRequest;
+using ::google::logging::v2::WriteLogEntriesResponse;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+auto constexpr kLogName = "projects/test-project/logs/test-log";
+
+WriteLogEntriesRequest TestDefaults() {
+  WriteLogEntriesRequest defaults;
+  defaults.set_log_name(kLogName);
+  defaults.mutable_resource()->set_type("global");
+  return defaults;
+}
+
+LogEntry MakeEntry(std::string payload) {
+  LogEntry entry;
+  entry.set_log_name(kLogName);
+  entry.mutable_resource()->set_type("global");
+  entry.set_text_payload(std::move(payload));
+  return entry;
+}
+
+std::vector<std::string> Payloads(WriteLogEntriesRequest const& request) {
+  std::vector<std::string> payloads;
+  for (auto const& e : request.entries()) payloads.push_back(e.text_payload());
+  return payloads;
+}
+
+Options HoldForever() {
+  return Options{}.set<LogEntryBatcherMaxHoldTimeOption>(
+      std::chrono::hours(1));
+}
+
+TEST(LogEntryBatcherTest, BatchByCount) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_EQ(kLogName, request.log_name());
+        EXPECT_EQ("global", request.resource().type());
+        EXPECT_TRUE(request.partial_success());
+        EXPECT_THAT(Payloads(request), ElementsAre("p0", "p1"));
+        // The shared fields are not repeated in each entry.
+        for (auto const& e : request.entries()) {
+          EXPECT_TRUE(e.log_name().empty());
+          EXPECT_FALSE(e.has_resource());
+        }
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(
+      mock, background.cq(), TestDefaults(),
+      HoldForever().set<LogEntryBatcherMaxEntriesOption>(2));
+  auto f0 = batcher->Write(MakeEntry("p0"));
+  auto f1 = batcher->Write(MakeEntry("p1"));
+  EXPECT_STATUS_OK(f0.get());
+  EXPECT_STATUS_OK(f1.get());
+}
+
+TEST(LogEntryBatcherTest, BatchByBytes) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  ::testing::InSequence sequence;
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(Payloads(request), ElementsAre("p0"));
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(Payloads(request), ElementsAre("p1"));
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(
+      mock, background.cq(), TestDefaults(),
+      HoldForever().set<LogEntryBatcherMaxBytesOption>(1));
+  EXPECT_STATUS_OK(batcher->Write(MakeEntry("p0")).get());
+  EXPECT_STATUS_OK(batcher->Write(MakeEntry("p1")).get());
+}
+
+TEST(LogEntryBatcherTest, BatchByTime) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(Payloads(request), ElementsAre("p0"));
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(
+      mock, background.cq(), TestDefaults(),
+      Options{}.set<LogEntryBatcherMaxHoldTimeOption>(
+          std::chrono::milliseconds(5)));
+  EXPECT_STATUS_OK(batcher->Write(MakeEntry("p0")).get());
+}
+
+TEST(LogEntryBatcherTest, Flush) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(Payloads(request), ElementsAre("p0", "p1"));
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(mock, background.cq(), TestDefaults(),
+                                         HoldForever());
+  auto f0 = batcher->Write(MakeEntry("p0"));
+  auto f1 = batcher->Write(MakeEntry("p1"));
+  batcher->Flush().get();
+  ASSERT_TRUE(f0.is_ready());
+  ASSERT_TRUE(f1.is_ready());
+  EXPECT_STATUS_OK(f0.get());
+  EXPECT_STATUS_OK(f1.get());
+  // Nothing is pending, the future is satisfied immediately.
+  EXPECT_TRUE(batcher->Flush().is_ready());
+}
+
+TEST(LogEntryBatcherTest, ErrorSatisfiesAllEntries) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const&) {
+        return StatusOr<WriteLogEntriesResponse>(
+            Status(StatusCode::kInvalidArgument, "bad entry"));
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(mock, background.cq(), TestDefaults(),
+                                         HoldForever());
+  auto f0 = batcher->Write(MakeEntry("p0"));
+  auto f1 = batcher->Write(MakeEntry("p1"));
+  batcher->Flush();
+  EXPECT_THAT(f0.get(), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(f1.get(), StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(LogEntryBatcherTest, KeepsFieldsDifferentFromDefaults) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_EQ(1, request.entries_size());
+        auto const& e = request.entries(0);
+        EXPECT_EQ("projects/test-project/logs/other-log", e.log_name());
+        EXPECT_EQ("gce_instance", e.resource().type());
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(mock, background.cq(), TestDefaults(),
+                                         HoldForever());
+  auto entry = MakeEntry("p0");
+  entry.set_log_name("projects/test-project/logs/other-log");
+  entry.mutable_resource()->set_type("gce_instance");
+  auto f = batcher->Write(std::move(entry));
+  batcher->Flush();
+  EXPECT_STATUS_OK(f.get());
+}
+
+TEST(LogEntryBatcherTest, RemovesDefaultLabels) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(request.labels(), UnorderedElementsAre(Pair("env", "prod"),
+                                                           Pair("zone", "a")));
+        EXPECT_EQ(1, request.entries_size());
+        // Only the labels that differ from the defaults remain.
+        EXPECT_THAT(request.entries(0).labels(),
+                    UnorderedElementsAre(Pair("zone", "b"), Pair("id", "1")));
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto defaults = TestDefaults();
+  (*defaults.mutable_labels())["env"] = "prod";
+  (*defaults.mutable_labels())["zone"] = "a";
+  auto batcher = LogEntryBatcher::Create(mock, background.cq(),
+                                         std::move(defaults), HoldForever());
+  auto entry = MakeEntry("p0");
+  (*entry.mutable_labels())["env"] = "prod";
+  (*entry.mutable_labels())["zone"] = "b";
+  (*entry.mutable_labels())["id"] = "1";
+  auto f = batcher->Write(std::move(entry));
+  batcher->Flush();
+  EXPECT_STATUS_OK(f.get());
+}
+
+TEST(LogEntryBatcherTest, ReusedEntriesAreCleared) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  ::testing::InSequence sequence;
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(Payloads(request), ElementsAre("p0", "p1"));
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(Payloads(request), ElementsAre("p2"));
+        EXPECT_TRUE(request.entries(0).labels().empty());
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(mock, background.cq(), TestDefaults(),
+                                         HoldForever());
+  auto e0 = MakeEntry("p0");
+  (*e0.mutable_labels())["id"] = "0";
+  auto f0 = batcher->Write(std::move(e0));
+  auto f1 = batcher->Write(MakeEntry("p1"));
+  batcher->Flush().get();
+  EXPECT_STATUS_OK(f0.get());
+  EXPECT_STATUS_OK(f1.get());
+  // The second batch reuses the entries of the first batch.
+  auto f2 = batcher->Write(MakeEntry("p2"));
+  batcher->Flush();
+  EXPECT_STATUS_OK(f2.get());
+}
+
+TEST(LogEntryBatcherTest, RejectWhenFull) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, WriteLogEntries)
+      .WillOnce([](WriteLogEntriesRequest const& request) {
+        EXPECT_THAT(Payloads(request), ElementsAre("p0"));
+        return make_status_or(WriteLogEntriesResponse{});
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto batcher = LogEntryBatcher::Create(
+      mock, background.cq(), TestDefaults(),
+      HoldForever().set<LogEntryBatcherMaxPendingBytesOption>(1));
+  // The first entry is accepted even though it is larger than the limit.
+  auto f0 = batcher->Write(MakeEntry("p0"));
+  auto f1 = batcher->Write(MakeEntry("p1"));
+  ASSERT_TRUE(f1.is_ready());
+  EXPECT_THAT(f1.get(), StatusIs(StatusCode::kFailedPrecondition));
+  batcher->Flush().get();
+  EXPECT_STATUS_OK(f0.get());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
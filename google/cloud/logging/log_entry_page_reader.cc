@@ -0,0 +1,104 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/logging/log_entry_page_reader.h"
+#include <deque>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+namespace {
+
+using ::google::logging::v2::ListLogEntriesRequest;
+using ::google::logging::v2::ListLogEntriesResponse;
+
+// At most this many pages are fetched but not yet returned by `Next()`, that
+// is, the reader prefetches one page.
+std::size_t constexpr kMaxPendingPages = 2;
+
+}  // namespace
+
+struct LogEntryPageReader::State {
+  explicit State(std::shared_ptr<LoggingServiceV2Connection> c)
+      : connection(std::move(c)) {}
+
+  std::shared_ptr<LoggingServiceV2Connection> const connection;
+  std::mutex mu;
+  std::deque<future<StatusOr<ListLogEntriesResponse>>> pages;
+  absl::optional<ListLogEntriesRequest> deferred;
+
+  static void Fetch(std::shared_ptr<State> const& state,
+                    ListLogEntriesRequest request) {
+    auto p = std::make_shared<promise<StatusOr<ListLogEntriesResponse>>>();
+    {
+      std::lock_guard<std::mutex> lk(state->mu);
+      state->pages.push_back(p->get_future());
+    }
+    // The reader may be deleted before the page arrives, then there is no
+    // need to fetch any more pages.
+    auto w = std::weak_ptr<State>(state);
+    state->connection->AsyncListLogEntries(request).then(
+        [w, request, p](future<StatusOr<ListLogEntriesResponse>> f) mutable {
+          auto page = f.get();
+          auto state = w.lock();
+          if (state && page && !page->next_page_token().empty()) {
+            request.set_page_token(page->next_page_token());
+            state->FetchOrDefer(state, std::move(request));
+          }
+          p->set_value(std::move(page));
+        });
+  }
+
+  void FetchOrDefer(std::shared_ptr<State> const& self,
+                    ListLogEntriesRequest request) {
+    std::unique_lock<std::mutex> lk(mu);
+    if (pages.size() >= kMaxPendingPages) {
+      deferred = std::move(request);
+      return;
+    }
+    lk.unlock();
+    Fetch(self, std::move(request));
+  }
+};
+
+LogEntryPageReader::LogEntryPageReader(
+    std::shared_ptr<LoggingServiceV2Connection> connection,
+    ListLogEntriesRequest request)
+    : state_(std::make_shared<State>(std::move(connection))) {
+  State::Fetch(state_, std::move(request));
+}
+
+future<absl::optional<StatusOr<ListLogEntriesResponse>>>
+LogEntryPageReader::Next() {
+  using Page = absl::optional<StatusOr<ListLogEntriesResponse>>;
+  std::unique_lock<std::mutex> lk(state_->mu);
+  if (state_->pages.empty()) return make_ready_future(Page{});
+  auto page = std::move(state_->pages.front());
+  state_->pages.pop_front();
+  auto deferred = std::move(state_->deferred);
+  state_->deferred.reset();
+  lk.unlock();
+  if (deferred) State::Fetch(state_, *std::move(deferred));
+  return page.then([](future<StatusOr<ListLogEntriesResponse>> f) {
+    return Page(f.get());
+  });
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
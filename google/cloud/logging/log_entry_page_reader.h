@@ -0,0 +1,84 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_PAGE_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_PAGE_READER_H
+
+#include "google/cloud/logging/logging_service_v2_connection.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <google/logging/v2/logging.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * Reads the pages of `ListLogEntries()` asynchronously.
+ *
+ * `LoggingServiceV2Connection::ListLogEntries()` returns a `StreamRange`,
+ * iterating it blocks the calling thread while each page is fetched. This
+ * class reads the pages with `AsyncListLogEntries()` instead, so no thread is
+ * blocked, and it requests the next page as soon as a page arrives. While the
+ * application processes one page the next one is already in flight.
+ *
+ * Each page is retried using the policies of the connection.
+ *
+ * @par Example
+ * @code
+ * namespace logging = ::google::cloud::logging;
+ * google::logging::v2::ListLogEntriesRequest request;
+ * request.add_resource_names("projects/my-project");
+ * logging::LogEntryPageReader reader(
+ *     logging::MakeLoggingServiceV2Connection(), std::move(request));
+ * for (auto page = reader.Next().get(); page; page = reader.Next().get()) {
+ *   if (!*page) throw std::move(*page).status();
+ *   for (auto const& e : (*page)->entries()) std::cout << e.DebugString();
+ * }
+ * @endcode
+ */
+class LogEntryPageReader {
+ public:
+  /// Starts reading the first page of @p request.
+  LogEntryPageReader(std::shared_ptr<LoggingServiceV2Connection> connection,
+                     google::logging::v2::ListLogEntriesRequest request);
+
+  /**
+   * Returns the next page.
+   *
+   * The returned future is satisfied with an empty optional once all the
+   * pages have been returned. An error ends the read, it is returned once and
+   * followed by an empty optional.
+   *
+   * Only call `Next()` after the future returned by the previous call is
+   * satisfied.
+   */
+  future<absl::optional<StatusOr<google::logging::v2::ListLogEntriesResponse>>>
+  Next();
+
+ private:
+  struct State;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_PAGE_READER_H
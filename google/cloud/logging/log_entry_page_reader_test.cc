@@ -0,0 +1,141 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/logging/log_entry_page_reader.h"
+#include "google/cloud/logging/mocks/mock_logging_service_v2_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::logging_mocks::MockLoggingServiceV2Connection;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::logging::v2::ListLogEntriesRequest;
+using ::google::logging::v2::ListLogEntriesResponse;
+using ::testing::ElementsAre;
+
+ListLogEntriesResponse MakePage(std::string const& id,
+                                std::string const& next_page_token) {
+  ListLogEntriesResponse page;
+  page.add_entries()->set_insert_id(id);
+  page.set_next_page_token(next_page_token);
+  return page;
+}
+
+ListLogEntriesRequest TestRequest() {
+  ListLogEntriesRequest request;
+  request.add_resource_names("projects/test-project");
+  return request;
+}
+
+TEST(LogEntryPageReaderTest, AllPages) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  std::vector<std::string> tokens;
+  EXPECT_CALL(*mock, AsyncListLogEntries)
+      .WillOnce([&tokens](ListLogEntriesRequest const& request) {
+        tokens.push_back(request.page_token());
+        return make_ready_future(make_status_or(MakePage("a", "t1")));
+      })
+      .WillOnce([&tokens](ListLogEntriesRequest const& request) {
+        tokens.push_back(request.page_token());
+        return make_ready_future(make_status_or(MakePage("b", "t2")));
+      })
+      .WillOnce([&tokens](ListLogEntriesRequest const& request) {
+        EXPECT_THAT(request.resource_names(),
+                    ElementsAre("projects/test-project"));
+        tokens.push_back(request.page_token());
+        return make_ready_future(make_status_or(MakePage("c", "")));
+      });
+
+  LogEntryPageReader reader(mock, TestRequest());
+  std::vector<std::string> ids;
+  for (auto page = reader.Next().get(); page; page = reader.Next().get()) {
+    ASSERT_STATUS_OK(*page);
+    for (auto const& e : (*page)->entries()) ids.push_back(e.insert_id());
+  }
+  EXPECT_THAT(ids, ElementsAre("a", "b", "c"));
+  EXPECT_THAT(tokens, ElementsAre("", "t1", "t2"));
+  EXPECT_FALSE(reader.Next().get().has_value());
+}
+
+TEST(LogEntryPageReaderTest, PrefetchesOnePage) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  std::vector<promise<StatusOr<ListLogEntriesResponse>>> pending;
+  pending.reserve(3);
+  EXPECT_CALL(*mock, AsyncListLogEntries)
+      .Times(3)
+      .WillRepeatedly([&pending](ListLogEntriesRequest const&) {
+        pending.emplace_back();
+        return pending.back().get_future();
+      });
+
+  LogEntryPageReader reader(mock, TestRequest());
+  ASSERT_EQ(1U, pending.size());
+  // The second page is requested as soon as the first page arrives.
+  pending[0].set_value(MakePage("a", "t1"));
+  ASSERT_EQ(2U, pending.size());
+  // The third page waits until the application reads the first page.
+  pending[1].set_value(MakePage("b", "t2"));
+  ASSERT_EQ(2U, pending.size());
+
+  auto page = reader.Next().get();
+  ASSERT_TRUE(page.has_value());
+  ASSERT_STATUS_OK(*page);
+  EXPECT_EQ("a", (*page)->entries(0).insert_id());
+  ASSERT_EQ(3U, pending.size());
+  pending[2].set_value(MakePage("c", ""));
+
+  page = reader.Next().get();
+  ASSERT_TRUE(page.has_value());
+  ASSERT_STATUS_OK(*page);
+  EXPECT_EQ("b", (*page)->entries(0).insert_id());
+  page = reader.Next().get();
+  ASSERT_TRUE(page.has_value());
+  ASSERT_STATUS_OK(*page);
+  EXPECT_EQ("c", (*page)->entries(0).insert_id());
+  EXPECT_FALSE(reader.Next().get().has_value());
+}
+
+TEST(LogEntryPageReaderTest, ErrorEndsTheRead) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, AsyncListLogEntries)
+      .WillOnce([](ListLogEntriesRequest const&) {
+        return make_ready_future(make_status_or(MakePage("a", "t1")));
+      })
+      .WillOnce([](ListLogEntriesRequest const&) {
+        return make_ready_future(StatusOr<ListLogEntriesResponse>(
+            Status(StatusCode::kPermissionDenied, "uh-oh")));
+      });
+
+  LogEntryPageReader reader(mock, TestRequest());
+  auto page = reader.Next().get();
+  ASSERT_TRUE(page.has_value());
+  ASSERT_STATUS_OK(*page);
+  page = reader.Next().get();
+  ASSERT_TRUE(page.has_value());
+  EXPECT_THAT(*page, StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_FALSE(reader.Next().get().has_value());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,221 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/logging/log_entry_tail.h"
+#include "google/cloud/logging/internal/logging_service_v2_option_defaults.h"
+#include "google/cloud/logging/logging_service_v2_options.h"
+#include "absl/types/optional.h"
+#include <google/protobuf/util/time_util.h>
+#include <algorithm>
+#include <set>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+namespace {
+
+using ::google::logging::v2::TailLogEntriesRequest;
+using ::google::logging::v2::TailLogEntriesResponse;
+using ::google::protobuf::Timestamp;
+using ::google::protobuf::util::TimeUtil;
+
+using TailStream =
+    internal::AsyncStreamingReadWriteRpc<TailLogEntriesRequest,
+                                         TailLogEntriesResponse>;
+
+/// Restricts @p filter to the entries at or after @p timestamp.
+std::string ResumeFilter(std::string const& filter,
+                         Timestamp const& timestamp) {
+  auto restriction =
+      "timestamp>=\"" + TimeUtil::ToString(timestamp) + "\"";
+  if (filter.empty()) return restriction;
+  return "(" + filter + ") AND " + restriction;
+}
+
+/**
+ * Implements `TailLogEntries()`.
+ *
+ * This follows `internal::AsyncResumableStreamingReadImpl`: each step is
+ * started from the callback of the previous step, so at most one operation is
+ * pending at a time and no locking is needed. The object keeps itself alive
+ * until the loop ends.
+ */
+class TailLoop : public std::enable_shared_from_this<TailLoop> {
+ public:
+  TailLoop(std::shared_ptr<LoggingServiceV2Connection> connection,
+           CompletionQueue cq, TailLogEntriesRequest request,
+           std::function<future<bool>(TailLogEntriesResponse)> on_read,
+           Options const& opts)
+      : connection_(std::move(connection)),
+        cq_(std::move(cq)),
+        retry_policy_prototype_(
+            opts.get<LoggingServiceV2RetryPolicyOption>()->clone()),
+        backoff_policy_prototype_(
+            opts.get<LoggingServiceV2BackoffPolicyOption>()->clone()),
+        retry_policy_(retry_policy_prototype_->clone()),
+        backoff_policy_(backoff_policy_prototype_->clone()),
+        request_(std::move(request)),
+        filter_(request_.filter()),
+        on_read_(std::move(on_read)) {}
+
+  future<Status> Start() {
+    auto f = result_.get_future();
+    StartStream();
+    return f;
+  }
+
+ private:
+  void StartStream() {
+    stream_ = connection_->AsyncTailLogEntries();
+    auto self = shared_from_this();
+    stream_->Start().then([self](future<bool> f) {
+      if (!f.get()) return self->Finish();
+      self->WriteRequest();
+    });
+  }
+
+  void WriteRequest() {
+    if (last_timestamp_) {
+      request_.set_filter(ResumeFilter(filter_, *last_timestamp_));
+    }
+    auto self = shared_from_this();
+    stream_->Write(request_, grpc::WriteOptions{})
+        .then([self](future<bool> f) {
+          if (!f.get()) return self->Finish();
+          self->Read();
+        });
+  }
+
+  void Read() {
+    auto self = shared_from_this();
+    stream_->Read().then(
+        [self](future<absl::optional<TailLogEntriesResponse>> f) {
+          self->OnRead(f.get());
+        });
+  }
+
+  void OnRead(absl::optional<TailLogEntriesResponse> response) {
+    if (!response) return Finish();
+    has_received_data_ = true;
+    RemoveDuplicates(*response);
+    if (response->entries().empty() && response->suppression_info().empty()) {
+      return Read();
+    }
+    auto self = shared_from_this();
+    on_read_(*std::move(response)).then([self](future<bool> f) {
+      if (f.get()) return self->Read();
+      // The caller is done with the stream, cancel it and discard any pending
+      // responses, gRPC requires this before calling `Finish()`.
+      self->cancelled_ = true;
+      self->stream_->Cancel();
+      self->Discard();
+    });
+  }
+
+  // Drops the entries already delivered, and records the newest timestamp
+  // (and the entries with that timestamp) to resume the stream from it.
+  void RemoveDuplicates(TailLogEntriesResponse& response) {
+    auto& entries = *response.mutable_entries();
+    auto end = std::remove_if(
+        entries.begin(), entries.end(),
+        [this](google::logging::v2::LogEntry const& e) {
+          auto const& ts = e.timestamp();
+          if (!last_timestamp_ || *last_timestamp_ < ts) {
+            last_timestamp_ = ts;
+            last_insert_ids_.clear();
+            last_insert_ids_.insert(e.insert_id());
+            return false;
+          }
+          if (ts < *last_timestamp_) return false;
+          return !last_insert_ids_.insert(e.insert_id()).second;
+        });
+    entries.erase(end, entries.end());
+  }
+
+  void Discard() {
+    auto self = shared_from_this();
+    stream_->Read().then(
+        [self](future<absl::optional<TailLogEntriesResponse>> f) {
+          if (!f.get()) return self->Finish();
+          self->Discard();
+        });
+  }
+
+  void Finish() {
+    auto self = shared_from_this();
+    stream_->Finish().then(
+        [self](future<Status> f) { self->OnFinish(f.get()); });
+  }
+
+  void OnFinish(Status status) {
+    stream_.reset();
+    if (cancelled_) return result_.set_value(Status{});
+    if (status.ok()) return result_.set_value(std::move(status));
+    if (has_received_data_) {
+      retry_policy_ = retry_policy_prototype_->clone();
+      backoff_policy_ = backoff_policy_prototype_->clone();
+    }
+    if (retry_policy_->IsExhausted() ||
+        (!has_received_data_ && !retry_policy_->OnFailure(status))) {
+      return result_.set_value(std::move(status));
+    }
+    has_received_data_ = false;
+    auto self = shared_from_this();
+    cq_.MakeRelativeTimer(backoff_policy_->OnCompletion())
+        .then([self](future<StatusOr<std::chrono::system_clock::time_point>>
+                         f) {
+          auto t = f.get();
+          if (!t) return self->result_.set_value(std::move(t).status());
+          self->StartStream();
+        });
+  }
+
+  std::shared_ptr<LoggingServiceV2Connection> const connection_;
+  CompletionQueue cq_;
+  std::unique_ptr<LoggingServiceV2RetryPolicy> const retry_policy_prototype_;
+  std::unique_ptr<BackoffPolicy> const backoff_policy_prototype_;
+  std::unique_ptr<LoggingServiceV2RetryPolicy> retry_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+  TailLogEntriesRequest request_;
+  std::string const filter_;
+  std::function<future<bool>(TailLogEntriesResponse)> const on_read_;
+  std::unique_ptr<TailStream> stream_;
+  absl::optional<Timestamp> last_timestamp_;
+  std::set<std::string> last_insert_ids_;
+  bool has_received_data_ = false;
+  bool cancelled_ = false;
+  promise<Status> result_;
+};
+
+}  // namespace
+
+future<Status> TailLogEntries(
+    std::shared_ptr<LoggingServiceV2Connection> connection, CompletionQueue cq,
+    TailLogEntriesRequest request,
+    std::function<future<bool>(TailLogEntriesResponse)> on_read,
+    Options opts) {
+  opts = logging_internal::LoggingServiceV2DefaultOptions(std::move(opts));
+  auto loop = std::make_shared<TailLoop>(std::move(connection), std::move(cq),
+                                         std::move(request),
+                                         std::move(on_read), opts);
+  return loop->Start();
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,84 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_TAIL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_TAIL_H
+
+#include "google/cloud/logging/logging_service_v2_connection.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <google/logging/v2/logging.pb.h>
+#include <functional>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * Streams the log entries matching @p request as they are ingested.
+ *
+ * This runs the `TailLogEntries()` bidirectional stream of @p connection:
+ * @p request is written once the stream starts, and @p on_read is called for
+ * each response. The next response is not read until the future returned by
+ * @p on_read is satisfied. If its value is `false` the stream is cancelled.
+ *
+ * If the stream fails with a transient error it is restarted, like the
+ * streaming reads in the generated connections. The restarted stream only
+ * asks for entries at or after the timestamp of the last entry received, and
+ * any entries delivered before the restart are dropped using their
+ * `insert_id`. Responses left without entries (or suppression info) are not
+ * delivered. As in `ResumableStreamingReadRpc`, the retry policy limits the
+ * attempts to *start* a stream, a stream that makes progress is resumed with
+ * fresh policies. The retry and backoff policies are taken from @p opts, with
+ * the same options and defaults as `MakeLoggingServiceV2Connection()`.
+ *
+ * No thread is blocked while the stream is active, all the work runs in the
+ * threads of @p cq.
+ *
+ * @return the final status of the stream. The status is OK if the service
+ *     closed the stream successfully, or if @p on_read returned `false`.
+ *
+ * @par Example
+ * @code
+ * namespace logging = ::google::cloud::logging;
+ * google::cloud::CompletionQueue cq = ...;
+ * google::logging::v2::TailLogEntriesRequest request;
+ * request.add_resource_names("projects/my-project");
+ * request.set_filter("severity>=ERROR");
+ * auto done = logging::TailLogEntries(
+ *     logging::MakeLoggingServiceV2Connection(), cq, std::move(request),
+ *     [](google::logging::v2::TailLogEntriesResponse r) {
+ *       for (auto const& e : r.entries()) std::cout << e.DebugString();
+ *       return google::cloud::make_ready_future(true);
+ *     });
+ * @endcode
+ */
+future<Status> TailLogEntries(
+    std::shared_ptr<LoggingServiceV2Connection> connection, CompletionQueue cq,
+    google::logging::v2::TailLogEntriesRequest request,
+    std::function<future<bool>(google::logging::v2::TailLogEntriesResponse)>
+        on_read,
+    Options opts = {});
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_LOG_ENTRY_TAIL_H
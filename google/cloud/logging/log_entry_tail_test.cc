@@ -0,0 +1,279 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/logging/log_entry_tail.h"
+#include "google/cloud/logging/logging_service_v2_options.h"
+#include "google/cloud/logging/mocks/mock_logging_service_v2_connection.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace logging {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+namespace {
+
+using ::google::cloud::logging_mocks::MockLoggingServiceV2Connection;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::logging::v2::TailLogEntriesRequest;
+using ::google::logging::v2::TailLogEntriesResponse;
+using ::testing::ElementsAre;
+
+class MockTailStream
+    : public internal::AsyncStreamingReadWriteRpc<TailLogEntriesRequest,
+                                                  TailLogEntriesResponse> {
+ public:
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD(future<bool>, Start, (), (override));
+  MOCK_METHOD(future<absl::optional<TailLogEntriesResponse>>, Read, (),
+              (override));
+  MOCK_METHOD(future<bool>, Write,
+              (TailLogEntriesRequest const&, grpc::WriteOptions), (override));
+  MOCK_METHOD(future<bool>, WritesDone, (), (override));
+  MOCK_METHOD(future<Status>, Finish, (), (override));
+};
+
+Options TestOptions() {
+  return Options{}
+      .set<LoggingServiceV2RetryPolicyOption>(
+          LoggingServiceV2LimitedErrorCountRetryPolicy(2).clone())
+      .set<LoggingServiceV2BackoffPolicyOption>(
+          ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                   std::chrono::microseconds(1), 2.0)
+              .clone());
+}
+
+TailLogEntriesResponse MakeResponse(
+    std::vector<std::pair<std::string, std::int64_t>> const& entries) {
+  TailLogEntriesResponse response;
+  for (auto const& e : entries) {
+    auto& entry = *response.add_entries();
+    entry.set_insert_id(e.first);
+    entry.mutable_timestamp()->set_seconds(e.second);
+  }
+  return response;
+}
+
+future<absl::optional<TailLogEntriesResponse>> ReadResponse(
+    TailLogEntriesResponse response) {
+  return make_ready_future(absl::make_optional(std::move(response)));
+}
+
+future<absl::optional<TailLogEntriesResponse>> ReadEnd() {
+  return make_ready_future(absl::optional<TailLogEntriesResponse>{});
+}
+
+TailLogEntriesRequest TestRequest() {
+  TailLogEntriesRequest request;
+  request.add_resource_names("projects/test-project");
+  request.set_filter("severity>=ERROR");
+  return request;
+}
+
+struct Collector {
+  std::vector<std::string> ids;
+
+  std::function<future<bool>(TailLogEntriesResponse)> Callback() {
+    return [this](TailLogEntriesResponse r) {
+      for (auto const& e : r.entries()) ids.push_back(e.insert_id());
+      return make_ready_future(true);
+    };
+  }
+};
+
+TEST(LogEntryTailTest, Success) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, AsyncTailLogEntries).WillOnce([] {
+    auto stream = absl::make_unique<MockTailStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Write)
+        .WillOnce([](TailLogEntriesRequest const& request, grpc::WriteOptions) {
+          EXPECT_THAT(request.resource_names(),
+                      ElementsAre("projects/test-project"));
+          EXPECT_EQ("severity>=ERROR", request.filter());
+          return make_ready_future(true);
+        });
+    EXPECT_CALL(*stream, Read)
+        .WillOnce([] { return ReadResponse(MakeResponse({{"a", 10}})); })
+        .WillOnce([] { return ReadResponse(MakeResponse({{"b", 11}})); })
+        .WillOnce(ReadEnd);
+    EXPECT_CALL(*stream, Finish).WillOnce([] {
+      return make_ready_future(Status{});
+    });
+    return stream;
+  });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  Collector collector;
+  auto status = TailLogEntries(mock, background.cq(), TestRequest(),
+                               collector.Callback(), TestOptions())
+                    .get();
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(collector.ids, ElementsAre("a", "b"));
+}
+
+TEST(LogEntryTailTest, ResumeAfterLastTimestamp) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, AsyncTailLogEntries)
+      .WillOnce([] {
+        auto stream = absl::make_unique<MockTailStream>();
+        EXPECT_CALL(*stream, Start).WillOnce([] {
+          return make_ready_future(true);
+        });
+        EXPECT_CALL(*stream, Write).WillOnce([] {
+          return make_ready_future(true);
+        });
+        EXPECT_CALL(*stream, Read)
+            .WillOnce([] {
+              return ReadResponse(MakeResponse({{"a", 10}, {"b", 10}}));
+            })
+            .WillOnce(ReadEnd);
+        EXPECT_CALL(*stream, Finish).WillOnce([] {
+          return make_ready_future(
+              Status(StatusCode::kUnavailable, "try-again"));
+        });
+        return stream;
+      })
+      .WillOnce([] {
+        auto stream = absl::make_unique<MockTailStream>();
+        EXPECT_CALL(*stream, Start).WillOnce([] {
+          return make_ready_future(true);
+        });
+        EXPECT_CALL(*stream, Write)
+            .WillOnce(
+                [](TailLogEntriesRequest const& request, grpc::WriteOptions) {
+                  EXPECT_EQ(
+                      "(severity>=ERROR) AND "
+                      "timestamp>=\"1970-01-01T00:00:10Z\"",
+                      request.filter());
+                  return make_ready_future(true);
+                });
+        EXPECT_CALL(*stream, Read)
+            .WillOnce([] {
+              // Only the duplicates are dropped, "c" has the same timestamp
+              // as the last entries before the restart.
+              return ReadResponse(MakeResponse({{"b", 10}, {"a", 10}}));
+            })
+            .WillOnce([] {
+              return ReadResponse(MakeResponse({{"c", 10}, {"d", 11}}));
+            })
+            .WillOnce(ReadEnd);
+        EXPECT_CALL(*stream, Finish).WillOnce([] {
+          return make_ready_future(Status{});
+        });
+        return stream;
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  Collector collector;
+  auto status = TailLogEntries(mock, background.cq(), TestRequest(),
+                               collector.Callback(), TestOptions())
+                    .get();
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(collector.ids, ElementsAre("a", "b", "c", "d"));
+}
+
+TEST(LogEntryTailTest, PermanentError) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, AsyncTailLogEntries).WillOnce([] {
+    auto stream = absl::make_unique<MockTailStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(false);
+    });
+    EXPECT_CALL(*stream, Finish).WillOnce([] {
+      return make_ready_future(Status(StatusCode::kPermissionDenied, "uh-oh"));
+    });
+    return stream;
+  });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  Collector collector;
+  auto status = TailLogEntries(mock, background.cq(), TestRequest(),
+                               collector.Callback(), TestOptions())
+                    .get();
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_TRUE(collector.ids.empty());
+}
+
+TEST(LogEntryTailTest, TooManyTransients) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, AsyncTailLogEntries).Times(3).WillRepeatedly([] {
+    auto stream = absl::make_unique<MockTailStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(false);
+    });
+    EXPECT_CALL(*stream, Finish).WillOnce([] {
+      return make_ready_future(Status(StatusCode::kUnavailable, "try-again"));
+    });
+    return stream;
+  });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  Collector collector;
+  auto status = TailLogEntries(mock, background.cq(), TestRequest(),
+                               collector.Callback(), TestOptions())
+                    .get();
+  EXPECT_THAT(status, StatusIs(StatusCode::kUnavailable));
+}
+
+TEST(LogEntryTailTest, CancelFromCallback) {
+  auto mock = std::make_shared<MockLoggingServiceV2Connection>();
+  EXPECT_CALL(*mock, AsyncTailLogEntries).WillOnce([] {
+    auto stream = absl::make_unique<MockTailStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Write).WillOnce([] {
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Read)
+        .WillOnce([] { return ReadResponse(MakeResponse({{"a", 10}})); })
+        .WillOnce([] { return ReadResponse(MakeResponse({{"b", 11}})); })
+        .WillOnce(ReadEnd);
+    EXPECT_CALL(*stream, Cancel).Times(1);
+    EXPECT_CALL(*stream, Finish).WillOnce([] {
+      return make_ready_future(Status(StatusCode::kCancelled, "cancelled"));
+    });
+    return stream;
+  });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  std::vector<std::string> ids;
+  auto status =
+      TailLogEntries(mock, background.cq(), TestRequest(),
+                     [&ids](TailLogEntriesResponse r) {
+                       for (auto const& e : r.entries()) {
+                         ids.push_back(e.insert_id());
+                       }
+                       return make_ready_future(false);
+                     },
+                     TestOptions())
+          .get();
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(ids, ElementsAre("a"));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging
+}  // namespace cloud
+}  // namespace google
@@ -95,6 +95,12 @@ StreamRange<std::string> LoggingServiceV2Client::ListLogs(
   return connection_->ListLogs(std::move(request));
 }
 
+future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+LoggingServiceV2Client::AsyncListLogEntries(
+    google::logging::v2::ListLogEntriesRequest const& request) {
+  return connection_->AsyncListLogEntries(request);
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
 }  // namespace logging
 }  // namespace cloud
@@ -249,6 +249,16 @@ class LoggingServiceV2Client {
   StreamRange<std::string> ListLogs(
       google::logging::v2::ListLogsRequest request);
 
+  /**
+   * Asynchronously calls `ListLogEntries()`.
+   *
+   * The call is retried using the policies of the connection, the
+   * returned future is satisfied when the call completes.
+   */
+  future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+  AsyncListLogEntries(
+      google::logging::v2::ListLogEntriesRequest const& request);
+
  private:
   std::shared_ptr<LoggingServiceV2Connection> connection_;
 };
@@ -22,9 +22,14 @@
 #include "google/cloud/logging/logging_service_v2_options.h"
 #include "google/cloud/background_threads.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/async_retry_loop.h"
+#include "google/cloud/internal/grpc_compression.h"
+#include "google/cloud/internal/hedged_call.h"
 #include "google/cloud/internal/pagination_range.h"
 #include "google/cloud/internal/retry_loop.h"
+#include <map>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -85,6 +90,24 @@ StreamRange<std::string> LoggingServiceV2Connection::ListLogs(
       });
 }
 
+std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+    google::logging::v2::TailLogEntriesRequest,
+    google::logging::v2::TailLogEntriesResponse>>
+LoggingServiceV2Connection::AsyncTailLogEntries() {
+  return absl::make_unique<internal::AsyncStreamingReadWriteRpcError<
+      google::logging::v2::TailLogEntriesRequest,
+      google::logging::v2::TailLogEntriesResponse>>(
+      Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
+future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+LoggingServiceV2Connection::AsyncListLogEntries(
+    google::logging::v2::ListLogEntriesRequest const&) {
+  return google::cloud::make_ready_future<
+      StatusOr<google::logging::v2::ListLogEntriesResponse>>(
+      Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
 namespace {
 class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
  public:
@@ -98,6 +121,10 @@ class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
             options.get<LoggingServiceV2RetryPolicyOption>()->clone()),
         backoff_policy_prototype_(
             options.get<LoggingServiceV2BackoffPolicyOption>()->clone()),
+        page_prefetch_depth_(options.get<GrpcPaginationPrefetchDepthOption>()),
+        attempt_timeout_(options.get<GrpcAttemptTimeoutOption>()),
+        hedging_delays_(options.get<GrpcHedgingDelayOption>()),
+        compression_(options.get<GrpcCompressionOption>()),
         idempotency_policy_(
             options.get<LoggingServiceV2ConnectionIdempotencyPolicyOption>()
                 ->clone()) {}
@@ -106,26 +133,42 @@ class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
 
   Status DeleteLog(
       google::logging::v2::DeleteLogRequest const& request) override {
+    auto const idempotency = idempotency_policy_->DeleteLog(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->DeleteLog(request),
-        [this](grpc::ClientContext& context,
-               google::logging::v2::DeleteLogRequest const& request) {
-          return stub_->DeleteLog(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "LoggingServiceV2.DeleteLog", idempotency),
+            [this](grpc::ClientContext& context,
+                   google::logging::v2::DeleteLogRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "LoggingServiceV2.DeleteLog", request);
+              return stub_->DeleteLog(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StatusOr<google::logging::v2::WriteLogEntriesResponse> WriteLogEntries(
       google::logging::v2::WriteLogEntriesRequest const& request) override {
+    auto const idempotency = idempotency_policy_->WriteLogEntries(request);
     return google::cloud::internal::RetryLoop(
-        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
-        idempotency_policy_->WriteLogEntries(request),
-        [this](grpc::ClientContext& context,
-               google::logging::v2::WriteLogEntriesRequest const& request) {
-          return stub_->WriteLogEntries(context, request);
-        },
-        request, __func__);
+        retry_policy_prototype_->clone(), *backoff_policy_prototype_,
+        idempotency,
+        google::cloud::internal::MakeHedgedFunctor(
+            background_->cq(),
+            google::cloud::internal::HedgingDelay(
+                hedging_delays_, "LoggingServiceV2.WriteLogEntries",
+                idempotency),
+            [this](grpc::ClientContext& context,
+                   google::logging::v2::WriteLogEntriesRequest const& request) {
+              google::cloud::internal::ConfigureCompression(
+                  context, compression_, "LoggingServiceV2.WriteLogEntries",
+                  request);
+              return stub_->WriteLogEntries(context, request);
+            }),
+        request, __func__, attempt_timeout_);
   }
 
   StreamRange<google::logging::v2::LogEntry> ListLogEntries(
@@ -137,27 +180,31 @@ class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListLogEntries(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<
         StreamRange<google::logging::v2::LogEntry>>(
         std::move(request),
-        [stub, retry, backoff, idempotency,
+        [stub, retry, backoff, idempotency, attempt_timeout,
          function_name](google::logging::v2::ListLogEntriesRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](
                   grpc::ClientContext& context,
                   google::logging::v2::ListLogEntriesRequest const& request) {
                 return stub->ListLogEntries(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::logging::v2::ListLogEntriesResponse r) {
           std::vector<google::logging::v2::LogEntry> result(r.entries().size());
           auto& messages = *r.mutable_entries();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StreamRange<google::api::MonitoredResourceDescriptor>
@@ -172,22 +219,23 @@ class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
         backoff_policy_prototype_->clone());
     auto idempotency =
         idempotency_policy_->ListMonitoredResourceDescriptors(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<
         StreamRange<google::api::MonitoredResourceDescriptor>>(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name](
+        [stub, retry, backoff, idempotency, attempt_timeout, function_name](
             google::logging::v2::ListMonitoredResourceDescriptorsRequest const&
                 r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](
                   grpc::ClientContext& context,
                   google::logging::v2::
                       ListMonitoredResourceDescriptorsRequest const& request) {
                 return stub->ListMonitoredResourceDescriptors(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::logging::v2::ListMonitoredResourceDescriptorsResponse r) {
           std::vector<google::api::MonitoredResourceDescriptor> result(
@@ -195,7 +243,10 @@ class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
           auto& messages = *r.mutable_resource_descriptors();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
   }
 
   StreamRange<std::string> ListLogs(
@@ -207,26 +258,54 @@ class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListLogs(request);
+    auto attempt_timeout = attempt_timeout_;
     char const* function_name = __func__;
     return google::cloud::internal::MakePaginationRange<
         StreamRange<std::string>>(
         std::move(request),
-        [stub, retry, backoff, idempotency,
+        [stub, retry, backoff, idempotency, attempt_timeout,
          function_name](google::logging::v2::ListLogsRequest const& r) {
           return google::cloud::internal::RetryLoop(
-              retry->clone(), backoff->clone(), idempotency,
+              retry->clone(), *backoff, idempotency,
               [stub](grpc::ClientContext& context,
                      google::logging::v2::ListLogsRequest const& request) {
                 return stub->ListLogs(context, request);
               },
-              r, function_name);
+              r, function_name, attempt_timeout);
         },
         [](google::logging::v2::ListLogsResponse r) {
           std::vector<std::string> result(r.log_names().size());
           auto& messages = *r.mutable_log_names();
           std::move(messages.begin(), messages.end(), result.begin());
           return result;
-        });
+        },
+        page_prefetch_depth_,
+        google::cloud::internal::MakeCompletionQueueExecutor(
+            background_->cq()));
+  }
+
+  std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+      google::logging::v2::TailLogEntriesRequest,
+      google::logging::v2::TailLogEntriesResponse>>
+  AsyncTailLogEntries() override {
+    auto cq = background_->cq();
+    return stub_->AsyncTailLogEntries(cq,
+                                      absl::make_unique<grpc::ClientContext>());
+  }
+
+  future<StatusOr<google::logging::v2::ListLogEntriesResponse>>
+  AsyncListLogEntries(
+      google::logging::v2::ListLogEntriesRequest const& request) override {
+    auto stub = stub_;
+    return google::cloud::internal::AsyncRetryLoop(
+        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
+        idempotency_policy_->ListLogEntries(request), background_->cq(),
+        [stub](google::cloud::CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               google::logging::v2::ListLogEntriesRequest const& request) {
+          return stub->AsyncListLogEntries(cq, std::move(context), request);
+        },
+        request, __func__, attempt_timeout_);
   }
 
  private:
@@ -234,6 +313,10 @@ class LoggingServiceV2ConnectionImpl : public LoggingServiceV2Connection {
   std::shared_ptr<logging_internal::LoggingServiceV2Stub> stub_;
   std::unique_ptr<LoggingServiceV2RetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
+  std::size_t page_prefetch_depth_;
+  std::chrono::milliseconds attempt_timeout_;
+  std::map<std::string, std::chrono::milliseconds> hedging_delays_;
+  std::map<std::string, std::size_t> compression_;
   std::unique_ptr<LoggingServiceV2ConnectionIdempotencyPolicy>
       idempotency_policy_;
 };
@@ -0,0 +1,158 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: google/logging/v2/logging.proto
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_MOCKS_FAKE_LOGGING_SERVICE_V2_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_MOCKS_FAKE_LOGGING_SERVICE_V2_SERVER_H
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include "google/cloud/version.h"
+#include <google/logging/v2/logging.grpc.pb.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace logging_mocks {
+inline namespace GOOGLE_CLOUD_CPP_GENERATED_NS {
+
+/**
+ * An in-process fake for `LoggingServiceV2`.
+ *
+ * Register this class with a `testing_util::EmbeddedGrpcServer` to
+ * benchmark or test the client library with the full gRPC stack. Each RPC
+ * simulates the latency and errors configured in its
+ * `testing_util::FakeServerBehavior`, and returns a canned response, which
+ * includes a payload of the configured size.
+ *
+ * The canned responses must be changed before the server starts.
+ */
+class FakeLoggingServiceV2Server
+    : public google::logging::v2::LoggingServiceV2::Service {
+ public:
+  explicit FakeLoggingServiceV2Server(
+      testing_util::FakeServerConfig config = {})
+      : behavior_(std::move(config)) {
+    behavior_.FillPayload(delete_log_response_);
+    behavior_.FillPayload(write_log_entries_response_);
+    behavior_.FillPayload(list_log_entries_response_);
+    behavior_.FillPayload(list_monitored_resource_descriptors_response_);
+    behavior_.FillPayload(list_logs_response_);
+    behavior_.FillPayload(tail_log_entries_response_);
+  }
+
+  testing_util::FakeServerBehavior& behavior() { return behavior_; }
+
+  void set_delete_log_response(google::protobuf::Empty response) {
+    delete_log_response_ = std::move(response);
+  }
+
+  grpc::Status DeleteLog(grpc::ServerContext*,
+                         google::logging::v2::DeleteLogRequest const*,
+                         google::protobuf::Empty* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = delete_log_response_;
+    return status;
+  }
+
+  void set_write_log_entries_response(
+      google::logging::v2::WriteLogEntriesResponse response) {
+    write_log_entries_response_ = std::move(response);
+  }
+
+  grpc::Status WriteLogEntries(
+      grpc::ServerContext*, google::logging::v2::WriteLogEntriesRequest const*,
+      google::logging::v2::WriteLogEntriesResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = write_log_entries_response_;
+    return status;
+  }
+
+  void set_list_log_entries_response(
+      google::logging::v2::ListLogEntriesResponse response) {
+    list_log_entries_response_ = std::move(response);
+  }
+
+  grpc::Status ListLogEntries(
+      grpc::ServerContext*, google::logging::v2::ListLogEntriesRequest const*,
+      google::logging::v2::ListLogEntriesResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_log_entries_response_;
+    return status;
+  }
+
+  void set_list_monitored_resource_descriptors_response(
+      google::logging::v2::ListMonitoredResourceDescriptorsResponse response) {
+    list_monitored_resource_descriptors_response_ = std::move(response);
+  }
+
+  grpc::Status ListMonitoredResourceDescriptors(
+      grpc::ServerContext*,
+      google::logging::v2::ListMonitoredResourceDescriptorsRequest const*,
+      google::logging::v2::ListMonitoredResourceDescriptorsResponse* response)
+      override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_monitored_resource_descriptors_response_;
+    return status;
+  }
+
+  void set_list_logs_response(google::logging::v2::ListLogsResponse response) {
+    list_logs_response_ = std::move(response);
+  }
+
+  grpc::Status ListLogs(
+      grpc::ServerContext*, google::logging::v2::ListLogsRequest const*,
+      google::logging::v2::ListLogsResponse* response) override {
+    auto status = behavior_.Simulate();
+    if (status.ok()) *response = list_logs_response_;
+    return status;
+  }
+
+  void set_tail_log_entries_response(
+      google::logging::v2::TailLogEntriesResponse response) {
+    tail_log_entries_response_ = std::move(response);
+  }
+
+  grpc::Status TailLogEntries(
+      grpc::ServerContext*,
+      grpc::ServerReaderWriter<google::logging::v2::TailLogEntriesResponse,
+                               google::logging::v2::TailLogEntriesRequest>*
+          stream) override {
+    google::logging::v2::TailLogEntriesRequest request;
+    while (stream->Read(&request)) {
+      auto status = behavior_.Simulate();
+      if (!status.ok()) return status;
+      if (!stream->Write(tail_log_entries_response_)) break;
+    }
+    return grpc::Status::OK;
+  }
+
+ private:
+  testing_util::FakeServerBehavior behavior_;
+  google::protobuf::Empty delete_log_response_;
+  google::logging::v2::WriteLogEntriesResponse write_log_entries_response_;
+  google::logging::v2::ListLogEntriesResponse list_log_entries_response_;
+  google::logging::v2::ListMonitoredResourceDescriptorsResponse
+      list_monitored_resource_descriptors_response_;
+  google::logging::v2::ListLogsResponse list_logs_response_;
+  google::logging::v2::TailLogEntriesResponse tail_log_entries_response_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
+}  // namespace logging_mocks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_LOGGING_MOCKS_FAKE_LOGGING_SERVICE_V2_SERVER_H
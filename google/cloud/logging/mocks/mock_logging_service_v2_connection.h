@@ -49,6 +49,16 @@ class MockLoggingServiceV2Connection
 
   MOCK_METHOD(StreamRange<std::string>, ListLogs,
               (google::logging::v2::ListLogsRequest request), (override));
+
+  MOCK_METHOD((std::unique_ptr<internal::AsyncStreamingReadWriteRpc<
+                   google::logging::v2::TailLogEntriesRequest,
+                   google::logging::v2::TailLogEntriesResponse>>),
+              AsyncTailLogEntries, (), (override));
+
+  MOCK_METHOD(future<StatusOr<google::logging::v2::ListLogEntriesResponse>>,
+              AsyncListLogEntries,
+              (google::logging::v2::ListLogEntriesRequest const& request),
+              (override));
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_GENERATED_NS
@@ -0,0 +1,73 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/memory_accountant.h"
+#include <algorithm>
+#include <map>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+std::shared_ptr<MemoryAccount> MemoryAccountant::CreateAccount(
+    std::string client) {
+  auto account =
+      std::make_shared<MemoryAccount>(shared_from_this(), std::move(client));
+  std::lock_guard<std::mutex> lk(mu_);
+  accounts_.erase(std::remove_if(accounts_.begin(), accounts_.end(),
+                                 [](std::weak_ptr<MemoryAccount> const& a) {
+                                   return a.expired();
+                                 }),
+                  accounts_.end());
+  accounts_.push_back(account);
+  return account;
+}
+
+std::vector<MemoryUsage> MemoryAccountant::Snapshot() const {
+  std::map<std::string, std::int64_t> merged;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto const& a : accounts_) {
+      auto account = a.lock();
+      if (account) merged[account->client()] += account->bytes();
+    }
+  }
+  std::vector<MemoryUsage> result;
+  result.reserve(merged.size());
+  for (auto& kv : merged) result.push_back(MemoryUsage{kv.first, kv.second});
+  return result;
+}
+
+void MemoryAccountant::Update(std::int64_t delta) {
+  auto const bytes = bytes_.fetch_add(delta) + delta;
+  auto peak = peak_bytes_.load();
+  while (bytes > peak) {
+    if (peak_bytes_.compare_exchange_weak(peak, bytes)) break;
+  }
+}
+
+namespace internal {
+
+std::shared_ptr<MemoryAccount> MakeMemoryAccount(Options const& opts,
+                                                 std::string client) {
+  if (!opts.has<MemoryAccountantOption>()) return nullptr;
+  auto const& accountant = opts.get<MemoryAccountantOption>();
+  if (!accountant) return nullptr;
+  return accountant->CreateAccount(std::move(client));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
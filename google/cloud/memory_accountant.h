@@ -0,0 +1,218 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_MEMORY_ACCOUNTANT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_MEMORY_ACCOUNTANT_H
+
+#include "google/cloud/options.h"
+#include "google/cloud/version.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+class MemoryAccount;
+
+/// The memory buffered by one client, see `MemoryAccountant::Snapshot()`.
+struct MemoryUsage {
+  std::string client;
+  std::int64_t bytes;
+};
+
+/**
+ * Tracks the memory buffered inside the client libraries.
+ *
+ * Configure the clients with the same `MemoryAccountantOption` to track the
+ * bytes they buffer: messages waiting to be published or delivered in
+ * Pub/Sub, mutations waiting in a Bigtable `MutationBatcher`, responses read
+ * ahead in Spanner, and upload buffers in Storage.
+ *
+ * With a soft limit, the clients apply backpressure while the total is over
+ * the limit, before the process runs out of memory:
+ * - A Pub/Sub publisher is considered full, and applies its
+ *   `PublisherOptions` full publisher action.
+ * - A Bigtable `MutationBatcher` admits no new mutations.
+ * - Spanner stops reading ahead of the application.
+ *
+ * The clients always make progress with at least one message, mutation, or
+ * response, so the total can exceed the soft limit.
+ *
+ * @par Example
+ * @code
+ * auto accountant = std::make_shared<google::cloud::MemoryAccountant>(
+ *     512 * 1024 * 1024);
+ * auto options = google::cloud::Options{}
+ *     .set<google::cloud::MemoryAccountantOption>(accountant);
+ * // ... create clients with `options` and use them ...
+ * for (auto const& u : accountant->Snapshot()) {
+ *   std::cout << u.client << ": " << u.bytes << "\n";
+ * }
+ * @endcode
+ *
+ * @par Thread-safety
+ * All the member functions are thread-safe.
+ */
+class MemoryAccountant
+    : public std::enable_shared_from_this<MemoryAccountant> {
+ public:
+  /// Creates an accountant, a zero @p soft_limit disables the backpressure.
+  explicit MemoryAccountant(std::int64_t soft_limit = 0)
+      : soft_limit_(soft_limit) {}
+  MemoryAccountant(MemoryAccountant const&) = delete;
+  MemoryAccountant& operator=(MemoryAccountant const&) = delete;
+
+  /// Creates the account where one client reports its buffered bytes.
+  std::shared_ptr<MemoryAccount> CreateAccount(std::string client);
+
+  std::int64_t soft_limit() const { return soft_limit_.load(); }
+  void set_soft_limit(std::int64_t bytes) { soft_limit_.store(bytes); }
+
+  /// The bytes buffered by all the clients.
+  std::int64_t bytes() const { return bytes_.load(); }
+
+  /// The maximum value of `bytes()` since this object was created.
+  std::int64_t peak_bytes() const { return peak_bytes_.load(); }
+
+  /// Returns true if the clients should apply backpressure.
+  bool OverSoftLimit() const {
+    auto const limit = soft_limit();
+    return limit > 0 && bytes() > limit;
+  }
+
+  /**
+   * Returns the bytes buffered by each client, sorted by name.
+   *
+   * Accounts created with the same client name are merged.
+   */
+  std::vector<MemoryUsage> Snapshot() const;
+
+ private:
+  friend class MemoryAccount;
+  void Update(std::int64_t delta);
+
+  std::atomic<std::int64_t> soft_limit_;
+  std::atomic<std::int64_t> bytes_{0};
+  std::atomic<std::int64_t> peak_bytes_{0};
+  mutable std::mutex mu_;
+  std::vector<std::weak_ptr<MemoryAccount>> accounts_;
+};
+
+/**
+ * The bytes buffered by one client.
+ *
+ * Use `MemoryAccountant::CreateAccount()` to create these objects. Any bytes
+ * still in the account are returned to the accountant when it is deleted.
+ */
+class MemoryAccount {
+ public:
+  MemoryAccount(std::shared_ptr<MemoryAccountant> accountant,
+                std::string client)
+      : accountant_(std::move(accountant)), client_(std::move(client)) {}
+  ~MemoryAccount() { accountant_->Update(-bytes_.load()); }
+  MemoryAccount(MemoryAccount const&) = delete;
+  MemoryAccount& operator=(MemoryAccount const&) = delete;
+
+  /// Adds @p delta bytes, use a negative value to release bytes.
+  void Add(std::int64_t delta) {
+    bytes_.fetch_add(delta);
+    accountant_->Update(delta);
+  }
+
+  std::int64_t bytes() const { return bytes_.load(); }
+  std::string const& client() const { return client_; }
+  bool OverSoftLimit() const { return accountant_->OverSoftLimit(); }
+
+ private:
+  std::shared_ptr<MemoryAccountant> const accountant_;
+  std::string const client_;
+  std::atomic<std::int64_t> bytes_{0};
+};
+
+/**
+ * Track the memory buffered by the clients.
+ *
+ * If set, the clients report the bytes they buffer to this object, and apply
+ * backpressure while it is over its soft limit.
+ */
+struct MemoryAccountantOption {
+  using Type = std::shared_ptr<MemoryAccountant>;
+};
+
+namespace internal {
+
+/**
+ * The bytes held by one buffer, reported to a `MemoryAccount`.
+ *
+ * The components keep one of these objects next to each buffer, and resize it
+ * as the buffer grows and shrinks. The bytes are released when the object is
+ * deleted. Without an account all the operations are no-ops.
+ *
+ * @par Thread-safety
+ * Like most value types, this class is not thread-safe. Use the same
+ * synchronization as the buffer it tracks.
+ */
+class MemoryReservation {
+ public:
+  MemoryReservation() = default;
+  explicit MemoryReservation(std::shared_ptr<MemoryAccount> account)
+      : account_(std::move(account)) {}
+  ~MemoryReservation() { Resize(0); }
+
+  MemoryReservation(MemoryReservation&& rhs) noexcept
+      : account_(std::move(rhs.account_)), bytes_(rhs.bytes_) {
+    rhs.bytes_ = 0;
+  }
+  MemoryReservation& operator=(MemoryReservation&& rhs) noexcept {
+    Resize(0);
+    account_ = std::move(rhs.account_);
+    bytes_ = rhs.bytes_;
+    rhs.bytes_ = 0;
+    return *this;
+  }
+  MemoryReservation(MemoryReservation const&) = delete;
+  MemoryReservation& operator=(MemoryReservation const&) = delete;
+
+  void Resize(std::int64_t bytes) {
+    if (!account_ || bytes == bytes_) return;
+    account_->Add(bytes - bytes_);
+    bytes_ = bytes;
+  }
+  void Add(std::int64_t delta) { Resize(bytes_ + delta); }
+
+  std::int64_t bytes() const { return bytes_; }
+  bool OverSoftLimit() const { return account_ && account_->OverSoftLimit(); }
+  std::shared_ptr<MemoryAccount> const& account() const { return account_; }
+
+ private:
+  std::shared_ptr<MemoryAccount> account_;
+  std::int64_t bytes_ = 0;
+};
+
+/// Creates an account for @p client, or `nullptr` if @p opts has no
+/// `MemoryAccountantOption`.
+std::shared_ptr<MemoryAccount> MakeMemoryAccount(Options const& opts,
+                                                 std::string client);
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_MEMORY_ACCOUNTANT_H
@@ -0,0 +1,138 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/memory_accountant.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Field;
+
+TEST(MemoryAccountant, Basic) {
+  auto accountant = std::make_shared<MemoryAccountant>();
+  auto a = accountant->CreateAccount("a");
+  auto b = accountant->CreateAccount("b");
+  a->Add(100);
+  b->Add(50);
+  a->Add(-30);
+  EXPECT_EQ(70, a->bytes());
+  EXPECT_EQ(50, b->bytes());
+  EXPECT_EQ(120, accountant->bytes());
+  EXPECT_EQ(150, accountant->peak_bytes());
+  EXPECT_FALSE(accountant->OverSoftLimit());
+}
+
+TEST(MemoryAccountant, SoftLimit) {
+  auto accountant = std::make_shared<MemoryAccountant>(100);
+  auto a = accountant->CreateAccount("a");
+  a->Add(100);
+  EXPECT_FALSE(a->OverSoftLimit());
+  a->Add(1);
+  EXPECT_TRUE(a->OverSoftLimit());
+  accountant->set_soft_limit(200);
+  EXPECT_FALSE(a->OverSoftLimit());
+  accountant->set_soft_limit(0);
+  a->Add(1000);
+  EXPECT_FALSE(a->OverSoftLimit());
+}
+
+TEST(MemoryAccountant, Snapshot) {
+  auto accountant = std::make_shared<MemoryAccountant>();
+  auto b = accountant->CreateAccount("b");
+  auto a0 = accountant->CreateAccount("a");
+  auto a1 = accountant->CreateAccount("a");
+  a0->Add(10);
+  a1->Add(20);
+  b->Add(5);
+  EXPECT_THAT(accountant->Snapshot(),
+              ElementsAre(AllOf(Field(&MemoryUsage::client, "a"),
+                                Field(&MemoryUsage::bytes, 30)),
+                          AllOf(Field(&MemoryUsage::client, "b"),
+                                Field(&MemoryUsage::bytes, 5))));
+
+  // Deleting an account returns its bytes.
+  b.reset();
+  EXPECT_EQ(30, accountant->bytes());
+  EXPECT_THAT(accountant->Snapshot(),
+              ElementsAre(Field(&MemoryUsage::client, "a")));
+}
+
+TEST(MemoryAccountant, Concurrent) {
+  auto constexpr kThreads = 4;
+  auto constexpr kIterations = 10000;
+  auto accountant = std::make_shared<MemoryAccountant>();
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([accountant] {
+      auto account = accountant->CreateAccount("test");
+      for (int i = 0; i != kIterations; ++i) {
+        account->Add(8);
+        account->Add(-8);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(0, accountant->bytes());
+  EXPECT_LE(accountant->peak_bytes(), 8 * kThreads);
+}
+
+TEST(MemoryReservation, Resize) {
+  auto accountant = std::make_shared<MemoryAccountant>(100);
+  auto account = accountant->CreateAccount("test");
+  {
+    internal::MemoryReservation r(account);
+    r.Resize(80);
+    EXPECT_EQ(80, account->bytes());
+    r.Add(40);
+    EXPECT_EQ(120, r.bytes());
+    EXPECT_TRUE(r.OverSoftLimit());
+
+    internal::MemoryReservation moved(std::move(r));
+    EXPECT_EQ(0, r.bytes());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(120, moved.bytes());
+    moved.Resize(10);
+    EXPECT_EQ(10, account->bytes());
+  }
+  EXPECT_EQ(0, account->bytes());
+  EXPECT_EQ(0, accountant->bytes());
+}
+
+TEST(MemoryReservation, NoAccount) {
+  internal::MemoryReservation r;
+  r.Resize(100);
+  EXPECT_EQ(0, r.bytes());
+  EXPECT_FALSE(r.OverSoftLimit());
+}
+
+TEST(MemoryAccountant, MakeMemoryAccount) {
+  EXPECT_EQ(nullptr, internal::MakeMemoryAccount(Options{}, "test"));
+  auto accountant = std::make_shared<MemoryAccountant>();
+  auto account = internal::MakeMemoryAccount(
+      Options{}.set<MemoryAccountantOption>(accountant), "test");
+  ASSERT_NE(nullptr, account);
+  account->Add(42);
+  EXPECT_EQ(42, accountant->bytes());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
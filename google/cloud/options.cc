@@ -16,27 +16,69 @@
 #include "google/cloud/internal/algorithm.h"
 #include "google/cloud/log.h"
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <set>
-#include <unordered_map>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
+
+Options::Options(Options const& rhs) : m_(rhs.m_) {
+  for (auto& e : m_) {
+    if (!e.escaped) continue;
+    e.data = e.data->Clone();
+    e.escaped = false;
+  }
+}
+
+Options& Options::operator=(Options const& rhs) {
+  Options tmp(rhs);
+  m_.swap(tmp.m_);
+  return *this;
+}
+
 namespace internal {
 
+std::size_t OptionId(std::type_index const& type) {
+  // Only called once for each option type (in each module), the ids are
+  // cached in `Options::Id<T>()`.
+  static auto* const kMu = new std::mutex;
+  static auto* const kIds = new std::map<std::type_index, std::size_t>;
+  std::lock_guard<std::mutex> lk(*kMu);
+  return kIds->emplace(type, kIds->size()).first->second;
+}
+
 void CheckExpectedOptionsImpl(std::set<std::type_index> const& expected,
                               Options const& opts, char const* const caller) {
-  for (auto const& p : opts.m_) {
-    if (!Contains(expected, p.first)) {
+  for (auto const& e : opts.m_) {
+    auto const type = e.data->type();
+    if (!Contains(expected, type)) {
       GCP_LOG(WARNING) << caller << ": Unexpected option (mangled name): "
-                       << p.first.name();
+                       << type.name();
     }
   }
 }
 
 Options MergeOptions(Options a, Options b) {
-  a.m_.insert(std::make_move_iterator(b.m_.begin()),
-              std::make_move_iterator(b.m_.end()));
+  if (b.m_.empty()) return a;
+  if (a.m_.empty()) return b;
+  // Both vectors are sorted by id, the values in `a` take precedence.
+  std::vector<Options::Entry> merged;
+  merged.reserve(a.m_.size() + b.m_.size());
+  auto i = a.m_.begin();
+  auto j = b.m_.begin();
+  while (i != a.m_.end() && j != b.m_.end()) {
+    if (j->id < i->id) {
+      merged.push_back(std::move(*j++));
+      continue;
+    }
+    if (j->id == i->id) ++j;
+    merged.push_back(std::move(*i++));
+  }
+  std::move(i, a.m_.end(), std::back_inserter(merged));
+  std::move(j, b.m_.end(), std::back_inserter(merged));
+  a.m_ = std::move(merged);
   return a;
 }
 
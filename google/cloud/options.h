@@ -17,11 +17,13 @@
 
 #include "google/cloud/internal/type_list.h"
 #include "google/cloud/version.h"
-#include "absl/types/any.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <set>
 #include <typeindex>
 #include <typeinfo>
-#include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -32,6 +34,9 @@ namespace internal {
 Options MergeOptions(Options, Options);
 void CheckExpectedOptionsImpl(std::set<std::type_index> const&, Options const&,
                               char const*);
+// Returns a small integer that identifies the option type. Each type gets the
+// same id in all the modules (e.g. DLLs) of an application.
+std::size_t OptionId(std::type_index const& type);
 }  // namespace internal
 
 /**
@@ -87,8 +92,8 @@ class Options {
   /// Constructs an empty instance.
   Options() = default;
 
-  Options(Options const&) = default;
-  Options& operator=(Options const&) = default;
+  Options(Options const& rhs);
+  Options& operator=(Options const& rhs);
   Options(Options&&) = default;
   Options& operator=(Options&&) = default;
 
@@ -107,7 +112,19 @@ class Options {
    */
   template <typename T>
   Options& set(ValueTypeT<T> v) {
-    m_[typeid(T)] = Data<T>{std::move(v)};
+    auto const it = Find(Id<T>());
+    if (it != m_.end() && it->id == Id<T>()) {
+      // Values shared with copies of this object are never modified.
+      if (it->data.use_count() == 1) {
+        static_cast<Data<T>&>(*it->data).value = std::move(v);
+      } else {
+        it->data = std::make_shared<Data<T>>(std::move(v));
+        it->escaped = false;
+      }
+      return *this;
+    }
+    m_.insert(it,
+              Entry{Id<T>(), std::make_shared<Data<T>>(std::move(v)), false});
     return *this;
   }
 
@@ -118,7 +135,8 @@ class Options {
    */
   template <typename T>
   bool has() const {
-    return m_.find(typeid(T)) != m_.end();
+    auto const it = Find(Id<T>());
+    return it != m_.end() && it->id == Id<T>();
   }
 
   /**
@@ -128,7 +146,8 @@ class Options {
    */
   template <typename T>
   void unset() {
-    m_.erase(typeid(T));
+    auto const it = Find(Id<T>());
+    if (it != m_.end() && it->id == Id<T>()) m_.erase(it);
   }
 
   /**
@@ -157,8 +176,10 @@ class Options {
   template <typename T>
   ValueTypeT<T> const& get() const {
     static auto const* const kDefaultValue = new ValueTypeT<T>{};
-    auto const it = m_.find(typeid(T));
-    if (it != m_.end()) return absl::any_cast<Data<T>>(&it->second)->value;
+    auto const it = Find(Id<T>());
+    if (it != m_.end() && it->id == Id<T>()) {
+      return static_cast<Data<T> const&>(*it->data).value;
+    }
     return *kDefaultValue;
   }
 
@@ -184,8 +205,18 @@ class Options {
    */
   template <typename T>
   ValueTypeT<T>& lookup(ValueTypeT<T> init_value = {}) {
-    auto const p = m_.emplace(typeid(T), Data<T>{std::move(init_value)});
-    return absl::any_cast<Data<T>>(&p.first->second)->value;
+    auto it = Find(Id<T>());
+    if (it == m_.end() || it->id != Id<T>()) {
+      it = m_.insert(
+          it, Entry{Id<T>(), std::make_shared<Data<T>>(std::move(init_value)),
+                    false});
+    } else if (it->data.use_count() != 1) {
+      it->data = it->data->Clone();
+    }
+    // The caller may modify the value through the returned reference, copies
+    // of this object must not share it.
+    it->escaped = true;
+    return static_cast<Data<T>&>(*it->data).value;
   }
 
  private:
@@ -193,14 +224,55 @@ class Options {
   friend void internal::CheckExpectedOptionsImpl(
       std::set<std::type_index> const&, Options const&, char const*);
 
+  // The base class for the holders of all the option values.
+  struct DataHolder {
+    virtual ~DataHolder() = default;
+    virtual std::type_index type() const = 0;
+    virtual std::shared_ptr<DataHolder> Clone() const = 0;
+  };
+
   // The data holder for all the option values.
   template <typename T>
-  struct Data {
+  struct Data : public DataHolder {
+    explicit Data(ValueTypeT<T> v) : value(std::move(v)) {}
+    std::type_index type() const override { return typeid(T); }
+    std::shared_ptr<DataHolder> Clone() const override {
+      return std::make_shared<Data<T>>(value);
+    }
+
     ValueTypeT<T> value;
   };
 
-  // The `absl::any` objects all hold a `Data<T>`
-  std::unordered_map<std::type_index, absl::any> m_;
+  // Copies of an `Options` share the values, copying an `Options` does not
+  // copy any option values, and `get<T>()` is a binary search over a few
+  // integers. Values are immutable while shared, `set<T>()` replaces a shared
+  // value. The references returned by `lookup<T>()` can modify the value at
+  // any time, these values are `escaped` and are copied with the `Options`.
+  struct Entry {
+    std::size_t id;
+    std::shared_ptr<DataHolder> data;
+    bool escaped;
+  };
+
+  template <typename T>
+  static std::size_t Id() {
+    static auto const kId = internal::OptionId(typeid(T));
+    return kId;
+  }
+
+  std::vector<Entry>::iterator Find(std::size_t id) {
+    return std::lower_bound(
+        m_.begin(), m_.end(), id,
+        [](Entry const& e, std::size_t v) { return e.id < v; });
+  }
+  std::vector<Entry>::const_iterator Find(std::size_t id) const {
+    return std::lower_bound(
+        m_.begin(), m_.end(), id,
+        [](Entry const& e, std::size_t v) { return e.id < v; });
+  }
+
+  // Sorted by `id`.
+  std::vector<Entry> m_;
 };
 
 /**
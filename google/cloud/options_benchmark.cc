@@ -0,0 +1,122 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/options.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <set>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+// Run on (1 X 2100 MHz CPU )
+// CPU Caches:
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Before, with a `std::unordered_map<std::type_index, absl::any>`:
+// -------------------------------------------------------------
+// Benchmark                   Time             CPU   Iterations
+// -------------------------------------------------------------
+// BM_OptionsCopy            449 ns          446 ns      1567153
+// BM_OptionsGet            44.0 ns         43.8 ns     16083936
+// BM_OptionsGetUnset       35.5 ns         35.3 ns     17557970
+// BM_OptionsMerge          1047 ns         1036 ns       683702
+//
+// After, with a sorted vector of shared values:
+// -------------------------------------------------------------
+// Benchmark                   Time             CPU   Iterations
+// -------------------------------------------------------------
+// BM_OptionsCopy           33.2 ns         32.4 ns     21488316
+// BM_OptionsGet            6.83 ns         6.76 ns    105003090
+// BM_OptionsGetUnset       6.28 ns         6.19 ns    136656078
+// BM_OptionsMerge           111 ns          110 ns      6524256
+
+template <int N>
+struct IntOption {
+  using Type = int;
+};
+struct StringOption {
+  using Type = std::string;
+};
+struct SetOption {
+  using Type = std::set<std::string>;
+};
+struct DurationOption {
+  using Type = std::chrono::milliseconds;
+};
+struct UnsetOption {
+  using Type = std::string;
+};
+
+// Roughly the number and type of options used by a typical client.
+Options MakeOptions() {
+  return Options{}
+      .set<IntOption<0>>(0)
+      .set<IntOption<1>>(1)
+      .set<IntOption<2>>(2)
+      .set<IntOption<3>>(3)
+      .set<IntOption<4>>(4)
+      .set<IntOption<5>>(5)
+      .set<StringOption>("storage.googleapis.com")
+      .set<SetOption>({"rpc", "rpc-streams"})
+      .set<DurationOption>(std::chrono::milliseconds(100));
+}
+
+void BM_OptionsCopy(benchmark::State& state) {
+  auto const opts = MakeOptions();
+  for (auto _ : state) {
+    auto copy = opts;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_OptionsCopy);
+
+void BM_OptionsGet(benchmark::State& state) {
+  auto const opts = MakeOptions();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(opts.get<StringOption>());
+  }
+}
+BENCHMARK(BM_OptionsGet);
+
+void BM_OptionsGetUnset(benchmark::State& state) {
+  auto const opts = MakeOptions();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(opts.get<UnsetOption>());
+  }
+}
+BENCHMARK(BM_OptionsGetUnset);
+
+void BM_OptionsMerge(benchmark::State& state) {
+  auto const defaults = MakeOptions();
+  auto const opts = Options{}
+                        .set<IntOption<1>>(42)
+                        .set<StringOption>("localhost:9000")
+                        .set<UnsetOption>("test");
+  for (auto _ : state) {
+    auto merged = internal::MergeOptions(opts, defaults);
+    benchmark::DoNotOptimize(merged);
+  }
+}
+BENCHMARK(BM_OptionsMerge);
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
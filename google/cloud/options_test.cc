@@ -142,6 +142,39 @@ TEST(Options, Copy) {
   EXPECT_EQ("foo", copy.get<StringOption>());
 }
 
+TEST(Options, CopiesAreIndependent) {
+  auto a = Options{}.set<IntOption>(42).set<StringOption>("foo");
+  auto copy = a;
+  copy.set<IntOption>(7);
+  copy.unset<StringOption>();
+  copy.set<BoolOption>(true);
+  EXPECT_EQ(42, a.get<IntOption>());
+  EXPECT_EQ("foo", a.get<StringOption>());
+  EXPECT_FALSE(a.has<BoolOption>());
+  EXPECT_EQ(7, copy.get<IntOption>());
+  EXPECT_FALSE(copy.has<StringOption>());
+
+  a.lookup<StringOption>() = "bar";
+  EXPECT_EQ("bar", a.get<StringOption>());
+  auto other = a;  // NOLINT(performance-unnecessary-copy-initialization)
+  EXPECT_EQ("bar", other.get<StringOption>());
+}
+
+TEST(Options, CopyAfterLookup) {
+  Options a;
+  auto& value = a.lookup<StringOption>("foo");
+  auto copy = a;
+  // The reference returned by `lookup()` changes `a`, but not its copies.
+  value = "bar";
+  EXPECT_EQ("bar", a.get<StringOption>());
+  EXPECT_EQ("foo", copy.get<StringOption>());
+
+  copy = a;
+  value = "baz";
+  EXPECT_EQ("baz", a.get<StringOption>());
+  EXPECT_EQ("bar", copy.get<StringOption>());
+}
+
 TEST(Options, Move) {
   auto a = Options{}.set<IntOption>(42).set<BoolOption>(true).set<StringOption>(
       "foo");
@@ -260,6 +293,16 @@ TEST(MergeOptions, Basics) {
   EXPECT_EQ(a.get<IntOption>(), 42);           // From a
 }
 
+TEST(MergeOptions, Empty) {
+  auto a = Options{}.set<IntOption>(42);
+  auto merged = internal::MergeOptions(a, Options{});
+  EXPECT_EQ(42, merged.get<IntOption>());
+  merged = internal::MergeOptions(Options{}, a);
+  EXPECT_EQ(42, merged.get<IntOption>());
+  merged = internal::MergeOptions(Options{}, Options{});
+  EXPECT_FALSE(merged.has<IntOption>());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -17,6 +17,7 @@
 
 #include "google/cloud/pubsub/version.h"
 #include <functional>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -24,6 +25,7 @@ namespace pubsub {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 class Message;
 class AckHandler;
+class BatchAckHandler;
 
 /**
  * Defines the interface for application-level callbacks.
@@ -34,6 +36,16 @@ class AckHandler;
  */
 using ApplicationCallback = std::function<void(Message, AckHandler)>;
 
+/**
+ * Defines the interface for application-level callbacks receiving batches.
+ *
+ * Applications provide a callable compatible with this type to receive several
+ * messages in each call. They acknowledge (or reject) all the messages in the
+ * batch using `BatchAckHandler`.
+ */
+using BatchApplicationCallback =
+    std::function<void(std::vector<Message>, BatchAckHandler)>;
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub
 }  // namespace cloud
@@ -0,0 +1,103 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BATCH_ACK_HANDLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BATCH_ACK_HANDLER_H
+
+#include "google/cloud/pubsub/version.h"
+#include <cstddef>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Defines the interface to acknowledge and reject a batch of messages.
+ *
+ * Applications receiving messages via `Subscriber::SubscribeBatch()` get a
+ * batch of messages and a single `pubsub::BatchAckHandler`. Actions on the
+ * handler affect all the messages in the batch, and are sent to the service in
+ * a single request.
+ *
+ * Like `pubsub::AckHandler`, this class is move-able but not copy-able, and
+ * if it is destroyed before calling `ack()` or `nack()` the messages are
+ * rejected.
+ *
+ * @par Thread Safety
+ * This class is *thread compatible*, only one thread should call non-const
+ * member functions of this class at a time. Note that because the non-const
+ * member functions are `&&` overloads the application can only call `ack()` or
+ * `nack()` exactly once, and only one of them.
+ */
+class BatchAckHandler {
+ public:
+  ~BatchAckHandler();
+
+  BatchAckHandler(BatchAckHandler&&) noexcept = default;
+  BatchAckHandler& operator=(BatchAckHandler&&) noexcept = default;
+
+  /**
+   * Acknowledges all the messages in the batch.
+   *
+   * @par Idempotency
+   * Note that this is not an idempotent operation, and therefore it is never
+   * retried. See `AckHandler::ack()` for more details.
+   */
+  void ack() && {
+    auto impl = std::move(impl_);
+    impl->ack();
+  }
+
+  /**
+   * Rejects all the messages in the batch.
+   *
+   * @par Idempotency
+   * Note that this is not an idempotent operation, and therefore it is never
+   * retried. See `AckHandler::nack()` for more details.
+   */
+  void nack() && {
+    auto impl = std::move(impl_);
+    impl->nack();
+  }
+
+  /// The number of messages in the batch.
+  std::size_t size() const { return impl_->size(); }
+
+  /// Allow applications to mock a `BatchAckHandler`.
+  class Impl {
+   public:
+    virtual ~Impl() = 0;
+    /// The implementation for `BatchAckHandler::ack()`
+    virtual void ack() {}
+    /// The implementation for `BatchAckHandler::nack()`
+    virtual void nack() {}
+    /// The implementation for `BatchAckHandler::size()`
+    virtual std::size_t size() const { return 0; }
+  };
+
+  explicit BatchAckHandler(std::unique_ptr<Impl> impl)
+      : impl_(std::move(impl)) {}
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BATCH_ACK_HANDLER_H
@@ -0,0 +1,268 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/benchmarks/embedded_server.h"
+#include <google/pubsub/v1/pubsub.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pubsub_proto = ::google::pubsub::v1;
+
+namespace google {
+namespace cloud {
+namespace pubsub_benchmarks {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+// The service limits each `StreamingPullResponse` to about 10MB, this is
+// sufficient for the benchmarks.
+auto constexpr kMaxMessagesPerResponse = 1000;
+
+/// The published messages, waiting to be delivered.
+class MessageQueue {
+ public:
+  explicit MessageQueue(std::size_t max_bytes) : max_bytes_(max_bytes) {}
+
+  /// Returns false if the message is dropped.
+  bool Push(pubsub_proto::PubsubMessage m) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const size = m.ByteSizeLong();
+    if (bytes_ >= max_bytes_) return false;
+    bytes_ += size;
+    messages_.push_back(std::move(m));
+    cv_.notify_one();
+    return true;
+  }
+
+  /// Wait until there are messages, or the timeout expires, or on shutdown.
+  std::vector<pubsub_proto::PubsubMessage> Pop(
+      std::size_t max_count, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait_for(lk, timeout, [&] { return shutdown_ || !messages_.empty(); });
+    auto const count = (std::min)(max_count, messages_.size());
+    std::vector<pubsub_proto::PubsubMessage> result(count);
+    for (auto& m : result) {
+      m.Swap(&messages_.front());
+      messages_.pop_front();
+      bytes_ -= m.ByteSizeLong();
+    }
+    return result;
+  }
+
+  void Shutdown() {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    cv_.notify_all();
+  }
+
+  bool IsShutdown() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return shutdown_;
+  }
+
+ private:
+  std::size_t const max_bytes_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<pubsub_proto::PubsubMessage> messages_;
+  std::size_t bytes_ = 0;
+  bool shutdown_ = false;
+};
+
+class PublisherImpl final : public pubsub_proto::Publisher::Service {
+ public:
+  explicit PublisherImpl(MessageQueue& queue) : queue_(queue) {}
+
+  grpc::Status Publish(grpc::ServerContext*,
+                       pubsub_proto::PublishRequest const* request,
+                       pubsub_proto::PublishResponse* response) override {
+    for (auto const& m : request->messages()) {
+      auto const id = std::to_string(++published_count_);
+      response->add_message_ids(id);
+      auto message = m;
+      message.set_message_id(id);
+      if (!queue_.Push(std::move(message))) ++dropped_count_;
+    }
+    return grpc::Status::OK;
+  }
+
+  std::int64_t published_count() const { return published_count_.load(); }
+  std::int64_t dropped_count() const { return dropped_count_.load(); }
+
+ private:
+  MessageQueue& queue_;
+  std::atomic<std::int64_t> published_count_{0};
+  std::atomic<std::int64_t> dropped_count_{0};
+};
+
+class SubscriberImpl final : public pubsub_proto::Subscriber::Service {
+ public:
+  explicit SubscriberImpl(MessageQueue& queue) : queue_(queue) {}
+
+  grpc::Status StreamingPull(
+      grpc::ServerContext* context,
+      grpc::ServerReaderWriter<pubsub_proto::StreamingPullResponse,
+                               pubsub_proto::StreamingPullRequest>* stream)
+      override {
+    pubsub_proto::StreamingPullRequest request;
+    if (!stream->Read(&request)) return grpc::Status::OK;
+    auto const max_outstanding = request.max_outstanding_messages();
+
+    // Messages that are acked or nacked no longer count against the flow
+    // control limits of the stream. A separate thread reads these requests.
+    std::mutex mu;
+    std::condition_variable cv;
+    std::int64_t released = 0;
+    bool reader_done = false;
+    std::thread reader([&] {
+      pubsub_proto::StreamingPullRequest r;
+      while (stream->Read(&r)) {
+        auto const nacks = static_cast<std::int64_t>(
+            std::count(r.modify_deadline_seconds().begin(),
+                       r.modify_deadline_seconds().end(), 0));
+        ack_count_ += r.ack_ids_size();
+        std::lock_guard<std::mutex> lk(mu);
+        released += r.ack_ids_size() + nacks;
+        cv.notify_one();
+      }
+      std::lock_guard<std::mutex> lk(mu);
+      reader_done = true;
+      cv.notify_one();
+    });
+
+    std::int64_t delivered = 0;
+    while (!context->IsCancelled() && !queue_.IsShutdown()) {
+      std::int64_t room = kMaxMessagesPerResponse;
+      {
+        std::unique_lock<std::mutex> lk(mu);
+        auto has_room = [&] {
+          room = kMaxMessagesPerResponse;
+          if (max_outstanding == 0) return true;
+          room = (std::min)(room, max_outstanding - (delivered - released));
+          return room > 0;
+        };
+        if (!cv.wait_for(lk, std::chrono::milliseconds(100), [&] {
+              return reader_done || has_room();
+            })) {
+          continue;
+        }
+        if (reader_done) break;
+      }
+      auto messages = queue_.Pop(static_cast<std::size_t>(room),
+                                 std::chrono::milliseconds(100));
+      if (messages.empty()) continue;
+      pubsub_proto::StreamingPullResponse response;
+      for (auto& m : messages) {
+        auto& received = *response.add_received_messages();
+        received.set_ack_id("ack-" + m.message_id());
+        received.mutable_message()->Swap(&m);
+      }
+      delivered += response.received_messages_size();
+      delivered_count_ += response.received_messages_size();
+      if (!stream->Write(response)) break;
+    }
+    context->TryCancel();
+    reader.join();
+    return grpc::Status::OK;
+  }
+
+  grpc::Status Acknowledge(grpc::ServerContext*,
+                           pubsub_proto::AcknowledgeRequest const* request,
+                           google::protobuf::Empty*) override {
+    ack_count_ += request->ack_ids_size();
+    return grpc::Status::OK;
+  }
+
+  grpc::Status ModifyAckDeadline(grpc::ServerContext*,
+                                 pubsub_proto::ModifyAckDeadlineRequest const*,
+                                 google::protobuf::Empty*) override {
+    return grpc::Status::OK;
+  }
+
+  std::int64_t delivered_count() const { return delivered_count_.load(); }
+  std::int64_t ack_count() const { return ack_count_.load(); }
+
+ private:
+  MessageQueue& queue_;
+  std::atomic<std::int64_t> delivered_count_{0};
+  std::atomic<std::int64_t> ack_count_{0};
+};
+
+/// The implementation of EmbeddedServer.
+class DefaultEmbeddedServer : public EmbeddedServer {
+ public:
+  explicit DefaultEmbeddedServer(std::size_t max_queued_bytes)
+      : queue_(max_queued_bytes),
+        publisher_service_(queue_),
+        subscriber_service_(queue_) {
+    int port;
+    std::string server_address("[::]:0");
+    builder_.AddListeningPort(server_address, grpc::InsecureServerCredentials(),
+                              &port);
+    builder_.RegisterService(&publisher_service_);
+    builder_.RegisterService(&subscriber_service_);
+    server_ = builder_.BuildAndStart();
+    address_ = "localhost:" + std::to_string(port);
+  }
+
+  std::string address() const override { return address_; }
+  void Shutdown() override {
+    // Wake up any `StreamingPull()` calls, otherwise they block the shutdown.
+    queue_.Shutdown();
+    server_->Shutdown();
+  }
+  void Wait() override { server_->Wait(); }
+
+  std::int64_t published_count() const override {
+    return publisher_service_.published_count();
+  }
+  std::int64_t dropped_count() const override {
+    return publisher_service_.dropped_count();
+  }
+  std::int64_t delivered_count() const override {
+    return subscriber_service_.delivered_count();
+  }
+  std::int64_t ack_count() const override {
+    return subscriber_service_.ack_count();
+  }
+
+ private:
+  MessageQueue queue_;
+  PublisherImpl publisher_service_;
+  SubscriberImpl subscriber_service_;
+  grpc::ServerBuilder builder_;
+  std::unique_ptr<grpc::Server> server_;
+  std::string address_;
+};
+
+}  // namespace
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    std::size_t max_queued_bytes) {
+  return std::unique_ptr<EmbeddedServer>(
+      new DefaultEmbeddedServer(max_queued_bytes));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_benchmarks
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,68 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_EMBEDDED_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_EMBEDDED_SERVER_H
+
+#include "google/cloud/pubsub/version.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace pubsub_benchmarks {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * An in-process server for the Cloud Pub/Sub publisher and subscriber APIs.
+ *
+ * Running the benchmarks against an embedded server eliminates the network and
+ * the service as sources of variation, which makes it easier to measure small
+ * changes to the library. The server implements `Publish()`, `StreamingPull()`,
+ * `Acknowledge()` and `ModifyAckDeadline()` for any topic and subscription. The
+ * published messages are queued in memory, and each message is delivered to
+ * exactly one subscriber stream. The server respects the flow control limits
+ * set by each stream, but it does not track leases, acks, nor nacks. It never
+ * redelivers a message.
+ *
+ * Messages published while the queue holds more than `max_queued_bytes` are
+ * dropped, so publisher-only benchmarks do not exhaust the memory.
+ */
+class EmbeddedServer {
+ public:
+  virtual ~EmbeddedServer() = default;
+
+  virtual std::string address() const = 0;
+  virtual void Shutdown() = 0;
+  virtual void Wait() = 0;
+
+  virtual std::int64_t published_count() const = 0;
+  virtual std::int64_t dropped_count() const = 0;
+  virtual std::int64_t delivered_count() const = 0;
+  virtual std::int64_t ack_count() const = 0;
+};
+
+/// Create an embedded server, listening on a local port.
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    std::size_t max_queued_bytes = 256 * 1024 * 1024);
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_benchmarks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_EMBEDDED_SERVER_H
@@ -387,11 +387,10 @@ void ExperimentFlowControl::Received(pubsub::Message const& m) {
   auto const now = std::chrono::steady_clock::now();
   auto const message_timestamp = [&m] {
     std::chrono::steady_clock::duration ts{0};
-    for (auto const& kv : m.attributes()) {
-      if (kv.first == "timestamp") {
-        ts = std::chrono::steady_clock::duration(std::stoll(kv.second));
-        break;
-      }
+    auto const timestamp = m.GetAttribute("timestamp");
+    if (timestamp) {
+      ts = std::chrono::steady_clock::duration(
+          std::stoll(std::string(*timestamp)));
     }
     return std::chrono::steady_clock::time_point{} + ts;
   }();
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "google/cloud/pubsub/benchmarks/embedded_server.h"
 #include "google/cloud/pubsub/publisher.h"
 #include "google/cloud/pubsub/subscriber.h"
 #include "google/cloud/pubsub/subscription_admin_client.h"
@@ -20,8 +21,8 @@
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/benchmark_record.h"
 #include "google/cloud/testing_util/command_line_parsing.h"
-#include "google/cloud/testing_util/timer.h"
 #include "absl/strings/str_format.h"
 #include <atomic>
 #include <chrono>
@@ -30,6 +31,7 @@
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <thread>
 
 namespace {
 namespace pubsub = ::google::cloud::pubsub;
@@ -37,6 +39,7 @@ using ::google::cloud::future;
 using ::google::cloud::Status;
 using ::google::cloud::StatusOr;
 using ::google::cloud::testing_util::FormatSize;
+using ::google::cloud::testing_util::kKiB;
 using ::google::cloud::testing_util::kMB;
 using ::google::cloud::testing_util::kMiB;
 
@@ -44,16 +47,27 @@ auto constexpr kDescription = R"""(
 A throughput vs. CPU benchmark for the Cloud Pub/Sub C++ client library.
 
 Measure the throughput for publishers and/or subscribers in the Cloud Pub/Sub
-C++ client library.
+C++ client library. For each iteration the benchmark reports the throughput,
+the CPU time and the number of allocations per message, and the distribution
+of the latency: from publishing a message to receiving the response from the
+service for publishers, and from publishing a message to receiving it for
+subscribers. The CPU time and allocations are for the whole process.
+
+With `--embedded-server` the benchmark runs against an in-process server, with
+no network or service variability. Note that the server work is then included
+in the CPU time and allocations.
 )""";
 
 struct Config {
+  bool embedded_server = false;
+  google::cloud::testing_util::BenchmarkOutputConfig output;
   std::string endpoint;
   std::string project_id;
   std::string topic_id;
   std::string subscription_id;
 
   std::int64_t payload_size = 1024;
+  std::string payload_type = "random";
   std::chrono::seconds iteration_duration = std::chrono::seconds(5);
 
   bool publisher = false;
@@ -65,6 +79,8 @@ struct Config {
   std::int64_t publisher_pending_lwm = 112 * kMiB;
   std::int64_t publisher_pending_hwm = 128 * kMiB;
   std::int64_t publisher_target_messages_per_second = 1200 * 2000;
+  bool publisher_compression = false;
+  std::int64_t publisher_compression_threshold = kKiB;
 
   bool subscriber = false;
   int subscriber_thread_count = 1;
@@ -100,6 +116,7 @@ class Cleanup {
 
 void PublisherTask(Config const& config);
 void SubscriberTask(Config const& config);
+void PrintHeader(Config const& config);
 
 }  // namespace
 
@@ -116,6 +133,18 @@ int main(int argc, char* argv[]) {
   auto generator = google::cloud::internal::MakeDefaultPRNG();
 
   Cleanup cleanup;
+  // The embedded server accepts any topic and subscription, there is no need
+  // to create them.
+  std::unique_ptr<google::cloud::pubsub_benchmarks::EmbeddedServer> server;
+  if (config->embedded_server) {
+    server = google::cloud::pubsub_benchmarks::CreateEmbeddedServer();
+    config->endpoint = server->address();
+    if (config->topic_id.empty()) config->topic_id = "benchmark-topic";
+    if (config->subscription_id.empty()) {
+      config->subscription_id = "benchmark-subscription";
+    }
+  }
+
   // If there is no pre-defined topic and/or subscription for this test, create
   // them and automatically remove them at the end of the test.
   if (config->topic_id.empty()) {
@@ -154,8 +183,7 @@ int main(int argc, char* argv[]) {
 
   auto const topic = pubsub::Topic(config->project_id, config->topic_id);
 
-  std::cout << "timestamp,elapsed(us),op,iteration,count,msgs/s,bytes,MB/s"
-            << std::endl;
+  PrintHeader(*config);
 
   std::vector<std::thread> tasks;
   if (config->publisher) {
@@ -166,13 +194,26 @@ int main(int argc, char* argv[]) {
   }
   for (auto& t : tasks) t.join();
 
+  if (server) {
+    std::cout << "# Embedded Server: published_count="
+              << server->published_count()
+              << ", dropped_count=" << server->dropped_count()
+              << ", delivered_count=" << server->delivered_count()
+              << ", ack_count=" << server->ack_count() << std::endl;
+    server->Shutdown();
+  }
+
   return 0;
 }
 
 namespace {
 
 using ::google::cloud::pubsub_internal::MessageSize;
-using ::google::cloud::testing_util::Timer;
+using ::google::cloud::testing_util::BenchmarkRecord;
+using ::google::cloud::testing_util::CurrentResourceUsage;
+using ::google::cloud::testing_util::FormatJson;
+using ::google::cloud::testing_util::LatencyHistogram;
+using ::google::cloud::testing_util::ResourceUsage;
 
 std::mutex cout_mu;
 
@@ -190,24 +231,122 @@ std::string Timestamp() {
       std::chrono::system_clock::now());
 }
 
-void PrintResult(std::string const& operation, int iteration,
-                 std::int64_t count, std::int64_t bytes,
-                 Timer::Snapshot const& usage) {
-  using std::chrono::duration_cast;
-  using std::chrono::microseconds;
-  using std::chrono::seconds;
-
-  auto const elapsed_us = duration_cast<microseconds>(usage.elapsed_time);
-  auto const mbs =
-      absl::StrFormat("%.02f", static_cast<double>(bytes) /
-                                   static_cast<double>(elapsed_us.count()));
-  auto const msgs =
-      absl::StrFormat("%.02f", static_cast<double>(count) * 1000000.0 /
-                                   static_cast<double>(elapsed_us.count()));
+void PrintHeader(Config const& config) {
+  if (config.output.format == "json") return;
+  std::cout << "timestamp,elapsed(us),op,iteration,count,msgs/s,bytes,MB/s"
+            << ",cpu(us)/msg,allocations/msg,p50(us),p99(us),p99.9(us)"
+            << std::endl;
+}
+
+/// Measure the resource usage and latency over an iteration.
+class IterationSample {
+ public:
+  explicit IterationSample(LatencyHistogram const& latency)
+      : latency_(latency),
+        start_(std::chrono::steady_clock::now()),
+        start_usage_(CurrentResourceUsage()),
+        start_latency_(latency.Sample()) {}
+
+  std::chrono::microseconds elapsed() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_);
+  }
+  ResourceUsage usage() const { return CurrentResourceUsage() - start_usage_; }
+  LatencyHistogram::Snapshot latency() const {
+    return latency_.Sample().Since(start_latency_);
+  }
+
+ private:
+  LatencyHistogram const& latency_;
+  std::chrono::steady_clock::time_point start_;
+  ResourceUsage start_usage_;
+  LatencyHistogram::Snapshot start_latency_;
+};
+
+/// The common fields for the JSON output.
+BenchmarkRecord MakeRecord(Config const& config, std::string operation) {
+  BenchmarkRecord record;
+  record.benchmark = "pubsub/throughput";
+  record.operation = std::move(operation);
+  record.labels = {
+      {"transport", "grpc"},
+      {"server", config.embedded_server ? "embedded" : "service"},
+  };
+  return record;
+}
+
+void PrintResult(Config const& config, std::string const& operation,
+                 int iteration, std::int64_t count, std::int64_t bytes,
+                 IterationSample const& sample) {
+  auto const elapsed_us = sample.elapsed();
+  auto const usage = sample.usage();
+  auto const latency = sample.latency();
+  auto const elapsed = static_cast<double>(elapsed_us.count());
+  auto const mbs = static_cast<double>(bytes) / elapsed;
+  auto const msgs = static_cast<double>(count) * 1000000.0 / elapsed;
+  auto const per_message = [count](std::int64_t v) {
+    return count == 0 ? 0.0
+                      : static_cast<double>(v) / static_cast<double>(count);
+  };
+  auto const cpu = per_message(usage.cpu_time.count());
+  auto const allocations = per_message(usage.allocations);
+  auto const p50 = latency.Percentile(50).count();
+  auto const p99 = latency.Percentile(99).count();
+  auto const p999 = latency.Percentile(99.9).count();
+
   std::lock_guard<std::mutex> lk(cout_mu);
+  if (config.output.format == "json") {
+    auto record = MakeRecord(config, operation);
+    record.iteration = iteration;
+    record.count = count;
+    record.bytes = bytes;
+    record.elapsed = elapsed_us;
+    record.usage = usage;
+    record.latency = latency;
+    std::cout << FormatJson(record, config.output) << std::endl;
+    return;
+  }
   std::cout << Timestamp() << ',' << elapsed_us.count() << ',' << operation
-            << ',' << iteration << ',' << count << ',' << msgs << ',' << bytes
-            << ',' << mbs << std::endl;
+            << ',' << iteration << ',' << count << ','
+            << absl::StrFormat("%.02f", msgs) << ',' << bytes << ','
+            << absl::StrFormat("%.02f", mbs) << ','
+            << absl::StrFormat("%.03f", cpu) << ','
+            << absl::StrFormat("%.02f", allocations) << ',' << p50 << ','
+            << p99 << ',' << p999 << std::endl;
+}
+
+/// Print the latency percentiles for the complete run.
+void PrintLatencySummary(Config const& config, std::string const& operation,
+                         LatencyHistogram::Snapshot const& latency) {
+  std::lock_guard<std::mutex> lk(cout_mu);
+  if (config.output.format == "json") {
+    auto record = MakeRecord(config, operation + "Summary");
+    record.count = latency.count();
+    record.latency = latency;
+    std::cout << FormatJson(record, config.output) << std::endl;
+    return;
+  }
+  std::cout << "# " << operation << " latency: count=" << latency.count()
+            << ", p50=" << latency.Percentile(50).count()
+            << "us, p90=" << latency.Percentile(90).count()
+            << "us, p99=" << latency.Percentile(99).count()
+            << "us, p99.9=" << latency.Percentile(99.9).count()
+            << "us, max=" << latency.Percentile(100).count() << "us"
+            << std::endl;
+}
+
+/// The time since the epoch, used to measure the end-to-end latency.
+std::int64_t NowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+pubsub::ConnectionOptions MakeConnectionOptions(Config const& config) {
+  if (config.embedded_server) {
+    return pubsub::ConnectionOptions(grpc::InsecureChannelCredentials());
+  }
+  return pubsub::ConnectionOptions{};
 }
 
 pubsub::Publisher CreatePublisher(Config const& config) {
@@ -215,9 +354,12 @@ pubsub::Publisher CreatePublisher(Config const& config) {
       pubsub::PublisherOptions{}
           .set_maximum_batch_message_count(config.publisher_max_batch_size)
           .set_maximum_batch_bytes(
-              static_cast<std::size_t>(config.publisher_max_batch_bytes));
+              static_cast<std::size_t>(config.publisher_max_batch_bytes))
+          .set_compression_threshold(static_cast<std::size_t>(
+              config.publisher_compression_threshold));
+  if (config.publisher_compression) publisher_options.enable_compression();
   auto connection_options =
-      pubsub::ConnectionOptions{}.set_channel_pool_domain("Publisher");
+      MakeConnectionOptions(config).set_channel_pool_domain("Publisher");
   if (!config.endpoint.empty()) {
     connection_options.set_endpoint(config.endpoint);
   }
@@ -238,7 +380,23 @@ std::atomic<std::int64_t> send_count{0};
 std::atomic<std::int64_t> send_bytes{0};
 std::atomic<std::int64_t> ack_count{0};
 std::atomic<std::int64_t> ack_bytes{0};
+std::atomic<std::int64_t> ack_latency_us{0};
 std::atomic<std::int64_t> error_count{0};
+LatencyHistogram publish_latency;
+LatencyHistogram end_to_end_latency;
+
+/// Create a payload with a sequence of JSON objects, which compress well.
+std::string MakeJsonPayload(std::size_t size) {
+  std::string payload = "[";
+  for (int i = 0; payload.size() < size; ++i) {
+    payload += absl::StrFormat(
+        R"""({"id": %d, "name": "user-%06d", "status": "active", )"""
+        R"""("tags": ["alpha", "beta"], "score": %d}, )""",
+        i, i, i % 100);
+  }
+  payload.resize(size);
+  return payload;
+}
 
 /// Run a single thread publishing events
 class PublishWorker {
@@ -255,8 +413,11 @@ class PublishWorker {
     auto publisher = CreatePublisher(config_);
 
     auto gen = google::cloud::internal::DefaultPRNG(std::random_device{}());
-    auto const data = google::cloud::internal::Sample(
-        gen, static_cast<int>(config_.payload_size), "0123456789");
+    auto const data =
+        config_.payload_type == "json"
+            ? MakeJsonPayload(static_cast<std::size_t>(config_.payload_size))
+            : google::cloud::internal::Sample(
+                  gen, static_cast<int>(config_.payload_size), "0123456789");
 
     using std::chrono::duration_cast;
     using std::chrono::steady_clock;
@@ -280,21 +441,25 @@ class PublishWorker {
     auto const start = std::chrono::steady_clock::now();
     auto pacing_time = start + pacing_period;
     for (std::int64_t i = 0; NotShutdownAndReady(); ++i) {
-      auto const elapsed =
-          duration_cast<std::chrono::microseconds>(steady_clock::now() - start);
+      // The subscriber uses this attribute to compute the end-to-end latency.
       auto message = pubsub::MessageBuilder{}
                          .SetAttributes({
-                             {"sendTime", std::to_string(elapsed.count())},
+                             {"sendTime", std::to_string(NowMicros())},
                              {"clientId", std::to_string(id_)},
                              {"sequenceNumber", std::to_string(i)},
                          })
                          .SetData(data)
                          .Build();
       auto const bytes = MessageSize(message);
+      auto const publish_start = steady_clock::now();
       publisher.Publish(std::move(message))
-          .then([this, bytes](future<StatusOr<std::string>> f) {
+          .then([this, bytes, publish_start](future<StatusOr<std::string>> f) {
             ++ack_count;
             ack_bytes.fetch_add(bytes);
+            auto const latency = duration_cast<std::chrono::microseconds>(
+                steady_clock::now() - publish_start);
+            ack_latency_us.fetch_add(latency.count());
+            publish_latency.Record(latency);
             if (!f.get()) ++error_count;
             OnAck();
           });
@@ -369,8 +534,7 @@ void PublisherTask(Config const& config) {
 
   auto const start = std::chrono::steady_clock::now();
   for (int i = 0; !Done(config, i, start); ++i) {
-    using std::chrono::steady_clock;
-    auto timer = Timer::PerThread();
+    IterationSample sample(publish_latency);
     auto const start_send_count = send_count.load();
     auto const start_send_bytes = send_bytes.load();
     auto const start_ack_count = ack_count.load();
@@ -380,9 +544,8 @@ void PublisherTask(Config const& config) {
     auto const send_bytes_last = send_bytes.load() - start_send_bytes;
     auto const ack_count_last = ack_count.load() - start_ack_count;
     auto const ack_bytes_last = ack_bytes.load() - start_ack_bytes;
-    auto const usage = timer.Sample();
-    PrintResult("Pub", i, send_count_last, send_bytes_last, usage);
-    PrintResult("Ack", i, ack_count_last, ack_bytes_last, usage);
+    PrintResult(config, "Pub", i, send_count_last, send_bytes_last, sample);
+    PrintResult(config, "Ack", i, ack_count_last, ack_bytes_last, sample);
   }
 
   for (auto& w : workers) w->Shutdown();
@@ -397,10 +560,14 @@ void PublisherTask(Config const& config) {
       [](std::int64_t a, std::shared_ptr<PublishWorker> const& w) {
         return a + w->lwm_count();
       });
+  auto const average_ack_latency_us =
+      ack_count == 0 ? 0 : ack_latency_us.load() / ack_count.load();
   std::cout << "# Publisher: error_count=" << error_count
             << ", ack_count=" << ack_count << ", send_count=" << send_count
             << ", hwm_count=" << hwm_count << ", lwm_count=" << lwm_count
+            << ", average_ack_latency_us=" << average_ack_latency_us
             << std::endl;
+  PrintLatencySummary(config, "Ack", publish_latency.Sample());
 }
 
 pubsub::Subscriber CreateSubscriber(Config const& config) {
@@ -411,7 +578,7 @@ pubsub::Subscriber CreateSubscriber(Config const& config) {
           .set_max_outstanding_bytes(config.subscriber_max_outstanding_bytes)
           .set_max_concurrency(config.subscriber_max_concurrency);
   auto connection_options =
-      pubsub::ConnectionOptions{}.set_channel_pool_domain("Subscriber");
+      MakeConnectionOptions(config).set_channel_pool_domain("Subscriber");
   if (!config.endpoint.empty()) {
     connection_options.set_endpoint(config.endpoint);
   }
@@ -440,6 +607,13 @@ void SubscriberTask(Config const& config) {
                                                     pubsub::AckHandler h) {
     ++received_count;
     received_bytes.fetch_add(MessageSize(m));
+    auto const& attributes =
+        google::cloud::pubsub_internal::ToProto(m).attributes();
+    auto const send_time = attributes.find("sendTime");
+    if (send_time != attributes.end()) {
+      end_to_end_latency.Record(std::chrono::microseconds(
+          NowMicros() - std::stoll(send_time->second)));
+    }
     std::move(h).ack();
   };
 
@@ -450,15 +624,13 @@ void SubscriberTask(Config const& config) {
 
   auto const start = std::chrono::steady_clock::now();
   for (int i = 0; !Done(config, i, start); ++i) {
-    using std::chrono::steady_clock;
-    auto timer = Timer::PerThread();
+    IterationSample sample(end_to_end_latency);
     auto const start_count = received_count.load();
     auto const start_bytes = received_bytes.load();
     std::this_thread::sleep_for(config.iteration_duration);
     auto const count = received_count.load() - start_count;
     auto const bytes = received_bytes.load() - start_bytes;
-    auto const usage = timer.Sample();
-    PrintResult("Sub", i, count, bytes, usage);
+    PrintResult(config, "Sub", i, count, bytes, sample);
   }
   for (auto& s : sessions) s.cancel();
   Status last_status;
@@ -473,6 +645,7 @@ void SubscriberTask(Config const& config) {
     std::cout << "# status=" << last_status << ", count=" << last_received_count
               << std::endl;
   }
+  PrintLatencySummary(config, "Sub", end_to_end_latency.Sample());
 }
 
 void PrintPublisher(std::ostream& os, Config const& config) {
@@ -488,7 +661,11 @@ void PrintPublisher(std::ostream& os, Config const& config) {
      << "\n# Publisher Pending HWM: "
      << FormatSize(config.publisher_pending_hwm)
      << "\n# Publisher Target messages/s: "
-     << config.publisher_target_messages_per_second;
+     << config.publisher_target_messages_per_second
+     << "\n# Publisher Compression: " << std::boolalpha
+     << config.publisher_compression
+     << "\n# Publisher Compression Threshold: "
+     << FormatSize(config.publisher_compression_threshold);
 }
 
 void PrintSubscriber(std::ostream& os, Config const& config) {
@@ -507,10 +684,13 @@ void Print(std::ostream& os, Config const& config) {
   os << "# Running Cloud Pub/Sub experiment"
      << "\n# Start time: "
      << google::cloud::internal::FormatRfc3339(std::chrono::system_clock::now())
+     << "\n# Embedded Server: " << std::boolalpha << config.embedded_server
+     << "\n# Output Format: " << config.output.format
      << "\n# Endpoint: " << config.endpoint
      << "\n# Topic ID: " << config.topic_id
      << "\n# Subscription ID: " << config.subscription_id
      << "\n# Payload Size: " << FormatSize(config.payload_size)
+     << "\n# Payload Type: " << config.payload_type
      << "\n# Iteration_Duration: " << config.iteration_duration.count() << "s"
      << "\n# Minimum Samples: " << config.minimum_samples
      << "\n# Maximum Samples: " << config.maximum_samples
@@ -522,10 +702,12 @@ void Print(std::ostream& os, Config const& config) {
 }
 
 using ::google::cloud::internal::GetEnv;
+using ::google::cloud::testing_util::BenchmarkOutputOptions;
 using ::google::cloud::testing_util::OptionDescriptor;
 using ::google::cloud::testing_util::ParseBoolean;
 using ::google::cloud::testing_util::ParseDuration;
 using ::google::cloud::testing_util::ParseSize;
+using ::google::cloud::testing_util::ValidateBenchmarkOutputConfig;
 
 google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
                                               std::string const& description) {
@@ -539,6 +721,12 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
        [&show_help](std::string const&) { show_help = true; }},
       {"--description", "print benchmark description",
        [&show_description](std::string const&) { show_description = true; }},
+      {"--embedded-server",
+       "run the benchmark against an in-process server, instead of the"
+       " service",
+       [&options](std::string const& val) {
+         options.embedded_server = ParseBoolean(val).value_or(true);
+       }},
       {"--endpoint", "use the given endpoint",
        [&options](std::string const& val) { options.endpoint = val; }},
       {"--project-id", "use the given project id for the benchmark",
@@ -552,6 +740,10 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
        [&options](std::string const& val) {
          options.payload_size = ParseSize(val);
        }},
+      {"--payload-type",
+       "the type of payload, 'random' (random digits) or 'json' (a sequence of"
+       " JSON objects, which compress well)",
+       [&options](std::string const& val) { options.payload_type = val; }},
       {"--iteration-duration",
        "measurement interval, report throughput every X seconds",
        [&options](std::string const& val) {
@@ -605,6 +797,15 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
        [&options](std::string const& val) {
          options.publisher_target_messages_per_second = std::stol(val);
        }},
+      {"--publisher-compression", "compress large batches using gzip",
+       [&options](std::string const& val) {
+         options.publisher_compression = ParseBoolean(val).value_or(true);
+       }},
+      {"--publisher-compression-threshold",
+       "only compress batches larger than this size",
+       [&options](std::string const& val) {
+         options.publisher_compression_threshold = ParseSize(val);
+       }},
 
       {"--subscriber", "run a subscriber in this program",
        [&options](std::string const& val) {
@@ -658,6 +859,8 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
          options.maximum_runtime = ParseDuration(val);
        }},
   };
+  auto output_options = BenchmarkOutputOptions(options.output);
+  desc.insert(desc.end(), output_options.begin(), output_options.end());
   auto const usage = BuildUsage(desc, args[0]);
   auto unparsed = OptionsParse(desc, args);
 
@@ -671,10 +874,20 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
     return options;
   }
 
+  if (options.project_id.empty() && options.embedded_server) {
+    options.project_id = "benchmark-project";
+  }
   if (options.project_id.empty()) {
     return google::cloud::Status(google::cloud::StatusCode::kInvalidArgument,
                                  "missing or empty --project-id option");
   }
+  auto status = ValidateBenchmarkOutputConfig(options.output);
+  if (!status.ok()) return status;
+  if (options.payload_type != "random" && options.payload_type != "json") {
+    return google::cloud::Status(
+        google::cloud::StatusCode::kInvalidArgument,
+        "invalid --payload-type option, must be 'random' or 'json'");
+  }
 
   return options;
 }
@@ -703,6 +916,15 @@ google::cloud::StatusOr<Config> SelfTest(std::string const& cmd) {
   if (!config) return error("--subscription-id");
   config = ParseArgsImpl({cmd, "--endpoint=test"}, kDescription);
   if (!config) return error("--endpoint");
+  config = ParseArgsImpl({cmd, "--payload-type=invalid"}, kDescription);
+  if (config) return error("--payload-type validation");
+  config = ParseArgsImpl({cmd, "--output-format=invalid"}, kDescription);
+  if (config) return error("--output-format validation");
+  config = ParseArgsImpl({cmd, "--project-id=", "--embedded-server"},
+                         kDescription);
+  if (!config || config->project_id.empty()) {
+    return error("--embedded-server without --project-id");
+  }
 
   return ParseArgsImpl(
       {
@@ -717,6 +939,8 @@ google::cloud::StatusOr<Config> SelfTest(std::string const& cmd) {
           "--publisher-pending-lwm=8MiB",
           "--publisher-pending-hwm=10MiB",
           "--publisher-target-messages-per-second=1000000",
+          "--publisher-compression=true",
+          "--publisher-compression-threshold=1KiB",
           "--subscriber=true",
           "--subscriber-thread-count=1",
           "--subscriber-io-threads=1",
@@ -726,6 +950,8 @@ google::cloud::StatusOr<Config> SelfTest(std::string const& cmd) {
           "--subscriber-max-concurrency=1000",
           "--iteration-duration=1s",
           "--payload-size=2KiB",
+          "--payload-type=json",
+          "--output-format=json",
           "--minimum-samples=1",
           "--maximum-samples=2",
           "--minimum-runtime=0s",
@@ -20,7 +20,10 @@ google_cloud_cpp_pubsub_hdrs = [
     "ack_handler.h",
     "application_callback.h",
     "backoff_policy.h",
+    "batch_ack_handler.h",
     "connection_options.h",
+    "internal/ack_latency_distribution.h",
+    "internal/adaptive_flow_control.h",
     "internal/batch_sink.h",
     "internal/batching_publisher_connection.h",
     "internal/create_channel.h",
@@ -29,16 +32,19 @@ google_cloud_cpp_pubsub_hdrs = [
     "internal/emulator_overrides.h",
     "internal/flow_controlled_publisher_connection.h",
     "internal/ordering_key_publisher_connection.h",
+    "internal/parallel_subscription_batch_source.h",
     "internal/publisher_logging.h",
     "internal/publisher_metadata.h",
     "internal/publisher_round_robin.h",
     "internal/publisher_stub.h",
+    "internal/pull_subscription_batch_source.h",
     "internal/rejects_with_ordering_key.h",
     "internal/schema_logging.h",
     "internal/schema_metadata.h",
     "internal/schema_stub.h",
     "internal/sequential_batch_sink.h",
     "internal/session_shutdown_manager.h",
+    "internal/sharded_publisher_connection.h",
     "internal/streaming_subscription_batch_source.h",
     "internal/subscriber_logging.h",
     "internal/subscriber_metadata.h",
@@ -54,6 +60,7 @@ google_cloud_cpp_pubsub_hdrs = [
     "publisher.h",
     "publisher_connection.h",
     "publisher_options.h",
+    "pull_result.h",
     "retry_policy.h",
     "schema.h",
     "schema_admin_client.h",
@@ -77,7 +84,10 @@ google_cloud_cpp_pubsub_hdrs = [
 
 google_cloud_cpp_pubsub_srcs = [
     "ack_handler.cc",
+    "batch_ack_handler.cc",
     "connection_options.cc",
+    "internal/ack_latency_distribution.cc",
+    "internal/adaptive_flow_control.cc",
     "internal/batching_publisher_connection.cc",
     "internal/create_channel.cc",
     "internal/default_batch_sink.cc",
@@ -85,16 +95,19 @@ google_cloud_cpp_pubsub_srcs = [
     "internal/emulator_overrides.cc",
     "internal/flow_controlled_publisher_connection.cc",
     "internal/ordering_key_publisher_connection.cc",
+    "internal/parallel_subscription_batch_source.cc",
     "internal/publisher_logging.cc",
     "internal/publisher_metadata.cc",
     "internal/publisher_round_robin.cc",
     "internal/publisher_stub.cc",
+    "internal/pull_subscription_batch_source.cc",
     "internal/rejects_with_ordering_key.cc",
     "internal/schema_logging.cc",
     "internal/schema_metadata.cc",
     "internal/schema_stub.cc",
     "internal/sequential_batch_sink.cc",
     "internal/session_shutdown_manager.cc",
+    "internal/sharded_publisher_connection.cc",
     "internal/streaming_subscription_batch_source.cc",
     "internal/subscriber_logging.cc",
     "internal/subscriber_metadata.cc",
@@ -0,0 +1,60 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/ack_latency_distribution.h"
+#include <algorithm>
+#include <cmath>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+AckLatencyDistribution::AckLatencyDistribution(std::chrono::seconds max_latency)
+    : buckets_(static_cast<std::size_t>((std::max)(
+                   max_latency.count(), std::chrono::seconds::rep{0})) +
+               1) {}
+
+void AckLatencyDistribution::Record(std::chrono::seconds latency) {
+  auto const max_bucket = static_cast<std::int64_t>(buckets_.size() - 1);
+  auto const bucket = (std::min)(
+      max_bucket, (std::max)(std::int64_t{0},
+                             static_cast<std::int64_t>(latency.count())));
+  ++buckets_[static_cast<std::size_t>(bucket)];
+  ++count_;
+}
+
+std::chrono::seconds AckLatencyDistribution::Percentile(
+    double percentile) const {
+  if (count_ == 0) return std::chrono::seconds(0);
+  // The number of samples that must be at or below the returned value.
+  auto const rank = (std::max)(
+      std::int64_t{1}, static_cast<std::int64_t>(std::ceil(
+                           percentile * static_cast<double>(count_) / 100.0)));
+  std::int64_t cumulative = 0;
+  for (std::size_t i = 0; i != buckets_.size(); ++i) {
+    cumulative += buckets_[i];
+    // Samples in bucket `i` are in the [i, i+1) range, round up.
+    if (cumulative >= rank) {
+      return std::chrono::seconds(static_cast<std::int64_t>(i) + 1);
+    }
+  }
+  return std::chrono::seconds(static_cast<std::int64_t>(buckets_.size()));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
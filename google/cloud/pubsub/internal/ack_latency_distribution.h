@@ -0,0 +1,68 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_LATENCY_DISTRIBUTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_LATENCY_DISTRIBUTION_H
+
+#include "google/cloud/pubsub/version.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Tracks the distribution of the time to acknowledge messages.
+ *
+ * The subscriber uses this distribution to compute how much to extend the
+ * leases of the outstanding messages. The distribution uses one bucket per
+ * second, up to a maximum value. Larger latencies are recorded in the last
+ * bucket.
+ *
+ * This class is not thread-safe, the caller must provide any synchronization.
+ */
+class AckLatencyDistribution {
+ public:
+  explicit AckLatencyDistribution(std::chrono::seconds max_latency);
+
+  /// Record a new sample.
+  void Record(std::chrono::seconds latency);
+
+  /**
+   * Returns the @p percentile of the distribution, rounded up to a second.
+   *
+   * Returns 0 if there are no samples.
+   *
+   * @param percentile a value in the (0, 100] range.
+   */
+  std::chrono::seconds Percentile(double percentile) const;
+
+  /// The number of samples recorded.
+  std::int64_t count() const { return count_; }
+
+ private:
+  std::vector<std::int64_t> buckets_;
+  std::int64_t count_ = 0;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_LATENCY_DISTRIBUTION_H
@@ -0,0 +1,58 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/ack_latency_distribution.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using std::chrono::seconds;
+
+TEST(AckLatencyDistributionTest, Empty) {
+  AckLatencyDistribution uut(seconds(600));
+  EXPECT_EQ(0, uut.count());
+  EXPECT_EQ(seconds(0), uut.Percentile(99));
+}
+
+TEST(AckLatencyDistributionTest, Percentiles) {
+  AckLatencyDistribution uut(seconds(600));
+  // 98 fast messages, and 2 slow ones.
+  for (int i = 0; i != 98; ++i) uut.Record(seconds(2));
+  uut.Record(seconds(30));
+  uut.Record(seconds(40));
+  EXPECT_EQ(100, uut.count());
+  EXPECT_EQ(seconds(3), uut.Percentile(50));
+  EXPECT_EQ(seconds(3), uut.Percentile(98));
+  EXPECT_EQ(seconds(31), uut.Percentile(99));
+  EXPECT_EQ(seconds(41), uut.Percentile(100));
+}
+
+TEST(AckLatencyDistributionTest, Clamps) {
+  AckLatencyDistribution uut(seconds(60));
+  uut.Record(seconds(-5));
+  EXPECT_EQ(seconds(1), uut.Percentile(100));
+  uut.Record(seconds(3600));
+  EXPECT_EQ(seconds(61), uut.Percentile(100));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,108 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/adaptive_flow_control.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+auto constexpr kSamplePeriod = std::chrono::seconds(1);
+// The average message size reacts to changes over a few dozen messages.
+auto constexpr kSizeSmoothing = 1.0 / 16;
+
+std::int64_t Unlimited(std::int64_t limit) {
+  return limit > 0 ? limit : (std::numeric_limits<std::int64_t>::max)();
+}
+}  // namespace
+
+AdaptiveFlowControl::AdaptiveFlowControl(std::int64_t min_messages,
+                                         std::int64_t max_messages,
+                                         std::int64_t max_bytes,
+                                         std::chrono::milliseconds buffer_time,
+                                         ClockFunction clock)
+    : min_messages_((std::min)((std::max<std::int64_t>)(1, min_messages),
+                               Unlimited(max_messages))),
+      max_messages_(Unlimited(max_messages)),
+      max_bytes_(Unlimited(max_bytes)),
+      buffer_time_(buffer_time),
+      clock_(std::move(clock)),
+      target_messages_(min_messages_),
+      sample_start_(clock_()) {}
+
+void AdaptiveFlowControl::Received(std::string const& ack_id,
+                                   std::int64_t bytes) {
+  if (!outstanding_.emplace(ack_id, bytes).second) return;
+  outstanding_bytes_ += bytes;
+  if (average_bytes_ == 0) {
+    average_bytes_ = static_cast<double>(bytes);
+    return;
+  }
+  auto const delta = static_cast<double>(bytes) - average_bytes_;
+  average_bytes_ += delta * kSizeSmoothing;
+}
+
+void AdaptiveFlowControl::Handled(std::string const& ack_id) {
+  auto i = outstanding_.find(ack_id);
+  if (i == outstanding_.end()) return;
+  outstanding_bytes_ -= i->second;
+  outstanding_.erase(i);
+  ++sample_handled_;
+  UpdateTarget(clock_());
+}
+
+bool AdaptiveFlowControl::CanRead() const {
+  // Always admit at least one message, even if it exceeds the bytes target.
+  if (outstanding_.empty()) return true;
+  return outstanding_messages() < target_messages_ &&
+         outstanding_bytes_ < target_bytes();
+}
+
+std::int64_t AdaptiveFlowControl::target_bytes() const {
+  // Until some messages arrive there is no basis to estimate their size.
+  if (average_bytes_ == 0) return max_bytes_;
+  auto const bytes = average_bytes_ * static_cast<double>(target_messages_);
+  if (bytes >= static_cast<double>(max_bytes_)) return max_bytes_;
+  return (std::max<std::int64_t>)(1, static_cast<std::int64_t>(bytes));
+}
+
+void AdaptiveFlowControl::UpdateTarget(Clock::time_point now) {
+  using seconds = std::chrono::duration<double>;
+  auto const elapsed = seconds(now - sample_start_).count();
+  if (elapsed < seconds(kSamplePeriod).count()) return;
+  auto const rate = static_cast<double>(sample_handled_) / elapsed;
+  handled_per_second_ = handled_per_second_ == 0
+                            ? rate
+                            : (handled_per_second_ + rate) / 2;
+  sample_start_ = now;
+  sample_handled_ = 0;
+
+  // By Little's law, this many messages are handled during `buffer_time_`.
+  auto const buffered = std::ceil(
+      handled_per_second_ * seconds(buffer_time_).count());
+  auto const headroom = static_cast<double>(max_messages_ - min_messages_);
+  target_messages_ =
+      min_messages_ + static_cast<std::int64_t>((std::min)(buffered, headroom));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,109 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ADAPTIVE_FLOW_CONTROL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ADAPTIVE_FLOW_CONTROL_H
+
+#include "google/cloud/pubsub/version.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Sizes the buffer of messages received by a streaming pull.
+ *
+ * The service pushes messages until the stream reaches the
+ * `max_outstanding_messages` and `max_outstanding_bytes` limits sent in the
+ * first `StreamingPullRequest`. Slow subscribers may hoard messages other
+ * subscribers could process, and these limits are too small for fast
+ * subscribers. Instead of restarting the stream to change the limits, the
+ * `StreamingSubscriptionBatchSource` stops reading from the stream while
+ * this class says the buffer is full. gRPC flow control then stops the
+ * service.
+ *
+ * The target is enough messages to keep the callbacks busy (`min_messages`),
+ * plus the messages handled, at the observed ack and nack rate, during
+ * `buffer_time`. The bytes target uses the average message size. Both
+ * targets are capped by the configured limits.
+ *
+ * This class is not thread-safe, the caller must provide any synchronization.
+ */
+class AdaptiveFlowControl {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using ClockFunction = std::function<Clock::time_point()>;
+
+  /**
+   * Constructor.
+   *
+   * @param min_messages the lowest target, typically the callback concurrency
+   * @param max_messages the highest target, 0 or negative for unlimited
+   * @param max_bytes the highest bytes target, 0 or negative for unlimited
+   * @param buffer_time how long the buffered messages should last
+   * @param clock the clock used to measure the handling rate, the rate is
+   *     sampled about once a second
+   */
+  AdaptiveFlowControl(std::int64_t min_messages, std::int64_t max_messages,
+                      std::int64_t max_bytes,
+                      std::chrono::milliseconds buffer_time,
+                      ClockFunction clock = &Clock::now);
+
+  /// Record a message received from the service.
+  void Received(std::string const& ack_id, std::int64_t bytes);
+
+  /// Record a message acked or nacked by the application.
+  void Handled(std::string const& ack_id);
+
+  /// Returns true if the buffer has room for more messages.
+  bool CanRead() const;
+
+  std::int64_t target_messages() const { return target_messages_; }
+  std::int64_t target_bytes() const;
+  std::int64_t outstanding_messages() const {
+    return static_cast<std::int64_t>(outstanding_.size());
+  }
+  std::int64_t outstanding_bytes() const { return outstanding_bytes_; }
+
+ private:
+  void UpdateTarget(Clock::time_point now);
+
+  std::int64_t const min_messages_;
+  std::int64_t const max_messages_;
+  std::int64_t const max_bytes_;
+  std::chrono::milliseconds const buffer_time_;
+  ClockFunction clock_;
+
+  std::unordered_map<std::string, std::int64_t> outstanding_;
+  std::int64_t outstanding_bytes_ = 0;
+  std::int64_t target_messages_;
+  Clock::time_point sample_start_;
+  std::int64_t sample_handled_ = 0;
+  double handled_per_second_ = 0;
+  double average_bytes_ = 0;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ADAPTIVE_FLOW_CONTROL_H
@@ -0,0 +1,123 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/adaptive_flow_control.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ms = std::chrono::milliseconds;
+
+class FakeClock {
+ public:
+  AdaptiveFlowControl::ClockFunction AsFunction() {
+    return [this] { return now_; };
+  }
+  void Advance(ms d) { now_ += d; }
+
+ private:
+  AdaptiveFlowControl::Clock::time_point now_ =
+      AdaptiveFlowControl::Clock::now();
+};
+
+std::string AckId(int i) { return "ack-" + std::to_string(i); }
+
+TEST(AdaptiveFlowControl, StartsAtMinimum) {
+  FakeClock clock;
+  AdaptiveFlowControl tested(4, 100, 0, ms(1000), clock.AsFunction());
+  EXPECT_EQ(4, tested.target_messages());
+  for (int i = 0; i != 4; ++i) {
+    EXPECT_TRUE(tested.CanRead());
+    tested.Received(AckId(i), 10);
+  }
+  EXPECT_FALSE(tested.CanRead());
+  EXPECT_EQ(4, tested.outstanding_messages());
+  EXPECT_EQ(40, tested.outstanding_bytes());
+
+  tested.Handled(AckId(0));
+  EXPECT_TRUE(tested.CanRead());
+  // Unknown and duplicate ids are ignored.
+  tested.Handled(AckId(0));
+  tested.Handled("unknown");
+  EXPECT_EQ(3, tested.outstanding_messages());
+  EXPECT_EQ(30, tested.outstanding_bytes());
+}
+
+TEST(AdaptiveFlowControl, TargetFollowsHandlingRate) {
+  FakeClock clock;
+  AdaptiveFlowControl tested(2, 1000, 0, ms(500), clock.AsFunction());
+  // Handle 40 messages per second, the buffer should hold 500ms worth.
+  for (int i = 0; i != 40; ++i) {
+    tested.Received(AckId(i), 100);
+    clock.Advance(ms(25));
+    tested.Handled(AckId(i));
+  }
+  EXPECT_EQ(2 + 20, tested.target_messages());
+
+  // A slower rate shrinks the target, the estimate is smoothed.
+  for (int i = 40; i != 50; ++i) {
+    tested.Received(AckId(i), 100);
+    clock.Advance(ms(100));
+    tested.Handled(AckId(i));
+  }
+  EXPECT_EQ(2 + 13, tested.target_messages());
+}
+
+TEST(AdaptiveFlowControl, TargetCappedByMaxMessages) {
+  FakeClock clock;
+  AdaptiveFlowControl tested(2, 10, 0, ms(1000), clock.AsFunction());
+  for (int i = 0; i != 1000; ++i) {
+    tested.Received(AckId(i), 100);
+    clock.Advance(ms(1));
+    tested.Handled(AckId(i));
+  }
+  EXPECT_EQ(10, tested.target_messages());
+
+  // The minimum is also capped by the maximum.
+  AdaptiveFlowControl small(20, 10, 0, ms(1000), clock.AsFunction());
+  EXPECT_EQ(10, small.target_messages());
+}
+
+TEST(AdaptiveFlowControl, BytesTarget) {
+  FakeClock clock;
+  AdaptiveFlowControl tested(4, 100, 1000, ms(1000), clock.AsFunction());
+  // Without samples the target is the configured maximum.
+  EXPECT_EQ(1000, tested.target_bytes());
+
+  tested.Received(AckId(0), 100);
+  EXPECT_EQ(400, tested.target_bytes());
+  tested.Received(AckId(1), 400);
+  EXPECT_FALSE(tested.CanRead());
+  EXPECT_EQ(2, tested.outstanding_messages());
+
+  // A single large message is always admitted.
+  AdaptiveFlowControl large(4, 100, 1000, ms(1000), clock.AsFunction());
+  large.Received(AckId(0), 5000);
+  EXPECT_EQ(1000, large.target_bytes());
+  EXPECT_FALSE(large.CanRead());
+  large.Handled(AckId(0));
+  EXPECT_TRUE(large.CanRead());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
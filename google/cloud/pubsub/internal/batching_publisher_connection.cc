@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/batching_publisher_connection.h"
+#include <cstdint>
 
 namespace google {
 namespace cloud {
@@ -22,61 +23,54 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 // A helper callable to handle a response, it is a bit large for a lambda, and
 // we need move-capture anyways.
 struct Batch {
-  std::vector<promise<StatusOr<std::string>>> waiters;
+  std::vector<BatchingPublisherConnection::Waiter> waiters;
+  int message_count = 0;
+  std::size_t no_wait_count = 0;
+  pubsub::PublisherOptions::BatchResultCallback on_result;
   std::weak_ptr<BatchingPublisherConnection> weak;
+  google::cloud::internal::MemoryReservation memory;
 
   void operator()(future<StatusOr<google::pubsub::v1::PublishResponse>> f) {
     auto response = f.get();
+    // The continuation may outlive this call, release the bytes now.
+    memory.Resize(0);
+    auto batcher = weak.lock();
     if (!response) {
-      SatisfyAllWaiters(response.status());
-      if (auto batcher = weak.lock()) batcher->HandleError(response.status());
-      return;
-    }
-    if (static_cast<std::size_t>(response->message_ids_size()) !=
-        waiters.size()) {
-      SatisfyAllWaiters(
-          Status(StatusCode::kUnknown, "mismatched message id count"));
-      return;
-    }
-    int idx = 0;
-    for (auto& w : waiters) {
-      w.set_value(std::move(*response->mutable_message_ids(idx++)));
+      SatisfyAll(response.status());
+      if (batcher) batcher->HandleError(response.status());
+    } else if (response->message_ids_size() != message_count) {
+      SatisfyAll(Status(StatusCode::kUnknown, "mismatched message id count"));
+    } else {
+      for (auto& w : waiters) {
+        w.p.set_value(std::move(*response->mutable_message_ids(w.index)));
+      }
+      ReportNoWait(Status{});
     }
+    if (batcher) batcher->OnBatchDone();
+  }
+
+  void SatisfyAll(Status const& status) {
+    for (auto& w : waiters) w.p.set_value(status);
+    ReportNoWait(status);
   }
 
-  void SatisfyAllWaiters(Status const& status) {
-    for (auto& w : waiters) w.set_value(status);
+  void ReportNoWait(Status const& status) {
+    if (no_wait_count != 0 && on_result) on_result(status, no_wait_count);
   }
 };
 
 future<StatusOr<std::string>> BatchingPublisherConnection::Publish(
     PublishParams p) {
   auto const bytes = pubsub_internal::MessageSize(p.message);
-  std::unique_lock<std::mutex> lk(mu_);
-  do {
-    if (!corked_on_status_.ok()) return CorkedError();
-    // If empty we need to create the batch, even if it would be oversized,
-    // otherwise the message may be dropped.
-    if (waiters_.empty()) break;
-    auto const has_bytes_capacity =
-        current_bytes_ + bytes <= options_.maximum_batch_bytes();
-    auto const has_messages_capacity =
-        waiters_.size() < options_.maximum_batch_message_count();
-    // If there is enough room just add the message below.
-    if (has_bytes_capacity && has_messages_capacity) break;
-    // We need to flush the existing batch, that will release the lock, and then
-    // we try again.
-    FlushImpl(std::move(lk));
-    lk = std::unique_lock<std::mutex>(mu_);
-  } while (true);
+  auto lk = MakeRoom(bytes);
+  if (!corked_on_status_.ok()) return CorkedError();
 
-  auto proto = pubsub_internal::ToProto(std::move(p.message));
-  waiters_.emplace_back();
-  auto f = waiters_.back().get_future();
+  waiters_.push_back(Waiter{pending_.messages_size(), {}});
+  auto f = waiters_.back().p.get_future();
 
   // Use RAII to preserve the strong exception guarantee.
   struct UndoPush {
-    std::vector<promise<StatusOr<std::string>>>* waiters;
+    std::vector<Waiter>* waiters;
 
     ~UndoPush() {
       if (waiters != nullptr) waiters->pop_back();
@@ -84,13 +78,33 @@ future<StatusOr<std::string>> BatchingPublisherConnection::Publish(
     void release() { waiters = nullptr; }
   } undo{&waiters_};
 
-  *pending_.add_messages() = std::move(proto);
+  // Swap the message into the request, without temporaries or copies.
+  auto&& message = pubsub_internal::ToProto(std::move(p.message));
+  pending_.add_messages()->Swap(&message);
   undo.release();  // no throws after this point, we can rest easy
   current_bytes_ += bytes;
+  pending_memory_.Add(static_cast<std::int64_t>(bytes));
   MaybeFlush(std::move(lk));
   return f;
 }
 
+void BatchingPublisherConnection::PublishNoWait(PublishNoWaitParams p) {
+  auto const bytes = pubsub_internal::MessageSize(p.message);
+  auto lk = MakeRoom(bytes);
+  if (!corked_on_status_.ok()) {
+    auto status = corked_on_status_;
+    lk.unlock();
+    ReportNoWait(std::move(status), 1);
+    return;
+  }
+  auto&& message = pubsub_internal::ToProto(std::move(p.message));
+  pending_.add_messages()->Swap(&message);
+  ++no_wait_count_;
+  current_bytes_ += bytes;
+  pending_memory_.Add(static_cast<std::int64_t>(bytes));
+  MaybeFlush(std::move(lk));
+}
+
 void BatchingPublisherConnection::Flush(FlushParams) {
   FlushImpl(std::unique_lock<std::mutex>(mu_));
 }
@@ -111,22 +125,39 @@ void BatchingPublisherConnection::HandleError(Status const& status) {
   if (!RequiresOrdering()) return;
   corked_on_status_ = status;
   pending_.Clear();
-  std::vector<promise<StatusOr<std::string>>> waiters;
+  current_bytes_ = 0;
+  pending_memory_.Resize(0);
+  std::vector<Waiter> waiters;
   waiters.swap(waiters_);
+  auto const no_wait_count = no_wait_count_;
+  no_wait_count_ = 0;
   lk.unlock();
-  for (auto& p : waiters) {
+  for (auto& w : waiters) {
     struct MoveCapture {
       promise<StatusOr<std::string>> p;
       Status status;
       void operator()() { p.set_value(std::move(status)); }
     };
-    cq_.RunAsync(MoveCapture{std::move(p), status});
+    cq_.RunAsync(MoveCapture{std::move(w.p), status});
   }
+  if (no_wait_count != 0) ReportNoWait(status, no_wait_count);
+}
+
+bool BatchingPublisherConnection::IsIdle() {
+  std::lock_guard<std::mutex> lk(mu_);
+  return pending_.messages().empty() && outstanding_batches_ == 0 &&
+         corked_on_status_.ok();
+}
+
+void BatchingPublisherConnection::OnBatchDone() {
+  std::lock_guard<std::mutex> lk(mu_);
+  --outstanding_batches_;
 }
 
 void BatchingPublisherConnection::MaybeFlush(std::unique_lock<std::mutex> lk) {
   auto const too_many_messages =
-      waiters_.size() >= options_.maximum_batch_message_count();
+      static_cast<std::size_t>(pending_.messages_size()) >=
+      options_.maximum_batch_message_count();
   auto const too_many_bytes = current_bytes_ >= options_.maximum_batch_bytes();
   if (too_many_messages || too_many_bytes) {
     FlushImpl(std::move(lk));
@@ -177,17 +208,66 @@ future<StatusOr<std::string>> BatchingPublisherConnection::CorkedError() {
   return f;
 }
 
+void BatchingPublisherConnection::ReportNoWait(Status status,
+                                               std::size_t message_count) {
+  auto const& callback = options_.batch_result_callback();
+  if (!callback) return;
+  struct MoveCapture {
+    pubsub::PublisherOptions::BatchResultCallback callback;
+    Status status;
+    std::size_t message_count;
+    void operator()() { callback(std::move(status), message_count); }
+  };
+  cq_.RunAsync(MoveCapture{callback, std::move(status), message_count});
+}
+
+std::unique_lock<std::mutex> BatchingPublisherConnection::MakeRoom(
+    std::size_t bytes) {
+  std::unique_lock<std::mutex> lk(mu_);
+  do {
+    if (!corked_on_status_.ok()) break;
+    // If empty we need to create the batch, even if it would be oversized,
+    // otherwise the message may be dropped.
+    if (pending_.messages().empty()) break;
+    auto const has_bytes_capacity =
+        current_bytes_ + bytes <= options_.maximum_batch_bytes();
+    auto const has_messages_capacity =
+        static_cast<std::size_t>(pending_.messages_size()) <
+        options_.maximum_batch_message_count();
+    // If there is enough room just add the message below.
+    if (has_bytes_capacity && has_messages_capacity) break;
+    // We need to flush the existing batch, that will release the lock, and then
+    // we try again.
+    FlushImpl(std::move(lk));
+    lk = std::unique_lock<std::mutex>(mu_);
+  } while (true);
+  return lk;
+}
+
 void BatchingPublisherConnection::FlushImpl(std::unique_lock<std::mutex> lk) {
   if (pending_.messages().empty()) return;
 
   Batch batch;
   batch.waiters.swap(waiters_);
+  batch.message_count = pending_.messages_size();
+  batch.no_wait_count = no_wait_count_;
+  if (no_wait_count_ != 0) {
+    batch.on_result = options_.batch_result_callback();
+    no_wait_count_ = 0;
+  }
   google::pubsub::v1::PublishRequest request;
   request.Swap(&pending_);
-  // Reserve enough capacity for the next batch.
-  pending_.mutable_messages()->Reserve(
-      static_cast<int>(options_.maximum_batch_message_count()));
+  // Reserve enough capacity for the next batch. Publishers with message
+  // ordering may have millions of (mostly small) per-key batches, do not
+  // preallocate for them.
+  if (!RequiresOrdering()) {
+    pending_.mutable_messages()->Reserve(
+        static_cast<int>(options_.maximum_batch_message_count()));
+  }
   current_bytes_ = 0;
+  batch.memory = std::move(pending_memory_);
+  pending_memory_ = google::cloud::internal::MemoryReservation(memory_account_);
+  ++outstanding_batches_;
   lk.unlock();
 
   batch.weak = shared_from_this();
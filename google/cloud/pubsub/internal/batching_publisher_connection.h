@@ -18,6 +18,7 @@
 #include "google/cloud/pubsub/internal/batch_sink.h"
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/version.h"
+#include "google/cloud/memory_accountant.h"
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -36,34 +37,60 @@ class BatchingPublisherConnection
   static std::shared_ptr<BatchingPublisherConnection> Create(
       pubsub::Topic topic, pubsub::PublisherOptions options,
       std::string ordering_key, std::shared_ptr<BatchSink> sink,
-      google::cloud::CompletionQueue cq) {
+      google::cloud::CompletionQueue cq,
+      std::shared_ptr<MemoryAccount> memory_account = {}) {
     return std::shared_ptr<BatchingPublisherConnection>(
-        new BatchingPublisherConnection(std::move(topic), std::move(options),
-                                        std::move(ordering_key),
-                                        std::move(sink), std::move(cq)));
+        new BatchingPublisherConnection(
+            std::move(topic), std::move(options), std::move(ordering_key),
+            std::move(sink), std::move(cq), std::move(memory_account)));
   }
 
   future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void PublishNoWait(PublishNoWaitParams p) override;
   void Flush(FlushParams) override;
   void ResumePublish(ResumePublishParams p) override;
 
   void HandleError(Status const& status);
+  void OnBatchDone();
+
+  /**
+   * Returns true if the connection holds no state.
+   *
+   * That is, there are no pending messages, no batches waiting for a response,
+   * and the connection is not corked by an error. Such a connection can be
+   * discarded, and replaced by a new one, without losing ordering guarantees.
+   */
+  bool IsIdle();
 
  private:
   explicit BatchingPublisherConnection(pubsub::Topic topic,
                                        pubsub::PublisherOptions options,
                                        std::string ordering_key,
                                        std::shared_ptr<BatchSink> sink,
-                                       google::cloud::CompletionQueue cq)
+                                       google::cloud::CompletionQueue cq,
+                                       std::shared_ptr<MemoryAccount> account)
       : topic_(std::move(topic)),
         topic_full_name_(topic_.FullName()),
         options_(std::move(options)),
         ordering_key_(std::move(ordering_key)),
         sink_(std::move(sink)),
-        cq_(std::move(cq)) {}
+        cq_(std::move(cq)),
+        memory_account_(std::move(account)),
+        pending_memory_(memory_account_) {}
+
+  friend struct Batch;
+
+  // A message published with `Publish()`, waiting for its message id.
+  struct Waiter {
+    // The position of the message in the batch.
+    int index;
+    promise<StatusOr<std::string>> p;
+  };
 
   void OnTimer();
   future<StatusOr<std::string>> CorkedError();
+  void ReportNoWait(Status status, std::size_t message_count);
+  std::unique_lock<std::mutex> MakeRoom(std::size_t bytes);
   void MaybeFlush(std::unique_lock<std::mutex> lk);
   void FlushImpl(std::unique_lock<std::mutex> lk);
 
@@ -75,12 +102,19 @@ class BatchingPublisherConnection
   std::string const ordering_key_;
   std::shared_ptr<BatchSink> const sink_;
   google::cloud::CompletionQueue cq_;
+  std::shared_ptr<MemoryAccount> const memory_account_;
 
   std::mutex mu_;
-  std::vector<promise<StatusOr<std::string>>> waiters_;
+  std::vector<Waiter> waiters_;
+  // The number of messages in `pending_` published with `PublishNoWait()`.
+  std::size_t no_wait_count_ = 0;
   google::pubsub::v1::PublishRequest pending_;
   std::size_t current_bytes_ = 0;
+  // The bytes in `pending_`, each batch keeps them until it completes.
+  google::cloud::internal::MemoryReservation pending_memory_;
   std::chrono::system_clock::time_point batch_expiration_;
+  // The number of batches sent to `sink_` without a response.
+  std::size_t outstanding_batches_ = 0;
 
   Status corked_on_status_;
 };
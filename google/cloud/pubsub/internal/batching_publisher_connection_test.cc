@@ -20,6 +20,7 @@
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <mutex>
 #include <numeric>
@@ -39,6 +40,7 @@ using ::testing::AtLeast;
 using ::testing::Contains;
 using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::UnorderedElementsAre;
 
 google::pubsub::v1::PublishResponse MakeResponse(
     google::pubsub::v1::PublishRequest const& request) {
@@ -170,6 +172,116 @@ TEST(BatchingPublisherConnectionTest, BatchByMessageCount) {
   background.cq().CancelAll();
 }
 
+TEST(BatchingPublisherConnectionTest, PublishNoWait) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const& request) {
+        auto const data = MessagesData(request);
+        EXPECT_THAT(data, ElementsAre("test-data-0", "test-data-1",
+                                      "test-data-2", "test-data-3"));
+        google::pubsub::v1::PublishResponse response;
+        for (auto const& d : data) response.add_message_ids("id-" + d);
+        return make_ready_future(make_status_or(response));
+      });
+
+  promise<std::pair<Status, std::size_t>> done;
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto const ordering_key = std::string{};
+  auto publisher = BatchingPublisherConnection::Create(
+      topic,
+      pubsub::PublisherOptions{}
+          .set_maximum_batch_message_count(4)
+          .set_maximum_hold_time(std::chrono::hours(24))
+          .set_batch_result_callback(
+              [&done](Status const& status, std::size_t message_count) {
+                done.set_value(std::make_pair(status, message_count));
+              }),
+      ordering_key, mock, background.cq());
+
+  // Mix both styles in the same batch, the message ids must go to the right
+  // `Publish()` calls.
+  publisher->PublishNoWait(
+      {pubsub::MessageBuilder{}.SetData("test-data-0").Build()});
+  auto r1 = publisher->Publish(
+      {pubsub::MessageBuilder{}.SetData("test-data-1").Build()});
+  publisher->PublishNoWait(
+      {pubsub::MessageBuilder{}.SetData("test-data-2").Build()});
+  auto r3 = publisher->Publish(
+      {pubsub::MessageBuilder{}.SetData("test-data-3").Build()});
+
+  auto result = done.get_future().get();
+  EXPECT_STATUS_OK(result.first);
+  EXPECT_EQ(2, result.second);
+  auto id1 = r1.get();
+  ASSERT_STATUS_OK(id1);
+  EXPECT_EQ("id-test-data-1", *id1);
+  auto id3 = r3.get();
+  ASSERT_STATUS_OK(id3);
+  EXPECT_EQ("id-test-data-3", *id3);
+}
+
+TEST(BatchingPublisherConnectionTest, PublishNoWaitErrorWithOrdering) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  auto const error_status = Status(StatusCode::kPermissionDenied, "uh-oh");
+
+  AsyncSequencer<void> async;
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const&) {
+        return async.PushBack().then([error_status](future<void>) {
+          return StatusOr<google::pubsub::v1::PublishResponse>(error_status);
+        });
+      });
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::vector<std::pair<StatusCode, std::size_t>> results;
+  auto constexpr kBatchSize = 4;
+  auto const ordering_key = std::string{"test-key"};
+  // Create an inactive queue to avoid race conditions.
+  google::cloud::CompletionQueue cq;
+  auto publisher = BatchingPublisherConnection::Create(
+      topic,
+      pubsub::PublisherOptions{}
+          .set_maximum_batch_message_count(kBatchSize)
+          .set_batch_result_callback(
+              [&](Status const& status, std::size_t message_count) {
+                std::lock_guard<std::mutex> lk(mu);
+                results.emplace_back(status.code(), message_count);
+                cv.notify_one();
+              }),
+      ordering_key, mock, cq);
+  // Create a full batch (by message count) and a partial batch.
+  for (int i = 0; i != kBatchSize + kBatchSize / 2; ++i) {
+    publisher->PublishNoWait(
+        {pubsub::MessageBuilder{}.SetData("data-" + std::to_string(i)).Build()});
+  }
+
+  // Fail the first batch, this also discards the partial batch.
+  async.PopFront().set_value();
+  // The publisher rejects new messages until `ResumePublish()` is called.
+  publisher->PublishNoWait({pubsub::MessageBuilder{}.SetData("late").Build()});
+
+  // Some callbacks run asynchronously, we need to activate the CompletionQueue.
+  std::thread t{[](CompletionQueue cq) { cq.Run(); }, cq};
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return results.size() == 3; });
+    EXPECT_THAT(results, UnorderedElementsAre(
+                             std::make_pair(StatusCode::kPermissionDenied,
+                                           std::size_t{kBatchSize}),
+                            std::make_pair(StatusCode::kPermissionDenied,
+                                           std::size_t{kBatchSize / 2}),
+                            std::make_pair(StatusCode::kPermissionDenied,
+                                           std::size_t{1})));
+  }
+  cq.Shutdown();
+  t.join();
+}
+
 TEST(BatchingPublisherConnectionTest, BatchByMessageSize) {
   auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
   pubsub::Topic const topic("test-project", "test-topic");
@@ -584,6 +696,84 @@ TEST(BatchingPublisherConnectionTest, HandleError) {
               StatusIs(StatusCode::kPermissionDenied, HasSubstr("uh-oh")));
 }
 
+TEST(BatchingPublisherConnectionTest, IsIdle) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  promise<StatusOr<google::pubsub::v1::PublishResponse>> p0;
+  promise<StatusOr<google::pubsub::v1::PublishResponse>> p1;
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const&) {
+        return p0.get_future();
+      })
+      .WillOnce([&](google::pubsub::v1::PublishRequest const&) {
+        return p1.get_future();
+      });
+  EXPECT_CALL(*mock, ResumePublish).Times(1);
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto publisher = BatchingPublisherConnection::Create(
+      topic, pubsub::PublisherOptions{}.set_maximum_batch_message_count(4),
+      "test-ordering-key", mock, background.cq());
+  EXPECT_TRUE(publisher->IsIdle());
+
+  // Pending messages and outstanding batches keep the connection busy.
+  auto r0 = publisher->Publish(
+      {pubsub::MessageBuilder{}.SetData("test-data-0").Build()});
+  EXPECT_FALSE(publisher->IsIdle());
+  publisher->Flush({});
+  EXPECT_FALSE(publisher->IsIdle());
+  google::pubsub::v1::PublishResponse response;
+  response.add_message_ids("test-message-id-0");
+  p0.set_value(response);
+  EXPECT_STATUS_OK(r0.get());
+  EXPECT_TRUE(publisher->IsIdle());
+
+  // So does an error, until the application resumes publishing.
+  auto r1 = publisher->Publish(
+      {pubsub::MessageBuilder{}.SetData("test-data-1").Build()});
+  publisher->Flush({});
+  p1.set_value(Status(StatusCode::kPermissionDenied, "uh-oh"));
+  EXPECT_THAT(r1.get(), StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_FALSE(publisher->IsIdle());
+  publisher->ResumePublish({"test-ordering-key"});
+  EXPECT_TRUE(publisher->IsIdle());
+}
+
+TEST(BatchingPublisherConnectionTest, MemoryAccounting) {
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  promise<StatusOr<google::pubsub::v1::PublishResponse>> p0;
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::pubsub::v1::PublishRequest const&) {
+        return p0.get_future();
+      });
+
+  auto accountant = std::make_shared<MemoryAccountant>();
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto publisher = BatchingPublisherConnection::Create(
+      topic, pubsub::PublisherOptions{}.set_maximum_batch_message_count(4), {},
+      mock, background.cq(), accountant->CreateAccount("test"));
+
+  auto m0 = pubsub::MessageBuilder{}.SetData("test-data-0").Build();
+  auto const size = static_cast<std::int64_t>(MessageSize(m0));
+  auto r0 = publisher->Publish({std::move(m0)});
+  publisher->PublishNoWait(
+      {pubsub::MessageBuilder{}.SetData("test-data-1").Build()});
+  EXPECT_EQ(2 * size, accountant->bytes());
+
+  // The bytes are held until the batch completes.
+  publisher->Flush({});
+  EXPECT_EQ(2 * size, accountant->bytes());
+  google::pubsub::v1::PublishResponse response;
+  response.add_message_ids("test-message-id-0");
+  response.add_message_ids("test-message-id-1");
+  p0.set_value(response);
+  EXPECT_STATUS_OK(r0.get());
+  EXPECT_EQ(0, accountant->bytes());
+}
+
 TEST(BatchingPublisherConnectionTest, HandleInvalidResponse) {
   auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
   pubsub::Topic const topic("test-project", "test-topic");
@@ -18,6 +18,7 @@
 #include "google/cloud/pubsub/backoff_policy.h"
 #include "google/cloud/pubsub/internal/batch_sink.h"
 #include "google/cloud/pubsub/internal/publisher_stub.h"
+#include "google/cloud/pubsub/publisher_options.h"
 #include "google/cloud/pubsub/retry_policy.h"
 #include "google/cloud/pubsub/version.h"
 #include <memory>
@@ -28,17 +29,23 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
-/// Publish message batches using a stub, with retries, but no queueing.
+/**
+ * Publish message batches using a stub, with retries, but no queueing.
+ *
+ * If compression is enabled in the `PublisherOptions`, batches larger than the
+ * configured threshold are sent using gzip compression.
+ */
 class DefaultBatchSink : public BatchSink {
  public:
   static std::shared_ptr<DefaultBatchSink> Create(
       std::shared_ptr<pubsub_internal::PublisherStub> stub,
       google::cloud::CompletionQueue cq,
       std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
-      std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
+      std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+      pubsub::PublisherOptions const& options = {}) {
     return std::shared_ptr<DefaultBatchSink>(new DefaultBatchSink(
         std::move(stub), std::move(cq), std::move(retry_policy),
-        std::move(backoff_policy)));
+        std::move(backoff_policy), options));
   }
 
   ~DefaultBatchSink() override = default;
@@ -52,12 +59,15 @@ class DefaultBatchSink : public BatchSink {
   DefaultBatchSink(std::shared_ptr<pubsub_internal::PublisherStub> stub,
                    google::cloud::CompletionQueue cq,
                    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
-                   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy);
+                   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+                   pubsub::PublisherOptions const& options);
 
   std::shared_ptr<pubsub_internal::PublisherStub> stub_;
   google::cloud::CompletionQueue cq_;
   std::unique_ptr<pubsub::RetryPolicy const> retry_policy_;
   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy_;
+  bool const compression_enabled_;
+  std::size_t const compression_threshold_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
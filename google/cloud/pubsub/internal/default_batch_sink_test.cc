@@ -116,6 +116,54 @@ TEST(DefaultBatchSinkTest, TooManyTransients) {
               StatusIs(StatusCode::kUnavailable, HasSubstr("try-again")));
 }
 
+TEST(DefaultBatchSinkTest, CompressionThreshold) {
+  auto const small = MakeRequest(1);
+  auto const large = MakeRequest(100);
+  auto const threshold = small.ByteSizeLong() + 1;
+  ASSERT_GE(large.ByteSizeLong(), threshold);
+
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([](Unused, std::unique_ptr<grpc::ClientContext> context,
+                   google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(GRPC_COMPRESS_NONE, context->compression_algorithm());
+        return make_ready_future(make_status_or(MakeResponse(request)));
+      })
+      .WillOnce([](Unused, std::unique_ptr<grpc::ClientContext> context,
+                   google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(GRPC_COMPRESS_GZIP, context->compression_algorithm());
+        return make_ready_future(make_status_or(MakeResponse(request)));
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto uut = DefaultBatchSink::Create(
+      mock, background.cq(), pubsub_testing::TestRetryPolicy(),
+      pubsub_testing::TestBackoffPolicy(),
+      pubsub::PublisherOptions{}.enable_compression().set_compression_threshold(
+          threshold));
+
+  EXPECT_THAT(uut->AsyncPublish(small).get(), IsOk());
+  EXPECT_THAT(uut->AsyncPublish(large).get(), IsOk());
+}
+
+TEST(DefaultBatchSinkTest, CompressionDisabled) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([](Unused, std::unique_ptr<grpc::ClientContext> context,
+                   google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(GRPC_COMPRESS_NONE, context->compression_algorithm());
+        return make_ready_future(make_status_or(MakeResponse(request)));
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto uut = DefaultBatchSink::Create(
+      mock, background.cq(), pubsub_testing::TestRetryPolicy(),
+      pubsub_testing::TestBackoffPolicy(),
+      pubsub::PublisherOptions{}.set_compression_threshold(0));
+
+  EXPECT_THAT(uut->AsyncPublish(MakeRequest(100)).get(), IsOk());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
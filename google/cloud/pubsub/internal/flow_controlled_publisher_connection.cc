@@ -14,27 +14,54 @@
 
 #include "google/cloud/pubsub/internal/flow_controlled_publisher_connection.h"
 #include <algorithm>
+#include <chrono>
+#include <limits>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 namespace {
+auto constexpr kUnlimited = (std::numeric_limits<std::size_t>::max)();
+
 StatusOr<std::string> RejectMessage() {
   return Status(StatusCode::kFailedPrecondition, "Publisher is full");
 }
 }  // namespace
 
+FlowControlledPublisherConnection::~FlowControlledPublisherConnection() {
+  // The timers only hold weak pointers to this object, they do nothing once it
+  // is deleted.
+  for (auto& w : waiters_) {
+    if (w.timer.valid()) w.timer.cancel();
+    w.result.set_value(Status(StatusCode::kCancelled,
+                              "Publisher shutdown while the message was "
+                              "waiting for flow control"));
+  }
+}
+
 future<StatusOr<std::string>> FlowControlledPublisherConnection::Publish(
     PublishParams p) {
   auto const message_size = MessageSize(p.message);
   std::unique_lock<std::mutex> lk(mu_);
+  // Messages are published in order, a message cannot skip the queue even if
+  // there is room for it.
+  if (QueueWhenFull() &&
+      (draining_ || !waiters_.empty() || MakesFull(message_size))) {
+    return Enqueue(std::move(lk), std::move(p), message_size);
+  }
   if (MakesFull(message_size)) {
     if (RejectWhenFull()) return make_ready_future(RejectMessage());
     if (BlockWhenFull()) {
       cv_.wait(lk, [this, message_size] { return !MakesFull(message_size); });
     }
   }
+  return PublishChild(lk, std::move(p), message_size);
+}
+
+future<StatusOr<std::string>> FlowControlledPublisherConnection::PublishChild(
+    std::unique_lock<std::mutex>& lk, PublishParams p,
+    std::size_t message_size) {
   ++pending_messages_;
   pending_bytes_ += message_size;
   auto w = WeakFromThis();
@@ -50,6 +77,89 @@ future<StatusOr<std::string>> FlowControlledPublisherConnection::Publish(
   return r;
 }
 
+future<StatusOr<std::string>> FlowControlledPublisherConnection::Enqueue(
+    std::unique_lock<std::mutex> lk, PublishParams p,
+    std::size_t message_size) {
+  auto const id = ++waiter_id_;
+  waiters_.push_back(Waiter{id, std::move(p), message_size, {}, {}});
+  auto f = waiters_.back().result.get_future();
+  auto const max_wait = options_.full_publisher_max_wait();
+  if (max_wait.count() == 0) return f;
+  lk.unlock();
+  auto w = WeakFromThis();
+  auto timer = cq_.MakeRelativeTimer(max_wait).then(
+      [w, id](future<StatusOr<std::chrono::system_clock::time_point>> t) {
+        if (!t.get()) return;  // The timer was cancelled.
+        if (auto self = w.lock()) self->OnTimeout(id);
+      });
+  lk.lock();
+  auto i = std::find_if(waiters_.begin(), waiters_.end(),
+                        [id](Waiter const& x) { return x.id == id; });
+  if (i != waiters_.end()) {
+    i->timer = std::move(timer);
+    return f;
+  }
+  // The message was published (or timed out) before the timer was set.
+  lk.unlock();
+  timer.cancel();
+  return f;
+}
+
+void FlowControlledPublisherConnection::DrainQueue(
+    std::unique_lock<std::mutex> lk) {
+  // Only one thread publishes the waiting messages, this preserves their
+  // order. The thread keeps going while there is room for the next message,
+  // which includes any room made by other threads while it runs.
+  if (draining_) return;
+  draining_ = true;
+  while (!waiters_.empty() && !MakesFull(waiters_.front().message_size)) {
+    auto w = std::move(waiters_.front());
+    waiters_.pop_front();
+    auto r = PublishChild(lk, std::move(w.params), w.message_size);
+    lk.unlock();
+    if (w.timer.valid()) w.timer.cancel();
+    auto result =
+        std::make_shared<promise<StatusOr<std::string>>>(std::move(w.result));
+    r.then([result](future<StatusOr<std::string>> f) {
+      result->set_value(f.get());
+    });
+    lk.lock();
+  }
+  draining_ = false;
+}
+
+void FlowControlledPublisherConnection::OnTimeout(std::uint64_t id) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = std::find_if(waiters_.begin(), waiters_.end(),
+                        [id](Waiter const& x) { return x.id == id; });
+  if (i == waiters_.end()) return;
+  auto result = std::move(i->result);
+  waiters_.erase(i);
+  lk.unlock();
+  result.set_value(Status(StatusCode::kDeadlineExceeded,
+                          "Publisher is full, the message waited longer than "
+                          "the maximum wait time"));
+  // There may be room for the messages behind the expired message.
+  lk.lock();
+  DrainQueue(std::move(lk));
+}
+
+void FlowControlledPublisherConnection::PublishNoWait(PublishNoWaitParams p) {
+  // Without limits there is nothing to track.
+  if (options_.maximum_pending_messages() == kUnlimited &&
+      options_.maximum_pending_bytes() == kUnlimited) {
+    return child_->PublishNoWait(std::move(p));
+  }
+  // Flow control needs to know when each message completes, so this cannot
+  // avoid the per-message future. Report each result individually.
+  auto r = Publish({std::move(p.message)});
+  auto const& callback = options_.batch_result_callback();
+  if (!callback) return;
+  r.then([callback](future<StatusOr<std::string>> f) {
+    callback(f.get().status(), 1);
+  });
+}
+
 void FlowControlledPublisherConnection::Flush(FlushParams p) {
   return child_->Flush(std::move(p));
 }
@@ -62,6 +172,7 @@ void FlowControlledPublisherConnection::OnPublish(std::size_t message_size) {
   std::unique_lock<std::mutex> lk(mu_);
   --pending_messages_;
   pending_bytes_ -= message_size;
+  if (!waiters_.empty()) return DrainQueue(std::move(lk));
   if (IsFull()) return;  // Nothing to notify
   lk.unlock();
   cv_.notify_all();
@@ -17,9 +17,14 @@
 
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/version.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/memory_accountant.h"
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -30,15 +35,30 @@ class FlowControlledPublisherConnection
     : public pubsub::PublisherConnection,
       public std::enable_shared_from_this<FlowControlledPublisherConnection> {
  public:
+  /**
+   * Create a connection that applies the flow control limits in @p options.
+   *
+   * The @p cq runs the timers for `full_publisher_max_wait()`, it is only used
+   * when the publisher queues messages.
+   *
+   * The publisher is also full while the accountant of @p memory_account is
+   * over its soft limit.
+   */
   static std::shared_ptr<FlowControlledPublisherConnection> Create(
       pubsub::PublisherOptions options,
-      std::shared_ptr<pubsub::PublisherConnection> child) {
+      std::shared_ptr<pubsub::PublisherConnection> child,
+      CompletionQueue cq = {},
+      std::shared_ptr<MemoryAccount> memory_account = {}) {
     return std::shared_ptr<FlowControlledPublisherConnection>(
         new FlowControlledPublisherConnection(std::move(options),
-                                              std::move(child)));
+                                              std::move(child), std::move(cq),
+                                              std::move(memory_account)));
   }
 
+  ~FlowControlledPublisherConnection() override;
+
   future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void PublishNoWait(PublishNoWaitParams p) override;
   void Flush(FlushParams p) override;
   void ResumePublish(ResumePublishParams p) override;
 
@@ -60,9 +80,30 @@ class FlowControlledPublisherConnection
  private:
   explicit FlowControlledPublisherConnection(
       pubsub::PublisherOptions options,
-      std::shared_ptr<pubsub::PublisherConnection> child)
-      : options_(std::move(options)), child_(std::move(child)) {}
+      std::shared_ptr<pubsub::PublisherConnection> child, CompletionQueue cq,
+      std::shared_ptr<MemoryAccount> memory_account)
+      : options_(std::move(options)),
+        child_(std::move(child)),
+        cq_(std::move(cq)),
+        memory_account_(std::move(memory_account)) {}
+
+  /// A message waiting for room in the publisher, see `QueueWhenFull()`.
+  struct Waiter {
+    std::uint64_t id;
+    PublishParams params;
+    std::size_t message_size;
+    promise<StatusOr<std::string>> result;
+    future<void> timer;
+  };
 
+  future<StatusOr<std::string>> PublishChild(std::unique_lock<std::mutex>& lk,
+                                             PublishParams p,
+                                             std::size_t message_size);
+  future<StatusOr<std::string>> Enqueue(std::unique_lock<std::mutex> lk,
+                                        PublishParams p,
+                                        std::size_t message_size);
+  void DrainQueue(std::unique_lock<std::mutex> lk);
+  void OnTimeout(std::uint64_t id);
   void OnPublish(std::size_t message_size);
   bool IsFull() const {
     return pending_messages_ > options_.maximum_pending_messages() ||
@@ -72,16 +113,20 @@ class FlowControlledPublisherConnection
     // Accept at least one message before blocking or rejecting data.
     if (pending_messages_ == 0) return false;
     return pending_messages_ + 1 > options_.maximum_pending_messages() ||
-           pending_bytes_ + message_size > options_.maximum_pending_bytes();
+           pending_bytes_ + message_size > options_.maximum_pending_bytes() ||
+           (memory_account_ && memory_account_->OverSoftLimit());
   }
   bool RejectWhenFull() const { return options_.full_publisher_rejects(); }
   bool BlockWhenFull() const { return options_.full_publisher_blocks(); }
+  bool QueueWhenFull() const { return options_.full_publisher_queues(); }
   std::weak_ptr<FlowControlledPublisherConnection> WeakFromThis() {
     return shared_from_this();
   }
 
   pubsub::PublisherOptions const options_;
   std::shared_ptr<pubsub::PublisherConnection> const child_;
+  CompletionQueue cq_;
+  std::shared_ptr<MemoryAccount> const memory_account_;
 
   mutable std::mutex mu_;
   std::condition_variable cv_;
@@ -89,6 +134,9 @@ class FlowControlledPublisherConnection
   std::size_t pending_messages_ = 0;
   std::size_t max_pending_bytes_ = 0;
   std::size_t max_pending_messages_ = 0;
+  std::deque<Waiter> waiters_;
+  std::uint64_t waiter_id_ = 0;
+  bool draining_ = false;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
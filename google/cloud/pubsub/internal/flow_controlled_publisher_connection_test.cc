@@ -14,6 +14,7 @@
 
 #include "google/cloud/pubsub/internal/flow_controlled_publisher_connection.h"
 #include "google/cloud/pubsub/mocks/mock_publisher_connection.h"
+#include "google/cloud/internal/background_threads_impl.h"
 #include "google/cloud/testing_util/async_sequencer.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
@@ -30,6 +31,7 @@ using ::google::cloud::pubsub_mocks::MockPublisherConnection;
 using ::google::cloud::testing_util::AsyncSequencer;
 using ::google::cloud::testing_util::IsOk;
 using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
 
 pubsub::Message MakeTestMessage(std::size_t size) {
   return pubsub::MessageBuilder{}.SetData(std::string(size, 'A')).Build();
@@ -125,6 +127,37 @@ TEST(FlowControlledPublisherConnection, RejectOnMessages) {
   EXPECT_THAT(m4.get(), IsOk());
 }
 
+TEST(FlowControlledPublisherConnection, RejectOverMemorySoftLimit) {
+  AsyncSequencer<StatusOr<std::string>> publish;
+  auto mock = std::make_shared<MockPublisherConnection>();
+  EXPECT_CALL(*mock, Publish)
+      .WillRepeatedly(
+          [&publish](pubsub::PublisherConnection::PublishParams const&) {
+            return publish.PushBack("Publish()");
+          });
+
+  auto accountant = std::make_shared<MemoryAccountant>(1024);
+  auto other = accountant->CreateAccount("other");
+  auto under_test = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}.set_full_publisher_rejects(), mock, {},
+      accountant->CreateAccount("test"));
+  auto m0 = under_test->Publish({MakeTestMessage(10)});
+  auto m1 = under_test->Publish({MakeTestMessage(10)});
+  // Other clients can push the accountant over its soft limit.
+  other->Add(2048);
+  auto m2 = under_test->Publish({MakeTestMessage(10)});
+  EXPECT_THAT(m2.get(), StatusIs(StatusCode::kFailedPrecondition));
+  other->Add(-2048);
+  auto m3 = under_test->Publish({MakeTestMessage(10)});
+
+  for (auto i = 0; i != 3; ++i) {
+    publish.PopFront().set_value(make_status_or(std::string{"ack"}));
+  }
+  EXPECT_THAT(m0.get(), IsOk());
+  EXPECT_THAT(m1.get(), IsOk());
+  EXPECT_THAT(m3.get(), IsOk());
+}
+
 TEST(FlowControlledPublisherConnection, AcceptsAtLeastOne) {
   AsyncSequencer<StatusOr<std::string>> publish;
   auto mock = std::make_shared<MockPublisherConnection>();
@@ -151,6 +184,113 @@ TEST(FlowControlledPublisherConnection, AcceptsAtLeastOne) {
   EXPECT_THAT(m1.get(), IsOk());
 }
 
+TEST(FlowControlledPublisherConnection, QueueOnMessages) {
+  AsyncSequencer<StatusOr<std::string>> publish;
+  std::vector<std::size_t> published;
+  auto mock = std::make_shared<MockPublisherConnection>();
+  EXPECT_CALL(*mock, Publish)
+      .WillRepeatedly([&](pubsub::PublisherConnection::PublishParams const& p) {
+        published.push_back(p.message.data().size());
+        return publish.PushBack("Publish()");
+      });
+
+  auto under_test = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}
+          .set_full_publisher_queues()
+          .set_maximum_pending_messages(2),
+      mock);
+
+  auto m0 = under_test->Publish({MakeTestMessage(100)});
+  auto m1 = under_test->Publish({MakeTestMessage(101)});
+  auto m2 = under_test->Publish({MakeTestMessage(102)});
+  // The caller is not blocked, the message waits for room in the publisher.
+  EXPECT_THAT(published, ElementsAre(100, 101));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m0"}));
+  EXPECT_THAT(m0.get(), IsOk());
+  EXPECT_THAT(published, ElementsAre(100, 101, 102));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m1"}));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m2"}));
+  EXPECT_THAT(m1.get(), IsOk());
+  auto r2 = m2.get();
+  ASSERT_THAT(r2, IsOk());
+  EXPECT_EQ("ack-m2", *r2);
+}
+
+TEST(FlowControlledPublisherConnection, QueueIsFifo) {
+  AsyncSequencer<StatusOr<std::string>> publish;
+  std::vector<std::size_t> published;
+  auto mock = std::make_shared<MockPublisherConnection>();
+  EXPECT_CALL(*mock, Publish)
+      .WillRepeatedly([&](pubsub::PublisherConnection::PublishParams const& p) {
+        published.push_back(p.message.data().size());
+        return publish.PushBack("Publish()");
+      });
+
+  auto under_test = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}
+          .set_full_publisher_queues()
+          .set_maximum_pending_bytes(128 * 1024),
+      mock);
+
+  auto m0 = under_test->Publish({MakeTestMessage(96 * 1024)});
+  auto m1 = under_test->Publish({MakeTestMessage(64 * 1024)});
+  // There is room for this message, but it must wait behind `m1`.
+  auto m2 = under_test->Publish({MakeTestMessage(1024)});
+  EXPECT_THAT(published, ElementsAre(96 * 1024));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m0"}));
+  EXPECT_THAT(published, ElementsAre(96 * 1024, 64 * 1024, 1024));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m1"}));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m2"}));
+  EXPECT_THAT(m0.get(), IsOk());
+  EXPECT_THAT(m1.get(), IsOk());
+  EXPECT_THAT(m2.get(), IsOk());
+}
+
+TEST(FlowControlledPublisherConnection, QueueMaxWait) {
+  AsyncSequencer<StatusOr<std::string>> publish;
+  auto mock = std::make_shared<MockPublisherConnection>();
+  EXPECT_CALL(*mock, Publish)
+      .WillOnce([&](pubsub::PublisherConnection::PublishParams const&) {
+        return publish.PushBack("Publish()");
+      });
+
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  auto under_test = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}
+          .set_full_publisher_queues()
+          .set_full_publisher_max_wait(std::chrono::milliseconds(10))
+          .set_maximum_pending_messages(1),
+      mock, background.cq());
+
+  auto m0 = under_test->Publish({MakeTestMessage(128)});
+  auto m1 = under_test->Publish({MakeTestMessage(128)});
+  EXPECT_THAT(m1.get(), StatusIs(StatusCode::kDeadlineExceeded));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m0"}));
+  EXPECT_THAT(m0.get(), IsOk());
+}
+
+TEST(FlowControlledPublisherConnection, QueueSatisfiedOnShutdown) {
+  AsyncSequencer<StatusOr<std::string>> publish;
+  auto mock = std::make_shared<MockPublisherConnection>();
+  EXPECT_CALL(*mock, Publish)
+      .WillOnce([&](pubsub::PublisherConnection::PublishParams const&) {
+        return publish.PushBack("Publish()");
+      });
+
+  auto under_test = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}
+          .set_full_publisher_queues()
+          .set_maximum_pending_messages(1),
+      mock);
+
+  auto m0 = under_test->Publish({MakeTestMessage(128)});
+  auto m1 = under_test->Publish({MakeTestMessage(128)});
+  under_test.reset();
+  EXPECT_THAT(m1.get(), StatusIs(StatusCode::kCancelled));
+  publish.PopFront().set_value(make_status_or(std::string{"ack-m0"}));
+  EXPECT_THAT(m0.get(), IsOk());
+}
+
 auto constexpr kMessageSize = 1024;
 auto constexpr kExpectedMaxMessages = 4;
 auto constexpr kExpectedMaxBytes = kExpectedMaxMessages * kMessageSize;
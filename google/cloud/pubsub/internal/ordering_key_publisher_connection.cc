@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/ordering_key_publisher_connection.h"
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -25,16 +26,28 @@ future<StatusOr<std::string>> OrderingKeyPublisherConnection::Publish(
   return child->Publish(std::move(p));
 }
 
+void OrderingKeyPublisherConnection::PublishNoWait(PublishNoWaitParams p) {
+  auto child = GetChild(p.message.ordering_key());
+  child->PublishNoWait(std::move(p));
+}
+
 void OrderingKeyPublisherConnection::Flush(FlushParams p) {
   // Make a copy so we can iterate without holding a lock, that is important as
   // other threads may be interested in publishing events and/or adding new
   // ordering keys. Locking while performing many (potentially long) requests is
   // just not a good idea.
-  auto copy_children = [this] {
-    std::lock_guard<std::mutex> lk(mu_);
-    return children_;
+  auto copy_children = [](Shard& shard) {
+    std::vector<std::shared_ptr<PublisherConnection>> children;
+    std::lock_guard<std::mutex> lk(shard.mu);
+    children.reserve(shard.children.size());
+    for (auto const& kv : shard.children) {
+      children.push_back(kv.second.connection);
+    }
+    return children;
   };
-  for (auto const& kv : copy_children()) kv.second->Flush(p);
+  for (auto& shard : shards_) {
+    for (auto const& c : copy_children(shard)) c->Flush(p);
+  }
 }
 
 void OrderingKeyPublisherConnection::ResumePublish(ResumePublishParams p) {
@@ -42,13 +55,44 @@ void OrderingKeyPublisherConnection::ResumePublish(ResumePublishParams p) {
   child->ResumePublish(std::move(p));
 }
 
+std::size_t OrderingKeyPublisherConnection::KeyCount() {
+  std::size_t count = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    count += shard.children.size();
+  }
+  return count;
+}
+
 std::shared_ptr<pubsub::PublisherConnection>
 OrderingKeyPublisherConnection::GetChild(std::string const& ordering_key) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto i =
-      children_.emplace(ordering_key, std::shared_ptr<PublisherConnection>{});
-  if (i.second) i.first->second = factory_(ordering_key);
-  return i.first->second;
+  auto& shard = shards_[std::hash<std::string>{}(ordering_key) % kShardCount];
+  auto const now = Clock::now();
+  std::lock_guard<std::mutex> lk(shard.mu);
+  MaybeSweep(shard, now);
+  auto i = shard.children.emplace(ordering_key, Child{});
+  if (i.second) i.first->second.connection = factory_(ordering_key);
+  i.first->second.last_used = now;
+  return i.first->second.connection;
+}
+
+void OrderingKeyPublisherConnection::MaybeSweep(Shard& shard,
+                                                Clock::time_point now) {
+  if (!is_idle_ || idle_timeout_.count() == 0 || now < shard.next_sweep) {
+    return;
+  }
+  // Sweeping is linear on the number of keys, amortize the cost by sweeping
+  // at most twice per timeout.
+  shard.next_sweep = now + idle_timeout_ / 2;
+  for (auto i = shard.children.begin(); i != shard.children.end();) {
+    auto& child = i->second;
+    // A child returned by `GetChild()` may be in use by another thread, even
+    // if it is idle. The map holds the only copy of any unused child.
+    auto const evict = now - child.last_used >= idle_timeout_ &&
+                       child.connection.use_count() == 1 &&
+                       is_idle_(*child.connection);
+    i = evict ? shard.children.erase(i) : std::next(i);
+  }
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
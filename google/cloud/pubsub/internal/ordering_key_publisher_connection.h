@@ -17,43 +17,92 @@
 
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/version.h"
+#include <array>
+#include <chrono>
 #include <functional>
-#include <map>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * Routes each message to a child connection for its ordering key.
+ *
+ * Applications may use millions of distinct ordering keys, e.g., one per user.
+ * If @p is_idle is set, the children idle for longer than the idle timeout are
+ * discarded, a new child is created if the key is used again. A child is only
+ * discarded if @p is_idle returns true, i.e., if it holds no messages, batches
+ * or errors, and no other thread is using it.
+ *
+ * The children are kept in several hash maps, each with its own mutex, so
+ * publishers using many keys from many threads do not serialize on a single
+ * lock.
+ */
 class OrderingKeyPublisherConnection : public pubsub::PublisherConnection {
  public:
   using ConnectionFactory =
       std::function<std::shared_ptr<PublisherConnection>(std::string const&)>;
+  using IdlePredicate = std::function<bool(PublisherConnection&)>;
 
   static std::shared_ptr<OrderingKeyPublisherConnection> Create(
       ConnectionFactory factory) {
+    return Create(std::move(factory), IdlePredicate{},
+                  std::chrono::milliseconds(0));
+  }
+
+  static std::shared_ptr<OrderingKeyPublisherConnection> Create(
+      ConnectionFactory factory, IdlePredicate is_idle,
+      std::chrono::milliseconds idle_timeout) {
     return std::shared_ptr<OrderingKeyPublisherConnection>(
-        new OrderingKeyPublisherConnection(std::move(factory)));
+        new OrderingKeyPublisherConnection(
+            std::move(factory), std::move(is_idle), idle_timeout));
   }
 
   ~OrderingKeyPublisherConnection() override = default;
 
   future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void PublishNoWait(PublishNoWaitParams p) override;
   void Flush(FlushParams) override;
   void ResumePublish(ResumePublishParams p) override;
 
+  /// The number of ordering keys with a child connection.
+  std::size_t KeyCount();
+
  private:
-  explicit OrderingKeyPublisherConnection(ConnectionFactory factory)
-      : factory_(std::move(factory)) {}
+  using Clock = std::chrono::steady_clock;
+
+  OrderingKeyPublisherConnection(ConnectionFactory factory,
+                                 IdlePredicate is_idle,
+                                 std::chrono::milliseconds idle_timeout)
+      : factory_(std::move(factory)),
+        is_idle_(std::move(is_idle)),
+        idle_timeout_(idle_timeout) {}
+
+  struct Child {
+    std::shared_ptr<PublisherConnection> connection;
+    Clock::time_point last_used;
+  };
+
+  struct Shard {
+    std::mutex mu;
+    std::unordered_map<std::string, Child> children;
+    Clock::time_point next_sweep;
+  };
 
   std::shared_ptr<PublisherConnection> GetChild(
       std::string const& ordering_key);
+  void MaybeSweep(Shard& shard, Clock::time_point now);
+
+  static auto constexpr kShardCount = 16;
 
-  ConnectionFactory factory_;
-  std::mutex mu_;
-  std::map<std::string, std::shared_ptr<PublisherConnection>> children_;
+  ConnectionFactory const factory_;
+  IdlePredicate const is_idle_;
+  std::chrono::milliseconds const idle_timeout_;
+  std::array<Shard, kShardCount> shards_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -18,6 +18,8 @@
 #include "google/cloud/testing_util/status_matchers.h"
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
+#include <map>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -25,6 +27,10 @@ namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 namespace {
 
+using ::testing::AnyNumber;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
 TEST(OrderingKeyPublisherConnectionTest, Publish) {
   struct TestStep {
     std::string ordering_key;
@@ -75,6 +81,50 @@ TEST(OrderingKeyPublisherConnectionTest, Publish) {
   publisher->Flush({});
 }
 
+TEST(OrderingKeyPublisherConnectionTest, EvictsIdleKeys) {
+  std::map<std::string, int> created;
+  std::map<pubsub::PublisherConnection*, std::string> keys;
+  auto factory = [&](std::string const& ordering_key) {
+    ++created[ordering_key];
+    auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    EXPECT_CALL(*mock, ResumePublish).Times(AnyNumber());
+    keys[mock.get()] = ordering_key;
+    return mock;
+  };
+  // Only "k0" is ever idle.
+  auto is_idle = [&](pubsub::PublisherConnection& c) {
+    return keys[&c] == "k0";
+  };
+  auto publisher = OrderingKeyPublisherConnection::Create(
+      factory, is_idle, std::chrono::milliseconds(1));
+
+  publisher->ResumePublish({"k0"});
+  publisher->ResumePublish({"k1"});
+  EXPECT_EQ(2, publisher->KeyCount());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  publisher->ResumePublish({"k1"});
+  publisher->ResumePublish({"k0"});
+  EXPECT_THAT(created, ElementsAre(Pair("k0", 2), Pair("k1", 1)));
+  EXPECT_EQ(2, publisher->KeyCount());
+}
+
+TEST(OrderingKeyPublisherConnectionTest, NoEvictionWithoutTimeout) {
+  int created = 0;
+  auto factory = [&](std::string const&) {
+    ++created;
+    auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    EXPECT_CALL(*mock, ResumePublish).Times(AnyNumber());
+    return mock;
+  };
+  auto publisher = OrderingKeyPublisherConnection::Create(factory);
+  publisher->ResumePublish({"k0"});
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  publisher->ResumePublish({"k0"});
+  EXPECT_EQ(1, created);
+  EXPECT_EQ(1, publisher->KeyCount());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
@@ -0,0 +1,114 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/parallel_subscription_batch_source.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+void ParallelSubscriptionBatchSource::Start(BatchCallback cb) {
+  auto weak =
+      std::weak_ptr<ParallelSubscriptionBatchSource>(shared_from_this());
+  for (std::size_t i = 0; i != children_.size(); ++i) {
+    children_[i]->Start(
+        [weak, cb, i](StatusOr<google::pubsub::v1::StreamingPullResponse> r) {
+          if (auto self = weak.lock()) self->OnRead(i, r);
+          cb(std::move(r));
+        });
+  }
+}
+
+void ParallelSubscriptionBatchSource::Shutdown() {
+  for (auto& c : children_) c->Shutdown();
+}
+
+void ParallelSubscriptionBatchSource::AckMessage(std::string const& ack_id) {
+  children_[Release(ack_id)]->AckMessage(ack_id);
+}
+
+void ParallelSubscriptionBatchSource::NackMessage(std::string const& ack_id) {
+  children_[Release(ack_id)]->NackMessage(ack_id);
+}
+
+void ParallelSubscriptionBatchSource::BulkAck(
+    std::vector<std::string> ack_ids) {
+  auto split = Release(std::move(ack_ids));
+  for (std::size_t i = 0; i != split.size(); ++i) {
+    if (!split[i].empty()) children_[i]->BulkAck(std::move(split[i]));
+  }
+}
+
+void ParallelSubscriptionBatchSource::BulkNack(
+    std::vector<std::string> ack_ids) {
+  auto split = Release(std::move(ack_ids));
+  for (std::size_t i = 0; i != split.size(); ++i) {
+    if (!split[i].empty()) children_[i]->BulkNack(std::move(split[i]));
+  }
+}
+
+void ParallelSubscriptionBatchSource::ExtendLeases(
+    std::vector<std::string> ack_ids, std::chrono::seconds extension) {
+  std::vector<std::vector<std::string>> split(children_.size());
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto& a : ack_ids) {
+    auto const l = owners_.find(a);
+    split[l == owners_.end() ? 0 : l->second].push_back(std::move(a));
+  }
+  lk.unlock();
+  for (std::size_t i = 0; i != split.size(); ++i) {
+    if (split[i].empty()) continue;
+    children_[i]->ExtendLeases(std::move(split[i]), extension);
+  }
+}
+
+void ParallelSubscriptionBatchSource::OnRead(
+    std::size_t child,
+    StatusOr<google::pubsub::v1::StreamingPullResponse> const& r) {
+  if (!r) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto const& m : r->received_messages()) owners_[m.ack_id()] = child;
+}
+
+std::size_t ParallelSubscriptionBatchSource::Release(
+    std::string const& ack_id) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const l = owners_.find(ack_id);
+  if (l == owners_.end()) return 0;
+  auto const child = l->second;
+  owners_.erase(l);
+  return child;
+}
+
+std::vector<std::vector<std::string>> ParallelSubscriptionBatchSource::Release(
+    std::vector<std::string> ack_ids) {
+  std::vector<std::vector<std::string>> split(children_.size());
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto& a : ack_ids) {
+    auto const l = owners_.find(a);
+    if (l == owners_.end()) {
+      split[0].push_back(std::move(a));
+      continue;
+    }
+    split[l->second].push_back(std::move(a));
+    owners_.erase(l);
+  }
+  return split;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,87 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_PARALLEL_SUBSCRIPTION_BATCH_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_PARALLEL_SUBSCRIPTION_BATCH_SOURCE_H
+
+#include "google/cloud/pubsub/internal/subscription_batch_source.h"
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/internal/absl_flat_hash_map_quiet.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Combines several batch sources, typically one per `StreamingPull` stream.
+ *
+ * Each child delivers its messages to the same callback. Lease extensions are
+ * sent back to the child that received the message, as they are written to
+ * the stream that received it. Acks and nacks are unary RPCs that would work
+ * through any child, but sending them to the same child keeps the load
+ * balanced.
+ */
+class ParallelSubscriptionBatchSource
+    : public SubscriptionBatchSource,
+      public std::enable_shared_from_this<ParallelSubscriptionBatchSource> {
+ public:
+  static std::shared_ptr<ParallelSubscriptionBatchSource> Create(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>> children) {
+    return std::shared_ptr<ParallelSubscriptionBatchSource>(
+        new ParallelSubscriptionBatchSource(std::move(children)));
+  }
+
+  void Start(BatchCallback cb) override;
+  void Shutdown() override;
+  void AckMessage(std::string const& ack_id) override;
+  void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
+  void BulkNack(std::vector<std::string> ack_ids) override;
+  void ExtendLeases(std::vector<std::string> ack_ids,
+                    std::chrono::seconds extension) override;
+
+ private:
+  explicit ParallelSubscriptionBatchSource(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>> children)
+      : children_(std::move(children)) {}
+
+  void OnRead(std::size_t child,
+              StatusOr<google::pubsub::v1::StreamingPullResponse> const& r);
+
+  /// Returns the child that received @p ack_id and forgets about it.
+  std::size_t Release(std::string const& ack_id);
+
+  /// Splits @p ack_ids by the child that received them and forgets about them.
+  std::vector<std::vector<std::string>> Release(
+      std::vector<std::string> ack_ids);
+
+  std::vector<std::shared_ptr<SubscriptionBatchSource>> const children_;
+
+  std::mutex mu_;
+  // The child that received each outstanding message.
+  absl::flat_hash_map<std::string, std::size_t> owners_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_PARALLEL_SUBSCRIPTION_BATCH_SOURCE_H
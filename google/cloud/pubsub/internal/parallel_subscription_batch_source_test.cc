@@ -0,0 +1,145 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/parallel_subscription_batch_source.h"
+#include "google/cloud/pubsub/testing/mock_subscription_batch_source.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+google::pubsub::v1::StreamingPullResponse GenerateMessages(
+    std::string const& prefix, int count) {
+  google::pubsub::v1::StreamingPullResponse response;
+  for (int i = 0; i != count; ++i) {
+    auto const id = prefix + std::to_string(i);
+    auto& m = *response.add_received_messages();
+    m.set_ack_id("ack-" + id);
+    m.mutable_message()->set_message_id("message-" + id);
+  }
+  return response;
+}
+
+struct MockChild {
+  std::shared_ptr<pubsub_testing::MockSubscriptionBatchSource> mock =
+      std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback callback;
+};
+
+std::shared_ptr<ParallelSubscriptionBatchSource> MakeTestSource(
+    std::vector<MockChild>& children) {
+  std::vector<std::shared_ptr<SubscriptionBatchSource>> mocks;
+  for (auto& c : children) {
+    auto* child = &c;
+    EXPECT_CALL(*c.mock, Start).WillOnce([child](BatchCallback cb) {
+      child->callback = std::move(cb);
+    });
+    mocks.push_back(c.mock);
+  }
+  return ParallelSubscriptionBatchSource::Create(std::move(mocks));
+}
+
+TEST(ParallelSubscriptionBatchSourceTest, StartAndShutdown) {
+  std::vector<MockChild> children(3);
+  auto tested = MakeTestSource(children);
+  for (auto& c : children) EXPECT_CALL(*c.mock, Shutdown).Times(1);
+
+  std::vector<std::string> received;
+  tested->Start(
+      [&](StatusOr<google::pubsub::v1::StreamingPullResponse> const& r) {
+        ASSERT_STATUS_OK(r);
+        for (auto const& m : r->received_messages()) {
+          received.push_back(m.ack_id());
+        }
+      });
+  children[2].callback(GenerateMessages("2-", 1));
+  children[0].callback(GenerateMessages("0-", 2));
+  EXPECT_THAT(received, ElementsAre("ack-2-0", "ack-0-0", "ack-0-1"));
+  tested->Shutdown();
+}
+
+TEST(ParallelSubscriptionBatchSourceTest, RoutesToReceivingChild) {
+  std::vector<MockChild> children(2);
+  auto tested = MakeTestSource(children);
+  EXPECT_CALL(*children[0].mock, AckMessage("ack-0-0"));
+  EXPECT_CALL(*children[1].mock, NackMessage("ack-1-0"));
+  EXPECT_CALL(*children[0].mock, ExtendLeases)
+      .WillOnce([](std::vector<std::string> const& ack_ids,
+                   std::chrono::seconds extension) {
+        EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-0-1", "ack-0-2"));
+        EXPECT_EQ(std::chrono::seconds(10), extension);
+      });
+  EXPECT_CALL(*children[1].mock, ExtendLeases)
+      .WillOnce([](std::vector<std::string> const& ack_ids,
+                   std::chrono::seconds) {
+        EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-1-1"));
+      });
+  EXPECT_CALL(*children[0].mock, BulkNack)
+      .WillOnce([](std::vector<std::string> const& ack_ids) {
+        EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-0-1", "ack-0-2"));
+      });
+  EXPECT_CALL(*children[1].mock, BulkNack)
+      .WillOnce([](std::vector<std::string> const& ack_ids) {
+        EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-1-1"));
+      });
+
+  tested->Start(
+      [](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  children[0].callback(GenerateMessages("0-", 3));
+  children[1].callback(GenerateMessages("1-", 2));
+
+  tested->AckMessage("ack-0-0");
+  tested->NackMessage("ack-1-0");
+  tested->ExtendLeases({"ack-0-1", "ack-1-1", "ack-0-2"},
+                       std::chrono::seconds(10));
+  tested->BulkNack({"ack-0-1", "ack-1-1", "ack-0-2"});
+}
+
+TEST(ParallelSubscriptionBatchSourceTest, BulkAck) {
+  std::vector<MockChild> children(2);
+  auto tested = MakeTestSource(children);
+  EXPECT_CALL(*children[0].mock, BulkAck(ElementsAre("ack-0-0", "ack-0-1")));
+  EXPECT_CALL(*children[1].mock, BulkAck(ElementsAre("ack-1-0")));
+
+  tested->Start(
+      [](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  children[0].callback(GenerateMessages("0-", 2));
+  children[1].callback(GenerateMessages("1-", 1));
+  tested->BulkAck({"ack-0-0", "ack-1-0", "ack-0-1"});
+}
+
+TEST(ParallelSubscriptionBatchSourceTest, UnknownAckIdsUseFirstChild) {
+  std::vector<MockChild> children(2);
+  auto tested = MakeTestSource(children);
+  EXPECT_CALL(*children[0].mock, AckMessage("ack-unknown"));
+
+  tested->Start(
+      [](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  children[1].callback(Status(StatusCode::kUnavailable, "try-again"));
+  tested->AckMessage("ack-unknown");
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,139 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/pull_subscription_batch_source.h"
+#include "absl/memory/memory.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+class PullAckHandlerImpl : public pubsub::BatchAckHandler::Impl {
+ public:
+  PullAckHandlerImpl(std::weak_ptr<SubscriptionBatchSource> w,
+                     std::vector<std::string> ack_ids)
+      : source_(std::move(w)), ack_ids_(std::move(ack_ids)) {}
+  ~PullAckHandlerImpl() override = default;
+
+  void ack() override {
+    if (auto s = source_.lock()) s->BulkAck(std::move(ack_ids_));
+  }
+  void nack() override {
+    if (auto s = source_.lock()) s->BulkNack(std::move(ack_ids_));
+  }
+  std::size_t size() const override { return ack_ids_.size(); }
+
+ private:
+  std::weak_ptr<SubscriptionBatchSource> source_;
+  std::vector<std::string> ack_ids_;
+};
+
+}  // namespace
+
+void PullSubscriptionBatchSource::Start(BatchCallback cb) {
+  std::lock_guard<std::mutex> lk(mu_);
+  callback_ = std::move(cb);
+}
+
+void PullSubscriptionBatchSource::AckMessage(std::string const& ack_id) {
+  BulkAck({ack_id});
+}
+
+void PullSubscriptionBatchSource::NackMessage(std::string const& ack_id) {
+  BulkNack({ack_id});
+}
+
+void PullSubscriptionBatchSource::BulkAck(std::vector<std::string> ack_ids) {
+  if (ack_ids.empty()) return;
+  google::pubsub::v1::AcknowledgeRequest request;
+  request.set_subscription(subscription_full_name_);
+  for (auto& a : ack_ids) request.add_ack_ids(std::move(a));
+  (void)stub_->AsyncAcknowledge(cq_, absl::make_unique<grpc::ClientContext>(),
+                                request);
+}
+
+void PullSubscriptionBatchSource::BulkNack(std::vector<std::string> ack_ids) {
+  ModifyAckDeadline(std::move(ack_ids), std::chrono::seconds(0));
+}
+
+void PullSubscriptionBatchSource::ExtendLeases(
+    std::vector<std::string> ack_ids, std::chrono::seconds extension) {
+  ModifyAckDeadline(std::move(ack_ids), extension);
+}
+
+future<StatusOr<google::pubsub::v1::PullResponse>>
+PullSubscriptionBatchSource::Pull(std::int32_t max_messages) {
+  google::pubsub::v1::PullRequest request;
+  request.set_subscription(subscription_full_name_);
+  request.set_max_messages(max_messages);
+  auto self = shared_from_this();
+  return stub_
+      ->AsyncPull(cq_, absl::make_unique<grpc::ClientContext>(), request)
+      .then([self](future<StatusOr<google::pubsub::v1::PullResponse>> f) {
+        auto response = f.get();
+        if (response) self->OnPull(*response);
+        return response;
+      });
+}
+
+void PullSubscriptionBatchSource::OnPull(
+    google::pubsub::v1::PullResponse const& response) {
+  if (response.received_messages().empty()) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  auto cb = callback_;
+  lk.unlock();
+  if (!cb) return;
+  // Only the ack ids are needed to track the leases, do not copy the messages.
+  google::pubsub::v1::StreamingPullResponse leases;
+  for (auto const& rm : response.received_messages()) {
+    leases.add_received_messages()->set_ack_id(rm.ack_id());
+  }
+  cb(std::move(leases));
+}
+
+void PullSubscriptionBatchSource::ModifyAckDeadline(
+    std::vector<std::string> ack_ids, std::chrono::seconds deadline) {
+  if (ack_ids.empty()) return;
+  google::pubsub::v1::ModifyAckDeadlineRequest request;
+  request.set_subscription(subscription_full_name_);
+  for (auto& a : ack_ids) request.add_ack_ids(std::move(a));
+  request.set_ack_deadline_seconds(static_cast<std::int32_t>(deadline.count()));
+  (void)stub_->AsyncModifyAckDeadline(
+      cq_, absl::make_unique<grpc::ClientContext>(), request);
+}
+
+pubsub::PullResult MakePullResult(
+    std::weak_ptr<SubscriptionBatchSource> source,
+    google::pubsub::v1::PullResponse response) {
+  std::vector<pubsub::Message> messages;
+  std::vector<std::string> ack_ids;
+  messages.reserve(response.received_messages_size());
+  ack_ids.reserve(response.received_messages_size());
+  for (auto& rm : *response.mutable_received_messages()) {
+    ack_ids.push_back(std::move(*rm.mutable_ack_id()));
+    messages.push_back(FromProto(std::move(*rm.mutable_message())));
+  }
+  return pubsub::PullResult{
+      std::move(messages),
+      pubsub::BatchAckHandler(absl::make_unique<PullAckHandlerImpl>(
+          std::move(source), std::move(ack_ids)))};
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,101 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_PULL_SUBSCRIPTION_BATCH_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_PULL_SUBSCRIPTION_BATCH_SOURCE_H
+
+#include "google/cloud/pubsub/internal/subscriber_stub.h"
+#include "google/cloud/pubsub/internal/subscription_batch_source.h"
+#include "google/cloud/pubsub/pull_result.h"
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <google/pubsub/v1/pubsub.pb.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * A `SubscriptionBatchSource` based on (unary) `Pull()` requests.
+ *
+ * Unlike the streaming source, this source does not fetch messages on its own.
+ * Each call to `Pull()` makes a single request, and reports the ack ids of any
+ * messages received to the callback set in `Start()` before returning them.
+ * Typically that callback is the lease management layer, which then extends
+ * the leases until the messages are acked or nacked.
+ *
+ * Acks, nacks, and lease extensions are sent as unary requests, one per call.
+ */
+class PullSubscriptionBatchSource
+    : public SubscriptionBatchSource,
+      public std::enable_shared_from_this<PullSubscriptionBatchSource> {
+ public:
+  PullSubscriptionBatchSource(google::cloud::CompletionQueue cq,
+                              std::shared_ptr<SubscriberStub> stub,
+                              std::string subscription_full_name)
+      : cq_(std::move(cq)),
+        stub_(std::move(stub)),
+        subscription_full_name_(std::move(subscription_full_name)) {}
+
+  void Start(BatchCallback cb) override;
+  void Shutdown() override {}
+  void AckMessage(std::string const& ack_id) override;
+  void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
+  void BulkNack(std::vector<std::string> ack_ids) override;
+  void ExtendLeases(std::vector<std::string> ack_ids,
+                    std::chrono::seconds extension) override;
+
+  /// Pull at most @p max_messages messages.
+  future<StatusOr<google::pubsub::v1::PullResponse>> Pull(
+      std::int32_t max_messages);
+
+ private:
+  void OnPull(google::pubsub::v1::PullResponse const& response);
+  void ModifyAckDeadline(std::vector<std::string> ack_ids,
+                         std::chrono::seconds deadline);
+
+  google::cloud::CompletionQueue cq_;
+  std::shared_ptr<SubscriberStub> const stub_;
+  std::string const subscription_full_name_;
+
+  std::mutex mu_;
+  BatchCallback callback_;
+};
+
+/**
+ * Converts @p response into a `pubsub::PullResult`.
+ *
+ * The handler in the result acks or nacks the messages using @p source.
+ */
+pubsub::PullResult MakePullResult(
+    std::weak_ptr<SubscriptionBatchSource> source,
+    google::pubsub::v1::PullResponse response);
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_PULL_SUBSCRIPTION_BATCH_SOURCE_H
@@ -0,0 +1,150 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/pull_subscription_batch_source.h"
+#include "google/cloud/pubsub/subscription.h"
+#include "google/cloud/pubsub/testing/mock_subscriber_stub.h"
+#include "google/cloud/pubsub/testing/mock_subscription_batch_source.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Property;
+
+using AckRequest = ::google::pubsub::v1::AcknowledgeRequest;
+using ModifyRequest = ::google::pubsub::v1::ModifyAckDeadlineRequest;
+using PullRequest = ::google::pubsub::v1::PullRequest;
+using PullResponse = ::google::pubsub::v1::PullResponse;
+
+std::string const kSubscription =
+    pubsub::Subscription("test-project", "test-subscription").FullName();
+
+PullResponse MakeResponse(int count) {
+  PullResponse response;
+  for (int i = 0; i != count; ++i) {
+    auto& m = *response.add_received_messages();
+    m.set_ack_id("ack-" + std::to_string(i));
+    m.mutable_message()->set_message_id("id-" + std::to_string(i));
+    m.mutable_message()->set_data("data-" + std::to_string(i));
+  }
+  return response;
+}
+
+TEST(PullSubscriptionBatchSourceTest, Pull) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  EXPECT_CALL(*mock, AsyncPull)
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   PullRequest const& request) {
+        EXPECT_EQ(kSubscription, request.subscription());
+        EXPECT_EQ(3, request.max_messages());
+        return make_ready_future(make_status_or(MakeResponse(2)));
+      })
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>, PullRequest const&) {
+        return make_ready_future(StatusOr<PullResponse>(
+            Status(StatusCode::kPermissionDenied, "uh-oh")));
+      });
+
+  google::cloud::CompletionQueue cq;
+  auto source =
+      std::make_shared<PullSubscriptionBatchSource>(cq, mock, kSubscription);
+  std::vector<std::string> leases;
+  source->Start(
+      [&](StatusOr<google::pubsub::v1::StreamingPullResponse> const& r) {
+        ASSERT_STATUS_OK(r);
+        for (auto const& m : r->received_messages()) {
+          // Only the ack ids are reported.
+          EXPECT_FALSE(m.has_message());
+          leases.push_back(m.ack_id());
+        }
+      });
+
+  auto response = source->Pull(3).get();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(2, response->received_messages_size());
+  EXPECT_THAT(leases, ElementsAre("ack-0", "ack-1"));
+
+  // Errors are returned to the caller, and not reported to the callback.
+  EXPECT_THAT(source->Pull(3).get(), StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_THAT(leases, ElementsAre("ack-0", "ack-1"));
+}
+
+TEST(PullSubscriptionBatchSourceTest, AckNackAndExtend) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  EXPECT_CALL(*mock, AsyncAcknowledge)
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   AckRequest const& request) {
+        EXPECT_EQ(kSubscription, request.subscription());
+        EXPECT_THAT(request.ack_ids(), ElementsAre("a0", "a1"));
+        return make_ready_future(Status{});
+      });
+  EXPECT_CALL(*mock, AsyncModifyAckDeadline)
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   ModifyRequest const& request) {
+        EXPECT_EQ(kSubscription, request.subscription());
+        EXPECT_THAT(request.ack_ids(), ElementsAre("n0"));
+        EXPECT_EQ(0, request.ack_deadline_seconds());
+        return make_ready_future(Status{});
+      })
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   ModifyRequest const& request) {
+        EXPECT_THAT(request.ack_ids(), ElementsAre("e0", "e1"));
+        EXPECT_EQ(30, request.ack_deadline_seconds());
+        return make_ready_future(Status{});
+      });
+
+  google::cloud::CompletionQueue cq;
+  auto source =
+      std::make_shared<PullSubscriptionBatchSource>(cq, mock, kSubscription);
+  source->BulkAck({"a0", "a1"});
+  source->NackMessage("n0");
+  source->ExtendLeases({"e0", "e1"}, std::chrono::seconds(30));
+  // Empty requests are not sent.
+  source->BulkAck({});
+  source->BulkNack({});
+}
+
+TEST(PullSubscriptionBatchSourceTest, MakePullResult) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  EXPECT_CALL(*mock, BulkAck(ElementsAre("ack-0", "ack-1")));
+  EXPECT_CALL(*mock, BulkNack(ElementsAre("ack-0")));
+
+  auto result = MakePullResult(mock, MakeResponse(2));
+  EXPECT_EQ(2, result.handler.size());
+  EXPECT_THAT(result.messages,
+              ElementsAre(Property(&pubsub::Message::message_id, "id-0"),
+                          Property(&pubsub::Message::message_id, "id-1")));
+  std::move(result.handler).ack();
+
+  // Handlers destroyed without an ack or nack reject the messages.
+  { auto unused = MakePullResult(mock, MakeResponse(1)); }
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
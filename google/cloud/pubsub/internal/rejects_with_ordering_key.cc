@@ -18,18 +18,31 @@ namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+Status OrderingKeyError() {
+  return Status(StatusCode::kInvalidArgument,
+                "Attempted to publish a message with an ordering"
+                " key with a publisher that does not have message"
+                " ordering enabled.");
+}
+}  // namespace
 
 future<StatusOr<std::string>> RejectsWithOrderingKey::Publish(PublishParams p) {
   if (!p.message.ordering_key().empty()) {
-    return google::cloud::make_ready_future(StatusOr<std::string>(
-        Status(StatusCode::kInvalidArgument,
-               "Attempted to publish a message with an ordering"
-               " key with a publisher that does not have message"
-               " ordering enabled.")));
+    return google::cloud::make_ready_future(
+        StatusOr<std::string>(OrderingKeyError()));
   }
   return connection_->Publish(std::move(p));
 }
 
+void RejectsWithOrderingKey::PublishNoWait(PublishNoWaitParams p) {
+  if (!p.message.ordering_key().empty()) {
+    if (on_reject_) on_reject_(OrderingKeyError(), 1);
+    return;
+  }
+  connection_->PublishNoWait(std::move(p));
+}
+
 void RejectsWithOrderingKey::Flush(FlushParams p) {
   return connection_->Flush(p);
 }
@@ -27,23 +27,28 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 class RejectsWithOrderingKey : public pubsub::PublisherConnection {
  public:
   static std::shared_ptr<RejectsWithOrderingKey> Create(
-      std::shared_ptr<pubsub::PublisherConnection> connection) {
-    return std::shared_ptr<RejectsWithOrderingKey>(
-        new RejectsWithOrderingKey(std::move(connection)));
+      std::shared_ptr<pubsub::PublisherConnection> connection,
+      pubsub::PublisherOptions::BatchResultCallback on_reject = {}) {
+    return std::shared_ptr<RejectsWithOrderingKey>(new RejectsWithOrderingKey(
+        std::move(connection), std::move(on_reject)));
   }
 
   ~RejectsWithOrderingKey() override = default;
 
   future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void PublishNoWait(PublishNoWaitParams p) override;
   void Flush(FlushParams) override;
   void ResumePublish(ResumePublishParams p) override;
 
  private:
-  explicit RejectsWithOrderingKey(
-      std::shared_ptr<PublisherConnection> connection)
-      : connection_(std::move(connection)) {}
+  RejectsWithOrderingKey(
+      std::shared_ptr<PublisherConnection> connection,
+      pubsub::PublisherOptions::BatchResultCallback on_reject)
+      : connection_(std::move(connection)), on_reject_(std::move(on_reject)) {}
 
   std::shared_ptr<PublisherConnection> connection_;
+  // Reports the `PublishNoWait()` messages rejected by this class.
+  pubsub::PublisherOptions::BatchResultCallback on_reject_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
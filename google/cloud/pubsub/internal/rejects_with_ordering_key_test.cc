@@ -16,6 +16,7 @@
 #include "google/cloud/pubsub/mocks/mock_publisher_connection.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -24,6 +25,7 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 namespace {
 
 using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
 
 TEST(RejectsWithOrderingKeyTest, MessageRejected) {
   auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
@@ -58,6 +60,28 @@ TEST(RejectsWithOrderingKeyTest, MessageAccepted) {
   EXPECT_EQ("test-id", *response);
 }
 
+TEST(RejectsWithOrderingKeyTest, PublishNoWait) {
+  auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+  EXPECT_CALL(*mock, PublishNoWait)
+      .WillOnce([](pubsub::PublisherConnection::PublishNoWaitParams const& p) {
+        EXPECT_EQ("test-data-0", p.message.data());
+      });
+
+  std::vector<Status> rejected;
+  auto publisher = RejectsWithOrderingKey::Create(
+      mock, [&rejected](Status const& status, std::size_t message_count) {
+        EXPECT_EQ(1, message_count);
+        rejected.push_back(status);
+      });
+  publisher->PublishNoWait(
+      {pubsub::MessageBuilder{}.SetData("test-data-0").Build()});
+  publisher->PublishNoWait({pubsub::MessageBuilder{}
+                                .SetData("test-data-1")
+                                .SetOrderingKey("test-ordering-key-0")
+                                .Build()});
+  EXPECT_THAT(rejected, ElementsAre(StatusIs(StatusCode::kInvalidArgument)));
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
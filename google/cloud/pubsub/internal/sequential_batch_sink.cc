@@ -14,6 +14,8 @@
 
 #include "google/cloud/pubsub/internal/sequential_batch_sink.h"
 #include "google/cloud/internal/async_retry_loop.h"
+#include <algorithm>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -21,8 +23,8 @@ namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
 SequentialBatchSink::SequentialBatchSink(
-    std::shared_ptr<pubsub_internal::BatchSink> sink)
-    : sink_(std::move(sink)) {}
+    std::shared_ptr<pubsub_internal::BatchSink> sink, std::size_t max_in_flight)
+    : sink_(std::move(sink)), max_in_flight_((std::max)(max_in_flight, std::size_t{1})) {}
 
 future<StatusOr<google::pubsub::v1::PublishResponse>>
 SequentialBatchSink::AsyncPublish(google::pubsub::v1::PublishRequest request) {
@@ -30,21 +32,10 @@ SequentialBatchSink::AsyncPublish(google::pubsub::v1::PublishRequest request) {
   if (!corked_on_error_.ok()) {
     return make_ready_future(StatusOr<PublishResponse>(corked_on_error_));
   }
-  if (corked_on_pending_) {
-    queue_.push_back({std::move(request), {}});
-    return queue_.back().promise.get_future();
-  }
-  corked_on_pending_ = true;
-  lk.unlock();
-
-  auto weak = WeakFromThis();
-  return sink_->AsyncPublish(std::move(request))
-      .then([weak](future<StatusOr<PublishResponse>> f) {
-        auto r = f.get();
-        auto status = r ? Status{} : r.status();
-        if (auto self = weak.lock()) self->OnPublish(std::move(status));
-        return r;
-      });
+  queue_.push_back({std::move(request), {}});
+  auto f = queue_.back().promise.get_future();
+  Drain(std::move(lk));
+  return f;
 }
 
 void SequentialBatchSink::ResumePublish(std::string const& ordering_key) {
@@ -55,45 +46,55 @@ void SequentialBatchSink::ResumePublish(std::string const& ordering_key) {
   sink_->ResumePublish(ordering_key);
 }
 
-void SequentialBatchSink::OnPublish(Status s) {
+void SequentialBatchSink::Drain(std::unique_lock<std::mutex> lk) {
+  while (corked_on_error_.ok() && !queue_.empty() &&
+         in_flight_.size() < max_in_flight_) {
+    auto pr = std::move(queue_.front());
+    queue_.pop_front();
+    in_flight_.push_back({std::move(pr.promise), {}});
+    auto const id = first_in_flight_id_ + in_flight_.size() - 1;
+    lk.unlock();
+
+    // Capture a strong reference, the promises for the in-flight requests are
+    // owned by this object and must be satisfied.
+    auto self = shared_from_this();
+    sink_->AsyncPublish(std::move(pr.request))
+        .then([self, id](future<StatusOr<PublishResponse>> f) {
+          self->OnPublish(id, f.get());
+        });
+    lk.lock();
+  }
+}
+
+void SequentialBatchSink::OnPublish(std::uint64_t id,
+                                    StatusOr<PublishResponse> response) {
   std::unique_lock<std::mutex> lk(mu_);
-  corked_on_pending_ = false;
-  corked_on_error_ = std::move(s);
+  in_flight_[static_cast<std::size_t>(id - first_in_flight_id_)].response =
+      std::move(response);
 
-  // If the last result is an error drain the queue with that status, note that
-  // no new elements will be added to the queue until ResumePublish() is called
-  // by the application, as AsyncPublish() rejects messages.
-  if (!corked_on_error_.ok()) {
-    std::deque<PendingRequest> queue;
-    queue.swap(queue_);
-    auto error = corked_on_error_;
-    lk.unlock();
-    for (auto& p : queue) {
-      p.promise.set_value(error);
-    }
-    return;
+  // Return the results in order, a response may complete before the responses
+  // for earlier requests.
+  std::vector<InFlightRequest> done;
+  while (!in_flight_.empty() && in_flight_.front().response.has_value()) {
+    auto const& r = *in_flight_.front().response;
+    if (!r && corked_on_error_.ok()) corked_on_error_ = r.status();
+    done.push_back(std::move(in_flight_.front()));
+    in_flight_.pop_front();
+    ++first_in_flight_id_;
   }
 
-  // If necessary, schedule the next call.
-  if (queue_.empty()) return;
-  corked_on_pending_ = true;
-  auto pr = std::move(queue_.front());
-  queue_.pop_front();
+  // If there was an error drain the queue with that status, note that no new
+  // elements will be added to the queue until ResumePublish() is called by the
+  // application, as AsyncPublish() rejects messages.
+  std::deque<PendingRequest> rejected;
+  if (!corked_on_error_.ok()) rejected.swap(queue_);
+  auto error = corked_on_error_;
   lk.unlock();
+  for (auto& d : done) d.promise.set_value(*std::move(d.response));
+  for (auto& p : rejected) p.promise.set_value(error);
 
-  auto weak = WeakFromThis();
-  struct MoveCaptureRequest {
-    std::weak_ptr<SequentialBatchSink> weak;
-    google::cloud::promise<StatusOr<PublishResponse>> promise;
-    void operator()(future<StatusOr<PublishResponse>> f) {
-      auto response = f.get();
-      auto status = response ? Status{} : response.status();
-      promise.set_value(std::move(response));
-      if (auto self = weak.lock()) self->OnPublish(std::move(status));
-    }
-  };
-  sink_->AsyncPublish(std::move(pr.request))
-      .then(MoveCaptureRequest{WeakFromThis(), std::move(pr.promise)});
+  // If necessary, schedule the next calls.
+  Drain(std::unique_lock<std::mutex>(mu_));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
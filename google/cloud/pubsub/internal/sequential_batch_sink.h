@@ -17,6 +17,8 @@
 
 #include "google/cloud/pubsub/internal/batch_sink.h"
 #include "google/cloud/pubsub/version.h"
+#include "absl/types/optional.h"
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -27,15 +29,23 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
-/// Publish message batches using a stub, with retries, but no queueing.
+/**
+ * Publish message batches using a stub, with retries, but no queueing.
+ *
+ * At most `max_in_flight` batches are sent to the service at a time, the
+ * remaining batches are queued. The results are returned in the same order as
+ * the batches. If a batch fails, all the queued batches fail with the same
+ * error, and new batches are rejected until `ResumePublish()` is called.
+ */
 class SequentialBatchSink
     : public BatchSink,
       public std::enable_shared_from_this<SequentialBatchSink> {
  public:
   static std::shared_ptr<SequentialBatchSink> Create(
-      std::shared_ptr<pubsub_internal::BatchSink> sink) {
+      std::shared_ptr<pubsub_internal::BatchSink> sink,
+      std::size_t max_in_flight = 1) {
     return std::shared_ptr<SequentialBatchSink>(
-        new SequentialBatchSink(std::move(sink)));
+        new SequentialBatchSink(std::move(sink), max_in_flight));
   }
 
   ~SequentialBatchSink() override = default;
@@ -49,28 +59,39 @@ class SequentialBatchSink
     std::lock_guard<std::mutex> lk(mu_);
     return queue_.size();
   }
+  std::size_t InFlight() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return in_flight_.size();
+  }
 
  private:
-  explicit SequentialBatchSink(
-      std::shared_ptr<pubsub_internal::BatchSink> sink);
+  SequentialBatchSink(std::shared_ptr<pubsub_internal::BatchSink> sink,
+                      std::size_t max_in_flight);
 
   using PublishResponse = google::pubsub::v1::PublishResponse;
   using PublishRequest = google::pubsub::v1::PublishRequest;
 
-  void OnPublish(Status s);
-  std::weak_ptr<SequentialBatchSink> WeakFromThis() {
-    return shared_from_this();
-  }
-
   struct PendingRequest {
     PublishRequest request;
     google::cloud::promise<StatusOr<PublishResponse>> promise;
   };
 
+  struct InFlightRequest {
+    google::cloud::promise<StatusOr<PublishResponse>> promise;
+    absl::optional<StatusOr<PublishResponse>> response;
+  };
+
+  void Drain(std::unique_lock<std::mutex> lk);
+  void OnPublish(std::uint64_t id, StatusOr<PublishResponse> response);
   std::shared_ptr<pubsub_internal::BatchSink> const sink_;
+  std::size_t const max_in_flight_;
   std::mutex mu_;
   std::deque<PendingRequest> queue_;
-  bool corked_on_pending_ = false;
+  // The requests sent to `sink_`, in the order they were sent. The results are
+  // returned in this order too, even if the responses arrive out of order.
+  std::deque<InFlightRequest> in_flight_;
+  // The id of `in_flight_.front()`, ids increase by one for each request sent.
+  std::uint64_t first_in_flight_id_ = 0;
   Status corked_on_error_;
 };
 
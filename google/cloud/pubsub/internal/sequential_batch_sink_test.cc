@@ -20,6 +20,7 @@
 #include "google/cloud/testing_util/is_proto_equal.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
@@ -175,6 +176,84 @@ TEST(DefaultBatchSinkTest, BasicErrorHandling) {
   EXPECT_THAT(*r5, IsProtoEqual(MakeResponse(MakeRequest(2))));
 }
 
+TEST(DefaultBatchSinkTest, PipelinedNoErrors) {
+  AsyncSequencer<void> sequencer;
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  EXPECT_CALL(*mock, AsyncPublish)
+      .Times(3)
+      .WillRepeatedly([&](google::pubsub::v1::PublishRequest const& r) {
+        return sequencer.PushBack().then(
+            [r](future<void>) { return make_status_or(MakeResponse(r)); });
+      });
+
+  auto uut = SequentialBatchSink::Create(mock, 2);
+  auto f1 = uut->AsyncPublish(MakeRequest(3));
+  auto f2 = uut->AsyncPublish(MakeRequest(2));
+  auto f3 = uut->AsyncPublish(MakeRequest(1));
+  EXPECT_EQ(2, uut->InFlight());
+  EXPECT_EQ(1, uut->QueueDepth());
+
+  // Complete the second request first, its result must wait for the first.
+  auto p1 = sequencer.PopFront();
+  auto p2 = sequencer.PopFront();
+  p2.set_value();
+  EXPECT_EQ(2, uut->InFlight());
+  EXPECT_EQ(std::future_status::timeout, f2.wait_for(std::chrono::seconds(0)));
+
+  p1.set_value();
+  auto r1 = f1.get();
+  ASSERT_THAT(r1, IsOk());
+  EXPECT_THAT(*r1, IsProtoEqual(MakeResponse(MakeRequest(3))));
+  auto r2 = f2.get();
+  ASSERT_THAT(r2, IsOk());
+  EXPECT_THAT(*r2, IsProtoEqual(MakeResponse(MakeRequest(2))));
+  EXPECT_EQ(1, uut->InFlight());
+  EXPECT_EQ(0, uut->QueueDepth());
+
+  sequencer.PopFront().set_value();
+  auto r3 = f3.get();
+  ASSERT_THAT(r3, IsOk());
+  EXPECT_THAT(*r3, IsProtoEqual(MakeResponse(MakeRequest(1))));
+}
+
+TEST(DefaultBatchSinkTest, PipelinedErrorHandling) {
+  AsyncSequencer<void> sequencer;
+
+  auto mock = std::make_shared<pubsub_testing::MockBatchSink>();
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock, AsyncPublish)
+        .WillOnce([&](google::pubsub::v1::PublishRequest const&) {
+          return sequencer.PushBack().then([](future<void>) {
+            return StatusOr<google::pubsub::v1::PublishResponse>(
+                Status{StatusCode::kPermissionDenied, "uh-oh"});
+          });
+        });
+    EXPECT_CALL(*mock, AsyncPublish)
+        .WillOnce([&](google::pubsub::v1::PublishRequest const& r) {
+          return sequencer.PushBack().then(
+              [r](future<void>) { return make_status_or(MakeResponse(r)); });
+        });
+  }
+
+  auto uut = SequentialBatchSink::Create(mock, 2);
+  auto f1 = uut->AsyncPublish(MakeRequest(3));
+  auto f2 = uut->AsyncPublish(MakeRequest(2));
+  auto f3 = uut->AsyncPublish(MakeRequest(1));
+
+  sequencer.PopFront().set_value();
+  ASSERT_THAT(f1.get(), StatusIs(StatusCode::kPermissionDenied));
+  // The queued request is rejected, and so are any new requests.
+  ASSERT_THAT(f3.get(), StatusIs(StatusCode::kPermissionDenied));
+  ASSERT_THAT(uut->AsyncPublish(MakeRequest(1)).get(),
+              StatusIs(StatusCode::kPermissionDenied));
+
+  // The request already in flight reports its own result.
+  sequencer.PopFront().set_value();
+  ASSERT_THAT(f2.get(), IsOk());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
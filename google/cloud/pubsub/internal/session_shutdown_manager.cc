@@ -47,6 +47,15 @@ void SessionShutdownManager::LogStart(const char* caller, const char* name) {
                  << ", result=" << result_ << ", count=" << increase_count();
 }
 
+bool SessionShutdownManager::StartDrainOperation(char const* caller,
+                                                 char const* name) {
+  std::lock_guard<std::mutex> lk(mu_);
+  LogStart(caller, name);
+  if (signaled_) return false;
+  ++outstanding_operations_;
+  return true;
+}
+
 bool SessionShutdownManager::FinishedOperation(char const* name) {
   std::unique_lock<std::mutex> lk(mu_);
   auto decrease_count = [&] { return --ops_[name]; };
@@ -71,12 +80,25 @@ void SessionShutdownManager::MarkAsShutdown(char const* caller, Status status) {
   SignalOnShutdown(std::move(lk));
 }
 
+void SessionShutdownManager::AbandonOperations(char const* caller) {
+  std::unique_lock<std::mutex> lk(mu_);
+  GCP_LOG(TRACE) << __func__ << "() - from " << caller << "()"
+                 << ", shutdown=" << shutdown_ << ", signaled=" << signaled_
+                 << ", outstanding_operations=" << outstanding_operations_
+                 << ", ops=" << FormatOps(ops_);
+  if (!shutdown_) return;
+  abandoned_ = true;
+  SignalOnShutdown(std::move(lk));
+}
+
 void SessionShutdownManager::SignalOnShutdown(std::unique_lock<std::mutex> lk) {
   GCP_LOG(TRACE) << __func__ << "() - maybe signal"
                  << ", shutdown=" << shutdown_ << ", signaled=" << signaled_
                  << ", outstanding_operations=" << outstanding_operations_
                  << ", result=" << result_ << ", ops=" << FormatOps(ops_);
-  if (outstanding_operations_ > 0 || !shutdown_ || signaled_) return;
+  if ((outstanding_operations_ > 0 && !abandoned_) || !shutdown_ || signaled_) {
+    return;
+  }
   // No other thread will go beyond this point, as `signaled_` is only set
   // once.
   signaled_ = true;
@@ -103,9 +103,25 @@ class SessionShutdownManager {
     return true;
   }
 
+  /**
+   * Start an operation that the shutdown waits for, even if it has started.
+   *
+   * The session sends requests to nack messages during the shutdown, it should
+   * not complete until these requests do. Returns false if the shutdown has
+   * completed, in which case the caller must not call `FinishedOperation()`.
+   */
+  bool StartDrainOperation(char const* caller, char const* name);
+
   /// Record an operation completion, returns true if marked for shutdown.
   bool FinishedOperation(char const* name);
 
+  /**
+   * Complete the shutdown without waiting for the outstanding operations.
+   *
+   * Has no effect if the shutdown has not started.
+   */
+  void AbandonOperations(char const* caller);
+
   // Start the shutdown process
   void MarkAsShutdown(char const* caller, Status status);
 
@@ -116,6 +132,7 @@ class SessionShutdownManager {
   std::mutex mu_;
   bool shutdown_ = false;
   bool signaled_ = false;
+  bool abandoned_ = false;
   int outstanding_operations_ = 0;
   Status result_;
   promise<Status> done_;
@@ -59,6 +59,46 @@ TEST(SessionShutdownManagerTest, Basic) {
   EXPECT_EQ(expected_status, shutdown.get());
 }
 
+/// @test Verify drain operations delay the shutdown.
+TEST(SessionShutdownManagerTest, DrainOperation) {
+  SessionShutdownManager tested;
+  auto shutdown = tested.Start({});
+  EXPECT_TRUE(tested.StartOperation("testing", "operation-1", [] {}));
+  tested.MarkAsShutdown("testing", {});
+  // The shutdown has started, but not completed, drain operations are
+  // accepted.
+  EXPECT_FALSE(tested.StartOperation("testing", "operation-2", [] {}));
+  EXPECT_TRUE(tested.StartDrainOperation("testing", "nack-1"));
+  EXPECT_TRUE(tested.FinishedOperation("operation-1"));
+  EXPECT_EQ(std::future_status::timeout,
+            shutdown.wait_for(std::chrono::milliseconds(0)));
+  EXPECT_TRUE(tested.FinishedOperation("nack-1"));
+  EXPECT_EQ(Status{}, shutdown.get());
+
+  EXPECT_FALSE(tested.StartDrainOperation("testing", "nack-2"));
+}
+
+/// @test Verify abandoning the pending operations completes the shutdown.
+TEST(SessionShutdownManagerTest, AbandonOperations) {
+  SessionShutdownManager tested;
+  auto shutdown = tested.Start({});
+  EXPECT_TRUE(tested.StartOperation("testing", "operation-1", [] {}));
+  // Abandoning the operations has no effect before the shutdown.
+  tested.AbandonOperations("testing");
+  EXPECT_EQ(std::future_status::timeout,
+            shutdown.wait_for(std::chrono::milliseconds(0)));
+
+  auto const expected_status = Status{StatusCode::kAborted, "test-message"};
+  tested.MarkAsShutdown("testing", expected_status);
+  EXPECT_EQ(std::future_status::timeout,
+            shutdown.wait_for(std::chrono::milliseconds(0)));
+  tested.AbandonOperations("testing");
+  EXPECT_EQ(expected_status, shutdown.get());
+
+  // The abandoned operations may still complete.
+  EXPECT_TRUE(tested.FinishedOperation("operation-1"));
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
@@ -0,0 +1,53 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/sharded_publisher_connection.h"
+#include <functional>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+future<StatusOr<std::string>> ShardedPublisherConnection::Publish(
+    PublishParams p) {
+  return Shard(p.message.ordering_key()).Publish(std::move(p));
+}
+
+void ShardedPublisherConnection::PublishNoWait(PublishNoWaitParams p) {
+  Shard(p.message.ordering_key()).PublishNoWait(std::move(p));
+}
+
+void ShardedPublisherConnection::Flush(FlushParams p) {
+  for (auto const& c : children_) c->Flush(p);
+}
+
+void ShardedPublisherConnection::ResumePublish(ResumePublishParams p) {
+  Shard(p.ordering_key).ResumePublish(std::move(p));
+}
+
+pubsub::PublisherConnection& ShardedPublisherConnection::Shard(
+    std::string const& ordering_key) {
+  auto const h = ordering_key.empty()
+                     ? std::hash<std::thread::id>{}(std::this_thread::get_id())
+                     : std::hash<std::string>{}(ordering_key);
+  return *children_[h % children_.size()];
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
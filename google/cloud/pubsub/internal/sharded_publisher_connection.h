@@ -0,0 +1,73 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_PUBLISHER_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_PUBLISHER_CONNECTION_H
+
+#include "google/cloud/pubsub/publisher_connection.h"
+#include "google/cloud/pubsub/version.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Spreads the calls to `Publish()` across several independent connections.
+ *
+ * Each child connection (typically a `BatchingPublisherConnection`) has its own
+ * lock and its own batch. Messages without an ordering key are routed based on
+ * the calling thread, so each publishing thread mostly uses the same shard and
+ * threads rarely contend with each other. Messages with an ordering key are
+ * routed based on the ordering key, so all the messages for a given key go
+ * through the same shard, in the order they were published.
+ *
+ * The set of children is fixed at construction time, so routing a message
+ * requires no locks.
+ */
+class ShardedPublisherConnection : public pubsub::PublisherConnection {
+ public:
+  static std::shared_ptr<ShardedPublisherConnection> Create(
+      std::vector<std::shared_ptr<pubsub::PublisherConnection>> children) {
+    return std::shared_ptr<ShardedPublisherConnection>(
+        new ShardedPublisherConnection(std::move(children)));
+  }
+
+  ~ShardedPublisherConnection() override = default;
+
+  future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void PublishNoWait(PublishNoWaitParams p) override;
+  void Flush(FlushParams) override;
+  void ResumePublish(ResumePublishParams p) override;
+
+ private:
+  explicit ShardedPublisherConnection(
+      std::vector<std::shared_ptr<pubsub::PublisherConnection>> children)
+      : children_(std::move(children)) {}
+
+  pubsub::PublisherConnection& Shard(std::string const& ordering_key);
+
+  std::vector<std::shared_ptr<pubsub::PublisherConnection>> const children_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_PUBLISHER_CONNECTION_H
@@ -0,0 +1,155 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/sharded_publisher_connection.h"
+#include "google/cloud/pubsub/mocks/mock_publisher_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::testing::SizeIs;
+
+auto constexpr kShardCount = 4;
+
+TEST(ShardedPublisherConnectionTest, OrderingKeysUseFixedShard) {
+  // Record the shard used for each ordering key, and the messages in order.
+  std::map<std::string, std::set<int>> shards_by_key;
+  std::map<std::string, std::vector<std::string>> received;
+  std::vector<std::shared_ptr<pubsub::PublisherConnection>> children;
+  for (int i = 0; i != kShardCount; ++i) {
+    auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    EXPECT_CALL(*mock, Publish)
+        .WillRepeatedly(
+            [&, i](pubsub::PublisherConnection::PublishParams const& p) {
+              auto const& key = p.message.ordering_key();
+              shards_by_key[key].insert(i);
+              auto data = std::string(p.message.data());
+              received[key].push_back(data);
+              return make_ready_future(make_status_or(key + "#" + data));
+            });
+    EXPECT_CALL(*mock, Flush).Times(1);
+    children.push_back(std::move(mock));
+  }
+  auto publisher = ShardedPublisherConnection::Create(std::move(children));
+
+  std::vector<std::string> expected;
+  for (int i = 0; i != 10; ++i) expected.push_back("data" + std::to_string(i));
+  for (auto const& data : expected) {
+    for (auto const& key : {"k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7"}) {
+      auto r = publisher
+                   ->Publish({pubsub::MessageBuilder{}
+                                  .SetData(data)
+                                  .SetOrderingKey(key)
+                                  .Build()})
+                   .get();
+      ASSERT_STATUS_OK(r);
+      EXPECT_EQ(std::string(key) + "#" + data, *r);
+    }
+  }
+  publisher->Flush({});
+
+  EXPECT_THAT(shards_by_key, SizeIs(8));
+  for (auto const& kv : shards_by_key) {
+    SCOPED_TRACE("Testing key=" + kv.first);
+    EXPECT_THAT(kv.second, SizeIs(1));
+    EXPECT_EQ(expected, received[kv.first]);
+  }
+}
+
+TEST(ShardedPublisherConnectionTest, NoKeyUsesThreadShard) {
+  std::mutex mu;
+  std::map<std::thread::id, std::set<int>> shards_by_thread;
+  std::vector<std::shared_ptr<pubsub::PublisherConnection>> children;
+  for (int i = 0; i != kShardCount; ++i) {
+    auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    EXPECT_CALL(*mock, Publish)
+        .WillRepeatedly(
+            [&, i](pubsub::PublisherConnection::PublishParams const&) {
+              std::lock_guard<std::mutex> lk(mu);
+              shards_by_thread[std::this_thread::get_id()].insert(i);
+              return make_ready_future(make_status_or(std::string("ack")));
+            });
+    children.push_back(std::move(mock));
+  }
+  auto publisher = ShardedPublisherConnection::Create(std::move(children));
+
+  auto worker = [&] {
+    for (int i = 0; i != 100; ++i) {
+      auto r = publisher
+                   ->Publish({pubsub::MessageBuilder{}.SetData("data").Build()})
+                   .get();
+      EXPECT_STATUS_OK(r);
+    }
+  };
+  std::vector<std::thread> tasks;
+  for (int i = 0; i != 8; ++i) tasks.emplace_back(worker);
+  for (auto& t : tasks) t.join();
+
+  EXPECT_THAT(shards_by_thread, SizeIs(8));
+  for (auto const& kv : shards_by_thread) {
+    EXPECT_THAT(kv.second, SizeIs(1));
+  }
+}
+
+TEST(ShardedPublisherConnectionTest, ResumePublish) {
+  auto const key = std::string("test-key");
+  int publish_shard = -1;
+  int resume_shard = -1;
+  std::vector<std::shared_ptr<pubsub::PublisherConnection>> children;
+  for (int i = 0; i != kShardCount; ++i) {
+    auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    EXPECT_CALL(*mock, Publish)
+        .WillRepeatedly(
+            [&, i](pubsub::PublisherConnection::PublishParams const&) {
+              publish_shard = i;
+              return make_ready_future(make_status_or(std::string("ack")));
+            });
+    EXPECT_CALL(*mock, ResumePublish)
+        .WillRepeatedly(
+            [&, i](pubsub::PublisherConnection::ResumePublishParams const& p) {
+              EXPECT_EQ(key, p.ordering_key);
+              resume_shard = i;
+            });
+    children.push_back(std::move(mock));
+  }
+  auto publisher = ShardedPublisherConnection::Create(std::move(children));
+  auto r = publisher
+               ->Publish({pubsub::MessageBuilder{}
+                              .SetData("data")
+                              .SetOrderingKey(key)
+                              .Build()})
+               .get();
+  ASSERT_STATUS_OK(r);
+  publisher->ResumePublish({key});
+  EXPECT_NE(-1, publish_shard);
+  EXPECT_EQ(publish_shard, resume_shard);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
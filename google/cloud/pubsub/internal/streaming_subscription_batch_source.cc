@@ -14,12 +14,19 @@
 
 #include "google/cloud/pubsub/internal/streaming_subscription_batch_source.h"
 #include "google/cloud/log.h"
+#include <algorithm>
+#include <iterator>
 #include <ostream>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+// Keeps each `AcknowledgeRequest` and `ModifyAckDeadlineRequest` well below
+// the 512KiB request size limit.
+auto constexpr kMaxAckIdsPerRequest = 2500;
+}  // namespace
 
 void StreamingSubscriptionBatchSource::Start(BatchCallback callback) {
   std::unique_lock<std::mutex> lk(mu_);
@@ -38,33 +45,55 @@ void StreamingSubscriptionBatchSource::Shutdown() {
   if (shutdown_ || !stream_) return;
   shutdown_ = true;
   if (stream_) stream_->Cancel();
+  // A paused read loop must read from the cancelled stream, which then
+  // finishes the stream.
+  auto const resume = read_paused_;
+  read_paused_ = false;
+  DrainQueues(std::move(lk), false);
+  if (!resume) return;
+  auto weak = WeakFromThis();
+  cq_.RunAsync([weak] {
+    if (auto self = weak.lock()) self->ReadLoop();
+  });
 }
 
 void StreamingSubscriptionBatchSource::AckMessage(std::string const& ack_id) {
-  google::pubsub::v1::AcknowledgeRequest request;
-  request.set_subscription(subscription_full_name_);
-  *request.add_ack_ids() = ack_id;
-  (void)stub_->AsyncAcknowledge(cq_, absl::make_unique<grpc::ClientContext>(),
-                                request);
+  BulkAck({ack_id});
 }
 
 void StreamingSubscriptionBatchSource::NackMessage(std::string const& ack_id) {
-  google::pubsub::v1::ModifyAckDeadlineRequest request;
-  request.set_subscription(subscription_full_name_);
-  *request.add_ack_ids() = ack_id;
-  request.set_ack_deadline_seconds(0);
-  (void)stub_->AsyncModifyAckDeadline(
-      cq_, absl::make_unique<grpc::ClientContext>(), request);
+  BulkNack({ack_id});
+}
+
+void StreamingSubscriptionBatchSource::BulkAck(
+    std::vector<std::string> ack_ids) {
+  Handled(ack_ids);
+  QueueAcks(std::move(ack_ids));
 }
 
 void StreamingSubscriptionBatchSource::BulkNack(
     std::vector<std::string> ack_ids) {
-  google::pubsub::v1::ModifyAckDeadlineRequest request;
-  request.set_subscription(subscription_full_name_);
-  for (auto& a : ack_ids) *request.add_ack_ids() = std::move(a);
-  request.set_ack_deadline_seconds(0);
-  (void)stub_->AsyncModifyAckDeadline(
-      cq_, absl::make_unique<grpc::ClientContext>(), request);
+  Handled(ack_ids);
+  // Most nacks happen during the shutdown, when all the outstanding messages
+  // are nacked. The shutdown waits for these requests, otherwise they may be
+  // cancelled if the application shuts down the completion queue.
+  auto const batch_size = static_cast<std::size_t>(kMaxAckIdsPerRequest);
+  for (std::size_t i = 0; i < ack_ids.size(); i += batch_size) {
+    google::pubsub::v1::ModifyAckDeadlineRequest request;
+    request.set_subscription(subscription_full_name_);
+    auto const end = (std::min)(ack_ids.size(), i + batch_size);
+    for (auto j = i; j != end; ++j) {
+      *request.add_ack_ids() = std::move(ack_ids[j]);
+    }
+    request.set_ack_deadline_seconds(0);
+    auto const tracked =
+        shutdown_manager_->StartDrainOperation(__func__, "nack");
+    auto f = stub_->AsyncModifyAckDeadline(
+        cq_, absl::make_unique<grpc::ClientContext>(), request);
+    if (!tracked) continue;
+    auto manager = shutdown_manager_;
+    f.then([manager](future<Status>) { manager->FinishedOperation("nack"); });
+  }
 }
 
 void StreamingSubscriptionBatchSource::ExtendLeases(
@@ -76,6 +105,19 @@ void StreamingSubscriptionBatchSource::ExtendLeases(
   DrainQueues(std::move(lk), false);
 }
 
+AckStats StreamingSubscriptionBatchSource::ack_stats() {
+  std::lock_guard<std::mutex> lk(mu_);
+  return ack_stats_;
+}
+
+void StreamingSubscriptionBatchSource::QueueAcks(
+    std::vector<std::string> ack_ids) {
+  auto const now = Clock::now();
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto& a : ack_ids) acks_queue_.push_back(PendingAck{std::move(a), now});
+  DrainQueues(std::move(lk), false);
+}
+
 void StreamingSubscriptionBatchSource::StartStream(
     std::shared_ptr<pubsub::RetryPolicy> retry_policy,
     std::shared_ptr<pubsub::BackoffPolicy> backoff_policy) {
@@ -108,6 +150,22 @@ void StreamingSubscriptionBatchSource::StartStream(
   });
 }
 
+std::unique_ptr<AdaptiveFlowControl>
+StreamingSubscriptionBatchSource::MakeFlowControl(
+    pubsub::SubscriberOptions const& options) {
+  if (options.prefetch_buffer_time() <= std::chrono::milliseconds(0)) {
+    return nullptr;
+  }
+  // The streams share the callbacks, each one buffers enough messages to keep
+  // its share of them busy.
+  auto const streams = (std::max)(options.parallel_streams(), std::size_t{1});
+  auto const concurrency = (options.max_concurrency() + streams - 1) / streams;
+  return absl::make_unique<AdaptiveFlowControl>(
+      static_cast<std::int64_t>(concurrency),
+      options.max_outstanding_messages(), options.max_outstanding_bytes(),
+      options.prefetch_buffer_time());
+}
+
 google::pubsub::v1::StreamingPullRequest
 StreamingSubscriptionBatchSource::InitialRequest() const {
   google::pubsub::v1::StreamingPullRequest request;
@@ -247,7 +305,15 @@ void StreamingSubscriptionBatchSource::OnRetryFailure(Status status) {
 
 void StreamingSubscriptionBatchSource::ReadLoop() {
   std::unique_lock<std::mutex> lk(mu_);
-  if (stream_state_ != StreamState::kActive) return;
+  if (stream_state_ != StreamState::kActive || pending_read_) return;
+  // Stop reading while the prefetch buffer is full, gRPC flow control then
+  // stops the service from sending more messages on this stream. `Handled()`
+  // resumes the loop.
+  if (flow_control_ && !shutdown_ && !flow_control_->CanRead()) {
+    read_paused_ = true;
+    return;
+  }
+  read_paused_ = false;
   pending_read_ = true;
   auto stream = stream_;
   lk.unlock();
@@ -265,6 +331,12 @@ void StreamingSubscriptionBatchSource::OnRead(
   std::unique_lock<std::mutex> lk(mu_);
   pending_read_ = false;
   if (response && stream_state_ == StreamState::kActive && !shutdown_) {
+    if (flow_control_) {
+      for (auto const& m : response->received_messages()) {
+        flow_control_->Received(
+            m.ack_id(), static_cast<std::int64_t>(m.message().ByteSizeLong()));
+      }
+    }
     lk.unlock();
     callback_(*std::move(response));
     cq_.RunAsync([weak] {
@@ -275,6 +347,20 @@ void StreamingSubscriptionBatchSource::OnRead(
   ShutdownStream(std::move(lk), response ? "state" : "read error");
 }
 
+void StreamingSubscriptionBatchSource::Handled(
+    std::vector<std::string> const& ack_ids) {
+  if (!flow_control_) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto const& a : ack_ids) flow_control_->Handled(a);
+  if (!read_paused_ || !flow_control_->CanRead()) return;
+  read_paused_ = false;
+  lk.unlock();
+  auto weak = WeakFromThis();
+  cq_.RunAsync([weak] {
+    if (auto self = weak.lock()) self->ReadLoop();
+  });
+}
+
 void StreamingSubscriptionBatchSource::ShutdownStream(
     std::unique_lock<std::mutex> lk, char const* reason) {
   if (stream_state_ != StreamState::kActive &&
@@ -308,22 +394,52 @@ void StreamingSubscriptionBatchSource::OnFinish(Status status) {
 }
 
 void StreamingSubscriptionBatchSource::DrainQueues(
-    std::unique_lock<std::mutex> lk, bool /*force_flush*/) {
-  if (deadlines_queue_.empty()) return;
-  if (stream_state_ != StreamState::kActive || pending_write_) return;
+    std::unique_lock<std::mutex> lk, bool force_flush) {
+  // Large bursts of acks go out as unary requests, as do any acks that cannot
+  // wait for a stream: either the source is shutting down, or the acks have
+  // been held for `max_hold_time` while the stream was reconnecting.
+  auto const stream_usable = stream_state_ == StreamState::kActive;
+  auto const flush_acks = shutdown_ || (force_flush && !stream_usable);
+  if (acks_queue_.size() >= ack_batching_config_.unary_ack_threshold ||
+      (flush_acks && !acks_queue_.empty())) {
+    std::vector<PendingAck> acks;
+    acks.swap(acks_queue_);
+    lk.unlock();
+    SendUnaryAcks(std::move(acks));
+    lk.lock();
+  }
+
+  auto const pending = acks_queue_.size() + deadlines_queue_.size();
+  if (pending == 0) return;
+  if (!stream_usable || pending_write_) return;
+  auto const max_batch_size =
+      (std::max)(ack_batching_config_.max_batch_size, std::size_t{1});
+  if (!force_flush && pending < max_batch_size) return;
   auto stream = stream_;
   pending_write_ = true;
 
-  std::vector<std::pair<std::string, std::chrono::seconds>> deadlines;
-  deadlines.swap(deadlines_queue_);
-  lk.unlock();
-
   google::pubsub::v1::StreamingPullRequest request;
-  for (auto& d : deadlines) {
-    request.add_modify_deadline_ack_ids(std::move(d.first));
+  auto const acks_count = (std::min)(acks_queue_.size(), max_batch_size);
+  auto const acks_end = std::next(acks_queue_.begin(), acks_count);
+  for (auto a = acks_queue_.begin(); a != acks_end; ++a) {
+    request.add_ack_ids(a->ack_id);
+  }
+  inflight_acks_.assign(std::make_move_iterator(acks_queue_.begin()),
+                        std::make_move_iterator(acks_end));
+  acks_queue_.erase(acks_queue_.begin(), acks_end);
+
+  auto const deadlines_count =
+      (std::min)(deadlines_queue_.size(), max_batch_size - acks_count);
+  auto const deadlines_end =
+      std::next(deadlines_queue_.begin(), deadlines_count);
+  for (auto d = deadlines_queue_.begin(); d != deadlines_end; ++d) {
+    request.add_modify_deadline_ack_ids(std::move(d->first));
     request.add_modify_deadline_seconds(
-        static_cast<std::int32_t>(d.second.count()));
+        static_cast<std::int32_t>(d->second.count()));
   }
+  deadlines_queue_.erase(deadlines_queue_.begin(), deadlines_end);
+  lk.unlock();
+
   // Note that we do not use `AsyncRetryLoop()` here. The ack/nack pipeline is
   // best-effort anyway, there is no guarantee that the server will act on any
   // of these.
@@ -337,6 +453,22 @@ void StreamingSubscriptionBatchSource::DrainQueues(
 void StreamingSubscriptionBatchSource::OnWrite(bool ok) {
   std::unique_lock<std::mutex> lk(mu_);
   pending_write_ = false;
+  std::vector<PendingAck> acks;
+  acks.swap(inflight_acks_);
+  if (ok) {
+    std::vector<Clock::time_point> queued(acks.size());
+    std::transform(acks.begin(), acks.end(), queued.begin(),
+                   [](PendingAck const& a) { return a.queued; });
+    if (!acks.empty()) ++ack_stats_.stream_writes;
+    RecordAcks(lk, queued);
+  } else if (!acks.empty()) {
+    // The stream is going away, and we do not know if the server received the
+    // acks. Resending them is harmless, and saves the application from seeing
+    // these messages again.
+    lk.unlock();
+    SendUnaryAcks(std::move(acks));
+    lk.lock();
+  }
   if (ok && stream_state_ == StreamState::kActive && !shutdown_) {
     DrainQueues(std::move(lk), false);
     return;
@@ -344,6 +476,55 @@ void StreamingSubscriptionBatchSource::OnWrite(bool ok) {
   ShutdownStream(std::move(lk), ok ? "state" : "write error");
 }
 
+void StreamingSubscriptionBatchSource::SendUnaryAcks(
+    std::vector<PendingAck> acks) {
+  auto weak = WeakFromThis();
+  for (auto begin = acks.begin(); begin != acks.end();) {
+    auto const count = (std::min)(
+        static_cast<std::size_t>(std::distance(begin, acks.end())),
+        static_cast<std::size_t>(kMaxAckIdsPerRequest));
+    auto const end = std::next(begin, count);
+    google::pubsub::v1::AcknowledgeRequest request;
+    request.set_subscription(subscription_full_name_);
+    std::vector<Clock::time_point> queued;
+    queued.reserve(count);
+    for (; begin != end; ++begin) {
+      *request.add_ack_ids() = std::move(begin->ack_id);
+      queued.push_back(begin->queued);
+    }
+    stub_
+        ->AsyncAcknowledge(cq_, absl::make_unique<grpc::ClientContext>(),
+                           request)
+        .then([weak, queued](future<Status> f) {
+          if (auto self = weak.lock()) self->OnUnaryAck(queued, f.get());
+        });
+  }
+}
+
+void StreamingSubscriptionBatchSource::OnUnaryAck(
+    std::vector<Clock::time_point> const& queued, Status const& status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  ++ack_stats_.unary_requests;
+  if (!status.ok()) {
+    ack_stats_.failed_acks += static_cast<std::int64_t>(queued.size());
+    return;
+  }
+  RecordAcks(lk, queued);
+}
+
+void StreamingSubscriptionBatchSource::RecordAcks(
+    std::unique_lock<std::mutex> const&,
+    std::vector<Clock::time_point> const& queued) {
+  auto const now = Clock::now();
+  for (auto const& q : queued) {
+    auto const latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - q);
+    ack_stats_.total_latency += latency;
+    ack_stats_.max_latency = (std::max)(ack_stats_.max_latency, latency);
+  }
+  ack_stats_.acks += static_cast<std::int64_t>(queued.size());
+}
+
 void StreamingSubscriptionBatchSource::StartWriteTimer() {
   auto weak = WeakFromThis();
   using F = future<StatusOr<std::chrono::system_clock::time_point>>;
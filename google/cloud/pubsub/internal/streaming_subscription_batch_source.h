@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_STREAMING_SUBSCRIPTION_BATCH_SOURCE_H
 
 #include "google/cloud/pubsub/backoff_policy.h"
+#include "google/cloud/pubsub/internal/adaptive_flow_control.h"
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/internal/subscription_batch_source.h"
@@ -30,6 +31,7 @@
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -47,17 +49,42 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
  * `pubsub::SubscriberOptions`. For now they are only available in
  * `pubsub_internal` because it is always easy to add new APIs later vs.
  * removing these any APIs or accessors.
+ *
+ * Acks and lease extensions are held until there are `max_batch_size` of them,
+ * or until they have waited for `max_hold_time`, whichever comes first. Each
+ * `Write()` carries at most `max_batch_size` ids. Bursts of at least
+ * `unary_ack_threshold` acks skip the stream and are sent using (unary)
+ * `Acknowledge()` requests, so they do not delay the lease extensions.
  */
 struct AckBatchingConfig {
   AckBatchingConfig() = default;
   AckBatchingConfig(std::size_t s, std::chrono::milliseconds t)
       : max_batch_size(s), max_hold_time(t) {}
+  AckBatchingConfig(std::size_t s, std::chrono::milliseconds t, std::size_t u)
+      : max_batch_size(s), max_hold_time(t), unary_ack_threshold(u) {}
 
   // The defaults are biased towards high-throughput applications. Note that
   // the max_hold_time is small enough that it should not make a big difference,
   // the minimum ack deadline is 10 seconds.
   std::size_t max_batch_size = 1000;
   std::chrono::milliseconds max_hold_time{100};
+  std::size_t unary_ack_threshold = 2500;
+};
+
+/// The acks sent by a `StreamingSubscriptionBatchSource` and their latency.
+struct AckStats {
+  /// The number of acks sent successfully.
+  std::int64_t acks = 0;
+  /// The number of acks that could not be sent.
+  std::int64_t failed_acks = 0;
+  /// The number of `Write()` requests on the stream that included acks.
+  std::int64_t stream_writes = 0;
+  /// The number of (unary) `Acknowledge()` requests.
+  std::int64_t unary_requests = 0;
+  /// The sum and maximum of the time between `AckMessage()` (or `BulkAck()`)
+  /// and the completion of the request that carried the ack.
+  std::chrono::microseconds total_latency{0};
+  std::chrono::microseconds max_latency{0};
 };
 
 class StreamingSubscriptionBatchSource
@@ -82,7 +109,8 @@ class StreamingSubscriptionBatchSource
         max_deadline_time_(options.max_deadline_time()),
         retry_policy_(std::move(retry_policy)),
         backoff_policy_(std::move(backoff_policy)),
-        ack_batching_config_(std::move(ack_batching_config)) {}
+        ack_batching_config_(std::move(ack_batching_config)),
+        flow_control_(MakeFlowControl(options)) {}
 
   ~StreamingSubscriptionBatchSource() override = default;
 
@@ -91,10 +119,14 @@ class StreamingSubscriptionBatchSource
   void Shutdown() override;
   void AckMessage(std::string const& ack_id) override;
   void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
   void BulkNack(std::vector<std::string> ack_ids) override;
   void ExtendLeases(std::vector<std::string> ack_ids,
                     std::chrono::seconds extension) override;
 
+  /// The acks sent so far, and their latency.
+  AckStats ack_stats();
+
   using AsyncPullStream = SubscriberStub::AsyncPullStream;
 
   enum class StreamState {
@@ -112,6 +144,9 @@ class StreamingSubscriptionBatchSource
     return {shared_from_this()};
   }
 
+  static std::unique_ptr<AdaptiveFlowControl> MakeFlowControl(
+      pubsub::SubscriberOptions const& options);
+
   void StartStream(std::shared_ptr<pubsub::RetryPolicy> retry_policy,
                    std::shared_ptr<pubsub::BackoffPolicy> backoff_policy);
 
@@ -134,14 +169,27 @@ class StreamingSubscriptionBatchSource
   void OnRetryFailure(Status status);
 
   void ReadLoop();
+  void Handled(std::vector<std::string> const& ack_ids);
 
   void OnRead(
       absl::optional<google::pubsub::v1::StreamingPullResponse> response);
   void ShutdownStream(std::unique_lock<std::mutex> lk, char const* reason);
   void OnFinish(Status status);
 
+  using Clock = std::chrono::steady_clock;
+  struct PendingAck {
+    std::string ack_id;
+    Clock::time_point queued;
+  };
+
+  void QueueAcks(std::vector<std::string> ack_ids);
   void DrainQueues(std::unique_lock<std::mutex> lk, bool force_flush);
   void OnWrite(bool ok);
+  void SendUnaryAcks(std::vector<PendingAck> acks);
+  void OnUnaryAck(std::vector<Clock::time_point> const& queued,
+                  Status const& status);
+  void RecordAcks(std::unique_lock<std::mutex> const& lk,
+                  std::vector<Clock::time_point> const& queued);
 
   void StartWriteTimer();
   void OnWriteTimer(Status const&);
@@ -160,6 +208,8 @@ class StreamingSubscriptionBatchSource
   std::unique_ptr<pubsub::RetryPolicy const> retry_policy_;
   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy_;
   AckBatchingConfig const ack_batching_config_;
+  // Only created if the application enables the adaptive prefetch buffer.
+  std::unique_ptr<AdaptiveFlowControl> const flow_control_;
 
   std::mutex mu_;
   BatchCallback callback_;
@@ -167,9 +217,13 @@ class StreamingSubscriptionBatchSource
   bool shutdown_ = false;
   bool pending_write_ = false;
   bool pending_read_ = false;
+  bool read_paused_ = false;
   Status status_;
   std::shared_ptr<AsyncPullStream> stream_;
   std::vector<std::pair<std::string, std::chrono::seconds>> deadlines_queue_;
+  std::vector<PendingAck> acks_queue_;
+  std::vector<PendingAck> inflight_acks_;
+  AckStats ack_stats_;
 };
 
 std::ostream& operator<<(std::ostream& os,
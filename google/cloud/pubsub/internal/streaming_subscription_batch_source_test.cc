@@ -583,13 +583,18 @@ TEST(StreamingSubscriptionBatchSourceTest, AckMany) {
                            Property(&ModifyRequest::ack_ids,
                                     ElementsAre("fake-004", "fake-005"))))
         .WillOnce(OnModify);
+    EXPECT_CALL(*mock, AsyncAcknowledge(
+                           _, _,
+                           Property(&AckRequest::ack_ids,
+                                    ElementsAre("fake-007", "fake-008"))))
+        .WillOnce(OnAck);
   }
 
   auto shutdown = std::make_shared<SessionShutdownManager>();
   auto uut = std::make_shared<StreamingSubscriptionBatchSource>(
       background.cq(), shutdown, mock, subscription.FullName(), client_id,
       TestSubscriptionOptions(), TestRetryPolicy(), TestBackoffPolicy(),
-      TestBatchingConfig());
+      AckBatchingConfig(1, std::chrono::milliseconds(10), 1));
 
   auto done = shutdown->Start({});
   uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
@@ -604,6 +609,7 @@ TEST(StreamingSubscriptionBatchSourceTest, AckMany) {
   uut->AckMessage("fake-002");
   uut->NackMessage("fake-003");
   uut->BulkNack({"fake-004", "fake-005"});
+  uut->BulkAck({"fake-007", "fake-008"});
 
   uut->ExtendLeases({"fake-006"}, std::chrono::seconds(10));
   success_stream.WaitForAction().set_value(true);  // Write()
@@ -616,6 +622,186 @@ TEST(StreamingSubscriptionBatchSourceTest, AckMany) {
   EXPECT_THAT(done.get(), IsOk());
 }
 
+TEST(StreamingSubscriptionBatchSourceTest, AckCoalescing) {
+  auto subscription = pubsub::Subscription("test-project", "test-subscription");
+  std::string const client_id = "fake-client-id";
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+
+  FakeStream success_stream(Status{});
+  EXPECT_CALL(*mock, AsyncStreamingPull)
+      .WillOnce([&](google::cloud::CompletionQueue& cq,
+                    std::unique_ptr<grpc::ClientContext> context,
+                    google::pubsub::v1::StreamingPullRequest const& request) {
+        auto stream = success_stream.MakeWriteFailureStream(
+            cq, std::move(context), request);
+        using Request = google::pubsub::v1::StreamingPullRequest;
+        EXPECT_CALL(*stream,
+                    Write(Property(&Request::subscription, std::string{}), _))
+            .WillOnce(
+                [&](google::pubsub::v1::StreamingPullRequest const& request,
+                    grpc::WriteOptions const&) {
+                  EXPECT_THAT(request.ack_ids(),
+                              ElementsAre("fake-001", "fake-002"));
+                  EXPECT_THAT(request.modify_deadline_ack_ids(),
+                              ElementsAre("fake-003"));
+                  return success_stream.AddAction("Write");
+                });
+        return stream;
+      });
+  EXPECT_CALL(*mock, AsyncAcknowledge).Times(0);
+
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = std::make_shared<StreamingSubscriptionBatchSource>(
+      background.cq(), shutdown, mock, subscription.FullName(), client_id,
+      TestSubscriptionOptions(), TestRetryPolicy(), TestBackoffPolicy(),
+      AckBatchingConfig(3, std::chrono::minutes(10), 100));
+
+  auto done = shutdown->Start({});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  success_stream.WaitForAction().set_value(true);  // Start()
+  success_stream.WaitForAction().set_value(true);  // Write()
+  success_stream.WaitForAction().set_value(true);  // Read()
+  auto last_read = success_stream.WaitForAction();
+
+  // The acks are held until there are enough of them to fill a `Write()`.
+  uut->AckMessage("fake-001");
+  uut->BulkAck({"fake-002"});
+  EXPECT_EQ(0, uut->ack_stats().acks);
+  uut->ExtendLeases({"fake-003"}, std::chrono::seconds(10));
+  success_stream.WaitForAction().set_value(true);  // Write()
+
+  auto const stats = uut->ack_stats();
+  EXPECT_EQ(2, stats.acks);
+  EXPECT_EQ(1, stats.stream_writes);
+  EXPECT_EQ(0, stats.unary_requests);
+  EXPECT_LE(stats.max_latency, stats.total_latency);
+
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  last_read.set_value(false);                      // Read()
+  success_stream.WaitForAction().set_value(true);  // Finish()
+
+  EXPECT_THAT(done.get(), IsOk());
+}
+
+TEST(StreamingSubscriptionBatchSourceTest, AckBurstUsesUnary) {
+  auto subscription = pubsub::Subscription("test-project", "test-subscription");
+  std::string const client_id = "fake-client-id";
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+
+  FakeStream success_stream(Status{});
+  EXPECT_CALL(*mock, AsyncStreamingPull)
+      .WillOnce([&](google::cloud::CompletionQueue& cq,
+                    std::unique_ptr<grpc::ClientContext> context,
+                    google::pubsub::v1::StreamingPullRequest const& request) {
+        return success_stream.MakeWriteFailureStream(cq, std::move(context),
+                                                     request);
+      });
+  EXPECT_CALL(*mock, AsyncAcknowledge(
+                         _, _,
+                         Property(&AckRequest::ack_ids,
+                                  ElementsAre("fake-001", "fake-002",
+                                              "fake-003"))))
+      .WillOnce(OnAck);
+
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = std::make_shared<StreamingSubscriptionBatchSource>(
+      background.cq(), shutdown, mock, subscription.FullName(), client_id,
+      TestSubscriptionOptions(), TestRetryPolicy(), TestBackoffPolicy(),
+      AckBatchingConfig(100, std::chrono::minutes(10), 3));
+
+  auto done = shutdown->Start({});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  success_stream.WaitForAction().set_value(true);  // Start()
+  success_stream.WaitForAction().set_value(true);  // Write()
+  success_stream.WaitForAction().set_value(true);  // Read()
+  auto last_read = success_stream.WaitForAction();
+
+  // The burst bypasses the stream, there is no `Write()` to satisfy.
+  uut->BulkAck({"fake-001", "fake-002", "fake-003"});
+
+  auto const stats = uut->ack_stats();
+  EXPECT_EQ(3, stats.acks);
+  EXPECT_EQ(0, stats.stream_writes);
+  EXPECT_EQ(1, stats.unary_requests);
+  EXPECT_EQ(0, stats.failed_acks);
+
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  last_read.set_value(false);                      // Read()
+  success_stream.WaitForAction().set_value(true);  // Finish()
+
+  EXPECT_THAT(done.get(), IsOk());
+}
+
+TEST(StreamingSubscriptionBatchSourceTest, PrefetchBufferPausesReads) {
+  auto subscription = pubsub::Subscription("test-project", "test-subscription");
+  std::string const client_id = "fake-client-id";
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+
+  FakeStream success_stream(Status{});
+  auto reads = std::make_shared<int>(0);
+  EXPECT_CALL(*mock, AsyncStreamingPull)
+      .WillOnce([&](google::cloud::CompletionQueue& cq,
+                    std::unique_ptr<grpc::ClientContext> context,
+                    google::pubsub::v1::StreamingPullRequest const& request) {
+        auto stream = success_stream.MakeWriteFailureStream(
+            cq, std::move(context), request);
+        // Each successful `Read()` returns two messages.
+        EXPECT_CALL(*stream, Read).WillRepeatedly([&success_stream, reads] {
+          auto const n = ++*reads;
+          return success_stream.AddAction("Read").then(
+              [n](future<bool> g) {
+                using Response = google::pubsub::v1::StreamingPullResponse;
+                if (!g.get()) return absl::optional<Response>{};
+                Response response;
+                for (auto i : {2 * n - 1, 2 * n}) {
+                  auto& m = *response.add_received_messages();
+                  m.set_ack_id("fake-00" + std::to_string(i));
+                  m.mutable_message()->set_data("data");
+                }
+                return absl::make_optional(std::move(response));
+              });
+        });
+        return stream;
+      });
+  EXPECT_CALL(*mock, AsyncAcknowledge).Times(2).WillRepeatedly(OnAck);
+
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  // With a single callback the buffer holds one message until the rate is
+  // known, so each `Read()` fills the buffer.
+  auto const options = TestSubscriptionOptions()
+                           .set_max_concurrency(1)
+                           .set_prefetch_buffer_time(std::chrono::seconds(1));
+  auto uut = std::make_shared<StreamingSubscriptionBatchSource>(
+      background.cq(), shutdown, mock, subscription.FullName(), client_id,
+      options, TestRetryPolicy(), TestBackoffPolicy(),
+      AckBatchingConfig(100, std::chrono::milliseconds(10), 1));
+
+  auto done = shutdown->Start({});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  success_stream.WaitForAction().set_value(true);  // Start()
+  success_stream.WaitForAction().set_value(true);  // Write()
+  success_stream.WaitForAction().set_value(true);  // Read()
+
+  // Handling the messages resumes the reads.
+  uut->AckMessage("fake-001");
+  uut->AckMessage("fake-002");
+  success_stream.WaitForAction().set_value(true);  // Read()
+  EXPECT_EQ(2, *reads);
+
+  // The shutdown resumes the paused reads, to finish the stream.
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  success_stream.WaitForAction().set_value(false);  // Read()
+  success_stream.WaitForAction().set_value(true);   // Finish()
+
+  EXPECT_THAT(done.get(), IsOk());
+}
+
 TEST(StreamingSubscriptionBatchSourceTest, ReadErrorWaitsForWrite) {
   auto subscription = pubsub::Subscription("test-project", "test-subscription");
   std::string const client_id = "fake-client-id";
@@ -107,6 +107,19 @@ SubscriberLogging::AsyncStreamingPull(
       std::move(stream), tracing_options_, request_id);
 }
 
+future<StatusOr<google::pubsub::v1::PullResponse>>
+SubscriberLogging::AsyncPull(google::cloud::CompletionQueue& cq,
+                             std::unique_ptr<grpc::ClientContext> context,
+                             google::pubsub::v1::PullRequest const& request) {
+  return LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::pubsub::v1::PullRequest const& request) {
+        return child_->AsyncPull(cq, std::move(context), request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
+
 future<Status> SubscriberLogging::AsyncAcknowledge(
     google::cloud::CompletionQueue& cq,
     std::unique_ptr<grpc::ClientContext> context,
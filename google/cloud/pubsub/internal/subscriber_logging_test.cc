@@ -193,6 +193,29 @@ TEST_F(SubscriberLoggingTest, AsyncStreamingPull) {
   EXPECT_THAT(log_.ExtractLines(), Contains(HasSubstr("Cancel")));
 }
 
+TEST_F(SubscriberLoggingTest, AsyncPull) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  EXPECT_CALL(*mock, AsyncPull)
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   google::pubsub::v1::PullRequest const&) {
+        return make_ready_future(
+            make_status_or(google::pubsub::v1::PullResponse{}));
+      });
+  SubscriberLogging stub(mock, TracingOptions{}.SetOptions("single_line_mode"),
+                         false);
+  google::cloud::CompletionQueue cq;
+  google::pubsub::v1::PullRequest request;
+  request.set_subscription("test-subscription-name");
+  auto response =
+      stub.AsyncPull(cq, absl::make_unique<grpc::ClientContext>(), request)
+          .get();
+  EXPECT_STATUS_OK(response);
+  EXPECT_THAT(log_.ExtractLines(),
+              Contains(AllOf(HasSubstr("AsyncPull"),
+                             HasSubstr("test-subscription-name"))));
+}
+
 TEST_F(SubscriberLoggingTest, AsyncAcknowledge) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
   EXPECT_CALL(*mock, AsyncAcknowledge)
@@ -164,6 +164,28 @@ TEST(SubscriberMetadataTest, AsyncStreamingPull) {
   EXPECT_TRUE(stream);
 }
 
+TEST(SubscriberMetadataTest, AsyncPull) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  EXPECT_CALL(*mock, AsyncPull)
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext> context,
+                   google::pubsub::v1::PullRequest const&) {
+        EXPECT_STATUS_OK(
+            IsContextMDValid(*context, "google.pubsub.v1.Subscriber.Pull",
+                             google::cloud::internal::ApiClientHeader()));
+        return make_ready_future(
+            make_status_or(google::pubsub::v1::PullResponse{}));
+      });
+  SubscriberMetadata stub(mock);
+  google::cloud::CompletionQueue cq;
+  google::pubsub::v1::PullRequest request;
+  request.set_subscription(
+      pubsub::Subscription("test-project", "test-subscription").FullName());
+  auto response =
+      stub.AsyncPull(cq, absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_STATUS_OK(response.get());
+}
+
 TEST(SubscriberMetadataTest, AsyncAcknowledge) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
   EXPECT_CALL(*mock, AsyncAcknowledge)
@@ -67,6 +67,13 @@ SubscriberRoundRobin::AsyncStreamingPull(
   return Child()->AsyncStreamingPull(cq, std::move(context), request);
 }
 
+future<StatusOr<google::pubsub::v1::PullResponse>>
+SubscriberRoundRobin::AsyncPull(google::cloud::CompletionQueue& cq,
+                                std::unique_ptr<grpc::ClientContext> context,
+                                google::pubsub::v1::PullRequest const& request) {
+  return Child()->AsyncPull(cq, std::move(context), request);
+}
+
 future<Status> SubscriberRoundRobin::AsyncAcknowledge(
     google::cloud::CompletionQueue& cq,
     std::unique_ptr<grpc::ClientContext> context,
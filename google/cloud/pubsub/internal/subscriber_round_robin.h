@@ -61,6 +61,11 @@ class SubscriberRoundRobin : public SubscriberStub {
       std::unique_ptr<grpc::ClientContext> context,
       google::pubsub::v1::StreamingPullRequest const& request) override;
 
+  future<StatusOr<google::pubsub::v1::PullResponse>> AsyncPull(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::pubsub::v1::PullRequest const& request) override;
+
   future<Status> AsyncAcknowledge(
       google::cloud::CompletionQueue& cq,
       std::unique_ptr<grpc::ClientContext> context,
@@ -178,6 +178,31 @@ TEST(SubscriberRoundRobinTest, AsyncStreamingPull) {
   }
 }
 
+TEST(SubscriberRoundRobinTest, AsyncPull) {
+  auto mocks = MakeMocks();
+  InSequence sequence;
+  for (int i = 0; i != kRepeats; ++i) {
+    for (auto& m : mocks) {
+      EXPECT_CALL(*m, AsyncPull)
+          .WillOnce([](google::cloud::CompletionQueue&,
+                       std::unique_ptr<grpc::ClientContext>,
+                       google::pubsub::v1::PullRequest const&) {
+            return make_ready_future(
+                make_status_or(google::pubsub::v1::PullResponse{}));
+          });
+    }
+  }
+  CompletionQueue cq;
+  SubscriberRoundRobin stub(AsPlainStubs(mocks));
+  for (std::size_t i = 0; i != kRepeats * mocks.size(); ++i) {
+    google::pubsub::v1::PullRequest request;
+    auto response =
+        stub.AsyncPull(cq, absl::make_unique<grpc::ClientContext>(), request)
+            .get();
+    EXPECT_STATUS_OK(response);
+  }
+}
+
 TEST(SubscriberRoundRobinTest, AsyncAcknowledge) {
   auto mocks = MakeMocks();
   InSequence sequence;
@@ -97,6 +97,19 @@ class DefaultSubscriberStub : public SubscriberStub {
         });
   }
 
+  future<StatusOr<google::pubsub::v1::PullResponse>> AsyncPull(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::pubsub::v1::PullRequest const& request) override {
+    return cq.MakeUnaryRpc(
+        [this](grpc::ClientContext* context,
+               google::pubsub::v1::PullRequest const& request,
+               grpc::CompletionQueue* cq) {
+          return grpc_stub_->AsyncPull(context, request, cq);
+        },
+        request, std::move(context));
+  }
+
   future<Status> AsyncAcknowledge(
       google::cloud::CompletionQueue& cq,
       std::unique_ptr<grpc::ClientContext> context,
@@ -80,6 +80,12 @@ class SubscriberStub {
       google::cloud::CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
       google::pubsub::v1::StreamingPullRequest const& request) = 0;
 
+  /// Pull a batch of messages using a unary request.
+  virtual future<StatusOr<google::pubsub::v1::PullResponse>> AsyncPull(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::pubsub::v1::PullRequest const& request) = 0;
+
   /// Acknowledge exactly one message.
   virtual future<Status> AsyncAcknowledge(
       google::cloud::CompletionQueue& cq,
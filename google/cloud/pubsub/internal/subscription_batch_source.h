@@ -69,6 +69,13 @@ class SubscriptionBatchSource {
    */
   virtual void NackMessage(std::string const& ack_id) = 0;
 
+  /**
+   * Positive acknowledgment of multiple messages.
+   *
+   * Typically generated by applications receiving batches of messages.
+   */
+  virtual void BulkAck(std::vector<std::string> ack_ids) = 0;
+
   /**
    * Negative acknowledgment of multiple messages.
    *
@@ -14,6 +14,7 @@
 
 #include "google/cloud/pubsub/internal/subscription_concurrency_control.h"
 #include "google/cloud/pubsub/ack_handler.h"
+#include "google/cloud/pubsub/batch_ack_handler.h"
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
 
@@ -45,12 +46,45 @@ class AckHandlerImpl : public pubsub::AckHandler::Impl {
   std::int32_t delivery_attempt_;
 };
 
+class BatchAckHandlerImpl : public pubsub::BatchAckHandler::Impl {
+ public:
+  explicit BatchAckHandlerImpl(std::weak_ptr<SubscriptionConcurrencyControl> w,
+                               std::vector<std::string> ack_ids)
+      : source_(std::move(w)), ack_ids_(std::move(ack_ids)) {}
+  ~BatchAckHandlerImpl() override = default;
+
+  void ack() override {
+    if (auto s = source_.lock()) s->BulkAck(std::move(ack_ids_));
+  }
+  void nack() override {
+    if (auto s = source_.lock()) s->BulkNack(std::move(ack_ids_));
+  }
+  std::size_t size() const override { return ack_ids_.size(); }
+
+ private:
+  std::weak_ptr<SubscriptionConcurrencyControl> source_;
+  std::vector<std::string> ack_ids_;
+};
+
 }  // namespace
 
 void SubscriptionConcurrencyControl::Start(pubsub::ApplicationCallback cb) {
   std::unique_lock<std::mutex> lk(mu_);
-  if (callback_) return;
+  if (callback_ || batch_callback_) return;
   callback_ = std::move(cb);
+  StartSource(std::move(lk));
+}
+
+void SubscriptionConcurrencyControl::Start(
+    pubsub::BatchApplicationCallback cb) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (callback_ || batch_callback_) return;
+  batch_callback_ = std::move(cb);
+  StartSource(std::move(lk));
+}
+
+void SubscriptionConcurrencyControl::StartSource(
+    std::unique_lock<std::mutex> lk) {
   std::weak_ptr<SubscriptionConcurrencyControl> weak = shared_from_this();
   source_->Start([weak](google::pubsub::v1::ReceivedMessage r) {
     if (auto self = weak.lock()) self->OnMessage(std::move(r));
@@ -69,18 +103,32 @@ void SubscriptionConcurrencyControl::Shutdown() {
 
 void SubscriptionConcurrencyControl::AckMessage(std::string const& ack_id) {
   source_->AckMessage(ack_id);
-  MessageHandled();
+  MessagesHandled(1);
 }
 
 void SubscriptionConcurrencyControl::NackMessage(std::string const& ack_id) {
   source_->NackMessage(ack_id);
-  MessageHandled();
+  MessagesHandled(1);
+}
+
+void SubscriptionConcurrencyControl::BulkAck(std::vector<std::string> ack_ids) {
+  auto const count = ack_ids.size();
+  source_->BulkAck(std::move(ack_ids));
+  MessagesHandled(count);
+}
+
+void SubscriptionConcurrencyControl::BulkNack(
+    std::vector<std::string> ack_ids) {
+  auto const count = ack_ids.size();
+  source_->BulkNack(std::move(ack_ids));
+  MessagesHandled(count);
 }
 
-void SubscriptionConcurrencyControl::MessageHandled() {
+// Each batch is a single "handler" operation, regardless of its size.
+void SubscriptionConcurrencyControl::MessagesHandled(std::size_t count) {
   if (shutdown_manager_->FinishedOperation("handler")) return;
   std::unique_lock<std::mutex> lk(mu_);
-  --message_count_;
+  message_count_ -= count;
   if (total_messages() < max_concurrency_) {
     auto const read_count = max_concurrency_ - total_messages();
     messages_requested_ += read_count;
@@ -94,6 +142,17 @@ void SubscriptionConcurrencyControl::OnMessage(
   std::unique_lock<std::mutex> lk(mu_);
   if (messages_requested_ > 0) --messages_requested_;
   ++message_count_;
+  if (batch_callback_) {
+    batch_.push_back(std::move(m));
+    if (batch_scheduled_) return;
+    batch_scheduled_ = true;
+    lk.unlock();
+    std::weak_ptr<SubscriptionConcurrencyControl> w = shared_from_this();
+    ScheduleCallback(__func__, [w] {
+      if (auto s = w.lock()) s->OnBatchAsync(w);
+    });
+    return;
+  }
   lk.unlock();
 
   struct MoveCapture {
@@ -103,8 +162,7 @@ void SubscriptionConcurrencyControl::OnMessage(
       if (auto s = w.lock()) s->OnMessageAsync(std::move(m), std::move(w));
     }
   };
-  shutdown_manager_->StartAsyncOperation(
-      __func__, "callback", cq_, MoveCapture{shared_from_this(), std::move(m)});
+  ScheduleCallback(__func__, MoveCapture{shared_from_this(), std::move(m)});
 }
 
 void SubscriptionConcurrencyControl::OnMessageAsync(
@@ -118,6 +176,42 @@ void SubscriptionConcurrencyControl::OnMessageAsync(
   shutdown_manager_->FinishedOperation("callback");
 }
 
+void SubscriptionConcurrencyControl::OnBatchAsync(
+    std::weak_ptr<SubscriptionConcurrencyControl> w) {
+  std::unique_lock<std::mutex> lk(mu_);
+  std::vector<google::pubsub::v1::ReceivedMessage> batch;
+  batch.swap(batch_);
+  batch_scheduled_ = false;
+  lk.unlock();
+  shutdown_manager_->StartOperation(__func__, "handler", [&] {
+    std::vector<pubsub::Message> messages;
+    std::vector<std::string> ack_ids;
+    messages.reserve(batch.size());
+    ack_ids.reserve(batch.size());
+    for (auto& m : batch) {
+      ack_ids.push_back(std::move(*m.mutable_ack_id()));
+      messages.push_back(FromProto(std::move(*m.mutable_message())));
+    }
+    pubsub::BatchAckHandler h(absl::make_unique<BatchAckHandlerImpl>(
+        std::move(w), std::move(ack_ids)));
+    batch_callback_(std::move(messages), std::move(h));
+  });
+  shutdown_manager_->FinishedOperation("callback");
+}
+
+void SubscriptionConcurrencyControl::ScheduleCallback(char const* caller,
+                                                      std::function<void()> f) {
+  if (!callback_executor_) {
+    shutdown_manager_->StartAsyncOperation(caller, "callback", cq_,
+                                           std::move(f));
+    return;
+  }
+  // The "callback" operation finishes when `f` runs, in `OnMessageAsync()` or
+  // `OnBatchAsync()`, as it does when `f` runs in `cq_`.
+  shutdown_manager_->StartOperation(caller, "callback",
+                                    [&] { callback_executor_(std::move(f)); });
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
 }  // namespace cloud
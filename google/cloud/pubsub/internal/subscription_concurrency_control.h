@@ -19,9 +19,12 @@
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscription_message_source.h"
 #include "google/cloud/pubsub/message.h"
+#include "google/cloud/pubsub/subscriber_options.h"
 #include "google/cloud/pubsub/version.h"
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -35,33 +38,53 @@ class SubscriptionConcurrencyControl
       google::cloud::CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionMessageSource> source,
-      std::size_t max_concurrency) {
+      std::size_t max_concurrency,
+      pubsub::SubscriberOptions::CallbackExecutor callback_executor = {}) {
     return std::shared_ptr<SubscriptionConcurrencyControl>(
-        new SubscriptionConcurrencyControl(std::move(cq),
-                                           std::move(shutdown_manager),
-                                           std::move(source), max_concurrency));
+        new SubscriptionConcurrencyControl(
+            std::move(cq), std::move(shutdown_manager), std::move(source),
+            max_concurrency, std::move(callback_executor)));
   }
 
   void Start(pubsub::ApplicationCallback);
+
+  /**
+   * Start delivering the messages in batches.
+   *
+   * Messages that arrive while a batch is scheduled are added to it, so each
+   * batch uses a single trip through the completion queue. The messages in a
+   * batch count against `max_concurrency` until the batch is acked or nacked.
+   */
+  void Start(pubsub::BatchApplicationCallback);
+
   void Shutdown();
   void AckMessage(std::string const& ack_id);
   void NackMessage(std::string const& ack_id);
+  void BulkAck(std::vector<std::string> ack_ids);
+  void BulkNack(std::vector<std::string> ack_ids);
 
  private:
   SubscriptionConcurrencyControl(
       google::cloud::CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionMessageSource> source,
-      std::size_t max_concurrency)
+      std::size_t max_concurrency,
+      pubsub::SubscriberOptions::CallbackExecutor callback_executor)
       : cq_(std::move(cq)),
         shutdown_manager_(std::move(shutdown_manager)),
         source_(std::move(source)),
-        max_concurrency_(max_concurrency) {}
+        max_concurrency_(max_concurrency),
+        callback_executor_(std::move(callback_executor)) {}
 
-  void MessageHandled();
+  void StartSource(std::unique_lock<std::mutex> lk);
+  void MessagesHandled(std::size_t count);
   void OnMessage(google::pubsub::v1::ReceivedMessage m);
   void OnMessageAsync(google::pubsub::v1::ReceivedMessage m,
                       std::weak_ptr<SubscriptionConcurrencyControl> w);
+  void OnBatchAsync(std::weak_ptr<SubscriptionConcurrencyControl> w);
+
+  /// Run @p f in the callback executor, or in `cq_` if there is none.
+  void ScheduleCallback(char const* caller, std::function<void()> f);
 
   std::size_t total_messages() const {
     return message_count_ + messages_requested_;
@@ -71,9 +94,13 @@ class SubscriptionConcurrencyControl
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::shared_ptr<SubscriptionMessageSource> const source_;
   std::size_t const max_concurrency_;
+  pubsub::SubscriberOptions::CallbackExecutor const callback_executor_;
 
   std::mutex mu_;
   pubsub::ApplicationCallback callback_;
+  pubsub::BatchApplicationCallback batch_callback_;
+  std::vector<google::pubsub::v1::ReceivedMessage> batch_;
+  bool batch_scheduled_ = false;
   std::size_t message_count_ = 0;
   std::size_t messages_requested_ = 0;
 };
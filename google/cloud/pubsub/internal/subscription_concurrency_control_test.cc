@@ -15,7 +15,9 @@
 #include "google/cloud/pubsub/internal/subscription_concurrency_control.h"
 #include "google/cloud/pubsub/internal/subscription_session.h"
 #include "google/cloud/pubsub/testing/mock_subscription_message_source.h"
+#include "google/cloud/pubsub/batch_ack_handler.h"
 #include "google/cloud/log.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <atomic>
@@ -30,8 +32,10 @@ namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 namespace {
 
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
 using ::google::cloud::testing_util::IsOk;
 using ::testing::AtLeast;
+using ::testing::ElementsAre;
 using ::testing::StartsWith;
 
 class SubscriptionConcurrencyControlTest : public ::testing::Test {
@@ -502,6 +506,146 @@ TEST_F(SubscriptionConcurrencyControlTest, MessageContents) {
   EXPECT_THAT(done.get(), IsOk());
 }
 
+/// @test Verify messages pushed before the callback runs are batched.
+/// @test Verify the callbacks run in the application-supplied executor.
+TEST_F(SubscriptionConcurrencyControlTest, CallbackExecutor) {
+  auto constexpr kMessageCount = 8;
+  auto source =
+      std::make_shared<pubsub_testing::MockSubscriptionMessageSource>();
+  MessageCallback message_callback;
+  PrepareMessages("ack-", kMessageCount);
+  auto push_messages = [&](std::size_t n) {
+    PushMessages(message_callback, n);
+  };
+  EXPECT_CALL(*source, Start).WillOnce([&message_callback](MessageCallback cb) {
+    message_callback = std::move(cb);
+  });
+  EXPECT_CALL(*source, Read).WillRepeatedly(push_messages);
+  EXPECT_CALL(*source, AckMessage).Times(kMessageCount);
+  EXPECT_CALL(*source, Shutdown).Times(1);
+
+  // A single-threaded executor, running the functions in the order received.
+  std::mutex executor_mu;
+  std::condition_variable executor_cv;
+  std::deque<std::function<void()>> work;
+  bool executor_done = false;
+  std::thread executor_thread([&] {
+    std::unique_lock<std::mutex> lk(executor_mu);
+    for (;;) {
+      executor_cv.wait(lk, [&] { return executor_done || !work.empty(); });
+      if (work.empty()) return;
+      auto f = std::move(work.front());
+      work.pop_front();
+      lk.unlock();
+      f();
+      lk.lock();
+    }
+  });
+  auto executor = [&](std::function<void()> f) {
+    std::lock_guard<std::mutex> lk(executor_mu);
+    work.push_back(std::move(f));
+    executor_cv.notify_one();
+  };
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionConcurrencyControl::Create(
+      background.cq(), shutdown, source, /*max_concurrency=*/2, executor);
+
+  std::mutex handler_mu;
+  std::condition_variable handler_cv;
+  std::vector<std::thread::id> callback_threads;
+  auto handler = [&](pubsub::Message const&, pubsub::AckHandler h) {
+    std::move(h).ack();
+    std::lock_guard<std::mutex> lk(handler_mu);
+    callback_threads.push_back(std::this_thread::get_id());
+    handler_cv.notify_one();
+  };
+
+  auto done = shutdown->Start({});
+  uut->Start(handler);
+  {
+    std::unique_lock<std::mutex> lk(handler_mu);
+    handler_cv.wait(lk, [&] {
+      return callback_threads.size() == static_cast<std::size_t>(kMessageCount);
+    });
+  }
+  for (auto const& id : callback_threads) {
+    EXPECT_EQ(executor_thread.get_id(), id);
+  }
+
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  EXPECT_THAT(done.get(), IsOk());
+  {
+    std::lock_guard<std::mutex> lk(executor_mu);
+    executor_done = true;
+    executor_cv.notify_one();
+  }
+  executor_thread.join();
+}
+
+TEST_F(SubscriptionConcurrencyControlTest, BatchLifecycle) {
+  auto source =
+      std::make_shared<pubsub_testing::MockSubscriptionMessageSource>();
+  MessageCallback message_callback;
+  auto push_messages = [&](std::size_t n) {
+    PushMessages(message_callback, n);
+  };
+  PrepareMessages("ack-0-", 5);
+  EXPECT_CALL(*source, Shutdown).Times(1);
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*source, Start)
+        .WillOnce([&message_callback](MessageCallback cb) {
+          message_callback = std::move(cb);
+        });
+    EXPECT_CALL(*source, Read(4)).WillOnce(push_messages);
+    EXPECT_CALL(*source, BulkAck(ElementsAre("ack-0-0", "ack-0-1", "ack-0-2",
+                                             "ack-0-3")));
+    EXPECT_CALL(*source, Read(4)).WillOnce(push_messages);
+    EXPECT_CALL(*source, BulkNack(ElementsAre("ack-0-4")));
+    EXPECT_CALL(*source, Read(1));
+  }
+
+  // Use a fake completion queue to control when the callbacks run.
+  auto fake_cq = std::make_shared<FakeCompletionQueueImpl>();
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionConcurrencyControl::Create(
+      CompletionQueue(fake_cq), shutdown, source, /*max_concurrency=*/4);
+
+  std::vector<std::vector<std::string>> batches;
+  std::vector<pubsub::BatchAckHandler> handlers;
+  auto handler = [&](std::vector<pubsub::Message> messages,
+                     pubsub::BatchAckHandler h) {
+    std::vector<std::string> ids;
+    for (auto const& m : messages) ids.push_back(m.message_id());
+    batches.push_back(std::move(ids));
+    EXPECT_EQ(batches.back().size(), h.size());
+    handlers.push_back(std::move(h));
+  };
+
+  auto done = shutdown->Start({});
+  uut->Start(pubsub::BatchApplicationCallback(handler));
+  // All the messages pushed so far are delivered in a single callback.
+  ASSERT_EQ(1U, fake_cq->size());
+  fake_cq->SimulateCompletion(true);
+  ASSERT_EQ(1U, handlers.size());
+  EXPECT_THAT(batches[0], ElementsAre("message:ack-0-0", "message:ack-0-1",
+                                      "message:ack-0-2", "message:ack-0-3"));
+
+  std::move(handlers[0]).ack();
+  ASSERT_EQ(1U, fake_cq->size());
+  fake_cq->SimulateCompletion(true);
+  ASSERT_EQ(2U, handlers.size());
+  EXPECT_THAT(batches[1], ElementsAre("message:ack-0-4"));
+  std::move(handlers[1]).nack();
+
+  shutdown->MarkAsShutdown(__func__, {});
+  uut->Shutdown();
+  EXPECT_THAT(done.get(), IsOk());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
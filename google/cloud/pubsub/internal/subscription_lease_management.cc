@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/subscription_lease_management.h"
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <map>
 
 namespace google {
 namespace cloud {
@@ -22,6 +25,13 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
 std::chrono::seconds constexpr SubscriptionLeaseManagement::kMinimumAckDeadline;
 std::chrono::seconds constexpr SubscriptionLeaseManagement::kAckDeadlineSlack;
+std::chrono::seconds constexpr SubscriptionLeaseManagement::kLeaseRefreshWindow;
+
+namespace {
+// The percentile of the ack latency used to extend the leases, this matches
+// the behavior of the Java and Go client libraries.
+auto constexpr kAckLatencyPercentile = 99.0;
+}  // namespace
 
 void SubscriptionLeaseManagement::Start(BatchCallback cb) {
   auto weak = std::weak_ptr<SubscriptionLeaseManagement>(shared_from_this());
@@ -42,8 +52,9 @@ void SubscriptionLeaseManagement::Shutdown() {
 }
 
 void SubscriptionLeaseManagement::AckMessage(std::string const& ack_id) {
+  auto const now = ToLeaseTime(std::chrono::system_clock::now());
   std::unique_lock<std::mutex> lk(mu_);
-  leases_.erase(ack_id);
+  RecordAck(ack_id, now);
   lk.unlock();
   child_->AckMessage(ack_id);
 }
@@ -55,6 +66,14 @@ void SubscriptionLeaseManagement::NackMessage(std::string const& ack_id) {
   child_->NackMessage(ack_id);
 }
 
+void SubscriptionLeaseManagement::BulkAck(std::vector<std::string> ack_ids) {
+  auto const now = ToLeaseTime(std::chrono::system_clock::now());
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto const& id : ack_ids) RecordAck(id, now);
+  lk.unlock();
+  child_->BulkAck(std::move(ack_ids));
+}
+
 void SubscriptionLeaseManagement::BulkNack(std::vector<std::string> ack_ids) {
   std::unique_lock<std::mutex> lk(mu_);
   for (auto const& id : ack_ids) leases_.erase(id);
@@ -79,53 +98,63 @@ void SubscriptionLeaseManagement::OnRead(
   }
   std::unique_lock<std::mutex> lk(mu_);
   auto const now = std::chrono::system_clock::now();
-  auto const estimated_server_deadline = now + std::chrono::seconds(10);
-  auto const handling_deadline = now + max_deadline_time_;
+  auto const received = ToLeaseTime(now);
+  auto const estimated_server_deadline = ToLeaseTime(now + kMinimumAckDeadline);
+  auto const handling_deadline = ToLeaseTime(now + max_deadline_time_);
   for (auto const& rm : response->received_messages()) {
     leases_.emplace(rm.ack_id(),
-                    LeaseStatus{estimated_server_deadline, handling_deadline});
+                    LeaseStatus{received, estimated_server_deadline,
+                                handling_deadline});
   }
   // Setup a timer to refresh the message leases. We do not want to immediately
   // refresh them because there is a good chance they will be handled before
   // the minimum lease time, and it seems wasteful to refresh the lease just to
   // quickly turnaround and ack or nack the message.
-  StartRefreshTimer(std::move(lk),
-                    std::chrono::system_clock::now() + kMinimumAckDeadline);
+  StartRefreshTimer(std::move(lk), FromLeaseTime(estimated_server_deadline));
 }
 
 void SubscriptionLeaseManagement::RefreshMessageLeases(
     std::unique_lock<std::mutex> lk) {
-  using seconds = std::chrono::seconds;
-
-  if (leases_.empty() || refreshing_leases_) return;
+  if (leases_.empty()) return;
 
-  std::vector<std::string> ack_ids;
-  ack_ids.reserve(leases_.size());
-  auto extension = max_deadline_extension_;
   auto const now = std::chrono::system_clock::now();
-  for (auto const& kv : leases_) {
+  auto const lease_now = ToLeaseTime(now);
+  auto const extension = LeaseExtension();
+  // Only extend the leases that expire soon after this refresh was scheduled.
+  // The other leases were extended recently, or were received recently, and
+  // including them would only add RPC traffic.
+  auto const horizon = ToLeaseTime((std::max)(now, refresh_deadline_) +
+                                   kAckDeadlineSlack + kLeaseRefreshWindow);
+  auto next_deadline = (std::numeric_limits<std::uint32_t>::max)();
+  std::map<std::chrono::seconds, std::vector<std::string>> extensions;
+  for (auto& kv : leases_) {
+    auto& lease = kv.second;
+    if (lease.estimated_server_deadline > horizon) {
+      next_deadline =
+          (std::min)(next_deadline, lease.estimated_server_deadline);
+      continue;
+    }
     // This message lease cannot be extended any further, and we do not want to
     // send an extension of 0 seconds because that is a nack.
-    if (kv.second.handling_deadline < now + seconds(1)) continue;
-    auto const message_extension =
-        std::chrono::duration_cast<seconds>(kv.second.handling_deadline - now);
-    extension = (std::min)(extension, message_extension);
-    ack_ids.push_back(kv.first);
+    if (lease.handling_deadline < lease_now + 1) continue;
+    auto const message_extension = (std::min)(
+        extension, std::chrono::seconds(lease.handling_deadline - lease_now));
+    extensions[message_extension].push_back(kv.first);
+    lease.estimated_server_deadline =
+        lease_now + static_cast<std::uint32_t>(message_extension.count());
+    next_deadline = (std::min)(next_deadline, lease.estimated_server_deadline);
   }
-  auto const new_deadline = now + extension;
-  if (ack_ids.empty()) {
-    StartRefreshTimer(std::move(lk), new_deadline);
-    return;
-  }
-  lk.unlock();
-  child_->ExtendLeases(ack_ids, extension);
-  lk.lock();
-  for (auto const& ack : ack_ids) {
-    auto i = leases_.find(ack);
-    if (i == leases_.end()) continue;
-    i->second.estimated_server_deadline = new_deadline;
+  if (!extensions.empty()) {
+    lk.unlock();
+    for (auto& kv : extensions) {
+      child_->ExtendLeases(std::move(kv.second), kv.first);
+    }
+    lk.lock();
   }
-  StartRefreshTimer(std::move(lk), new_deadline);
+  // None of the leases can be extended, no need for a timer. New messages
+  // will start a new timer.
+  if (next_deadline == (std::numeric_limits<std::uint32_t>::max)()) return;
+  StartRefreshTimer(std::move(lk), FromLeaseTime(next_deadline));
 }
 
 void SubscriptionLeaseManagement::StartRefreshTimer(
@@ -133,6 +162,10 @@ void SubscriptionLeaseManagement::StartRefreshTimer(
     std::chrono::system_clock::time_point new_server_deadline) {
   std::weak_ptr<SubscriptionLeaseManagement> weak = shared_from_this();
   auto deadline = new_server_deadline - kAckDeadlineSlack;
+  // There is already a timer that will fire before it is needed.
+  if (refresh_pending_ && refresh_deadline_ <= deadline) return;
+  refresh_pending_ = true;
+  refresh_deadline_ = deadline;
 
   shutdown_manager_->StartOperation(__func__, "OnRefreshTimer", [&] {
     using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
@@ -146,8 +179,12 @@ void SubscriptionLeaseManagement::StartRefreshTimer(
 
 void SubscriptionLeaseManagement::OnRefreshTimer(bool cancelled) {
   if (shutdown_manager_->FinishedOperation(__func__)) return;
+  // A cancelled timer was replaced by a new one, or the session is shutting
+  // down, in either case there is nothing to do.
   if (cancelled) return;
-  RefreshMessageLeases(std::unique_lock<std::mutex>(mu_));
+  std::unique_lock<std::mutex> lk(mu_);
+  refresh_pending_ = false;
+  RefreshMessageLeases(std::move(lk));
 }
 
 void SubscriptionLeaseManagement::NackAll(std::unique_lock<std::mutex> lk) {
@@ -161,6 +198,33 @@ void SubscriptionLeaseManagement::NackAll(std::unique_lock<std::mutex> lk) {
   BulkNack(std::move(ack_ids));
 }
 
+void SubscriptionLeaseManagement::RecordAck(std::string const& ack_id,
+                                            std::uint32_t now) {
+  auto i = leases_.find(ack_id);
+  if (i == leases_.end()) return;
+  ack_latency_.Record(std::chrono::seconds(
+      static_cast<std::int64_t>(now) - std::int64_t{i->second.received}));
+  leases_.erase(i);
+}
+
+std::chrono::seconds SubscriptionLeaseManagement::LeaseExtension() const {
+  auto const latency = ack_latency_.Percentile(kAckLatencyPercentile);
+  return (std::min)(max_deadline_extension_,
+                    (std::max)(kMinimumAckDeadline, latency));
+}
+
+std::uint32_t SubscriptionLeaseManagement::ToLeaseTime(
+    std::chrono::system_clock::time_point tp) const {
+  auto const d = std::chrono::duration_cast<std::chrono::seconds>(tp - epoch_);
+  if (d.count() <= 0) return 0;
+  return static_cast<std::uint32_t>(d.count());
+}
+
+std::chrono::system_clock::time_point
+SubscriptionLeaseManagement::FromLeaseTime(std::uint32_t t) const {
+  return epoch_ + std::chrono::seconds(t);
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
 }  // namespace cloud
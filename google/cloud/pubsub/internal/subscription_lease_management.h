@@ -15,13 +15,16 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_LEASE_MANAGEMENT_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_LEASE_MANAGEMENT_H
 
+#include "google/cloud/pubsub/internal/ack_latency_distribution.h"
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/internal/subscription_batch_source.h"
 #include "google/cloud/pubsub/version.h"
 #include "google/cloud/internal/absl_flat_hash_map_quiet.h"
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -30,12 +33,27 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * Automatically extends the leases for messages that are not yet handled.
+ *
+ * The lease extensions adapt to the application: the class tracks the
+ * distribution of the time to ack each message, and extends the leases by the
+ * 99th percentile of that distribution, clamped between `kMinimumAckDeadline`
+ * and the configured maximum extension. If the application acks most messages
+ * quickly, then messages lost by the application are redelivered sooner.
+ *
+ * Each refresh only extends the leases that are about to expire, leases that
+ * were extended recently are left alone. The leases extended in a refresh are
+ * grouped into as few `ExtendLeases()` calls as possible, one per distinct
+ * extension.
+ */
 class SubscriptionLeaseManagement
     : public SubscriptionBatchSource,
       public std::enable_shared_from_this<SubscriptionLeaseManagement> {
  public:
   static auto constexpr kAckDeadlineSlack = std::chrono::seconds(2);
   static auto constexpr kMinimumAckDeadline = std::chrono::seconds(10);
+  static auto constexpr kLeaseRefreshWindow = std::chrono::seconds(5);
 
   static std::shared_ptr<SubscriptionLeaseManagement> Create(
       google::cloud::CompletionQueue cq,
@@ -53,6 +71,7 @@ class SubscriptionLeaseManagement
   void Shutdown() override;
   void AckMessage(std::string const& ack_id) override;
   void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
   void BulkNack(std::vector<std::string> ack_ids) override;
   void ExtendLeases(std::vector<std::string> ack_ids,
                     std::chrono::seconds extension) override;
@@ -68,7 +87,9 @@ class SubscriptionLeaseManagement
         child_(std::move(child)),
         shutdown_manager_(std::move(shutdown_manager)),
         max_deadline_time_(max_deadline_time),
-        max_deadline_extension_(max_deadline_extension) {}
+        max_deadline_extension_(max_deadline_extension),
+        epoch_(std::chrono::system_clock::now()),
+        ack_latency_(max_deadline_extension) {}
 
   void OnRead(
       StatusOr<google::pubsub::v1::StreamingPullResponse> const& response);
@@ -86,22 +107,38 @@ class SubscriptionLeaseManagement
 
   void NackAll(std::unique_lock<std::mutex> lk);
 
+  /// Stop tracking the lease for @p ack_id, and record its ack latency.
+  void RecordAck(std::string const& ack_id, std::uint32_t now);
+
+  /// The extension for message leases, based on the ack latency distribution.
+  std::chrono::seconds LeaseExtension() const;
+
+  /// Convert between time points and the (more compact) lease timestamps.
+  std::uint32_t ToLeaseTime(std::chrono::system_clock::time_point tp) const;
+  std::chrono::system_clock::time_point FromLeaseTime(std::uint32_t t) const;
+
   google::cloud::CompletionQueue cq_;
   std::shared_ptr<SubscriptionBatchSource> const child_;
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::chrono::seconds const max_deadline_time_;
   std::chrono::seconds const max_deadline_extension_;
+  std::chrono::system_clock::time_point const epoch_;
 
   std::mutex mu_;
 
-  // A collection of message ack_ids to maintain the message leases.
+  // A collection of message ack_ids to maintain the message leases. The ack_ids
+  // are needed to extend the leases, but the times are stored as seconds since
+  // `epoch_`, which is precise enough and keeps each entry small.
   struct LeaseStatus {
-    std::chrono::system_clock::time_point estimated_server_deadline;
-    std::chrono::system_clock::time_point handling_deadline;
+    std::uint32_t received;
+    std::uint32_t estimated_server_deadline;
+    std::uint32_t handling_deadline;
   };
   absl::flat_hash_map<std::string, LeaseStatus> leases_;
+  AckLatencyDistribution ack_latency_;
 
-  bool refreshing_leases_ = false;
+  bool refresh_pending_ = false;
+  std::chrono::system_clock::time_point refresh_deadline_;
   future<void> refresh_timer_;
 };
 
@@ -65,7 +65,10 @@ TEST(SubscriptionLeaseManagementTest, NormalLifecycle) {
         .WillOnce([&](std::vector<std::string> const& ack_ids,
                       std::chrono::seconds extension) {
           EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-0-0", "ack-0-2"));
-          EXPECT_LE(std::abs((kTestDeadline - extension).count()), 2);
+          // The acked message was handled quickly, so the leases are extended
+          // by the minimum.
+          EXPECT_EQ(SubscriptionLeaseManagement::kMinimumAckDeadline,
+                    extension);
           return make_ready_future(Status{});
         });
     // Then a message is nacked.
@@ -75,7 +78,8 @@ TEST(SubscriptionLeaseManagementTest, NormalLifecycle) {
         .WillOnce([&](std::vector<std::string> const& ack_ids,
                       std::chrono::seconds extension) {
           EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-0-0"));
-          EXPECT_LE(std::abs((kTestDeadline - extension).count()), 2);
+          EXPECT_EQ(SubscriptionLeaseManagement::kMinimumAckDeadline,
+                    extension);
           return make_ready_future(Status{});
         });
     // Then all unhandled messages are nacked on shutdown.
@@ -160,7 +164,8 @@ TEST(SubscriptionLeaseManagementTest, DoesNotPropagateExtendLeases) {
   uut->ExtendLeases({"a", "b", "c"}, std::chrono::seconds(10));
 }
 
-TEST(SubscriptionLeaseManagementTest, UsesDeadlineExtension) {
+/// @test Verify leases are extended by the minimum when there is no history.
+TEST(SubscriptionLeaseManagementTest, UsesMinimumExtension) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
   BatchCallback batch_callback;
   EXPECT_CALL(*mock, Start).WillOnce([&](BatchCallback cb) {
@@ -169,6 +174,59 @@ TEST(SubscriptionLeaseManagementTest, UsesDeadlineExtension) {
 
   auto constexpr kTestDeadline = std::chrono::seconds(345);
   auto constexpr kTestExtension = std::chrono::seconds(100);
+  {
+    ::testing::InSequence sequence;
+    // All the messages are extended in a single call.
+    EXPECT_CALL(*mock, ExtendLeases)
+        .WillOnce([&](std::vector<std::string> const& ack_ids,
+                      std::chrono::seconds extension) {
+          EXPECT_THAT(ack_ids,
+                      UnorderedElementsAre("ack-0-0", "ack-0-1", "ack-1-0"));
+          EXPECT_EQ(SubscriptionLeaseManagement::kMinimumAckDeadline,
+                    extension);
+          return make_ready_future(Status{});
+        });
+    EXPECT_CALL(*mock, BulkNack)
+        .WillOnce([](std::vector<std::string> const&) {
+          return make_ready_future(Status{});
+        });
+    EXPECT_CALL(*mock, Shutdown).Times(1);
+  }
+
+  auto fake_cq = std::make_shared<FakeCompletionQueueImpl>();
+  CompletionQueue cq(fake_cq);
+
+  auto shutdown_manager = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionLeaseManagement::Create(cq, shutdown_manager, mock,
+                                                 kTestDeadline, kTestExtension);
+
+  auto done = shutdown_manager->Start({});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+
+  // The second batch does not need a new timer.
+  batch_callback(GenerateMessages("0-", 2));
+  batch_callback(GenerateMessages("1-", 1));
+  ASSERT_EQ(1U, fake_cq->size());
+
+  fake_cq->SimulateCompletion(true);
+  ASSERT_EQ(1U, fake_cq->size());
+
+  shutdown_manager->MarkAsShutdown(__func__, Status{});
+  uut->Shutdown();
+  fake_cq->SimulateCompletion(false);
+  ASSERT_EQ(0U, fake_cq->size());
+  EXPECT_THAT(done.get(), IsOk());
+}
+
+TEST(SubscriptionLeaseManagementTest, LimitedByHandlingDeadline) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback batch_callback;
+  EXPECT_CALL(*mock, Start).WillOnce([&](BatchCallback cb) {
+    batch_callback = std::move(cb);
+  });
+
+  auto constexpr kTestDeadline = std::chrono::seconds(5);
+  auto constexpr kTestExtension = std::chrono::seconds(100);
   {
     ::testing::InSequence sequence;
     // No messages acked.
@@ -177,7 +235,7 @@ TEST(SubscriptionLeaseManagementTest, UsesDeadlineExtension) {
         .WillOnce([&](std::vector<std::string> const& ack_ids,
                       std::chrono::seconds extension) {
           EXPECT_THAT(ack_ids, UnorderedElementsAre("ack-0-0"));
-          EXPECT_LE(std::abs((kTestExtension - extension).count()), 2);
+          EXPECT_LE(std::abs((kTestDeadline - extension).count()), 2);
           return make_ready_future(Status{});
         });
     // Then the unhandled message is nacked on shutdown.
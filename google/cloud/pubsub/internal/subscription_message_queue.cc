@@ -15,12 +15,15 @@
 #include "google/cloud/pubsub/internal/subscription_message_queue.h"
 #include "google/cloud/pubsub/message.h"
 #include <algorithm>
+#include <iterator>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+std::size_t constexpr SubscriptionMessageQueue::kShardCount;
+
 void SubscriptionMessageQueue::Start(MessageCallback cb) {
   std::unique_lock<std::mutex> lk(mu_);
   if (callback_) return;
@@ -54,47 +57,74 @@ void SubscriptionMessageQueue::NackMessage(std::string const& ack_id) {
   source_->NackMessage(ack_id);
 }
 
+void SubscriptionMessageQueue::BulkAck(std::vector<std::string> ack_ids) {
+  for (auto const& a : ack_ids) HandlerDone(a);
+  source_->BulkAck(std::move(ack_ids));
+}
+
+void SubscriptionMessageQueue::BulkNack(std::vector<std::string> ack_ids) {
+  for (auto const& a : ack_ids) HandlerDone(a);
+  source_->BulkNack(std::move(ack_ids));
+}
+
 void SubscriptionMessageQueue::OnRead(
     StatusOr<google::pubsub::v1::StreamingPullResponse> r) {
-  std::unique_lock<std::mutex> lk(mu_);
   if (!r) {
     shutdown_manager_->MarkAsShutdown(__func__, std::move(r).status());
-    Shutdown(std::move(lk));
+    Shutdown(std::unique_lock<std::mutex>(mu_));
     return;
   }
-  OnRead(std::move(lk), *std::move(r));
+  OnRead(*std::move(r));
 }
 
 void SubscriptionMessageQueue::OnRead(
-    std::unique_lock<std::mutex> lk,
     google::pubsub::v1::StreamingPullResponse r) {
   auto handle_response = [&] {
     shutdown_manager_->FinishedOperation("OnRead");
+    std::vector<google::pubsub::v1::ReceivedMessage> runnable;
+    std::vector<std::string> rejected;
     for (auto& m : *r.mutable_received_messages()) {
-      auto key = m.message().ordering_key();
+      auto const& key = m.message().ordering_key();
       if (key.empty()) {
         // Empty key, requires no ordering and therefore immediately runnable.
-        runnable_messages_.push_back(std::move(m));
+        runnable.push_back(std::move(m));
         continue;
       }
       // The message requires ordering, find out if there is an existing queue
       // for its ordering key, and insert one if necessary.
-      auto loc = queues_.insert({key, {}});
+      auto const id = MakeOrderingKeyId(key);
+      auto& shard = ShardFor(id);
+      std::lock_guard<std::mutex> lk(shard.mu);
+      if (shard.shutdown) {
+        rejected.push_back(std::move(*m.mutable_ack_id()));
+        continue;
+      }
+      auto loc = shard.queues.insert({id, {}});
       // There is no queue for this ordering key, that means no other messages
       // are present, we can push the message to the runnable queue. We leave
       // the per-ordering-key queue as a marker for any other incoming messages
       // with the same ordering key.
       if (loc.second) {
-        runnable_messages_.push_back(std::move(m));
+        runnable.push_back(std::move(m));
         continue;
       }
       // Insert the messages into the existing queue.
       loc.first->second.push_back(std::move(m));
     }
-    DrainQueue(std::move(lk));
+    std::unique_lock<std::mutex> lk(mu_);
+    if (shutdown_) {
+      lk.unlock();
+      for (auto& m : runnable) {
+        rejected.push_back(std::move(*m.mutable_ack_id()));
+      }
+    } else {
+      std::move(runnable.begin(), runnable.end(),
+                std::back_inserter(runnable_messages_));
+      DrainQueue(std::move(lk));
+    }
+    if (!rejected.empty()) source_->BulkNack(std::move(rejected));
   };
   auto bulk_nack = [&] {
-    lk.unlock();
     std::vector<std::string> ack_ids(r.mutable_received_messages()->size());
     std::transform(r.mutable_received_messages()->begin(),
                    r.mutable_received_messages()->end(), ack_ids.begin(),
@@ -111,17 +141,20 @@ void SubscriptionMessageQueue::OnRead(
 void SubscriptionMessageQueue::Shutdown(std::unique_lock<std::mutex> lk) {
   shutdown_ = true;
   available_slots_ = 0;
-  QueueByOrderingKey queues;
-  queues.swap(queues_);
   std::deque<google::pubsub::v1::ReceivedMessage> runnable_messages;
   runnable_messages.swap(runnable_messages_);
   lk.unlock();
 
   std::vector<std::string> ack_ids;
-  for (auto& kv : queues) {
-    for (auto& m : kv.second) {
-      ack_ids.push_back(std::move(*m.mutable_ack_id()));
+  for (auto& shard : queues_) {
+    std::unique_lock<std::mutex> shard_lk(shard.mu);
+    shard.shutdown = true;
+    for (auto& kv : shard.queues) {
+      for (auto& m : kv.second) {
+        ack_ids.push_back(std::move(*m.mutable_ack_id()));
+      }
     }
+    shard.queues.clear();
   }
   for (auto& m : runnable_messages) {
     ack_ids.push_back(std::move(*m.mutable_ack_id()));
@@ -136,43 +169,64 @@ void SubscriptionMessageQueue::DrainQueue(std::unique_lock<std::mutex> lk) {
     auto m = std::move(runnable_messages_.front());
     runnable_messages_.pop_front();
     --available_slots_;
+    // Don't hold a lock during the callback, as the callee may call `Read()`
+    // or something similar.
+    lk.unlock();
     // No need to track messages without an ordering key, as there is no action
     // to take in their HandlerDone() member function.
     if (!m.message().ordering_key().empty()) {
-      ordering_key_by_ack_id_[m.ack_id()] = m.message().ordering_key();
+      auto& shard = ShardFor(m.ack_id());
+      std::lock_guard<std::mutex> shard_lk(shard.mu);
+      shard.ordering_key_by_ack_id[m.ack_id()] =
+          MakeOrderingKeyId(m.message().ordering_key());
     }
-    // Don't hold a lock during the callback, as the callee may call `Read()`
-    // or something similar.
-    lk.unlock();
     callback_(std::move(m));
     lk.lock();
   }
 }
 
 void SubscriptionMessageQueue::HandlerDone(std::string const& ack_id) {
-  std::unique_lock<std::mutex> lk(mu_);
   // Find out the ordering key for this message.
-  auto loc = ordering_key_by_ack_id_.find(ack_id);
+  auto& ack_id_shard = ShardFor(ack_id);
+  std::unique_lock<std::mutex> ack_id_lk(ack_id_shard.mu);
+  auto loc = ack_id_shard.ordering_key_by_ack_id.find(ack_id);
   // Messages without an ordering key are not inserted in the collection (see
   // `DrainQueue()`), so this happens routinely.
-  if (loc == ordering_key_by_ack_id_.end()) return;
-  auto key = std::move(loc->second);
-  ordering_key_by_ack_id_.erase(loc);
-  auto ql = queues_.find(key);
+  if (loc == ack_id_shard.ordering_key_by_ack_id.end()) return;
+  auto const id = loc->second;
+  ack_id_shard.ordering_key_by_ack_id.erase(loc);
+  ack_id_lk.unlock();
+
+  auto& shard = ShardFor(id);
+  std::unique_lock<std::mutex> shard_lk(shard.mu);
+  auto ql = shard.queues.find(id);
   // This is purely defensive, but should not happen.
-  if (ql == queues_.end()) return;
+  if (ql == shard.queues.end()) return;
   if (ql->second.empty()) {
     // There are no more messages for this ordering key, remove the queue, as it
     // also serves as a marker to order the next message.
-    queues_.erase(ql);
+    shard.queues.erase(ql);
     return;
   }
   auto m = std::move(ql->second.front());
   ql->second.pop_front();
+  shard_lk.unlock();
+
+  std::unique_lock<std::mutex> lk(mu_);
   runnable_messages_.push_back(std::move(m));
   DrainQueue(std::move(lk));
 }
 
+SubscriptionMessageQueue::OrderingKeyId
+SubscriptionMessageQueue::MakeOrderingKeyId(std::string const& ordering_key) {
+  return absl::Hash<std::string>{}(ordering_key);
+}
+
+SubscriptionMessageQueue::AckIdShard& SubscriptionMessageQueue::ShardFor(
+    std::string const& ack_id) {
+  return ack_ids_[absl::Hash<std::string>{}(ack_id) % kShardCount];
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
 }  // namespace cloud
@@ -22,10 +22,12 @@
 #include "google/cloud/internal/absl_flat_hash_map_quiet.h"
 #include "google/cloud/internal/random.h"
 #include <google/pubsub/v1/pubsub.pb.h>
+#include <array>
 #include <deque>
 #include <functional>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -56,6 +58,14 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
  * For messages with an ordering key, this class also maintains a mapping of
  * ack_id to ordering key. This is necessary to determine which ordering key
  * queue is drained when the message is acknowledged or rejected.
+ *
+ * Subscriptions with many ordering keys and many callback threads update these
+ * structures often, so they are sharded, each shard with its own mutex: the
+ * per-ordering-key queues are sharded by the hash of the ordering key, and the
+ * ack_id mapping by the hash of the ack_id. The mapping stores the hash of the
+ * ordering key, which also serves as its identifier, instead of a copy of the
+ * key. Two keys with the same hash share a queue: their messages are still
+ * delivered in order, but not in parallel with each other.
  */
 class SubscriptionMessageQueue
     : public SubscriptionMessageSource,
@@ -74,6 +84,8 @@ class SubscriptionMessageQueue
   void Read(std::size_t max_callbacks) override;
   void AckMessage(std::string const& ack_id) override;
   void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
+  void BulkNack(std::vector<std::string> ack_ids) override;
 
  private:
   explicit SubscriptionMessageQueue(
@@ -83,28 +95,46 @@ class SubscriptionMessageQueue
         source_(std::move(source)) {}
 
   void OnRead(StatusOr<google::pubsub::v1::StreamingPullResponse> r);
-  void OnRead(std::unique_lock<std::mutex> lk,
-              google::pubsub::v1::StreamingPullResponse r);
+  void OnRead(google::pubsub::v1::StreamingPullResponse r);
   void Shutdown(std::unique_lock<std::mutex> lk);
   void DrainQueue(std::unique_lock<std::mutex> lk);
 
   /// Process a nack() or ack() for a message
   void HandlerDone(std::string const& ack_id);
 
+  /// Identifies the queue for each ordering key, see the class comments.
+  using OrderingKeyId = std::size_t;
+
+  static OrderingKeyId MakeOrderingKeyId(std::string const& ordering_key);
+
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::shared_ptr<SubscriptionBatchSource> const source_;
 
-  using QueueByOrderingKey =
-      absl::flat_hash_map<std::string,
-                          std::deque<google::pubsub::v1::ReceivedMessage>>;
+  static std::size_t constexpr kShardCount = 32;
+
+  struct QueueShard {
+    std::mutex mu;
+    bool shutdown = false;
+    absl::flat_hash_map<OrderingKeyId,
+                        std::deque<google::pubsub::v1::ReceivedMessage>>
+        queues;
+  };
+  struct AckIdShard {
+    std::mutex mu;
+    absl::flat_hash_map<std::string, OrderingKeyId> ordering_key_by_ack_id;
+  };
+
+  QueueShard& ShardFor(OrderingKeyId id) { return queues_[id % kShardCount]; }
+  AckIdShard& ShardFor(std::string const& ack_id);
 
   std::mutex mu_;
   MessageCallback callback_;
   bool shutdown_ = false;
   std::size_t available_slots_ = 0;
   std::deque<google::pubsub::v1::ReceivedMessage> runnable_messages_;
-  QueueByOrderingKey queues_;
-  absl::flat_hash_map<std::string, std::string> ordering_key_by_ack_id_;
+
+  std::array<QueueShard, kShardCount> queues_;
+  std::array<AckIdShard, kShardCount> ack_ids_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -33,6 +33,7 @@ using ::testing::AtMost;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAreArray;
 
 std::vector<google::pubsub::v1::ReceivedMessage> GenerateMessages() {
   auto constexpr kTextM0 = R"pb(
@@ -393,6 +394,50 @@ TEST(SubscriptionMessageQueueTest, DuplicateMessagesWithKey) {
   uut->Shutdown();
 }
 
+/// @test Verify pending messages for many ordering keys are nacked on shutdown.
+TEST(SubscriptionMessageQueueTest, NackPendingWithManyKeys) {
+  auto constexpr kKeyCount = 100;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  EXPECT_CALL(*mock, Shutdown).Times(1);
+  BatchCallback batch_callback;
+  EXPECT_CALL(*mock, Start).WillOnce([&](BatchCallback cb) {
+    batch_callback = std::move(cb);
+  });
+
+  std::vector<std::string> nacked;
+  EXPECT_CALL(*mock, BulkNack)
+      .WillOnce([&](std::vector<std::string> const& ack_ids) {
+        nacked = ack_ids;
+        return make_ready_future(Status{});
+      });
+
+  std::vector<std::string> received;
+  auto handler = [&received](google::pubsub::v1::ReceivedMessage const& m) {
+    received.push_back(m.message().message_id());
+  };
+
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  shutdown->Start({});
+  auto uut = SubscriptionMessageQueue::Create(shutdown, mock);
+  uut->Start(handler);
+  uut->Read(2 * kKeyCount);
+
+  std::vector<std::string> expected_received;
+  std::vector<std::string> expected_nacked;
+  for (int i = 0; i != kKeyCount; ++i) {
+    auto const key = absl::StrFormat("k%03d", i);
+    batch_callback(AsPullResponse(GenerateOrderKeyMessages(key, 0, 3)));
+    expected_received.push_back("id-" + key + "-000000");
+    expected_nacked.push_back("ack-" + key + "-000001");
+    expected_nacked.push_back("ack-" + key + "-000002");
+  }
+  // Only the first message for each key is delivered.
+  EXPECT_THAT(received, ElementsAreArray(expected_received));
+
+  uut->Shutdown();
+  EXPECT_THAT(nacked, UnorderedElementsAreArray(expected_nacked));
+}
+
 /// @test Work with large sets of non-keyed messages
 TEST_P(SubscriptionMessageQueueOrderingTest, RespectOrderingKeysTorture) {
   auto const message_count = GetParam().message_count;
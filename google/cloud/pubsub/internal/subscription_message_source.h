@@ -21,6 +21,7 @@
 #include <google/pubsub/v1/pubsub.pb.h>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -68,6 +69,12 @@ class SubscriptionMessageSource {
    * configuration.
    */
   virtual void NackMessage(std::string const& ack_id) = 0;
+
+  /// Positive acknowledgment of multiple messages.
+  virtual void BulkAck(std::vector<std::string> ack_ids) = 0;
+
+  /// Reject multiple messages.
+  virtual void BulkNack(std::vector<std::string> ack_ids) = 0;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
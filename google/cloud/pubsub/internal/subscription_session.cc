@@ -13,11 +13,14 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/subscription_session.h"
+#include "google/cloud/pubsub/internal/parallel_subscription_batch_source.h"
 #include "google/cloud/pubsub/internal/streaming_subscription_batch_source.h"
 #include "google/cloud/pubsub/internal/subscription_lease_management.h"
 #include "google/cloud/pubsub/internal/subscription_message_queue.h"
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
+#include <cstdint>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -28,21 +31,22 @@ namespace {
 class SubscriptionSessionImpl
     : public std::enable_shared_from_this<SubscriptionSessionImpl> {
  public:
+  template <typename Callback>
   static future<Status> Create(
       pubsub::SubscriberOptions const& options,
       google::cloud::CompletionQueue executor,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
-      std::shared_ptr<SubscriptionBatchSource> source,
-      pubsub::SubscriberConnection::SubscribeParams p) {
+      std::shared_ptr<SubscriptionBatchSource> source, Callback callback) {
     auto queue =
         SubscriptionMessageQueue::Create(shutdown_manager, std::move(source));
     auto concurrency_control = SubscriptionConcurrencyControl::Create(
-        executor, shutdown_manager, std::move(queue),
-        options.max_concurrency());
+        executor, shutdown_manager, std::move(queue), options.max_concurrency(),
+        options.callback_executor());
 
     auto self = std::make_shared<SubscriptionSessionImpl>(
         std::move(executor), std::move(shutdown_manager),
-        std::move(concurrency_control), options.shutdown_polling_period());
+        std::move(concurrency_control), options.shutdown_polling_period(),
+        options.max_shutdown_time());
 
     auto weak = std::weak_ptr<SubscriptionSessionImpl>(self);
     auto result = self->shutdown_manager_->Start(promise<Status>([weak] {
@@ -54,7 +58,7 @@ class SubscriptionSessionImpl
     // 2) When the completion queue is shutdown, the timer is canceled and
     //    `self` gets a chance to shutdown the pipeline.
     self->ScheduleTimer();
-    self->pipeline_->Start(std::move(p.callback));
+    self->pipeline_->Start(std::move(callback));
     return result.then([weak](future<Status> f) {
       if (auto self = weak.lock()) self->ShutdownCompleted();
       return f.get();
@@ -65,10 +69,12 @@ class SubscriptionSessionImpl
       CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionConcurrencyControl> pipeline,
-      std::chrono::milliseconds shutdown_polling_period)
+      std::chrono::milliseconds shutdown_polling_period,
+      std::chrono::milliseconds max_shutdown_time)
       : cq_(std::move(cq)),
         shutdown_manager_(std::move(shutdown_manager)),
         shutdown_polling_period_(shutdown_polling_period),
+        max_shutdown_time_(max_shutdown_time),
         pipeline_(std::move(pipeline)) {}
 
  private:
@@ -85,6 +91,7 @@ class SubscriptionSessionImpl
     auto shutdown_manager = shutdown_manager_;
     if (reason == kShutdownByCompletionQueue) pipeline_.reset();
     shutdown_state_ = reason;
+    if (reason == kShutdownByApplication) StartShutdownTimer(lk);
     lk.unlock();
     shutdown_manager->MarkAsShutdown(where, {});
     if (pipeline) pipeline->Shutdown();
@@ -112,6 +119,20 @@ class SubscriptionSessionImpl
     pipeline_.reset();
     shutdown_state_ = kShutdownCompleted;
     if (timer_.valid()) timer_.cancel();
+    if (shutdown_timer_.valid()) shutdown_timer_.cancel();
+  }
+
+  // Bounds the time waiting for callbacks and other pending operations.
+  void StartShutdownTimer(std::unique_lock<std::mutex> const&) {
+    using TimerArg = future<StatusOr<std::chrono::system_clock::time_point>>;
+    if (max_shutdown_time_.count() <= 0) return;
+    auto shutdown_manager = shutdown_manager_;
+    shutdown_timer_ = cq_.MakeRelativeTimer(max_shutdown_time_)
+                          .then([shutdown_manager](TimerArg f) {
+                            if (!f.get()) return;
+                            shutdown_manager->AbandonOperations(
+                                "OnShutdownTimer");
+                          });
   }
 
   void ScheduleTimer() {
@@ -149,34 +170,91 @@ class SubscriptionSessionImpl
   CompletionQueue cq_;
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::chrono::milliseconds const shutdown_polling_period_;
+  std::chrono::milliseconds const max_shutdown_time_;
 
   std::mutex mu_;
   std::shared_ptr<SubscriptionConcurrencyControl> pipeline_;
   ShutdownState shutdown_state_ = kNotInShutdown;
   future<void> timer_;
+  future<void> shutdown_timer_;
 };
-}  // namespace
 
-future<Status> CreateSubscriptionSession(
+// Each of the @p n streams gets an equal share of a flow control limit, where
+// 0 means "unlimited".
+std::int64_t StreamShare(std::int64_t limit, std::size_t n) {
+  if (limit == 0) return 0;
+  auto const streams = static_cast<std::int64_t>(n);
+  return (limit + streams - 1) / streams;
+}
+
+template <typename Callback>
+future<Status> CreateSession(
     pubsub::Subscription const& subscription,
     pubsub::SubscriberOptions const& options,
     std::shared_ptr<pubsub_internal::SubscriberStub> const& stub,
     google::cloud::CompletionQueue const& executor, std::string client_id,
-    pubsub::SubscriberConnection::SubscribeParams p,
-    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    Callback callback, std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
   auto shutdown_manager = std::make_shared<SessionShutdownManager>();
-  auto batch = std::make_shared<StreamingSubscriptionBatchSource>(
-      executor, shutdown_manager, stub, subscription.FullName(),
-      std::move(client_id), options, std::move(retry_policy),
-      std::move(backoff_policy));
+  auto const streams = options.parallel_streams();
+  std::shared_ptr<SubscriptionBatchSource> batch;
+  if (streams <= 1) {
+    batch = std::make_shared<StreamingSubscriptionBatchSource>(
+        executor, shutdown_manager, stub, subscription.FullName(),
+        std::move(client_id), options, std::move(retry_policy),
+        std::move(backoff_policy));
+  } else {
+    // Each call to `AsyncStreamingPull()` uses the next channel in the
+    // (round-robin) stub, so the streams are spread across channels.
+    auto stream_options = options;
+    stream_options
+        .set_max_outstanding_messages(
+            StreamShare(options.max_outstanding_messages(), streams))
+        .set_max_outstanding_bytes(
+            StreamShare(options.max_outstanding_bytes(), streams));
+    std::vector<std::shared_ptr<SubscriptionBatchSource>> children;
+    for (std::size_t i = 0; i != streams; ++i) {
+      children.push_back(std::make_shared<StreamingSubscriptionBatchSource>(
+          executor, shutdown_manager, stub, subscription.FullName(), client_id,
+          stream_options, retry_policy->clone(), backoff_policy->clone()));
+    }
+    batch = ParallelSubscriptionBatchSource::Create(std::move(children));
+  }
   auto lease_management = SubscriptionLeaseManagement::Create(
       executor, shutdown_manager, std::move(batch), options.max_deadline_time(),
       options.max_deadline_extension());
 
   return SubscriptionSessionImpl::Create(
       options, std::move(executor), std::move(shutdown_manager),
-      std::move(lease_management), std::move(p));
+      std::move(lease_management), std::move(callback));
+}
+
+}  // namespace
+
+future<Status> CreateSubscriptionSession(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::shared_ptr<pubsub_internal::SubscriberStub> const& stub,
+    google::cloud::CompletionQueue const& executor, std::string client_id,
+    pubsub::SubscriberConnection::SubscribeParams p,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
+  return CreateSession(subscription, options, stub, executor,
+                       std::move(client_id), std::move(p.callback),
+                       std::move(retry_policy), std::move(backoff_policy));
+}
+
+future<Status> CreateSubscriptionSession(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::shared_ptr<pubsub_internal::SubscriberStub> const& stub,
+    google::cloud::CompletionQueue const& executor, std::string client_id,
+    pubsub::SubscriberConnection::SubscribeBatchParams p,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
+  return CreateSession(subscription, options, stub, executor,
+                       std::move(client_id), std::move(p.callback),
+                       std::move(retry_policy), std::move(backoff_policy));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -43,6 +43,17 @@ std::chrono::system_clock::time_point Message::publish_time() const {
   return google::cloud::internal::ToChronoTimePoint(proto_.publish_time());
 }
 
+absl::optional<absl::string_view> Message::GetAttribute(
+    absl::string_view key) const {
+  auto const& attributes = proto_.attributes();
+  // `google::protobuf::Map` does not support heterogeneous lookup in C++11.
+  // Attribute keys are typically short, so the temporary fits in the small
+  // string buffer and is not allocated.
+  auto const l = attributes.find(std::string(key));
+  if (l == attributes.end()) return absl::nullopt;
+  return absl::string_view(l->second);
+}
+
 std::size_t Message::MessageSize() const {
   return pubsub_internal::MessageProtoSize(proto_);
 }
@@ -16,8 +16,12 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_MESSAGE_H
 
 #include "google/cloud/pubsub/version.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include <google/pubsub/v1/pubsub.pb.h>
 #include <chrono>
+#include <cstddef>
 #include <iosfwd>
 #include <map>
 #include <string>
@@ -77,6 +81,9 @@ using PubsubMessageDataType = std::decay<
  */
 class Message {
  public:
+  /// The type returned by `attributes_view()`.
+  using AttributesView = ::google::protobuf::Map<std::string, std::string>;
+
   //@{
   /// @name accessors
   PubsubMessageDataType const& data() const& { return proto_.data(); }
@@ -86,6 +93,7 @@ class Message {
   std::string const& message_id() const { return proto_.message_id(); }
   std::string const& ordering_key() const { return proto_.ordering_key(); }
   std::chrono::system_clock::time_point publish_time() const;
+  /// Returns a copy of the attributes, see `attributes_view()` to avoid it.
   std::map<std::string, std::string> attributes() const {
     std::map<std::string, std::string> r;
     for (auto const& kv : proto_.attributes()) {
@@ -93,6 +101,21 @@ class Message {
     }
     return r;
   }
+  /**
+   * Returns the attributes without copying them.
+   *
+   * The view is owned by the message, it is invalidated when the message is
+   * destroyed or moved from. Iterating over the view does not allocate memory.
+   */
+  AttributesView const& attributes_view() const { return proto_.attributes(); }
+  /**
+   * Returns the value of the attribute @p key, or `absl::nullopt` if the
+   * message has no such attribute.
+   *
+   * The returned value refers to the message, it is invalidated when the
+   * message is destroyed or moved from.
+   */
+  absl::optional<absl::string_view> GetAttribute(absl::string_view key) const;
   //@}
 
   //@{
@@ -160,6 +183,41 @@ class MessageBuilder {
     return std::move(*this);
   }
 
+  /**
+   * Sets the message payload to the contents of @p data.
+   *
+   * The contents are copied directly into the message, without creating any
+   * intermediate strings. Use this overload (or the `absl::Cord` overload) for
+   * large payloads held in application buffers.
+   */
+  MessageBuilder& SetData(char const* data, std::size_t size) & {
+    proto_.mutable_data()->assign(data, size);
+    return *this;
+  }
+
+  /// @copydoc SetData(char const*, std::size_t) &
+  MessageBuilder&& SetData(char const* data, std::size_t size) && {
+    SetData(data, size);
+    return std::move(*this);
+  }
+
+  /**
+   * Sets the message payload to the contents of @p data.
+   *
+   * The payload of a Cloud Pub/Sub message is stored in a contiguous string,
+   * the contents of the cord are copied (once) directly into that string.
+   */
+  MessageBuilder& SetData(absl::Cord const& data) & {
+    absl::CopyCordToString(data, proto_.mutable_data());
+    return *this;
+  }
+
+  /// @copydoc SetData(absl::Cord const&) &
+  MessageBuilder&& SetData(absl::Cord const& data) && {
+    SetData(data);
+    return std::move(*this);
+  }
+
   /// Sets the ordering key to @p key
   MessageBuilder& SetOrderingKey(std::string key) & {
     proto_.set_ordering_key(std::move(key));
@@ -17,7 +17,9 @@
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
 #include <sstream>
+#include <string>
 #include <tuple>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -27,6 +29,7 @@ namespace {
 
 using ::google::cloud::testing_util::IsProtoEqual;
 using ::testing::HasSubstr;
+using ::testing::Pair;
 using ::testing::UnorderedElementsAre;
 
 TEST(Message, Empty) {
@@ -132,6 +135,28 @@ TEST(Message, SetAttributesVectorStdTupleSimple) {
                                    std::make_pair("k2", "v2")));
 }
 
+TEST(Message, AttributesView) {
+  auto const m0 = MessageBuilder{}
+                      .SetAttribute("k1", "v1")
+                      .SetAttribute("k2", "v2")
+                      .Build();
+  auto const& view = m0.attributes_view();
+  EXPECT_THAT(view, UnorderedElementsAre(Pair("k1", "v1"), Pair("k2", "v2")));
+  EXPECT_EQ(&view, &m0.attributes_view());
+}
+
+TEST(Message, GetAttribute) {
+  auto const m0 = MessageBuilder{}
+                      .SetAttribute("k1", "v1")
+                      .SetAttribute("k2", "")
+                      .Build();
+  EXPECT_EQ(absl::make_optional(absl::string_view("v1")),
+            m0.GetAttribute("k1"));
+  EXPECT_EQ(absl::make_optional(absl::string_view()), m0.GetAttribute("k2"));
+  EXPECT_EQ(absl::nullopt, m0.GetAttribute("k3"));
+  EXPECT_EQ(absl::nullopt, MessageBuilder{}.Build().GetAttribute("k1"));
+}
+
 TEST(Message, SetData) {
   auto const m0 =
       MessageBuilder{}.SetData("original").SetData("changed").Build();
@@ -180,6 +205,28 @@ TEST(Message, SetAttributesVectorStdTuple) {
                                    std::make_pair("k2", "v2")));
 }
 
+TEST(Message, SetDataPointerAndSize) {
+  std::vector<char> buffer{'a', 'b', '\0', 'c'};
+  auto const m0 =
+      MessageBuilder{}.SetData(buffer.data(), buffer.size()).Build();
+  EXPECT_EQ(std::string("ab\0c", 4), m0.data());
+
+  auto const m1 = MessageBuilder{}.SetData(buffer.data(), 0).Build();
+  EXPECT_EQ("", m1.data());
+}
+
+TEST(Message, SetDataCord) {
+  absl::Cord data("abc");
+  data.Append(std::string(1024, 'x'));
+  data.Append("def");
+  auto const m0 = MessageBuilder{}.SetData(data).Build();
+  EXPECT_EQ(std::string(data), m0.data());
+
+  MessageBuilder builder;
+  builder.SetData("original").SetData(absl::Cord("changed"));
+  EXPECT_EQ("changed", std::move(builder).Build().data());
+}
+
 TEST(Message, DataMove) {
   auto m0 = MessageBuilder{}.SetData("contents-0").Build();
   auto const d = std::move(m0).data();
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_MOCKS_MOCK_ACK_HANDLER_H
 
 #include "google/cloud/pubsub/ack_handler.h"
+#include "google/cloud/pubsub/batch_ack_handler.h"
 #include <gmock/gmock.h>
 #include <string>
 
@@ -49,6 +50,18 @@ class MockAckHandler : public pubsub::AckHandler::Impl {
   MOCK_METHOD(std::int32_t, delivery_attempt, (), (const, override));
 };
 
+/**
+ * A googlemock-based mock for [pubsub::BatchAckHandler::Impl][mocked-link]
+ *
+ * [mocked-link]: @ref google::cloud::pubsub::v1::BatchAckHandler::Impl
+ */
+class MockBatchAckHandler : public pubsub::BatchAckHandler::Impl {
+ public:
+  MOCK_METHOD(void, ack, (), (override));
+  MOCK_METHOD(void, nack, (), (override));
+  MOCK_METHOD(std::size_t, size, (), (const, override));
+};
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_mocks
 }  // namespace cloud
@@ -35,6 +35,8 @@ class MockPublisherConnection : public pubsub::PublisherConnection {
  public:
   MOCK_METHOD(future<StatusOr<std::string>>, Publish,
               (pubsub::PublisherConnection::PublishParams), (override));
+  MOCK_METHOD(void, PublishNoWait,
+              (pubsub::PublisherConnection::PublishNoWaitParams), (override));
   MOCK_METHOD(void, Flush, (pubsub::PublisherConnection::FlushParams),
               (override));
   MOCK_METHOD(void, ResumePublish,
@@ -34,6 +34,11 @@ class MockSubscriberConnection : public pubsub::SubscriberConnection {
  public:
   MOCK_METHOD(future<Status>, Subscribe,
               (pubsub::SubscriberConnection::SubscribeParams), (override));
+  MOCK_METHOD(future<Status>, SubscribeBatch,
+              (pubsub::SubscriberConnection::SubscribeBatchParams),
+              (override));
+  MOCK_METHOD(future<StatusOr<pubsub::PullResult>>, AsyncPull,
+              (pubsub::SubscriberConnection::PullParams), (override));
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -147,6 +147,23 @@ class Publisher {
     return connection_->Publish({std::move(m)});
   }
 
+  /**
+   * Publishes a message to this publisher's topic, without waiting for its
+   * result.
+   *
+   * Unlike `Publish()` this function does not create a future for each
+   * message, and the message id is not available to the application. The
+   * publisher reports the status of each batch, and the number of
+   * `PublishNoWait()` messages in it, to the callback configured with
+   * `PublisherOptions::set_batch_result_callback()`. Applications that do
+   * not need the message ids, such as telemetry publishers, should prefer
+   * this function, as it is less expensive.
+   *
+   * @par Idempotency
+   * See the description in `Publish()`.
+   */
+  void PublishNoWait(Message m) { connection_->PublishNoWait({std::move(m)}); }
+
   /**
    * Forcibly publishes any batched messages.
    *
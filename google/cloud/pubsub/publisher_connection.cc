@@ -24,9 +24,12 @@
 #include "google/cloud/pubsub/internal/publisher_stub.h"
 #include "google/cloud/pubsub/internal/rejects_with_ordering_key.h"
 #include "google/cloud/pubsub/internal/sequential_batch_sink.h"
+#include "google/cloud/pubsub/internal/sharded_publisher_connection.h"
 #include "google/cloud/future_void.h"
 #include "google/cloud/log.h"
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -44,6 +47,9 @@ class ContainingPublisherConnection : public PublisherConnection {
   future<StatusOr<std::string>> Publish(PublishParams p) override {
     return child_->Publish(std::move(p));
   }
+  void PublishNoWait(PublishNoWaitParams p) override {
+    child_->PublishNoWait(std::move(p));
+  }
   void Flush(FlushParams p) override { child_->Flush(std::move(p)); }
   void ResumePublish(ResumePublishParams p) override {
     child_->ResumePublish(std::move(p));
@@ -63,6 +69,10 @@ future<StatusOr<std::string>> PublisherConnection::Publish(PublishParams) {
       Status{StatusCode::kUnimplemented, "needs-override"}));
 }
 
+void PublisherConnection::PublishNoWait(PublishNoWaitParams p) {
+  Publish({std::move(p.message)});
+}
+
 void PublisherConnection::Flush(FlushParams) {}
 
 // NOLINTNEXTLINE(performance-unnecessary-value-param)
@@ -131,25 +141,49 @@ std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
   }
 
   auto background = connection_options.background_threads_factory()();
+  auto cq = background->cq();
+  auto memory_account = google::cloud::internal::MakeMemoryAccount(
+      google::cloud::internal::MakeOptions(connection_options),
+      "pubsub.Publisher/" + topic.FullName());
+  std::shared_ptr<BatchSink> sink = DefaultBatchSink::Create(
+      stub, cq, std::move(retry_policy), std::move(backoff_policy), options);
   auto make_connection = [&]() -> std::shared_ptr<pubsub::PublisherConnection> {
-    auto cq = background->cq();
-    std::shared_ptr<BatchSink> sink = DefaultBatchSink::Create(
-        stub, cq, std::move(retry_policy), std::move(backoff_policy));
     if (options.message_ordering()) {
-      auto factory = [topic, options, sink, cq](std::string const& key) {
+      auto factory = [topic, options, sink, cq,
+                      memory_account](std::string const& key) {
         return BatchingPublisherConnection::Create(
-            topic, options, key, SequentialBatchSink::Create(std::move(sink)),
-            cq);
+            topic, options, key,
+            SequentialBatchSink::Create(
+                sink, options.max_in_flight_batches_per_key()),
+            cq, memory_account);
       };
-      return OrderingKeyPublisherConnection::Create(std::move(factory));
+      // The factory only creates `BatchingPublisherConnection` children.
+      auto is_idle = [](pubsub::PublisherConnection& c) {
+        return static_cast<BatchingPublisherConnection&>(c).IsIdle();
+      };
+      return OrderingKeyPublisherConnection::Create(
+          std::move(factory), std::move(is_idle),
+          options.ordering_key_idle_timeout());
     }
-    return RejectsWithOrderingKey::Create(BatchingPublisherConnection::Create(
-        std::move(topic), std::move(options), {}, sink, std::move(cq)));
+    return RejectsWithOrderingKey::Create(
+        BatchingPublisherConnection::Create(topic, options, {}, sink, cq,
+                                            memory_account),
+        options.batch_result_callback());
+  };
+  auto make_sharded_connection =
+      [&]() -> std::shared_ptr<pubsub::PublisherConnection> {
+    if (options.batching_shards() <= 1) return make_connection();
+    // All the shards share the same sink, the sink holds no per-batch state.
+    std::vector<std::shared_ptr<pubsub::PublisherConnection>> shards(
+        options.batching_shards());
+    std::generate(shards.begin(), shards.end(), make_connection);
+    return ShardedPublisherConnection::Create(std::move(shards));
   };
-  auto connection = make_connection();
-  if (options.full_publisher_rejects() || options.full_publisher_blocks()) {
+  auto connection = make_sharded_connection();
+  if (options.full_publisher_rejects() || options.full_publisher_blocks() ||
+      options.full_publisher_queues()) {
     connection = FlowControlledPublisherConnection::Create(
-        options, std::move(connection));
+        options, std::move(connection), cq, std::move(memory_account));
   }
   return std::make_shared<pubsub::ContainingPublisherConnection>(
       std::move(background), std::move(connection));
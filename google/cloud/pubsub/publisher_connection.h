@@ -60,6 +60,11 @@ class PublisherConnection {
     Message message;
   };
 
+  /// Wrap the arguments for `PublishNoWait()`
+  struct PublishNoWaitParams {
+    Message message;
+  };
+
   /// Wrap the arguments for `Flush()`
   struct FlushParams {};
 
@@ -71,6 +76,13 @@ class PublisherConnection {
   /// Defines the interface for `Publisher::Publish()`
   virtual future<StatusOr<std::string>> Publish(PublishParams p);
 
+  /**
+   * Defines the interface for `Publisher::PublishNoWait()`
+   *
+   * The default implementation calls `Publish()` and discards the result.
+   */
+  virtual void PublishNoWait(PublishNoWaitParams p);
+
   /// Defines the interface for `Publisher::Flush()`
   virtual void Flush(FlushParams);
 
@@ -16,9 +16,11 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_PUBLISHER_OPTIONS_H
 
 #include "google/cloud/pubsub/version.h"
+#include "google/cloud/status.h"
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <functional>
 #include <limits>
 
 namespace google {
@@ -121,6 +123,27 @@ class PublisherOptions {
     maximum_batch_bytes_ = v;
     return *this;
   }
+
+  /**
+   * Set the number of independent batching shards.
+   *
+   * By default all the calls to `Publisher::Publish()` append to a single
+   * batch, and therefore serialize on a single lock. Applications publishing
+   * from many threads may prefer to use several shards: each publishing thread
+   * is assigned to a shard, and each shard accumulates and flushes its own
+   * batches. Messages with an ordering key are always routed to the same shard,
+   * so message ordering is preserved.
+   *
+   * The batch limits (hold time, message count, and bytes) apply to each shard
+   * separately. The flow control limits apply to the publisher as a whole.
+   *
+   * A value of 0 is treated as 1.
+   */
+  PublisherOptions& set_batching_shards(std::size_t v) {
+    batching_shards_ = v == 0 ? 1 : v;
+    return *this;
+  }
+  std::size_t batching_shards() const { return batching_shards_; }
   //@}
 
   //@{
@@ -159,6 +182,91 @@ class PublisherOptions {
     message_ordering_ = false;
     return *this;
   }
+
+  /**
+   * Set the maximum number of batches in flight for each ordering key.
+   *
+   * With message ordering enabled the publisher sends a single batch at a time
+   * for each ordering key, so the throughput of each key is limited to one
+   * batch per round-trip to the service. Allowing more batches in flight
+   * increases that throughput, at a cost: batches in flight at the same time
+   * may take different network paths, and may be received out of order.
+   *
+   * The results are always reported in order, and if a batch fails all the
+   * following messages with the same ordering key are rejected until the
+   * application calls `Publisher::ResumePublish()`. Batches that were already
+   * in flight when the failure happened may have been received by the service.
+   *
+   * The default is 1, a value of 0 is treated as 1.
+   */
+  PublisherOptions& set_max_in_flight_batches_per_key(std::size_t v) {
+    max_in_flight_batches_per_key_ = v == 0 ? 1 : v;
+    return *this;
+  }
+  std::size_t max_in_flight_batches_per_key() const {
+    return max_in_flight_batches_per_key_;
+  }
+
+  /**
+   * Discard the state for ordering keys idle for longer than this timeout.
+   *
+   * With message ordering enabled the publisher keeps some state for each
+   * ordering key. Applications using many distinct ordering keys (e.g. one per
+   * user) would see this state grow without bounds. The publisher discards the
+   * state for keys without pending messages, batches in flight, or errors
+   * waiting for `Publisher::ResumePublish()`, once they have been idle for
+   * this long. Discarding this state does not change the ordering guarantees.
+   *
+   * The default is 60 seconds, a value of 0 disables discarding idle keys.
+   */
+  template <typename Rep, typename Period>
+  PublisherOptions& set_ordering_key_idle_timeout(
+      std::chrono::duration<Rep, Period> v) {
+    ordering_key_idle_timeout_ =
+        std::chrono::duration_cast<std::chrono::milliseconds>(v);
+    return *this;
+  }
+  std::chrono::milliseconds ordering_key_idle_timeout() const {
+    return ordering_key_idle_timeout_;
+  }
+  //@}
+
+  //@{
+  /**
+   * @name Publisher compression.
+   *
+   * Applications publishing compressible payloads (e.g. JSON or other text
+   * formats) can reduce their network usage by compressing the batches sent
+   * to the service, using gRPC's per-call compression (gzip). Compression
+   * increases the CPU usage in the client, and rarely helps with small
+   * batches. Therefore, the publisher only compresses batches that are at
+   * least `compression_threshold()` bytes large. Compression is disabled by
+   * default.
+   */
+
+  /// Return `true` if compression is enabled.
+  bool compression_enabled() const { return compression_enabled_; }
+
+  /// Enable compression for batches larger than `compression_threshold()`.
+  PublisherOptions& enable_compression() {
+    compression_enabled_ = true;
+    return *this;
+  }
+
+  /// Disable compression.
+  PublisherOptions& disable_compression() {
+    compression_enabled_ = false;
+    return *this;
+  }
+
+  /// The minimum size (in bytes) for a batch to be compressed.
+  std::size_t compression_threshold() const { return compression_threshold_; }
+
+  /// Set the minimum size (in bytes) for a batch to be compressed.
+  PublisherOptions& set_compression_threshold(std::size_t v) {
+    compression_threshold_ = v;
+    return *this;
+  }
   //@}
 
   //@{
@@ -170,8 +278,8 @@ class PublisherOptions {
    * potentially consumes memory resources in the client (and/or the service).
    *
    * Some applications may have constraints on the number of bytes and/or
-   * messages they can tolerate in this pending state, and may prefer to block
-   * or reject messages.
+   * messages they can tolerate in this pending state, and may prefer to block,
+   * reject, or queue messages.
    */
 
   /// Flow control based on pending bytes.
@@ -201,6 +309,9 @@ class PublisherOptions {
   bool full_publisher_blocks() const {
     return full_publisher_action_ == FullPublisherAction::kBlocks;
   }
+  bool full_publisher_queues() const {
+    return full_publisher_action_ == FullPublisherAction::kQueues;
+  }
 
   /// Ignore full publishers, continue as usual
   PublisherOptions& set_full_publisher_ignored() {
@@ -219,26 +330,94 @@ class PublisherOptions {
     full_publisher_action_ = FullPublisherAction::kBlocks;
     return *this;
   }
+
+  /**
+   * Configure the publisher to queue new messages when full.
+   *
+   * `Publisher::Publish()` returns immediately. The messages wait, in the
+   * order they were published, until the pending messages complete and make
+   * room for them. No threads are blocked while the messages wait. Use
+   * `set_full_publisher_max_wait()` to limit how long a message can wait.
+   */
+  PublisherOptions& set_full_publisher_queues() {
+    full_publisher_action_ = FullPublisherAction::kQueues;
+    return *this;
+  }
+
+  /**
+   * The maximum time a message waits when the publisher queues messages.
+   *
+   * Messages that wait longer are not published, their future is satisfied
+   * with a `kDeadlineExceeded` error. The default value, 0, means that the
+   * messages wait until the publisher has room for them.
+   */
+  PublisherOptions& set_full_publisher_max_wait(std::chrono::milliseconds v) {
+    full_publisher_max_wait_ = v;
+    return *this;
+  }
+  std::chrono::milliseconds full_publisher_max_wait() const {
+    return full_publisher_max_wait_;
+  }
   //@}
 
+  /**
+   * The callback type for the results of `Publisher::PublishNoWait()`.
+   *
+   * The callback receives the status of a batch, and the number of messages
+   * in that batch published with `Publisher::PublishNoWait()`.
+   */
+  using BatchResultCallback =
+      std::function<void(Status const& status, std::size_t message_count)>;
+
+  /**
+   * Receive the aggregate results for messages published with
+   * `Publisher::PublishNoWait()`.
+   *
+   * The publisher calls @p v once for each batch containing such messages,
+   * usually from one of the background threads. Messages rejected before they
+   * are batched (e.g. while waiting for `Publisher::ResumePublish()`) are
+   * reported individually. With flow control limits (see
+   * `set_maximum_pending_bytes()` and `set_maximum_pending_messages()`) the
+   * publisher tracks each message, and reports each result individually. By
+   * default the results are discarded.
+   */
+  PublisherOptions& set_batch_result_callback(BatchResultCallback v) {
+    batch_result_callback_ = std::move(v);
+    return *this;
+  }
+  BatchResultCallback const& batch_result_callback() const {
+    return batch_result_callback_;
+  }
+
  private:
   static auto constexpr kDefaultMaximumHoldTime = std::chrono::milliseconds(10);
   static std::size_t constexpr kDefaultMaximumMessageCount = 100;
   static std::size_t constexpr kDefaultMaximumMessageSize = 1024 * 1024L;
+  static std::size_t constexpr kDefaultCompressionThreshold = 1024;
+  static auto constexpr kDefaultOrderingKeyIdleTimeout =
+      std::chrono::seconds(60);
   static std::size_t constexpr kDefaultMaximumPendingBytes =
       (std::numeric_limits<std::size_t>::max)();
   static std::size_t constexpr kDefaultMaximumPendingMessages =
       (std::numeric_limits<std::size_t>::max)();
 
-  enum class FullPublisherAction { kIgnored, kRejects, kBlocks };
+  enum class FullPublisherAction { kIgnored, kRejects, kBlocks, kQueues };
 
   std::chrono::microseconds maximum_hold_time_ = kDefaultMaximumHoldTime;
   std::size_t maximum_batch_message_count_ = kDefaultMaximumMessageCount;
   std::size_t maximum_batch_bytes_ = kDefaultMaximumMessageSize;
+  std::size_t batching_shards_ = 1;
   bool message_ordering_ = false;
+  std::size_t max_in_flight_batches_per_key_ = 1;
+  std::chrono::milliseconds ordering_key_idle_timeout_ =
+      kDefaultOrderingKeyIdleTimeout;
+  bool compression_enabled_ = false;
+  std::size_t compression_threshold_ = kDefaultCompressionThreshold;
   std::size_t maximum_pending_bytes_ = kDefaultMaximumPendingBytes;
   std::size_t maximum_pending_messages_ = kDefaultMaximumPendingMessages;
   FullPublisherAction full_publisher_action_ = FullPublisherAction::kBlocks;
+  std::chrono::milliseconds full_publisher_max_wait_{0};
+  BatchResultCallback batch_result_callback_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
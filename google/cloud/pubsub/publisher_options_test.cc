@@ -43,6 +43,49 @@ TEST(PublisherOptions, Setters) {
   EXPECT_FALSE(b1.message_ordering());
 }
 
+TEST(PublisherOptions, Compression) {
+  auto const b0 = PublisherOptions{};
+  EXPECT_FALSE(b0.compression_enabled());
+  EXPECT_NE(0, b0.compression_threshold());
+
+  auto const b1 =
+      PublisherOptions{}.enable_compression().set_compression_threshold(4096);
+  EXPECT_TRUE(b1.compression_enabled());
+  EXPECT_EQ(4096, b1.compression_threshold());
+
+  auto const b2 = PublisherOptions{}.enable_compression().disable_compression();
+  EXPECT_FALSE(b2.compression_enabled());
+}
+
+TEST(PublisherOptions, BatchingShards) {
+  EXPECT_EQ(1, PublisherOptions{}.batching_shards());
+  EXPECT_EQ(8, PublisherOptions{}.set_batching_shards(8).batching_shards());
+  EXPECT_EQ(1, PublisherOptions{}.set_batching_shards(0).batching_shards());
+}
+
+TEST(PublisherOptions, MaxInFlightBatchesPerKey) {
+  EXPECT_EQ(1, PublisherOptions{}.max_in_flight_batches_per_key());
+  EXPECT_EQ(4, PublisherOptions{}
+                   .set_max_in_flight_batches_per_key(4)
+                   .max_in_flight_batches_per_key());
+  EXPECT_EQ(1, PublisherOptions{}
+                   .set_max_in_flight_batches_per_key(0)
+                   .max_in_flight_batches_per_key());
+}
+
+TEST(PublisherOptions, OrderingKeyIdleTimeout) {
+  EXPECT_EQ(std::chrono::seconds(60),
+            PublisherOptions{}.ordering_key_idle_timeout());
+  EXPECT_EQ(std::chrono::milliseconds(1500),
+            PublisherOptions{}
+                .set_ordering_key_idle_timeout(std::chrono::milliseconds(1500))
+                .ordering_key_idle_timeout());
+  EXPECT_EQ(std::chrono::milliseconds(0),
+            PublisherOptions{}
+                .set_ordering_key_idle_timeout(std::chrono::seconds(0))
+                .ordering_key_idle_timeout());
+}
+
 TEST(PublisherOptions, MaximumPendingBytes) {
   auto const b0 = PublisherOptions{};
   EXPECT_NE(0, b0.maximum_pending_bytes());
@@ -70,6 +113,8 @@ TEST(PublisherOptions, FullPublisherAction) {
   EXPECT_FALSE(b0.full_publisher_ignored());
   EXPECT_FALSE(b0.full_publisher_rejects());
   EXPECT_TRUE(b0.full_publisher_blocks());
+  EXPECT_FALSE(b0.full_publisher_queues());
+  EXPECT_EQ(std::chrono::milliseconds(0), b0.full_publisher_max_wait());
 
   EXPECT_TRUE(
       PublisherOptions{}.set_full_publisher_ignored().full_publisher_ignored());
@@ -77,6 +122,23 @@ TEST(PublisherOptions, FullPublisherAction) {
       PublisherOptions{}.set_full_publisher_rejects().full_publisher_rejects());
   EXPECT_TRUE(
       PublisherOptions{}.set_full_publisher_blocks().full_publisher_blocks());
+  EXPECT_TRUE(
+      PublisherOptions{}.set_full_publisher_queues().full_publisher_queues());
+  EXPECT_EQ(std::chrono::milliseconds(250),
+            PublisherOptions{}
+                .set_full_publisher_max_wait(std::chrono::milliseconds(250))
+                .full_publisher_max_wait());
+}
+
+TEST(PublisherOptions, BatchResultCallback) {
+  EXPECT_FALSE(PublisherOptions{}.batch_result_callback());
+
+  std::size_t count = 0;
+  auto const b1 = PublisherOptions{}.set_batch_result_callback(
+      [&count](Status const&, std::size_t n) { count += n; });
+  ASSERT_TRUE(b1.batch_result_callback());
+  b1.batch_result_callback()(Status{}, 3);
+  EXPECT_EQ(3, count);
 }
 
 }  // namespace
@@ -18,19 +18,25 @@
 
 pubsub_client_unit_tests = [
     "ack_handler_test.cc",
+    "batch_ack_handler_test.cc",
+    "internal/ack_latency_distribution_test.cc",
+    "internal/adaptive_flow_control_test.cc",
     "internal/batching_publisher_connection_test.cc",
     "internal/default_batch_sink_test.cc",
     "internal/emulator_overrides_test.cc",
     "internal/flow_controlled_publisher_connection_test.cc",
     "internal/ordering_key_publisher_connection_test.cc",
+    "internal/parallel_subscription_batch_source_test.cc",
     "internal/publisher_logging_test.cc",
     "internal/publisher_metadata_test.cc",
     "internal/publisher_round_robin_test.cc",
+    "internal/pull_subscription_batch_source_test.cc",
     "internal/rejects_with_ordering_key_test.cc",
     "internal/schema_logging_test.cc",
     "internal/schema_metadata_test.cc",
     "internal/sequential_batch_sink_test.cc",
     "internal/session_shutdown_manager_test.cc",
+    "internal/sharded_publisher_connection_test.cc",
     "internal/streaming_subscription_batch_source_test.cc",
     "internal/subscriber_logging_test.cc",
     "internal/subscriber_metadata_test.cc",
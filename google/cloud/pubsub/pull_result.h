@@ -0,0 +1,50 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_PULL_RESULT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_PULL_RESULT_H
+
+#include "google/cloud/pubsub/batch_ack_handler.h"
+#include "google/cloud/pubsub/message.h"
+#include "google/cloud/pubsub/version.h"
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * The messages returned by `Subscriber::Pull()` and `Subscriber::AsyncPull()`.
+ *
+ * The library extends the leases of the messages until the application acks
+ * or nacks them using `handler`, or until the maximum deadline time set in
+ * the `SubscriberOptions` expires. If `handler` is destroyed without calling
+ * `ack()` or `nack()` the messages are nacked.
+ *
+ * The result may contain fewer messages than requested, or even no messages,
+ * this does not mean the subscription has no more messages.
+ */
+struct PullResult {
+  std::vector<Message> messages;
+  BatchAckHandler handler;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_PULL_RESULT_H
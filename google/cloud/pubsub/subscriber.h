@@ -16,11 +16,14 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_SUBSCRIBER_H
 
 #include "google/cloud/pubsub/message.h"
+#include "google/cloud/pubsub/pull_result.h"
 #include "google/cloud/pubsub/subscriber_connection.h"
 #include "google/cloud/pubsub/subscription.h"
 #include "google/cloud/pubsub/version.h"
 #include "google/cloud/status.h"
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -131,6 +134,71 @@ class Subscriber {
     return connection_->Subscribe({std::move(f)});
   }
 
+  /**
+   * Creates a new session to receive batches of messages from @p subscription.
+   *
+   * This is similar to `Subscribe()`, but each call to @p cb receives all the
+   * messages available at the time, and a single `BatchAckHandler` to
+   * acknowledge (or reject) all of them in one request. Applications that
+   * receive many small messages can use this function to amortize the cost of
+   * scheduling each callback and acknowledging each message.
+   *
+   * The number of messages in each batch is at most
+   * `SubscriberOptions::max_concurrency()`. A message counts against this
+   * limit until the handler for its batch is used.
+   *
+   * @note Callable must be `CopyConstructible`, as @p cb will be stored in a
+   *   [`std::function<>`][std-function-link].
+   *
+   * @param cb the callable invoked when messages are received. This must be
+   *     usable to construct a
+   *     `std::function<void(std::vector<pubsub::Message>,
+   *     pubsub::BatchAckHandler)>`.
+   * @return a future that is satisfied when the session will no longer receive
+   *     messages. Calling `.cancel()` in this object will (eventually)
+   *     terminate the session and satisfy the future.
+   *
+   * [std-function-link]:
+   * https://en.cppreference.com/w/cpp/utility/functional/function
+   */
+  template <typename Callable>
+  future<Status> SubscribeBatch(Callable&& cb) {
+    std::function<void(std::vector<Message>, BatchAckHandler)> f(
+        std::forward<Callable>(cb));
+    return connection_->SubscribeBatch({std::move(f)});
+  }
+
+  /**
+   * Pulls at most @p max_messages messages, blocking until they are received.
+   *
+   * Unlike `Subscribe()` this function does not start a session, it makes a
+   * single (unary) `Pull` request. This is useful for batch jobs that process
+   * many messages at once, and then acknowledge all of them.
+   *
+   * The library extends the leases of the messages until they are acked or
+   * nacked using the handler in the result, subject to the
+   * `SubscriberOptions::max_deadline_time()`.
+   *
+   * @par Idempotency
+   * This function is not retried. Messages returned by a failed request are
+   * redelivered once their ack deadline expires.
+   *
+   * @param max_messages the maximum number of messages to return. The service
+   *     may return fewer messages, even if more are available.
+   */
+  StatusOr<PullResult> Pull(std::int32_t max_messages) {
+    return connection_->AsyncPull({max_messages}).get();
+  }
+
+  /**
+   * Asynchronously pulls at most @p max_messages messages.
+   *
+   * @see `Pull()` for details.
+   */
+  future<StatusOr<PullResult>> AsyncPull(std::int32_t max_messages) {
+    return connection_->AsyncPull({max_messages});
+  }
+
  private:
   std::shared_ptr<SubscriberConnection> connection_;
 };
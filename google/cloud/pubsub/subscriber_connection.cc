@@ -14,9 +14,12 @@
 
 #include "google/cloud/pubsub/subscriber_connection.h"
 #include "google/cloud/pubsub/internal/default_retry_policies.h"
+#include "google/cloud/pubsub/internal/pull_subscription_batch_source.h"
+#include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscriber_logging.h"
 #include "google/cloud/pubsub/internal/subscriber_metadata.h"
 #include "google/cloud/pubsub/internal/subscriber_round_robin.h"
+#include "google/cloud/pubsub/internal/subscription_lease_management.h"
 #include "google/cloud/pubsub/internal/subscription_session.h"
 #include "google/cloud/pubsub/retry_policy.h"
 #include "google/cloud/internal/random.h"
@@ -38,6 +41,18 @@ future<Status> SubscriberConnection::Subscribe(SubscribeParams) {
       Status{StatusCode::kUnimplemented, "needs-override"});
 }
 
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+future<Status> SubscriberConnection::SubscribeBatch(SubscribeBatchParams) {
+  return make_ready_future(
+      Status{StatusCode::kUnimplemented, "needs-override"});
+}
+
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+future<StatusOr<PullResult>> SubscriberConnection::AsyncPull(PullParams) {
+  return make_ready_future(StatusOr<PullResult>(
+      Status{StatusCode::kUnimplemented, "needs-override"}));
+}
+
 std::shared_ptr<SubscriberConnection> MakeSubscriberConnection(
     Subscription subscription, SubscriberOptions options,
     ConnectionOptions connection_options,
@@ -76,23 +91,56 @@ class SubscriberConnectionImpl : public pubsub::SubscriberConnection {
         background_(connection_options.background_threads_factory()()),
         retry_policy_(std::move(retry_policy)),
         backoff_policy_(std::move(backoff_policy)),
-        generator_(google::cloud::internal::MakeDefaultPRNG()) {}
+        generator_(google::cloud::internal::MakeDefaultPRNG()),
+        pull_shutdown_(std::make_shared<SessionShutdownManager>()),
+        pull_source_(std::make_shared<PullSubscriptionBatchSource>(
+            background_->cq(), stub_, subscription_.FullName())),
+        pull_leases_(SubscriptionLeaseManagement::Create(
+            background_->cq(), pull_shutdown_, pull_source_,
+            options_.max_deadline_time(), options_.max_deadline_extension())) {
+    // The messages are returned by `AsyncPull()`, the lease management layer
+    // only needs to see their ack ids.
+    pull_leases_->Start(
+        [](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  }
 
-  ~SubscriberConnectionImpl() override = default;
+  ~SubscriberConnectionImpl() override {
+    // Stop the lease refresh timers, and nack any messages still pending.
+    pull_shutdown_->MarkAsShutdown(__func__, {});
+    pull_leases_->Shutdown();
+  }
 
   future<Status> Subscribe(SubscribeParams p) override {
-    auto client_id = [this] {
-      std::lock_guard<std::mutex> lk(mu_);
-      auto constexpr kLength = 32;
-      auto constexpr kChars = "abcdefghijklmnopqrstuvwxyz0123456789";
-      return google::cloud::internal::Sample(generator_, kLength, kChars);
-    }();
     return CreateSubscriptionSession(
-        subscription_, options_, stub_, background_->cq(), std::move(client_id),
+        subscription_, options_, stub_, background_->cq(), MakeClientId(),
+        std::move(p), retry_policy_->clone(), backoff_policy_->clone());
+  }
+
+  future<Status> SubscribeBatch(SubscribeBatchParams p) override {
+    return CreateSubscriptionSession(
+        subscription_, options_, stub_, background_->cq(), MakeClientId(),
         std::move(p), retry_policy_->clone(), backoff_policy_->clone());
   }
 
+  future<StatusOr<pubsub::PullResult>> AsyncPull(PullParams p) override {
+    std::weak_ptr<SubscriptionBatchSource> w = pull_leases_;
+    return pull_source_->Pull(p.max_messages)
+        .then([w](future<StatusOr<google::pubsub::v1::PullResponse>> f)
+                  -> StatusOr<pubsub::PullResult> {
+          auto response = f.get();
+          if (!response) return std::move(response).status();
+          return MakePullResult(w, *std::move(response));
+        });
+  }
+
  private:
+  std::string MakeClientId() {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto constexpr kLength = 32;
+    auto constexpr kChars = "abcdefghijklmnopqrstuvwxyz0123456789";
+    return google::cloud::internal::Sample(generator_, kLength, kChars);
+  }
+
   pubsub::Subscription const subscription_;
   pubsub::SubscriberOptions const options_;
   std::shared_ptr<pubsub_internal::SubscriberStub> stub_;
@@ -101,6 +149,9 @@ class SubscriberConnectionImpl : public pubsub::SubscriberConnection {
   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy_;
   std::mutex mu_;
   google::cloud::internal::DefaultPRNG generator_;
+  std::shared_ptr<SessionShutdownManager> const pull_shutdown_;
+  std::shared_ptr<PullSubscriptionBatchSource> const pull_source_;
+  std::shared_ptr<SubscriptionLeaseManagement> const pull_leases_;
 };
 }  // namespace
 
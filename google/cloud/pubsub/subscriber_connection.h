@@ -18,14 +18,17 @@
 #include "google/cloud/pubsub/ack_handler.h"
 #include "google/cloud/pubsub/application_callback.h"
 #include "google/cloud/pubsub/backoff_policy.h"
+#include "google/cloud/pubsub/batch_ack_handler.h"
 #include "google/cloud/pubsub/connection_options.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/message.h"
+#include "google/cloud/pubsub/pull_result.h"
 #include "google/cloud/pubsub/retry_policy.h"
 #include "google/cloud/pubsub/subscriber_options.h"
 #include "google/cloud/pubsub/subscription.h"
 #include "google/cloud/pubsub/version.h"
 #include "google/cloud/status_or.h"
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -61,8 +64,25 @@ class SubscriberConnection {
     ApplicationCallback callback;
   };
 
+  /// Wrap the arguments for `SubscribeBatch()`
+  struct SubscribeBatchParams {
+    BatchApplicationCallback callback;
+  };
+
+  /// Wrap the arguments for `AsyncPull()`
+  struct PullParams {
+    std::int32_t max_messages;
+  };
+
   /// Defines the interface for `Subscriber::Subscribe()`
   virtual future<Status> Subscribe(SubscribeParams p);
+
+  /// Defines the interface for `Subscriber::SubscribeBatch()`
+  virtual future<Status> SubscribeBatch(SubscribeBatchParams p);
+
+  /// Defines the interface for `Subscriber::Pull()` and
+  /// `Subscriber::AsyncPull()`
+  virtual future<StatusOr<PullResult>> AsyncPull(PullParams p);
 };
 
 /**
@@ -34,6 +34,7 @@ using ::google::cloud::testing_util::IsContextMDValid;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::AtLeast;
 using ::testing::Contains;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
 using ::testing::StartsWith;
 
@@ -84,6 +85,45 @@ TEST(SubscriberConnectionTest, Basic) {
   t.join();
 }
 
+TEST(SubscriberConnectionTest, AsyncPull) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  Subscription const subscription("test-project", "test-subscription");
+  EXPECT_CALL(*mock, AsyncPull)
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PullRequest const& request) {
+        EXPECT_EQ(subscription.FullName(), request.subscription());
+        EXPECT_EQ(10, request.max_messages());
+        google::pubsub::v1::PullResponse response;
+        for (int i = 0; i != 2; ++i) {
+          auto& m = *response.add_received_messages();
+          m.set_ack_id("test-ack-id-" + std::to_string(i));
+          m.mutable_message()->set_message_id("test-message-id-" +
+                                              std::to_string(i));
+        }
+        return make_ready_future(make_status_or(std::move(response)));
+      });
+  EXPECT_CALL(*mock, AsyncAcknowledge)
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   google::pubsub::v1::AcknowledgeRequest const& request) {
+        EXPECT_THAT(request.ack_ids(),
+                    ElementsAre("test-ack-id-0", "test-ack-id-1"));
+        return make_ready_future(Status{});
+      });
+
+  auto subscriber = pubsub_internal::MakeSubscriberConnection(
+      subscription, {}, ConnectionOptions{grpc::InsecureChannelCredentials()},
+      mock, pubsub_testing::TestRetryPolicy(),
+      pubsub_testing::TestBackoffPolicy());
+  auto result = subscriber->AsyncPull({10}).get();
+  ASSERT_STATUS_OK(result);
+  ASSERT_EQ(2, result->messages.size());
+  EXPECT_EQ("test-message-id-0", result->messages[0].message_id());
+  EXPECT_EQ("test-message-id-1", result->messages[1].message_id());
+  std::move(result->handler).ack();
+}
+
 TEST(SubscriberConnectionTest, PullFailure) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
   Subscription const subscription("test-project", "test-subscription");
@@ -17,6 +17,7 @@
 
 #include "google/cloud/pubsub/version.h"
 #include <chrono>
+#include <functional>
 #include <thread>
 
 namespace google {
@@ -186,6 +187,56 @@ class SubscriberOptions {
   /// Maximum number of callbacks scheduled by the library at a time.
   std::size_t max_concurrency() const { return max_concurrency_; }
 
+  /**
+   * Set the number of `StreamingPull` streams used by each subscription.
+   *
+   * A single stream delivers messages at roughly 10 MB/s. Applications
+   * receiving messages at higher rates can open several streams for the same
+   * subscription. The streams are spread across the connection's gRPC
+   * channels, and all of them deliver messages to the same callbacks, subject
+   * to the same `max_concurrency()` limit.
+   *
+   * The flow control limits (see `set_max_outstanding_messages()` and
+   * `set_max_outstanding_bytes()`) apply to the subscription as a whole, each
+   * stream gets an equal share of them.
+   *
+   * @param v the new value, 0 resets to the default (1)
+   */
+  SubscriberOptions& set_parallel_streams(std::size_t v) {
+    parallel_streams_ = v == 0 ? 1 : v;
+    return *this;
+  }
+  std::size_t parallel_streams() const { return parallel_streams_; }
+
+  /// The type of the functions used to run application callbacks.
+  using CallbackExecutor = std::function<void(std::function<void()>)>;
+
+  /**
+   * Run the application callbacks using @p executor.
+   *
+   * By default the callbacks run in the background threads of the
+   * `SubscriberConnection`, which also process the streaming pull I/O, the
+   * acks, and the lease extensions. CPU-intensive callbacks may delay that
+   * work. Applications can use this option to run the callbacks in their own
+   * thread pool instead, while the I/O stays on the background threads.
+   *
+   * The library calls @p executor with a function that runs one callback (or
+   * one batch of messages, see `Subscriber::SubscribeBatch()`). The executor
+   * must call this function exactly once, typically in a different thread.
+   * The number of callbacks scheduled at a time is still limited by
+   * `max_concurrency()`, so the executor does not need to provide any flow
+   * control.
+   *
+   * @param executor the new executor, an empty function restores the default.
+   */
+  SubscriberOptions& set_callback_executor(CallbackExecutor executor) {
+    callback_executor_ = std::move(executor);
+    return *this;
+  }
+  CallbackExecutor const& callback_executor() const {
+    return callback_executor_;
+  }
+
   /**
    * Control how often the session polls for automatic shutdowns.
    *
@@ -203,6 +254,56 @@ class SubscriberOptions {
     return shutdown_polling_period_;
   }
 
+  /**
+   * Bound the time to shutdown a session.
+   *
+   * When the application shuts down a session (via `future<Status>::cancel()`)
+   * the library stops extending the message leases, and immediately nacks all
+   * the outstanding messages, using batched `ModifyAckDeadline(0)` requests.
+   * The service can redeliver these messages to other subscribers right away.
+   * The session then waits for the running callbacks to return, and for the
+   * nack requests to complete, before satisfying the `future<Status>`.
+   *
+   * With a non-zero value the session waits at most @p v. Applications that
+   * shutdown frequently, for example, during rolling restarts, may use this to
+   * bound the time to drain a subscriber. The callbacks that are still running
+   * when this time expires may keep running, their acks and nacks are ignored.
+   *
+   * @param v the maximum time to wait, `0` (the default) waits until all the
+   *     callbacks return.
+   */
+  SubscriberOptions& set_max_shutdown_time(std::chrono::milliseconds v) {
+    max_shutdown_time_ = v;
+    return *this;
+  }
+  std::chrono::milliseconds max_shutdown_time() const {
+    return max_shutdown_time_;
+  }
+
+  /**
+   * Size the buffer of prefetched messages based on the processing rate.
+   *
+   * The flow control limits (see `set_max_outstanding_messages()` and
+   * `set_max_outstanding_bytes()`) are sent to the service when each stream
+   * starts. Slow subscribers may hold many more messages than they can
+   * process, while other subscribers are idle. With a non-zero value the
+   * library measures how fast the callbacks ack or nack messages, and stops
+   * reading from the stream once it has enough messages for the callbacks
+   * in progress (see `set_max_concurrency()`), plus the messages the
+   * callbacks handle in about @p v. The configured limits remain the upper
+   * bounds.
+   *
+   * @param v the time the prefetched messages should last, `0` (the default)
+   *     disables the adaptive buffer and only uses the configured limits.
+   */
+  SubscriberOptions& set_prefetch_buffer_time(std::chrono::milliseconds v) {
+    prefetch_buffer_time_ = v;
+    return *this;
+  }
+  std::chrono::milliseconds prefetch_buffer_time() const {
+    return prefetch_buffer_time_;
+  }
+
  private:
   static std::size_t DefaultMaxConcurrency() {
     auto constexpr kDefaultMaxConcurrency = 4;
@@ -215,7 +316,12 @@ class SubscriberOptions {
   std::int64_t max_outstanding_messages_ = 1000;
   std::int64_t max_outstanding_bytes_ = 100 * 1024 * 1024L;
   std::size_t max_concurrency_ = DefaultMaxConcurrency();
+  std::size_t parallel_streams_ = 1;
+  CallbackExecutor callback_executor_;
   std::chrono::milliseconds shutdown_polling_period_ = std::chrono::seconds(5);
+  std::chrono::milliseconds max_shutdown_time_ = std::chrono::milliseconds(0);
+  std::chrono::milliseconds prefetch_buffer_time_ =
+      std::chrono::milliseconds(0);
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
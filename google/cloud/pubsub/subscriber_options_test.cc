@@ -30,6 +30,7 @@ TEST(SubscriberOptionsTest, Default) {
   EXPECT_LT(0, options.max_outstanding_messages());
   EXPECT_LT(0, options.max_outstanding_bytes());
   EXPECT_LT(0, options.max_concurrency());
+  EXPECT_EQ(1, options.parallel_streams());
 }
 
 TEST(SubscriberOptionsTest, SetDeadlineExtension) {
@@ -68,6 +69,48 @@ TEST(SubscriberOptionsTest, SetConcurrency) {
   EXPECT_EQ(SubscriberOptions{}.max_concurrency(), options.max_concurrency());
 }
 
+TEST(SubscriberOptionsTest, SetParallelStreams) {
+  auto options = SubscriberOptions{}.set_parallel_streams(4);
+  EXPECT_EQ(4, options.parallel_streams());
+
+  // 0 resets to default
+  options.set_parallel_streams(0);
+  EXPECT_EQ(1, options.parallel_streams());
+}
+
+TEST(SubscriberOptionsTest, SetCallbackExecutor) {
+  EXPECT_FALSE(SubscriberOptions{}.callback_executor());
+
+  int calls = 0;
+  auto options = SubscriberOptions{}.set_callback_executor(
+      [&calls](std::function<void()> f) {
+        ++calls;
+        f();
+      });
+  ASSERT_TRUE(options.callback_executor());
+  bool ran = false;
+  options.callback_executor()([&ran] { ran = true; });
+  EXPECT_EQ(1, calls);
+  EXPECT_TRUE(ran);
+
+  options.set_callback_executor({});
+  EXPECT_FALSE(options.callback_executor());
+}
+
+TEST(SubscriberOptionsTest, SetMaxShutdownTime) {
+  using ms = std::chrono::milliseconds;
+  EXPECT_EQ(ms(0), SubscriberOptions{}.max_shutdown_time());
+  auto options = SubscriberOptions{}.set_max_shutdown_time(ms(500));
+  EXPECT_EQ(ms(500), options.max_shutdown_time());
+}
+
+TEST(SubscriberOptionsTest, SetPrefetchBufferTime) {
+  using ms = std::chrono::milliseconds;
+  EXPECT_EQ(ms(0), SubscriberOptions{}.prefetch_buffer_time());
+  auto options = SubscriberOptions{}.set_prefetch_buffer_time(ms(2000));
+  EXPECT_EQ(ms(2000), options.prefetch_buffer_time());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub
@@ -76,6 +76,35 @@ TEST(SubscriberTest, SubscribeWithOptions) {
   ASSERT_STATUS_OK(status);
 }
 
+/// @test Verify Subscriber::SubscribeBatch() works, including mocks.
+TEST(SubscriberTest, SubscribeBatch) {
+  auto mock = std::make_shared<pubsub_mocks::MockSubscriberConnection>();
+  EXPECT_CALL(*mock, SubscribeBatch)
+      .WillOnce([&](SubscriberConnection::SubscribeBatchParams const& p) {
+        auto ack = absl::make_unique<pubsub_mocks::MockBatchAckHandler>();
+        EXPECT_CALL(*ack, ack()).Times(1);
+        std::vector<Message> messages{
+            pubsub::MessageBuilder{}.SetData("m0").Build(),
+            pubsub::MessageBuilder{}.SetData("m1").Build()};
+        p.callback(std::move(messages), BatchAckHandler(std::move(ack)));
+        return make_ready_future(Status{});
+      });
+
+  Subscriber subscriber(mock);
+  std::vector<std::string> received;
+  auto status = subscriber
+                    .SubscribeBatch([&](std::vector<Message> const& messages,
+                                        BatchAckHandler h) {
+                      for (auto const& m : messages) {
+                        received.push_back(m.data());
+                      }
+                      std::move(h).ack();
+                    })
+                    .get();
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(received, ::testing::ElementsAre("m0", "m1"));
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub
@@ -68,6 +68,12 @@ class MockSubscriberStub : public pubsub_internal::SubscriberStub {
                google::pubsub::v1::StreamingPullRequest const&),
               (override));
 
+  MOCK_METHOD(future<StatusOr<google::pubsub::v1::PullResponse>>, AsyncPull,
+              (google::cloud::CompletionQueue&,
+               std::unique_ptr<grpc::ClientContext>,
+               google::pubsub::v1::PullRequest const&),
+              (override));
+
   MOCK_METHOD(future<Status>, AsyncAcknowledge,
               (google::cloud::CompletionQueue&,
                std::unique_ptr<grpc::ClientContext>,
@@ -34,6 +34,7 @@ class MockSubscriptionBatchSource
   MOCK_METHOD(void, Shutdown, (), (override));
   MOCK_METHOD(void, AckMessage, (std::string const& ack_id), (override));
   MOCK_METHOD(void, NackMessage, (std::string const& ack_id), (override));
+  MOCK_METHOD(void, BulkAck, (std::vector<std::string> ack_ids), (override));
   MOCK_METHOD(void, BulkNack, (std::vector<std::string> ack_ids), (override));
   MOCK_METHOD(void, ExtendLeases,
               (std::vector<std::string> ack_ids,
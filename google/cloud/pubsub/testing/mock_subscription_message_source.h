@@ -33,6 +33,8 @@ class MockSubscriptionMessageSource
   MOCK_METHOD(void, Read, (std::size_t max_callbacks), (override));
   MOCK_METHOD(void, AckMessage, (std::string const& ack_id), (override));
   MOCK_METHOD(void, NackMessage, (std::string const& ack_id), (override));
+  MOCK_METHOD(void, BulkAck, (std::vector<std::string> ack_ids), (override));
+  MOCK_METHOD(void, BulkNack, (std::vector<std::string> ack_ids), (override));
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
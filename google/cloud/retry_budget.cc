@@ -0,0 +1,69 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/retry_budget.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+RetryBudget::RetryBudget(double max_tokens, double token_ratio)
+    : max_tokens_(static_cast<std::int64_t>(max_tokens * kScale)),
+      token_ratio_(static_cast<std::int64_t>(token_ratio * kScale)),
+      tokens_(max_tokens_) {}
+
+void RetryBudget::OnSuccess() {
+  successes_.fetch_add(1, std::memory_order_relaxed);
+  auto current = tokens_.load(std::memory_order_relaxed);
+  std::int64_t updated;
+  do {
+    updated = (std::min)(max_tokens_, current + token_ratio_);
+    if (updated == current) return;
+  } while (!tokens_.compare_exchange_weak(current, updated,
+                                          std::memory_order_relaxed));
+}
+
+bool RetryBudget::OnFailure() {
+  auto current = tokens_.load(std::memory_order_relaxed);
+  std::int64_t updated;
+  do {
+    updated = (std::max)(std::int64_t{0}, current - kScale);
+  } while (!tokens_.compare_exchange_weak(current, updated,
+                                          std::memory_order_relaxed));
+  if (updated > max_tokens_ / 2) {
+    retries_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  throttled_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+RetryBudgetMetrics RetryBudget::Metrics() const {
+  return RetryBudgetMetrics{
+      successes_.load(std::memory_order_relaxed),
+      retries_.load(std::memory_order_relaxed),
+      throttled_.load(std::memory_order_relaxed),
+      static_cast<double>(tokens_.load(std::memory_order_relaxed)) / kScale};
+}
+
+std::shared_ptr<RetryBudget> GlobalRetryBudget() {
+  static auto* const kBudget = new std::shared_ptr<RetryBudget>(
+      std::make_shared<RetryBudget>());
+  return *kBudget;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
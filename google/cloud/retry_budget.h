@@ -0,0 +1,170 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RETRY_BUDGET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RETRY_BUDGET_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/// A point-in-time copy of the counters in a `RetryBudget`.
+struct RetryBudgetMetrics {
+  /// The number of calls that completed without exhausting their retries.
+  std::uint64_t successes;
+  /// The number of failed attempts that the budget allowed to retry.
+  std::uint64_t retries;
+  /// The number of failed attempts that the budget did not allow to retry.
+  std::uint64_t throttled;
+  /// The tokens currently in the budget.
+  double tokens;
+};
+
+/**
+ * A token bucket shared by many calls, limiting their retries.
+ *
+ * The retry policies limit the retries of each call. During an outage every
+ * call retries, even though most retries fail, and the retries add to the load
+ * on the service. A `RetryBudget` limits the retries across all the calls that
+ * share it, to a fraction of the successful calls.
+ *
+ * This uses the same algorithm as gRPC's retry throttling: the budget starts
+ * with @p max_tokens tokens, each failed attempt removes one token, and each
+ * successful call adds @p token_ratio tokens, up to @p max_tokens. Failed
+ * attempts may retry only while the budget has more than half its maximum
+ * tokens. With the defaults, the calls stop retrying when more than about 1 in
+ * 10 calls fail, and resume once enough calls succeed.
+ *
+ * Use `RetryBudgetPolicy` to apply a budget to the retry policies of any
+ * client. Share one budget per client, or use `GlobalRetryBudget()` to share
+ * it across the process.
+ */
+class RetryBudget {
+ public:
+  explicit RetryBudget(double max_tokens = 100.0, double token_ratio = 0.1);
+
+  RetryBudget(RetryBudget const&) = delete;
+  RetryBudget& operator=(RetryBudget const&) = delete;
+
+  /// Records a call that completed without exhausting its retries.
+  void OnSuccess();
+
+  /// Records a failed attempt, returns true if the attempt may be retried.
+  bool OnFailure();
+
+  /// Returns a snapshot of the counters.
+  RetryBudgetMetrics Metrics() const;
+
+ private:
+  // The tokens are stored in thousandths, so they can be updated atomically.
+  static std::int64_t constexpr kScale = 1000;
+
+  std::int64_t const max_tokens_;
+  std::int64_t const token_ratio_;
+  std::atomic<std::int64_t> tokens_;
+  std::atomic<std::uint64_t> successes_{0};
+  std::atomic<std::uint64_t> retries_{0};
+  std::atomic<std::uint64_t> throttled_{0};
+};
+
+/// Returns a budget shared by all the clients in the process.
+std::shared_ptr<RetryBudget> GlobalRetryBudget();
+
+/**
+ * Decorates a retry policy with a `RetryBudget`.
+ *
+ * Works with the retry policies for any client based on
+ * `google::cloud::internal::TraitBasedRetryPolicy`, including the Spanner,
+ * Pub/Sub, and Storage retry policies. Like any other policy, this object is
+ * a prototype, each call uses a copy created with `clone()`.
+ *
+ * @par Example
+ * @code
+ * namespace spanner = ::google::cloud::spanner;
+ * auto budget = std::make_shared<google::cloud::RetryBudget>();
+ * auto policy = google::cloud::RetryBudgetPolicy<spanner::RetryPolicy>(
+ *     budget, spanner::LimitedTimeRetryPolicy(std::chrono::minutes(10)));
+ * @endcode
+ *
+ * @tparam RetryPolicyType the base class for the service retry policies, for
+ *     example `spanner::RetryPolicy` or `storage::RetryPolicy`.
+ */
+template <typename RetryPolicyType>
+class RetryBudgetPolicy : public RetryPolicyType {
+ public:
+  RetryBudgetPolicy(std::shared_ptr<RetryBudget> budget,
+                    RetryPolicyType const& child)
+      : budget_(std::move(budget)), child_(child.clone()) {}
+
+  RetryBudgetPolicy(RetryBudgetPolicy const& rhs)
+      : budget_(rhs.budget_), child_(rhs.child_->clone()) {}
+
+  ~RetryBudgetPolicy() override {
+    // The loops call `IsExhausted()` before each attempt, unused copies (such
+    // as prototypes) do not count as successful calls.
+    if (attempted_ && !gave_up_) budget_->OnSuccess();
+  }
+
+  std::unique_ptr<RetryPolicyType> clone() const override {
+    return std::unique_ptr<RetryPolicyType>(new RetryBudgetPolicy(*this));
+  }
+
+  bool OnFailure(Status const& status) override {
+    if (!child_->OnFailure(status)) {
+      gave_up_ = true;
+      return false;
+    }
+    if (!budget_->OnFailure()) {
+      gave_up_ = throttled_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  bool IsExhausted() const override {
+    attempted_ = true;
+    return throttled_ || child_->IsExhausted();
+  }
+
+  bool IsPermanentFailure(Status const& status) const override {
+    return child_->IsPermanentFailure(status);
+  }
+
+  std::chrono::system_clock::time_point deadline() const override {
+    return child_->deadline();
+  }
+
+ protected:
+  void OnFailureImpl() override {}
+
+ private:
+  std::shared_ptr<RetryBudget> budget_;
+  std::unique_ptr<RetryPolicyType> child_;
+  mutable bool attempted_ = false;
+  bool gave_up_ = false;
+  bool throttled_ = false;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RETRY_BUDGET_H
@@ -0,0 +1,169 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/retry_budget.h"
+#include "google/cloud/internal/retry_policy.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+struct TestRetryablePolicy {
+  static bool IsPermanentFailure(google::cloud::Status const& s) {
+    return !s.ok() &&
+           (s.code() == google::cloud::StatusCode::kPermissionDenied);
+  }
+};
+
+Status CreateTransientError() { return Status(StatusCode::kUnavailable, ""); }
+Status CreatePermanentError() {
+  return Status(StatusCode::kPermissionDenied, "");
+}
+
+using RetryPolicyForTest =
+    google::cloud::internal::TraitBasedRetryPolicy<TestRetryablePolicy>;
+using LimitedErrorCountRetryPolicyForTest =
+    google::cloud::internal::LimitedErrorCountRetryPolicy<TestRetryablePolicy>;
+using RetryBudgetPolicyForTest = RetryBudgetPolicy<RetryPolicyForTest>;
+
+TEST(RetryBudget, Initial) {
+  RetryBudget tested(10.0, 0.5);
+  auto const metrics = tested.Metrics();
+  EXPECT_EQ(0, metrics.successes);
+  EXPECT_EQ(0, metrics.retries);
+  EXPECT_EQ(0, metrics.throttled);
+  EXPECT_DOUBLE_EQ(10.0, metrics.tokens);
+}
+
+TEST(RetryBudget, ThrottleAtHalf) {
+  RetryBudget tested(10.0, 0.5);
+  for (int i = 0; i != 4; ++i) EXPECT_TRUE(tested.OnFailure()) << "i=" << i;
+  // The budget has 5 tokens, that is not more than half.
+  EXPECT_FALSE(tested.OnFailure());
+  auto metrics = tested.Metrics();
+  EXPECT_EQ(4, metrics.retries);
+  EXPECT_EQ(1, metrics.throttled);
+  EXPECT_DOUBLE_EQ(5.0, metrics.tokens);
+
+  // Each success adds 0.5 tokens.
+  tested.OnSuccess();
+  tested.OnSuccess();
+  tested.OnSuccess();
+  EXPECT_TRUE(tested.OnFailure());
+  metrics = tested.Metrics();
+  EXPECT_EQ(3, metrics.successes);
+  EXPECT_DOUBLE_EQ(5.5, metrics.tokens);
+}
+
+TEST(RetryBudget, Bounds) {
+  RetryBudget tested(2.0, 1.0);
+  for (int i = 0; i != 5; ++i) tested.OnFailure();
+  EXPECT_DOUBLE_EQ(0.0, tested.Metrics().tokens);
+  for (int i = 0; i != 5; ++i) tested.OnSuccess();
+  EXPECT_DOUBLE_EQ(2.0, tested.Metrics().tokens);
+}
+
+TEST(RetryBudget, Concurrent) {
+  RetryBudget tested(1000.0, 1.0);
+  auto constexpr kThreads = 4;
+  auto constexpr kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&tested] {
+      for (int i = 0; i != kIterations; ++i) {
+        tested.OnFailure();
+        tested.OnSuccess();
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  auto const metrics = tested.Metrics();
+  EXPECT_EQ(kThreads * kIterations, metrics.successes);
+  EXPECT_EQ(kThreads * kIterations, metrics.retries + metrics.throttled);
+}
+
+TEST(RetryBudget, Global) {
+  auto b0 = GlobalRetryBudget();
+  auto b1 = GlobalRetryBudget();
+  ASSERT_NE(nullptr, b0);
+  EXPECT_EQ(b0.get(), b1.get());
+}
+
+TEST(RetryBudgetPolicy, ForwardsToChild) {
+  auto budget = std::make_shared<RetryBudget>();
+  RetryBudgetPolicyForTest tested(budget,
+                                  LimitedErrorCountRetryPolicyForTest(2));
+  EXPECT_FALSE(tested.IsExhausted());
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_FALSE(tested.OnFailure(CreateTransientError()));
+  EXPECT_TRUE(tested.IsExhausted());
+  EXPECT_TRUE(tested.IsPermanentFailure(CreatePermanentError()));
+  EXPECT_FALSE(tested.IsPermanentFailure(CreateTransientError()));
+  EXPECT_EQ(2, budget->Metrics().retries);
+}
+
+TEST(RetryBudgetPolicy, PermanentFailure) {
+  auto budget = std::make_shared<RetryBudget>();
+  RetryBudgetPolicyForTest tested(budget,
+                                  LimitedErrorCountRetryPolicyForTest(2));
+  EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
+  // Permanent failures do not use the budget, nor exhaust the policy.
+  EXPECT_FALSE(tested.IsExhausted());
+  EXPECT_EQ(0, budget->Metrics().throttled);
+  EXPECT_DOUBLE_EQ(100.0, budget->Metrics().tokens);
+}
+
+TEST(RetryBudgetPolicy, Throttled) {
+  auto budget = std::make_shared<RetryBudget>(4.0, 1.0);
+  RetryBudgetPolicyForTest prototype(budget,
+                                     LimitedErrorCountRetryPolicyForTest(10));
+  auto p0 = prototype.clone();
+  EXPECT_FALSE(p0->IsExhausted());
+  EXPECT_TRUE(p0->OnFailure(CreateTransientError()));
+  // The budget is shared by all the copies.
+  auto p1 = prototype.clone();
+  EXPECT_FALSE(p1->IsExhausted());
+  EXPECT_FALSE(p1->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(p1->IsExhausted());
+  auto const metrics = budget->Metrics();
+  EXPECT_EQ(1, metrics.retries);
+  EXPECT_EQ(1, metrics.throttled);
+}
+
+TEST(RetryBudgetPolicy, SuccessRefillsBudget) {
+  auto budget = std::make_shared<RetryBudget>(4.0, 1.0);
+  RetryBudgetPolicyForTest prototype(budget,
+                                     LimitedErrorCountRetryPolicyForTest(10));
+  {
+    auto tested = prototype.clone();
+    EXPECT_FALSE(tested->IsExhausted());
+    EXPECT_TRUE(tested->OnFailure(CreateTransientError()));
+    EXPECT_FALSE(tested->IsExhausted());
+  }
+  // Copies that are never used do not count as successful calls.
+  { auto unused = prototype.clone(); }
+  auto const metrics = budget->Metrics();
+  EXPECT_EQ(1, metrics.successes);
+  EXPECT_DOUBLE_EQ(4.0, metrics.tokens);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,199 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_metrics.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#if _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+std::size_t constexpr RpcLatencyHistogram::kBucketCount;
+std::size_t constexpr RpcMetrics::kTableSize;
+
+void RpcLatencyHistogram::Record(std::chrono::nanoseconds latency) {
+  auto const us =
+      std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  std::size_t bucket = 0;
+  for (auto v = us; v > 0 && bucket + 1 < kBucketCount; v >>= 1) ++bucket;
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+RpcLatencyHistogram::Counts RpcLatencyHistogram::counts() const {
+  Counts result;
+  for (std::size_t i = 0; i != kBucketCount; ++i) {
+    result[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+std::chrono::microseconds RpcLatencyHistogram::BucketUpperBound(
+    std::size_t i) {
+  if (i + 1 >= kBucketCount) return std::chrono::microseconds::max();
+  return std::chrono::microseconds(std::int64_t{1} << i);
+}
+
+void RpcMethodMetrics::RecordCall(std::chrono::nanoseconds latency,
+                                  Status const& status) {
+  calls_.fetch_add(1, std::memory_order_relaxed);
+  if (!status.ok()) errors_.fetch_add(1, std::memory_order_relaxed);
+  latency_.Record(latency);
+}
+
+void RpcMethodMetrics::RecordResources(std::chrono::nanoseconds cpu_time,
+                                       std::int64_t allocations) {
+  if (cpu_time.count() > 0) {
+    cpu_time_ns_.fetch_add(static_cast<std::uint64_t>(cpu_time.count()),
+                           std::memory_order_relaxed);
+  }
+  if (allocations > 0) {
+    allocations_.fetch_add(static_cast<std::uint64_t>(allocations),
+                           std::memory_order_relaxed);
+  }
+}
+
+RpcMethodMetricsSnapshot RpcMethodMetrics::Snapshot() const {
+  return RpcMethodMetricsSnapshot{
+      std::string{},
+      calls_.load(std::memory_order_relaxed),
+      errors_.load(std::memory_order_relaxed),
+      retries_.load(std::memory_order_relaxed),
+      bytes_sent_.load(std::memory_order_relaxed),
+      bytes_received_.load(std::memory_order_relaxed),
+      latency_.counts(),
+      std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(
+          cpu_time_ns_.load(std::memory_order_relaxed))),
+      allocations_.load(std::memory_order_relaxed)};
+}
+
+RpcMetrics::RpcMetrics() = default;
+
+RpcMetrics::RpcMetrics(RpcResourceAccounting accounting)
+    : accounting_(new RpcResourceAccounting(std::move(accounting))) {}
+
+RpcMetrics::~RpcMetrics() {
+  for (auto& slot : table_) delete slot.load();
+}
+
+RpcMethodMetrics& RpcMetrics::Method(char const* method) {
+  auto const hash =
+      static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(method) >> 3);
+  for (std::size_t i = 0; i != kTableSize; ++i) {
+    auto& slot = table_[(hash + i) % kTableSize];
+    auto* entry = slot.load(std::memory_order_acquire);
+    if (entry == nullptr) {
+      auto candidate =
+          std::unique_ptr<Entry>(new Entry(method, accounting_.get()));
+      if (slot.compare_exchange_strong(entry, candidate.get(),
+                                       std::memory_order_acq_rel)) {
+        return candidate.release()->metrics;
+      }
+      // Another thread won the race, `entry` holds its value.
+    }
+    if (entry->key == method) return entry->metrics;
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& entry = overflow_[method];
+  if (!entry) entry.reset(new Entry(method, accounting_.get()));
+  return entry->metrics;
+}
+
+std::vector<RpcMethodMetricsSnapshot> RpcMetrics::Snapshot() const {
+  std::map<std::string, RpcMethodMetricsSnapshot> merged;
+  auto merge = [&merged](Entry const& e) {
+    auto s = e.metrics.Snapshot();
+    auto ins = merged.emplace(e.name, s);
+    auto& m = ins.first->second;
+    m.method = e.name;
+    if (ins.second) return;
+    m.calls += s.calls;
+    m.errors += s.errors;
+    m.retries += s.retries;
+    m.bytes_sent += s.bytes_sent;
+    m.bytes_received += s.bytes_received;
+    m.cpu_time += s.cpu_time;
+    m.allocations += s.allocations;
+    for (std::size_t i = 0; i != m.latency.size(); ++i) {
+      m.latency[i] += s.latency[i];
+    }
+  };
+  for (auto const& slot : table_) {
+    auto const* entry = slot.load(std::memory_order_acquire);
+    if (entry != nullptr) merge(*entry);
+  }
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto const& kv : overflow_) merge(*kv.second);
+  }
+  std::vector<RpcMethodMetricsSnapshot> result;
+  result.reserve(merged.size());
+  for (auto& kv : merged) result.push_back(std::move(kv.second));
+  return result;
+}
+
+void RpcMetrics::Export(RpcMetricsExporter& exporter) const {
+  exporter.Export(Snapshot());
+}
+
+namespace internal {
+namespace {
+thread_local int current_retry_attempt = 0;
+}  // namespace
+
+RetryAttemptScope::RetryAttemptScope(int attempt)
+    : previous_(current_retry_attempt) {
+  current_retry_attempt = attempt;
+}
+
+RetryAttemptScope::~RetryAttemptScope() { current_retry_attempt = previous_; }
+
+int CurrentRetryAttempt() { return current_retry_attempt; }
+
+std::chrono::nanoseconds ThreadCpuTime() {
+#if defined(_WIN32)
+  FILETIME creation;
+  FILETIME exit;
+  FILETIME kernel;
+  FILETIME user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+    return std::chrono::nanoseconds(0);
+  }
+  auto as_int64 = [](FILETIME const& t) {
+    return (static_cast<std::int64_t>(t.dwHighDateTime) << 32) +
+           t.dwLowDateTime;
+  };
+  // FILETIME counts 100ns intervals.
+  return std::chrono::nanoseconds((as_int64(kernel) + as_int64(user)) * 100);
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#else
+  return std::chrono::nanoseconds(0);
+#endif  // _WIN32
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,276 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * A lock-free histogram of RPC latencies.
+ *
+ * The buckets grow exponentially: bucket 0 counts latencies below 1
+ * microsecond, and bucket `i > 0` counts latencies in the
+ * `[2^(i-1), 2^i)` microseconds range. The last bucket also counts any
+ * larger latencies.
+ */
+class RpcLatencyHistogram {
+ public:
+  static std::size_t constexpr kBucketCount = 32;
+  using Counts = std::array<std::uint64_t, kBucketCount>;
+
+  RpcLatencyHistogram() = default;
+  RpcLatencyHistogram(RpcLatencyHistogram const&) = delete;
+  RpcLatencyHistogram& operator=(RpcLatencyHistogram const&) = delete;
+
+  void Record(std::chrono::nanoseconds latency);
+  Counts counts() const;
+
+  /// The (exclusive) upper bound for bucket @p i.
+  static std::chrono::microseconds BucketUpperBound(std::size_t i);
+
+ private:
+  std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+};
+
+/**
+ * Counts the memory allocations made by the application.
+ *
+ * The library does not replace the global allocation functions. Applications
+ * that want allocation counts in `RpcMetrics` implement this interface, for
+ * example, using the statistics of their memory allocator.
+ */
+class RpcAllocationCounter {
+ public:
+  virtual ~RpcAllocationCounter() = default;
+
+  /**
+   * The number of allocations made so far.
+   *
+   * Counters that can only measure the allocations for the whole process also
+   * count the allocations made by other threads while an RPC is running.
+   */
+  virtual std::int64_t Count() = 0;
+};
+
+/**
+ * Configures the per-call resource accounting in `RpcMetrics`.
+ *
+ * With resource accounting enabled the clients also record, for each call,
+ * the CPU time used by the calling thread while running the client library
+ * layers and the gRPC stub. This excludes the time blocked waiting for the
+ * service. For asynchronous calls only the work to start the call is
+ * recorded.
+ */
+struct RpcResourceAccounting {
+  /// If set, the clients also record the allocations made during each call.
+  std::shared_ptr<RpcAllocationCounter> allocation_counter;
+};
+
+/// A point-in-time copy of the metrics for one RPC method.
+struct RpcMethodMetricsSnapshot {
+  std::string method;
+  std::uint64_t calls;
+  std::uint64_t errors;
+  std::uint64_t retries;
+  std::uint64_t bytes_sent;
+  std::uint64_t bytes_received;
+  RpcLatencyHistogram::Counts latency;
+  /// The client CPU time, zero unless resource accounting is enabled.
+  std::chrono::nanoseconds cpu_time;
+  /// The client allocations, zero unless an allocation counter is configured.
+  std::uint64_t allocations;
+};
+
+/**
+ * The counters and latency histogram for one RPC method.
+ *
+ * All the member functions are thread-safe, and the `Record*()` functions
+ * only use relaxed atomic increments.
+ */
+class RpcMethodMetrics {
+ public:
+  RpcMethodMetrics() = default;
+  explicit RpcMethodMetrics(RpcResourceAccounting const* accounting)
+      : accounting_(accounting) {}
+  RpcMethodMetrics(RpcMethodMetrics const&) = delete;
+  RpcMethodMetrics& operator=(RpcMethodMetrics const&) = delete;
+
+  /// Record a completed call (or attempt) with its latency and result.
+  void RecordCall(std::chrono::nanoseconds latency, Status const& status);
+  /// Record that a call was a retry of a previous, failed, attempt.
+  void RecordRetry() { retries_.fetch_add(1, std::memory_order_relaxed); }
+  void RecordBytesSent(std::uint64_t n) {
+    bytes_sent_.fetch_add(n, std::memory_order_relaxed);
+  }
+  void RecordBytesReceived(std::uint64_t n) {
+    bytes_received_.fetch_add(n, std::memory_order_relaxed);
+  }
+  /// Record the client resources used by a call.
+  void RecordResources(std::chrono::nanoseconds cpu_time,
+                       std::int64_t allocations);
+
+  /// The resource accounting configuration, `nullptr` if it is disabled.
+  RpcResourceAccounting const* resource_accounting() const {
+    return accounting_;
+  }
+
+  /// Returns a snapshot, with an empty `method` field.
+  RpcMethodMetricsSnapshot Snapshot() const;
+
+ private:
+  std::atomic<std::uint64_t> calls_{0};
+  std::atomic<std::uint64_t> errors_{0};
+  std::atomic<std::uint64_t> retries_{0};
+  std::atomic<std::uint64_t> bytes_sent_{0};
+  std::atomic<std::uint64_t> bytes_received_{0};
+  std::atomic<std::uint64_t> cpu_time_ns_{0};
+  std::atomic<std::uint64_t> allocations_{0};
+  RpcLatencyHistogram latency_;
+  RpcResourceAccounting const* accounting_ = nullptr;
+};
+
+/**
+ * Receives the metrics collected by `RpcMetrics`.
+ *
+ * Applications implement this interface to forward the metrics to their
+ * monitoring system.
+ */
+class RpcMetricsExporter {
+ public:
+  virtual ~RpcMetricsExporter() = default;
+  virtual void Export(std::vector<RpcMethodMetricsSnapshot> const& metrics) = 0;
+};
+
+/**
+ * Collects per-method RPC metrics.
+ *
+ * Configure a client with `RpcMetricsOption` to collect call counts, error
+ * counts, retry counts, bytes sent and received, and a latency histogram for
+ * each RPC method. The application decides when to export the metrics, for
+ * example, from a periodic timer.
+ *
+ * Create the object with a `RpcResourceAccounting` to also record the client
+ * CPU time, and optionally the allocations, used by each call. The accounting
+ * is disabled by default, and then it costs a single branch per call.
+ *
+ * The lookup in `Method()` is lock-free for names that have been seen
+ * before, so this class can be shared by many clients and threads.
+ *
+ * @par Example
+ * @code
+ * auto metrics = std::make_shared<google::cloud::RpcMetrics>();
+ * auto options = google::cloud::Options{}
+ *     .set<google::cloud::RpcMetricsOption>(metrics);
+ * // ... create clients with `options` and use them ...
+ * metrics->Export(my_exporter);
+ * @endcode
+ */
+class RpcMetrics {
+ public:
+  RpcMetrics();
+  explicit RpcMetrics(RpcResourceAccounting accounting);
+  ~RpcMetrics();
+  RpcMetrics(RpcMetrics const&) = delete;
+  RpcMetrics& operator=(RpcMetrics const&) = delete;
+
+  /**
+   * Returns the metrics for @p method.
+   *
+   * @p method must have static storage duration, typically a string literal.
+   * The lookup uses the address of the string, different strings with the
+   * same value are merged in `Snapshot()`.
+   */
+  RpcMethodMetrics& Method(char const* method);
+
+  /// Returns a snapshot of all the methods, sorted by name.
+  std::vector<RpcMethodMetricsSnapshot> Snapshot() const;
+
+  /// Sends a snapshot of all the metrics to @p exporter.
+  void Export(RpcMetricsExporter& exporter) const;
+
+ private:
+  struct Entry {
+    Entry(char const* k, RpcResourceAccounting const* accounting)
+        : key(k), name(k), metrics(accounting) {}
+    char const* key;
+    std::string name;
+    RpcMethodMetrics metrics;
+  };
+
+  std::unique_ptr<RpcResourceAccounting const> accounting_;
+
+  static std::size_t constexpr kTableSize = 1024;
+  std::array<std::atomic<Entry*>, kTableSize> table_{};
+
+  // Used only when the lock-free table is full.
+  mutable std::mutex mu_;
+  std::map<char const*, std::unique_ptr<Entry>> overflow_;
+};
+
+/**
+ * Collect per-method RPC metrics.
+ *
+ * If set, the clients record the metrics for each RPC in this object.
+ */
+struct RpcMetricsOption {
+  using Type = std::shared_ptr<RpcMetrics>;
+};
+
+namespace internal {
+
+/**
+ * Annotates the RPCs made by the calling thread with the retry attempt.
+ *
+ * The retry loops create one of these objects while starting each attempt.
+ * Decorators that collect metrics use `CurrentRetryAttempt()` to count
+ * retries without any changes to the stub interfaces.
+ */
+class RetryAttemptScope {
+ public:
+  explicit RetryAttemptScope(int attempt);
+  ~RetryAttemptScope();
+  RetryAttemptScope(RetryAttemptScope const&) = delete;
+  RetryAttemptScope& operator=(RetryAttemptScope const&) = delete;
+
+ private:
+  int previous_;
+};
+
+/// The attempt number for the RPC the calling thread is starting, 0 if none.
+int CurrentRetryAttempt();
+
+/// The CPU time used by the calling thread, or zero if not supported.
+std::chrono::nanoseconds ThreadCpuTime();
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H
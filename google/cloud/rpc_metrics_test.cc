@@ -0,0 +1,213 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_metrics.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Field;
+
+TEST(RpcLatencyHistogram, Buckets) {
+  RpcLatencyHistogram h;
+  h.Record(std::chrono::nanoseconds(500));
+  h.Record(std::chrono::microseconds(1));
+  h.Record(std::chrono::microseconds(3));
+  h.Record(std::chrono::microseconds(4));
+  h.Record(std::chrono::hours(24 * 365 * 100));
+  auto const counts = h.counts();
+  EXPECT_EQ(1, counts[0]);
+  EXPECT_EQ(1, counts[1]);
+  EXPECT_EQ(1, counts[2]);
+  EXPECT_EQ(1, counts[3]);
+  EXPECT_EQ(1, counts[RpcLatencyHistogram::kBucketCount - 1]);
+}
+
+TEST(RpcLatencyHistogram, BucketUpperBound) {
+  EXPECT_EQ(std::chrono::microseconds(1),
+            RpcLatencyHistogram::BucketUpperBound(0));
+  EXPECT_EQ(std::chrono::microseconds(8),
+            RpcLatencyHistogram::BucketUpperBound(3));
+  EXPECT_EQ(std::chrono::microseconds::max(),
+            RpcLatencyHistogram::BucketUpperBound(
+                RpcLatencyHistogram::kBucketCount - 1));
+}
+
+TEST(RpcMethodMetrics, Counters) {
+  RpcMethodMetrics m;
+  m.RecordCall(std::chrono::microseconds(10), Status{});
+  m.RecordCall(std::chrono::microseconds(10),
+               Status(StatusCode::kUnavailable, "try-again"));
+  m.RecordRetry();
+  m.RecordBytesSent(100);
+  m.RecordBytesReceived(200);
+  auto const s = m.Snapshot();
+  EXPECT_EQ(2, s.calls);
+  EXPECT_EQ(1, s.errors);
+  EXPECT_EQ(1, s.retries);
+  EXPECT_EQ(100, s.bytes_sent);
+  EXPECT_EQ(200, s.bytes_received);
+  EXPECT_EQ(2, s.latency[4]);
+}
+
+TEST(RpcMethodMetrics, Resources) {
+  RpcMethodMetrics m;
+  EXPECT_EQ(nullptr, m.resource_accounting());
+  m.RecordResources(std::chrono::microseconds(3), 2);
+  m.RecordResources(std::chrono::microseconds(4), 5);
+  // Clocks and counters going backwards are ignored.
+  m.RecordResources(std::chrono::microseconds(-1), -1);
+  auto const s = m.Snapshot();
+  EXPECT_EQ(std::chrono::microseconds(7), s.cpu_time);
+  EXPECT_EQ(7, s.allocations);
+}
+
+TEST(RpcMetrics, MethodIsStable) {
+  RpcMetrics metrics;
+  char const* name = "Service.Method";
+  auto& m0 = metrics.Method(name);
+  auto& m1 = metrics.Method(name);
+  EXPECT_EQ(&m0, &m1);
+}
+
+TEST(RpcMetrics, SnapshotSortedAndMerged) {
+  RpcMetrics metrics;
+  // Two different arrays with the same contents are merged by name.
+  static char const kName0[] = "Service.B";
+  static char const kName1[] = "Service.B";
+  metrics.Method("Service.A").RecordCall(std::chrono::microseconds(1),
+                                         Status{});
+  metrics.Method(kName0).RecordCall(std::chrono::microseconds(1), Status{});
+  metrics.Method(kName1).RecordCall(std::chrono::microseconds(1), Status{});
+  EXPECT_THAT(
+      metrics.Snapshot(),
+      ElementsAre(
+          AllOf(Field(&RpcMethodMetricsSnapshot::method, "Service.A"),
+                Field(&RpcMethodMetricsSnapshot::calls, 1)),
+          AllOf(Field(&RpcMethodMetricsSnapshot::method, "Service.B"),
+                Field(&RpcMethodMetricsSnapshot::calls, 2))));
+}
+
+TEST(RpcMetrics, Overflow) {
+  // Use more names than the lock-free table can hold.
+  std::vector<std::unique_ptr<char[]>> names;
+  RpcMetrics metrics;
+  for (int i = 0; i != 1100; ++i) {
+    auto s = std::to_string(i);
+    names.emplace_back(new char[s.size() + 1]);
+    std::copy(s.c_str(), s.c_str() + s.size() + 1, names.back().get());
+    auto& m0 = metrics.Method(names.back().get());
+    m0.RecordRetry();
+    EXPECT_EQ(&m0, &metrics.Method(names.back().get()));
+  }
+  auto const snapshot = metrics.Snapshot();
+  EXPECT_EQ(1100, snapshot.size());
+  for (auto const& s : snapshot) EXPECT_EQ(1, s.retries);
+}
+
+TEST(RpcMetrics, Concurrent) {
+  RpcMetrics metrics;
+  auto constexpr kThreads = 8;
+  auto constexpr kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&metrics] {
+      for (int i = 0; i != kIterations; ++i) {
+        metrics.Method("Service.Method")
+            .RecordCall(std::chrono::microseconds(i), Status{});
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  auto const snapshot = metrics.Snapshot();
+  ASSERT_EQ(1, snapshot.size());
+  EXPECT_EQ(kThreads * kIterations, snapshot.front().calls);
+}
+
+TEST(RpcMetrics, Export) {
+  struct Exporter : public RpcMetricsExporter {
+    void Export(std::vector<RpcMethodMetricsSnapshot> const& m) override {
+      exported = m;
+    }
+    std::vector<RpcMethodMetricsSnapshot> exported;
+  };
+  RpcMetrics metrics;
+  metrics.Method("Service.Method").RecordBytesSent(42);
+  Exporter exporter;
+  metrics.Export(exporter);
+  ASSERT_EQ(1, exporter.exported.size());
+  EXPECT_EQ("Service.Method", exporter.exported.front().method);
+  EXPECT_EQ(42, exporter.exported.front().bytes_sent);
+}
+
+TEST(RpcMetrics, ResourceAccounting) {
+  RpcMetrics disabled;
+  EXPECT_EQ(nullptr, disabled.Method("Service.Method").resource_accounting());
+
+  RpcMetrics enabled{RpcResourceAccounting{}};
+  auto const* accounting = enabled.Method("Service.A").resource_accounting();
+  ASSERT_NE(nullptr, accounting);
+  EXPECT_EQ(nullptr, accounting->allocation_counter);
+  EXPECT_EQ(accounting, enabled.Method("Service.B").resource_accounting());
+  enabled.Method("Service.A").RecordResources(std::chrono::microseconds(1), 1);
+  enabled.Method("Service.A").RecordResources(std::chrono::microseconds(2), 3);
+  auto const snapshot = enabled.Snapshot();
+  ASSERT_EQ(2, snapshot.size());
+  EXPECT_EQ(std::chrono::microseconds(3), snapshot[0].cpu_time);
+  EXPECT_EQ(4, snapshot[0].allocations);
+  EXPECT_EQ(std::chrono::nanoseconds(0), snapshot[1].cpu_time);
+}
+
+TEST(ThreadCpuTime, Increases) {
+  auto const start = internal::ThreadCpuTime();
+  // Burn some CPU, in a way the optimizer cannot remove.
+  volatile std::uint64_t sink = 0;
+  for (std::uint64_t i = 0; i != 10000000; ++i) sink = sink + i;
+  auto const elapsed = internal::ThreadCpuTime() - start;
+#if defined(_WIN32) || defined(CLOCK_THREAD_CPUTIME_ID)
+  EXPECT_GT(elapsed, std::chrono::nanoseconds(0));
+#else
+  EXPECT_EQ(std::chrono::nanoseconds(0), elapsed);
+#endif  // defined(_WIN32) || defined(CLOCK_THREAD_CPUTIME_ID)
+}
+
+TEST(RetryAttemptScope, Nested) {
+  EXPECT_EQ(0, internal::CurrentRetryAttempt());
+  {
+    internal::RetryAttemptScope s1(1);
+    EXPECT_EQ(1, internal::CurrentRetryAttempt());
+    {
+      internal::RetryAttemptScope s2(2);
+      EXPECT_EQ(2, internal::CurrentRetryAttempt());
+    }
+    EXPECT_EQ(1, internal::CurrentRetryAttempt());
+  }
+  EXPECT_EQ(0, internal::CurrentRetryAttempt());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,89 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_tracing.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+struct TracerHolder {
+  std::atomic<bool> enabled{false};
+  std::mutex mu;
+  std::shared_ptr<RpcTracer> tracer;
+};
+
+TracerHolder& Holder() {
+  static auto* const kHolder = new TracerHolder;
+  return *kHolder;
+}
+
+thread_local RpcSpan* current_span = nullptr;
+
+}  // namespace
+
+void SetRpcTracer(std::shared_ptr<RpcTracer> tracer) {
+  auto& holder = Holder();
+  std::lock_guard<std::mutex> lk(holder.mu);
+  holder.enabled.store(tracer != nullptr, std::memory_order_relaxed);
+  holder.tracer = std::move(tracer);
+}
+
+namespace internal {
+
+bool RpcTracingEnabled() {
+  return Holder().enabled.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<RpcSpan> StartRpcSpan(std::string const& name,
+                                      RpcSpan* parent) {
+  if (!RpcTracingEnabled()) return nullptr;
+  std::shared_ptr<RpcTracer> tracer;
+  {
+    auto& holder = Holder();
+    std::lock_guard<std::mutex> lk(holder.mu);
+    tracer = holder.tracer;
+  }
+  if (!tracer) return nullptr;
+  return tracer->StartSpan(name, parent);
+}
+
+RpcSpanScope::RpcSpanScope(RpcSpan* span) : previous_(current_span) {
+  current_span = span;
+}
+
+RpcSpanScope::~RpcSpanScope() { current_span = previous_; }
+
+RpcSpan* CurrentRpcSpan() { return current_span; }
+
+std::shared_ptr<RpcSpan> RetryLoopTracer::StartAttempt(int attempt) {
+  if (!loop_) return nullptr;
+  auto span = StartRpcSpan("attempt", loop_.get());
+  if (span) span->SetAttribute("attempt", std::to_string(attempt));
+  return span;
+}
+
+void RetryLoopTracer::Backoff(std::chrono::milliseconds delay) {
+  if (!loop_) return;
+  loop_->AddEvent("backoff", {{"delay_ms", std::to_string(delay.count())}});
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,172 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_TRACING_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_TRACING_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/// A list of key/value pairs, used for span attributes and context headers.
+using RpcTraceAttributes = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * A span created by a `RpcTracer`.
+ *
+ * The client libraries create one span for each retry loop (or resumable
+ * stream), and one child span for each attempt. The backoff periods between
+ * attempts are recorded as `"backoff"` events in the retry loop span.
+ *
+ * The member functions may be called from any thread, but the client
+ * libraries never call them concurrently for the same span.
+ */
+class RpcSpan {
+ public:
+  virtual ~RpcSpan() = default;
+
+  virtual void SetAttribute(std::string const& key,
+                            std::string const& value) = 0;
+  virtual void AddEvent(std::string const& name,
+                        RpcTraceAttributes const& attributes) = 0;
+  /// Called exactly once, when the operation represented by the span ends.
+  virtual void End(Status const& status) = 0;
+
+  /**
+   * The headers used to propagate this span to the service.
+   *
+   * For example, an OpenTelemetry adapter would return the W3C
+   * `traceparent` and `tracestate` headers. The keys must be lowercase, as
+   * required by gRPC metadata.
+   */
+  virtual RpcTraceAttributes ContextHeaders() const = 0;
+};
+
+/**
+ * The hook used by the client libraries to create tracing spans.
+ *
+ * Applications implement this interface to forward the spans to their
+ * tracing system, e.g., an OpenTelemetry `Tracer`, and install it using
+ * `SetRpcTracer()`.
+ */
+class RpcTracer {
+ public:
+  virtual ~RpcTracer() = default;
+
+  /**
+   * Start a new span.
+   *
+   * @param name the name of the operation, for example,
+   *     `"google.cloud.spanner.Connection::Commit"`.
+   * @param parent the enclosing span created by the client library, if any.
+   *     If null, implementations should use their own notion of the current
+   *     span (if any) as the parent.
+   */
+  virtual std::shared_ptr<RpcSpan> StartSpan(std::string const& name,
+                                             RpcSpan* parent) = 0;
+};
+
+/**
+ * Install @p tracer as the process-wide tracing hook.
+ *
+ * Passing `nullptr` disables tracing. When disabled, the cost in the client
+ * libraries is a single relaxed atomic load per retry loop.
+ *
+ * @note Like `LogSink`, this setting applies to all the clients in the
+ *     process, the retry loops do not have access to the client options.
+ */
+void SetRpcTracer(std::shared_ptr<RpcTracer> tracer);
+
+namespace internal {
+
+/// Returns true if a tracer is installed. Very cheap.
+bool RpcTracingEnabled();
+
+/// Returns a new span, or `nullptr` if tracing is disabled.
+std::shared_ptr<RpcSpan> StartRpcSpan(std::string const& name,
+                                      RpcSpan* parent);
+
+/**
+ * Makes @p span the current span for the calling thread.
+ *
+ * Decorators use `CurrentRpcSpan()` to propagate the span to the service.
+ */
+class RpcSpanScope {
+ public:
+  explicit RpcSpanScope(RpcSpan* span);
+  ~RpcSpanScope();
+  RpcSpanScope(RpcSpanScope const&) = delete;
+  RpcSpanScope& operator=(RpcSpanScope const&) = delete;
+
+ private:
+  RpcSpan* previous_;
+};
+
+/// The current span for the calling thread, `nullptr` if there is none.
+RpcSpan* CurrentRpcSpan();
+
+/**
+ * Creates the spans for a retry loop.
+ *
+ * All the functions are no-ops if tracing was disabled when the loop started.
+ */
+class RetryLoopTracer {
+ public:
+  explicit RetryLoopTracer(char const* location)
+      : loop_(RpcTracingEnabled() ? StartRpcSpan(location, CurrentRpcSpan())
+                                  : nullptr) {}
+
+  /// Start the span for a new attempt, as a child of the loop span.
+  std::shared_ptr<RpcSpan> StartAttempt(int attempt);
+
+  void EndAttempt(std::shared_ptr<RpcSpan> attempt, Status const& status) {
+    if (attempt) attempt->End(status);
+  }
+  template <typename T>
+  void EndAttempt(std::shared_ptr<RpcSpan> attempt, StatusOr<T> const& r) {
+    if (attempt) attempt->End(r.status());
+  }
+
+  /// Record a backoff period as an event in the loop span.
+  void Backoff(std::chrono::milliseconds delay);
+
+  /// End the loop span, only the first call has any effect.
+  void End(Status const& status) {
+    auto loop = std::move(loop_);
+    if (loop) loop->End(status);
+  }
+  template <typename T>
+  void End(StatusOr<T> const& r) {
+    if (loop_) End(r.status());
+  }
+
+ private:
+  std::shared_ptr<RpcSpan> loop_;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_TRACING_H
@@ -0,0 +1,113 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_tracing.h"
+#include "google/cloud/testing_util/fake_rpc_tracer.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::ScopedFakeRpcTracer;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+
+TEST(RpcTracing, DisabledByDefault) {
+  EXPECT_FALSE(RpcTracingEnabled());
+  EXPECT_EQ(nullptr, StartRpcSpan("test", nullptr));
+
+  RetryLoopTracer tracer("test-location");
+  EXPECT_EQ(nullptr, tracer.StartAttempt(0));
+  tracer.Backoff(std::chrono::milliseconds(10));
+  tracer.End(Status{});
+}
+
+TEST(RpcTracing, EnableAndDisable) {
+  {
+    ScopedFakeRpcTracer fake;
+    EXPECT_TRUE(RpcTracingEnabled());
+    auto span = StartRpcSpan("test", nullptr);
+    ASSERT_NE(nullptr, span);
+    span->End(Status{});
+    ASSERT_EQ(1, fake.Spans().size());
+    EXPECT_EQ("test", fake.Spans()[0].name);
+  }
+  EXPECT_FALSE(RpcTracingEnabled());
+}
+
+TEST(RpcTracing, SpanScope) {
+  ScopedFakeRpcTracer fake;
+  EXPECT_EQ(nullptr, CurrentRpcSpan());
+  auto s1 = StartRpcSpan("s1", nullptr);
+  auto s2 = StartRpcSpan("s2", nullptr);
+  {
+    RpcSpanScope scope1(s1.get());
+    EXPECT_EQ(s1.get(), CurrentRpcSpan());
+    {
+      RpcSpanScope scope2(s2.get());
+      EXPECT_EQ(s2.get(), CurrentRpcSpan());
+    }
+    EXPECT_EQ(s1.get(), CurrentRpcSpan());
+  }
+  EXPECT_EQ(nullptr, CurrentRpcSpan());
+}
+
+TEST(RetryLoopTracer, Basic) {
+  ScopedFakeRpcTracer fake;
+  auto parent = StartRpcSpan("parent", nullptr);
+  RpcSpanScope scope(parent.get());
+  RetryLoopTracer tracer("test-location");
+  auto a0 = tracer.StartAttempt(0);
+  tracer.EndAttempt(std::move(a0),
+                    StatusOr<int>(Status(StatusCode::kUnavailable, "try")));
+  tracer.Backoff(std::chrono::milliseconds(10));
+  auto a1 = tracer.StartAttempt(1);
+  tracer.EndAttempt(std::move(a1), StatusOr<int>(42));
+  tracer.End(Status{});
+  // Calling End() again has no effect.
+  tracer.End(Status(StatusCode::kUnknown, "ignored"));
+
+  auto const spans = fake.Spans();
+  ASSERT_EQ(4, spans.size());
+  EXPECT_EQ("parent", spans[0].name);
+  EXPECT_FALSE(spans[0].ended);
+
+  EXPECT_EQ("test-location", spans[1].name);
+  EXPECT_EQ("parent", spans[1].parent);
+  EXPECT_TRUE(spans[1].ended);
+  EXPECT_STATUS_OK(spans[1].status);
+  EXPECT_THAT(spans[1].events, ElementsAre("backoff"));
+
+  EXPECT_EQ("attempt", spans[2].name);
+  EXPECT_EQ("test-location", spans[2].parent);
+  EXPECT_THAT(spans[2].attributes, ElementsAre(Pair("attempt", "0")));
+  EXPECT_THAT(spans[2].status, StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(spans[2].events, IsEmpty());
+
+  EXPECT_THAT(spans[3].attributes, ElementsAre(Pair("attempt", "1")));
+  EXPECT_TRUE(spans[3].ended);
+  EXPECT_STATUS_OK(spans[3].status);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
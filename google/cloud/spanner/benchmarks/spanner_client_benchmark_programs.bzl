@@ -20,4 +20,5 @@ spanner_client_benchmark_programs = [
     "benchmarks_config_test.cc",
     "multiple_rows_cpu_benchmark.cc",
     "single_row_throughput_benchmark.cc",
+    "transaction_mix_benchmark.cc",
 ]
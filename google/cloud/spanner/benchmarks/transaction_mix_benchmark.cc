@@ -0,0 +1,419 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/benchmarks/benchmarks_config.h"
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/database_admin_client.h"
+#include "google/cloud/spanner/read_only_transaction_cache.h"
+#include "google/cloud/spanner/testing/pick_random_instance.h"
+#include "google/cloud/spanner/testing/random_database_name.h"
+#include "google/cloud/internal/random.h"
+#include <algorithm>
+#include <array>
+#include <future>
+#include <map>
+#include <random>
+#include <sstream>
+#include <thread>
+
+/**
+ * @file
+ *
+ * Runs a mix of transaction types against a single `KeyValue` table and
+ * reports, for each type, the number of transactions, errors, aborted
+ * attempts and latency, together with the session pool behavior observed
+ * during the iteration (see `spanner::SessionPoolStats`).
+ *
+ * The `--experiment` flag selects the mix, see `AvailableProfiles()`.
+ */
+
+namespace {
+
+namespace spanner = ::google::cloud::spanner;
+using ::google::cloud::spanner_benchmarks::Config;
+
+enum OperationType {
+  kPointRead,
+  kStaleRead,
+  kReadWrite,
+  kBatchDml,
+  kOperationTypeCount
+};
+
+char const* OperationName(int op) {
+  switch (op) {
+    case kPointRead:
+      return "PointRead";
+    case kStaleRead:
+      return "StaleRead";
+    case kReadWrite:
+      return "ReadWrite";
+    case kBatchDml:
+      return "BatchDml";
+    default:
+      break;
+  }
+  return "Unknown";
+}
+
+// The relative weight of each `OperationType` in a mix.
+using Profile = std::array<int, kOperationTypeCount>;
+
+std::map<std::string, Profile> AvailableProfiles() {
+  return {
+      // point, stale, read-write, batch-dml
+      {"read-heavy", Profile{{70, 20, 8, 2}}},
+      {"balanced", Profile{{40, 20, 30, 10}}},
+      {"write-heavy", Profile{{10, 10, 60, 20}}},
+      {"read-write-only", Profile{{0, 0, 100, 0}}},
+  };
+}
+
+struct OperationStats {
+  std::int64_t count = 0;
+  std::int64_t errors = 0;
+  // Attempts that were aborted and retried by `Client::Commit()`.
+  std::int64_t retries = 0;
+  std::chrono::microseconds total_latency{0};
+  std::chrono::microseconds max_latency{0};
+
+  OperationStats& operator+=(OperationStats const& rhs) {
+    count += rhs.count;
+    errors += rhs.errors;
+    retries += rhs.retries;
+    total_latency += rhs.total_latency;
+    max_latency = (std::max)(max_latency, rhs.max_latency);
+    return *this;
+  }
+};
+
+using IterationStats = std::array<OperationStats, kOperationTypeCount>;
+
+int constexpr kBatchDmlSize = 5;
+auto constexpr kMaxStaleness = std::chrono::seconds(10);
+
+class TransactionMix {
+ public:
+  TransactionMix(Config const& config, spanner::Client client)
+      : config_(config),
+        client_(std::move(client)),
+        stale_reads_(kMaxStaleness),
+        value_(1024, 'A') {}
+
+  IterationStats RunTask(Profile const& profile) {
+    google::cloud::internal::DefaultPRNG generator(std::random_device{}());
+    std::discrete_distribution<int> pick_operation(profile.begin(),
+                                                   profile.end());
+    std::uniform_int_distribution<std::int64_t> pick_key(
+        0, config_.table_size - 1);
+
+    IterationStats stats;
+    for (auto start = std::chrono::steady_clock::now(),
+              deadline = start + config_.iteration_duration;
+         start < deadline; start = std::chrono::steady_clock::now()) {
+      auto const op = pick_operation(generator);
+      auto const key = pick_key(generator);
+      int attempts = 1;
+      google::cloud::Status status;
+      switch (op) {
+        case kPointRead:
+          status = PointRead(key);
+          break;
+        case kStaleRead:
+          status = StaleRead(key);
+          break;
+        case kReadWrite:
+          status = ReadWrite(key, attempts);
+          break;
+        case kBatchDml:
+          status = BatchDml(key, attempts);
+          break;
+      }
+      auto const latency =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start);
+      auto& s = stats[op];
+      ++s.count;
+      if (!status.ok()) ++s.errors;
+      s.retries += attempts - 1;
+      s.total_latency += latency;
+      s.max_latency = (std::max)(s.max_latency, latency);
+    }
+    return stats;
+  }
+
+ private:
+  google::cloud::Status ConsumeRows(spanner::RowStream rows) {
+    for (auto& row :
+         spanner::StreamOf<std::tuple<std::int64_t, std::string>>(rows)) {
+      if (!row) return std::move(row).status();
+    }
+    return google::cloud::Status();
+  }
+
+  google::cloud::Status PointRead(std::int64_t key) {
+    return ConsumeRows(client_.Read(
+        "KeyValue", spanner::KeySet().AddKey(spanner::MakeKey(key)),
+        {"Key", "Data"}));
+  }
+
+  google::cloud::Status StaleRead(std::int64_t key) {
+    auto status = ConsumeRows(client_.Read(
+        stale_reads_.Get(), "KeyValue",
+        spanner::KeySet().AddKey(spanner::MakeKey(key)), {"Key", "Data"}));
+    if (!status.ok()) stale_reads_.Reset();
+    return status;
+  }
+
+  google::cloud::Status ReadWrite(std::int64_t key, int& attempts) {
+    attempts = 0;
+    auto result = client_.Commit(
+        [this, key, &attempts](spanner::Transaction const& txn)
+            -> google::cloud::StatusOr<spanner::Mutations> {
+          ++attempts;
+          auto status = ConsumeRows(client_.ExecuteQuery(
+              txn, spanner::SqlStatement(
+                       "SELECT Key, Data FROM KeyValue WHERE Key = @key",
+                       {{"key", spanner::Value(key)}})));
+          if (!status.ok()) return status;
+          auto dml = client_.ExecuteDml(
+              txn, spanner::SqlStatement(
+                       "UPDATE KeyValue SET Data = @data WHERE Key = @key",
+                       {{"key", spanner::Value(key)},
+                        {"data", spanner::Value(value_)}}));
+          if (!dml) return std::move(dml).status();
+          return spanner::Mutations{};
+        });
+    attempts = (std::max)(attempts, 1);
+    return result.status();
+  }
+
+  google::cloud::Status BatchDml(std::int64_t key, int& attempts) {
+    std::vector<spanner::SqlStatement> statements;
+    for (int i = 0; i != kBatchDmlSize; ++i) {
+      statements.emplace_back(
+          "UPDATE KeyValue SET Data = @data WHERE Key = @key",
+          spanner::SqlStatement::ParamType{
+              {"key", spanner::Value((key + i) % config_.table_size)},
+              {"data", spanner::Value(value_)}});
+    }
+    attempts = 0;
+    auto result = client_.Commit(
+        [this, &statements, &attempts](spanner::Transaction const& txn)
+            -> google::cloud::StatusOr<spanner::Mutations> {
+          ++attempts;
+          auto dml = client_.ExecuteBatchDml(txn, statements);
+          if (!dml) return std::move(dml).status();
+          if (!dml->status.ok()) return dml->status;
+          return spanner::Mutations{};
+        });
+    attempts = (std::max)(attempts, 1);
+    return result.status();
+  }
+
+  Config const& config_;
+  spanner::Client client_;
+  spanner::ReadOnlyTransactionCache stale_reads_;
+  std::string const value_;
+};
+
+void FillTable(Config const& config, spanner::Database const& database) {
+  // All the transactions touch existing rows, populate the table first.
+  spanner::Client client(spanner::MakeConnection(database));
+  std::cout << "# Populating database " << std::flush;
+  std::string const value(1024, 'A');
+  auto const report_period =
+      (std::max)(static_cast<std::int32_t>(2), config.table_size / 50);
+  auto mutation =
+      spanner::InsertOrUpdateMutationBuilder("KeyValue", {"Key", "Data"});
+  int current_mutations = 0;
+  for (std::int64_t key = 0; key != config.table_size; ++key) {
+    if (key % report_period == 0) std::cout << '.' << std::flush;
+    mutation.EmplaceRow(key, value);
+    if (++current_mutations < 1000 && key + 1 != config.table_size) continue;
+    auto result =
+        client.Commit(spanner::Mutations{std::move(mutation).Build()});
+    if (!result) std::cerr << "# Error in Commit() " << result.status() << "\n";
+    mutation =
+        spanner::InsertOrUpdateMutationBuilder("KeyValue", {"Key", "Data"});
+    current_mutations = 0;
+  }
+  std::cout << " DONE\n";
+}
+
+void RunIteration(Config const& config, spanner::Database const& database,
+                  std::string const& profile_name, Profile const& profile,
+                  int channel_count, int thread_count) {
+  // Keep the connection around to query the session pool counters.
+  auto connection = spanner::MakeConnection(
+      database, spanner::ConnectionOptions().set_num_channels(channel_count));
+  TransactionMix mix(config, spanner::Client(connection));
+
+  std::vector<std::future<IterationStats>> tasks(thread_count);
+  for (auto& t : tasks) {
+    t = std::async(std::launch::async,
+                   [&mix, &profile] { return mix.RunTask(profile); });
+  }
+  IterationStats stats;
+  for (auto& t : tasks) {
+    auto const task_stats = t.get();
+    for (int op = 0; op != kOperationTypeCount; ++op) {
+      stats[op] += task_stats[op];
+    }
+  }
+
+  spanner::SessionPoolStats pool;
+  auto pool_stats = connection->GetSessionPoolStats();
+  if (pool_stats) {
+    pool = *std::move(pool_stats);
+  } else {
+    std::cerr << "# Error in GetSessionPoolStats() " << pool_stats.status()
+              << "\n";
+  }
+  auto const pool_wait =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          pool.allocation_wait_time);
+
+  for (int op = 0; op != kOperationTypeCount; ++op) {
+    auto const& s = stats[op];
+    if (s.count == 0) continue;
+    std::cout << profile_name << ',' << channel_count << ',' << thread_count
+              << ',' << OperationName(op) << ',' << s.count << ','
+              << s.errors << ',' << s.retries << ','
+              << s.total_latency.count() / s.count << ','
+              << s.max_latency.count() << ',' << pool.allocations << ','
+              << pool.allocation_waits << ',' << pool_wait.count() << ','
+              << pool.allocations_exhausted << ',' << pool.sessions_created
+              << ',' << pool.session_create_failures << '\n';
+  }
+  std::cout << std::flush;
+}
+
+void Run(Config const& config, spanner::Database const& database,
+         std::string const& profile_name, Profile const& profile) {
+  std::cout << config << std::flush;
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  std::uniform_int_distribution<int> thread_count_gen(config.minimum_threads,
+                                                      config.maximum_threads);
+  std::uniform_int_distribution<int> channel_count_gen(config.minimum_channels,
+                                                       config.maximum_channels);
+  for (int i = 0; i != config.samples; ++i) {
+    auto const thread_count = thread_count_gen(generator);
+    auto const channel_count = channel_count_gen(generator);
+    RunIteration(config, database, profile_name, profile, channel_count,
+                 thread_count);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // Set any "sticky" I/O format flags before we fork threads.
+  std::cout.setf(std::ios::boolalpha);
+
+  Config config;
+  {
+    std::vector<std::string> args{argv, argv + argc};
+    auto c = google::cloud::spanner_benchmarks::ParseArgs(args);
+    if (!c) {
+      std::cerr << "Error parsing command-line arguments: " << c.status()
+                << "\n";
+      return 1;
+    }
+    config = *std::move(c);
+  }
+
+  auto profiles = AvailableProfiles();
+  auto const run_all = config.experiment == "run-all";
+  if (run_all) {
+    // Smoke test all the profiles by running a very small version of each.
+    config.table_size = 10;
+    config.samples = 1;
+    config.iteration_duration = std::chrono::seconds(1);
+  } else if (profiles.find(config.experiment) == profiles.end()) {
+    std::cerr << "Experiment " << config.experiment << " not found\n";
+    return 1;
+  }
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  if (config.instance_id.empty()) {
+    auto instance = google::cloud::spanner_testing::PickRandomInstance(
+        generator, config.project_id);
+    if (!instance) {
+      std::cerr << "Error selecting an instance to run the experiment: "
+                << instance.status() << "\n";
+      return 1;
+    }
+    config.instance_id = *std::move(instance);
+  }
+
+  // If the user specified a database name on the command line, re-use it to
+  // reduce setup time when running the benchmark repeatedly.
+  bool user_specified_database = !config.database_id.empty();
+  if (!user_specified_database) {
+    config.database_id =
+        google::cloud::spanner_testing::RandomDatabaseName(generator);
+  }
+  spanner::Database database(config.project_id, config.instance_id,
+                             config.database_id);
+
+  spanner::DatabaseAdminClient admin_client;
+  std::cout << "# Waiting for database creation to complete " << std::flush;
+  auto create_future =
+      admin_client.CreateDatabase(database, {R"sql(CREATE TABLE KeyValue (
+                                Key   INT64 NOT NULL,
+                                Data  STRING(1024),
+                             ) PRIMARY KEY (Key))sql"});
+  for (;;) {
+    auto status = create_future.wait_for(std::chrono::seconds(1));
+    if (status == std::future_status::ready) break;
+    std::cout << '.' << std::flush;
+  }
+  auto db = create_future.get();
+  std::cout << " DONE\n";
+
+  bool database_created = true;
+  if (!db) {
+    if (user_specified_database &&
+        db.status().code() == google::cloud::StatusCode::kAlreadyExists) {
+      std::cout << "# Re-using existing database\n";
+      database_created = false;
+    } else {
+      std::cerr << "Error creating database: " << db.status() << "\n";
+      return 1;
+    }
+  }
+  if (database_created) FillTable(config, database);
+
+  std::cout << "Profile,ChannelCount,ThreadCount,Operation,Count,Errors"
+            << ",Retries,AverageLatency,MaxLatency,Allocations"
+            << ",AllocationWaits,AllocationWaitTime,AllocationsExhausted"
+            << ",SessionsCreated,SessionCreateFailures\n"
+            << std::flush;
+  for (auto const& kv : profiles) {
+    if (!run_all && kv.first != config.experiment) continue;
+    Run(config, database, kv.first, kv.second);
+  }
+
+  if (!user_specified_database) {
+    auto drop = admin_client.DropDatabase(database);
+    if (!drop.ok()) {
+      std::cerr << "# Error dropping database: " << drop << "\n";
+    }
+  }
+  std::cout << "# Experiment finished, "
+            << (user_specified_database ? "user-specified database kept\n"
+                                        : "database dropped\n");
+  return 0;
+}
@@ -17,17 +17,45 @@
 
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/internal/base64_transforms.h"
+#include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/status_or.h"
 #include <array>
 #include <cstddef>
+#include <iterator>
 #include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace spanner_internal {
 inline namespace SPANNER_CLIENT_NS {
 struct BytesInternals;
+
+// Containers whose octets are stored contiguously, and can be encoded in bulk.
+template <typename C, typename = void>
+struct IsContiguousOctets : std::false_type {};
+template <typename C>
+struct IsContiguousOctets<
+    C, google::cloud::internal::void_t<
+           decltype(std::declval<C const&>().size()),
+           decltype(*std::declval<C const&>().data())>>
+    : std::integral_constant<bool,
+                             sizeof(*std::declval<C const&>().data()) == 1> {};
+
+// Containers that can be sized up front, and decoded into in bulk.
+template <typename C>
+struct IsResizableOctets : std::false_type {};
+template <>
+struct IsResizableOctets<std::string> : std::true_type {};
+template <>
+struct IsResizableOctets<std::vector<char>> : std::true_type {};
+template <>
+struct IsResizableOctets<std::vector<signed char>> : std::true_type {};
+template <>
+struct IsResizableOctets<std::vector<unsigned char>> : std::true_type {};
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
 
@@ -54,17 +82,37 @@ class Bytes {
     base64_rep_ = std::move(encoder).FlushAndPad();
   }
   template <typename Container>
-  explicit Bytes(Container const& c) : Bytes(std::begin(c), std::end(c)) {}
+  explicit Bytes(Container const& c)
+      : Bytes(c, spanner_internal::IsContiguousOctets<Container>{}) {}
   ///@}
 
   /// Conversion to a sequence of octets.  The `Container` must support
   /// construction from a range specified as a pair of input iterators.
   template <typename Container>
   Container get() const {
-    google::cloud::internal::Base64Decoder decoder(base64_rep_);
-    return Container(decoder.begin(), decoder.end());
+    return Get<Container>(spanner_internal::IsResizableOctets<Container>{});
   }
 
+  /// The number of octets.
+  std::size_t size() const {
+    return google::cloud::internal::Base64DecodedSize(base64_rep_);
+  }
+
+  /**
+   * Copies the octets to the `size()` octets starting at @p dest.
+   *
+   * Unlike `get()` this does not allocate, so it can be used to decode large
+   * values directly into a buffer owned by the caller.
+   */
+  ///@{
+  void CopyTo(unsigned char* dest) const {
+    google::cloud::internal::Base64DecodeTo(base64_rep_, dest);
+  }
+  void CopyTo(char* dest) const {
+    CopyTo(reinterpret_cast<unsigned char*>(dest));
+  }
+  ///@}
+
   /// @name Relational operators
   ///@{
   friend bool operator==(Bytes const& a, Bytes const& b) {
@@ -84,6 +132,27 @@ class Bytes {
  private:
   friend struct spanner_internal::SPANNER_CLIENT_NS::BytesInternals;
 
+  template <typename Container>
+  Bytes(Container const& c, std::true_type) {
+    base64_rep_ = google::cloud::internal::Base64Encode(
+        reinterpret_cast<unsigned char const*>(c.data()), c.size());
+  }
+  template <typename Container>
+  Bytes(Container const& c, std::false_type)
+      : Bytes(std::begin(c), std::end(c)) {}
+
+  template <typename Container>
+  Container Get(std::true_type) const {
+    Container c(size(), typename Container::value_type{});
+    if (!c.empty()) CopyTo(reinterpret_cast<unsigned char*>(&c[0]));
+    return c;
+  }
+  template <typename Container>
+  Container Get(std::false_type) const {
+    google::cloud::internal::Base64Decoder decoder(base64_rep_);
+    return Container(decoder.begin(), decoder.end());
+  }
+
   std::string base64_rep_;  // valid base64 representation
 };
 
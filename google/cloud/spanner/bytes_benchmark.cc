@@ -15,6 +15,7 @@
 #include "google/cloud/spanner/bytes.h"
 #include <benchmark/benchmark.h>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -32,8 +33,9 @@ namespace {
 // ----------------------------------------------------------------
 // Benchmark            Time       CPU   Iterations UserCounters...
 // ----------------------------------------------------------------
-// BM_BytesCtor      8386 ns   8318 ns        82963 bytes_per_second=167.843M/s
-// BM_BytesGet       6094 ns   6057 ns       115399 bytes_per_second=307.34M/s
+// BM_BytesCtor       935 ns    927 ns       757161 bytes_per_second=1.571G/s
+// BM_BytesGet        876 ns    870 ns       848407 bytes_per_second=2.235G/s
+// BM_BytesCopyTo     746 ns    742 ns       929942 bytes_per_second=2.622G/s
 
 std::string const kText = R"""(
     Four score and seven years ago our fathers brought forth on this
@@ -81,6 +83,18 @@ void BM_BytesGet(benchmark::State& state) {
 }
 BENCHMARK(BM_BytesGet);
 
+void BM_BytesCopyTo(benchmark::State& state) {
+  Bytes b(kText);
+  std::vector<char> buffer(b.size());
+  for (auto _ : state) {
+    b.CopyTo(buffer.data());
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          spanner_internal::BytesToBase64(b).size());
+}
+BENCHMARK(BM_BytesCopyTo);
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -15,6 +15,7 @@
 #include "google/cloud/spanner/bytes.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <array>
 #include <cstdint>
 #include <deque>
 #include <limits>
@@ -111,6 +112,22 @@ TEST(Bytes, Conversions) {
   EXPECT_EQ(v_plain, bytes->get<std::vector<std::uint8_t>>());
 }
 
+TEST(Bytes, CopyTo) {
+  std::string const s_plain = "foobar";
+  std::array<char, 6> const a_plain = {{'f', 'o', 'o', 'b', 'a', 'r'}};
+  EXPECT_EQ(Bytes(s_plain), Bytes(a_plain));
+
+  for (auto const& bytes : {Bytes(), Bytes(s_plain.substr(0, 1)),
+                            Bytes(s_plain.substr(0, 2)), Bytes(s_plain)}) {
+    auto const expected = bytes.get<std::string>();
+    EXPECT_EQ(expected.size(), bytes.size());
+    std::vector<char> buffer(bytes.size() + 1, '#');
+    bytes.CopyTo(buffer.data());
+    EXPECT_EQ(expected, std::string(buffer.data(), bytes.size()));
+    EXPECT_EQ('#', buffer.back());
+  }
+}
+
 TEST(Bytes, RelationalOperators) {
   std::string const s_plain = "The quick brown fox jumps over the lazy dog.";
   std::deque<char> const d_plain(s_plain.begin(), s_plain.end());
@@ -295,6 +295,42 @@ Status Client::Rollback(Transaction transaction) {
   return conn_->Rollback({std::move(transaction)});
 }
 
+future<StatusOr<RowStream>> Client::AsyncRead(Transaction transaction,
+                                              std::string table, KeySet keys,
+                                              std::vector<std::string> columns,
+                                              ReadOptions read_options) {
+  return conn_->AsyncRead({std::move(transaction),
+                           std::move(table),
+                           std::move(keys),
+                           std::move(columns),
+                           std::move(read_options),
+                           {}});
+}
+
+future<StatusOr<RowStream>> Client::AsyncExecuteQuery(
+    Transaction transaction, SqlStatement statement, QueryOptions const& opts) {
+  return conn_->AsyncExecuteQuery({std::move(transaction),
+                                   std::move(statement),
+                                   OverlayQueryOptions(opts),
+                                   {}});
+}
+
+future<StatusOr<DmlResult>> Client::AsyncExecuteDml(Transaction transaction,
+                                                    SqlStatement statement,
+                                                    QueryOptions const& opts) {
+  return conn_->AsyncExecuteDml({std::move(transaction),
+                                 std::move(statement),
+                                 OverlayQueryOptions(opts),
+                                 {}});
+}
+
+future<StatusOr<CommitResult>> Client::AsyncCommit(
+    Transaction transaction, Mutations mutations,
+    CommitOptions const& options) {
+  return conn_->AsyncCommit(
+      {std::move(transaction), std::move(mutations), options});
+}
+
 StatusOr<PartitionedDmlResult> Client::ExecutePartitionedDml(
     SqlStatement statement, QueryOptions const& opts) {
   return conn_->ExecutePartitionedDml(
@@ -324,8 +360,8 @@ std::shared_ptr<spanner::Connection> MakeConnection(spanner::Database const& db,
                                                     Options opts) {
   internal::CheckExpectedOptions<
       CommonOptionList, GrpcOptionList, SessionPoolOptionList,
-      spanner_internal::SessionPoolClockOption, SpannerPolicyOptionList>(
-      opts, __func__);
+      spanner_internal::SessionPoolClockOption, SpannerPolicyOptionList,
+      StreamingOptionList, QueryStatsOptionList>(opts, __func__);
   opts = spanner_internal::DefaultOptions(std::move(opts));
 
   std::vector<std::shared_ptr<spanner_internal::SpannerStub>> stubs(
@@ -402,6 +438,13 @@ spanner::QueryOptions OverlayQueryOptions(
     opts.set_request_priority(fallback.request_priority());
   }
 
+  // Choose the `max_rows` option.
+  if (preferred.max_rows().has_value()) {
+    opts.set_max_rows(preferred.max_rows());
+  } else if (fallback.max_rows().has_value()) {
+    opts.set_max_rows(fallback.max_rows());
+  }
+
   return opts;
 }
 
@@ -36,6 +36,7 @@
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/backoff_policy.h"
+#include "google/cloud/future.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
@@ -618,6 +619,47 @@ class Client {
    */
   Status Rollback(Transaction transaction);
 
+  /**
+   * @name Asynchronous operations
+   *
+   * These functions return immediately, the returned future is satisfied when
+   * the operation completes. They never block the calling thread, not even to
+   * allocate a session or to wait for another operation to begin
+   * @p transaction. Use them to keep many operations in flight from a few
+   * threads.
+   *
+   * The results of `AsyncRead()` and `AsyncExecuteQuery()` are returned in a
+   * single response, they are subject to the limits on the response size of
+   * the non-streaming Spanner RPCs. Use `Read()` and `ExecuteQuery()` for
+   * large results.
+   */
+  //@{
+  /// The asynchronous version of `Read()`.
+  future<StatusOr<RowStream>> AsyncRead(Transaction transaction,
+                                        std::string table, KeySet keys,
+                                        std::vector<std::string> columns,
+                                        ReadOptions read_options = {});
+
+  /// The asynchronous version of `ExecuteQuery()`.
+  future<StatusOr<RowStream>> AsyncExecuteQuery(Transaction transaction,
+                                                SqlStatement statement,
+                                                QueryOptions const& opts = {});
+
+  /// The asynchronous version of `ExecuteDml()`.
+  future<StatusOr<DmlResult>> AsyncExecuteDml(Transaction transaction,
+                                              SqlStatement statement,
+                                              QueryOptions const& opts = {});
+
+  /**
+   * The asynchronous version of `Commit(Transaction, Mutations, ...)`.
+   *
+   * There is no rerun loop, a `kAborted` error is returned to the caller.
+   */
+  future<StatusOr<CommitResult>> AsyncCommit(Transaction transaction,
+                                             Mutations mutations,
+                                             CommitOptions const& options = {});
+  //@}
+
   /**
    * Executes a Partitioned DML SQL query.
    *
@@ -664,6 +706,8 @@ class Client {
  * - `google::cloud::GrpcOptionList`
  * - `google::cloud::spanner::SpannerPolicyOptionList`
  * - `google::cloud::spanner::SessionPoolOptionList`
+ * - `google::cloud::spanner::StreamingOptionList`
+ * - `google::cloud::spanner::QueryStatsOptionList`
  *
  * @note Unrecognized options will be ignored. To debug issues with options set
  *     `GOOGLE_CLOUD_CPP_ENABLE_CLOG=yes` in the environment and unexpected
@@ -1103,6 +1103,28 @@ TEST(ClientTest, QueryOptionsOverlayPrecedence) {
                   .request_priority(),
               absl::nullopt);
   }
+
+  // Check max_rows, it has no environment variable.
+  {
+    QueryOptions preferred;
+    preferred.set_max_rows(10);
+    QueryOptions fallback;
+    fallback.set_max_rows(20);
+    EXPECT_EQ(spanner_internal::OverlayQueryOptions(
+                  preferred, fallback, absl::nullopt, absl::nullopt)
+                  .max_rows(),
+              10);
+    preferred.set_max_rows(absl::nullopt);
+    EXPECT_EQ(spanner_internal::OverlayQueryOptions(
+                  preferred, fallback, absl::nullopt, absl::nullopt)
+                  .max_rows(),
+              20);
+    fallback.set_max_rows(absl::nullopt);
+    EXPECT_EQ(spanner_internal::OverlayQueryOptions(
+                  preferred, fallback, absl::nullopt, absl::nullopt)
+                  .max_rows(),
+              absl::nullopt);
+  }
 }
 
 }  // namespace
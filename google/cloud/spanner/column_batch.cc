@@ -0,0 +1,214 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/column_batch.h"
+#include "absl/strings/numbers.h"
+#include <cmath>
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+std::string TypeName(google::spanner::v1::TypeCode code) {
+  return google::spanner::v1::TypeCode_Name(code);
+}
+
+}  // namespace
+
+std::vector<std::string> const& ColumnBatch::column_names() const {
+  static auto const* const kEmpty = new std::vector<std::string>;
+  return names_ ? *names_ : *kEmpty;
+}
+
+StatusOr<bool> ColumnBatch::IsNull(std::size_t column, std::size_t row) const {
+  auto status = CheckCell(column, row);
+  if (!status.ok()) return status;
+  return static_cast<bool>(columns_[column].nulls[row]);
+}
+
+StatusOr<absl::Span<std::int64_t const>> ColumnBatch::Int64Values(
+    std::size_t column) const {
+  auto c = TypedColumn(column, google::spanner::v1::TypeCode::INT64);
+  if (!c) return std::move(c).status();
+  return absl::MakeConstSpan((*c)->int64_values);
+}
+
+StatusOr<absl::Span<double const>> ColumnBatch::Float64Values(
+    std::size_t column) const {
+  auto c = TypedColumn(column, google::spanner::v1::TypeCode::FLOAT64);
+  if (!c) return std::move(c).status();
+  return absl::MakeConstSpan((*c)->float64_values);
+}
+
+StatusOr<absl::Span<std::uint8_t const>> ColumnBatch::BoolValues(
+    std::size_t column) const {
+  auto c = TypedColumn(column, google::spanner::v1::TypeCode::BOOL);
+  if (!c) return std::move(c).status();
+  return absl::MakeConstSpan((*c)->bool_values);
+}
+
+StatusOr<absl::string_view> ColumnBatch::StringValue(std::size_t column,
+                                                     std::size_t row) const {
+  auto c = TypedColumn(column, google::spanner::v1::TypeCode::STRING);
+  if (!c) return std::move(c).status();
+  auto status = CheckCell(column, row);
+  if (!status.ok()) return status;
+  auto const& offsets = (*c)->string_offsets;
+  return absl::string_view((*c)->string_arena)
+      .substr(offsets[row], offsets[row + 1] - offsets[row]);
+}
+
+StatusOr<Value> ColumnBatch::get(std::size_t column, std::size_t row) const {
+  auto status = CheckCell(column, row);
+  if (!status.ok()) return status;
+  auto const& c = columns_[column];
+  if (c.nulls[row]) {
+    google::protobuf::Value null;
+    null.set_null_value(google::protobuf::NullValue::NULL_VALUE);
+    return spanner_internal::FromProto(c.type, std::move(null));
+  }
+  switch (c.type->code()) {
+    case google::spanner::v1::TypeCode::INT64:
+      return Value(c.int64_values[row]);
+    case google::spanner::v1::TypeCode::FLOAT64:
+      return Value(c.float64_values[row]);
+    case google::spanner::v1::TypeCode::BOOL:
+      return Value(c.bool_values[row] != 0);
+    case google::spanner::v1::TypeCode::STRING:
+      return Value(std::string(c.string_arena, c.string_offsets[row],
+                               c.string_offsets[row + 1] -
+                                   c.string_offsets[row]));
+    default:
+      return spanner_internal::FromProto(c.type, c.other_values[row]);
+  }
+}
+
+Status ColumnBatch::CheckCell(std::size_t column, std::size_t row) const {
+  if (column >= columns_.size() || row >= num_rows()) {
+    return Status(StatusCode::kInvalidArgument, "position out of range");
+  }
+  return Status();
+}
+
+StatusOr<ColumnBatch::Column const*> ColumnBatch::TypedColumn(
+    std::size_t column, google::spanner::v1::TypeCode code) const {
+  if (column >= columns_.size()) {
+    return Status(StatusCode::kInvalidArgument, "position out of range");
+  }
+  auto const& c = columns_[column];
+  if (c.type->code() != code) {
+    return Status(StatusCode::kInvalidArgument,
+                  "column type is " + TypeName(c.type->code()) + ", not " +
+                      TypeName(code));
+  }
+  return &c;
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+// FLOAT64 values are numbers, or strings for the non-finite values.
+StatusOr<double> DecodeFloat64(google::protobuf::Value const& v) {
+  if (v.kind_case() == google::protobuf::Value::kNumberValue) {
+    return v.number_value();
+  }
+  if (v.kind_case() == google::protobuf::Value::kStringValue) {
+    auto const inf = std::numeric_limits<double>::infinity();
+    auto const& s = v.string_value();
+    if (s == "-Infinity") return -inf;
+    if (s == "Infinity") return inf;
+    if (s == "NaN") return std::nan("");
+  }
+  return Status(StatusCode::kInternal, "malformed FLOAT64 value");
+}
+
+}  // namespace
+
+spanner::ColumnBatch ColumnBatchInternals::Make(
+    google::spanner::v1::StructType const& row_type,
+    std::shared_ptr<std::vector<std::string> const> names) {
+  spanner::ColumnBatch batch;
+  batch.names_ = std::move(names);
+  batch.columns_.resize(row_type.fields_size());
+  auto column = batch.columns_.begin();
+  for (auto const& field : row_type.fields()) {
+    column->type =
+        std::make_shared<google::spanner::v1::Type const>(field.type());
+    if (column->type->code() == google::spanner::v1::TypeCode::STRING) {
+      column->string_offsets.push_back(0);
+    }
+    ++column;
+  }
+  return batch;
+}
+
+Status ColumnBatchInternals::Append(spanner::ColumnBatch& batch,
+                                    std::size_t column,
+                                    google::protobuf::Value v) {
+  if (column >= batch.columns_.size()) {
+    return Status(StatusCode::kInternal, "more values than columns in a row");
+  }
+  auto& c = batch.columns_[column];
+  auto const is_null = v.kind_case() == google::protobuf::Value::kNullValue;
+  switch (c.type->code()) {
+    case google::spanner::v1::TypeCode::INT64: {
+      std::int64_t x = 0;
+      if (!is_null &&
+          (v.kind_case() != google::protobuf::Value::kStringValue ||
+           !absl::SimpleAtoi(v.string_value(), &x))) {
+        return Status(StatusCode::kInternal, "malformed INT64 value");
+      }
+      c.int64_values.push_back(x);
+      break;
+    }
+    case google::spanner::v1::TypeCode::FLOAT64: {
+      auto x = is_null ? StatusOr<double>(0.0) : DecodeFloat64(v);
+      if (!x) return std::move(x).status();
+      c.float64_values.push_back(*x);
+      break;
+    }
+    case google::spanner::v1::TypeCode::BOOL:
+      if (!is_null && v.kind_case() != google::protobuf::Value::kBoolValue) {
+        return Status(StatusCode::kInternal, "malformed BOOL value");
+      }
+      c.bool_values.push_back(!is_null && v.bool_value() ? 1 : 0);
+      break;
+    case google::spanner::v1::TypeCode::STRING:
+      if (!is_null && v.kind_case() != google::protobuf::Value::kStringValue) {
+        return Status(StatusCode::kInternal, "malformed STRING value");
+      }
+      if (!is_null) c.string_arena += v.string_value();
+      c.string_offsets.push_back(c.string_arena.size());
+      break;
+    default:
+      c.other_values.push_back(std::move(v));
+      break;
+  }
+  c.nulls.push_back(is_null);
+  return Status();
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
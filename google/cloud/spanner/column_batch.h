@@ -0,0 +1,196 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_COLUMN_BATCH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_COLUMN_BATCH_H
+
+#include "google/cloud/spanner/value.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include <google/protobuf/struct.pb.h>
+#include <google/spanner/v1/type.pb.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+struct ColumnBatchInternals;
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * A batch of rows from a query or read, stored by column.
+ *
+ * Iterating a `RowStream` yields one `Row` per result, with a separate `Value`
+ * for each cell. For large analytic results `RowStream::NextColumnBatch()` is
+ * cheaper: the rows are decoded into one buffer per column, and the column
+ * names and types are stored once for the whole batch.
+ *
+ * `INT64`, `FLOAT64` and `BOOL` columns are stored as arrays of native values,
+ * and `STRING` columns as a single character buffer. The typed accessors
+ * return views into these buffers, which remain valid as long as the batch.
+ * Columns of any other type keep the cells in their wire format, and are
+ * decoded by `get()`.
+ *
+ * @par Example
+ * @code
+ * auto rows = client.ExecuteQuery(SqlStatement("SELECT Id, Score FROM T"));
+ * for (;;) {
+ *   auto batch = rows.NextColumnBatch(1024);
+ *   if (!batch) throw std::runtime_error(batch.status().message());
+ *   if (batch->num_rows() == 0) break;
+ *   auto scores = batch->Float64Values(1);
+ *   if (!scores) throw std::runtime_error(scores.status().message());
+ *   for (auto s : *scores) total += s;
+ * }
+ * @endcode
+ */
+class ColumnBatch {
+ public:
+  /// Default constructs an empty batch with no columns nor rows.
+  ColumnBatch() = default;
+
+  /// The number of rows in the batch.
+  std::size_t num_rows() const {
+    return columns_.empty() ? 0 : columns_.front().nulls.size();
+  }
+
+  /// The number of columns in the batch.
+  std::size_t num_columns() const { return columns_.size(); }
+
+  /// Returns the column names for the batch.
+  std::vector<std::string> const& column_names() const;
+
+  /// Returns true if the cell at @p column and @p row is `NULL`.
+  StatusOr<bool> IsNull(std::size_t column, std::size_t row) const;
+
+  /**
+   * Returns the values of the `INT64` column at @p column.
+   *
+   * The view has one entry per row, `NULL` cells hold 0.
+   */
+  StatusOr<absl::Span<std::int64_t const>> Int64Values(
+      std::size_t column) const;
+
+  /**
+   * Returns the values of the `FLOAT64` column at @p column.
+   *
+   * The view has one entry per row, `NULL` cells hold 0.
+   */
+  StatusOr<absl::Span<double const>> Float64Values(std::size_t column) const;
+
+  /**
+   * Returns the values of the `BOOL` column at @p column.
+   *
+   * The view has one entry per row, 0 for `false` or `NULL` cells and 1 for
+   * `true`.
+   */
+  StatusOr<absl::Span<std::uint8_t const>> BoolValues(
+      std::size_t column) const;
+
+  /**
+   * Returns the `STRING` at @p column and @p row.
+   *
+   * The view is empty for `NULL` cells.
+   */
+  StatusOr<absl::string_view> StringValue(std::size_t column,
+                                          std::size_t row) const;
+
+  /// Returns the cell at @p column and @p row as a `Value`, for any type.
+  StatusOr<Value> get(std::size_t column, std::size_t row) const;
+
+  /**
+   * Returns the cell at @p column and @p row as a native C++ value.
+   *
+   * @tparam T the native C++ type, e.g., std::int64_t or std::string
+   */
+  template <typename T>
+  StatusOr<T> get(std::size_t column, std::size_t row) const {
+    auto v = get(column, row);
+    if (v) return v->template get<T>();
+    return v.status();
+  }
+
+ private:
+  friend struct spanner_internal::SPANNER_CLIENT_NS::ColumnBatchInternals;
+
+  // Each column uses `nulls` and, depending on the type, one of the buffers.
+  struct Column {
+    std::shared_ptr<google::spanner::v1::Type const> type;
+    std::vector<bool> nulls;
+    std::vector<std::int64_t> int64_values;
+    std::vector<double> float64_values;
+    std::vector<std::uint8_t> bool_values;
+    std::string string_arena;
+    std::vector<std::size_t> string_offsets;  // `num_rows() + 1` entries
+    std::vector<google::protobuf::Value> other_values;
+  };
+
+  Status CheckCell(std::size_t column, std::size_t row) const;
+  StatusOr<Column const*> TypedColumn(
+      std::size_t column, google::spanner::v1::TypeCode code) const;
+
+  std::shared_ptr<std::vector<std::string> const> names_;
+  std::vector<Column> columns_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+struct ColumnBatchInternals {
+  static spanner::ColumnBatch Make(
+      google::spanner::v1::StructType const& row_type,
+      std::shared_ptr<std::vector<std::string> const> names);
+
+  // Decodes @p v into the buffers of @p column, the caller appends the cells
+  // of each row in column order.
+  static Status Append(spanner::ColumnBatch& batch, std::size_t column,
+                       google::protobuf::Value v);
+};
+
+/// Creates an empty batch with the columns described by @p row_type.
+inline spanner::ColumnBatch MakeColumnBatch(
+    google::spanner::v1::StructType const& row_type,
+    std::shared_ptr<std::vector<std::string> const> names) {
+  return ColumnBatchInternals::Make(row_type, std::move(names));
+}
+
+/// Appends @p v to @p column of @p batch.
+inline Status AppendToColumnBatch(spanner::ColumnBatch& batch,
+                                  std::size_t column,
+                                  google::protobuf::Value v) {
+  return ColumnBatchInternals::Append(batch, column, std::move(v));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_COLUMN_BATCH_H
@@ -0,0 +1,223 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/column_batch.h"
+#include "google/cloud/spanner/date.h"
+#include "google/cloud/spanner/value.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+google::spanner::v1::StructType MakeRowType() {
+  auto constexpr kText = R"pb(
+    fields: {
+      name: "Id",
+      type: { code: INT64 }
+    }
+    fields: {
+      name: "Score",
+      type: { code: FLOAT64 }
+    }
+    fields: {
+      name: "Active",
+      type: { code: BOOL }
+    }
+    fields: {
+      name: "Name",
+      type: { code: STRING }
+    }
+    fields: {
+      name: "Birthday",
+      type: { code: DATE }
+    }
+  )pb";
+  google::spanner::v1::StructType row_type;
+  EXPECT_TRUE(TextFormat::ParseFromString(kText, &row_type));
+  return row_type;
+}
+
+std::shared_ptr<std::vector<std::string> const> MakeNames(
+    google::spanner::v1::StructType const& row_type) {
+  auto names = std::make_shared<std::vector<std::string>>();
+  for (auto const& field : row_type.fields()) names->push_back(field.name());
+  return names;
+}
+
+// Appends a row given as `Value`s, converting them to the wire format.
+void AppendRow(ColumnBatch& batch, std::vector<Value> row) {
+  std::size_t column = 0;
+  for (auto& v : row) {
+    auto status = spanner_internal::AppendToColumnBatch(
+        batch, column++, spanner_internal::ToProto(std::move(v)).second);
+    ASSERT_STATUS_OK(status);
+  }
+}
+
+ColumnBatch MakeTestBatch() {
+  auto const row_type = MakeRowType();
+  auto batch = spanner_internal::MakeColumnBatch(row_type, MakeNames(row_type));
+  AppendRow(batch, {Value(1), Value(1.5), Value(true), Value("ann"),
+                    Value(Date(2000, 1, 2))});
+  AppendRow(batch, {Value(absl::optional<std::int64_t>{}),
+                    Value(std::numeric_limits<double>::infinity()),
+                    Value(absl::optional<bool>{}),
+                    Value(absl::optional<std::string>{}),
+                    Value(absl::optional<Date>{})});
+  AppendRow(batch, {Value(3), Value(-2.0), Value(false), Value(""),
+                    Value(Date(2001, 2, 3))});
+  return batch;
+}
+
+TEST(ColumnBatch, DefaultConstructed) {
+  ColumnBatch batch;
+  EXPECT_EQ(0U, batch.num_rows());
+  EXPECT_EQ(0U, batch.num_columns());
+  EXPECT_TRUE(batch.column_names().empty());
+  EXPECT_THAT(batch.get(0, 0), StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(ColumnBatch, TypedColumns) {
+  auto batch = MakeTestBatch();
+  EXPECT_EQ(3U, batch.num_rows());
+  EXPECT_EQ(5U, batch.num_columns());
+  EXPECT_THAT(batch.column_names(),
+              ElementsAre("Id", "Score", "Active", "Name", "Birthday"));
+
+  auto ids = batch.Int64Values(0);
+  ASSERT_STATUS_OK(ids);
+  EXPECT_THAT(std::vector<std::int64_t>(ids->begin(), ids->end()),
+              ElementsAre(1, 0, 3));
+  auto scores = batch.Float64Values(1);
+  ASSERT_STATUS_OK(scores);
+  EXPECT_THAT(std::vector<double>(scores->begin(), scores->end()),
+              ElementsAre(1.5, std::numeric_limits<double>::infinity(), -2.0));
+  auto active = batch.BoolValues(2);
+  ASSERT_STATUS_OK(active);
+  EXPECT_THAT(std::vector<std::uint8_t>(active->begin(), active->end()),
+              ElementsAre(1, 0, 0));
+
+  std::vector<std::string> names;
+  for (std::size_t row = 0; row != batch.num_rows(); ++row) {
+    auto name = batch.StringValue(3, row);
+    ASSERT_STATUS_OK(name);
+    names.emplace_back(*name);
+  }
+  EXPECT_THAT(names, ElementsAre("ann", "", ""));
+}
+
+TEST(ColumnBatch, Nulls) {
+  auto batch = MakeTestBatch();
+  for (std::size_t column = 0; column != batch.num_columns(); ++column) {
+    SCOPED_TRACE("Testing column " + std::to_string(column));
+    auto is_null = batch.IsNull(column, 0);
+    ASSERT_STATUS_OK(is_null);
+    EXPECT_FALSE(*is_null);
+    is_null = batch.IsNull(column, 1);
+    ASSERT_STATUS_OK(is_null);
+    EXPECT_EQ(column != 1, *is_null);
+  }
+  // An empty string is not `NULL`.
+  auto is_null = batch.IsNull(3, 2);
+  ASSERT_STATUS_OK(is_null);
+  EXPECT_FALSE(*is_null);
+}
+
+TEST(ColumnBatch, GetMatchesValues) {
+  auto batch = MakeTestBatch();
+  EXPECT_EQ(Value(1), *batch.get(0, 0));
+  EXPECT_EQ(Value(1.5), *batch.get(1, 0));
+  EXPECT_EQ(Value(true), *batch.get(2, 0));
+  EXPECT_EQ(Value("ann"), *batch.get(3, 0));
+  EXPECT_EQ(Value(Date(2000, 1, 2)), *batch.get(4, 0));
+
+  EXPECT_EQ(Value(absl::optional<std::int64_t>{}), *batch.get(0, 1));
+  EXPECT_EQ(Value(absl::optional<bool>{}), *batch.get(2, 1));
+  EXPECT_EQ(Value(absl::optional<std::string>{}), *batch.get(3, 1));
+  EXPECT_EQ(Value(absl::optional<Date>{}), *batch.get(4, 1));
+
+  EXPECT_EQ(3, *batch.get<std::int64_t>(0, 2));
+  EXPECT_EQ(Date(2001, 2, 3), *batch.get<Date>(4, 2));
+  EXPECT_THAT(batch.get<std::string>(0, 2), StatusIs(StatusCode::kUnknown));
+}
+
+TEST(ColumnBatch, OutOfRange) {
+  auto batch = MakeTestBatch();
+  EXPECT_THAT(batch.get(5, 0), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(batch.get(0, 3), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(batch.IsNull(0, 3), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(batch.Int64Values(5), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(batch.StringValue(3, 3), StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(ColumnBatch, TypeMismatch) {
+  auto batch = MakeTestBatch();
+  EXPECT_THAT(batch.Int64Values(1),
+              StatusIs(StatusCode::kInvalidArgument,
+                       HasSubstr("column type is FLOAT64, not INT64")));
+  EXPECT_THAT(batch.Float64Values(0), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(batch.BoolValues(3), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(batch.StringValue(4, 0), StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(ColumnBatch, MalformedValues) {
+  auto const row_type = MakeRowType();
+  auto batch = spanner_internal::MakeColumnBatch(row_type, MakeNames(row_type));
+  google::protobuf::Value v;
+  v.set_string_value("not-a-number");
+  EXPECT_THAT(spanner_internal::AppendToColumnBatch(batch, 0, v),
+              StatusIs(StatusCode::kInternal, HasSubstr("INT64")));
+  EXPECT_THAT(spanner_internal::AppendToColumnBatch(batch, 1, v),
+              StatusIs(StatusCode::kInternal, HasSubstr("FLOAT64")));
+  EXPECT_THAT(spanner_internal::AppendToColumnBatch(batch, 2, v),
+              StatusIs(StatusCode::kInternal, HasSubstr("BOOL")));
+  v.set_bool_value(true);
+  EXPECT_THAT(spanner_internal::AppendToColumnBatch(batch, 3, v),
+              StatusIs(StatusCode::kInternal, HasSubstr("STRING")));
+  EXPECT_THAT(spanner_internal::AppendToColumnBatch(batch, 5, v),
+              StatusIs(StatusCode::kInternal));
+  EXPECT_EQ(0U, batch.num_rows());
+}
+
+TEST(ColumnBatch, NaN) {
+  auto const row_type = MakeRowType();
+  auto batch = spanner_internal::MakeColumnBatch(row_type, MakeNames(row_type));
+  AppendRow(batch, {Value(1), Value(std::nan("")), Value(true), Value("a"),
+                    Value(Date())});
+  auto scores = batch.Float64Values(1);
+  ASSERT_STATUS_OK(scores);
+  EXPECT_TRUE(std::isnan((*scores)[0]));
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
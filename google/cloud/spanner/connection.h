@@ -25,9 +25,11 @@
 #include "google/cloud/spanner/query_options.h"
 #include "google/cloud/spanner/read_options.h"
 #include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/session_pool_stats.h"
 #include "google/cloud/spanner/sql_statement.h"
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include "absl/types/optional.h"
@@ -165,6 +167,49 @@ class Connection {
 
   /// Defines the interface for `Client::Rollback()`
   virtual Status Rollback(RollbackParams) = 0;
+
+  /**
+   * @name Asynchronous operations
+   *
+   * These have default implementations that fail with `kUnimplemented`, so
+   * existing `Connection` implementations need not provide them.
+   */
+  //@{
+  /// Defines the interface for `Client::AsyncRead()`
+  virtual future<StatusOr<RowStream>> AsyncRead(ReadParams) {
+    return make_ready_future(StatusOr<RowStream>(
+        Status(StatusCode::kUnimplemented, "AsyncRead() not implemented")));
+  }
+
+  /// Defines the interface for `Client::AsyncExecuteQuery()`
+  virtual future<StatusOr<RowStream>> AsyncExecuteQuery(SqlParams) {
+    return make_ready_future(StatusOr<RowStream>(Status(
+        StatusCode::kUnimplemented, "AsyncExecuteQuery() not implemented")));
+  }
+
+  /// Defines the interface for `Client::AsyncExecuteDml()`
+  virtual future<StatusOr<DmlResult>> AsyncExecuteDml(SqlParams) {
+    return make_ready_future(StatusOr<DmlResult>(Status(
+        StatusCode::kUnimplemented, "AsyncExecuteDml() not implemented")));
+  }
+
+  /// Defines the interface for `Client::AsyncCommit()`
+  virtual future<StatusOr<CommitResult>> AsyncCommit(CommitParams) {
+    return make_ready_future(StatusOr<CommitResult>(
+        Status(StatusCode::kUnimplemented, "AsyncCommit() not implemented")));
+  }
+  //@}
+
+  /**
+   * Returns the counters of the session pool used by this connection.
+   *
+   * The default implementation fails with `kUnimplemented`, for connections
+   * that do not use a session pool.
+   */
+  virtual StatusOr<SessionPoolStats> GetSessionPoolStats() {
+    return Status(StatusCode::kUnimplemented,
+                  "GetSessionPoolStats() not implemented");
+  }
 };
 
 }  // namespace SPANNER_CLIENT_NS
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/database_admin_client.h"
+#include "google/cloud/internal/iam_read_modify_write.h"
 #include "google/cloud/spanner/timestamp.h"
 #include <algorithm>
 
@@ -101,30 +102,21 @@ StatusOr<google::iam::v1::Policy> DatabaseAdminClient::SetIamPolicy(
     Database const& db, IamUpdater const& updater,
     std::unique_ptr<TransactionRerunPolicy> rerun_policy,
     std::unique_ptr<BackoffPolicy> backoff_policy) {
-  using RerunnablePolicy = spanner_internal::SafeTransactionRerun;
-
-  Status last_status;
-  do {
-    auto current_policy = GetIamPolicy(db);
-    if (!current_policy) {
-      last_status = std::move(current_policy).status();
-    } else {
-      auto etag = current_policy->etag();
-      auto desired = updater(*current_policy);
-      if (!desired.has_value()) {
-        return current_policy;
-      }
-      desired->set_etag(std::move(etag));
-      auto result = SetIamPolicy(db, *std::move(desired));
-      if (RerunnablePolicy::IsOk(result.status())) {
-        return result;
-      }
-      last_status = std::move(result).status();
-    }
-    if (!rerun_policy->OnFailure(last_status)) break;
-    std::this_thread::sleep_for(backoff_policy->OnCompletion());
-  } while (!rerun_policy->IsExhausted());
-  return last_status;
+  // The updater receives its own copy of the policy, the loop keeps the
+  // original to return it if the updater makes no changes.
+  auto update = [&updater](google::iam::v1::Policy& policy) {
+    auto desired = updater(policy);
+    if (!desired.has_value()) return false;
+    desired->set_etag(policy.etag());
+    policy = *std::move(desired);
+    return true;
+  };
+  return google::cloud::internal::IamReadModifyWrite(
+      [this, &db] { return GetIamPolicy(db); },
+      [this, &db](google::iam::v1::Policy policy) {
+        return SetIamPolicy(db, std::move(policy));
+      },
+      update, *rerun_policy, *backoff_policy);
 }
 
 StatusOr<google::iam::v1::TestIamPermissionsResponse>
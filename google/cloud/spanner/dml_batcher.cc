@@ -0,0 +1,87 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/dml_batcher.h"
+#include "google/cloud/spanner/internal/status_only_result_set_source.h"
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+DmlBatcher::~DmlBatcher() { Flush(); }
+
+future<StatusOr<std::int64_t>> DmlBatcher::ExecuteDml(SqlStatement statement) {
+  promise<StatusOr<std::int64_t>> p;
+  auto f = p.get_future();
+  std::lock_guard<std::mutex> lk(mu_);
+  statements_.push_back(std::move(statement));
+  promises_.push_back(std::move(p));
+  return f;
+}
+
+Status DmlBatcher::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (statements_.empty()) return Status{};
+  auto statements = std::move(statements_);
+  statements_.clear();
+  auto promises = std::move(promises_);
+  promises_.clear();
+  auto result = client_.ExecuteBatchDml(transaction_, std::move(statements),
+                                        opts_);
+  // Satisfying the promises may run continuations, which could call
+  // `ExecuteDml()`.
+  lk.unlock();
+  if (!result) {
+    for (auto& p : promises) p.set_value(result.status());
+    return std::move(result).status();
+  }
+  std::size_t i = 0;
+  for (auto const& s : result->stats) {
+    if (i == promises.size()) break;
+    promises[i++].set_value(s.row_count);
+  }
+  auto status = result->status;
+  if (status.ok() && i != promises.size()) {
+    status = Status(StatusCode::kInternal, "missing row counts in batch DML");
+  }
+  for (; i != promises.size(); ++i) promises[i].set_value(status);
+  return status;
+}
+
+RowStream DmlBatcher::Read(std::string table, KeySet keys,
+                           std::vector<std::string> columns,
+                           ReadOptions read_options) {
+  auto status = Flush();
+  if (!status.ok()) {
+    return spanner_internal::MakeStatusOnlyResult<RowStream>(std::move(status));
+  }
+  return client_.Read(transaction_, std::move(table), std::move(keys),
+                      std::move(columns), std::move(read_options));
+}
+
+RowStream DmlBatcher::ExecuteQuery(SqlStatement statement,
+                                   QueryOptions const& opts) {
+  auto status = Flush();
+  if (!status.ok()) {
+    return spanner_internal::MakeStatusOnlyResult<RowStream>(std::move(status));
+  }
+  return client_.ExecuteQuery(transaction_, std::move(statement), opts);
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,142 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/keys.h"
+#include "google/cloud/spanner/query_options.h"
+#include "google/cloud/spanner/read_options.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/sql_statement.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Defers DML statements in a transaction, and executes them in batches.
+ *
+ * Transactions that execute many DML statements with `Client::ExecuteDml()`
+ * wait for a round trip for each statement. If the application does not need
+ * the row counts right away, it can create a `DmlBatcher` for the
+ * transaction, and call `DmlBatcher::ExecuteDml()` for each statement. The
+ * statements are queued, and sent in a single `Client::ExecuteBatchDml()` call
+ * when the application calls `Flush()`, or reads in the transaction using
+ * `DmlBatcher::Read()` or `DmlBatcher::ExecuteQuery()`, so the reads observe
+ * the effects of the queued statements.
+ *
+ * As with `Client::ExecuteBatchDml()`, the statements in a batch run in order,
+ * and the batch stops at the first failed statement. The error is reported
+ * to the failed statement, and to the statements after it in the batch.
+ *
+ * Applications must flush the batcher before committing the transaction. The
+ * destructor flushes any queued statements, but its result is only available
+ * through the futures returned by `ExecuteDml()`.
+ *
+ * @par Example
+ * @code
+ * auto commit = client.Commit([&](spanner::Transaction const& txn)
+ *                                 -> StatusOr<spanner::Mutations> {
+ *   spanner::DmlBatcher batcher(client, txn);
+ *   for (auto const& singer : singers) {
+ *     batcher.ExecuteDml(spanner::SqlStatement(
+ *         "UPDATE Singers SET Rank = @rank WHERE SingerId = @id",
+ *         {{"rank", spanner::Value(singer.rank)},
+ *          {"id", spanner::Value(singer.id)}}));
+ *   }
+ *   auto status = batcher.Flush();
+ *   if (!status.ok()) return status;
+ *   return spanner::Mutations{};
+ * });
+ * @endcode
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads. The statements are executed in the order of the
+ * `ExecuteDml()` calls.
+ */
+class DmlBatcher {
+ public:
+  /**
+   * Creates a batcher for @p transaction.
+   *
+   * @param opts the options for each `Client::ExecuteBatchDml()` call.
+   */
+  DmlBatcher(Client client, Transaction transaction,
+             google::cloud::Options opts = {})
+      : client_(std::move(client)),
+        transaction_(std::move(transaction)),
+        opts_(std::move(opts)) {}
+
+  /// Flushes any queued statements.
+  ~DmlBatcher();
+
+  DmlBatcher(DmlBatcher const&) = delete;
+  DmlBatcher& operator=(DmlBatcher const&) = delete;
+
+  /**
+   * Queues @p statement, the returned future is satisfied with the number of
+   * rows modified by the statement once its batch runs.
+   */
+  future<StatusOr<std::int64_t>> ExecuteDml(SqlStatement statement);
+
+  /**
+   * Executes the queued statements.
+   *
+   * Returns an OK status if there were no queued statements, or they all
+   * succeeded, otherwise returns the error of the failed statement.
+   */
+  Status Flush();
+
+  /// Flushes the queued statements, and then calls `Client::Read()` in the
+  /// transaction.
+  RowStream Read(std::string table, KeySet keys,
+                 std::vector<std::string> columns,
+                 ReadOptions read_options = {});
+
+  /// Flushes the queued statements, and then calls `Client::ExecuteQuery()`
+  /// in the transaction.
+  RowStream ExecuteQuery(SqlStatement statement, QueryOptions const& opts = {});
+
+ private:
+  Client client_;
+  Transaction const transaction_;
+  google::cloud::Options const opts_;
+
+  // Held while flushing, so the batches run in order.
+  std::mutex mu_;
+  std::vector<SqlStatement> statements_;
+  std::vector<promise<StatusOr<std::int64_t>>> promises_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
@@ -0,0 +1,157 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/dml_batcher.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::InSequence;
+using ::testing::Return;
+
+std::vector<std::string> Sql(std::vector<SqlStatement> const& statements) {
+  std::vector<std::string> sql;
+  for (auto const& s : statements) sql.push_back(s.sql());
+  return sql;
+}
+
+BatchDmlResult MakeBatchDmlResult(std::vector<std::int64_t> const& counts,
+                                  Status status = {}) {
+  BatchDmlResult result;
+  for (auto c : counts) result.stats.push_back(BatchDmlResult::Stats{c});
+  result.status = std::move(status);
+  return result;
+}
+
+TEST(DmlBatcher, QueuesUntilFlush) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml)
+      .WillOnce([](Connection::ExecuteBatchDmlParams const& params) {
+        EXPECT_THAT(Sql(params.statements), ElementsAre("S0", "S1", "S2"));
+        return MakeBatchDmlResult({1, 2, 3});
+      });
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  std::vector<future<StatusOr<std::int64_t>>> results;
+  for (auto const* sql : {"S0", "S1", "S2"}) {
+    results.push_back(batcher.ExecuteDml(SqlStatement(sql)));
+  }
+  for (auto& r : results) EXPECT_FALSE(r.is_ready());
+  EXPECT_STATUS_OK(batcher.Flush());
+
+  std::vector<std::int64_t> counts;
+  for (auto& r : results) {
+    auto count = r.get();
+    ASSERT_STATUS_OK(count);
+    counts.push_back(*count);
+  }
+  EXPECT_THAT(counts, ElementsAre(1, 2, 3));
+  // There is nothing to flush.
+  EXPECT_STATUS_OK(batcher.Flush());
+}
+
+TEST(DmlBatcher, FailedStatement) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml)
+      .WillOnce(Return(MakeBatchDmlResult(
+          {1}, Status(StatusCode::kInvalidArgument, "bad statement"))));
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto r0 = batcher.ExecuteDml(SqlStatement("S0"));
+  auto r1 = batcher.ExecuteDml(SqlStatement("S1"));
+  auto r2 = batcher.ExecuteDml(SqlStatement("S2"));
+  EXPECT_THAT(batcher.Flush(), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_STATUS_OK(r0.get());
+  EXPECT_THAT(r1.get(), StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(r2.get(), StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(DmlBatcher, ReadFlushesFirst) {
+  auto conn = std::make_shared<MockConnection>();
+  {
+    InSequence seq;
+    EXPECT_CALL(*conn, ExecuteBatchDml)
+        .WillOnce(Return(MakeBatchDmlResult({1})));
+    EXPECT_CALL(*conn, Read).WillOnce([](Connection::ReadParams const&) {
+      auto source = absl::make_unique<MockResultSetSource>();
+      EXPECT_CALL(*source, NextRow).WillOnce(Return(Row()));
+      return RowStream(std::move(source));
+    });
+    EXPECT_CALL(*conn, ExecuteQuery).WillOnce([](Connection::SqlParams const&) {
+      auto source = absl::make_unique<MockResultSetSource>();
+      EXPECT_CALL(*source, NextRow).WillOnce(Return(Row()));
+      return RowStream(std::move(source));
+    });
+  }
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto r0 = batcher.ExecuteDml(SqlStatement("S0"));
+  auto rows = batcher.Read("Singers", KeySet::All(), {"SingerId"});
+  EXPECT_TRUE(r0.is_ready());
+  for (auto& row : rows) EXPECT_STATUS_OK(row);
+  // There is nothing to flush before the query.
+  auto query = batcher.ExecuteQuery(SqlStatement("SELECT 1"));
+  for (auto& row : query) EXPECT_STATUS_OK(row);
+}
+
+TEST(DmlBatcher, FlushErrorFailsRead) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml)
+      .WillOnce(Return(Status(StatusCode::kAborted, "try again")));
+  EXPECT_CALL(*conn, Read).Times(0);
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto r0 = batcher.ExecuteDml(SqlStatement("S0"));
+  auto rows = batcher.Read("Singers", KeySet::All(), {"SingerId"});
+  auto row = rows.begin();
+  ASSERT_NE(row, rows.end());
+  EXPECT_THAT(*row, StatusIs(StatusCode::kAborted));
+  EXPECT_THAT(r0.get(), StatusIs(StatusCode::kAborted));
+}
+
+TEST(DmlBatcher, DestructorFlushes) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml)
+      .WillOnce(Return(MakeBatchDmlResult({7})));
+
+  future<StatusOr<std::int64_t>> r0;
+  {
+    DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+    r0 = batcher.ExecuteDml(SqlStatement("S0"));
+  }
+  auto count = r0.get();
+  ASSERT_STATUS_OK(count);
+  EXPECT_EQ(7, *count);
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -23,6 +23,7 @@ google_cloud_cpp_spanner_hdrs = [
     "bytes.h",
     "client.h",
     "client_options.h",
+    "column_batch.h",
     "commit_options.h",
     "commit_result.h",
     "connection.h",
@@ -32,6 +33,7 @@ google_cloud_cpp_spanner_hdrs = [
     "database_admin_client.h",
     "database_admin_connection.h",
     "date.h",
+    "dml_batcher.h",
     "encryption_config.h",
     "iam_updater.h",
     "instance.h",
@@ -51,24 +53,33 @@ google_cloud_cpp_spanner_hdrs = [
     "internal/logging_spanner_stub.h",
     "internal/merge_chunk.h",
     "internal/metadata_spanner_stub.h",
+    "internal/metrics_spanner_stub.h",
     "internal/partial_result_set_reader.h",
     "internal/partial_result_set_resume.h",
     "internal/partial_result_set_source.h",
+    "internal/query_stats_result_source.h",
+    "internal/read_ahead_result_set_reader.h",
     "internal/session.h",
     "internal/session_pool.h",
     "internal/spanner_stub.h",
+    "internal/status_only_result_set_source.h",
     "internal/status_utils.h",
     "internal/transaction_impl.h",
     "internal/tuple_utils.h",
     "keys.h",
+    "mutation_batcher.h",
     "mutations.h",
     "numeric.h",
     "options.h",
+    "parallel_query.h",
     "partition_options.h",
     "partitioned_dml_result.h",
     "polling_policy.h",
     "query_options.h",
     "query_partition.h",
+    "query_stats_sampler.h",
+    "read_coalescer.h",
+    "read_only_transaction_cache.h",
     "read_options.h",
     "read_partition.h",
     "request_priority.h",
@@ -76,6 +87,7 @@ google_cloud_cpp_spanner_hdrs = [
     "retry_policy.h",
     "row.h",
     "session_pool_options.h",
+    "session_pool_stats.h",
     "sql_statement.h",
     "timestamp.h",
     "tracing_options.h",
@@ -90,10 +102,12 @@ google_cloud_cpp_spanner_srcs = [
     "backup.cc",
     "bytes.cc",
     "client.cc",
+    "column_batch.cc",
     "connection_options.cc",
     "database.cc",
     "database_admin_client.cc",
     "database_admin_connection.cc",
+    "dml_batcher.cc",
     "instance.cc",
     "instance_admin_client.cc",
     "instance_admin_connection.cc",
@@ -109,18 +123,26 @@ google_cloud_cpp_spanner_srcs = [
     "internal/logging_spanner_stub.cc",
     "internal/merge_chunk.cc",
     "internal/metadata_spanner_stub.cc",
+    "internal/metrics_spanner_stub.cc",
     "internal/partial_result_set_resume.cc",
     "internal/partial_result_set_source.cc",
+    "internal/query_stats_result_source.cc",
+    "internal/read_ahead_result_set_reader.cc",
     "internal/session.cc",
     "internal/session_pool.cc",
     "internal/spanner_stub.cc",
     "internal/status_utils.cc",
     "internal/transaction_impl.cc",
     "keys.cc",
+    "mutation_batcher.cc",
     "mutations.cc",
     "numeric.cc",
+    "parallel_query.cc",
     "partition_options.cc",
     "query_partition.cc",
+    "query_stats_sampler.cc",
+    "read_coalescer.cc",
+    "read_only_transaction_cache.cc",
     "read_partition.cc",
     "results.cc",
     "row.cc",
@@ -17,6 +17,7 @@
 
 #include "google/cloud/spanner/internal/spanner_stub.h"
 #include "google/cloud/spanner/version.h"
+#include <atomic>
 #include <memory>
 
 namespace google {
@@ -38,6 +39,10 @@ struct Channel {
 
   std::shared_ptr<SpannerStub> const stub;
   int session_count = 0;
+  // The sessions on this channel currently allocated from the pool. All the
+  // RPCs of their transactions use this channel, so this approximates the
+  // load on the channel.
+  std::atomic<int> active_sessions{0};
 };
 
 }  // namespace SPANNER_CLIENT_NS
@@ -17,12 +17,17 @@
 #include "google/cloud/spanner/internal/logging_result_set_reader.h"
 #include "google/cloud/spanner/internal/partial_result_set_resume.h"
 #include "google/cloud/spanner/internal/partial_result_set_source.h"
+#include "google/cloud/spanner/internal/read_ahead_result_set_reader.h"
+#include "google/cloud/spanner/internal/query_stats_result_source.h"
+#include "google/cloud/spanner/internal/status_only_result_set_source.h"
 #include "google/cloud/spanner/internal/status_utils.h"
 #include "google/cloud/spanner/options.h"
 #include "google/cloud/spanner/query_partition.h"
 #include "google/cloud/spanner/read_partition.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/algorithm.h"
+#include "google/cloud/internal/async_retry_unary_rpc.h"
+#include "google/cloud/internal/grpc_compression.h"
 #include "google/cloud/internal/retry_loop.h"
 #include "google/cloud/internal/retry_policy.h"
 #include "google/cloud/options.h"
@@ -70,6 +75,17 @@ class DefaultPartialResultSetReader : public PartialResultSetReader {
 
 namespace spanner_proto = ::google::spanner::v1;
 
+// Reads ahead of the application when `spanner::StreamingReadAheadOption` is
+// set. The resume logic is in @p reader, below the read-ahead buffer.
+std::unique_ptr<PartialResultSetReader> MaybeReadAhead(
+    std::unique_ptr<PartialResultSetReader> reader, int read_ahead,
+    std::shared_ptr<MemoryAccount> memory_account) {
+  if (read_ahead <= 0) return reader;
+  return absl::make_unique<ReadAheadResultSetReader>(
+      std::move(reader), static_cast<std::size_t>(read_ahead),
+      std::move(memory_account));
+}
+
 spanner_proto::TransactionOptions PartitionedDmlTransactionOptions() {
   spanner_proto::TransactionOptions options;
   *options.mutable_partitioned_dml() =
@@ -101,6 +117,88 @@ Status MissingTransactionStatus(std::string const& operation) {
                     operation + ")");
 }
 
+// Builds the `ReadRequest` for @p params, without the session and transaction.
+spanner_proto::ReadRequest MakeReadRequest(
+    spanner::Connection::ReadParams params) {
+  spanner_proto::ReadRequest request;
+  request.set_table(std::move(params.table));
+  request.set_index(std::move(params.read_options.index_name));
+  for (auto&& column : params.columns) {
+    request.add_columns(std::move(column));
+  }
+  *request.mutable_key_set() = ToProto(std::move(params.keys));
+  request.set_limit(params.read_options.limit);
+  if (params.partition_token) {
+    request.set_partition_token(*std::move(params.partition_token));
+  }
+  request.mutable_request_options()->set_priority(
+      ProtoRequestPriority(params.read_options.request_priority));
+  return request;
+}
+
+// Builds the `ExecuteSqlRequest` for @p params, without the session,
+// transaction, and sequence number.
+spanner_proto::ExecuteSqlRequest MakeExecuteSqlRequest(
+    spanner::Connection::SqlParams params,
+    spanner_proto::ExecuteSqlRequest::QueryMode query_mode) {
+  spanner_proto::ExecuteSqlRequest request;
+  auto sql_statement = ToProto(std::move(params.statement));
+  request.set_sql(std::move(*sql_statement.mutable_sql()));
+  *request.mutable_params() = std::move(*sql_statement.mutable_params());
+  *request.mutable_param_types() =
+      std::move(*sql_statement.mutable_param_types());
+  request.set_query_mode(query_mode);
+  if (params.partition_token) {
+    request.set_partition_token(*std::move(params.partition_token));
+  }
+  if (params.query_options.optimizer_version()) {
+    request.mutable_query_options()->set_optimizer_version(
+        *params.query_options.optimizer_version());
+  }
+  if (params.query_options.optimizer_statistics_package()) {
+    request.mutable_query_options()->set_optimizer_statistics_package(
+        *params.query_options.optimizer_statistics_package());
+  }
+  request.mutable_request_options()->set_priority(
+      ProtoRequestPriority(params.query_options.request_priority()));
+  return request;
+}
+
+// Builds the `CommitRequest` for @p params, without the session and
+// transaction.
+spanner_proto::CommitRequest MakeCommitRequest(
+    spanner::Connection::CommitParams params) {
+  spanner_proto::CommitRequest request;
+  for (auto&& m : params.mutations) {
+    *request.add_mutations() = std::move(m).as_proto();
+  }
+  request.set_return_commit_stats(params.options.return_stats());
+  request.mutable_request_options()->set_priority(
+      ProtoRequestPriority(params.options.request_priority()));
+  return request;
+}
+
+spanner::CommitResult MakeCommitResult(
+    spanner_proto::CommitResponse const& response) {
+  auto timestamp = spanner::MakeTimestamp(response.commit_timestamp());
+  if (!timestamp) {
+    // The response commit_timestamp is out of range, but the commit was
+    // successful so we cannot indicate an error. This should not happen,
+    // but if it does we set r.commit_timestamp to its maximal value.
+    protobuf::Timestamp proto;
+    proto.set_seconds(google::protobuf::util::TimeUtil::kTimestampMaxSeconds);
+    proto.set_nanos(999999999);
+    timestamp = spanner::MakeTimestamp(proto);
+  }
+  spanner::CommitResult r;
+  r.commit_timestamp = *std::move(timestamp);
+  if (response.has_commit_stats()) {
+    r.commit_stats.emplace(
+        spanner::CommitStats{response.commit_stats().mutation_count()});
+  }
+  return r;
+}
+
 ConnectionImpl::ConnectionImpl(spanner::Database db,
                                std::vector<std::shared_ptr<SpannerStub>> stubs,
                                Options const& opts)
@@ -114,7 +212,12 @@ ConnectionImpl::ConnectionImpl(spanner::Database db,
                                     background_threads_->cq(), opts)),
       rpc_stream_tracing_enabled_(internal::Contains(
           opts.get<TracingComponentsOption>(), "rpc-streams")),
-      tracing_options_(opts.get<GrpcTracingOptionsOption>()) {}
+      tracing_options_(opts.get<GrpcTracingOptionsOption>()),
+      read_ahead_(opts.get<spanner::StreamingReadAheadOption>()),
+      compression_(opts.get<GrpcCompressionOption>()),
+      memory_account_(
+          internal::MakeMemoryAccount(opts, "spanner/" + db_.FullName())),
+      query_stats_sampler_(opts.get<spanner::QueryStatsSamplerOption>()) {}
 
 spanner::RowStream ConnectionImpl::Read(ReadParams params) {
   return Visit(std::move(params.transaction),
@@ -230,44 +333,45 @@ Status ConnectionImpl::Rollback(RollbackParams params) {
                       std::int64_t) { return this->RollbackImpl(session, s); });
 }
 
-class StatusOnlyResultSetSource : public ResultSourceInterface {
- public:
-  explicit StatusOnlyResultSetSource(google::cloud::Status status)
-      : status_(std::move(status)) {}
-  ~StatusOnlyResultSetSource() override = default;
-
-  StatusOr<spanner::Row> NextRow() override { return status_; }
-  absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
-    return {};
-  }
-  absl::optional<google::spanner::v1::ResultSetStats> Stats() const override {
-    return {};
-  }
-
- private:
-  google::cloud::Status status_;
-};
-
-// Helper function to build and wrap a `StatusOnlyResultSetSource`.
-template <typename ResultType>
-ResultType MakeStatusOnlyResult(Status status) {
-  return ResultType(
-      absl::make_unique<StatusOnlyResultSetSource>(std::move(status)));
-}
-
-class DmlResultSetSource : public ResultSourceInterface {
+// Iterates over the rows of a `ResultSet` returned by a unary RPC.
+class ResultSetSource : public ResultSourceInterface {
  public:
   static StatusOr<std::unique_ptr<ResultSourceInterface>> Create(
       spanner_proto::ResultSet result_set) {
     return std::unique_ptr<ResultSourceInterface>(
-        new DmlResultSetSource(std::move(result_set)));
+        new ResultSetSource(std::move(result_set)));
   }
 
-  explicit DmlResultSetSource(spanner_proto::ResultSet result_set)
+  explicit ResultSetSource(spanner_proto::ResultSet result_set)
       : result_set_(std::move(result_set)) {}
-  ~DmlResultSetSource() override = default;
-
-  StatusOr<spanner::Row> NextRow() override { return {}; }
+  ~ResultSetSource() override = default;
+
+  StatusOr<spanner::Row> NextRow() override {
+    if (next_row_ == result_set_.rows_size()) return spanner::Row();
+    auto const& fields = result_set_.metadata().row_type().fields();
+    auto& row = *result_set_.mutable_rows(next_row_++);
+    if (row.values_size() != fields.size()) {
+      return Status(StatusCode::kInternal,
+                    "row does not match the row type in the response metadata");
+    }
+    if (!columns_) {
+      // Share the column names and types between all the rows, as in
+      // `PartialResultSetSource`.
+      columns_ = std::make_shared<std::vector<std::string>>();
+      for (auto const& field : fields) {
+        columns_->push_back(field.name());
+        column_types_.push_back(
+            std::make_shared<google::spanner::v1::Type const>(field.type()));
+      }
+    }
+    std::vector<spanner::Value> values;
+    values.reserve(fields.size());
+    for (int i = 0; i != fields.size(); ++i) {
+      values.push_back(
+          FromProto(column_types_[i], std::move(*row.mutable_values(i))));
+    }
+    return MakeRow(std::move(values), columns_);
+  }
 
   absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
     if (result_set_.has_metadata()) {
@@ -285,6 +389,9 @@ class DmlResultSetSource : public ResultSourceInterface {
 
  private:
   spanner_proto::ResultSet result_set_;
+  int next_row_ = 0;
+  std::shared_ptr<std::vector<std::string>> columns_;
+  std::vector<std::shared_ptr<google::spanner::v1::Type const>> column_types_;
 };
 
 // Used as an intermediary for streaming PartitionedDml operations.
@@ -383,21 +490,9 @@ spanner::RowStream ConnectionImpl::ReadImpl(
     return MakeStatusOnlyResult<spanner::RowStream>(std::move(prepare_status));
   }
 
-  spanner_proto::ReadRequest request;
+  auto request = MakeReadRequest(std::move(params));
   request.set_session(session->session_name());
   *request.mutable_transaction() = *s;
-  request.set_table(std::move(params.table));
-  request.set_index(std::move(params.read_options.index_name));
-  for (auto&& column : params.columns) {
-    request.add_columns(std::move(column));
-  }
-  *request.mutable_key_set() = ToProto(std::move(params.keys));
-  request.set_limit(params.read_options.limit);
-  if (params.partition_token) {
-    request.set_partition_token(*std::move(params.partition_token));
-  }
-  request.mutable_request_options()->set_priority(
-      ProtoRequestPriority(params.read_options.request_priority));
 
   // Capture a copy of `stub` to ensure the `shared_ptr<>` remains valid through
   // the lifetime of the lambda.
@@ -418,10 +513,13 @@ spanner::RowStream ConnectionImpl::ReadImpl(
     return reader;
   };
   for (;;) {
-    auto rpc = absl::make_unique<PartialResultSetResume>(
-        factory, Idempotency::kIdempotent, retry_policy_prototype_->clone(),
-        backoff_policy_prototype_->clone());
-    auto reader = PartialResultSetSource::Create(std::move(rpc));
+    auto rpc = MaybeReadAhead(
+        absl::make_unique<PartialResultSetResume>(
+            factory, Idempotency::kIdempotent, retry_policy_prototype_->clone(),
+            backoff_policy_prototype_->clone()),
+        read_ahead_, memory_account_);
+    auto reader =
+        PartialResultSetSource::Create(std::move(rpc), memory_account_);
     if (s->has_begin()) {
       if (reader.ok()) {
         auto metadata = (*reader)->Metadata();
@@ -534,29 +632,10 @@ StatusOr<ResultType> ConnectionImpl::ExecuteSqlImpl(
     return s.status();
   }
 
-  spanner_proto::ExecuteSqlRequest request;
+  auto request = MakeExecuteSqlRequest(std::move(params), query_mode);
   request.set_session(session->session_name());
   *request.mutable_transaction() = *s;
-  auto sql_statement = ToProto(std::move(params.statement));
-  request.set_sql(std::move(*sql_statement.mutable_sql()));
-  *request.mutable_params() = std::move(*sql_statement.mutable_params());
-  *request.mutable_param_types() =
-      std::move(*sql_statement.mutable_param_types());
   request.set_seqno(seqno);
-  request.set_query_mode(query_mode);
-  if (params.partition_token) {
-    request.set_partition_token(*std::move(params.partition_token));
-  }
-  if (params.query_options.optimizer_version()) {
-    request.mutable_query_options()->set_optimizer_version(
-        *params.query_options.optimizer_version());
-  }
-  if (params.query_options.optimizer_statistics_package()) {
-    request.mutable_query_options()->set_optimizer_statistics_package(
-        *params.query_options.optimizer_statistics_package());
-  }
-  request.mutable_request_options()->set_priority(
-      ProtoRequestPriority(params.query_options.request_priority()));
 
   for (;;) {
     auto reader = retry_resume_fn(request);
@@ -589,7 +668,8 @@ template <typename ResultType>
 ResultType ConnectionImpl::CommonQueryImpl(
     SessionHolder& session, StatusOr<spanner_proto::TransactionSelector>& s,
     std::int64_t seqno, SqlParams params,
-    google::spanner::v1::ExecuteSqlRequest::QueryMode query_mode) {
+    google::spanner::v1::ExecuteSqlRequest::QueryMode query_mode,
+    std::shared_ptr<spanner::QueryStatsSampler> stats_sampler) {
   if (!s.ok()) {
     return MakeStatusOnlyResult<ResultType>(s.status());
   }
@@ -606,14 +686,21 @@ ResultType ConnectionImpl::CommonQueryImpl(
   auto const& backoff_policy = backoff_policy_prototype_;
   auto const tracing_enabled = rpc_stream_tracing_enabled_;
   auto const tracing_options = tracing_options_;
+  auto const read_ahead = read_ahead_;
+  auto const& compression = compression_;
+  auto const& memory_account = memory_account_;
+  auto const max_rows = params.query_options.max_rows();
   auto retry_resume_fn =
-      [stub, retry_policy, backoff_policy, tracing_enabled,
-       tracing_options](spanner_proto::ExecuteSqlRequest& request) mutable
+      [stub, retry_policy, backoff_policy, tracing_enabled, tracing_options,
+       read_ahead, compression, memory_account, max_rows,
+       stats_sampler](spanner_proto::ExecuteSqlRequest& request) mutable
       -> StatusOr<std::unique_ptr<ResultSourceInterface>> {
-    auto factory = [stub, request, tracing_enabled,
-                    tracing_options](std::string const& resume_token) mutable {
+    auto factory = [stub, request, tracing_enabled, tracing_options,
+                    compression](std::string const& resume_token) mutable {
       request.set_resume_token(resume_token);
       auto context = absl::make_unique<grpc::ClientContext>();
+      internal::ConfigureCompression(*context, compression,
+                                     "Spanner.ExecuteStreamingSql", request);
       std::unique_ptr<PartialResultSetReader> reader =
           absl::make_unique<DefaultPartialResultSetReader>(
               std::move(context), stub->ExecuteStreamingSql(*context, request));
@@ -623,11 +710,18 @@ ResultType ConnectionImpl::CommonQueryImpl(
       }
       return reader;
     };
-    auto rpc = absl::make_unique<PartialResultSetResume>(
-        std::move(factory), Idempotency::kIdempotent, retry_policy->clone(),
-        backoff_policy->clone());
-
-    return PartialResultSetSource::Create(std::move(rpc));
+    auto rpc = MaybeReadAhead(
+        absl::make_unique<PartialResultSetResume>(
+            std::move(factory), Idempotency::kIdempotent,
+            retry_policy->clone(), backoff_policy->clone()),
+        read_ahead, memory_account);
+
+    auto source = PartialResultSetSource::Create(std::move(rpc),
+                                                 memory_account, max_rows);
+    if (!source || !stats_sampler) return source;
+    return std::unique_ptr<ResultSourceInterface>(
+        absl::make_unique<QueryStatsResultSource>(
+            *std::move(source), stats_sampler, request.sql()));
   };
 
   StatusOr<ResultType> response =
@@ -644,6 +738,11 @@ ResultType ConnectionImpl::CommonQueryImpl(
 spanner::RowStream ConnectionImpl::ExecuteQueryImpl(
     SessionHolder& session, StatusOr<spanner_proto::TransactionSelector>& s,
     std::int64_t seqno, SqlParams params) {
+  if (query_stats_sampler_ && query_stats_sampler_->Sample()) {
+    return CommonQueryImpl<spanner::RowStream>(
+        session, s, seqno, std::move(params),
+        spanner_proto::ExecuteSqlRequest::PROFILE, query_stats_sampler_);
+  }
   return CommonQueryImpl<spanner::RowStream>(
       session, s, seqno, std::move(params),
       spanner_proto::ExecuteSqlRequest::NORMAL);
@@ -677,15 +776,18 @@ StatusOr<ResultType> ConnectionImpl::CommonDmlImpl(
   auto const& retry_policy = retry_policy_prototype_;
   auto const& backoff_policy = backoff_policy_prototype_;
 
+  auto const& compression = compression_;
   auto retry_resume_fn =
-      [function_name, stub, retry_policy, backoff_policy,
-       session](spanner_proto::ExecuteSqlRequest& request) mutable
+      [function_name, stub, retry_policy, backoff_policy, session,
+       compression](spanner_proto::ExecuteSqlRequest& request) mutable
       -> StatusOr<std::unique_ptr<ResultSourceInterface>> {
     StatusOr<spanner_proto::ResultSet> response = RetryLoop(
         retry_policy->clone(), backoff_policy->clone(),
         Idempotency::kIdempotent,
-        [stub](grpc::ClientContext& context,
-               spanner_proto::ExecuteSqlRequest const& request) {
+        [stub, &compression](grpc::ClientContext& context,
+                             spanner_proto::ExecuteSqlRequest const& request) {
+          internal::ConfigureCompression(context, compression,
+                                         "Spanner.ExecuteSql", request);
           return stub->ExecuteSql(context, request);
         },
         request, function_name);
@@ -694,7 +796,7 @@ StatusOr<ResultType> ConnectionImpl::CommonDmlImpl(
       if (IsSessionNotFound(status)) session->set_bad();
       return status;
     }
-    return DmlResultSetSource::Create(std::move(*response));
+    return ResultSetSource::Create(std::move(*response));
   };
   return ExecuteSqlImpl<ResultType>(session, s, seqno, std::move(params),
                                     query_mode, std::move(retry_resume_fn));
@@ -827,8 +929,10 @@ StatusOr<spanner::BatchDmlResult> ConnectionImpl::ExecuteBatchDmlImpl(
     auto response = RetryLoop(
         retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
         Idempotency::kIdempotent,
-        [&stub](grpc::ClientContext& context,
-                spanner_proto::ExecuteBatchDmlRequest const& request) {
+        [this, &stub](grpc::ClientContext& context,
+                      spanner_proto::ExecuteBatchDmlRequest const& request) {
+          internal::ConfigureCompression(context, compression_,
+                                         "Spanner.ExecuteBatchDml", request);
           return stub->ExecuteBatchDml(context, request);
         },
         request, __func__);
@@ -914,14 +1018,8 @@ StatusOr<spanner::CommitResult> ConnectionImpl::CommitImpl(
     return prepare_status;
   }
 
-  spanner_proto::CommitRequest request;
+  auto request = MakeCommitRequest(std::move(params));
   request.set_session(session->session_name());
-  for (auto&& m : params.mutations) {
-    *request.add_mutations() = std::move(m).as_proto();
-  }
-  request.set_return_commit_stats(params.options.return_stats());
-  request.mutable_request_options()->set_priority(
-      ProtoRequestPriority(params.options.request_priority()));
 
   if (s->selector_case() != spanner_proto::TransactionSelector::kId) {
     auto begin = BeginTransaction(
@@ -938,8 +1036,10 @@ StatusOr<spanner::CommitResult> ConnectionImpl::CommitImpl(
   auto response = RetryLoop(
       retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
       Idempotency::kIdempotent,
-      [&stub](grpc::ClientContext& context,
-              spanner_proto::CommitRequest const& request) {
+      [this, &stub](grpc::ClientContext& context,
+                    spanner_proto::CommitRequest const& request) {
+        internal::ConfigureCompression(context, compression_, "Spanner.Commit",
+                                       request);
         return stub->Commit(context, request);
       },
       request, __func__);
@@ -948,23 +1048,7 @@ StatusOr<spanner::CommitResult> ConnectionImpl::CommitImpl(
     if (IsSessionNotFound(status)) session->set_bad();
     return status;
   }
-  auto timestamp = spanner::MakeTimestamp(response->commit_timestamp());
-  if (!timestamp) {
-    // The response commit_timestamp is out of range, but the commit was
-    // successful so we cannot indicate an error. This should not happen,
-    // but if it does we set r.commit_timestamp to its maximal value.
-    protobuf::Timestamp proto;
-    proto.set_seconds(google::protobuf::util::TimeUtil::kTimestampMaxSeconds);
-    proto.set_nanos(999999999);
-    timestamp = spanner::MakeTimestamp(proto);
-  }
-  spanner::CommitResult r;
-  r.commit_timestamp = *std::move(timestamp);
-  if (response->has_commit_stats()) {
-    r.commit_stats.emplace(
-        spanner::CommitStats{response->commit_stats().mutation_count()});
-  }
-  return r;
+  return MakeCommitResult(*response);
 }
 
 Status ConnectionImpl::RollbackImpl(
@@ -976,21 +1060,19 @@ Status ConnectionImpl::RollbackImpl(
     return Status(StatusCode::kInvalidArgument,
                   "Cannot rollback a single-use transaction");
   }
+  if (s->has_begin()) {
+    // The transaction has not begun on the server, as its first operation
+    // would have begun it inline, so there is nothing to roll back. Any
+    // later operation must fail instead of beginning a new transaction.
+    s = Status(StatusCode::kFailedPrecondition, "transaction rolled back");
+    return Status();
+  }
 
   auto prepare_status = PrepareSession(session);
   if (!prepare_status.ok()) {
     return prepare_status;
   }
 
-  if (s->has_begin()) {
-    auto begin = BeginTransaction(session, s->begin(), __func__);
-    if (!begin.ok()) {
-      s = begin.status();  // invalidate the transaction
-      return begin.status();
-    }
-    s->set_id(begin->id());
-  }
-
   spanner_proto::RollbackRequest request;
   request.set_session(session->session_name());
   request.set_transaction_id(s->id());
@@ -1007,6 +1089,308 @@ Status ConnectionImpl::RollbackImpl(
   return status;
 }
 
+// Copies of the `ConnectionImpl` members used by the asynchronous operations,
+// the operations may outlive the connection.
+struct AsyncRpcContext {
+  CompletionQueue cq;
+  std::shared_ptr<SessionPool> session_pool;
+  std::shared_ptr<spanner::RetryPolicy const> retry_policy;
+  std::shared_ptr<spanner::BackoffPolicy const> backoff_policy;
+};
+
+/**
+ * The asynchronous version of `PrepareSession()`.
+ *
+ * `AsyncVisit()` keeps @p session alive until the returned future is
+ * satisfied.
+ */
+future<Status> AsyncPrepareSession(AsyncRpcContext const& ctx,
+                                   SessionHolder& session) {
+  if (session) return make_ready_future(Status());
+  return ctx.session_pool->AsyncAllocate().then(
+      [&session](future<StatusOr<SessionHolder>> f) -> Status {
+        auto allocated = f.get();
+        if (!allocated) return std::move(allocated).status();
+        session = *std::move(allocated);
+        return Status();
+      });
+}
+
+/// The asynchronous version of `ConnectionImpl::BeginTransaction()`.
+future<StatusOr<spanner_proto::Transaction>> AsyncBeginTransaction(
+    AsyncRpcContext const& ctx, SessionHolder const& session,
+    spanner_proto::TransactionOptions options, char const* func) {
+  spanner_proto::BeginTransactionRequest begin;
+  begin.set_session(session->session_name());
+  *begin.mutable_options() = std::move(options);
+  auto stub = ctx.session_pool->GetStub(*session);
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+             ctx.cq, func, ctx.retry_policy->clone(),
+             ctx.backoff_policy->clone(), Idempotency::kIdempotent,
+             [stub](grpc::ClientContext* context,
+                    spanner_proto::BeginTransactionRequest const& request,
+                    grpc::CompletionQueue* cq) {
+               return stub->AsyncBeginTransaction(*context, request, cq);
+             },
+             std::move(begin))
+      .then([session](future<StatusOr<spanner_proto::Transaction>> f) {
+        auto response = f.get();
+        if (!response && IsSessionNotFound(response.status())) {
+          session->set_bad();
+        }
+        return response;
+      });
+}
+
+future<StatusOr<spanner_proto::ResultSet>> AsyncResultSetRpc(
+    AsyncRpcContext const& ctx, std::shared_ptr<SpannerStub> const& stub,
+    spanner_proto::ExecuteSqlRequest request, char const* func) {
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+      ctx.cq, func, ctx.retry_policy->clone(), ctx.backoff_policy->clone(),
+      Idempotency::kIdempotent,
+      [stub](grpc::ClientContext* context,
+             spanner_proto::ExecuteSqlRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncExecuteSql(*context, request, cq);
+      },
+      std::move(request));
+}
+
+future<StatusOr<spanner_proto::ResultSet>> AsyncResultSetRpc(
+    AsyncRpcContext const& ctx, std::shared_ptr<SpannerStub> const& stub,
+    spanner_proto::ReadRequest request, char const* func) {
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+      ctx.cq, func, ctx.retry_policy->clone(), ctx.backoff_policy->clone(),
+      Idempotency::kIdempotent,
+      [stub](grpc::ClientContext* context,
+             spanner_proto::ReadRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncRead(*context, request, cq);
+      },
+      std::move(request));
+}
+
+/**
+ * Sends @p request in the transaction selected by @p s.
+ *
+ * This is the asynchronous version of the loops in `ReadImpl()` and
+ * `ExecuteSqlImpl()`: if the request was to begin the transaction, but it
+ * failed, we begin the transaction explicitly and send the request again.
+ */
+template <typename Request>
+future<StatusOr<spanner_proto::ResultSet>> AsyncResultSetCall(
+    AsyncRpcContext const& ctx, SessionHolder const& session,
+    StatusOr<spanner_proto::TransactionSelector>& s, Request request,
+    char const* func) {
+  using Response = StatusOr<spanner_proto::ResultSet>;
+  *request.mutable_transaction() = *s;
+  auto stub = ctx.session_pool->GetStub(*session);
+  auto pending = AsyncResultSetRpc(ctx, stub, request, func);
+  return pending.then([ctx, session, &s, request,
+                       func](future<Response> f) -> future<Response> {
+    auto response = f.get();
+    if (s->has_begin()) {
+      if (response.ok()) {
+        if (!response->metadata().has_transaction()) {
+          s = MissingTransactionStatus(func);
+          return make_ready_future(Response(s.status()));
+        }
+        s->set_id(response->metadata().transaction().id());
+      } else {
+        auto status = std::move(response).status();
+        return AsyncBeginTransaction(ctx, session, s->begin(), func)
+            .then([ctx, session, &s, request, func, status](
+                      future<StatusOr<spanner_proto::Transaction>> f)
+                      -> future<Response> {
+              auto begin = f.get();
+              if (!begin) {
+                s = begin.status();  // invalidate the transaction
+                if (IsSessionNotFound(status)) session->set_bad();
+                return make_ready_future(Response(status));
+              }
+              s->set_id(begin->id());
+              return AsyncResultSetCall(ctx, session, s, request, func);
+            });
+      }
+    }
+    if (!response && IsSessionNotFound(response.status())) session->set_bad();
+    return make_ready_future(std::move(response));
+  });
+}
+
+/// The asynchronous version of `ReadImpl()` and `ExecuteSqlImpl()`.
+template <typename Request>
+future<StatusOr<spanner_proto::ResultSet>> AsyncResultSetImpl(
+    AsyncRpcContext const& ctx, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s, Request request,
+    char const* func) {
+  using Response = StatusOr<spanner_proto::ResultSet>;
+  if (!s.ok()) return make_ready_future(Response(s.status()));
+  return AsyncPrepareSession(ctx, session)
+      .then([ctx, &session, &s, request,
+             func](future<Status> f) -> future<Response> {
+        auto status = f.get();
+        if (!status.ok()) return make_ready_future(Response(status));
+        auto r = request;
+        r.set_session(session->session_name());
+        return AsyncResultSetCall(ctx, session, s, std::move(r), func);
+      });
+}
+
+future<StatusOr<spanner::RowStream>> MakeAsyncRowStream(
+    future<StatusOr<spanner_proto::ResultSet>> pending) {
+  return pending.then([](future<StatusOr<spanner_proto::ResultSet>> f)
+                          -> StatusOr<spanner::RowStream> {
+    auto response = f.get();
+    if (!response) return std::move(response).status();
+    return spanner::RowStream(
+        absl::make_unique<ResultSetSource>(*std::move(response)));
+  });
+}
+
+/// The asynchronous version of `CommitImpl()`.
+future<StatusOr<spanner::CommitResult>> AsyncCommitImpl(
+    AsyncRpcContext const& ctx, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s,
+    spanner_proto::CommitRequest request, char const* func) {
+  using Response = StatusOr<spanner::CommitResult>;
+  if (!s.ok()) {
+    // Fail the commit if the transaction has been invalidated.
+    return make_ready_future(Response(s.status()));
+  }
+  return AsyncPrepareSession(ctx, session)
+      .then([ctx, &session, &s, request,
+             func](future<Status> f) -> future<Response> {
+        auto status = f.get();
+        if (!status.ok()) return make_ready_future(Response(status));
+        auto held = session;
+        auto commit = [ctx, held, request, func](std::string const& id) {
+          auto r = request;
+          r.set_session(held->session_name());
+          r.set_transaction_id(id);
+          auto stub = ctx.session_pool->GetStub(*held);
+          return google::cloud::internal::StartRetryAsyncUnaryRpc(
+                     ctx.cq, func, ctx.retry_policy->clone(),
+                     ctx.backoff_policy->clone(), Idempotency::kIdempotent,
+                     [stub](grpc::ClientContext* context,
+                            spanner_proto::CommitRequest const& request,
+                            grpc::CompletionQueue* cq) {
+                       return stub->AsyncCommit(*context, request, cq);
+                     },
+                     std::move(r))
+              .then([held](future<StatusOr<spanner_proto::CommitResponse>> f)
+                        -> Response {
+                auto response = f.get();
+                if (!response) {
+                  auto status = std::move(response).status();
+                  if (IsSessionNotFound(status)) held->set_bad();
+                  return status;
+                }
+                return MakeCommitResult(*response);
+              });
+        };
+        if (s->selector_case() == spanner_proto::TransactionSelector::kId) {
+          return commit(s->id());
+        }
+        return AsyncBeginTransaction(
+                   ctx, held, s->has_begin() ? s->begin() : s->single_use(),
+                   func)
+            .then([&s, commit](future<StatusOr<spanner_proto::Transaction>> f)
+                      -> future<Response> {
+              auto begin = f.get();
+              if (!begin) {
+                s = begin.status();  // invalidate the transaction
+                return make_ready_future(Response(begin.status()));
+              }
+              s->set_id(begin->id());
+              return commit(s->id());
+            });
+      });
+}
+
+future<StatusOr<spanner::RowStream>> ConnectionImpl::AsyncRead(
+    ReadParams params) {
+  AsyncRpcContext ctx{background_threads_->cq(), session_pool_,
+                      retry_policy_prototype_, backoff_policy_prototype_};
+  auto transaction = std::move(params.transaction);
+  auto request = MakeReadRequest(std::move(params));
+  auto const* func = __func__;
+  return AsyncVisit(
+      std::move(transaction),
+      [ctx, request, func](SessionHolder& session,
+                           StatusOr<spanner_proto::TransactionSelector>& s,
+                           std::int64_t) {
+        return MakeAsyncRowStream(
+            AsyncResultSetImpl(ctx, session, s, request, func));
+      });
+}
+
+future<StatusOr<spanner::RowStream>> ConnectionImpl::AsyncExecuteQuery(
+    SqlParams params) {
+  AsyncRpcContext ctx{background_threads_->cq(), session_pool_,
+                      retry_policy_prototype_, backoff_policy_prototype_};
+  auto transaction = std::move(params.transaction);
+  auto request = MakeExecuteSqlRequest(
+      std::move(params), spanner_proto::ExecuteSqlRequest::NORMAL);
+  auto const* func = __func__;
+  return AsyncVisit(
+      std::move(transaction),
+      [ctx, request, func](SessionHolder& session,
+                           StatusOr<spanner_proto::TransactionSelector>& s,
+                           std::int64_t seqno) {
+        auto r = request;
+        r.set_seqno(seqno);
+        return MakeAsyncRowStream(
+            AsyncResultSetImpl(ctx, session, s, std::move(r), func));
+      });
+}
+
+future<StatusOr<spanner::DmlResult>> ConnectionImpl::AsyncExecuteDml(
+    SqlParams params) {
+  AsyncRpcContext ctx{background_threads_->cq(), session_pool_,
+                      retry_policy_prototype_, backoff_policy_prototype_};
+  auto transaction = std::move(params.transaction);
+  auto request = MakeExecuteSqlRequest(
+      std::move(params), spanner_proto::ExecuteSqlRequest::NORMAL);
+  auto const* func = __func__;
+  return AsyncVisit(
+      std::move(transaction),
+      [ctx, request, func](SessionHolder& session,
+                           StatusOr<spanner_proto::TransactionSelector>& s,
+                           std::int64_t seqno) {
+        auto r = request;
+        r.set_seqno(seqno);
+        return AsyncResultSetImpl(ctx, session, s, std::move(r), func)
+            .then([](future<StatusOr<spanner_proto::ResultSet>> f)
+                      -> StatusOr<spanner::DmlResult> {
+              auto response = f.get();
+              if (!response) return std::move(response).status();
+              return spanner::DmlResult(
+                  absl::make_unique<ResultSetSource>(*std::move(response)));
+            });
+      });
+}
+
+future<StatusOr<spanner::CommitResult>> ConnectionImpl::AsyncCommit(
+    CommitParams params) {
+  AsyncRpcContext ctx{background_threads_->cq(), session_pool_,
+                      retry_policy_prototype_, backoff_policy_prototype_};
+  auto transaction = std::move(params.transaction);
+  auto request = MakeCommitRequest(std::move(params));
+  auto const* func = __func__;
+  return AsyncVisit(
+      std::move(transaction),
+      [ctx, request, func](SessionHolder& session,
+                           StatusOr<spanner_proto::TransactionSelector>& s,
+                           std::int64_t) {
+        return AsyncCommitImpl(ctx, session, s, request, func);
+      });
+}
+
+StatusOr<spanner::SessionPoolStats> ConnectionImpl::GetSessionPoolStats() {
+  return session_pool_->GetStats();
+}
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
 }  // namespace cloud
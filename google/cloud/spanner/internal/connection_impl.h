@@ -21,17 +21,22 @@
 #include "google/cloud/spanner/internal/session.h"
 #include "google/cloud/spanner/internal/session_pool.h"
 #include "google/cloud/spanner/internal/spanner_stub.h"
+#include "google/cloud/spanner/query_stats_sampler.h"
 #include "google/cloud/spanner/retry_policy.h"
 #include "google/cloud/spanner/tracing_options.h"
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/background_threads.h"
 #include "google/cloud/backoff_policy.h"
+#include "google/cloud/future.h"
+#include "google/cloud/memory_accountant.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/spanner.pb.h>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace google {
@@ -65,6 +70,11 @@ class ConnectionImpl : public spanner::Connection {
       ExecuteBatchDmlParams) override;
   StatusOr<spanner::CommitResult> Commit(CommitParams) override;
   Status Rollback(RollbackParams) override;
+  future<StatusOr<spanner::RowStream>> AsyncRead(ReadParams) override;
+  future<StatusOr<spanner::RowStream>> AsyncExecuteQuery(SqlParams) override;
+  future<StatusOr<spanner::DmlResult>> AsyncExecuteDml(SqlParams) override;
+  future<StatusOr<spanner::CommitResult>> AsyncCommit(CommitParams) override;
+  StatusOr<spanner::SessionPoolStats> GetSessionPoolStats() override;
 
  private:
   Status PrepareSession(SessionHolder& session,
@@ -147,7 +157,8 @@ class ConnectionImpl : public spanner::Connection {
       SessionHolder& session,
       StatusOr<google::spanner::v1::TransactionSelector>& s, std::int64_t seqno,
       SqlParams params,
-      google::spanner::v1::ExecuteSqlRequest::QueryMode query_mode);
+      google::spanner::v1::ExecuteSqlRequest::QueryMode query_mode,
+      std::shared_ptr<spanner::QueryStatsSampler> stats_sampler = {});
   template <typename ResultType>
   StatusOr<ResultType> CommonDmlImpl(
       SessionHolder& session,
@@ -162,6 +173,12 @@ class ConnectionImpl : public spanner::Connection {
   std::shared_ptr<SessionPool> session_pool_;
   bool rpc_stream_tracing_enabled_ = false;
   TracingOptions tracing_options_;
+  int read_ahead_ = 0;
+  std::map<std::string, std::size_t> compression_;
+  // Tracks the responses buffered by the result sets, may be null.
+  std::shared_ptr<MemoryAccount> memory_account_;
+  // Samples the queries in `ExecuteQuery()`, may be null.
+  std::shared_ptr<spanner::QueryStatsSampler> query_stats_sampler_;
 };
 
 }  // namespace SPANNER_CLIENT_NS
@@ -19,8 +19,11 @@
 #include "google/cloud/spanner/options.h"
 #include "google/cloud/spanner/testing/matchers.h"
 #include "google/cloud/spanner/testing/mock_spanner_stub.h"
+#include "google/cloud/internal/background_threads_impl.h"
 #include "google/cloud/log.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
 #include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/mock_async_response_reader.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include "absl/memory/memory.h"
 #include "absl/types/optional.h"
@@ -59,8 +62,10 @@ namespace {
 #endif
 
 using ::google::cloud::spanner_testing::HasSessionAndTransactionId;
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
 using ::google::cloud::testing_util::IsOk;
 using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::MockAsyncResponseReader;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
 using ::testing::_;
@@ -78,6 +83,7 @@ using ::testing::Return;
 using ::testing::Sequence;
 using ::testing::SetArgPointee;
 using ::testing::StartsWith;
+using ::testing::StrictMock;
 using ::testing::UnorderedPointwise;
 using ::testing::Unused;
 
@@ -221,6 +227,22 @@ std::shared_ptr<spanner::Connection> MakeLimitedRetryConnection(
   return MakeConnectionImpl(db, {std::move(mock)}, std::move(opts));
 }
 
+// Create a `ConnectionImpl` that runs its asynchronous operations on @p impl,
+// with one session created when the connection is created.
+std::shared_ptr<ConnectionImpl> MakeAsyncTestConnection(
+    spanner::Database db, std::shared_ptr<SpannerStub> mock,
+    std::shared_ptr<FakeCompletionQueueImpl> const& impl) {
+  auto opts =
+      Options{}
+          .set<GrpcBackgroundThreadsFactoryOption>([impl] {
+            return absl::make_unique<
+                internal::CustomerSuppliedBackgroundThreads>(
+                CompletionQueue(impl));
+          })
+          .set<spanner::SessionPoolMinSessionsOption>(1);
+  return MakeConnectionImpl(std::move(db), {std::move(mock)}, std::move(opts));
+}
+
 class MockGrpcReader
     : public ::grpc::ClientReaderInterface<spanner_proto::PartialResultSet> {
  public:
@@ -1051,6 +1073,63 @@ TEST(ConnectionImplTest, ProfileQuerySuccess) {
   EXPECT_THAT(*execution_stats, UnorderedPointwise(Eq(), expected_stats));
 }
 
+TEST(ConnectionImplTest, ExecuteQuerySampledStats) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("placeholder_project", "placeholder_instance",
+                              "placeholder_database_id");
+  auto sampler = std::make_shared<spanner::QueryStatsSampler>(1.0);
+  auto conn = MakeConnectionImpl(
+      db, {mock}, Options{}.set<spanner::QueryStatsSamplerOption>(sampler));
+  EXPECT_CALL(*mock, BatchCreateSessions(_, HasDatabase(db)))
+      .WillOnce(Return(MakeSessionsResponse({"session-name"})));
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+      }
+    }
+    values: { string_value: "12" }
+    stats: {
+      query_plan { plan_nodes: { index: 42 } }
+      query_stats {
+        fields {
+          key: "cpu_time"
+          value { string_value: "2 msecs" }
+        }
+        fields {
+          key: "rows_scanned"
+          value { string_value: "7" }
+        }
+      }
+    }
+  )pb";
+  EXPECT_CALL(*mock, ExecuteStreamingSql)
+      .WillOnce([&](grpc::ClientContext&,
+                    spanner_proto::ExecuteSqlRequest const& request) {
+        EXPECT_EQ(spanner_proto::ExecuteSqlRequest::PROFILE,
+                  request.query_mode());
+        return MakeReader({kText});
+      });
+
+  auto rows = conn->ExecuteQuery(
+      {MakeSingleUseTransaction(spanner::Transaction::ReadOnlyOptions()),
+       spanner::SqlStatement("select * from table where id = 3")});
+  using RowType = std::tuple<std::int64_t>;
+  for (auto& row : spanner::StreamOf<RowType>(rows)) {
+    EXPECT_STATUS_OK(row);
+  }
+
+  auto const snapshot = sampler->Snapshot();
+  ASSERT_EQ(1, snapshot.size());
+  EXPECT_EQ("select * from table where id = ?", snapshot[0].fingerprint);
+  EXPECT_EQ(1, snapshot[0].samples);
+  EXPECT_EQ(std::chrono::microseconds(2000), snapshot[0].cpu_time);
+  EXPECT_EQ(7, snapshot[0].rows_scanned);
+}
+
 TEST(ConnectionImplTest, ProfileQueryGetSessionFailure) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = spanner::Database("placeholder_project", "placeholder_instance",
@@ -1673,6 +1752,145 @@ TEST(ConnectionImplTest,
                        HasSubstr("try-again in ExecutePartitionedDml")));
 }
 
+TEST(ConnectionImplTest, AsyncExecuteQuerySuccess) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("placeholder_project", "placeholder_instance",
+                              "placeholder_database_id");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, HasDatabase(db)))
+      .WillOnce(Return(MakeSessionsResponse({"test-session-name"})));
+  auto reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::ResultSet>>>();
+  EXPECT_CALL(*mock, AsyncExecuteSql)
+      .WillOnce([&reader](grpc::ClientContext&,
+                          spanner_proto::ExecuteSqlRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ("test-session-name", request.session());
+        EXPECT_EQ("select * from table", request.sql());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<
+            grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>(
+            reader.get());
+      });
+  EXPECT_CALL(*reader, Finish)
+      .WillOnce(
+          [](spanner_proto::ResultSet* result, grpc::Status* status, void*) {
+            auto constexpr kText = R"pb(
+              metadata: {
+                row_type: {
+                  fields: {
+                    name: "UserId",
+                    type: { code: INT64 }
+                  }
+                  fields: {
+                    name: "UserName",
+                    type: { code: STRING }
+                  }
+                }
+              }
+              rows: {
+                values: { string_value: "12" }
+                values: { string_value: "Steve" }
+              }
+              rows: {
+                values: { string_value: "42" }
+                values: { string_value: "Ann" }
+              }
+            )pb";
+            ASSERT_TRUE(TextFormat::ParseFromString(kText, result));
+            *status = grpc::Status::OK;
+          });
+
+  auto impl = std::make_shared<FakeCompletionQueueImpl>();
+  auto conn = MakeAsyncTestConnection(db, mock, impl);
+  auto pending = conn->AsyncExecuteQuery(
+      {MakeSingleUseTransaction(spanner::Transaction::ReadOnlyOptions()),
+       spanner::SqlStatement("select * from table")});
+  impl->SimulateCompletion(true);
+  auto rows = pending.get();
+  ASSERT_STATUS_OK(rows);
+
+  using RowType = std::tuple<std::int64_t, std::string>;
+  auto expected =
+      std::vector<RowType>{RowType(12, "Steve"), RowType(42, "Ann")};
+  int row_number = 0;
+  for (auto& row : spanner::StreamOf<RowType>(*rows)) {
+    EXPECT_STATUS_OK(row);
+    EXPECT_EQ(*row, expected[row_number]);
+    ++row_number;
+  }
+  EXPECT_EQ(row_number, expected.size());
+}
+
+TEST(ConnectionImplTest, AsyncCommitBeginsTransaction) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("placeholder_project", "placeholder_instance",
+                              "placeholder_database_id");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, HasDatabase(db)))
+      .WillOnce(Return(MakeSessionsResponse({"test-session-name"})));
+  spanner_proto::Transaction txn = MakeTestTransaction();
+  auto begin_reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::Transaction>>>();
+  EXPECT_CALL(*mock, AsyncBeginTransaction)
+      .WillOnce([&begin_reader](grpc::ClientContext&,
+                                spanner_proto::BeginTransactionRequest const&,
+                                grpc::CompletionQueue*) {
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::Transaction>>(begin_reader.get());
+      });
+  EXPECT_CALL(*begin_reader, Finish)
+      .WillOnce([&txn](spanner_proto::Transaction* response,
+                       grpc::Status* status, void*) {
+        *response = txn;
+        *status = grpc::Status::OK;
+      });
+  auto const commit_timestamp =
+      spanner::MakeTimestamp(std::chrono::system_clock::from_time_t(123))
+          .value();
+  auto commit_reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::CommitResponse>>>();
+  EXPECT_CALL(*mock, AsyncCommit)
+      .WillOnce([&commit_reader, &txn](
+                    grpc::ClientContext&,
+                    spanner_proto::CommitRequest const& request,
+                    grpc::CompletionQueue*) {
+        EXPECT_EQ("test-session-name", request.session());
+        EXPECT_EQ(txn.id(), request.transaction_id());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::CommitResponse>>(commit_reader.get());
+      });
+  EXPECT_CALL(*commit_reader, Finish)
+      .WillOnce([&commit_timestamp](spanner_proto::CommitResponse* response,
+                                    grpc::Status* status, void*) {
+        *response = MakeCommitResponse(commit_timestamp);
+        *status = grpc::Status::OK;
+      });
+
+  auto impl = std::make_shared<FakeCompletionQueueImpl>();
+  auto conn = MakeAsyncTestConnection(db, mock, impl);
+  auto pending = conn->AsyncCommit({spanner::MakeReadWriteTransaction()});
+  impl->SimulateCompletion(true);  // BeginTransaction
+  impl->SimulateCompletion(true);  // Commit
+  auto commit = pending.get();
+  ASSERT_STATUS_OK(commit);
+  EXPECT_EQ(commit_timestamp, commit->commit_timestamp);
+}
+
+TEST(ConnectionImplTest, AsyncCommitInvalidatedTransaction) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  auto db = spanner::Database("placeholder_project", "placeholder_instance",
+                              "placeholder_database_id");
+  auto conn = MakeConnectionImpl(db, {mock});
+
+  // Committing an invalidated transaction fails without any RPCs.
+  auto txn = spanner::MakeReadWriteTransaction();
+  SetTransactionInvalid(txn, Status(StatusCode::kAlreadyExists, "constraint"));
+  auto commit = conn->AsyncCommit({txn}).get();
+  EXPECT_THAT(commit, StatusIs(StatusCode::kAlreadyExists,
+                               HasSubstr("constraint")));
+}
+
 TEST(ConnectionImplTest, CommitGetSessionPermanentFailure) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
 
@@ -1944,26 +2162,35 @@ TEST(ConnectionImplTest, RollbackGetSessionFailure) {
                                  HasSubstr("uh-oh in GetSession")));
 }
 
-TEST(ConnectionImplTest, RollbackBeginTransaction) {
+TEST(ConnectionImplTest, RollbackBeforeBegin) {
   auto db = spanner::Database("project", "instance", "database");
-  std::string const session_name = "test-session-name";
-  std::string const transaction_id = "RollbackBeginTransaction";
-
-  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
-  EXPECT_CALL(*mock, BatchCreateSessions(_, HasDatabase(db)))
-      .WillOnce(Return(MakeSessionsResponse({session_name})));
-  EXPECT_CALL(*mock, BeginTransaction)
-      .WillOnce(Return(MakeTestTransaction(transaction_id)));
-  EXPECT_CALL(*mock, Rollback(_, AllOf(HasSession(session_name),
-                                       HasNakedTransactionId(transaction_id))))
-      .WillOnce(Return(Status()));
 
+  // The transaction never began, so no session or RPCs are needed.
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
   auto conn = MakeConnectionImpl(db, {mock});
   auto txn = spanner::MakeReadWriteTransaction();
   auto rollback = conn->Rollback({txn});
   EXPECT_STATUS_OK(rollback);
 }
 
+TEST(ConnectionImplTest, CommitAfterRollbackBeforeBegin) {
+  auto db = spanner::Database("project", "instance", "database");
+
+  // The rolled back transaction cannot be used, and no RPCs are needed.
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  auto conn = MakeConnectionImpl(db, {mock});
+  auto txn = spanner::MakeReadWriteTransaction();
+  EXPECT_STATUS_OK(conn->Rollback({txn}));
+  auto commit = conn->Commit({txn});
+  EXPECT_THAT(commit, StatusIs(StatusCode::kFailedPrecondition,
+                               HasSubstr("transaction rolled back")));
+  auto rows =
+      conn->ExecuteQuery({txn, spanner::SqlStatement("SELECT * FROM Table")});
+  for (auto const& row : rows) {
+    EXPECT_THAT(row, StatusIs(StatusCode::kFailedPrecondition));
+  }
+}
+
 TEST(ConnectionImplTest, RollbackSingleUseTransaction) {
   auto db = spanner::Database("project", "instance", "database");
   std::string const session_name = "test-session-name";
@@ -89,6 +89,9 @@ Options DefaultOptions(Options opts) {
     opts.set<spanner::SessionPoolKeepAliveIntervalOption>(
         std::chrono::minutes(55));
   }
+  if (!opts.has<spanner::SessionPoolWaitForWarmupOption>()) {
+    opts.set<spanner::SessionPoolWaitForWarmupOption>(true);
+  }
   if (!opts.has<SessionPoolClockOption>()) {
     opts.set<SessionPoolClockOption>(std::make_shared<Session::Clock>());
   }
@@ -104,6 +107,10 @@ Options DefaultOptions(Options opts) {
   min_sessions = (std::max)(min_sessions, 0);
   min_sessions =
       (std::min)(min_sessions, max_sessions_per_channel * num_channels);
+  auto& low_watermark = opts.lookup<spanner::SessionPoolLowWatermarkOption>();
+  low_watermark = (std::max)(low_watermark, 0);
+  auto& read_ahead = opts.lookup<spanner::StreamingReadAheadOption>();
+  read_ahead = (std::max)(read_ahead, 0);
 
   return opts;
 }
@@ -72,6 +72,8 @@ TEST(Options, Defaults) {
             opts.get<SessionPoolActionOnExhaustionOption>());
   EXPECT_EQ(std::chrono::minutes(55),
             opts.get<SessionPoolKeepAliveIntervalOption>());
+  EXPECT_TRUE(opts.get<SessionPoolWaitForWarmupOption>());
+  EXPECT_EQ(0, opts.get<SessionPoolLowWatermarkOption>());
 
   EXPECT_TRUE(opts.has<SpannerRetryPolicyOption>());
   EXPECT_TRUE(opts.has<SpannerBackoffPolicyOption>());
@@ -110,6 +112,8 @@ TEST(Options, AdminDefaults) {
   EXPECT_FALSE(opts.has<SessionPoolMaxIdleSessionsOption>());
   EXPECT_FALSE(opts.has<SessionPoolActionOnExhaustionOption>());
   EXPECT_FALSE(opts.has<SessionPoolKeepAliveIntervalOption>());
+  EXPECT_FALSE(opts.has<SessionPoolWaitForWarmupOption>());
+  EXPECT_FALSE(opts.has<SessionPoolLowWatermarkOption>());
   EXPECT_FALSE(opts.has<spanner_internal::SessionPoolClockOption>());
 }
 
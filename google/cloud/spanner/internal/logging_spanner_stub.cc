@@ -171,6 +171,20 @@ LoggingSpannerStub::StreamingRead(grpc::ClientContext& client_context,
       client_context, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+LoggingSpannerStub::AsyncRead(grpc::ClientContext& client_context,
+                              spanner_proto::ReadRequest const& request,
+                              grpc::CompletionQueue* cq) {
+  return LogWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::ReadRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return child_->AsyncRead(context, request, cq);
+      },
+      client_context, request, cq, __func__, tracing_options_);
+}
+
 StatusOr<spanner_proto::Transaction> LoggingSpannerStub::BeginTransaction(
     grpc::ClientContext& client_context,
     spanner_proto::BeginTransactionRequest const& request) {
@@ -182,6 +196,21 @@ StatusOr<spanner_proto::Transaction> LoggingSpannerStub::BeginTransaction(
       client_context, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+LoggingSpannerStub::AsyncBeginTransaction(
+    grpc::ClientContext& client_context,
+    spanner_proto::BeginTransactionRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return LogWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::BeginTransactionRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return child_->AsyncBeginTransaction(context, request, cq);
+      },
+      client_context, request, cq, __func__, tracing_options_);
+}
+
 StatusOr<spanner_proto::CommitResponse> LoggingSpannerStub::Commit(
     grpc::ClientContext& client_context,
     spanner_proto::CommitRequest const& request) {
@@ -193,6 +222,20 @@ StatusOr<spanner_proto::CommitResponse> LoggingSpannerStub::Commit(
       client_context, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+LoggingSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                spanner_proto::CommitRequest const& request,
+                                grpc::CompletionQueue* cq) {
+  return LogWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::CommitRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return child_->AsyncCommit(context, request, cq);
+      },
+      client_context, request, cq, __func__, tracing_options_);
+}
+
 Status LoggingSpannerStub::Rollback(
     grpc::ClientContext& client_context,
     spanner_proto::RollbackRequest const& request) {
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/internal/merge_chunk.h"
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -51,18 +52,23 @@ Status MergeChunk(google::protobuf::Value& value,  // NOLINT(misc-no-recursion)
 
       // Recursively merge the last element of value_list with the first
       // element of chunk_list if necessary.
-      auto value_it = value_list.rbegin();
-      auto chunk_it = chunk_list.begin();
-      if (value_it->kind_case() == google::protobuf::Value::kStringValue ||
-          value_it->kind_case() == google::protobuf::Value::kListValue) {
-        auto status = MergeChunk(*value_it, std::move(*chunk_it++));
+      auto& last = *value_list.rbegin();
+      int first = 0;
+      if (last.kind_case() == google::protobuf::Value::kStringValue ||
+          last.kind_case() == google::protobuf::Value::kListValue) {
+        auto status = MergeChunk(last, std::move(chunk_list[first++]));
         if (!status.ok()) return status;
       }
 
-      // Moves all the remaining elements over.
-      while (chunk_it != chunk_list.end()) {
-        *value.mutable_list_value()->add_values() = std::move(*chunk_it++);
-      }
+      // Transfers the ownership of the remaining elements, so they are
+      // neither copied nor reallocated.
+      std::vector<google::protobuf::Value*> remaining(chunk_list.size() -
+                                                      first);
+      chunk_list.ExtractSubrange(first, static_cast<int>(remaining.size()),
+                                 remaining.data());
+      value_list.Reserve(value_list.size() +
+                         static_cast<int>(remaining.size()));
+      for (auto* e : remaining) value_list.AddAllocated(e);
 
       return Status();
     }
@@ -73,6 +79,31 @@ Status MergeChunk(google::protobuf::Value& value,  // NOLINT(misc-no-recursion)
   return Status(StatusCode::kUnknown, "unknown Value type");
 }
 
+Status ChunkedValue::Merge(google::protobuf::Value&& chunk) {
+  if (value_.kind_case() == google::protobuf::Value::kStringValue &&
+      chunk.kind_case() == google::protobuf::Value::kStringValue) {
+    pieces_size_ += chunk.string_value().size();
+    pieces_.push_back(std::move(*chunk.mutable_string_value()));
+    return Status();
+  }
+  Flush();
+  return MergeChunk(value_, std::move(chunk));
+}
+
+google::protobuf::Value ChunkedValue::Finish() && {
+  Flush();
+  return std::move(value_);
+}
+
+void ChunkedValue::Flush() {
+  if (pieces_.empty()) return;
+  auto& s = *value_.mutable_string_value();
+  s.reserve(s.size() + pieces_size_);
+  for (auto const& p : pieces_) s += p;
+  pieces_.clear();
+  pieces_size_ = 0;
+}
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
 }  // namespace cloud
@@ -18,6 +18,9 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/status.h"
 #include <google/protobuf/struct.pb.h>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -47,6 +50,35 @@ inline namespace SPANNER_CLIENT_NS {
 Status MergeChunk(google::protobuf::Value& value,
                   google::protobuf::Value&& chunk);
 
+/**
+ * Reassembles a value that is split across several `PartialResultSet`s.
+ *
+ * Merging the chunks with this class gives the same result as calling
+ * `MergeChunk()` for each of them. When the value is a string (a `STRING` or
+ * `BYTES` column), it keeps each chunk as a separate piece, and concatenates
+ * the pieces only once, in `Finish()`. This avoids reallocating and copying
+ * the whole string as each chunk arrives, which matters for large values that
+ * span many responses.
+ */
+class ChunkedValue {
+ public:
+  explicit ChunkedValue(google::protobuf::Value value)
+      : value_(std::move(value)) {}
+
+  /// Merges @p chunk into the value, or returns an error.
+  Status Merge(google::protobuf::Value&& chunk);
+
+  /// Returns the merged value.
+  google::protobuf::Value Finish() &&;
+
+ private:
+  void Flush();
+
+  google::protobuf::Value value_;
+  std::vector<std::string> pieces_;  // to be appended to `value_`
+  std::size_t pieces_size_ = 0;
+};
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
 }  // namespace cloud
@@ -115,6 +115,45 @@ void BM_MergeChunkListsOfListOfString(benchmark::State& state) {
 }
 BENCHMARK(BM_MergeChunkListsOfListOfString);
 
+// A multi-MB `BYTES` value split across many responses, merged one chunk at
+// a time, as `PartialResultSetSource` did before `ChunkedValue`.
+void BM_MergeChunkLargeString(benchmark::State& state) {
+  auto const chunk = MakeProtoValue(std::string(64 * 1024, 'x'));
+  for (auto _ : state) {
+    auto value = chunk;
+    for (int i = 1; i != state.range(0); ++i) {
+      auto c = chunk;
+      benchmark::DoNotOptimize(MergeChunk(value, std::move(c)));
+    }
+  }
+}
+BENCHMARK(BM_MergeChunkLargeString)->Range(8, 512);
+
+void BM_ChunkedValueLargeString(benchmark::State& state) {
+  auto const chunk = MakeProtoValue(std::string(64 * 1024, 'x'));
+  for (auto _ : state) {
+    ChunkedValue value(chunk);
+    for (int i = 1; i != state.range(0); ++i) {
+      auto c = chunk;
+      benchmark::DoNotOptimize(value.Merge(std::move(c)));
+    }
+    benchmark::DoNotOptimize(std::move(value).Finish());
+  }
+}
+BENCHMARK(BM_ChunkedValueLargeString)->Range(8, 512);
+
+// An `ARRAY<BYTES>` with many large elements, split across responses.
+void BM_MergeChunkLargeList(benchmark::State& state) {
+  auto const chunk = MakeProtoValue(
+      std::vector<std::string>(state.range(0), std::string(1024, 'x')));
+  for (auto _ : state) {
+    auto value = chunk;
+    auto c = chunk;
+    benchmark::DoNotOptimize(MergeChunk(value, std::move(c)));
+  }
+}
+BENCHMARK(BM_MergeChunkLargeList)->Range(8, 4096);
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
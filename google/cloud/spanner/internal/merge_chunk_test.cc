@@ -220,6 +220,35 @@ TEST(MergeChunk, CannotMergeStruct) {
                                testing::HasSubstr("invalid type")));
 }
 
+TEST(ChunkedValue, Strings) {
+  ChunkedValue value(MakeProtoValue("foo"));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue("bar")));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue("")));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue("baz")));
+  EXPECT_THAT(std::move(value).Finish(),
+              IsProtoEqual(MakeProtoValue("foobarbaz")));
+}
+
+TEST(ChunkedValue, Lists) {
+  ChunkedValue value(MakeProtoValue(std::vector<std::string>{"a", "b"}));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue(std::vector<std::string>{"c"})));
+  ASSERT_STATUS_OK(
+      value.Merge(MakeProtoValue(std::vector<std::string>{"d", "e"})));
+  EXPECT_THAT(
+      std::move(value).Finish(),
+      IsProtoEqual(MakeProtoValue(std::vector<std::string>{"a", "bcd", "e"})));
+}
+
+TEST(ChunkedValue, MismatchedTypes) {
+  ChunkedValue value(MakeProtoValue("foo"));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue("bar")));
+  EXPECT_THAT(value.Merge(MakeProtoValue(std::vector<std::string>{"c"})),
+              StatusIs(Not(StatusCode::kOk), HasSubstr("mismatched types")));
+  // The pieces merged before the error are kept.
+  EXPECT_THAT(std::move(value).Finish(),
+              IsProtoEqual(MakeProtoValue("foobar")));
+}
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
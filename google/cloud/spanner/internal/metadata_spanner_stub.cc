@@ -127,6 +127,15 @@ MetadataSpannerStub::StreamingRead(grpc::ClientContext& client_context,
   return child_->StreamingRead(client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+MetadataSpannerStub::AsyncRead(grpc::ClientContext& client_context,
+                               spanner_proto::ReadRequest const& request,
+                               grpc::CompletionQueue* cq) {
+  SetMetadata(client_context, "session=" + request.session());
+  return child_->AsyncRead(client_context, request, cq);
+}
+
 StatusOr<spanner_proto::Transaction> MetadataSpannerStub::BeginTransaction(
     grpc::ClientContext& client_context,
     spanner_proto::BeginTransactionRequest const& request) {
@@ -134,6 +143,16 @@ StatusOr<spanner_proto::Transaction> MetadataSpannerStub::BeginTransaction(
   return child_->BeginTransaction(client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+MetadataSpannerStub::AsyncBeginTransaction(
+    grpc::ClientContext& client_context,
+    spanner_proto::BeginTransactionRequest const& request,
+    grpc::CompletionQueue* cq) {
+  SetMetadata(client_context, "session=" + request.session());
+  return child_->AsyncBeginTransaction(client_context, request, cq);
+}
+
 StatusOr<spanner_proto::CommitResponse> MetadataSpannerStub::Commit(
     grpc::ClientContext& client_context,
     spanner_proto::CommitRequest const& request) {
@@ -141,6 +160,15 @@ StatusOr<spanner_proto::CommitResponse> MetadataSpannerStub::Commit(
   return child_->Commit(client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+MetadataSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                 spanner_proto::CommitRequest const& request,
+                                 grpc::CompletionQueue* cq) {
+  SetMetadata(client_context, "session=" + request.session());
+  return child_->AsyncCommit(client_context, request, cq);
+}
+
 Status MetadataSpannerStub::Rollback(
     grpc::ClientContext& client_context,
     spanner_proto::RollbackRequest const& request) {
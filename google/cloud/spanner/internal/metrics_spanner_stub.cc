@@ -0,0 +1,269 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/metrics_spanner_stub.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+#include <grpcpp/grpcpp.h>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace spanner_proto = ::google::spanner::v1;
+using ::google::cloud::internal::MetricsWrapper;
+
+StatusOr<spanner_proto::Session> MetricsSpannerStub::CreateSession(
+    grpc::ClientContext& client_context,
+    spanner_proto::CreateSessionRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::CreateSessionRequest const& request) {
+        return child_->CreateSession(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.CreateSession"));
+}
+
+StatusOr<spanner_proto::BatchCreateSessionsResponse>
+MetricsSpannerStub::BatchCreateSessions(
+    grpc::ClientContext& client_context,
+    spanner_proto::BatchCreateSessionsRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::BatchCreateSessionsRequest const& request) {
+        return child_->BatchCreateSessions(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.BatchCreateSessions"));
+}
+
+std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+    spanner_proto::BatchCreateSessionsResponse>>
+MetricsSpannerStub::AsyncBatchCreateSessions(
+    grpc::ClientContext& client_context,
+    spanner_proto::BatchCreateSessionsRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::BatchCreateSessionsRequest const& request) {
+        return child_->AsyncBatchCreateSessions(context, request, cq);
+      },
+      client_context, request, metrics_->Method("Spanner.BatchCreateSessions"));
+}
+
+StatusOr<spanner_proto::Session> MetricsSpannerStub::GetSession(
+    grpc::ClientContext& client_context,
+    spanner_proto::GetSessionRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::GetSessionRequest const& request) {
+        return child_->GetSession(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.GetSession"));
+}
+
+StatusOr<spanner_proto::ListSessionsResponse> MetricsSpannerStub::ListSessions(
+    grpc::ClientContext& client_context,
+    spanner_proto::ListSessionsRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::ListSessionsRequest const& request) {
+        return child_->ListSessions(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.ListSessions"));
+}
+
+Status MetricsSpannerStub::DeleteSession(
+    grpc::ClientContext& client_context,
+    spanner_proto::DeleteSessionRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::DeleteSessionRequest const& request) {
+        return child_->DeleteSession(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.DeleteSession"));
+}
+
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<google::protobuf::Empty>>
+MetricsSpannerStub::AsyncDeleteSession(
+    grpc::ClientContext& client_context,
+    spanner_proto::DeleteSessionRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::DeleteSessionRequest const& request) {
+        return child_->AsyncDeleteSession(context, request, cq);
+      },
+      client_context, request, metrics_->Method("Spanner.DeleteSession"));
+}
+
+StatusOr<spanner_proto::ResultSet> MetricsSpannerStub::ExecuteSql(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteSqlRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::ExecuteSqlRequest const& request) {
+        return child_->ExecuteSql(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.ExecuteSql"));
+}
+
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+MetricsSpannerStub::AsyncExecuteSql(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteSqlRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::ExecuteSqlRequest const& request) {
+        return child_->AsyncExecuteSql(context, request, cq);
+      },
+      client_context, request, metrics_->Method("Spanner.ExecuteSql"));
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
+MetricsSpannerStub::ExecuteStreamingSql(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteSqlRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::ExecuteSqlRequest const& request) {
+        return child_->ExecuteStreamingSql(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.ExecuteStreamingSql"));
+}
+
+StatusOr<spanner_proto::ExecuteBatchDmlResponse>
+MetricsSpannerStub::ExecuteBatchDml(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteBatchDmlRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::ExecuteBatchDmlRequest const& request) {
+        return child_->ExecuteBatchDml(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.ExecuteBatchDml"));
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
+MetricsSpannerStub::StreamingRead(grpc::ClientContext& client_context,
+                                  spanner_proto::ReadRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::ReadRequest const& request) {
+        return child_->StreamingRead(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.StreamingRead"));
+}
+
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+MetricsSpannerStub::AsyncRead(grpc::ClientContext& client_context,
+                              spanner_proto::ReadRequest const& request,
+                              grpc::CompletionQueue* cq) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::ReadRequest const& request) {
+        return child_->AsyncRead(context, request, cq);
+      },
+      client_context, request, metrics_->Method("Spanner.Read"));
+}
+
+StatusOr<spanner_proto::Transaction> MetricsSpannerStub::BeginTransaction(
+    grpc::ClientContext& client_context,
+    spanner_proto::BeginTransactionRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::BeginTransactionRequest const& request) {
+        return child_->BeginTransaction(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.BeginTransaction"));
+}
+
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+MetricsSpannerStub::AsyncBeginTransaction(
+    grpc::ClientContext& client_context,
+    spanner_proto::BeginTransactionRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::BeginTransactionRequest const& request) {
+        return child_->AsyncBeginTransaction(context, request, cq);
+      },
+      client_context, request, metrics_->Method("Spanner.BeginTransaction"));
+}
+
+StatusOr<spanner_proto::CommitResponse> MetricsSpannerStub::Commit(
+    grpc::ClientContext& client_context,
+    spanner_proto::CommitRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::CommitRequest const& request) {
+        return child_->Commit(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.Commit"));
+}
+
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+MetricsSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                spanner_proto::CommitRequest const& request,
+                                grpc::CompletionQueue* cq) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::CommitRequest const& request) {
+        return child_->AsyncCommit(context, request, cq);
+      },
+      client_context, request, metrics_->Method("Spanner.Commit"));
+}
+
+Status MetricsSpannerStub::Rollback(
+    grpc::ClientContext& client_context,
+    spanner_proto::RollbackRequest const& request) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::RollbackRequest const& request) {
+        return child_->Rollback(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.Commit"));
+}
+
+StatusOr<spanner_proto::PartitionResponse> MetricsSpannerStub::PartitionQuery(
+    grpc::ClientContext& client_context,
+    spanner_proto::PartitionQueryRequest const& request) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::PartitionQueryRequest const& request) {
+        return child_->PartitionQuery(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.Commit"));
+}
+
+StatusOr<spanner_proto::PartitionResponse> MetricsSpannerStub::PartitionRead(
+    grpc::ClientContext& client_context,
+    spanner_proto::PartitionReadRequest const& request) {
+  return MetricsWrapper(
+      [this, cq](grpc::ClientContext& context,
+                 spanner_proto::PartitionReadRequest const& request) {
+        return child_->PartitionRead(context, request);
+      },
+      client_context, request, metrics_->Method("Spanner.Commit"));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,134 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/internal/metrics_spanner_stub.h"
+#include "google/cloud/spanner/testing/mock_spanner_stub.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <grpcpp/grpcpp.h>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Return;
+namespace spanner_proto = ::google::spanner::v1;
+
+class FakeAllocationCounter : public RpcAllocationCounter {
+ public:
+  std::int64_t Count() override { return count; }
+  std::int64_t count = 0;
+};
+
+TEST(MetricsSpannerStubTest, Success) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  spanner_proto::Session session;
+  session.set_name("test-session-name");
+  EXPECT_CALL(*mock, CreateSession).WillOnce(Return(session));
+
+  auto metrics = std::make_shared<RpcMetrics>();
+  MetricsSpannerStub stub(mock, metrics);
+  grpc::ClientContext context;
+  auto response =
+      stub.CreateSession(context, spanner_proto::CreateSessionRequest());
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(
+      metrics->Snapshot(),
+      ElementsAre(AllOf(
+          Field(&RpcMethodMetricsSnapshot::method, "Spanner.CreateSession"),
+          Field(&RpcMethodMetricsSnapshot::calls, 1),
+          Field(&RpcMethodMetricsSnapshot::errors, 0),
+          Field(&RpcMethodMetricsSnapshot::bytes_received,
+                session.ByteSizeLong()))));
+}
+
+TEST(MetricsSpannerStubTest, Error) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  EXPECT_CALL(*mock, Rollback)
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+
+  auto metrics = std::make_shared<RpcMetrics>();
+  MetricsSpannerStub stub(mock, metrics);
+  grpc::ClientContext context;
+  auto status = stub.Rollback(context, spanner_proto::RollbackRequest());
+  EXPECT_THAT(status, StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(metrics->Snapshot(),
+              ElementsAre(AllOf(
+                  Field(&RpcMethodMetricsSnapshot::method, "Spanner.Rollback"),
+                  Field(&RpcMethodMetricsSnapshot::calls, 1),
+                  Field(&RpcMethodMetricsSnapshot::errors, 1))));
+}
+
+TEST(MetricsSpannerStubTest, AsyncAndStreamingCalls) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  EXPECT_CALL(*mock, AsyncCommit)
+      .WillOnce([](grpc::ClientContext&, spanner_proto::CommitRequest const&,
+                   grpc::CompletionQueue*) { return nullptr; });
+  EXPECT_CALL(*mock, ExecuteStreamingSql)
+      .WillOnce(
+          [](grpc::ClientContext&, spanner_proto::ExecuteSqlRequest const&) {
+            return nullptr;
+          });
+
+  auto metrics = std::make_shared<RpcMetrics>();
+  MetricsSpannerStub stub(mock, metrics);
+  grpc::CompletionQueue cq;
+  grpc::ClientContext c0;
+  stub.AsyncCommit(c0, spanner_proto::CommitRequest(), &cq);
+  grpc::ClientContext c1;
+  stub.ExecuteStreamingSql(c1, spanner_proto::ExecuteSqlRequest());
+  EXPECT_THAT(
+      metrics->Snapshot(),
+      ElementsAre(
+          AllOf(Field(&RpcMethodMetricsSnapshot::method, "Spanner.Commit"),
+                Field(&RpcMethodMetricsSnapshot::calls, 1)),
+          AllOf(Field(&RpcMethodMetricsSnapshot::method,
+                      "Spanner.ExecuteStreamingSql"),
+                Field(&RpcMethodMetricsSnapshot::calls, 1))));
+}
+
+TEST(MetricsSpannerStubTest, ResourceAccounting) {
+  auto counter = std::make_shared<FakeAllocationCounter>();
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  EXPECT_CALL(*mock, BeginTransaction)
+      .WillOnce([&counter](grpc::ClientContext&,
+                           spanner_proto::BeginTransactionRequest const&) {
+        counter->count += 2;
+        return spanner_proto::Transaction{};
+      });
+
+  auto metrics = std::make_shared<RpcMetrics>(RpcResourceAccounting{counter});
+  MetricsSpannerStub stub(mock, metrics);
+  grpc::ClientContext context;
+  auto response = stub.BeginTransaction(
+      context, spanner_proto::BeginTransactionRequest());
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(metrics->Snapshot(),
+              ElementsAre(Field(&RpcMethodMetricsSnapshot::allocations, 2)));
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
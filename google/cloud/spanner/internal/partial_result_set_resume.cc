@@ -20,7 +20,11 @@ namespace cloud {
 namespace spanner_internal {
 inline namespace SPANNER_CLIENT_NS {
 
-void PartialResultSetResume::TryCancel() { child_->TryCancel(); }
+void PartialResultSetResume::TryCancel() {
+  std::lock_guard<std::mutex> lk(mu_);
+  cancelled_ = true;
+  child_->TryCancel();
+}
 
 absl::optional<google::spanner::v1::PartialResultSet>
 PartialResultSetResume::Read() {
@@ -38,6 +42,8 @@ PartialResultSetResume::Read() {
       return {};
     }
     std::this_thread::sleep_for(backoff_policy_prototype_->OnCompletion());
+    std::lock_guard<std::mutex> lk(mu_);
+    if (cancelled_) return {};
     last_status_.reset();
     child_ = factory_(last_resume_token_);
   } while (!retry_policy_prototype_->IsExhausted());
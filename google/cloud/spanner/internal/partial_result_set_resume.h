@@ -24,6 +24,7 @@
 #include "absl/types/optional.h"
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace google {
@@ -37,6 +38,9 @@ using PartialResultSetReaderFactory =
 
 /**
  * A PartialResultSetReader that resumes the streaming RPC on retryable errors.
+ *
+ * `TryCancel()` may be called while another thread is blocked in `Read()`,
+ * the reader does not resume the streaming RPC after it is cancelled.
  */
 class PartialResultSetResume : public PartialResultSetReader {
  public:
@@ -62,6 +66,9 @@ class PartialResultSetResume : public PartialResultSetReader {
   std::unique_ptr<spanner::RetryPolicy> retry_policy_prototype_;
   std::unique_ptr<spanner::BackoffPolicy> backoff_policy_prototype_;
   std::string last_resume_token_;
+  // Guards replacing `child_` against concurrent `TryCancel()` calls.
+  std::mutex mu_;
+  bool cancelled_ = false;
   std::unique_ptr<PartialResultSetReader> child_;
   absl::optional<Status> last_status_;
 };
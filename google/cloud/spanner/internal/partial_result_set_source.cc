@@ -15,6 +15,9 @@
 #include "google/cloud/spanner/internal/partial_result_set_source.h"
 #include "google/cloud/spanner/internal/merge_chunk.h"
 #include "google/cloud/log.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 
 namespace google {
 namespace cloud {
@@ -22,9 +25,11 @@ namespace spanner_internal {
 inline namespace SPANNER_CLIENT_NS {
 
 StatusOr<std::unique_ptr<ResultSourceInterface>> PartialResultSetSource::Create(
-    std::unique_ptr<PartialResultSetReader> reader) {
-  std::unique_ptr<PartialResultSetSource> source(
-      new PartialResultSetSource(std::move(reader)));
+    std::unique_ptr<PartialResultSetReader> reader,
+    std::shared_ptr<MemoryAccount> memory_account,
+    absl::optional<std::int64_t> max_rows) {
+  std::unique_ptr<PartialResultSetSource> source(new PartialResultSetSource(
+      std::move(reader), std::move(memory_account), max_rows));
 
   // Do the first read so the metadata is immediately available.
   auto status = source->ReadFromStream();
@@ -36,14 +41,89 @@ StatusOr<std::unique_ptr<ResultSourceInterface>> PartialResultSetSource::Create(
   if (!source->metadata_) {
     return Status(StatusCode::kInternal, "response contained no metadata");
   }
+  source->OnRowsReturned(0);
 
   return {std::move(source)};
 }
 
 StatusOr<spanner::Row> PartialResultSetSource::NextRow() {
-  if (finished_) {
-    return spanner::Row();
+  auto has_row = BufferRow();
+  if (!has_row) return std::move(has_row).status();
+  if (!*has_row) return spanner::Row();
+
+  std::vector<spanner::Value> values;
+  values.reserve(column_types_.size());
+  auto iter = buffer_.begin();
+  for (auto const& type : column_types_) {
+    values.push_back(FromProto(type, std::move(*iter)));
+    ++iter;
+  }
+  buffer_.erase(buffer_.begin(), iter);
+  OnRowsReturned(1);
+  return MakeRow(std::move(values), columns_);
+}
+
+Status PartialResultSetSource::NextRowValues(
+    std::vector<google::protobuf::Value>& values) {
+  values.clear();
+  auto has_row = BufferRow();
+  if (!has_row) return std::move(has_row).status();
+  if (!*has_row) return Status();
+
+  auto end = buffer_.begin() + column_types_.size();
+  values.reserve(column_types_.size());
+  std::move(buffer_.begin(), end, std::back_inserter(values));
+  buffer_.erase(buffer_.begin(), end);
+  OnRowsReturned(1);
+  return Status();
+}
+
+StatusOr<spanner::ColumnBatch> PartialResultSetSource::NextBatch(
+    std::size_t max_rows) {
+  auto const& row_type = metadata_->row_type();
+  auto batch = MakeColumnBatch(row_type, columns_);
+  auto const columns = columns_->size();
+  if (columns == 0) {
+    // There is nothing to decode, `NextRow()` detects the end of the stream or
+    // reports the missing row type.
+    auto row = NextRow();
+    if (!row) return std::move(row).status();
+    return batch;
+  }
+
+  if (rows_remaining_) {
+    max_rows = (std::min)(max_rows, static_cast<std::size_t>(*rows_remaining_));
+  }
+  while (batch.num_rows() < max_rows) {
+    if (buffer_.size() < columns) {
+      if (finished_) break;
+      auto status = ReadFromStream();
+      if (!status.ok()) return status;
+      if (finished_) {
+        if (chunk_) {
+          return Status(StatusCode::kInternal,
+                        "incomplete chunked_value at end of stream");
+        }
+        if (!buffer_.empty()) {
+          return Status(StatusCode::kInternal,
+                        "incomplete row at end of stream");
+        }
+      }
+      continue;
+    }
+    auto iter = buffer_.begin();
+    for (std::size_t i = 0; i != columns; ++i, ++iter) {
+      auto status = AppendToColumnBatch(batch, i, std::move(*iter));
+      if (!status.ok()) return status;
+    }
+    buffer_.erase(buffer_.begin(), iter);
   }
+  OnRowsReturned(batch.num_rows());
+  return batch;
+}
+
+StatusOr<bool> PartialResultSetSource::BufferRow() {
+  if (finished_) return false;
 
   while (buffer_.empty() || buffer_.size() < columns_->size()) {
     auto status = ReadFromStream();
@@ -58,50 +138,55 @@ StatusOr<spanner::Row> PartialResultSetSource::NextRow() {
       if (!buffer_.empty()) {
         return Status(StatusCode::kInternal, "incomplete row at end of stream");
       }
-      return spanner::Row();
+      return false;
     }
   }
 
-  auto const& fields = metadata_->row_type().fields();
-  if (fields.empty()) {
+  if (column_types_.empty()) {
     return Status(StatusCode::kInternal,
                   "response metadata is missing row type information");
   }
+  return true;
+}
 
-  std::vector<spanner::Value> values;
-  values.reserve(fields.size());
-  auto iter = buffer_.begin();
-  for (auto const& field : fields) {
-    values.push_back(FromProto(field.type(), std::move(*iter)));
-    ++iter;
-  }
-  buffer_.erase(buffer_.begin(), iter);
-  return MakeRow(std::move(values), columns_);
+void PartialResultSetSource::OnRowsReturned(std::size_t rows) {
+  if (!rows_remaining_) return;
+  *rows_remaining_ -= static_cast<std::int64_t>(rows);
+  if (*rows_remaining_ <= 0) Cancel();
 }
 
-PartialResultSetSource::~PartialResultSetSource() {
-  if (!finished_) {
-    // If there is actual data in the streaming RPC Finish() can deadlock, so
-    // before trying to read the final status we need to cancel the streaming
-    // RPC.
-    reader_->TryCancel();
-    // The user didn't iterate over all the data; finish the stream on their
-    // behalf, but we have no way to communicate error status.
-    auto finish_status = reader_->Finish();
-    if (!finish_status.ok() && finish_status.code() != StatusCode::kCancelled) {
-      GCP_LOG(WARNING) << "Finish() failed in destructor: " << finish_status;
-    }
+void PartialResultSetSource::Cancel() {
+  if (finished_) return;
+  // If there is actual data in the streaming RPC Finish() can deadlock, so
+  // before trying to read the final status we need to cancel the streaming
+  // RPC.
+  reader_->TryCancel();
+  // The user didn't iterate over all the data; finish the stream on their
+  // behalf, but we have no way to communicate error status.
+  auto finish_status = reader_->Finish();
+  if (!finish_status.ok() && finish_status.code() != StatusCode::kCancelled) {
+    GCP_LOG(WARNING) << "Finish() failed in Cancel(): " << finish_status;
   }
+  finished_ = true;
+  buffer_.clear();
+  chunk_.reset();
+  memory_.Resize(0);
 }
 
+PartialResultSetSource::~PartialResultSetSource() { Cancel(); }
+
 Status PartialResultSetSource::ReadFromStream() {
   auto result_set = reader_->Read();
   if (!result_set) {
     // Read() returns false for end of stream, whether we read all the data or
     // encountered an error. Finish() tells us the status.
     finished_ = true;
+    memory_.Resize(0);
     return reader_->Finish();
   }
+  // The values of the previous responses are (mostly) consumed, account for
+  // the new response until the next read.
+  memory_.Resize(static_cast<std::int64_t>(result_set->ByteSizeLong()));
 
   if (result_set->has_metadata()) {
     // If we got metadata more than once, log it, but use the first one.
@@ -109,11 +194,13 @@ Status PartialResultSetSource::ReadFromStream() {
       GCP_LOG(WARNING) << "Unexpectedly received two sets of metadata";
     } else {
       metadata_ = std::move(*result_set->mutable_metadata());
-      // Copies the column names into a shared_ptr that will be shared with
-      // every Row object returned from NextRow().
+      // Copies the column names and types into shared_ptrs that will be
+      // shared with every Row object returned from NextRow().
       columns_ = std::make_shared<std::vector<std::string>>();
       for (auto const& field : metadata_->row_type().fields()) {
         columns_->push_back(field.name());
+        column_types_.push_back(
+            std::make_shared<google::spanner::v1::Type const>(field.type()));
       }
     }
   }
@@ -151,13 +238,16 @@ Status PartialResultSetSource::ReadFromStream() {
                     "PartialResultSet contained no values "
                     "to merge with prior chunked_value");
     }
-    auto& front = new_values[0];
-    auto merge_status = MergeChunk(*chunk_, std::move(front));
+    auto merge_status = chunk_->Merge(std::move(new_values[0]));
     if (!merge_status.ok()) {
       return merge_status;
     }
-    using std::swap;
-    swap(*chunk_, front);
+    if (new_values.size() == 1 && result_set->chunked_value()) {
+      // The value continues in the next response (the `E2` case above), keep
+      // accumulating its chunks.
+      return {};  // OK
+    }
+    new_values[0] = std::move(*chunk_).Finish();
     chunk_ = {};
   }
 
@@ -167,7 +257,7 @@ Status PartialResultSetSource::ReadFromStream() {
                     "PartialResultSet had chunked_value "
                     "set true but contained no values");
     }
-    chunk_ = std::move(new_values[new_values.size() - 1]);
+    chunk_.emplace(std::move(new_values[new_values.size() - 1]));
     new_values.RemoveLast();
   }
 
@@ -15,15 +15,19 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_SOURCE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_SOURCE_H
 
+#include "google/cloud/spanner/internal/merge_chunk.h"
 #include "google/cloud/spanner/internal/partial_result_set_reader.h"
 #include "google/cloud/spanner/results.h"
 #include "google/cloud/spanner/value.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/memory_accountant.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "absl/types/optional.h"
 #include <google/spanner/v1/spanner.pb.h>
 #include <grpcpp/grpcpp.h>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <string>
@@ -42,13 +46,32 @@ inline namespace SPANNER_CLIENT_NS {
 class PartialResultSetSource : public ResultSourceInterface {
  public:
   /// Factory method to create a PartialResultSetSource.
+  ///
+  /// The size of the last response is reported to @p memory_account, if set,
+  /// until the values in it are consumed. If @p max_rows is set the stream is
+  /// cancelled, and ends, as soon as that many rows are returned.
   static StatusOr<std::unique_ptr<ResultSourceInterface>> Create(
-      std::unique_ptr<PartialResultSetReader> reader);
+      std::unique_ptr<PartialResultSetReader> reader,
+      std::shared_ptr<MemoryAccount> memory_account = {},
+      absl::optional<std::int64_t> max_rows = absl::nullopt);
 
   ~PartialResultSetSource() override;
 
   StatusOr<spanner::Row> NextRow() override;
 
+  /// Decodes the values directly into the column buffers, without creating a
+  /// `spanner::Row` for each result.
+  StatusOr<spanner::ColumnBatch> NextBatch(std::size_t max_rows) override;
+
+  std::vector<std::shared_ptr<google::spanner::v1::Type const>> ColumnTypes()
+      override {
+    return column_types_;
+  }
+
+  /// Moves the values out of the response buffer, used by `StreamOf()` to
+  /// decode each `std::tuple` without creating a `spanner::Row`.
+  Status NextRowValues(std::vector<google::protobuf::Value>& values) override;
+
   absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
     return metadata_;
   }
@@ -57,19 +80,37 @@ class PartialResultSetSource : public ResultSourceInterface {
     return stats_;
   }
 
+  void Cancel() override;
+
  private:
-  explicit PartialResultSetSource(
-      std::unique_ptr<PartialResultSetReader> reader)
-      : reader_(std::move(reader)) {}
+  PartialResultSetSource(std::unique_ptr<PartialResultSetReader> reader,
+                         std::shared_ptr<MemoryAccount> memory_account,
+                         absl::optional<std::int64_t> max_rows)
+      : reader_(std::move(reader)),
+        memory_(std::move(memory_account)),
+        rows_remaining_(max_rows) {}
 
   Status ReadFromStream();
 
+  // Reads until `buffer_` holds a complete row, returns false at the end of
+  // the stream.
+  StatusOr<bool> BufferRow();
+
+  // Counts the rows returned to the application, cancels the stream once
+  // `max_rows` are returned.
+  void OnRowsReturned(std::size_t rows);
+
   std::unique_ptr<PartialResultSetReader> reader_;
   absl::optional<google::spanner::v1::ResultSetMetadata> metadata_;
   absl::optional<google::spanner::v1::ResultSetStats> stats_;
   std::deque<google::protobuf::Value> buffer_;
-  absl::optional<google::protobuf::Value> chunk_;
+  google::cloud::internal::MemoryReservation memory_;
+  absl::optional<ChunkedValue> chunk_;
   std::shared_ptr<std::vector<std::string>> columns_;
+  // The column types, shared with every `Value` returned from NextRow().
+  std::vector<std::shared_ptr<google::spanner::v1::Type const>> column_types_;
+  // The rows the application still wants, unset if there is no limit.
+  absl::optional<std::int64_t> rows_remaining_;
   bool finished_ = false;
 };
 
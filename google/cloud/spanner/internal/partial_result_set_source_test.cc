@@ -25,6 +25,8 @@
 #include <array>
 #include <cstdint>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -39,6 +41,7 @@ using ::google::cloud::spanner_testing::MockPartialResultSetReader;
 using ::google::cloud::testing_util::IsProtoEqual;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
 using ::testing::Return;
 
@@ -254,6 +257,40 @@ TEST(PartialResultSetSourceTest, SingleResponse) {
  * @test Verify the functionality of the PartialResultSetSource when the gRPC
  * reader returns data across multiple Read() calls.
  */
+/// @test Verify the buffered responses are reported to the memory account.
+TEST(PartialResultSetSourceTest, MemoryAccounting) {
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+      }
+    }
+    values: { string_value: "10" }
+  )pb";
+  spanner_proto::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  EXPECT_CALL(*grpc_reader, Read())
+      .WillOnce(Return(response))
+      .WillOnce(Return(absl::optional<spanner_proto::PartialResultSet>{}));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(Return(Status()));
+
+  auto accountant = std::make_shared<MemoryAccountant>();
+  auto reader = PartialResultSetSource::Create(
+      std::move(grpc_reader), accountant->CreateAccount("test"));
+  ASSERT_STATUS_OK(reader);
+  EXPECT_EQ(static_cast<std::int64_t>(response.ByteSizeLong()),
+            accountant->bytes());
+
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(MakeTestRow({{"UserId", spanner::Value(10)}})));
+  EXPECT_THAT((*reader)->NextRow(), IsValidAndEquals(spanner::Row{}));
+  EXPECT_EQ(0, accountant->bytes());
+}
+
 TEST(PartialResultSetSourceTest, MultipleResponses) {
   auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
   std::array<char const*, 5> text{{
@@ -338,6 +375,214 @@ TEST(PartialResultSetSourceTest, MultipleResponses) {
   EXPECT_THAT((*reader)->NextRow(), IsValidAndEquals(spanner::Row{}));
 }
 
+/// @test Verify `NextBatch()` decodes the rows across multiple responses.
+TEST(PartialResultSetSourceTest, NextBatch) {
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  std::array<char const*, 3> text{{
+      R"pb(
+        metadata: {
+          row_type: {
+            fields: {
+              name: "UserId",
+              type: { code: INT64 }
+            }
+            fields: {
+              name: "UserName",
+              type: { code: STRING }
+            }
+          }
+        }
+        values: { string_value: "10" }
+        values: { string_value: "user10" }
+        values: { string_value: "22" }
+      )pb",
+      R"pb(
+        values: { null_value: NULL_VALUE }
+        values: { string_value: "99" }
+        values: { string_value: "user" }
+        chunked_value: true
+      )pb",
+      R"pb(
+        values: { string_value: "99" }
+        values: { string_value: "42" }
+        values: { string_value: "user42" }
+      )pb",
+  }};
+  std::array<spanner_proto::PartialResultSet, text.size()> response;
+  for (std::size_t i = 0; i != text.size(); ++i) {
+    SCOPED_TRACE("Converting text to proto [" + std::to_string(i) + "]");
+    ASSERT_TRUE(TextFormat::ParseFromString(text[i], &response[i]));
+  }
+  EXPECT_CALL(*grpc_reader, Read())
+      .WillOnce(Return(response[0]))
+      .WillOnce(Return(response[1]))
+      .WillOnce(Return(response[2]))
+      .WillOnce(Return(absl::optional<spanner_proto::PartialResultSet>{}));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(Return(Status()));
+
+  auto reader = PartialResultSetSource::Create(std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+
+  auto batch = (*reader)->NextBatch(2);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_THAT(batch->column_names(), ElementsAre("UserId", "UserName"));
+  ASSERT_EQ(2U, batch->num_rows());
+  auto ids = batch->Int64Values(0);
+  ASSERT_STATUS_OK(ids);
+  EXPECT_THAT(std::vector<std::int64_t>(ids->begin(), ids->end()),
+              ElementsAre(10, 22));
+  auto name = batch->StringValue(1, 0);
+  ASSERT_STATUS_OK(name);
+  EXPECT_EQ("user10", *name);
+  auto is_null = batch->IsNull(1, 1);
+  ASSERT_STATUS_OK(is_null);
+  EXPECT_TRUE(*is_null);
+
+  // Batches and rows can be mixed, each row is returned once.
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(MakeTestRow({
+                  {"UserId", spanner::Value(99)},
+                  {"UserName", spanner::Value("user99")},
+              })));
+  batch = (*reader)->NextBatch(2);
+  ASSERT_STATUS_OK(batch);
+  ASSERT_EQ(1U, batch->num_rows());
+  EXPECT_EQ(42, *batch->get<std::int64_t>(0, 0));
+  EXPECT_EQ("user42", *batch->get<std::string>(1, 0));
+
+  // At end of stream, we get an empty batch.
+  batch = (*reader)->NextBatch(2);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(0U, batch->num_rows());
+}
+
+/// @test Verify the stream is cancelled once `max_rows` rows are returned.
+TEST(PartialResultSetSourceTest, MaxRowsCancelsStream) {
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+      }
+    }
+    values: { string_value: "10" }
+    values: { string_value: "22" }
+    values: { string_value: "99" }
+  )pb";
+  spanner_proto::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*grpc_reader, Read()).WillOnce(Return(response));
+    // The rest of the results are never read.
+    EXPECT_CALL(*grpc_reader, TryCancel()).Times(1);
+    EXPECT_CALL(*grpc_reader, Finish())
+        .WillOnce(Return(Status(StatusCode::kCancelled, "cancelled")));
+  }
+
+  auto reader = PartialResultSetSource::Create(std::move(grpc_reader), {}, 2);
+  ASSERT_STATUS_OK(reader);
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(MakeTestRow({{"UserId", spanner::Value(10)}})));
+  auto batch = (*reader)->NextBatch(8);
+  ASSERT_STATUS_OK(batch);
+  ASSERT_EQ(1U, batch->num_rows());
+  EXPECT_EQ(22, *batch->get<std::int64_t>(0, 0));
+
+  // After `max_rows` the stream ends, even though more rows are available.
+  auto row = (*reader)->NextRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ(0U, row->size());
+  batch = (*reader)->NextBatch(8);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(0U, batch->num_rows());
+}
+
+/// @test Verify `Cancel()` stops the stream and discards the buffered rows.
+TEST(PartialResultSetSourceTest, Cancel) {
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+      }
+    }
+    values: { string_value: "10" }
+    values: { string_value: "22" }
+  )pb";
+  spanner_proto::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*grpc_reader, Read()).WillOnce(Return(response));
+    EXPECT_CALL(*grpc_reader, TryCancel()).Times(1);
+    EXPECT_CALL(*grpc_reader, Finish())
+        .WillOnce(Return(Status(StatusCode::kCancelled, "cancelled")));
+  }
+
+  auto reader = PartialResultSetSource::Create(std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+  EXPECT_THAT((*reader)->NextRow(),
+              IsValidAndEquals(MakeTestRow({{"UserId", spanner::Value(10)}})));
+  (*reader)->Cancel();
+  // The metadata is still available, and the stream has no more rows.
+  EXPECT_TRUE((*reader)->Metadata().has_value());
+  auto row = (*reader)->NextRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ(0U, row->size());
+  // Cancelling twice, or destroying the source, does not finish the RPC again.
+  (*reader)->Cancel();
+}
+
+/// @test Verify `StreamOf()` decodes the values without creating rows.
+TEST(PartialResultSetSourceTest, StreamOf) {
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+        fields: {
+          name: "UserName",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { string_value: "10" }
+    values: { string_value: "user10" }
+    values: { string_value: "22" }
+    values: { null_value: NULL_VALUE }
+  )pb";
+  spanner_proto::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  EXPECT_CALL(*grpc_reader, Read())
+      .WillOnce(Return(response))
+      .WillOnce(Return(absl::optional<spanner_proto::PartialResultSet>{}));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(Return(Status()));
+
+  auto reader = PartialResultSetSource::Create(std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+  spanner::RowStream rows(*std::move(reader));
+
+  using RowType = std::tuple<std::int64_t, absl::optional<std::string>>;
+  std::vector<RowType> actual;
+  for (auto& row : spanner::StreamOf<RowType>(rows)) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(*std::move(row));
+  }
+  EXPECT_THAT(actual,
+              ElementsAre(RowType(10, "user10"),
+                          RowType(22, absl::optional<std::string>())));
+}
+
 /**
  * @test Verify the behavior when a response with no values is received.
  */
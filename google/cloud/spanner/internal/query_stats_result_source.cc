@@ -0,0 +1,54 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/internal/query_stats_result_source.h"
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+StatusOr<spanner::Row> QueryStatsResultSource::NextRow() {
+  auto row = child_->NextRow();
+  if (row && row->size() == 0) OnEndOfStream();
+  return row;
+}
+
+StatusOr<spanner::ColumnBatch> QueryStatsResultSource::NextBatch(
+    std::size_t max_rows) {
+  auto batch = child_->NextBatch(max_rows);
+  if (batch && batch->num_rows() == 0) OnEndOfStream();
+  return batch;
+}
+
+Status QueryStatsResultSource::NextRowValues(
+    std::vector<google::protobuf::Value>& values) {
+  auto status = child_->NextRowValues(values);
+  if (status.ok() && values.empty()) OnEndOfStream();
+  return status;
+}
+
+void QueryStatsResultSource::OnEndOfStream() {
+  if (recorded_) return;
+  recorded_ = true;
+  auto stats = child_->Stats();
+  if (!stats || !stats->has_query_stats()) return;
+  sampler_->Record(sql_, *stats);
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
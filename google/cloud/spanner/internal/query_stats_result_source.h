@@ -0,0 +1,76 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_QUERY_STATS_RESULT_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_QUERY_STATS_RESULT_SOURCE_H
+
+#include "google/cloud/spanner/query_stats_sampler.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/version.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Records the stats of a profiled query in a `QueryStatsSampler`.
+ *
+ * The stats are recorded once the wrapped source reaches end-of-stream. Errors
+ * and streams that are not fully read are not recorded.
+ */
+class QueryStatsResultSource : public ResultSourceInterface {
+ public:
+  QueryStatsResultSource(std::unique_ptr<ResultSourceInterface> child,
+                         std::shared_ptr<spanner::QueryStatsSampler> sampler,
+                         std::string sql)
+      : child_(std::move(child)),
+        sampler_(std::move(sampler)),
+        sql_(std::move(sql)) {}
+  ~QueryStatsResultSource() override = default;
+
+  StatusOr<spanner::Row> NextRow() override;
+  StatusOr<spanner::ColumnBatch> NextBatch(std::size_t max_rows) override;
+  std::vector<std::shared_ptr<google::spanner::v1::Type const>> ColumnTypes()
+      override {
+    return child_->ColumnTypes();
+  }
+  Status NextRowValues(std::vector<google::protobuf::Value>& values) override;
+  absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return child_->Metadata();
+  }
+  absl::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    return child_->Stats();
+  }
+  void Cancel() override { child_->Cancel(); }
+
+ private:
+  void OnEndOfStream();
+
+  std::unique_ptr<ResultSourceInterface> child_;
+  std::shared_ptr<spanner::QueryStatsSampler> sampler_;
+  std::string sql_;
+  bool recorded_ = false;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_QUERY_STATS_RESULT_SOURCE_H
@@ -0,0 +1,106 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/internal/query_stats_result_source.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner::MakeTestRow;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+
+google::spanner::v1::ResultSetStats MakeStats() {
+  auto constexpr kText = R"pb(
+    query_stats {
+      fields {
+        key: "elapsed_time"
+        value { string_value: "1 msecs" }
+      }
+      fields {
+        key: "rows_returned"
+        value { string_value: "1" }
+      }
+    }
+  )pb";
+  google::spanner::v1::ResultSetStats stats;
+  EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(kText, &stats));
+  return stats;
+}
+
+TEST(QueryStatsResultSource, RecordsAtEndOfStream) {
+  auto mock = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*mock, NextRow)
+      .WillOnce(Return(MakeTestRow({{"c", spanner::Value(1)}})))
+      .WillOnce(Return(spanner::Row()))
+      .WillOnce(Return(spanner::Row()));
+  EXPECT_CALL(*mock, Stats).WillOnce(Return(MakeStats()));
+  auto sampler = std::make_shared<spanner::QueryStatsSampler>(1.0);
+
+  QueryStatsResultSource source(std::move(mock), sampler, "SELECT 1");
+  auto row = source.NextRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ(1, row->size());
+  EXPECT_TRUE(sampler->Snapshot().empty());
+  ASSERT_STATUS_OK(source.NextRow());
+  // Reading past the end-of-stream does not record the stats again.
+  ASSERT_STATUS_OK(source.NextRow());
+
+  auto const snapshot = sampler->Snapshot();
+  ASSERT_EQ(1, snapshot.size());
+  EXPECT_EQ("SELECT ?", snapshot[0].fingerprint);
+  EXPECT_EQ(1, snapshot[0].samples);
+  EXPECT_EQ(std::chrono::microseconds(1000), snapshot[0].elapsed_time);
+  EXPECT_EQ(1, snapshot[0].rows_returned);
+}
+
+TEST(QueryStatsResultSource, ErrorsAreNotRecorded) {
+  auto mock = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*mock, NextRow)
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+  EXPECT_CALL(*mock, Stats).Times(0);
+  auto sampler = std::make_shared<spanner::QueryStatsSampler>(1.0);
+
+  QueryStatsResultSource source(std::move(mock), sampler, "SELECT 1");
+  EXPECT_THAT(source.NextRow(), StatusIs(StatusCode::kUnavailable));
+  EXPECT_TRUE(sampler->Snapshot().empty());
+}
+
+TEST(QueryStatsResultSource, MissingStats) {
+  auto mock = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*mock, NextRow).WillOnce(Return(spanner::Row()));
+  EXPECT_CALL(*mock, Stats)
+      .WillOnce(Return(absl::optional<google::spanner::v1::ResultSetStats>{}));
+  auto sampler = std::make_shared<spanner::QueryStatsSampler>(1.0);
+
+  QueryStatsResultSource source(std::move(mock), sampler, "SELECT 1");
+  ASSERT_STATUS_OK(source.NextRow());
+  EXPECT_TRUE(sampler->Snapshot().empty());
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,98 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/internal/read_ahead_result_set_reader.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+ReadAheadResultSetReader::ReadAheadResultSetReader(
+    std::unique_ptr<PartialResultSetReader> child, std::size_t max_responses,
+    std::shared_ptr<MemoryAccount> memory_account)
+    : child_(std::move(child)),
+      max_responses_((std::max)(max_responses, std::size_t{1})),
+      memory_(std::move(memory_account)),
+      thread_([this] { Run(); }) {}
+
+ReadAheadResultSetReader::~ReadAheadResultSetReader() {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const done = done_;
+  lk.unlock();
+  // The background thread may be blocked reading from the stream.
+  if (!done) TryCancel();
+  thread_.join();
+}
+
+void ReadAheadResultSetReader::TryCancel() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    cancelled_ = true;
+  }
+  cv_.notify_all();
+  child_->TryCancel();
+}
+
+absl::optional<google::spanner::v1::PartialResultSet>
+ReadAheadResultSetReader::Read() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return !buffer_.empty() || done_; });
+  if (buffer_.empty()) return {};
+  auto response = std::move(buffer_.front().response);
+  memory_.Add(-buffer_.front().bytes);
+  buffer_.pop_front();
+  lk.unlock();
+  cv_.notify_all();
+  return response;
+}
+
+Status ReadAheadResultSetReader::Finish() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return done_; });
+  return status_;
+}
+
+void ReadAheadResultSetReader::Run() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk, [this] { return cancelled_ || HasRoom(); });
+      if (cancelled_) break;
+    }
+    auto response = child_->Read();
+    if (!response) break;
+    auto const bytes = static_cast<std::int64_t>(response->ByteSizeLong());
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      buffer_.push_back(Buffered{std::move(*response), bytes});
+      memory_.Add(bytes);
+    }
+    cv_.notify_all();
+  }
+  auto status = child_->Finish();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    status_ = std::move(status);
+    done_ = true;
+  }
+  cv_.notify_all();
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,100 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_READ_AHEAD_RESULT_SET_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_READ_AHEAD_RESULT_SET_READER_H
+
+#include "google/cloud/spanner/internal/partial_result_set_reader.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/memory_accountant.h"
+#include "google/cloud/status.h"
+#include "absl/types/optional.h"
+#include <google/spanner/v1/spanner.pb.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * A PartialResultSetReader that reads ahead of its caller.
+ *
+ * A background thread reads the responses from @p child, and keeps at most
+ * @p max_responses of them until the caller reads them. This overlaps the
+ * network reads with the work the application does for each row.
+ *
+ * The resume token handling is not affected. When @p child is a
+ * `PartialResultSetResume` it resumes the stream with the token of the last
+ * response it received, and all the responses it received are either in the
+ * buffer or already returned to the caller.
+ *
+ * The `TryCancel()` member function of @p child must be safe to call while
+ * another thread is blocked in `Read()`.
+ *
+ * The buffered responses are reported to @p memory_account, if set. While its
+ * accountant is over the soft limit the reader stops reading ahead, it only
+ * reads a response when the buffer is empty.
+ */
+class ReadAheadResultSetReader : public PartialResultSetReader {
+ public:
+  ReadAheadResultSetReader(
+      std::unique_ptr<PartialResultSetReader> child, std::size_t max_responses,
+      std::shared_ptr<MemoryAccount> memory_account = {});
+  ~ReadAheadResultSetReader() override;
+
+  void TryCancel() override;
+  absl::optional<google::spanner::v1::PartialResultSet> Read() override;
+  Status Finish() override;
+
+ private:
+  void Run();
+  bool HasRoom() const {
+    if (buffer_.size() >= max_responses_) return false;
+    return buffer_.empty() || !memory_.OverSoftLimit();
+  }
+
+  struct Buffered {
+    google::spanner::v1::PartialResultSet response;
+    std::int64_t bytes;
+  };
+
+  std::unique_ptr<PartialResultSetReader> child_;
+  std::size_t const max_responses_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Buffered> buffer_;
+  google::cloud::internal::MemoryReservation memory_;
+  bool cancelled_ = false;
+  // Set once `child_` has no more responses, `status_` is its final status.
+  bool done_ = false;
+  Status status_;
+  // Declared last, the thread uses all the other members.
+  std::thread thread_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_READ_AHEAD_RESULT_SET_READER_H
@@ -0,0 +1,156 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/internal/read_ahead_result_set_reader.h"
+#include "google/cloud/spanner/testing/mock_partial_result_set_reader.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+using ::google::cloud::spanner_testing::MockPartialResultSetReader;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+
+using ReadReturn = absl::optional<spanner_proto::PartialResultSet>;
+
+ReadReturn MakeResponse(std::string const& token) {
+  spanner_proto::PartialResultSet response;
+  response.set_resume_token(token);
+  return response;
+}
+
+TEST(ReadAheadResultSetReader, ReadsAllResponses) {
+  auto mock = absl::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*mock, Read)
+      .WillOnce(Return(MakeResponse("t1")))
+      .WillOnce(Return(MakeResponse("t2")))
+      .WillOnce(Return(MakeResponse("t3")))
+      .WillOnce(Return(ReadReturn{}));
+  EXPECT_CALL(*mock, Finish).WillOnce(Return(Status()));
+  EXPECT_CALL(*mock, TryCancel).Times(0);
+
+  ReadAheadResultSetReader reader(std::move(mock), 2);
+  for (auto const* token : {"t1", "t2", "t3"}) {
+    auto response = reader.Read();
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(token, response->resume_token());
+  }
+  EXPECT_FALSE(reader.Read().has_value());
+  EXPECT_FALSE(reader.Read().has_value());
+  EXPECT_STATUS_OK(reader.Finish());
+}
+
+TEST(ReadAheadResultSetReader, ReturnsError) {
+  auto mock = absl::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*mock, Read)
+      .WillOnce(Return(MakeResponse("t1")))
+      .WillOnce(Return(ReadReturn{}));
+  EXPECT_CALL(*mock, Finish)
+      .WillOnce(Return(Status(StatusCode::kPermissionDenied, "uh-oh")));
+
+  ReadAheadResultSetReader reader(std::move(mock), 4);
+  auto response = reader.Read();
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ("t1", response->resume_token());
+  EXPECT_FALSE(reader.Read().has_value());
+  EXPECT_THAT(reader.Finish(),
+              StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+}
+
+TEST(ReadAheadResultSetReader, BoundedBuffer) {
+  std::atomic<int> reads{0};
+  auto mock = absl::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*mock, Read).WillRepeatedly([&reads] {
+    return MakeResponse("t" + std::to_string(++reads));
+  });
+  EXPECT_CALL(*mock, TryCancel).Times(1);
+  EXPECT_CALL(*mock, Finish)
+      .WillOnce(Return(Status(StatusCode::kCancelled, "cancelled")));
+
+  {
+    ReadAheadResultSetReader reader(std::move(mock), 2);
+    auto response = reader.Read();
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ("t1", response->resume_token());
+    // One response was consumed, so at most 3 were read from the stream.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_LE(reads.load(), 3);
+    // The destructor cancels the stream and stops reading.
+  }
+  EXPECT_LE(reads.load(), 3);
+}
+
+TEST(ReadAheadResultSetReader, MemorySoftLimit) {
+  std::atomic<int> reads{0};
+  auto mock = absl::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*mock, Read).WillRepeatedly([&reads] {
+    return MakeResponse("t" + std::to_string(++reads));
+  });
+  EXPECT_CALL(*mock, TryCancel).Times(1);
+  EXPECT_CALL(*mock, Finish)
+      .WillOnce(Return(Status(StatusCode::kCancelled, "cancelled")));
+
+  auto accountant = std::make_shared<MemoryAccountant>(1);
+  {
+    ReadAheadResultSetReader reader(std::move(mock), 8,
+                                    accountant->CreateAccount("test"));
+    // Over the soft limit the reader only fills an empty buffer.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_LE(reads.load(), 1);
+    auto response = reader.Read();
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ("t1", response->resume_token());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_LE(reads.load(), 2);
+    EXPECT_LE(accountant->bytes(),
+              static_cast<std::int64_t>(MakeResponse("t2")->ByteSizeLong()));
+  }
+  EXPECT_EQ(0, accountant->bytes());
+}
+
+TEST(ReadAheadResultSetReader, TryCancel) {
+  auto mock = absl::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*mock, Read).WillRepeatedly(Return(MakeResponse("t")));
+  EXPECT_CALL(*mock, TryCancel).Times(1);
+  EXPECT_CALL(*mock, Finish)
+      .WillOnce(Return(Status(StatusCode::kCancelled, "cancelled")));
+
+  ReadAheadResultSetReader reader(std::move(mock), 1);
+  reader.TryCancel();
+  // Any buffered responses are still returned, then the stream ends.
+  int count = 0;
+  while (reader.Read().has_value()) ++count;
+  EXPECT_LE(count, 2);
+  EXPECT_THAT(reader.Finish(), StatusIs(StatusCode::kCancelled));
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
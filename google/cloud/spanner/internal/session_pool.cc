@@ -25,7 +25,6 @@
 #include <grpcpp/grpcpp.h>
 #include <algorithm>
 #include <chrono>
-#include <random>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -62,8 +61,9 @@ SessionPool::SessionPool(spanner::Database db,
       max_pool_size_(
           opts_.get<spanner::SessionPoolMaxSessionsPerChannelOption>() *
           static_cast<int>(stubs.size())),
-      random_generator_(std::random_device()()),
-      channels_(stubs.size()) {
+      low_watermark_(opts_.get<spanner::SessionPoolLowWatermarkOption>()),
+      channels_(stubs.size()),
+      shards_(stubs.size()) {
   if (stubs.empty()) {
     google::cloud::internal::ThrowInvalidArgument(
         "SessionPool requires a non-empty set of stubs");
@@ -79,8 +79,11 @@ SessionPool::SessionPool(spanner::Database db,
 void SessionPool::Initialize() {
   auto const min_sessions = opts_.get<spanner::SessionPoolMinSessionsOption>();
   if (min_sessions > 0) {
+    auto const wait = opts_.get<spanner::SessionPoolWaitForWarmupOption>()
+                          ? WaitForSessionAllocation::kWait
+                          : WaitForSessionAllocation::kNoWait;
     std::unique_lock<std::mutex> lk(mu_);
-    (void)Grow(lk, min_sessions, WaitForSessionAllocation::kWait);
+    (void)Grow(lk, min_sessions, wait);
   }
   ScheduleBackgroundWork(std::chrono::seconds(5));
 }
@@ -97,6 +100,11 @@ SessionPool::~SessionPool() {
   // must return `nullptr`, and the lambda will not do any work nor reschedule
   // the timer.
   current_timer_.cancel();
+
+  for (auto& w : async_waiters_) {
+    w.session.set_value(
+        Status(StatusCode::kCancelled, "session pool destroyed"));
+  }
 }
 
 void SessionPool::ScheduleBackgroundWork(std::chrono::seconds relative_time) {
@@ -126,7 +134,7 @@ void SessionPool::MaintainPoolSize() {
   std::unique_lock<std::mutex> lk(mu_);
   auto const min_sessions = opts_.get<spanner::SessionPoolMinSessionsOption>();
   if (create_calls_in_progress_ == 0 && total_sessions_ < min_sessions) {
-    Grow(lk, total_sessions_ - min_sessions, WaitForSessionAllocation::kNoWait);
+    Grow(lk, min_sessions - total_sessions_, WaitForSessionAllocation::kNoWait);
   }
 }
 
@@ -142,14 +150,17 @@ void SessionPool::RefreshExpiringSessions() {
     std::unique_lock<std::mutex> lk(mu_);
     if (last_use_time_lower_bound_ <= refresh_limit) {
       last_use_time_lower_bound_ = now;
-      for (auto const& session : sessions_) {
-        auto last_use_time = session->last_use_time();
-        if (last_use_time <= refresh_limit) {
-          sessions_to_refresh.emplace_back(session->channel()->stub,
-                                           session->session_name());
-          session->update_last_use_time();
-        } else if (last_use_time < last_use_time_lower_bound_) {
-          last_use_time_lower_bound_ = last_use_time;
+      for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> shard_lk(shard.mu);
+        for (auto const& session : shard.sessions) {
+          auto last_use_time = session->last_use_time();
+          if (last_use_time <= refresh_limit) {
+            sessions_to_refresh.emplace_back(session->channel()->stub,
+                                             session->session_name());
+            session->update_last_use_time();
+          } else if (last_use_time < last_use_time_lower_bound_) {
+            last_use_time_lower_bound_ = last_use_time;
+          }
         }
       }
     }
@@ -244,39 +255,55 @@ SessionPool::ComputeCreateCounts(int sessions_to_create) {
 Status SessionPool::CreateSessions(
     std::vector<CreateCount> const& create_counts,
     WaitForSessionAllocation wait) {
-  Status return_status;
-  for (auto const& op : create_counts) {
-    auto const& labels = opts_.get<spanner::SessionPoolLabelsOption>();
-    switch (wait) {
-      case WaitForSessionAllocation::kWait: {
-        auto status = CreateSessionsSync(op.channel, labels, op.session_count);
-        if (!status.ok()) {
-          return_status = status;
-        }
-        break;
-      }
-      case WaitForSessionAllocation::kNoWait:
-        CreateSessionsAsync(op.channel, labels, op.session_count);
-        break;
+  auto const& labels = opts_.get<spanner::SessionPoolLabelsOption>();
+  if (wait == WaitForSessionAllocation::kNoWait) {
+    for (auto const& op : create_counts) {
+      CreateSessionsAsync(op.channel, labels, op.session_count);
     }
+    return Status();
+  }
+
+  // Make the calls on all the channels concurrently, so the caller waits for
+  // the slowest call instead of the sum of all of them. This thread makes the
+  // first call.
+  std::vector<Status> statuses(create_counts.size());
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < create_counts.size(); ++i) {
+    threads.emplace_back([this, &create_counts, &labels, &statuses, i] {
+      statuses[i] = CreateSessionsSync(create_counts[i].channel, labels,
+                                       create_counts[i].session_count);
+    });
+  }
+  if (!create_counts.empty()) {
+    statuses[0] = CreateSessionsSync(create_counts[0].channel, labels,
+                                     create_counts[0].session_count);
+  }
+  for (auto& t : threads) t.join();
+
+  Status return_status;
+  for (auto& status : statuses) {
+    if (!status.ok()) return_status = std::move(status);
   }
   return return_status;
 }
 
 StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
+  // The fast path, a free session is available and `mu_` is not needed.
+  if (auto session = TryPopSession()) {
+    ++allocations_;
+    MaybeGrowAhead();
+    return {MakeSessionHolder(std::move(session), dissociate_from_pool)};
+  }
+
+  auto const start = clock_->Now();
+  bool waited = false;
   std::unique_lock<std::mutex> lk(mu_);
   for (;;) {
-    if (!sessions_.empty()) {
-      // return the most recently used session.
-      auto session = std::move(sessions_.back());
-      sessions_.pop_back();
-      if (dissociate_from_pool) {
-        --total_sessions_;
-        auto const& channel = session->channel();
-        if (channel) {
-          --channel->session_count;
-        }
-      }
+    if (auto session = TryPopSession()) {
+      lk.unlock();
+      ++allocations_;
+      if (waited) RecordAllocationWait(start);
+      MaybeGrowAhead();
       return {MakeSessionHolder(std::move(session), dissociate_from_pool)};
     }
 
@@ -285,10 +312,12 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
     if (total_sessions_ >= max_pool_size_) {
       if (opts_.get<spanner::SessionPoolActionOnExhaustionOption>() ==
           spanner::ActionOnExhaustion::kFail) {
+        ++allocations_exhausted_;
         return Status(StatusCode::kResourceExhausted, "session pool exhausted");
       }
+      waited = true;
       Wait(lk, [this] {
-        return !sessions_.empty() || total_sessions_ < max_pool_size_;
+        return free_sessions_.load() > 0 || total_sessions_ < max_pool_size_;
       });
       continue;
     }
@@ -300,8 +329,9 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
     // simultaneous calls if additional sessions are needed. We can also use the
     // number of waiters in the `sessions_to_create` calculation below.
     if (create_calls_in_progress_ > 0) {
+      waited = true;
       Wait(lk, [this] {
-        return !sessions_.empty() || create_calls_in_progress_ == 0;
+        return free_sessions_.load() > 0 || create_calls_in_progress_ == 0;
       });
       continue;
     }
@@ -310,6 +340,7 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
     // one for the `Session` this caller is waiting for.
     auto const min_sessions =
         opts_.get<spanner::SessionPoolMinSessionsOption>();
+    waited = true;
     auto status = Grow(lk, min_sessions + 1, WaitForSessionAllocation::kWait);
     if (!status.ok()) {
       return status;
@@ -317,6 +348,150 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
   }
 }
 
+future<StatusOr<SessionHolder>> SessionPool::AsyncAllocate(
+    bool dissociate_from_pool) {
+  auto session = TryPopSession();
+  if (session) {
+    ++allocations_;
+    MaybeGrowAhead();
+    return make_ready_future(StatusOr<SessionHolder>(
+        MakeSessionHolder(std::move(session), dissociate_from_pool)));
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  if (total_sessions_ >= max_pool_size_ &&
+      opts_.get<spanner::SessionPoolActionOnExhaustionOption>() ==
+          spanner::ActionOnExhaustion::kFail) {
+    ++allocations_exhausted_;
+    return make_ready_future(StatusOr<SessionHolder>(
+        Status(StatusCode::kResourceExhausted, "session pool exhausted")));
+  }
+
+  // Wait for a `Session` to be released, or created by the call below.
+  async_waiters_.push_back(AsyncWaiter{dissociate_from_pool,
+                                       promise<StatusOr<SessionHolder>>{},
+                                       clock_->Now()});
+  ++num_waiting_for_session_;
+  auto f = async_waiters_.back().session.get_future();
+  if (free_sessions_.load() > 0) {
+    // A session was released before `Release()` could see this waiter.
+    ServeAsyncWaiters(lk, Status());
+  } else if (total_sessions_ < max_pool_size_ &&
+             create_calls_in_progress_ == 0) {
+    auto const min_sessions =
+        opts_.get<spanner::SessionPoolMinSessionsOption>();
+    auto status = Grow(lk, min_sessions + 1, WaitForSessionAllocation::kNoWait);
+    if (!status.ok()) ServeAsyncWaiters(lk, status);
+  }
+  return f;
+}
+
+void SessionPool::MaybeGrowAhead() {
+  if (low_watermark_ == 0 || free_sessions_.load() >= low_watermark_) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  // Callers that find the pool empty wait for the calls in progress, there is
+  // no need to start more.
+  if (create_calls_in_progress_ > 0 || total_sessions_ >= max_pool_size_ ||
+      free_sessions_.load() >= low_watermark_) {
+    return;
+  }
+  (void)Grow(lk, low_watermark_, WaitForSessionAllocation::kNoWait);
+}
+
+std::unique_ptr<Session> SessionPool::TryPopSession() {
+  if (free_sessions_.load() == 0) return nullptr;
+  // Visit the shards in order of the load on their channels. Ties start at a
+  // different shard on each call, this spreads the callers across the shard
+  // mutexes. The loads are read once, they may change while sorting.
+  auto const n = shards_.size();
+  auto const first = next_shard_.fetch_add(1, std::memory_order_relaxed);
+  absl::FixedArray<std::pair<int, std::size_t>, 16> order(n);
+  for (std::size_t i = 0; i != n; ++i) {
+    auto const index = (first + i) % n;
+    order[i] = {channels_[index]->active_sessions.load(), index};
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [](std::pair<int, std::size_t> const& a,
+                      std::pair<int, std::size_t> const& b) {
+                     return a.first < b.first;
+                   });
+  for (auto const& o : order) {
+    auto& shard = shards_[o.second];
+    std::lock_guard<std::mutex> lk(shard.mu);
+    if (shard.sessions.empty()) continue;
+    // return the most recently used session.
+    auto session = std::move(shard.sessions.back());
+    shard.sessions.pop_back();
+    --free_sessions_;
+    return session;
+  }
+  return nullptr;
+}
+
+void SessionPool::PushSession(std::unique_ptr<Session> session) {
+  // Sessions in the pool always have a channel, see `CreateSessions()`.
+  auto const pos = std::find(channels_.begin(), channels_.end(),
+                             session->channel()) -
+                   channels_.begin();
+  auto& shard = shards_[static_cast<std::size_t>(pos) % shards_.size()];
+  std::lock_guard<std::mutex> lk(shard.mu);
+  shard.sessions.push_back(std::move(session));
+  ++free_sessions_;
+}
+
+void SessionPool::ServeAsyncWaiters(std::unique_lock<std::mutex>& lk,
+                                    Status const& status) {
+  std::vector<std::pair<AsyncWaiter, std::unique_ptr<Session>>> ready;
+  while (!async_waiters_.empty()) {
+    auto session = TryPopSession();
+    if (!session) break;
+    ready.emplace_back(std::move(async_waiters_.front()), std::move(session));
+    async_waiters_.pop_front();
+    --num_waiting_for_session_;
+  }
+  if (status.ok() && !async_waiters_.empty() &&
+      create_calls_in_progress_ == 0 && total_sessions_ < max_pool_size_) {
+    // The last batch of sessions was not enough for all the waiters.
+    (void)Grow(lk, static_cast<int>(async_waiters_.size()),
+               WaitForSessionAllocation::kNoWait);
+  }
+  std::deque<AsyncWaiter> failed;
+  if (!status.ok() && create_calls_in_progress_ == 0) {
+    failed.swap(async_waiters_);
+    num_waiting_for_session_ -= static_cast<int>(failed.size());
+  }
+  lk.unlock();
+  // The continuations may call back into the pool, do not hold the lock.
+  for (auto& r : ready) {
+    ++allocations_;
+    RecordAllocationWait(r.first.start);
+    r.first.session.set_value(
+        MakeSessionHolder(std::move(r.second), r.first.dissociate_from_pool));
+  }
+  for (auto& w : failed) w.session.set_value(status);
+}
+
+spanner::SessionPoolStats SessionPool::GetStats() {
+  spanner::SessionPoolStats stats;
+  stats.allocations = allocations_.load();
+  stats.allocation_waits = allocation_waits_.load();
+  stats.allocation_wait_time =
+      std::chrono::nanoseconds(allocation_wait_nanos_.load());
+  stats.allocations_exhausted = allocations_exhausted_.load();
+  stats.sessions_created = sessions_created_.load();
+  stats.session_create_failures = session_create_failures_.load();
+  stats.free_sessions = free_sessions_.load();
+  std::lock_guard<std::mutex> lk(mu_);
+  stats.total_sessions = total_sessions_;
+  return stats;
+}
+
+void SessionPool::RecordAllocationWait(Session::Clock::time_point start) {
+  auto const wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock_->Now() - start);
+  ++allocation_waits_;
+  allocation_wait_nanos_ += wait.count();
+}
+
 std::shared_ptr<SpannerStub> SessionPool::GetStub(Session const& session) {
   auto const& channel = session.channel();
   if (channel) {
@@ -335,10 +510,11 @@ std::shared_ptr<SpannerStub> SessionPool::GetStub(Session const& session) {
 }
 
 void SessionPool::Release(std::unique_ptr<Session> session) {
-  std::unique_lock<std::mutex> lk(mu_);
+  --session->channel()->active_sessions;
   if (session->is_bad()) {
     // Once we have support for background processing, we may want to signal
     // that to replenish this bad session.
+    std::lock_guard<std::mutex> lk(mu_);
     --total_sessions_;
     auto const& channel = session->channel();
     if (channel) {
@@ -347,11 +523,18 @@ void SessionPool::Release(std::unique_ptr<Session> session) {
     return;
   }
   session->update_last_use_time();
-  sessions_.push_back(std::move(session));
-  if (num_waiting_for_session_ > 0) {
-    lk.unlock();
-    cond_.notify_one();
+  PushSession(std::move(session));
+  // The waiters increment `num_waiting_for_session_` before they check
+  // `free_sessions_`, so either they find this session or we find them.
+  if (num_waiting_for_session_.load() == 0) return;
+
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!async_waiters_.empty()) {
+    ServeAsyncWaiters(lk, Status());
+    return;
   }
+  lk.unlock();
+  cond_.notify_one();
 }
 
 // Creates `num_sessions` on `channel` and adds them to the pool.
@@ -393,9 +576,19 @@ void SessionPool::CreateSessionsAsync(
 SessionHolder SessionPool::MakeSessionHolder(std::unique_ptr<Session> session,
                                              bool dissociate_from_pool) {
   if (dissociate_from_pool) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      --total_sessions_;
+      auto const& channel = session->channel();
+      if (channel) {
+        --channel->session_count;
+      }
+    }
     // Uses the default deleter; the `Session` is not returned to the pool.
     return {std::move(session)};
   }
+  // Sessions in the pool always have a channel, see `CreateSessions()`.
+  ++session->channel()->active_sessions;
   std::weak_ptr<SessionPool> pool = shared_from_this();
   return SessionHolder(session.release(), [pool](Session* s) {
     std::unique_ptr<Session> session(s);
@@ -466,22 +659,22 @@ Status SessionPool::HandleBatchCreateSessionsDone(
   std::unique_lock<std::mutex> lk(mu_);
   --create_calls_in_progress_;
   if (!response.ok()) {
+    ++session_create_failures_;
+    if (!async_waiters_.empty()) ServeAsyncWaiters(lk, response.status());
     return response.status();
   }
   // Add sessions to the pool and update counters for `channel` and the pool.
   auto const sessions_created = response->session_size();
   channel->session_count += sessions_created;
   total_sessions_ += sessions_created;
-  sessions_.reserve(sessions_.size() + sessions_created);
+  sessions_created_ += sessions_created;
   for (auto& session : *response->mutable_session()) {
-    sessions_.push_back(absl::make_unique<Session>(
-        std::move(*session.mutable_name()), channel, clock_));
+    PushSession(absl::make_unique<Session>(std::move(*session.mutable_name()),
+                                           channel, clock_));
   }
-  // Shuffle the pool so we distribute returned sessions across channels.
-  std::shuffle(sessions_.begin(), sessions_.end(), random_generator_);
 
   // Wake up anyone who was waiting for a `Session`.
-  lk.unlock();
+  ServeAsyncWaiters(lk, Status());
   cond_.notify_all();
   return Status();
 }
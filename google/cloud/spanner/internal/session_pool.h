@@ -22,6 +22,7 @@
 #include "google/cloud/spanner/internal/spanner_stub.h"
 #include "google/cloud/spanner/retry_policy.h"
 #include "google/cloud/spanner/session_pool_options.h"
+#include "google/cloud/spanner/session_pool_stats.h"
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/backoff_policy.h"
 #include "google/cloud/completion_queue.h"
@@ -29,13 +30,15 @@
 #include "google/cloud/status_or.h"
 #include "absl/container/fixed_array.h"
 #include <google/spanner/v1/spanner.pb.h>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -77,6 +80,17 @@ std::shared_ptr<SessionPool> MakeSessionPool(
  * Allocation from the pool is LIFO to take advantage of the fact the Spanner
  * backends maintain a cache of sessions which is valid for 30 seconds, so
  * re-using Sessions as quickly as possible has performance advantages.
+ *
+ * The free sessions are kept in one shard per channel, each with its own
+ * mutex. `Allocate()` prefers the shard whose channel has the fewest sessions
+ * allocated, as all the RPCs of a transaction use its session's channel, and
+ * takes from the other shards when that one is empty. `Release()` returns the
+ * session to the shard of its channel. Neither touches the pool-wide mutex
+ * unless the pool must grow, or some caller is waiting for a session.
+ *
+ * When the pool grows synchronously it calls `BatchCreateSessions` on all the
+ * channels concurrently. With `SessionPoolLowWatermarkOption` it also grows in
+ * the background, before the callers run out of free sessions.
  */
 class SessionPool : public std::enable_shared_from_this<SessionPool> {
  public:
@@ -95,11 +109,24 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
    */
   StatusOr<SessionHolder> Allocate(bool dissociate_from_pool = false);
 
+  /**
+   * Allocate a `Session` from the pool without blocking the calling thread.
+   *
+   * Behaves like `Allocate()`, but if no `Session` is available the returned
+   * future is satisfied once one is released to the pool or created by an
+   * asynchronous `BatchCreateSessions` call.
+   */
+  future<StatusOr<SessionHolder>> AsyncAllocate(
+      bool dissociate_from_pool = false);
+
   /**
    * Return a `SpannerStub` to be used when making calls using `session`.
    */
   std::shared_ptr<SpannerStub> GetStub(Session const& session);
 
+  /// Returns the counters describing the pool's behavior so far.
+  spanner::SessionPoolStats GetStats();
+
  private:
   friend std::shared_ptr<SessionPool> MakeSessionPool(
       spanner::Database, std::vector<std::shared_ptr<SpannerStub>>,
@@ -127,8 +154,39 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   // Release session back to the pool.
   void Release(std::unique_ptr<Session> session);
 
+  // The free sessions created on one channel.
+  struct Shard {
+    std::mutex mu;
+    std::vector<std::unique_ptr<Session>> sessions;  // GUARDED_BY(mu)
+  };
+
+  // Start creating `low_watermark_` sessions in the background if there are
+  // fewer free sessions than that, and no sessions are being created.
+  void MaybeGrowAhead();  // LOCKS_EXCLUDED(mu_)
+  void RecordAllocationWait(Session::Clock::time_point start);
+
+  // Remove the most recently used session from the shard of the least loaded
+  // channel that has one, or return nullptr if all the shards are empty.
+  std::unique_ptr<Session> TryPopSession();  // LOCKS_EXCLUDED(Shard::mu)
+  // Add `session` to the shard of its channel.
+  void PushSession(
+      std::unique_ptr<Session> session);  // LOCKS_EXCLUDED(Shard::mu)
+
+  // A caller of `AsyncAllocate()` waiting for a `Session`.
+  struct AsyncWaiter {
+    bool dissociate_from_pool;
+    promise<StatusOr<SessionHolder>> session;
+    Session::Clock::time_point start;  // when the caller started waiting
+  };
+  // Hand the available sessions to the async waiters, or fail the waiters with
+  // `status` if no more sessions are being created. Releases `lk`.
+  void ServeAsyncWaiters(std::unique_lock<std::mutex>& lk,
+                         Status const& status);
+
   // Called when a thread needs to wait for a `Session` to become available.
-  // @p specifies the condition to wait for.
+  // @p specifies the condition to wait for. `Release()` only notifies `cond_`
+  // if it sees `num_waiting_for_session_ > 0`, so the count is incremented
+  // before @p is first evaluated.
   template <typename Predicate>
   void Wait(std::unique_lock<std::mutex>& lk, Predicate&& p) {
     ++num_waiting_for_session_;
@@ -149,8 +207,9 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
                            std::map<std::string, std::string> const& labels,
                            int num_sessions);  // LOCKS_EXCLUDED(mu_)
 
-  SessionHolder MakeSessionHolder(std::unique_ptr<Session> session,
-                                  bool dissociate_from_pool);
+  SessionHolder MakeSessionHolder(
+      std::unique_ptr<Session> session,
+      bool dissociate_from_pool);  // LOCKS_EXCLUDED(mu_)
 
   friend struct SessionPoolFriendForTest;  // To test Async*()
   // Asynchronous calls used to maintain the pool.
@@ -182,26 +241,42 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   std::unique_ptr<spanner::BackoffPolicy const> backoff_policy_prototype_;
   std::shared_ptr<Session::Clock> clock_;
   int const max_pool_size_;
-  std::mt19937 random_generator_;
+  int const low_watermark_;
 
   std::mutex mu_;
   std::condition_variable cond_;
-  std::vector<std::unique_ptr<Session>> sessions_;  // GUARDED_BY(mu_)
-  int total_sessions_ = 0;                          // GUARDED_BY(mu_)
-  int create_calls_in_progress_ = 0;                // GUARDED_BY(mu_)
-  int num_waiting_for_session_ = 0;                 // GUARDED_BY(mu_)
+  int total_sessions_ = 0;                 // GUARDED_BY(mu_)
+  int create_calls_in_progress_ = 0;       // GUARDED_BY(mu_)
+  std::deque<AsyncWaiter> async_waiters_;  // GUARDED_BY(mu_)
+
+  // The number of sessions in all the shards, and of the callers blocked in
+  // `Allocate()` or queued in `async_waiters_`.
+  std::atomic<int> free_sessions_{0};
+  std::atomic<int> num_waiting_for_session_{0};
+  // Where the next `TryPopSession()` starts looking for a session.
+  std::atomic<std::size_t> next_shard_{0};
+
+  // Counters reported by `GetStats()`.
+  std::atomic<std::int64_t> allocations_{0};
+  std::atomic<std::int64_t> allocation_waits_{0};
+  std::atomic<std::int64_t> allocation_wait_nanos_{0};
+  std::atomic<std::int64_t> allocations_exhausted_{0};
+  std::atomic<std::int64_t> sessions_created_{0};
+  std::atomic<std::int64_t> session_create_failures_{0};
 
-  // Lower bound on all `sessions_[i]->last_use_time()` values.
+  // Lower bound on the `last_use_time()` of all the free sessions.
   Session::Clock::time_point last_use_time_lower_bound_ =
       clock_->Now();  // GUARDED_BY(mu_)
 
   future<void> current_timer_;
 
   // `channels_` is guaranteed to be non-empty and will not be resized after
-  // the constructor runs.
+  // the constructor runs. `shards_[i]` holds the free sessions created on
+  // `channels_[i]`.
   // n.b. `FixedArray` iterators are never invalidated.
   using ChannelVec = absl::FixedArray<std::shared_ptr<Channel>>;
-  ChannelVec channels_;                                 // GUARDED_BY(mu_)
+  ChannelVec channels_;
+  absl::FixedArray<Shard> shards_;
   ChannelVec::iterator next_dissociated_stub_channel_;  // GUARDED_BY(mu_)
 };
 
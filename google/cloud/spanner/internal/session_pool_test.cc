@@ -29,6 +29,7 @@
 #include <gmock/gmock.h>
 #include <grpcpp/grpcpp.h>
 #include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
@@ -46,6 +47,8 @@ using ::google::cloud::testing_util::MockAsyncResponseReader;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
 using ::testing::_;
+using ::testing::AnyOf;
+using ::testing::AtMost;
 using ::testing::ByMove;
 using ::testing::HasSubstr;
 using ::testing::Return;
@@ -283,6 +286,42 @@ TEST(SessionPool, MaxSessionsFailOnExhaustion) {
                                 "session pool exhausted"));
 }
 
+TEST(SessionPool, Stats) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions)
+      .WillOnce(Return(ByMove(Status(StatusCode::kInternal, "some failure"))))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1"}))));
+
+  Options opts;
+  opts.set<spanner::SessionPoolMaxSessionsPerChannelOption>(1);
+  opts.set<spanner::SessionPoolActionOnExhaustionOption>(
+      spanner::ActionOnExhaustion::kFail);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(db, {mock}, threads.cq(), std::move(opts));
+  EXPECT_THAT(pool->Allocate(), StatusIs(StatusCode::kInternal));
+
+  {
+    auto session = pool->Allocate();  // waits for s1 to be created
+    ASSERT_STATUS_OK(session);
+    EXPECT_THAT(pool->Allocate(), StatusIs(StatusCode::kResourceExhausted));
+    auto const stats = pool->GetStats();
+    EXPECT_EQ(1, stats.allocations);
+    EXPECT_EQ(1, stats.allocation_waits);
+    EXPECT_EQ(1, stats.allocations_exhausted);
+    EXPECT_EQ(1, stats.sessions_created);
+    EXPECT_EQ(1, stats.session_create_failures);
+    EXPECT_EQ(1, stats.total_sessions);
+    EXPECT_EQ(0, stats.free_sessions);
+  }
+
+  ASSERT_STATUS_OK(pool->Allocate());  // s1 is free, no need to wait
+  auto const stats = pool->GetStats();
+  EXPECT_EQ(2, stats.allocations);
+  EXPECT_EQ(1, stats.allocation_waits);
+  EXPECT_EQ(1, stats.free_sessions);
+}
+
 TEST(SessionPool, MaxSessionsBlockUntilRelease) {
   int const max_sessions_per_channel = 1;
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
@@ -393,6 +432,225 @@ TEST(SessionPool, MultipleChannelsPreAllocation) {
                                 "session pool exhausted"));
 }
 
+TEST(SessionPool, StealFromOtherChannels) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  // Only one of the channels creates a session, the other stays empty.
+  EXPECT_CALL(*mock1, BatchCreateSessions)
+      .Times(AtMost(1))
+      .WillRepeatedly(Return(MakeSessionsResponse({"c1s1"})));
+  EXPECT_CALL(*mock2, BatchCreateSessions)
+      .Times(AtMost(1))
+      .WillRepeatedly(Return(MakeSessionsResponse({"c2s1"})));
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(db, {mock1, mock2}, threads.cq());
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+  auto const name = (*session)->session_name();
+  session->reset();
+
+  // Each allocation starts at a different channel, all of them must find the
+  // one session in the pool.
+  for (int i = 0; i != 4; ++i) {
+    auto s = pool->Allocate();
+    ASSERT_STATUS_OK(s);
+    EXPECT_EQ(name, (*s)->session_name());
+  }
+}
+
+TEST(SessionPool, PrefersLeastLoadedChannel) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock1, BatchCreateSessions)
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c1s1", "c1s2"}))));
+  EXPECT_CALL(*mock2, BatchCreateSessions)
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c2s1", "c2s2"}))));
+
+  Options opts;
+  opts.set<spanner::SessionPoolMinSessionsOption>(4);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(db, {mock1, mock2}, threads.cq(),
+                                  std::move(opts));
+  auto channel_of = [](SessionHolder const& s) {
+    return s->session_name().substr(0, 2);
+  };
+
+  // Each allocation uses the channel with the fewest sessions in use.
+  auto s1 = pool->Allocate();
+  ASSERT_STATUS_OK(s1);
+  auto s2 = pool->Allocate();
+  ASSERT_STATUS_OK(s2);
+  EXPECT_NE(channel_of(*s1), channel_of(*s2));
+
+  // Release one of them, the next allocation must use its channel again.
+  auto const released = channel_of(*s1);
+  s1->reset();
+  auto s3 = pool->Allocate();
+  ASSERT_STATUS_OK(s3);
+  EXPECT_EQ(released, channel_of(*s3));
+}
+
+TEST(SessionPool, ConcurrentAllocateRelease) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock1, BatchCreateSessions)
+      .Times(AtMost(1))
+      .WillRepeatedly(Return(MakeSessionsResponse({"c1s1"})));
+  EXPECT_CALL(*mock2, BatchCreateSessions)
+      .Times(AtMost(1))
+      .WillRepeatedly(Return(MakeSessionsResponse({"c2s1"})));
+
+  Options opts;
+  opts.set<spanner::SessionPoolMaxSessionsPerChannelOption>(1);
+  opts.set<spanner::SessionPoolActionOnExhaustionOption>(
+      spanner::ActionOnExhaustion::kBlock);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool =
+      MakeTestSessionPool(db, {mock1, mock2}, threads.cq(), std::move(opts));
+
+  // More threads than sessions, so most allocations block until some other
+  // thread releases its session.
+  auto work = [&pool] {
+    for (int i = 0; i != 100; ++i) {
+      auto session = pool->Allocate();
+      ASSERT_STATUS_OK(session);
+      EXPECT_THAT((*session)->session_name(), AnyOf("c1s1", "c2s1"));
+    }
+  };
+  std::vector<std::thread> tasks;
+  for (int i = 0; i != 8; ++i) tasks.emplace_back(work);
+  for (auto& t : tasks) t.join();
+}
+
+TEST(SessionPool, WarmupUsesAllChannelsConcurrently) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  std::thread::id id1;
+  std::thread::id id2;
+  EXPECT_CALL(*mock1, BatchCreateSessions(_, SessionCountIs(2)))
+      .WillOnce([&id1](grpc::ClientContext&,
+                       spanner_proto::BatchCreateSessionsRequest const&) {
+        id1 = std::this_thread::get_id();
+        return MakeSessionsResponse({"c1s1", "c1s2"});
+      });
+  EXPECT_CALL(*mock2, BatchCreateSessions(_, SessionCountIs(2)))
+      .WillOnce([&id2](grpc::ClientContext&,
+                       spanner_proto::BatchCreateSessionsRequest const&) {
+        id2 = std::this_thread::get_id();
+        return MakeSessionsResponse({"c2s1", "c2s2"});
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(
+      db, {mock1, mock2}, threads.cq(),
+      Options{}.set<spanner::SessionPoolMinSessionsOption>(4));
+  EXPECT_NE(id1, id2);
+  std::vector<SessionHolder> sessions;
+  for (int i = 0; i != 4; ++i) {
+    auto session = pool->Allocate();
+    ASSERT_STATUS_OK(session);
+    sessions.push_back(*std::move(session));
+  }
+}
+
+TEST(SessionPool, WarmupWithoutWaiting) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  auto reader = absl::make_unique<StrictMock<
+      MockAsyncResponseReader<spanner_proto::BatchCreateSessionsResponse>>>();
+  EXPECT_CALL(*mock, AsyncBatchCreateSessions)
+      .WillOnce([&reader](
+                    grpc::ClientContext&,
+                    spanner_proto::BatchCreateSessionsRequest const& request,
+                    grpc::CompletionQueue*) {
+        EXPECT_EQ(2, request.session_count());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::BatchCreateSessionsResponse>>(reader.get());
+      });
+  EXPECT_CALL(*reader, Finish)
+      .WillOnce([](spanner_proto::BatchCreateSessionsResponse* response,
+                   grpc::Status* status, void*) {
+        *response = MakeSessionsResponse({"s1", "s2"});
+        *status = grpc::Status::OK;
+      });
+
+  auto db = spanner::Database("project", "instance", "database");
+  auto impl = std::make_shared<FakeCompletionQueueImpl>();
+  // The pool is created without waiting for `BatchCreateSessions`.
+  auto pool = MakeTestSessionPool(
+      db, {mock}, CompletionQueue(impl),
+      Options{}
+          .set<spanner::SessionPoolMinSessionsOption>(2)
+          .set<spanner::SessionPoolWaitForWarmupOption>(false));
+
+  // The allocation waits for the call in progress, it does not start another.
+  auto pending = pool->AsyncAllocate();
+  EXPECT_EQ(std::future_status::timeout,
+            pending.wait_for(std::chrono::milliseconds(0)));
+  impl->SimulateCompletion(true);
+  auto session = pending.get();
+  ASSERT_STATUS_OK(session);
+  EXPECT_THAT((*session)->session_name(), AnyOf("s1", "s2"));
+}
+
+TEST(SessionPool, LowWatermarkGrowsAhead) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  EXPECT_CALL(*mock, BatchCreateSessions(_, SessionCountIs(2)))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1", "s2"}))));
+  auto reader = absl::make_unique<StrictMock<
+      MockAsyncResponseReader<spanner_proto::BatchCreateSessionsResponse>>>();
+  EXPECT_CALL(*mock, AsyncBatchCreateSessions)
+      .WillOnce([&reader](
+                    grpc::ClientContext&,
+                    spanner_proto::BatchCreateSessionsRequest const& request,
+                    grpc::CompletionQueue*) {
+        EXPECT_EQ(2, request.session_count());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::BatchCreateSessionsResponse>>(reader.get());
+      });
+  EXPECT_CALL(*reader, Finish)
+      .WillOnce([](spanner_proto::BatchCreateSessionsResponse* response,
+                   grpc::Status* status, void*) {
+        *response = MakeSessionsResponse({"s3", "s4"});
+        *status = grpc::Status::OK;
+      });
+
+  auto db = spanner::Database("project", "instance", "database");
+  auto impl = std::make_shared<FakeCompletionQueueImpl>();
+  auto pool = MakeTestSessionPool(
+      db, {mock}, CompletionQueue(impl),
+      Options{}
+          .set<spanner::SessionPoolMinSessionsOption>(2)
+          .set<spanner::SessionPoolMaxSessionsPerChannelOption>(4)
+          .set<spanner::SessionPoolLowWatermarkOption>(2));
+
+  // This leaves one free session, so the pool starts creating two more.
+  auto s1 = pool->Allocate();
+  ASSERT_STATUS_OK(s1);
+  impl->SimulateCompletion(true);
+
+  // None of these allocations wait for a `BatchCreateSessions` call, and the
+  // pool does not grow beyond its maximum size.
+  std::vector<std::string> names{(*s1)->session_name()};
+  std::vector<SessionHolder> sessions;
+  for (int i = 0; i != 3; ++i) {
+    auto session = pool->AsyncAllocate();
+    ASSERT_EQ(std::future_status::ready,
+              session.wait_for(std::chrono::milliseconds(0)));
+    auto s = session.get();
+    ASSERT_STATUS_OK(s);
+    names.push_back((*s)->session_name());
+    sessions.push_back(*std::move(s));
+  }
+  EXPECT_THAT(names, UnorderedElementsAre("s1", "s2", "s3", "s4"));
+}
+
 TEST(SessionPool, GetStubForStublessSession) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = spanner::Database("project", "instance", "database");
@@ -403,6 +661,83 @@ TEST(SessionPool, GetStubForStublessSession) {
   EXPECT_EQ(pool->GetStub(*session), mock);
 }
 
+TEST(SessionPool, AsyncAllocateWaitsForRelease) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions)
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"session1"}))));
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(
+      db, {mock}, threads.cq(),
+      Options{}.set<spanner::SessionPoolMaxSessionsPerChannelOption>(1));
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+
+  // The pool is exhausted, so this is satisfied when "session1" is released.
+  auto pending = pool->AsyncAllocate();
+  EXPECT_EQ(std::future_status::timeout,
+            pending.wait_for(std::chrono::milliseconds(0)));
+  session->reset();
+  auto session2 = pending.get();
+  ASSERT_STATUS_OK(session2);
+  EXPECT_EQ("session1", (*session2)->session_name());
+}
+
+TEST(SessionPool, AsyncAllocateCreatesSessions) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  auto reader = absl::make_unique<StrictMock<
+      MockAsyncResponseReader<spanner_proto::BatchCreateSessionsResponse>>>();
+  EXPECT_CALL(*mock, AsyncBatchCreateSessions)
+      .WillOnce([&reader](
+                    grpc::ClientContext&,
+                    spanner_proto::BatchCreateSessionsRequest const& request,
+                    grpc::CompletionQueue*) {
+        EXPECT_EQ(1, request.session_count());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::BatchCreateSessionsResponse>>(reader.get());
+      });
+  EXPECT_CALL(*reader, Finish)
+      .WillOnce([](spanner_proto::BatchCreateSessionsResponse* response,
+                   grpc::Status* status, void*) {
+        *response = MakeSessionsResponse({"session1"});
+        *status = grpc::Status::OK;
+      });
+
+  auto db = spanner::Database("project", "instance", "database");
+  auto impl = std::make_shared<FakeCompletionQueueImpl>();
+  auto pool = MakeTestSessionPool(db, {mock}, CompletionQueue(impl));
+
+  // No thread blocks waiting for the `BatchCreateSessions` call.
+  auto pending = pool->AsyncAllocate();
+  EXPECT_EQ(std::future_status::timeout,
+            pending.wait_for(std::chrono::milliseconds(0)));
+  impl->SimulateCompletion(true);
+  auto session = pending.get();
+  ASSERT_STATUS_OK(session);
+  EXPECT_EQ("session1", (*session)->session_name());
+}
+
+TEST(SessionPool, AsyncAllocateExhaustedFails) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions)
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"session1"}))));
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(
+      db, {mock}, threads.cq(),
+      Options{}
+          .set<spanner::SessionPoolMaxSessionsPerChannelOption>(1)
+          .set<spanner::SessionPoolActionOnExhaustionOption>(
+              spanner::ActionOnExhaustion::kFail));
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+  EXPECT_THAT(pool->AsyncAllocate().get(),
+              StatusIs(StatusCode::kResourceExhausted));
+}
+
 TEST(SessionPool, SessionRefresh) {
   auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
   EXPECT_CALL(*mock, BatchCreateSessions)
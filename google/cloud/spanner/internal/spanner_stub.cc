@@ -15,7 +15,9 @@
 #include "google/cloud/spanner/internal/spanner_stub.h"
 #include "google/cloud/spanner/internal/logging_spanner_stub.h"
 #include "google/cloud/spanner/internal/metadata_spanner_stub.h"
+#include "google/cloud/spanner/internal/metrics_spanner_stub.h"
 #include "google/cloud/common_options.h"
+#include "google/cloud/grpc_channel_registry.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/algorithm.h"
@@ -86,12 +88,28 @@ class DefaultSpannerStub : public SpannerStub {
   std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
   StreamingRead(grpc::ClientContext& client_context,
                 spanner_proto::ReadRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+  AsyncRead(grpc::ClientContext& client_context,
+            spanner_proto::ReadRequest const& request,
+            grpc::CompletionQueue* cq) override;
   StatusOr<spanner_proto::Transaction> BeginTransaction(
       grpc::ClientContext& client_context,
       spanner_proto::BeginTransactionRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+  AsyncBeginTransaction(
+      grpc::ClientContext& client_context,
+      spanner_proto::BeginTransactionRequest const& request,
+      grpc::CompletionQueue* cq) override;
   StatusOr<spanner_proto::CommitResponse> Commit(
       grpc::ClientContext& client_context,
       spanner_proto::CommitRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+  AsyncCommit(grpc::ClientContext& client_context,
+              spanner_proto::CommitRequest const& request,
+              grpc::CompletionQueue* cq) override;
   Status Rollback(grpc::ClientContext& client_context,
                   spanner_proto::RollbackRequest const& request) override;
   StatusOr<spanner_proto::PartitionResponse> PartitionQuery(
@@ -228,6 +246,14 @@ DefaultSpannerStub::StreamingRead(grpc::ClientContext& client_context,
   return grpc_stub_->StreamingRead(&client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+DefaultSpannerStub::AsyncRead(grpc::ClientContext& client_context,
+                              spanner_proto::ReadRequest const& request,
+                              grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncRead(&client_context, request, cq);
+}
+
 StatusOr<spanner_proto::Transaction> DefaultSpannerStub::BeginTransaction(
     grpc::ClientContext& client_context,
     spanner_proto::BeginTransactionRequest const& request) {
@@ -240,6 +266,15 @@ StatusOr<spanner_proto::Transaction> DefaultSpannerStub::BeginTransaction(
   return response;
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+DefaultSpannerStub::AsyncBeginTransaction(
+    grpc::ClientContext& client_context,
+    spanner_proto::BeginTransactionRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncBeginTransaction(&client_context, request, cq);
+}
+
 StatusOr<spanner_proto::CommitResponse> DefaultSpannerStub::Commit(
     grpc::ClientContext& client_context,
     spanner_proto::CommitRequest const& request) {
@@ -252,6 +287,14 @@ StatusOr<spanner_proto::CommitResponse> DefaultSpannerStub::Commit(
   return response;
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+DefaultSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                spanner_proto::CommitRequest const& request,
+                                grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncCommit(&client_context, request, cq);
+}
+
 Status DefaultSpannerStub::Rollback(
     grpc::ClientContext& client_context,
     spanner_proto::RollbackRequest const& request) {
@@ -295,10 +338,13 @@ std::shared_ptr<SpannerStub> CreateDefaultSpannerStub(
   // its value here to allow compiling against older versions.
   channel_arguments.SetInt("grpc.channel_id", channel_id);
 
-  auto spanner_grpc_stub =
-      spanner_proto::Spanner::NewStub(grpc::CreateCustomChannel(
-          opts.get<EndpointOption>(), opts.get<GrpcCredentialOption>(),
-          channel_arguments));
+  // Clients sharing a `GrpcChannelRegistryOption` share their channels.
+  auto channel = internal::CreateSharedChannel(opts, channel_arguments, [&] {
+    return grpc::CreateCustomChannel(opts.get<EndpointOption>(),
+                                     opts.get<GrpcCredentialOption>(),
+                                     channel_arguments);
+  });
+  auto spanner_grpc_stub = spanner_proto::Spanner::NewStub(std::move(channel));
 
   std::shared_ptr<SpannerStub> stub =
       std::make_shared<DefaultSpannerStub>(std::move(spanner_grpc_stub));
@@ -306,9 +352,15 @@ std::shared_ptr<SpannerStub> CreateDefaultSpannerStub(
 
   if (internal::Contains(opts.get<TracingComponentsOption>(), "rpc")) {
     GCP_LOG(INFO) << "Enabled logging for gRPC calls";
-    return std::make_shared<LoggingSpannerStub>(
+    stub = std::make_shared<LoggingSpannerStub>(
         std::move(stub), opts.get<GrpcTracingOptionsOption>());
   }
+  // The metrics decorator is the outermost layer, so the resource accounting
+  // for each call includes the work done by all the other decorators.
+  if (opts.has<RpcMetricsOption>()) {
+    stub = std::make_shared<MetricsSpannerStub>(std::move(stub),
+                                                opts.get<RpcMetricsOption>());
+  }
   return stub;
 }
 
@@ -0,0 +1,62 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_STATUS_ONLY_RESULT_SET_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_STATUS_ONLY_RESULT_SET_SOURCE_H
+
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+/// A result source that returns @p status as its only "row".
+class StatusOnlyResultSetSource : public ResultSourceInterface {
+ public:
+  explicit StatusOnlyResultSetSource(google::cloud::Status status)
+      : status_(std::move(status)) {}
+  ~StatusOnlyResultSetSource() override = default;
+
+  StatusOr<spanner::Row> NextRow() override { return status_; }
+  absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return {};
+  }
+  absl::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    return {};
+  }
+
+ private:
+  google::cloud::Status status_;
+};
+
+// Helper function to build and wrap a `StatusOnlyResultSetSource`.
+template <typename ResultType>
+ResultType MakeStatusOnlyResult(Status status) {
+  return ResultType(
+      absl::make_unique<StatusOnlyResultSetSource>(std::move(status)));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_STATUS_ONLY_RESULT_SET_SOURCE_H
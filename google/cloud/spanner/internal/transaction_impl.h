@@ -19,12 +19,15 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/port_platform.h"
+#include "google/cloud/future.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/transaction.pb.h>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 
 namespace google {
 namespace cloud {
@@ -39,7 +42,7 @@ using VisitInvokeResult = ::google::cloud::internal::invoke_result_t<
 /**
  * The internal representation of a google::cloud::spanner::Transaction.
  */
-class TransactionImpl {
+class TransactionImpl : public std::enable_shared_from_this<TransactionImpl> {
  public:
   explicit TransactionImpl(google::spanner::v1::TransactionSelector selector)
       : TransactionImpl(/*session=*/{}, std::move(selector)) {}
@@ -99,41 +102,116 @@ class TransactionImpl {
     try {
 #endif
       auto r = f(session_, selector_, seqno);
-      bool done = false;
-      {
-        std::lock_guard<std::mutex> lock(mu_);
-        state_ =
-            selector_ && selector_->has_begin() ? State::kBegin : State::kDone;
-        done = (state_ == State::kDone);
-      }
-      if (done) {
-        cond_.notify_all();
-      } else {
-        cond_.notify_one();
-      }
+      EndPendingVisit(/*failed=*/false);
       return r;
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
     } catch (...) {
-      {
-        std::lock_guard<std::mutex> lock(mu_);
-        state_ = State::kBegin;
-      }
-      cond_.notify_one();
+      EndPendingVisit(/*failed=*/true);
       throw;
     }
 #endif
   }
 
+  // Like `Visit()`, but the functor returns a `future<T>`, and the visit ends
+  // when that future is satisfied. The calling thread never blocks: while
+  // another visitor is assigning the transaction ID the functor is queued,
+  // and it runs once that visitor ends.
+  //
+  // The object must be owned by a `std::shared_ptr`.
+  template <typename Functor>
+  VisitInvokeResult<Functor> AsyncVisit(Functor&& f) {
+    using Fn = typename std::decay<Functor>::type;
+    using ResultType = VisitInvokeResult<Functor>;
+    auto self = shared_from_this();
+    std::unique_lock<std::mutex> lock(mu_);
+    std::int64_t const seqno = ++seqno_;
+    if (state_ == State::kDone) {
+      lock.unlock();
+      return KeepAlive(f(session_, selector_, seqno));
+    }
+    if (state_ == State::kBegin) {
+      state_ = State::kPending;
+      lock.unlock();
+      return AsyncVisitPending(Fn(std::forward<Functor>(f)), seqno);
+    }
+    async_waiters_.emplace_back();
+    auto ready = async_waiters_.back().get_future();
+    lock.unlock();
+    Fn fn(std::forward<Functor>(f));
+    return ready.then([self, fn, seqno](future<bool> pending) mutable
+                      -> ResultType {
+      // The visitor was handed the pending state, or the ID was assigned.
+      if (pending.get()) return self->AsyncVisitPending(std::move(fn), seqno);
+      return self->KeepAlive(fn(self->session_, self->selector_, seqno));
+    });
+  }
+
  private:
   enum class State {
     kBegin,    // waiting for a future visitor to assign a transaction ID
     kPending,  // waiting for an active visitor to assign a transaction ID
     kDone,     // a transaction ID has been assigned (or we are single-use)
   };
+
+  // Run an async visitor that holds the pending state.
+  template <typename Functor>
+  VisitInvokeResult<Functor> AsyncVisitPending(Functor f, std::int64_t seqno) {
+    using ResultType = VisitInvokeResult<Functor>;
+    auto self = shared_from_this();
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+#endif
+      return f(session_, selector_, seqno)
+          .then([self](ResultType r) -> decltype(r.get()) {
+            self->EndPendingVisit(/*failed=*/false);
+            return r.get();
+          });
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    } catch (...) {
+      EndPendingVisit(/*failed=*/true);
+      throw;
+    }
+#endif
+  }
+
+  // The visitor may use the session and selector until @p f is satisfied.
+  template <typename T>
+  future<T> KeepAlive(future<T> f) {
+    auto self = shared_from_this();
+    return f.then([self](future<T> r) { return r.get(); });
+  }
+
+  // Leave the pending state, waking the visitors that were waiting for it.
+  // The next async visitor, if any, is handed the pending state directly.
+  void EndPendingVisit(bool failed) {
+    std::unique_lock<std::mutex> lock(mu_);
+    bool const done = !failed && !(selector_ && selector_->has_begin());
+    if (done) {
+      state_ = State::kDone;
+      auto waiters = std::move(async_waiters_);
+      async_waiters_.clear();
+      lock.unlock();
+      cond_.notify_all();
+      for (auto& w : waiters) w.set_value(false);
+      return;
+    }
+    if (!async_waiters_.empty()) {
+      auto w = std::move(async_waiters_.front());
+      async_waiters_.pop_front();
+      lock.unlock();
+      w.set_value(true);
+      return;
+    }
+    state_ = State::kBegin;
+    lock.unlock();
+    cond_.notify_one();
+  }
+
   State state_;
 
   std::mutex mu_;
   std::condition_variable cond_;
+  std::deque<promise<bool>> async_waiters_;
   SessionHolder session_;
   StatusOr<google::spanner::v1::TransactionSelector> selector_;
   std::int64_t seqno_;
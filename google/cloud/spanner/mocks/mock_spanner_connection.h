@@ -63,6 +63,14 @@ class MockConnection : public spanner::Connection {
   MOCK_METHOD(StatusOr<spanner::CommitResult>, Commit, (CommitParams),
               (override));
   MOCK_METHOD(Status, Rollback, (RollbackParams), (override));
+  MOCK_METHOD(future<StatusOr<spanner::RowStream>>, AsyncRead, (ReadParams),
+              (override));
+  MOCK_METHOD(future<StatusOr<spanner::RowStream>>, AsyncExecuteQuery,
+              (SqlParams), (override));
+  MOCK_METHOD(future<StatusOr<spanner::DmlResult>>, AsyncExecuteDml,
+              (SqlParams), (override));
+  MOCK_METHOD(future<StatusOr<spanner::CommitResult>>, AsyncCommit,
+              (CommitParams), (override));
 };
 
 /**
@@ -0,0 +1,158 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/mutation_batcher.h"
+#include "google/cloud/spanner/transaction.h"
+#include <algorithm>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+// Cloud Spanner doesn't accept more than this in a single commit.
+auto constexpr kSpannerMutationLimit = 20000;
+// Small enough to leave room for the indexes, which also count against the
+// limit.
+auto constexpr kDefaultMutationLimit = 5000;
+auto constexpr kDefaultMaxSizePerBatch = 4 * 1024 * 1024;
+auto constexpr kDefaultMaxBatches = 4;
+
+std::size_t MutationCount(google::spanner::v1::Mutation const& m) {
+  google::spanner::v1::Mutation::Write const* write = nullptr;
+  switch (m.operation_case()) {
+    case google::spanner::v1::Mutation::kInsert:
+      write = &m.insert();
+      break;
+    case google::spanner::v1::Mutation::kUpdate:
+      write = &m.update();
+      break;
+    case google::spanner::v1::Mutation::kInsertOrUpdate:
+      write = &m.insert_or_update();
+      break;
+    case google::spanner::v1::Mutation::kReplace:
+      write = &m.replace();
+      break;
+    case google::spanner::v1::Mutation::kDelete: {
+      auto const& keys = m.delete_().key_set();
+      if (keys.all()) return 1;
+      return static_cast<std::size_t>(
+          (std::max)(1, keys.keys_size() + keys.ranges_size()));
+    }
+    default:
+      return 1;
+  }
+  return static_cast<std::size_t>(
+      (std::max)(1, write->columns_size() * write->values_size()));
+}
+
+}  // namespace
+
+MutationBatcher::Options::Options()
+    : max_mutations_per_batch(kDefaultMutationLimit),
+      max_size_per_batch(kDefaultMaxSizePerBatch),
+      max_batches(kDefaultMaxBatches) {}
+
+MutationBatcher::Options& MutationBatcher::Options::SetMaxMutationsPerBatch(
+    std::size_t max_mutations_per_batch_arg) {
+  max_mutations_per_batch = std::min<std::size_t>(max_mutations_per_batch_arg,
+                                                  kSpannerMutationLimit);
+  return *this;
+}
+
+MutationBatcher::~MutationBatcher() { AsyncWaitForNoPendingRequests().get(); }
+
+future<StatusOr<CommitResult>> MutationBatcher::Apply(Mutation mutation) {
+  auto const& proto = spanner_internal::MutationProto(mutation);
+  auto const count = MutationCount(proto);
+  auto const size = proto.ByteSizeLong();
+
+  promise<StatusOr<CommitResult>> p;
+  auto f = p.get_future();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!current_.mutations.empty() &&
+      (current_.mutation_count + count > options_.max_mutations_per_batch ||
+       current_.size + size > options_.max_size_per_batch)) {
+    full_.push_back(std::move(current_));
+    current_ = Batch{};
+  }
+  current_.mutations.push_back(std::move(mutation));
+  current_.promises.push_back(std::move(p));
+  current_.mutation_count += count;
+  current_.size += size;
+  SendBatches(std::move(lk));
+  return f;
+}
+
+future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (outstanding_ == 0 && full_.empty() && current_.mutations.empty()) {
+    return make_ready_future();
+  }
+  no_more_pending_promises_.emplace_back();
+  return no_more_pending_promises_.back().get_future();
+}
+
+void MutationBatcher::SendBatches(std::unique_lock<std::mutex> lk) {
+  while (outstanding_ < options_.max_batches) {
+    Batch batch;
+    if (!full_.empty()) {
+      batch = std::move(full_.front());
+      full_.pop_front();
+    } else if (!current_.mutations.empty()) {
+      batch = std::move(current_);
+      current_ = Batch{};
+    } else {
+      break;
+    }
+    ++outstanding_;
+    // The commit may complete immediately, and `OnCommit()` needs the lock.
+    lk.unlock();
+    auto promises =
+        std::make_shared<std::vector<promise<StatusOr<CommitResult>>>>(
+            std::move(batch.promises));
+    client_
+        .AsyncCommit(MakeReadWriteTransaction(), std::move(batch.mutations),
+                     options_.commit_options)
+        .then([this, promises](future<StatusOr<CommitResult>> f) {
+          OnCommit(std::move(*promises), f.get());
+        });
+    lk.lock();
+  }
+
+  if (outstanding_ != 0 || !full_.empty() || !current_.mutations.empty()) {
+    return;
+  }
+  auto waiters = std::move(no_more_pending_promises_);
+  no_more_pending_promises_.clear();
+  lk.unlock();
+  for (auto& w : waiters) w.set_value();
+}
+
+void MutationBatcher::OnCommit(
+    std::vector<promise<StatusOr<CommitResult>>> promises,
+    StatusOr<CommitResult> const& result) {
+  for (auto& p : promises) p.set_value(result);
+  std::unique_lock<std::mutex> lk(mu_);
+  --outstanding_;
+  SendBatches(std::move(lk));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
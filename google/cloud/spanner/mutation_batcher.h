@@ -0,0 +1,174 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_MUTATION_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_MUTATION_BATCHER_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/commit_options.h"
+#include "google/cloud/spanner/commit_result.h"
+#include "google/cloud/spanner/mutations.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Packs mutations into commits, and keeps several commits in flight.
+ *
+ * Loading large amounts of data into Cloud Spanner is most efficient when
+ * the mutations are sent in batches, each batch in its own commit, with a few
+ * commits running concurrently. Create a `MutationBatcher` and call
+ * `MutationBatcher::Apply()` for each mutation, the batcher creates the
+ * batches, commits them with `Client::AsyncCommit()`, and reports the result
+ * of the commit to each mutation.
+ *
+ * A batch is committed as soon as fewer than `max_batches` commits are in
+ * flight, the batches grow while the commits are running. Each batch is
+ * committed in a separate read-write transaction, so mutations in different
+ * batches are not applied atomically, and are not applied in any particular
+ * order. Mutations that must be applied in order, such as an insert and a
+ * later update of the same row, should wait for the result of the first
+ * mutation.
+ *
+ * The batcher does not rerun failed commits, the error is reported to every
+ * mutation in the batch.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ */
+class MutationBatcher {
+ public:
+  /// Configuration for `MutationBatcher`.
+  struct Options {
+    Options();
+
+    /**
+     * A single commit will not have more mutations than this.
+     *
+     * Mutations are counted as Cloud Spanner does: each column of each row
+     * in an insert, update, insert-or-update, or replace counts as one
+     * mutation, each key and key range in a delete counts as one.
+     */
+    Options& SetMaxMutationsPerBatch(std::size_t max_mutations_per_batch_arg);
+
+    /// The sum of the mutation sizes in a single commit is not larger than
+    /// this, unless the batch has a single mutation.
+    Options& SetMaxSizePerBatch(std::size_t max_size_per_batch_arg) {
+      max_size_per_batch = max_size_per_batch_arg;
+      return *this;
+    }
+
+    /// There will be no more commits in flight than this.
+    Options& SetMaxBatches(std::size_t max_batches_arg) {
+      max_batches = max_batches_arg == 0 ? 1 : max_batches_arg;
+      return *this;
+    }
+
+    /// The options used for each commit.
+    Options& SetCommitOptions(CommitOptions commit_options_arg) {
+      commit_options = std::move(commit_options_arg);
+      return *this;
+    }
+
+    std::size_t max_mutations_per_batch;
+    std::size_t max_size_per_batch;
+    std::size_t max_batches;
+    CommitOptions commit_options;
+  };
+
+  explicit MutationBatcher(Client client, Options options = Options())
+      : client_(std::move(client)), options_(std::move(options)) {}
+
+  /// Waits until all the mutations are committed.
+  ~MutationBatcher();
+
+  MutationBatcher(MutationBatcher const&) = delete;
+  MutationBatcher& operator=(MutationBatcher const&) = delete;
+
+  /**
+   * Commits @p mutation, most likely in a batch with other mutations.
+   *
+   * The returned future is satisfied with the result of the commit that
+   * included @p mutation. Note that the batcher does not limit the number of
+   * mutations waiting for a commit, applications that generate mutations
+   * faster than they are committed should wait on the returned futures, or
+   * call `AsyncWaitForNoPendingRequests()` from time to time.
+   *
+   * @par Example
+   * @code
+   * spanner::MutationBatcher batcher(client);
+   * std::vector<future<StatusOr<spanner::CommitResult>>> results;
+   * for (auto const& singer : singers) {
+   *   results.push_back(batcher.Apply(spanner::MakeInsertMutation(
+   *       "Singers", {"SingerId", "FirstName"}, singer.id, singer.name)));
+   * }
+   * for (auto& r : results) {
+   *   auto result = r.get();
+   *   if (!result) throw std::runtime_error(result.status().message());
+   * }
+   * @endcode
+   */
+  future<StatusOr<CommitResult>> Apply(Mutation mutation);
+
+  /**
+   * Returns a future satisfied when all the mutations applied so far are
+   * committed.
+   *
+   * The future is satisfied when there are no pending mutations, mutations
+   * applied after this call may delay it.
+   */
+  future<void> AsyncWaitForNoPendingRequests();
+
+ private:
+  struct Batch {
+    Mutations mutations;
+    std::vector<promise<StatusOr<CommitResult>>> promises;
+    std::size_t mutation_count = 0;
+    std::size_t size = 0;
+  };
+
+  /// Commits the full batches, and then the current batch, while there are
+  /// fewer than `max_batches` commits in flight.
+  void SendBatches(std::unique_lock<std::mutex> lk);
+
+  /// Reports @p result to the mutations of a batch, and sends more batches.
+  void OnCommit(std::vector<promise<StatusOr<CommitResult>>> promises,
+                StatusOr<CommitResult> const& result);
+
+  Client client_;
+  Options const options_;
+
+  std::mutex mu_;
+  Batch current_;
+  std::deque<Batch> full_;
+  std::size_t outstanding_ = 0;
+  std::vector<promise<void>> no_more_pending_promises_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_MUTATION_BATCHER_H
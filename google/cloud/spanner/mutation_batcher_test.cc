@@ -0,0 +1,205 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/mutation_batcher.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+Mutation MakeTestMutation(std::int64_t id) {
+  return MakeInsertMutation("Singers", {"SingerId", "FirstName"}, id,
+                            "name-" + std::to_string(id));
+}
+
+CommitResult MakeCommitResult(std::int64_t seconds) {
+  return CommitResult{
+      MakeTimestamp(absl::FromUnixSeconds(seconds)).value(), {}};
+}
+
+// Keeps the commits pending until the test completes them.
+struct PendingCommits {
+  std::vector<std::size_t> sizes;
+  std::deque<promise<StatusOr<CommitResult>>> commits;
+
+  void Complete(StatusOr<CommitResult> result) {
+    auto p = std::move(commits.front());
+    commits.pop_front();
+    p.set_value(std::move(result));
+  }
+};
+
+void ExpectPendingCommits(MockConnection& conn, PendingCommits& pending) {
+  EXPECT_CALL(conn, AsyncCommit)
+      .WillRepeatedly([&pending](Connection::CommitParams const& params) {
+        pending.sizes.push_back(params.mutations.size());
+        pending.commits.emplace_back();
+        return pending.commits.back().get_future();
+      });
+}
+
+TEST(MutationBatcher, SingleMutation) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit)
+      .WillOnce([](Connection::CommitParams const& params) {
+        EXPECT_THAT(params.mutations, ElementsAre(MakeTestMutation(1)));
+        return make_ready_future(
+            StatusOr<CommitResult>(MakeCommitResult(1234)));
+      });
+
+  MutationBatcher batcher(Client(conn));
+  auto result = batcher.Apply(MakeTestMutation(1)).get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(MakeCommitResult(1234).commit_timestamp, result->commit_timestamp);
+}
+
+TEST(MutationBatcher, BatchesWhileCommitsAreInFlight) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingCommits pending;
+  ExpectPendingCommits(*conn, pending);
+
+  MutationBatcher batcher(Client(conn),
+                          MutationBatcher::Options{}.SetMaxBatches(1));
+  std::vector<future<StatusOr<CommitResult>>> results;
+  for (std::int64_t i = 0; i != 4; ++i) {
+    results.push_back(batcher.Apply(MakeTestMutation(i)));
+  }
+  EXPECT_THAT(pending.sizes, ElementsAre(1));
+
+  pending.Complete(MakeCommitResult(1));
+  EXPECT_THAT(pending.sizes, ElementsAre(1, 3));
+  pending.Complete(MakeCommitResult(2));
+
+  std::vector<std::int64_t> seconds;
+  for (auto& r : results) {
+    auto result = r.get();
+    ASSERT_STATUS_OK(result);
+    seconds.push_back(
+        absl::ToUnixSeconds(*result->commit_timestamp.get<absl::Time>()));
+  }
+  EXPECT_THAT(seconds, ElementsAre(1, 2, 2, 2));
+}
+
+TEST(MutationBatcher, MaxMutationsPerBatch) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingCommits pending;
+  ExpectPendingCommits(*conn, pending);
+
+  // Each test mutation counts as 2 mutations, one for each column.
+  MutationBatcher batcher(
+      Client(conn),
+      MutationBatcher::Options{}.SetMaxBatches(1).SetMaxMutationsPerBatch(4));
+  std::vector<future<StatusOr<CommitResult>>> results;
+  for (std::int64_t i = 0; i != 6; ++i) {
+    results.push_back(batcher.Apply(MakeTestMutation(i)));
+  }
+  while (!pending.commits.empty()) pending.Complete(MakeCommitResult(1));
+  EXPECT_THAT(pending.sizes, ElementsAre(1, 2, 2, 1));
+  for (auto& r : results) EXPECT_STATUS_OK(r.get());
+}
+
+TEST(MutationBatcher, MaxSizePerBatch) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingCommits pending;
+  ExpectPendingCommits(*conn, pending);
+
+  auto const size =
+      spanner_internal::MutationProto(MakeTestMutation(0)).ByteSizeLong();
+  MutationBatcher batcher(Client(conn), MutationBatcher::Options{}
+                                            .SetMaxBatches(1)
+                                            .SetMaxSizePerBatch(2 * size));
+  std::vector<future<StatusOr<CommitResult>>> results;
+  for (std::int64_t i = 0; i != 5; ++i) {
+    results.push_back(batcher.Apply(MakeTestMutation(i)));
+  }
+  while (!pending.commits.empty()) pending.Complete(MakeCommitResult(1));
+  EXPECT_THAT(pending.sizes, ElementsAre(1, 2, 2));
+  for (auto& r : results) EXPECT_STATUS_OK(r.get());
+}
+
+TEST(MutationBatcher, ConcurrentBatches) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingCommits pending;
+  ExpectPendingCommits(*conn, pending);
+
+  MutationBatcher batcher(Client(conn),
+                          MutationBatcher::Options{}.SetMaxBatches(3));
+  std::vector<future<StatusOr<CommitResult>>> results;
+  for (std::int64_t i = 0; i != 5; ++i) {
+    results.push_back(batcher.Apply(MakeTestMutation(i)));
+  }
+  EXPECT_THAT(pending.sizes, ElementsAre(1, 1, 1));
+  while (!pending.commits.empty()) pending.Complete(MakeCommitResult(1));
+  EXPECT_THAT(pending.sizes, ElementsAre(1, 1, 1, 2));
+  for (auto& r : results) EXPECT_STATUS_OK(r.get());
+}
+
+TEST(MutationBatcher, CommitFailure) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingCommits pending;
+  ExpectPendingCommits(*conn, pending);
+
+  MutationBatcher batcher(Client(conn),
+                          MutationBatcher::Options{}.SetMaxBatches(1));
+  auto r0 = batcher.Apply(MakeTestMutation(0));
+  auto r1 = batcher.Apply(MakeTestMutation(1));
+  auto r2 = batcher.Apply(MakeTestMutation(2));
+  pending.Complete(MakeCommitResult(1));
+  pending.Complete(Status(StatusCode::kAborted, "aborted"));
+
+  EXPECT_STATUS_OK(r0.get());
+  EXPECT_THAT(r1.get(), StatusIs(StatusCode::kAborted, "aborted"));
+  EXPECT_THAT(r2.get(), StatusIs(StatusCode::kAborted, "aborted"));
+}
+
+TEST(MutationBatcher, WaitForNoPendingRequests) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingCommits pending;
+  ExpectPendingCommits(*conn, pending);
+
+  MutationBatcher batcher(Client(conn),
+                          MutationBatcher::Options{}.SetMaxBatches(1));
+  auto idle = batcher.AsyncWaitForNoPendingRequests();
+  EXPECT_EQ(std::future_status::ready, idle.wait_for(std::chrono::seconds(0)));
+
+  batcher.Apply(MakeTestMutation(0));
+  batcher.Apply(MakeTestMutation(1));
+  idle = batcher.AsyncWaitForNoPendingRequests();
+  pending.Complete(MakeCommitResult(1));
+  EXPECT_EQ(std::future_status::timeout,
+            idle.wait_for(std::chrono::seconds(0)));
+  pending.Complete(MakeCommitResult(2));
+  EXPECT_EQ(std::future_status::ready, idle.wait_for(std::chrono::seconds(0)));
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
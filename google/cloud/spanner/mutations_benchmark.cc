@@ -0,0 +1,75 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/mutations.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+// Compares building a mutation row by row, with a `Value` for each cell, and
+// column by column, encoding the cells directly. Run with, for example:
+//   mutations_benchmark --benchmark_filter=BM_Insert
+struct Columns {
+  std::vector<std::int64_t> ids;
+  std::vector<std::string> names;
+  std::vector<double> scores;
+};
+
+Columns MakeColumns(std::size_t rows) {
+  Columns c;
+  for (std::size_t i = 0; i != rows; ++i) {
+    c.ids.push_back(static_cast<std::int64_t>(i));
+    c.names.push_back("name-" + std::to_string(i));
+    c.scores.push_back(static_cast<double>(i) / 2);
+  }
+  return c;
+}
+
+void BM_InsertAddRow(benchmark::State& state) {
+  auto const c = MakeColumns(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    InsertMutationBuilder builder("Table", {"Id", "Name", "Score"});
+    for (std::size_t i = 0; i != c.ids.size(); ++i) {
+      builder.AddRow({Value(c.ids[i]), Value(c.names[i]), Value(c.scores[i])});
+    }
+    benchmark::DoNotOptimize(std::move(builder).Build());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsertAddRow)->Range(1 << 6, 1 << 14);
+
+void BM_InsertAddColumns(benchmark::State& state) {
+  auto const c = MakeColumns(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        InsertMutationBuilder("Table", {"Id", "Name", "Score"})
+            .AddColumns(c.ids, c.names, c.scores)
+            .Build());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsertAddColumns)->Range(1 << 6, 1 << 14);
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
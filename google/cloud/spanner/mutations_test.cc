@@ -21,6 +21,7 @@
 #include <gmock/gmock.h>
 #include <cstdint>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -421,6 +422,44 @@ TEST(MutationsTest, FluentDeleteBuilder) {
   EXPECT_THAT(actual, IsProtoEqual(expected));
 }
 
+TEST(MutationsTest, AddColumns) {
+  std::vector<std::int64_t> const ids = {1, 2, 3};
+  std::vector<std::string> const names = {"a", "b", "c"};
+  std::vector<absl::optional<double>> const scores = {1.5, absl::nullopt, 3.5};
+
+  auto actual = InsertOrUpdateMutationBuilder("table-name",
+                                              {"Id", "Name", "Score"})
+                    .EmplaceRow(std::int64_t{0}, "z", 0.5)
+                    .AddColumns(ids, names, scores)
+                    .Build();
+  auto expected = InsertOrUpdateMutationBuilder("table-name",
+                                                {"Id", "Name", "Score"})
+                      .EmplaceRow(std::int64_t{0}, "z", 0.5);
+  for (std::size_t i = 0; i != ids.size(); ++i) {
+    expected.EmplaceRow(ids[i], names[i], scores[i]);
+  }
+  EXPECT_EQ(expected.Build(), actual);
+  EXPECT_EQ(4, actual.as_proto().insert_or_update().values_size());
+}
+
+TEST(MutationsTest, AddColumnsEmpty) {
+  auto m = InsertMutationBuilder("table-name", {"col_a"})
+               .AddColumns(std::vector<bool>{})
+               .Build();
+  EXPECT_EQ(0, m.as_proto().insert().values_size());
+}
+
+TEST(MutationsTest, AddColumnsMismatchedSizes) {
+  InsertMutationBuilder builder("table-name", {"col_a", "col_b"});
+  std::vector<std::int64_t> const a = {1, 2};
+  std::vector<std::string> const b = {"x"};
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(builder.AddColumns(a, b), std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(builder.AddColumns(a, b), "same size");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
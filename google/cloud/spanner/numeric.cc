@@ -16,10 +16,12 @@
 #include "google/cloud/status.h"
 #include "absl/strings/string_view.h"
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cerrno>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <iomanip>
 #include <limits>
@@ -231,6 +233,71 @@ StatusOr<spanner::Numeric> MakeNumeric(std::string s, int exponent) {
   return MakeNumeric(std::move(s));
 }
 
+// Formats `magnitude * 10^exponent` with the given sign without going
+// through `MakeNumeric(s)`, as that parses, shifts, and rounds the digits
+// one character at a time. Out-of-range values use `MakeNumeric(s, exponent)`
+// so that the errors are the same.
+StatusOr<spanner::Numeric> MakeNumeric(bool negative, absl::uint128 magnitude,
+                                       int exponent) {
+  auto const frac_prec = static_cast<int>(spanner::Numeric::kFracPrec);
+  auto m = magnitude;
+  auto e = exponent;
+
+  // Round to `kFracPrec` decimal places, with halfway cases rounding away
+  // from zero, then drop any trailing fractional zeros.
+  if (e < -frac_prec) {
+    auto const drop = -frac_prec - e;
+    if (drop > std::numeric_limits<absl::uint128>::digits10) {
+      m = 0;  // m < 10^drop / 2
+    } else {
+      absl::uint128 p = 1;
+      for (int i = 0; i != drop; ++i) p *= 10;
+      auto const r = m % p;
+      m /= p;
+      if (r >= p - r) ++m;
+    }
+    e = -frac_prec;
+  }
+  if (m == 0) return NumericInternals::Create("0");
+  for (; e < 0 && m % 10 == 0; ++e) m /= 10;
+
+  // The digits of `m`, formatted right to left.
+  std::array<char, std::numeric_limits<absl::uint128>::digits10 + 1> buf;
+  auto* const end = buf.data() + buf.size();
+  auto* p = end;
+  if (absl::Uint128High64(m) == 0) {
+    for (auto v = absl::Uint128Low64(m); v != 0; v /= 10) {
+      *--p = static_cast<char>('0' + v % 10);
+    }
+  } else {
+    for (auto v = m; v != 0; v /= 10) {
+      *--p = static_cast<char>('0' + absl::Uint128Low64(v % 10));
+    }
+  }
+  auto const digits = static_cast<std::int64_t>(end - p);
+  auto const int_digits = digits + e;
+  if (int_digits > static_cast<std::int64_t>(spanner::Numeric::kIntPrec)) {
+    return MakeNumeric((negative ? "-" : "") + ToString(magnitude), exponent);
+  }
+
+  std::string rep;
+  rep.reserve(spanner::Numeric::kIntPrec + spanner::Numeric::kFracPrec + 3);
+  if (negative) rep.push_back('-');
+  if (e >= 0) {
+    rep.append(p, end);
+    rep.append(e, '0');
+  } else if (int_digits <= 0) {
+    rep.append("0.");
+    rep.append(static_cast<std::size_t>(-int_digits), '0');
+    rep.append(p, end);
+  } else {
+    rep.append(p, p + int_digits);
+    rep.push_back('.');
+    rep.append(p + int_digits, end);
+  }
+  return NumericInternals::Create(std::move(rep));
+}
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
 
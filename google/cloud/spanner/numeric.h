@@ -38,6 +38,7 @@ class Numeric;  // defined below
 // Internal implementation details that callers should not use.
 namespace spanner_internal {
 inline namespace SPANNER_CLIENT_NS {
+struct NumericInternals;
 StatusOr<spanner::Numeric> MakeNumeric(std::string s);
 
 // Like `std::to_string`, but also supports Abseil 128-bit integers.
@@ -52,6 +53,11 @@ std::string ToString(absl::uint128 value);
 Status DataLoss(std::string message);
 StatusOr<spanner::Numeric> MakeNumeric(std::string s, int exponent);
 
+// Like `MakeNumeric(s, exponent)` with `s` the decimal representation of the
+// integer, but formats the canonical representation directly.
+StatusOr<spanner::Numeric> MakeNumeric(bool negative, absl::uint128 magnitude,
+                                       int exponent);
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
 
@@ -132,12 +138,40 @@ class Numeric {
   }
 
  private:
+  friend struct spanner_internal::SPANNER_CLIENT_NS::NumericInternals;
   friend StatusOr<Numeric> spanner_internal::SPANNER_CLIENT_NS::MakeNumeric(
       std::string s);
   explicit Numeric(std::string rep) : rep_(std::move(rep)) {}
   std::string rep_;  // a valid and canonical NUMERIC representation
 };
 
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+// Splits a signed or unsigned integer into its sign and magnitude.
+template <typename T>
+StatusOr<spanner::Numeric> MakeNumericFromInteger(T i, int exponent,
+                                                  std::true_type) {
+  auto const magnitude = absl::uint128(i);
+  if (i < 0) return MakeNumeric(true, -magnitude, exponent);
+  return MakeNumeric(false, magnitude, exponent);
+}
+
+template <typename T>
+StatusOr<spanner::Numeric> MakeNumericFromInteger(T u, int exponent,
+                                                  std::false_type) {
+  return MakeNumeric(false, absl::uint128(u), exponent);
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
 /**
  * Construction from a string, in decimal fixed- or floating-point formats.
  *
@@ -172,7 +206,9 @@ StatusOr<Numeric> MakeNumeric(double d);
 template <typename T, typename std::enable_if<
                           std::numeric_limits<T>::is_integer, int>::type = 0>
 StatusOr<Numeric> MakeNumeric(T i, int exponent = 0) {
-  return spanner_internal::MakeNumeric(spanner_internal::ToString(i), exponent);
+  return spanner_internal::MakeNumericFromInteger(
+      i, exponent,
+      std::integral_constant<bool, std::numeric_limits<T>::is_signed>{});
 }
 
 /**
@@ -287,6 +323,26 @@ StatusOr<T> ToInteger(  // NOLINT(misc-no-recursion)
 
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
+
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+struct NumericInternals {
+  static spanner::Numeric Create(std::string rep) {
+    return spanner::Numeric(std::move(rep));
+  }
+};
+
+/**
+ * Construction from a representation that is already valid and canonical,
+ * such as a NUMERIC value received from Cloud Spanner, without validating it.
+ */
+inline spanner::Numeric MakeNumericFromCanonical(std::string rep) {
+  return NumericInternals::Create(std::move(rep));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
 }  // namespace cloud
 }  // namespace google
 
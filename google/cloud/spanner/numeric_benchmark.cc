@@ -34,15 +34,17 @@ namespace {
 // ------------------------------------------------------------------------
 // Benchmark                              Time             CPU   Iterations
 // ------------------------------------------------------------------------
-// BM_NumericFromStringCanonical       76.0 ns         76.0 ns      8999376
-// BM_NumericFromString                 369 ns          369 ns      1925749
-// BM_NumericFromDouble                2072 ns         2072 ns       340812
-// BM_NumericFromUnsigned               168 ns          168 ns      4151959
-// BM_NumericFromInteger                165 ns          165 ns      4238271
-// BM_NumericToString                 0.360 ns        0.360 ns   1000000000
-// BM_NumericToDouble                   115 ns          115 ns      6120955
-// BM_NumericToUnsigned                83.8 ns         83.8 ns      8466831
-// BM_NumericToInteger                 86.3 ns         86.3 ns      8092890
+// BM_NumericFromStringCanonical       59.5 ns         59.1 ns     11654970
+// BM_NumericFromString                 239 ns          238 ns      2900270
+// BM_NumericFromDouble                1130 ns         1114 ns       638782
+// BM_NumericFromUnsigned              41.5 ns         41.2 ns     16742787
+// BM_NumericFromInteger               45.3 ns         44.1 ns     16312180
+// BM_NumericFromIntegerScaled         46.8 ns         46.4 ns     14582127
+// BM_NumericFromCanonical             19.2 ns         19.2 ns     36480836
+// BM_NumericToString                 0.341 ns        0.338 ns   1000000000
+// BM_NumericToDouble                  85.0 ns         84.3 ns      8855427
+// BM_NumericToUnsigned                66.3 ns         65.8 ns     10903470
+// BM_NumericToInteger                 69.1 ns         68.3 ns     10691787
 
 void BM_NumericFromStringCanonical(benchmark::State& state) {
   std::string s = "99999999999999999999999999999.999999999";
@@ -84,6 +86,24 @@ void BM_NumericFromInteger(benchmark::State& state) {
 }
 BENCHMARK(BM_NumericFromInteger);
 
+// A fixed-point amount, in units of 10^-4.
+void BM_NumericFromIntegerScaled(benchmark::State& state) {
+  std::int64_t i = -1234567890123456789;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MakeNumeric(i, -4));
+  }
+}
+BENCHMARK(BM_NumericFromIntegerScaled);
+
+// The path for NUMERIC values read from Cloud Spanner.
+void BM_NumericFromCanonical(benchmark::State& state) {
+  std::string s = "99999999999999999999999999999.999999999";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spanner_internal::MakeNumericFromCanonical(s));
+  }
+}
+BENCHMARK(BM_NumericFromCanonical);
+
 void BM_NumericToString(benchmark::State& state) {
   std::string s = "99999999999999999999999999999.999999999";
   Numeric n = MakeNumeric(s).value();
@@ -20,6 +20,7 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -526,6 +527,41 @@ TEST(Numeric, MakeNumericIntegerScaled) {
   EXPECT_EQ(9223372036854775807, ToInteger<std::int64_t>(n, 9).value());
 }
 
+TEST(Numeric, MakeNumericIntegerScaledMatchesString) {
+  std::vector<absl::int128> const values = {
+      0,
+      1,
+      -1,
+      5,
+      -5,
+      10,
+      -10,
+      123456789,
+      -123456789,
+      1234567890000,
+      std::numeric_limits<std::int64_t>::min(),
+      std::numeric_limits<std::int64_t>::max(),
+      kNumericIntMin,
+      kNumericIntMax,
+      absl::MakeInt128(1, 0),
+      (std::numeric_limits<absl::int128>::min)(),
+      (std::numeric_limits<absl::int128>::max)(),
+  };
+  for (auto const v : values) {
+    for (int exponent = -45; exponent <= 30; ++exponent) {
+      std::ostringstream ss;
+      ss << v;
+      SCOPED_TRACE(ss.str() + "e" + std::to_string(exponent));
+      auto const expected = spanner_internal::MakeNumeric(ss.str(), exponent);
+      auto const actual = MakeNumeric(v, exponent);
+      ASSERT_EQ(expected.status(), actual.status());
+      if (expected) {
+        EXPECT_EQ(*expected, *actual);
+      }
+    }
+  }
+}
+
 TEST(Numeric, MakeNumericIntegerScaledFail) {
   // Beyond the integer-scaling limit (message is rendered with exponent).
   EXPECT_THAT(MakeNumeric(1, 29),
@@ -41,6 +41,7 @@
 #include "google/cloud/spanner/backoff_policy.h"
 #include "google/cloud/spanner/internal/session.h"
 #include "google/cloud/spanner/polling_policy.h"
+#include "google/cloud/spanner/query_stats_sampler.h"
 #include "google/cloud/spanner/request_priority.h"
 #include "google/cloud/spanner/retry_policy.h"
 #include "google/cloud/spanner/version.h"
@@ -148,13 +149,42 @@ struct SessionPoolLabelsOption {
   using Type = std::map<std::string, std::string>;
 };
 
+/**
+ * Option for `google::cloud::Options` to block the creation of a
+ * `spanner::Connection` until the initial sessions are created.
+ *
+ * The pool creates `SessionPoolMinSessionsOption` sessions when it starts,
+ * with concurrent `BatchCreateSessions` calls on all the channels. If this
+ * option is `true` (the default) `MakeConnection()` returns once those calls
+ * complete, so the first operations find a warm pool. If `false` the calls
+ * complete in the background, and operations that start before then wait for
+ * them.
+ */
+struct SessionPoolWaitForWarmupOption {
+  using Type = bool;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the number of free sessions
+ * below which the pool creates more sessions in the background.
+ *
+ * When an allocation leaves fewer free sessions than this, and the pool is
+ * not at its maximum size, the pool creates this many sessions without
+ * blocking the caller, so later allocations do not wait for a
+ * `BatchCreateSessions` call. Values <= 0, the default, disable the feature.
+ */
+struct SessionPoolLowWatermarkOption {
+  using Type = int;
+};
+
 /**
  * List of all SessionPool options.
  */
 using SessionPoolOptionList = OptionList<
     SessionPoolMinSessionsOption, SessionPoolMaxSessionsPerChannelOption,
     SessionPoolMaxIdleSessionsOption, SessionPoolActionOnExhaustionOption,
-    SessionPoolKeepAliveIntervalOption, SessionPoolLabelsOption>;
+    SessionPoolKeepAliveIntervalOption, SessionPoolLabelsOption,
+    SessionPoolWaitForWarmupOption, SessionPoolLowWatermarkOption>;
 
 /**
  * Option for `google::cloud::Options` to set a `spanner::RequestPriority`.
@@ -168,6 +198,42 @@ struct RequestPriorityOption {
  */
 using RequestOptionList = OptionList<RequestPriorityOption>;
 
+/**
+ * Option for `google::cloud::Options` to set the number of responses read
+ * ahead of the application in `Read()` and `ExecuteQuery()` streams.
+ *
+ * With a positive value each stream uses a background thread to receive up to
+ * this many `PartialResultSet` responses while the application processes the
+ * current rows. If the stream is interrupted it resumes from the last response
+ * received, as usual. The memory used by each stream grows with this value.
+ * Values <= 0, the default, disable reading ahead.
+ */
+struct StreamingReadAheadOption {
+  using Type = int;
+};
+
+/**
+ * List of all streaming options.
+ */
+using StreamingOptionList = OptionList<StreamingReadAheadOption>;
+
+/**
+ * Option for `google::cloud::Options` to sample the queries in
+ * `ExecuteQuery()` with a `spanner::QueryStatsSampler`.
+ *
+ * If set, the connection runs a fraction of the queries with
+ * `QueryMode::PROFILE`, and records their execution statistics in the
+ * sampler. Unset, the default, disables sampling.
+ */
+struct QueryStatsSamplerOption {
+  using Type = std::shared_ptr<spanner::QueryStatsSampler>;
+};
+
+/**
+ * List of all query statistics options.
+ */
+using QueryStatsOptionList = OptionList<QueryStatsSamplerOption>;
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
 }  // namespace cloud
@@ -0,0 +1,95 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/parallel_query.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+// Runs `execute(i)` for each partition index `i` on up to `max_concurrency`
+// threads, and passes the rows to `sink`.
+Status ParallelRun(std::size_t partition_count,
+                   std::function<RowStream(std::size_t)> const& execute,
+                   PartitionRowSink const& sink, std::size_t max_concurrency) {
+  std::mutex mu;
+  std::size_t next = 0;
+  Status status;
+  std::atomic<bool> failed{false};
+
+  auto fail = [&](Status s) {
+    std::lock_guard<std::mutex> lk(mu);
+    if (status.ok()) status = std::move(s);
+    failed = true;
+  };
+  auto worker = [&] {
+    for (;;) {
+      std::size_t partition;
+      {
+        std::lock_guard<std::mutex> lk(mu);
+        if (!status.ok() || next == partition_count) return;
+        partition = next++;
+      }
+      auto rows = execute(partition);
+      for (auto& row : rows) {
+        if (failed) return;
+        auto s = row ? sink(partition, *std::move(row)) : row.status();
+        if (!s.ok()) return fail(std::move(s));
+      }
+    }
+  };
+
+  auto const thread_count =
+      (std::min)(partition_count, (std::max)(max_concurrency, std::size_t{1}));
+  std::vector<std::thread> threads;
+  // The calling thread is one of the workers.
+  for (std::size_t i = 1; i < thread_count; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads) t.join();
+  return status;
+}
+
+}  // namespace
+
+Status ParallelExecuteQuery(Client client,
+                            std::vector<QueryPartition> partitions,
+                            PartitionRowSink const& sink,
+                            std::size_t max_concurrency,
+                            QueryOptions const& opts) {
+  return ParallelRun(
+      partitions.size(),
+      [&](std::size_t i) { return client.ExecuteQuery(partitions[i], opts); },
+      sink, max_concurrency);
+}
+
+Status ParallelRead(Client client, std::vector<ReadPartition> partitions,
+                    PartitionRowSink const& sink, std::size_t max_concurrency) {
+  return ParallelRun(
+      partitions.size(),
+      [&](std::size_t i) { return client.Read(partitions[i]); }, sink,
+      max_concurrency);
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
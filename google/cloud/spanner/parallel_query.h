@@ -0,0 +1,111 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARALLEL_QUERY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARALLEL_QUERY_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/query_options.h"
+#include "google/cloud/spanner/query_partition.h"
+#include "google/cloud/spanner/read_options.h"
+#include "google/cloud/spanner/read_partition.h"
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Receives the rows of a partition in `ParallelExecuteQuery()` and
+ * `ParallelRead()`.
+ *
+ * The first argument is the index of the partition in the input vector.
+ * Returning a non-OK status stops the whole operation.
+ */
+using PartitionRowSink = std::function<Status(std::size_t, Row)>;
+
+/**
+ * Executes @p partitions, at most @p max_concurrency at a time, and passes
+ * their rows to @p sink.
+ *
+ * Each partition runs on its own thread, which calls `Client::ExecuteQuery()`
+ * and then @p sink for each row. The sink is called concurrently for rows of
+ * different partitions, and in order for the rows of each partition. A
+ * partition does not fetch more rows until the sink returns, so a slow sink
+ * applies backpressure to the streams.
+ *
+ * A partition that fails with a transient error is resumed from its last row
+ * by the client, as for any other query, without restarting the other
+ * partitions. If a partition fails, or @p sink returns an error, no new
+ * partitions are started, the running partitions stop at their next row, and
+ * the first error is returned.
+ *
+ * @param client the client used to execute the partitions.
+ * @param partitions obtained by calling `Client::PartitionQuery()`.
+ * @param sink receives the rows of each partition.
+ * @param max_concurrency the maximum number of partitions executed at the same
+ *     time, values smaller than 1 are treated as 1.
+ * @param opts the options for each `Client::ExecuteQuery()` call.
+ *
+ * @par Example
+ * @code
+ * auto partitions = client.PartitionQuery(
+ *     MakeReadOnlyTransaction(), SqlStatement("SELECT * FROM Singers"));
+ * if (!partitions) throw std::runtime_error(partitions.status().message());
+ * std::mutex mu;
+ * std::int64_t count = 0;
+ * auto status = ParallelExecuteQuery(
+ *     client, *std::move(partitions),
+ *     [&](std::size_t, Row const&) {
+ *       std::lock_guard<std::mutex> lk(mu);
+ *       ++count;
+ *       return Status();
+ *     },
+ *     8);  // max_concurrency
+ * @endcode
+ */
+Status ParallelExecuteQuery(Client client,
+                            std::vector<QueryPartition> partitions,
+                            PartitionRowSink const& sink,
+                            std::size_t max_concurrency,
+                            QueryOptions const& opts = {});
+
+/**
+ * Reads @p partitions, at most @p max_concurrency at a time, and passes their
+ * rows to @p sink.
+ *
+ * This is the `Client::Read()` equivalent of `ParallelExecuteQuery()`, see
+ * its documentation for the details.
+ *
+ * @param client the client used to read the partitions.
+ * @param partitions obtained by calling `Client::PartitionRead()`.
+ * @param sink receives the rows of each partition.
+ * @param max_concurrency the maximum number of partitions read at the same
+ *     time, values smaller than 1 are treated as 1.
+ */
+Status ParallelRead(Client client, std::vector<ReadPartition> partitions,
+                    PartitionRowSink const& sink, std::size_t max_concurrency);
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARALLEL_QUERY_H
@@ -0,0 +1,171 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/parallel_query.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+std::vector<QueryPartition> MakeQueryPartitions(int count) {
+  std::vector<QueryPartition> partitions;
+  for (int i = 0; i != count; ++i) {
+    partitions.push_back(spanner_internal::MakeQueryPartition(
+        "txn-id", "session", std::to_string(i),
+        SqlStatement("SELECT * FROM Table")));
+  }
+  return partitions;
+}
+
+// Returns a stream with the rows `{token, 0}`, `{token, 1}`, ...
+RowStream MakeRows(absl::optional<std::string> const& token, int count) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  auto next = std::make_shared<int>(0);
+  auto const name = token.value_or("");
+  EXPECT_CALL(*source, NextRow()).WillRepeatedly([next, name, count] {
+    if (*next == count) return Row();
+    return MakeTestRow(name, std::int64_t{(*next)++});
+  });
+  return RowStream(std::move(source));
+}
+
+TEST(ParallelExecuteQuery, Success) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery)
+      .Times(5)
+      .WillRepeatedly([](Connection::SqlParams const& params) {
+        return MakeRows(params.partition_token, 3);
+      });
+
+  std::mutex mu;
+  std::map<std::size_t, std::vector<std::int64_t>> actual;
+  auto status = ParallelExecuteQuery(
+      Client(conn), MakeQueryPartitions(5),
+      [&](std::size_t partition, Row const& row) {
+        auto values = row.get<std::tuple<std::string, std::int64_t>>();
+        if (!values) return values.status();
+        EXPECT_EQ(std::to_string(partition), std::get<0>(*values));
+        std::lock_guard<std::mutex> lk(mu);
+        actual[partition].push_back(std::get<1>(*values));
+        return Status();
+      },
+      2);
+  ASSERT_STATUS_OK(status);
+  ASSERT_EQ(5U, actual.size());
+  for (auto const& kv : actual) {
+    EXPECT_THAT(kv.second, ElementsAre(0, 1, 2));
+  }
+}
+
+TEST(ParallelExecuteQuery, NoPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery).Times(0);
+  auto status = ParallelExecuteQuery(
+      Client(conn), {}, [](std::size_t, Row const&) { return Status(); }, 4);
+  EXPECT_STATUS_OK(status);
+}
+
+TEST(ParallelExecuteQuery, PartitionFailure) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery)
+      .WillOnce([](Connection::SqlParams const&) {
+        auto source = absl::make_unique<MockResultSetSource>();
+        EXPECT_CALL(*source, NextRow())
+            .WillOnce(Return(Status(StatusCode::kPermissionDenied, "uh-oh")));
+        return RowStream(std::move(source));
+      });
+
+  std::atomic<int> rows{0};
+  auto status = ParallelExecuteQuery(
+      Client(conn), MakeQueryPartitions(3),
+      [&](std::size_t, Row const&) {
+        ++rows;
+        return Status();
+      },
+      1);
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+  EXPECT_EQ(0, rows.load());
+}
+
+TEST(ParallelExecuteQuery, SinkFailure) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery)
+      .WillOnce([](Connection::SqlParams const& params) {
+        return MakeRows(params.partition_token, 3);
+      });
+
+  std::atomic<int> rows{0};
+  auto status = ParallelExecuteQuery(
+      Client(conn), MakeQueryPartitions(3),
+      [&](std::size_t, Row const&) {
+        ++rows;
+        return Status(StatusCode::kCancelled, "enough");
+      },
+      1);
+  EXPECT_THAT(status, StatusIs(StatusCode::kCancelled, "enough"));
+  EXPECT_EQ(1, rows.load());
+}
+
+TEST(ParallelRead, Success) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read)
+      .Times(3)
+      .WillRepeatedly([](Connection::ReadParams const& params) {
+        return MakeRows(params.partition_token, 2);
+      });
+
+  std::vector<ReadPartition> partitions;
+  for (int i = 0; i != 3; ++i) {
+    partitions.push_back(spanner_internal::MakeReadPartition(
+        "txn-id", "session", std::to_string(i), "Table", KeySet::All(),
+        {"Name", "Id"}, ReadOptions{}));
+  }
+  std::atomic<int> rows{0};
+  auto status = ParallelRead(
+      Client(conn), std::move(partitions),
+      [&](std::size_t, Row const&) {
+        ++rows;
+        return Status();
+      },
+      8);
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(6, rows.load());
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
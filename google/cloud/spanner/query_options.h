@@ -19,6 +19,7 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/optional.h"
 #include "absl/types/optional.h"
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -82,10 +83,29 @@ class QueryOptions {
     return *this;
   }
 
+  /// Returns the maximum number of rows the application will consume.
+  absl::optional<std::int64_t> const& max_rows() const { return max_rows_; }
+
+  /**
+   * Sets the maximum number of rows the application will consume.
+   *
+   * The client library cancels the streaming RPC as soon as this many rows are
+   * returned, and the `RowStream` then reports the end of the stream, instead
+   * of waiting for the server to send (and the library to buffer) the rest of
+   * the results. The statistics in the final response are not available if
+   * the RPC is cancelled. This does not change the query sent to the server,
+   * use a `LIMIT` clause if the server should stop producing rows too.
+   */
+  QueryOptions& set_max_rows(absl::optional<std::int64_t> max_rows) {
+    max_rows_ = std::move(max_rows);
+    return *this;
+  }
+
   friend bool operator==(QueryOptions const& a, QueryOptions const& b) {
     return a.request_priority_ == b.request_priority_ &&
            a.optimizer_version_ == b.optimizer_version_ &&
-           a.optimizer_statistics_package_ == b.optimizer_statistics_package_;
+           a.optimizer_statistics_package_ == b.optimizer_statistics_package_ &&
+           a.max_rows_ == b.max_rows_;
   }
 
   friend bool operator!=(QueryOptions const& a, QueryOptions const& b) {
@@ -98,6 +118,7 @@ class QueryOptions {
   absl::optional<std::string> optimizer_version_;
   absl::optional<std::string> optimizer_statistics_package_;
   absl::optional<RequestPriority> request_priority_;
+  absl::optional<std::int64_t> max_rows_;
 };
 
 }  // namespace SPANNER_CLIENT_NS
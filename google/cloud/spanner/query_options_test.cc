@@ -69,6 +69,19 @@ TEST(QueryOptionsTest, OptimizerStatisticsPackage) {
   EXPECT_EQ(copy, default_constructed);
 }
 
+TEST(QueryOptionsTest, MaxRows) {
+  QueryOptions const default_constructed{};
+  EXPECT_FALSE(default_constructed.max_rows().has_value());
+
+  auto copy = default_constructed;
+  copy.set_max_rows(10);
+  EXPECT_NE(copy, default_constructed);
+  EXPECT_EQ(10, copy.max_rows().value());
+
+  copy.set_max_rows(absl::nullopt);
+  EXPECT_EQ(copy, default_constructed);
+}
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -0,0 +1,253 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/query_stats_sampler.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <random>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+bool IsIdentifierChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsSpace(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+
+// Removes the `b`, `r`, `br`, or `rb` prefix of a string literal from @p out.
+void RemoveLiteralPrefix(std::string& out) {
+  auto const n = out.size();
+  auto prefix = [&out](std::size_t i) {
+    auto const c = static_cast<char>(std::tolower(out[i]));
+    return c == 'b' || c == 'r';
+  };
+  auto const starts_token = [&out](std::size_t i) {
+    return i == 0 || !IsIdentifierChar(out[i - 1]);
+  };
+  if (n >= 2 && prefix(n - 1) && prefix(n - 2) && starts_token(n - 2)) {
+    out.resize(n - 2);
+  } else if (n >= 1 && prefix(n - 1) && starts_token(n - 1)) {
+    out.resize(n - 1);
+  }
+}
+
+// Returns the position after the string literal starting at @p pos.
+std::size_t SkipString(std::string const& sql, std::size_t pos) {
+  auto const quote = sql[pos];
+  auto const n = sql.size();
+  auto const triple =
+      pos + 2 < n && sql[pos + 1] == quote && sql[pos + 2] == quote;
+  pos += triple ? 3 : 1;
+  while (pos < n) {
+    auto const c = sql[pos];
+    if (c == '\\') {
+      pos += 2;
+      continue;
+    }
+    if (c != quote) {
+      ++pos;
+      continue;
+    }
+    if (!triple) return pos + 1;
+    if (pos + 2 < n && sql[pos + 1] == quote && sql[pos + 2] == quote) {
+      return pos + 3;
+    }
+    ++pos;
+  }
+  return n;
+}
+
+// Returns the position after the numeric literal starting at @p pos.
+std::size_t SkipNumber(std::string const& sql, std::size_t pos) {
+  auto const n = sql.size();
+  while (pos < n) {
+    auto const c = sql[pos];
+    if ((c == 'e' || c == 'E') && pos + 1 < n &&
+        (sql[pos + 1] == '+' || sql[pos + 1] == '-')) {
+      pos += 2;
+      continue;
+    }
+    if (!IsIdentifierChar(c) && c != '.') break;
+    ++pos;
+  }
+  return pos;
+}
+
+// Returns the position after the comment starting at @p pos, or @p pos if
+// there is no comment.
+std::size_t SkipComment(std::string const& sql, std::size_t pos) {
+  auto const n = sql.size();
+  auto const c = sql[pos];
+  auto const next = pos + 1 < n ? sql[pos + 1] : '\0';
+  if (c == '#' || (c == '-' && next == '-')) {
+    auto end = sql.find('\n', pos);
+    return end == std::string::npos ? n : end;
+  }
+  if (c == '/' && next == '*') {
+    auto end = sql.find("*/", pos + 2);
+    return end == std::string::npos ? n : end + 2;
+  }
+  return pos;
+}
+
+// Converts durations reported by the service, such as "1.5 msecs".
+std::chrono::microseconds ParseDuration(google::protobuf::Value const& v) {
+  if (v.kind_case() != google::protobuf::Value::kStringValue) return {};
+  auto const& s = v.string_value();
+  char* end = nullptr;
+  auto const value = std::strtod(s.c_str(), &end);
+  while (*end != '\0' && IsSpace(*end)) ++end;
+  std::string const unit = end;
+  double scale = 0;
+  if (unit == "usecs") scale = 1.0;
+  if (unit == "msecs") scale = 1.0E3;
+  if (unit == "secs") scale = 1.0E6;
+  if (unit == "mins") scale = 60.0E6;
+  return std::chrono::microseconds(static_cast<std::int64_t>(value * scale));
+}
+
+std::uint64_t ParseCount(google::protobuf::Value const& v) {
+  switch (v.kind_case()) {
+    case google::protobuf::Value::kStringValue:
+      return std::strtoull(v.string_value().c_str(), nullptr, 10);
+    case google::protobuf::Value::kNumberValue:
+      return v.number_value() < 0
+                 ? 0
+                 : static_cast<std::uint64_t>(v.number_value());
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+std::string QueryFingerprint(std::string const& sql) {
+  std::string out;
+  out.reserve(sql.size());
+  auto const n = sql.size();
+  bool pending_space = false;
+  for (std::size_t pos = 0; pos < n;) {
+    auto const c = sql[pos];
+    auto const after_comment = SkipComment(sql, pos);
+    if (IsSpace(c) || after_comment != pos) {
+      pending_space = true;
+      pos = (std::max)(after_comment, pos + 1);
+      continue;
+    }
+    if (pending_space && !out.empty()) out.push_back(' ');
+    pending_space = false;
+    if (c == '\'' || c == '"') {
+      RemoveLiteralPrefix(out);
+      out.push_back('?');
+      pos = SkipString(sql, pos);
+      continue;
+    }
+    if (c == '`') {
+      auto end = sql.find('`', pos + 1);
+      end = end == std::string::npos ? n : end + 1;
+      out.append(sql, pos, end - pos);
+      pos = end;
+      continue;
+    }
+    if (std::isdigit(static_cast<unsigned char>(c)) &&
+        (out.empty() || !IsIdentifierChar(out.back()))) {
+      out.push_back('?');
+      pos = SkipNumber(sql, pos);
+      continue;
+    }
+    out.push_back(c);
+    ++pos;
+  }
+  return out;
+}
+
+QueryStatsSampler::QueryStatsSampler(double sample_fraction,
+                                     std::size_t max_fingerprints)
+    : sample_fraction_(sample_fraction),
+      max_fingerprints_(max_fingerprints),
+      generator_(google::cloud::internal::MakeDefaultPRNG()) {}
+
+bool QueryStatsSampler::Sample() {
+  if (sample_fraction_ <= 0) return false;
+  if (sample_fraction_ >= 1) return true;
+  std::lock_guard<std::mutex> lk(mu_);
+  return std::uniform_real_distribution<double>(0, 1)(generator_) <
+         sample_fraction_;
+}
+
+void QueryStatsSampler::Record(
+    std::string const& sql, google::spanner::v1::ResultSetStats const& stats) {
+  auto const& fields = stats.query_stats().fields();
+  auto field = [&fields](std::string const& name) {
+    auto f = fields.find(name);
+    return f == fields.end() ? google::protobuf::Value{} : f->second;
+  };
+  auto const elapsed_time = ParseDuration(field("elapsed_time"));
+  auto const cpu_time = ParseDuration(field("cpu_time"));
+  auto const rows_returned = ParseCount(field("rows_returned"));
+  auto const rows_scanned = ParseCount(field("rows_scanned"));
+  auto fingerprint = QueryFingerprint(sql);
+
+  std::lock_guard<std::mutex> lk(mu_);
+  auto i = stats_.find(fingerprint);
+  if (i == stats_.end()) {
+    if (stats_.size() >= max_fingerprints_) {
+      ++dropped_samples_;
+      return;
+    }
+    QueryStatsSnapshot s{fingerprint,
+                         0,
+                         std::chrono::microseconds(0),
+                         std::chrono::microseconds(0),
+                         std::chrono::microseconds(0),
+                         0,
+                         0};
+    i = stats_.emplace(std::move(fingerprint), std::move(s)).first;
+  }
+  auto& s = i->second;
+  ++s.samples;
+  s.elapsed_time += elapsed_time;
+  s.max_elapsed_time = (std::max)(s.max_elapsed_time, elapsed_time);
+  s.cpu_time += cpu_time;
+  s.rows_returned += rows_returned;
+  s.rows_scanned += rows_scanned;
+}
+
+std::vector<QueryStatsSnapshot> QueryStatsSampler::Snapshot() const {
+  std::vector<QueryStatsSnapshot> result;
+  std::lock_guard<std::mutex> lk(mu_);
+  result.reserve(stats_.size());
+  for (auto const& kv : stats_) result.push_back(kv.second);
+  return result;
+}
+
+void QueryStatsSampler::Export(QueryStatsExporter& exporter) const {
+  exporter.Export(Snapshot());
+}
+
+std::uint64_t QueryStatsSampler::dropped_samples() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return dropped_samples_;
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
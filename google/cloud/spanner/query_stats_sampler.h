@@ -0,0 +1,144 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_QUERY_STATS_SAMPLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_QUERY_STATS_SAMPLER_H
+
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/internal/random.h"
+#include <google/spanner/v1/result_set.pb.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/// The aggregated statistics for all the sampled queries with a fingerprint.
+struct QueryStatsSnapshot {
+  /// The normalized SQL text, see `QueryFingerprint()`.
+  std::string fingerprint;
+  /// The number of sampled queries included in these statistics.
+  std::uint64_t samples;
+  /// The total, and the maximum, time to execute the queries in the service.
+  std::chrono::microseconds elapsed_time;
+  std::chrono::microseconds max_elapsed_time;
+  /// The total CPU time used by the service to execute the queries.
+  std::chrono::microseconds cpu_time;
+  /// The total number of rows returned and scanned by the queries.
+  std::uint64_t rows_returned;
+  std::uint64_t rows_scanned;
+};
+
+/**
+ * Receives the statistics collected by `QueryStatsSampler`.
+ *
+ * Applications implement this interface to forward the statistics to their
+ * monitoring system.
+ */
+class QueryStatsExporter {
+ public:
+  virtual ~QueryStatsExporter() = default;
+  virtual void Export(std::vector<QueryStatsSnapshot> const& stats) = 0;
+};
+
+/**
+ * Returns the SQL text of @p sql with the literals and whitespace normalized.
+ *
+ * String, bytes, and numeric literals are replaced by `?`, and any sequence
+ * of whitespace characters by a single space. Queries that differ only in
+ * their literal values have the same fingerprint. Queries using parameters
+ * already have the same text.
+ */
+std::string QueryFingerprint(std::string const& sql);
+
+/**
+ * Samples `ExecuteQuery()` calls to find the queries that need tuning.
+ *
+ * Configure a `Connection` with `QueryStatsSamplerOption` to run a fraction
+ * of the queries in `ExecuteQuery()` with `QueryMode::PROFILE`. Once a
+ * sampled query returns all its rows the sampler aggregates its execution
+ * statistics (service CPU time, elapsed time, rows returned and scanned) by
+ * the query fingerprint. The rows returned by a sampled query are unchanged,
+ * but the service returns the execution plan too, and the application may see
+ * them in `RowStream::ExecutionStats()`.
+ *
+ * The sampler keeps at most `max_fingerprints` different fingerprints, the
+ * samples for any other queries are counted in `dropped_samples()`. The
+ * application decides when to export the statistics, for example, from a
+ * periodic timer.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads, and can be shared by many connections.
+ *
+ * @par Example
+ * @code
+ * auto sampler = std::make_shared<spanner::QueryStatsSampler>(0.01);
+ * auto client = spanner::Client(spanner::MakeConnection(
+ *     db, Options{}.set<spanner::QueryStatsSamplerOption>(sampler)));
+ * // ... use `client` ...
+ * sampler->Export(my_exporter);
+ * @endcode
+ */
+class QueryStatsSampler {
+ public:
+  /// Samples @p sample_fraction of the queries, a value in the [0, 1] range.
+  explicit QueryStatsSampler(double sample_fraction,
+                             std::size_t max_fingerprints = 1000);
+
+  QueryStatsSampler(QueryStatsSampler const&) = delete;
+  QueryStatsSampler& operator=(QueryStatsSampler const&) = delete;
+
+  double sample_fraction() const { return sample_fraction_; }
+
+  /// Returns true if the next query should be profiled.
+  bool Sample();
+
+  /// Aggregates the @p stats returned by a profiled query.
+  void Record(std::string const& sql,
+              google::spanner::v1::ResultSetStats const& stats);
+
+  /// Returns the statistics for each fingerprint, sorted by fingerprint.
+  std::vector<QueryStatsSnapshot> Snapshot() const;
+
+  /// Sends a snapshot of the statistics to @p exporter.
+  void Export(QueryStatsExporter& exporter) const;
+
+  /// The samples not recorded because there were too many fingerprints.
+  std::uint64_t dropped_samples() const;
+
+ private:
+  double const sample_fraction_;
+  std::size_t const max_fingerprints_;
+
+  mutable std::mutex mu_;
+  google::cloud::internal::DefaultPRNG generator_;  // GUARDED_BY(mu_)
+  std::map<std::string, QueryStatsSnapshot> stats_;  // GUARDED_BY(mu_)
+  std::uint64_t dropped_samples_ = 0;               // GUARDED_BY(mu_)
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_QUERY_STATS_SAMPLER_H
@@ -0,0 +1,150 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/query_stats_sampler.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+
+google::spanner::v1::ResultSetStats MakeStats(std::string const& elapsed,
+                                              std::string const& cpu,
+                                              std::string const& returned,
+                                              std::string const& scanned) {
+  auto const text = R"pb(
+    query_stats {
+      fields {
+        key: "elapsed_time"
+        value { string_value: ")pb" + elapsed + R"pb(" }
+      }
+      fields {
+        key: "cpu_time"
+        value { string_value: ")pb" + cpu + R"pb(" }
+      }
+      fields {
+        key: "rows_returned"
+        value { string_value: ")pb" + returned + R"pb(" }
+      }
+      fields {
+        key: "rows_scanned"
+        value { string_value: ")pb" + scanned + R"pb(" }
+      }
+    }
+  )pb";
+  google::spanner::v1::ResultSetStats stats;
+  EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(text, &stats));
+  return stats;
+}
+
+TEST(QueryFingerprint, Literals) {
+  EXPECT_EQ("SELECT * FROM Singers WHERE SingerId = ?",
+            QueryFingerprint("SELECT * FROM Singers WHERE SingerId = 42"));
+  EXPECT_EQ("SELECT * FROM Singers WHERE FirstName = ? AND LastName = ?",
+            QueryFingerprint("SELECT * FROM Singers WHERE FirstName = 'Bob' "
+                             "AND LastName = \"O'Brien\""));
+  EXPECT_EQ("SELECT ?, ?, ?, ?",
+            QueryFingerprint("SELECT b'\\x01', r'a\\b', 1.5e-3, 0x1F"));
+  EXPECT_EQ("SELECT ? AS x", QueryFingerprint("SELECT '''a\n'b''' AS x"));
+}
+
+TEST(QueryFingerprint, KeepsIdentifiersAndParameters) {
+  EXPECT_EQ("SELECT c1 FROM `Table 2` WHERE t2.id = @p1",
+            QueryFingerprint("SELECT c1 FROM `Table 2` WHERE t2.id = @p1"));
+}
+
+TEST(QueryFingerprint, WhitespaceAndComments) {
+  EXPECT_EQ("SELECT a FROM T WHERE b = ?",
+            QueryFingerprint("  SELECT a -- comment\n"
+                             "FROM T\t/* another */ WHERE b =\n 7 # end"));
+}
+
+TEST(QueryStatsSampler, Sample) {
+  QueryStatsSampler never(0.0);
+  QueryStatsSampler always(1.0);
+  QueryStatsSampler half(0.5);
+  int sampled = 0;
+  for (int i = 0; i != 1000; ++i) {
+    EXPECT_FALSE(never.Sample());
+    EXPECT_TRUE(always.Sample());
+    if (half.Sample()) ++sampled;
+  }
+  EXPECT_LT(0, sampled);
+  EXPECT_GT(1000, sampled);
+}
+
+TEST(QueryStatsSampler, AggregatesByFingerprint) {
+  QueryStatsSampler sampler(1.0);
+  sampler.Record("SELECT * FROM T WHERE id = 1",
+                 MakeStats("1.5 msecs", "1 msecs", "1", "10"));
+  sampler.Record("SELECT * FROM T WHERE id = 2",
+                 MakeStats("2.5 msecs", "2 msecs", "2", "20"));
+  sampler.Record("SELECT a FROM U", MakeStats("1.2 secs", "3 secs", "7", "7"));
+
+  auto const snapshot = sampler.Snapshot();
+  ASSERT_EQ(2, snapshot.size());
+  auto const& t = snapshot[0];
+  EXPECT_EQ("SELECT * FROM T WHERE id = ?", t.fingerprint);
+  EXPECT_EQ(2, t.samples);
+  EXPECT_EQ(std::chrono::microseconds(4000), t.elapsed_time);
+  EXPECT_EQ(std::chrono::microseconds(2500), t.max_elapsed_time);
+  EXPECT_EQ(std::chrono::microseconds(3000), t.cpu_time);
+  EXPECT_EQ(3, t.rows_returned);
+  EXPECT_EQ(30, t.rows_scanned);
+  auto const& u = snapshot[1];
+  EXPECT_EQ("SELECT a FROM U", u.fingerprint);
+  EXPECT_EQ(1, u.samples);
+  EXPECT_EQ(std::chrono::microseconds(1200000), u.elapsed_time);
+  EXPECT_EQ(std::chrono::microseconds(3000000), u.cpu_time);
+}
+
+TEST(QueryStatsSampler, MaxFingerprints) {
+  QueryStatsSampler sampler(1.0, 1);
+  auto const stats = MakeStats("1 msecs", "1 msecs", "1", "1");
+  sampler.Record("SELECT 1", stats);
+  sampler.Record("SELECT a FROM T", stats);
+  sampler.Record("SELECT 2", stats);
+  EXPECT_THAT(sampler.Snapshot(),
+              ElementsAre(Field(&QueryStatsSnapshot::samples, 2)));
+  EXPECT_EQ(1, sampler.dropped_samples());
+}
+
+TEST(QueryStatsSampler, Export) {
+  struct TestExporter : public QueryStatsExporter {
+    void Export(std::vector<QueryStatsSnapshot> const& s) override {
+      for (auto const& x : s) fingerprints.push_back(x.fingerprint);
+    }
+    std::vector<std::string> fingerprints;
+  };
+  QueryStatsSampler sampler(1.0);
+  sampler.Record("SELECT 1", MakeStats("1 msecs", "1 msecs", "1", "1"));
+  TestExporter exporter;
+  sampler.Export(exporter);
+  EXPECT_THAT(exporter.fingerprints, ElementsAre("SELECT ?"));
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
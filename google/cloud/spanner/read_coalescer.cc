@@ -0,0 +1,145 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/read_coalescer.h"
+#include <algorithm>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+auto constexpr kDefaultMaxKeysPerRead = 100;
+auto constexpr kDefaultMaxReads = 4;
+
+// Returns true if the first values in @p row are the values in @p key.
+bool RowHasKey(std::vector<Value> const& row, Key const& key) {
+  return key.size() <= row.size() &&
+         std::equal(key.begin(), key.end(), row.begin());
+}
+
+}  // namespace
+
+ReadCoalescer::Options::Options()
+    : max_keys_per_read(kDefaultMaxKeysPerRead),
+      max_reads(kDefaultMaxReads),
+      transaction_options(Transaction::ReadOnlyOptions()) {}
+
+ReadCoalescer::~ReadCoalescer() { AsyncWaitForNoPendingRequests().get(); }
+
+future<StatusOr<absl::optional<Row>>> ReadCoalescer::Lookup(Key key) {
+  promise<StatusOr<absl::optional<Row>>> p;
+  auto f = p.get_future();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (current_.keys.size() >= options_.max_keys_per_read) {
+    full_.push_back(std::move(current_));
+    current_ = Lookups{};
+  }
+  current_.keys.push_back(std::move(key));
+  current_.promises.push_back(std::move(p));
+  SendBatches(std::move(lk));
+  return f;
+}
+
+future<void> ReadCoalescer::AsyncWaitForNoPendingRequests() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (outstanding_ == 0 && full_.empty() && current_.keys.empty()) {
+    return make_ready_future();
+  }
+  no_more_pending_promises_.emplace_back();
+  return no_more_pending_promises_.back().get_future();
+}
+
+void ReadCoalescer::SendBatches(std::unique_lock<std::mutex> lk) {
+  while (outstanding_ < options_.max_reads) {
+    Lookups batch;
+    if (!full_.empty()) {
+      batch = std::move(full_.front());
+      full_.pop_front();
+    } else if (!current_.keys.empty()) {
+      batch = std::move(current_);
+      current_ = Lookups{};
+    } else {
+      break;
+    }
+    ++outstanding_;
+    // The read may complete immediately, and `OnRead()` needs the lock.
+    lk.unlock();
+    KeySet keys;
+    for (auto const& k : batch.keys) keys.AddKey(k);
+    auto pending = std::make_shared<Lookups>(std::move(batch));
+    client_
+        .AsyncRead(spanner_internal::MakeSingleUseTransaction(
+                       options_.transaction_options),
+                   table_, std::move(keys), columns_, options_.read_options)
+        .then([this, pending](future<StatusOr<RowStream>> f) {
+          OnRead(std::move(*pending), f.get());
+        });
+    lk.lock();
+  }
+
+  if (outstanding_ != 0 || !full_.empty() || !current_.keys.empty()) return;
+  auto waiters = std::move(no_more_pending_promises_);
+  no_more_pending_promises_.clear();
+  lk.unlock();
+  for (auto& w : waiters) w.set_value();
+}
+
+void ReadCoalescer::OnRead(Lookups batch, StatusOr<RowStream> rows) {
+  auto& keys = batch.keys;
+  auto& promises = batch.promises;
+  Status status = rows.status();
+  if (rows) {
+    for (auto& row : *rows) {
+      if (!row) {
+        status = std::move(row).status();
+        break;
+      }
+      // Several lookups may have requested the same key, satisfy all of them.
+      // Remove the satisfied lookups, so later rows have fewer keys to match.
+      for (std::size_t i = 0; i < keys.size();) {
+        if (!RowHasKey(row->values(), keys[i])) {
+          ++i;
+          continue;
+        }
+        promises[i].set_value(absl::optional<Row>(*row));
+        std::swap(keys[i], keys.back());
+        std::swap(promises[i], promises.back());
+        keys.pop_back();
+        promises.pop_back();
+      }
+    }
+  }
+  // The remaining keys have no rows, unless the read failed.
+  for (auto& p : promises) {
+    if (status.ok()) {
+      p.set_value(absl::optional<Row>());
+    } else {
+      p.set_value(status);
+    }
+  }
+
+  std::unique_lock<std::mutex> lk(mu_);
+  --outstanding_;
+  SendBatches(std::move(lk));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
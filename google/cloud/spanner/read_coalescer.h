@@ -0,0 +1,172 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_READ_COALESCER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_READ_COALESCER_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/keys.h"
+#include "google/cloud/spanner/read_options.h"
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Merges concurrent single-key reads of the same table into `KeySet` reads.
+ *
+ * Applications that look up many rows by key, each lookup with its own
+ * `Client::Read()`, use a session and a streaming RPC for each row. Create a
+ * `ReadCoalescer` for the table and columns, and call
+ * `ReadCoalescer::Lookup()` for each key, the coalescer reads the keys in
+ * batches, with `Client::AsyncRead()`, and returns each row to the lookups
+ * for its key.
+ *
+ * A batch is read as soon as fewer than `max_reads` reads are in flight, the
+ * batches grow while the reads are running. Each batch is read in a separate
+ * single-use transaction, so lookups in different batches may observe
+ * different snapshots of the database.
+ *
+ * The coalescer finds the row for each key by comparing the key with the
+ * first values in the row. Therefore, `columns` must start with the key
+ * columns, in the order of the primary key, or of the index named in
+ * `Options::read_options`.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ */
+class ReadCoalescer {
+ public:
+  /// Configuration for `ReadCoalescer`.
+  struct Options {
+    Options();
+
+    /// A single read will not have more keys than this.
+    Options& SetMaxKeysPerRead(std::size_t max_keys_per_read_arg) {
+      max_keys_per_read =
+          max_keys_per_read_arg == 0 ? 1 : max_keys_per_read_arg;
+      return *this;
+    }
+
+    /// There will be no more reads in flight than this.
+    Options& SetMaxReads(std::size_t max_reads_arg) {
+      max_reads = max_reads_arg == 0 ? 1 : max_reads_arg;
+      return *this;
+    }
+
+    /// The options for the single-use transaction of each read.
+    Options& SetTransactionOptions(
+        Transaction::SingleUseOptions transaction_options_arg) {
+      transaction_options = std::move(transaction_options_arg);
+      return *this;
+    }
+
+    /// The options used for each read.
+    Options& SetReadOptions(ReadOptions read_options_arg) {
+      read_options = std::move(read_options_arg);
+      return *this;
+    }
+
+    std::size_t max_keys_per_read;
+    std::size_t max_reads;
+    Transaction::SingleUseOptions transaction_options;
+    ReadOptions read_options;
+  };
+
+  ReadCoalescer(Client client, std::string table,
+                std::vector<std::string> columns, Options options = Options())
+      : client_(std::move(client)),
+        table_(std::move(table)),
+        columns_(std::move(columns)),
+        options_(std::move(options)) {}
+
+  /// Waits until all the lookups are completed.
+  ~ReadCoalescer();
+
+  ReadCoalescer(ReadCoalescer const&) = delete;
+  ReadCoalescer& operator=(ReadCoalescer const&) = delete;
+
+  /**
+   * Reads the row for @p key, most likely in a batch with other keys.
+   *
+   * The returned future is satisfied with the row, with an empty optional if
+   * there is no row for @p key, or with the error of the read that included
+   * @p key.
+   *
+   * @par Example
+   * @code
+   * spanner::ReadCoalescer coalescer(client, "Singers",
+   *                                  {"SingerId", "FirstName", "LastName"});
+   * auto row = coalescer.Lookup(spanner::MakeKey(singer_id)).get();
+   * if (!row) throw std::runtime_error(row.status().message());
+   * if (!row->has_value()) return;  // no such singer
+   * @endcode
+   */
+  future<StatusOr<absl::optional<Row>>> Lookup(Key key);
+
+  /**
+   * Returns a future satisfied when all the lookups requested so far are
+   * completed.
+   *
+   * The future is satisfied when there are no pending lookups, lookups
+   * requested after this call may delay it.
+   */
+  future<void> AsyncWaitForNoPendingRequests();
+
+ private:
+  struct Lookups {
+    std::vector<Key> keys;
+    std::vector<promise<StatusOr<absl::optional<Row>>>> promises;
+  };
+
+  /// Reads the full batches, and then the current batch, while there are
+  /// fewer than `max_reads` reads in flight.
+  void SendBatches(std::unique_lock<std::mutex> lk);
+
+  /// Returns the rows in @p rows to the lookups in @p batch, and sends more
+  /// batches.
+  void OnRead(Lookups batch, StatusOr<RowStream> rows);
+
+  Client client_;
+  std::string const table_;
+  std::vector<std::string> const columns_;
+  Options const options_;
+
+  std::mutex mu_;
+  Lookups current_;
+  std::deque<Lookups> full_;
+  std::size_t outstanding_ = 0;
+  std::vector<promise<void>> no_more_pending_promises_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_READ_COALESCER_H
@@ -0,0 +1,175 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/spanner/read_coalescer.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+Row MakeSingerRow(std::int64_t id) {
+  return MakeTestRow(id, "name-" + std::to_string(id));
+}
+
+RowStream MakeRowStream(std::vector<Row> rows) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  auto pending = std::make_shared<std::deque<Row>>(rows.begin(), rows.end());
+  EXPECT_CALL(*source, NextRow).WillRepeatedly([pending] {
+    if (pending->empty()) return StatusOr<Row>(Row());
+    auto row = std::move(pending->front());
+    pending->pop_front();
+    return StatusOr<Row>(std::move(row));
+  });
+  return RowStream(std::move(source));
+}
+
+// Keeps the reads pending until the test completes them.
+struct PendingReads {
+  std::vector<int> sizes;
+  std::deque<promise<StatusOr<RowStream>>> reads;
+
+  void Complete(StatusOr<RowStream> result) {
+    auto p = std::move(reads.front());
+    reads.pop_front();
+    p.set_value(std::move(result));
+  }
+};
+
+void ExpectPendingReads(MockConnection& conn, PendingReads& pending) {
+  EXPECT_CALL(conn, AsyncRead)
+      .WillRepeatedly([&pending](Connection::ReadParams const& params) {
+        pending.sizes.push_back(
+            spanner_internal::ToProto(params.keys).keys_size());
+        pending.reads.emplace_back();
+        return pending.reads.back().get_future();
+      });
+}
+
+std::string Name(StatusOr<absl::optional<Row>> const& row) {
+  if (!row || !row->has_value()) return "<missing>";
+  return *(*row)->get<std::string>(1);
+}
+
+TEST(ReadCoalescer, SingleLookup) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncRead)
+      .WillOnce([](Connection::ReadParams const& params) {
+        EXPECT_EQ("Singers", params.table);
+        EXPECT_THAT(params.columns, ElementsAre("SingerId", "FirstName"));
+        EXPECT_EQ(KeySet().AddKey(MakeKey(std::int64_t{1})), params.keys);
+        return make_ready_future(
+            make_status_or(MakeRowStream({MakeSingerRow(1)})));
+      });
+
+  ReadCoalescer coalescer(Client(conn), "Singers", {"SingerId", "FirstName"});
+  auto row = coalescer.Lookup(MakeKey(std::int64_t{1})).get();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ("name-1", Name(row));
+}
+
+TEST(ReadCoalescer, BatchesWhileReadsAreInFlight) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingReads pending;
+  ExpectPendingReads(*conn, pending);
+
+  ReadCoalescer coalescer(Client(conn), "Singers", {"SingerId", "FirstName"},
+                          ReadCoalescer::Options{}.SetMaxReads(1));
+  std::vector<future<StatusOr<absl::optional<Row>>>> results;
+  // Key 2 is requested twice, and key 3 does not exist.
+  for (std::int64_t id : {1, 2, 3, 2}) {
+    results.push_back(coalescer.Lookup(MakeKey(id)));
+  }
+  EXPECT_THAT(pending.sizes, ElementsAre(1));
+
+  pending.Complete(MakeRowStream({MakeSingerRow(1)}));
+  EXPECT_THAT(pending.sizes, ElementsAre(1, 3));
+  pending.Complete(MakeRowStream({MakeSingerRow(2)}));
+
+  std::vector<std::string> names;
+  for (auto& r : results) {
+    auto row = r.get();
+    ASSERT_STATUS_OK(row);
+    names.push_back(Name(row));
+  }
+  EXPECT_THAT(names, ElementsAre("name-1", "name-2", "<missing>", "name-2"));
+}
+
+TEST(ReadCoalescer, MaxKeysPerRead) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingReads pending;
+  ExpectPendingReads(*conn, pending);
+
+  ReadCoalescer coalescer(
+      Client(conn), "Singers", {"SingerId", "FirstName"},
+      ReadCoalescer::Options{}.SetMaxReads(1).SetMaxKeysPerRead(2));
+  std::vector<future<StatusOr<absl::optional<Row>>>> results;
+  for (std::int64_t id = 0; id != 6; ++id) {
+    results.push_back(coalescer.Lookup(MakeKey(id)));
+  }
+  while (!pending.reads.empty()) pending.Complete(MakeRowStream({}));
+  EXPECT_THAT(pending.sizes, ElementsAre(1, 2, 2, 1));
+  for (auto& r : results) EXPECT_STATUS_OK(r.get());
+}
+
+TEST(ReadCoalescer, ReadError) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingReads pending;
+  ExpectPendingReads(*conn, pending);
+
+  ReadCoalescer coalescer(Client(conn), "Singers", {"SingerId", "FirstName"},
+                          ReadCoalescer::Options{}.SetMaxReads(1));
+  auto r0 = coalescer.Lookup(MakeKey(std::int64_t{0}));
+  auto r1 = coalescer.Lookup(MakeKey(std::int64_t{1}));
+  pending.Complete(Status(StatusCode::kPermissionDenied, "uh-oh"));
+  pending.Complete(MakeRowStream({MakeSingerRow(1)}));
+  EXPECT_THAT(r0.get(), StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_EQ("name-1", Name(r1.get()));
+}
+
+TEST(ReadCoalescer, WaitForNoPendingRequests) {
+  auto conn = std::make_shared<MockConnection>();
+  PendingReads pending;
+  ExpectPendingReads(*conn, pending);
+
+  ReadCoalescer coalescer(Client(conn), "Singers", {"SingerId", "FirstName"});
+  EXPECT_TRUE(coalescer.AsyncWaitForNoPendingRequests().is_ready());
+  auto r0 = coalescer.Lookup(MakeKey(std::int64_t{0}));
+  auto done = coalescer.AsyncWaitForNoPendingRequests();
+  EXPECT_FALSE(done.is_ready());
+  pending.Complete(MakeRowStream({}));
+  EXPECT_TRUE(done.is_ready());
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
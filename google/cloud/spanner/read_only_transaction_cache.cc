@@ -0,0 +1,63 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/read_only_transaction_cache.h"
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+spanner_internal::SteadyClock::duration ToClockDuration(
+    std::chrono::nanoseconds d) {
+  return std::chrono::duration_cast<spanner_internal::SteadyClock::duration>(d);
+}
+
+}  // namespace
+
+// The transaction reads at `refresh_interval_` in the past, and the read
+// timestamp is chosen when the first read begins it, which is after it was
+// created. So, until it expires, its snapshot is at most
+// `2 * refresh_interval_ == max_staleness` old.
+ReadOnlyTransactionCache::ReadOnlyTransactionCache(
+    std::chrono::nanoseconds max_staleness,
+    std::shared_ptr<spanner_internal::SteadyClock> clock)
+    : refresh_interval_(max_staleness / 2),
+      clock_(std::move(clock)),
+      current_(MakeReadOnlyTransaction(
+          Transaction::ReadOnlyOptions(refresh_interval_))),
+      expiration_(clock_->Now() + ToClockDuration(refresh_interval_)) {}
+
+Transaction ReadOnlyTransactionCache::Get() {
+  auto const now = clock_->Now();
+  std::lock_guard<std::mutex> lk(mu_);
+  if (now >= expiration_) {
+    current_ = MakeReadOnlyTransaction(
+        Transaction::ReadOnlyOptions(refresh_interval_));
+    expiration_ = now + ToClockDuration(refresh_interval_);
+  }
+  return current_;
+}
+
+void ReadOnlyTransactionCache::Reset() {
+  std::lock_guard<std::mutex> lk(mu_);
+  expiration_ = clock_->Now();
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,99 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_READ_ONLY_TRANSACTION_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_READ_ONLY_TRANSACTION_CACHE_H
+
+#include "google/cloud/spanner/internal/clock.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/version.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Shares one read-only transaction among reads that tolerate stale data.
+ *
+ * Reads using `Transaction::SingleUseOptions` with a staleness bound each get
+ * their own session and their own snapshot. When many such reads run
+ * concurrently it is cheaper to run them in a single multi-use read-only
+ * transaction: the transaction is begun once, by the first read, and the
+ * other reads then run concurrently on the same session and see the same
+ * snapshot.
+ *
+ * `Get()` returns such a transaction. It reads at a timestamp
+ * `max_staleness / 2` in the past, so Cloud Spanner can serve the reads from
+ * any replica without waiting, and it is replaced by a new transaction
+ * `max_staleness / 2` after it was created. Reads in the returned
+ * transaction therefore never see data older than `max_staleness`.
+ *
+ * @par Example
+ * @code
+ * spanner::ReadOnlyTransactionCache cache(std::chrono::seconds(10));
+ * // In each of many threads:
+ * auto rows = client.ExecuteQuery(cache.Get(), spanner::SqlStatement(
+ *     "SELECT FirstName FROM Singers WHERE SingerId = 1"));
+ * @endcode
+ *
+ * @note An error beginning the transaction is reported to every read that
+ *     uses it. Call `Reset()` after such an error to start a new transaction
+ *     on the next `Get()`.
+ *
+ * @par Thread-safety
+ * Instances of this class are guaranteed to work when accessed concurrently
+ * from multiple threads.
+ */
+class ReadOnlyTransactionCache {
+ public:
+  /// Reads in the returned transactions are at most @p max_staleness old.
+  explicit ReadOnlyTransactionCache(std::chrono::nanoseconds max_staleness)
+      : ReadOnlyTransactionCache(
+            max_staleness,
+            std::make_shared<spanner_internal::SteadyClock>()) {}
+
+  /// Like the constructor above, with the clock used to age the transactions.
+  ReadOnlyTransactionCache(
+      std::chrono::nanoseconds max_staleness,
+      std::shared_ptr<spanner_internal::SteadyClock> clock);
+
+  ReadOnlyTransactionCache(ReadOnlyTransactionCache const&) = delete;
+  ReadOnlyTransactionCache& operator=(ReadOnlyTransactionCache const&) =
+      delete;
+
+  /// Returns the current transaction, or a new one if it is too old.
+  Transaction Get();
+
+  /// Makes the next `Get()` return a new transaction.
+  void Reset();
+
+ private:
+  std::chrono::nanoseconds const refresh_interval_;
+  std::shared_ptr<spanner_internal::SteadyClock> const clock_;
+
+  std::mutex mu_;
+  Transaction current_;
+  spanner_internal::SteadyClock::time_point expiration_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_READ_ONLY_TRANSACTION_CACHE_H
@@ -0,0 +1,80 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/read_only_transaction_cache.h"
+#include "google/cloud/spanner/internal/session.h"
+#include "google/cloud/spanner/testing/fake_clock.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_testing::FakeSteadyClock;
+
+TEST(ReadOnlyTransactionCache, ExactStaleness) {
+  ReadOnlyTransactionCache cache(std::chrono::seconds(10));
+  spanner_internal::Visit(
+      cache.Get(), [](spanner_internal::SessionHolder& /*session*/,
+                      StatusOr<google::spanner::v1::TransactionSelector>& s,
+                      std::int64_t) {
+        EXPECT_TRUE(s->has_begin());
+        EXPECT_TRUE(s->begin().has_read_only());
+        EXPECT_EQ(5, s->begin().read_only().exact_staleness().seconds());
+        EXPECT_EQ(0, s->begin().read_only().exact_staleness().nanos());
+        return 0;
+      });
+}
+
+TEST(ReadOnlyTransactionCache, SharedUntilExpired) {
+  auto clock = std::make_shared<FakeSteadyClock>();
+  ReadOnlyTransactionCache cache(std::chrono::seconds(10), clock);
+  auto const t0 = cache.Get();
+  EXPECT_EQ(t0, cache.Get());
+
+  clock->AdvanceTime(std::chrono::seconds(4));
+  EXPECT_EQ(t0, cache.Get());
+
+  clock->AdvanceTime(std::chrono::seconds(1));
+  auto const t1 = cache.Get();
+  EXPECT_NE(t0, t1);
+  EXPECT_EQ(t1, cache.Get());
+}
+
+TEST(ReadOnlyTransactionCache, Reset) {
+  auto clock = std::make_shared<FakeSteadyClock>();
+  ReadOnlyTransactionCache cache(std::chrono::seconds(10), clock);
+  auto const t0 = cache.Get();
+  cache.Reset();
+  auto const t1 = cache.Get();
+  EXPECT_NE(t0, t1);
+  EXPECT_EQ(t1, cache.Get());
+}
+
+TEST(ReadOnlyTransactionCache, ZeroStaleness) {
+  auto clock = std::make_shared<FakeSteadyClock>();
+  ReadOnlyTransactionCache cache(std::chrono::seconds(0), clock);
+  EXPECT_NE(cache.Get(), cache.Get());
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -18,9 +18,48 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
+namespace spanner_internal {
+inline namespace SPANNER_CLIENT_NS {
+
+StatusOr<spanner::ColumnBatch> ResultSourceInterface::NextBatch(
+    std::size_t max_rows) {
+  auto metadata = Metadata();
+  auto row_type = metadata ? metadata->row_type()
+                           : google::spanner::v1::StructType{};
+  auto names = std::make_shared<std::vector<std::string>>();
+  for (auto const& field : row_type.fields()) names->push_back(field.name());
+  auto batch = MakeColumnBatch(row_type, std::move(names));
+  while (batch.num_rows() < max_rows) {
+    auto row = NextRow();
+    if (!row) return std::move(row).status();
+    if (row->size() == 0) break;
+    if (row->size() != batch.num_columns()) {
+      return Status(StatusCode::kInternal,
+                    "row does not match the result set metadata");
+    }
+    std::size_t column = 0;
+    for (auto& value : std::move(*row).values()) {
+      auto status = AppendToColumnBatch(
+          batch, column++, spanner_internal::ToProto(std::move(value)).second);
+      if (!status.ok()) return status;
+    }
+  }
+  return batch;
+}
+
+Status ResultSourceInterface::NextRowValues(
+    std::vector<google::protobuf::Value>&) {
+  return Status(StatusCode::kUnimplemented, "NextRowValues() not supported");
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner_internal
+
 namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 namespace {
@@ -15,15 +15,21 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_RESULTS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_RESULTS_H
 
+#include "google/cloud/spanner/column_batch.h"
+#include "google/cloud/spanner/internal/tuple_utils.h"
 #include "google/cloud/spanner/row.h"
 #include "google/cloud/spanner/timestamp.h"
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/optional.h"
 #include "absl/types/optional.h"
 #include <google/spanner/v1/spanner.pb.h>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -34,8 +40,105 @@ class ResultSourceInterface {
   virtual ~ResultSourceInterface() = default;
   // Returns OK Status with an empty Row to indicate end-of-stream.
   virtual StatusOr<spanner::Row> NextRow() = 0;
+  // Returns up to `max_rows` rows, an empty batch indicates end-of-stream. The
+  // default implementation uses `NextRow()`.
+  virtual StatusOr<spanner::ColumnBatch> NextBatch(std::size_t max_rows);
+  // Returns the column types if the source supports `NextRowValues()`. The
+  // default implementation returns an empty vector.
+  virtual std::vector<std::shared_ptr<google::spanner::v1::Type const>>
+  ColumnTypes() {
+    return {};
+  }
+  // Moves the values of the next row into `values`, which is left empty to
+  // indicate end-of-stream. Only called if `ColumnTypes()` is not empty.
+  virtual Status NextRowValues(std::vector<google::protobuf::Value>& values);
   virtual absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() = 0;
   virtual absl::optional<google::spanner::v1::ResultSetStats> Stats() const = 0;
+  // Stops reading, cancelling the streaming RPC if it is still running. The
+  // next row is end-of-stream. The default implementation does nothing.
+  virtual void Cancel() {}
+};
+
+/**
+ * Decodes the rows of a `ResultSourceInterface` into `Tuple` objects.
+ *
+ * If the source supports `NextRowValues()` each tuple element is decoded
+ * directly from its `google::protobuf::Value`, without creating a
+ * `spanner::Row`, and the column types are checked only once, with the first
+ * row. Otherwise this uses `NextRow()` and `spanner::Row::get<Tuple>()`.
+ */
+template <typename Tuple>
+class TupleDecoder {
+ public:
+  explicit TupleDecoder(ResultSourceInterface& source) : source_(&source) {}
+
+  absl::optional<StatusOr<Tuple>> operator()() {
+    if (!initialized_) {
+      types_ = source_->ColumnTypes();
+      initialized_ = true;
+    }
+    if (types_.empty()) {
+      auto row = source_->NextRow();
+      if (!row) return StatusOr<Tuple>(std::move(row).status());
+      if (row->size() == 0) return absl::nullopt;
+      return std::move(*row).template get<Tuple>();
+    }
+    auto status = source_->NextRowValues(values_);
+    if (!status.ok()) return StatusOr<Tuple>(std::move(status));
+    if (values_.empty()) return absl::nullopt;
+    if (!types_checked_) {
+      status = CheckTypes();
+      if (!status.ok()) return StatusOr<Tuple>(std::move(status));
+      types_checked_ = true;
+    }
+    Tuple tup;
+    auto value = values_.begin();
+    auto type = types_.begin();
+    ForEach(tup, DecodeValue{status}, value, type);
+    if (!status.ok()) return StatusOr<Tuple>(std::move(status));
+    return StatusOr<Tuple>(std::move(tup));
+  }
+
+ private:
+  struct CheckType {
+    bool& ok;
+    template <typename T, typename It>
+    void operator()(T const&, It& type) const {
+      if (!TypeProtoIs<T>(**type++)) ok = false;
+    }
+  };
+
+  struct DecodeValue {
+    Status& status;
+    template <typename T, typename ValueIt, typename TypeIt>
+    void operator()(T& t, ValueIt& value, TypeIt& type) const {
+      auto x = GetValue<T>(std::move(*value++), **type++);
+      if (!x) {
+        status = std::move(x).status();
+      } else {
+        t = *std::move(x);
+      }
+    }
+  };
+
+  // Returns the same errors as `spanner::Row::get<Tuple>()`.
+  Status CheckTypes() const {
+    if (values_.size() != std::tuple_size<Tuple>::value) {
+      auto constexpr kMsg = "Tuple has the wrong number of elements";
+      return Status(StatusCode::kInvalidArgument, kMsg);
+    }
+    bool ok = true;
+    auto type = types_.begin();
+    ForEach(Tuple{}, CheckType{ok}, type);
+    if (!ok) return Status(StatusCode::kUnknown, "wrong type");
+    return Status();
+  }
+
+  ResultSourceInterface* source_;
+  bool initialized_ = false;
+  bool types_checked_ = false;
+  std::vector<std::shared_ptr<google::spanner::v1::Type const>> types_;
+  std::vector<google::protobuf::Value> values_;
 };
 
 }  // namespace SPANNER_CLIENT_NS
@@ -90,6 +193,31 @@ class RowStream {
   // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
   RowStreamIterator end() { return {}; }
 
+  /**
+   * Returns up to @p max_rows of the remaining rows, stored by column.
+   *
+   * This avoids creating a `Row` and a `Value` for each result, which matters
+   * for queries returning millions of rows. It can be mixed with iterating
+   * over the stream, each row is returned only once.
+   *
+   * @return the next batch, an empty batch (`num_rows() == 0`) at the end of
+   *     the stream, or the error that terminated the stream.
+   */
+  StatusOr<ColumnBatch> NextColumnBatch(std::size_t max_rows) {
+    return source_->NextBatch(max_rows);
+  }
+
+  /**
+   * Stops reading the remaining rows.
+   *
+   * Cancels the streaming RPC if it is still running, and discards any rows
+   * buffered by the library. After this call the stream has no more rows.
+   * Destroying the `RowStream` has the same effect, use this function to stop
+   * the RPC promptly while the `RowStream` is still needed, for example, to
+   * call `ReadTimestamp()`.
+   */
+  void Cancel() { source_->Cancel(); }
+
   /**
    * Retrieves the timestamp at which the read occurred.
    *
@@ -98,9 +226,27 @@ class RowStream {
   absl::optional<Timestamp> ReadTimestamp() const;
 
  private:
+  template <typename Tuple>
+  friend TupleStream<Tuple> StreamOf(RowStream& rows);
+
   std::unique_ptr<spanner_internal::ResultSourceInterface> source_;
 };
 
+/**
+ * A `StreamOf()` overload for `RowStream`.
+ *
+ * It produces the same sequence as the generic `StreamOf()`, but decodes each
+ * `Tuple` directly from the response, without creating an intermediate `Row`.
+ *
+ * @note ownership of @p rows is not transferred, so it must outlive the
+ *     returned `TupleStream`.
+ */
+template <typename Tuple>
+TupleStream<Tuple> StreamOf(RowStream& rows) {
+  return TupleStream<Tuple>(typename TupleStreamIterator<Tuple>::Source(
+      spanner_internal::TupleDecoder<Tuple>(*rows.source_)));
+}
+
 /**
  * Represents the result of a data modifying operation using
  * `spanner::Client::ExecuteDml()`.
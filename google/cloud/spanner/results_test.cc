@@ -21,8 +21,12 @@
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -36,6 +40,7 @@ using ::google::cloud::spanner_mocks::MockResultSetSource;
 using ::google::cloud::testing_util::IsProtoEqual;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Return;
 using ::testing::UnorderedPointwise;
@@ -117,6 +122,133 @@ TEST(RowStream, IterateError) {
   EXPECT_EQ(num_rows, 2);
 }
 
+// A source that supports `NextRowValues()`, to test the direct decoding in
+// `StreamOf()`.
+class RowValuesSource : public spanner_internal::ResultSourceInterface {
+ public:
+  RowValuesSource(std::vector<Value> const& column_types,
+                  std::vector<std::vector<Value>> rows, Status final_status)
+      : final_status_(std::move(final_status)) {
+    for (auto const& v : column_types) {
+      types_.push_back(std::make_shared<spanner_proto::Type const>(
+          spanner_internal::ToProto(v).first));
+    }
+    for (auto& row : rows) {
+      std::vector<google::protobuf::Value> values;
+      for (auto& v : row) {
+        values.push_back(spanner_internal::ToProto(std::move(v)).second);
+      }
+      rows_.push_back(std::move(values));
+    }
+  }
+
+  StatusOr<Row> NextRow() override {
+    ADD_FAILURE() << "unexpected NextRow() call";
+    return Status(StatusCode::kInternal, "unexpected NextRow() call");
+  }
+  std::vector<std::shared_ptr<spanner_proto::Type const>> ColumnTypes()
+      override {
+    return types_;
+  }
+  Status NextRowValues(std::vector<google::protobuf::Value>& values) override {
+    values.clear();
+    if (next_ == rows_.size()) return final_status_;
+    values = std::move(rows_[next_++]);
+    return Status();
+  }
+  absl::optional<spanner_proto::ResultSetMetadata> Metadata() override {
+    return {};
+  }
+  absl::optional<spanner_proto::ResultSetStats> Stats() const override {
+    return {};
+  }
+
+ private:
+  std::vector<std::shared_ptr<spanner_proto::Type const>> types_;
+  std::vector<std::vector<google::protobuf::Value>> rows_;
+  std::size_t next_ = 0;
+  Status final_status_;
+};
+
+TEST(RowStream, StreamOfDecodesValues) {
+  RowStream rows(absl::make_unique<RowValuesSource>(
+      std::vector<Value>{Value(0), Value(""), MakeNullValue<bool>()},
+      std::vector<std::vector<Value>>{
+          {Value(5), Value("foo"), Value(true)},
+          {Value(10), Value("bar"), MakeNullValue<bool>()},
+      },
+      Status()));
+
+  using RowType = std::tuple<std::int64_t, std::string, absl::optional<bool>>;
+  std::vector<RowType> actual;
+  for (auto& row : StreamOf<RowType>(rows)) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(*std::move(row));
+  }
+  EXPECT_THAT(actual,
+              ElementsAre(RowType(5, "foo", true),
+                          RowType(10, "bar", absl::optional<bool>())));
+}
+
+TEST(RowStream, StreamOfError) {
+  RowStream rows(absl::make_unique<RowValuesSource>(
+      std::vector<Value>{Value(0)},
+      std::vector<std::vector<Value>>{{Value(5)}},
+      Status(StatusCode::kUnknown, "oops")));
+
+  std::vector<StatusOr<std::tuple<std::int64_t>>> actual;
+  for (auto& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    actual.push_back(std::move(row));
+  }
+  ASSERT_EQ(2U, actual.size());
+  ASSERT_STATUS_OK(actual[0]);
+  EXPECT_EQ(5, std::get<0>(*actual[0]));
+  EXPECT_THAT(actual[1], StatusIs(StatusCode::kUnknown, "oops"));
+}
+
+TEST(RowStream, StreamOfWrongType) {
+  RowStream rows(absl::make_unique<RowValuesSource>(
+      std::vector<Value>{Value(0), Value("")},
+      std::vector<std::vector<Value>>{{Value(5), Value("foo")},
+                                      {Value(6), Value("bar")}},
+      Status()));
+
+  std::vector<StatusOr<std::tuple<std::int64_t, bool>>> actual;
+  for (auto& row : StreamOf<std::tuple<std::int64_t, bool>>(rows)) {
+    actual.push_back(std::move(row));
+  }
+  // As with `Row::get<Tuple>()`, the stream ends after the error.
+  ASSERT_EQ(1U, actual.size());
+  EXPECT_THAT(actual[0], StatusIs(StatusCode::kUnknown, "wrong type"));
+}
+
+TEST(RowStream, StreamOfWrongSize) {
+  RowStream rows(absl::make_unique<RowValuesSource>(
+      std::vector<Value>{Value(0), Value("")},
+      std::vector<std::vector<Value>>{{Value(5), Value("foo")}}, Status()));
+
+  std::vector<StatusOr<std::tuple<std::int64_t>>> actual;
+  for (auto& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    actual.push_back(std::move(row));
+  }
+  ASSERT_EQ(1U, actual.size());
+  EXPECT_THAT(actual[0], StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(RowStream, StreamOfUnexpectedNull) {
+  RowStream rows(absl::make_unique<RowValuesSource>(
+      std::vector<Value>{Value(0)},
+      std::vector<std::vector<Value>>{{MakeNullValue<std::int64_t>()}},
+      Status()));
+
+  std::vector<StatusOr<std::tuple<std::int64_t>>> actual;
+  for (auto& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    actual.push_back(std::move(row));
+  }
+  ASSERT_EQ(1U, actual.size());
+  EXPECT_THAT(actual[0], StatusIs(StatusCode::kUnknown, "null value"));
+}
+
 TEST(RowStream, TimestampNoTransaction) {
   auto mock_source = absl::make_unique<MockResultSetSource>();
   spanner_proto::ResultSetMetadata no_transaction;
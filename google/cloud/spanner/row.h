@@ -20,6 +20,7 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -34,6 +35,7 @@ namespace cloud {
 namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 class Row;
+class RowStream;
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
 
@@ -327,6 +329,12 @@ class TupleStreamIterator {
   using const_reference = value_type const&;
   ///@}
 
+  /**
+   * A function that returns a sequence of `StatusOr<Tuple>` objects. Returning
+   * an empty optional indicates that there are no more tuples to be returned.
+   */
+  using Source = std::function<absl::optional<value_type>()>;
+
   /// Default constructs an "end" iterator.
   TupleStreamIterator() = default;
 
@@ -336,6 +344,14 @@ class TupleStreamIterator {
     ParseTuple();
   }
 
+  /**
+   * Creates an iterator that will consume tuples from the given @p source,
+   * which must not be `nullptr`.
+   */
+  explicit TupleStreamIterator(Source source) : source_(std::move(source)) {
+    NextTuple();
+  }
+
   reference operator*() { return tup_; }
   pointer operator->() { return &tup_; }
 
@@ -345,6 +361,11 @@ class TupleStreamIterator {
   TupleStreamIterator& operator++() {
     if (!tup_) {
       it_ = end_;
+      source_ = nullptr;
+      return *this;
+    }
+    if (source_) {
+      NextTuple();
       return *this;
     }
     ++it_;
@@ -360,7 +381,7 @@ class TupleStreamIterator {
 
   friend bool operator==(TupleStreamIterator const& a,
                          TupleStreamIterator const& b) {
-    return a.it_ == b.it_;
+    return a.at_end() == b.at_end();
   }
 
   friend bool operator!=(TupleStreamIterator const& a,
@@ -374,9 +395,22 @@ class TupleStreamIterator {
     tup_ = *it_ ? std::move(*it_)->template get<Tuple>() : it_->status();
   }
 
+  void NextTuple() {
+    auto tup = source_();
+    if (!tup) {
+      source_ = nullptr;  // No more tuples to consume; become "end"
+      return;
+    }
+    tup_ = *std::move(tup);
+  }
+
+  // Without a `source_` both `RowStreamIterator`s are "end" iterators.
+  bool at_end() const { return !source_ && it_ == end_; }
+
   value_type tup_;
   RowStreamIterator it_;
   RowStreamIterator end_;
+  Source source_;  // nullptr when iterating over `it_`
 };
 
 /**
@@ -419,11 +453,16 @@ class TupleStream {
  private:
   template <typename T, typename RowRange>
   friend TupleStream<T> StreamOf(RowRange&& range);
+  template <typename T>
+  friend TupleStream<T> StreamOf(RowStream& rows);
 
   template <typename It>
   explicit TupleStream(It&& start, It&& end)
       : begin_(std::forward<It>(start), std::forward<It>(end)) {}
 
+  explicit TupleStream(typename iterator::Source source)
+      : begin_(std::move(source)) {}
+
   iterator begin_;
   iterator end_;
 };
@@ -0,0 +1,66 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_SESSION_POOL_STATS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_SESSION_POOL_STATS_H
+
+#include "google/cloud/spanner/version.h"
+#include <chrono>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Counters describing the behavior of a `Connection`'s session pool.
+ *
+ * The counters are cumulative since the connection was created. Use the
+ * difference between two snapshots to measure an interval.
+ *
+ * @see `Connection::GetSessionPoolStats()`
+ */
+struct SessionPoolStats {
+  /// Sessions handed out by the pool.
+  std::int64_t allocations = 0;
+
+  /// Allocations that found no free session, and waited for one to be
+  /// created or released.
+  std::int64_t allocation_waits = 0;
+
+  /// The total time spent by those allocations waiting for a session.
+  std::chrono::nanoseconds allocation_wait_time{0};
+
+  /// Allocations that failed because the pool was at its maximum size, with
+  /// `ActionOnExhaustion::kFail`.
+  std::int64_t allocations_exhausted = 0;
+
+  /// Sessions created by the pool.
+  std::int64_t sessions_created = 0;
+
+  /// `BatchCreateSessions` calls that failed.
+  std::int64_t session_create_failures = 0;
+
+  /// The number of sessions in the pool, and how many of those are free.
+  int total_sessions = 0;
+  int free_sessions = 0;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_SESSION_POOL_STATS_H
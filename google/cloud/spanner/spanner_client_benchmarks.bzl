@@ -19,6 +19,8 @@
 spanner_client_benchmarks = [
     "bytes_benchmark.cc",
     "internal/merge_chunk_benchmark.cc",
+    "mutations_benchmark.cc",
     "numeric_benchmark.cc",
     "row_benchmark.cc",
+    "sql_statement_benchmark.cc",
 ]
@@ -21,12 +21,14 @@ spanner_client_unit_tests = [
     "bytes_test.cc",
     "client_options_test.cc",
     "client_test.cc",
+    "column_batch_test.cc",
     "commit_options_test.cc",
     "connection_options_test.cc",
     "create_instance_request_builder_test.cc",
     "database_admin_client_test.cc",
     "database_admin_connection_test.cc",
     "database_test.cc",
+    "dml_batcher_test.cc",
     "instance_admin_client_test.cc",
     "instance_admin_connection_test.cc",
     "instance_test.cc",
@@ -41,19 +43,27 @@ spanner_client_unit_tests = [
     "internal/logging_spanner_stub_test.cc",
     "internal/merge_chunk_test.cc",
     "internal/metadata_spanner_stub_test.cc",
+    "internal/metrics_spanner_stub_test.cc",
     "internal/partial_result_set_resume_test.cc",
     "internal/partial_result_set_source_test.cc",
+    "internal/query_stats_result_source_test.cc",
+    "internal/read_ahead_result_set_reader_test.cc",
     "internal/session_pool_test.cc",
     "internal/spanner_stub_test.cc",
     "internal/status_utils_test.cc",
     "internal/transaction_impl_test.cc",
     "internal/tuple_utils_test.cc",
     "keys_test.cc",
+    "mutation_batcher_test.cc",
     "mutations_test.cc",
     "numeric_test.cc",
+    "parallel_query_test.cc",
     "partition_options_test.cc",
     "query_options_test.cc",
     "query_partition_test.cc",
+    "query_stats_sampler_test.cc",
+    "read_coalescer_test.cc",
+    "read_only_transaction_cache_test.cc",
     "read_options_test.cc",
     "read_partition_test.cc",
     "results_test.cc",
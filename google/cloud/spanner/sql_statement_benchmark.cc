@@ -0,0 +1,128 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/sql_statement.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+// The cost of encoding the statement of a parameterized point lookup, which is
+// paid on each `Client::ExecuteQuery()` call, compared with a prototype of a
+// "prepared statement" that encodes the SQL text and parameter types once, and
+// then binds only the parameter values for each call.
+//
+// ---------------------------------------------------------------------------
+// Benchmark                                 Time             CPU   Iterations
+// ---------------------------------------------------------------------------
+// BM_SqlStatementToProto                 1927 ns         1922 ns       362874
+// BM_PreparedStatementBind               2012 ns         1994 ns       344969
+// BM_PreparedStatementValuesOnly         1186 ns         1178 ns       598577
+//
+// The prepared statement is not faster: each `ExecuteSqlRequest` must own its
+// SQL text and parameter types, because the request is kept for stream
+// resumption and retries, and copying the cached encoding costs about as much
+// as creating it (the types are shared by each `Value`, so encoding a type is
+// a single proto copy). Only the "values only" lower bound, which does not
+// build a usable request, is cheaper. The library does not offer a prepared
+// statement API for this reason.
+
+auto constexpr kSql =
+    "SELECT FirstName, LastName, SingerInfo FROM Singers"
+    " WHERE SingerId = @id AND Tags = @tags";
+
+SqlStatement MakeStatement(std::int64_t id) {
+  return SqlStatement(kSql, {{"id", Value(id)},
+                             {"tags", Value(std::vector<std::string>{"a"})}});
+}
+
+std::vector<Value> MakeValues(std::int64_t id) {
+  return {Value(id), Value(std::vector<std::string>{"a"})};
+}
+
+void BM_SqlStatementToProto(benchmark::State& state) {
+  std::int64_t id = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spanner_internal::ToProto(MakeStatement(++id)));
+  }
+}
+BENCHMARK(BM_SqlStatementToProto);
+
+// The prototype: the SQL text and parameter types are encoded once, each call
+// copies them into the new request and encodes only the values.
+class PreparedStatementPrototype {
+ public:
+  // The values passed to `Bind()` are in the same order as @p names.
+  PreparedStatementPrototype(SqlStatement const& statement,
+                             std::vector<std::string> names)
+      : names_(std::move(names)), proto_(spanner_internal::ToProto(statement)) {
+    proto_.clear_params();
+  }
+
+  spanner_internal::SqlStatementProto Bind(std::vector<Value> values) const {
+    auto proto = proto_;
+    auto& fields = *proto.mutable_params()->mutable_fields();
+    for (std::size_t i = 0; i != names_.size(); ++i) {
+      fields[names_[i]] =
+          spanner_internal::ValueInternals::ValueProto(std::move(values[i]));
+    }
+    return proto;
+  }
+
+  std::vector<std::string> const& names() const { return names_; }
+
+ private:
+  std::vector<std::string> names_;
+  spanner_internal::SqlStatementProto proto_;
+};
+
+void BM_PreparedStatementBind(benchmark::State& state) {
+  PreparedStatementPrototype const prepared(MakeStatement(0), {"id", "tags"});
+  std::int64_t id = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(prepared.Bind(MakeValues(++id)));
+  }
+}
+BENCHMARK(BM_PreparedStatementBind);
+
+// A lower bound for any prepared statement: encode only the values, without
+// the SQL text and parameter types that each request needs.
+void BM_PreparedStatementValuesOnly(benchmark::State& state) {
+  PreparedStatementPrototype const prepared(MakeStatement(0), {"id", "tags"});
+  std::int64_t id = 0;
+  for (auto _ : state) {
+    google::protobuf::Struct params;
+    auto values = MakeValues(++id);
+    auto& fields = *params.mutable_fields();
+    for (std::size_t i = 0; i != values.size(); ++i) {
+      fields[prepared.names()[i]] =
+          spanner_internal::ValueInternals::ValueProto(std::move(values[i]));
+    }
+    benchmark::DoNotOptimize(params);
+  }
+}
+BENCHMARK(BM_PreparedStatementValuesOnly);
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
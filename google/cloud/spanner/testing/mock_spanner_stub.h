@@ -105,15 +105,37 @@ class MockSpannerStub : public google::cloud::spanner_internal::SpannerStub {
       (grpc::ClientContext&, google::spanner::v1::ReadRequest const&),
       (override));
 
+  MOCK_METHOD(std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                  google::spanner::v1::ResultSet>>,
+              AsyncRead,
+              (grpc::ClientContext&, google::spanner::v1::ReadRequest const&,
+               grpc::CompletionQueue*),
+              (override));
+
   MOCK_METHOD(StatusOr<google::spanner::v1::Transaction>, BeginTransaction,
               (grpc::ClientContext&,
                google::spanner::v1::BeginTransactionRequest const&),
               (override));
 
+  MOCK_METHOD(std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                  google::spanner::v1::Transaction>>,
+              AsyncBeginTransaction,
+              (grpc::ClientContext&,
+               google::spanner::v1::BeginTransactionRequest const&,
+               grpc::CompletionQueue*),
+              (override));
+
   MOCK_METHOD(StatusOr<google::spanner::v1::CommitResponse>, Commit,
               (grpc::ClientContext&, google::spanner::v1::CommitRequest const&),
               (override));
 
+  MOCK_METHOD(std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                  google::spanner::v1::CommitResponse>>,
+              AsyncCommit,
+              (grpc::ClientContext&, google::spanner::v1::CommitRequest const&,
+               grpc::CompletionQueue*),
+              (override));
+
   MOCK_METHOD(Status, Rollback,
               (grpc::ClientContext&,
                google::spanner::v1::RollbackRequest const&),
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/status.h"
 #include <google/protobuf/util/time_util.h>
 #include <string>
@@ -105,6 +107,12 @@ Status InvalidArgument(std::string message) {
 }  // namespace
 
 StatusOr<spanner::Timestamp> TimestampFromRFC3339(std::string const& s) {
+  std::int64_t seconds;
+  std::int32_t nanos;
+  if (google::cloud::internal::ParseRfc3339Fast(s, &seconds, &nanos)) {
+    return spanner::MakeTimestamp(absl::FromUnixSeconds(seconds) +
+                                  absl::Nanoseconds(nanos));
+  }
   absl::Time t;
   std::string err;
   if (absl::ParseTime(kParseSpec, s, &t, &err)) {
@@ -115,6 +123,13 @@ StatusOr<spanner::Timestamp> TimestampFromRFC3339(std::string const& s) {
 
 std::string TimestampToRFC3339(spanner::Timestamp ts) {
   auto const t = ts.get<absl::Time>().value();  // Cannot fail.
+  auto const seconds = absl::ToUnixSeconds(t);
+  auto const nanos =
+      absl::ToInt64Nanoseconds(t - absl::FromUnixSeconds(seconds));
+  char buffer[google::cloud::internal::kFormatRfc3339BufferSize];
+  auto const n = google::cloud::internal::FormatRfc3339To(
+      seconds, static_cast<std::int32_t>(nanos), buffer);
+  if (n != 0) return std::string(buffer, n);
   return absl::FormatTime(kFormatSpec, t, absl::UTCTimeZone());
 }
 
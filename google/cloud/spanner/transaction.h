@@ -221,6 +221,13 @@ struct TransactionInternals {
     return txn.impl_->Visit(std::forward<Functor>(f));
   }
 
+  template <typename Functor>
+  // NOLINTNEXTLINE(performance-unnecessary-value-param)
+  static VisitInvokeResult<Functor> AsyncVisit(spanner::Transaction txn,
+                                               Functor&& f) {
+    return txn.impl_->AsyncVisit(std::forward<Functor>(f));
+  }
+
   static spanner::Transaction MakeTransactionFromIds(
       std::string session_id, std::string transaction_id);
 };
@@ -239,6 +246,13 @@ VisitInvokeResult<Functor> Visit(spanner::Transaction txn, Functor&& f) {
   return TransactionInternals::Visit(std::move(txn), std::forward<Functor>(f));
 }
 
+template <typename Functor>
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+VisitInvokeResult<Functor> AsyncVisit(spanner::Transaction txn, Functor&& f) {
+  return TransactionInternals::AsyncVisit(std::move(txn),
+                                          std::forward<Functor>(f));
+}
+
 inline spanner::Transaction MakeTransactionFromIds(std::string session_id,
                                                    std::string transaction_id) {
   return TransactionInternals::MakeTransactionFromIds(
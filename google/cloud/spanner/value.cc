@@ -20,8 +20,10 @@
 #include <cstdlib>
 #include <iomanip>
 #include <ios>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -186,11 +188,38 @@ std::ostream& StreamHelper(std::ostream& os,  // NOLINT(misc-no-recursion)
 }  // namespace
 
 bool operator==(Value const& a, Value const& b) {
-  return Equal(a.type_, a.value_, b.type_, b.value_);
+  return Equal(a.type_proto(), a.value_, b.type_proto(), b.value_);
 }
 
 std::ostream& operator<<(std::ostream& os, Value const& v) {
-  return StreamHelper(os, v.value_, v.type_, StreamMode::kScalar);
+  return StreamHelper(os, v.value_, v.type_proto(), StreamMode::kScalar);
+}
+
+std::shared_ptr<google::spanner::v1::Type const> Value::MakeSharedTypeProto(
+    google::spanner::v1::Type t) {
+  using google::spanner::v1::TypeCode;
+  static auto const* const kScalarTypes = [] {
+    auto* types = new std::vector<std::shared_ptr<google::spanner::v1::Type>>(
+        google::spanner::v1::TypeCode_ARRAYSIZE);
+    for (auto code : {TypeCode::BOOL, TypeCode::INT64, TypeCode::FLOAT64,
+                      TypeCode::TIMESTAMP, TypeCode::DATE, TypeCode::STRING,
+                      TypeCode::BYTES, TypeCode::NUMERIC}) {
+      auto& type = (*types)[code];
+      type = std::make_shared<google::spanner::v1::Type>();
+      type->set_code(code);
+    }
+    return types;
+  }();
+  auto const code = static_cast<std::size_t>(t.code());
+  if (code < kScalarTypes->size() && (*kScalarTypes)[code]) {
+    return (*kScalarTypes)[code];
+  }
+  return std::make_shared<google::spanner::v1::Type const>(std::move(t));
+}
+
+google::spanner::v1::Type const& Value::DefaultTypeProto() {
+  static auto const* const kDefault = new google::spanner::v1::Type;
+  return *kDefault;
 }
 
 //
@@ -464,9 +493,18 @@ StatusOr<Numeric> Value::GetValue(Numeric const&,
   if (pv.kind_case() != google::protobuf::Value::kStringValue) {
     return Status(StatusCode::kUnknown, "missing NUMERIC");
   }
-  auto decoded = MakeNumeric(pv.string_value());
-  if (!decoded) return decoded.status();
-  return *decoded;
+  // Cloud Spanner only sends canonical NUMERIC representations, and so does
+  // `MakeValueProto(Numeric)`, so there is no need to validate it again.
+  return spanner_internal::MakeNumericFromCanonical(pv.string_value());
+}
+
+StatusOr<Numeric> Value::GetValue(Numeric const&, google::protobuf::Value&& pv,
+                                  google::spanner::v1::Type const&) {
+  if (pv.kind_case() != google::protobuf::Value::kStringValue) {
+    return Status(StatusCode::kUnknown, "missing NUMERIC");
+  }
+  return spanner_internal::MakeNumericFromCanonical(
+      std::move(*pv.mutable_string_value()));
 }
 
 StatusOr<Timestamp> Value::GetValue(Timestamp,
@@ -29,6 +29,7 @@
 #include <google/protobuf/struct.pb.h>
 #include <google/protobuf/util/message_differencer.h>
 #include <google/spanner/v1/type.pb.h>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <tuple>
@@ -291,26 +292,26 @@ class Value {
    */
   template <typename T>
   StatusOr<T> get() const& {
-    if (!TypeProtoIs(T{}, type_))
+    if (!TypeProtoIs(T{}, type_proto()))
       return Status(StatusCode::kUnknown, "wrong type");
     if (value_.kind_case() == google::protobuf::Value::kNullValue) {
       if (IsOptional<T>::value) return T{};
       return Status(StatusCode::kUnknown, "null value");
     }
-    return GetValue(T{}, value_, type_);
+    return GetValue(T{}, value_, type_proto());
   }
 
   /// @copydoc get()
   template <typename T>
   StatusOr<T> get() && {
-    if (!TypeProtoIs(T{}, type_))
+    if (!TypeProtoIs(T{}, type_proto()))
       return Status(StatusCode::kUnknown, "wrong type");
     if (value_.kind_case() == google::protobuf::Value::kNullValue) {
       if (IsOptional<T>::value) return T{};
       return Status(StatusCode::kUnknown, "null value");
     }
     auto tag = T{};  // Works around an odd msvc issue
-    return GetValue(std::move(tag), std::move(value_), type_);
+    return GetValue(std::move(tag), std::move(value_), type_proto());
   }
 
   /**
@@ -529,6 +530,8 @@ class Value {
   static StatusOr<Numeric> GetValue(Numeric const&,
                                     google::protobuf::Value const&,
                                     google::spanner::v1::Type const&);
+  static StatusOr<Numeric> GetValue(Numeric const&, google::protobuf::Value&&,
+                                    google::spanner::v1::Type const&);
   static StatusOr<Timestamp> GetValue(Timestamp, google::protobuf::Value const&,
                                       google::spanner::v1::Type const&);
   static StatusOr<CommitTimestamp> GetValue(CommitTimestamp,
@@ -634,14 +637,30 @@ class Value {
   struct PrivateConstructor {};
   template <typename T>
   Value(PrivateConstructor, T&& t)
-      : type_(MakeTypeProto(t)), value_(MakeValueProto(std::forward<T>(t))) {}
+      : type_(MakeSharedTypeProto(MakeTypeProto(t))),
+        value_(MakeValueProto(std::forward<T>(t))) {}
 
-  Value(google::spanner::v1::Type t, google::protobuf::Value v)
+  Value(std::shared_ptr<google::spanner::v1::Type const> t,
+        google::protobuf::Value v)
       : type_(std::move(t)), value_(std::move(v)) {}
 
+  // Returns a shared copy of @p t. All the values of a scalar type share the
+  // same instance, so constructing them does not allocate.
+  static std::shared_ptr<google::spanner::v1::Type const> MakeSharedTypeProto(
+      google::spanner::v1::Type t);
+
+  // The type of a default constructed (or moved-from) value.
+  static google::spanner::v1::Type const& DefaultTypeProto();
+
+  google::spanner::v1::Type const& type_proto() const {
+    return type_ ? *type_ : DefaultTypeProto();
+  }
+
   friend struct spanner_internal::SPANNER_CLIENT_NS::ValueInternals;
 
-  google::spanner::v1::Type type_;
+  // The type is immutable, and shared by all the values of a result set
+  // column. See `spanner_internal::FromProto()`.
+  std::shared_ptr<google::spanner::v1::Type const> type_;
   google::protobuf::Value value_;
 };
 
@@ -666,12 +685,49 @@ inline namespace SPANNER_CLIENT_NS {
 struct ValueInternals {
   static spanner::Value FromProto(google::spanner::v1::Type t,
                                   google::protobuf::Value v) {
+    return spanner::Value(
+        std::make_shared<google::spanner::v1::Type const>(std::move(t)),
+        std::move(v));
+  }
+
+  static spanner::Value FromProto(
+      std::shared_ptr<google::spanner::v1::Type const> t,
+      google::protobuf::Value v) {
     return spanner::Value(std::move(t), std::move(v));
   }
 
   static std::pair<google::spanner::v1::Type, google::protobuf::Value> ToProto(
       spanner::Value v) {
-    return std::make_pair(std::move(v.type_), std::move(v.value_));
+    return std::make_pair(v.type_proto(), std::move(v.value_));
+  }
+
+  // The value proto of @p v, without copying its type proto.
+  static google::protobuf::Value ValueProto(spanner::Value v) {
+    return std::move(v.value_);
+  }
+
+  // The value proto for @p t, without creating a `spanner::Value`.
+  template <typename T>
+  static google::protobuf::Value MakeValueProto(T const& t) {
+    return spanner::Value::MakeValueProto(t);
+  }
+
+  template <typename T>
+  static bool TypeProtoIs(google::spanner::v1::Type const& t) {
+    return spanner::Value::TypeProtoIs(T{}, t);
+  }
+
+  // The equivalent of `FromProto(t, v).get<T>()`, without checking that `t`
+  // matches `T`, and without creating a `spanner::Value`.
+  template <typename T>
+  static StatusOr<T> GetValue(google::protobuf::Value v,
+                              google::spanner::v1::Type const& t) {
+    if (v.kind_case() == google::protobuf::Value::kNullValue) {
+      if (spanner::Value::IsOptional<T>::value) return T{};
+      return Status(StatusCode::kUnknown, "null value");
+    }
+    auto tag = T{};
+    return spanner::Value::GetValue(std::move(tag), std::move(v), t);
   }
 };
 
@@ -680,11 +736,41 @@ inline spanner::Value FromProto(google::spanner::v1::Type t,
   return ValueInternals::FromProto(std::move(t), std::move(v));
 }
 
+/**
+ * Creates a `Value` that shares @p t with other values.
+ *
+ * Result sets create one `Type` per column, and share it with the values of
+ * every row, instead of copying the type proto for each cell.
+ */
+inline spanner::Value FromProto(
+    std::shared_ptr<google::spanner::v1::Type const> t,
+    google::protobuf::Value v) {
+  return ValueInternals::FromProto(std::move(t), std::move(v));
+}
+
 inline std::pair<google::spanner::v1::Type, google::protobuf::Value> ToProto(
     spanner::Value v) {
   return ValueInternals::ToProto(std::move(v));
 }
 
+/// Returns true if values of type @p t can be converted to `T`.
+template <typename T>
+bool TypeProtoIs(google::spanner::v1::Type const& t) {
+  return ValueInternals::TypeProtoIs<T>(t);
+}
+
+/**
+ * Converts @p v, of type @p t, to `T`.
+ *
+ * Callers must check that `TypeProtoIs<T>(t)`, which can be done once for all
+ * the values of a result set column.
+ */
+template <typename T>
+StatusOr<T> GetValue(google::protobuf::Value v,
+                     google::spanner::v1::Type const& t) {
+  return ValueInternals::GetValue<T>(std::move(v), t);
+}
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_internal
 }  // namespace cloud
@@ -22,6 +22,7 @@
 #include <cmath>
 #include <ios>
 #include <limits>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -773,6 +774,37 @@ TEST(Value, ProtoConversionStruct) {
   EXPECT_EQ("42", p.second.list_value().values(1).string_value());
 }
 
+TEST(Value, ProtoConversionSharedType) {
+  auto type = std::make_shared<google::spanner::v1::Type const>(
+      spanner_internal::ToProto(Value(std::vector<std::string>{})).first);
+  std::vector<Value> values;
+  for (auto const* s : {"foo", "bar"}) {
+    values.push_back(spanner_internal::FromProto(
+        type, spanner_internal::ToProto(Value(std::vector<std::string>{s}))
+                  .second));
+  }
+  EXPECT_EQ(Value(std::vector<std::string>{"foo"}), values[0]);
+  EXPECT_EQ(Value(std::vector<std::string>{"bar"}), values[1]);
+  EXPECT_EQ(3, type.use_count());
+
+  // The values own their type, and it is copied when converted to protos.
+  auto const p = spanner_internal::ToProto(values[1]);
+  type.reset();
+  EXPECT_EQ(google::spanner::v1::TypeCode::ARRAY, p.first.code());
+  EXPECT_EQ(std::vector<std::string>{"foo"},
+            *values[0].get<std::vector<std::string>>());
+}
+
+TEST(Value, MovedFrom) {
+  Value v(42);
+  Value moved = std::move(v);
+  EXPECT_EQ(42, *moved.get<std::int64_t>());
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_THAT(v.get<std::int64_t>(), Not(IsOk()));
+  v = Value(true);
+  EXPECT_EQ(true, *v.get<bool>());
+}
+
 void SetProtoKind(Value& v, google::protobuf::NullValue x) {
   auto p = spanner_internal::ToProto(v);
   p.second.set_null_value(x);
@@ -14,6 +14,7 @@
 
 #include "google/cloud/status.h"
 #include <sstream>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -71,6 +72,27 @@ std::ostream& operator<<(std::ostream& os, StatusCode code) {
   return os << StatusCodeToString(code);
 }
 
+std::string const& Status::EmptyMessage() {
+  static auto const* const kEmpty = new std::string;
+  return *kEmpty;
+}
+
+Status::Impl* Status::MovedFromSlow(Impl* impl) {
+  auto constexpr kMaxCode = static_cast<int>(StatusCode::kUnauthenticated);
+  static auto* const kMovedFrom = [] {
+    auto* v = new std::vector<Impl*>;
+    for (int c = 0; c <= kMaxCode; ++c) {
+      v->push_back(new Impl(static_cast<StatusCode>(c), {}, true));
+    }
+    return v;
+  }();
+  auto const c = static_cast<int>(impl->code);
+  if (c >= 0 && c <= kMaxCode) return (*kMovedFrom)[c];
+  // Unexpected codes are rare, share the state instead.
+  impl->refs.fetch_add(1, std::memory_order_relaxed);
+  return impl;
+}
+
 RuntimeStatusError::RuntimeStatusError(Status status)
     : std::runtime_error(StatusWhat(status)), status_(std::move(status)) {}
 
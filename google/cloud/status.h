@@ -16,9 +16,11 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STATUS_H
 
 #include "google/cloud/version.h"
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <tuple>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -66,16 +68,72 @@ class Status {
   Status() = default;
 
   explicit Status(StatusCode status_code, std::string message)
-      : code_(status_code), message_(std::move(message)) {}
-
-  bool ok() const { return code_ == StatusCode::kOk; }
-
-  StatusCode code() const { return code_; }
-  std::string const& message() const { return message_; }
+      : impl_(status_code == StatusCode::kOk && message.empty()
+                  ? nullptr
+                  : new Impl(status_code, std::move(message))) {}
+
+  // Copies share the (immutable) error details, and do not allocate.
+  Status(Status const& rhs) noexcept : impl_(rhs.impl_) { Ref(); }
+  Status& operator=(Status const& rhs) noexcept {
+    Status tmp(rhs);
+    std::swap(impl_, tmp.impl_);
+    return *this;
+  }
+  // A moved-from status keeps its code (but not its message), `StatusOr<T>`
+  // relies on this behavior.
+  Status(Status&& rhs) noexcept : impl_(rhs.impl_) {
+    rhs.impl_ = MovedFrom(impl_);
+  }
+  Status& operator=(Status&& rhs) noexcept {
+    if (this == &rhs) return *this;
+    Unref();
+    impl_ = rhs.impl_;
+    rhs.impl_ = MovedFrom(impl_);
+    return *this;
+  }
+  ~Status() { Unref(); }
+
+  bool ok() const { return impl_ == nullptr || impl_->code == StatusCode::kOk; }
+
+  StatusCode code() const {
+    return impl_ == nullptr ? StatusCode::kOk : impl_->code;
+  }
+  std::string const& message() const {
+    return impl_ == nullptr ? EmptyMessage() : impl_->message;
+  }
 
  private:
-  StatusCode code_{StatusCode::kOk};
-  std::string message_;
+  // The OK status, by far the most common, is a null pointer, so creating,
+  // copying, or destroying it costs almost nothing.
+  struct Impl {
+    Impl(StatusCode c, std::string m, bool s = false)
+        : code(c), message(std::move(m)), is_static(s) {}
+
+    std::atomic<int> refs{1};
+    StatusCode const code;
+    std::string const message;
+    // Moved-from statuses point to a static (and never deleted) `Impl`.
+    bool const is_static;
+  };
+
+  static std::string const& EmptyMessage();
+
+  // Returns the state for a status moved from one with @p impl.
+  static Impl* MovedFrom(Impl* impl) {
+    return impl == nullptr || impl->is_static ? impl : MovedFromSlow(impl);
+  }
+  static Impl* MovedFromSlow(Impl* impl);
+
+  void Ref() const {
+    if (impl_ == nullptr || impl_->is_static) return;
+    impl_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  void Unref() const {
+    if (impl_ == nullptr || impl_->is_static) return;
+    if (impl_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete impl_;
+  }
+
+  Impl* impl_ = nullptr;
 };
 
 inline std::ostream& operator<<(std::ostream& os, Status const& rhs) {
@@ -49,6 +49,52 @@ TEST(Status, StatusCodeToString) {
             StatusCodeToString(static_cast<StatusCode>(42)));
 }
 
+TEST(Status, DefaultIsOk) {
+  Status s;
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(StatusCode::kOk, s.code());
+  EXPECT_EQ("", s.message());
+  EXPECT_EQ(s, Status(StatusCode::kOk, ""));
+  // The OK status is a single (null) pointer.
+  EXPECT_EQ(sizeof(void*), sizeof(Status));
+}
+
+TEST(Status, OkWithMessage) {
+  Status s(StatusCode::kOk, "ok with message");
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ("ok with message", s.message());
+  EXPECT_NE(s, Status());
+}
+
+TEST(Status, CopySharesDetails) {
+  Status s(StatusCode::kUnavailable, "try again");
+  Status copy = s;
+  EXPECT_EQ(s, copy);
+  EXPECT_EQ(&s.message(), &copy.message());
+
+  Status assigned;
+  assigned = copy;
+  EXPECT_EQ(s, assigned);
+  assigned = Status();
+  EXPECT_TRUE(assigned.ok());
+  EXPECT_EQ(StatusCode::kUnavailable, copy.code());
+}
+
+TEST(Status, MoveKeepsCode) {
+  Status s(StatusCode::kNotFound, "not found");
+  Status moved = std::move(s);
+  EXPECT_EQ(StatusCode::kNotFound, moved.code());
+  EXPECT_EQ("not found", moved.message());
+  // `StatusOr<T>` relies on this behavior.
+  EXPECT_EQ(StatusCode::kNotFound, s.code());  // NOLINT
+
+  Status assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(StatusCode::kNotFound, assigned.code());
+  EXPECT_EQ("not found", assigned.message());
+  EXPECT_EQ(StatusCode::kNotFound, moved.code());  // NOLINT
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
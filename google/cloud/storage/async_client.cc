@@ -0,0 +1,140 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/async_client.h"
+#include "google/cloud/storage/grpc_plugin.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+StatusOr<std::string> ReadAll(ObjectBufferReader reader) {
+  auto constexpr kReadSize = 1024 * 1024;
+  std::string contents;
+  std::vector<char> buffer(kReadSize);
+  for (;;) {
+    auto n = reader.Read(MutableBuffer(buffer));
+    if (!n) return std::move(n).status();
+    if (*n == 0) break;
+    contents.append(buffer.data(), *n);
+  }
+  return contents;
+}
+
+StatusOr<ObjectMetadata> WriteAll(ObjectWriteStream stream,
+                                  std::string const& contents) {
+  stream.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  stream.Close();
+  return stream.metadata();
+}
+
+struct AsyncClientExecutor::State {
+  std::mutex mu;
+  std::condition_variable cv;
+  std::deque<std::function<void()>> queue;
+  bool shutdown = false;
+  std::vector<std::thread> threads;
+};
+
+// The threads keep the state alive, as the last reference to the executor may
+// be released by one of its own threads.
+void AsyncClientExecutor::Loop(std::shared_ptr<State> const& state) {
+  std::unique_lock<std::mutex> lk(state->mu);
+  for (;;) {
+    state->cv.wait(lk,
+                   [&] { return state->shutdown || !state->queue.empty(); });
+    if (state->queue.empty()) return;
+    auto f = std::move(state->queue.front());
+    state->queue.pop_front();
+    lk.unlock();
+    f();
+    f = nullptr;
+    lk.lock();
+  }
+}
+
+AsyncClientExecutor::AsyncClientExecutor(std::size_t thread_count)
+    : thread_count_((std::max)(thread_count, std::size_t{1})),
+      state_(std::make_shared<State>()) {
+  state_->threads.reserve(thread_count_);
+  for (std::size_t i = 0; i != thread_count_; ++i) {
+    state_->threads.emplace_back(Loop, state_);
+  }
+}
+
+AsyncClientExecutor::~AsyncClientExecutor() {
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lk(state_->mu);
+    state_->shutdown = true;
+    threads.swap(state_->threads);
+  }
+  state_->cv.notify_all();
+  for (auto& t : threads) {
+    if (t.get_id() == std::this_thread::get_id()) {
+      t.detach();
+      continue;
+    }
+    t.join();
+  }
+}
+
+void AsyncClientExecutor::Schedule(std::function<void()> f) {
+  {
+    std::lock_guard<std::mutex> lk(state_->mu);
+    state_->queue.push_back(std::move(f));
+  }
+  state_->cv.notify_one();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+
+namespace storage_experimental {
+inline namespace STORAGE_CLIENT_NS {
+
+namespace {
+
+std::size_t AsyncClientConcurrency(Options const& opts) {
+  if (opts.has<AsyncClientConcurrencyOption>()) {
+    return opts.get<AsyncClientConcurrencyOption>();
+  }
+  return (std::max)(std::thread::hardware_concurrency(), 1U);
+}
+
+}  // namespace
+
+AsyncClient::AsyncClient(storage::Client client, Options const& opts)
+    : client_(std::move(client)),
+      executor_(std::make_shared<storage::internal::AsyncClientExecutor>(
+          AsyncClientConcurrency(opts))) {}
+
+AsyncClient DefaultAsyncClient(Options opts) {
+  auto client = DefaultGrpcClient(opts);
+  return AsyncClient(std::move(client), opts);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage_experimental
+}  // namespace cloud
+}  // namespace google
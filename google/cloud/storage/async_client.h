@@ -0,0 +1,312 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_ASYNC_CLIENT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_ASYNC_CLIENT_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/tuple.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage_experimental {
+inline namespace STORAGE_CLIENT_NS {
+
+/**
+ * The maximum number of concurrent operations in an `AsyncClient`.
+ *
+ * Each operation blocks one of the client's threads until it completes, this
+ * option sets the number of threads. The default is the number of hardware
+ * threads, or 1 if that cannot be determined.
+ */
+struct AsyncClientConcurrencyOption {
+  using Type = std::size_t;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage_experimental
+
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Runs functions on a fixed number of threads.
+ *
+ * Functions scheduled while all the threads are busy are queued. The
+ * destructor runs any queued functions before stopping the threads.
+ */
+class AsyncClientExecutor {
+ public:
+  explicit AsyncClientExecutor(std::size_t thread_count);
+  ~AsyncClientExecutor();
+
+  AsyncClientExecutor(AsyncClientExecutor const&) = delete;
+  AsyncClientExecutor& operator=(AsyncClientExecutor const&) = delete;
+
+  void Schedule(std::function<void()> f);
+
+  std::size_t thread_count() const { return thread_count_; }
+
+ private:
+  struct State;
+  static void Loop(std::shared_ptr<State> const& state);
+
+  std::size_t thread_count_;
+  std::shared_ptr<State> state_;
+};
+
+/// Read the full contents of @p reader into a string.
+StatusOr<std::string> ReadAll(ObjectBufferReader reader);
+
+/// Upload @p contents using @p stream, and return the object metadata.
+StatusOr<ObjectMetadata> WriteAll(ObjectWriteStream stream,
+                                  std::string const& contents);
+
+struct AsyncReadObjectApplyHelper {
+  template <typename... Options>
+  StatusOr<std::string> operator()(Options&&... options) const {
+    return ReadAll(client.ReadObjectToBuffers(
+        bucket_name, object_name, std::forward<Options>(options)...));
+  }
+
+  Client& client;
+  std::string const& bucket_name;
+  std::string const& object_name;
+};
+
+struct AsyncWriteObjectApplyHelper {
+  template <typename... Options>
+  StatusOr<ObjectMetadata> operator()(Options&&... options) const {
+    return WriteAll(client.WriteObject(bucket_name, object_name,
+                                       std::forward<Options>(options)...),
+                    contents);
+  }
+
+  Client& client;
+  std::string const& bucket_name;
+  std::string const& object_name;
+  std::string const& contents;
+};
+
+struct AsyncInsertObjectApplyHelper {
+  template <typename... Options>
+  StatusOr<ObjectMetadata> operator()(Options&&... options) const {
+    return client.InsertObject(bucket_name, object_name, contents,
+                               std::forward<Options>(options)...);
+  }
+
+  Client& client;
+  std::string const& bucket_name;
+  std::string const& object_name;
+  std::string const& contents;
+};
+
+struct AsyncDeleteObjectApplyHelper {
+  template <typename... Options>
+  Status operator()(Options&&... options) const {
+    return client.DeleteObject(bucket_name, object_name,
+                               std::forward<Options>(options)...);
+  }
+
+  Client& client;
+  std::string const& bucket_name;
+  std::string const& object_name;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+
+namespace storage_experimental {
+inline namespace STORAGE_CLIENT_NS {
+
+/**
+ * Runs GCS object operations asynchronously, returning `future<>` values.
+ *
+ * The operations are blocking `storage::Client` calls, executed on a pool of
+ * threads owned by this client. At most `AsyncClientConcurrencyOption`
+ * operations run at the same time, each blocking one thread until it
+ * completes. Operations beyond that limit are queued until a thread becomes
+ * available. The pool is separate from any `CompletionQueue` in the
+ * application, so long transfers never starve other asynchronous work.
+ *
+ * Combined with `DefaultGrpcClient()` the operations use the gRPC transport,
+ * see `DefaultAsyncClient()`.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * namespace gcs_ex = google::cloud::storage_experimental;
+ * auto client = gcs_ex::AsyncClient(gcs::Client());
+ * std::vector<google::cloud::future<google::cloud::StatusOr<std::string>>> v;
+ * for (auto const& name : {"object-1", "object-2", "object-3"}) {
+ *   v.push_back(client.AsyncReadObject("my-bucket", name));
+ * }
+ * for (auto& f : v) {
+ *   auto contents = f.get();
+ *   if (!contents) throw std::runtime_error(contents.status().message());
+ *   std::cout << "read " << contents->size() << " bytes\n";
+ * }
+ * @endcode
+ *
+ * @warning this is an experimental feature, and subject to change without
+ *     notice.
+ */
+class AsyncClient {
+ public:
+  /**
+   * Creates a client running operations on new background threads.
+   *
+   * The number of threads is set by `AsyncClientConcurrencyOption` in
+   * @p opts. The threads complete any pending operations, and stop, when the
+   * last copy of this object is deleted.
+   */
+  explicit AsyncClient(storage::Client client, Options const& opts = {});
+
+  /// The maximum number of operations running at the same time.
+  std::size_t concurrency() const { return executor_->thread_count(); }
+
+  /**
+   * Reads the contents of an object.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param options a list of optional query parameters and/or request headers,
+   *     the valid types are the same as in `storage::Client::ReadObject()`.
+   */
+  template <typename... RequestOptions>
+  future<StatusOr<std::string>> AsyncReadObject(std::string bucket_name,
+                                                std::string object_name,
+                                                RequestOptions&&... options) {
+    auto client = client_;
+    auto opts = std::make_tuple(std::forward<RequestOptions>(options)...);
+    return Submit([client, bucket_name, object_name, opts]() mutable {
+      return google::cloud::internal::apply(
+          storage::internal::AsyncReadObjectApplyHelper{client, bucket_name,
+                                                        object_name},
+          std::move(opts));
+    });
+  }
+
+  /**
+   * Uploads @p contents using a resumable upload.
+   *
+   * @param bucket_name the name of the bucket that will contain the object.
+   * @param object_name the name of the object to be created.
+   * @param contents the contents (media) for the new object.
+   * @param options a list of optional query parameters and/or request headers,
+   *     the valid types are the same as in `storage::Client::WriteObject()`.
+   */
+  template <typename... RequestOptions>
+  future<StatusOr<storage::ObjectMetadata>> AsyncWriteObject(
+      std::string bucket_name, std::string object_name, std::string contents,
+      RequestOptions&&... options) {
+    auto client = client_;
+    auto opts = std::make_tuple(std::forward<RequestOptions>(options)...);
+    return Submit([client, bucket_name, object_name, contents, opts]() mutable {
+      return google::cloud::internal::apply(
+          storage::internal::AsyncWriteObjectApplyHelper{client, bucket_name,
+                                                         object_name, contents},
+          std::move(opts));
+    });
+  }
+
+  /**
+   * Creates an object given its name and contents.
+   *
+   * @param bucket_name the name of the bucket that will contain the object.
+   * @param object_name the name of the object to be created.
+   * @param contents the contents (media) for the new object.
+   * @param options a list of optional query parameters and/or request headers,
+   *     the valid types are the same as in `storage::Client::InsertObject()`.
+   */
+  template <typename... RequestOptions>
+  future<StatusOr<storage::ObjectMetadata>> AsyncInsertObject(
+      std::string bucket_name, std::string object_name, std::string contents,
+      RequestOptions&&... options) {
+    auto client = client_;
+    auto opts = std::make_tuple(std::forward<RequestOptions>(options)...);
+    return Submit([client, bucket_name, object_name, contents, opts]() mutable {
+      return google::cloud::internal::apply(
+          storage::internal::AsyncInsertObjectApplyHelper{
+              client, bucket_name, object_name, contents},
+          std::move(opts));
+    });
+  }
+
+  /**
+   * Deletes an object.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be deleted.
+   * @param options a list of optional query parameters and/or request headers,
+   *     the valid types are the same as in `storage::Client::DeleteObject()`.
+   */
+  template <typename... RequestOptions>
+  future<Status> AsyncDeleteObject(std::string bucket_name,
+                                   std::string object_name,
+                                   RequestOptions&&... options) {
+    auto client = client_;
+    auto opts = std::make_tuple(std::forward<RequestOptions>(options)...);
+    return Submit([client, bucket_name, object_name, opts]() mutable {
+      return google::cloud::internal::apply(
+          storage::internal::AsyncDeleteObjectApplyHelper{client, bucket_name,
+                                                          object_name},
+          std::move(opts));
+    });
+  }
+
+ private:
+  template <typename Functor,
+            typename R = google::cloud::internal::invoke_result_t<Functor>>
+  future<R> Submit(Functor&& functor) {
+    auto p = std::make_shared<promise<R>>();
+    auto f = p->get_future();
+    executor_->Schedule([p, functor]() mutable { p->set_value(functor()); });
+    return f;
+  }
+
+  storage::Client client_;
+  std::shared_ptr<storage::internal::AsyncClientExecutor> executor_;
+};
+
+/**
+ * Create an `AsyncClient` using the gRPC transport.
+ *
+ * @param opts the configuration parameters for the client and the background
+ *     threads.
+ *
+ * @warning this is an experimental feature, and subject to change without
+ *     notice.
+ */
+AsyncClient DefaultAsyncClient(Options opts = {});
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage_experimental
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_ASYNC_CLIENT_H
@@ -0,0 +1,240 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/async_client.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/client_unit_test.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage_experimental {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::IfGenerationMatch;
+using ::google::cloud::storage::ObjectMetadata;
+using ::google::cloud::storage::internal::DeleteObjectRequest;
+using ::google::cloud::storage::internal::EmptyResponse;
+using ::google::cloud::storage::internal::InsertObjectMediaRequest;
+using ::google::cloud::storage::internal::ObjectMetadataParser;
+using ::google::cloud::storage::internal::ObjectReadSource;
+using ::google::cloud::storage::internal::ReadObjectRangeRequest;
+using ::google::cloud::storage::internal::ReadSourceResult;
+using ::google::cloud::storage::internal::ResumableUploadRequest;
+using ::google::cloud::storage::internal::ResumableUploadResponse;
+using ::google::cloud::storage::internal::ResumableUploadSession;
+using ::google::cloud::storage::testing::MockObjectReadSource;
+using ::google::cloud::storage::testing::MockResumableUploadSession;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+
+class AsyncClientTest
+    : public ::google::cloud::storage::testing::ClientUnitTest {
+ protected:
+  AsyncClient CreateAsyncClient() {
+    return AsyncClient(ClientForMock(),
+                       Options{}.set<AsyncClientConcurrencyOption>(2));
+  }
+};
+
+ObjectMetadata CreateMetadata(std::string const& name) {
+  return ObjectMetadataParser::FromString(
+             R"""({"bucket": "test-bucket", "name": ")""" + name + R"""("})""")
+      .value();
+}
+
+TEST_F(AsyncClientTest, ReadObject) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&contents](ReadObjectRangeRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        auto source = absl::make_unique<MockObjectReadSource>();
+        auto open = std::make_shared<bool>(true);
+        EXPECT_CALL(*source, IsOpen).WillRepeatedly([open] { return *open; });
+        EXPECT_CALL(*source, Read)
+            .WillOnce([open, contents](char* buf, std::size_t n) {
+              EXPECT_LE(contents.size(), n);
+              std::memcpy(buf, contents.data(), contents.size());
+              *open = false;
+              return make_status_or(ReadSourceResult{contents.size(), {}});
+            });
+        return make_status_or(
+            std::unique_ptr<ObjectReadSource>(std::move(source)));
+      });
+
+  auto client = CreateAsyncClient();
+  auto actual = client.AsyncReadObject("test-bucket", "test-object").get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents, *actual);
+}
+
+TEST_F(AsyncClientTest, ReadObjectError) {
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce(Return(
+          StatusOr<std::unique_ptr<ObjectReadSource>>(PermanentError())));
+
+  auto client = CreateAsyncClient();
+  auto actual = client.AsyncReadObject("test-bucket", "test-object").get();
+  EXPECT_THAT(actual, StatusIs(PermanentError().code()));
+}
+
+TEST_F(AsyncClientTest, WriteObject) {
+  auto const expected = CreateMetadata("test-object");
+  EXPECT_CALL(*mock_, CreateResumableSession)
+      .WillOnce([&expected](ResumableUploadRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        auto session = absl::make_unique<MockResumableUploadSession>();
+        EXPECT_CALL(*session, done()).WillRepeatedly(Return(false));
+        EXPECT_CALL(*session, next_expected_byte()).WillRepeatedly(Return(0));
+        EXPECT_CALL(*session, UploadFinalChunk)
+            .WillOnce(Return(make_status_or(ResumableUploadResponse{
+                "fake-url", 0, expected, ResumableUploadResponse::kDone, {}})));
+        return make_status_or(
+            std::unique_ptr<ResumableUploadSession>(std::move(session)));
+      });
+
+  auto client = CreateAsyncClient();
+  auto actual =
+      client.AsyncWriteObject("test-bucket", "test-object", "contents").get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(expected, *actual);
+}
+
+TEST_F(AsyncClientTest, InsertObject) {
+  auto const expected = CreateMetadata("test-object");
+  EXPECT_CALL(*mock_, InsertObjectMedia)
+      .WillOnce([&expected](InsertObjectMediaRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        EXPECT_EQ("contents", request.contents());
+        EXPECT_EQ(42, request.GetOption<IfGenerationMatch>().value_or(0));
+        return make_status_or(expected);
+      });
+
+  auto client = CreateAsyncClient();
+  auto actual = client
+                    .AsyncInsertObject("test-bucket", "test-object",
+                                       "contents", IfGenerationMatch(42))
+                    .get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(expected, *actual);
+}
+
+TEST_F(AsyncClientTest, DeleteObject) {
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce([](DeleteObjectRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        EXPECT_EQ(42, request.GetOption<IfGenerationMatch>().value_or(0));
+        return make_status_or(EmptyResponse{});
+      });
+
+  auto client = CreateAsyncClient();
+  auto status = client
+                    .AsyncDeleteObject("test-bucket", "test-object",
+                                       IfGenerationMatch(42))
+                    .get();
+  EXPECT_STATUS_OK(status);
+}
+
+TEST_F(AsyncClientTest, ManyOperations) {
+  auto constexpr kCount = 100;
+  std::mutex mu;
+  int running = 0;
+  int max_running = 0;
+  EXPECT_CALL(*mock_, DeleteObject)
+      .Times(kCount)
+      .WillRepeatedly([&](DeleteObjectRequest const&) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          max_running = (std::max)(max_running, ++running);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lk(mu);
+        --running;
+        return make_status_or(EmptyResponse{});
+      });
+
+  auto client = CreateAsyncClient();
+  EXPECT_EQ(2U, client.concurrency());
+  std::vector<future<Status>> pending;
+  for (int i = 0; i != kCount; ++i) {
+    pending.push_back(client.AsyncDeleteObject(
+        "test-bucket", "test-object-" + std::to_string(i)));
+  }
+  for (auto& f : pending) EXPECT_STATUS_OK(f.get());
+  EXPECT_LE(max_running, 2);
+}
+
+TEST_F(AsyncClientTest, DefaultConcurrency) {
+  AsyncClient client(ClientForMock());
+  EXPECT_LE(1U, client.concurrency());
+}
+
+TEST_F(AsyncClientTest, PendingOperationsCompleteOnDelete) {
+  auto constexpr kCount = 10;
+  EXPECT_CALL(*mock_, DeleteObject)
+      .Times(kCount)
+      .WillRepeatedly(Return(make_status_or(EmptyResponse{})));
+
+  std::vector<future<Status>> pending;
+  {
+    auto client = CreateAsyncClient();
+    for (int i = 0; i != kCount; ++i) {
+      pending.push_back(client.AsyncDeleteObject(
+          "test-bucket", "test-object-" + std::to_string(i)));
+    }
+  }
+  for (auto& f : pending) EXPECT_STATUS_OK(f.get());
+}
+
+TEST_F(AsyncClientTest, DeleteFromOwnThread) {
+  promise<void> started;
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce([&started](DeleteObjectRequest const&) {
+        started.get_future().get();
+        return make_status_or(EmptyResponse{});
+      });
+
+  auto client = absl::make_unique<AsyncClient>(CreateAsyncClient());
+  auto done = client->AsyncDeleteObject("test-bucket", "test-object")
+                  .then([&client](future<Status> f) {
+                    // Release the last reference from the client's threads.
+                    client.reset();
+                    return f.get();
+                  });
+  started.set_value();
+  EXPECT_STATUS_OK(done.get());
+  EXPECT_EQ(nullptr, client);
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage_experimental
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,61 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/batch_request.h"
+#include <algorithm>
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::vector<StatusOr<ObjectMetadata>> ExecuteBatchImpl(
+    RawClient& client, std::vector<ExecuteBatchRequest::Operation> operations) {
+  std::vector<StatusOr<ObjectMetadata>> results;
+  results.reserve(operations.size());
+  auto begin = operations.begin();
+  while (begin != operations.end()) {
+    auto const count = (std::min)(
+        kMaxBatchOperations,
+        static_cast<std::size_t>(std::distance(begin, operations.end())));
+    auto end = std::next(begin, static_cast<std::ptrdiff_t>(count));
+    ExecuteBatchRequest request(
+        {std::make_move_iterator(begin), std::make_move_iterator(end)});
+    begin = end;
+    auto response = client.ExecuteBatch(request);
+    if (!response) {
+      results.insert(results.end(), count, response.status());
+      continue;
+    }
+    std::move(response->results.begin(), response->results.end(),
+              std::back_inserter(results));
+  }
+  return results;
+}
+
+}  // namespace internal
+
+std::vector<StatusOr<ObjectMetadata>> ExecuteBatch(Client client,
+                                                   BatchRequest batch) {
+  return internal::ExecuteBatchImpl(
+      *internal::ClientImplDetails::GetRawClient(client),
+      std::move(batch.operations_));
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,129 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_REQUEST_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_REQUEST_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/batch_requests.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/// The implementation of `ExecuteBatch()`.
+std::vector<StatusOr<ObjectMetadata>> ExecuteBatchImpl(
+    RawClient& client, std::vector<ExecuteBatchRequest::Operation> operations);
+}  // namespace internal
+
+/**
+ * A list of object operations to send to the service using batch requests.
+ *
+ * Applications that need to delete, or change the metadata of, many objects
+ * can reduce the number of round-trips by adding the operations to an
+ * `BatchRequest` and calling `ExecuteBatch()`. The operations are sent in
+ * batches of (at most) 100 operations, each batch is a single HTTP request.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = ::google::cloud::storage;
+ * gcs::BatchRequest batch;
+ * for (auto const& name : names) batch.DeleteObject("my-bucket", name);
+ * for (auto& result : gcs::ExecuteBatch(client, std::move(batch))) {
+ *   if (!result) std::cerr << result.status() << "\n";
+ * }
+ * @endcode
+ */
+class BatchRequest {
+ public:
+  BatchRequest() = default;
+
+  /**
+   * Adds a request to delete an object.
+   *
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation are the same as in
+   *     `Client::DeleteObject()`.
+   */
+  template <typename... Options>
+  BatchRequest& DeleteObject(std::string bucket_name, std::string object_name,
+                             Options&&... options) {
+    internal::DeleteObjectRequest request(std::move(bucket_name),
+                                          std::move(object_name));
+    request.set_multiple_options(std::forward<Options>(options)...);
+    operations_.emplace_back(std::move(request));
+    return *this;
+  }
+
+  /**
+   * Adds a request to patch the metadata of an object.
+   *
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation are the same as in
+   *     `Client::PatchObject()`.
+   */
+  template <typename... Options>
+  BatchRequest& PatchObject(std::string bucket_name, std::string object_name,
+                            ObjectMetadataPatchBuilder const& builder,
+                            Options&&... options) {
+    internal::PatchObjectRequest request(std::move(bucket_name),
+                                         std::move(object_name), builder);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    operations_.emplace_back(std::move(request));
+    return *this;
+  }
+
+  std::size_t size() const { return operations_.size(); }
+  bool empty() const { return operations_.empty(); }
+
+ private:
+  friend std::vector<StatusOr<ObjectMetadata>> ExecuteBatch(
+      Client client, BatchRequest batch);
+
+  std::vector<internal::ExecuteBatchRequest::Operation> operations_;
+};
+
+/**
+ * Executes the operations in @p batch using batch requests.
+ *
+ * @return the result of each operation, in the same order as they were added
+ *     to @p batch. Successful deletes return an empty `ObjectMetadata`,
+ *     successful patches return the updated metadata. If a batch request
+ *     fails all the operations in it report the same error.
+ *
+ * @par Idempotency
+ * The operations are retried only as a group, if the HTTP request for the
+ * batch fails. A batch request is retried only if all its operations are
+ * idempotent. Failures of individual operations are not retried, the
+ * application can add these operations to a new batch.
+ */
+std::vector<StatusOr<ObjectMetadata>> ExecuteBatch(Client client,
+                                                   BatchRequest batch);
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_REQUEST_H
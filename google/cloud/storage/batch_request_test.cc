@@ -0,0 +1,109 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/batch_request.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ExecuteBatchRequest;
+using ::google::cloud::storage::internal::ExecuteBatchResponse;
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+
+/// Return the results for a batch where only the patch requests succeed.
+ExecuteBatchResponse PatchesSucceed(ExecuteBatchRequest const& r) {
+  ExecuteBatchResponse response;
+  for (auto const& op : r.operations()) {
+    if (absl::holds_alternative<internal::PatchObjectRequest>(op)) {
+      response.results.emplace_back(ObjectMetadata{});
+    } else {
+      response.results.emplace_back(Status(StatusCode::kNotFound, "nope"));
+    }
+  }
+  return response;
+}
+
+TEST(BatchRequestTest, SplitsLargeBatches) {
+  auto mock = std::make_shared<MockClient>();
+  std::vector<std::size_t> sizes;
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .Times(3)
+      .WillRepeatedly([&sizes](ExecuteBatchRequest const& r) {
+        sizes.push_back(r.operations().size());
+        return make_status_or(PatchesSucceed(r));
+      });
+
+  BatchRequest batch;
+  for (int i = 0; i != 250; ++i) {
+    auto name = "obj-" + std::to_string(i);
+    if (i % 2 == 0) {
+      batch.DeleteObject("test-bucket", name, Generation(i + 1));
+    } else {
+      batch.PatchObject("test-bucket", name,
+                        ObjectMetadataPatchBuilder().SetContentType("a/b"));
+    }
+  }
+  EXPECT_EQ(250, batch.size());
+  auto results =
+      ExecuteBatch(testing::ClientFromMock(mock), std::move(batch));
+  EXPECT_THAT(sizes, ::testing::ElementsAre(100, 100, 50));
+  ASSERT_EQ(250, results.size());
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    if (i % 2 == 0) {
+      EXPECT_THAT(results[i], StatusIs(StatusCode::kNotFound)) << "i=" << i;
+    } else {
+      EXPECT_STATUS_OK(results[i]) << "i=" << i;
+    }
+  }
+}
+
+TEST(BatchRequestTest, BatchFailure) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ExecuteBatch).WillOnce(Return(PermanentError()));
+
+  BatchRequest batch;
+  batch.DeleteObject("test-bucket", "obj-1", Generation(1))
+      .DeleteObject("test-bucket", "obj-2", Generation(1));
+  auto results =
+      ExecuteBatch(testing::ClientFromMock(mock), std::move(batch));
+  ASSERT_EQ(2, results.size());
+  EXPECT_THAT(results[0], StatusIs(PermanentError().code()));
+  EXPECT_THAT(results[1], StatusIs(PermanentError().code()));
+}
+
+TEST(BatchRequestTest, Empty) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ExecuteBatch).Times(0);
+  BatchRequest batch;
+  EXPECT_TRUE(batch.empty());
+  auto results =
+      ExecuteBatch(testing::ClientFromMock(mock), std::move(batch));
+  EXPECT_TRUE(results.empty());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -13,7 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
-#include "google/cloud/storage/benchmarks/bounded_queue.h"
+#include "google/cloud/internal/bounded_queue.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "absl/types/optional.h"
 #include <cctype>
@@ -35,14 +35,15 @@ void DeleteAllObjects(google::cloud::storage::Client client,
 void DeleteAllObjects(google::cloud::storage::Client client,
                       std::string const& bucket_name,
                       google::cloud::storage::Prefix prefix, int thread_count) {
-  using WorkQueue = BoundedQueue<google::cloud::storage::ObjectMetadata>;
+  using WorkQueue = google::cloud::internal::BoundedQueue<
+      google::cloud::storage::ObjectMetadata>;
   using std::chrono::duration_cast;
   using std::chrono::milliseconds;
   namespace gcs = google::cloud::storage;
 
   std::cout << "# Deleting test objects [" << thread_count << "]\n";
   auto start = std::chrono::steady_clock::now();
-  WorkQueue work_queue;
+  WorkQueue work_queue(1024);
   std::vector<std::future<google::cloud::Status>> workers;
   std::generate_n(
       std::back_inserter(workers), thread_count, [&client, &work_queue] {
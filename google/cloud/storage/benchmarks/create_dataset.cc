@@ -12,7 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "google/cloud/storage/benchmarks/bounded_queue.h"
 #include "google/cloud/storage/benchmarks/create_dataset_options.h"
 #include "google/cloud/storage/client.h"
 #include "google/cloud/internal/build_info.h"
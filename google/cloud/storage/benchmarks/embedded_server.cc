@@ -0,0 +1,925 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/grpc_plugin.h"
+#include "google/cloud/storage/options.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/credentials.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include <nlohmann/json.hpp>
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+#include <google/storage/v1/storage.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif  // _WIN32
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+namespace {
+
+std::size_t constexpr kSyntheticDataSize = 1 * kMiB;
+
+/// The data returned by downloads, repeated as needed to fill each object.
+std::string const& SyntheticData() {
+  static auto const* const kData = [] {
+    auto generator =
+        google::cloud::internal::DefaultPRNG(std::random_device{}());
+    return new std::string(MakeRandomData(generator, kSyntheticDataSize));
+  }();
+  return *kData;
+}
+
+std::string ObjectJson(std::string const& bucket, std::string const& name,
+                       std::int64_t size, std::int64_t generation) {
+  return nlohmann::json{
+      {"kind", "storage#object"},
+      {"id", bucket + "/" + name + "/" + std::to_string(generation)},
+      {"bucket", bucket},
+      {"name", name},
+      {"size", std::to_string(size)},
+      {"generation", std::to_string(generation)},
+      {"metageneration", "1"},
+      {"storageClass", "STANDARD"},
+  }
+      .dump();
+}
+
+/**
+ * The objects and uploads in the embedded server.
+ *
+ * Only the object sizes are stored, the uploaded data is discarded.
+ */
+class ObjectStore {
+ public:
+  struct Object {
+    std::string bucket;
+    std::string name;
+    std::int64_t size;
+    std::int64_t generation;
+  };
+
+  struct Upload {
+    std::string bucket;
+    std::string name;
+    std::int64_t committed;
+    absl::optional<Object> object;
+  };
+
+  Object Insert(std::string bucket, std::string name, std::int64_t size) {
+    std::lock_guard<std::mutex> lk(mu_);
+    return InsertImpl(std::move(bucket), std::move(name), size);
+  }
+
+  absl::optional<Object> Get(std::string const& bucket,
+                             std::string const& name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto i = objects_.find({bucket, name});
+    if (i == objects_.end()) return absl::nullopt;
+    return i->second;
+  }
+
+  bool Delete(std::string const& bucket, std::string const& name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    return objects_.erase({bucket, name}) != 0;
+  }
+
+  std::vector<Object> List(std::string const& bucket) {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<Object> result;
+    for (auto i = objects_.lower_bound({bucket, std::string{}});
+         i != objects_.end() && i->first.first == bucket; ++i) {
+      result.push_back(i->second);
+    }
+    return result;
+  }
+
+  std::string StartUpload(std::string bucket, std::string name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto id = std::to_string(++upload_id_generator_);
+    uploads_.emplace(id, Upload{std::move(bucket), std::move(name), 0, {}});
+    return id;
+  }
+
+  absl::optional<Upload> GetUpload(std::string const& id) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto i = uploads_.find(id);
+    if (i == uploads_.end()) return absl::nullopt;
+    return i->second;
+  }
+
+  /// Add @p size bytes to an upload, and create the object if @p finalize.
+  absl::optional<Upload> AppendUpload(std::string const& id, std::int64_t size,
+                                      bool finalize) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto i = uploads_.find(id);
+    if (i == uploads_.end()) return absl::nullopt;
+    auto& upload = i->second;
+    if (upload.object) return upload;
+    upload.committed += size;
+    if (finalize) {
+      upload.object = InsertImpl(upload.bucket, upload.name, upload.committed);
+    }
+    return upload;
+  }
+
+ private:
+  Object InsertImpl(std::string bucket, std::string name, std::int64_t size) {
+    auto key = std::make_pair(bucket, name);
+    Object object{std::move(bucket), std::move(name), size,
+                  ++generation_generator_};
+    objects_[std::move(key)] = object;
+    return object;
+  }
+
+  std::mutex mu_;
+  std::map<std::pair<std::string, std::string>, Object> objects_;
+  std::map<std::string, Upload> uploads_;
+  std::int64_t generation_generator_ = 0;
+  std::int64_t upload_id_generator_ = 0;
+};
+
+#ifndef _WIN32
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+std::string UrlUnescape(absl::string_view s) {
+  std::string result;
+  result.reserve(s.size());
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '%' && i + 2 < s.size() && HexValue(s[i + 1]) >= 0 &&
+        HexValue(s[i + 2]) >= 0) {
+      result.push_back(
+          static_cast<char>(HexValue(s[i + 1]) * 16 + HexValue(s[i + 2])));
+      i += 2;
+      continue;
+    }
+    result.push_back(s[i] == '+' ? ' ' : s[i]);
+  }
+  return result;
+}
+
+/// A parsed HTTP/1.1 request, the body is summarized to avoid copying it.
+struct HttpRequest {
+  std::string method;
+  std::vector<std::string> path;
+  std::map<std::string, std::string> query;
+  std::map<std::string, std::string> headers;
+  /// The size of the body.
+  std::int64_t body_size = 0;
+  /// The first bytes of the body, enough to parse JSON requests and the
+  /// headers of multipart uploads.
+  std::string body_head;
+  /// The last bytes of the body, enough to parse multipart trailers.
+  std::string body_tail;
+
+  std::string Header(std::string const& name) const {
+    auto i = headers.find(name);
+    return i == headers.end() ? std::string{} : i->second;
+  }
+  std::string Query(std::string const& name) const {
+    auto i = query.find(name);
+    return i == query.end() ? std::string{} : i->second;
+  }
+};
+
+std::size_t constexpr kBodyHeadSize = 64 * kKiB;
+std::size_t constexpr kBodyTailSize = 1 * kKiB;
+std::size_t constexpr kReadBufferSize = 256 * kKiB;
+
+/// Reads and writes HTTP/1.1 messages on a connected socket.
+class HttpConnection {
+ public:
+  explicit HttpConnection(int fd) : fd_(fd), buffer_(kReadBufferSize) {}
+
+  absl::optional<HttpRequest> ReadRequest() {
+    auto line = ReadLine();
+    if (!line) return absl::nullopt;
+    std::vector<std::string> request_line = absl::StrSplit(*line, ' ');
+    if (request_line.size() != 3) return absl::nullopt;
+
+    HttpRequest request;
+    request.method = std::move(request_line[0]);
+    std::vector<absl::string_view> target =
+        absl::StrSplit(request_line[1], absl::MaxSplits('?', 1));
+    for (auto p : absl::StrSplit(target[0], '/', absl::SkipEmpty())) {
+      request.path.push_back(UrlUnescape(p));
+    }
+    if (target.size() == 2) {
+      for (auto kv : absl::StrSplit(target[1], '&', absl::SkipEmpty())) {
+        std::vector<absl::string_view> p =
+            absl::StrSplit(kv, absl::MaxSplits('=', 1));
+        request.query[UrlUnescape(p[0])] =
+            p.size() == 2 ? UrlUnescape(p[1]) : std::string{};
+      }
+    }
+    for (line = ReadLine(); line && !line->empty(); line = ReadLine()) {
+      auto pos = line->find(':');
+      if (pos == std::string::npos) continue;
+      auto name = absl::AsciiStrToLower(line->substr(0, pos));
+      request.headers[std::move(name)] = std::string(
+          absl::StripAsciiWhitespace(absl::string_view(*line).substr(pos + 1)));
+    }
+    if (!line) return absl::nullopt;
+
+    if (absl::EqualsIgnoreCase(request.Header("expect"), "100-continue")) {
+      if (!Write("HTTP/1.1 100 Continue\r\n\r\n")) return absl::nullopt;
+    }
+    if (absl::EqualsIgnoreCase(request.Header("transfer-encoding"),
+                               "chunked")) {
+      if (!ReadChunkedBody(request)) return absl::nullopt;
+      return request;
+    }
+    std::int64_t length = 0;
+    auto const content_length = request.Header("content-length");
+    if (!content_length.empty() && !absl::SimpleAtoi(content_length, &length)) {
+      return absl::nullopt;
+    }
+    if (!ReadBody(request, length)) return absl::nullopt;
+    return request;
+  }
+
+  bool Write(absl::string_view data) {
+    while (!data.empty()) {
+      auto n = ::send(fd_, data.data(), data.size(), MSG_NOSIGNAL);
+      if (n <= 0) return false;
+      data.remove_prefix(static_cast<std::size_t>(n));
+    }
+    return true;
+  }
+
+  bool WriteResponse(int code, std::string const& reason,
+                     std::vector<std::string> const& headers,
+                     std::string const& payload) {
+    std::string response = "HTTP/1.1 " + std::to_string(code) + " " + reason +
+                           "\r\nContent-Length: " +
+                           std::to_string(payload.size()) + "\r\n";
+    for (auto const& h : headers) response += h + "\r\n";
+    response += "\r\n";
+    response += payload;
+    return Write(response);
+  }
+
+  /// Send @p size bytes of synthetic data.
+  bool WriteMedia(std::int64_t size, std::vector<std::string> const& headers) {
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Length: " +
+                           std::to_string(size) +
+                           "\r\nContent-Type: application/octet-stream\r\n";
+    for (auto const& h : headers) response += h + "\r\n";
+    response += "\r\n";
+    if (!Write(response)) return false;
+    auto const& data = SyntheticData();
+    while (size > 0) {
+      auto n = (std::min)(size, static_cast<std::int64_t>(data.size()));
+      if (!Write(absl::string_view(data.data(), static_cast<std::size_t>(n)))) {
+        return false;
+      }
+      size -= n;
+    }
+    return true;
+  }
+
+ private:
+  bool Fill() {
+    if (begin_ == end_) begin_ = end_ = 0;
+    if (end_ == buffer_.size()) {
+      std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+      end_ -= begin_;
+      begin_ = 0;
+    }
+    auto n = ::recv(fd_, buffer_.data() + end_, buffer_.size() - end_, 0);
+    if (n <= 0) return false;
+    end_ += static_cast<std::size_t>(n);
+    return true;
+  }
+
+  absl::optional<std::string> ReadLine() {
+    for (std::size_t scanned = begin_;;) {
+      auto* b = buffer_.data();
+      auto* nl = static_cast<char*>(
+          std::memchr(b + scanned, '\n', end_ - scanned));
+      if (nl != nullptr) {
+        auto const eol = static_cast<std::size_t>(nl - b);
+        std::string line(b + begin_, eol - begin_);
+        begin_ = eol + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        return line;
+      }
+      if (end_ - begin_ == buffer_.size()) return absl::nullopt;
+      auto const offset = end_ - begin_;
+      if (!Fill()) return absl::nullopt;
+      scanned = begin_ + offset;
+    }
+  }
+
+  /// Consume @p length bytes of body, keeping only a summary.
+  bool ReadBody(HttpRequest& request, std::int64_t length) {
+    while (length > 0) {
+      if (begin_ == end_ && !Fill()) return false;
+      auto n = (std::min)(static_cast<std::size_t>(length), end_ - begin_);
+      AppendBody(request, absl::string_view(buffer_.data() + begin_, n));
+      begin_ += n;
+      length -= static_cast<std::int64_t>(n);
+    }
+    return true;
+  }
+
+  bool ReadChunkedBody(HttpRequest& request) {
+    for (;;) {
+      auto line = ReadLine();
+      if (!line) return false;
+      std::uint64_t size;
+      auto hex = absl::string_view(*line).substr(0, line->find(';'));
+      if (!absl::SimpleHexAtoi(hex, &size)) return false;
+      if (size == 0) break;
+      if (!ReadBody(request, static_cast<std::int64_t>(size))) return false;
+      if (!ReadLine()) return false;
+    }
+    // Discard any trailers.
+    for (auto line = ReadLine(); line; line = ReadLine()) {
+      if (line->empty()) return true;
+    }
+    return false;
+  }
+
+  static void AppendBody(HttpRequest& request, absl::string_view data) {
+    request.body_size += static_cast<std::int64_t>(data.size());
+    if (request.body_head.size() < kBodyHeadSize) {
+      auto n = (std::min)(data.size(), kBodyHeadSize - request.body_head.size());
+      request.body_head.append(data.data(), n);
+    }
+    if (data.size() >= kBodyTailSize) {
+      request.body_tail.assign(data.data() + data.size() - kBodyTailSize,
+                               kBodyTailSize);
+      return;
+    }
+    request.body_tail.append(data.data(), data.size());
+    if (request.body_tail.size() > kBodyTailSize) {
+      request.body_tail.erase(0, request.body_tail.size() - kBodyTailSize);
+    }
+  }
+
+  int fd_;
+  std::vector<char> buffer_;
+  std::size_t begin_ = 0;
+  std::size_t end_ = 0;
+};
+
+/// Returns the size of the media in a `multipart/related` upload.
+absl::optional<std::int64_t> MultipartMediaSize(HttpRequest const& request) {
+  std::string boundary;
+  for (absl::string_view p :
+       absl::StrSplit(request.Header("content-type"), ';')) {
+    p = absl::StripAsciiWhitespace(p);
+    if (!absl::ConsumePrefix(&p, "boundary=")) continue;
+    absl::ConsumePrefix(&p, "\"");
+    absl::ConsumeSuffix(&p, "\"");
+    boundary = std::string(p);
+  }
+  if (boundary.empty()) return absl::nullopt;
+  auto const marker = "--" + boundary;
+  // The media is the second part, after the object metadata.
+  auto pos = request.body_head.find(marker);
+  if (pos != std::string::npos) pos = request.body_head.find(marker, pos + 1);
+  if (pos != std::string::npos) pos = request.body_head.find("\r\n\r\n", pos);
+  auto const trailer = request.body_tail.rfind("\r\n" + marker + "--");
+  if (pos == std::string::npos || trailer == std::string::npos) {
+    return absl::nullopt;
+  }
+  auto const media_start = static_cast<std::int64_t>(pos + 4);
+  auto const trailer_size =
+      static_cast<std::int64_t>(request.body_tail.size() - trailer);
+  return request.body_size - media_start - trailer_size;
+}
+
+/// Parse a `Content-Range: bytes a-b/total` header, returns true if final.
+bool IsFinalChunk(std::string const& content_range) {
+  auto pos = content_range.find('/');
+  return pos != std::string::npos && content_range.substr(pos + 1) != "*";
+}
+
+/// Implements the JSON and XML APIs over HTTP/1.1.
+class RestHandler {
+ public:
+  RestHandler(std::shared_ptr<ObjectStore> store, std::string endpoint)
+      : store_(std::move(store)), endpoint_(std::move(endpoint)) {}
+
+  bool Handle(HttpConnection& connection, HttpRequest const& request) {
+    auto const& path = request.path;
+    if (path.size() == 6 && path[0] == "upload" && path[1] == "storage" &&
+        path[3] == "b" && path[5] == "o") {
+      return Upload(connection, request, path[4]);
+    }
+    if (path.size() >= 3 && path[0] == "storage" && path[2] == "b") {
+      return JsonApi(connection, request);
+    }
+    if (path.size() >= 2) {
+      std::vector<std::string> parts(path.begin() + 1, path.end());
+      return XmlApi(connection, request, path[0],
+                    absl::StrJoin(parts, "/"));
+    }
+    return NotFound(connection);
+  }
+
+ private:
+  bool Upload(HttpConnection& connection, HttpRequest const& request,
+              std::string const& bucket) {
+    auto const upload_type = request.Query("uploadType");
+    auto const upload_id = request.Query("upload_id");
+    if (request.method == "PUT" && !upload_id.empty()) {
+      return UploadChunk(connection, request, upload_id);
+    }
+    if (request.method != "POST") return NotFound(connection);
+    auto name = request.Query("name");
+    if (upload_type == "resumable") {
+      if (name.empty()) {
+        auto metadata =
+            nlohmann::json::parse(request.body_head, nullptr, false);
+        if (metadata.is_object()) name = metadata.value("name", "");
+      }
+      auto id = store_->StartUpload(bucket, name);
+      return connection.WriteResponse(
+          200, "OK",
+          {"Location: " + endpoint_ + "/upload/storage/v1/b/" + bucket +
+           "/o?uploadType=resumable&upload_id=" + id},
+          std::string{});
+    }
+    auto size = absl::optional<std::int64_t>(request.body_size);
+    if (upload_type == "multipart") size = MultipartMediaSize(request);
+    if (!size) return BadRequest(connection, "cannot parse multipart upload");
+    auto object = store_->Insert(bucket, name, *size);
+    return connection.WriteResponse(
+        200, "OK", {"Content-Type: application/json; charset=UTF-8"},
+        ObjectJson(object.bucket, object.name, object.size,
+                   object.generation));
+  }
+
+  bool UploadChunk(HttpConnection& connection, HttpRequest const& request,
+                   std::string const& upload_id) {
+    auto const content_range = request.Header("content-range");
+    auto upload = store_->AppendUpload(upload_id, request.body_size,
+                                       IsFinalChunk(content_range));
+    if (!upload) return NotFound(connection);
+    if (upload->object) {
+      auto const& o = *upload->object;
+      return connection.WriteResponse(
+          200, "OK", {"Content-Type: application/json; charset=UTF-8"},
+          ObjectJson(o.bucket, o.name, o.size, o.generation));
+    }
+    std::vector<std::string> headers;
+    if (upload->committed != 0) {
+      headers.push_back("Range: bytes=0-" +
+                        std::to_string(upload->committed - 1));
+    }
+    return connection.WriteResponse(308, "Resume Incomplete", headers,
+                                    std::string{});
+  }
+
+  bool JsonApi(HttpConnection& connection, HttpRequest const& request) {
+    auto const& path = request.path;
+    auto const& method = request.method;
+    if (path.size() == 3) {
+      if (method == "POST") {
+        auto metadata =
+            nlohmann::json::parse(request.body_head, nullptr, false);
+        auto name =
+            metadata.is_object() ? metadata.value("name", "") : std::string{};
+        return WriteJson(connection, BucketJson(name));
+      }
+      return WriteJson(connection, R"""({"kind": "storage#buckets"})""");
+    }
+    auto const& bucket = path[3];
+    if (path.size() == 4) {
+      if (method == "DELETE") return NoContent(connection);
+      return WriteJson(connection, BucketJson(bucket));
+    }
+    if (path[4] != "o") return NotFound(connection);
+    if (path.size() == 5) {
+      auto items = nlohmann::json::array();
+      for (auto const& o : store_->List(bucket)) {
+        items.push_back(nlohmann::json::parse(
+            ObjectJson(o.bucket, o.name, o.size, o.generation)));
+      }
+      return WriteJson(connection,
+                       nlohmann::json{{"kind", "storage#objects"},
+                                      {"items", std::move(items)}}
+                           .dump());
+    }
+    if (path.size() != 6) return NotFound(connection);
+    auto const& name = path[5];
+    if (method == "DELETE") {
+      if (!store_->Delete(bucket, name)) return NotFound(connection);
+      return NoContent(connection);
+    }
+    if (method != "GET") return NotFound(connection);
+    auto object = store_->Get(bucket, name);
+    if (!object) return NotFound(connection);
+    if (request.Query("alt") == "media") {
+      return connection.WriteMedia(
+          object->size,
+          {"x-goog-generation: " + std::to_string(object->generation)});
+    }
+    return WriteJson(connection, ObjectJson(object->bucket, object->name,
+                                            object->size, object->generation));
+  }
+
+  bool XmlApi(HttpConnection& connection, HttpRequest const& request,
+              std::string const& bucket, std::string const& name) {
+    auto const& method = request.method;
+    if (method == "PUT") {
+      auto object = store_->Insert(bucket, name, request.body_size);
+      return connection.WriteResponse(
+          200, "OK",
+          {"x-goog-generation: " + std::to_string(object.generation),
+           "x-goog-metageneration: 1", "x-goog-stored-content-length: " +
+                                           std::to_string(object.size)},
+          std::string{});
+    }
+    if (method == "DELETE") {
+      if (!store_->Delete(bucket, name)) return NotFound(connection);
+      return NoContent(connection);
+    }
+    if (method != "GET") return NotFound(connection);
+    auto object = store_->Get(bucket, name);
+    if (!object) return NotFound(connection);
+    return connection.WriteMedia(
+        object->size,
+        {"x-goog-generation: " + std::to_string(object->generation)});
+  }
+
+  static std::string BucketJson(std::string const& name) {
+    return nlohmann::json{
+        {"kind", "storage#bucket"}, {"id", name}, {"name", name}}
+        .dump();
+  }
+
+  static bool WriteJson(HttpConnection& connection,
+                        std::string const& payload) {
+    return connection.WriteResponse(
+        200, "OK", {"Content-Type: application/json; charset=UTF-8"}, payload);
+  }
+
+  static bool NoContent(HttpConnection& connection) {
+    return connection.WriteResponse(204, "No Content", {}, std::string{});
+  }
+
+  static bool NotFound(HttpConnection& connection) {
+    return connection.WriteResponse(
+        404, "Not Found", {"Content-Type: application/json; charset=UTF-8"},
+        R"""({"error": {"code": 404, "message": "Not Found"}})""");
+  }
+
+  static bool BadRequest(HttpConnection& connection,
+                         std::string const& message) {
+    return connection.WriteResponse(
+        400, "Bad Request", {"Content-Type: application/json; charset=UTF-8"},
+        nlohmann::json{{"error", {{"code", 400}, {"message", message}}}}
+            .dump());
+  }
+
+  std::shared_ptr<ObjectStore> store_;
+  std::string endpoint_;
+};
+
+/// Accepts connections on the loopback interface, one thread per connection.
+class RestServer {
+ public:
+  explicit RestServer(std::shared_ptr<ObjectStore> store)
+      : store_(std::move(store)) {}
+
+  ~RestServer() { Shutdown(); }
+
+  Status Start() {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) return ErrnoStatus("socket()");
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    auto* a = reinterpret_cast<sockaddr*>(&address);
+    socklen_t length = sizeof(address);
+    if (::bind(listen_fd_, a, length) != 0) return ErrnoStatus("bind()");
+    if (::listen(listen_fd_, SOMAXCONN) != 0) return ErrnoStatus("listen()");
+    if (::getsockname(listen_fd_, a, &length) != 0) {
+      return ErrnoStatus("getsockname()");
+    }
+    endpoint_ =
+        "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+    acceptor_ = std::thread([this] { AcceptLoop(); });
+    return Status{};
+  }
+
+  std::string const& endpoint() const { return endpoint_; }
+  std::int64_t request_count() const { return request_count_.load(); }
+
+  void Shutdown() {
+    std::vector<std::thread> workers;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (shutdown_) return;
+      shutdown_ = true;
+      // Unblock the threads in `accept()` and `recv()` calls.
+      if (listen_fd_ >= 0) ::shutdown(listen_fd_, SHUT_RDWR);
+      for (auto fd : connections_) ::shutdown(fd, SHUT_RDWR);
+      workers.swap(workers_);
+    }
+    if (acceptor_.joinable()) acceptor_.join();
+    for (auto& t : workers) t.join();
+    if (listen_fd_ >= 0) ::close(listen_fd_);
+    listen_fd_ = -1;
+  }
+
+ private:
+  static Status ErrnoStatus(char const* where) {
+    return Status(StatusCode::kUnavailable,
+                  std::string(where) + " failed: " + std::strerror(errno));
+  }
+
+  void AcceptLoop() {
+    for (;;) {
+      auto fd = ::accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) return;
+      int one = 1;
+      ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      std::lock_guard<std::mutex> lk(mu_);
+      if (shutdown_) {
+        ::close(fd);
+        return;
+      }
+      connections_.insert(fd);
+      workers_.emplace_back([this, fd] { Serve(fd); });
+    }
+  }
+
+  void Serve(int fd) {
+    RestHandler handler(store_, endpoint_);
+    HttpConnection connection(fd);
+    for (auto request = connection.ReadRequest(); request;
+         request = connection.ReadRequest()) {
+      ++request_count_;
+      if (!handler.Handle(connection, *request)) break;
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    connections_.erase(fd);
+    ::close(fd);
+  }
+
+  std::shared_ptr<ObjectStore> store_;
+  int listen_fd_ = -1;
+  std::string endpoint_;
+  std::thread acceptor_;
+  std::atomic<std::int64_t> request_count_{0};
+  std::mutex mu_;
+  bool shutdown_ = false;
+  std::set<int> connections_;
+  std::vector<std::thread> workers_;
+};
+
+#endif  // _WIN32
+
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+/// Implements the media operations in the gRPC API.
+class GrpcService final : public google::storage::v1::Storage::Service {
+ public:
+  explicit GrpcService(std::shared_ptr<ObjectStore> store)
+      : store_(std::move(store)) {}
+
+  std::int64_t request_count() const { return request_count_.load(); }
+
+  grpc::Status InsertObject(
+      grpc::ServerContext*,
+      grpc::ServerReader<google::storage::v1::InsertObjectRequest>* reader,
+      google::storage::v1::Object* response) override {
+    ++request_count_;
+    google::storage::v1::InsertObjectRequest request;
+    std::string upload_id;
+    std::string bucket;
+    std::string name;
+    std::int64_t size = 0;
+    bool finish = false;
+    while (!finish && reader->Read(&request)) {
+      if (request.has_insert_object_spec()) {
+        bucket = request.insert_object_spec().resource().bucket();
+        name = request.insert_object_spec().resource().name();
+      } else if (!request.upload_id().empty()) {
+        upload_id = request.upload_id();
+      }
+      size += static_cast<std::int64_t>(
+          request.checksummed_data().content().size());
+      finish = request.finish_write();
+    }
+    if (upload_id.empty()) {
+      *response = ToProto(store_->Insert(bucket, name, size));
+      return grpc::Status::OK;
+    }
+    auto upload = store_->AppendUpload(upload_id, size, finish);
+    if (!upload) return grpc::Status(grpc::StatusCode::NOT_FOUND, upload_id);
+    if (upload->object) *response = ToProto(*upload->object);
+    return grpc::Status::OK;
+  }
+
+  grpc::Status GetObjectMedia(
+      grpc::ServerContext*,
+      google::storage::v1::GetObjectMediaRequest const* request,
+      grpc::ServerWriter<google::storage::v1::GetObjectMediaResponse>* writer)
+      override {
+    ++request_count_;
+    auto object = store_->Get(request->bucket(), request->object());
+    if (!object) {
+      return grpc::Status(grpc::StatusCode::NOT_FOUND, request->object());
+    }
+    auto const& data = SyntheticData();
+    auto const chunk = (std::min)(
+        static_cast<std::int64_t>(data.size()),
+        static_cast<std::int64_t>(
+            google::storage::v1::ServiceConstants::MAX_READ_CHUNK_BYTES));
+    google::storage::v1::GetObjectMediaResponse response;
+    *response.mutable_metadata() = ToProto(*object);
+    for (std::int64_t offset = 0; offset < object->size;) {
+      auto const n = (std::min)(chunk, object->size - offset);
+      response.mutable_checksummed_data()->mutable_content()->assign(
+          data.data(), static_cast<std::size_t>(n));
+      if (!writer->Write(response)) break;
+      response.clear_metadata();
+      offset += n;
+    }
+    return grpc::Status::OK;
+  }
+
+  grpc::Status DeleteObject(grpc::ServerContext*,
+                            google::storage::v1::DeleteObjectRequest const* r,
+                            google::protobuf::Empty*) override {
+    ++request_count_;
+    if (!store_->Delete(r->bucket(), r->object())) {
+      return grpc::Status(grpc::StatusCode::NOT_FOUND, r->object());
+    }
+    return grpc::Status::OK;
+  }
+
+  grpc::Status StartResumableWrite(
+      grpc::ServerContext*,
+      google::storage::v1::StartResumableWriteRequest const* request,
+      google::storage::v1::StartResumableWriteResponse* response) override {
+    ++request_count_;
+    auto const& resource = request->insert_object_spec().resource();
+    response->set_upload_id(
+        store_->StartUpload(resource.bucket(), resource.name()));
+    return grpc::Status::OK;
+  }
+
+  grpc::Status QueryWriteStatus(
+      grpc::ServerContext*,
+      google::storage::v1::QueryWriteStatusRequest const* request,
+      google::storage::v1::QueryWriteStatusResponse* response) override {
+    ++request_count_;
+    auto upload = store_->GetUpload(request->upload_id());
+    if (!upload) {
+      return grpc::Status(grpc::StatusCode::NOT_FOUND, request->upload_id());
+    }
+    response->set_committed_size(upload->committed);
+    response->set_complete(upload->object.has_value());
+    if (upload->object) *response->mutable_resource() = ToProto(*upload->object);
+    return grpc::Status::OK;
+  }
+
+ private:
+  static google::storage::v1::Object ToProto(ObjectStore::Object const& o) {
+    google::storage::v1::Object result;
+    result.set_bucket(o.bucket);
+    result.set_name(o.name);
+    result.set_size(o.size);
+    result.set_generation(o.generation);
+    result.set_metageneration(1);
+    result.set_storage_class("STANDARD");
+    return result;
+  }
+
+  std::shared_ptr<ObjectStore> store_;
+  std::atomic<std::int64_t> request_count_{0};
+};
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+
+#ifndef _WIN32
+class EmbeddedServerImpl : public EmbeddedServer {
+ public:
+  EmbeddedServerImpl()
+      : store_(std::make_shared<ObjectStore>()), rest_(store_) {}
+  ~EmbeddedServerImpl() override { Shutdown(); }
+
+  Status Start() {
+    auto status = rest_.Start();
+    if (!status.ok()) return status;
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+    grpc_service_ = absl::make_unique<GrpcService>(store_);
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(),
+                             &port);
+    builder.RegisterService(grpc_service_.get());
+    grpc_server_ = builder.BuildAndStart();
+    if (!grpc_server_ || port == 0) {
+      return Status(StatusCode::kUnavailable, "cannot start gRPC server");
+    }
+    grpc_endpoint_ = "127.0.0.1:" + std::to_string(port);
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+    return Status{};
+  }
+
+  std::string rest_endpoint() const override { return rest_.endpoint(); }
+  std::string grpc_endpoint() const override { return grpc_endpoint_; }
+
+  void Shutdown() override {
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+    if (grpc_server_) grpc_server_->Shutdown();
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+    rest_.Shutdown();
+  }
+
+  std::int64_t request_count() const override {
+    auto count = rest_.request_count();
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+    if (grpc_service_) count += grpc_service_->request_count();
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+    return count;
+  }
+
+ private:
+  std::shared_ptr<ObjectStore> store_;
+  RestServer rest_;
+  std::string grpc_endpoint_;
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+  std::unique_ptr<GrpcService> grpc_service_;
+  std::unique_ptr<grpc::Server> grpc_server_;
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+};
+#endif  // _WIN32
+
+}  // namespace
+
+StatusOr<std::unique_ptr<EmbeddedServer>> CreateEmbeddedServer() {
+#ifndef _WIN32
+  auto server = absl::make_unique<EmbeddedServerImpl>();
+  auto status = server->Start();
+  if (!status.ok()) return status;
+  return std::unique_ptr<EmbeddedServer>(std::move(server));
+#else
+  return Status(StatusCode::kUnimplemented,
+                "the embedded server requires POSIX sockets");
+#endif  // _WIN32
+}
+
+google::cloud::Options EmbeddedServerOptions(EmbeddedServer const& server) {
+  auto options =
+      google::cloud::Options{}
+          .set<google::cloud::UnifiedCredentialsOption>(
+              google::cloud::MakeInsecureCredentials())
+          .set<google::cloud::storage::RestEndpointOption>(
+              server.rest_endpoint())
+          .set<google::cloud::storage::ProjectIdOption>("embedded-project");
+  if (!server.grpc_endpoint().empty()) {
+    options.set<google::cloud::EndpointOption>(server.grpc_endpoint());
+  }
+  return options;
+}
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
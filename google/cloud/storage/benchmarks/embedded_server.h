@@ -0,0 +1,77 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H
+
+#include "google/cloud/options.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+
+/**
+ * An in-process server implementing the subset of GCS used in the benchmarks.
+ *
+ * Running the throughput benchmarks against a local server eliminates the
+ * network and the service as sources of variation, and makes it possible to
+ * measure changes in the client CPU usage without a real bucket. The server
+ * accepts any bucket name, it discards all uploaded data (only the object
+ * sizes are stored), and it serves synthetic data for downloads.
+ *
+ * The server implements the JSON and XML APIs over HTTP/1.1 and, if the
+ * library is compiled with gRPC support, the media operations of the gRPC API.
+ */
+class EmbeddedServer {
+ public:
+  virtual ~EmbeddedServer() = default;
+
+  /// The endpoint for the JSON and XML APIs, e.g. `http://127.0.0.1:1234`.
+  virtual std::string rest_endpoint() const = 0;
+
+  /// The endpoint for the gRPC API, empty if gRPC is not supported.
+  virtual std::string grpc_endpoint() const = 0;
+
+  /// Stop the server, blocks until all the connections are closed.
+  virtual void Shutdown() = 0;
+
+  /// The number of HTTP requests and RPCs handled by the server.
+  virtual std::int64_t request_count() const = 0;
+};
+
+/**
+ * Create and start an embedded server, listening on the loopback interface.
+ *
+ * Returns an error if the server cannot start, or if the platform does not
+ * support POSIX sockets.
+ */
+StatusOr<std::unique_ptr<EmbeddedServer>> CreateEmbeddedServer();
+
+/**
+ * Returns the client options to use @p server.
+ *
+ * The options use anonymous credentials, and the REST and gRPC endpoints of
+ * the server. The retry policies are unchanged.
+ */
+google::cloud::Options EmbeddedServerOptions(EmbeddedServer const& server);
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H
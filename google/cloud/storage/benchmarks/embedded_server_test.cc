@@ -0,0 +1,133 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+namespace {
+
+namespace gcs = google::cloud::storage;
+using ::google::cloud::testing_util::StatusIs;
+
+class EmbeddedServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto server = CreateEmbeddedServer();
+    if (server.status().code() == StatusCode::kUnimplemented) {
+      GTEST_SKIP();
+    }
+    ASSERT_STATUS_OK(server);
+    server_ = *std::move(server);
+  }
+
+  void TearDown() override {
+    if (server_) server_->Shutdown();
+  }
+
+  gcs::Client MakeClient() {
+    return gcs::Client(EmbeddedServerOptions(*server_)
+                           .set<gcs::UploadBufferSizeOption>(256 * 1024));
+  }
+
+  static std::int64_t ReadSize(gcs::ObjectReadStream stream) {
+    std::vector<char> buffer(128 * 1024);
+    std::int64_t size = 0;
+    while (stream.read(buffer.data(), buffer.size()) || stream.gcount() != 0) {
+      size += stream.gcount();
+    }
+    EXPECT_STATUS_OK(stream.status());
+    return size;
+  }
+
+  std::unique_ptr<EmbeddedServer> server_;
+};
+
+TEST_F(EmbeddedServerTest, InsertReadDelete) {
+  auto client = MakeClient();
+  std::string const contents(100000, 'A');
+  auto insert = client.InsertObject("test-bucket", "test/object", contents);
+  ASSERT_STATUS_OK(insert);
+  EXPECT_EQ(insert->size(), contents.size());
+  EXPECT_EQ(insert->name(), "test/object");
+
+  auto get = client.GetObjectMetadata("test-bucket", "test/object");
+  ASSERT_STATUS_OK(get);
+  EXPECT_EQ(get->size(), contents.size());
+  EXPECT_EQ(get->generation(), insert->generation());
+
+  EXPECT_EQ(ReadSize(client.ReadObject("test-bucket", "test/object")),
+            contents.size());
+
+  ASSERT_STATUS_OK(client.DeleteObject("test-bucket", "test/object"));
+  EXPECT_THAT(client.GetObjectMetadata("test-bucket", "test/object"),
+              StatusIs(StatusCode::kNotFound));
+  EXPECT_GT(server_->request_count(), 0);
+}
+
+TEST_F(EmbeddedServerTest, ResumableUpload) {
+  auto client = MakeClient();
+  // Upload a few chunks, with a partial chunk at the end.
+  auto constexpr kBlockCount = 1000;
+  std::string const block(1000, 'B');
+  auto writer = client.WriteObject("test-bucket", "resumable");
+  for (int i = 0; i != kBlockCount; ++i) writer << block;
+  writer.Close();
+  ASSERT_STATUS_OK(writer.metadata());
+  EXPECT_EQ(writer.metadata()->size(), kBlockCount * block.size());
+
+  EXPECT_EQ(ReadSize(client.ReadObject("test-bucket", "resumable")),
+            kBlockCount * block.size());
+}
+
+TEST_F(EmbeddedServerTest, XmlApi) {
+  auto client = MakeClient();
+  std::string const contents(5000, 'C');
+  // Using `Fields("")` selects the XML API for uploads.
+  auto insert =
+      client.InsertObject("test-bucket", "xml", contents, gcs::Fields(""));
+  ASSERT_STATUS_OK(insert);
+
+  // Downloads use the XML API by default.
+  EXPECT_EQ(ReadSize(client.ReadObject("test-bucket", "xml")),
+            contents.size());
+  // Using `IfGenerationNotMatch(0)` selects the JSON API for downloads.
+  EXPECT_EQ(ReadSize(client.ReadObject("test-bucket", "xml",
+                                       gcs::IfGenerationNotMatch(0))),
+            contents.size());
+}
+
+TEST_F(EmbeddedServerTest, ListObjects) {
+  auto client = MakeClient();
+  for (auto const* name : {"a", "b", "c"}) {
+    ASSERT_STATUS_OK(client.InsertObject("list-bucket", name, "contents"));
+  }
+  ASSERT_STATUS_OK(client.InsertObject("other-bucket", "d", "contents"));
+  std::vector<std::string> names;
+  for (auto& o : client.ListObjects("list-bucket")) {
+    ASSERT_STATUS_OK(o);
+    names.push_back(o->name());
+  }
+  EXPECT_THAT(names, ::testing::ElementsAre("a", "b", "c"));
+}
+
+}  // namespace
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,456 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/benchmarks/throughput_experiment.h"
+#include "google/cloud/storage/benchmarks/throughput_options.h"
+#include "google/cloud/storage/benchmarks/throughput_result.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/grpc_plugin.h"
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include "absl/types/optional.h"
+#include <curl/curl.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+
+namespace {
+namespace gcs = google::cloud::storage;
+namespace gcs_bm = google::cloud::storage_benchmarks;
+using gcs_bm::ApiName;
+using gcs_bm::ThroughputOptions;
+using gcs_bm::ThroughputResult;
+
+char const kDescription[] = R"""(
+An offline throughput benchmark for the GCS C++ client library.
+
+This program runs the same upload and download experiments as
+`storage_throughput_vs_cpu_benchmark`, but against an embedded server running in
+the same process. The server discards uploaded data and serves synthetic data
+for downloads over the loopback interface, without authentication. Without the
+network and the service as sources of variation, the benchmark measures the
+cost of the client library itself, and can detect CPU regressions in CI without
+access to a real bucket.
+
+For each API (JSON, XML, and gRPC if available) and operation, the program
+reports:
+
+- The client CPU time per GiB transferred.
+- The number of memory allocations per operation, including both C++
+  allocations and the allocations made by libcurl.
+- The number of system calls per operation, this requires Linux and
+  permissions to read the `raw_syscalls:sys_enter` tracepoint, see
+  `perf_event_open(2)` and `/proc/sys/kernel/perf_event_paranoid`.
+
+All the measurements are per-thread, and only include the work performed in the
+thread running the experiment. With gRPC some of the work happens in background
+threads, so the results underestimate the costs for gRPC.
+
+The `--region` and `--project-id` options are ignored, and the `Raw*` APIs are
+not supported as they do not use the client library.
+)""";
+
+// Count the allocations in each thread. The counters are updated from the
+// replacement `operator new()` and the libcurl memory callbacks below.
+thread_local std::int64_t allocation_count = 0;
+
+extern "C" void* CountingMalloc(std::size_t size) {
+  ++allocation_count;
+  return std::malloc(size);
+}
+
+extern "C" void CountingFree(void* ptr) { std::free(ptr); }
+
+extern "C" void* CountingRealloc(void* ptr, std::size_t size) {
+  ++allocation_count;
+  return std::realloc(ptr, size);
+}
+
+extern "C" char* CountingStrdup(char const* str) {
+  auto const size = std::strlen(str) + 1;
+  auto* copy = static_cast<char*>(CountingMalloc(size));
+  if (copy != nullptr) std::memcpy(copy, str, size);
+  return copy;
+}
+
+extern "C" void* CountingCalloc(std::size_t nmemb, std::size_t size) {
+  ++allocation_count;
+  return std::calloc(nmemb, size);
+}
+
+/// Counts the system calls made by the calling thread.
+class SyscallCounter {
+ public:
+  SyscallCounter() {
+#ifdef __linux__
+    std::int64_t id = -1;
+    for (auto const* path :
+         {"/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+          "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id"}) {
+      std::ifstream is(path);
+      if (is >> id) break;
+    }
+    if (id < 0) return;
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_TRACEPOINT;
+    attr.size = sizeof(attr);
+    attr.config = static_cast<std::uint64_t>(id);
+    fd_ = static_cast<int>(::syscall(__NR_perf_event_open, &attr,
+                                     /*pid=*/0, /*cpu=*/-1,
+                                     /*group_fd=*/-1, /*flags=*/0));
+#endif  // __linux__
+  }
+  ~SyscallCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) ::close(fd_);
+#endif  // __linux__
+  }
+
+  SyscallCounter(SyscallCounter const&) = delete;
+  SyscallCounter& operator=(SyscallCounter const&) = delete;
+
+  absl::optional<std::int64_t> Read() const {
+#ifdef __linux__
+    std::uint64_t value;
+    if (fd_ >= 0 && ::read(fd_, &value, sizeof(value)) == sizeof(value)) {
+      return static_cast<std::int64_t>(value);
+    }
+#endif  // __linux__
+    return absl::nullopt;
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+struct Sample {
+  ThroughputResult result;
+  std::int64_t allocations;
+  absl::optional<std::int64_t> syscalls;
+};
+
+using TestResults = std::vector<Sample>;
+
+TestResults RunThread(ThroughputOptions const& options,
+                      google::cloud::Options const& client_options,
+                      gcs::Client rest_client, gcs::Client grpc_client,
+                      std::string const& bucket_name, int thread_id);
+void PrintSummary(std::vector<TestResults> const& results);
+
+google::cloud::StatusOr<ThroughputOptions> ParseArgs(int argc, char* argv[]);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++allocation_count;
+  if (auto* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+
+using ::google::cloud::storage_experimental::DefaultGrpcClient;
+
+int main(int argc, char* argv[]) {
+  google::cloud::StatusOr<ThroughputOptions> options = ParseArgs(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return 1;
+  }
+
+  // This must happen before the client library initializes libcurl.
+  auto const curl_init = curl_global_init_mem(
+      CURL_GLOBAL_ALL, CountingMalloc, CountingFree, CountingRealloc,
+      CountingStrdup, CountingCalloc);
+  if (curl_init != CURLE_OK) {
+    std::cerr << "Cannot initialize libcurl: " << curl_easy_strerror(curl_init)
+              << "\n";
+    return 1;
+  }
+
+  auto server = gcs_bm::CreateEmbeddedServer();
+  if (!server) {
+    std::cerr << "Cannot start embedded server: " << server.status() << "\n";
+    return 1;
+  }
+  auto client_options = gcs_bm::EmbeddedServerOptions(**server);
+  auto rest_client = gcs::Client(client_options);
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+  auto grpc_client = DefaultGrpcClient(client_options);
+#else
+  auto grpc_client = rest_client;
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
+
+  auto generator = google::cloud::internal::DefaultPRNG(std::random_device{}());
+  auto bucket_name = gcs_bm::MakeRandomBucketName(generator);
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+
+  std::cout << "# REST Endpoint: " << (*server)->rest_endpoint()
+            << "\n# gRPC Endpoint: " << (*server)->grpc_endpoint()
+            << "\n# Syscall Counting: "
+            << (SyscallCounter{}.Read().has_value() ? "enabled" : "disabled")
+            << "\n# Duration: " << options->duration.count() << "s"
+            << "\n# Thread Count: " << options->thread_count
+            << "\n# Min Object Size: " << options->minimum_object_size
+            << "\n# Max Object Size: " << options->maximum_object_size
+            << "\n# Min Write Size: " << options->minimum_write_size
+            << "\n# Max Write Size: " << options->maximum_write_size
+            << "\n# Min Read Size: " << options->minimum_read_size
+            << "\n# Max Read Size: " << options->maximum_read_size
+            << "\n# Minimum Sample Count: " << options->minimum_sample_count
+            << "\n# Maximum Sample Count: " << options->maximum_sample_count
+            << "\n# Build info: " << notes << "\n";
+  // Make the output generated so far immediately visible, helps with debugging.
+  std::cout << std::flush;
+
+  std::vector<std::future<TestResults>> tasks;
+  for (int i = 0; i != options->thread_count; ++i) {
+    tasks.emplace_back(std::async(std::launch::async, RunThread, *options,
+                                  client_options, rest_client, grpc_client,
+                                  bucket_name, i));
+  }
+  std::vector<TestResults> results;
+  for (auto& f : tasks) results.push_back(f.get());
+  PrintSummary(results);
+
+  std::size_t operation_count = 0;
+  for (auto const& r : results) operation_count += r.size();
+  std::cout << "# Server Requests: " << (*server)->request_count()
+            << "\n# Operations: " << operation_count << "\n";
+
+  (*server)->Shutdown();
+  std::cout << "# DONE\n" << std::flush;
+
+  return 0;
+}
+
+namespace {
+
+/// Run @p experiment, measuring the allocations and system calls.
+Sample Measure(SyscallCounter const& syscalls, gcs_bm::ThroughputExperiment& e,
+               std::string const& bucket_name, std::string const& object_name,
+               gcs_bm::ThroughputExperimentConfig const& config) {
+  auto const allocations_start = allocation_count;
+  auto const syscalls_start = syscalls.Read();
+  auto result = e.Run(bucket_name, object_name, config);
+  auto const syscalls_end = syscalls.Read();
+  auto const allocations = allocation_count - allocations_start;
+  absl::optional<std::int64_t> count;
+  if (syscalls_start && syscalls_end) count = *syscalls_end - *syscalls_start;
+  return Sample{std::move(result), allocations, count};
+}
+
+TestResults RunThread(ThroughputOptions const& options,
+                      google::cloud::Options const& client_options,
+                      gcs::Client rest_client, gcs::Client grpc_client,
+                      std::string const& bucket_name, int thread_id) {
+  auto generator = google::cloud::internal::DefaultPRNG(std::random_device{}());
+  SyscallCounter syscalls;
+
+  auto const defaults =
+      gcs::internal::DefaultOptionsWithCredentials(client_options);
+  auto const upload_buffer_size = defaults.get<gcs::UploadBufferSizeOption>();
+  auto const download_buffer_size =
+      defaults.get<gcs::DownloadBufferSizeOption>();
+
+  auto uploaders = gcs_bm::CreateUploadExperiments(
+      options, rest_client, grpc_client, client_options);
+  auto downloaders = gcs_bm::CreateDownloadExperiments(
+      options, rest_client, std::move(grpc_client), client_options, thread_id);
+  if (uploaders.empty() || downloaders.empty()) {
+    // This is possible if only gRPC is requested but the benchmark was compiled
+    // without gRPC support.
+    std::cout << "# None of the APIs configured are available\n";
+    return {};
+  }
+
+  std::uniform_int_distribution<std::size_t> uploader_generator(
+      0, uploaders.size() - 1);
+  std::uniform_int_distribution<std::size_t> downloader_generator(
+      0, downloaders.size() - 1);
+  std::uniform_int_distribution<std::int64_t> size_generator(
+      options.minimum_object_size, options.maximum_object_size);
+  std::uniform_int_distribution<std::size_t> write_size_generator(
+      options.minimum_write_size / options.write_quantum,
+      options.maximum_write_size / options.write_quantum);
+  std::uniform_int_distribution<std::size_t> read_size_generator(
+      options.minimum_read_size / options.read_quantum,
+      options.maximum_read_size / options.read_quantum);
+  std::uniform_int_distribution<std::size_t> crc32c_generator(
+      0, options.enabled_crc32c.size() - 1);
+  std::uniform_int_distribution<std::size_t> md5_generator(
+      0, options.enabled_md5.size() - 1);
+
+  auto deadline = std::chrono::steady_clock::now() + options.duration;
+
+  TestResults results;
+  std::int32_t iteration_count = 0;
+  for (auto start = std::chrono::steady_clock::now();
+       iteration_count < options.maximum_sample_count &&
+       (iteration_count < options.minimum_sample_count || start < deadline);
+       start = std::chrono::steady_clock::now(), ++iteration_count) {
+    auto object_name = gcs_bm::MakeRandomObjectName(generator);
+    auto object_size = size_generator(generator);
+    auto write_size = options.write_quantum * write_size_generator(generator);
+    auto read_size = options.read_quantum * read_size_generator(generator);
+    bool const enable_crc = options.enabled_crc32c[crc32c_generator(generator)];
+    bool const enable_md5 = options.enabled_md5[md5_generator(generator)];
+
+    auto& uploader = *uploaders[uploader_generator(generator)];
+    results.push_back(Measure(
+        syscalls, uploader, bucket_name, object_name,
+        gcs_bm::ThroughputExperimentConfig{gcs_bm::kOpWrite, object_size,
+                                           write_size, upload_buffer_size,
+                                           enable_crc, enable_md5}));
+    if (!results.back().result.status.ok()) continue;
+
+    auto& downloader = *downloaders[downloader_generator(generator)];
+    for (auto op : {gcs_bm::kOpRead0, gcs_bm::kOpRead1, gcs_bm::kOpRead2}) {
+      results.push_back(Measure(
+          syscalls, downloader, bucket_name, object_name,
+          gcs_bm::ThroughputExperimentConfig{op, object_size, read_size,
+                                             download_buffer_size, enable_crc,
+                                             enable_md5}));
+    }
+    (void)rest_client.DeleteObject(bucket_name, object_name);
+  }
+  return results;
+}
+
+void PrintSummary(std::vector<TestResults> const& results) {
+  struct Summary {
+    std::int64_t samples = 0;
+    std::int64_t errors = 0;
+    std::int64_t bytes = 0;
+    std::chrono::microseconds cpu_time{0};
+    std::int64_t allocations = 0;
+    std::int64_t syscalls = 0;
+    bool has_syscalls = true;
+  };
+  // The three download operations (kOpRead[012]) are reported together.
+  auto op_name = [](gcs_bm::OpType op) {
+    return op == gcs_bm::kOpWrite || op == gcs_bm::kOpInsert
+               ? std::string{gcs_bm::ToString(op)}
+               : std::string{"READ"};
+  };
+  std::map<std::pair<std::string, std::string>, Summary> summaries;
+  for (auto const& thread_results : results) {
+    for (auto const& s : thread_results) {
+      auto& summary = summaries[{gcs_bm::ToString(s.result.api),
+                                 op_name(s.result.op)}];
+      ++summary.samples;
+      if (!s.result.status.ok()) ++summary.errors;
+      summary.bytes += s.result.object_size;
+      summary.cpu_time += s.result.cpu_time;
+      summary.allocations += s.allocations;
+      summary.has_syscalls = summary.has_syscalls && s.syscalls.has_value();
+      summary.syscalls += s.syscalls.value_or(0);
+    }
+  }
+
+  std::cout << "Api,Op,Samples,Errors,Bytes,CpuSecondsPerGiB,"
+            << "AllocationsPerOp,SyscallsPerOp\n";
+  for (auto const& kv : summaries) {
+    auto const& s = kv.second;
+    auto const gib = static_cast<double>(s.bytes) / gcs_bm::kGiB;
+    auto const cpu = std::chrono::duration<double>(s.cpu_time).count();
+    auto const samples = static_cast<double>(s.samples);
+    std::cout << kv.first.first << ',' << kv.first.second << ',' << s.samples
+              << ',' << s.errors << ',' << s.bytes << ','
+              << (gib == 0 ? 0 : cpu / gib) << ','
+              << static_cast<double>(s.allocations) / samples << ',';
+    if (s.has_syscalls) {
+      std::cout << static_cast<double>(s.syscalls) / samples;
+    } else {
+      std::cout << "n/a";
+    }
+    std::cout << "\n";
+  }
+  std::cout << std::flush;
+}
+
+google::cloud::StatusOr<ThroughputOptions> ValidateOptions(
+    google::cloud::StatusOr<ThroughputOptions> options) {
+  if (!options) return options;
+  for (auto api : options->enabled_apis) {
+    if (api == ApiName::kApiRawJson || api == ApiName::kApiRawXml ||
+        api == ApiName::kApiRawGrpc) {
+      return google::cloud::Status(
+          google::cloud::StatusCode::kInvalidArgument,
+          std::string{"the embedded benchmark does not support the "} +
+              gcs_bm::ToString(api) + " API");
+    }
+  }
+  return options;
+}
+
+google::cloud::StatusOr<ThroughputOptions> SelfTest(char const* argv0) {
+  return ValidateOptions(gcs_bm::ParseThroughputOptions(
+      {
+          argv0,
+          "--region=embedded",
+          "--thread-count=1",
+          "--minimum-object-size=16KiB",
+          "--maximum-object-size=4MiB",
+          "--minimum-write-size=16KiB",
+          "--maximum-write-size=128KiB",
+          "--write-quantum=16KiB",
+          "--minimum-read-size=16KiB",
+          "--maximum-read-size=128KiB",
+          "--read-quantum=16KiB",
+          "--duration=1s",
+          "--minimum-sample-count=4",
+          "--maximum-sample-count=10",
+      },
+      kDescription));
+}
+
+google::cloud::StatusOr<ThroughputOptions> ParseArgs(int argc, char* argv[]) {
+  bool auto_run =
+      google::cloud::internal::GetEnv("GOOGLE_CLOUD_CPP_AUTO_RUN_EXAMPLES")
+          .value_or("") == "yes";
+  if (auto_run) return SelfTest(argv[0]);
+
+  // The region is required by `ParseThroughputOptions()`, but it is not used
+  // by the embedded server. Use a shorter default duration too.
+  std::vector<std::string> args{argv[0], "--region=embedded", "--duration=60s"};
+  args.insert(args.end(), argv + 1, argv + argc);
+  return ValidateOptions(gcs_bm::ParseThroughputOptions(args, kDescription));
+}
+
+}  // namespace
@@ -0,0 +1,322 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/testing/remove_stale_buckets.h"
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+namespace gcs = google::cloud::storage;
+namespace gcs_bm = google::cloud::storage_benchmarks;
+
+char const kDescription[] = R"""(
+A latency benchmark for small objects with the Google Cloud Storage C++ client
+library.
+
+For small objects the time to complete a request is dominated by per-request
+overhead (opening connections, TLS handshakes, building the request), and not
+by the throughput of the network. This program repeatedly uploads an object of
+a random size, in the `[--minimum-object-size, --maximum-object-size]` range,
+and then downloads the same object. It reports the latency of each operation,
+and once the benchmark completes, the p50, p90, p99 and p99.9 latencies for
+each operation.
+
+The program also reports how many requests opened a new connection, how many
+reused an existing connection, and the total time spent building the requests.
+Compare these counters with different values of `--connection-pool-size` to
+diagnose connection reuse problems.
+
+To perform this benchmark the program creates a new standard bucket, in a region
+configured via the command line. The output of this program is an annotated CSV
+file, that can be analyzed by an external script. The annotation lines start
+with a '#', analysis scripts should skip these lines.
+)""";
+
+struct Options {
+  std::string project_id;
+  std::string region;
+  std::chrono::seconds duration = std::chrono::seconds(60);
+  std::int64_t minimum_object_size = 4 * gcs_bm::kKiB;
+  std::int64_t maximum_object_size = 64 * gcs_bm::kKiB;
+  std::size_t connection_pool_size = 4;
+};
+
+google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]);
+
+using Latencies = std::vector<std::chrono::microseconds>;
+
+void PrintPercentiles(std::string const& op, Latencies latencies) {
+  if (latencies.empty()) return;
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "# " << op << " latency (us):";
+  for (auto const p : {50.0, 90.0, 99.0, 99.9}) {
+    auto const rank = static_cast<std::size_t>(
+        std::ceil(p / 100.0 * static_cast<double>(latencies.size())));
+    auto const index = (std::max)(rank, std::size_t{1}) - 1;
+    std::cout << " p" << p << "=" << latencies[index].count();
+  }
+  std::cout << " samples=" << latencies.size() << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::cloud::StatusOr<Options> options = ParseArgs(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return 1;
+  }
+
+  // Create the `CurlClient` directly, as the benchmark needs its counters.
+  auto curl = gcs::internal::CurlClient::Create(
+      google::cloud::Options{}
+          .set<gcs::ConnectionPoolSizeOption>(options->connection_pool_size)
+          .set<gcs::ProjectIdOption>(options->project_id));
+  auto client = gcs::internal::ClientImplDetails::CreateClient(curl);
+
+  std::cout << "# Cleaning up stale benchmark buckets\n";
+  google::cloud::storage::testing::RemoveStaleBuckets(
+      client, gcs_bm::RandomBucketPrefix(),
+      std::chrono::system_clock::now() - std::chrono::hours(48));
+
+  google::cloud::internal::DefaultPRNG generator =
+      google::cloud::internal::MakeDefaultPRNG();
+
+  auto bucket_name = gcs_bm::MakeRandomBucketName(generator);
+  auto meta =
+      client
+          .CreateBucket(bucket_name,
+                        gcs::BucketMetadata()
+                            .set_storage_class(gcs::storage_class::Standard())
+                            .set_location(options->region),
+                        gcs::PredefinedAcl::ProjectPrivate(),
+                        gcs::PredefinedDefaultObjectAcl::ProjectPrivate(),
+                        gcs::Projection("full"))
+          .value();
+  std::cout << "# Running test on bucket: " << meta.name() << "\n";
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Start time: "
+            << google::cloud::internal::FormatRfc3339(
+                   std::chrono::system_clock::now())
+            << "\n# Region: " << options->region
+            << "\n# Duration: " << options->duration.count() << "s"
+            << "\n# Minimum Object Size: " << options->minimum_object_size
+            << "\n# Maximum Object Size: " << options->maximum_object_size
+            << "\n# Connection Pool Size: " << options->connection_pool_size
+            << "\n# Build info: " << notes << "\n";
+
+  auto const contents = gcs_bm::MakeRandomData(
+      generator, static_cast<std::size_t>(options->maximum_object_size));
+  std::uniform_int_distribution<std::int64_t> size_generator(
+      options->minimum_object_size, options->maximum_object_size);
+
+  auto const before = curl->request_counters();
+  std::cout << "# Counters before: " << before << "\n";
+  std::cout << "Op,ObjectSize,ElapsedMicroseconds,StatusCode\n";
+
+  std::map<std::string, Latencies> latencies;
+  auto report = [&latencies](std::string const& op, std::int64_t size,
+                             std::chrono::steady_clock::time_point start,
+                             google::cloud::Status const& status) {
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << op << ',' << size << ',' << elapsed.count() << ','
+              << status.code() << "\n";
+    if (status.ok()) latencies[op].push_back(elapsed);
+  };
+
+  auto deadline = std::chrono::system_clock::now() + options->duration;
+  for (auto now = std::chrono::system_clock::now(); now < deadline;
+       now = std::chrono::system_clock::now()) {
+    auto const object_name = gcs_bm::MakeRandomObjectName(generator);
+    auto const size = size_generator(generator);
+
+    auto start = std::chrono::steady_clock::now();
+    auto object_metadata = client.InsertObject(
+        bucket_name, object_name,
+        contents.substr(0, static_cast<std::size_t>(size)));
+    report("Upload", size, start, object_metadata.status());
+    if (!object_metadata) continue;
+
+    start = std::chrono::steady_clock::now();
+    auto reader = client.ReadObject(bucket_name, object_name);
+    std::string data{std::istreambuf_iterator<char>{reader}, {}};
+    report("Download", size, start, reader.status());
+
+    (void)client.DeleteObject(bucket_name, object_name,
+                              gcs::Generation(object_metadata->generation()));
+  }
+
+  for (auto const& kv : latencies) PrintPercentiles(kv.first, kv.second);
+  auto const after = curl->request_counters();
+  std::cout << "# Counters after: " << after << "\n";
+
+  std::cout << "# Deleting " << bucket_name << "\n";
+  gcs_bm::DeleteAllObjects(client, bucket_name, 1);
+  auto status = client.DeleteBucket(bucket_name);
+  if (!status.ok()) {
+    std::cerr << "# Error deleting bucket, status=" << status << "\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+namespace {
+
+using ::google::cloud::testing_util::OptionDescriptor;
+
+google::cloud::StatusOr<Options> ParseArgsDefault(
+    std::vector<std::string> const& argv) {
+  Options options;
+
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<OptionDescriptor> descriptors{
+      {"--help", "print the usage message",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print a description of the benchmark",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--project-id", "the GCP project to create the bucket",
+       [&options](std::string const& val) { options.project_id = val; }},
+      {"--region", "the GCS region used for the benchmark",
+       [&options](std::string const& val) { options.region = val; }},
+      {"--duration", "how long should the benchmark run (in seconds).",
+       [&options](std::string const& val) {
+         options.duration = gcs_bm::ParseDuration(val);
+       }},
+      {"--minimum-object-size", "the minimum size of the objects",
+       [&options](std::string const& val) {
+         options.minimum_object_size = gcs_bm::ParseSize(val);
+       }},
+      {"--maximum-object-size", "the maximum size of the objects",
+       [&options](std::string const& val) {
+         options.maximum_object_size = gcs_bm::ParseSize(val);
+       }},
+      {"--connection-pool-size", "configure gcs::Client connection pool size",
+       [&options](std::string const& val) {
+         options.connection_pool_size = std::stoul(val);
+       }},
+  };
+  auto usage = BuildUsage(descriptors, argv[0]);
+
+  auto unparsed = OptionsParse(descriptors, argv);
+  if (wants_help) {
+    std::cout << usage << "\n";
+  }
+
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+  }
+
+  if (unparsed.size() > 2) {
+    std::ostringstream os;
+    os << "Unknown arguments or options\n" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  if (unparsed.size() == 2) {
+    options.region = unparsed[1];
+  }
+  if (options.region.empty()) {
+    std::ostringstream os;
+    os << "Missing value for --region option" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  if (options.minimum_object_size <= 0 ||
+      options.minimum_object_size > options.maximum_object_size) {
+    std::ostringstream os;
+    os << "Invalid range for object sizes [" << options.minimum_object_size
+       << ',' << options.maximum_object_size << "]\n"
+       << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+
+  return options;
+}
+
+google::cloud::StatusOr<Options> SelfTest() {
+  using google::cloud::internal::GetEnv;
+
+  google::cloud::Status const self_test_error(
+      google::cloud::StatusCode::kUnknown, "self-test failure");
+
+  {
+    auto options = ParseArgsDefault(
+        {"self-test", "--help", "--description", "fake-region"});
+    if (!options) return options;
+  }
+  {
+    // Missing the region should be an error
+    auto options = ParseArgsDefault({"self-test"});
+    if (options) return self_test_error;
+  }
+  {
+    // An empty range of object sizes should be an error
+    auto options = ParseArgsDefault({"self-test", "fake-region",
+                                     "--minimum-object-size=64KiB",
+                                     "--maximum-object-size=4KiB"});
+    if (options) return self_test_error;
+  }
+
+  for (auto const& var :
+       {"GOOGLE_CLOUD_PROJECT", "GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID"}) {
+    auto const value = GetEnv(var).value_or("");
+    if (!value.empty()) continue;
+    std::ostringstream os;
+    os << "The environment variable " << var << " is not set or empty";
+    return google::cloud::Status(google::cloud::StatusCode::kUnknown,
+                                 std::move(os).str());
+  }
+  return ParseArgsDefault({
+      "self-test",
+      "--project-id=" + GetEnv("GOOGLE_CLOUD_PROJECT").value(),
+      "--duration=1s",
+      "--minimum-object-size=1KiB",
+      "--maximum-object-size=4KiB",
+      "--connection-pool-size=2",
+      "--region=" + GetEnv("GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID").value(),
+  });
+}
+
+google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]) {
+  bool auto_run =
+      google::cloud::internal::GetEnv("GOOGLE_CLOUD_CPP_AUTO_RUN_EXAMPLES")
+          .value_or("") == "yes";
+  if (auto_run) return SelfTest();
+
+  return ParseArgsDefault({argv, argv + argc});
+}
+
+}  // namespace
@@ -19,6 +19,8 @@
 storage_benchmark_programs = [
     "aggregate_throughput_benchmark.cc",
     "create_dataset.cc",
+    "embedded_throughput_benchmark.cc",
+    "small_object_latency_benchmark.cc",
     "storage_file_transfer_benchmark.cc",
     "storage_parallel_uploads_benchmark.cc",
     "storage_throughput_vs_cpu_benchmark.cc",
@@ -19,8 +19,8 @@
 storage_benchmarks_hdrs = [
     "aggregate_throughput_options.h",
     "benchmark_utils.h",
-    "bounded_queue.h",
     "create_dataset_options.h",
+    "embedded_server.h",
     "throughput_experiment.h",
     "throughput_options.h",
     "throughput_result.h",
@@ -30,6 +30,7 @@ storage_benchmarks_srcs = [
     "aggregate_throughput_options.cc",
     "benchmark_utils.cc",
     "create_dataset_options.cc",
+    "embedded_server.cc",
     "throughput_experiment.cc",
     "throughput_options.cc",
     "throughput_result.cc",
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
 #include "google/cloud/storage/client.h"
+#include "google/cloud/storage/parallel_download.h"
 #include "google/cloud/storage/testing/remove_stale_buckets.h"
 #include "google/cloud/internal/build_info.h"
 #include "google/cloud/internal/format_time_point.h"
@@ -38,6 +39,10 @@ the GCS object to a separate file. The program reports the time taken to perform
 the each operation, as well as the effective bandwidth (in Gbps and MiB/s). The
 program deletes the target GCS object after each iteration.
 
+If `--parallel-download-streams` is set to a non-zero value, each iteration also
+downloads the object using `ParallelDownloadFile()`, with (at most) that many
+concurrent streams, and reports the results as `ParallelFileDownload`.
+
 To perform this benchmark the program creates a new standard bucket, in a region
 configured via the command line. Other test parameters, such as the project id,
 the file size, and the buffer sizes are configurable via the command line too.
@@ -56,6 +61,7 @@ struct Options {
   std::int64_t file_size = 100 * gcs_bm::kMiB;
   std::size_t download_buffer_size = 16 * gcs_bm::kMiB;
   std::size_t upload_buffer_size = 16 * gcs_bm::kMiB;
+  std::size_t parallel_download_streams = 0;
 };
 
 google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]);
@@ -69,11 +75,17 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  auto client = gcs::Client(
+  auto client_options =
       google::cloud::Options{}
           .set<gcs::UploadBufferSizeOption>(options->upload_buffer_size)
           .set<gcs::DownloadBufferSizeOption>(options->download_buffer_size)
-          .set<gcs::ProjectIdOption>(options->project_id));
+          .set<gcs::ProjectIdOption>(options->project_id);
+  if (options->parallel_download_streams != 0) {
+    // Keep one pooled connection per download stream.
+    client_options.set<gcs::ConnectionPoolSizeOption>(
+        options->parallel_download_streams);
+  }
+  auto client = gcs::Client(std::move(client_options));
 
   std::cout << "# Cleaning up stale benchmark buckets\n";
   google::cloud::storage::testing::RemoveStaleBuckets(
@@ -111,6 +123,8 @@ int main(int argc, char* argv[]) {
             << options->download_buffer_size / gcs_bm::kKiB
             << "\n# Upload buffer size (KiB): "
             << options->upload_buffer_size / gcs_bm::kKiB
+            << "\n# Parallel download streams: "
+            << options->parallel_download_streams
             << "\n# Build info: " << notes << "\n";
 
   std::cout << "# Creating file to upload ..." << std::flush;
@@ -178,11 +192,34 @@ int main(int argc, char* argv[]) {
     std::cout << "FileDownload," << options->file_size << ','
               << download_elapsed.count() << ',' << gbps << ',' << ms.count()
               << ',' << mi_bs << ',' << object_metadata.status().code() << "\n";
+    std::remove(destination_filename.c_str());
+
+    if (options->parallel_download_streams != 0) {
+      auto const parallel_start = std::chrono::steady_clock::now();
+      auto status = gcs::ParallelDownloadFile(
+          client, object_metadata->bucket(), object_metadata->name(),
+          destination_filename,
+          gcs::MaxStreams(options->parallel_download_streams),
+          gcs::MinStreamSize(options->download_buffer_size));
+      auto const parallel_elapsed =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - parallel_start);
+      gbps = to_gbps(options->file_size, parallel_elapsed);
+      ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+          parallel_elapsed);
+      mi_bs = to_mibs(options->file_size, ms);
+      std::cout << "ParallelFileDownload," << options->file_size << ','
+                << parallel_elapsed.count() << ',' << gbps << ','
+                << ms.count() << ',' << mi_bs << ',' << status.code() << "\n";
+      if (!status.ok()) {
+        std::cout << "# Error in ParallelFileDownload: " << status << "\n";
+      }
+      std::remove(destination_filename.c_str());
+    }
 
     (void)client.DeleteObject(object_metadata->bucket(),
                               object_metadata->name(),
                               gcs::Generation(object_metadata->generation()));
-    std::remove(destination_filename.c_str());
   }
 
   std::remove(filename.c_str());
@@ -232,6 +269,11 @@ google::cloud::StatusOr<Options> ParseArgsDefault(
        }},
       {"--region", "The GCS region used for the benchmark",
        [&options](std::string const& val) { options.region = val; }},
+      {"--parallel-download-streams",
+       "also benchmark ParallelDownloadFile() with this many streams",
+       [&options](std::string const& val) {
+         options.parallel_download_streams = std::stoi(val);
+       }},
   };
   auto usage = BuildUsage(descriptors, argv[0]);
 
@@ -302,6 +344,7 @@ google::cloud::StatusOr<Options> SelfTest() {
       "--file-size=1KiB",
       "--upload-buffer-size=1KiB",
       "--download-buffer-size=1KiB",
+      "--parallel-download-streams=2",
       "--region=" + GetEnv("GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID").value(),
   });
 }
@@ -185,6 +185,8 @@ int main(int argc, char* argv[]) {
             << absl::StrJoin(options->enabled_crc32c, ",", Formatter{})
             << "\n# Enabled MD5: "
             << absl::StrJoin(options->enabled_md5, ",", Formatter{})
+            << "\n# Background Hashing: " << std::boolalpha
+            << options->background_hashing << std::noboolalpha
             << "\n# Build info: " << notes << "\n";
   // Make the output generated so far immediately visible, helps with debugging.
   std::cout << std::flush;
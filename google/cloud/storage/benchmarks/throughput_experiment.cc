@@ -39,11 +39,13 @@ namespace {
 class UploadObject : public ThroughputExperiment {
  public:
   explicit UploadObject(google::cloud::storage::Client client, ApiName api,
-                        std::string random_data, bool prefer_insert)
+                        std::string random_data, bool prefer_insert,
+                        bool background_hashing)
       : client_(std::move(client)),
         api_(api),
         random_data_(std::move(random_data)),
-        prefer_insert_(prefer_insert) {}
+        prefer_insert_(prefer_insert),
+        background_hashing_(background_hashing) {}
   ~UploadObject() override = default;
 
   ThroughputResult Run(std::string const& bucket_name,
@@ -86,7 +88,8 @@ class UploadObject : public ThroughputExperiment {
     auto writer = client_.WriteObject(
         bucket_name, object_name,
         gcs::DisableCrc32cChecksum(!config.enable_crc32c),
-        gcs::DisableMD5Hash(!config.enable_md5), api_selector);
+        gcs::DisableMD5Hash(!config.enable_md5),
+        gcs::UseBackgroundHashing(background_hashing_), api_selector);
     for (std::int64_t offset = 0; offset < config.object_size;
          offset += config.app_buffer_size) {
       auto len = config.app_buffer_size;
@@ -115,6 +118,7 @@ class UploadObject : public ThroughputExperiment {
   ApiName api_;
   std::string random_data_;
   bool prefer_insert_;
+  bool background_hashing_;
 };
 
 /**
@@ -122,8 +126,11 @@ class UploadObject : public ThroughputExperiment {
  */
 class DownloadObject : public ThroughputExperiment {
  public:
-  explicit DownloadObject(google::cloud::storage::Client client, ApiName api)
-      : client_(std::move(client)), api_(api) {}
+  explicit DownloadObject(google::cloud::storage::Client client, ApiName api,
+                          bool background_hashing)
+      : client_(std::move(client)),
+        api_(api),
+        background_hashing_(background_hashing) {}
   ~DownloadObject() override = default;
 
   ThroughputResult Run(std::string const& bucket_name,
@@ -142,7 +149,8 @@ class DownloadObject : public ThroughputExperiment {
     auto reader = client_.ReadObject(
         bucket_name, object_name,
         gcs::DisableCrc32cChecksum(!config.enable_crc32c),
-        gcs::DisableMD5Hash(!config.enable_md5), api_selector);
+        gcs::DisableMD5Hash(!config.enable_md5),
+        gcs::UseBackgroundHashing(background_hashing_), api_selector);
     for (std::uint64_t num_read = 0; reader.read(buffer.data(), buffer.size());
          num_read += reader.gcount()) {
     }
@@ -162,6 +170,7 @@ class DownloadObject : public ThroughputExperiment {
  private:
   google::cloud::storage::Client client_;
   ApiName api_;
+  bool background_hashing_;
 };
 
 extern "C" std::size_t OnWrite(char* src, size_t size, size_t nmemb, void* d) {
@@ -341,19 +350,19 @@ std::vector<std::unique_ptr<ThroughputExperiment>> CreateUploadExperiments(
     switch (a) {
       case ApiName::kApiGrpc:
       case ApiName::kApiRawGrpc:
-        result.push_back(
-            absl::make_unique<UploadObject>(grpc_client, a, contents, false));
-        result.push_back(
-            absl::make_unique<UploadObject>(grpc_client, a, contents, true));
+        result.push_back(absl::make_unique<UploadObject>(
+            grpc_client, a, contents, false, options.background_hashing));
+        result.push_back(absl::make_unique<UploadObject>(
+            grpc_client, a, contents, true, options.background_hashing));
         break;
       case ApiName::kApiXml:
       case ApiName::kApiJson:
       case ApiName::kApiRawJson:
       case ApiName::kApiRawXml:
-        result.push_back(
-            absl::make_unique<UploadObject>(rest_client, a, contents, false));
-        result.push_back(
-            absl::make_unique<UploadObject>(rest_client, a, contents, true));
+        result.push_back(absl::make_unique<UploadObject>(
+            rest_client, a, contents, false, options.background_hashing));
+        result.push_back(absl::make_unique<UploadObject>(
+            rest_client, a, contents, true, options.background_hashing));
         break;
     }
   }
@@ -378,11 +387,13 @@ std::vector<std::unique_ptr<ThroughputExperiment>> CreateDownloadExperiments(
   for (auto a : options.enabled_apis) {
     switch (a) {
       case ApiName::kApiGrpc:
-        result.push_back(absl::make_unique<DownloadObject>(grpc_client, a));
+        result.push_back(absl::make_unique<DownloadObject>(
+            grpc_client, a, options.background_hashing));
         break;
       case ApiName::kApiXml:
       case ApiName::kApiJson:
-        result.push_back(absl::make_unique<DownloadObject>(rest_client, a));
+        result.push_back(absl::make_unique<DownloadObject>(
+            rest_client, a, options.background_hashing));
         break;
       case ApiName::kApiRawXml:
       case ApiName::kApiRawJson:
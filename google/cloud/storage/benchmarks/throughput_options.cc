@@ -127,6 +127,10 @@ google::cloud::StatusOr<ThroughputOptions> ParseThroughputOptions(
        [&options, &parse_checksums](std::string const& val) {
          options.enabled_md5 = parse_checksums(val);
        }},
+      {"--background-hashing", "compute MD5 hashes in a background thread",
+       [&options](std::string const& val) {
+         options.background_hashing = ParseBoolean(val).value_or(false);
+       }},
   };
   auto usage = BuildUsage(desc, argv[0]);
 
@@ -50,6 +50,7 @@ struct ThroughputOptions {
   };
   std::vector<bool> enabled_crc32c = {false, true};
   std::vector<bool> enabled_md5 = {false, true};
+  bool background_hashing = false;
 };
 
 google::cloud::StatusOr<ThroughputOptions> ParseThroughputOptions(
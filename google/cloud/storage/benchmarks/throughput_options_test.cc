@@ -47,6 +47,7 @@ TEST(ThroughputOptions, Basic) {
       "--enabled-crc32c=enabled",
       "--enabled-md5=disabled",
       "--client-per-thread=false",
+      "--background-hashing=true",
   });
   ASSERT_STATUS_OK(options);
   EXPECT_EQ("test-project", options->project_id);
@@ -68,6 +69,7 @@ TEST(ThroughputOptions, Basic) {
                                    ApiName::kApiJson));
   EXPECT_THAT(options->enabled_crc32c, ElementsAre(true));
   EXPECT_THAT(options->enabled_md5, ElementsAre(false));
+  EXPECT_TRUE(options->background_hashing);
 }
 
 TEST(ThroughputOptions, Description) {
@@ -0,0 +1,149 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/bulk_operations.h"
+#include "absl/types/optional.h"
+#include <algorithm>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+double BulkOperationResult::OperationsPerSecond() const {
+  using seconds = std::chrono::duration<double>;
+  auto const s = std::chrono::duration_cast<seconds>(elapsed).count();
+  if (s <= 0) return 0;
+  auto const count = succeeded + static_cast<std::int64_t>(failures.size());
+  return static_cast<double>(count) / s;
+}
+
+namespace internal {
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(std::size_t max_limit)
+    : max_limit_((std::max)(max_limit, std::size_t{1})), limit_(max_limit_) {}
+
+void AdaptiveConcurrencyLimiter::Acquire() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return in_flight_ < limit_; });
+  ++in_flight_;
+}
+
+void AdaptiveConcurrencyLimiter::Release(bool throttled) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    --in_flight_;
+    if (throttled) {
+      limit_ = (std::max)(limit_ / 2, std::size_t{1});
+      successes_ = 0;
+    } else if (++successes_ >= limit_) {
+      limit_ = (std::min)(limit_ + 1, max_limit_);
+      successes_ = 0;
+    }
+  }
+  cv_.notify_all();
+}
+
+std::size_t AdaptiveConcurrencyLimiter::limit() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return limit_;
+}
+
+bool IsThrottled(Status const& status) {
+  // The service returns 429 and 503 when the request rate is too high, these
+  // are mapped to `kResourceExhausted` and `kUnavailable`.
+  return status.code() == StatusCode::kResourceExhausted ||
+         status.code() == StatusCode::kUnavailable;
+}
+
+BulkOperationResult RunBulkOperation(ListObjectsReader objects,
+                                     BulkOperation const& operation,
+                                     std::size_t concurrency,
+                                     BackoffPolicy const& backoff,
+                                     int max_throttled_attempts) {
+  auto const start = std::chrono::steady_clock::now();
+  concurrency = (std::max)(concurrency, std::size_t{1});
+  AdaptiveConcurrencyLimiter limiter(concurrency);
+
+  // The listing is not thread-safe, all access is serialized by `mu`, and so
+  // are the updates to `result`.
+  std::mutex mu;
+  BulkOperationResult result;
+  auto it = objects.begin();
+  auto const end = objects.end();
+  bool listing_done = false;
+  auto next = [&]() -> absl::optional<ObjectMetadata> {
+    std::lock_guard<std::mutex> lk(mu);
+    if (listing_done || it == end) {
+      listing_done = true;
+      return absl::nullopt;
+    }
+    auto object = std::move(*it);
+    ++it;
+    if (object) return *std::move(object);
+    result.list_status = std::move(object).status();
+    listing_done = true;
+    return absl::nullopt;
+  };
+
+  auto worker = [&] {
+    for (auto object = next(); object.has_value(); object = next()) {
+      auto policy = backoff.clone();
+      std::int64_t throttled = 0;
+      Status status;
+      for (int attempt = 0;; ++attempt) {
+        limiter.Acquire();
+        status = operation(*object);
+        auto const is_throttled = IsThrottled(status);
+        limiter.Release(is_throttled);
+        if (!is_throttled) break;
+        ++throttled;
+        if (attempt + 1 >= max_throttled_attempts) break;
+        std::this_thread::sleep_for(policy->OnCompletion());
+      }
+      std::lock_guard<std::mutex> lk(mu);
+      result.throttled += throttled;
+      if (status.ok()) {
+        ++result.succeeded;
+        continue;
+      }
+      result.failures.push_back(BulkOperationFailure{
+          object->bucket(), object->name(), object->generation(),
+          std::move(status)});
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(concurrency);
+  for (std::size_t i = 0; i != concurrency; ++i) threads.emplace_back(worker);
+  for (auto& t : threads) t.join();
+
+  result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  return result;
+}
+
+std::size_t DefaultBulkConcurrency() { return 16; }
+
+ExponentialBackoffPolicy DefaultBulkBackoffPolicy() {
+  return ExponentialBackoffPolicy(std::chrono::seconds(1),
+                                  std::chrono::seconds(32), 2.0);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,264 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BULK_OPERATIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BULK_OPERATIONS_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/tuple_filter.h"
+#include "google/cloud/storage/list_objects_reader.h"
+#include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/internal/tuple.h"
+#include "google/cloud/status.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * A parameter type indicating the maximum number of concurrent operations in
+ * `BulkDeleteObjects()` and `BulkRewriteObjects()`.
+ */
+class BulkConcurrency {
+ public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  BulkConcurrency(std::size_t value) : value_(value) {}
+  std::size_t value() const { return value_; }
+
+ private:
+  std::size_t value_;
+};
+
+/// An operation that failed in `BulkDeleteObjects()` or `BulkRewriteObjects()`.
+struct BulkOperationFailure {
+  std::string bucket;
+  std::string name;
+  std::int64_t generation;
+  Status status;
+};
+
+/// The results of `BulkDeleteObjects()` and `BulkRewriteObjects()`.
+struct BulkOperationResult {
+  /// The number of successful operations.
+  std::int64_t succeeded = 0;
+  /// The number of attempts rejected by the service with 429 or 503 errors.
+  std::int64_t throttled = 0;
+  /// The operations that failed, in no particular order.
+  std::vector<BulkOperationFailure> failures;
+  /// The error that stopped the listing, if any.
+  Status list_status;
+  /// The time to complete all the operations.
+  std::chrono::microseconds elapsed{0};
+
+  /// The number of completed (successful or not) operations per second.
+  double OperationsPerSecond() const;
+};
+
+namespace internal {
+
+/**
+ * Limits the number of concurrent operations, adapting to throttling.
+ *
+ * The limit starts at the maximum, it is halved each time an operation is
+ * throttled, and grows by one after `limit` consecutive operations succeed,
+ * that is, an additive-increase/multiplicative-decrease scheme.
+ */
+class AdaptiveConcurrencyLimiter {
+ public:
+  explicit AdaptiveConcurrencyLimiter(std::size_t max_limit);
+
+  /// Blocks until there are fewer operations in flight than the limit.
+  void Acquire();
+
+  /// Report the completion of an operation started after `Acquire()`.
+  void Release(bool throttled);
+
+  std::size_t limit() const;
+
+ private:
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::size_t const max_limit_;
+  std::size_t limit_;
+  std::size_t in_flight_ = 0;
+  std::size_t successes_ = 0;
+};
+
+/// Returns true if @p status represents a 429 or 503 error.
+bool IsThrottled(Status const& status);
+
+using BulkOperation = std::function<Status(ObjectMetadata const&)>;
+
+/**
+ * Runs @p operation on each object in @p objects, using multiple threads.
+ *
+ * Throttled operations are retried, after waiting as indicated by @p backoff,
+ * up to @p max_throttled_attempts times.
+ */
+BulkOperationResult RunBulkOperation(ListObjectsReader objects,
+                                     BulkOperation const& operation,
+                                     std::size_t concurrency,
+                                     BackoffPolicy const& backoff,
+                                     int max_throttled_attempts);
+
+/// The default concurrency for `BulkDeleteObjects()` and friends.
+std::size_t DefaultBulkConcurrency();
+
+/// The backoff policy for throttled operations in bulk operations.
+ExponentialBackoffPolicy DefaultBulkBackoffPolicy();
+
+/// The number of attempts for throttled operations in bulk operations.
+constexpr int kBulkMaxThrottledAttempts = 8;
+
+template <typename... Options>
+std::size_t BulkConcurrencyValue(std::tuple<Options...> const& options) {
+  auto value = ExtractFirstOccurrenceOfType<BulkConcurrency>(options);
+  return value ? value->value() : DefaultBulkConcurrency();
+}
+
+struct BulkRewriteApplyHelper {
+  template <typename... Options>
+  Status operator()(Options... options) const {
+    return client
+        .RewriteObjectBlocking(source.bucket(), source.name(),
+                               destination_bucket, destination_object,
+                               SourceGeneration(source.generation()),
+                               std::move(options)...)
+        .status();
+  }
+
+  Client& client;
+  ObjectMetadata const& source;
+  std::string const& destination_bucket;
+  std::string destination_object;
+};
+
+}  // namespace internal
+
+/**
+ * Deletes the objects returned by a listing, using concurrent requests.
+ *
+ * Each object is deleted using its `Generation`, that is, only the versions
+ * returned by @p objects are deleted, even if they are overwritten while this
+ * function runs. With the generation set, the requests are idempotent with
+ * both the default and the `AlwaysRetryIdempotencyPolicy`, and each request
+ * is retried using the client's policies.
+ *
+ * The number of concurrent requests starts at `BulkConcurrency` and is
+ * reduced when the service returns 429 or 503 errors. Throttled requests are
+ * retried with exponential backoff, in addition to any retries in the client.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * auto result = gcs::BulkDeleteObjects(
+ *     client, client.ListObjects("my-bucket", gcs::Prefix("tmp/")),
+ *     gcs::BulkConcurrency(32));
+ * std::cout << result.OperationsPerSecond() << " deletes/s\n";
+ * @endcode
+ *
+ * @param client the client on which to perform the operations.
+ * @param objects the objects to delete, typically from `Client::ListObjects()`.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `BulkConcurrency`, `QuotaUser`,
+ *     `UserIp`, and `UserProject`.
+ */
+template <typename... Options>
+BulkOperationResult BulkDeleteObjects(Client client, ListObjectsReader objects,
+                                      Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto all_options = std::tie(options...);
+  static_assert(
+      std::tuple_size<
+          decltype(StaticTupleFilter<NotAmong<
+                       BulkConcurrency, QuotaUser, UserIp, UserProject>::TPred>(
+              all_options))>::value == 0,
+      "This functions accepts only options of type BulkConcurrency, "
+      "QuotaUser, UserIp, or UserProject.");
+  auto request_options =
+      StaticTupleFilter<NotAmong<BulkConcurrency>::TPred>(all_options);
+  auto operation = [client, request_options](ObjectMetadata const& o) mutable {
+    return google::cloud::internal::apply(
+        internal::DeleteApplyHelper{client, o.bucket(), o.name(),
+                                    o.generation()},
+        request_options);
+  };
+  return internal::RunBulkOperation(std::move(objects), operation,
+                                    internal::BulkConcurrencyValue(all_options),
+                                    internal::DefaultBulkBackoffPolicy(),
+                                    internal::kBulkMaxThrottledAttempts);
+}
+
+/**
+ * Copies the objects returned by a listing, using concurrent rewrites.
+ *
+ * This is the bulk version of `Client::RewriteObjectBlocking()`. Each object
+ * is copied using its `SourceGeneration`. Retrying a rewrite of the same
+ * source generation produces the same destination contents, the requests are
+ * retried using the client's policies, and throttled requests are retried as
+ * described in `BulkDeleteObjects()`. Use `IfGenerationMatch(0)` to avoid
+ * overwriting existing objects.
+ *
+ * @param client the client on which to perform the operations.
+ * @param objects the objects to copy, typically from `Client::ListObjects()`.
+ * @param destination_bucket the bucket for the new objects.
+ * @param destination_name returns the name of the new object for each source.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `BulkConcurrency`, and the
+ *     options for `Client::RewriteObjectBlocking()`, other than
+ *     `SourceGeneration`.
+ */
+template <typename... Options>
+BulkOperationResult BulkRewriteObjects(
+    Client client, ListObjectsReader objects, std::string destination_bucket,
+    std::function<std::string(ObjectMetadata const&)> destination_name,
+    Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto all_options = std::tie(options...);
+  auto request_options =
+      StaticTupleFilter<NotAmong<BulkConcurrency>::TPred>(all_options);
+  auto operation = [client, request_options, destination_bucket,
+                    destination_name](ObjectMetadata const& o) mutable {
+    return google::cloud::internal::apply(
+        internal::BulkRewriteApplyHelper{client, o, destination_bucket,
+                                         destination_name(o)},
+        request_options);
+  };
+  return internal::RunBulkOperation(std::move(objects), operation,
+                                    internal::BulkConcurrencyValue(all_options),
+                                    internal::DefaultBulkBackoffPolicy(),
+                                    internal::kBulkMaxThrottledAttempts);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BULK_OPERATIONS_H
@@ -0,0 +1,270 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/bulk_operations.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ListObjectsRequest;
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::cloud::testing_util::chrono_literals::operator"" _us;
+
+ObjectMetadata CreateObject(int index) {
+  return internal::ObjectMetadataParser::FromJson(
+             nlohmann::json{
+                 {"bucket", "test-bucket"},
+                 {"name", "object-" + std::to_string(index)},
+                 {"generation", std::to_string(1000 + index)},
+             })
+      .value();
+}
+
+/// Configure @p mock to list @p count objects, two objects per page.
+void ListObjects(MockClient& mock, int count) {
+  EXPECT_CALL(mock, ListObjects)
+      .WillRepeatedly([count](ListObjectsRequest const& r) {
+        auto const offset =
+            r.page_token().empty() ? 0 : std::stoi(r.page_token());
+        ListObjectsResponse response;
+        for (int i = offset; i != offset + 2 && i != count; ++i) {
+          response.items.push_back(CreateObject(i));
+        }
+        if (offset + 2 < count) {
+          response.next_page_token = std::to_string(offset + 2);
+        }
+        return make_status_or(response);
+      });
+}
+
+TEST(BulkOperationsTest, AdaptiveConcurrencyLimiter) {
+  internal::AdaptiveConcurrencyLimiter limiter(8);
+  EXPECT_EQ(8, limiter.limit());
+  limiter.Acquire();
+  limiter.Release(/*throttled=*/true);
+  EXPECT_EQ(4, limiter.limit());
+  limiter.Acquire();
+  limiter.Release(/*throttled=*/true);
+  limiter.Acquire();
+  limiter.Release(/*throttled=*/true);
+  limiter.Acquire();
+  limiter.Release(/*throttled=*/true);
+  EXPECT_EQ(1, limiter.limit());
+  // Grows by one after `limit` successes in a row.
+  limiter.Acquire();
+  limiter.Release(/*throttled=*/false);
+  EXPECT_EQ(2, limiter.limit());
+  limiter.Acquire();
+  limiter.Release(/*throttled=*/false);
+  EXPECT_EQ(2, limiter.limit());
+  limiter.Acquire();
+  limiter.Release(/*throttled=*/false);
+  EXPECT_EQ(3, limiter.limit());
+}
+
+TEST(BulkOperationsTest, IsThrottled) {
+  EXPECT_TRUE(internal::IsThrottled(Status(StatusCode::kUnavailable, "")));
+  EXPECT_TRUE(
+      internal::IsThrottled(Status(StatusCode::kResourceExhausted, "")));
+  EXPECT_FALSE(internal::IsThrottled(Status()));
+  EXPECT_FALSE(internal::IsThrottled(PermanentError()));
+}
+
+TEST(BulkOperationsTest, DeleteObjects) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjects(*mock, 7);
+  std::mutex mu;
+  std::set<std::string> deleted;
+  EXPECT_CALL(*mock, DeleteObject)
+      .Times(7)
+      .WillRepeatedly([&](internal::DeleteObjectRequest const& r) {
+        EXPECT_EQ("test-bucket", r.bucket_name());
+        EXPECT_EQ("test-project", r.GetOption<UserProject>().value_or(""));
+        auto const name = r.object_name();
+        EXPECT_EQ(1000 + std::stoi(name.substr(name.find('-') + 1)),
+                  r.GetOption<Generation>().value_or(0));
+        std::lock_guard<std::mutex> lk(mu);
+        deleted.insert(name);
+        return make_status_or(internal::EmptyResponse{});
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  auto result =
+      BulkDeleteObjects(client, client.ListObjects("test-bucket"),
+                        BulkConcurrency(3), UserProject("test-project"));
+  EXPECT_EQ(7, result.succeeded);
+  EXPECT_EQ(0, result.throttled);
+  EXPECT_TRUE(result.failures.empty());
+  EXPECT_STATUS_OK(result.list_status);
+  EXPECT_EQ(7, deleted.size());
+}
+
+TEST(BulkOperationsTest, RewriteObjects) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjects(*mock, 3);
+  EXPECT_CALL(*mock, RewriteObject)
+      .Times(3)
+      .WillRepeatedly([](internal::RewriteObjectRequest const& r) {
+        EXPECT_EQ("test-bucket", r.source_bucket());
+        EXPECT_EQ("dest-bucket", r.destination_bucket());
+        EXPECT_EQ("copy/" + r.source_object(), r.destination_object());
+        EXPECT_TRUE(r.HasOption<SourceGeneration>());
+        EXPECT_EQ(0, r.GetOption<IfGenerationMatch>().value_or(-1));
+        internal::RewriteObjectResponse response{0, 0, true, "", {}};
+        return make_status_or(response);
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  auto result = BulkRewriteObjects(
+      client, client.ListObjects("test-bucket"), "dest-bucket",
+      [](ObjectMetadata const& o) { return "copy/" + o.name(); },
+      IfGenerationMatch(0), BulkConcurrency(2));
+  EXPECT_EQ(3, result.succeeded);
+  EXPECT_TRUE(result.failures.empty());
+}
+
+TEST(BulkOperationsTest, ReportsFailures) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjects(*mock, 4);
+  EXPECT_CALL(*mock, DeleteObject)
+      .WillRepeatedly([](internal::DeleteObjectRequest const& r) {
+        if (r.object_name() == "object-2") {
+          return StatusOr<internal::EmptyResponse>(PermanentError());
+        }
+        return make_status_or(internal::EmptyResponse{});
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  auto result = BulkDeleteObjects(client, client.ListObjects("test-bucket"));
+  EXPECT_EQ(3, result.succeeded);
+  ASSERT_EQ(1, result.failures.size());
+  EXPECT_EQ("object-2", result.failures[0].name);
+  EXPECT_EQ(1002, result.failures[0].generation);
+  EXPECT_THAT(result.failures[0].status, StatusIs(PermanentError().code()));
+}
+
+TEST(BulkOperationsTest, ListError) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillOnce([](ListObjectsRequest const&) {
+        ListObjectsResponse response;
+        response.items.push_back(CreateObject(0));
+        response.next_page_token = "2";
+        return make_status_or(response);
+      })
+      .WillOnce(
+          [](ListObjectsRequest const&) -> StatusOr<ListObjectsResponse> {
+            return PermanentError();
+          });
+  EXPECT_CALL(*mock, DeleteObject)
+      .WillOnce([](internal::DeleteObjectRequest const&) {
+        return make_status_or(internal::EmptyResponse{});
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  auto result = BulkDeleteObjects(client, client.ListObjects("test-bucket"));
+  EXPECT_EQ(1, result.succeeded);
+  EXPECT_THAT(result.list_status, StatusIs(PermanentError().code()));
+}
+
+TEST(BulkOperationsTest, RetriesThrottled) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjects(*mock, 5);
+  auto client = testing::ClientFromMock(mock);
+
+  std::mutex mu;
+  std::vector<std::string> attempts;
+  auto operation = [&](ObjectMetadata const& o) {
+    std::lock_guard<std::mutex> lk(mu);
+    attempts.push_back(o.name());
+    // The first two attempts for `object-1` are throttled.
+    auto const count = std::count(attempts.begin(), attempts.end(), o.name());
+    if (o.name() == "object-1" && count <= 2) {
+      return Status(StatusCode::kResourceExhausted, "slow down");
+    }
+    // `object-3` is always throttled.
+    if (o.name() == "object-3") {
+      return Status(StatusCode::kUnavailable, "try again");
+    }
+    return Status();
+  };
+  auto result = internal::RunBulkOperation(
+      client.ListObjects("test-bucket"), operation, 4,
+      ExponentialBackoffPolicy(1_us, 2_us, 2.0), /*max_throttled_attempts=*/3);
+  EXPECT_EQ(4, result.succeeded);
+  EXPECT_EQ(2 + 3, result.throttled);
+  ASSERT_EQ(1, result.failures.size());
+  EXPECT_EQ("object-3", result.failures[0].name);
+  EXPECT_THAT(result.failures[0].status, StatusIs(StatusCode::kUnavailable));
+  EXPECT_EQ(3, std::count(attempts.begin(), attempts.end(), "object-1"));
+  EXPECT_EQ(3, std::count(attempts.begin(), attempts.end(), "object-3"));
+}
+
+TEST(BulkOperationsTest, LimitsConcurrency) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjects(*mock, 20);
+  auto client = testing::ClientFromMock(mock);
+
+  std::atomic<int> in_flight{0};
+  std::atomic<int> max_in_flight{0};
+  auto operation = [&](ObjectMetadata const&) {
+    auto const current = ++in_flight;
+    auto observed = max_in_flight.load();
+    while (current > observed &&
+           !max_in_flight.compare_exchange_weak(observed, current)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    --in_flight;
+    return Status();
+  };
+  auto result = internal::RunBulkOperation(
+      client.ListObjects("test-bucket"), operation, 3,
+      ExponentialBackoffPolicy(1_us, 2_us, 2.0), 3);
+  EXPECT_EQ(20, result.succeeded);
+  EXPECT_LE(max_in_flight.load(), 3);
+  EXPECT_GT(result.OperationsPerSecond(), 0);
+}
+
+TEST(BulkOperationsTest, OperationsPerSecond) {
+  BulkOperationResult result;
+  EXPECT_EQ(0, result.OperationsPerSecond());
+  result.succeeded = 9;
+  result.failures.push_back(BulkOperationFailure{"b", "o", 1, Status()});
+  result.elapsed = std::chrono::seconds(2);
+  EXPECT_DOUBLE_EQ(5.0, result.OperationsPerSecond());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,13 +15,23 @@
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/storage/internal/file_region_sink.h"
+#include "google/cloud/storage/internal/gzip_object_read_source.h"
+#include "google/cloud/storage/internal/iam_cache_client.h"
+#include "google/cloud/storage/internal/mapped_file.h"
+#include "google/cloud/storage/internal/object_metadata_cache_client.h"
 #include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/storage/internal/pipelined_resumable_upload_session.h"
+#include "google/cloud/storage/internal/positional_file_writer.h"
+#include "google/cloud/storage/internal/rate_limited_transfer.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
 #include "google/cloud/internal/algorithm.h"
 #include "google/cloud/internal/filesystem.h"
+#include "google/cloud/memory_accountant.h"
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
 #include <openssl/md5.h>
+#include <algorithm>
 #include <fstream>
 #include <thread>
 
@@ -35,6 +45,46 @@ static_assert(std::is_copy_constructible<storage::Client>::value,
 static_assert(std::is_copy_assignable<storage::Client>::value,
               "storage::Client must be assignable");
 
+namespace {
+
+template <typename ReportError>
+Status DownloadFileDirectIo(ObjectReadStream stream,
+                            std::string const& file_name,
+                            std::size_t buffer_size,
+                            ReportError const& report_error) {
+  char const* func = "DownloadFileImpl";
+  auto writer = internal::PositionalFileWriter::Create(file_name, 0,
+                                                       /*direct_io=*/true);
+  if (!writer) {
+    return report_error(func, "cannot open download destination file",
+                        writer.status());
+  }
+  // Receive the data directly into aligned buffers, and write each buffer in
+  // the background while the next one is received.
+  internal::FileRegionSink sink(**writer, 0, buffer_size);
+  Status status;
+  do {
+    auto buffer = sink.buffer();
+    stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    status = sink.Commit(static_cast<std::size_t>(stream.gcount()));
+  } while (status.ok() && stream.good());
+  auto close = sink.Close();
+  if (status.ok()) status = std::move(close);
+  close = (*writer)->Close();
+  if (status.ok()) status = std::move(close);
+  if (!status.ok()) {
+    return report_error(func, "cannot write download destination file",
+                        status);
+  }
+  if (!stream.status().ok()) {
+    return report_error(func, "error reading download source object",
+                        stream.status());
+  }
+  return Status();
+}
+
+}  // namespace
+
 Client::Client(Options opts)
     : Client(Client::InternalOnlyNoDecorations{},
              Client::CreateDefaultInternalClient(
@@ -49,7 +99,23 @@ std::shared_ptr<internal::RawClient> Client::CreateDefaultInternalClient(
   if (enable_logging) {
     client = std::make_shared<internal::LoggingClient>(std::move(client));
   }
-  return std::make_shared<internal::RetryClient>(std::move(client), opts);
+  client = std::make_shared<internal::RetryClient>(std::move(client), opts);
+  auto const iam_cache_size =
+      opts.get<storage_experimental::IamCacheSizeOption>();
+  if (iam_cache_size != 0) {
+    client = std::make_shared<internal::IamCacheClient>(
+        std::move(client), iam_cache_size,
+        opts.get<storage_experimental::IamCacheTtlOption>());
+  }
+  auto const cache_size =
+      opts.get<storage_experimental::ObjectMetadataCacheSizeOption>();
+  if (cache_size == 0) return client;
+  // Cache hits skip the retry loop and any logging.
+  return std::make_shared<internal::ObjectMetadataCacheClient>(
+      std::move(client),
+      std::make_shared<internal::ObjectMetadataCache>(
+          cache_size,
+          opts.get<storage_experimental::ObjectMetadataCacheTtlOption>()));
 }
 
 std::shared_ptr<internal::RawClient> Client::CreateDefaultInternalClient(
@@ -69,10 +135,15 @@ ObjectReadStream Client::ReadObjectImpl(
     error_stream.setstate(std::ios::badbit | std::ios::eofbit);
     return error_stream;
   }
+  auto const options = internal::MakeOptions(raw_client_->client_options());
   auto stream =
       ObjectReadStream(absl::make_unique<internal::ObjectReadStreambuf>(
-          request, *std::move(source),
-          request.GetOption<ReadFromOffset>().value_or(0)));
+          request,
+          internal::DecompressDownload(
+              request, internal::RateLimitDownload(options, request,
+                                                   *std::move(source))),
+          request.GetOption<ReadFromOffset>().value_or(0),
+          options.get<storage_experimental::IoBufferPoolOption>()));
   (void)stream.peek();
 #if !GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
   // Without exceptions the streambuf cannot report errors, so we have to
@@ -84,6 +155,42 @@ ObjectReadStream Client::ReadObjectImpl(
   return stream;
 }
 
+ObjectBufferReader Client::ReadObjectToBuffersImpl(
+    internal::ReadObjectRangeRequest const& request) {
+  auto source = raw_client_->ReadObject(request);
+  if (!source) return ObjectBufferReader(std::move(source).status());
+  auto const options = internal::MakeOptions(raw_client_->client_options());
+  return ObjectBufferReader(
+      request, internal::DecompressDownload(
+                   request, internal::RateLimitDownload(options, request,
+                                                        *std::move(source))));
+}
+
+StatusOr<RandomAccessObjectReader> Client::OpenRandomAccessReaderImpl(
+    internal::ReadObjectRangeRequest const& request) {
+  internal::GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                                      request.object_name());
+  metadata_request.set_multiple_options(
+      request.GetOption<Generation>(), request.GetOption<IfGenerationMatch>(),
+      request.GetOption<IfGenerationNotMatch>(),
+      request.GetOption<IfMetagenerationMatch>(),
+      request.GetOption<IfMetagenerationNotMatch>(),
+      request.GetOption<UserProject>(), request.GetOption<QuotaUser>(),
+      request.GetOption<UserIp>());
+  auto metadata = raw_client_->GetObjectMetadata(metadata_request);
+  if (!metadata) return std::move(metadata).status();
+
+  auto const options = internal::MakeOptions(raw_client_->client_options());
+  internal::RandomAccessReaderConfig config{
+      options.get<storage_experimental::RandomAccessMinReadaheadOption>(),
+      options.get<storage_experimental::RandomAccessMaxReadaheadOption>(),
+      options.get<storage_experimental::RandomAccessMaxIdleStreamsOption>()};
+  return RandomAccessObjectReader(
+      std::make_shared<internal::RandomAccessReaderImpl>(
+          raw_client_, request, metadata->generation(),
+          static_cast<std::int64_t>(metadata->size()), config));
+}
+
 ObjectWriteStream Client::WriteObjectImpl(
     internal::ResumableUploadRequest const& request) {
   auto session = raw_client_->CreateResumableSession(request);
@@ -100,16 +207,41 @@ ObjectWriteStream Client::WriteObjectImpl(
     error_stream.Close();
     return error_stream;
   }
+  auto const options = internal::MakeOptions(raw_client_->client_options());
+  // Rate limit the session before pipelining, so the background uploads are
+  // limited too.
+  auto upload_session =
+      internal::RateLimitUpload(options, request, *std::move(session));
+  auto const buffer_size = raw_client_->client_options().upload_buffer_size();
+  std::unique_ptr<internal::UploadChunkSizer> chunk_sizer;
+  auto const depth = request.GetOption<UploadPipelineDepth>().value_or(1);
+  if (depth > 1) {
+    upload_session =
+        absl::make_unique<internal::PipelinedResumableUploadSession>(
+            std::move(upload_session), depth);
+  } else {
+    // The chunks are uploaded in the background with pipelining, the elapsed
+    // time does not measure the throughput.
+    if (options.get<storage_experimental::AdaptiveUploadBufferSizeOption>()) {
+      chunk_sizer = absl::make_unique<internal::UploadChunkSizer>(
+          buffer_size,
+          options.get<storage_experimental::MinimumUploadBufferSizeOption>(),
+          options.get<storage_experimental::MaximumUploadBufferSizeOption>());
+    }
+  }
   return ObjectWriteStream(absl::make_unique<internal::ObjectWriteStreambuf>(
-      *std::move(session), raw_client_->client_options().upload_buffer_size(),
+      std::move(upload_session), buffer_size,
       internal::CreateHashFunction(request),
       internal::HashValues{
           request.GetOption<Crc32cChecksumValue>().value_or(""),
           request.GetOption<MD5HashValue>().value_or(""),
       },
       internal::CreateHashValidator(request),
-      request.GetOption<AutoFinalize>().value_or(
-          AutoFinalizeConfig::kEnabled)));
+      request.GetOption<AutoFinalize>().value_or(AutoFinalizeConfig::kEnabled),
+      std::move(chunk_sizer),
+      options.get<storage_experimental::IoBufferPoolOption>(),
+      google::cloud::internal::MakeMemoryAccount(
+          options, "storage.ObjectWriteStream/" + request.bucket_name())));
 }
 
 bool Client::UseSimpleUpload(std::string const& file_name,
@@ -141,26 +273,18 @@ StatusOr<ObjectMetadata> Client::UploadFileSimple(
                                     file_size - upload_offset),
                                 file_size - upload_offset);
 
-  std::ifstream is(file_name, std::ios::binary);
-  if (!is.is_open()) {
+  // Map the file instead of reading it, the bytes go from the page cache to
+  // the hash functions and the socket without copying them.
+  auto file = internal::MappedFile::Open(
+      file_name, upload_offset, static_cast<std::size_t>(upload_size));
+  if (!file) {
     std::ostringstream os;
     os << __func__ << "(" << request << ", " << file_name
-       << "): cannot open upload file source";
-    return Status(StatusCode::kNotFound, std::move(os).str());
-  }
-
-  std::string payload(static_cast<std::size_t>(upload_size), char{});
-  is.seekg(upload_offset, std::ios::beg);
-  is.read(&payload[0], payload.size());
-  if (static_cast<std::size_t>(is.gcount()) < payload.size()) {
-    std::ostringstream os;
-    os << __func__ << "(" << request << ", " << file_name << "): Actual read ("
-       << is.gcount() << ") is smaller than upload_size (" << payload.size()
-       << ")";
-    return Status(StatusCode::kInternal, std::move(os).str());
+       << "): " << file.status().message();
+    return Status(file.status().code(), std::move(os).str());
   }
-  is.close();
-  request.set_contents(std::move(payload));
+  auto contents = (*file)->contents();
+  request.set_contents(contents, *std::move(file));
 
   return raw_client_->InsertObjectMedia(request);
 }
@@ -224,7 +348,9 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
     return std::move(session_status).status();
   }
 
-  auto session = std::move(*session_status);
+  auto session = internal::RateLimitUpload(
+      internal::MakeOptions(raw_client_->client_options()), request,
+      std::move(*session_status));
   // How many bytes of the local file are uploaded to the GCS server.
   auto server_size = session->next_expected_byte();
   auto upload_limit = request.GetOption<UploadLimit>().value_or(
@@ -310,6 +436,13 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                         stream.status());
   }
 
+  auto const buffer_size = raw_client_->client_options().download_buffer_size();
+  if (internal::MakeOptions(raw_client_->client_options())
+          .get<storage_experimental::DirectFileIoOption>()) {
+    return DownloadFileDirectIo(std::move(stream), file_name, buffer_size,
+                                report_error);
+  }
+
   // Open the destination file, and immediate raise an exception on failure.
   std::ofstream os(file_name, std::ios::binary);
   if (!os.is_open()) {
@@ -319,7 +452,7 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
   }
 
   std::string buffer;
-  buffer.resize(raw_client_->client_options().download_buffer_size(), '\0');
+  buffer.resize(buffer_size, '\0');
   do {
     stream.read(&buffer[0], buffer.size());
     os.write(buffer.data(), stream.gcount());
@@ -419,6 +552,31 @@ StatusOr<std::string> Client::SignUrlV4(internal::V4SignUrlRequest request) {
   return std::move(os).str();
 }
 
+std::vector<StatusOr<std::string>> Client::SignUrlsV4(
+    std::vector<internal::V4SignUrlRequest> requests) {
+  std::vector<StatusOr<std::string>> results(requests.size());
+  auto sign = [&](std::size_t begin, std::size_t stride) {
+    for (auto i = begin; i < requests.size(); i += stride) {
+      results[i] = SignUrlV4(std::move(requests[i]));
+    }
+  };
+  auto const concurrency = (std::min)(
+      requests.size(),
+      internal::MakeOptions(raw_client_->client_options())
+          .get<storage_experimental::SigningConcurrencyOption>());
+  if (concurrency <= 1) {
+    sign(0, 1);
+    return results;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(concurrency);
+  for (std::size_t i = 0; i != concurrency; ++i) {
+    threads.emplace_back(sign, i, concurrency);
+  }
+  for (auto& t : threads) t.join();
+  return results;
+}
+
 StatusOr<PolicyDocumentResult> Client::SignPolicyDocument(
     internal::PolicyDocumentRequest const& request) {
   SigningAccount const& signing_account = request.signing_account();
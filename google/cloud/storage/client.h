@@ -19,19 +19,25 @@
 #include "google/cloud/storage/internal/logging_client.h"
 #include "google/cloud/storage/internal/parameter_pack_validation.h"
 #include "google/cloud/storage/internal/policy_document_request.h"
+#include "google/cloud/storage/internal/prefetching_paged_stream_reader.h"
 #include "google/cloud/storage/internal/retry_client.h"
 #include "google/cloud/storage/internal/signed_url_requests.h"
 #include "google/cloud/storage/internal/tuple_filter.h"
 #include "google/cloud/storage/list_buckets_reader.h"
 #include "google/cloud/storage/list_hmac_keys_reader.h"
+#include "google/cloud/storage/list_object_summaries_reader.h"
+#include "google/cloud/storage/list_objects_options.h"
 #include "google/cloud/storage/list_objects_and_prefixes_reader.h"
 #include "google/cloud/storage/list_objects_reader.h"
 #include "google/cloud/storage/notification_event_type.h"
 #include "google/cloud/storage/notification_payload_format.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/object_buffer_reader.h"
 #include "google/cloud/storage/object_rewriter.h"
 #include "google/cloud/storage/object_stream.h"
+#include "google/cloud/storage/random_access_object_reader.h"
 #include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/transfer_rate_limiter.h"
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/internal/throw_delegate.h"
@@ -1046,7 +1052,8 @@ class Client {
    *     Valid types for this operation include
    *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
    *     `Projection`, `Prefix`, `Delimiter`, `IncludeTrailingDelimiter`,
-   *     `StartOffset`, `EndOffset`, and `Versions`.
+   *     `StartOffset`, `EndOffset`, `Versions`, and
+   *     `ListObjectsPrefetchDepth`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
@@ -1059,15 +1066,55 @@ class Client {
                                 Options&&... options) {
     internal::ListObjectsRequest request(bucket_name);
     request.set_multiple_options(std::forward<Options>(options)...);
-    auto client = raw_client_;
-    return google::cloud::internal::MakePaginationRange<ListObjectsReader>(
-        request,
-        [client](internal::ListObjectsRequest const& r) {
-          return client->ListObjects(r);
-        },
+    return MakeListObjectsRange<ListObjectsReader>(
+        std::move(request),
         [](internal::ListObjectsResponse r) { return std::move(r.items); });
   }
 
+  /**
+   * Lists the objects in a bucket, returning only a summary of each object.
+   *
+   * Use this function instead of `ListObjects()` when the application only
+   * needs the name, size, generation and CRC32C checksum of each object. The
+   * function requests just these fields from the service, and the response is
+   * parsed directly into compact `ObjectSummary` values, without creating a
+   * full `ObjectMetadata` for each object. This significantly reduces the
+   * memory and CPU usage when listing large buckets.
+   *
+   * @param bucket_name the name of the bucket to list.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include
+   *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
+   *     `Prefix`, `Delimiter`, `IncludeTrailingDelimiter`, `StartOffset`,
+   *     `EndOffset`, `Versions`, and `ListObjectsPrefetchDepth`. Any `Fields`
+   *     option is ignored.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   *
+   * @par Example
+   * @code
+   * namespace gcs = google::cloud::storage;
+   * std::uint64_t total = 0;
+   * for (auto& summary : client.ListObjectSummaries(bucket_name)) {
+   *   if (!summary) throw std::runtime_error(summary.status().message());
+   *   total += summary->size;
+   * }
+   * @endcode
+   */
+  template <typename... Options>
+  ListObjectSummariesReader ListObjectSummaries(std::string const& bucket_name,
+                                                Options&&... options) {
+    internal::ListObjectsRequest request(bucket_name);
+    request.set_multiple_options(std::forward<Options>(options)...,
+                                 Fields(internal::ObjectSummaryFields()));
+    request.set_summaries_only(true);
+    return MakeListObjectsRange<ListObjectSummariesReader>(
+        std::move(request), [](internal::ListObjectsResponse r) {
+          return internal::ExtractObjectSummaries(std::move(r));
+        });
+  }
+
   /**
    * Lists the objects and prefixes in a bucket.
    *
@@ -1076,7 +1123,8 @@ class Client {
    *     Valid types for this operation include
    *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
    *     `Projection`, `Prefix`, `Delimiter`, `IncludeTrailingDelimiter`,
-   *     `StartOffset`, `EndOffset`, and `Versions`.
+   *     `StartOffset`, `EndOffset`, `Versions`, and
+   *     `ListObjectsPrefetchDepth`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
@@ -1089,14 +1137,8 @@ class Client {
       std::string const& bucket_name, Options&&... options) {
     internal::ListObjectsRequest request(bucket_name);
     request.set_multiple_options(std::forward<Options>(options)...);
-    auto client = raw_client_;
-    return google::cloud::internal::MakePaginationRange<
-        ListObjectsAndPrefixesReader>(
-        request,
-        [client](internal::ListObjectsRequest const& r) {
-          return client->ListObjects(r);
-        },
-        [](internal::ListObjectsResponse r) {
+    return MakeListObjectsRange<ListObjectsAndPrefixesReader>(
+        std::move(request), [](internal::ListObjectsResponse r) {
           std::vector<ObjectOrPrefix> result;
           for (auto& item : r.items) {
             result.emplace_back(std::move(item));
@@ -1126,8 +1168,9 @@ class Client {
    *     Valid types for this operation include `DisableCrc32cChecksum`,
    *     `DisableMD5Hash`, `IfGenerationMatch`, `EncryptionKey`, `Generation`,
    *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *     `IfMetagenerationNotMatch`, `ReadFromOffset`, `ReadRange`, `ReadLast`
-   *     and `UserProject`.
+   *     `IfMetagenerationNotMatch`, `ReadFromOffset`, `ReadRange`, `ReadLast`,
+   *     `UseBackgroundHashing`, `UseTransferRateLimiter`, `UserProject` and
+   *     `WithTransferPriority`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
@@ -1166,6 +1209,81 @@ class Client {
     return ReadObjectImpl(request);
   }
 
+  /**
+   * Reads the contents of an object into application-provided buffers.
+   *
+   * Returns an `ObjectBufferReader`, which copies the object contents directly
+   * from the transport into buffers owned by the application, without the
+   * intermediate copies and buffering of `std::istream`. Errors are reported
+   * via `Status` values, independently of the exception settings.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation are the same as in `ReadObject()`.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   *
+   * @see ObjectBufferReader for an example.
+   */
+  template <typename... Options>
+  ObjectBufferReader ReadObjectToBuffers(std::string const& bucket_name,
+                                         std::string const& object_name,
+                                         Options&&... options) {
+    struct HasReadRange
+        : public absl::disjunction<std::is_same<ReadRange, Options>...> {};
+    struct HasReadFromOffset
+        : public absl::disjunction<std::is_same<ReadFromOffset, Options>...> {};
+    struct HasReadLast
+        : public absl::disjunction<std::is_same<ReadLast, Options>...> {};
+
+    static_assert(!(HasReadLast::value &&
+                    (HasReadFromOffset::value || HasReadRange::value)),
+                  "Cannot set ReadLast option with either ReadFromOffset or "
+                  "ReadRange.");
+
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return ReadObjectToBuffersImpl(request);
+  }
+
+  /**
+   * Opens an object for reads at arbitrary offsets.
+   *
+   * Fetches the object metadata, to find its current generation and size, and
+   * returns a `RandomAccessObjectReader` for that generation.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `EncryptionKey`, `Generation`,
+   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, and `UserProject`. The preconditions only
+   *     apply to the metadata request.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   *
+   * @see RandomAccessObjectReader for an example.
+   */
+  template <typename... Options>
+  StatusOr<RandomAccessObjectReader> OpenRandomAccessReader(
+      std::string const& bucket_name, std::string const& object_name,
+      Options&&... options) {
+    struct HasRange
+        : public absl::disjunction<std::is_same<ReadRange, Options>...,
+                                   std::is_same<ReadFromOffset, Options>...,
+                                   std::is_same<ReadLast, Options>...> {};
+    static_assert(!HasRange::value,
+                  "Cannot set ReadRange, ReadFromOffset, or ReadLast with "
+                  "OpenRandomAccessReader(), use ReadAt() instead.");
+
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return OpenRandomAccessReaderImpl(request);
+  }
+
   /**
    * Writes contents into an object.
    *
@@ -1200,9 +1318,10 @@ class Client {
    *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
    *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
    *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
-   *   `MD5HashValue`, `PredefinedAcl`, `Projection`,
-   *   `UseResumableUploadSession`, `UserProject`, `WithObjectMetadata` and
-   *   `UploadContentLength`, `AutoFinalize`.
+   *   `MD5HashValue`, `PredefinedAcl`, `Projection`, `UseBackgroundHashing`,
+   *   `UseResumableUploadSession`, `UserProject`, `WithObjectMetadata`,
+   *   `UploadContentLength`, `AutoFinalize`, `UploadPipelineDepth`,
+   *   `UseTransferRateLimiter` and `WithTransferPriority`.
    *
    * @par Idempotency
    * This operation is only idempotent if restricted by pre-conditions, in this
@@ -2897,6 +3016,43 @@ class Client {
   }
   //@}
 
+  /**
+   * Create V4 signed URLs for many objects in the same bucket.
+   *
+   * This is equivalent to calling `CreateV4SignedUrl()` for each object, with
+   * the same @p verb, @p bucket_name, and @p options. Applications that
+   * create many signed URLs should prefer this function, it can sign the URLs
+   * concurrently, see `storage_experimental::SigningConcurrencyOption`.
+   *
+   * With service account credentials the URLs are signed locally, and the
+   * parsed private key is reused across calls. With other credentials each
+   * URL requires a `SignBlob` request to the IAM service, running these
+   * requests concurrently avoids serializing a burst of URLs on the request
+   * latency.
+   *
+   * @param verb the operation allowed through the signed URLs.
+   * @param bucket_name the name of the bucket.
+   * @param object_names the names of the objects.
+   * @param options a list of optional parameters for the signed URLs, the
+   *     valid types are the same as in `CreateV4SignedUrl()`.
+   *
+   * @return the signed URL, or an error, for each object in @p object_names,
+   *     in the same order.
+   */
+  template <typename... Options>
+  std::vector<StatusOr<std::string>> CreateV4SignedUrls(
+      std::string const& verb, std::string const& bucket_name,
+      std::vector<std::string> const& object_names, Options&&... options) {
+    std::vector<internal::V4SignUrlRequest> requests;
+    requests.reserve(object_names.size());
+    for (auto const& object_name : object_names) {
+      internal::V4SignUrlRequest request(verb, bucket_name, object_name);
+      request.set_multiple_options(options...);
+      requests.push_back(std::move(request));
+    }
+    return SignUrlsV4(std::move(requests));
+  }
+
   /**
    * Create a signed policy document.
    *
@@ -3151,9 +3307,34 @@ class Client {
   ObjectReadStream ReadObjectImpl(
       internal::ReadObjectRangeRequest const& request);
 
+  ObjectBufferReader ReadObjectToBuffersImpl(
+      internal::ReadObjectRangeRequest const& request);
+
+  StatusOr<RandomAccessObjectReader> OpenRandomAccessReaderImpl(
+      internal::ReadObjectRangeRequest const& request);
+
   ObjectWriteStream WriteObjectImpl(
       internal::ResumableUploadRequest const& request);
 
+  // The implementation of ListObjects() and ListObjectsAndPrefixes(), the
+  // pages are loaded in the background when using `ListObjectsPrefetchDepth`.
+  template <typename Range, typename Extractor>
+  Range MakeListObjectsRange(internal::ListObjectsRequest request,
+                             Extractor extractor) {
+    auto client = raw_client_;
+    auto loader = [client](internal::ListObjectsRequest const& r) {
+      return client->ListObjects(r);
+    };
+    auto const depth =
+        request.GetOption<ListObjectsPrefetchDepth>().value_or(0);
+    if (depth == 0) {
+      return google::cloud::internal::MakePaginationRange<Range>(
+          std::move(request), std::move(loader), std::move(extractor));
+    }
+    return internal::MakePrefetchingPaginationRange<Range>(
+        std::move(request), std::move(loader), std::move(extractor), depth);
+  }
+
   // The version of UploadFile() where UseResumableUploadSession is one of the
   // options. Note how this does not use InsertObjectMedia at all.
   template <typename... Options>
@@ -3219,6 +3400,8 @@ class Client {
 
   StatusOr<std::string> SignUrlV2(internal::V2SignUrlRequest const& request);
   StatusOr<std::string> SignUrlV4(internal::V4SignUrlRequest request);
+  std::vector<StatusOr<std::string>> SignUrlsV4(
+      std::vector<internal::V4SignUrlRequest> requests);
 
   StatusOr<PolicyDocumentResult> SignPolicyDocument(
       internal::PolicyDocumentRequest const& request);
@@ -112,6 +112,11 @@ std::string JsonUploadEndpoint(Options const& options) {
          "/upload/storage/" + options.get<TargetApiVersionOption>();
 }
 
+std::string JsonBatchEndpoint(Options const& options) {
+  return GetEmulator().value_or(options.get<RestEndpointOption>()) +
+         "/batch/storage/" + options.get<TargetApiVersionOption>();
+}
+
 std::string XmlEndpoint(Options const& options) {
   return GetEmulator().value_or(options.get<RestEndpointOption>());
 }
@@ -166,6 +171,28 @@ Options DefaultOptions(std::shared_ptr<oauth2::Credentials> credentials,
               GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MAXIMUM_SIMPLE_UPLOAD_SIZE)
           .set<EnableCurlSslLockingOption>(true)
           .set<EnableCurlSigpipeHandlerOption>(true)
+          .set<storage_experimental::EnableCurlShareOption>(true)
+          .set<storage_experimental::ObjectMetadataCacheSizeOption>(0)
+          .set<storage_experimental::ObjectMetadataCacheTtlOption>(
+              std::chrono::seconds(10))
+          .set<storage_experimental::IamCacheSizeOption>(0)
+          .set<storage_experimental::IamCacheTtlOption>(
+              std::chrono::seconds(10))
+          .set<storage_experimental::ReadBlockCacheSizeOption>(0)
+          .set<storage_experimental::ReadBlockCacheBlockSizeOption>(
+              1024 * 1024)
+          .set<storage_experimental::SigningConcurrencyOption>(1)
+          .set<storage_experimental::DirectFileIoOption>(false)
+          .set<storage_experimental::RandomAccessMinReadaheadOption>(256 * 1024)
+          .set<storage_experimental::RandomAccessMaxReadaheadOption>(
+              16 * 1024 * 1024)
+          .set<storage_experimental::RandomAccessMaxIdleStreamsOption>(4)
+          .set<storage_experimental::AdaptiveUploadBufferSizeOption>(false)
+          .set<storage_experimental::MinimumUploadBufferSizeOption>(256 * 1024)
+          .set<storage_experimental::MaximumUploadBufferSizeOption>(
+              32 * 1024 * 1024)
+          .set<storage_experimental::TransferPriorityOption>(
+              TransferPriority::kNormal)
           .set<MaximumCurlSocketRecvSizeOption>(0)
           .set<MaximumCurlSocketSendSizeOption>(0)
           .set<DownloadStallTimeoutOption>(std::chrono::seconds(
@@ -32,6 +32,7 @@ class ClientOptions;
 namespace internal {
 std::string JsonEndpoint(Options const&);
 std::string JsonUploadEndpoint(Options const&);
+std::string JsonBatchEndpoint(Options const&);
 std::string XmlEndpoint(Options const&);
 std::string IamEndpoint(Options const&);
 
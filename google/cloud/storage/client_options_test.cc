@@ -142,6 +142,8 @@ TEST_F(ClientOptionsTest, EndpointsDefault) {
             internal::JsonEndpoint(o));
   EXPECT_EQ("https://storage.googleapis.com/upload/storage/v1",
             internal::JsonUploadEndpoint(o));
+  EXPECT_EQ("https://storage.googleapis.com/batch/storage/v1",
+            internal::JsonBatchEndpoint(o));
   EXPECT_EQ("https://iamcredentials.googleapis.com/v1",
             internal::IamEndpoint(o));
 }
@@ -157,6 +159,8 @@ TEST_F(ClientOptionsTest, EndpointsOverride) {
             internal::JsonEndpoint(o));
   EXPECT_EQ("http://127.0.0.1.nip.io:1234/upload/storage/v1",
             internal::JsonUploadEndpoint(o));
+  EXPECT_EQ("http://127.0.0.1.nip.io:1234/batch/storage/v1",
+            internal::JsonBatchEndpoint(o));
   EXPECT_EQ("http://127.0.0.1.nip.io:1234", internal::XmlEndpoint(o));
   EXPECT_EQ("https://iamcredentials.googleapis.com/v1",
             internal::IamEndpoint(o));
@@ -171,6 +175,8 @@ TEST_F(ClientOptionsTest, EndpointsEmulator) {
   EXPECT_EQ("http://localhost:1234/storage/v1", internal::JsonEndpoint(o));
   EXPECT_EQ("http://localhost:1234/upload/storage/v1",
             internal::JsonUploadEndpoint(o));
+  EXPECT_EQ("http://localhost:1234/batch/storage/v1",
+            internal::JsonBatchEndpoint(o));
   EXPECT_EQ("http://localhost:1234", internal::XmlEndpoint(o));
   EXPECT_EQ("http://localhost:1234/iamapi", internal::IamEndpoint(o));
 }
@@ -185,6 +191,8 @@ TEST_F(ClientOptionsTest, OldEndpointsEmulator) {
   EXPECT_EQ("http://localhost:1234/storage/v1", internal::JsonEndpoint(o));
   EXPECT_EQ("http://localhost:1234/upload/storage/v1",
             internal::JsonUploadEndpoint(o));
+  EXPECT_EQ("http://localhost:1234/batch/storage/v1",
+            internal::JsonBatchEndpoint(o));
   EXPECT_EQ("http://localhost:1234", internal::XmlEndpoint(o));
   EXPECT_EQ("http://localhost:1234/iamapi", internal::IamEndpoint(o));
 }
@@ -322,6 +330,7 @@ TEST_F(ClientOptionsTest, MakeOptionsFromDefault) {
   EXPECT_LT(0, opts.get<MaximumSimpleUploadSizeOption>());
   EXPECT_TRUE(opts.has<EnableCurlSslLockingOption>());
   EXPECT_TRUE(opts.has<EnableCurlSigpipeHandlerOption>());
+  EXPECT_TRUE(opts.get<storage_experimental::EnableCurlShareOption>());
   EXPECT_EQ(0, opts.get<MaximumCurlSocketSendSizeOption>());
   EXPECT_EQ(0, opts.get<MaximumCurlSocketRecvSizeOption>());
   EXPECT_LT(0, opts.get<DownloadStallTimeoutOption>().count());
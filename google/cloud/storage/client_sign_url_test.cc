@@ -224,6 +224,60 @@ TEST_F(CreateSignedUrlTest, V4SignPut) {
   EXPECT_EQ(expected, *actual);
 }
 
+TEST_F(CreateSignedUrlTest, V4SignMany) {
+  auto const timestamp =
+      google::cloud::internal::ParseRfc3339("2019-02-01T09:00:00Z").value();
+  std::vector<std::string> const names = {"object-1", "object-2", "object-3",
+                                          "object-4", "object-5"};
+  for (std::size_t concurrency : {1, 2, 8}) {
+    SCOPED_TRACE("concurrency=" + std::to_string(concurrency));
+    Client client(
+        Options{}
+            .set<UnifiedCredentialsOption>(
+                MakeServiceAccountCredentials(kJsonKeyfileContentsForV4))
+            .set<storage_experimental::SigningConcurrencyOption>(concurrency));
+
+    auto actual = client.CreateV4SignedUrls(
+        "GET", "test-bucket", names, SignedUrlTimestamp(timestamp),
+        SignedUrlDuration(std::chrono::seconds(10)));
+    ASSERT_EQ(names.size(), actual.size());
+    for (std::size_t i = 0; i != names.size(); ++i) {
+      auto expected = client.CreateV4SignedUrl(
+          "GET", "test-bucket", names[i], SignedUrlTimestamp(timestamp),
+          SignedUrlDuration(std::chrono::seconds(10)));
+      ASSERT_STATUS_OK(expected);
+      ASSERT_STATUS_OK(actual[i]);
+      EXPECT_EQ(*expected, *actual[i]);
+    }
+  }
+}
+
+/// @test Verify that CreateV4SignedUrls() sends concurrent SignBlob requests.
+TEST_F(CreateSignedUrlTest, V4SignManyRemote) {
+  client_options_ = internal::MakeBackwardsCompatibleClientOptions(
+      internal::MakeOptions(client_options_)
+          .set<storage_experimental::SigningConcurrencyOption>(4));
+  std::string expected_signed_blob = "dGVzdC1zaWduZWQtYmxvYg==";
+  std::string expected_signed_blob_hex = "746573742d7369676e65642d626c6f62";
+
+  EXPECT_CALL(*mock_, SignBlob)
+      .Times(8)
+      .WillRepeatedly([&](internal::SignBlobRequest const&) {
+        return make_status_or(
+            internal::SignBlobResponse{"test-key-id", expected_signed_blob});
+      });
+  auto client = ClientForMock();
+  std::vector<std::string> names;
+  for (int i = 0; i != 8; ++i) names.push_back("object-" + std::to_string(i));
+  auto actual = client.CreateV4SignedUrls("GET", "test-bucket", names);
+  ASSERT_EQ(names.size(), actual.size());
+  for (std::size_t i = 0; i != names.size(); ++i) {
+    ASSERT_STATUS_OK(actual[i]);
+    EXPECT_THAT(*actual[i], HasSubstr(names[i]));
+    EXPECT_THAT(*actual[i], HasSubstr(expected_signed_blob_hex));
+  }
+}
+
 /// @test Verify that CreateV4SignedUrl() uses the SignBlob API when needed.
 TEST_F(CreateSignedUrlTest, V4SignRemote) {
   // Use `echo -n test-signed-blob | openssl base64 -e` to create the magic
@@ -0,0 +1,417 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/directory_sync.h"
+#include "google/cloud/storage/internal/hash_function_impl.h"
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/internal/strerror.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#if _WIN32
+#include <direct.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/utime.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <utime.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+auto constexpr kFileMtimeKey = "goog-reserved-file-mtime";
+
+Status ErrnoError(char const* func, std::string const& path,
+                  char const* syscall) {
+  auto const error = errno;
+  return Status(StatusCode::kUnknown,
+                std::string(func) + "(" + path + "): " + syscall +
+                    "() failed: " + google::cloud::internal::strerror(error));
+}
+
+#if _WIN32
+Status ListLocalFilesImpl(std::string const& directory,
+                          std::string const& relative,
+                          std::vector<LocalFileInfo>& files) {
+  WIN32_FIND_DATAA data;
+  auto handle = FindFirstFileA((directory + "\\*").c_str(), &data);
+  if (handle == INVALID_HANDLE_VALUE) {
+    return Status(StatusCode::kNotFound,
+                  "ListLocalFiles(" + directory + "): cannot open directory");
+  }
+  Status status;
+  do {
+    std::string const name = data.cFileName;
+    if (name == "." || name == "..") continue;
+    if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0) continue;
+    auto const path = directory + "\\" + name;
+    if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+      status = ListLocalFilesImpl(path, relative + name + "/", files);
+      if (!status.ok()) break;
+      continue;
+    }
+    struct _stat64 st;
+    if (_stat64(path.c_str(), &st) != 0) {
+      status = ErrnoError("ListLocalFiles", path, "_stat64");
+      break;
+    }
+    files.push_back(LocalFileInfo{relative + name,
+                                  static_cast<std::uintmax_t>(st.st_size),
+                                  static_cast<std::int64_t>(st.st_mtime)});
+  } while (FindNextFileA(handle, &data));
+  FindClose(handle);
+  return status;
+}
+
+int MakeDirectory(std::string const& path) { return _mkdir(path.c_str()); }
+
+int SetFileMtime(std::string const& path, std::int64_t mtime) {
+  struct __utimbuf64 times;
+  times.actime = mtime;
+  times.modtime = mtime;
+  return _utime64(path.c_str(), &times);
+}
+#else
+Status ListLocalFilesImpl(std::string const& directory,
+                          std::string const& relative,
+                          std::vector<LocalFileInfo>& files) {
+  auto* dir = opendir(directory.c_str());
+  if (dir == nullptr) return ErrnoError("ListLocalFiles", directory, "opendir");
+  Status status;
+  while (auto* entry = readdir(dir)) {
+    std::string const name = entry->d_name;
+    if (name == "." || name == "..") continue;
+    auto const path = directory + "/" + name;
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) {
+      status = ErrnoError("ListLocalFiles", path, "lstat");
+      break;
+    }
+    if (S_ISDIR(st.st_mode)) {
+      status = ListLocalFilesImpl(path, relative + name + "/", files);
+      if (!status.ok()) break;
+      continue;
+    }
+    if (!S_ISREG(st.st_mode)) continue;
+    files.push_back(LocalFileInfo{relative + name,
+                                  static_cast<std::uintmax_t>(st.st_size),
+                                  static_cast<std::int64_t>(st.st_mtime)});
+  }
+  closedir(dir);
+  return status;
+}
+
+int MakeDirectory(std::string const& path) {
+  return mkdir(path.c_str(), 0755);
+}
+
+int SetFileMtime(std::string const& path, std::int64_t mtime) {
+  struct utimbuf times;
+  times.actime = static_cast<time_t>(mtime);
+  times.modtime = static_cast<time_t>(mtime);
+  return utime(path.c_str(), &times);
+}
+#endif  // _WIN32
+
+/// Creates the parent directories of @p file_name, if needed.
+Status MakeParentDirectories(std::string const& file_name) {
+  for (auto pos = file_name.find('/', 1); pos != std::string::npos;
+       pos = file_name.find('/', pos + 1)) {
+    auto const parent = file_name.substr(0, pos);
+    if (MakeDirectory(parent) != 0 && errno != EEXIST) {
+      return ErrnoError("MakeParentDirectories", parent, "mkdir");
+    }
+  }
+  return Status{};
+}
+
+/// Returns true if @p name is safe to use as a path relative to a directory.
+bool IsSafeRelativePath(std::string const& name) {
+  if (name.empty() || name.front() == '/' || name.back() == '/') return false;
+  if (name.find('\\') != std::string::npos) return false;
+  std::size_t start = 0;
+  for (;;) {
+    auto const end = name.find('/', start);
+    auto const component = name.substr(start, end - start);
+    if (component.empty() || component == "." || component == "..") {
+      return false;
+    }
+    if (end == std::string::npos) return true;
+    start = end + 1;
+  }
+}
+
+/**
+ * Runs @p task for each index in `[0, count)`, using up to @p concurrency
+ * threads.
+ */
+void RunConcurrently(std::size_t count, std::size_t concurrency,
+                     std::function<void(std::size_t)> const& task) {
+  std::atomic<std::size_t> next{0};
+  auto worker = [&] {
+    for (auto i = next++; i < count; i = next++) task(i);
+  };
+  auto const threads_count =
+      (std::min)(count, (std::max)(concurrency, std::size_t{1}));
+  std::vector<std::thread> threads;
+  threads.reserve(threads_count);
+  for (std::size_t i = 0; i != threads_count; ++i) threads.emplace_back(worker);
+  for (auto& t : threads) t.join();
+}
+
+/// Accumulates the results from multiple threads.
+class SyncResultCollector {
+ public:
+  SyncResultCollector() : start_(std::chrono::steady_clock::now()) {}
+
+  void Skipped() {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++result_.skipped;
+  }
+  void Transferred(std::uintmax_t size) {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++result_.transferred;
+    result_.bytes_transferred += size;
+  }
+  void Failed(std::string file_name, std::string object_name, Status status) {
+    std::lock_guard<std::mutex> lk(mu_);
+    result_.failures.push_back(DirectorySyncFailure{
+        std::move(file_name), std::move(object_name), std::move(status)});
+  }
+
+  DirectorySyncResult Finish(Status list_status = {}) && {
+    result_.list_status = std::move(list_status);
+    result_.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_);
+    return std::move(result_);
+  }
+
+ private:
+  std::chrono::steady_clock::time_point const start_;
+  std::mutex mu_;
+  DirectorySyncResult result_;
+};
+
+StatusOr<std::map<std::string, ObjectMetadata>> ListObjectsByName(
+    Client& client, std::string const& bucket_name, std::string const& prefix,
+    UserProject const& user_project) {
+  std::map<std::string, ObjectMetadata> objects;
+  for (auto& o :
+       client.ListObjects(bucket_name, Prefix(prefix), user_project)) {
+    if (!o) return std::move(o).status();
+    auto name = o->name();
+    objects.emplace(std::move(name), *std::move(o));
+  }
+  return objects;
+}
+
+UserProject MakeUserProject(DirectorySyncConfig const& config) {
+  return config.user_project ? UserProject(*config.user_project)
+                             : UserProject();
+}
+
+}  // namespace
+
+StatusOr<std::vector<LocalFileInfo>> ListLocalFiles(
+    std::string const& directory) {
+  std::vector<LocalFileInfo> files;
+  auto status = ListLocalFilesImpl(directory, "", files);
+  if (!status.ok()) return status;
+  return files;
+}
+
+StatusOr<std::string> ComputeFileCrc32c(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  if (!is.is_open()) {
+    return Status(StatusCode::kNotFound,
+                  "ComputeFileCrc32c(" + file_name + "): cannot open file");
+  }
+  Crc32cHashFunction function;
+  std::vector<char> buffer(1024 * 1024);
+  while (is) {
+    is.read(buffer.data(), buffer.size());
+    function.Update(buffer.data(), static_cast<std::size_t>(is.gcount()));
+  }
+  if (is.bad()) {
+    return Status(StatusCode::kUnknown,
+                  "ComputeFileCrc32c(" + file_name + "): error reading file");
+  }
+  return std::move(function).Finish().crc32c;
+}
+
+absl::optional<std::int64_t> ObjectFileMtime(ObjectMetadata const& object) {
+  if (!object.has_metadata(kFileMtimeKey)) return absl::nullopt;
+  auto const& value = object.metadata(kFileMtimeKey);
+  char* end = nullptr;
+  errno = 0;
+  auto const mtime = std::strtoll(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || errno != 0) return absl::nullopt;
+  return static_cast<std::int64_t>(mtime);
+}
+
+StatusOr<bool> IsFileInSync(
+    LocalFileInfo const& local, ObjectMetadata const& object,
+    absl::optional<std::int64_t> object_mtime,
+    std::function<StatusOr<std::string>()> const& crc32c) {
+  if (local.size != object.size()) return false;
+  if (object_mtime && *object_mtime == local.mtime) return true;
+  if (object.crc32c().empty()) return false;
+  auto actual = crc32c();
+  if (!actual) return std::move(actual).status();
+  return *actual == object.crc32c();
+}
+
+DirectorySyncResult UploadDirectoryImpl(Client client,
+                                        std::string const& directory,
+                                        std::string const& bucket_name,
+                                        std::string const& prefix,
+                                        DirectorySyncConfig const& config) {
+  SyncResultCollector collector;
+  auto const user_project = MakeUserProject(config);
+  auto files = ListLocalFiles(directory);
+  if (!files) return std::move(collector).Finish(std::move(files).status());
+  auto objects = ListObjectsByName(client, bucket_name, prefix, user_project);
+  if (!objects) return std::move(collector).Finish(std::move(objects).status());
+
+  auto upload = [&](std::size_t i) {
+    auto const& local = (*files)[i];
+    auto const file_name = directory + "/" + local.name;
+    auto const object_name = prefix + local.name;
+    auto existing = objects->find(object_name);
+    if (existing != objects->end()) {
+      auto in_sync = IsFileInSync(
+          local, existing->second, ObjectFileMtime(existing->second),
+          [&file_name] { return ComputeFileCrc32c(file_name); });
+      if (!in_sync) {
+        return collector.Failed(file_name, object_name,
+                                std::move(in_sync).status());
+      }
+      if (*in_sync) return collector.Skipped();
+    }
+    auto metadata = WithObjectMetadata(ObjectMetadata().upsert_metadata(
+        kFileMtimeKey, std::to_string(local.mtime)));
+    auto uploaded =
+        local.size >= config.parallel_threshold
+            ? ParallelUploadFile(client, file_name, bucket_name, object_name,
+                                 CreateRandomPrefixName(object_name + ".tmp-"),
+                                 /*ignore_cleanup_failures=*/true,
+                                 MaxStreams(config.max_streams),
+                                 std::move(metadata), user_project)
+            : client.UploadFile(file_name, bucket_name, object_name,
+                                std::move(metadata), user_project);
+    if (!uploaded) {
+      return collector.Failed(file_name, object_name,
+                              std::move(uploaded).status());
+    }
+    collector.Transferred(local.size);
+  };
+  RunConcurrently(files->size(), config.concurrency, upload);
+  return std::move(collector).Finish();
+}
+
+DirectorySyncResult DownloadDirectoryImpl(Client client,
+                                          std::string const& bucket_name,
+                                          std::string const& prefix,
+                                          std::string const& directory,
+                                          DirectorySyncConfig const& config) {
+  SyncResultCollector collector;
+  auto const user_project = MakeUserProject(config);
+  auto objects = ListObjectsByName(client, bucket_name, prefix, user_project);
+  if (!objects) return std::move(collector).Finish(std::move(objects).status());
+  auto files = ListLocalFiles(directory);
+  // The destination directory may not exist yet.
+  std::map<std::string, LocalFileInfo> local_files;
+  if (files) {
+    for (auto& f : *files) {
+      auto name = f.name;
+      local_files.emplace(std::move(name), std::move(f));
+    }
+  }
+
+  std::vector<ObjectMetadata const*> pending;
+  for (auto const& kv : *objects) {
+    // Ignore the placeholders for "folders".
+    if (kv.first.back() == '/') continue;
+    pending.push_back(&kv.second);
+  }
+
+  auto download = [&](std::size_t i) {
+    auto const& object = *pending[i];
+    auto const relative = object.name().substr(prefix.size());
+    auto const file_name = directory + "/" + relative;
+    if (!IsSafeRelativePath(relative)) {
+      return collector.Failed(
+          file_name, object.name(),
+          Status(StatusCode::kInvalidArgument,
+                 "DownloadDirectory(): the object name is not a valid"
+                 " relative path"));
+    }
+    auto const mtime = ObjectFileMtime(object).value_or(
+        static_cast<std::int64_t>(
+            std::chrono::system_clock::to_time_t(object.updated())));
+    auto local = local_files.find(relative);
+    if (local != local_files.end()) {
+      auto in_sync = IsFileInSync(
+          local->second, object, mtime,
+          [&file_name] { return ComputeFileCrc32c(file_name); });
+      if (!in_sync) {
+        return collector.Failed(file_name, object.name(),
+                                std::move(in_sync).status());
+      }
+      if (*in_sync) return collector.Skipped();
+    }
+    auto status = MakeParentDirectories(file_name);
+    if (!status.ok()) {
+      return collector.Failed(file_name, object.name(), std::move(status));
+    }
+    status = object.size() >= config.parallel_threshold
+                 ? ParallelDownloadFile(client, bucket_name, object.name(),
+                                        file_name,
+                                        Generation(object.generation()),
+                                        MaxStreams(config.max_streams),
+                                        user_project)
+                 : client.DownloadToFile(bucket_name, object.name(), file_name,
+                                         Generation(object.generation()),
+                                         user_project);
+    if (!status.ok()) {
+      return collector.Failed(file_name, object.name(), std::move(status));
+    }
+    // Failing to set the time only means the next sync compares checksums.
+    (void)SetFileMtime(file_name, mtime);
+    collector.Transferred(object.size());
+  };
+  RunConcurrently(pending.size(), config.concurrency, download);
+  return std::move(collector).Finish();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,284 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_DIRECTORY_SYNC_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_DIRECTORY_SYNC_H
+
+#include "google/cloud/storage/bulk_operations.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/tuple_filter.h"
+#include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * A parameter type indicating the minimum size of the files transferred using
+ * multiple streams by `UploadDirectory()` and `DownloadDirectory()`.
+ */
+class ParallelTransferThreshold {
+ public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ParallelTransferThreshold(std::uintmax_t value) : value_(value) {}
+  std::uintmax_t value() const { return value_; }
+
+ private:
+  std::uintmax_t value_;
+};
+
+/// A file that failed to transfer in `UploadDirectory()` or
+/// `DownloadDirectory()`.
+struct DirectorySyncFailure {
+  std::string file_name;
+  std::string object_name;
+  Status status;
+};
+
+/// The results of `UploadDirectory()` and `DownloadDirectory()`.
+struct DirectorySyncResult {
+  /// The number of files transferred.
+  std::int64_t transferred = 0;
+  /// The number of files skipped because they were already in sync.
+  std::int64_t skipped = 0;
+  /// The total size of the files transferred.
+  std::uintmax_t bytes_transferred = 0;
+  /// The files that failed to transfer, in no particular order.
+  std::vector<DirectorySyncFailure> failures;
+  /// The error listing the objects or the local files, if any. Nothing is
+  /// transferred if the listing fails.
+  Status list_status;
+  /// The time to complete the sync.
+  std::chrono::microseconds elapsed{0};
+};
+
+namespace internal {
+
+/// A regular file found by `ListLocalFiles()`.
+struct LocalFileInfo {
+  /// The path relative to the directory, using `/` as the separator.
+  std::string name;
+  std::uintmax_t size;
+  /// The modification time, in seconds since the epoch.
+  std::int64_t mtime;
+};
+
+/**
+ * Lists the regular files in @p directory and its subdirectories.
+ *
+ * Symbolic links and special files are skipped.
+ */
+StatusOr<std::vector<LocalFileInfo>> ListLocalFiles(
+    std::string const& directory);
+
+/// Computes the CRC32C checksum of a file, in the `ObjectMetadata` format.
+StatusOr<std::string> ComputeFileCrc32c(std::string const& file_name);
+
+/**
+ * Returns the modification time recorded in the object metadata.
+ *
+ * The time is stored in the `goog-reserved-file-mtime` custom metadata key,
+ * which is also used by `gsutil`.
+ */
+absl::optional<std::int64_t> ObjectFileMtime(ObjectMetadata const& object);
+
+/**
+ * Returns true if @p local has the same contents as @p object.
+ *
+ * Files of different sizes are not in sync. Files with the same size and
+ * modification time as @p object_mtime are in sync. Otherwise, the function
+ * calls @p crc32c to compute the checksum of the file, and compares it against
+ * the object checksum.
+ */
+StatusOr<bool> IsFileInSync(
+    LocalFileInfo const& local, ObjectMetadata const& object,
+    absl::optional<std::int64_t> object_mtime,
+    std::function<StatusOr<std::string>()> const& crc32c);
+
+struct DirectorySyncConfig {
+  std::size_t concurrency;
+  std::uintmax_t parallel_threshold;
+  std::size_t max_streams;
+  absl::optional<std::string> user_project;
+};
+
+/// The default value for `ParallelTransferThreshold`.
+constexpr std::uintmax_t kDefaultParallelTransferThreshold =
+    64 * 1024 * 1024;
+
+/// The default number of streams for large files in directory syncs.
+constexpr std::size_t kDefaultDirectorySyncStreams = 8;
+
+template <typename... Options>
+DirectorySyncConfig MakeDirectorySyncConfig(
+    std::tuple<Options...> const& options) {
+  DirectorySyncConfig config;
+  config.concurrency = BulkConcurrencyValue(options);
+  auto threshold =
+      ExtractFirstOccurrenceOfType<ParallelTransferThreshold>(options);
+  config.parallel_threshold =
+      threshold ? threshold->value() : kDefaultParallelTransferThreshold;
+  auto max_streams = ExtractFirstOccurrenceOfType<MaxStreams>(options);
+  config.max_streams =
+      max_streams ? max_streams->value() : kDefaultDirectorySyncStreams;
+  auto user_project = ExtractFirstOccurrenceOfType<UserProject>(options);
+  if (user_project && user_project->has_value()) {
+    config.user_project = user_project->value();
+  }
+  return config;
+}
+
+DirectorySyncResult UploadDirectoryImpl(Client client,
+                                        std::string const& directory,
+                                        std::string const& bucket_name,
+                                        std::string const& prefix,
+                                        DirectorySyncConfig const& config);
+
+DirectorySyncResult DownloadDirectoryImpl(Client client,
+                                          std::string const& bucket_name,
+                                          std::string const& prefix,
+                                          std::string const& directory,
+                                          DirectorySyncConfig const& config);
+
+}  // namespace internal
+
+/**
+ * Uploads the files in a local directory tree that differ from the objects
+ * with the given prefix.
+ *
+ * Each file in @p directory (and its subdirectories) is uploaded to the object
+ * named @p prefix followed by the file path relative to @p directory, unless
+ * an object with the same contents already exists. The objects are listed
+ * once, and compared against the local files by size, then by modification
+ * time, and finally by CRC32C checksum. The checksums are only computed for
+ * files with the same size, but a different modification time, than the
+ * object, and they are computed in parallel. The uploaded objects record the
+ * file modification time in their custom metadata (using the same key as
+ * `gsutil`), so unchanged files are skipped without reading them next time.
+ *
+ * Up to `BulkConcurrency` files are compared and transferred concurrently.
+ * Files of at least `ParallelTransferThreshold` bytes (64 MiB by default) are
+ * uploaded with `ParallelUploadFile()`, using up to `MaxStreams` streams
+ * (8 by default). Objects without a matching local file are not deleted.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * auto result = gcs::UploadDirectory(client, "/data/logs", "my-bucket",
+ *                                    "logs/", gcs::BulkConcurrency(16));
+ * std::cout << result.transferred << " files uploaded, " << result.skipped
+ *           << " files unchanged\n";
+ * @endcode
+ *
+ * @param client the client on which to perform the operations.
+ * @param directory the local directory to upload.
+ * @param bucket_name the name of the destination bucket.
+ * @param prefix the prefix for the object names, typically ends with `/`.
+ * @param options a list of optional parameters. Valid types for this operation
+ *     include `BulkConcurrency`, `MaxStreams`, `ParallelTransferThreshold`,
+ *     and `UserProject`.
+ */
+template <typename... Options>
+DirectorySyncResult UploadDirectory(Client client, std::string const& directory,
+                                    std::string const& bucket_name,
+                                    std::string const& prefix,
+                                    Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto all_options = std::tie(options...);
+  static_assert(
+      std::tuple_size<decltype(StaticTupleFilter<NotAmong<
+                                   BulkConcurrency, MaxStreams,
+                                   ParallelTransferThreshold,
+                                   UserProject>::TPred>(all_options))>::value ==
+          0,
+      "This functions accepts only options of type BulkConcurrency, "
+      "MaxStreams, ParallelTransferThreshold, or UserProject.");
+  return internal::UploadDirectoryImpl(
+      std::move(client), directory, bucket_name, prefix,
+      internal::MakeDirectorySyncConfig(all_options));
+}
+
+/**
+ * Downloads the objects with the given prefix that differ from the files in a
+ * local directory tree.
+ *
+ * Each object whose name starts with @p prefix is downloaded to the file in
+ * @p directory named by the rest of the object name, creating any
+ * subdirectories as needed, unless the file already has the same contents.
+ * The files are compared as described in `UploadDirectory()`. The downloaded
+ * files get the modification time recorded in the object metadata, or the
+ * object update time if there is none, so unchanged files are skipped without
+ * reading them next time.
+ *
+ * Objects whose names end with `/`, which are often used as folder
+ * placeholders, are ignored. Objects whose names would create files outside
+ * @p directory, such as names containing `..` components, are reported as
+ * failures. Files without a matching object are not deleted.
+ *
+ * Up to `BulkConcurrency` objects are compared and transferred concurrently.
+ * Objects of at least `ParallelTransferThreshold` bytes (64 MiB by default)
+ * are downloaded with `ParallelDownloadFile()`, using up to `MaxStreams`
+ * streams (8 by default).
+ *
+ * @param client the client on which to perform the operations.
+ * @param bucket_name the name of the bucket with the objects.
+ * @param prefix the prefix of the objects to download, typically ends with
+ *     `/`.
+ * @param directory the local destination directory.
+ * @param options a list of optional parameters. Valid types for this operation
+ *     include `BulkConcurrency`, `MaxStreams`, `ParallelTransferThreshold`,
+ *     and `UserProject`.
+ */
+template <typename... Options>
+DirectorySyncResult DownloadDirectory(Client client,
+                                      std::string const& bucket_name,
+                                      std::string const& prefix,
+                                      std::string const& directory,
+                                      Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto all_options = std::tie(options...);
+  static_assert(
+      std::tuple_size<decltype(StaticTupleFilter<NotAmong<
+                                   BulkConcurrency, MaxStreams,
+                                   ParallelTransferThreshold,
+                                   UserProject>::TPred>(all_options))>::value ==
+          0,
+      "This functions accepts only options of type BulkConcurrency, "
+      "MaxStreams, ParallelTransferThreshold, or UserProject.");
+  return internal::DownloadDirectoryImpl(
+      std::move(client), bucket_name, prefix, directory,
+      internal::MakeDirectorySyncConfig(all_options));
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_DIRECTORY_SYNC_H
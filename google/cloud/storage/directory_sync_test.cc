@@ -0,0 +1,333 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/directory_sync.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/random_names.h"
+#include "google/cloud/internal/filesystem.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#if _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ListObjectsRequest;
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::internal::LocalFileInfo;
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Not;
+using ::testing::UnorderedElementsAre;
+
+/// Creates a temporary directory tree, and removes it in the destructor.
+class TempDirectory {
+ public:
+  TempDirectory() {
+    auto generator =
+        google::cloud::internal::DefaultPRNG(std::random_device{}());
+    path_ = google::cloud::internal::PathAppend(
+        ::testing::TempDir(), testing::MakeRandomFileName(generator));
+    MakeDirectory(path_);
+  }
+  ~TempDirectory() {
+    for (auto i = files_.rbegin(); i != files_.rend(); ++i) {
+      std::remove(i->c_str());
+    }
+    for (auto i = directories_.rbegin(); i != directories_.rend(); ++i) {
+      Rmdir(*i);
+    }
+    Rmdir(path_);
+  }
+
+  std::string const& path() const { return path_; }
+
+  void AddDirectory(std::string const& name) {
+    MakeDirectory(path_ + "/" + name);
+    directories_.push_back(path_ + "/" + name);
+  }
+
+  std::string AddFile(std::string const& name, std::string const& contents) {
+    auto file_name = path_ + "/" + name;
+    std::ofstream(file_name, std::ios::binary) << contents;
+    files_.push_back(file_name);
+    return file_name;
+  }
+
+  void Track(std::string const& name) { files_.push_back(path_ + "/" + name); }
+  void TrackDirectory(std::string const& name) {
+    directories_.push_back(path_ + "/" + name);
+  }
+
+ private:
+#if _WIN32
+  static void MakeDirectory(std::string const& p) { _mkdir(p.c_str()); }
+  static void Rmdir(std::string const& p) { _rmdir(p.c_str()); }
+#else
+  static void MakeDirectory(std::string const& p) { mkdir(p.c_str(), 0755); }
+  static void Rmdir(std::string const& p) { rmdir(p.c_str()); }
+#endif  // _WIN32
+
+  std::string path_;
+  std::vector<std::string> files_;
+  std::vector<std::string> directories_;
+};
+
+ObjectMetadata CreateObject(
+    std::string const& name, std::string const& contents,
+    nlohmann::json metadata = nlohmann::json::object()) {
+  return internal::ObjectMetadataParser::FromJson(
+             nlohmann::json{
+                 {"bucket", "test-bucket"},
+                 {"name", name},
+                 {"generation", "1000"},
+                 {"size", std::to_string(contents.size())},
+                 {"crc32c", ComputeCrc32cChecksum(contents)},
+                 {"updated", "2021-01-01T00:00:00Z"},
+                 {"metadata", std::move(metadata)},
+             })
+      .value();
+}
+
+void ListObjects(MockClient& mock, std::vector<ObjectMetadata> objects) {
+  EXPECT_CALL(mock, ListObjects)
+      .WillRepeatedly([objects](ListObjectsRequest const&) {
+        ListObjectsResponse response;
+        response.items = objects;
+        return make_status_or(response);
+      });
+}
+
+std::int64_t FileMtime(std::string const& name) {
+  auto files = internal::ListLocalFiles(name.substr(0, name.rfind('/')));
+  auto const base = name.substr(name.rfind('/') + 1);
+  for (auto const& f : files.value()) {
+    if (f.name == base) return f.mtime;
+  }
+  return -1;
+}
+
+TEST(DirectorySyncTest, ListLocalFiles) {
+  TempDirectory dir;
+  dir.AddDirectory("a");
+  dir.AddDirectory("a/b");
+  dir.AddFile("top.txt", "0123");
+  dir.AddFile("a/b/nested.txt", "01234567");
+
+  auto files = internal::ListLocalFiles(dir.path());
+  ASSERT_STATUS_OK(files);
+  EXPECT_THAT(*files, UnorderedElementsAre(
+                          Field(&LocalFileInfo::name, "top.txt"),
+                          Field(&LocalFileInfo::name, "a/b/nested.txt")));
+  for (auto const& f : *files) {
+    EXPECT_EQ(f.name == "top.txt" ? 4 : 8, f.size);
+  }
+
+  EXPECT_THAT(internal::ListLocalFiles(dir.path() + "/not-there"),
+              StatusIs(Not(StatusCode::kOk)));
+}
+
+TEST(DirectorySyncTest, ComputeFileCrc32c) {
+  TempDirectory dir;
+  std::string const contents(3 * 1024 * 1024 + 7, 'x');
+  auto const file_name = dir.AddFile("large.bin", contents);
+  auto crc32c = internal::ComputeFileCrc32c(file_name);
+  ASSERT_STATUS_OK(crc32c);
+  EXPECT_EQ(ComputeCrc32cChecksum(contents), *crc32c);
+
+  EXPECT_THAT(internal::ComputeFileCrc32c(dir.path() + "/not-there"),
+              StatusIs(StatusCode::kNotFound));
+}
+
+TEST(DirectorySyncTest, ObjectFileMtime) {
+  EXPECT_FALSE(internal::ObjectFileMtime(CreateObject("o", "")).has_value());
+  EXPECT_EQ(1234, internal::ObjectFileMtime(
+                      CreateObject("o", "",
+                                   {{"goog-reserved-file-mtime", "1234"}}))
+                      .value_or(0));
+  EXPECT_FALSE(internal::ObjectFileMtime(
+                   CreateObject("o", "", {{"goog-reserved-file-mtime", "x"}}))
+                   .has_value());
+}
+
+TEST(DirectorySyncTest, IsFileInSync) {
+  auto const object = CreateObject("o", "contents");
+  auto const size = std::string("contents").size();
+  int calls = 0;
+  auto crc32c = [&calls](std::string const& contents) {
+    return [&calls, contents] {
+      ++calls;
+      return make_status_or(ComputeCrc32cChecksum(contents));
+    };
+  };
+
+  // Different sizes are never in sync, and do not compute the checksum.
+  auto r = internal::IsFileInSync(LocalFileInfo{"o", size + 1, 10}, object,
+                                  10, crc32c("contents-"));
+  ASSERT_STATUS_OK(r);
+  EXPECT_FALSE(*r);
+  // The same size and mtime is enough.
+  r = internal::IsFileInSync(LocalFileInfo{"o", size, 10}, object, 10,
+                             crc32c("contents"));
+  ASSERT_STATUS_OK(r);
+  EXPECT_TRUE(*r);
+  EXPECT_EQ(0, calls);
+
+  // Otherwise the checksums are compared.
+  r = internal::IsFileInSync(LocalFileInfo{"o", size, 10}, object, 20,
+                             crc32c("contents"));
+  ASSERT_STATUS_OK(r);
+  EXPECT_TRUE(*r);
+  r = internal::IsFileInSync(LocalFileInfo{"o", size, 10}, object,
+                             absl::nullopt, crc32c("CONTENTS"));
+  ASSERT_STATUS_OK(r);
+  EXPECT_FALSE(*r);
+  EXPECT_EQ(2, calls);
+
+  r = internal::IsFileInSync(
+      LocalFileInfo{"o", size, 10}, object, absl::nullopt,
+      [] { return StatusOr<std::string>(Status(StatusCode::kUnknown, "")); });
+  EXPECT_THAT(r, StatusIs(StatusCode::kUnknown));
+}
+
+TEST(DirectorySyncTest, UploadDirectory) {
+  TempDirectory dir;
+  dir.AddDirectory("d");
+  auto const same_mtime = dir.AddFile("same-mtime.txt", "0123");
+  dir.AddFile("same-crc.txt", "abcd");
+  dir.AddFile("d/changed.txt", "new contents");
+  dir.AddFile("d/new.txt", "new file");
+
+  auto mock = std::make_shared<MockClient>();
+  ListObjects(*mock,
+              {CreateObject("p/same-mtime.txt", "XXXX",
+                            {{"goog-reserved-file-mtime",
+                              std::to_string(FileMtime(same_mtime))}}),
+               CreateObject("p/same-crc.txt", "abcd"),
+               CreateObject("p/d/changed.txt", "old contents")});
+  std::mutex mu;
+  std::vector<std::string> uploaded;
+  EXPECT_CALL(*mock, InsertObjectMedia)
+      .Times(2)
+      .WillRepeatedly([&](internal::InsertObjectMediaRequest const& r) {
+        EXPECT_EQ("test-bucket", r.bucket_name());
+        auto const metadata = r.GetOption<WithObjectMetadata>().value();
+        EXPECT_TRUE(metadata.has_metadata("goog-reserved-file-mtime"));
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          uploaded.push_back(r.object_name());
+        }
+        return make_status_or(
+            CreateObject(r.object_name(), std::string(r.contents())));
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  auto result = UploadDirectory(client, dir.path(), "test-bucket", "p/",
+                                BulkConcurrency(2));
+  ASSERT_STATUS_OK(result.list_status);
+  EXPECT_THAT(result.failures, ElementsAre());
+  EXPECT_EQ(2, result.transferred);
+  EXPECT_EQ(2, result.skipped);
+  EXPECT_EQ(std::string("new contents").size() + std::string("new file").size(),
+            result.bytes_transferred);
+  EXPECT_THAT(uploaded, UnorderedElementsAre("p/d/changed.txt", "p/d/new.txt"));
+}
+
+TEST(DirectorySyncTest, UploadDirectoryListError) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects).Times(0);
+  auto client = testing::ClientFromMock(mock);
+  auto result = UploadDirectory(client, "/not/a/valid/directory/for/test",
+                                "test-bucket", "p/");
+  EXPECT_FALSE(result.list_status.ok());
+  EXPECT_EQ(0, result.transferred);
+}
+
+TEST(DirectorySyncTest, DownloadDirectory) {
+  TempDirectory dir;
+  auto const existing = dir.AddFile("same.txt", "0123");
+  dir.TrackDirectory("d");
+  dir.Track("d/new.txt");
+
+  auto mock = std::make_shared<MockClient>();
+  ListObjects(*mock, {CreateObject("p/same.txt", "0123"),
+                      CreateObject("p/d/", ""),
+                      CreateObject("p/d/new.txt", "new file",
+                                   {{"goog-reserved-file-mtime", "1000000"}}),
+                      CreateObject("p/../escape.txt", "bad")});
+  EXPECT_CALL(*mock, ReadObject)
+      .WillOnce([](internal::ReadObjectRangeRequest const& r) {
+        EXPECT_EQ("p/d/new.txt", r.object_name());
+        EXPECT_EQ(1000, r.GetOption<Generation>().value_or(0));
+        auto source = absl::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*source, IsOpen).WillRepeatedly([] { return true; });
+        EXPECT_CALL(*source, Read)
+            .WillOnce([](char* buf, std::size_t n) {
+              std::string const contents = "new file";
+              EXPECT_LE(contents.size(), n);
+              std::copy(contents.begin(), contents.end(), buf);
+              internal::ReadSourceResult result{contents.size(),
+                                                internal::HttpResponse{
+                                                    200, {}, {}}};
+              result.response.headers.emplace(
+                  "x-goog-hash",
+                  "crc32c=" + ComputeCrc32cChecksum(contents));
+              return result;
+            })
+            .WillOnce([](char*, std::size_t) {
+              return internal::ReadSourceResult{
+                  0, internal::HttpResponse{200, {}, {}}};
+            });
+        return make_status_or(
+            std::unique_ptr<internal::ObjectReadSource>(std::move(source)));
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  auto result = DownloadDirectory(client, "test-bucket", "p/", dir.path());
+  ASSERT_STATUS_OK(result.list_status);
+  EXPECT_EQ(1, result.transferred);
+  EXPECT_EQ(1, result.skipped);
+  ASSERT_EQ(1, result.failures.size());
+  EXPECT_EQ("p/../escape.txt", result.failures[0].object_name);
+  EXPECT_THAT(result.failures[0].status,
+              StatusIs(StatusCode::kInvalidArgument));
+
+  std::ifstream is(dir.path() + "/d/new.txt", std::ios::binary);
+  std::string contents{std::istreambuf_iterator<char>{is}, {}};
+  EXPECT_EQ("new file", contents);
+  EXPECT_EQ(1000000, FileMtime(dir.path() + "/d/new.txt"));
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
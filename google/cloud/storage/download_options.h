@@ -70,6 +70,28 @@ struct ReadLast : public internal::ComplexOption<ReadLast, std::int64_t> {
   static char const* name() { return "read-last"; }
 };
 
+/**
+ * Download gzip-encoded objects compressed, and decompress them in the client.
+ *
+ * By default GCS decompresses objects stored with `Content-Encoding: gzip`
+ * before sending them ("decompressive transcoding"). With this option the
+ * library requests the stored (compressed) bytes, and inflates them as the
+ * application reads the stream. This reduces the network traffic for highly
+ * compressible data. The checksums are validated against the compressed bytes.
+ *
+ * Use `DecompressGzip(true)` to enable this behavior. Objects that are not
+ * gzip-encoded are returned unchanged. This option cannot
+ * be combined with `ReadFromOffset`, `ReadRange`, or `ReadLast`, the offsets
+ * would refer to the compressed data.
+ */
+struct DecompressGzip : public internal::ComplexOption<DecompressGzip, bool> {
+  using ComplexOption<DecompressGzip, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  DecompressGzip() = default;
+  static char const* name() { return "decompress-gzip"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
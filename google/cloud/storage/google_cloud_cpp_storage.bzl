@@ -18,10 +18,13 @@
 
 google_cloud_cpp_storage_hdrs = [
     "auto_finalize.h",
+    "batch_request.h",
     "bucket_access_control.h",
     "bucket_metadata.h",
+    "bulk_operations.h",
     "client.h",
     "client_options.h",
+    "directory_sync.h",
     "download_options.h",
     "hash_mismatch_error.h",
     "hashing_options.h",
@@ -31,30 +34,37 @@ google_cloud_cpp_storage_hdrs = [
     "internal/access_control_common.h",
     "internal/access_control_common_parser.h",
     "internal/access_token_credentials.h",
+    "internal/batch_requests.h",
     "internal/binary_data_as_debug_string.h",
     "internal/bucket_access_control_parser.h",
     "internal/bucket_acl_requests.h",
     "internal/bucket_metadata_parser.h",
     "internal/bucket_requests.h",
+    "internal/caching_object_read_source.h",
     "internal/common_metadata.h",
     "internal/common_metadata_parser.h",
     "internal/complex_option.h",
     "internal/compute_engine_util.h",
     "internal/const_buffer.h",
+    "internal/crc32c_combine.h",
     "internal/curl_client.h",
     "internal/curl_download_request.h",
     "internal/curl_handle.h",
     "internal/curl_handle_factory.h",
+    "internal/curl_multi_loop.h",
     "internal/curl_request.h",
     "internal/curl_request_builder.h",
+    "internal/curl_request_stats.h",
     "internal/curl_resumable_upload_session.h",
     "internal/curl_wrappers.h",
     "internal/default_object_acl_requests.h",
     "internal/empty_response.h",
     "internal/error_credentials.h",
+    "internal/file_region_sink.h",
     "internal/generate_message_boundary.h",
     "internal/generic_object_request.h",
     "internal/generic_request.h",
+    "internal/gzip_object_read_source.h",
     "internal/hash_function.h",
     "internal/hash_function_impl.h",
     "internal/hash_validator.h",
@@ -63,17 +73,20 @@ google_cloud_cpp_storage_hdrs = [
     "internal/hmac_key_metadata_parser.h",
     "internal/hmac_key_requests.h",
     "internal/http_response.h",
+    "internal/iam_cache_client.h",
     "internal/impersonate_service_account_credentials.h",
     "internal/lifecycle_rule_parser.h",
     "internal/logging_client.h",
     "internal/logging_resumable_upload_session.h",
     "internal/make_jwt_assertion.h",
+    "internal/mapped_file.h",
     "internal/metadata_parser.h",
     "internal/minimal_iam_credentials_rest.h",
     "internal/notification_metadata_parser.h",
     "internal/notification_requests.h",
     "internal/object_access_control_parser.h",
     "internal/object_acl_requests.h",
+    "internal/object_metadata_cache_client.h",
     "internal/object_metadata_parser.h",
     "internal/object_read_source.h",
     "internal/object_read_streambuf.h",
@@ -82,9 +95,16 @@ google_cloud_cpp_storage_hdrs = [
     "internal/openssl_util.h",
     "internal/parameter_pack_validation.h",
     "internal/patch_builder.h",
+    "internal/pipelined_object_reader_impl.h",
+    "internal/pipelined_resumable_upload_session.h",
     "internal/policy_document_request.h",
+    "internal/prefetching_paged_stream_reader.h",
+    "internal/positional_file_writer.h",
+    "internal/random_access_reader_impl.h",
+    "internal/rate_limited_transfer.h",
     "internal/raw_client.h",
     "internal/raw_client_wrapper_utils.h",
+    "internal/read_block_cache.h",
     "internal/resumable_upload_session.h",
     "internal/retry_client.h",
     "internal/retry_object_read_source.h",
@@ -97,10 +117,14 @@ google_cloud_cpp_storage_hdrs = [
     "internal/signed_url_requests.h",
     "internal/tuple_filter.h",
     "internal/unified_rest_credentials.h",
+    "internal/upload_chunk_sizer.h",
+    "io_buffer_pool.h",
     "lifecycle_rule.h",
     "list_buckets_reader.h",
     "list_hmac_keys_reader.h",
+    "list_object_summaries_reader.h",
     "list_objects_and_prefixes_reader.h",
+    "list_objects_options.h",
     "list_objects_reader.h",
     "notification_event_type.h",
     "notification_metadata.h",
@@ -115,6 +139,7 @@ google_cloud_cpp_storage_hdrs = [
     "oauth2/refreshing_credentials_wrapper.h",
     "oauth2/service_account_credentials.h",
     "object_access_control.h",
+    "object_buffer_reader.h",
     "object_metadata.h",
     "object_read_stream.h",
     "object_rewriter.h",
@@ -122,12 +147,17 @@ google_cloud_cpp_storage_hdrs = [
     "object_write_stream.h",
     "options.h",
     "override_default_project.h",
+    "parallel_download.h",
+    "parallel_list_objects.h",
     "parallel_upload.h",
+    "pipelined_object_reader.h",
     "policy_document.h",
+    "random_access_object_reader.h",
     "retry_policy.h",
     "service_account.h",
     "signed_url_options.h",
     "storage_class.h",
+    "transfer_rate_limiter.h",
     "upload_options.h",
     "version.h",
     "version_info.h",
@@ -137,34 +167,44 @@ google_cloud_cpp_storage_hdrs = [
 
 google_cloud_cpp_storage_srcs = [
     "auto_finalize.cc",
+    "batch_request.cc",
     "bucket_access_control.cc",
     "bucket_metadata.cc",
+    "bulk_operations.cc",
     "client.cc",
     "client_options.cc",
+    "directory_sync.cc",
     "hashing_options.cc",
     "hmac_key_metadata.cc",
     "iam_policy.cc",
     "idempotency_policy.cc",
     "internal/access_control_common_parser.cc",
     "internal/access_token_credentials.cc",
+    "internal/batch_requests.cc",
     "internal/binary_data_as_debug_string.cc",
     "internal/bucket_access_control_parser.cc",
     "internal/bucket_acl_requests.cc",
     "internal/bucket_metadata_parser.cc",
     "internal/bucket_requests.cc",
+    "internal/caching_object_read_source.cc",
     "internal/compute_engine_util.cc",
     "internal/const_buffer.cc",
+    "internal/crc32c_combine.cc",
     "internal/curl_client.cc",
     "internal/curl_download_request.cc",
     "internal/curl_handle.cc",
     "internal/curl_handle_factory.cc",
+    "internal/curl_multi_loop.cc",
     "internal/curl_request.cc",
     "internal/curl_request_builder.cc",
+    "internal/curl_request_stats.cc",
     "internal/curl_resumable_upload_session.cc",
     "internal/curl_wrappers.cc",
     "internal/default_object_acl_requests.cc",
     "internal/empty_response.cc",
     "internal/error_credentials.cc",
+    "internal/file_region_sink.cc",
+    "internal/gzip_object_read_source.cc",
     "internal/hash_function.cc",
     "internal/hash_function_impl.cc",
     "internal/hash_validator.cc",
@@ -173,24 +213,33 @@ google_cloud_cpp_storage_srcs = [
     "internal/hmac_key_metadata_parser.cc",
     "internal/hmac_key_requests.cc",
     "internal/http_response.cc",
+    "internal/iam_cache_client.cc",
     "internal/impersonate_service_account_credentials.cc",
     "internal/lifecycle_rule_parser.cc",
     "internal/logging_client.cc",
     "internal/logging_resumable_upload_session.cc",
     "internal/make_jwt_assertion.cc",
+    "internal/mapped_file.cc",
     "internal/metadata_parser.cc",
     "internal/minimal_iam_credentials_rest.cc",
     "internal/notification_metadata_parser.cc",
     "internal/notification_requests.cc",
     "internal/object_access_control_parser.cc",
     "internal/object_acl_requests.cc",
+    "internal/object_metadata_cache_client.cc",
     "internal/object_metadata_parser.cc",
     "internal/object_read_streambuf.cc",
     "internal/object_requests.cc",
     "internal/object_write_streambuf.cc",
     "internal/openssl_util.cc",
     "internal/patch_builder.cc",
+    "internal/pipelined_object_reader_impl.cc",
+    "internal/pipelined_resumable_upload_session.cc",
     "internal/policy_document_request.cc",
+    "internal/positional_file_writer.cc",
+    "internal/random_access_reader_impl.cc",
+    "internal/rate_limited_transfer.cc",
+    "internal/read_block_cache.cc",
     "internal/resumable_upload_session.cc",
     "internal/retry_client.cc",
     "internal/retry_object_read_source.cc",
@@ -202,9 +251,12 @@ google_cloud_cpp_storage_srcs = [
     "internal/sign_blob_requests.cc",
     "internal/signed_url_requests.cc",
     "internal/unified_rest_credentials.cc",
+    "internal/upload_chunk_sizer.cc",
+    "io_buffer_pool.cc",
     "lifecycle_rule.cc",
     "list_buckets_reader.cc",
     "list_hmac_keys_reader.cc",
+    "list_object_summaries_reader.cc",
     "list_objects_reader.cc",
     "notification_metadata.cc",
     "oauth2/anonymous_credentials.cc",
@@ -216,13 +268,18 @@ google_cloud_cpp_storage_srcs = [
     "oauth2/refreshing_credentials_wrapper.cc",
     "oauth2/service_account_credentials.cc",
     "object_access_control.cc",
+    "object_buffer_reader.cc",
     "object_metadata.cc",
     "object_read_stream.cc",
     "object_rewriter.cc",
     "object_write_stream.cc",
+    "parallel_download.cc",
+    "parallel_list_objects.cc",
     "parallel_upload.cc",
+    "pipelined_object_reader.cc",
     "policy_document.cc",
     "service_account.cc",
+    "transfer_rate_limiter.cc",
     "version.cc",
     "well_known_headers.cc",
     "well_known_parameters.cc",
@@ -17,25 +17,31 @@
 """Automatically generated source lists for google_cloud_cpp_storage_grpc - DO NOT EDIT."""
 
 google_cloud_cpp_storage_grpc_hdrs = [
+    "async_client.h",
     "grpc_plugin.h",
     "internal/grpc_client.h",
     "internal/grpc_object_read_source.h",
     "internal/grpc_resumable_upload_session.h",
     "internal/grpc_resumable_upload_session_url.h",
     "internal/hybrid_client.h",
+    "internal/hybrid_router.h",
     "internal/storage_auth.h",
+    "internal/storage_metrics.h",
     "internal/storage_round_robin.h",
     "internal/storage_stub.h",
 ]
 
 google_cloud_cpp_storage_grpc_srcs = [
+    "async_client.cc",
     "grpc_plugin.cc",
     "internal/grpc_client.cc",
     "internal/grpc_object_read_source.cc",
     "internal/grpc_resumable_upload_session.cc",
     "internal/grpc_resumable_upload_session_url.cc",
     "internal/hybrid_client.cc",
+    "internal/hybrid_router.cc",
     "internal/storage_auth.cc",
+    "internal/storage_metrics.cc",
     "internal/storage_round_robin.cc",
     "internal/storage_stub.cc",
 ]
@@ -18,6 +18,7 @@
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
+#include <cstddef>
 
 namespace google {
 namespace cloud {
@@ -56,6 +57,55 @@ struct GrpcPluginOption {
   using Type = std::string;
 };
 
+/**
+ * Create the gRPC channels on demand.
+ *
+ * By default the client creates all the `GrpcNumChannelsOption` channels when
+ * it is created. With this option the client creates the first channel on the
+ * first RPC, and adds channels, up to `GrpcNumChannelsOption`, as the number of
+ * concurrent RPCs grows. This reduces the startup time for applications that
+ * make only a few RPCs, such as command-line tools or serverless functions.
+ */
+struct GrpcLazyChannelsOption {
+  using Type = bool;
+};
+
+/**
+ * Warm up the channels in the background.
+ *
+ * Only used with `GrpcLazyChannelsOption`. The client creates all the channels
+ * in its background threads, and starts connecting them, as soon as the client
+ * is created. The first RPCs do not wait for this warm up to complete.
+ */
+struct GrpcChannelWarmUpOption {
+  using Type = bool;
+};
+
+/**
+ * Use gRPC only for uploads and downloads of at least this many bytes.
+ *
+ * By default `DefaultGrpcClient()` uses the JSON API for metadata requests,
+ * and gRPC for all uploads and downloads. With this option smaller uploads
+ * and downloads also use the JSON API, where a round trip is cheaper. The
+ * size of downloads without `ReadRange` or `ReadLast`, and of resumable
+ * uploads without `UploadContentLength`, is unknown, and these always use
+ * gRPC. The default is 0, all uploads and downloads use gRPC.
+ */
+struct GrpcMediaThresholdOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Adjust the `GrpcMediaThresholdOption` from the observed throughput.
+ *
+ * The client measures the throughput of both transports for requests close
+ * to the threshold, and raises or lowers the threshold to use the faster
+ * transport. Only used if `GrpcMediaThresholdOption` is not zero.
+ */
+struct GrpcMediaAdaptiveThresholdOption {
+  using Type = bool;
+};
+
 /**
  * Create a `google::cloud::storage::Client` object configured to use gRPC.
  *
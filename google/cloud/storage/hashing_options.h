@@ -125,6 +125,25 @@ struct DisableCrc32cChecksum
   static char const* name() { return "disable-crc32c-checksum"; }
 };
 
+/**
+ * Compute MD5 hashes in a background thread.
+ *
+ * MD5 hashes are expensive to compute, with this option the client library
+ * computes them in a separate thread, concurrently with the CRC32C checksum and
+ * the data transfer. Each upload or download stream using this option copies
+ * its data once more, and uses an additional thread.
+ *
+ * This option has no effect unless MD5 hashes are enabled.
+ */
+struct UseBackgroundHashing
+    : public internal::ComplexOption<UseBackgroundHashing, bool> {
+  using ComplexOption<UseBackgroundHashing, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  UseBackgroundHashing() : UseBackgroundHashing(true) {}
+  static char const* name() { return "use-background-hashing"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
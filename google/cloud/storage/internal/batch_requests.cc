@@ -0,0 +1,312 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include <iostream>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// URL-escape @p s, with the same rules as `curl_easy_escape()`.
+std::string UrlEscape(std::string const& s) {
+  static char const kHex[] = "0123456789ABCDEF";
+  std::string result;
+  result.reserve(s.size());
+  for (auto c : s) {
+    auto const u = static_cast<unsigned char>(c);
+    if (absl::ascii_isalnum(u) || c == '-' || c == '.' || c == '_' ||
+        c == '~') {
+      result.push_back(c);
+      continue;
+    }
+    result.push_back('%');
+    result.push_back(kHex[u >> 4]);
+    result.push_back(kHex[u & 0xF]);
+  }
+  return result;
+}
+
+/**
+ * Collects the query parameters and headers for one operation in a batch.
+ *
+ * This has the same `AddOption()` overloads as `CurlRequestBuilder`, so it can
+ * be used with `GenericRequest::AddOptionsToHttpRequest()`.
+ */
+class BatchPartBuilder {
+ public:
+  template <typename P>
+  void AddOption(WellKnownParameter<P, std::string> const& p) {
+    if (p.has_value()) AddQueryParameter(p.parameter_name(), p.value());
+  }
+
+  template <typename P>
+  void AddOption(WellKnownParameter<P, std::int64_t> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), std::to_string(p.value()));
+    }
+  }
+
+  template <typename P>
+  void AddOption(WellKnownParameter<P, bool> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), p.value() ? "true" : "false");
+    }
+  }
+
+  template <typename P>
+  void AddOption(WellKnownHeader<P, std::string> const& p) {
+    if (p.has_value()) AddHeader(p.header_name(), p.value());
+  }
+
+  void AddOption(CustomHeader const& p) {
+    if (p.has_value()) AddHeader(p.custom_header_name(), p.value());
+  }
+
+  template <typename Option, typename T>
+  void AddOption(ComplexOption<Option, T> const&) {}
+
+  std::string const& query() const { return query_; }
+  std::string const& headers() const { return headers_; }
+
+ private:
+  void AddQueryParameter(std::string const& key, std::string const& value) {
+    query_ += query_.empty() ? "?" : "&";
+    query_ += UrlEscape(key) + "=" + UrlEscape(value);
+  }
+
+  void AddHeader(std::string const& name, std::string const& value) {
+    headers_ += name + ": " + value + "\r\n";
+  }
+
+  std::string query_;
+  std::string headers_;
+};
+
+template <typename Request>
+std::string EncodeOperation(char const* method, std::string const& path_prefix,
+                            Request const& request, std::string const& body) {
+  BatchPartBuilder builder;
+  request.AddOptionsToHttpRequest(builder);
+  std::string part = method;
+  part += " " + path_prefix + "/b/" + request.bucket_name() + "/o/" +
+          UrlEscape(request.object_name()) + builder.query() + " HTTP/1.1\r\n";
+  part += builder.headers();
+  if (!body.empty()) {
+    part += "Content-Type: application/json; charset=UTF-8\r\n";
+    part += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  }
+  part += "\r\n";
+  part += body;
+  return part;
+}
+
+struct OperationEncoder {
+  std::string operator()(DeleteObjectRequest const& r) const {
+    return EncodeOperation("DELETE", path_prefix, r, std::string{});
+  }
+  std::string operator()(PatchObjectRequest const& r) const {
+    return EncodeOperation("PATCH", path_prefix, r, r.payload());
+  }
+
+  std::string const& path_prefix;
+};
+
+struct OperationPrinter {
+  void operator()(DeleteObjectRequest const& r) const { os << r; }
+  void operator()(PatchObjectRequest const& r) const { os << r; }
+
+  std::ostream& os;
+};
+
+/// Split a MIME entity (or HTTP message) into its headers and body.
+std::pair<absl::string_view, absl::string_view> SplitHeaders(
+    absl::string_view text) {
+  for (absl::string_view separator : {"\r\n\r\n", "\n\n"}) {
+    auto pos = text.find(separator);
+    if (pos == absl::string_view::npos) continue;
+    return {text.substr(0, pos), text.substr(pos + separator.size())};
+  }
+  return {text, absl::string_view{}};
+}
+
+std::multimap<std::string, std::string> ParseHeaders(
+    std::vector<absl::string_view> const& lines) {
+  std::multimap<std::string, std::string> headers;
+  for (auto line : lines) {
+    auto pos = line.find(':');
+    if (pos == absl::string_view::npos) continue;
+    auto name = absl::AsciiStrToLower(line.substr(0, pos));
+    auto value = absl::StripAsciiWhitespace(line.substr(pos + 1));
+    headers.emplace(std::move(name), std::string(value));
+  }
+  return headers;
+}
+
+std::vector<absl::string_view> SplitLines(absl::string_view text) {
+  std::vector<absl::string_view> lines = absl::StrSplit(text, '\n');
+  for (auto& line : lines) line = absl::StripTrailingAsciiWhitespace(line);
+  return lines;
+}
+
+/// Parse a `Content-ID: <response-N>` header into a zero-based index.
+absl::optional<std::size_t> ParseContentId(
+    std::multimap<std::string, std::string> const& headers) {
+  auto h = headers.find("content-id");
+  if (h == headers.end()) return absl::nullopt;
+  absl::string_view id = h->second;
+  absl::ConsumePrefix(&id, "<");
+  absl::ConsumeSuffix(&id, ">");
+  absl::ConsumePrefix(&id, "response-");
+  std::size_t n;
+  if (!absl::SimpleAtoi(id, &n) || n == 0) return absl::nullopt;
+  return n - 1;
+}
+
+/// Parse the embedded HTTP response in one part of the batch response.
+StatusOr<HttpResponse> ParsePart(absl::string_view part) {
+  auto lines = SplitLines(SplitHeaders(part).first);
+  auto body = SplitHeaders(part).second;
+  if (lines.empty()) {
+    return Status(StatusCode::kInternal, "empty response in batch");
+  }
+  // The status line is `HTTP/1.1 204 No Content`.
+  std::vector<absl::string_view> status_line =
+      absl::StrSplit(lines.front(), absl::MaxSplits(' ', 2));
+  long code;  // NOLINT(google-runtime-int)
+  if (status_line.size() < 2 || !absl::SimpleAtoi(status_line[1], &code)) {
+    return Status(StatusCode::kInternal,
+                  "invalid status line in batch response: " +
+                      std::string(lines.front()));
+  }
+  lines.erase(lines.begin());
+  absl::ConsumeSuffix(&body, "\r\n");
+  return HttpResponse{code, std::string(body), ParseHeaders(lines)};
+}
+
+}  // namespace
+
+std::string ExecuteBatchRequest::Payload(std::string const& boundary,
+                                         std::string const& path_prefix) const {
+  std::string payload;
+  OperationEncoder encoder{path_prefix};
+  for (std::size_t i = 0; i != operations_.size(); ++i) {
+    payload += "--" + boundary + "\r\n";
+    payload += "Content-Type: application/http\r\n";
+    payload += "Content-ID: <" + std::to_string(i + 1) + ">\r\n\r\n";
+    payload += absl::visit(encoder, operations_[i]);
+    payload += "\r\n";
+  }
+  payload += "--" + boundary + "--\r\n";
+  return payload;
+}
+
+std::ostream& operator<<(std::ostream& os, ExecuteBatchRequest const& r) {
+  os << "ExecuteBatchRequest={operations={";
+  char const* sep = "";
+  for (auto const& op : r.operations()) {
+    os << sep;
+    absl::visit(OperationPrinter{os}, op);
+    sep = ", ";
+  }
+  return os << "}}";
+}
+
+StatusOr<ExecuteBatchResponse> ExecuteBatchResponse::FromHttpResponse(
+    ExecuteBatchRequest const& request, HttpResponse const& response) {
+  std::string boundary;
+  for (auto const& kv : response.headers) {
+    if (absl::AsciiStrToLower(kv.first) != "content-type") continue;
+    for (absl::string_view p : absl::StrSplit(kv.second, ';')) {
+      p = absl::StripAsciiWhitespace(p);
+      if (!absl::ConsumePrefix(&p, "boundary=")) continue;
+      absl::ConsumePrefix(&p, "\"");
+      absl::ConsumeSuffix(&p, "\"");
+      boundary = std::string(p);
+    }
+  }
+  if (boundary.empty()) {
+    return Status(StatusCode::kInternal,
+                  "missing multipart boundary in batch response");
+  }
+
+  auto const& operations = request.operations();
+  ExecuteBatchResponse result;
+  result.results.assign(
+      operations.size(),
+      Status(StatusCode::kInternal, "missing response in batch"));
+  auto const delimiter = "--" + boundary;
+  absl::string_view payload = response.payload;
+  auto pos = payload.find(delimiter);
+  std::size_t next_index = 0;
+  while (pos != absl::string_view::npos) {
+    payload.remove_prefix(pos + delimiter.size());
+    // The last delimiter is followed by `--`.
+    if (absl::StartsWith(payload, "--")) break;
+    pos = payload.find(delimiter);
+    auto entity = payload.substr(0, pos);
+    absl::ConsumePrefix(&entity, "\r\n") || absl::ConsumePrefix(&entity, "\n");
+    auto headers = ParseHeaders(SplitLines(SplitHeaders(entity).first));
+    auto index = ParseContentId(headers).value_or(next_index);
+    next_index = index + 1;
+    if (index >= operations.size()) continue;
+
+    auto part = ParsePart(SplitHeaders(entity).second);
+    if (!part) {
+      result.results[index] = std::move(part).status();
+      continue;
+    }
+    auto status = AsStatus(*part);
+    if (!status.ok()) {
+      result.results[index] = std::move(status);
+    } else if (absl::holds_alternative<PatchObjectRequest>(
+                   operations[index])) {
+      result.results[index] = ObjectMetadataParser::FromString(part->payload);
+    } else {
+      result.results[index] = ObjectMetadata{};
+    }
+  }
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& os, ExecuteBatchResponse const& r) {
+  os << "ExecuteBatchResponse={results={";
+  char const* sep = "";
+  for (auto const& result : r.results) {
+    os << sep;
+    if (result) {
+      os << "OK";
+    } else {
+      os << result.status();
+    }
+    sep = ", ";
+  }
+  return os << "}}";
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
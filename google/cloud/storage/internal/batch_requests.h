@@ -0,0 +1,93 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H
+
+#include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/variant.h"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// The maximum number of operations the service accepts in a single batch.
+constexpr std::size_t kMaxBatchOperations = 100;
+
+/**
+ * Represents a batch of JSON API requests sent in a single HTTP request.
+ *
+ * The operations are encoded as the parts of a `multipart/mixed` payload, see
+ * https://cloud.google.com/storage/docs/batch for details.
+ */
+class ExecuteBatchRequest {
+ public:
+  using Operation = absl::variant<DeleteObjectRequest, PatchObjectRequest>;
+
+  ExecuteBatchRequest() = default;
+  explicit ExecuteBatchRequest(std::vector<Operation> operations)
+      : operations_(std::move(operations)) {}
+
+  std::vector<Operation> const& operations() const { return operations_; }
+
+  /**
+   * Returns the `multipart/mixed` payload for this batch.
+   *
+   * @param boundary the separator between the parts, it must not appear in
+   *     the payload with an empty boundary.
+   * @param path_prefix the path for the JSON API, e.g. `/storage/v1`.
+   */
+  std::string Payload(std::string const& boundary,
+                      std::string const& path_prefix) const;
+
+ private:
+  std::vector<Operation> operations_;
+};
+
+std::ostream& operator<<(std::ostream& os, ExecuteBatchRequest const& r);
+
+/// Represents the results of a batch, one per operation.
+struct ExecuteBatchResponse {
+  /**
+   * Parses a `multipart/mixed` response.
+   *
+   * Each part of the response is matched to its operation using the
+   * `Content-ID` header. Operations without a response report an error.
+   */
+  static StatusOr<ExecuteBatchResponse> FromHttpResponse(
+      ExecuteBatchRequest const& request, HttpResponse const& response);
+
+  /// The result of each operation, successful deletes return an empty object.
+  std::vector<StatusOr<ObjectMetadata>> results;
+};
+
+std::ostream& operator<<(std::ostream& os, ExecuteBatchResponse const& r);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H
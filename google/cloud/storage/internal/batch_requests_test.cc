@@ -0,0 +1,140 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::HasSubstr;
+
+ExecuteBatchRequest MakeRequest() {
+  DeleteObjectRequest del("test-bucket", "folder/obj 1");
+  del.set_multiple_options(Generation(7), UserProject("my-project"));
+  PatchObjectRequest patch("test-bucket", "obj-2",
+                           ObjectMetadataPatchBuilder().SetContentType("a/b"));
+  patch.set_multiple_options(IfMetagenerationMatch(3));
+  return ExecuteBatchRequest({std::move(del), std::move(patch)});
+}
+
+TEST(BatchRequestsTest, Payload) {
+  auto const request = MakeRequest();
+  auto const& patch = absl::get<PatchObjectRequest>(request.operations()[1]);
+  auto const expected =
+      std::string("--BOUNDARY\r\n") +
+      "Content-Type: application/http\r\n"
+      "Content-ID: <1>\r\n"
+      "\r\n"
+      "DELETE /storage/v1/b/test-bucket/o/folder%2Fobj%201"
+      "?generation=7&userProject=my-project HTTP/1.1\r\n"
+      "\r\n"
+      "\r\n"
+      "--BOUNDARY\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <2>\r\n"
+      "\r\n"
+      "PATCH /storage/v1/b/test-bucket/o/obj-2?ifMetagenerationMatch=3"
+      " HTTP/1.1\r\n"
+      "Content-Type: application/json; charset=UTF-8\r\n"
+      "Content-Length: " +
+      std::to_string(patch.payload().size()) +
+      "\r\n"
+      "\r\n" +
+      patch.payload() +
+      "\r\n"
+      "--BOUNDARY--\r\n";
+  EXPECT_EQ(expected, request.Payload("BOUNDARY", "/storage/v1"));
+}
+
+TEST(BatchRequestsTest, ParseResponse) {
+  auto const request = MakeRequest();
+  // Responses may arrive out of order, they are matched by `Content-ID`.
+  std::string const payload = R"""(--batch_abc
+Content-Type: application/http
+Content-ID: <response-2>
+
+HTTP/1.1 200 OK
+Content-Type: application/json; charset=UTF-8
+
+{"bucket": "test-bucket", "name": "obj-2", "contentType": "a/b"}
+--batch_abc
+Content-Type: application/http
+Content-ID: <response-1>
+
+HTTP/1.1 204 No Content
+Content-Length: 0
+
+
+--batch_abc--
+)""";
+  HttpResponse response{
+      200, payload, {{"content-type", "multipart/mixed; boundary=batch_abc"}}};
+  auto actual = ExecuteBatchResponse::FromHttpResponse(request, response);
+  ASSERT_STATUS_OK(actual);
+  ASSERT_EQ(2, actual->results.size());
+  ASSERT_STATUS_OK(actual->results[0]);
+  ASSERT_STATUS_OK(actual->results[1]);
+  EXPECT_EQ("obj-2", actual->results[1]->name());
+  EXPECT_EQ("a/b", actual->results[1]->content_type());
+}
+
+TEST(BatchRequestsTest, ParseResponseErrors) {
+  auto const request = MakeRequest();
+  std::string const payload =
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-1>\r\n"
+      "\r\n"
+      "HTTP/1.1 412 Precondition Failed\r\n"
+      "Content-Type: application/json; charset=UTF-8\r\n"
+      "\r\n"
+      "{\"error\": {\"code\": 412, \"message\": \"failed\"}}\r\n"
+      "--batch_abc--\r\n";
+  HttpResponse response{
+      200, payload, {{"content-type", "multipart/mixed; boundary=batch_abc"}}};
+  auto actual = ExecuteBatchResponse::FromHttpResponse(request, response);
+  ASSERT_STATUS_OK(actual);
+  ASSERT_EQ(2, actual->results.size());
+  EXPECT_THAT(actual->results[0], StatusIs(StatusCode::kFailedPrecondition));
+  // The second operation has no response.
+  EXPECT_THAT(actual->results[1], StatusIs(StatusCode::kInternal));
+}
+
+TEST(BatchRequestsTest, ParseResponseMissingBoundary) {
+  HttpResponse response{200, "", {{"content-type", "application/json"}}};
+  EXPECT_THAT(ExecuteBatchResponse::FromHttpResponse(MakeRequest(), response),
+              StatusIs(StatusCode::kInternal));
+}
+
+TEST(BatchRequestsTest, Stream) {
+  std::ostringstream os;
+  os << MakeRequest();
+  EXPECT_THAT(os.str(), HasSubstr("folder/obj 1"));
+  EXPECT_THAT(os.str(), HasSubstr("obj-2"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,205 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/caching_object_read_source.h"
+#include "absl/strings/numbers.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::int64_t RequestGeneration(ReadObjectRangeRequest const& request) {
+  if (request.HasOption<Generation>()) {
+    return request.GetOption<Generation>().value();
+  }
+  return request.GetOption<IfGenerationMatch>().value();
+}
+
+std::int64_t RequestEnd(ReadObjectRangeRequest const& request) {
+  if (request.HasOption<ReadRange>()) {
+    return request.GetOption<ReadRange>().value().end;
+  }
+  return (std::numeric_limits<std::int64_t>::max)();
+}
+
+/// Parse the object size from a `Content-Range: bytes 0-9/1234` header.
+std::int64_t ObjectSize(HttpResponse const& response) {
+  auto h = response.headers.find("content-range");
+  if (h == response.headers.end()) return -1;
+  auto pos = h->second.rfind('/');
+  if (pos == std::string::npos) return -1;
+  std::int64_t size;
+  if (!absl::SimpleAtoi(h->second.substr(pos + 1), &size)) return -1;
+  return size;
+}
+
+}  // namespace
+
+CachingObjectReadSource::CachingObjectReadSource(
+    std::shared_ptr<RetryClient> client, ReadObjectRangeRequest request,
+    std::shared_ptr<ReadBlockCache> cache)
+    : client_(std::move(client)),
+      request_(std::move(request)),
+      cache_(std::move(cache)),
+      generation_(RequestGeneration(request_)),
+      object_key_(request_.bucket_name() + "/" + request_.object_name() + "#" +
+                  std::to_string(generation_)),
+      begin_(request_.StartingByte()),
+      end_(RequestEnd(request_)),
+      offset_(begin_) {}
+
+bool CachingObjectReadSource::IsCacheable(
+    ReadObjectRangeRequest const& request) {
+  // Full downloads are not cached, their checksums are validated.
+  if (!request.RequiresNoCache() || request.HasOption<ReadLast>()) {
+    return false;
+  }
+  if (!request.HasOption<Generation>() &&
+      !request.HasOption<IfGenerationMatch>()) {
+    return false;
+  }
+  if (request.HasOption<Generation>() &&
+      request.HasOption<IfGenerationMatch>() &&
+      request.GetOption<Generation>().value() !=
+          request.GetOption<IfGenerationMatch>().value()) {
+    return false;
+  }
+  // Encrypted objects are not cached, the data would be available without
+  // the key.
+  return !request.HasOption<EncryptionKey>() &&
+         !request.HasOption<CustomHeader>() &&
+         !request.HasOption<IfGenerationNotMatch>() &&
+         !request.HasOption<IfMetagenerationMatch>() &&
+         !request.HasOption<IfMetagenerationNotMatch>() &&
+         !request.HasOption<IfMatchEtag>() &&
+         !request.HasOption<IfNoneMatchEtag>();
+}
+
+StatusOr<HttpResponse> CachingObjectReadSource::Close() {
+  done_ = true;
+  return HttpResponse{HttpStatusCode::kOk, {}, {}};
+}
+
+StatusOr<ReadSourceResult> CachingObjectReadSource::Read(char* buf,
+                                                         std::size_t n) {
+  if (done_) return Status(StatusCode::kFailedPrecondition, "Stream is closed");
+  ReadSourceResult result{0, HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+  if (!headers_sent_) {
+    result.response.headers.emplace("x-goog-generation",
+                                    std::to_string(generation_));
+    headers_sent_ = true;
+  }
+  auto const block_size = static_cast<std::int64_t>(cache_->block_size());
+  while (n != 0) {
+    if (offset_ >= end_ || (object_size_ >= 0 && offset_ >= object_size_)) {
+      done_ = true;
+      break;
+    }
+    auto const index = offset_ / block_size;
+    auto block = cache_->Lookup(object_key_, index);
+    if (!block) {
+      // Return any data already copied before starting a new download.
+      if (result.bytes_received != 0) break;
+      auto fetched = Fetch(index);
+      // Without a `Content-Range` header the object size is unknown until the
+      // first block past the end of the object.
+      if (!fetched && offset_ != begin_ &&
+          fetched.status().code() == StatusCode::kOutOfRange) {
+        done_ = true;
+        break;
+      }
+      if (!fetched) return std::move(fetched).status();
+      block = *std::move(fetched);
+    }
+    if (block->object_size >= 0) object_size_ = block->object_size;
+    auto const block_start = index * block_size;
+    auto const block_end =
+        block_start + static_cast<std::int64_t>(block->data.size());
+    if (offset_ >= block_end) {
+      // The read starts past the end of the object, report the same error as
+      // the service would.
+      if (offset_ == begin_) {
+        return Status(StatusCode::kOutOfRange,
+                      "the requested range starts past the end of the object");
+      }
+      done_ = true;
+      break;
+    }
+    auto const count = static_cast<std::size_t>((std::min)(
+        {static_cast<std::int64_t>(n), block_end - offset_, end_ - offset_}));
+    std::memcpy(buf, block->data.data() + (offset_ - block_start), count);
+    buf += count;
+    n -= count;
+    offset_ += static_cast<std::int64_t>(count);
+    result.bytes_received += count;
+  }
+  if (offset_ >= end_ || (object_size_ >= 0 && offset_ >= object_size_)) {
+    done_ = true;
+  }
+  if (done_) result.response.status_code = HttpStatusCode::kOk;
+  return result;
+}
+
+StatusOr<std::shared_ptr<ReadBlockCache::Block const>>
+CachingObjectReadSource::Fetch(std::int64_t index) {
+  auto const block_size = cache_->block_size();
+  auto const block_start = index * static_cast<std::int64_t>(block_size);
+  ReadObjectRangeRequest request(request_.bucket_name(),
+                                 request_.object_name());
+  request.set_multiple_options(
+      Generation(generation_),
+      ReadRange(block_start,
+                block_start + static_cast<std::int64_t>(block_size)),
+      request_.GetOption<UserProject>(), request_.GetOption<QuotaUser>(),
+      request_.GetOption<UserIp>());
+  auto source = client_->ReadObjectWithoutCache(request);
+  if (!source) return std::move(source).status();
+
+  auto block = std::make_shared<Block>();
+  block->data.resize(block_size);
+  std::size_t size = 0;
+  while ((*source)->IsOpen()) {
+    // Read past the end of the block to detect the end of the download.
+    char overflow;
+    auto* dest = size < block_size ? &block->data[size] : &overflow;
+    auto const capacity = size < block_size ? block_size - size : 1;
+    auto r = (*source)->Read(dest, capacity);
+    if (!r) return std::move(r).status();
+    if (size == block_size && r->bytes_received != 0) {
+      return Status(StatusCode::kInternal,
+                    "download returned more data than requested");
+    }
+    size += r->bytes_received;
+    auto const object_size = ObjectSize(r->response);
+    if (object_size >= 0) block->object_size = object_size;
+  }
+  block->data.resize(size);
+  if (size < block_size) {
+    block->object_size = block_start + static_cast<std::int64_t>(size);
+  }
+  cache_->Insert(object_key_, index, block);
+  return std::shared_ptr<Block const>(std::move(block));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
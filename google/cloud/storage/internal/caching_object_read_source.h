@@ -0,0 +1,79 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CACHING_OBJECT_READ_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CACHING_OBJECT_READ_SOURCE_H
+
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/read_block_cache.h"
+#include "google/cloud/storage/internal/retry_client.h"
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A data source that serves ranged reads from a `ReadBlockCache`.
+ *
+ * The requested range is split into blocks. Blocks found in the cache are
+ * copied directly, missing blocks are downloaded (with retries) using
+ * `RetryClient::ReadObjectWithoutCache()` and then inserted in the cache.
+ *
+ * Only reads of a specific object generation can be cached, see
+ * `IsCacheable()`.
+ */
+class CachingObjectReadSource : public ObjectReadSource {
+ public:
+  CachingObjectReadSource(std::shared_ptr<RetryClient> client,
+                          ReadObjectRangeRequest request,
+                          std::shared_ptr<ReadBlockCache> cache);
+
+  /// Returns true if @p request can be served by this class.
+  static bool IsCacheable(ReadObjectRangeRequest const& request);
+
+  bool IsOpen() const override { return !done_; }
+  StatusOr<HttpResponse> Close() override;
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+
+ private:
+  using Block = ReadBlockCache::Block;
+
+  /// Download the block at @p index and insert it in the cache.
+  StatusOr<std::shared_ptr<Block const>> Fetch(std::int64_t index);
+
+  std::shared_ptr<RetryClient> client_;
+  ReadObjectRangeRequest request_;
+  std::shared_ptr<ReadBlockCache> cache_;
+  std::int64_t generation_;
+  std::string object_key_;
+  std::int64_t const begin_;
+  std::int64_t const end_;
+  std::int64_t offset_;
+  std::int64_t object_size_ = -1;
+  bool done_ = false;
+  bool headers_sent_ = false;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CACHING_OBJECT_READ_SOURCE_H
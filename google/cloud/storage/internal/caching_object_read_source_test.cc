@@ -0,0 +1,273 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/caching_object_read_source.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::google::cloud::testing_util::chrono_literals::operator"" _us;
+using ::testing::Return;
+
+/// Serves a range of an object, in small pieces, like a real download.
+class FakeReadSource : public ObjectReadSource {
+ public:
+  explicit FakeReadSource(std::string contents, std::string content_range = {})
+      : contents_(std::move(contents)),
+        content_range_(std::move(content_range)) {}
+
+  bool IsOpen() const override { return open_; }
+  StatusOr<HttpResponse> Close() override {
+    open_ = false;
+    return HttpResponse{HttpStatusCode::kOk, {}, {}};
+  }
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override {
+    auto count = (std::min)({n, contents_.size() - offset_, std::size_t{5}});
+    std::memcpy(buf, contents_.data() + offset_, count);
+    offset_ += count;
+    ReadSourceResult result{count,
+                            HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+    if (offset_ == contents_.size()) {
+      open_ = false;
+      result.response.status_code = HttpStatusCode::kOk;
+    }
+    if (!content_range_.empty()) {
+      result.response.headers.emplace("content-range", content_range_);
+    }
+    return result;
+  }
+
+ private:
+  std::string contents_;
+  std::string content_range_;
+  std::size_t offset_ = 0;
+  bool open_ = true;
+};
+
+std::string MakeContents(std::size_t size) {
+  std::string contents;
+  for (std::size_t i = 0; i != size; ++i) {
+    contents.push_back(static_cast<char>('a' + i % 26));
+  }
+  return contents;
+}
+
+Options TestOptions() {
+  return Options{}
+      .set<RetryPolicyOption>(LimitedErrorCountRetryPolicy(3).clone())
+      .set<BackoffPolicyOption>(
+          // Make the tests faster.
+          ExponentialBackoffPolicy(1_us, 2_us, 2).clone())
+      .set<IdempotencyPolicyOption>(AlwaysRetryIdempotencyPolicy().clone())
+      .set<storage_experimental::ReadBlockCacheSizeOption>(1024)
+      .set<storage_experimental::ReadBlockCacheBlockSizeOption>(16);
+}
+
+class CachingObjectReadSourceTest : public ::testing::Test {
+ protected:
+  /// Configure the mock to serve @p contents, returns the number of requests.
+  std::shared_ptr<int> ServeObject(std::string contents,
+                                   bool content_range = false) {
+    auto count = std::make_shared<int>(0);
+    EXPECT_CALL(*mock_, ReadObject)
+        .WillRepeatedly([count, contents,
+                         content_range](ReadObjectRangeRequest const& r) {
+          ++*count;
+          EXPECT_EQ(42, r.GetOption<Generation>().value_or(0));
+          auto range = r.GetOption<ReadRange>().value();
+          auto const size = static_cast<std::int64_t>(contents.size());
+          if (range.begin >= size) {
+            return StatusOr<std::unique_ptr<ObjectReadSource>>(
+                Status(StatusCode::kOutOfRange, "past the end"));
+          }
+          auto end = (std::min)(range.end, size);
+          auto data = contents.substr(
+              static_cast<std::size_t>(range.begin),
+              static_cast<std::size_t>(end - range.begin));
+          std::string header;
+          if (content_range) {
+            header = "bytes " + std::to_string(range.begin) + "-" +
+                     std::to_string(end - 1) + "/" + std::to_string(size);
+          }
+          return make_status_or(std::unique_ptr<ObjectReadSource>(
+              absl::make_unique<FakeReadSource>(std::move(data),
+                                                std::move(header))));
+        });
+    return count;
+  }
+
+  StatusOr<std::string> ReadAll(ReadObjectRangeRequest const& request) {
+    auto source = client_->ReadObject(request);
+    if (!source) return std::move(source).status();
+    std::string actual;
+    while ((*source)->IsOpen()) {
+      char buf[7];
+      auto r = (*source)->Read(buf, sizeof(buf));
+      if (!r) return std::move(r).status();
+      actual.append(buf, r->bytes_received);
+    }
+    return actual;
+  }
+
+  std::shared_ptr<testing::MockClient> mock_ =
+      std::make_shared<testing::MockClient>();
+  std::shared_ptr<RetryClient> client_ =
+      std::make_shared<RetryClient>(mock_, TestOptions());
+};
+
+TEST_F(CachingObjectReadSourceTest, IsCacheable) {
+  auto make = [] { return ReadObjectRangeRequest("test-bucket", "test-obj"); };
+  EXPECT_TRUE(CachingObjectReadSource::IsCacheable(
+      make().set_multiple_options(Generation(42), ReadRange(0, 10))));
+  EXPECT_TRUE(CachingObjectReadSource::IsCacheable(
+      make().set_multiple_options(IfGenerationMatch(42), ReadFromOffset(10))));
+  // Full downloads validate their checksums.
+  EXPECT_FALSE(CachingObjectReadSource::IsCacheable(
+      make().set_multiple_options(Generation(42))));
+  EXPECT_FALSE(CachingObjectReadSource::IsCacheable(
+      make().set_multiple_options(Generation(42), ReadLast(10))));
+  EXPECT_FALSE(CachingObjectReadSource::IsCacheable(
+      make().set_multiple_options(ReadRange(0, 10))));
+  EXPECT_FALSE(CachingObjectReadSource::IsCacheable(make().set_multiple_options(
+      Generation(42), IfGenerationMatch(7), ReadRange(0, 10))));
+  EXPECT_FALSE(CachingObjectReadSource::IsCacheable(make().set_multiple_options(
+      Generation(42), ReadRange(0, 10),
+      EncryptionKey::FromBinaryKey(std::string(32, 'k')))));
+}
+
+TEST_F(CachingObjectReadSourceTest, ServesRepeatedReadsFromCache) {
+  auto const contents = MakeContents(160);
+  auto count = ServeObject(contents);
+
+  auto request = ReadObjectRangeRequest("test-bucket", "test-obj")
+                     .set_multiple_options(Generation(42), ReadRange(20, 60));
+  auto actual = ReadAll(request);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents.substr(20, 40), *actual);
+  // The range covers blocks 1, 2, and 3.
+  EXPECT_EQ(3, *count);
+
+  actual = ReadAll(request);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents.substr(20, 40), *actual);
+  EXPECT_EQ(3, *count);
+
+  // An overlapping range only downloads the missing blocks.
+  actual = ReadAll(ReadObjectRangeRequest("test-bucket", "test-obj")
+                       .set_multiple_options(Generation(42), ReadRange(0, 40)));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents.substr(0, 40), *actual);
+  EXPECT_EQ(4, *count);
+}
+
+TEST_F(CachingObjectReadSourceTest, ReadToEndShortBlock) {
+  auto const contents = MakeContents(40);
+  auto count = ServeObject(contents);
+
+  auto request =
+      ReadObjectRangeRequest("test-bucket", "test-obj")
+          .set_multiple_options(IfGenerationMatch(42), ReadFromOffset(10));
+  auto actual = ReadAll(request);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents.substr(10), *actual);
+  EXPECT_EQ(3, *count);
+
+  // The last block records the object size, no requests past the end.
+  actual = ReadAll(request);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents.substr(10), *actual);
+  EXPECT_EQ(3, *count);
+}
+
+TEST_F(CachingObjectReadSourceTest, ReadToEndFullBlock) {
+  auto const contents = MakeContents(32);
+  auto count = ServeObject(contents);
+
+  auto actual =
+      ReadAll(ReadObjectRangeRequest("test-bucket", "test-obj")
+                  .set_multiple_options(Generation(42), ReadFromOffset(1)));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents.substr(1), *actual);
+  // Without a `Content-Range` header the end of the object is only detected
+  // when the next block is out of range.
+  EXPECT_EQ(3, *count);
+}
+
+TEST_F(CachingObjectReadSourceTest, ReadToEndContentRange) {
+  auto const contents = MakeContents(32);
+  auto count = ServeObject(contents, /*content_range=*/true);
+
+  auto actual =
+      ReadAll(ReadObjectRangeRequest("test-bucket", "test-obj")
+                  .set_multiple_options(Generation(42), ReadFromOffset(1)));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents.substr(1), *actual);
+  EXPECT_EQ(2, *count);
+}
+
+TEST_F(CachingObjectReadSourceTest, ReadPastEnd) {
+  auto const contents = MakeContents(20);
+  ServeObject(contents);
+
+  EXPECT_THAT(
+      ReadAll(ReadObjectRangeRequest("test-bucket", "test-obj")
+                  .set_multiple_options(Generation(42), ReadFromOffset(24))),
+      StatusIs(StatusCode::kOutOfRange));
+  EXPECT_THAT(
+      ReadAll(ReadObjectRangeRequest("test-bucket", "test-obj")
+                  .set_multiple_options(Generation(42), ReadFromOffset(40))),
+      StatusIs(StatusCode::kOutOfRange));
+}
+
+TEST_F(CachingObjectReadSourceTest, UncacheableRequest) {
+  EXPECT_CALL(*mock_, ReadObject).WillOnce([](ReadObjectRangeRequest const& r) {
+    EXPECT_FALSE(r.HasOption<ReadRange>());
+    return make_status_or(std::unique_ptr<ObjectReadSource>(
+        absl::make_unique<FakeReadSource>("full contents")));
+  });
+  auto actual = ReadAll(ReadObjectRangeRequest("test-bucket", "test-obj")
+                            .set_multiple_options(Generation(42)));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("full contents", *actual);
+}
+
+TEST_F(CachingObjectReadSourceTest, PermanentError) {
+  EXPECT_CALL(*mock_, ReadObject).WillOnce(Return(PermanentError()));
+  EXPECT_THAT(ReadAll(ReadObjectRangeRequest("test-bucket", "test-obj")
+                          .set_multiple_options(Generation(42),
+                                                ReadRange(0, 10))),
+              StatusIs(PermanentError().code()));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -63,6 +63,7 @@ namespace internal {
 class GrpcClient;
 template <typename Derived>
 struct CommonMetadataParser;
+class ObjectMetadataSaxHandler;
 
 /**
  * Defines common attributes to both `BucketMetadata` and `ObjectMetadata`.
@@ -106,6 +107,7 @@ class CommonMetadata {
   friend class GrpcClient;
   template <typename ParserDerived>
   friend struct CommonMetadataParser;
+  friend class ObjectMetadataSaxHandler;
 
   // Keep the fields in alphabetical order.
   std::string etag_;
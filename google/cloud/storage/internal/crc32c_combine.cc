@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include <array>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// The CRC32C (Castagnoli) polynomial, in the reversed (LSB-first)
+// representation used by the crc32c library.
+auto constexpr kCrc32cPolynomial = std::uint32_t{0x82F63B78};
+
+// A 32x32 matrix over GF(2), each element represents a column.
+using Gf2Matrix = std::array<std::uint32_t, 32>;
+
+std::uint32_t Gf2MatrixTimes(Gf2Matrix const& matrix, std::uint32_t vector) {
+  std::uint32_t sum = 0;
+  for (std::size_t i = 0; vector != 0; ++i, vector >>= 1) {
+    if ((vector & 1) != 0) sum ^= matrix[i];
+  }
+  return sum;
+}
+
+Gf2Matrix Gf2MatrixSquare(Gf2Matrix const& matrix) {
+  Gf2Matrix square;
+  for (std::size_t i = 0; i != matrix.size(); ++i) {
+    square[i] = Gf2MatrixTimes(matrix, matrix[i]);
+  }
+  return square;
+}
+
+}  // namespace
+
+// This is the algorithm used by zlib's `crc32_combine()`: the operator that
+// appends N zero bits to a CRC is a linear operator, represented as a matrix
+// over GF(2). Appending `length_b` zero bytes is computed by repeated squaring
+// of the operator for a single zero bit. The pre- and post-conditioning of the
+// CRC cancel out when XOR-ing the two (shifted) values.
+std::uint32_t Crc32cCombine(std::uint32_t crc_a, std::uint32_t crc_b,
+                            std::uintmax_t length_b) {
+  if (length_b == 0) return crc_a;
+
+  // The operator for a single zero bit.
+  Gf2Matrix odd;
+  odd[0] = kCrc32cPolynomial;
+  std::uint32_t row = 1;
+  for (std::size_t i = 1; i != odd.size(); ++i) {
+    odd[i] = row;
+    row <<= 1;
+  }
+  // The operators for two and four zero bits.
+  auto even = Gf2MatrixSquare(odd);
+  odd = Gf2MatrixSquare(even);
+
+  // Apply `length_b` zero bytes to `crc_a`, the first squaring below yields
+  // the operator for one zero byte.
+  do {
+    even = Gf2MatrixSquare(odd);
+    if ((length_b & 1) != 0) crc_a = Gf2MatrixTimes(even, crc_a);
+    length_b >>= 1;
+    if (length_b == 0) break;
+    odd = Gf2MatrixSquare(even);
+    if ((length_b & 1) != 0) crc_a = Gf2MatrixTimes(odd, crc_a);
+    length_b >>= 1;
+  } while (length_b != 0);
+
+  return crc_a ^ crc_b;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,70 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include <gmock/gmock.h>
+#include <crc32c/crc32c.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(Crc32cCombine, EmptySuffix) {
+  auto const crc = crc32c::Crc32c(std::string("The quick brown fox"));
+  EXPECT_EQ(crc, Crc32cCombine(crc, crc32c::Crc32c(std::string{}), 0));
+}
+
+TEST(Crc32cCombine, EmptyPrefix) {
+  std::string const suffix = "jumps over the lazy dog";
+  auto const crc = crc32c::Crc32c(suffix);
+  EXPECT_EQ(crc, Crc32cCombine(crc32c::Crc32c(std::string{}), crc,
+                               suffix.size()));
+}
+
+TEST(Crc32cCombine, QuickFox) {
+  std::string const full = "The quick brown fox jumps over the lazy dog";
+  auto const expected = crc32c::Crc32c(full);
+  for (std::size_t split = 0; split <= full.size(); ++split) {
+    SCOPED_TRACE("Testing with split = " + std::to_string(split));
+    auto const a = full.substr(0, split);
+    auto const b = full.substr(split);
+    EXPECT_EQ(expected, Crc32cCombine(crc32c::Crc32c(a), crc32c::Crc32c(b),
+                                      b.size()));
+  }
+}
+
+TEST(Crc32cCombine, ManySlices) {
+  std::string full;
+  for (int i = 0; i != 1000; ++i) full += std::to_string(i) + ",";
+  auto const expected = crc32c::Crc32c(full);
+
+  std::size_t const slice_size = 317;
+  std::uint32_t actual = crc32c::Crc32c(std::string{});
+  for (std::size_t offset = 0; offset < full.size(); offset += slice_size) {
+    auto const slice = full.substr(offset, slice_size);
+    actual = Crc32cCombine(actual, crc32c::Crc32c(slice), slice.size());
+  }
+  EXPECT_EQ(expected, actual);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
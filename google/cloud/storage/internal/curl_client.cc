@@ -24,12 +24,16 @@
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/storage/internal/object_read_streambuf.h"
 #include "google/cloud/storage/internal/object_write_streambuf.h"
+#include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/internal/service_account_parser.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/big_endian.h"
 #include "google/cloud/internal/getenv.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/match.h"
+#include <crc32c/crc32c.h>
+#include <cstring>
 #include <sstream>
 
 namespace google {
@@ -39,12 +43,40 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 namespace {
 
-std::shared_ptr<CurlHandleFactory> CreateHandleFactory(Options const& options) {
+std::shared_ptr<CurlShareHandle> CreateCurlShare(Options const& options) {
+  if (!options.get<storage_experimental::EnableCurlShareOption>()) {
+    return nullptr;
+  }
+  // Initialize libcurl before creating any of its objects.
+  CurlInitializeOnce(options);
+  return std::make_shared<CurlShareHandle>();
+}
+
+std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
+    Options const& options, std::shared_ptr<CurlShareHandle> share) {
   auto const pool_size = options.get<ConnectionPoolSizeOption>();
   if (pool_size == 0) {
-    return std::make_shared<DefaultCurlHandleFactory>(options);
+    return std::make_shared<DefaultCurlHandleFactory>(options,
+                                                      std::move(share));
   }
-  return std::make_shared<PooledCurlHandleFactory>(pool_size, options);
+  return std::make_shared<PooledCurlHandleFactory>(pool_size, options,
+                                                   std::move(share));
+}
+
+std::string ComputePayloadMD5Hash(absl::string_view payload) {
+  return Base64Encode(MD5Hash(payload));
+}
+
+std::string ComputePayloadCrc32cChecksum(absl::string_view payload) {
+  auto checksum = crc32c::Extend(
+      0, reinterpret_cast<std::uint8_t const*>(payload.data()), payload.size());
+  return Base64Encode(google::cloud::internal::EncodeBigEndian(checksum));
+}
+
+ConstBufferSequence PayloadBuffers(InsertObjectMediaRequest const& request) {
+  auto const contents = request.contents();
+  if (contents.empty()) return {};
+  return {ConstBuffer(contents.data(), contents.size())};
 }
 
 std::string UrlEscapeString(std::string const& value) {
@@ -128,10 +160,14 @@ Status CurlClient::SetupBuilderCommon(CurlRequestBuilder& builder,
     return std::move(auth_header).status();
   }
   builder.SetMethod(method)
-      .ApplyClientOptions(opts_)
-      .AddHeader(auth_header.value())
-      .AddHeader(HostHeader(opts_, service))
-      .AddHeader(x_goog_api_client_header_);
+      .ApplyClientConfig(builder_config_)
+      .AddHeader(auth_header.value());
+  if (std::strcmp(service, "storage") == 0) {
+    builder.AddHeader(storage_host_header_);
+  } else {
+    builder.AddHeader(HostHeader(opts_, service));
+  }
+  builder.AddHeader(x_goog_api_client_header_);
   return Status();
 }
 
@@ -266,12 +302,38 @@ CurlClient::CurlClient(google::cloud::Options options)
       xml_endpoint_(XmlEndpoint(opts_)),
       iam_endpoint_(IamEndpoint(opts_)),
       xml_enabled_(XmlEnabled()),
+      builder_config_(opts_),
+      storage_host_header_(HostHeader(opts_, "storage")),
       generator_(google::cloud::internal::MakeDefaultPRNG()),
-      storage_factory_(CreateHandleFactory(opts_)),
-      upload_factory_(CreateHandleFactory(opts_)),
-      xml_upload_factory_(CreateHandleFactory(opts_)),
-      xml_download_factory_(CreateHandleFactory(opts_)) {
+      share_(CreateCurlShare(opts_)),
+      storage_factory_(CreateHandleFactory(opts_, share_)),
+      upload_factory_(CreateHandleFactory(opts_, share_)),
+      xml_upload_factory_(CreateHandleFactory(opts_, share_)),
+      xml_download_factory_(CreateHandleFactory(opts_, share_)) {
   CurlInitializeOnce(opts_);
+  auto const prewarm =
+      opts_.get<storage_experimental::ConnectionPoolPrewarmOption>();
+  if (prewarm != 0) storage_factory_->Prewarm(storage_endpoint_, prewarm);
+  auto const threads =
+      opts_.get<storage_experimental::SharedCurlMultiThreadsOption>();
+  for (std::size_t i = 0; i != threads; ++i) {
+    multi_loops_.push_back(std::make_shared<CurlMultiLoop>());
+  }
+}
+
+CurlRequestCounters CurlClient::request_counters() const {
+  CurlRequestCounters counters;
+  for (auto const* f : {&storage_factory_, &upload_factory_,
+                        &xml_upload_factory_, &xml_download_factory_}) {
+    counters += (*f)->stats().Counters();
+  }
+  return counters;
+}
+
+void CurlClient::SetupDownloadBuilder(CurlRequestBuilder& builder) {
+  if (multi_loops_.empty()) return;
+  auto const i = next_multi_loop_.fetch_add(1) % multi_loops_.size();
+  builder.SetCurlMultiLoop(multi_loops_[i]);
 }
 
 StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
@@ -606,6 +668,12 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
   if (request.RequiresNoCache()) {
     builder.AddHeader("Cache-Control: no-transform");
   }
+  if (request.GetOption<DecompressGzip>().value_or(false)) {
+    // Disable decompressive transcoding, `GzipObjectReadSource` inflates the
+    // data in the client.
+    builder.AddHeader("Accept-Encoding: gzip");
+  }
+  SetupDownloadBuilder(builder);
 
   return std::unique_ptr<ObjectReadSource>(
       std::move(builder).BuildDownloadRequest());
@@ -622,8 +690,16 @@ StatusOr<ListObjectsResponse> CurlClient::ListObjects(
     return status;
   }
   builder.AddQueryParameter("pageToken", request.page_token());
-  return ParseFromHttpResponse<ListObjectsResponse>(
-      builder.BuildRequest().MakeRequest(std::string{}));
+  auto response = builder.BuildRequest().MakeRequest(std::string{});
+  if (!response.ok()) return std::move(response).status();
+  if (response->status_code >= HttpStatusCode::kMinNotSuccess) {
+    return AsStatus(*response);
+  }
+  if (request.summaries_only()) {
+    return ListObjectsResponse::SummariesFromHttpResponse(response->payload);
+  }
+  return ListObjectsResponse::FromHttpResponse(response->payload,
+                                               ListObjectsItemFields(request));
 }
 
 StatusOr<EmptyResponse> CurlClient::DeleteObject(
@@ -750,6 +826,35 @@ StatusOr<EmptyResponse> CurlClient::DeleteResumableUpload(
   return EmptyResponse{};
 }
 
+StatusOr<ExecuteBatchResponse> CurlClient::ExecuteBatch(
+    ExecuteBatchRequest const& request) {
+  if (request.operations().empty()) return ExecuteBatchResponse{};
+  if (request.operations().size() > kMaxBatchOperations) {
+    std::ostringstream os;
+    os << __func__ << " - a batch cannot have more than "
+       << kMaxBatchOperations << " operations, got "
+       << request.operations().size();
+    return Status(StatusCode::kInvalidArgument, std::move(os).str());
+  }
+  CurlRequestBuilder builder(JsonBatchEndpoint(opts_), storage_factory_);
+  auto status = SetupBuilderCommon(builder, "POST");
+  if (!status.ok()) {
+    return status;
+  }
+  auto const path_prefix = "/storage/" + opts_.get<TargetApiVersionOption>();
+  auto boundary = PickBoundary(request.Payload({}, path_prefix));
+  builder.AddHeader("content-type: multipart/mixed; boundary=" + boundary);
+  auto payload = request.Payload(boundary, path_prefix);
+  auto response = builder.BuildRequest().MakeRequest(payload);
+  if (!response.ok()) {
+    return std::move(response).status();
+  }
+  if (response->status_code >= HttpStatusCode::kMinNotSuccess) {
+    return AsStatus(*response);
+  }
+  return ExecuteBatchResponse::FromHttpResponse(request, *response);
+}
+
 StatusOr<ListBucketAclResponse> CurlClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   CurlRequestBuilder builder(
@@ -1237,14 +1342,15 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
     builder.AddHeader("x-goog-hash: md5=" +
                       request.GetOption<MD5HashValue>().value());
   } else if (!request.GetOption<DisableMD5Hash>().value_or(false)) {
-    builder.AddHeader("x-goog-hash: md5=" + ComputeMD5Hash(request.contents()));
+    builder.AddHeader("x-goog-hash: md5=" +
+                      ComputePayloadMD5Hash(request.contents()));
   }
   if (request.HasOption<Crc32cChecksumValue>()) {
     builder.AddHeader("x-goog-hash: crc32c=" +
                       request.GetOption<Crc32cChecksumValue>().value());
   } else if (!request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
     builder.AddHeader("x-goog-hash: crc32c=" +
-                      ComputeCrc32cChecksum(request.contents()));
+                      ComputePayloadCrc32cChecksum(request.contents()));
   }
   if (request.HasOption<PredefinedAcl>()) {
     builder.AddHeader("x-goog-acl: " +
@@ -1265,7 +1371,8 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
 
   builder.AddHeader("Content-Length: " +
                     std::to_string(request.contents().size()));
-  auto response = builder.BuildRequest().MakeRequest(request.contents());
+  auto response =
+      builder.BuildRequest().MakeUploadRequest(PayloadBuffers(request));
   if (!response.ok()) {
     return std::move(response).status();
   }
@@ -1314,6 +1421,12 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
   if (request.RequiresNoCache()) {
     builder.AddHeader("Cache-Control: no-transform");
   }
+  if (request.GetOption<DecompressGzip>().value_or(false)) {
+    // Disable decompressive transcoding, `GzipObjectReadSource` inflates the
+    // data in the client.
+    builder.AddHeader("Accept-Encoding: gzip");
+  }
+  SetupDownloadBuilder(builder);
 
   return std::unique_ptr<ObjectReadSource>(
       std::move(builder).BuildDownloadRequest());
@@ -1339,8 +1452,8 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   builder.AddQueryParameter("uploadType", "multipart");
   builder.AddQueryParameter("name", request.object_name());
 
-  // 3. Perform a streaming upload because computing the size upfront is more
-  //    complicated than it is worth.
+  // 3. Format the parts around the contents, the contents are sent from the
+  //    request buffer without copying them.
   std::ostringstream writer;
 
   nlohmann::json metadata = nlohmann::json::object();
@@ -1351,13 +1464,13 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   if (request.HasOption<MD5HashValue>()) {
     metadata["md5Hash"] = request.GetOption<MD5HashValue>().value();
   } else if (!request.GetOption<DisableMD5Hash>().value_or(false)) {
-    metadata["md5Hash"] = ComputeMD5Hash(request.contents());
+    metadata["md5Hash"] = ComputePayloadMD5Hash(request.contents());
   }
 
   if (request.HasOption<Crc32cChecksumValue>()) {
     metadata["crc32c"] = request.GetOption<Crc32cChecksumValue>().value();
   } else if (!request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
-    metadata["crc32c"] = ComputeCrc32cChecksum(request.contents());
+    metadata["crc32c"] = ComputePayloadCrc32cChecksum(request.contents());
   }
 
   std::string crlf = "\r\n";
@@ -1378,16 +1491,22 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   } else {
     writer << "content-type: application/octet-stream" << crlf;
   }
-  writer << crlf << request.contents() << crlf << marker << "--" << crlf;
+  writer << crlf;
+  auto const header = std::move(writer).str();
+  auto const trailer = crlf + marker + "--" + crlf;
 
   // 6. Return the results as usual.
-  auto contents = std::move(writer).str();
-  builder.AddHeader("Content-Length: " + std::to_string(contents.size()));
+  auto const contents = request.contents();
+  builder.AddHeader("Content-Length: " +
+                    std::to_string(header.size() + contents.size() +
+                                   trailer.size()));
   return CheckedFromString<ObjectMetadataParser>(
-      builder.BuildRequest().MakeRequest(contents));
+      builder.BuildRequest().MakeUploadRequest(
+          {ConstBuffer(header), ConstBuffer(contents.data(), contents.size()),
+           ConstBuffer(trailer)}));
 }
 
-std::string CurlClient::PickBoundary(std::string const& text_to_avoid) {
+std::string CurlClient::PickBoundary(absl::string_view text_to_avoid) {
   // We need to find a string that is *not* found in `text_to_avoid`, we pick
   // a string at random, and see if it is in `text_to_avoid`, if it is, we grow
   // the string with random characters and start from where we last found a
@@ -1424,7 +1543,7 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaSimple(
   builder.AddHeader("Content-Length: " +
                     std::to_string(request.contents().size()));
   return CheckedFromString<ObjectMetadataParser>(
-      builder.BuildRequest().MakeRequest(request.contents()));
+      builder.BuildRequest().MakeUploadRequest(PayloadBuffers(request)));
 }
 
 }  // namespace internal
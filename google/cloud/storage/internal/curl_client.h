@@ -16,13 +16,20 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_CLIENT_H
 
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/internal/curl_multi_loop.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include "google/cloud/storage/internal/curl_request_stats.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/internal/random.h"
+#include "absl/strings/string_view.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -85,6 +92,14 @@ class CurlClient : public RawClient,
     return backwards_compatibility_options_;
   }
 
+  /**
+   * The request counters, added across all the handle factories.
+   *
+   * Use these to diagnose connection reuse, e.g., a high number of new
+   * connections suggests the connection pool is too small.
+   */
+  CurlRequestCounters request_counters() const;
+
   StatusOr<ListBucketsResponse> ListBuckets(
       ListBucketsRequest const& request) override;
   StatusOr<BucketMetadata> CreateBucket(
@@ -131,6 +146,8 @@ class CurlClient : public RawClient,
       std::string const& session_id) override;
   StatusOr<EmptyResponse> DeleteResumableUpload(
       DeleteResumableUploadRequest const& request) override;
+  StatusOr<ExecuteBatchResponse> ExecuteBatch(
+      ExecuteBatchRequest const& request) override;
 
   StatusOr<ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const& request) override;
@@ -210,6 +227,9 @@ class CurlClient : public RawClient,
   Status SetupBuilder(CurlRequestBuilder& builder, Request const& request,
                       char const* method);
 
+  /// Runs @p builder's download on a shared loop, if enabled.
+  void SetupDownloadBuilder(CurlRequestBuilder& builder);
+
   StatusOr<ObjectMetadata> InsertObjectMediaXml(
       InsertObjectMediaRequest const& request);
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObjectXml(
@@ -218,7 +238,7 @@ class CurlClient : public RawClient,
   /// Insert an object using uploadType=multipart.
   StatusOr<ObjectMetadata> InsertObjectMediaMultipart(
       InsertObjectMediaRequest const& request);
-  std::string PickBoundary(std::string const& text_to_avoid);
+  std::string PickBoundary(absl::string_view text_to_avoid);
 
   /// Insert an object using uploadType=media.
   StatusOr<ObjectMetadata> InsertObjectMediaSimple(
@@ -236,14 +256,22 @@ class CurlClient : public RawClient,
   std::string const xml_endpoint_;
   std::string const iam_endpoint_;
   bool const xml_enabled_;
+  // Computed once, instead of on each request.
+  CurlRequestBuilderConfig const builder_config_;
+  std::string const storage_host_header_;
 
   std::mutex mu_;
   google::cloud::internal::DefaultPRNG generator_;  // GUARDED_BY(mu_);
 
+  // Shared by the handles created by all the factories, if not null.
+  std::shared_ptr<CurlShareHandle> share_;
   std::shared_ptr<CurlHandleFactory> storage_factory_;
   std::shared_ptr<CurlHandleFactory> upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_download_factory_;
+
+  std::vector<std::shared_ptr<CurlMultiLoop>> multi_loops_;
+  std::atomic<std::size_t> next_multi_loop_{0};
 };
 
 }  // namespace internal
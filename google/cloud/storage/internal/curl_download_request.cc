@@ -54,23 +54,27 @@ extern "C" std::size_t CurlDownloadRequestHeader(char* contents,
                  << ", closing=" << closing_ << ", closed=" << curl_closed_ \
                  << ", paused=" << paused_ << ", in_multi=" << in_multi_
 
-CurlDownloadRequest::CurlDownloadRequest(CurlHeaders headers, CurlHandle handle,
-                                         CurlMulti multi)
+CurlDownloadRequest::CurlDownloadRequest(
+    CurlHeaders headers, CurlHandle handle, CurlMulti multi,
+    std::shared_ptr<IoBufferPool> const& buffer_pool)
     : headers_(std::move(headers)),
       download_stall_timeout_(0),
       handle_(std::move(handle)),
       multi_(std::move(multi)),
-      spill_(CURL_MAX_WRITE_SIZE) {}
+      spill_(MakeIoBuffer(buffer_pool, CURL_MAX_WRITE_SIZE)) {}
 
 CurlDownloadRequest::~CurlDownloadRequest() {
   CleanupHandles();
   if (factory_) {
     factory_->CleanupHandle(std::move(handle_));
-    factory_->CleanupMultiHandle(std::move(multi_));
+    factory_->CleanupMultiHandle(std::move(multi_), url_);
   }
 }
 
 StatusOr<HttpResponse> CurlDownloadRequest::Close() {
+  // Once the handle is removed from a shared loop no other thread uses the
+  // state in this class.
+  if (loop_) CleanupHandles();
   if (curl_closed_) return HttpResponse{http_code_, {}, received_headers_};
   TRACE_STATE();
   // Set the the closing_ flag to trigger a return 0 from the next read
@@ -100,6 +104,8 @@ StatusOr<HttpResponse> CurlDownloadRequest::Close() {
 }
 
 StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
+  std::unique_lock<std::mutex> lk;
+  if (loop_) lk = loop_->Lock();
   buffer_ = buf;
   buffer_offset_ = 0;
   buffer_size_ = n;
@@ -113,29 +119,47 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
   // to return it.
   DrainSpillBuffer();
   if (curl_closed_) {
+    if (spill_offset_ != 0) return PartialResult(buffer_offset_);
     return ReadSourceResult{
         buffer_offset_,
         HttpResponse{http_code_, std::string{}, std::move(received_headers_)}};
   }
 
-  handle_.SetOption(CURLOPT_WRITEFUNCTION, &CurlDownloadRequestWrite);
-  handle_.SetOption(CURLOPT_WRITEDATA, this);
-  handle_.SetOption(CURLOPT_HEADERFUNCTION, &CurlDownloadRequestHeader);
-  handle_.SetOption(CURLOPT_HEADERDATA, this);
+  if (!loop_) {
+    // With a shared loop these are set before the transfer starts.
+    handle_.SetOption(CURLOPT_WRITEFUNCTION, &CurlDownloadRequestWrite);
+    handle_.SetOption(CURLOPT_WRITEDATA, this);
+    handle_.SetOption(CURLOPT_HEADERFUNCTION, &CurlDownloadRequestHeader);
+    handle_.SetOption(CURLOPT_HEADERDATA, this);
+  }
 
   handle_.FlushDebug(__func__);
   TRACE_STATE();
 
   if (!curl_closed_ && paused_) {
     paused_ = false;
-    auto status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
-    TRACE_STATE() << ", status=" << status;
-    if (!status.ok()) return status;
+    if (loop_) {
+      loop_->Unpause(lk, handle_.handle_.get());
+    } else {
+      auto status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
+      TRACE_STATE() << ", status=" << status;
+      if (!status.ok()) return status;
+    }
   }
 
-  auto status = Wait([this] {
+  auto predicate = [this] {
     return curl_closed_ || paused_ || buffer_offset_ >= buffer_size_;
-  });
+  };
+  Status status;
+  if (loop_) {
+    loop_->Wait(lk, predicate);
+    status = transfer_status_;
+    // A closed transfer is no longer in the loop, release the lock so the
+    // clean up below does not block other transfers.
+    if (curl_closed_) lk.unlock();
+  } else {
+    status = Wait(predicate);
+  }
   TRACE_STATE() << ", status=" << status;
   if (!status.ok()) return OnTransferError(std::move(status));
   auto bytes_read = buffer_offset_;
@@ -150,6 +174,12 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
     TRACE_STATE() << ", status=" << status
                   << ", http code=" << response.status_code;
     if (!status.ok()) return status;
+    // The transfer may complete (this is common with a shared loop) before the
+    // application consumes all the data in the spill buffer.
+    if (spill_offset_ != 0) {
+      received_headers_ = std::move(response.headers);
+      return PartialResult(bytes_read);
+    }
     return ReadSourceResult{bytes_read, std::move(response)};
   }
   TRACE_STATE() << ", code=100";
@@ -160,7 +190,24 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
           HttpStatusCode::kContinue, {}, std::move(received_headers_)}};
 }
 
+ReadSourceResult CurlDownloadRequest::PartialResult(std::size_t bytes_read) {
+  return ReadSourceResult{bytes_read,
+                          HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+}
+
 void CurlDownloadRequest::CleanupHandles() {
+  if (loop_) {
+    auto lk = loop_->Lock();
+    if (!in_multi_) return;
+    loop_->RemoveHandle(lk, handle_.handle_.get());
+    in_multi_ = false;
+    TRACE_STATE();
+    if (paused_) {
+      paused_ = false;
+      (void)handle_.EasyPause(CURLPAUSE_RECV_CONT);
+    }
+    return;
+  }
   if (!multi_ != !handle_.handle_) {
     GCP_LOG(FATAL) << "handles are inconsistent, multi_=" << multi_.get()
                    << ", handle_.handle_=" << handle_.handle_.get();
@@ -210,6 +257,10 @@ void CurlDownloadRequest::SetOptions() {
         static_cast<long>(download_stall_timeout_.count()));
   }
   if (in_multi_) GCP_LOG(FATAL) << "in_multi_ should be false in `SetOptions`";
+  if (loop_) {
+    AddToLoop();
+    return;
+  }
   auto error = curl_multi_add_handle(multi_.get(), handle_.handle_.get());
   if (error != CURLM_OK) {
     // This indicates that we are using the API incorrectly, the application
@@ -220,6 +271,25 @@ void CurlDownloadRequest::SetOptions() {
   in_multi_ = true;
 }
 
+void CurlDownloadRequest::AddToLoop() {
+  handle_.SetOption(CURLOPT_WRITEFUNCTION, &CurlDownloadRequestWrite);
+  handle_.SetOption(CURLOPT_WRITEDATA, this);
+  handle_.SetOption(CURLOPT_HEADERFUNCTION, &CurlDownloadRequestHeader);
+  handle_.SetOption(CURLOPT_HEADERDATA, this);
+  // Prefer waiting for a connection that can be multiplexed over opening a
+  // new connection.
+  handle_.SetOption(CURLOPT_PIPEWAIT, 1L);
+  auto lk = loop_->Lock();
+  loop_->AddHandle(lk, handle_.handle_.get(), [this](Status status) {
+    // Called with the loop mutex held, after the handle is removed.
+    in_multi_ = false;
+    curl_closed_ = true;
+    // Errors are expected when closing, see `PerformWork()`.
+    if (!closing_) transfer_status_ = std::move(status);
+  });
+  in_multi_ = true;
+}
+
 void CurlDownloadRequest::OnTransferDone() {
   // Retrieve the response code for a closed stream. Note the use of
   // `.value()`, this is equivalent to: assert(http_code.ok());
@@ -236,12 +306,13 @@ void CurlDownloadRequest::OnTransferDone() {
   // Capture the peer (the HTTP server), used for troubleshooting.
   received_headers_.emplace(":curl-peer", handle_.GetPeer());
   TRACE_STATE();
+  if (factory_) factory_->stats().OnRequestDone(handle_.GetNumConnects());
 
   // Release the handles back to the factory as soon as possible, so they can be
   // reused for any other requests.
   if (factory_) {
     factory_->CleanupHandle(std::move(handle_));
-    factory_->CleanupMultiHandle(std::move(multi_));
+    factory_->CleanupMultiHandle(std::move(multi_), url_);
   }
 }
 
@@ -255,7 +326,7 @@ Status CurlDownloadRequest::OnTransferError(Status status) {
     // While the handle is suspect, there is probably nothing wrong with the
     // CURLM* handle, that just represents a local resource, such as data
     // structures for `epoll(7)` or `select(2)`
-    factory_->CleanupMultiHandle(std::move(multi_));
+    factory_->CleanupMultiHandle(std::move(multi_), url_);
   }
   return status;
 }
@@ -15,12 +15,16 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H
 
+#include "google/cloud/storage/internal/curl_multi_loop.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/io_buffer_pool.h"
 #include "google/cloud/storage/version.h"
 #include "absl/functional/function_ref.h"
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -48,7 +52,10 @@ extern "C" std::size_t CurlDownloadRequestHeader(char* contents,
  */
 class CurlDownloadRequest : public ObjectReadSource {
  public:
-  CurlDownloadRequest(CurlHeaders headers, CurlHandle handle, CurlMulti multi);
+  /// Creates a request, its spill buffer is acquired from @p buffer_pool if
+  /// not null.
+  CurlDownloadRequest(CurlHeaders headers, CurlHandle handle, CurlMulti multi,
+                      std::shared_ptr<IoBufferPool> const& buffer_pool = {});
 
   ~CurlDownloadRequest() override;
 
@@ -89,12 +96,18 @@ class CurlDownloadRequest : public ObjectReadSource {
   /// Set the underlying CurlHandle options on a new CurlDownloadRequest.
   void SetOptions();
 
+  /// Start the transfer on a shared `CurlMultiLoop`.
+  void AddToLoop();
+
   /// Handle a completed (even interrupted) download.
   void OnTransferDone();
 
   /// Handle an error during a transfer
   Status OnTransferError(Status status);
 
+  /// A result for a closed transfer with data left in the spill buffer.
+  static ReadSourceResult PartialResult(std::size_t bytes_read);
+
   /// Copy any available data from the spill buffer to `buffer_`
   void DrainSpillBuffer();
 
@@ -130,6 +143,12 @@ class CurlDownloadRequest : public ObjectReadSource {
   CurlMulti multi_;
   std::shared_ptr<CurlHandleFactory> factory_;
 
+  // When set, the transfer runs on this shared loop instead of `multi_`. In
+  // that case the loop's mutex guards the members below, because they are also
+  // used by the callbacks running in the loop's background thread.
+  std::shared_ptr<CurlMultiLoop> loop_;
+  Status transfer_status_;
+
   // Explicitly closing the handle happens in two steps.
   // 1. First the application (or higher-level class), calls Close(). This class
   //    needs to notify libcurl that the transfer is terminated by returning 0
@@ -163,7 +182,7 @@ class CurlDownloadRequest : public ObjectReadSource {
   // less bytes read aborts the download (we do that on a Close(), but in
   // general we do not). The application may have requested less bytes in the
   // call to `Read()`, so we need a place to store the additional bytes.
-  std::vector<char> spill_;
+  IoBuffer spill_;
   std::size_t spill_offset_ = 0;
 };
 
@@ -157,6 +157,12 @@ StatusOr<std::int32_t> CurlHandle::GetResponseCode() {
   return AsStatus(e, __func__);
 }
 
+long CurlHandle::GetNumConnects() {  // NOLINT(google-runtime-int)
+  long count = 0;                       // NOLINT(google-runtime-int)
+  auto e = curl_easy_getinfo(handle_.get(), CURLINFO_NUM_CONNECTS, &count);
+  return e == CURLE_OK ? count : 0;
+}
+
 std::string CurlHandle::GetPeer() {
   char* ip = nullptr;
   auto e = curl_easy_getinfo(handle_.get(), CURLINFO_PRIMARY_IP, &ip);
@@ -134,6 +134,9 @@ class CurlHandle {
   /// Gets the HTTP response code, or an error.
   StatusOr<std::int32_t> GetResponseCode();
 
+  /// Gets the number of new connections opened by the last transfer.
+  long GetNumConnects();  // NOLINT(google-runtime-int)
+
   /**
    * Gets a string identifying the peer.
    *
@@ -13,6 +13,13 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/options.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/ascii.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -42,7 +49,9 @@ std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory(
   return GetDefaultCurlHandleFactory();
 }
 
-DefaultCurlHandleFactory::DefaultCurlHandleFactory(Options const& o) {
+DefaultCurlHandleFactory::DefaultCurlHandleFactory(
+    Options const& o, std::shared_ptr<CurlShareHandle> share)
+    : share_(std::move(share)) {
   if (o.has<CARootsFilePathOption>()) cainfo_ = o.get<CARootsFilePathOption>();
   if (o.has<CAPathOption>()) capath_ = o.get<CAPathOption>();
 }
@@ -77,81 +86,236 @@ void DefaultCurlHandleFactory::SetCurlOptions(CURL* handle) {
   if (capath_) {
     SetCurlStringOption(handle, CURLOPT_CAPATH, capath_->c_str());
   }
+  if (share_) (void)curl_easy_setopt(handle, CURLOPT_SHARE, share_->get());
 }
 
-PooledCurlHandleFactory::PooledCurlHandleFactory(std::size_t maximum_size,
-                                                 Options const& o)
-    : maximum_size_(maximum_size) {
+namespace {
+
+std::size_t DefaultShardCount(std::size_t maximum_size) {
+  std::size_t const threads = std::thread::hardware_concurrency();
+  return (std::max)(std::size_t{1}, (std::min)(maximum_size, threads));
+}
+
+/// Returns the most recently released handle for @p endpoint, if any.
+template <typename T>
+T* PopMatching(std::deque<std::pair<std::string, T*>>& pool,
+               std::string const& endpoint) {
+  auto i = std::find_if(
+      pool.rbegin(), pool.rend(),
+      [&endpoint](std::pair<std::string, T*> const& e) {
+        return e.first == endpoint;
+      });
+  if (i == pool.rend()) return nullptr;
+  auto* handle = i->second;
+  pool.erase(std::next(i).base());
+  return handle;
+}
+
+/// Adds @p handle to @p pool, evicting the oldest handles if needed.
+template <typename T, typename Cleanup>
+void PushEvicting(std::deque<std::pair<std::string, T*>>& pool,
+                  std::size_t maximum_size, std::string endpoint, T* handle,
+                  Cleanup cleanup) {
+  while (!pool.empty() && pool.size() >= maximum_size) {
+    cleanup(pool.front().second);
+    pool.pop_front();
+  }
+  pool.emplace_back(std::move(endpoint), handle);
+}
+
+// Prewarming must not block the client constructor for long, the connections
+// are an optimization.
+auto constexpr kPrewarmTimeoutMs = 5000L;
+
+}  // namespace
+
+std::string CurlPoolEndpoint(std::string const& url) {
+  auto const scheme = url.find("://");
+  auto const authority = scheme == std::string::npos ? 0 : scheme + 3;
+  auto const path = url.find_first_of("/?#", authority);
+  return absl::AsciiStrToLower(url.substr(0, path));
+}
+
+PooledCurlHandleFactory::PooledCurlHandleFactory(
+    std::size_t maximum_size, Options const& o,
+    std::shared_ptr<CurlShareHandle> share)
+    : maximum_size_(maximum_size), share_(std::move(share)) {
+  auto shards = o.get<storage_experimental::ConnectionPoolShardsOption>();
+  if (shards == 0) shards = DefaultShardCount(maximum_size_);
+  // Split the capacity, rounding up, so the pool is never smaller than
+  // requested.
+  shard_size_ =
+      (std::max)(std::size_t{1}, (maximum_size_ + shards - 1) / shards);
+  for (std::size_t i = 0; i != shards; ++i) {
+    shards_.push_back(absl::make_unique<Shard>());
+  }
   if (o.has<CARootsFilePathOption>()) cainfo_ = o.get<CARootsFilePathOption>();
   if (o.has<CAPathOption>()) capath_ = o.get<CAPathOption>();
+  http_version_ = o.get<storage_experimental::HttpVersionOption>();
 }
 
 PooledCurlHandleFactory::~PooledCurlHandleFactory() {
-  for (auto* h : handles_) {
-    curl_easy_cleanup(h);
-  }
-  for (auto* m : multi_handles_) {
-    curl_multi_cleanup(m);
+  for (auto& shard : shards_) {
+    for (auto& h : shard->handles) curl_easy_cleanup(h.second);
+    for (auto& m : shard->multi_handles) curl_multi_cleanup(m.second);
   }
 }
 
-CurlPtr PooledCurlHandleFactory::CreateHandle() {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (!handles_.empty()) {
-    auto* handle = handles_.back();
+CurlPtr PooledCurlHandleFactory::CreateHandle() { return CreateHandle({}); }
+
+CurlPtr PooledCurlHandleFactory::CreateHandle(std::string const& url) {
+  auto* handle = AcquireHandle(CurlPoolEndpoint(url));
+  if (handle != nullptr) {
     // Clear all the options in the handle so we do not leak its previous state.
+    // This preserves the open connections and the DNS and TLS session caches.
     (void)curl_easy_reset(handle);
-    handles_.pop_back();
-    CurlPtr curl(handle, &curl_easy_cleanup);
-    SetCurlOptions(curl.get());
-    return curl;
+  } else {
+    handle = curl_easy_init();
   }
-  CurlPtr curl(curl_easy_init(), &curl_easy_cleanup);
+  CurlPtr curl(handle, &curl_easy_cleanup);
   SetCurlOptions(curl.get());
   return curl;
 }
 
 void PooledCurlHandleFactory::CleanupHandle(CurlHandle&& h) {
   if (GetHandle(h) == nullptr) return;
-  std::unique_lock<std::mutex> lk(mu_);
   char* ip;
   auto res = curl_easy_getinfo(GetHandle(h), CURLINFO_LOCAL_IP, &ip);
   if (res == CURLE_OK && ip != nullptr) {
+    std::lock_guard<std::mutex> lk(mu_);
     last_client_ip_address_ = ip;
   }
-  while (handles_.size() >= maximum_size_) {
-    auto* tmp = handles_.front();
-    handles_.erase(handles_.begin());
-    curl_easy_cleanup(tmp);
-  }
-  handles_.push_back(GetHandle(h));
-  // The handles_ vector now has ownership, so release it.
+  char* url = nullptr;
+  res = curl_easy_getinfo(GetHandle(h), CURLINFO_EFFECTIVE_URL, &url);
+  auto endpoint =
+      res == CURLE_OK && url != nullptr ? CurlPoolEndpoint(url) : std::string{};
+  ReturnHandle(CurrentShard(), std::move(endpoint), GetHandle(h));
+  // The pool now has ownership, so release it.
   ReleaseHandle(h);
 }
 
 CurlMulti PooledCurlHandleFactory::CreateMultiHandle() {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (!multi_handles_.empty()) {
-    auto* m = multi_handles_.back();
-    multi_handles_.pop_back();
-    return CurlMulti(m, &curl_multi_cleanup);
-  }
+  return CreateMultiHandle({});
+}
+
+CurlMulti PooledCurlHandleFactory::CreateMultiHandle(std::string const& url) {
+  auto* m = AcquireMultiHandle(CurlPoolEndpoint(url));
+  if (m != nullptr) return CurlMulti(m, &curl_multi_cleanup);
   return CurlMulti(curl_multi_init(), &curl_multi_cleanup);
 }
 
 void PooledCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m) {
+  CleanupMultiHandle(std::move(m), {});
+}
+
+void PooledCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m,
+                                                 std::string const& url) {
   if (!m) return;
-  std::unique_lock<std::mutex> lk(mu_);
-  while (multi_handles_.size() >= maximum_size_) {
-    auto* tmp = multi_handles_.front();
-    multi_handles_.erase(multi_handles_.begin());
-    curl_multi_cleanup(tmp);
-  }
-  multi_handles_.push_back(m.get());
-  // The multi_handles_ vector now has ownership, so release it.
+  auto& shard = *shards_[CurrentShard()];
+  std::lock_guard<std::mutex> lk(shard.mu);
+  PushEvicting(shard.multi_handles, shard_size_, CurlPoolEndpoint(url),
+               m.get(), [](CURLM* tmp) { curl_multi_cleanup(tmp); });
+  // The pool now has ownership, so release it.
   (void)m.release();
 }
 
+void PooledCurlHandleFactory::Prewarm(std::string const& url,
+                                      std::size_t count) {
+  count = (std::min)(count, maximum_size_);
+  std::vector<CurlPtr> handles;
+  for (std::size_t i = 0; i != count; ++i) {
+    CurlPtr curl(curl_easy_init(), &curl_easy_cleanup);
+    SetCurlOptions(curl.get());
+    (void)curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+    // A HEAD request is enough to open the connection and complete the TLS
+    // handshake, the response is ignored.
+    (void)curl_easy_setopt(curl.get(), CURLOPT_NOBODY, 1L);
+    (void)curl_easy_setopt(curl.get(), CURLOPT_NOSIGNAL, 1L);
+    (void)curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT_MS, kPrewarmTimeoutMs);
+    if (!http_version_.empty()) {
+      (void)curl_easy_setopt(curl.get(), CURLOPT_HTTP_VERSION,
+                             VersionToCurlCode(http_version_));
+    }
+    handles.push_back(std::move(curl));
+  }
+  // Each handle keeps its connection in its own cache, use a thread per handle
+  // to open them in parallel.
+  std::vector<std::thread> tasks;
+  for (auto& h : handles) {
+    tasks.emplace_back([&h] { (void)curl_easy_perform(h.get()); });
+  }
+  for (auto& t : tasks) t.join();
+
+  auto const endpoint = CurlPoolEndpoint(url);
+  for (std::size_t i = 0; i != handles.size(); ++i) {
+    ReturnHandle(i % shards_.size(), endpoint, handles[i].release());
+  }
+}
+
+std::size_t PooledCurlHandleFactory::CurrentHandleCount() const {
+  std::size_t count = 0;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    count += shard->handles.size();
+  }
+  return count;
+}
+
+std::size_t PooledCurlHandleFactory::CurrentMultiHandleCount() const {
+  std::size_t count = 0;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    count += shard->multi_handles.size();
+  }
+  return count;
+}
+
+std::size_t PooledCurlHandleFactory::CurrentShard() const {
+  auto const h = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return h % shards_.size();
+}
+
+CURL* PooledCurlHandleFactory::AcquireHandle(std::string const& endpoint) {
+  auto& shard = *shards_[CurrentShard()];
+  {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    if (auto* h = PopMatching(shard.handles, endpoint)) return h;
+  }
+  // Look for a matching handle in the other shards, but do not wait for them,
+  // creating a new handle is cheaper than blocking.
+  for (auto& other : shards_) {
+    if (other.get() == &shard) continue;
+    std::unique_lock<std::mutex> lk(other->mu, std::try_to_lock);
+    if (!lk) continue;
+    if (auto* h = PopMatching(other->handles, endpoint)) return h;
+  }
+  return nullptr;
+}
+
+void PooledCurlHandleFactory::ReturnHandle(std::size_t shard,
+                                           std::string endpoint, CURL* handle) {
+  auto& s = *shards_[shard];
+  std::lock_guard<std::mutex> lk(s.mu);
+  PushEvicting(s.handles, shard_size_, std::move(endpoint), handle,
+               [](CURL* tmp) { curl_easy_cleanup(tmp); });
+}
+
+CURLM* PooledCurlHandleFactory::AcquireMultiHandle(
+    std::string const& endpoint) {
+  auto& shard = *shards_[CurrentShard()];
+  {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    if (auto* m = PopMatching(shard.multi_handles, endpoint)) return m;
+  }
+  for (auto& other : shards_) {
+    if (other.get() == &shard) continue;
+    std::unique_lock<std::mutex> lk(other->mu, std::try_to_lock);
+    if (!lk) continue;
+    if (auto* m = PopMatching(other->multi_handles, endpoint)) return m;
+  }
+  return nullptr;
+}
+
 void PooledCurlHandleFactory::SetCurlOptions(CURL* handle) {
   if (cainfo_) {
     SetCurlStringOption(handle, CURLOPT_CAINFO, cainfo_->c_str());
@@ -159,6 +323,7 @@ void PooledCurlHandleFactory::SetCurlOptions(CURL* handle) {
   if (capath_) {
     SetCurlStringOption(handle, CURLOPT_CAPATH, capath_->c_str());
   }
+  if (share_) (void)curl_easy_setopt(handle, CURLOPT_SHARE, share_->get());
 }
 
 }  // namespace internal
@@ -16,12 +16,16 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HANDLE_FACTORY_H
 
 #include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/storage/internal/curl_request_stats.h"
 #include "google/cloud/storage/internal/curl_wrappers.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/options.h"
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -41,8 +45,47 @@ class CurlHandleFactory {
   virtual CurlMulti CreateMultiHandle() = 0;
   virtual void CleanupMultiHandle(CurlMulti&&) = 0;
 
+  /**
+   * Create a handle to make requests to @p url.
+   *
+   * Factories that pool handles use @p url to return a handle that recently
+   * made requests to the same endpoint, as it may hold an open connection to
+   * it. The default implementation ignores @p url.
+   */
+  virtual CurlPtr CreateHandle(std::string const& url) {
+    (void)url;
+    return CreateHandle();
+  }
+
+  /// Create a multi handle to make requests to @p url.
+  virtual CurlMulti CreateMultiHandle(std::string const& url) {
+    (void)url;
+    return CreateMultiHandle();
+  }
+
+  /// Release a multi handle used to make requests to @p url.
+  virtual void CleanupMultiHandle(CurlMulti&& m, std::string const& url) {
+    (void)url;
+    CleanupMultiHandle(std::move(m));
+  }
+
+  /**
+   * Open up to @p count connections to @p url ahead of any requests.
+   *
+   * This is a best-effort operation, errors are ignored. The default
+   * implementation does nothing, as the factory does not keep the handles.
+   */
+  virtual void Prewarm(std::string const& url, std::size_t count) {
+    (void)url;
+    (void)count;
+  }
+
   virtual std::string LastClientIpAddress() const = 0;
 
+  /// The counters for the requests made with the handles from this factory.
+  CurlRequestStats& stats() { return stats_; }
+  CurlRequestStats const& stats() const { return stats_; }
+
  protected:
   // Only virtual for testing purposes.
   virtual void SetCurlStringOption(CURL* handle, CURLoption option_tag,
@@ -51,6 +94,9 @@ class CurlHandleFactory {
   static CURL* GetHandle(CurlHandle& h) { return h.handle_.get(); }
   static void ResetHandle(CurlHandle& h) { h.handle_.reset(); }
   static void ReleaseHandle(CurlHandle& h) { (void)h.handle_.release(); }
+
+ private:
+  CurlRequestStats stats_;
 };
 
 std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory(
@@ -67,7 +113,15 @@ std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory();
 class DefaultCurlHandleFactory : public CurlHandleFactory {
  public:
   DefaultCurlHandleFactory() = default;
-  explicit DefaultCurlHandleFactory(Options const& o);
+  explicit DefaultCurlHandleFactory(Options const& o)
+      : DefaultCurlHandleFactory(o, nullptr) {}
+  /// Create handles that share the caches in @p share, if not null.
+  DefaultCurlHandleFactory(Options const& o,
+                           std::shared_ptr<CurlShareHandle> share);
+
+  using CurlHandleFactory::CleanupMultiHandle;
+  using CurlHandleFactory::CreateHandle;
+  using CurlHandleFactory::CreateMultiHandle;
 
   CurlPtr CreateHandle() override;
   void CleanupHandle(CurlHandle&&) override;
@@ -87,6 +141,7 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
   std::string last_client_ip_address_;
   absl::optional<std::string> cainfo_;
   absl::optional<std::string> capath_;
+  std::shared_ptr<CurlShareHandle> share_;
 };
 
 /**
@@ -94,19 +149,35 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
  *
  * This implementation keeps up to N handles in memory, they are only released
  * when the factory is destructed.
+ *
+ * Each handle is tagged with the endpoint (the scheme and authority of the
+ * URL) it last made requests to, and `CreateHandle(url)` prefers handles for
+ * the same endpoint, as they may hold open connections and cached TLS sessions
+ * for that endpoint. To reduce lock contention the pool is split into shards,
+ * each thread uses the shard selected by its id, but may take matching handles
+ * from other shards.
  */
 class PooledCurlHandleFactory : public CurlHandleFactory {
  public:
-  PooledCurlHandleFactory(std::size_t maximum_size, Options const& o);
+  PooledCurlHandleFactory(std::size_t maximum_size, Options const& o)
+      : PooledCurlHandleFactory(maximum_size, o, nullptr) {}
+  /// Create handles that share the caches in @p share, if not null.
+  PooledCurlHandleFactory(std::size_t maximum_size, Options const& o,
+                          std::shared_ptr<CurlShareHandle> share);
   explicit PooledCurlHandleFactory(std::size_t maximum_size)
       : PooledCurlHandleFactory(maximum_size, {}) {}
   ~PooledCurlHandleFactory() override;
 
   CurlPtr CreateHandle() override;
+  CurlPtr CreateHandle(std::string const& url) override;
   void CleanupHandle(CurlHandle&&) override;
 
   CurlMulti CreateMultiHandle() override;
+  CurlMulti CreateMultiHandle(std::string const& url) override;
   void CleanupMultiHandle(CurlMulti&&) override;
+  void CleanupMultiHandle(CurlMulti&& m, std::string const& url) override;
+
+  void Prewarm(std::string const& url, std::size_t count) override;
 
   std::string LastClientIpAddress() const override {
     std::lock_guard<std::mutex> lk(mu_);
@@ -114,28 +185,42 @@ class PooledCurlHandleFactory : public CurlHandleFactory {
   }
 
   // Test only
-  std::size_t CurrentHandleCount() const {
-    std::lock_guard<std::mutex> lk(mu_);
-    return handles_.size();
-  }
+  std::size_t CurrentHandleCount() const;
   // Test only
-  std::size_t CurrentMultiHandleCount() const {
-    std::lock_guard<std::mutex> lk(mu_);
-    return multi_handles_.size();
-  }
+  std::size_t CurrentMultiHandleCount() const;
+  // Test only
+  std::size_t ShardCount() const { return shards_.size(); }
 
  private:
+  template <typename T>
+  using Pool = std::deque<std::pair<std::string, T*>>;
+
+  struct Shard {
+    std::mutex mu;
+    Pool<CURL> handles;
+    Pool<CURLM> multi_handles;
+  };
+
+  std::size_t CurrentShard() const;
+  CURL* AcquireHandle(std::string const& endpoint);
+  void ReturnHandle(std::size_t shard, std::string endpoint, CURL* handle);
+  CURLM* AcquireMultiHandle(std::string const& endpoint);
   void SetCurlOptions(CURL* handle);
 
   std::size_t maximum_size_;
+  std::size_t shard_size_;
+  std::vector<std::unique_ptr<Shard>> shards_;
   mutable std::mutex mu_;
-  std::deque<CURL*> handles_;
-  std::deque<CURLM*> multi_handles_;
   std::string last_client_ip_address_;
   absl::optional<std::string> cainfo_;
   absl::optional<std::string> capath_;
+  std::string http_version_;
+  std::shared_ptr<CurlShareHandle> share_;
 };
 
+/// Returns the scheme and authority of @p url, used as the pool key.
+std::string CurlPoolEndpoint(std::string const& url);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/options.h"
 #include <gmock/gmock.h>
 #include <map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -108,6 +110,86 @@ TEST(CurlHandleFactoryTest, PooledFactoryChannelOptionsCallsSetOptions) {
   EXPECT_THAT(object_under_test.set_options_, testing::ElementsAre(expected));
 }
 
+TEST(CurlHandleFactoryTest, CurlPoolEndpoint) {
+  EXPECT_EQ("https://storage.googleapis.com",
+            CurlPoolEndpoint("https://storage.googleapis.com/storage/v1/b"));
+  EXPECT_EQ("https://storage.googleapis.com",
+            CurlPoolEndpoint("HTTPS://Storage.GoogleAPIs.com?alt=json"));
+  EXPECT_EQ("http://localhost:8080",
+            CurlPoolEndpoint("http://localhost:8080/upload#fragment"));
+  EXPECT_EQ("localhost:8080", CurlPoolEndpoint("localhost:8080/b"));
+  EXPECT_EQ("", CurlPoolEndpoint(""));
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryShardCount) {
+  auto const options =
+      Options{}.set<storage_experimental::ConnectionPoolShardsOption>(3);
+  EXPECT_EQ(3, PooledCurlHandleFactory(8, options).ShardCount());
+
+  PooledCurlHandleFactory defaulted(2);
+  EXPECT_LE(1, defaulted.ShardCount());
+  EXPECT_GE(2, defaulted.ShardCount());
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryMultiHandlesByEndpoint) {
+  auto const options =
+      Options{}.set<storage_experimental::ConnectionPoolShardsOption>(1);
+  PooledCurlHandleFactory object_under_test(4, options);
+
+  auto m = object_under_test.CreateMultiHandle("https://a.example.com/x");
+  auto* const expected = m.get();
+  object_under_test.CleanupMultiHandle(std::move(m), "https://a.example.com/y");
+  EXPECT_EQ(1, object_under_test.CurrentMultiHandleCount());
+
+  // A request for a different endpoint does not reuse the handle.
+  auto other = object_under_test.CreateMultiHandle("https://b.example.com/x");
+  EXPECT_NE(expected, other.get());
+  EXPECT_EQ(1, object_under_test.CurrentMultiHandleCount());
+
+  auto same = object_under_test.CreateMultiHandle("https://a.example.com/z");
+  EXPECT_EQ(expected, same.get());
+  EXPECT_EQ(0, object_under_test.CurrentMultiHandleCount());
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryMultiHandlesEvictOldest) {
+  auto const options =
+      Options{}.set<storage_experimental::ConnectionPoolShardsOption>(1);
+  PooledCurlHandleFactory object_under_test(2, options);
+
+  std::vector<CURLM*> released;
+  for (auto const* url : {"https://a.example.com", "https://b.example.com",
+                          "https://c.example.com"}) {
+    auto m = object_under_test.CreateMultiHandle(url);
+    released.push_back(m.get());
+    object_under_test.CleanupMultiHandle(std::move(m), url);
+  }
+  EXPECT_EQ(2, object_under_test.CurrentMultiHandleCount());
+
+  // The handle for "a" was evicted, the handle for "c" is still there.
+  auto a = object_under_test.CreateMultiHandle("https://a.example.com");
+  EXPECT_EQ(2, object_under_test.CurrentMultiHandleCount());
+  auto c = object_under_test.CreateMultiHandle("https://c.example.com");
+  EXPECT_EQ(released[2], c.get());
+  EXPECT_EQ(1, object_under_test.CurrentMultiHandleCount());
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryPrewarm) {
+  CurlInitializeOnce(Options{});
+  auto const options =
+      Options{}.set<storage_experimental::ConnectionPoolShardsOption>(2);
+  PooledCurlHandleFactory object_under_test(4, options);
+
+  // Nothing listens on this port, the prewarming fails, but the handles are
+  // still kept in the pool.
+  object_under_test.Prewarm("http://localhost:1/storage/v1", 8);
+  EXPECT_EQ(4, object_under_test.CurrentHandleCount());
+
+  auto other = object_under_test.CreateHandle("http://localhost:2/");
+  EXPECT_EQ(4, object_under_test.CurrentHandleCount());
+  auto same = object_under_test.CreateHandle("http://localhost:1/b");
+  EXPECT_EQ(3, object_under_test.CurrentHandleCount());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
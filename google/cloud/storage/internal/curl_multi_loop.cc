@@ -0,0 +1,210 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_multi_loop.h"
+#include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/log.h"
+#include <curl/multi.h>
+#include <chrono>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+namespace {
+Status AsStatus(CURLMcode result, char const* where) {
+  if (result == CURLM_OK) return Status();
+  std::ostringstream os;
+  os << where << "(): unexpected error code in curl_multi_*, [" << result
+     << "]=" << curl_multi_strerror(result);
+  return Status(StatusCode::kUnknown, std::move(os).str());
+}
+}  // namespace
+
+CurlMultiLoop::CurlMultiLoop()
+    : multi_(curl_multi_init(), &curl_multi_cleanup),
+      thread_([this] { Run(); }) {}
+
+CurlMultiLoop::~CurlMultiLoop() {
+  {
+    auto lk = Lock();
+    shutdown_ = true;
+  }
+  loop_cv_.notify_one();
+  Wakeup();
+  thread_.join();
+}
+
+void CurlMultiLoop::AddHandle(std::unique_lock<std::mutex>& lk, CURL* handle,
+                              OnTransferDone on_done) {
+  (void)Submit(lk, Command{Operation::kAdd, handle, std::move(on_done)});
+}
+
+void CurlMultiLoop::RemoveHandle(std::unique_lock<std::mutex>& lk,
+                                 CURL* handle) {
+  auto const id = Submit(lk, Command{Operation::kRemove, handle, {}});
+  cv_.wait(lk, [this, id] { return applied_ >= id; });
+}
+
+void CurlMultiLoop::Unpause(std::unique_lock<std::mutex>& lk, CURL* handle) {
+  (void)Submit(lk, Command{Operation::kUnpause, handle, {}});
+}
+
+void CurlMultiLoop::Wait(std::unique_lock<std::mutex>& lk,
+                         absl::FunctionRef<bool()> predicate) {
+  cv_.wait(lk, predicate);
+}
+
+std::uint64_t CurlMultiLoop::Submit(std::unique_lock<std::mutex>&,
+                                    Command command) {
+  commands_.push_back(std::move(command));
+  loop_cv_.notify_one();
+  Wakeup();
+  return ++submitted_;
+}
+
+void CurlMultiLoop::Run() {
+  auto lk = Lock();
+  while (!shutdown_) {
+    ApplyCommands();
+    if (transfers_.empty()) {
+      loop_cv_.wait(lk, [this] { return shutdown_ || !commands_.empty(); });
+      continue;
+    }
+    PerformWork();
+    // The callbacks run by PerformWork() may have satisfied some predicates.
+    cv_.notify_all();
+    WaitForHandles(lk);
+  }
+  // Any transfers added after the last iteration are cancelled too.
+  ApplyCommands();
+  CompleteAll(Status(StatusCode::kCancelled, "the CurlMultiLoop was deleted"));
+}
+
+void CurlMultiLoop::ApplyCommands() {
+  if (commands_.empty()) return;
+  auto commands = std::move(commands_);
+  commands_.clear();
+  for (auto& c : commands) {
+    switch (c.operation) {
+      case Operation::kAdd: {
+        auto status =
+            AsStatus(curl_multi_add_handle(multi_.get(), c.handle), __func__);
+        if (!status.ok()) {
+          c.on_done(std::move(status));
+          break;
+        }
+        transfers_.emplace(c.handle, std::move(c.on_done));
+        break;
+      }
+      case Operation::kRemove:
+        if (transfers_.erase(c.handle) != 0) {
+          (void)curl_multi_remove_handle(multi_.get(), c.handle);
+        }
+        break;
+      case Operation::kUnpause:
+        // The handle may have completed (or be removed) since the command was
+        // submitted.
+        if (transfers_.count(c.handle) != 0) {
+          (void)curl_easy_pause(c.handle, CURLPAUSE_RECV_CONT);
+        }
+        break;
+    }
+  }
+  applied_ += commands.size();
+  cv_.notify_all();
+}
+
+void CurlMultiLoop::PerformWork() {
+  int running_handles = 0;
+  CURLMcode result;
+  do {
+    result = curl_multi_perform(multi_.get(), &running_handles);
+  } while (result == CURLM_CALL_MULTI_PERFORM);
+  auto status = AsStatus(result, __func__);
+  if (!status.ok()) {
+    // This indicates that we are using the API incorrectly, there is no way
+    // to recover the transfers in this case.
+    GCP_LOG(WARNING) << "CurlMultiLoop: " << status;
+    CompleteAll(status);
+    return;
+  }
+  int remaining;
+  while (auto* msg = curl_multi_info_read(multi_.get(), &remaining)) {
+    if (msg->msg != CURLMSG_DONE) continue;
+    // `msg` is invalidated by curl_multi_remove_handle(), copy the values.
+    auto* handle = msg->easy_handle;
+    auto const code = msg->data.result;
+    auto i = transfers_.find(handle);
+    if (i == transfers_.end()) continue;
+    auto on_done = std::move(i->second);
+    transfers_.erase(i);
+    (void)curl_multi_remove_handle(multi_.get(), handle);
+    on_done(CurlHandle::AsStatus(code, __func__));
+  }
+}
+
+void CurlMultiLoop::CompleteAll(Status const& status) {
+  auto transfers = std::move(transfers_);
+  transfers_.clear();
+  for (auto& kv : transfers) {
+    (void)curl_multi_remove_handle(multi_.get(), kv.first);
+    kv.second(status);
+  }
+  cv_.notify_all();
+}
+
+void CurlMultiLoop::WaitForHandles(std::unique_lock<std::mutex>& lk) {
+  if (!commands_.empty() || shutdown_) return;
+  // No other thread uses multi_ while the lock is released: the commands are
+  // queued and applied by this thread.
+  lk.unlock();
+  int numfds = 0;
+#if LIBCURL_VERSION_NUM >= 0x074400
+  // Use a long timeout, Wakeup() interrupts the call when new commands arrive,
+  // and libcurl shortens the timeout to satisfy any internal timers.
+  auto constexpr kTimeoutMs = 1000;
+  auto result = curl_multi_poll(multi_.get(), nullptr, 0, kTimeoutMs, &numfds);
+#else
+  // Without curl_multi_wakeup() the loop must check for new commands often.
+  auto constexpr kTimeoutMs = 1;
+  auto result = curl_multi_wait(multi_.get(), nullptr, 0, kTimeoutMs, &numfds);
+#endif  // LIBCURL_VERSION_NUM >= 0x074400
+  auto status = AsStatus(result, __func__);
+  if (!status.ok()) GCP_LOG(WARNING) << "CurlMultiLoop: " << status;
+  // The documentation for curl_multi_wait() recommends sleeping if it returns
+  // numfds == 0 more than once in a row :shrug:
+  //    https://curl.haxx.se/libcurl/c/curl_multi_wait.html
+  if (numfds == 0 && ++repeats_ > 1) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  } else if (numfds != 0) {
+    repeats_ = 0;
+  }
+  lk.lock();
+}
+
+void CurlMultiLoop::Wakeup() {
+#if LIBCURL_VERSION_NUM >= 0x074400
+  (void)curl_multi_wakeup(multi_.get());
+#endif  // LIBCURL_VERSION_NUM >= 0x074400
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
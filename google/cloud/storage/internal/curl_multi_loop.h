@@ -0,0 +1,124 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_LOOP_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_LOOP_H
+
+#include "google/cloud/storage/internal/curl_wrappers.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "absl/functional/function_ref.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Runs many libcurl transfers on a single, shared, `CURLM*` handle.
+ *
+ * A background thread owns the `CURLM*` handle and performs all the I/O for
+ * the easy handles added to it. Because all the transfers share the same
+ * multi handle they also share its connection cache, and HTTP/2 transfers to
+ * the same host can be multiplexed over a single connection.
+ *
+ * libcurl invokes the callbacks for all the transfers from the background
+ * thread, while holding the mutex returned by `Lock()`. Any state shared
+ * with those callbacks must only be accessed while holding that mutex. All the
+ * member functions that take a lock require it to be held on entry.
+ */
+class CurlMultiLoop {
+ public:
+  /// Called, with the mutex held, when a transfer completes or fails.
+  using OnTransferDone = std::function<void(Status)>;
+
+  CurlMultiLoop();
+  ~CurlMultiLoop();
+
+  CurlMultiLoop(CurlMultiLoop const&) = delete;
+  CurlMultiLoop& operator=(CurlMultiLoop const&) = delete;
+  CurlMultiLoop(CurlMultiLoop&&) = delete;
+  CurlMultiLoop& operator=(CurlMultiLoop&&) = delete;
+
+  std::unique_lock<std::mutex> Lock() {
+    return std::unique_lock<std::mutex>(mu_);
+  }
+
+  /**
+   * Start the transfer for @p handle.
+   *
+   * The handle is removed from the loop before @p on_done is called.
+   */
+  void AddHandle(std::unique_lock<std::mutex>& lk, CURL* handle,
+                 OnTransferDone on_done);
+
+  /**
+   * Stop the transfer for @p handle.
+   *
+   * Blocks until the background thread stops using @p handle, after this
+   * function returns there are no more callbacks for the transfer.
+   */
+  void RemoveHandle(std::unique_lock<std::mutex>& lk, CURL* handle);
+
+  /// Resume a transfer paused by its write callback.
+  void Unpause(std::unique_lock<std::mutex>& lk, CURL* handle);
+
+  /// Block until @p predicate, evaluated with the mutex held, is satisfied.
+  void Wait(std::unique_lock<std::mutex>& lk,
+            absl::FunctionRef<bool()> predicate);
+
+ private:
+  enum class Operation { kAdd, kRemove, kUnpause };
+  struct Command {
+    Operation operation;
+    CURL* handle;
+    OnTransferDone on_done;
+  };
+
+  std::uint64_t Submit(std::unique_lock<std::mutex>& lk, Command command);
+  void Run();
+  void ApplyCommands();
+  void PerformWork();
+  void CompleteAll(Status const& status);
+  void WaitForHandles(std::unique_lock<std::mutex>& lk);
+  void Wakeup();
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::condition_variable loop_cv_;
+  CurlMulti multi_;
+  std::vector<Command> commands_;
+  std::uint64_t submitted_ = 0;
+  std::uint64_t applied_ = 0;
+  std::unordered_map<CURL*, OnTransferDone> transfers_;
+  int repeats_ = 0;
+  bool shutdown_ = false;
+  std::thread thread_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_LOOP_H
@@ -0,0 +1,177 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_multi_loop.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::TempFile;
+using ::google::cloud::testing_util::StatusIs;
+
+/// A single transfer, all the fields are guarded by the loop mutex.
+struct Transfer {
+  CurlPtr handle = CurlPtr(curl_easy_init(), &curl_easy_cleanup);
+  std::string contents;
+  bool done = false;
+  int done_count = 0;
+  Status status;
+};
+
+extern "C" std::size_t CurlMultiLoopTestWrite(char* ptr, std::size_t size,
+                                              std::size_t nmemb,
+                                              void* userdata) {
+  auto* t = reinterpret_cast<Transfer*>(userdata);
+  t->contents.append(ptr, size * nmemb);
+  return size * nmemb;
+}
+
+void Prepare(Transfer& t, std::string const& filename) {
+  auto url = "file://" + filename;
+  curl_easy_setopt(t.handle.get(), CURLOPT_URL, url.c_str());
+  curl_easy_setopt(t.handle.get(), CURLOPT_WRITEFUNCTION,
+                   &CurlMultiLoopTestWrite);
+  curl_easy_setopt(t.handle.get(), CURLOPT_WRITEDATA, &t);
+}
+
+CurlMultiLoop::OnTransferDone OnDone(Transfer& t) {
+  return [&t](Status s) {
+    t.done = true;
+    ++t.done_count;
+    t.status = std::move(s);
+  };
+}
+
+std::string MakeContents(int seed) {
+  std::string line = "line " + std::to_string(seed) + ":";
+  line += std::string(64, static_cast<char>('a' + seed % 26)) + "\n";
+  std::string contents;
+  for (int i = 0; i != 4096; ++i) contents += line;
+  return contents;
+}
+
+TEST(CurlMultiLoopTest, SingleTransfer) {
+  CurlInitializeOnce(Options{});
+  auto const expected = MakeContents(0);
+  TempFile file(expected);
+
+  CurlMultiLoop loop;
+  Transfer t;
+  Prepare(t, file.name());
+  auto lk = loop.Lock();
+  loop.AddHandle(lk, t.handle.get(), OnDone(t));
+  loop.Wait(lk, [&t] { return t.done; });
+  EXPECT_STATUS_OK(t.status);
+  EXPECT_EQ(1, t.done_count);
+  EXPECT_EQ(expected, t.contents);
+}
+
+TEST(CurlMultiLoopTest, ManyTransfers) {
+  CurlInitializeOnce(Options{});
+  int const count = 16;
+  std::vector<std::unique_ptr<TempFile>> files;
+  std::vector<std::unique_ptr<Transfer>> transfers;
+  for (int i = 0; i != count; ++i) {
+    files.emplace_back(new TempFile(MakeContents(i)));
+    transfers.emplace_back(new Transfer);
+    Prepare(*transfers.back(), files.back()->name());
+  }
+
+  CurlMultiLoop loop;
+  auto lk = loop.Lock();
+  for (auto& t : transfers) loop.AddHandle(lk, t->handle.get(), OnDone(*t));
+  loop.Wait(lk, [&transfers] {
+    for (auto const& t : transfers) {
+      if (!t->done) return false;
+    }
+    return true;
+  });
+  for (int i = 0; i != count; ++i) {
+    SCOPED_TRACE("Testing with transfer " + std::to_string(i));
+    EXPECT_STATUS_OK(transfers[i]->status);
+    EXPECT_EQ(MakeContents(i), transfers[i]->contents);
+  }
+}
+
+TEST(CurlMultiLoopTest, RemoveBeforeStart) {
+  CurlInitializeOnce(Options{});
+  TempFile file(MakeContents(1));
+
+  CurlMultiLoop loop;
+  Transfer t;
+  Prepare(t, file.name());
+  auto lk = loop.Lock();
+  // Both commands are queued before the background thread can run, so the
+  // transfer is removed before it makes any progress.
+  loop.AddHandle(lk, t.handle.get(), OnDone(t));
+  loop.RemoveHandle(lk, t.handle.get());
+  EXPECT_FALSE(t.done);
+  EXPECT_EQ(0, t.done_count);
+  EXPECT_TRUE(t.contents.empty());
+}
+
+TEST(CurlMultiLoopTest, RemoveAfterDone) {
+  CurlInitializeOnce(Options{});
+  auto const expected = MakeContents(2);
+  TempFile file(expected);
+
+  CurlMultiLoop loop;
+  Transfer t;
+  Prepare(t, file.name());
+  auto lk = loop.Lock();
+  loop.AddHandle(lk, t.handle.get(), OnDone(t));
+  loop.Wait(lk, [&t] { return t.done; });
+  loop.RemoveHandle(lk, t.handle.get());
+  loop.Unpause(lk, t.handle.get());
+  EXPECT_STATUS_OK(t.status);
+  EXPECT_EQ(1, t.done_count);
+  EXPECT_EQ(expected, t.contents);
+}
+
+TEST(CurlMultiLoopTest, DestructorCompletesTransfers) {
+  CurlInitializeOnce(Options{});
+  TempFile file(MakeContents(3));
+
+  Transfer t;
+  {
+    CurlMultiLoop loop;
+    Prepare(t, file.name());
+    auto lk = loop.Lock();
+    loop.AddHandle(lk, t.handle.get(), OnDone(t));
+  }
+  // The transfer may complete before the loop is deleted, but the callback is
+  // called exactly once in either case.
+  EXPECT_TRUE(t.done);
+  EXPECT_EQ(1, t.done_count);
+  if (!t.status.ok()) {
+    EXPECT_THAT(t.status, StatusIs(StatusCode::kCancelled));
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
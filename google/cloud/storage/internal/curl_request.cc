@@ -112,6 +112,7 @@ StatusOr<HttpResponse> CurlRequest::MakeRequestImpl() {
   handle_.SetOption(CURLOPT_HEADERDATA, this);
   auto status = handle_.EasyPerform();
   if (!status.ok()) return status;
+  if (factory_) factory_->stats().OnRequestDone(handle_.GetNumConnects());
 
   if (logging_enabled_) handle_.FlushDebug(__func__);
   auto code = handle_.GetResponseCode();
@@ -29,22 +29,74 @@ namespace internal {
 #define GOOGLE_CLOUD_CPP_STORAGE_INITIAL_BUFFER_SIZE (128 * 1024)
 #endif  // GOOGLE_CLOUD_CPP_STORAGE_INITIAL_BUFFER_SIZE
 
+namespace {
+
+// Most query strings fit in this many bytes, reserve them in the URL once.
+auto constexpr kInitialQueryStringSize = 256;
+
+std::string const& CachedUserAgentSuffix() {
+  static auto const* const kUserAgentSuffix = new auto([] {
+    std::string agent = google::cloud::internal::UserAgentPrefix() + " ";
+    agent += curl_version();
+    return agent;
+  }());
+  return *kUserAgentSuffix;
+}
+
+}  // namespace
+
+CurlRequestBuilderConfig::CurlRequestBuilderConfig(Options const& options)
+    : logging_enabled(google::cloud::internal::Contains(
+          options.get<TracingComponentsOption>(), "http")),
+      http_version(options.get<storage_experimental::HttpVersionOption>()),
+      download_stall_timeout(options.get<DownloadStallTimeoutOption>()),
+      buffer_pool(options.get<storage_experimental::IoBufferPoolOption>()) {
+  socket_options.recv_buffer_size_ =
+      options.get<MaximumCurlSocketRecvSizeOption>();
+  socket_options.send_buffer_size_ =
+      options.get<MaximumCurlSocketSendSizeOption>();
+  auto agents = options.get<UserAgentProductsOption>();
+  agents.emplace_back(CachedUserAgentSuffix());
+  user_agent = absl::StrJoin(agents, " ");
+}
+
+void AppendUrlEscaped(std::string& out, absl::string_view s) {
+  static char const kHex[] = "0123456789ABCDEF";
+  for (auto const c : s) {
+    auto const u = static_cast<unsigned char>(c);
+    if ((u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') ||
+        (u >= '0' && u <= '9') || u == '-' || u == '.' || u == '_' ||
+        u == '~') {
+      out.push_back(c);
+      continue;
+    }
+    out.push_back('%');
+    out.push_back(kHex[u >> 4]);
+    out.push_back(kHex[u & 0xF]);
+  }
+}
+
 CurlRequestBuilder::CurlRequestBuilder(
     std::string base_url, std::shared_ptr<CurlHandleFactory> factory)
-    : factory_(std::move(factory)),
-      handle_(factory_->CreateHandle()),
+    : start_(std::chrono::steady_clock::now()),
+      factory_(std::move(factory)),
+      handle_(factory_->CreateHandle(base_url)),
       headers_(nullptr, &curl_slist_free_all),
       url_(std::move(base_url)),
       query_parameter_separator_("?"),
       logging_enabled_(false),
-      download_stall_timeout_(0) {}
+      download_stall_timeout_(0) {
+  url_.reserve(url_.size() + kInitialQueryStringSize);
+}
 
 CurlRequest CurlRequestBuilder::BuildRequest() {
   ValidateBuilderState(__func__);
+  RecordBuildTime();
   CurlRequest request;
   request.url_ = std::move(url_);
   request.headers_ = std::move(headers_);
-  request.user_agent_ = user_agent_prefix_ + UserAgentSuffix();
+  request.user_agent_ =
+      user_agent_.empty() ? UserAgentSuffix() : std::move(user_agent_);
   request.http_version_ = std::move(http_version_);
   request.handle_ = std::move(handle_);
   request.factory_ = std::move(factory_);
@@ -56,9 +108,14 @@ CurlRequest CurlRequestBuilder::BuildRequest() {
 std::unique_ptr<CurlDownloadRequest>
 CurlRequestBuilder::BuildDownloadRequest() && {
   ValidateBuilderState(__func__);
-  auto agent = user_agent_prefix_ + UserAgentSuffix();
+  RecordBuildTime();
+  auto agent =
+      user_agent_.empty() ? UserAgentSuffix() : std::move(user_agent_);
+  // With a shared loop the request does not need its own CURLM* handle.
+  auto multi = loop_ ? CurlMulti(nullptr, &curl_multi_cleanup)
+                     : factory_->CreateMultiHandle(url_);
   auto request = absl::make_unique<CurlDownloadRequest>(
-      std::move(headers_), std::move(handle_), factory_->CreateMultiHandle());
+      std::move(headers_), std::move(handle_), std::move(multi), buffer_pool_);
   request->url_ = std::move(url_);
   request->user_agent_ = std::move(agent);
   request->http_version_ = std::move(http_version_);
@@ -66,25 +123,25 @@ CurlRequestBuilder::BuildDownloadRequest() && {
   request->logging_enabled_ = logging_enabled_;
   request->socket_options_ = socket_options_;
   request->download_stall_timeout_ = download_stall_timeout_;
+  request->loop_ = std::move(loop_);
   request->SetOptions();
   return request;
 }
 
 CurlRequestBuilder& CurlRequestBuilder::ApplyClientOptions(
     Options const& options) {
+  return ApplyClientConfig(CurlRequestBuilderConfig(options));
+}
+
+CurlRequestBuilder& CurlRequestBuilder::ApplyClientConfig(
+    CurlRequestBuilderConfig const& config) {
   ValidateBuilderState(__func__);
-  logging_enabled_ = google::cloud::internal::Contains(
-      options.get<TracingComponentsOption>(), "http");
-  socket_options_.recv_buffer_size_ =
-      options.get<MaximumCurlSocketRecvSizeOption>();
-  socket_options_.send_buffer_size_ =
-      options.get<MaximumCurlSocketSendSizeOption>();
-  auto agents = options.get<UserAgentProductsOption>();
-  agents.push_back(user_agent_prefix_);
-  user_agent_prefix_ = absl::StrJoin(agents, " ");
-  http_version_ =
-      std::move(options.get<storage_experimental::HttpVersionOption>());
-  download_stall_timeout_ = options.get<DownloadStallTimeoutOption>();
+  logging_enabled_ = config.logging_enabled;
+  socket_options_ = config.socket_options;
+  user_agent_ = config.user_agent;
+  http_version_ = config.http_version;
+  download_stall_timeout_ = config.download_stall_timeout;
+  buffer_pool_ = config.buffer_pool;
   return *this;
 }
 
@@ -96,15 +153,22 @@ CurlRequestBuilder& CurlRequestBuilder::AddHeader(std::string const& header) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::AddHeader(absl::string_view name,
+                                                  absl::string_view value) {
+  header_buffer_.assign(name.data(), name.size());
+  header_buffer_ += ": ";
+  header_buffer_.append(value.data(), value.size());
+  return AddHeader(header_buffer_);
+}
+
 CurlRequestBuilder& CurlRequestBuilder::AddQueryParameter(
     std::string const& key, std::string const& value) {
   ValidateBuilderState(__func__);
-  std::string parameter = query_parameter_separator_;
-  parameter += handle_.MakeEscapedString(key).get();
-  parameter += "=";
-  parameter += handle_.MakeEscapedString(value).get();
+  url_ += query_parameter_separator_;
+  AppendUrlEscaped(url_, key);
+  url_ += '=';
+  AppendUrlEscaped(url_, value);
   query_parameter_separator_ = "&";
-  url_.append(parameter);
   return *this;
 }
 
@@ -119,15 +183,15 @@ CurlRequestBuilder& CurlRequestBuilder::SetCurlShare(CURLSH* share) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetCurlMultiLoop(
+    std::shared_ptr<CurlMultiLoop> loop) {
+  loop_ = std::move(loop);
+  return *this;
+}
+
 std::string CurlRequestBuilder::UserAgentSuffix() const {
   ValidateBuilderState(__func__);
-  // Pre-compute and cache the user agent string:
-  static auto const* const kUserAgentSuffix = new auto([] {
-    std::string agent = google::cloud::internal::UserAgentPrefix() + " ";
-    agent += curl_version();
-    return agent;
-  }());
-  return *kUserAgentSuffix;
+  return CachedUserAgentSuffix();
 }
 
 void CurlRequestBuilder::ValidateBuilderState(char const* where) const {
@@ -137,6 +201,13 @@ void CurlRequestBuilder::ValidateBuilderState(char const* where) const {
     google::cloud::internal::ThrowRuntimeError(msg);
   }
 }
+
+void CurlRequestBuilder::RecordBuildTime() {
+  factory_->stats().OnRequestBuilt(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_));
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
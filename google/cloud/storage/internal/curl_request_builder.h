@@ -21,7 +21,9 @@
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_headers.h"
+#include "absl/strings/string_view.h"
 #include <chrono>
+#include <memory>
 #include <string>
 
 namespace google {
@@ -29,6 +31,33 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+
+/**
+ * The client configuration used by `CurlRequestBuilder`.
+ *
+ * Computing these values requires several lookups in `Options` and some string
+ * concatenation. Clients compute the configuration once, and apply it to each
+ * request.
+ */
+struct CurlRequestBuilderConfig {
+  explicit CurlRequestBuilderConfig(Options const& options);
+
+  bool logging_enabled;
+  CurlHandle::SocketOptions socket_options;
+  std::string user_agent;
+  std::string http_version;
+  std::chrono::seconds download_stall_timeout;
+  std::shared_ptr<IoBufferPool> buffer_pool;
+};
+
+/**
+ * Appends @p s to @p out, URL-escaped.
+ *
+ * This produces the same output as `curl_easy_escape()`, without allocating a
+ * new string for each call.
+ */
+void AppendUrlEscaped(std::string& out, absl::string_view s);
+
 /**
  * Implements the Builder pattern for CurlRequest, and CurlUploadRequest.
  */
@@ -86,12 +115,7 @@ class CurlRequestBuilder {
   /// Adds one of the well-known headers to the request.
   template <typename P>
   CurlRequestBuilder& AddOption(WellKnownHeader<P, std::string> const& p) {
-    if (p.has_value()) {
-      std::string header = p.header_name();
-      header += ": ";
-      header += p.value();
-      AddHeader(header);
-    }
+    if (p.has_value()) AddHeader(p.header_name(), p.value());
     return *this;
   }
 
@@ -100,20 +124,13 @@ class CurlRequestBuilder {
             typename Enabled = typename std::enable_if<
                 std::is_arithmetic<V>::value, void>::type>
   CurlRequestBuilder& AddOption(WellKnownHeader<P, V> const& p) {
-    if (p.has_value()) {
-      std::string header = p.header_name();
-      header += ": ";
-      header += std::to_string(p.value());
-      AddHeader(header);
-    }
+    if (p.has_value()) AddHeader(p.header_name(), std::to_string(p.value()));
     return *this;
   }
 
   /// Adds a custom header to the request.
   CurlRequestBuilder& AddOption(CustomHeader const& p) {
-    if (p.has_value()) {
-      AddHeader(p.custom_header_name() + ": " + p.value());
-    }
+    if (p.has_value()) AddHeader(p.custom_header_name(), p.value());
     return *this;
   }
 
@@ -155,6 +172,10 @@ class CurlRequestBuilder {
   /// Adds request headers.
   CurlRequestBuilder& AddHeader(std::string const& header);
 
+  /// Adds the @p name header with @p value.
+  CurlRequestBuilder& AddHeader(absl::string_view name,
+                                absl::string_view value);
+
   /// Adds a parameter for a request.
   CurlRequestBuilder& AddQueryParameter(std::string const& key,
                                         std::string const& value);
@@ -165,9 +186,15 @@ class CurlRequestBuilder {
   /// Copy interesting configuration parameters from the client options.
   CurlRequestBuilder& ApplyClientOptions(Options const& options);
 
+  /// Copy a configuration precomputed from the client options.
+  CurlRequestBuilder& ApplyClientConfig(CurlRequestBuilderConfig const& config);
+
   /// Sets the CURLSH* handle to share resources.
   CurlRequestBuilder& SetCurlShare(CURLSH* share);
 
+  /// Runs download requests on a shared `CurlMultiLoop`.
+  CurlRequestBuilder& SetCurlMultiLoop(std::shared_ptr<CurlMultiLoop> loop);
+
   /// Gets the user-agent suffix.
   std::string UserAgentSuffix() const;
 
@@ -183,7 +210,10 @@ class CurlRequestBuilder {
 
  private:
   void ValidateBuilderState(char const* where) const;
+  void RecordBuildTime();
 
+  // Initialized first, so the build time includes creating the handle.
+  std::chrono::steady_clock::time_point start_;
   std::shared_ptr<CurlHandleFactory> factory_;
 
   CurlHandle handle_;
@@ -191,12 +221,18 @@ class CurlRequestBuilder {
 
   std::string url_;
   char const* query_parameter_separator_;
+  // Reused to format each header, `curl_slist_append()` copies it.
+  std::string header_buffer_;
 
-  std::string user_agent_prefix_;
+  // Empty until the client options are applied, the default is
+  // `UserAgentSuffix()`.
+  std::string user_agent_;
   bool logging_enabled_;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
   std::string http_version_;
+  std::shared_ptr<CurlMultiLoop> loop_;
+  std::shared_ptr<IoBufferPool> buffer_pool_;
 };
 
 }  // namespace internal
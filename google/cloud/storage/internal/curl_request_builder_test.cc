@@ -0,0 +1,80 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include "google/cloud/storage/options.h"
+#include "google/cloud/internal/user_agent_prefix.h"
+#include "google/cloud/common_options.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+TEST(CurlRequestBuilderTest, AppendUrlEscapedMatchesCurl) {
+  std::string all;
+  for (int i = 0; i != 256; ++i) all.push_back(static_cast<char>(i));
+  for (std::string const& s :
+       {std::string{}, std::string{"abc-XYZ_0.9~"}, std::string{"a b/c?d=e&f"},
+        std::string{"caf\xc3\xa9"}, all}) {
+    CurlRequestBuilder builder("http://localhost",
+                               GetDefaultCurlHandleFactory());
+    std::string actual = "prefix:";
+    AppendUrlEscaped(actual, s);
+    EXPECT_EQ("prefix:" + std::string(builder.MakeEscapedString(s).get()),
+              actual);
+  }
+}
+
+TEST(CurlRequestBuilderTest, ConfigFromOptions) {
+  auto const options =
+      Options{}
+          .set<TracingComponentsOption>({"http"})
+          .set<MaximumCurlSocketRecvSizeOption>(1024)
+          .set<MaximumCurlSocketSendSizeOption>(2048)
+          .set<UserAgentProductsOption>({"test-product/1.0"})
+          .set<storage_experimental::HttpVersionOption>("2")
+          .set<DownloadStallTimeoutOption>(std::chrono::seconds(42));
+  CurlRequestBuilderConfig config(options);
+  EXPECT_TRUE(config.logging_enabled);
+  EXPECT_EQ(1024, config.socket_options.recv_buffer_size_);
+  EXPECT_EQ(2048, config.socket_options.send_buffer_size_);
+  EXPECT_THAT(config.user_agent, StartsWith("test-product/1.0 "));
+  EXPECT_THAT(config.user_agent,
+              HasSubstr(google::cloud::internal::UserAgentPrefix()));
+  EXPECT_EQ("2", config.http_version);
+  EXPECT_EQ(std::chrono::seconds(42), config.download_stall_timeout);
+}
+
+TEST(CurlRequestBuilderTest, ConfigDefaultUserAgent) {
+  CurlRequestBuilderConfig config(Options{});
+  EXPECT_FALSE(config.logging_enabled);
+  EXPECT_THAT(config.user_agent,
+              StartsWith(google::cloud::internal::UserAgentPrefix()));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
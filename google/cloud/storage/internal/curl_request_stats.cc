@@ -0,0 +1,59 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/curl_request_stats.h"
+#include <ostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+CurlRequestCounters& CurlRequestCounters::operator+=(
+    CurlRequestCounters const& rhs) {
+  requests += rhs.requests;
+  new_connections += rhs.new_connections;
+  reused_connections += rhs.reused_connections;
+  request_builder_time += rhs.request_builder_time;
+  return *this;
+}
+
+std::ostream& operator<<(std::ostream& os, CurlRequestCounters const& rhs) {
+  return os << "requests=" << rhs.requests
+            << ", new_connections=" << rhs.new_connections
+            << ", reused_connections=" << rhs.reused_connections
+            << ", request_builder_time="
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   rhs.request_builder_time)
+                   .count()
+            << "us";
+}
+
+CurlRequestCounters CurlRequestStats::Counters() const {
+  CurlRequestCounters c;
+  c.requests = requests_.load(std::memory_order_relaxed);
+  c.new_connections = new_connections_.load(std::memory_order_relaxed);
+  c.reused_connections = reused_connections_.load(std::memory_order_relaxed);
+  c.request_builder_time =
+      std::chrono::nanoseconds(builder_time_ns_.load(std::memory_order_relaxed));
+  return c;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
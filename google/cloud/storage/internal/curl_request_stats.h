@@ -0,0 +1,83 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_STATS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_STATS_H
+
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// A snapshot of the `CurlRequestStats` counters.
+struct CurlRequestCounters {
+  /// The number of completed requests.
+  std::int64_t requests = 0;
+  /// The requests that had to open at least one new connection.
+  std::int64_t new_connections = 0;
+  /// The requests that reused a connection from a previous request.
+  std::int64_t reused_connections = 0;
+  /// The total time spent in `CurlRequestBuilder`, including handle creation.
+  std::chrono::nanoseconds request_builder_time{0};
+
+  CurlRequestCounters& operator+=(CurlRequestCounters const& rhs);
+};
+
+std::ostream& operator<<(std::ostream& os, CurlRequestCounters const& rhs);
+
+/**
+ * Counts the requests made with the handles of a `CurlHandleFactory`.
+ *
+ * Small object requests are dominated by per-request overhead, mostly the
+ * cost of opening new connections (TCP and TLS handshakes). These counters
+ * show how often the requests reuse a connection, and how much time is spent
+ * preparing them.
+ */
+class CurlRequestStats {
+ public:
+  /// Records the time spent building a request.
+  void OnRequestBuilt(std::chrono::nanoseconds elapsed) {
+    builder_time_ns_.fetch_add(elapsed.count(), std::memory_order_relaxed);
+  }
+
+  /// Records a completed request, @p num_connects is `CURLINFO_NUM_CONNECTS`.
+  void OnRequestDone(long num_connects) {  // NOLINT(google-runtime-int)
+    requests_.fetch_add(1, std::memory_order_relaxed);
+    auto& counter = num_connects > 0 ? new_connections_ : reused_connections_;
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  CurlRequestCounters Counters() const;
+
+ private:
+  std::atomic<std::int64_t> requests_{0};
+  std::atomic<std::int64_t> new_connections_{0};
+  std::atomic<std::int64_t> reused_connections_{0};
+  std::atomic<std::int64_t> builder_time_ns_{0};
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_STATS_H
@@ -0,0 +1,82 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/curl_request_stats.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(CurlRequestStatsTest, Empty) {
+  CurlRequestStats stats;
+  auto const c = stats.Counters();
+  EXPECT_EQ(0, c.requests);
+  EXPECT_EQ(0, c.new_connections);
+  EXPECT_EQ(0, c.reused_connections);
+  EXPECT_EQ(0, c.request_builder_time.count());
+}
+
+TEST(CurlRequestStatsTest, CountsConnections) {
+  CurlRequestStats stats;
+  stats.OnRequestDone(1);
+  stats.OnRequestDone(0);
+  stats.OnRequestDone(0);
+  stats.OnRequestDone(2);
+  stats.OnRequestBuilt(std::chrono::microseconds(3));
+  stats.OnRequestBuilt(std::chrono::microseconds(4));
+  auto const c = stats.Counters();
+  EXPECT_EQ(4, c.requests);
+  EXPECT_EQ(2, c.new_connections);
+  EXPECT_EQ(2, c.reused_connections);
+  EXPECT_EQ(std::chrono::microseconds(7), c.request_builder_time);
+}
+
+TEST(CurlRequestStatsTest, AddAndPrint) {
+  CurlRequestStats a;
+  a.OnRequestDone(1);
+  a.OnRequestBuilt(std::chrono::microseconds(10));
+  CurlRequestStats b;
+  b.OnRequestDone(0);
+  b.OnRequestBuilt(std::chrono::microseconds(20));
+
+  CurlRequestCounters total;
+  total += a.Counters();
+  total += b.Counters();
+  EXPECT_EQ(2, total.requests);
+  EXPECT_EQ(1, total.new_connections);
+  EXPECT_EQ(1, total.reused_connections);
+  EXPECT_EQ(std::chrono::microseconds(30), total.request_builder_time);
+
+  std::ostringstream os;
+  os << total;
+  EXPECT_THAT(os.str(), HasSubstr("requests=2"));
+  EXPECT_THAT(os.str(), HasSubstr("new_connections=1"));
+  EXPECT_THAT(os.str(), HasSubstr("reused_connections=1"));
+  EXPECT_THAT(os.str(), HasSubstr("request_builder_time=30us"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -183,6 +183,26 @@ void InitializeSigPipeHandler(bool enable_sigpipe_handler) {
 #endif  // SIGPIPE
 }
 
+// The lock callbacks for `CurlShareHandle`, libcurl calls them with the handle
+// as the `userptr` argument.
+extern "C" void CurlShareLockCb(CURL*, curl_lock_data data, curl_lock_access,
+                                void* userptr) {
+  static_cast<CurlShareHandle*>(userptr)->Lock(data);
+}
+
+extern "C" void CurlShareUnlockCb(CURL*, curl_lock_data data, void* userptr) {
+  static_cast<CurlShareHandle*>(userptr)->Unlock(data);
+}
+
+void CurlShareSetOption(CURLSH* share, CURLSHoption option,
+                        long value) {  // NOLINT(google-runtime-int)
+  auto const e = curl_share_setopt(share, option, value);
+  if (e == CURLSHE_OK) return;
+  // This is not fatal, the handles would just not share some cache.
+  GCP_LOG(WARNING) << "curl_share_setopt(" << option << ", " << value
+                   << ") failed: [" << e << "]=" << curl_share_strerror(e);
+}
+
 /// Automatically initialize (and cleanup) the libcurl library.
 class CurlInitializer {
  public:
@@ -255,6 +275,18 @@ std::size_t CurlAppendHeaderData(CurlReceivedHeaders& received_headers,
   return size;
 }
 
+CurlShareHandle::CurlShareHandle()
+    : share_(curl_share_init(), &curl_share_cleanup) {
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_LOCKFUNC, &CurlShareLockCb);
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_UNLOCKFUNC,
+                          &CurlShareUnlockCb);
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_USERDATA, this);
+  CurlShareSetOption(share_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  CurlShareSetOption(share_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  // Do not share CURL_LOCK_DATA_CONNECT: libcurl does not support using a
+  // shared connection cache from multiple threads at the same time.
+}
+
 void CurlInitializeOnce(Options const& options) {
   static CurlInitializer curl_initializer;
   std::call_once(ssl_locking_initialized, InitializeSslLocking,
@@ -20,9 +20,11 @@
 #include "google/cloud/storage/well_known_parameters.h"
 #include "google/cloud/options.h"
 #include <curl/curl.h>
+#include <array>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace google {
@@ -53,6 +55,42 @@ std::size_t CurlAppendHeaderData(CurlReceivedHeaders& received_headers,
 
 using CurlShare = std::unique_ptr<CURLSH, decltype(&curl_share_cleanup)>;
 
+/**
+ * A `CURLSH*` handle to share caches between many `CURL*` handles.
+ *
+ * The handles using this object share their DNS cache and their TLS session
+ * cache. The connection cache is not shared, libcurl does not support sharing
+ * it between handles running in different threads. libcurl requires lock
+ * callbacks to use a share handle from multiple threads, this class owns the
+ * mutexes used by these callbacks.
+ *
+ * The `CURL*` handles using this object must be released (or reset) before
+ * this object is deleted.
+ */
+class CurlShareHandle {
+ public:
+  CurlShareHandle();
+
+  CurlShareHandle(CurlShareHandle const&) = delete;
+  CurlShareHandle& operator=(CurlShareHandle const&) = delete;
+
+  CURLSH* get() const { return share_.get(); }
+
+  /// Used by the libcurl lock callbacks.
+  void Lock(curl_lock_data data) { locks_[Index(data)].lock(); }
+  void Unlock(curl_lock_data data) { locks_[Index(data)].unlock(); }
+
+ private:
+  static std::size_t Index(curl_lock_data data) {
+    auto const i = static_cast<std::size_t>(data);
+    return i < CURL_LOCK_DATA_LAST ? i : 0;
+  }
+
+  // The mutexes must outlive `share_`, as libcurl uses them on cleanup.
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> locks_;
+  CurlShare share_;
+};
+
 /// Returns true if the SSL locking callbacks are installed.
 bool SslLockingCallbacksInstalled();
 
@@ -14,6 +14,8 @@
 
 #include "google/cloud/storage/internal/curl_wrappers.h"
 #include <gmock/gmock.h>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -47,6 +49,29 @@ TEST(CurlWrappers, VersionToCurlCode) {
   }
 }
 
+TEST(CurlWrappers, CurlShareHandleMultipleThreads) {
+  CurlInitializeOnce(Options{});
+  CurlShareHandle share;
+  ASSERT_NE(nullptr, share.get());
+
+  // Nothing listens on this port, the requests fail, but they still use (and
+  // lock) the shared DNS cache.
+  auto constexpr kThreads = 8;
+  std::vector<std::thread> tasks;
+  std::vector<CURLcode> results(kThreads, CURLE_OK);
+  for (auto& r : results) {
+    tasks.emplace_back([&share, &r] {
+      CurlPtr handle(curl_easy_init(), &curl_easy_cleanup);
+      (void)curl_easy_setopt(handle.get(), CURLOPT_SHARE, share.get());
+      (void)curl_easy_setopt(handle.get(), CURLOPT_URL, "http://localhost:1/");
+      (void)curl_easy_setopt(handle.get(), CURLOPT_NOSIGNAL, 1L);
+      r = curl_easy_perform(handle.get());
+    });
+  }
+  for (auto& t : tasks) t.join();
+  for (auto const r : results) EXPECT_NE(CURLE_OK, r);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
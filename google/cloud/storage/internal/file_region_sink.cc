@@ -0,0 +1,117 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/file_region_sink.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+auto constexpr kAlignment = PositionalFileWriter::kDirectIoAlignment;
+
+std::size_t AlignedBufferSize(std::size_t buffer_size) {
+  return (std::max)(kAlignment,
+                    (buffer_size + kAlignment - 1) / kAlignment * kAlignment);
+}
+
+}  // namespace
+
+FileRegionSink::FileRegionSink(PositionalFileWriter& writer,
+                               std::uintmax_t offset, std::size_t buffer_size)
+    : writer_(writer),
+      buffer_size_(AlignedBufferSize(buffer_size)),
+      offset_(offset),
+      current_(MakeBuffer()),
+      // The first buffer ends at an aligned offset, so the following buffers
+      // start at aligned offsets.
+      capacity_(buffer_size_ - static_cast<std::size_t>(offset % kAlignment)),
+      worker_([this] { WriteLoop(); }) {}
+
+FileRegionSink::~FileRegionSink() {
+  if (worker_.joinable()) Close();
+}
+
+Status FileRegionSink::Commit(std::size_t n) {
+  used_ += n;
+  if (used_ < capacity_) {
+    std::lock_guard<std::mutex> lk(mu_);
+    return status_;
+  }
+  return Flush();
+}
+
+Status FileRegionSink::Close() {
+  auto status = used_ == 0 ? Status{} : Flush();
+  std::unique_lock<std::mutex> lk(mu_);
+  closing_ = true;
+  cv_.notify_all();
+  lk.unlock();
+  if (worker_.joinable()) worker_.join();
+  lk.lock();
+  return status.ok() ? status_ : status;
+}
+
+FileRegionSink::Buffer FileRegionSink::MakeBuffer() const {
+  Buffer b;
+  b.storage.reset(new char[buffer_size_ + kAlignment]);
+  auto const address = reinterpret_cast<std::uintptr_t>(b.storage.get());
+  b.data = b.storage.get() + (kAlignment - address % kAlignment) % kAlignment;
+  return b;
+}
+
+Status FileRegionSink::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  // Wait for the previous write, this bounds the memory used by the sink.
+  cv_.wait(lk, [this] { return !has_pending_; });
+  if (!status_.ok()) return status_;
+  pending_ = std::move(current_);
+  pending_offset_ = offset_;
+  pending_size_ = used_;
+  has_pending_ = true;
+  current_ = spare_.storage ? std::move(spare_) : MakeBuffer();
+  cv_.notify_all();
+  lk.unlock();
+  offset_ += used_;
+  used_ = 0;
+  capacity_ = buffer_size_;
+  return Status{};
+}
+
+void FileRegionSink::WriteLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return has_pending_ || closing_; });
+    if (!has_pending_) return;
+    auto buffer = std::move(pending_);
+    auto const offset = pending_offset_;
+    auto const size = pending_size_;
+    lk.unlock();
+    auto status = writer_.WriteAt(offset, buffer.data, size);
+    lk.lock();
+    if (!status.ok() && status_.ok()) status_ = std::move(status);
+    spare_ = std::move(buffer);
+    has_pending_ = false;
+    cv_.notify_all();
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
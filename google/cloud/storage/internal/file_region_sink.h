@@ -0,0 +1,108 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_FILE_REGION_SINK_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_FILE_REGION_SINK_H
+
+#include "google/cloud/storage/internal/positional_file_writer.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "absl/types/span.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Writes a stream of data to a contiguous region of a file.
+ *
+ * The caller receives data directly into the buffer returned by `buffer()`,
+ * and commits it with `Commit()`. Full buffers are written by a background
+ * thread, while the caller fills the next buffer, so receiving the data
+ * overlaps writing it to disk.
+ *
+ * The buffers are aligned, their size is a multiple of
+ * `PositionalFileWriter::kDirectIoAlignment`, and all the buffers but the
+ * first start at an aligned offset in the file. Therefore, with a writer
+ * using direct I/O, all the full buffers bypass the page cache.
+ */
+class FileRegionSink {
+ public:
+  /// Writes the data starting at @p offset in @p writer.
+  FileRegionSink(PositionalFileWriter& writer, std::uintmax_t offset,
+                 std::size_t buffer_size);
+  ~FileRegionSink();
+
+  FileRegionSink(FileRegionSink const&) = delete;
+  FileRegionSink& operator=(FileRegionSink const&) = delete;
+
+  /// The free space in the current buffer, never empty.
+  absl::Span<char> buffer() {
+    return absl::Span<char>(current_.data + used_, capacity_ - used_);
+  }
+
+  /**
+   * Adds the next @p n bytes in `buffer()` to the data.
+   *
+   * Returns the error from a previous write, if any.
+   */
+  Status Commit(std::size_t n);
+
+  /// Writes any remaining data, and waits until all the writes complete.
+  Status Close();
+
+ private:
+  struct Buffer {
+    std::unique_ptr<char[]> storage;
+    char* data = nullptr;
+  };
+
+  Buffer MakeBuffer() const;
+  Status Flush();
+  void WriteLoop();
+
+  PositionalFileWriter& writer_;
+  std::size_t const buffer_size_;
+  std::uintmax_t offset_;
+  Buffer current_;
+  std::size_t capacity_;
+  std::size_t used_ = 0;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool has_pending_ = false;
+  Buffer pending_;
+  std::uintmax_t pending_offset_ = 0;
+  std::size_t pending_size_ = 0;
+  Buffer spare_;
+  Status status_;
+  bool closing_ = false;
+  std::thread worker_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_FILE_REGION_SINK_H
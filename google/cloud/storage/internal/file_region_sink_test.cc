@@ -0,0 +1,140 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/file_region_sink.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+
+auto constexpr kAlignment = PositionalFileWriter::kDirectIoAlignment;
+
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string{std::istreambuf_iterator<char>{is}, {}};
+}
+
+/// Appends @p data to @p sink, in chunks of at most @p chunk bytes.
+Status Append(FileRegionSink& sink, std::string const& data,
+              std::size_t chunk) {
+  for (std::size_t offset = 0; offset < data.size();) {
+    auto buffer = sink.buffer();
+    auto const n = (std::min)({chunk, buffer.size(), data.size() - offset});
+    std::memcpy(buffer.data(), data.data() + offset, n);
+    auto status = sink.Commit(n);
+    if (!status.ok()) return status;
+    offset += n;
+  }
+  return Status{};
+}
+
+std::string MakeData(std::size_t size) {
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i != size; ++i) {
+    data[i] = static_cast<char>('a' + i % 26);
+  }
+  return data;
+}
+
+TEST(FileRegionSinkTest, AlignedBuffers) {
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), 0);
+  ASSERT_STATUS_OK(writer);
+  FileRegionSink sink(**writer, 0, 100);
+  auto buffer = sink.buffer();
+  EXPECT_EQ(kAlignment, buffer.size());
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(buffer.data()) % kAlignment);
+  EXPECT_STATUS_OK(sink.Close());
+}
+
+TEST(FileRegionSinkTest, FirstBufferEndsAligned) {
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), 0);
+  ASSERT_STATUS_OK(writer);
+  FileRegionSink sink(**writer, kAlignment + 100, 2 * kAlignment);
+  EXPECT_EQ(2 * kAlignment - 100, sink.buffer().size());
+  EXPECT_STATUS_OK(sink.Close());
+}
+
+TEST(FileRegionSinkTest, WritesRegion) {
+  auto const data = MakeData(10 * kAlignment + 123);
+  auto const offset = kAlignment / 2;
+  testing::TempFile temp("");
+  auto writer =
+      PositionalFileWriter::Create(temp.name(), offset + data.size());
+  ASSERT_STATUS_OK(writer);
+  FileRegionSink sink(**writer, offset, 2 * kAlignment);
+  EXPECT_STATUS_OK(Append(sink, data, 1000));
+  EXPECT_STATUS_OK(sink.Close());
+  EXPECT_STATUS_OK((*writer)->Close());
+  EXPECT_EQ(std::string(offset, '\0') + data, ReadFile(temp.name()));
+}
+
+TEST(FileRegionSinkTest, DirectIo) {
+  auto const data = MakeData(8 * kAlignment + 17);
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), 0,
+                                             /*direct_io=*/true);
+  ASSERT_STATUS_OK(writer);
+  FileRegionSink sink(**writer, 0, 4 * kAlignment);
+  EXPECT_STATUS_OK(Append(sink, data, 3 * kAlignment));
+  EXPECT_STATUS_OK(sink.Close());
+  EXPECT_STATUS_OK((*writer)->Close());
+  EXPECT_EQ(data, ReadFile(temp.name()));
+}
+
+TEST(FileRegionSinkTest, CloseInDestructor) {
+  auto const data = MakeData(3 * kAlignment);
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), data.size());
+  ASSERT_STATUS_OK(writer);
+  {
+    FileRegionSink sink(**writer, 0, kAlignment);
+    EXPECT_STATUS_OK(Append(sink, data, data.size()));
+  }
+  EXPECT_STATUS_OK((*writer)->Close());
+  EXPECT_EQ(data, ReadFile(temp.name()));
+}
+
+TEST(FileRegionSinkTest, WriteError) {
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), 0);
+  ASSERT_STATUS_OK(writer);
+  // Writing to a closed file fails, the error is reported by a later call.
+  ASSERT_STATUS_OK((*writer)->Close());
+  FileRegionSink sink(**writer, 0, kAlignment);
+  auto status = Append(sink, MakeData(4 * kAlignment), kAlignment);
+  if (status.ok()) status = sink.Close();
+  EXPECT_THAT(status, StatusIs(StatusCode::kUnknown));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/version.h"
 #include "google/cloud/internal/invoke_result.h"
+#include "absl/strings/string_view.h"
 #include <string>
 
 namespace google {
@@ -56,11 +57,11 @@ template <typename RandomStringGenerator,
                                       RandomStringGenerator, int>::value,
                                   int>::type = 0>
 std::string GenerateMessageBoundary(
-    std::string const& message, RandomStringGenerator&& random_string_generator,
+    absl::string_view message, RandomStringGenerator&& random_string_generator,
     int initial_size, int growth_size) {
   std::string candidate = random_string_generator(initial_size);
-  for (std::string::size_type i = message.find(candidate, 0);
-       i != std::string::npos; i = message.find(candidate, i)) {
+  for (auto i = message.find(candidate, 0); i != absl::string_view::npos;
+       i = message.find(candidate, i)) {
     candidate += random_string_generator(growth_size);
   }
   return candidate;
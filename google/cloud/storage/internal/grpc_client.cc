@@ -20,6 +20,7 @@
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/internal/sha256_hash.h"
 #include "google/cloud/storage/internal/storage_auth.h"
+#include "google/cloud/storage/internal/storage_metrics.h"
 #include "google/cloud/storage/internal/storage_round_robin.h"
 #include "google/cloud/storage/internal/storage_stub.h"
 #include "google/cloud/grpc_options.h"
@@ -30,6 +31,7 @@
 #include "google/cloud/internal/time_utils.h"
 #include "google/cloud/internal/unified_grpc_credentials.h"
 #include "google/cloud/log.h"
+#include "google/cloud/rpc_metrics.h"
 #include "absl/algorithm/container.h"
 #include "absl/strings/str_split.h"
 #include "absl/time/time.h"
@@ -129,20 +131,55 @@ std::shared_ptr<GrpcAuthenticationStrategy> CreateAuthenticationStrategy(
       opts.get<google::cloud::GrpcCredentialOption>());
 }
 
+namespace {
+
+std::shared_ptr<StorageStub> CreateLazyStorageStub(
+    CompletionQueue cq, std::shared_ptr<GrpcAuthenticationStrategy> auth,
+    Options const& opts) {
+  auto const warm_up =
+      opts.get<storage_experimental::GrpcChannelWarmUpOption>();
+  auto factory = [auth, opts, warm_up](int id) {
+    auto channel = CreateGrpcChannel(*auth, opts, id);
+    if (warm_up) channel->GetState(/*try_to_connect=*/true);
+    return MakeDefaultStorageStub(std::move(channel));
+  };
+  auto stub = std::make_shared<StorageRoundRobin>(
+      std::move(factory), opts.get<GrpcNumChannelsOption>());
+  if (warm_up) {
+    std::weak_ptr<StorageRoundRobin> w = stub;
+    cq.RunAsync([w] {
+      if (auto self = w.lock()) self->CreateAllChildren();
+    });
+  }
+  return stub;
+}
+
+}  // namespace
+
 std::shared_ptr<StorageStub> CreateStorageStub(CompletionQueue cq,
                                                Options const& opts) {
-  auto auth = CreateAuthenticationStrategy(std::move(cq), opts);
-  std::vector<std::shared_ptr<StorageStub>> children(
-      (std::max)(1, opts.get<GrpcNumChannelsOption>()));
-  int id = 0;
-  std::generate(children.begin(), children.end(), [&id, &auth, opts] {
-    return MakeDefaultStorageStub(CreateGrpcChannel(*auth, opts, id++));
-  });
-  std::shared_ptr<StorageStub> stub =
-      std::make_shared<StorageRoundRobin>(std::move(children));
+  auto auth = CreateAuthenticationStrategy(cq, opts);
+  std::shared_ptr<StorageStub> stub;
+  if (opts.get<storage_experimental::GrpcLazyChannelsOption>()) {
+    stub = CreateLazyStorageStub(std::move(cq), auth, opts);
+  } else {
+    std::vector<std::shared_ptr<StorageStub>> children(
+        (std::max)(1, opts.get<GrpcNumChannelsOption>()));
+    int id = 0;
+    std::generate(children.begin(), children.end(), [&id, &auth, opts] {
+      return MakeDefaultStorageStub(CreateGrpcChannel(*auth, opts, id++));
+    });
+    stub = std::make_shared<StorageRoundRobin>(std::move(children));
+  }
   if (auth->RequiresConfigureContext()) {
     stub = std::make_shared<StorageAuth>(std::move(auth), std::move(stub));
   }
+  // The metrics decorator is the outermost layer, so the resource accounting
+  // for each call includes the work done by all the other decorators.
+  if (opts.has<RpcMetricsOption>()) {
+    stub = std::make_shared<StorageMetrics>(std::move(stub),
+                                            opts.get<RpcMetricsOption>());
+  }
   return stub;
 }
 
@@ -259,20 +296,24 @@ StatusOr<ObjectMetadata> GrpcClient::InsertObjectMedia(
   auto stream =
       stub_->InsertObjectMedia(absl::make_unique<grpc::ClientContext>());
 
-  auto const& contents = request.contents();
+  auto const contents = request.contents();
   auto const contents_size = static_cast<std::int64_t>(contents.size());
   std::int64_t const maximum_buffer_size =
       google::storage::v1::ServiceConstants::MAX_WRITE_CHUNK_BYTES;
 
+  // The same message is reused for each chunk, `Write()` serializes the
+  // message before returning, so the content buffer (and its capacity) can be
+  // reused without reallocating it on each iteration.
+  auto& data = *proto_request.mutable_checksummed_data();
   // This loop must run at least once because we need to send at least one
   // Write() call for empty objects.
   for (std::int64_t offset = 0, n = 0; offset <= contents_size; offset += n) {
     proto_request.set_write_offset(offset);
-    auto& data = *proto_request.mutable_checksummed_data();
     n = (std::min)(contents_size - offset, maximum_buffer_size);
-    data.set_content(
-        contents.substr(static_cast<std::string::size_type>(offset),
-                        static_cast<std::string::size_type>(n)));
+    data.mutable_content()->assign(
+        contents.data() + static_cast<std::string::size_type>(offset),
+        static_cast<std::string::size_type>(n));
+    // Compute the checksum while the data is in the CPU cache.
     data.mutable_crc32c()->set_value(crc32c::Crc32c(data.content()));
 
     if (offset + n >= contents_size) {
@@ -280,7 +321,10 @@ StatusOr<ObjectMetadata> GrpcClient::InsertObjectMedia(
       stream->Write(proto_request, grpc::WriteOptions{}.set_last_message());
       break;
     }
-    if (!stream->Write(proto_request, grpc::WriteOptions{})) break;
+    // Let gRPC coalesce the messages, the last message flushes the stream.
+    if (!stream->Write(proto_request, grpc::WriteOptions{}.set_buffer_hint())) {
+      break;
+    }
     // After the first message, clear the object specification and checksums,
     // there is no need to resend it.
     proto_request.clear_insert_object_spec();
@@ -908,7 +952,9 @@ StatusOr<google::storage::v1::InsertObjectRequest> GrpcClient::ToProto(
   } else if (request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
     // Nothing to do, the option is disabled (mostly useful in tests).
   } else {
-    checksums.mutable_crc32c()->set_value(crc32c::Crc32c(request.contents()));
+    auto const contents = request.contents();
+    checksums.mutable_crc32c()->set_value(
+        crc32c::Crc32c(contents.data(), contents.size()));
   }
 
   if (request.HasOption<MD5HashValue>()) {
@@ -1012,7 +1058,7 @@ StatusOr<std::string> GrpcClient::MD5ToProto(std::string const& v) {
   return internal::HexEncode(*binary);
 }
 
-std::string GrpcClient::ComputeMD5Hash(const std::string& payload) {
+std::string GrpcClient::ComputeMD5Hash(absl::string_view payload) {
   return internal::HexEncode(internal::MD5Hash(payload));
 }
 
@@ -19,6 +19,7 @@
 #include "google/cloud/storage/version.h"
 #include "google/cloud/background_threads.h"
 #include "google/cloud/internal/streaming_write_rpc.h"
+#include "absl/strings/string_view.h"
 #include <google/storage/v1/storage.pb.h>
 #include <memory>
 #include <string>
@@ -210,7 +211,7 @@ class GrpcClient : public RawClient,
   static StatusOr<std::uint32_t> Crc32cToProto(std::string const&);
   static std::string MD5FromProto(std::string const&);
   static StatusOr<std::string> MD5ToProto(std::string const&);
-  static std::string ComputeMD5Hash(std::string const& payload);
+  static std::string ComputeMD5Hash(absl::string_view payload);
 
  protected:
   explicit GrpcClient(Options const& opts);
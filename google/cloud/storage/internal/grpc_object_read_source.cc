@@ -56,17 +56,17 @@ StatusOr<HttpResponse> GrpcObjectReadSource::Close() {
 StatusOr<ReadSourceResult> GrpcObjectReadSource::Read(char* buf,
                                                       std::size_t n) {
   std::size_t offset = 0;
-  auto update_buf = [&offset, buf, n](std::string source) {
-    if (source.empty()) return source;
-    auto const nbytes = std::min(n - offset, source.size());
-    std::copy(source.data(), source.data() + nbytes, buf + offset);
+  // Copy as much of the data as fits into `buf`, returning the number of bytes
+  // copied.
+  auto copy_to_buf = [&offset, buf, n](char const* data, std::size_t size) {
+    auto const nbytes = (std::min)(n - offset, size);
+    std::copy(data, data + nbytes, buf + offset);
     offset += nbytes;
-    source.erase(0, nbytes);
-    return source;
+    return nbytes;
   };
   struct Visitor {
     GrpcObjectReadSource& self;
-    absl::FunctionRef<std::string(std::string)> update_buf;
+    absl::FunctionRef<std::size_t(char const*, std::size_t)> copy_to_buf;
 
     HeadersMap operator()(Status s) {
       // A status, whether success or failure, closes the stream.
@@ -80,10 +80,16 @@ StatusOr<ReadSourceResult> GrpcObjectReadSource::Read(char* buf,
       // The google.storage.v1.Storage documentation says this field can be
       // empty.
       if (response.has_checksummed_data()) {
-        self.spill_ =
-            update_buf(std::string(  // Sometimes protobuf bytes are not strings
-                std::move(
-                    *response.mutable_checksummed_data()->mutable_content())));
+        // Sometimes protobuf bytes are not strings
+        std::string content(
+            std::move(*response.mutable_checksummed_data()->mutable_content()));
+        // Copy the data directly into the application buffer, and only keep
+        // (without copying) the data that does not fit.
+        auto const nbytes = copy_to_buf(content.data(), content.size());
+        if (nbytes != content.size()) {
+          self.spill_ = std::move(content);
+          self.spill_offset_ = nbytes;
+        }
       }
       if (self.checksums_known_) return {};
       if (!response.has_object_checksums()) return {};
@@ -92,11 +98,18 @@ StatusOr<ReadSourceResult> GrpcObjectReadSource::Read(char* buf,
     }
   };
 
-  spill_ = update_buf(std::move(spill_));
+  if (spill_offset_ != spill_.size()) {
+    spill_offset_ += copy_to_buf(spill_.data() + spill_offset_,
+                                 spill_.size() - spill_offset_);
+    if (spill_offset_ == spill_.size()) {
+      spill_.clear();
+      spill_offset_ = 0;
+    }
+  }
   HeadersMap headers;
   while (offset < n && stream_) {
     auto v = stream_->Read();
-    auto h = absl::visit(Visitor{*this, update_buf}, std::move(v));
+    auto h = absl::visit(Visitor{*this, copy_to_buf}, std::move(v));
     headers.insert(h.begin(), h.end());
   }
 
@@ -60,8 +60,12 @@ class GrpcObjectReadSource : public ObjectReadSource {
   std::unique_ptr<StreamingRpc> stream_;
 
   // In some cases the gRPC response may contain more data than the buffer
-  // provided by the application. This buffer stores any excess results.
+  // provided by the application. This buffer stores any excess results, the
+  // data before `spill_offset_` was already returned to the application.
+  // Keeping an offset (instead of erasing the returned data) avoids copying
+  // the remaining data on each `Read()`.
   std::string spill_;
+  std::size_t spill_offset_ = 0;
 
   // The status of the request.
   google::cloud::Status status_;
@@ -84,26 +84,30 @@ StatusOr<ResumableUploadResponse> GrpcResumableUploadSession::UploadGeneric(
 
   std::size_t const maximum_chunk_size =
       google::storage::v1::ServiceConstants::MAX_WRITE_CHUNK_BYTES;
-  std::string chunk;
-  chunk.reserve(maximum_chunk_size);
+  // The data is copied directly into the request message, and the same message
+  // (and its buffer) is reused for each chunk. The CRC32C checksum for each
+  // chunk is computed while the data is copied, when it is already in the CPU
+  // cache.
+  google::storage::v1::InsertObjectRequest request;
+  request.set_upload_id(session_id_params_.upload_id);
+  auto& data = *request.mutable_checksummed_data();
+  auto& content = *data.mutable_content();
+  content.reserve((std::min)(maximum_chunk_size, TotalBytes(buffers)));
+  std::uint32_t crc = 0;
   auto flush_chunk = [&](bool has_more) {
-    if (chunk.size() < maximum_chunk_size && has_more) return true;
-    if (chunk.empty() && !final_chunk) return true;
+    if (content.size() < maximum_chunk_size && has_more) return true;
+    if (content.empty() && !final_chunk) return true;
 
-    google::storage::v1::InsertObjectRequest request;
-    request.set_upload_id(session_id_params_.upload_id);
     request.set_write_offset(
         static_cast<google::protobuf::int64>(next_expected_));
     request.set_finish_write(false);
-
-    auto& data = *request.mutable_checksummed_data();
-    auto const n = chunk.size();
-    data.set_content(std::move(chunk));
-    chunk.clear();
-    chunk.reserve(maximum_chunk_size);
-    data.mutable_crc32c()->set_value(crc32c::Crc32c(data.content()));
+    data.mutable_crc32c()->set_value(crc);
+    auto const n = content.size();
 
     auto options = grpc::WriteOptions();
+    // Let gRPC coalesce the messages in a burst, the last message (or the
+    // `WritesDone()` in `Close()`) flushes any buffered data.
+    if (has_more) options.set_buffer_hint();
     if (final_chunk && !has_more) {
       if (!hashes.md5.empty()) {
         auto md5 = GrpcClient::MD5ToProto(hashes.md5);
@@ -123,10 +127,11 @@ StatusOr<ResumableUploadResponse> GrpcResumableUploadSession::UploadGeneric(
     }
 
     if (!writer->Write(request, options)) return false;
-    // After the first message, clear the object specification and checksums,
-    // there is no need to resend it.
-    request.clear_insert_object_spec();
+    // `Write()` serializes the message before returning, so the buffer can be
+    // reused. The object checksums are only sent with the last message.
     request.clear_object_checksums();
+    content.clear();
+    crc = 0;
 
     next_expected_ += n;
     return true;
@@ -153,11 +158,14 @@ StatusOr<ResumableUploadResponse> GrpcResumableUploadSession::UploadGeneric(
   do {
     std::size_t consumed = 0;
     for (auto const& b : buffers) {
-      // flush_chunk() guarantees that maximum_chunk_size < chunk.size()
-      auto capacity = maximum_chunk_size - chunk.size();
+      // flush_chunk() guarantees that content.size() <= maximum_chunk_size
+      auto capacity = maximum_chunk_size - content.size();
       if (capacity == 0) break;
       auto n = (std::min)(capacity, b.size());
-      chunk.append(b.data(), b.data() + n);
+      auto const offset = content.size();
+      content.append(b.data(), n);
+      crc = crc32c::Extend(
+          crc, reinterpret_cast<std::uint8_t const*>(&content[offset]), n);
       consumed += n;
     }
     PopFrontBytes(buffers, consumed);
@@ -151,7 +151,7 @@ TEST(GrpcResumableUploadSessionTest, SingleStreamForLargeChunks) {
         EXPECT_CALL(*writer, Write)
             .Times(AtLeast(2))
             .WillRepeatedly([&](InsertObjectRequest const& r,
-                                grpc::WriteOptions const&) {
+                                grpc::WriteOptions const& options) {
               EXPECT_EQ("test-upload-id", r.upload_id());
               EXPECT_EQ(expected_write_offset, r.write_offset());
               EXPECT_TRUE(r.has_checksummed_data());
@@ -160,6 +160,9 @@ TEST(GrpcResumableUploadSessionTest, SingleStreamForLargeChunks) {
                   content_size,
                   google::storage::v1::ServiceConstants::MAX_WRITE_CHUNK_BYTES);
               expected_write_offset += content_size;
+              // Only the last message in each upload flushes the stream.
+              auto const is_last = expected_write_offset % size == 0;
+              EXPECT_EQ(!is_last, options.get_buffer_hint());
               return true;
             });
         EXPECT_CALL(*writer, Close).WillOnce(Return(MockCloseSuccess()));
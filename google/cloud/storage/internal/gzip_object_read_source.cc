@@ -0,0 +1,207 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/gzip_object_read_source.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/match.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// The same size as the first read in `ObjectReadStreambuf`, gzip-encoded data
+// is typically several times smaller than the buffers it is inflated into.
+auto constexpr kInputBufferSize = 128 * 1024;
+
+// The hashes of the compressed data, as if the request did not decompress it.
+ReadObjectRangeRequest HashRequest(ReadObjectRangeRequest request) {
+  request.set_option(DecompressGzip(false));
+  return request;
+}
+
+Status GzipError(z_stream const& stream, char const* what) {
+  std::string message = "invalid gzip data in download: ";
+  message += what;
+  if (stream.msg != nullptr) {
+    message += ": ";
+    message += stream.msg;
+  }
+  return Status(StatusCode::kDataLoss, std::move(message));
+}
+
+}  // namespace
+
+GzipObjectReadSource::GzipObjectReadSource(
+    ReadObjectRangeRequest const& request,
+    std::unique_ptr<ObjectReadSource> child)
+    : child_(std::move(child)),
+      hash_function_(CreateHashFunction(HashRequest(request))),
+      hash_validator_(CreateHashValidator(HashRequest(request))),
+      input_(kInputBufferSize) {
+  std::memset(&stream_, 0, sizeof(stream_));
+}
+
+GzipObjectReadSource::~GzipObjectReadSource() {
+  if (compressed_) inflateEnd(&stream_);
+}
+
+StatusOr<HttpResponse> GzipObjectReadSource::Close() {
+  done_ = true;
+  return child_->Close();
+}
+
+StatusOr<ReadSourceResult> GzipObjectReadSource::Read(char* buf,
+                                                      std::size_t n) {
+  ReadSourceResult result{0, HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+  if (done_) {
+    result.response.status_code = status_code_;
+    return result;
+  }
+  while (result.bytes_received < n) {
+    if (stream_.avail_in == 0 && !child_done_) {
+      auto status = ReadInput(result.response);
+      if (!status.ok()) return status;
+    }
+    auto produced =
+        Produce(buf + result.bytes_received, n - result.bytes_received);
+    if (!produced) return std::move(produced).status();
+    result.bytes_received += *produced;
+    if (stream_.avail_in != 0) continue;
+    if (child_done_) {
+      auto status = Finish();
+      if (!status.ok()) return status;
+      result.response.status_code = status_code_;
+      break;
+    }
+    // Return the data available instead of blocking for more.
+    if (result.bytes_received != 0) break;
+  }
+  return result;
+}
+
+Status GzipObjectReadSource::ReadInput(HttpResponse& response) {
+  auto read = child_->Read(input_.data(), input_.size());
+  if (!read) return std::move(read).status();
+  for (auto const& kv : read->response.headers) {
+    hash_validator_->ProcessHeader(kv.first, kv.second);
+    // The service may compress objects stored without compression when the
+    // request accepts gzip. The hashes are for the stored data in that case.
+    if (kv.first == "x-goog-stored-content-encoding" &&
+        !absl::EqualsIgnoreCase(kv.second, "gzip")) {
+      hash_output_ = true;
+    }
+    if (!compressed_ && kv.first == "content-encoding" &&
+        absl::EqualsIgnoreCase(kv.second, "gzip")) {
+      // Only accept gzip, not zlib, data. That is what the header promises.
+      auto constexpr kGzipWindowBits = 16 + MAX_WBITS;
+      if (inflateInit2(&stream_, kGzipWindowBits) != Z_OK) {
+        return Status(StatusCode::kResourceExhausted,
+                      "cannot initialize the gzip decompressor");
+      }
+      compressed_ = true;
+    }
+    response.headers.emplace(kv.first, kv.second);
+  }
+  if (!hash_output_) {
+    hash_function_->Update(input_.data(), read->bytes_received);
+  }
+  stream_.next_in = reinterpret_cast<Bytef*>(input_.data());
+  stream_.avail_in = static_cast<uInt>(read->bytes_received);
+  if (read->response.status_code != HttpStatusCode::kContinue) {
+    status_code_ = read->response.status_code;
+  }
+  child_done_ = !child_->IsOpen();
+  return Status();
+}
+
+StatusOr<std::size_t> GzipObjectReadSource::Produce(char* buf,
+                                                    std::size_t n) {
+  if (!compressed_) {
+    auto const count = (std::min)(n, std::size_t{stream_.avail_in});
+    if (count != 0) std::memcpy(buf, stream_.next_in, count);
+    if (hash_output_) hash_function_->Update(buf, count);
+    stream_.next_in += count;
+    stream_.avail_in -= static_cast<uInt>(count);
+    return count;
+  }
+  auto const size = static_cast<uInt>(
+      (std::min)(n, std::size_t{std::numeric_limits<uInt>::max()}));
+  stream_.next_out = reinterpret_cast<Bytef*>(buf);
+  stream_.avail_out = size;
+  while (stream_.avail_out != 0) {
+    if (!in_member_) {
+      if (stream_.avail_in == 0) break;
+      // The data may contain several gzip members, each one is decoded as an
+      // independent stream, and the output is concatenated.
+      if (inflateReset(&stream_) != Z_OK) {
+        return GzipError(stream_, "cannot reset decompressor");
+      }
+      in_member_ = true;
+    }
+    auto const rc = inflate(&stream_, Z_NO_FLUSH);
+    if (rc == Z_STREAM_END) {
+      in_member_ = false;
+      continue;
+    }
+    // Z_BUF_ERROR means no progress was possible, more input is needed.
+    if (rc == Z_BUF_ERROR) break;
+    if (rc != Z_OK) return GzipError(stream_, "cannot inflate");
+  }
+  auto const count = std::size_t{size - stream_.avail_out};
+  if (hash_output_) hash_function_->Update(buf, count);
+  return count;
+}
+
+Status GzipObjectReadSource::Finish() {
+  done_ = true;
+  if (status_code_ == HttpStatusCode::kContinue) {
+    status_code_ = HttpStatusCode::kOk;
+  }
+  auto result = std::move(*hash_validator_)
+                    .Finish(std::move(*hash_function_).Finish());
+  if (result.is_mismatch) {
+    return Status(StatusCode::kDataLoss,
+                  "mismatched hashes in download, computed=" +
+                      FormatComputedHashes(result) +
+                      ", received=" + FormatReceivedHashes(result));
+  }
+  if (in_member_) return GzipError(stream_, "truncated stream");
+  return Status();
+}
+
+std::unique_ptr<ObjectReadSource> DecompressDownload(
+    ReadObjectRangeRequest const& request,
+    std::unique_ptr<ObjectReadSource> source) {
+  if (!request.GetOption<DecompressGzip>().value_or(false)) return source;
+  if (request.RequiresRangeHeader()) {
+    return absl::make_unique<ObjectReadErrorSource>(Status(
+        StatusCode::kInvalidArgument,
+        "DecompressGzip cannot be combined with ReadFromOffset, ReadRange, or "
+        "ReadLast"));
+  }
+  return absl::make_unique<GzipObjectReadSource>(request, std::move(source));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
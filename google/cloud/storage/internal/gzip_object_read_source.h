@@ -0,0 +1,100 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_OBJECT_READ_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_OBJECT_READ_SOURCE_H
+
+#include "google/cloud/storage/internal/hash_function.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/version.h"
+#include <zlib.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Inflates a gzip-encoded download as it is read.
+ *
+ * The child source must return the stored (compressed) representation of the
+ * object, i.e., the request must include `Accept-Encoding: gzip`. The data is
+ * inflated only if the response has a `Content-Encoding: gzip` header,
+ * otherwise it is returned unchanged.
+ *
+ * The hashes reported by the service apply to the stored data, which is
+ * usually the compressed data, so this class computes and validates them as
+ * the data is received. A mismatch is reported as a `kDataLoss` error in the
+ * last `Read()` call.
+ */
+class GzipObjectReadSource : public ObjectReadSource {
+ public:
+  GzipObjectReadSource(ReadObjectRangeRequest const& request,
+                       std::unique_ptr<ObjectReadSource> child);
+  ~GzipObjectReadSource() override;
+
+  GzipObjectReadSource(GzipObjectReadSource const&) = delete;
+  GzipObjectReadSource& operator=(GzipObjectReadSource const&) = delete;
+
+  bool IsOpen() const override { return !done_; }
+  StatusOr<HttpResponse> Close() override;
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+
+ private:
+  /// Reads the next block of compressed data into `input_`, and appends any
+  /// headers to @p response.
+  Status ReadInput(HttpResponse& response);
+
+  /// Moves (or inflates) data from `input_` to @p buf, returns the size.
+  StatusOr<std::size_t> Produce(char* buf, std::size_t n);
+
+  /// Validates the hashes and the gzip trailer once all the data is read.
+  Status Finish();
+
+  std::unique_ptr<ObjectReadSource> child_;
+  std::unique_ptr<HashFunction> hash_function_;
+  std::unique_ptr<HashValidator> hash_validator_;
+  std::vector<char> input_;
+  z_stream stream_;
+  bool compressed_ = false;
+  // The stored data is not compressed, compute the hashes after inflating it.
+  bool hash_output_ = false;
+  bool in_member_ = false;
+  bool child_done_ = false;
+  bool done_ = false;
+  long status_code_ = HttpStatusCode::kContinue;  // NOLINT(google-runtime-int)
+};
+
+/**
+ * Wraps @p source in a `GzipObjectReadSource` if the request includes the
+ * `DecompressGzip` option.
+ */
+std::unique_ptr<ObjectReadSource> DecompressDownload(
+    ReadObjectRangeRequest const& request,
+    std::unique_ptr<ObjectReadSource> source);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_OBJECT_READ_SOURCE_H
@@ -0,0 +1,244 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/gzip_object_read_source.h"
+#include "google/cloud/storage/hashing_options.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::HasSubstr;
+
+std::string Gzip(std::string const& data) {
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                               16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+  std::string output(deflateBound(&stream, static_cast<uLong>(data.size())),
+                     '\0');
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+  stream.avail_out = static_cast<uInt>(output.size());
+  EXPECT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+  return output;
+}
+
+std::string Contents() {
+  std::string contents;
+  for (int i = 0; i != 10000; ++i) {
+    contents += "line " + std::to_string(i) + ": the quick brown fox\n";
+  }
+  return contents;
+}
+
+/// Returns @p data in blocks of at most @p block_size, like a download.
+class FakeSource : public ObjectReadSource {
+ public:
+  FakeSource(std::string data, std::multimap<std::string, std::string> headers,
+             std::size_t block_size = 4096)
+      : data_(std::move(data)),
+        headers_(std::move(headers)),
+        block_size_(block_size) {}
+
+  bool IsOpen() const override { return open_; }
+  StatusOr<HttpResponse> Close() override {
+    open_ = false;
+    return HttpResponse{HttpStatusCode::kOk, {}, {}};
+  }
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override {
+    auto const count = (std::min)({n, block_size_, data_.size() - offset_});
+    std::memcpy(buf, data_.data() + offset_, count);
+    offset_ += count;
+    ReadSourceResult result{count,
+                            HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+    result.response.headers = std::move(headers_);
+    headers_.clear();
+    if (offset_ == data_.size()) {
+      open_ = false;
+      result.response.status_code = HttpStatusCode::kOk;
+    }
+    return result;
+  }
+
+ private:
+  std::string data_;
+  std::multimap<std::string, std::string> headers_;
+  std::size_t block_size_;
+  std::size_t offset_ = 0;
+  bool open_ = true;
+};
+
+ReadObjectRangeRequest TestRequest() {
+  return ReadObjectRangeRequest("test-bucket", "test-object")
+      .set_multiple_options(DecompressGzip(true), DisableMD5Hash(true));
+}
+
+StatusOr<std::string> ReadAll(ObjectReadSource& source) {
+  std::string contents;
+  std::vector<char> buffer(1000);
+  while (source.IsOpen()) {
+    auto result = source.Read(buffer.data(), buffer.size());
+    if (!result) return std::move(result).status();
+    contents.append(buffer.data(), result->bytes_received);
+    if (result->response.status_code != HttpStatusCode::kContinue) {
+      EXPECT_EQ(HttpStatusCode::kOk, result->response.status_code);
+    }
+  }
+  return contents;
+}
+
+TEST(GzipObjectReadSourceTest, NotRequested) {
+  auto mock = absl::make_unique<testing::MockObjectReadSource>();
+  auto* expected = mock.get();
+  auto actual = DecompressDownload(ReadObjectRangeRequest("b", "o"),
+                                   std::move(mock));
+  EXPECT_EQ(expected, actual.get());
+}
+
+TEST(GzipObjectReadSourceTest, RangesNotSupported) {
+  auto source = DecompressDownload(
+      TestRequest().set_option(ReadFromOffset(1024)),
+      absl::make_unique<testing::MockObjectReadSource>());
+  std::vector<char> buffer(16);
+  EXPECT_THAT(source->Read(buffer.data(), buffer.size()),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(GzipObjectReadSourceTest, Inflate) {
+  auto const contents = Contents();
+  auto const compressed = Gzip(contents);
+  auto source = DecompressDownload(
+      TestRequest(),
+      absl::make_unique<FakeSource>(
+          compressed,
+          std::multimap<std::string, std::string>{
+              {"content-encoding", "gzip"},
+              {"x-goog-hash",
+               "crc32c=" + ComputeCrc32cChecksum(compressed)}}));
+  auto actual = ReadAll(*source);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents, *actual);
+}
+
+TEST(GzipObjectReadSourceTest, InflateMultipleMembers) {
+  auto const contents = Contents();
+  auto const half = contents.size() / 2;
+  auto const compressed =
+      Gzip(contents.substr(0, half)) + Gzip(contents.substr(half));
+  auto source = DecompressDownload(
+      TestRequest(), absl::make_unique<FakeSource>(
+                         compressed, std::multimap<std::string, std::string>{
+                                         {"content-encoding", "gzip"}}));
+  auto actual = ReadAll(*source);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents, *actual);
+}
+
+TEST(GzipObjectReadSourceTest, NotCompressed) {
+  auto const contents = Contents();
+  auto source = DecompressDownload(
+      TestRequest(),
+      absl::make_unique<FakeSource>(
+          contents, std::multimap<std::string, std::string>{
+                        {"x-goog-hash",
+                         "crc32c=" + ComputeCrc32cChecksum(contents)}}));
+  auto actual = ReadAll(*source);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents, *actual);
+}
+
+TEST(GzipObjectReadSourceTest, CompressedInTransit) {
+  // Objects stored without compression may be compressed by the service, the
+  // hashes are for the stored data.
+  auto const contents = Contents();
+  auto source = DecompressDownload(
+      TestRequest(),
+      absl::make_unique<FakeSource>(
+          Gzip(contents),
+          std::multimap<std::string, std::string>{
+              {"content-encoding", "gzip"},
+              {"x-goog-stored-content-encoding", "identity"},
+              {"x-goog-hash", "crc32c=" + ComputeCrc32cChecksum(contents)}}));
+  auto actual = ReadAll(*source);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents, *actual);
+}
+
+TEST(GzipObjectReadSourceTest, HashMismatch) {
+  auto const contents = Contents();
+  auto source = DecompressDownload(
+      TestRequest(),
+      absl::make_unique<FakeSource>(
+          Gzip(contents),
+          std::multimap<std::string, std::string>{
+              {"content-encoding", "gzip"},
+              // The checksum of the decompressed data is the wrong value.
+              {"x-goog-hash", "crc32c=" + ComputeCrc32cChecksum(contents)}}));
+  EXPECT_THAT(ReadAll(*source), StatusIs(StatusCode::kDataLoss,
+                                         HasSubstr("mismatched hashes")));
+}
+
+TEST(GzipObjectReadSourceTest, Truncated) {
+  auto compressed = Gzip(Contents());
+  compressed.resize(compressed.size() - 16);
+  auto source = DecompressDownload(
+      TestRequest(),
+      absl::make_unique<FakeSource>(
+          compressed,
+          std::multimap<std::string, std::string>{
+              {"content-encoding", "gzip"},
+              {"x-goog-hash",
+               "crc32c=" + ComputeCrc32cChecksum(compressed)}}));
+  EXPECT_THAT(ReadAll(*source),
+              StatusIs(StatusCode::kDataLoss, HasSubstr("truncated")));
+}
+
+TEST(GzipObjectReadSourceTest, Corrupted) {
+  auto compressed = Gzip(Contents());
+  compressed[compressed.size() / 2] ^= 0x55;
+  compressed[compressed.size() / 2 + 1] ^= 0x55;
+  auto source = DecompressDownload(
+      TestRequest(), absl::make_unique<FakeSource>(
+                         compressed, std::multimap<std::string, std::string>{
+                                         {"content-encoding", "gzip"}}));
+  EXPECT_THAT(ReadAll(*source), StatusIs(StatusCode::kDataLoss));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
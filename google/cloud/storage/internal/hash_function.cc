@@ -23,16 +23,26 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 namespace {
+std::unique_ptr<HashFunction> CreateMD5HashFunction(bool background) {
+  std::unique_ptr<HashFunction> md5 = absl::make_unique<MD5HashFunction>();
+  if (!background) return md5;
+  return absl::make_unique<BackgroundHashFunction>(std::move(md5));
+}
+
 std::unique_ptr<HashFunction> CreateHashFunction(bool disable_crc32c,
-                                                 bool disable_md5) {
+                                                 bool disable_md5,
+                                                 bool background) {
   if (disable_md5 && disable_crc32c) {
     return absl::make_unique<NullHashFunction>();
   }
+  // CRC32C checksums are hardware accelerated (SSE4.2 or ARMv8 CRC) on most
+  // platforms, they run as fast as the copy needed to move them to a
+  // background thread. Only MD5 hashes benefit from running in the background.
   if (disable_md5) return absl::make_unique<Crc32cHashFunction>();
-  if (disable_crc32c) return absl::make_unique<MD5HashFunction>();
+  if (disable_crc32c) return CreateMD5HashFunction(background);
   return absl::make_unique<CompositeFunction>(
       absl::make_unique<Crc32cHashFunction>(),
-      absl::make_unique<MD5HashFunction>());
+      CreateMD5HashFunction(background));
 }
 }  // namespace
 
@@ -43,9 +53,15 @@ std::unique_ptr<HashFunction> CreateNullHashFunction() {
 std::unique_ptr<HashFunction> CreateHashFunction(
     ReadObjectRangeRequest const& request) {
   if (request.RequiresRangeHeader()) return CreateNullHashFunction();
+  // `GzipObjectReadSource` validates the checksums of decompressed downloads,
+  // as they apply to the compressed data.
+  if (request.GetOption<DecompressGzip>().value_or(false)) {
+    return CreateNullHashFunction();
+  }
   return CreateHashFunction(
       request.GetOption<DisableCrc32cChecksum>().value_or(false),
-      request.GetOption<DisableMD5Hash>().value_or(false));
+      request.GetOption<DisableMD5Hash>().value_or(false),
+      request.GetOption<UseBackgroundHashing>().value_or(false));
 }
 
 std::unique_ptr<HashFunction> CreateHashFunction(
@@ -61,7 +77,8 @@ std::unique_ptr<HashFunction> CreateHashFunction(
       request.GetOption<DisableCrc32cChecksum>().value_or(false) ||
           !request.GetOption<Crc32cChecksumValue>().value_or("").empty(),
       request.GetOption<DisableMD5Hash>().value_or(false) ||
-          !request.GetOption<MD5HashValue>().value_or("").empty());
+          !request.GetOption<MD5HashValue>().value_or("").empty(),
+      request.GetOption<UseBackgroundHashing>().value_or(false));
 }
 
 }  // namespace internal
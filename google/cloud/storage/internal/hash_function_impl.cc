@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/hash_function_impl.h"
+#include "google/cloud/storage/internal/crc32c_combine.h"
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/internal/big_endian.h"
 #include "absl/memory/memory.h"
 #include <crc32c/crc32c.h>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -59,6 +61,96 @@ HashValues Crc32cHashFunction::Finish() && {
   return HashValues{/*.crc32c=*/Base64Encode(hash), /*.md5=*/{}};
 }
 
+void Crc32cHashFunction::Concat(std::uint32_t crc32c, std::uintmax_t size) {
+  current_ = Crc32cCombine(current_, crc32c, size);
+}
+
+Status Crc32cHashFunction::Concat(std::string const& crc32c,
+                                  std::uintmax_t size) {
+  auto decoded = Base64Decode(crc32c);
+  if (!decoded) return std::move(decoded).status();
+  auto value = google::cloud::internal::DecodeBigEndian<std::uint32_t>(
+      std::string(decoded->begin(), decoded->end()));
+  if (!value) return std::move(value).status();
+  Concat(*value, size);
+  return Status{};
+}
+
+namespace {
+// Limit the memory used by each background hash function. This is enough to
+// queue a few calls to `Update()` with the default buffer sizes.
+auto constexpr kMaxPendingBytes = std::size_t{32} * 1024 * 1024;
+auto constexpr kMaxFreeBuffers = std::size_t{2};
+}  // namespace
+
+BackgroundHashFunction::BackgroundHashFunction(
+    std::unique_ptr<HashFunction> child)
+    : child_(std::move(child)), name_("background(" + child_->Name() + ")") {}
+
+BackgroundHashFunction::~BackgroundHashFunction() {
+  std::unique_lock<std::mutex> lk(mu_);
+  // Nobody will use the results, discard any queued data.
+  for (auto const& chunk : pending_) pending_bytes_ -= chunk.size();
+  pending_.clear();
+  Shutdown(std::move(lk));
+}
+
+std::string BackgroundHashFunction::Name() const { return name_; }
+
+void BackgroundHashFunction::Update(char const* buf, std::size_t n) {
+  if (n == 0) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  // Start the thread on the first call, many streams never see any data.
+  if (!worker_.joinable()) {
+    worker_ = std::thread([this] { WorkerLoop(); });
+  }
+  cv_.wait(lk, [this, n] {
+    return pending_bytes_ == 0 || pending_bytes_ + n <= kMaxPendingBytes;
+  });
+  std::string chunk;
+  if (!free_.empty()) {
+    chunk = std::move(free_.back());
+    free_.pop_back();
+  }
+  // Only this thread adds data, it is safe to release the lock while copying.
+  lk.unlock();
+  chunk.assign(buf, n);
+  lk.lock();
+  pending_bytes_ += n;
+  pending_.push_back(std::move(chunk));
+  lk.unlock();
+  cv_.notify_all();
+}
+
+HashValues BackgroundHashFunction::Finish() && {
+  Shutdown(std::unique_lock<std::mutex>(mu_));
+  return std::move(*child_).Finish();
+}
+
+void BackgroundHashFunction::Shutdown(std::unique_lock<std::mutex> lk) {
+  shutdown_ = true;
+  lk.unlock();
+  cv_.notify_all();
+  if (worker_.joinable()) worker_.join();
+}
+
+void BackgroundHashFunction::WorkerLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    // Drain the queue before exiting, `Finish()` needs all the data.
+    if (pending_.empty()) return;
+    auto chunk = std::move(pending_.front());
+    pending_.pop_front();
+    lk.unlock();
+    child_->Update(chunk.data(), chunk.size());
+    lk.lock();
+    pending_bytes_ -= chunk.size();
+    if (free_.size() < kMaxFreeBuffers) free_.push_back(std::move(chunk));
+    cv_.notify_all();
+  }
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
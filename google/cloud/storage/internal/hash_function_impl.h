@@ -17,10 +17,17 @@
 
 #include "google/cloud/storage/internal/hash_function.h"
 #include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
 #include <openssl/md5.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -90,10 +97,65 @@ class Crc32cHashFunction : public HashFunction {
   void Update(char const* buf, std::size_t n) override;
   HashValues Finish() && override;
 
+  /**
+   * Extends the checksum as-if @p size bytes with checksum @p crc32c were
+   * passed to `Update()`.
+   *
+   * This combines the checksums of consecutive slices of an object into the
+   * checksum of the full object, without access to the data. The cost is
+   * `O(log(size))`.
+   */
+  void Concat(std::uint32_t crc32c, std::uintmax_t size);
+
+  /**
+   * Extends the checksum using a checksum in the `HashValues::crc32c` format.
+   *
+   * @return an error if @p crc32c is not a valid, Base64-encoded, checksum. The
+   *     checksum is not modified in this case.
+   */
+  Status Concat(std::string const& crc32c, std::uintmax_t size);
+
  private:
   std::uint32_t current_{0};
 };
 
+/**
+ * Runs a hash function in a background thread.
+ *
+ * `Update()` copies the data and queues it for a background thread, so the
+ * caller can continue with the next I/O operation while the data is hashed.
+ * The amount of queued data is bounded, `Update()` blocks if the background
+ * thread falls behind. `Finish()` blocks until all the queued data is hashed,
+ * so the results are the same as calling the wrapped function directly.
+ */
+class BackgroundHashFunction : public HashFunction {
+ public:
+  explicit BackgroundHashFunction(std::unique_ptr<HashFunction> child);
+  ~BackgroundHashFunction() override;
+
+  BackgroundHashFunction(BackgroundHashFunction const&) = delete;
+  BackgroundHashFunction& operator=(BackgroundHashFunction const&) = delete;
+
+  std::string Name() const override;
+  void Update(char const* buf, std::size_t n) override;
+  HashValues Finish() && override;
+
+ private:
+  void Shutdown(std::unique_lock<std::mutex> lk);
+  void WorkerLoop();
+
+  std::unique_ptr<HashFunction> child_;
+  std::string const name_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::string> pending_;
+  std::size_t pending_bytes_ = 0;
+  // Recycle the buffers to avoid one allocation per `Update()` call.
+  std::vector<std::string> free_;
+  bool shutdown_ = false;
+  std::thread worker_;
+};
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
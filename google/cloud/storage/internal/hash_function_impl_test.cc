@@ -15,7 +15,9 @@
 #include "google/cloud/storage/internal/hash_function_impl.h"
 #include "google/cloud/storage/internal/object_requests.h"
 #include "absl/memory/memory.h"
+#include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -24,7 +26,9 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 namespace {
 
+using ::google::cloud::testing_util::IsOk;
 using ::testing::IsEmpty;
+using ::testing::Not;
 
 // These values were obtained using:
 // echo -n '' > foo.txt && gsutil hash foo.txt
@@ -74,6 +78,41 @@ TEST(HasFunctionImplTest, QuickCrc32c) {
   EXPECT_THAT(result.md5, IsEmpty());
 }
 
+TEST(HasFunctionImplTest, ConcatCrc32c) {
+  std::string const prefix = "The quick";
+  std::string const suffix = " brown fox jumps over the lazy dog";
+  Crc32cHashFunction first;
+  Update(first, suffix);
+  auto const suffix_crc32c = std::move(first).Finish().crc32c;
+
+  Crc32cHashFunction function;
+  Update(function, prefix);
+  EXPECT_STATUS_OK(function.Concat(suffix_crc32c, suffix.size()));
+  auto result = std::move(function).Finish();
+  EXPECT_THAT(result.crc32c, kQuickFoxCrc32cChecksum);
+  EXPECT_THAT(result.md5, IsEmpty());
+}
+
+TEST(HasFunctionImplTest, ConcatCrc32cEmpty) {
+  Crc32cHashFunction function;
+  Update(function, "The quick brown fox jumps over the lazy dog");
+  EXPECT_STATUS_OK(function.Concat(kEmptyStringCrc32cChecksum, 0));
+  function.Concat(std::uint32_t{0}, 0);
+  auto result = std::move(function).Finish();
+  EXPECT_THAT(result.crc32c, kQuickFoxCrc32cChecksum);
+}
+
+TEST(HasFunctionImplTest, ConcatCrc32cInvalid) {
+  Crc32cHashFunction function;
+  Update(function, "The quick brown fox jumps over the lazy dog");
+  // Not valid base64.
+  EXPECT_THAT(function.Concat("not-base64!", 3), Not(IsOk()));
+  // Valid base64, but too long for a CRC32C checksum.
+  EXPECT_THAT(function.Concat(kQuickFoxMD5Hash, 3), Not(IsOk()));
+  auto result = std::move(function).Finish();
+  EXPECT_THAT(result.crc32c, kQuickFoxCrc32cChecksum);
+}
+
 TEST(HasFunctionImplTest, EmptyMD5) {
   MD5HashFunction function;
   auto result = std::move(function).Finish();
@@ -110,6 +149,76 @@ TEST(HasFunctionImplTest, QuickComposite) {
   EXPECT_THAT(result.md5, kQuickFoxMD5Hash);
 }
 
+TEST(HasFunctionImplTest, EmptyBackground) {
+  BackgroundHashFunction function(absl::make_unique<MD5HashFunction>());
+  EXPECT_EQ("background(md5)", function.Name());
+  auto result = std::move(function).Finish();
+  EXPECT_THAT(result.crc32c, IsEmpty());
+  EXPECT_THAT(result.md5, kEmptyStringMD5Hash);
+}
+
+TEST(HasFunctionImplTest, QuickBackground) {
+  BackgroundHashFunction function(absl::make_unique<CompositeFunction>(
+      absl::make_unique<MD5HashFunction>(),
+      absl::make_unique<Crc32cHashFunction>()));
+  Update(function, "The quick");
+  Update(function, " brown");
+  Update(function, "");
+  Update(function, " fox jumps over the lazy dog");
+  auto result = std::move(function).Finish();
+  EXPECT_THAT(result.crc32c, kQuickFoxCrc32cChecksum);
+  EXPECT_THAT(result.md5, kQuickFoxMD5Hash);
+}
+
+TEST(HasFunctionImplTest, LargeBackground) {
+  // Queue more data than the background function buffers, and reuse the
+  // caller's buffer between calls, as the streams do.
+  std::string buffer(1024 * 1024, '\0');
+  MD5HashFunction expected_function;
+  BackgroundHashFunction function(absl::make_unique<MD5HashFunction>());
+  for (int i = 0; i != 64; ++i) {
+    std::fill(buffer.begin(), buffer.end(), static_cast<char>('a' + i % 26));
+    Update(expected_function, buffer);
+    Update(function, buffer);
+  }
+  auto const expected = std::move(expected_function).Finish();
+  auto const actual = std::move(function).Finish();
+  EXPECT_EQ(expected.md5, actual.md5);
+}
+
+TEST(HasFunctionImplTest, DestroyBackgroundWithoutFinish) {
+  std::string const buffer(1024 * 1024, 'x');
+  auto function = absl::make_unique<BackgroundHashFunction>(
+      absl::make_unique<MD5HashFunction>());
+  for (int i = 0; i != 16; ++i) Update(*function, buffer);
+  // This should not block or crash.
+  function.reset();
+}
+
+TEST(HasFunctionImplTest, CreateHashFunctionBackground) {
+  auto function = CreateHashFunction(
+      ReadObjectRangeRequest("test-bucket", "test-object")
+          .set_multiple_options(DisableMD5Hash(false), UseBackgroundHashing()));
+  EXPECT_EQ("composite(crc32c,background(md5))", function->Name());
+  Update(*function, "The quick brown fox jumps over the lazy dog");
+  auto const actual = std::move(*function).Finish();
+  EXPECT_EQ(kQuickFoxCrc32cChecksum, actual.crc32c);
+  EXPECT_EQ(kQuickFoxMD5Hash, actual.md5);
+
+  function = CreateHashFunction(
+      ResumableUploadRequest("test-bucket", "test-object")
+          .set_multiple_options(DisableCrc32cChecksum(true),
+                                DisableMD5Hash(false),
+                                UseBackgroundHashing(true)));
+  EXPECT_EQ("background(md5)", function->Name());
+
+  // MD5 disabled, so there is nothing to run in the background.
+  function = CreateHashFunction(
+      ResumableUploadRequest("test-bucket", "test-object")
+          .set_multiple_options(DisableMD5Hash(true), UseBackgroundHashing()));
+  EXPECT_EQ("crc32c", function->Name());
+}
+
 TEST(HasFunctionImplTest, CreateHashFunctionRead) {
   struct Test {
     std::string crc32c_expected;
@@ -50,6 +50,11 @@ std::unique_ptr<HashValidator> CreateNullHashValidator() {
 std::unique_ptr<HashValidator> CreateHashValidator(
     ReadObjectRangeRequest const& request) {
   if (request.RequiresRangeHeader()) return CreateNullHashValidator();
+  // `GzipObjectReadSource` validates the checksums of decompressed downloads,
+  // as they apply to the compressed data.
+  if (request.GetOption<DecompressGzip>().value_or(false)) {
+    return CreateNullHashValidator();
+  }
 
   // `DisableMD5Hash`'s default value is `true`.
   auto disable_md5 = request.GetOption<DisableMD5Hash>().value_or(false);
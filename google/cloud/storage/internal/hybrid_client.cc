@@ -13,20 +13,92 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/hybrid_client.h"
+#include "google/cloud/storage/grpc_plugin.h"
 #include "google/cloud/storage/internal/grpc_resumable_upload_session_url.h"
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include <algorithm>
+#include <chrono>
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+namespace {
+
+absl::optional<std::uint64_t> DownloadSize(
+    ReadObjectRangeRequest const& request) {
+  if (request.HasOption<ReadLast>()) {
+    return static_cast<std::uint64_t>(
+        (std::max)(request.GetOption<ReadLast>().value(), std::int64_t{0}));
+  }
+  if (!request.HasOption<ReadRange>()) return absl::nullopt;
+  auto const range = request.GetOption<ReadRange>().value();
+  auto const offset = request.GetOption<ReadFromOffset>().value_or(0);
+  auto const begin = (std::max)(range.begin, offset);
+  if (range.end <= begin) return 0;
+  return static_cast<std::uint64_t>(range.end - begin);
+}
+
+/// Reports the throughput of completed downloads to the router.
+class TimedReadSource : public ObjectReadSource {
+ public:
+  TimedReadSource(std::unique_ptr<ObjectReadSource> child,
+                  std::shared_ptr<HybridRouter> router, HybridRoute route,
+                  std::chrono::steady_clock::time_point start)
+      : child_(std::move(child)),
+        router_(std::move(router)),
+        route_(route),
+        start_(start) {}
+
+  bool IsOpen() const override { return child_->IsOpen(); }
+  StatusOr<HttpResponse> Close() override { return child_->Close(); }
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override {
+    auto result = child_->Read(buf, n);
+    if (!result) return result;
+    size_ += result->bytes_received;
+    // Downloads closed early, or failed, are not representative.
+    if (!child_->IsOpen() &&
+        result->response.status_code < HttpStatusCode::kMinNotSuccess) {
+      router_->OnTransfer(route_, size_,
+                          std::chrono::steady_clock::now() - start_);
+    }
+    return result;
+  }
+
+ private:
+  std::unique_ptr<ObjectReadSource> child_;
+  std::shared_ptr<HybridRouter> router_;
+  HybridRoute route_;
+  std::chrono::steady_clock::time_point start_;
+  std::uint64_t size_ = 0;
+};
+
+}  // namespace
 
 std::shared_ptr<RawClient> HybridClient::Create(Options const& options) {
-  return std::shared_ptr<RawClient>(new HybridClient(options));
+  return Create(GrpcClient::Create(options), CurlClient::Create(options),
+                options);
 }
 
-HybridClient::HybridClient(Options const& options)
-    : grpc_(GrpcClient::Create(options)), curl_(CurlClient::Create(options)) {}
+std::shared_ptr<HybridClient> HybridClient::Create(
+    std::shared_ptr<RawClient> grpc, std::shared_ptr<RawClient> curl,
+    Options const& options) {
+  return std::shared_ptr<HybridClient>(
+      new HybridClient(std::move(grpc), std::move(curl), options));
+}
+
+HybridClient::HybridClient(std::shared_ptr<RawClient> grpc,
+                           std::shared_ptr<RawClient> curl,
+                           Options const& options)
+    : grpc_(std::move(grpc)),
+      curl_(std::move(curl)),
+      router_(std::make_shared<HybridRouter>(
+          options.get<storage_experimental::GrpcMediaThresholdOption>(),
+          options
+              .get<storage_experimental::GrpcMediaAdaptiveThresholdOption>())) {
+}
 
 ClientOptions const& HybridClient::client_options() const {
   return curl_->client_options();
@@ -95,7 +167,14 @@ StatusOr<BucketMetadata> HybridClient::LockBucketRetentionPolicy(
 
 StatusOr<ObjectMetadata> HybridClient::InsertObjectMedia(
     InsertObjectMediaRequest const& request) {
-  return grpc_->InsertObjectMedia(request);
+  auto const size = static_cast<std::uint64_t>(request.contents().size());
+  auto const route = router_->Route(size);
+  auto const start = std::chrono::steady_clock::now();
+  auto response = Select(route).InsertObjectMedia(request);
+  if (response) {
+    router_->OnTransfer(route, size, std::chrono::steady_clock::now() - start);
+  }
+  return response;
 }
 
 StatusOr<ObjectMetadata> HybridClient::CopyObject(
@@ -110,7 +189,14 @@ StatusOr<ObjectMetadata> HybridClient::GetObjectMetadata(
 
 StatusOr<std::unique_ptr<ObjectReadSource>> HybridClient::ReadObject(
     ReadObjectRangeRequest const& request) {
-  return grpc_->ReadObject(request);
+  auto const size = DownloadSize(request);
+  auto const route = size ? router_->Route(*size) : router_->RouteUnknownSize();
+  auto const start = std::chrono::steady_clock::now();
+  auto source = Select(route).ReadObject(request);
+  if (!source || !size || !router_->adaptive()) return source;
+  return std::unique_ptr<ObjectReadSource>(
+      absl::make_unique<TimedReadSource>(*std::move(source), router_, route,
+                                         start));
 }
 
 StatusOr<ListObjectsResponse> HybridClient::ListObjects(
@@ -145,7 +231,14 @@ StatusOr<RewriteObjectResponse> HybridClient::RewriteObject(
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
 HybridClient::CreateResumableSession(ResumableUploadRequest const& request) {
-  return grpc_->CreateResumableSession(request);
+  // The sessions created with the JSON API are restored with the JSON API too,
+  // see `RestoreResumableSession()`.
+  auto const route =
+      request.HasOption<UploadContentLength>()
+          ? router_->Route(static_cast<std::uint64_t>(
+                request.GetOption<UploadContentLength>().value()))
+          : router_->RouteUnknownSize();
+  return Select(route).CreateResumableSession(request);
 }
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
@@ -164,6 +257,11 @@ StatusOr<EmptyResponse> HybridClient::DeleteResumableUpload(
   return curl_->DeleteResumableUpload(request);
 }
 
+StatusOr<ExecuteBatchResponse> HybridClient::ExecuteBatch(
+    ExecuteBatchRequest const& request) {
+  return curl_->ExecuteBatch(request);
+}
+
 StatusOr<ListBucketAclResponse> HybridClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   return curl_->ListBucketAcl(request);
@@ -17,8 +17,10 @@
 
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/grpc_client.h"
+#include "google/cloud/storage/internal/hybrid_router.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/version.h"
+#include <memory>
 #include <string>
 
 namespace google {
@@ -27,11 +29,26 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
+/**
+ * Uses the JSON API for metadata requests, and gRPC for media requests.
+ *
+ * Uploads and downloads smaller than the `GrpcMediaThresholdOption` also use
+ * the JSON API, see `HybridRouter` for details.
+ */
 class HybridClient : public RawClient {
  public:
   static std::shared_ptr<RawClient> Create(Options const& options);
+
+  /// Mostly used for unit testing, uses the given @p grpc and @p curl clients.
+  static std::shared_ptr<HybridClient> Create(std::shared_ptr<RawClient> grpc,
+                                              std::shared_ptr<RawClient> curl,
+                                              Options const& options);
+
   ~HybridClient() override = default;
 
+  /// The number of media requests, and their bytes, sent over each transport.
+  HybridRouteCounters route_counters() const { return router_->counters(); }
+
   ClientOptions const& client_options() const override;
 
   StatusOr<ListBucketsResponse> ListBuckets(
@@ -84,6 +101,8 @@ class HybridClient : public RawClient {
       std::string const& upload_id) override;
   StatusOr<EmptyResponse> DeleteResumableUpload(
       DeleteResumableUploadRequest const& request) override;
+  StatusOr<ExecuteBatchResponse> ExecuteBatch(
+      ExecuteBatchRequest const& request) override;
 
   StatusOr<ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const& request) override;
@@ -145,10 +164,16 @@ class HybridClient : public RawClient {
       DeleteNotificationRequest const&) override;
 
  private:
-  explicit HybridClient(Options const& options);
+  HybridClient(std::shared_ptr<RawClient> grpc,
+               std::shared_ptr<RawClient> curl, Options const& options);
+
+  RawClient& Select(HybridRoute route) {
+    return route == HybridRoute::kGrpc ? *grpc_ : *curl_;
+  }
 
-  std::shared_ptr<GrpcClient> grpc_;
-  std::shared_ptr<CurlClient> curl_;
+  std::shared_ptr<RawClient> grpc_;
+  std::shared_ptr<RawClient> curl_;
+  std::shared_ptr<HybridRouter> router_;
 };
 
 }  // namespace internal
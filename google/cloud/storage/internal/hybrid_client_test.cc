@@ -0,0 +1,144 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/hybrid_client.h"
+#include "google/cloud/storage/grpc_plugin.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::MockObjectReadSource;
+using ::google::cloud::storage::testing::MockResumableUploadSession;
+using ::testing::Return;
+
+std::shared_ptr<HybridClient> MakeClient(std::shared_ptr<MockClient> grpc,
+                                         std::shared_ptr<MockClient> curl) {
+  return HybridClient::Create(
+      std::move(grpc), std::move(curl),
+      Options{}.set<storage_experimental::GrpcMediaThresholdOption>(1000));
+}
+
+TEST(HybridClientTest, InsertObjectMediaBySize) {
+  auto grpc = std::make_shared<MockClient>();
+  auto curl = std::make_shared<MockClient>();
+  EXPECT_CALL(*curl, InsertObjectMedia)
+      .WillOnce(Return(make_status_or(ObjectMetadata{})));
+  EXPECT_CALL(*grpc, InsertObjectMedia)
+      .WillOnce(Return(make_status_or(ObjectMetadata{})));
+
+  auto client = MakeClient(grpc, curl);
+  EXPECT_STATUS_OK(client->InsertObjectMedia(
+      InsertObjectMediaRequest("test-bucket", "small", std::string(10, 'a'))));
+  EXPECT_STATUS_OK(client->InsertObjectMedia(InsertObjectMediaRequest(
+      "test-bucket", "large", std::string(2000, 'a'))));
+
+  auto const counters = client->route_counters();
+  EXPECT_EQ(1, counters.curl_requests);
+  EXPECT_EQ(10, counters.curl_bytes);
+  EXPECT_EQ(1, counters.grpc_requests);
+  EXPECT_EQ(2000, counters.grpc_bytes);
+}
+
+TEST(HybridClientTest, ReadObjectBySize) {
+  auto grpc = std::make_shared<MockClient>();
+  auto curl = std::make_shared<MockClient>();
+  EXPECT_CALL(*curl, ReadObject).Times(2).WillRepeatedly([](
+                                     ReadObjectRangeRequest const&) {
+    return std::unique_ptr<ObjectReadSource>(
+        absl::make_unique<MockObjectReadSource>());
+  });
+  EXPECT_CALL(*grpc, ReadObject).Times(3).WillRepeatedly([](
+                                     ReadObjectRangeRequest const&) {
+    return std::unique_ptr<ObjectReadSource>(
+        absl::make_unique<MockObjectReadSource>());
+  });
+
+  auto client = MakeClient(grpc, curl);
+  ReadObjectRangeRequest small("test-bucket", "test");
+  small.set_option(ReadRange(0, 100));
+  EXPECT_STATUS_OK(client->ReadObject(small));
+  ReadObjectRangeRequest last("test-bucket", "test");
+  last.set_option(ReadLast(100));
+  EXPECT_STATUS_OK(client->ReadObject(last));
+
+  ReadObjectRangeRequest large("test-bucket", "test");
+  large.set_option(ReadRange(0, 2000));
+  EXPECT_STATUS_OK(client->ReadObject(large));
+  // The size of these downloads is unknown.
+  EXPECT_STATUS_OK(client->ReadObject(ReadObjectRangeRequest("b", "o")));
+  ReadObjectRangeRequest offset("test-bucket", "test");
+  offset.set_option(ReadFromOffset(100));
+  EXPECT_STATUS_OK(client->ReadObject(offset));
+
+  auto const counters = client->route_counters();
+  EXPECT_EQ(2, counters.curl_requests);
+  EXPECT_EQ(3, counters.grpc_requests);
+}
+
+TEST(HybridClientTest, CreateResumableSessionBySize) {
+  auto grpc = std::make_shared<MockClient>();
+  auto curl = std::make_shared<MockClient>();
+  EXPECT_CALL(*curl, CreateResumableSession)
+      .WillOnce([](ResumableUploadRequest const&) {
+        return std::unique_ptr<ResumableUploadSession>(
+            absl::make_unique<MockResumableUploadSession>());
+      });
+  EXPECT_CALL(*grpc, CreateResumableSession)
+      .Times(2)
+      .WillRepeatedly([](ResumableUploadRequest const&) {
+        return std::unique_ptr<ResumableUploadSession>(
+            absl::make_unique<MockResumableUploadSession>());
+      });
+
+  auto client = MakeClient(grpc, curl);
+  ResumableUploadRequest small("test-bucket", "test");
+  small.set_option(UploadContentLength(100));
+  EXPECT_STATUS_OK(client->CreateResumableSession(small));
+  ResumableUploadRequest large("test-bucket", "test");
+  large.set_option(UploadContentLength(2000));
+  EXPECT_STATUS_OK(client->CreateResumableSession(large));
+  EXPECT_STATUS_OK(client->CreateResumableSession(
+      ResumableUploadRequest("test-bucket", "test")));
+}
+
+TEST(HybridClientTest, DefaultUsesGrpcForMedia) {
+  auto grpc = std::make_shared<MockClient>();
+  auto curl = std::make_shared<MockClient>();
+  EXPECT_CALL(*grpc, InsertObjectMedia)
+      .WillOnce(Return(make_status_or(ObjectMetadata{})));
+  EXPECT_CALL(*curl, GetObjectMetadata)
+      .WillOnce(Return(make_status_or(ObjectMetadata{})));
+
+  auto client = HybridClient::Create(grpc, curl, Options{});
+  EXPECT_STATUS_OK(client->InsertObjectMedia(
+      InsertObjectMediaRequest("test-bucket", "small", std::string(10, 'a'))));
+  EXPECT_STATUS_OK(
+      client->GetObjectMetadata(GetObjectMetadataRequest("test-bucket", "o")));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,134 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/hybrid_router.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// One in this many requests near the threshold uses the other transport.
+auto constexpr kProbeInterval = 8;
+// The number of samples needed, for each transport, before comparing them.
+auto constexpr kMinSamples = 4;
+// The weight of each new sample in the moving average.
+auto constexpr kSmoothing = 0.25;
+// A transport must be this much faster to change the threshold.
+auto constexpr kMargin = 1.1;
+// The threshold changes by at most this factor from its initial value.
+auto constexpr kMaxAdjustment = 16;
+
+HybridRoute Other(HybridRoute route) {
+  return route == HybridRoute::kGrpc ? HybridRoute::kCurl : HybridRoute::kGrpc;
+}
+
+int Index(HybridRoute route) { return route == HybridRoute::kGrpc ? 1 : 0; }
+
+}  // namespace
+
+HybridRouter::HybridRouter(std::uint64_t threshold, bool adaptive)
+    : min_threshold_((std::max)(threshold / kMaxAdjustment, std::uint64_t{1})),
+      max_threshold_(threshold * kMaxAdjustment),
+      adaptive_(adaptive && threshold != 0),
+      threshold_(threshold) {}
+
+HybridRoute HybridRouter::Route(std::uint64_t size) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto route = size >= threshold_ ? HybridRoute::kGrpc : HybridRoute::kCurl;
+  if (adaptive_ && size >= threshold_ / 2 && size / 2 < threshold_ &&
+      ++band_requests_ % kProbeInterval == 0) {
+    route = Other(route);
+  }
+  Count(route, size);
+  return route;
+}
+
+HybridRoute HybridRouter::RouteUnknownSize() {
+  std::lock_guard<std::mutex> lk(mu_);
+  Count(HybridRoute::kGrpc, 0);
+  return HybridRoute::kGrpc;
+}
+
+void HybridRouter::OnTransfer(HybridRoute route, std::uint64_t size,
+                              std::chrono::nanoseconds elapsed) {
+  if (!adaptive_ || elapsed.count() <= 0) return;
+  auto const throughput =
+      static_cast<double>(size) /
+      std::chrono::duration_cast<std::chrono::duration<double>>(elapsed)
+          .count();
+
+  std::lock_guard<std::mutex> lk(mu_);
+  if (size < threshold_ / 2 || size / 2 >= threshold_) return;
+  auto& e = estimates_[size >= threshold_ ? 1 : 0][Index(route)];
+  e.throughput = e.samples == 0 ? throughput
+                                : kSmoothing * throughput +
+                                      (1 - kSmoothing) * e.throughput;
+  ++e.samples;
+
+  auto const curl = Index(HybridRoute::kCurl);
+  auto const grpc = Index(HybridRoute::kGrpc);
+  auto const ready = [](Estimate const(&half)[2]) {
+    return half[0].samples >= kMinSamples && half[1].samples >= kMinSamples;
+  };
+  // Compare the transports only with requests of similar sizes.
+  auto const& upper = estimates_[1];
+  if (ready(upper) &&
+      upper[curl].throughput > kMargin * upper[grpc].throughput) {
+    threshold_ = (std::min)(threshold_ * 2, max_threshold_);
+    Reset();
+    return;
+  }
+  auto const& lower = estimates_[0];
+  if (ready(lower) &&
+      lower[grpc].throughput > kMargin * lower[curl].throughput) {
+    threshold_ = (std::max)(threshold_ / 2, min_threshold_);
+    Reset();
+  }
+}
+
+std::uint64_t HybridRouter::threshold() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return threshold_;
+}
+
+HybridRouteCounters HybridRouter::counters() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return counters_;
+}
+
+void HybridRouter::Count(HybridRoute route, std::uint64_t size) {
+  if (route == HybridRoute::kGrpc) {
+    ++counters_.grpc_requests;
+    counters_.grpc_bytes += size;
+    return;
+  }
+  ++counters_.curl_requests;
+  counters_.curl_bytes += size;
+}
+
+void HybridRouter::Reset() {
+  for (auto& half : estimates_) {
+    for (auto& e : half) e = Estimate{};
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,104 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HYBRID_ROUTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HYBRID_ROUTER_H
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// The transports used by `HybridClient`.
+enum class HybridRoute { kCurl, kGrpc };
+
+/// The number of media requests, and their bytes, sent over each transport.
+struct HybridRouteCounters {
+  std::uint64_t curl_requests = 0;
+  std::uint64_t curl_bytes = 0;
+  std::uint64_t grpc_requests = 0;
+  std::uint64_t grpc_bytes = 0;
+};
+
+/**
+ * Picks the transport for media (upload and download) requests.
+ *
+ * Requests transferring at least `threshold` bytes, or an unknown number of
+ * bytes, use gRPC. Smaller requests use the JSON API over libcurl, where a
+ * round trip is cheaper.
+ *
+ * With @p adaptive enabled the router adjusts the threshold from the
+ * throughput observed for requests between half and twice the threshold.
+ * About one in eight requests in this band is sent over the other transport,
+ * so both transports are measured with similar sizes. If curl is faster for
+ * requests above the threshold the threshold doubles, if gRPC is faster for
+ * requests below the threshold it halves. The threshold stays within 1/16 and
+ * 16 times its initial value.
+ */
+class HybridRouter {
+ public:
+  HybridRouter(std::uint64_t threshold, bool adaptive);
+
+  /// Returns the transport for a request transferring @p size bytes.
+  HybridRoute Route(std::uint64_t size);
+
+  /// Returns the transport for a request of unknown size.
+  HybridRoute RouteUnknownSize();
+
+  /**
+   * Records a completed transfer of @p size bytes over @p route, which took
+   * @p elapsed time.
+   */
+  void OnTransfer(HybridRoute route, std::uint64_t size,
+                  std::chrono::nanoseconds elapsed);
+
+  bool adaptive() const { return adaptive_; }
+  std::uint64_t threshold() const;
+  HybridRouteCounters counters() const;
+
+ private:
+  // A moving average of the throughput, in bytes per second.
+  struct Estimate {
+    double throughput = 0;
+    int samples = 0;
+  };
+
+  void Count(HybridRoute route, std::uint64_t size);
+  void Reset();
+
+  std::uint64_t const min_threshold_;
+  std::uint64_t const max_threshold_;
+  bool const adaptive_;
+
+  mutable std::mutex mu_;
+  std::uint64_t threshold_;
+  std::uint64_t band_requests_ = 0;
+  // Indexed by [upper half][route], see the class comments.
+  Estimate estimates_[2][2];
+  HybridRouteCounters counters_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HYBRID_ROUTER_H
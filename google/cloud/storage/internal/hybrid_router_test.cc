@@ -0,0 +1,139 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/hybrid_router.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ms = std::chrono::milliseconds;
+
+TEST(HybridRouterTest, DefaultUsesGrpc) {
+  HybridRouter router(0, true);
+  EXPECT_FALSE(router.adaptive());
+  EXPECT_EQ(HybridRoute::kGrpc, router.Route(0));
+  EXPECT_EQ(HybridRoute::kGrpc, router.Route(1024));
+  EXPECT_EQ(HybridRoute::kGrpc, router.RouteUnknownSize());
+  auto const counters = router.counters();
+  EXPECT_EQ(0, counters.curl_requests);
+  EXPECT_EQ(3, counters.grpc_requests);
+  EXPECT_EQ(1024, counters.grpc_bytes);
+}
+
+TEST(HybridRouterTest, Threshold) {
+  HybridRouter router(1000, false);
+  EXPECT_EQ(HybridRoute::kCurl, router.Route(0));
+  EXPECT_EQ(HybridRoute::kCurl, router.Route(999));
+  EXPECT_EQ(HybridRoute::kGrpc, router.Route(1000));
+  EXPECT_EQ(HybridRoute::kGrpc, router.RouteUnknownSize());
+  auto const counters = router.counters();
+  EXPECT_EQ(2, counters.curl_requests);
+  EXPECT_EQ(999, counters.curl_bytes);
+  EXPECT_EQ(2, counters.grpc_requests);
+  EXPECT_EQ(1000, counters.grpc_bytes);
+}
+
+TEST(HybridRouterTest, NoProbesWithoutAdaptive) {
+  HybridRouter router(1000, false);
+  for (int i = 0; i != 100; ++i) {
+    EXPECT_EQ(HybridRoute::kCurl, router.Route(900));
+    EXPECT_EQ(HybridRoute::kGrpc, router.Route(1100));
+  }
+}
+
+TEST(HybridRouterTest, ProbesNearThreshold) {
+  HybridRouter router(1000, true);
+  for (int i = 0; i != 16; ++i) router.Route(900);
+  for (int i = 0; i != 16; ++i) router.Route(1100);
+  // Requests far from the threshold are never probed.
+  for (int i = 0; i != 16; ++i) router.Route(100);
+  for (int i = 0; i != 16; ++i) router.Route(4000);
+  auto const counters = router.counters();
+  EXPECT_EQ(14 + 2 + 16, counters.curl_requests);
+  EXPECT_EQ(2 + 14 + 16, counters.grpc_requests);
+}
+
+TEST(HybridRouterTest, RaisesThresholdWhenCurlIsFaster) {
+  HybridRouter router(1000, true);
+  for (int i = 0; i != 4; ++i) {
+    router.OnTransfer(HybridRoute::kCurl, 1500, ms(1));
+    EXPECT_EQ(1000, router.threshold());
+    router.OnTransfer(HybridRoute::kGrpc, 1500, ms(10));
+  }
+  EXPECT_EQ(2000, router.threshold());
+}
+
+TEST(HybridRouterTest, LowersThresholdWhenGrpcIsFaster) {
+  HybridRouter router(1000, true);
+  for (int i = 0; i != 4; ++i) {
+    router.OnTransfer(HybridRoute::kCurl, 700, ms(10));
+    EXPECT_EQ(1000, router.threshold());
+    router.OnTransfer(HybridRoute::kGrpc, 700, ms(1));
+  }
+  EXPECT_EQ(500, router.threshold());
+}
+
+TEST(HybridRouterTest, KeepsThresholdWhenSimilar) {
+  HybridRouter router(1000, true);
+  for (int i = 0; i != 20; ++i) {
+    router.OnTransfer(HybridRoute::kCurl, 700, ms(10));
+    router.OnTransfer(HybridRoute::kGrpc, 700, ms(10));
+    router.OnTransfer(HybridRoute::kCurl, 1500, ms(10));
+    router.OnTransfer(HybridRoute::kGrpc, 1500, ms(10));
+  }
+  EXPECT_EQ(1000, router.threshold());
+}
+
+TEST(HybridRouterTest, IgnoresTransfersFarFromThreshold) {
+  HybridRouter router(1000, true);
+  for (int i = 0; i != 20; ++i) {
+    router.OnTransfer(HybridRoute::kCurl, 100, ms(1));
+    router.OnTransfer(HybridRoute::kGrpc, 100, ms(100));
+    router.OnTransfer(HybridRoute::kCurl, 5000, ms(1));
+    router.OnTransfer(HybridRoute::kGrpc, 5000, ms(100));
+  }
+  EXPECT_EQ(1000, router.threshold());
+}
+
+TEST(HybridRouterTest, ThresholdIsBounded) {
+  HybridRouter router(1000, true);
+  for (int i = 0; i != 10; ++i) {
+    auto const size = router.threshold() + router.threshold() / 2;
+    for (int j = 0; j != 4; ++j) {
+      router.OnTransfer(HybridRoute::kCurl, size, ms(1));
+      router.OnTransfer(HybridRoute::kGrpc, size, ms(10));
+    }
+  }
+  EXPECT_EQ(16000, router.threshold());
+  for (int i = 0; i != 20; ++i) {
+    auto const size = router.threshold() - router.threshold() / 4;
+    for (int j = 0; j != 4; ++j) {
+      router.OnTransfer(HybridRoute::kCurl, size, ms(10));
+      router.OnTransfer(HybridRoute::kGrpc, size, ms(1));
+    }
+  }
+  EXPECT_EQ(62, router.threshold());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,405 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/iam_cache_client.h"
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+template <typename Request>
+bool IsCacheable(Request const& request) {
+  // A field mask changes the response, and custom headers may change how the
+  // service handles the request.
+  return !request.template HasOption<Fields>() &&
+         !request.template HasOption<CustomHeader>();
+}
+
+// Bucket names cannot contain a newline, so all the keys for a bucket start
+// with this prefix.
+std::string BucketPrefix(std::string const& bucket_name) {
+  return bucket_name + "\n";
+}
+
+std::string PolicyKey(GetBucketIamPolicyRequest const& request) {
+  auto const version = request.GetOption<RequestedPolicyVersion>().value_or(0);
+  return BucketPrefix(request.bucket_name()) +
+         request.GetOption<UserProject>().value_or("") + "\n" +
+         std::to_string(version);
+}
+
+std::string PermissionsKey(TestBucketIamPermissionsRequest const& request) {
+  auto key = BucketPrefix(request.bucket_name()) +
+             request.GetOption<UserProject>().value_or("");
+  for (auto const& p : request.permissions()) key += "\n" + p;
+  return key;
+}
+
+std::function<bool(std::string const&)> HasPrefix(std::string prefix) {
+  return [prefix](std::string const& key) {
+    return key.compare(0, prefix.size(), prefix) == 0;
+  };
+}
+
+}  // namespace
+
+IamCacheClient::IamCacheClient(std::shared_ptr<RawClient> client,
+                               std::size_t max_entries,
+                               std::chrono::milliseconds ttl,
+                               ClockFunction clock)
+    : client_(std::move(client)),
+      policies_(max_entries, ttl, clock),
+      permissions_(max_entries, ttl, std::move(clock)) {}
+
+/**
+ * Call a `RawClient` member function that may change the permissions on a
+ * bucket.
+ *
+ * The entries are discarded before and after the call: a concurrent lookup may
+ * refresh them while the request is in flight.
+ */
+template <typename Request, typename Response>
+StatusOr<Response> IamCacheClient::CallAndInvalidate(
+    std::string const& bucket_name,
+    StatusOr<Response> (RawClient::*function)(Request const&),
+    Request const& request) {
+  InvalidateBucket(bucket_name);
+  auto response = ((*client_).*function)(request);
+  InvalidateBucket(bucket_name);
+  return response;
+}
+
+ClientOptions const& IamCacheClient::client_options() const {
+  return client_->client_options();
+}
+
+StatusOr<ListBucketsResponse> IamCacheClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return client_->ListBuckets(request);
+}
+
+StatusOr<BucketMetadata> IamCacheClient::CreateBucket(
+    CreateBucketRequest const& request) {
+  return client_->CreateBucket(request);
+}
+
+StatusOr<BucketMetadata> IamCacheClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  return client_->GetBucketMetadata(request);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  return CallAndInvalidate(request.bucket_name(), &RawClient::DeleteBucket,
+                           request);
+}
+
+StatusOr<BucketMetadata> IamCacheClient::UpdateBucket(
+    UpdateBucketRequest const& request) {
+  return CallAndInvalidate(request.metadata().name(), &RawClient::UpdateBucket,
+                           request);
+}
+
+StatusOr<BucketMetadata> IamCacheClient::PatchBucket(
+    PatchBucketRequest const& request) {
+  return CallAndInvalidate(request.bucket(), &RawClient::PatchBucket, request);
+}
+
+StatusOr<IamPolicy> IamCacheClient::GetBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return client_->GetBucketIamPolicy(request);
+}
+
+StatusOr<NativeIamPolicy> IamCacheClient::GetNativeBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  if (!IsCacheable(request)) return client_->GetNativeBucketIamPolicy(request);
+  auto const key = PolicyKey(request);
+  auto stale = policies_.Peek(key);
+  auto policy = policies_.GetOrFetch(key, [this, &request] {
+    return client_->GetNativeBucketIamPolicy(request);
+  });
+  // A different ETag means the policy changed, and the cached permission
+  // checks for this bucket may be stale.
+  if (policy && stale && stale->etag() != policy->etag()) {
+    InvalidatePermissions(request.bucket_name());
+  }
+  return policy;
+}
+
+StatusOr<IamPolicy> IamCacheClient::SetBucketIamPolicy(
+    SetBucketIamPolicyRequest const& request) {
+  return CallAndInvalidate(request.bucket_name(),
+                           &RawClient::SetBucketIamPolicy, request);
+}
+
+StatusOr<NativeIamPolicy> IamCacheClient::SetNativeBucketIamPolicy(
+    SetNativeBucketIamPolicyRequest const& request) {
+  return CallAndInvalidate(request.bucket_name(),
+                           &RawClient::SetNativeBucketIamPolicy, request);
+}
+
+StatusOr<TestBucketIamPermissionsResponse>
+IamCacheClient::TestBucketIamPermissions(
+    TestBucketIamPermissionsRequest const& request) {
+  if (!IsCacheable(request)) return client_->TestBucketIamPermissions(request);
+  return permissions_.GetOrFetch(PermissionsKey(request), [this, &request] {
+    return client_->TestBucketIamPermissions(request);
+  });
+}
+
+StatusOr<BucketMetadata> IamCacheClient::LockBucketRetentionPolicy(
+    LockBucketRetentionPolicyRequest const& request) {
+  return client_->LockBucketRetentionPolicy(request);
+}
+
+StatusOr<ObjectMetadata> IamCacheClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return client_->InsertObjectMedia(request);
+}
+
+StatusOr<ObjectMetadata> IamCacheClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return client_->CopyObject(request);
+}
+
+StatusOr<ObjectMetadata> IamCacheClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return client_->GetObjectMetadata(request);
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>> IamCacheClient::ReadObject(
+    ReadObjectRangeRequest const& request) {
+  return client_->ReadObject(request);
+}
+
+StatusOr<ListObjectsResponse> IamCacheClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return client_->ListObjects(request);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  return client_->DeleteObject(request);
+}
+
+StatusOr<ObjectMetadata> IamCacheClient::UpdateObject(
+    UpdateObjectRequest const& request) {
+  return client_->UpdateObject(request);
+}
+
+StatusOr<ObjectMetadata> IamCacheClient::PatchObject(
+    PatchObjectRequest const& request) {
+  return client_->PatchObject(request);
+}
+
+StatusOr<ObjectMetadata> IamCacheClient::ComposeObject(
+    ComposeObjectRequest const& request) {
+  return client_->ComposeObject(request);
+}
+
+StatusOr<RewriteObjectResponse> IamCacheClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return client_->RewriteObject(request);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+IamCacheClient::CreateResumableSession(ResumableUploadRequest const& request) {
+  return client_->CreateResumableSession(request);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+IamCacheClient::RestoreResumableSession(std::string const& session_id) {
+  return client_->RestoreResumableSession(session_id);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteResumableUpload(
+    DeleteResumableUploadRequest const& request) {
+  return client_->DeleteResumableUpload(request);
+}
+
+StatusOr<ExecuteBatchResponse> IamCacheClient::ExecuteBatch(
+    ExecuteBatchRequest const& request) {
+  return client_->ExecuteBatch(request);
+}
+
+StatusOr<ListBucketAclResponse> IamCacheClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return client_->ListBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> IamCacheClient::CreateBucketAcl(
+    CreateBucketAclRequest const& request) {
+  return CallAndInvalidate(request.bucket_name(), &RawClient::CreateBucketAcl,
+                           request);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteBucketAcl(
+    DeleteBucketAclRequest const& request) {
+  return CallAndInvalidate(request.bucket_name(), &RawClient::DeleteBucketAcl,
+                           request);
+}
+
+StatusOr<BucketAccessControl> IamCacheClient::GetBucketAcl(
+    GetBucketAclRequest const& request) {
+  return client_->GetBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> IamCacheClient::UpdateBucketAcl(
+    UpdateBucketAclRequest const& request) {
+  return CallAndInvalidate(request.bucket_name(), &RawClient::UpdateBucketAcl,
+                           request);
+}
+
+StatusOr<BucketAccessControl> IamCacheClient::PatchBucketAcl(
+    PatchBucketAclRequest const& request) {
+  return CallAndInvalidate(request.bucket_name(), &RawClient::PatchBucketAcl,
+                           request);
+}
+
+StatusOr<ListObjectAclResponse> IamCacheClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return client_->ListObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  return client_->CreateObjectAcl(request);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteObjectAcl(
+    DeleteObjectAclRequest const& request) {
+  return client_->DeleteObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::GetObjectAcl(
+    GetObjectAclRequest const& request) {
+  return client_->GetObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  return client_->UpdateObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  return client_->PatchObjectAcl(request);
+}
+
+StatusOr<ListDefaultObjectAclResponse> IamCacheClient::ListDefaultObjectAcl(
+    ListDefaultObjectAclRequest const& request) {
+  return client_->ListDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::CreateDefaultObjectAcl(
+    CreateDefaultObjectAclRequest const& request) {
+  return client_->CreateDefaultObjectAcl(request);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteDefaultObjectAcl(
+    DeleteDefaultObjectAclRequest const& request) {
+  return client_->DeleteDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::GetDefaultObjectAcl(
+    GetDefaultObjectAclRequest const& request) {
+  return client_->GetDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::UpdateDefaultObjectAcl(
+    UpdateDefaultObjectAclRequest const& request) {
+  return client_->UpdateDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> IamCacheClient::PatchDefaultObjectAcl(
+    PatchDefaultObjectAclRequest const& request) {
+  return client_->PatchDefaultObjectAcl(request);
+}
+
+StatusOr<ServiceAccount> IamCacheClient::GetServiceAccount(
+    GetProjectServiceAccountRequest const& request) {
+  return client_->GetServiceAccount(request);
+}
+
+StatusOr<ListHmacKeysResponse> IamCacheClient::ListHmacKeys(
+    ListHmacKeysRequest const& request) {
+  return client_->ListHmacKeys(request);
+}
+
+StatusOr<CreateHmacKeyResponse> IamCacheClient::CreateHmacKey(
+    CreateHmacKeyRequest const& request) {
+  return client_->CreateHmacKey(request);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteHmacKey(
+    DeleteHmacKeyRequest const& request) {
+  return client_->DeleteHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> IamCacheClient::GetHmacKey(
+    GetHmacKeyRequest const& request) {
+  return client_->GetHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> IamCacheClient::UpdateHmacKey(
+    UpdateHmacKeyRequest const& request) {
+  return client_->UpdateHmacKey(request);
+}
+
+StatusOr<SignBlobResponse> IamCacheClient::SignBlob(
+    SignBlobRequest const& request) {
+  return client_->SignBlob(request);
+}
+
+StatusOr<ListNotificationsResponse> IamCacheClient::ListNotifications(
+    ListNotificationsRequest const& request) {
+  return client_->ListNotifications(request);
+}
+
+StatusOr<NotificationMetadata> IamCacheClient::CreateNotification(
+    CreateNotificationRequest const& request) {
+  return client_->CreateNotification(request);
+}
+
+StatusOr<NotificationMetadata> IamCacheClient::GetNotification(
+    GetNotificationRequest const& request) {
+  return client_->GetNotification(request);
+}
+
+StatusOr<EmptyResponse> IamCacheClient::DeleteNotification(
+    DeleteNotificationRequest const& request) {
+  return client_->DeleteNotification(request);
+}
+
+void IamCacheClient::InvalidateBucket(std::string const& bucket_name) {
+  auto pred = HasPrefix(BucketPrefix(bucket_name));
+  policies_.InvalidateIf(pred);
+  permissions_.InvalidateIf(pred);
+}
+
+void IamCacheClient::InvalidatePermissions(std::string const& bucket_name) {
+  permissions_.InvalidateIf(HasPrefix(BucketPrefix(bucket_name)));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
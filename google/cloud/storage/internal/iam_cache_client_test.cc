@@ -0,0 +1,192 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/iam_cache_client.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+NativeIamPolicy MakePolicy(std::string etag) {
+  return NativeIamPolicy({}, std::move(etag));
+}
+
+TestBucketIamPermissionsResponse MakePermissions(
+    std::vector<std::string> permissions) {
+  return TestBucketIamPermissionsResponse{std::move(permissions)};
+}
+
+TestBucketIamPermissionsRequest TestRequest() {
+  return TestBucketIamPermissionsRequest(
+      "test-bucket", {"storage.objects.get", "storage.objects.list"});
+}
+
+class IamCacheClientTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<IamCacheClient> MakeClient() {
+    return std::make_shared<IamCacheClient>(mock_, 8, std::chrono::seconds(10),
+                                            [this] { return now_; });
+  }
+
+  std::shared_ptr<testing::MockClient> mock_ =
+      std::make_shared<testing::MockClient>();
+  IamCacheClient::Clock::time_point now_ = IamCacheClient::Clock::now();
+};
+
+TEST_F(IamCacheClientTest, CachesPermissions) {
+  EXPECT_CALL(*mock_, TestBucketIamPermissions)
+      .WillOnce(Return(MakePermissions({"storage.objects.get"})));
+
+  auto client = MakeClient();
+  for (int i = 0; i != 3; ++i) {
+    auto actual = client->TestBucketIamPermissions(TestRequest());
+    ASSERT_STATUS_OK(actual);
+    EXPECT_THAT(actual->permissions, ElementsAre("storage.objects.get"));
+  }
+}
+
+TEST_F(IamCacheClientTest, PermissionsExpire) {
+  EXPECT_CALL(*mock_, TestBucketIamPermissions)
+      .WillOnce(Return(MakePermissions({"storage.objects.get"})))
+      .WillOnce(Return(MakePermissions({})));
+
+  auto client = MakeClient();
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+  now_ += std::chrono::seconds(10);
+  auto actual = client->TestBucketIamPermissions(TestRequest());
+  ASSERT_STATUS_OK(actual);
+  EXPECT_TRUE(actual->permissions.empty());
+}
+
+TEST_F(IamCacheClientTest, DifferentKeysMiss) {
+  EXPECT_CALL(*mock_, TestBucketIamPermissions)
+      .Times(3)
+      .WillRepeatedly(Return(MakePermissions({})));
+
+  auto client = MakeClient();
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(
+      TestBucketIamPermissionsRequest("test-bucket", {"storage.objects.get"})));
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(
+      TestRequest().set_multiple_options(UserProject("other-project"))));
+}
+
+TEST_F(IamCacheClientTest, ErrorsAreNotCached) {
+  EXPECT_CALL(*mock_, TestBucketIamPermissions)
+      .WillOnce(Return(
+          StatusOr<TestBucketIamPermissionsResponse>(PermanentError())))
+      .WillOnce(Return(MakePermissions({})));
+
+  auto client = MakeClient();
+  EXPECT_THAT(client->TestBucketIamPermissions(TestRequest()),
+              StatusIs(PermanentError().code()));
+  EXPECT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+}
+
+TEST_F(IamCacheClientTest, UncacheableRequests) {
+  EXPECT_CALL(*mock_, TestBucketIamPermissions)
+      .Times(2)
+      .WillRepeatedly(Return(MakePermissions({})));
+
+  auto client = MakeClient();
+  for (int i = 0; i != 2; ++i) {
+    ASSERT_STATUS_OK(client->TestBucketIamPermissions(
+        TestRequest().set_multiple_options(Fields("permissions"))));
+  }
+}
+
+TEST_F(IamCacheClientTest, CachesPolicy) {
+  EXPECT_CALL(*mock_, GetNativeBucketIamPolicy)
+      .WillOnce(Return(MakePolicy("etag-1")));
+
+  auto client = MakeClient();
+  for (int i = 0; i != 3; ++i) {
+    auto actual = client->GetNativeBucketIamPolicy(
+        GetBucketIamPolicyRequest("test-bucket"));
+    ASSERT_STATUS_OK(actual);
+    EXPECT_EQ("etag-1", actual->etag());
+  }
+}
+
+TEST_F(IamCacheClientTest, NewEtagDiscardsPermissions) {
+  EXPECT_CALL(*mock_, GetNativeBucketIamPolicy)
+      .WillOnce(Return(MakePolicy("etag-1")))
+      .WillOnce(Return(MakePolicy("etag-1")))
+      .WillOnce(Return(MakePolicy("etag-2")));
+  EXPECT_CALL(*mock_, TestBucketIamPermissions)
+      .Times(3)
+      .WillRepeatedly(Return(MakePermissions({})));
+
+  auto client = MakeClient();
+  GetBucketIamPolicyRequest policy_request("test-bucket");
+  ASSERT_STATUS_OK(client->GetNativeBucketIamPolicy(policy_request));
+  now_ += std::chrono::seconds(5);
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+
+  // Refreshing the policy with the same ETag keeps the permissions.
+  now_ += std::chrono::seconds(5);
+  ASSERT_STATUS_OK(client->GetNativeBucketIamPolicy(policy_request));
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+
+  // Refresh the permissions, then the policy gets a new ETag, which discards
+  // the permissions even though they have not expired.
+  now_ += std::chrono::seconds(5);
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+  now_ += std::chrono::seconds(5);
+  ASSERT_STATUS_OK(client->GetNativeBucketIamPolicy(policy_request));
+  ASSERT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+}
+
+TEST_F(IamCacheClientTest, SetPolicyInvalidates) {
+  EXPECT_CALL(*mock_, GetNativeBucketIamPolicy)
+      .Times(2)
+      .WillRepeatedly(Return(MakePolicy("etag-1")));
+  EXPECT_CALL(*mock_, TestBucketIamPermissions)
+      .Times(2)
+      .WillRepeatedly(Return(MakePermissions({})));
+  EXPECT_CALL(*mock_, SetNativeBucketIamPolicy)
+      .WillOnce(Return(MakePolicy("etag-2")));
+
+  auto client = MakeClient();
+  GetBucketIamPolicyRequest policy_request("test-bucket");
+  for (int i = 0; i != 2; ++i) {
+    ASSERT_STATUS_OK(client->GetNativeBucketIamPolicy(policy_request));
+    ASSERT_STATUS_OK(client->TestBucketIamPermissions(TestRequest()));
+    if (i != 0) continue;
+    ASSERT_STATUS_OK(client->SetNativeBucketIamPolicy(
+        SetNativeBucketIamPolicyRequest("test-bucket", MakePolicy("etag-1"))));
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
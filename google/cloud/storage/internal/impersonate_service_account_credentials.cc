@@ -14,6 +14,8 @@
 
 #include "google/cloud/storage/internal/impersonate_service_account_credentials.h"
 #include "google/cloud/storage/internal/unified_rest_credentials.h"
+#include <algorithm>
+#include <random>
 
 namespace google {
 namespace cloud {
@@ -45,7 +47,10 @@ ImpersonateServiceAccountCredentials::ImpersonateServiceAccountCredentials(
 ImpersonateServiceAccountCredentials::ImpersonateServiceAccountCredentials(
     google::cloud::internal::ImpersonateServiceAccountConfig const& config,
     std::shared_ptr<MinimalIamCredentialsRest> stub)
-    : stub_(std::move(stub)), request_(MakeRequest(config)) {}
+    : stub_(std::move(stub)),
+      request_(MakeRequest(config)),
+      refresh_lead_time_(config.refresh_lead_time()),
+      generator_(google::cloud::internal::MakeDefaultPRNG()) {}
 
 StatusOr<std::string>
 ImpersonateServiceAccountCredentials::AuthorizationHeader() {
@@ -55,14 +60,48 @@ ImpersonateServiceAccountCredentials::AuthorizationHeader() {
 StatusOr<std::string> ImpersonateServiceAccountCredentials::AuthorizationHeader(
     std::chrono::system_clock::time_point now) {
   std::unique_lock<std::mutex> lk(mu_);
-  if (now + kUseSlack <= expiration_) return header_;
+  if (now < refresh_time_ && IsUsable(now)) return header_;
+  // Only one caller refreshes the token, the others use the current token if
+  // it is still usable, and wait for the refresh otherwise.
+  cv_.wait(lk, [&] { return !refreshing_ || IsUsable(now); });
+  if (refreshing_) return header_;
+  if (now < refresh_time_ && IsUsable(now)) return header_;
+
+  refreshing_ = true;
+  lk.unlock();
   auto response = stub_->GenerateAccessToken(request_);
-  if (!response) return std::move(response).status();
+  lk.lock();
+  refreshing_ = false;
+  cv_.notify_all();
+  if (!response) {
+    // Errors are ignored while the current token is still usable, the next
+    // call will try again.
+    if (IsUsable(now)) return header_;
+    return std::move(response).status();
+  }
   expiration_ = response->expiration;
   header_ = "Authorization: Bearer " + response->token;
+  // Refresh between the lead time and half the lead time before the token
+  // expires. The jitter spreads the refresh requests from many processes. Use
+  // at most half the remaining lifetime, short-lived tokens would be refreshed
+  // on every call otherwise.
+  using std::chrono::milliseconds;
+  auto const remaining = (std::max)(
+      milliseconds(0),
+      std::chrono::duration_cast<milliseconds>(expiration_ - now));
+  auto const lead = (std::min)(
+      std::chrono::duration_cast<milliseconds>(refresh_lead_time_),
+      remaining / 2);
+  std::uniform_int_distribution<milliseconds::rep> jitter(0, lead.count() / 2);
+  refresh_time_ = expiration_ - lead + milliseconds(jitter(generator_));
   return header_;
 }
 
+bool ImpersonateServiceAccountCredentials::IsUsable(
+    std::chrono::system_clock::time_point now) const {
+  return now + kUseSlack <= expiration_;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -19,6 +19,10 @@
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/credentials.h"
+#include "google/cloud/internal/random.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 
@@ -28,6 +32,15 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
+/**
+ * Implements service account impersonation for the REST transport.
+ *
+ * The credentials return the current access token, and refresh it once it is
+ * within the refresh lead time (with some jitter) of its expiration. Only one
+ * caller makes the refresh request, the other callers continue to use the
+ * current token. Callers wait for the refresh only if the token has actually
+ * expired.
+ */
 class ImpersonateServiceAccountCredentials : public oauth2::Credentials {
  public:
   explicit ImpersonateServiceAccountCredentials(
@@ -41,11 +54,18 @@ class ImpersonateServiceAccountCredentials : public oauth2::Credentials {
       std::chrono::system_clock::time_point now);
 
  private:
+  bool IsUsable(std::chrono::system_clock::time_point now) const;
+
   std::shared_ptr<MinimalIamCredentialsRest> stub_;
   GenerateAccessTokenRequest request_;
+  std::chrono::seconds refresh_lead_time_;
   std::mutex mu_;
+  std::condition_variable cv_;
   std::string header_;
   std::chrono::system_clock::time_point expiration_;
+  std::chrono::system_clock::time_point refresh_time_;
+  bool refreshing_ = false;
+  google::cloud::internal::DefaultPRNG generator_;
 };
 
 }  // namespace internal
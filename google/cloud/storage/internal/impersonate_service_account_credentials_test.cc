@@ -16,6 +16,7 @@
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <memory>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -25,6 +26,7 @@ namespace internal {
 namespace {
 
 using ::google::cloud::AccessTokenLifetimeOption;
+using ::google::cloud::AccessTokenRefreshLeadTimeOption;
 using ::google::cloud::internal::AccessToken;
 using ::google::cloud::testing_util::IsOk;
 using ::std::chrono::minutes;
@@ -69,6 +71,76 @@ TEST(ImpersonateServiceAccountCredentialsTest, Basic) {
   EXPECT_THAT(*header, EndsWith("token2"));
 }
 
+TEST(ImpersonateServiceAccountCredentialsTest, RefreshLeadTime) {
+  auto const now = std::chrono::system_clock::now();
+
+  auto mock = std::make_shared<MockMinimalIamCredentialsRest>();
+  EXPECT_CALL(*mock, GenerateAccessToken)
+      .WillOnce(
+          Return(make_status_or(AccessToken{"token1", now + minutes(30)})))
+      .WillOnce(
+          Return(make_status_or(AccessToken{"token2", now + minutes(60)})));
+
+  auto config = google::cloud::internal::ImpersonateServiceAccountConfig(
+      google::cloud::MakeGoogleDefaultCredentials(),
+      "test-only-invalid@test.invalid",
+      Options{}.set<AccessTokenRefreshLeadTimeOption>(minutes(10)));
+  ImpersonateServiceAccountCredentials under_test(config, mock);
+
+  // The token is refreshed between 10 and 5 minutes before it expires.
+  for (auto const i : {0, 10, 19}) {
+    SCOPED_TRACE("Testing with i = " + std::to_string(i));
+    auto header = under_test.AuthorizationHeader(now + minutes(i));
+    ASSERT_THAT(header, IsOk());
+    EXPECT_THAT(*header, EndsWith("token1"));
+  }
+  auto header = under_test.AuthorizationHeader(now + minutes(26));
+  ASSERT_THAT(header, IsOk());
+  EXPECT_THAT(*header, EndsWith("token2"));
+}
+
+TEST(ImpersonateServiceAccountCredentialsTest, UseCurrentTokenDuringRefresh) {
+  auto const now = std::chrono::system_clock::now();
+
+  auto mock = std::make_shared<MockMinimalIamCredentialsRest>();
+  auto config = google::cloud::internal::ImpersonateServiceAccountConfig(
+      google::cloud::MakeGoogleDefaultCredentials(),
+      "test-only-invalid@test.invalid",
+      Options{}.set<AccessTokenRefreshLeadTimeOption>(minutes(10)));
+  ImpersonateServiceAccountCredentials under_test(config, mock);
+
+  EXPECT_CALL(*mock, GenerateAccessToken)
+      .WillOnce(
+          Return(make_status_or(AccessToken{"token1", now + minutes(30)})))
+      .WillOnce([&](GenerateAccessTokenRequest const&) {
+        // Other callers use the current token while the refresh is in
+        // progress, and do not start a second refresh.
+        auto header = under_test.AuthorizationHeader(now + minutes(26));
+        EXPECT_THAT(header, IsOk());
+        if (header) {
+          EXPECT_THAT(*header, EndsWith("token1"));
+        }
+        return make_status_or(AccessToken{"token2", now + minutes(60)});
+      })
+      .WillOnce([&](GenerateAccessTokenRequest const&) {
+        // Errors are ignored while the current token is usable.
+        return StatusOr<AccessToken>(
+            Status(StatusCode::kUnavailable, "try-again"));
+      });
+
+  auto header = under_test.AuthorizationHeader(now);
+  ASSERT_THAT(header, IsOk());
+  EXPECT_THAT(*header, EndsWith("token1"));
+
+  header = under_test.AuthorizationHeader(now + minutes(26));
+  ASSERT_THAT(header, IsOk());
+  EXPECT_THAT(*header, EndsWith("token2"));
+
+  header = under_test.AuthorizationHeader(now + minutes(56));
+  ASSERT_THAT(header, IsOk());
+  EXPECT_THAT(*header, EndsWith("token2"));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
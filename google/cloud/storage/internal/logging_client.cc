@@ -225,6 +225,11 @@ StatusOr<EmptyResponse> LoggingClient::DeleteResumableUpload(
                   __func__);
 }
 
+StatusOr<ExecuteBatchResponse> LoggingClient::ExecuteBatch(
+    ExecuteBatchRequest const& request) {
+  return MakeCall(*client_, &RawClient::ExecuteBatch, request, __func__);
+}
+
 StatusOr<ListBucketAclResponse> LoggingClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   return MakeCall(*client_, &RawClient::ListBucketAcl, request, __func__);
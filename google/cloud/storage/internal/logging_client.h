@@ -82,6 +82,8 @@ class LoggingClient : public RawClient {
       std::string const& request) override;
   StatusOr<EmptyResponse> DeleteResumableUpload(
       DeleteResumableUploadRequest const& request) override;
+  StatusOr<ExecuteBatchResponse> ExecuteBatch(
+      ExecuteBatchRequest const& request) override;
 
   StatusOr<ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const& request) override;
@@ -24,12 +24,18 @@ namespace internal {
 StatusOr<std::string> MakeJWTAssertionNoThrow(std::string const& header,
                                               std::string const& payload,
                                               std::string const& pem_contents) {
-  auto const body =
-      UrlsafeBase64Encode(header) + '.' + UrlsafeBase64Encode(payload);
-  auto pem_signature = internal::SignStringWithPem(
-      body, pem_contents, storage::oauth2::JwtSigningAlgorithms::RS256);
-  if (!pem_signature) return std::move(pem_signature).status();
-  return body + '.' + UrlsafeBase64Encode(*pem_signature);
+  auto key = PemPrivateKey::Parse(pem_contents);
+  if (!key) return std::move(key).status();
+  return MakeJWTAssertionNoThrow(UrlsafeBase64Encode(header), payload, *key);
+}
+
+StatusOr<std::string> MakeJWTAssertionNoThrow(std::string const& encoded_header,
+                                              std::string const& payload,
+                                              PemPrivateKey const& key) {
+  auto const body = encoded_header + '.' + UrlsafeBase64Encode(payload);
+  auto signature = key.Sign(body, storage::oauth2::JwtSigningAlgorithms::RS256);
+  if (!signature) return std::move(signature).status();
+  return body + '.' + UrlsafeBase64Encode(*signature);
 }
 
 }  // namespace internal
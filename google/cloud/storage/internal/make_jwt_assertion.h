@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAKE_JWT_ASSERTION_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAKE_JWT_ASSERTION_H
 
+#include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
 #include <string>
@@ -28,6 +29,20 @@ StatusOr<std::string> MakeJWTAssertionNoThrow(std::string const& header,
                                               std::string const& payload,
                                               std::string const& pem_contents);
 
+/**
+ * Creates a JWT assertion using a pre-parsed key and a pre-encoded header.
+ *
+ * Applications that create many assertions with the same key and header
+ * should use this function, it avoids parsing the key and encoding the header
+ * for each assertion.
+ *
+ * @param encoded_header the JWT header, already encoded with
+ *     `UrlsafeBase64Encode()`.
+ */
+StatusOr<std::string> MakeJWTAssertionNoThrow(std::string const& encoded_header,
+                                              std::string const& payload,
+                                              PemPrivateKey const& key);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -61,6 +61,33 @@ TEST(MakeJWTAssertionNoThrow, InvalidKey) {
   ASSERT_THAT(assertion, Not(IsOk()));
 }
 
+TEST(MakeJWTAssertionNoThrow, ParsedKey) {
+  auto header = nlohmann::json{
+      {"alg", "HS256"}, {"typ", "JWT"}, {"kid", "test-key-name"}};
+  auto payload = nlohmann::json{
+      {"iss", "--invalid--@developer.gserviceaccount.com"},
+      {"sub", "--invalid--@developer.gserviceaccount.com"},
+      {"aud", "https//not-a-service.googleapis.com"},
+      {"iat", "1511900000"},
+      {"exp", "1511903600"},
+  };
+  auto const expected = MakeJWTAssertionNoThrow(header.dump(), payload.dump(),
+                                                testing::kWellFormatedKey);
+  ASSERT_THAT(expected, IsOk());
+
+  auto key = PemPrivateKey::Parse(testing::kWellFormatedKey);
+  ASSERT_THAT(key, IsOk());
+  auto const encoded_header = UrlsafeBase64Encode(header.dump());
+  // RS256 signatures are deterministic, both overloads produce the same
+  // assertion.
+  for (int i = 0; i != 2; ++i) {
+    auto const actual =
+        MakeJWTAssertionNoThrow(encoded_header, payload.dump(), *key);
+    ASSERT_THAT(actual, IsOk());
+    EXPECT_EQ(*expected, *actual);
+  }
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
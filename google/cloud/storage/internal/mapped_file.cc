@@ -0,0 +1,131 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file.h"
+#include "google/cloud/internal/strerror.h"
+#include <cerrno>
+#include <sstream>
+#if _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+Status MakeError(StatusCode code, char const* func,
+                 std::string const& file_name, std::string const& what) {
+  std::ostringstream os;
+  os << "MappedFile::" << func << "(" << file_name << "): " << what;
+  return Status(code, std::move(os).str());
+}
+
+#if !_WIN32
+Status ErrnoError(char const* func, std::string const& file_name,
+                  char const* syscall) {
+  auto const error = errno;
+  return MakeError(StatusCode::kUnknown, func, file_name,
+                   std::string(syscall) + "() failed: " +
+                       google::cloud::internal::strerror(error));
+}
+#endif  // !_WIN32
+
+}  // namespace
+
+#if _WIN32
+StatusOr<std::shared_ptr<MappedFile>> MappedFile::Open(
+    std::string const& file_name, std::uintmax_t offset, std::size_t size) {
+  std::ifstream is(file_name, std::ios::binary);
+  if (!is.is_open()) {
+    return MakeError(StatusCode::kNotFound, __func__, file_name,
+                     "cannot open upload file source");
+  }
+  auto file = std::shared_ptr<MappedFile>(new MappedFile);
+  file->buffer_.resize(size);
+  is.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+  is.read(&file->buffer_[0], static_cast<std::streamsize>(size));
+  if (static_cast<std::size_t>(is.gcount()) < size) {
+    return MakeError(StatusCode::kInternal, __func__, file_name,
+                     "file is smaller than the requested region");
+  }
+  file->contents_ = file->buffer_;
+  return file;
+}
+
+MappedFile::~MappedFile() = default;
+#else
+StatusOr<std::shared_ptr<MappedFile>> MappedFile::Open(
+    std::string const& file_name, std::uintmax_t offset, std::size_t size) {
+  auto const fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return MakeError(StatusCode::kNotFound, __func__, file_name,
+                     "cannot open upload file source");
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    auto status = ErrnoError(__func__, file_name, "fstat");
+    ::close(fd);
+    return status;
+  }
+  // Accessing a mapped page past the end of the file raises `SIGBUS`.
+  if (static_cast<std::uintmax_t>(st.st_size) < offset + size) {
+    ::close(fd);
+    return MakeError(StatusCode::kInternal, __func__, file_name,
+                     "file is smaller than the requested region");
+  }
+  auto file = std::shared_ptr<MappedFile>(new MappedFile);
+  if (size == 0) {
+    ::close(fd);
+    return file;
+  }
+  // The offset of a mapping must be a multiple of the page size.
+  auto const page_size = static_cast<std::uintmax_t>(::sysconf(_SC_PAGESIZE));
+  auto const skip = static_cast<std::size_t>(offset % page_size);
+  auto* mapping = ::mmap(nullptr, skip + size, PROT_READ, MAP_PRIVATE, fd,
+                         static_cast<off_t>(offset - skip));
+  if (mapping == MAP_FAILED) {
+    auto status = ErrnoError(__func__, file_name, "mmap");
+    ::close(fd);
+    return status;
+  }
+  // The mapping keeps a reference to the file.
+  ::close(fd);
+  // This is only a hint, the data is read at most once, from start to end.
+  (void)::madvise(mapping, skip + size, MADV_SEQUENTIAL);
+  file->mapping_ = mapping;
+  file->mapping_size_ = skip + size;
+  file->contents_ =
+      absl::string_view(static_cast<char const*>(mapping) + skip, size);
+  return file;
+}
+
+MappedFile::~MappedFile() {
+  if (mapping_ != nullptr) ::munmap(mapping_, mapping_size_);
+}
+#endif  // _WIN32
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
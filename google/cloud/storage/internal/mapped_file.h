@@ -0,0 +1,67 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include "absl/strings/string_view.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A read-only view of a region of a file.
+ *
+ * On POSIX platforms the region is memory mapped, the data is read from the
+ * page cache as it is used, and it is never copied into a user-space buffer.
+ * On other platforms the region is read into a buffer.
+ */
+class MappedFile {
+ public:
+  /// Maps @p size bytes of @p file_name, starting at @p offset.
+  static StatusOr<std::shared_ptr<MappedFile>> Open(
+      std::string const& file_name, std::uintmax_t offset, std::size_t size);
+
+  ~MappedFile();
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  absl::string_view contents() const { return contents_; }
+
+ private:
+  MappedFile() = default;
+
+  void* mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  std::string buffer_;
+  absl::string_view contents_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_H
@@ -0,0 +1,77 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+
+TEST(MappedFileTest, Full) {
+  testing::TempFile temp("0123456789");
+  auto file = MappedFile::Open(temp.name(), 0, 10);
+  ASSERT_STATUS_OK(file);
+  EXPECT_EQ("0123456789", (*file)->contents());
+}
+
+TEST(MappedFileTest, Region) {
+  testing::TempFile temp("0123456789");
+  auto file = MappedFile::Open(temp.name(), 3, 4);
+  ASSERT_STATUS_OK(file);
+  EXPECT_EQ("3456", (*file)->contents());
+}
+
+TEST(MappedFileTest, UnalignedOffset) {
+  // Use an offset past the first page, and not a multiple of the page size.
+  std::string contents(3 * 4096 + 123, 'a');
+  contents += "the tail";
+  testing::TempFile temp(contents);
+  auto file = MappedFile::Open(temp.name(), 3 * 4096 + 123, 8);
+  ASSERT_STATUS_OK(file);
+  EXPECT_EQ("the tail", (*file)->contents());
+}
+
+TEST(MappedFileTest, Empty) {
+  testing::TempFile temp("");
+  auto file = MappedFile::Open(temp.name(), 0, 0);
+  ASSERT_STATUS_OK(file);
+  EXPECT_TRUE((*file)->contents().empty());
+}
+
+TEST(MappedFileTest, NotFound) {
+  auto file = MappedFile::Open("/no/such/file/should/exist", 0, 10);
+  EXPECT_THAT(file, StatusIs(StatusCode::kNotFound));
+}
+
+TEST(MappedFileTest, TooShort) {
+  testing::TempFile temp("0123456789");
+  auto file = MappedFile::Open(temp.name(), 5, 10);
+  EXPECT_THAT(file, StatusIs(StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
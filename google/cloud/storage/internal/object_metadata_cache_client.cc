@@ -0,0 +1,535 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_cache_client.h"
+#include "absl/memory/memory.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/**
+ * Call a `RawClient` member function that may modify an object.
+ *
+ * The entry is discarded before and after the call: a concurrent lookup may
+ * refresh the entry while the request is in flight.
+ */
+template <typename Request, typename Response>
+StatusOr<Response> CallAndInvalidate(
+    ObjectMetadataCache& cache, std::string const& bucket_name,
+    std::string const& object_name, RawClient& client,
+    StatusOr<Response> (RawClient::*function)(Request const&),
+    Request const& request) {
+  cache.Invalidate(bucket_name, object_name);
+  auto response = (client.*function)(request);
+  cache.Invalidate(bucket_name, object_name);
+  return response;
+}
+
+bool IsCacheable(GetObjectMetadataRequest const& request) {
+  // A specific generation or a field mask change the response, and the
+  // remaining preconditions are rare enough to always go to the service.
+  return !request.HasOption<Generation>() &&
+         !request.HasOption<IfGenerationNotMatch>() &&
+         !request.HasOption<IfMetagenerationMatch>() &&
+         !request.HasOption<IfMetagenerationNotMatch>() &&
+         !request.HasOption<IfNoneMatchEtag>() &&
+         !request.HasOption<Fields>() && !request.HasOption<CustomHeader>();
+}
+
+bool SatisfiesPreconditions(GetObjectMetadataRequest const& request,
+                            ObjectMetadata const& metadata) {
+  if (request.HasOption<IfGenerationMatch>() &&
+      request.GetOption<IfGenerationMatch>().value() != metadata.generation()) {
+    return false;
+  }
+  if (request.HasOption<IfMatchEtag>() &&
+      request.GetOption<IfMatchEtag>().value() != metadata.etag()) {
+    return false;
+  }
+  return true;
+}
+
+/// Discards the cached metadata when a resumable upload completes.
+class InvalidatingUploadSession : public ResumableUploadSession {
+ public:
+  InvalidatingUploadSession(std::unique_ptr<ResumableUploadSession> session,
+                            std::shared_ptr<ObjectMetadataCache> cache,
+                            std::string bucket_name, std::string object_name)
+      : session_(std::move(session)),
+        cache_(std::move(cache)),
+        bucket_name_(std::move(bucket_name)),
+        object_name_(std::move(object_name)) {}
+
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      ConstBufferSequence const& buffers) override {
+    return Invalidate(session_->UploadChunk(buffers));
+  }
+  StatusOr<ResumableUploadResponse> UploadFinalChunk(
+      ConstBufferSequence const& buffers, std::uint64_t upload_size,
+      HashValues const& full_object_hashes) override {
+    return Invalidate(session_->UploadFinalChunk(buffers, upload_size,
+                                                 full_object_hashes));
+  }
+  StatusOr<ResumableUploadResponse> ResetSession() override {
+    return Invalidate(session_->ResetSession());
+  }
+  std::uint64_t next_expected_byte() const override {
+    return session_->next_expected_byte();
+  }
+  std::string const& session_id() const override {
+    return session_->session_id();
+  }
+  bool done() const override { return session_->done(); }
+  StatusOr<ResumableUploadResponse> const& last_response() const override {
+    return session_->last_response();
+  }
+
+ private:
+  StatusOr<ResumableUploadResponse> Invalidate(
+      StatusOr<ResumableUploadResponse> response) {
+    if (session_->done()) cache_->Invalidate(bucket_name_, object_name_);
+    return response;
+  }
+
+  std::unique_ptr<ResumableUploadSession> session_;
+  std::shared_ptr<ObjectMetadataCache> cache_;
+  std::string bucket_name_;
+  std::string object_name_;
+};
+
+struct InvalidateVisitor {
+  template <typename Request>
+  void operator()(Request const& request) const {
+    cache.Invalidate(request.bucket_name(), request.object_name());
+  }
+
+  ObjectMetadataCache& cache;
+};
+
+}  // namespace
+
+ObjectMetadataCache::ObjectMetadataCache(std::size_t max_entries,
+                                         std::chrono::milliseconds ttl,
+                                         ClockFunction clock)
+    : max_entries_(max_entries), ttl_(ttl), clock_(std::move(clock)) {}
+
+absl::optional<ObjectMetadata> ObjectMetadataCache::Lookup(
+    std::string const& bucket_name, std::string const& object_name,
+    std::string const& projection, std::string const& user_project) {
+  auto const now = clock_();
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = index_.find(MakeKey(bucket_name, object_name));
+  if (i == index_.end()) return absl::nullopt;
+  auto e = i->second;
+  if (e->expiration <= now) {
+    Erase(lk, e);
+    return absl::nullopt;
+  }
+  if (e->projection != projection || e->user_project != user_project) {
+    return absl::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, e);
+  return e->metadata;
+}
+
+void ObjectMetadataCache::Insert(std::string const& projection,
+                                 std::string const& user_project,
+                                 ObjectMetadata metadata) {
+  if (max_entries_ == 0) return;
+  auto key = MakeKey(metadata.bucket(), metadata.name());
+  auto const expiration = clock_() + ttl_;
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = index_.find(key);
+  if (i != index_.end()) Erase(lk, i->second);
+  while (entries_.size() >= max_entries_) Erase(lk, std::prev(entries_.end()));
+  entries_.push_front(Entry{key, projection, user_project, std::move(metadata),
+                            expiration});
+  index_.emplace(std::move(key), entries_.begin());
+}
+
+void ObjectMetadataCache::Invalidate(std::string const& bucket_name,
+                                     std::string const& object_name) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = index_.find(MakeKey(bucket_name, object_name));
+  if (i == index_.end()) return;
+  Erase(lk, i->second);
+}
+
+std::size_t ObjectMetadataCache::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return entries_.size();
+}
+
+std::string ObjectMetadataCache::MakeKey(std::string const& bucket_name,
+                                         std::string const& object_name) {
+  // Bucket names cannot contain a '/', so the key is unambiguous.
+  return bucket_name + "/" + object_name;
+}
+
+void ObjectMetadataCache::Erase(std::unique_lock<std::mutex> const&,
+                                EntryList::iterator i) {
+  index_.erase(i->key);
+  entries_.erase(i);
+}
+
+ObjectMetadataCacheClient::ObjectMetadataCacheClient(
+    std::shared_ptr<RawClient> client,
+    std::shared_ptr<ObjectMetadataCache> cache)
+    : client_(std::move(client)), cache_(std::move(cache)) {}
+
+ClientOptions const& ObjectMetadataCacheClient::client_options() const {
+  return client_->client_options();
+}
+
+StatusOr<ListBucketsResponse> ObjectMetadataCacheClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return client_->ListBuckets(request);
+}
+
+StatusOr<BucketMetadata> ObjectMetadataCacheClient::CreateBucket(
+    CreateBucketRequest const& request) {
+  return client_->CreateBucket(request);
+}
+
+StatusOr<BucketMetadata> ObjectMetadataCacheClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  return client_->GetBucketMetadata(request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  return client_->DeleteBucket(request);
+}
+
+StatusOr<BucketMetadata> ObjectMetadataCacheClient::UpdateBucket(
+    UpdateBucketRequest const& request) {
+  return client_->UpdateBucket(request);
+}
+
+StatusOr<BucketMetadata> ObjectMetadataCacheClient::PatchBucket(
+    PatchBucketRequest const& request) {
+  return client_->PatchBucket(request);
+}
+
+StatusOr<IamPolicy> ObjectMetadataCacheClient::GetBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return client_->GetBucketIamPolicy(request);
+}
+
+StatusOr<NativeIamPolicy> ObjectMetadataCacheClient::GetNativeBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return client_->GetNativeBucketIamPolicy(request);
+}
+
+StatusOr<IamPolicy> ObjectMetadataCacheClient::SetBucketIamPolicy(
+    SetBucketIamPolicyRequest const& request) {
+  return client_->SetBucketIamPolicy(request);
+}
+
+StatusOr<NativeIamPolicy> ObjectMetadataCacheClient::SetNativeBucketIamPolicy(
+    SetNativeBucketIamPolicyRequest const& request) {
+  return client_->SetNativeBucketIamPolicy(request);
+}
+
+StatusOr<TestBucketIamPermissionsResponse>
+ObjectMetadataCacheClient::TestBucketIamPermissions(
+    TestBucketIamPermissionsRequest const& request) {
+  return client_->TestBucketIamPermissions(request);
+}
+
+StatusOr<BucketMetadata> ObjectMetadataCacheClient::LockBucketRetentionPolicy(
+    LockBucketRetentionPolicyRequest const& request) {
+  return client_->LockBucketRetentionPolicy(request);
+}
+
+StatusOr<ObjectMetadata> ObjectMetadataCacheClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::InsertObjectMedia, request);
+}
+
+StatusOr<ObjectMetadata> ObjectMetadataCacheClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return CallAndInvalidate(*cache_, request.destination_bucket(),
+                           request.destination_object(), *client_,
+                           &RawClient::CopyObject, request);
+}
+
+StatusOr<ObjectMetadata> ObjectMetadataCacheClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  if (!IsCacheable(request)) return client_->GetObjectMetadata(request);
+  auto const projection = request.GetOption<Projection>().value_or("");
+  auto const user_project = request.GetOption<UserProject>().value_or("");
+  auto cached = cache_->Lookup(request.bucket_name(), request.object_name(),
+                               projection, user_project);
+  if (cached) {
+    if (SatisfiesPreconditions(request, *cached)) return *std::move(cached);
+    // The object may have changed since it was cached, let the service decide
+    // if the preconditions are met.
+    cache_->Invalidate(request.bucket_name(), request.object_name());
+  }
+  auto response = client_->GetObjectMetadata(request);
+  if (response) cache_->Insert(projection, user_project, *response);
+  return response;
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>>
+ObjectMetadataCacheClient::ReadObject(ReadObjectRangeRequest const& request) {
+  return client_->ReadObject(request);
+}
+
+StatusOr<ListObjectsResponse> ObjectMetadataCacheClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return client_->ListObjects(request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::DeleteObject, request);
+}
+
+StatusOr<ObjectMetadata> ObjectMetadataCacheClient::UpdateObject(
+    UpdateObjectRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::UpdateObject, request);
+}
+
+StatusOr<ObjectMetadata> ObjectMetadataCacheClient::PatchObject(
+    PatchObjectRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::PatchObject, request);
+}
+
+StatusOr<ObjectMetadata> ObjectMetadataCacheClient::ComposeObject(
+    ComposeObjectRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::ComposeObject, request);
+}
+
+StatusOr<RewriteObjectResponse> ObjectMetadataCacheClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return CallAndInvalidate(*cache_, request.destination_bucket(),
+                           request.destination_object(), *client_,
+                           &RawClient::RewriteObject, request);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+ObjectMetadataCacheClient::CreateResumableSession(
+    ResumableUploadRequest const& request) {
+  cache_->Invalidate(request.bucket_name(), request.object_name());
+  auto session = client_->CreateResumableSession(request);
+  if (!session) return session;
+  return std::unique_ptr<ResumableUploadSession>(
+      absl::make_unique<InvalidatingUploadSession>(
+          *std::move(session), cache_, request.bucket_name(),
+          request.object_name()));
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+ObjectMetadataCacheClient::RestoreResumableSession(
+    std::string const& request) {
+  // The session id does not identify the object, the entry cannot be
+  // invalidated when the upload completes.
+  return client_->RestoreResumableSession(request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteResumableUpload(
+    DeleteResumableUploadRequest const& request) {
+  return client_->DeleteResumableUpload(request);
+}
+
+StatusOr<ExecuteBatchResponse> ObjectMetadataCacheClient::ExecuteBatch(
+    ExecuteBatchRequest const& request) {
+  auto invalidate = [this, &request] {
+    for (auto const& op : request.operations()) {
+      absl::visit(InvalidateVisitor{*cache_}, op);
+    }
+  };
+  invalidate();
+  auto response = client_->ExecuteBatch(request);
+  invalidate();
+  return response;
+}
+
+StatusOr<ListBucketAclResponse> ObjectMetadataCacheClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return client_->ListBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> ObjectMetadataCacheClient::CreateBucketAcl(
+    CreateBucketAclRequest const& request) {
+  return client_->CreateBucketAcl(request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteBucketAcl(
+    DeleteBucketAclRequest const& request) {
+  return client_->DeleteBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> ObjectMetadataCacheClient::GetBucketAcl(
+    GetBucketAclRequest const& request) {
+  return client_->GetBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> ObjectMetadataCacheClient::UpdateBucketAcl(
+    UpdateBucketAclRequest const& request) {
+  return client_->UpdateBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> ObjectMetadataCacheClient::PatchBucketAcl(
+    PatchBucketAclRequest const& request) {
+  return client_->PatchBucketAcl(request);
+}
+
+StatusOr<ListObjectAclResponse> ObjectMetadataCacheClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return client_->ListObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::CreateObjectAcl, request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteObjectAcl(
+    DeleteObjectAclRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::DeleteObjectAcl, request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::GetObjectAcl(
+    GetObjectAclRequest const& request) {
+  return client_->GetObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::UpdateObjectAcl, request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  return CallAndInvalidate(*cache_, request.bucket_name(),
+                           request.object_name(), *client_,
+                           &RawClient::PatchObjectAcl, request);
+}
+
+StatusOr<ListDefaultObjectAclResponse>
+ObjectMetadataCacheClient::ListDefaultObjectAcl(
+    ListDefaultObjectAclRequest const& request) {
+  return client_->ListDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::CreateDefaultObjectAcl(
+    CreateDefaultObjectAclRequest const& request) {
+  return client_->CreateDefaultObjectAcl(request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteDefaultObjectAcl(
+    DeleteDefaultObjectAclRequest const& request) {
+  return client_->DeleteDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::GetDefaultObjectAcl(
+    GetDefaultObjectAclRequest const& request) {
+  return client_->GetDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::UpdateDefaultObjectAcl(
+    UpdateDefaultObjectAclRequest const& request) {
+  return client_->UpdateDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> ObjectMetadataCacheClient::PatchDefaultObjectAcl(
+    PatchDefaultObjectAclRequest const& request) {
+  return client_->PatchDefaultObjectAcl(request);
+}
+
+StatusOr<ServiceAccount> ObjectMetadataCacheClient::GetServiceAccount(
+    GetProjectServiceAccountRequest const& request) {
+  return client_->GetServiceAccount(request);
+}
+
+StatusOr<ListHmacKeysResponse> ObjectMetadataCacheClient::ListHmacKeys(
+    ListHmacKeysRequest const& request) {
+  return client_->ListHmacKeys(request);
+}
+
+StatusOr<CreateHmacKeyResponse> ObjectMetadataCacheClient::CreateHmacKey(
+    CreateHmacKeyRequest const& request) {
+  return client_->CreateHmacKey(request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteHmacKey(
+    DeleteHmacKeyRequest const& request) {
+  return client_->DeleteHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> ObjectMetadataCacheClient::GetHmacKey(
+    GetHmacKeyRequest const& request) {
+  return client_->GetHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> ObjectMetadataCacheClient::UpdateHmacKey(
+    UpdateHmacKeyRequest const& request) {
+  return client_->UpdateHmacKey(request);
+}
+
+StatusOr<SignBlobResponse> ObjectMetadataCacheClient::SignBlob(
+    SignBlobRequest const& request) {
+  return client_->SignBlob(request);
+}
+
+StatusOr<ListNotificationsResponse>
+ObjectMetadataCacheClient::ListNotifications(
+    ListNotificationsRequest const& request) {
+  return client_->ListNotifications(request);
+}
+
+StatusOr<NotificationMetadata> ObjectMetadataCacheClient::CreateNotification(
+    CreateNotificationRequest const& request) {
+  return client_->CreateNotification(request);
+}
+
+StatusOr<NotificationMetadata> ObjectMetadataCacheClient::GetNotification(
+    GetNotificationRequest const& request) {
+  return client_->GetNotification(request);
+}
+
+StatusOr<EmptyResponse> ObjectMetadataCacheClient::DeleteNotification(
+    DeleteNotificationRequest const& request) {
+  return client_->DeleteNotification(request);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
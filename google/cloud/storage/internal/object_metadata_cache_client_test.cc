@@ -0,0 +1,262 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_cache_client.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <chrono>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+
+ObjectMetadata MakeMetadata(std::string const& name,
+                            std::int64_t generation) {
+  return ObjectMetadataParser::FromString(
+             R"""({"bucket": "test-bucket", "name": ")""" + name +
+             R"""(", "generation": ")""" + std::to_string(generation) +
+             R"""(", "etag": "etag-)""" + std::to_string(generation) +
+             R"""("})""")
+      .value();
+}
+
+class ObjectMetadataCacheClientTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ObjectMetadataCacheClient> MakeClient(
+      std::size_t max_entries) {
+    cache_ = std::make_shared<ObjectMetadataCache>(
+        max_entries, std::chrono::seconds(10), [this] { return now_; });
+    return std::make_shared<ObjectMetadataCacheClient>(mock_, cache_);
+  }
+
+  std::shared_ptr<testing::MockClient> mock_ =
+      std::make_shared<testing::MockClient>();
+  std::shared_ptr<ObjectMetadataCache> cache_;
+  ObjectMetadataCache::Clock::time_point now_ =
+      ObjectMetadataCache::Clock::now();
+};
+
+TEST_F(ObjectMetadataCacheClientTest, CachesMetadata) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(MakeMetadata("foo", 1)));
+
+  auto client = MakeClient(8);
+  for (int i = 0; i != 3; ++i) {
+    auto actual = client->GetObjectMetadata(
+        GetObjectMetadataRequest("test-bucket", "foo"));
+    ASSERT_STATUS_OK(actual);
+    EXPECT_EQ(1, actual->generation());
+  }
+  EXPECT_EQ(1, cache_->size());
+}
+
+TEST_F(ObjectMetadataCacheClientTest, EntriesExpire) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(MakeMetadata("foo", 1)))
+      .WillOnce(Return(MakeMetadata("foo", 2)));
+
+  auto client = MakeClient(8);
+  auto actual =
+      client->GetObjectMetadata(GetObjectMetadataRequest("test-bucket", "foo"));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(1, actual->generation());
+  now_ += std::chrono::seconds(10);
+  actual =
+      client->GetObjectMetadata(GetObjectMetadataRequest("test-bucket", "foo"));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(2, actual->generation());
+}
+
+TEST_F(ObjectMetadataCacheClientTest, EvictsLeastRecentlyUsed) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(MakeMetadata("a", 1)))
+      .WillOnce(Return(MakeMetadata("b", 1)))
+      .WillOnce(Return(MakeMetadata("c", 1)))
+      .WillOnce(Return(MakeMetadata("b", 2)));
+
+  auto client = MakeClient(2);
+  auto get = [&](std::string const& name) {
+    auto r = client->GetObjectMetadata(
+        GetObjectMetadataRequest("test-bucket", name));
+    EXPECT_STATUS_OK(r);
+    return r ? r->generation() : 0;
+  };
+  EXPECT_EQ(1, get("a"));
+  EXPECT_EQ(1, get("b"));
+  EXPECT_EQ(1, get("a"));
+  // "b" is the least recently used entry and gets evicted.
+  EXPECT_EQ(1, get("c"));
+  EXPECT_EQ(2, cache_->size());
+  EXPECT_EQ(1, get("a"));
+  EXPECT_EQ(2, get("b"));
+}
+
+TEST_F(ObjectMetadataCacheClientTest, ValidatesPreconditions) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(MakeMetadata("foo", 1)))
+      .WillOnce([](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ(2, r.GetOption<IfGenerationMatch>().value());
+        return make_status_or(MakeMetadata("foo", 2));
+      })
+      .WillOnce([](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("etag-3", r.GetOption<IfMatchEtag>().value());
+        return StatusOr<ObjectMetadata>(
+            Status(StatusCode::kFailedPrecondition, "mismatch"));
+      });
+
+  auto client = MakeClient(8);
+  ASSERT_STATUS_OK(client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")));
+  auto actual = client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")
+          .set_multiple_options(IfGenerationMatch(1), IfMatchEtag("etag-1")));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(1, actual->generation());
+
+  // A mismatch goes to the service, which refreshes the entry.
+  actual = client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")
+          .set_multiple_options(IfGenerationMatch(2)));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(2, actual->generation());
+
+  EXPECT_THAT(client->GetObjectMetadata(
+                  GetObjectMetadataRequest("test-bucket", "foo")
+                      .set_multiple_options(IfMatchEtag("etag-3"))),
+              StatusIs(StatusCode::kFailedPrecondition));
+  EXPECT_EQ(0, cache_->size());
+}
+
+TEST_F(ObjectMetadataCacheClientTest, UncacheableRequests) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .Times(4)
+      .WillRepeatedly(Return(MakeMetadata("foo", 1)));
+
+  auto client = MakeClient(8);
+  for (int i = 0; i != 2; ++i) {
+    EXPECT_STATUS_OK(client->GetObjectMetadata(
+        GetObjectMetadataRequest("test-bucket", "foo")
+            .set_multiple_options(Generation(1))));
+    EXPECT_STATUS_OK(client->GetObjectMetadata(
+        GetObjectMetadataRequest("test-bucket", "foo")
+            .set_multiple_options(Fields("name"))));
+  }
+  EXPECT_EQ(0, cache_->size());
+}
+
+TEST_F(ObjectMetadataCacheClientTest, ProjectionMismatch) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .Times(2)
+      .WillRepeatedly(Return(MakeMetadata("foo", 1)));
+
+  auto client = MakeClient(8);
+  EXPECT_STATUS_OK(client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")));
+  EXPECT_STATUS_OK(client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")
+          .set_multiple_options(Projection::Full())));
+  EXPECT_STATUS_OK(client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")
+          .set_multiple_options(Projection::Full())));
+}
+
+TEST_F(ObjectMetadataCacheClientTest, ErrorsAreNotCached) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(PermanentError()))
+      .WillOnce(Return(MakeMetadata("foo", 1)));
+
+  auto client = MakeClient(8);
+  EXPECT_THAT(client->GetObjectMetadata(
+                  GetObjectMetadataRequest("test-bucket", "foo")),
+              StatusIs(PermanentError().code()));
+  EXPECT_STATUS_OK(client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")));
+}
+
+TEST_F(ObjectMetadataCacheClientTest, WritesInvalidate) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .Times(4)
+      .WillRepeatedly(Return(MakeMetadata("foo", 1)));
+  EXPECT_CALL(*mock_, PatchObject).WillOnce(Return(MakeMetadata("foo", 1)));
+  EXPECT_CALL(*mock_, CopyObject).WillOnce(Return(MakeMetadata("foo", 2)));
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce(Return(make_status_or(EmptyResponse{})));
+
+  auto client = MakeClient(8);
+  auto get = [&] {
+    EXPECT_STATUS_OK(client->GetObjectMetadata(
+        GetObjectMetadataRequest("test-bucket", "foo")));
+    EXPECT_EQ(1, cache_->size());
+  };
+  get();
+  EXPECT_STATUS_OK(
+      client->PatchObject(PatchObjectRequest("test-bucket", "foo", {}, {})));
+  EXPECT_EQ(0, cache_->size());
+  get();
+  EXPECT_STATUS_OK(client->CopyObject(
+      CopyObjectRequest("source-bucket", "bar", "test-bucket", "foo")));
+  EXPECT_EQ(0, cache_->size());
+  get();
+  EXPECT_STATUS_OK(
+      client->DeleteObject(DeleteObjectRequest("test-bucket", "foo")));
+  EXPECT_EQ(0, cache_->size());
+  get();
+}
+
+TEST_F(ObjectMetadataCacheClientTest, ResumableUploadInvalidates) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .Times(2)
+      .WillRepeatedly(Return(MakeMetadata("foo", 1)));
+  EXPECT_CALL(*mock_, CreateResumableSession).WillOnce([] {
+    auto session = absl::make_unique<testing::MockResumableUploadSession>();
+    EXPECT_CALL(*session, UploadFinalChunk)
+        .WillOnce(Return(make_status_or(ResumableUploadResponse{
+            "test-session-id", 0, {}, ResumableUploadResponse::kDone, {}})));
+    EXPECT_CALL(*session, done).WillOnce(Return(true));
+    return make_status_or(
+        std::unique_ptr<ResumableUploadSession>(std::move(session)));
+  });
+
+  auto client = MakeClient(8);
+  auto session = client->CreateResumableSession(
+      ResumableUploadRequest("test-bucket", "foo"));
+  ASSERT_STATUS_OK(session);
+  // An entry populated while the upload is in progress is discarded when it
+  // completes.
+  EXPECT_STATUS_OK(client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")));
+  EXPECT_EQ(1, cache_->size());
+  EXPECT_STATUS_OK((*session)->UploadFinalChunk({}, 0, {}));
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_STATUS_OK(client->GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "foo")));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -16,7 +16,10 @@
 #include "google/cloud/storage/internal/common_metadata_parser.h"
 #include "google/cloud/storage/internal/object_access_control_parser.h"
 #include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/parse_rfc3339.h"
+#include "absl/strings/numbers.h"
 #include <nlohmann/json.hpp>
+#include <unordered_map>
 
 namespace google {
 namespace cloud {
@@ -119,8 +122,495 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
 
 StatusOr<ObjectMetadata> ObjectMetadataParser::FromString(
     std::string const& payload) {
-  auto json = nlohmann::json::parse(payload, nullptr, false);
-  return FromJson(json);
+  ObjectMetadataSaxHandler handler;
+  auto const ok = nlohmann::json::sax_parse(payload, &handler);
+  if (!handler.status().ok()) return handler.status();
+  if (!ok || !handler.done()) {
+    return Status(StatusCode::kInvalidArgument, __func__);
+  }
+  return std::move(handler.result());
+}
+
+enum class ObjectMetadataSaxHandler::Field {
+  kIgnore = 0,
+  // Nested fields, captured as a (small) DOM.
+  kAcl,
+  kCustomerEncryption,
+  kMetadata,
+  kOwner,
+  // String fields.
+  kBucket,
+  kCacheControl,
+  kContentDisposition,
+  kContentEncoding,
+  kContentLanguage,
+  kContentType,
+  kCrc32c,
+  kEtag,
+  kId,
+  kKind,
+  kKmsKeyName,
+  kMd5Hash,
+  kMediaLink,
+  kName,
+  kSelfLink,
+  kStorageClass,
+  // Integer fields, the service may send them as numbers or strings.
+  kComponentCount,
+  kGeneration,
+  kMetageneration,
+  kSize,
+  // Boolean fields.
+  kEventBasedHold,
+  kTemporaryHold,
+  // Timestamp fields.
+  kCustomTime,
+  kRetentionExpirationTime,
+  kTimeCreated,
+  kTimeDeleted,
+  kTimeStorageClassUpdated,
+  kUpdated,
+};
+
+namespace {
+using SaxField = ObjectMetadataSaxHandler::Field;
+
+std::unordered_map<std::string, SaxField> const& SaxFields() {
+  static auto const* const kFields =
+      new std::unordered_map<std::string, SaxField>{
+          {"acl", SaxField::kAcl},
+          {"customerEncryption", SaxField::kCustomerEncryption},
+          {"metadata", SaxField::kMetadata},
+          {"owner", SaxField::kOwner},
+          {"bucket", SaxField::kBucket},
+          {"cacheControl", SaxField::kCacheControl},
+          {"contentDisposition", SaxField::kContentDisposition},
+          {"contentEncoding", SaxField::kContentEncoding},
+          {"contentLanguage", SaxField::kContentLanguage},
+          {"contentType", SaxField::kContentType},
+          {"crc32c", SaxField::kCrc32c},
+          {"etag", SaxField::kEtag},
+          {"id", SaxField::kId},
+          {"kind", SaxField::kKind},
+          {"kmsKeyName", SaxField::kKmsKeyName},
+          {"md5Hash", SaxField::kMd5Hash},
+          {"mediaLink", SaxField::kMediaLink},
+          {"name", SaxField::kName},
+          {"selfLink", SaxField::kSelfLink},
+          {"storageClass", SaxField::kStorageClass},
+          {"componentCount", SaxField::kComponentCount},
+          {"generation", SaxField::kGeneration},
+          {"metageneration", SaxField::kMetageneration},
+          {"size", SaxField::kSize},
+          {"eventBasedHold", SaxField::kEventBasedHold},
+          {"temporaryHold", SaxField::kTemporaryHold},
+          {"customTime", SaxField::kCustomTime},
+          {"retentionExpirationTime", SaxField::kRetentionExpirationTime},
+          {"timeCreated", SaxField::kTimeCreated},
+          {"timeDeleted", SaxField::kTimeDeleted},
+          {"timeStorageClassUpdated", SaxField::kTimeStorageClassUpdated},
+          {"updated", SaxField::kUpdated},
+      };
+  return *kFields;
+}
+
+char const* FieldTypeName(SaxField field) {
+  switch (field) {
+    case SaxField::kAcl:
+      return "array";
+    case SaxField::kCustomerEncryption:
+    case SaxField::kOwner:
+      return "object";
+    case SaxField::kMetadata:
+      return "map of strings";
+    case SaxField::kComponentCount:
+      return "std::int32_t";
+    case SaxField::kGeneration:
+    case SaxField::kMetageneration:
+      return "std::int64_t";
+    case SaxField::kSize:
+      return "std::uint64_t";
+    case SaxField::kEventBasedHold:
+    case SaxField::kTemporaryHold:
+      return "boolean";
+    case SaxField::kCustomTime:
+    case SaxField::kRetentionExpirationTime:
+    case SaxField::kTimeCreated:
+    case SaxField::kTimeDeleted:
+    case SaxField::kTimeStorageClassUpdated:
+    case SaxField::kUpdated:
+      return "timestamp";
+    default:
+      break;
+  }
+  return "string";
+}
+}  // namespace
+
+void ObjectMetadataSaxHandler::Reset() {
+  result_ = ObjectMetadata{};
+  status_ = Status();
+  started_ = false;
+  done_ = false;
+  key_.clear();
+  field_ = Field::kIgnore;
+  skip_depth_ = 0;
+  capture_ = nullptr;
+  capture_stack_.clear();
+  capture_key_.clear();
+}
+
+bool ObjectMetadataSaxHandler::null() {
+  if (skip_depth_ > 0) return true;
+  if (!capture_stack_.empty()) return CaptureValue(nullptr);
+  if (!started_) return Error("expected a JSON object");
+  // The service does not send `null` values, treat them as missing fields.
+  return true;
+}
+
+bool ObjectMetadataSaxHandler::boolean(bool value) {
+  if (skip_depth_ > 0) return true;
+  if (!capture_stack_.empty()) return CaptureValue(value);
+  if (!started_) return Error("expected a JSON object");
+  return SetBoolean(value);
+}
+
+bool ObjectMetadataSaxHandler::number_integer(
+    nlohmann::json::number_integer_t value) {
+  if (skip_depth_ > 0) return true;
+  if (!capture_stack_.empty()) return CaptureValue(value);
+  if (!started_) return Error("expected a JSON object");
+  return SetInteger(value);
+}
+
+bool ObjectMetadataSaxHandler::number_unsigned(
+    nlohmann::json::number_unsigned_t value) {
+  if (skip_depth_ > 0) return true;
+  if (!capture_stack_.empty()) return CaptureValue(value);
+  if (!started_) return Error("expected a JSON object");
+  return SetUnsigned(value);
+}
+
+bool ObjectMetadataSaxHandler::number_float(
+    nlohmann::json::number_float_t value, nlohmann::json::string_t const&) {
+  if (skip_depth_ > 0) return true;
+  if (!capture_stack_.empty()) return CaptureValue(value);
+  if (!started_) return Error("expected a JSON object");
+  // Match `nlohmann::json::get<std::int64_t>()`, which truncates the value.
+  return SetInteger(static_cast<std::int64_t>(value));
+}
+
+bool ObjectMetadataSaxHandler::string(nlohmann::json::string_t& value) {
+  if (skip_depth_ > 0) return true;
+  if (!capture_stack_.empty()) return CaptureValue(std::move(value));
+  if (!started_) return Error("expected a JSON object");
+  return SetString(value);
+}
+
+bool ObjectMetadataSaxHandler::binary(nlohmann::json::binary_t&) {
+  // Binary values only appear in binary formats such as CBOR.
+  return Error("unexpected binary value");
+}
+
+bool ObjectMetadataSaxHandler::start_object(std::size_t) {
+  if (skip_depth_ > 0) {
+    ++skip_depth_;
+    return true;
+  }
+  if (!capture_stack_.empty()) return CaptureValue(nlohmann::json::object());
+  if (!started_) {
+    started_ = true;
+    return true;
+  }
+  return StartNested(nlohmann::json::object());
+}
+
+bool ObjectMetadataSaxHandler::key(nlohmann::json::string_t& value) {
+  if (skip_depth_ > 0) return true;
+  if (!capture_stack_.empty()) {
+    capture_key_ = std::move(value);
+    return true;
+  }
+  auto const& fields = SaxFields();
+  auto const f = fields.find(value);
+  field_ = f == fields.end() ? Field::kIgnore : f->second;
+  if (fields_ == ObjectMetadataFields::kNameSizeGeneration &&
+      field_ != Field::kName && field_ != Field::kSize &&
+      field_ != Field::kGeneration) {
+    field_ = Field::kIgnore;
+  }
+  key_ = std::move(value);
+  return true;
+}
+
+bool ObjectMetadataSaxHandler::end_object() {
+  if (skip_depth_ > 0) {
+    --skip_depth_;
+    return true;
+  }
+  if (!capture_stack_.empty()) {
+    capture_stack_.pop_back();
+    return capture_stack_.empty() ? EndNested() : true;
+  }
+  done_ = true;
+  return true;
+}
+
+bool ObjectMetadataSaxHandler::start_array(std::size_t) {
+  if (skip_depth_ > 0) {
+    ++skip_depth_;
+    return true;
+  }
+  if (!capture_stack_.empty()) return CaptureValue(nlohmann::json::array());
+  if (!started_) return Error("expected a JSON object");
+  return StartNested(nlohmann::json::array());
+}
+
+bool ObjectMetadataSaxHandler::end_array() {
+  if (skip_depth_ > 0) {
+    --skip_depth_;
+    return true;
+  }
+  if (capture_stack_.empty()) return Error("unexpected end of array");
+  capture_stack_.pop_back();
+  return capture_stack_.empty() ? EndNested() : true;
+}
+
+bool ObjectMetadataSaxHandler::parse_error(
+    std::size_t, std::string const&, nlohmann::json::exception const& ex) {
+  return Error(ex.what());
+}
+
+bool ObjectMetadataSaxHandler::Error(std::string message) {
+  status_ = Status(StatusCode::kInvalidArgument,
+                   "Error parsing ObjectMetadata: " + std::move(message));
+  return false;
+}
+
+bool ObjectMetadataSaxHandler::FieldError() {
+  status_ = Status(StatusCode::kInvalidArgument,
+                   "Error parsing field <" + key_ + "> as a " +
+                       FieldTypeName(field_));
+  return false;
+}
+
+bool ObjectMetadataSaxHandler::StartNested(nlohmann::json value) {
+  switch (field_) {
+    case Field::kIgnore:
+      skip_depth_ = 1;
+      return true;
+    case Field::kAcl:
+      if (!value.is_array()) return FieldError();
+      break;
+    case Field::kCustomerEncryption:
+    case Field::kMetadata:
+    case Field::kOwner:
+      if (!value.is_object()) return FieldError();
+      break;
+    default:
+      return FieldError();
+  }
+  capture_ = std::move(value);
+  capture_stack_.push_back(&capture_);
+  return true;
+}
+
+bool ObjectMetadataSaxHandler::EndNested() {
+  auto json = std::move(capture_);
+  capture_ = nullptr;
+  switch (field_) {
+    case Field::kAcl:
+      for (auto const& kv : json.items()) {
+        auto parsed = ObjectAccessControlParser::FromJson(kv.value());
+        if (!parsed.ok()) {
+          status_ = std::move(parsed).status();
+          return false;
+        }
+        result_.acl_.emplace_back(std::move(*parsed));
+      }
+      return true;
+    case Field::kCustomerEncryption: {
+      CustomerEncryption e;
+      e.encryption_algorithm = json.value("encryptionAlgorithm", "");
+      e.key_sha256 = json.value("keySha256", "");
+      result_.customer_encryption_ = std::move(e);
+      return true;
+    }
+    case Field::kMetadata:
+      for (auto const& kv : json.items()) {
+        if (!kv.value().is_string()) return FieldError();
+        result_.metadata_.emplace(kv.key(), kv.value().get<std::string>());
+      }
+      return true;
+    case Field::kOwner: {
+      Owner o;
+      o.entity = json.value("entity", "");
+      o.entity_id = json.value("entityId", "");
+      result_.owner_ = std::move(o);
+      return true;
+    }
+    default:
+      break;
+  }
+  return true;
+}
+
+bool ObjectMetadataSaxHandler::CaptureValue(nlohmann::json value) {
+  auto& parent = *capture_stack_.back();
+  nlohmann::json* child;
+  if (parent.is_array()) {
+    parent.push_back(std::move(value));
+    child = &parent.back();
+  } else {
+    child = &(parent[capture_key_] = std::move(value));
+  }
+  if (child->is_structured()) capture_stack_.push_back(child);
+  return true;
+}
+
+bool ObjectMetadataSaxHandler::SetString(std::string const& value) {
+  auto set_timestamp = [&](std::chrono::system_clock::time_point& field) {
+    auto parsed = google::cloud::internal::ParseRfc3339(value);
+    if (!parsed) {
+      status_ = std::move(parsed).status();
+      return false;
+    }
+    field = *parsed;
+    return true;
+  };
+  switch (field_) {
+    case Field::kIgnore:
+      return true;
+    case Field::kBucket:
+      result_.bucket_ = value;
+      return true;
+    case Field::kCacheControl:
+      result_.cache_control_ = value;
+      return true;
+    case Field::kContentDisposition:
+      result_.content_disposition_ = value;
+      return true;
+    case Field::kContentEncoding:
+      result_.content_encoding_ = value;
+      return true;
+    case Field::kContentLanguage:
+      result_.content_language_ = value;
+      return true;
+    case Field::kContentType:
+      result_.content_type_ = value;
+      return true;
+    case Field::kCrc32c:
+      result_.crc32c_ = value;
+      return true;
+    case Field::kEtag:
+      result_.etag_ = value;
+      return true;
+    case Field::kId:
+      result_.id_ = value;
+      return true;
+    case Field::kKind:
+      result_.kind_ = value;
+      return true;
+    case Field::kKmsKeyName:
+      result_.kms_key_name_ = value;
+      return true;
+    case Field::kMd5Hash:
+      result_.md5_hash_ = value;
+      return true;
+    case Field::kMediaLink:
+      result_.media_link_ = value;
+      return true;
+    case Field::kName:
+      result_.name_ = value;
+      return true;
+    case Field::kSelfLink:
+      result_.self_link_ = value;
+      return true;
+    case Field::kStorageClass:
+      result_.storage_class_ = value;
+      return true;
+    case Field::kComponentCount:
+      if (absl::SimpleAtoi(value, &result_.component_count_)) return true;
+      return FieldError();
+    case Field::kGeneration:
+      if (absl::SimpleAtoi(value, &result_.generation_)) return true;
+      return FieldError();
+    case Field::kMetageneration:
+      if (absl::SimpleAtoi(value, &result_.metageneration_)) return true;
+      return FieldError();
+    case Field::kSize:
+      if (absl::SimpleAtoi(value, &result_.size_)) return true;
+      return FieldError();
+    case Field::kEventBasedHold:
+    case Field::kTemporaryHold:
+      if (value != "true" && value != "false") return FieldError();
+      return SetBoolean(value == "true");
+    case Field::kCustomTime: {
+      std::chrono::system_clock::time_point tp;
+      if (!set_timestamp(tp)) return false;
+      result_.custom_time_ = tp;
+      return true;
+    }
+    case Field::kRetentionExpirationTime:
+      return set_timestamp(result_.retention_expiration_time_);
+    case Field::kTimeCreated:
+      return set_timestamp(result_.time_created_);
+    case Field::kTimeDeleted:
+      return set_timestamp(result_.time_deleted_);
+    case Field::kTimeStorageClassUpdated:
+      return set_timestamp(result_.time_storage_class_updated_);
+    case Field::kUpdated:
+      return set_timestamp(result_.updated_);
+    default:
+      break;
+  }
+  return FieldError();
+}
+
+bool ObjectMetadataSaxHandler::SetInteger(std::int64_t value) {
+  switch (field_) {
+    case Field::kIgnore:
+      return true;
+    case Field::kComponentCount:
+      result_.component_count_ = static_cast<std::int32_t>(value);
+      return true;
+    case Field::kGeneration:
+      result_.generation_ = value;
+      return true;
+    case Field::kMetageneration:
+      result_.metageneration_ = value;
+      return true;
+    case Field::kSize:
+      result_.size_ = static_cast<std::uint64_t>(value);
+      return true;
+    default:
+      break;
+  }
+  return FieldError();
+}
+
+bool ObjectMetadataSaxHandler::SetUnsigned(std::uint64_t value) {
+  if (field_ == Field::kSize) {
+    result_.size_ = value;
+    return true;
+  }
+  return SetInteger(static_cast<std::int64_t>(value));
+}
+
+bool ObjectMetadataSaxHandler::SetBoolean(bool value) {
+  switch (field_) {
+    case Field::kIgnore:
+      return true;
+    case Field::kEventBasedHold:
+      result_.event_based_hold_ = value;
+      return true;
+    case Field::kTemporaryHold:
+      result_.temporary_hold_ = value;
+      return true;
+    default:
+      break;
+  }
+  return FieldError();
 }
 
 nlohmann::json ObjectMetadataJsonForCompose(ObjectMetadata const& meta) {
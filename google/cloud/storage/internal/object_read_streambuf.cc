@@ -26,9 +26,11 @@ namespace internal {
 
 ObjectReadStreambuf::ObjectReadStreambuf(
     ReadObjectRangeRequest const& request,
-    std::unique_ptr<ObjectReadSource> source, std::streamoff pos_in_stream)
+    std::unique_ptr<ObjectReadSource> source, std::streamoff pos_in_stream,
+    std::shared_ptr<IoBufferPool> buffer_pool)
     : source_(std::move(source)),
       source_pos_(pos_in_stream),
+      buffer_pool_(std::move(buffer_pool)),
       hash_function_(CreateHashFunction(request)),
       hash_validator_(CreateHashValidator(request)) {}
 
@@ -141,17 +143,18 @@ ObjectReadStreambuf::int_type ObjectReadStreambuf::underflow() {
   if (!CheckPreconditions(__func__)) return traits_type::eof();
 
   // If this function is called, then the internal buffer must be empty. We will
-  // perform a read into a new buffer and reset the input area to use this
-  // buffer.
+  // perform a read into the buffer and reset the input area to use it. The
+  // buffer is allocated on the first call, and reused until the stream is
+  // destroyed.
   auto constexpr kInitialPeekRead = 128 * 1024;
-  std::vector<char> buffer(kInitialPeekRead);
-  auto const offset = xsgetn(buffer.data(), kInitialPeekRead);
+  if (current_ios_buffer_.empty()) {
+    current_ios_buffer_ = MakeIoBuffer(buffer_pool_, kInitialPeekRead);
+  }
+  char* data = current_ios_buffer_.data();
+  auto const offset = xsgetn(data, kInitialPeekRead);
   if (offset == 0) return traits_type::eof();
 
-  buffer.resize(static_cast<std::size_t>(offset));
-  buffer.swap(current_ios_buffer_);
-  char* data = current_ios_buffer_.data();
-  setg(data, data, data + current_ios_buffer_.size());
+  setg(data, data, data + offset);
   return traits_type::to_int_type(*data);
 }
 
@@ -19,6 +19,7 @@
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/object_read_source.h"
 #include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/io_buffer_pool.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
@@ -42,9 +43,15 @@ namespace internal {
  */
 class ObjectReadStreambuf : public std::basic_streambuf<char> {
  public:
+  /**
+   * Creates a streambuf reading from @p source.
+   *
+   * The buffer for formatted I/O is acquired from @p buffer_pool, if not null.
+   */
   ObjectReadStreambuf(ReadObjectRangeRequest const& request,
                       std::unique_ptr<ObjectReadSource> source,
-                      std::streamoff pos_in_stream);
+                      std::streamoff pos_in_stream,
+                      std::shared_ptr<IoBufferPool> buffer_pool = {});
 
   /// Create a streambuf in a permanent error status.
   ObjectReadStreambuf(ReadObjectRangeRequest const& request, Status status);
@@ -80,7 +87,8 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
 
   std::unique_ptr<ObjectReadSource> source_;
   std::streamoff source_pos_;
-  std::vector<char> current_ios_buffer_;
+  std::shared_ptr<IoBufferPool> buffer_pool_;
+  IoBuffer current_ios_buffer_;
   std::unique_ptr<HashFunction> hash_function_;
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
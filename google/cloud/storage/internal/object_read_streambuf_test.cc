@@ -91,6 +91,27 @@ TEST(ObjectReadStreambufTest, WrongSeek) {
   EXPECT_TRUE(stream.fail());
 }
 
+TEST(ObjectReadStreambufTest, UsesBufferPool) {
+  auto pool = IoBufferPool::Create();
+  {
+    auto read_source = absl::make_unique<testing::MockObjectReadSource>();
+    EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*read_source, Read)
+        .WillOnce(Return(ReadSourceResult{10, {}}))
+        .WillOnce(Return(ReadSourceResult{10, {}}));
+    ObjectReadStreambuf buf(ReadObjectRangeRequest{}, std::move(read_source),
+                            0, pool);
+    std::istream stream(&buf);
+    // Formatted I/O reads into a single buffer, reused by each `underflow()`.
+    EXPECT_EQ(11, stream.ignore(11).gcount());
+    EXPECT_EQ(128 * 1024, pool->stats().bytes_in_use);
+    EXPECT_EQ(1, pool->stats().misses);
+  }
+  auto stats = pool->stats();
+  EXPECT_EQ(0, stats.bytes_in_use);
+  EXPECT_EQ(128 * 1024, stats.bytes_cached);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -19,7 +19,9 @@
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
 #include <cinttypes>
 #include <sstream>
 
@@ -34,38 +36,380 @@ std::string UpdateObjectRequest::json_payload() const {
 
 std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r) {
   os << "ListObjectsRequest={bucket_name=" << r.bucket_name();
+  if (r.summaries_only()) os << ", summaries_only=true";
   r.DumpOptions(os, ", ");
   return os << "}";
 }
 
-StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
-    std::string const& payload) {
-  auto json = nlohmann::json::parse(payload, nullptr, false);
-  if (!json.is_object()) {
-    return Status(StatusCode::kInvalidArgument, __func__);
+namespace {
+/**
+ * Parses an `ObjectSummary` from `nlohmann::json` SAX events.
+ *
+ * Follows the same protocol as `ObjectMetadataSaxHandler`, but only keeps the
+ * `name`, `size`, `generation` and `crc32c` fields. Any other values,
+ * including nested objects and arrays, are skipped.
+ */
+class ObjectSummarySaxHandler {
+ public:
+  void Reset() {
+    result_ = ObjectSummary{};
+    status_ = Status();
+    depth_ = 0;
+    done_ = false;
+    field_ = Field::kIgnore;
+  }
+  bool done() const { return done_; }
+  Status const& status() const { return status_; }
+  ObjectSummary& result() { return result_; }
+
+  bool null() { return true; }
+  bool boolean(bool) { return true; }
+  bool number_integer(nlohmann::json::number_integer_t value) {
+    if (depth_ != 1) return true;
+    if (field_ == Field::kSize) {
+      result_.size = static_cast<std::uint64_t>(value);
+    } else if (field_ == Field::kGeneration) {
+      result_.generation = value;
+    } else if (field_ != Field::kIgnore) {
+      return Error();
+    }
+    return true;
+  }
+  bool number_unsigned(nlohmann::json::number_unsigned_t value) {
+    if (depth_ == 1 && field_ == Field::kSize) {
+      result_.size = value;
+      return true;
+    }
+    return number_integer(static_cast<std::int64_t>(value));
+  }
+  bool number_float(nlohmann::json::number_float_t,
+                    nlohmann::json::string_t const&) {
+    if (depth_ != 1 || field_ == Field::kIgnore) return true;
+    return Error();
+  }
+  bool string(nlohmann::json::string_t& value) {
+    if (depth_ != 1) return true;
+    switch (field_) {
+      case Field::kIgnore:
+        return true;
+      case Field::kName:
+        result_.name = std::move(value);
+        return true;
+      case Field::kCrc32c:
+        result_.crc32c = std::move(value);
+        return true;
+      case Field::kSize:
+        if (absl::SimpleAtoi(value, &result_.size)) return true;
+        break;
+      case Field::kGeneration:
+        if (absl::SimpleAtoi(value, &result_.generation)) return true;
+        break;
+    }
+    return Error();
+  }
+  bool binary(nlohmann::json::binary_t&) { return Error(); }
+  bool start_object(std::size_t) {
+    if (depth_ == 1 && field_ != Field::kIgnore) return Error();
+    ++depth_;
+    return true;
+  }
+  bool key(nlohmann::json::string_t& value) {
+    if (depth_ != 1) return true;
+    if (value == "name") {
+      field_ = Field::kName;
+    } else if (value == "size") {
+      field_ = Field::kSize;
+    } else if (value == "generation") {
+      field_ = Field::kGeneration;
+    } else if (value == "crc32c") {
+      field_ = Field::kCrc32c;
+    } else {
+      field_ = Field::kIgnore;
+    }
+    return true;
+  }
+  bool end_object() {
+    if (--depth_ == 0) done_ = true;
+    return true;
+  }
+  bool start_array(std::size_t) {
+    if (depth_ == 1 && field_ != Field::kIgnore) return Error();
+    ++depth_;
+    return true;
+  }
+  bool end_array() {
+    --depth_;
+    return true;
+  }
+  bool parse_error(std::size_t, std::string const&,
+                   nlohmann::json::exception const& ex) {
+    status_ = Status(StatusCode::kInvalidArgument, ex.what());
+    return false;
+  }
+
+ private:
+  enum class Field { kIgnore, kName, kSize, kGeneration, kCrc32c };
+
+  bool Error() {
+    status_ = Status(StatusCode::kInvalidArgument,
+                     "ObjectSummarySaxHandler: invalid value for field");
+    return false;
   }
 
-  ListObjectsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
+  ObjectSummary result_;
+  Status status_;
+  int depth_ = 0;
+  bool done_ = false;
+  Field field_ = Field::kIgnore;
+};
 
-  for (auto const& kv : json["items"].items()) {
-    auto parsed = internal::ObjectMetadataParser::FromJson(kv.value());
-    if (!parsed.ok()) {
-      return std::move(parsed).status();
+void AddItem(ListObjectsResponse& response, ObjectMetadata item) {
+  response.items.push_back(std::move(item));
+}
+
+void AddItem(ListObjectsResponse& response, ObjectSummary item) {
+  response.summaries.push_back(std::move(item));
+}
+
+/**
+ * Parses a `ListObjectsResponse` from `nlohmann::json` SAX events.
+ *
+ * The items are forwarded to a `ObjectMetadataSaxHandler`, or a
+ * `ObjectSummarySaxHandler`, so the response is parsed without creating a
+ * `nlohmann::json` DOM for it.
+ */
+template <typename ItemHandler>
+class ListObjectsSaxHandler {
+ public:
+  explicit ListObjectsSaxHandler(ItemHandler item) : item_(std::move(item)) {}
+
+  Status const& status() const { return status_; }
+  bool done() const { return state_ == State::kDone; }
+  ListObjectsResponse& result() { return result_; }
+
+  bool null() {
+    if (item_active_) return Forward(item_.null());
+    return Scalar();
+  }
+  bool boolean(bool value) {
+    if (item_active_) return Forward(item_.boolean(value));
+    return Scalar();
+  }
+  bool number_integer(nlohmann::json::number_integer_t value) {
+    if (item_active_) return Forward(item_.number_integer(value));
+    return Scalar();
+  }
+  bool number_unsigned(nlohmann::json::number_unsigned_t value) {
+    if (item_active_) return Forward(item_.number_unsigned(value));
+    return Scalar();
+  }
+  bool number_float(nlohmann::json::number_float_t value,
+                    nlohmann::json::string_t const& raw) {
+    if (item_active_) return Forward(item_.number_float(value, raw));
+    return Scalar();
+  }
+  bool string(nlohmann::json::string_t& value) {
+    if (item_active_) return Forward(item_.string(value));
+    if (skip_depth_ == 0 && state_ == State::kPrefixes) {
+      result_.prefixes.push_back(std::move(value));
+      return true;
     }
-    result.items.emplace_back(std::move(*parsed));
+    if (skip_depth_ == 0 && state_ == State::kTop && key_ == "nextPageToken") {
+      result_.next_page_token = std::move(value);
+      return true;
+    }
+    return Scalar();
   }
+  bool binary(nlohmann::json::binary_t&) { return Error(); }
 
-  for (auto const& prefix_iterator : json["prefixes"].items()) {
-    auto const& prefix = prefix_iterator.value();
-    if (!prefix.is_string()) {
-      return Status(StatusCode::kInternal,
-                    "List Objects Response's 'prefix' is not a string.");
+  bool start_object(std::size_t elements) {
+    if (item_active_) return Forward(item_.start_object(elements));
+    if (skip_depth_ > 0) {
+      ++skip_depth_;
+      return true;
+    }
+    switch (state_) {
+      case State::kStart:
+        state_ = State::kTop;
+        return true;
+      case State::kTop:
+        skip_depth_ = 1;
+        return true;
+      case State::kItems:
+        item_.Reset();
+        item_active_ = true;
+        return Forward(item_.start_object(elements));
+      case State::kPrefixes:
+        return PrefixError();
+      case State::kDone:
+        break;
+    }
+    return Error();
+  }
+  bool key(nlohmann::json::string_t& value) {
+    if (item_active_) return Forward(item_.key(value));
+    if (skip_depth_ == 0) key_ = std::move(value);
+    return true;
+  }
+  bool end_object() {
+    if (item_active_) {
+      if (!Forward(item_.end_object())) return false;
+      if (item_.done()) {
+        AddItem(result_, std::move(item_.result()));
+        item_active_ = false;
+      }
+      return true;
+    }
+    if (skip_depth_ > 0) {
+      --skip_depth_;
+      return true;
     }
-    result.prefixes.emplace_back(prefix.get<std::string>());
+    state_ = State::kDone;
+    return true;
+  }
+  bool start_array(std::size_t elements) {
+    if (item_active_) return Forward(item_.start_array(elements));
+    if (skip_depth_ > 0) {
+      ++skip_depth_;
+      return true;
+    }
+    switch (state_) {
+      case State::kTop:
+        if (key_ == "items") {
+          state_ = State::kItems;
+        } else if (key_ == "prefixes") {
+          state_ = State::kPrefixes;
+        } else {
+          skip_depth_ = 1;
+        }
+        return true;
+      case State::kPrefixes:
+        return PrefixError();
+      default:
+        break;
+    }
+    return Error();
+  }
+  bool end_array() {
+    if (item_active_) return Forward(item_.end_array());
+    if (skip_depth_ > 0) {
+      --skip_depth_;
+      return true;
+    }
+    state_ = State::kTop;
+    return true;
+  }
+  bool parse_error(std::size_t, std::string const&,
+                   nlohmann::json::exception const& ex) {
+    status_ = Status(StatusCode::kInvalidArgument, ex.what());
+    return false;
   }
 
-  return result;
+ private:
+  enum class State { kStart, kTop, kItems, kPrefixes, kDone };
+
+  bool Forward(bool ok) {
+    if (!ok) status_ = item_.status();
+    return ok;
+  }
+  bool Scalar() {
+    if (skip_depth_ > 0) return true;
+    if (state_ == State::kTop) return true;
+    if (state_ == State::kPrefixes) return PrefixError();
+    return Error();
+  }
+  bool PrefixError() {
+    status_ = Status(StatusCode::kInternal,
+                     "List Objects Response's 'prefix' is not a string.");
+    return false;
+  }
+  bool Error() {
+    status_ = Status(StatusCode::kInvalidArgument,
+                     "ListObjectsResponse::FromHttpResponse");
+    return false;
+  }
+
+  ItemHandler item_;
+  bool item_active_ = false;
+  State state_ = State::kStart;
+  std::string key_;
+  int skip_depth_ = 0;
+  Status status_;
+  ListObjectsResponse result_;
+};
+
+template <typename ItemHandler>
+StatusOr<ListObjectsResponse> ParseListObjectsResponse(
+    std::string const& payload, ItemHandler item) {
+  ListObjectsSaxHandler<ItemHandler> handler(std::move(item));
+  auto const ok = nlohmann::json::sax_parse(payload, &handler);
+  if (!handler.status().ok()) return handler.status();
+  if (!ok || !handler.done()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "ListObjectsResponse::FromHttpResponse");
+  }
+  return std::move(handler.result());
+}
+
+bool IsNameSizeGeneration(absl::string_view field) {
+  return field == "name" || field == "size" || field == "generation";
+}
+}  // namespace
+
+StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
+    std::string const& payload) {
+  return FromHttpResponse(payload, ObjectMetadataFields::kAll);
+}
+
+StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
+    std::string const& payload, ObjectMetadataFields fields) {
+  return ParseListObjectsResponse(payload, ObjectMetadataSaxHandler(fields));
+}
+
+StatusOr<ListObjectsResponse> ListObjectsResponse::SummariesFromHttpResponse(
+    std::string const& payload) {
+  return ParseListObjectsResponse(payload, ObjectSummarySaxHandler{});
+}
+
+ObjectMetadataFields ListObjectsItemFields(ListObjectsRequest const& request) {
+  auto const fields = request.GetOption<Fields>().value_or("");
+  // Split the top-level selectors, e.g. "items(name,size),nextPageToken".
+  std::vector<std::string> selectors(1);
+  int depth = 0;
+  for (auto c : fields) {
+    if (c == ' ') continue;
+    if (c == ',' && depth == 0) {
+      selectors.emplace_back();
+      continue;
+    }
+    if (c == '(') ++depth;
+    if (c == ')') --depth;
+    selectors.back().push_back(c);
+  }
+  bool has_items = false;
+  for (auto const& s : selectors) {
+    absl::string_view selector = s;
+    if (absl::ConsumePrefix(&selector, "items/")) {
+      if (!IsNameSizeGeneration(selector)) return ObjectMetadataFields::kAll;
+      has_items = true;
+      continue;
+    }
+    if (absl::ConsumePrefix(&selector, "items(") &&
+        absl::ConsumeSuffix(&selector, ")")) {
+      for (auto f : absl::StrSplit(selector, ',')) {
+        if (!IsNameSizeGeneration(f)) return ObjectMetadataFields::kAll;
+      }
+      has_items = true;
+      continue;
+    }
+    // Any other selector for the items, including "items" and "*", requires
+    // all the fields.
+    if (absl::StartsWith(s, "items") || s == "*") {
+      return ObjectMetadataFields::kAll;
+    }
+  }
+  return has_items ? ObjectMetadataFields::kNameSizeGeneration
+                   : ObjectMetadataFields::kAll;
 }
 
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
@@ -76,9 +420,34 @@ std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
   os << "}, prefixes={";
   std::copy(r.prefixes.begin(), r.prefixes.end(),
             std::ostream_iterator<std::string>(os, "\n "));
+  if (!r.summaries.empty()) {
+    os << "}, summaries={";
+    std::copy(r.summaries.begin(), r.summaries.end(),
+              std::ostream_iterator<ObjectSummary>(os, "\n  "));
+  }
   return os << "}}";
 }
 
+char const* ObjectSummaryFields() {
+  return "items(name,size,generation,crc32c),prefixes,nextPageToken";
+}
+
+std::vector<ObjectSummary> ExtractObjectSummaries(
+    ListObjectsResponse response) {
+  if (response.items.empty()) return std::move(response.summaries);
+  std::vector<ObjectSummary> result;
+  result.reserve(response.items.size());
+  for (auto const& item : response.items) {
+    ObjectSummary summary;
+    summary.name = item.name();
+    summary.size = item.size();
+    summary.generation = item.generation();
+    summary.crc32c = item.crc32c();
+    result.push_back(std::move(summary));
+  }
+  return result;
+}
+
 std::ostream& operator<<(std::ostream& os, GetObjectMetadataRequest const& r) {
   os << "GetObjectMetadataRequest={bucket_name=" << r.bucket_name()
      << ", object_name=" << r.object_name();
@@ -21,11 +21,17 @@
 #include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/generic_object_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/list_object_summaries_reader.h"
+#include "google/cloud/storage/list_objects_options.h"
 #include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/transfer_rate_limiter.h"
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_parameters.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -41,7 +47,8 @@ namespace internal {
 class ListObjectsRequest
     : public GenericRequest<ListObjectsRequest, MaxResults, Prefix, Delimiter,
                             IncludeTrailingDelimiter, StartOffset, EndOffset,
-                            Projection, UserProject, Versions> {
+                            Projection, UserProject, Versions,
+                            ListObjectsPrefetchDepth> {
  public:
   ListObjectsRequest() = default;
   explicit ListObjectsRequest(std::string bucket_name)
@@ -54,9 +61,17 @@ class ListObjectsRequest
     return *this;
   }
 
+  /// If true, return the items as `ObjectSummary` values.
+  bool summaries_only() const { return summaries_only_; }
+  ListObjectsRequest& set_summaries_only(bool v) {
+    summaries_only_ = v;
+    return *this;
+  }
+
  private:
   std::string bucket_name_;
   std::string page_token_;
+  bool summaries_only_ = false;
 };
 
 std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r);
@@ -64,14 +79,42 @@ std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r);
 struct ListObjectsResponse {
   static StatusOr<ListObjectsResponse> FromHttpResponse(
       std::string const& payload);
+  /// Parses the response, only filling @p fields in each item.
+  static StatusOr<ListObjectsResponse> FromHttpResponse(
+      std::string const& payload, ObjectMetadataFields fields);
+  /// Parses the response items into `summaries`, skipping `items`.
+  static StatusOr<ListObjectsResponse> SummariesFromHttpResponse(
+      std::string const& payload);
 
   std::string next_page_token;
   std::vector<ObjectMetadata> items;
   std::vector<std::string> prefixes;
+  /// Only used for requests with `summaries_only()`.
+  std::vector<ObjectSummary> summaries;
 };
 
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r);
 
+/// The `fields` parameter used to list objects as `ObjectSummary` values.
+char const* ObjectSummaryFields();
+
+/**
+ * Returns the summaries in @p response.
+ *
+ * Only the REST transport parses the summaries directly. With other transports
+ * the summaries are extracted from the full `items`.
+ */
+std::vector<ObjectSummary> ExtractObjectSummaries(ListObjectsResponse response);
+
+/**
+ * Returns the item fields that need parsing for @p request.
+ *
+ * Applications listing many objects often use the `Fields` parameter to only
+ * receive the name, size and generation of each object. In that case the
+ * response parser can skip the other fields entirely.
+ */
+ObjectMetadataFields ListObjectsItemFields(ListObjectsRequest const& request);
+
 /**
  * Represents a request to the `Objects: get` API.
  */
@@ -111,14 +154,33 @@ class InsertObjectMediaRequest
       : GenericObjectRequest(std::move(bucket_name), std::move(object_name)),
         contents_(std::move(contents)) {}
 
-  std::string const& contents() const { return contents_; }
+  absl::string_view contents() const {
+    return owner_ ? view_ : absl::string_view(contents_);
+  }
   InsertObjectMediaRequest& set_contents(std::string&& v) {
     contents_ = std::move(v);
+    view_ = {};
+    owner_.reset();
+    return *this;
+  }
+
+  /**
+   * Uploads @p v without copying it, @p owner keeps the data alive.
+   *
+   * Copies of the request share @p owner, so they can outlive the caller.
+   */
+  InsertObjectMediaRequest& set_contents(absl::string_view v,
+                                         std::shared_ptr<void const> owner) {
+    contents_.clear();
+    view_ = v;
+    owner_ = std::move(owner);
     return *this;
   }
 
  private:
   std::string contents_;
+  absl::string_view view_;
+  std::shared_ptr<void const> owner_;
 };
 
 std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r);
@@ -163,10 +225,11 @@ std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r);
  */
 class ReadObjectRangeRequest
     : public GenericObjectRequest<
-          ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, ReadFromOffset,
-          ReadRange, ReadLast, UserProject> {
+          ReadObjectRangeRequest, DecompressGzip, DisableCrc32cChecksum,
+          DisableMD5Hash, EncryptionKey, Generation, IfGenerationMatch,
+          IfGenerationNotMatch, IfMetagenerationMatch, IfMetagenerationNotMatch,
+          ReadFromOffset, ReadRange, ReadLast, UseBackgroundHashing,
+          UseTransferRateLimiter, UserProject, WithTransferPriority> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 
@@ -334,9 +397,10 @@ class ResumableUploadRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
-          UserProject, UploadFromOffset, UploadLimit, WithObjectMetadata,
-          UploadContentLength, AutoFinalize> {
+          MD5HashValue, PredefinedAcl, Projection, UseBackgroundHashing,
+          UseResumableUploadSession, UserProject, UploadFromOffset,
+          UploadLimit, WithObjectMetadata, UploadContentLength, AutoFinalize,
+          UploadPipelineDepth, UseTransferRateLimiter, WithTransferPriority> {
  public:
   ResumableUploadRequest() = default;
 
@@ -28,6 +28,7 @@ namespace internal {
 namespace {
 
 using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::StatusIs;
 using ::testing::HasSubstr;
 using ::testing::Not;
 
@@ -140,6 +141,139 @@ TEST(ObjectRequestsTest, ParseListResponseFailureInItems) {
   EXPECT_THAT(actual, Not(IsOk()));
 }
 
+TEST(ObjectRequestsTest, ParseListResponsePrefixFailure) {
+  std::string text = R"""({"prefixes": [ "foo/", 42 ]})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text);
+  EXPECT_THAT(actual, StatusIs(StatusCode::kInternal));
+}
+
+TEST(ObjectRequestsTest, ParseListResponseNameSizeGeneration) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "unknownField": {"items": [ "ignored" ]},
+      "items": [{
+        "bucket": "foo-bar",
+        "generation": "7",
+        "metadata": {"lbl1": "bar"},
+        "name": "foo",
+        "size": "1024"
+      }, {
+        "name": "bar",
+        "size": 2048,
+        "owner": {"entity": "user-qux"},
+        "generation": 8
+      }],
+      "nextPageToken": "some-token-42"
+})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(
+      text, ObjectMetadataFields::kNameSizeGeneration);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("some-token-42", actual->next_page_token);
+  ASSERT_EQ(2, actual->items.size());
+  EXPECT_EQ("foo", actual->items[0].name());
+  EXPECT_EQ(1024, actual->items[0].size());
+  EXPECT_EQ(7, actual->items[0].generation());
+  EXPECT_TRUE(actual->items[0].bucket().empty());
+  EXPECT_TRUE(actual->items[0].metadata().empty());
+  EXPECT_EQ("bar", actual->items[1].name());
+  EXPECT_EQ(2048, actual->items[1].size());
+  EXPECT_EQ(8, actual->items[1].generation());
+  EXPECT_FALSE(actual->items[1].has_owner());
+  EXPECT_TRUE(actual->prefixes.empty());
+}
+
+TEST(ObjectRequestsTest, ParseListResponseSummaries) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "items": [{
+        "bucket": "foo-bar",
+        "crc32c": "deadbeef",
+        "generation": "7",
+        "metadata": {"name": "ignored"},
+        "name": "foo",
+        "size": "1024"
+      }, {
+        "name": "bar",
+        "size": 2048,
+        "acl": [{"entity": "user-qux"}],
+        "generation": 8
+      }],
+      "prefixes": ["baz/"],
+      "nextPageToken": "some-token-42"
+})""";
+
+  auto actual = ListObjectsResponse::SummariesFromHttpResponse(text);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("some-token-42", actual->next_page_token);
+  EXPECT_TRUE(actual->items.empty());
+  EXPECT_THAT(actual->prefixes, ::testing::ElementsAre("baz/"));
+  ASSERT_EQ(2, actual->summaries.size());
+  EXPECT_EQ("foo", actual->summaries[0].name);
+  EXPECT_EQ(1024, actual->summaries[0].size);
+  EXPECT_EQ(7, actual->summaries[0].generation);
+  EXPECT_EQ("deadbeef", actual->summaries[0].crc32c);
+  EXPECT_EQ("bar", actual->summaries[1].name);
+  EXPECT_EQ(2048, actual->summaries[1].size);
+  EXPECT_EQ(8, actual->summaries[1].generation);
+  EXPECT_TRUE(actual->summaries[1].crc32c.empty());
+}
+
+TEST(ObjectRequestsTest, ParseListResponseSummariesFailure) {
+  for (std::string text : {
+           R"""({"items": [ {"size": "not-a-number"} ]})""",
+           R"""({"items": [ {"generation": 1.5} ]})""",
+           R"""({"items": [ {"name": {"nested": "object"}} ]})""",
+           R"""({"items": [ {"name": "truncated")""",
+       }) {
+    auto actual = ListObjectsResponse::SummariesFromHttpResponse(text);
+    EXPECT_THAT(actual, StatusIs(StatusCode::kInvalidArgument)) << text;
+  }
+}
+
+TEST(ObjectRequestsTest, ExtractObjectSummaries) {
+  ListObjectsResponse response;
+  response.items.push_back(internal::ObjectMetadataParser::FromJson(
+                               nlohmann::json{{"name", "foo"},
+                                              {"size", "1024"},
+                                              {"generation", "7"},
+                                              {"crc32c", "deadbeef"}})
+                               .value());
+  ObjectSummary expected;
+  expected.name = "foo";
+  expected.size = 1024;
+  expected.generation = 7;
+  expected.crc32c = "deadbeef";
+  EXPECT_THAT(ExtractObjectSummaries(response),
+              ::testing::ElementsAre(expected));
+
+  response.items.clear();
+  response.summaries.push_back(expected);
+  EXPECT_THAT(ExtractObjectSummaries(response),
+              ::testing::ElementsAre(expected));
+}
+
+TEST(ObjectRequestsTest, ListObjectsItemFields) {
+  auto fields = [](std::string f) {
+    ListObjectsRequest request("my-bucket");
+    if (!f.empty()) request.set_option(Fields(std::move(f)));
+    return ListObjectsItemFields(request);
+  };
+  auto const all = ObjectMetadataFields::kAll;
+  auto const subset = ObjectMetadataFields::kNameSizeGeneration;
+  EXPECT_EQ(all, fields(""));
+  EXPECT_EQ(all, fields("*"));
+  EXPECT_EQ(all, fields("items"));
+  EXPECT_EQ(all, fields("nextPageToken,prefixes"));
+  EXPECT_EQ(all, fields("items(name,bucket),nextPageToken"));
+  EXPECT_EQ(all, fields("items(name,owner(entity))"));
+  EXPECT_EQ(all, fields("items/name,items/md5Hash"));
+  EXPECT_EQ(subset, fields("items(name,size,generation),nextPageToken"));
+  EXPECT_EQ(subset, fields("items(name), nextPageToken, prefixes"));
+  EXPECT_EQ(subset, fields("items/name,items/size,nextPageToken"));
+}
+
 TEST(ObjectRequestsTest, Get) {
   GetObjectMetadataRequest request("my-bucket", "my-object");
   request.set_multiple_options(Generation(1), IfMetagenerationMatch(3));
@@ -177,6 +311,27 @@ TEST(ObjectRequestsTest, InsertObjectMediaUpdateContents) {
   EXPECT_EQ("new contents", request.contents());
 }
 
+TEST(ObjectRequestsTest, InsertObjectMediaExternalContents) {
+  auto buffer = std::make_shared<std::string>("external contents");
+  InsertObjectMediaRequest request("my-bucket", "my-object", "");
+  request.set_contents(*buffer, buffer);
+  EXPECT_EQ(buffer->data(), request.contents().data());
+  EXPECT_EQ(2, buffer.use_count());
+
+  // Copies share the buffer, the view is still valid after the original is
+  // released.
+  auto copy = request;
+  std::weak_ptr<std::string> w = buffer;
+  buffer.reset();
+  request = InsertObjectMediaRequest{};
+  EXPECT_FALSE(w.expired());
+  EXPECT_EQ("external contents", copy.contents());
+
+  copy.set_contents("new contents");
+  EXPECT_TRUE(w.expired());
+  EXPECT_EQ("new contents", copy.contents());
+}
+
 TEST(ObjectRequestsTest, Copy) {
   CopyObjectRequest request("source-bucket", "source-object", "my-bucket",
                             "my-object");
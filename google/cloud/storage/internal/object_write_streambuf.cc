@@ -16,6 +16,9 @@
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/version.h"
 #include "absl/memory/memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <sstream>
 
 namespace google {
@@ -28,16 +31,25 @@ ObjectWriteStreambuf::ObjectWriteStreambuf(
     std::unique_ptr<ResumableUploadSession> upload_session,
     std::size_t max_buffer_size, std::unique_ptr<HashFunction> hash_function,
     HashValues known_hashes, std::unique_ptr<HashValidator> hash_validator,
-    AutoFinalizeConfig auto_finalize)
+    AutoFinalizeConfig auto_finalize,
+    std::unique_ptr<UploadChunkSizer> chunk_sizer,
+    std::shared_ptr<IoBufferPool> buffer_pool,
+    std::shared_ptr<MemoryAccount> memory_account)
     : upload_session_(std::move(upload_session)),
-      max_buffer_size_(UploadChunkRequest::RoundUpToQuantum(max_buffer_size)),
+      buffer_pool_(std::move(buffer_pool)),
+      memory_(std::move(memory_account)),
+      max_buffer_size_(chunk_sizer ? chunk_sizer->chunk_size()
+                                   : UploadChunkRequest::RoundUpToQuantum(
+                                         max_buffer_size)),
       hash_function_(std::move(hash_function)),
       known_hashes_(std::move(known_hashes)),
       hash_validator_(std::move(hash_validator)),
       auto_finalize_(auto_finalize),
+      chunk_sizer_(std::move(chunk_sizer)),
       last_response_(ResumableUploadResponse{
           {}, 0, {}, ResumableUploadResponse::kInProgress, {}}) {
-  current_ios_buffer_.resize(max_buffer_size_);
+  current_ios_buffer_ = MakeIoBuffer(buffer_pool_, max_buffer_size_);
+  memory_.Resize(static_cast<std::int64_t>(current_ios_buffer_.size()));
   auto* pbeg = current_ios_buffer_.data();
   auto* pend = pbeg + current_ios_buffer_.size();
   setp(pbeg, pend);
@@ -138,10 +150,11 @@ void ObjectWriteStreambuf::FlushFinal() {
       {ConstBuffer(pbase(), actual_size)}, upload_size,
       Merge(known_hashes_, hash_values_));
 
-  // Reset the iostream put area with valid pointers, but empty.
-  current_ios_buffer_.resize(1);
-  auto* pbeg = current_ios_buffer_.data();
-  setp(pbeg, pbeg);
+  // Release the buffer, and reset the iostream put area. No more data is
+  // accepted once the stream is closed.
+  current_ios_buffer_ = IoBuffer{};
+  memory_.Resize(0);
+  setp(nullptr, nullptr);
 
   // Close the stream
   upload_session_.reset();
@@ -181,7 +194,19 @@ void ObjectWriteStreambuf::FlushRoundChunk(ConstBufferSequence buffers) {
   // buffer.
   auto first_buffered_byte = upload_session_->next_expected_byte();
   auto expected_next_byte = upload_session_->next_expected_byte() + actual_size;
+  auto const failed_attempts =
+      chunk_sizer_ ? upload_session_->failed_attempts() : 0;
+  auto const start = std::chrono::steady_clock::now();
   last_response_ = upload_session_->UploadChunk(payload);
+  if (chunk_sizer_ && last_response_) {
+    auto const errors = upload_session_->failed_attempts() - failed_attempts;
+    if (errors != 0) {
+      chunk_sizer_->OnErrors(static_cast<std::size_t>(errors));
+    } else {
+      chunk_sizer_->OnChunk(actual_size,
+                            std::chrono::steady_clock::now() - start);
+    }
+  }
 
   if (last_response_) {
     // Reset the internal buffer and copy any trailing bytes from `buffers` to
@@ -193,6 +218,7 @@ void ObjectWriteStreambuf::FlushRoundChunk(ConstBufferSequence buffers) {
       std::copy(b.begin(), b.end(), pptr());
       pbump(static_cast<int>(b.size()));
     }
+    if (chunk_sizer_) ResizePutArea(chunk_sizer_->chunk_size());
 
     // We cannot use the last committed byte in `last_response_` because when
     // using X-Upload-Content-Length GCS returns 0 when the upload completed
@@ -225,6 +251,19 @@ void ObjectWriteStreambuf::FlushRoundChunk(ConstBufferSequence buffers) {
   }
 }
 
+void ObjectWriteStreambuf::ResizePutArea(std::size_t size) {
+  if (size == max_buffer_size_) return;
+  auto const used = put_area_size();
+  max_buffer_size_ = size;
+  auto buffer = MakeIoBuffer(buffer_pool_, size);
+  std::copy(pbase(), pbase() + used, buffer.data());
+  current_ios_buffer_ = std::move(buffer);
+  memory_.Resize(static_cast<std::int64_t>(current_ios_buffer_.size()));
+  auto* pbeg = current_ios_buffer_.data();
+  setp(pbeg, pbeg + current_ios_buffer_.size());
+  pbump(static_cast<int>(used));
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
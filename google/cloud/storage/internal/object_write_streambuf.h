@@ -19,7 +19,10 @@
 #include "google/cloud/storage/internal/hash_function.h"
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/internal/upload_chunk_sizer.h"
+#include "google/cloud/storage/io_buffer_pool.h"
 #include "google/cloud/storage/version.h"
+#include "google/cloud/memory_accountant.h"
 #include <iostream>
 #include <memory>
 
@@ -41,12 +44,24 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
  public:
   ObjectWriteStreambuf() = default;
 
+  /**
+   * Creates a streambuf uploading chunks of @p max_buffer_size bytes.
+   *
+   * If @p chunk_sizer is not null it adjusts the size of the chunks (and the
+   * buffer) after each chunk is uploaded. The buffer is acquired from
+   * @p buffer_pool, if not null, and returned to it when the upload is
+   * finalized. The size of the buffer is charged to @p memory_account, if not
+   * null.
+   */
   ObjectWriteStreambuf(std::unique_ptr<ResumableUploadSession> upload_session,
                        std::size_t max_buffer_size,
                        std::unique_ptr<HashFunction> hash_function,
                        HashValues known_hashes,
                        std::unique_ptr<HashValidator> hash_validator,
-                       AutoFinalizeConfig auto_finalize);
+                       AutoFinalizeConfig auto_finalize,
+                       std::unique_ptr<UploadChunkSizer> chunk_sizer = {},
+                       std::shared_ptr<IoBufferPool> buffer_pool = {},
+                       std::shared_ptr<MemoryAccount> memory_account = {});
 
   ~ObjectWriteStreambuf() override = default;
 
@@ -104,9 +119,14 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   /// The current used bytes in the put area (aka current_ios_buffer_)
   std::size_t put_area_size() const { return pptr() - pbase(); }
 
+  /// Change the buffer size, preserving any bytes in the put area.
+  void ResizePutArea(std::size_t size);
+
   std::unique_ptr<ResumableUploadSession> upload_session_;
 
-  std::vector<char> current_ios_buffer_;
+  std::shared_ptr<IoBufferPool> buffer_pool_;
+  IoBuffer current_ios_buffer_;
+  google::cloud::internal::MemoryReservation memory_;
   std::size_t max_buffer_size_;
 
   std::unique_ptr<HashFunction> hash_function_;
@@ -114,6 +134,7 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   HashValues known_hashes_;
   std::unique_ptr<HashValidator> hash_validator_;
   AutoFinalizeConfig auto_finalize_ = AutoFinalizeConfig::kDisabled;
+  std::unique_ptr<UploadChunkSizer> chunk_sizer_;
 
   HashValidator::Result hash_validator_result_;
   std::string computed_hash_;
@@ -694,6 +694,118 @@ TEST(ObjectWriteStreambufTest, PubsyncTooSmall) {
   EXPECT_EQ(0, streambuf.pubsync());
 }
 
+/// @test Verify the adaptive chunk size shrinks after failed attempts.
+TEST(ObjectWriteStreambufTest, AdaptiveChunkSizeShrinksOnErrors) {
+  auto mock = absl::make_unique<testing::MockResumableUploadSession>();
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload(2 * quantum, '*');
+
+  std::size_t mock_next_byte = 0;
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly([&]() {
+    return mock_next_byte;
+  });
+  bool mock_is_done = false;
+  EXPECT_CALL(*mock, done()).WillRepeatedly([&]() { return mock_is_done; });
+  std::string const mock_session_id = "session-id";
+  EXPECT_CALL(*mock, session_id()).WillRepeatedly(ReturnRef(mock_session_id));
+  std::uint64_t mock_failed_attempts = 0;
+  EXPECT_CALL(*mock, failed_attempts()).WillRepeatedly([&]() {
+    return mock_failed_attempts;
+  });
+  std::vector<std::size_t> chunks;
+  EXPECT_CALL(*mock, UploadChunk)
+      .Times(2)
+      .WillRepeatedly([&](ConstBufferSequence const& p) {
+        // The first chunk needs a retry.
+        if (chunks.empty()) ++mock_failed_attempts;
+        chunks.push_back(TotalBytes(p));
+        mock_next_byte += TotalBytes(p);
+        return make_status_or(
+            ResumableUploadResponse{"",
+                                    mock_next_byte - 1,
+                                    {},
+                                    ResumableUploadResponse::kInProgress,
+                                    {}});
+      });
+  EXPECT_CALL(*mock, UploadFinalChunk)
+      .WillOnce([&](ConstBufferSequence const& p, std::uint64_t,
+                    HashValues const&) {
+        chunks.push_back(TotalBytes(p));
+        mock_next_byte += TotalBytes(p);
+        mock_is_done = true;
+        return make_status_or(ResumableUploadResponse{
+            "", mock_next_byte - 1, {}, ResumableUploadResponse::kDone, {}});
+      });
+
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), 2 * quantum, CreateNullHashFunction(), HashValues{},
+      CreateNullHashValidator(), AutoFinalizeConfig::kEnabled,
+      absl::make_unique<UploadChunkSizer>(2 * quantum, quantum, 4 * quantum));
+
+  auto const half = quantum / 2;
+  EXPECT_EQ(2 * quantum, streambuf.sputn(payload.data(), 2 * quantum));
+  // With the original buffer size these would not fill the buffer.
+  EXPECT_EQ(half, streambuf.sputn(payload.data(), half));
+  EXPECT_EQ(quantum, streambuf.sputn(payload.data(), quantum));
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+  EXPECT_THAT(chunks, ElementsAre(2 * quantum, quantum, half));
+}
+
+/// @test Verify the buffer is returned to the pool once the upload finalizes.
+TEST(ObjectWriteStreambufTest, UsesBufferPool) {
+  auto mock = absl::make_unique<testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+  EXPECT_CALL(*mock, UploadFinalChunk)
+      .WillOnce([](ConstBufferSequence const& p, std::uint64_t,
+                   HashValues const&) {
+        EXPECT_EQ(3, TotalBytes(p));
+        return make_status_or(ResumableUploadResponse{
+            {}, 3, {}, ResumableUploadResponse::kDone, {}});
+      });
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Return(0));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  auto pool = IoBufferPool::Create();
+  ObjectWriteStream stream(absl::make_unique<ObjectWriteStreambuf>(
+      std::move(mock), quantum, CreateNullHashFunction(), HashValues{},
+      CreateNullHashValidator(), AutoFinalizeConfig::kEnabled, nullptr, pool));
+  EXPECT_EQ(quantum, pool->stats().bytes_in_use);
+  stream << "abc";
+  stream.Close();
+  EXPECT_STATUS_OK(stream.last_status());
+  auto stats = pool->stats();
+  EXPECT_EQ(0, stats.bytes_in_use);
+  EXPECT_EQ(quantum, stats.bytes_cached);
+}
+
+/// @test Verify the buffer is charged to the memory account while in use.
+TEST(ObjectWriteStreambufTest, ChargesMemoryAccount) {
+  auto mock = absl::make_unique<testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+  EXPECT_CALL(*mock, UploadFinalChunk)
+      .WillOnce([](ConstBufferSequence const&, std::uint64_t,
+                   HashValues const&) {
+        return make_status_or(ResumableUploadResponse{
+            {}, 3, {}, ResumableUploadResponse::kDone, {}});
+      });
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Return(0));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  auto accountant = std::make_shared<MemoryAccountant>();
+  ObjectWriteStream stream(absl::make_unique<ObjectWriteStreambuf>(
+      std::move(mock), quantum, CreateNullHashFunction(), HashValues{},
+      CreateNullHashValidator(), AutoFinalizeConfig::kEnabled, nullptr,
+      nullptr, accountant->CreateAccount("test")));
+  EXPECT_EQ(quantum, accountant->bytes());
+  stream << "abc";
+  stream.Close();
+  EXPECT_STATUS_OK(stream.last_status());
+  EXPECT_EQ(0, accountant->bytes());
+  EXPECT_EQ(quantum, accountant->peak_bytes());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -63,27 +63,16 @@ std::string Base64Encode(std::vector<std::uint8_t> const& bytes) {
 StatusOr<std::vector<std::uint8_t>> SignStringWithPem(
     std::string const& str, std::string const& pem_contents,
     storage::oauth2::JwtSigningAlgorithms alg) {
-  using ::google::cloud::storage::oauth2::JwtSigningAlgorithms;
-
-  auto digest_ctx = GetDigestCtx();
-  if (!digest_ctx) {
-    return Status(StatusCode::kInvalidArgument,
-                  "Invalid ServiceAccountCredentials: "
-                  "could not create context for OpenSSL digest. ");
-  }
+  auto key = PemPrivateKey::Parse(pem_contents);
+  if (!key) return std::move(key).status();
+  return key->Sign(str, alg);
+}
 
-  EVP_MD const* digest_type = nullptr;
-  switch (alg) {
-    case JwtSigningAlgorithms::RS256:
-      digest_type = EVP_sha256();
-      break;
-  }
-  if (digest_type == nullptr) {
-    return Status(StatusCode::kInvalidArgument,
-                  "Invalid ServiceAccountCredentials: "
-                  "could not find specified digest in OpenSSL. ");
-  }
+struct PemPrivateKey::Impl {
+  std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key;
+};
 
+StatusOr<PemPrivateKey> PemPrivateKey::Parse(std::string const& pem_contents) {
   auto pem_buffer = std::unique_ptr<BIO, decltype(&BIO_free)>(
       BIO_new_mem_buf(pem_contents.data(),
                       static_cast<int>(pem_contents.length())),
@@ -109,6 +98,32 @@ StatusOr<std::vector<std::uint8_t>> SignStringWithPem(
                   "Invalid ServiceAccountCredentials: "
                   "could not parse PEM to get private key ");
   }
+  return PemPrivateKey(
+      std::make_shared<Impl const>(Impl{std::move(private_key)}));
+}
+
+StatusOr<std::vector<std::uint8_t>> PemPrivateKey::Sign(
+    std::string const& str, storage::oauth2::JwtSigningAlgorithms alg) const {
+  using ::google::cloud::storage::oauth2::JwtSigningAlgorithms;
+
+  auto digest_ctx = GetDigestCtx();
+  if (!digest_ctx) {
+    return Status(StatusCode::kInvalidArgument,
+                  "Invalid ServiceAccountCredentials: "
+                  "could not create context for OpenSSL digest. ");
+  }
+
+  EVP_MD const* digest_type = nullptr;
+  switch (alg) {
+    case JwtSigningAlgorithms::RS256:
+      digest_type = EVP_sha256();
+      break;
+  }
+  if (digest_type == nullptr) {
+    return Status(StatusCode::kInvalidArgument,
+                  "Invalid ServiceAccountCredentials: "
+                  "could not find specified digest in OpenSSL. ");
+  }
 
   int const digest_sign_success_code = 1;
   if (digest_sign_success_code !=
@@ -116,7 +131,7 @@ StatusOr<std::vector<std::uint8_t>> SignStringWithPem(
                          nullptr,  // `EVP_PKEY_CTX **pctx`
                          digest_type,
                          nullptr,  // `ENGINE *e`
-                         private_key.get())) {
+                         impl_->key.get())) {
     return Status(StatusCode::kInvalidArgument,
                   "Invalid ServiceAccountCredentials: "
                   "could not initialize PEM digest. ");
@@ -171,10 +186,10 @@ StatusOr<std::vector<std::uint8_t>> UrlsafeBase64Decode(
   return Base64Decode(b64str);
 }
 
-std::vector<std::uint8_t> MD5Hash(std::string const& payload) {
+std::vector<std::uint8_t> MD5Hash(absl::string_view payload) {
   MD5_CTX md5;
   MD5_Init(&md5);
-  MD5_Update(&md5, payload.c_str(), payload.size());
+  MD5_Update(&md5, payload.data(), payload.size());
 
   std::vector<std::uint8_t> hash(MD5_DIGEST_LENGTH, 0);
   // Note: MD5_Final consumes a `unsigned char*` in its first parameter, on some
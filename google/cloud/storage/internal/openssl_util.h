@@ -18,7 +18,9 @@
 #include "google/cloud/storage/oauth2/credential_constants.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
+#include "absl/strings/string_view.h"
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -54,6 +56,30 @@ StatusOr<std::vector<std::uint8_t>> SignStringWithPem(
     std::string const& str, std::string const& pem_contents,
     storage::oauth2::JwtSigningAlgorithms alg);
 
+/**
+ * A private key parsed from a PEM container.
+ *
+ * Parsing the PEM container is a significant fraction of the cost of
+ * `SignStringWithPem()`, applications that sign many strings with the same key
+ * should parse the key once. Copies share the same key, and `Sign()` can be
+ * called from multiple threads.
+ */
+class PemPrivateKey {
+ public:
+  static StatusOr<PemPrivateKey> Parse(std::string const& pem_contents);
+
+  /// Signs @p str, returns the signature as an *unencoded* byte array.
+  StatusOr<std::vector<std::uint8_t>> Sign(
+      std::string const& str, storage::oauth2::JwtSigningAlgorithms alg) const;
+
+ private:
+  struct Impl;
+  explicit PemPrivateKey(std::shared_ptr<Impl const> impl)
+      : impl_(std::move(impl)) {}
+
+  std::shared_ptr<Impl const> impl_;
+};
+
 /**
  * Returns a Base64-encoded version of @p bytes. Using the URL- and
  * filesystem-safe alphabet, making these adjustments:
@@ -79,7 +105,7 @@ inline std::string UrlsafeBase64Encode(Collection const& bytes) {
 StatusOr<std::vector<std::uint8_t>> UrlsafeBase64Decode(std::string const& str);
 
 /// Compute the MD5 hash of @p payload
-std::vector<std::uint8_t> MD5Hash(std::string const& payload);
+std::vector<std::uint8_t> MD5Hash(absl::string_view payload);
 
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
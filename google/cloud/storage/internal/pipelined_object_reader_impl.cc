@@ -0,0 +1,185 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/pipelined_object_reader_impl.h"
+#include "google/cloud/storage/hashing_options.h"
+#include "google/cloud/storage/internal/object_read_streambuf.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+BufferedObjectReadSource::BufferedObjectReadSource(std::string data,
+                                                   HeadersMap headers,
+                                                   Status status)
+    : data_(std::move(data)),
+      headers_(std::move(headers)),
+      status_(std::move(status)) {}
+
+StatusOr<HttpResponse> BufferedObjectReadSource::Close() {
+  open_ = false;
+  return HttpResponse{HttpStatusCode::kOk, {}, {}};
+}
+
+StatusOr<ReadSourceResult> BufferedObjectReadSource::Read(char* buf,
+                                                          std::size_t n) {
+  // A short read signals the end of the stream, report the error instead.
+  if (!status_.ok() && data_.size() - offset_ <= n) {
+    open_ = false;
+    return status_;
+  }
+  auto const count = (std::min)(n, data_.size() - offset_);
+  std::memcpy(buf, data_.data() + offset_, count);
+  offset_ += count;
+  ReadSourceResult result{
+      count, HttpResponse{HttpStatusCode::kContinue, {}, std::move(headers_)}};
+  headers_.clear();
+  if (offset_ == data_.size() && status_.ok()) {
+    open_ = false;
+    result.response.status_code = HttpStatusCode::kOk;
+  }
+  return result;
+}
+
+PipelinedObjectReaderImpl::PipelinedObjectReaderImpl(
+    InputFunction input, OpenFunction open, PipelinedReaderConfig config)
+    : input_(std::move(input)), open_(std::move(open)), config_(config) {
+  auto const depth = (std::max)(config_.depth, std::size_t{1});
+  workers_.reserve(depth);
+  for (std::size_t i = 0; i != depth; ++i) {
+    workers_.emplace_back([this] { Worker(); });
+  }
+}
+
+PipelinedObjectReaderImpl::~PipelinedObjectReaderImpl() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& w : workers_) w.join();
+}
+
+absl::optional<StatusOr<PipelinedObject>> PipelinedObjectReaderImpl::Next() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return slots_.empty() ? input_done_ : slots_.front()->done;
+  });
+  if (slots_.empty()) return absl::nullopt;
+  auto slot = std::move(slots_.front());
+  slots_.pop_front();
+  buffered_bytes_ -= static_cast<std::int64_t>(slot->data.size());
+  lk.unlock();
+  // The next object may be waiting for this memory.
+  cv_.notify_all();
+
+  if (slot->input_error) return StatusOr<PipelinedObject>(slot->status);
+  ReadObjectRangeRequest request(slot->object.bucket, slot->object.name);
+  // The worker already validated the checksums of the download.
+  request.set_multiple_options(DisableCrc32cChecksum(true),
+                               DisableMD5Hash(true));
+  auto source = absl::make_unique<BufferedObjectReadSource>(
+      std::move(slot->data), std::move(slot->headers),
+      std::move(slot->status));
+  ObjectReadStream stream(absl::make_unique<ObjectReadStreambuf>(
+      request, std::move(source), std::streamoff{0}));
+  return StatusOr<PipelinedObject>(
+      PipelinedObject{std::move(slot->object), std::move(stream)});
+}
+
+std::int64_t PipelinedObjectReaderImpl::buffered_bytes() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return buffered_bytes_;
+}
+
+void PipelinedObjectReaderImpl::Worker() {
+  for (auto slot = Claim(); slot; slot = Claim()) {
+    if (WaitForBudget(*slot)) Download(*slot);
+    std::lock_guard<std::mutex> lk(mu_);
+    slot->done = true;
+    cv_.notify_all();
+  }
+}
+
+std::shared_ptr<PipelinedObjectReaderImpl::Slot>
+PipelinedObjectReaderImpl::Claim() {
+  std::lock_guard<std::mutex> input_lk(input_mu_);
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (input_done_ || shutdown_) return nullptr;
+  }
+  auto next = input_();
+  std::lock_guard<std::mutex> lk(mu_);
+  if (!next) {
+    input_done_ = true;
+    cv_.notify_all();
+    return nullptr;
+  }
+  auto slot = std::make_shared<Slot>();
+  if (!*next) {
+    slot->status = std::move(*next).status();
+    slot->input_error = true;
+    slot->done = true;
+    slots_.push_back(std::move(slot));
+    input_done_ = true;
+    cv_.notify_all();
+    return nullptr;
+  }
+  slot->object = *std::move(*next);
+  slots_.push_back(slot);
+  return slot;
+}
+
+bool PipelinedObjectReaderImpl::WaitForBudget(Slot const& slot) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this, &slot] {
+    return shutdown_ || slots_.front().get() == &slot ||
+           buffered_bytes_ < config_.max_buffered_bytes;
+  });
+  return !shutdown_;
+}
+
+void PipelinedObjectReaderImpl::Download(Slot& slot) {
+  auto const chunk_size = (std::max)(config_.chunk_size, std::size_t{1});
+  auto stream = open_(slot.object);
+  for (;;) {
+    auto const offset = slot.data.size();
+    slot.data.resize(offset + chunk_size);
+    stream.read(&slot.data[offset], static_cast<std::streamsize>(chunk_size));
+    auto const n = static_cast<std::size_t>(stream.gcount());
+    slot.data.resize(offset + n);
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      buffered_bytes_ += static_cast<std::int64_t>(n);
+    }
+    if (!stream.good()) break;
+    if (!WaitForBudget(slot)) return;
+  }
+  slot.headers = stream.headers();
+  slot.status = stream.status();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
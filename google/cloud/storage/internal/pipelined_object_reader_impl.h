@@ -0,0 +1,158 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_OBJECT_READER_IMPL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_OBJECT_READER_IMPL_H
+
+#include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/object_read_stream.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/// Identifies an object read by `PipelinedObjectReader`.
+struct ObjectReference {
+  std::string bucket;
+  std::string name;
+  /// The generation to read, `0` reads the latest generation.
+  std::int64_t generation;
+};
+
+/// An object downloaded by `PipelinedObjectReader`, and its contents.
+struct PipelinedObject {
+  ObjectReference object;
+  ObjectReadStream stream;
+};
+
+namespace internal {
+
+/**
+ * An `ObjectReadSource` returning data already downloaded to memory.
+ *
+ * Returns @p headers with the first result. If @p status is not OK it is
+ * returned instead of the last read, as a failed download would do.
+ */
+class BufferedObjectReadSource : public ObjectReadSource {
+ public:
+  BufferedObjectReadSource(std::string data, HeadersMap headers,
+                           Status status);
+
+  bool IsOpen() const override { return open_; }
+  StatusOr<HttpResponse> Close() override;
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+
+ private:
+  std::string data_;
+  std::size_t offset_ = 0;
+  HeadersMap headers_;
+  Status status_;
+  bool open_ = true;
+};
+
+/// The configuration for a `PipelinedObjectReaderImpl`.
+struct PipelinedReaderConfig {
+  std::size_t depth;
+  std::int64_t max_buffered_bytes;
+  std::size_t chunk_size;
+};
+
+/**
+ * Implements `PipelinedObjectReader`.
+ *
+ * `depth` worker threads take the objects in order from the input, download
+ * them into memory, and leave them in a queue (`slots_`) in the same order.
+ * `Next()` hands out the front of the queue once its download completes.
+ *
+ * The worker downloading the front of the queue always makes progress. The
+ * other workers do not start, or continue, a download while the buffered data
+ * exceeds `max_buffered_bytes`, so the total is bounded by that value plus one
+ * chunk per worker, plus the size of the object at the front of the queue.
+ */
+class PipelinedObjectReaderImpl {
+ public:
+  /// Returns the next object, an error, or an empty optional at the end.
+  using InputFunction =
+      std::function<absl::optional<StatusOr<ObjectReference>>()>;
+  /// Starts the download of an object.
+  using OpenFunction = std::function<ObjectReadStream(ObjectReference const&)>;
+
+  PipelinedObjectReaderImpl(InputFunction input, OpenFunction open,
+                            PipelinedReaderConfig config);
+  ~PipelinedObjectReaderImpl();
+
+  absl::optional<StatusOr<PipelinedObject>> Next();
+
+  /// The bytes downloaded but not returned by `Next()`, mostly for testing.
+  std::int64_t buffered_bytes() const;
+
+ private:
+  struct Slot {
+    ObjectReference object;
+    // Only the worker that owns the slot modifies these fields, until it sets
+    // `done`.
+    std::string data;
+    HeadersMap headers;
+    Status status;
+    bool done = false;
+    // The input failed, `status` has the error.
+    bool input_error = false;
+  };
+
+  void Worker();
+  /// Takes the next object from the input, returns null at the end.
+  std::shared_ptr<Slot> Claim();
+  /// Blocks until @p slot may buffer more data, returns false on shutdown.
+  bool WaitForBudget(Slot const& slot);
+  void Download(Slot& slot);
+
+  InputFunction input_;
+  OpenFunction open_;
+  PipelinedReaderConfig const config_;
+
+  // Serializes the calls to `input_`, acquired before `mu_`.
+  std::mutex input_mu_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<Slot>> slots_;  // GUARDED_BY(mu_)
+  std::int64_t buffered_bytes_ = 0;          // GUARDED_BY(mu_)
+  bool input_done_ = false;                  // GUARDED_BY(mu_)
+  bool shutdown_ = false;                    // GUARDED_BY(mu_)
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_OBJECT_READER_IMPL_H
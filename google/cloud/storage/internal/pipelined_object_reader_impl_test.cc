@@ -0,0 +1,231 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/pipelined_object_reader_impl.h"
+#include "google/cloud/storage/internal/object_read_streambuf.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+ObjectReadStream MakeStream(std::string data, Status status = {},
+                            HeadersMap headers = {}) {
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(DisableCrc32cChecksum(true),
+                               DisableMD5Hash(true));
+  return ObjectReadStream(absl::make_unique<ObjectReadStreambuf>(
+      request,
+      absl::make_unique<BufferedObjectReadSource>(
+          std::move(data), std::move(headers), std::move(status)),
+      std::streamoff{0}));
+}
+
+std::string ReadAll(ObjectReadStream& stream) {
+  std::string contents;
+  std::vector<char> buffer(16);
+  do {
+    stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    contents.append(buffer.data(), static_cast<std::size_t>(stream.gcount()));
+  } while (stream.gcount() != 0);
+  return contents;
+}
+
+PipelinedObjectReaderImpl::InputFunction MakeInput(int count) {
+  auto next = std::make_shared<int>(0);
+  return [next, count]() -> absl::optional<StatusOr<ObjectReference>> {
+    if (*next == count) return absl::nullopt;
+    auto name = "object-" + std::to_string((*next)++);
+    return make_status_or(ObjectReference{"test-bucket", name, 0});
+  };
+}
+
+std::string Contents(ObjectReference const& o) {
+  return "contents of " + o.name;
+}
+
+TEST(BufferedObjectReadSource, ReadsDataThenError) {
+  BufferedObjectReadSource source(
+      "0123456789", {{"x-goog-generation", "42"}},
+      Status(StatusCode::kDataLoss, "mismatched hashes"));
+  std::vector<char> buffer(6);
+  auto r = source.Read(buffer.data(), buffer.size());
+  ASSERT_STATUS_OK(r);
+  EXPECT_EQ(6, r->bytes_received);
+  EXPECT_THAT(r->response.headers,
+              ElementsAre(Pair("x-goog-generation", "42")));
+  EXPECT_TRUE(source.IsOpen());
+  EXPECT_THAT(source.Read(buffer.data(), buffer.size()),
+              StatusIs(StatusCode::kDataLoss));
+  EXPECT_FALSE(source.IsOpen());
+}
+
+TEST(PipelinedObjectReaderImpl, ReturnsObjectsInOrder) {
+  auto open = [](ObjectReference const& o) {
+    // Complete the downloads out of order.
+    auto const n = std::stoi(o.name.substr(o.name.find('-') + 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 - n));
+    return MakeStream(Contents(o), {}, {{"x-test-name", o.name}});
+  };
+  PipelinedObjectReaderImpl reader(MakeInput(10), open, {4, 1 << 20, 4});
+  std::vector<std::string> names;
+  for (auto o = reader.Next(); o; o = reader.Next()) {
+    ASSERT_STATUS_OK(*o);
+    auto& object = **o;
+    EXPECT_EQ("test-bucket", object.object.bucket);
+    EXPECT_EQ(Contents(object.object), ReadAll(object.stream));
+    EXPECT_STATUS_OK(object.stream.status());
+    EXPECT_THAT(object.stream.headers(),
+                ElementsAre(Pair("x-test-name", object.object.name)));
+    names.push_back(object.object.name);
+  }
+  EXPECT_THAT(names, ElementsAre("object-0", "object-1", "object-2", "object-3",
+                                 "object-4", "object-5", "object-6", "object-7",
+                                 "object-8", "object-9"));
+  EXPECT_EQ(0, reader.buffered_bytes());
+}
+
+TEST(PipelinedObjectReaderImpl, KeepsDepthDownloadsInFlight) {
+  std::mutex mu;
+  std::condition_variable cv;
+  int in_flight = 0;
+  int max_in_flight = 0;
+  auto open = [&](ObjectReference const& o) {
+    std::unique_lock<std::mutex> lk(mu);
+    max_in_flight = (std::max)(max_in_flight, ++in_flight);
+    cv.notify_all();
+    // Wait until all the workers start a download, or a timeout, so a broken
+    // implementation fails instead of hanging.
+    cv.wait_for(lk, std::chrono::seconds(5),
+                [&] { return max_in_flight == 3; });
+    --in_flight;
+    return MakeStream(Contents(o));
+  };
+  PipelinedObjectReaderImpl reader(MakeInput(6), open, {3, 1 << 20, 1024});
+  int count = 0;
+  for (auto o = reader.Next(); o; o = reader.Next()) {
+    ASSERT_STATUS_OK(*o);
+    ++count;
+  }
+  EXPECT_EQ(6, count);
+  EXPECT_EQ(3, max_in_flight);
+}
+
+TEST(PipelinedObjectReaderImpl, BoundsBufferedBytes) {
+  std::atomic<int> opened{0};
+  auto open = [&opened](ObjectReference const&) {
+    ++opened;
+    return MakeStream(std::string(100, 'x'));
+  };
+  // Without any budget only the object at the front of the queue is
+  // downloaded.
+  PipelinedObjectReaderImpl reader(MakeInput(8), open, {4, 0, 16});
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(1, opened.load());
+  EXPECT_EQ(100, reader.buffered_bytes());
+
+  int count = 0;
+  for (auto o = reader.Next(); o; o = reader.Next()) {
+    ASSERT_STATUS_OK(*o);
+    EXPECT_EQ(std::string(100, 'x'), ReadAll((*o)->stream));
+    EXPECT_LE(reader.buffered_bytes(), 100);
+    ++count;
+  }
+  EXPECT_EQ(8, count);
+  EXPECT_EQ(8, opened.load());
+}
+
+TEST(PipelinedObjectReaderImpl, DownloadErrors) {
+  auto open = [](ObjectReference const& o) {
+    if (o.name == "object-1") {
+      return MakeStream("partial", Status(StatusCode::kDataLoss, "bad hash"));
+    }
+    return MakeStream(Contents(o));
+  };
+  PipelinedObjectReaderImpl reader(MakeInput(3), open, {2, 1 << 20, 4});
+  std::vector<StatusCode> codes;
+  for (auto o = reader.Next(); o; o = reader.Next()) {
+    ASSERT_STATUS_OK(*o);
+    ReadAll((*o)->stream);
+    codes.push_back((*o)->stream.status().code());
+  }
+  EXPECT_THAT(codes, ElementsAre(StatusCode::kOk, StatusCode::kDataLoss,
+                                 StatusCode::kOk));
+}
+
+TEST(PipelinedObjectReaderImpl, InputError) {
+  auto next = std::make_shared<int>(0);
+  auto input = [next]() -> absl::optional<StatusOr<ObjectReference>> {
+    if (*next == 2) {
+      return StatusOr<ObjectReference>(
+          Status(StatusCode::kPermissionDenied, "uh-oh"));
+    }
+    auto name = "object-" + std::to_string((*next)++);
+    return make_status_or(ObjectReference{"test-bucket", name, 0});
+  };
+  auto open = [](ObjectReference const& o) { return MakeStream(Contents(o)); };
+  PipelinedObjectReaderImpl reader(input, open, {4, 1 << 20, 4});
+  auto o = reader.Next();
+  ASSERT_TRUE(o.has_value());
+  EXPECT_STATUS_OK(*o);
+  o = reader.Next();
+  ASSERT_TRUE(o.has_value());
+  EXPECT_STATUS_OK(*o);
+  o = reader.Next();
+  ASSERT_TRUE(o.has_value());
+  EXPECT_THAT(*o, StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_FALSE(reader.Next().has_value());
+}
+
+TEST(PipelinedObjectReaderImpl, DestroyWithPendingDownloads) {
+  std::atomic<int> opened{0};
+  auto open = [&opened](ObjectReference const&) {
+    ++opened;
+    return MakeStream(std::string(1000, 'x'));
+  };
+  {
+    PipelinedObjectReaderImpl reader(MakeInput(100), open, {4, 0, 10});
+    auto o = reader.Next();
+    ASSERT_TRUE(o.has_value());
+  }
+  // The workers blocked waiting for memory stop without starting any
+  // downloads.
+  EXPECT_LE(opened.load(), 2);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
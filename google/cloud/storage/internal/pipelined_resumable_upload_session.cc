@@ -0,0 +1,190 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/pipelined_resumable_upload_session.h"
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+PipelinedResumableUploadSession::PipelinedResumableUploadSession(
+    std::unique_ptr<ResumableUploadSession> session, std::size_t depth)
+    : session_(std::move(session)),
+      // One of the buffers is always owned by the caller.
+      max_in_flight_(depth < 2 ? 1 : depth - 1),
+      accepted_next_byte_(session_->next_expected_byte()),
+      committed_next_byte_(accepted_next_byte_),
+      done_(session_->done()),
+      last_response_(session_->last_response()),
+      session_id_(session_->session_id()) {
+  worker_ = std::thread([this] { WorkerLoop(); });
+}
+
+PipelinedResumableUploadSession::~PipelinedResumableUploadSession() {
+  std::unique_lock<std::mutex> lk(mu_);
+  // Any chunks not yet uploaded are discarded, without a `UploadFinalChunk()`
+  // call the upload is incomplete anyway.
+  shutdown_ = true;
+  lk.unlock();
+  cv_.notify_all();
+  worker_.join();
+}
+
+StatusOr<ResumableUploadResponse> PipelinedResumableUploadSession::UploadChunk(
+    ConstBufferSequence const& buffers) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return pending_.size() + (busy_ ? 1 : 0) < max_in_flight_ ||
+           !last_response_;
+  });
+  if (!last_response_ || done_) return last_response_;
+  std::vector<char> chunk;
+  if (!free_.empty()) {
+    chunk = std::move(free_.back());
+    free_.pop_back();
+  }
+  lk.unlock();
+
+  chunk.clear();
+  chunk.reserve(TotalBytes(buffers));
+  for (auto const& b : buffers) chunk.insert(chunk.end(), b.begin(), b.end());
+
+  lk.lock();
+  accepted_next_byte_ += chunk.size();
+  pending_.push_back(std::move(chunk));
+  auto const next_byte = accepted_next_byte_;
+  lk.unlock();
+  cv_.notify_all();
+  return ResumableUploadResponse{session_id_,
+                                 next_byte == 0 ? 0 : next_byte - 1,
+                                 {},
+                                 ResumableUploadResponse::kInProgress,
+                                 {}};
+}
+
+StatusOr<ResumableUploadResponse>
+PipelinedResumableUploadSession::UploadFinalChunk(
+    ConstBufferSequence const& buffers, std::uint64_t upload_size,
+    HashValues const& full_object_hashes) {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  if (!last_response_) return last_response_;
+  lk.unlock();
+  auto response =
+      session_->UploadFinalChunk(buffers, upload_size, full_object_hashes);
+  Refresh(response);
+  return response;
+}
+
+StatusOr<ResumableUploadResponse>
+PipelinedResumableUploadSession::ResetSession() {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  lk.unlock();
+  auto response = session_->ResetSession();
+  Refresh(response);
+  return response;
+}
+
+std::uint64_t PipelinedResumableUploadSession::next_expected_byte() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return last_response_ ? accepted_next_byte_ : committed_next_byte_;
+}
+
+std::string const& PipelinedResumableUploadSession::session_id() const {
+  return session_id_;
+}
+
+bool PipelinedResumableUploadSession::done() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return done_;
+}
+
+StatusOr<ResumableUploadResponse> const&
+PipelinedResumableUploadSession::last_response() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  return last_response_;
+}
+
+void PipelinedResumableUploadSession::Drain(
+    std::unique_lock<std::mutex>& lk) const {
+  cv_.wait(lk, [this] { return pending_.empty() && !busy_; });
+}
+
+void PipelinedResumableUploadSession::Refresh(
+    StatusOr<ResumableUploadResponse> response) {
+  // The pipeline is drained, the worker thread is not using `session_`.
+  auto const next_byte = session_->next_expected_byte();
+  auto const done = session_->done();
+  session_id_ = session_->session_id();
+  std::lock_guard<std::mutex> lk(mu_);
+  accepted_next_byte_ = next_byte;
+  committed_next_byte_ = next_byte;
+  done_ = done;
+  last_response_ = std::move(response);
+}
+
+void PipelinedResumableUploadSession::WorkerLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    if (shutdown_) return;
+    auto chunk = std::move(pending_.front());
+    pending_.pop_front();
+    busy_ = true;
+    // After an error the remaining chunks are discarded, the caller must
+    // resume from `next_expected_byte()`.
+    if (last_response_) {
+      auto const first_byte = committed_next_byte_;
+      auto const expected_next_byte = first_byte + chunk.size();
+      lk.unlock();
+      auto response =
+          session_->UploadChunk({ConstBuffer(chunk.data(), chunk.size())});
+      auto const actual_next_byte = session_->next_expected_byte();
+      auto const done = session_->done();
+      lk.lock();
+      // Perform the same consistency checks as `ObjectWriteStreambuf`, the
+      // caller already received a successful response for this chunk.
+      if (response && actual_next_byte < expected_next_byte &&
+          actual_next_byte < first_byte) {
+        std::ostringstream os;
+        os << "Could not continue upload stream. GCS requested byte "
+           << actual_next_byte << " which has already been uploaded.";
+        response = Status(StatusCode::kAborted, std::move(os).str());
+      } else if (response && actual_next_byte > expected_next_byte) {
+        std::ostringstream os;
+        os << "Could not continue upload stream. "
+           << "GCS requested unexpected byte. (expected: "
+           << expected_next_byte << ", actual: " << actual_next_byte << ")";
+        response = Status(StatusCode::kAborted, std::move(os).str());
+      }
+      committed_next_byte_ = actual_next_byte;
+      done_ = done;
+      last_response_ = std::move(response);
+    }
+    free_.push_back(std::move(chunk));
+    busy_ = false;
+    cv_.notify_all();
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,105 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_UPLOAD_SESSION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_UPLOAD_SESSION_H
+
+#include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Decorates a `ResumableUploadSession` to upload chunks in the background.
+ *
+ * `UploadChunk()` copies the data into one of `depth - 1` chunk buffers and
+ * returns immediately, a background thread uploads the chunks in order using
+ * the decorated session. The caller can fill its next buffer while the
+ * previous chunks are in flight. `UploadChunk()` blocks when all the chunk
+ * buffers are in use.
+ *
+ * The decorated session (typically a `RetryResumableUploadSession`) still
+ * handles any retries. Any errors are reported by the next call to
+ * `UploadChunk()` or `UploadFinalChunk()`, and `next_expected_byte()` then
+ * returns the last byte committed by the service, so the application can
+ * resume the upload.
+ */
+class PipelinedResumableUploadSession : public ResumableUploadSession {
+ public:
+  PipelinedResumableUploadSession(
+      std::unique_ptr<ResumableUploadSession> session, std::size_t depth);
+  ~PipelinedResumableUploadSession() override;
+
+  PipelinedResumableUploadSession(PipelinedResumableUploadSession const&) =
+      delete;
+  PipelinedResumableUploadSession& operator=(
+      PipelinedResumableUploadSession const&) = delete;
+
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      ConstBufferSequence const& buffers) override;
+  StatusOr<ResumableUploadResponse> UploadFinalChunk(
+      ConstBufferSequence const& buffers, std::uint64_t upload_size,
+      HashValues const& full_object_hashes) override;
+  StatusOr<ResumableUploadResponse> ResetSession() override;
+  std::uint64_t next_expected_byte() const override;
+  std::string const& session_id() const override;
+  bool done() const override;
+  StatusOr<ResumableUploadResponse> const& last_response() const override;
+
+ private:
+  /// Wait until all the queued chunks are uploaded.
+  void Drain(std::unique_lock<std::mutex>& lk) const;
+  /// Update the cached state after calling `session_` directly.
+  void Refresh(StatusOr<ResumableUploadResponse> response);
+  void WorkerLoop();
+
+  std::unique_ptr<ResumableUploadSession> session_;
+  std::size_t const max_in_flight_;
+
+  mutable std::mutex mu_;
+  mutable std::condition_variable cv_;
+  std::deque<std::vector<char>> pending_;  // GUARDED_BY(mu_)
+  // Recycle the buffers to avoid one allocation per chunk.
+  std::vector<std::vector<char>> free_;  // GUARDED_BY(mu_)
+  bool busy_ = false;                    // GUARDED_BY(mu_)
+  bool shutdown_ = false;                // GUARDED_BY(mu_)
+  // The next byte after all the chunks accepted by `UploadChunk()`.
+  std::uint64_t accepted_next_byte_;  // GUARDED_BY(mu_)
+  // The next byte expected by the service, as of the last completed chunk.
+  std::uint64_t committed_next_byte_;                // GUARDED_BY(mu_)
+  bool done_;                                        // GUARDED_BY(mu_)
+  StatusOr<ResumableUploadResponse> last_response_;  // GUARDED_BY(mu_)
+  // Only changes while the pipeline is drained, no locking required.
+  std::string session_id_;
+  std::thread worker_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_UPLOAD_SESSION_H
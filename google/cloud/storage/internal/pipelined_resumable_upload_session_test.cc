@@ -0,0 +1,184 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/pipelined_resumable_upload_session.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <atomic>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+/// A mock session which records the uploaded data.
+class PipelinedResumableUploadSessionTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<testing::MockResumableUploadSession> MakeMock() {
+    auto mock = absl::make_unique<testing::MockResumableUploadSession>();
+    EXPECT_CALL(*mock, next_expected_byte).WillRepeatedly([this] {
+      return committed_.load();
+    });
+    EXPECT_CALL(*mock, session_id).WillRepeatedly(ReturnRef(session_id_));
+    EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+    EXPECT_CALL(*mock, last_response)
+        .WillRepeatedly(ReturnRef(initial_response_));
+    return mock;
+  }
+
+  StatusOr<ResumableUploadResponse> Accept(ConstBufferSequence const& p) {
+    for (auto const& b : p) uploaded_.append(b.data(), b.size());
+    committed_ += TotalBytes(p);
+    return ResumableUploadResponse{
+        session_id_, committed_ - 1, {}, ResumableUploadResponse::kInProgress,
+        {}};
+  }
+
+  std::string session_id_ = "test-session-id";
+  StatusOr<ResumableUploadResponse> initial_response_ =
+      ResumableUploadResponse{
+          {}, 0, {}, ResumableUploadResponse::kInProgress, {}};
+  std::atomic<std::uint64_t> committed_{0};
+  std::string uploaded_;
+};
+
+TEST_F(PipelinedResumableUploadSessionTest, UploadsInOrder) {
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, UploadChunk)
+      .Times(3)
+      .WillRepeatedly(
+          [this](ConstBufferSequence const& p) { return Accept(p); });
+  EXPECT_CALL(*mock, UploadFinalChunk)
+      .WillOnce([this](ConstBufferSequence const& p, std::uint64_t size,
+                       HashValues const&) {
+        EXPECT_EQ(uploaded_.size() + TotalBytes(p), size);
+        Accept(p);
+        return make_status_or(ResumableUploadResponse{
+            session_id_, committed_ - 1, ObjectMetadata{},
+            ResumableUploadResponse::kDone, {}});
+      });
+
+  PipelinedResumableUploadSession session(std::move(mock), 3);
+  std::string const a = "aaaa";
+  std::string const b = "bbbb";
+  // The data is copied, the caller can reuse its buffers.
+  std::string c = "cc";
+  std::string const d = "dd";
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer(a)}));
+  EXPECT_EQ(4, session.next_expected_byte());
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer(b)}));
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer(c), ConstBuffer(d)}));
+  c = "xx";
+  EXPECT_EQ(12, session.next_expected_byte());
+  auto response = session.UploadFinalChunk({ConstBuffer(a)}, 16, {});
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(ResumableUploadResponse::kDone, response->upload_state);
+  EXPECT_EQ("aaaabbbbccddaaaa", uploaded_);
+  EXPECT_EQ(16, session.next_expected_byte());
+}
+
+TEST_F(PipelinedResumableUploadSessionTest, OverlapsWithCaller) {
+  promise<void> release;
+  auto released = release.get_future();
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, UploadChunk)
+      .WillOnce([&](ConstBufferSequence const& p) {
+        released.wait();
+        return Accept(p);
+      })
+      .WillOnce([this](ConstBufferSequence const& p) { return Accept(p); });
+  EXPECT_CALL(*mock, UploadFinalChunk)
+      .WillOnce([this](ConstBufferSequence const& p, std::uint64_t,
+                       HashValues const&) { return Accept(p); });
+
+  PipelinedResumableUploadSession session(std::move(mock), 3);
+  // Neither call blocks, even though the first chunk is still in flight.
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer("abc", 3)}));
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer("def", 3)}));
+  EXPECT_EQ(0, committed_.load());
+  release.set_value();
+  EXPECT_STATUS_OK(session.UploadFinalChunk({}, 6, {}));
+  EXPECT_EQ("abcdef", uploaded_);
+}
+
+TEST_F(PipelinedResumableUploadSessionTest, ErrorReportedOnNextCall) {
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, UploadChunk)
+      .WillOnce([this](ConstBufferSequence const& p) { return Accept(p); })
+      .WillOnce(Return(PermanentError()));
+  EXPECT_CALL(*mock, UploadFinalChunk).Times(0);
+
+  PipelinedResumableUploadSession session(std::move(mock), 2);
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer("abc", 3)}));
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer("def", 3)}));
+  // With a single buffer in flight this waits for the failed chunk.
+  EXPECT_THAT(session.UploadChunk({ConstBuffer("ghi", 3)}),
+              StatusIs(PermanentError().code()));
+  // The application can resume from the last committed byte.
+  EXPECT_EQ(3, session.next_expected_byte());
+  EXPECT_THAT(session.UploadFinalChunk({}, 9, {}),
+              StatusIs(PermanentError().code()));
+  EXPECT_EQ("abc", uploaded_);
+}
+
+TEST_F(PipelinedResumableUploadSessionTest, DetectsUnexpectedByte) {
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, UploadChunk).WillOnce([this](ConstBufferSequence const&) {
+    committed_ = 1024;
+    return make_status_or(ResumableUploadResponse{
+        session_id_, 1023, {}, ResumableUploadResponse::kInProgress, {}});
+  });
+
+  PipelinedResumableUploadSession session(std::move(mock), 2);
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer("abc", 3)}));
+  EXPECT_THAT(session.last_response(), StatusIs(StatusCode::kAborted));
+  EXPECT_EQ(1024, session.next_expected_byte());
+}
+
+TEST_F(PipelinedResumableUploadSessionTest, ResetSessionClearsError) {
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, UploadChunk)
+      .WillOnce(Return(PermanentError()))
+      .WillOnce([this](ConstBufferSequence const& p) { return Accept(p); });
+  EXPECT_CALL(*mock, ResetSession)
+      .WillOnce(Return(make_status_or(ResumableUploadResponse{
+          session_id_, 0, {}, ResumableUploadResponse::kInProgress, {}})));
+
+  PipelinedResumableUploadSession session(std::move(mock), 2);
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer("abc", 3)}));
+  EXPECT_THAT(session.last_response(), StatusIs(PermanentError().code()));
+  EXPECT_EQ(0, session.next_expected_byte());
+  EXPECT_STATUS_OK(session.ResetSession());
+  EXPECT_STATUS_OK(session.UploadChunk({ConstBuffer("abc", 3)}));
+  EXPECT_STATUS_OK(session.last_response());
+  EXPECT_EQ("abc", uploaded_);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,197 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/positional_file_writer.h"
+#include "google/cloud/internal/strerror.h"
+#include "google/cloud/log.h"
+#include "absl/memory/memory.h"
+#include <cerrno>
+#include <cstdint>
+#include <sstream>
+#if _WIN32
+#include <fstream>
+#include <mutex>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+Status MakeError(StatusCode code, char const* func,
+                 std::string const& file_name, std::string const& what) {
+  std::ostringstream os;
+  os << "PositionalFileWriter::" << func << "(" << file_name << "): " << what;
+  return Status(code, std::move(os).str());
+}
+
+#if !_WIN32
+Status ErrnoError(char const* func, std::string const& file_name,
+                  char const* syscall) {
+  auto const error = errno;
+  return MakeError(StatusCode::kUnknown, func, file_name,
+                   std::string(syscall) + "() failed: " +
+                       google::cloud::internal::strerror(error));
+}
+#endif  // !_WIN32
+
+}  // namespace
+
+std::size_t constexpr PositionalFileWriter::kDirectIoAlignment;
+
+#if _WIN32
+// Windows lacks `pwrite()`, serialize the writes through a single stream.
+struct PositionalFileWriter::Impl {
+  std::mutex mu;
+  std::fstream os;
+};
+
+StatusOr<std::unique_ptr<PositionalFileWriter>> PositionalFileWriter::Create(
+    std::string const& file_name, std::uintmax_t size, bool /*direct_io*/) {
+  auto impl = absl::make_unique<Impl>();
+  impl->os.open(file_name, std::ios::binary | std::ios::in | std::ios::out |
+                               std::ios::trunc);
+  if (!impl->os.is_open()) {
+    return MakeError(StatusCode::kInvalidArgument, __func__, file_name,
+                     "cannot open destination file");
+  }
+  if (size != 0) {
+    impl->os.seekp(static_cast<std::streamoff>(size - 1));
+    impl->os.put('\0');
+  }
+  if (!impl->os.good()) {
+    return MakeError(StatusCode::kUnknown, __func__, file_name,
+                     "cannot resize destination file");
+  }
+  return std::unique_ptr<PositionalFileWriter>(
+      new PositionalFileWriter(file_name, std::move(impl)));
+}
+
+Status PositionalFileWriter::WriteAt(std::uintmax_t offset, char const* data,
+                                     std::size_t size) {
+  std::lock_guard<std::mutex> lk(impl_->mu);
+  impl_->os.seekp(static_cast<std::streamoff>(offset));
+  impl_->os.write(data, static_cast<std::streamsize>(size));
+  if (impl_->os.good()) return Status{};
+  return MakeError(StatusCode::kUnknown, __func__, file_name_,
+                   "error writing to destination file");
+}
+
+Status PositionalFileWriter::Close() {
+  std::lock_guard<std::mutex> lk(impl_->mu);
+  if (!impl_->os.is_open()) return Status{};
+  impl_->os.close();
+  if (impl_->os.good()) return Status{};
+  return MakeError(StatusCode::kUnknown, __func__, file_name_,
+                   "error closing destination file");
+}
+
+PositionalFileWriter::~PositionalFileWriter() {
+  if (impl_ && impl_->os.is_open()) impl_->os.close();
+}
+#else
+struct PositionalFileWriter::Impl {
+  int fd = -1;
+  // A second descriptor, opened with `O_DIRECT`, used for aligned writes.
+  int direct_fd = -1;
+
+  int Select(std::uintmax_t offset, char const* data, std::size_t size) const {
+    if (direct_fd == -1) return fd;
+    if (offset % kDirectIoAlignment != 0) return fd;
+    if (size % kDirectIoAlignment != 0) return fd;
+    auto const address = reinterpret_cast<std::uintptr_t>(data);
+    if (address % kDirectIoAlignment != 0) return fd;
+    return direct_fd;
+  }
+};
+
+StatusOr<std::unique_ptr<PositionalFileWriter>> PositionalFileWriter::Create(
+    std::string const& file_name, std::uintmax_t size, bool direct_io) {
+  auto impl = absl::make_unique<Impl>();
+  impl->fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (impl->fd == -1) return ErrnoError(__func__, file_name, "open");
+  // Preallocating the file lets each slice write at its final offset without
+  // coordinating with the other slices.
+  if (::ftruncate(impl->fd, static_cast<off_t>(size)) != 0) {
+    auto status = ErrnoError(__func__, file_name, "ftruncate");
+    ::close(impl->fd);
+    return status;
+  }
+#ifdef O_DIRECT
+  if (direct_io) {
+    // Some filesystems (e.g. tmpfs) reject `O_DIRECT`, use the page cache.
+    impl->direct_fd = ::open(file_name.c_str(), O_WRONLY | O_DIRECT);
+    if (impl->direct_fd == -1) {
+      GCP_LOG(INFO) << ErrnoError(__func__, file_name, "open(O_DIRECT)")
+                    << ", using buffered writes";
+    }
+  }
+#else
+  (void)direct_io;
+#endif  // O_DIRECT
+  return std::unique_ptr<PositionalFileWriter>(
+      new PositionalFileWriter(file_name, std::move(impl)));
+}
+
+Status PositionalFileWriter::WriteAt(std::uintmax_t offset, char const* data,
+                                     std::size_t size) {
+  while (size != 0) {
+    auto const fd = impl_->Select(offset, data, size);
+    auto const n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return ErrnoError(__func__, file_name_, "pwrite");
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+    offset += static_cast<std::uintmax_t>(n);
+  }
+  return Status{};
+}
+
+Status PositionalFileWriter::Close() {
+  Status status;
+  for (auto* fd : {&impl_->direct_fd, &impl_->fd}) {
+    if (*fd == -1) continue;
+    auto const f = *fd;
+    *fd = -1;
+    if (::close(f) != 0 && status.ok()) {
+      status = ErrnoError(__func__, file_name_, "close");
+    }
+  }
+  return status;
+}
+
+PositionalFileWriter::~PositionalFileWriter() {
+  if (impl_ && impl_->direct_fd != -1) ::close(impl_->direct_fd);
+  if (impl_ && impl_->fd != -1) ::close(impl_->fd);
+}
+#endif  // _WIN32
+
+PositionalFileWriter::PositionalFileWriter(std::string file_name,
+                                           std::unique_ptr<Impl> impl)
+    : file_name_(std::move(file_name)), impl_(std::move(impl)) {}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,80 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_POSITIONAL_FILE_WRITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_POSITIONAL_FILE_WRITER_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Writes to a preallocated file at arbitrary offsets.
+ *
+ * Multiple threads can call `WriteAt()` concurrently, as long as they write
+ * to non-overlapping ranges. On POSIX systems this uses `pwrite(2)`, so the
+ * threads do not contend on a shared file position.
+ *
+ * With @p direct_io, and where the platform supports `O_DIRECT`, the writes
+ * whose buffer, offset, and size are multiples of `kDirectIoAlignment` bypass
+ * the page cache. Any other writes go through the page cache as usual.
+ */
+class PositionalFileWriter {
+ public:
+  /// The alignment required for the writes that bypass the page cache.
+  static std::size_t constexpr kDirectIoAlignment = 4096;
+
+  /// Creates (or truncates) @p file_name and resizes it to @p size bytes.
+  static StatusOr<std::unique_ptr<PositionalFileWriter>> Create(
+      std::string const& file_name, std::uintmax_t size,
+      bool direct_io = false);
+
+  ~PositionalFileWriter();
+
+  PositionalFileWriter(PositionalFileWriter const&) = delete;
+  PositionalFileWriter& operator=(PositionalFileWriter const&) = delete;
+
+  /// Writes @p size bytes from @p data starting at @p offset.
+  Status WriteAt(std::uintmax_t offset, char const* data, std::size_t size);
+
+  /// Flushes and closes the file, reporting any errors.
+  Status Close();
+
+  std::string const& file_name() const { return file_name_; }
+
+ private:
+  struct Impl;
+  PositionalFileWriter(std::string file_name, std::unique_ptr<Impl> impl);
+
+  std::string file_name_;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_POSITIONAL_FILE_WRITER_H
@@ -0,0 +1,132 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/positional_file_writer.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/internal/filesystem.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Not;
+
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string{std::istreambuf_iterator<char>{is}, {}};
+}
+
+TEST(PositionalFileWriterTest, Preallocates) {
+  testing::TempFile temp("some existing contents that will be truncated");
+  auto writer = PositionalFileWriter::Create(temp.name(), 16);
+  ASSERT_STATUS_OK(writer);
+  EXPECT_STATUS_OK((*writer)->Close());
+  EXPECT_EQ(std::string(16, '\0'), ReadFile(temp.name()));
+}
+
+TEST(PositionalFileWriterTest, WriteOutOfOrder) {
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), 12);
+  ASSERT_STATUS_OK(writer);
+  EXPECT_STATUS_OK((*writer)->WriteAt(8, "9abc", 4));
+  EXPECT_STATUS_OK((*writer)->WriteAt(0, "1234", 4));
+  EXPECT_STATUS_OK((*writer)->WriteAt(4, "5678", 4));
+  EXPECT_STATUS_OK((*writer)->Close());
+  EXPECT_EQ("123456789abc", ReadFile(temp.name()));
+}
+
+TEST(PositionalFileWriterTest, ConcurrentWrites) {
+  auto constexpr kSliceCount = 16;
+  auto constexpr kSliceSize = 4096;
+  testing::TempFile temp("");
+  auto writer =
+      PositionalFileWriter::Create(temp.name(), kSliceCount * kSliceSize);
+  ASSERT_STATUS_OK(writer);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kSliceCount; ++i) {
+    threads.emplace_back([&writer, i] {
+      std::string const slice(kSliceSize, static_cast<char>('a' + i));
+      EXPECT_STATUS_OK((*writer)->WriteAt(i * kSliceSize, slice.data(),
+                                           slice.size()));
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_STATUS_OK((*writer)->Close());
+
+  std::string expected;
+  for (int i = 0; i != kSliceCount; ++i) {
+    expected += std::string(kSliceSize, static_cast<char>('a' + i));
+  }
+  EXPECT_EQ(expected, ReadFile(temp.name()));
+}
+
+TEST(PositionalFileWriterTest, CloseIsIdempotent) {
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), 0);
+  ASSERT_STATUS_OK(writer);
+  EXPECT_STATUS_OK((*writer)->Close());
+  EXPECT_STATUS_OK((*writer)->Close());
+}
+
+TEST(PositionalFileWriterTest, DirectIo) {
+  auto constexpr kAlignment = PositionalFileWriter::kDirectIoAlignment;
+  testing::TempFile temp("");
+  auto writer = PositionalFileWriter::Create(temp.name(), 2 * kAlignment + 4,
+                                             /*direct_io=*/true);
+  ASSERT_STATUS_OK(writer);
+  // An aligned write, which may bypass the page cache, and unaligned writes,
+  // which always use it.
+  std::unique_ptr<char[]> storage(new char[2 * kAlignment]);
+  auto* aligned = storage.get() +
+                  (kAlignment - reinterpret_cast<std::uintptr_t>(
+                                    storage.get()) % kAlignment) %
+                      kAlignment;
+  std::fill_n(aligned, kAlignment, 'a');
+  EXPECT_STATUS_OK((*writer)->WriteAt(kAlignment, aligned, kAlignment));
+  EXPECT_STATUS_OK((*writer)->WriteAt(0, std::string(kAlignment, 'b').data(),
+                                      kAlignment));
+  EXPECT_STATUS_OK((*writer)->WriteAt(2 * kAlignment, "cccc", 4));
+  EXPECT_STATUS_OK((*writer)->Close());
+  EXPECT_EQ(std::string(kAlignment, 'b') + std::string(kAlignment, 'a') +
+                "cccc",
+            ReadFile(temp.name()));
+}
+
+TEST(PositionalFileWriterTest, CreateError) {
+  auto const file_name = google::cloud::internal::PathAppend(
+      ::testing::TempDir(), "does-not-exist/some-file.txt");
+  auto writer = PositionalFileWriter::Create(file_name, 16);
+  EXPECT_THAT(writer, StatusIs(Not(StatusCode::kOk)));
+  EXPECT_THAT(writer.status().message(), ::testing::HasSubstr(file_name));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,206 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PREFETCHING_PAGED_STREAM_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PREFETCHING_PAGED_STREAM_READER_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/internal/pagination_range.h"
+#include "google/cloud/status_or.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Returns `T`s one at a time from pages loaded by a background thread.
+ *
+ * This is a variation of `google::cloud::internal::PagedStreamReader` that
+ * starts loading pages as soon as it is created. The background thread
+ * requests the next page as soon as the previous one arrives, and stops when
+ * `depth` pages are waiting to be consumed. A non-OK status stops the
+ * background thread, and is returned after all the previous pages are
+ * consumed.
+ *
+ * Deleting the object waits for any request in progress, but does not start
+ * new requests.
+ *
+ * @tparam T the type of the items
+ * @tparam Request the type of the request object for the `List` RPC, it must
+ *     have a `set_page_token()` member function.
+ * @tparam Response the type of the response object for the `List` RPC, it must
+ *     have a `next_page_token` data member.
+ */
+template <typename T, typename Request, typename Response>
+class PrefetchingPagedStreamReader {
+ public:
+  PrefetchingPagedStreamReader(
+      Request request, std::function<StatusOr<Response>(Request const&)> loader,
+      std::function<std::vector<T>(Response)> extractor, std::size_t depth)
+      : request_(std::move(request)),
+        loader_(std::move(loader)),
+        extractor_(std::move(extractor)),
+        depth_(depth == 0 ? 1 : depth) {
+    current_ = page_.begin();
+    worker_ = std::thread([this] { WorkerLoop(); });
+  }
+
+  ~PrefetchingPagedStreamReader() {
+    std::unique_lock<std::mutex> lk(mu_);
+    shutdown_ = true;
+    lk.unlock();
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  PrefetchingPagedStreamReader(PrefetchingPagedStreamReader const&) = delete;
+  PrefetchingPagedStreamReader& operator=(PrefetchingPagedStreamReader const&) =
+      delete;
+
+  /**
+   * Returns the next object from the stream, waiting for its page if needed.
+   *
+   * @return the next available `T`, if one exists (or can be loaded). Returns
+   *   a non-OK `Status` to indicate an error, and an OK `Status` to indicate a
+   *   successful end of stream.
+   */
+  typename google::cloud::internal::StreamReader<T>::result_type GetNext() {
+    // Some pages may be empty, for example when using `StartOffset`, skip them
+    // instead of ending the iteration.
+    while (current_ == page_.end()) {
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk, [this] { return !pages_.empty() || done_; });
+      if (pages_.empty()) return status_;
+      page_ = std::move(pages_.front());
+      pages_.pop_front();
+      lk.unlock();
+      cv_.notify_all();
+      current_ = page_.begin();
+    }
+    return std::move(*current_++);
+  }
+
+  /**
+   * Returns the next page from the stream, waiting for it if needed.
+   *
+   * The page is moved into @p batch. Any elements not yet returned by
+   * `GetNext()` are returned first. Empty pages are skipped.
+   *
+   * @return an OK `Status` with a non-empty @p batch if more elements may
+   *   follow, an OK `Status` with an empty @p batch to indicate a successful
+   *   end of stream, or a non-OK `Status` to indicate an error.
+   */
+  Status GetNextBatch(std::vector<T>& batch) {
+    if (current_ != page_.end()) {
+      batch.assign(std::make_move_iterator(current_),
+                   std::make_move_iterator(page_.end()));
+      current_ = page_.end();
+      return Status{};
+    }
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+      cv_.wait(lk, [this] { return !pages_.empty() || done_; });
+      if (pages_.empty()) return status_;
+      batch = std::move(pages_.front());
+      pages_.pop_front();
+      cv_.notify_all();
+      if (!batch.empty()) return Status{};
+    }
+  }
+
+ private:
+  void WorkerLoop() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+      cv_.wait(lk, [this] { return shutdown_ || pages_.size() < depth_; });
+      if (shutdown_) return;
+      lk.unlock();
+      auto response = loader_(request_);
+      lk.lock();
+      if (!response) {
+        status_ = std::move(response).status();
+        done_ = true;
+        cv_.notify_all();
+        return;
+      }
+      auto token = std::move(response->next_page_token);
+      pages_.push_back(extractor_(*std::move(response)));
+      done_ = token.empty();
+      cv_.notify_all();
+      if (done_) return;
+      request_.set_page_token(std::move(token));
+    }
+  }
+
+  // Only used by the background thread.
+  Request request_;
+  std::function<StatusOr<Response>(Request const&)> loader_;
+  std::function<std::vector<T>(Response)> extractor_;
+  std::size_t const depth_;
+
+  // Only used by the thread calling `GetNext()` or `GetNextBatch()`.
+  std::vector<T> page_;
+  typename std::vector<T>::iterator current_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::vector<T>> pages_;  // GUARDED_BY(mu_)
+  Status status_;                     // GUARDED_BY(mu_)
+  bool done_ = false;                 // GUARDED_BY(mu_)
+  bool shutdown_ = false;             // GUARDED_BY(mu_)
+  std::thread worker_;
+};
+
+/**
+ * Creates a `PaginationRange<T>` that loads pages in the background.
+ *
+ * The arguments are the same as in
+ * `google::cloud::internal::MakePaginationRange()`, @p depth is the maximum
+ * number of pages loaded ahead of the application.
+ */
+template <typename Range, typename Request, typename Loader, typename Extractor>
+Range MakePrefetchingPaginationRange(Request request, Loader loader,
+                                     Extractor extractor, std::size_t depth) {
+  using ValueType = typename Range::value_type::value_type;
+  using LoaderResult =
+      google::cloud::internal::invoke_result_t<Loader, Request>;
+  using Response = typename LoaderResult::value_type;
+  using ReaderType = PrefetchingPagedStreamReader<ValueType, Request, Response>;
+  auto reader = std::make_shared<ReaderType>(
+      std::move(request), std::move(loader), std::move(extractor), depth);
+  return google::cloud::internal::MakeBatchStreamRange<ValueType>(
+      [reader](std::vector<ValueType>& batch) {
+        return reader->GetNextBatch(batch);
+      });
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PREFETCHING_PAGED_STREAM_READER_H
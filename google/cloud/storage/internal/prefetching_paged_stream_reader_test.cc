@@ -0,0 +1,167 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/prefetching_paged_stream_reader.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+struct TestRequest {
+  std::string page_token;
+  void set_page_token(std::string t) { page_token = std::move(t); }
+};
+
+struct TestResponse {
+  std::string next_page_token;
+  std::vector<int> items;
+};
+
+using TestRange = google::cloud::internal::PaginationRange<int>;
+
+// Each page contains two items, page i has the items 2*i and 2*i+1.
+StatusOr<TestResponse> MakePage(TestRequest const& request, int page_count) {
+  auto const page = request.page_token.empty() ? 0
+                                               : std::stoi(request.page_token);
+  TestResponse response;
+  response.items = {2 * page, 2 * page + 1};
+  if (page + 1 != page_count) {
+    response.next_page_token = std::to_string(page + 1);
+  }
+  return response;
+}
+
+std::vector<int> Extract(TestResponse r) { return std::move(r.items); }
+
+template <typename Predicate>
+bool WaitFor(Predicate p) {
+  auto const deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!p()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+TEST(PrefetchingPagedStreamReaderTest, Basic) {
+  auto range = MakePrefetchingPaginationRange<TestRange>(
+      TestRequest{}, [](TestRequest const& r) { return MakePage(r, 3); },
+      Extract, 2);
+  std::vector<int> actual;
+  for (auto& v : range) {
+    ASSERT_STATUS_OK(v);
+    actual.push_back(*v);
+  }
+  EXPECT_THAT(actual, ElementsAre(0, 1, 2, 3, 4, 5));
+}
+
+TEST(PrefetchingPagedStreamReaderTest, LoadsAhead) {
+  std::atomic<int> calls{0};
+  PrefetchingPagedStreamReader<int, TestRequest, TestResponse> reader(
+      TestRequest{},
+      [&calls](TestRequest const& r) {
+        ++calls;
+        return MakePage(r, 100);
+      },
+      Extract, 2);
+  // The reader loads up to two pages before the application asks for them.
+  ASSERT_TRUE(WaitFor([&calls] { return calls.load() == 2; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(2, calls.load());
+
+  // Consuming a page makes room for another one.
+  auto v = reader.GetNext();
+  ASSERT_TRUE(absl::holds_alternative<int>(v));
+  EXPECT_EQ(0, absl::get<int>(v));
+  ASSERT_TRUE(WaitFor([&calls] { return calls.load() == 3; }));
+}
+
+TEST(PrefetchingPagedStreamReaderTest, SkipsEmptyPages) {
+  auto range = MakePrefetchingPaginationRange<TestRange>(
+      TestRequest{},
+      [](TestRequest const& r) {
+        auto response = MakePage(r, 4);
+        if (response && r.page_token != "2") response->items.clear();
+        return response;
+      },
+      Extract, 1);
+  std::vector<int> actual;
+  for (auto& v : range) {
+    ASSERT_STATUS_OK(v);
+    actual.push_back(*v);
+  }
+  EXPECT_THAT(actual, ElementsAre(4, 5));
+}
+
+TEST(PrefetchingPagedStreamReaderTest, PermanentFailure) {
+  auto range = MakePrefetchingPaginationRange<TestRange>(
+      TestRequest{},
+      [](TestRequest const& r) -> StatusOr<TestResponse> {
+        if (r.page_token == "2") return PermanentError();
+        return MakePage(r, 10);
+      },
+      Extract, 4);
+  std::vector<int> actual;
+  Status status;
+  for (auto& v : range) {
+    if (!v) {
+      status = std::move(v).status();
+      continue;
+    }
+    actual.push_back(*v);
+  }
+  EXPECT_THAT(status, StatusIs(PermanentError().code()));
+  EXPECT_THAT(actual, ElementsAre(0, 1, 2, 3));
+}
+
+TEST(PrefetchingPagedStreamReaderTest, DestroyWhileLoading) {
+  std::atomic<int> calls{0};
+  {
+    auto range = MakePrefetchingPaginationRange<TestRange>(
+        TestRequest{},
+        [&calls](TestRequest const& r) {
+          ++calls;
+          return MakePage(r, 1000);
+        },
+        Extract, 8);
+    auto it = range.begin();
+    ASSERT_NE(it, range.end());
+    EXPECT_EQ(0, **it);
+  }
+  // After the range is deleted no more pages are requested.
+  auto const count = calls.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(count, calls.load());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
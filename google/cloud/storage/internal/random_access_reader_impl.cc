@@ -0,0 +1,179 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/random_access_reader_impl.h"
+#include "google/cloud/log.h"
+#include <algorithm>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// Skipped bytes are read into a scratch buffer of (at most) this size.
+auto constexpr kDiscardBufferSize = 64 * 1024;
+
+void CloseSource(std::unique_ptr<ObjectReadSource> source) {
+  if (!source || !source->IsOpen()) return;
+  auto response = source->Close();
+  if (!response) {
+    GCP_LOG(INFO) << "Ignored error while closing download: "
+                  << response.status();
+  }
+}
+
+}  // namespace
+
+RandomAccessReaderImpl::RandomAccessReaderImpl(
+    std::shared_ptr<RawClient> client, ReadObjectRangeRequest request,
+    std::int64_t generation, std::int64_t size, RandomAccessReaderConfig config)
+    : client_(std::move(client)),
+      request_(std::move(request)),
+      generation_(generation),
+      size_(size),
+      config_{(std::max)(config.min_readahead, std::size_t{1}),
+              (std::max)(config.min_readahead, config.max_readahead),
+              config.max_idle_streams} {}
+
+RandomAccessReaderImpl::~RandomAccessReaderImpl() { Close(); }
+
+StatusOr<std::size_t> RandomAccessReaderImpl::ReadAt(std::int64_t offset,
+                                                     char* buf,
+                                                     std::size_t n) {
+  if (offset < 0) {
+    return Status(StatusCode::kInvalidArgument,
+                  "ReadAt(): the offset must be non-negative");
+  }
+  if (offset >= size_ || n == 0) return 0;
+  n = static_cast<std::size_t>(
+      (std::min)(static_cast<std::int64_t>(n), size_ - offset));
+
+  auto stream = CheckOut(offset);
+  std::vector<char> discard;
+  std::size_t count = 0;
+  // Stop if a new download ends without returning any data, the object is
+  // shorter than its metadata said.
+  bool progress = true;
+  while (count < n) {
+    auto const pos = offset + static_cast<std::int64_t>(count);
+    if (!stream.source || stream.offset >= stream.end) {
+      if (!progress) break;
+      // Reading past the end of a stream is a sequential scan, use a larger
+      // readahead for the next download.
+      auto const readahead =
+          stream.source
+              ? (std::min)(2 * stream.readahead,
+                           static_cast<std::int64_t>(config_.max_readahead))
+              : static_cast<std::int64_t>(config_.min_readahead);
+      CloseSource(std::move(stream.source));
+      auto s = Open(pos, n - count, readahead);
+      if (!s) return std::move(s).status();
+      stream = *std::move(s);
+      progress = false;
+    }
+
+    char* dest = buf + count;
+    auto capacity = (std::min)(static_cast<std::int64_t>(n - count),
+                               stream.end - stream.offset);
+    auto const skip = stream.offset < pos;
+    if (skip) {
+      // Discard the bytes between the stream position and the read offset.
+      discard.resize(kDiscardBufferSize);
+      dest = discard.data();
+      capacity = (std::min)(capacity, pos - stream.offset);
+      capacity = (std::min)(capacity,
+                            static_cast<std::int64_t>(kDiscardBufferSize));
+    }
+    auto r = stream.source->Read(dest, static_cast<std::size_t>(capacity));
+    if (!r) return std::move(r).status();
+    if (r->response.status_code >= HttpStatusCode::kMinNotSuccess) {
+      return AsStatus(r->response);
+    }
+    if (r->bytes_received != 0) progress = true;
+    stream.offset += static_cast<std::int64_t>(r->bytes_received);
+    if (!skip) count += r->bytes_received;
+    if (!stream.source->IsOpen()) {
+      stream.end = (std::min)(stream.end, stream.offset);
+    }
+  }
+  Return(std::move(stream));
+  return count;
+}
+
+void RandomAccessReaderImpl::Close() {
+  std::list<Stream> idle;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    idle.swap(idle_);
+  }
+  for (auto& s : idle) CloseSource(std::move(s.source));
+}
+
+std::size_t RandomAccessReaderImpl::idle_streams() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return idle_.size();
+}
+
+RandomAccessReaderImpl::Stream RandomAccessReaderImpl::CheckOut(
+    std::int64_t offset) {
+  auto const max_gap = static_cast<std::int64_t>(config_.min_readahead);
+  std::lock_guard<std::mutex> lk(mu_);
+  for (auto i = idle_.begin(); i != idle_.end(); ++i) {
+    if (offset < i->offset || offset > i->end) continue;
+    if (offset - i->offset > max_gap) continue;
+    auto stream = std::move(*i);
+    idle_.erase(i);
+    return stream;
+  }
+  return Stream{nullptr, offset, offset, 0};
+}
+
+void RandomAccessReaderImpl::Return(Stream stream) {
+  if (!stream.source) return;
+  // Close evicted streams after releasing the lock.
+  std::unique_ptr<ObjectReadSource> evicted;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    idle_.push_front(std::move(stream));
+    if (idle_.size() > config_.max_idle_streams) {
+      evicted = std::move(idle_.back().source);
+      idle_.pop_back();
+    }
+  }
+  CloseSource(std::move(evicted));
+}
+
+StatusOr<RandomAccessReaderImpl::Stream> RandomAccessReaderImpl::Open(
+    std::int64_t offset, std::size_t n, std::int64_t readahead) {
+  auto const length = (std::max)(static_cast<std::int64_t>(n), readahead);
+  auto const end = (std::min)(size_, offset + length);
+  ReadObjectRangeRequest request(request_.bucket_name(),
+                                 request_.object_name());
+  request.set_multiple_options(
+      Generation(generation_), ReadRange(offset, end),
+      request_.GetOption<EncryptionKey>(), request_.GetOption<UserProject>(),
+      request_.GetOption<QuotaUser>(), request_.GetOption<UserIp>());
+  auto source = client_->ReadObject(request);
+  if (!source) return std::move(source).status();
+  return Stream{*std::move(source), offset, end, readahead};
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,110 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RANDOM_ACCESS_READER_IMPL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RANDOM_ACCESS_READER_IMPL_H
+
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// The configuration for a `RandomAccessReaderImpl`.
+struct RandomAccessReaderConfig {
+  std::size_t min_readahead;
+  std::size_t max_readahead;
+  std::size_t max_idle_streams;
+};
+
+/**
+ * Implements `RandomAccessObjectReader`.
+ *
+ * The reader keeps a small pool of open ranged downloads ("streams"). Each
+ * `ReadAt()` call checks out the stream positioned at, or shortly before, the
+ * requested offset, discarding any bytes in between, so nearby small reads
+ * share a single ranged request. If there is no such stream the reader starts
+ * a new download of at least `min_readahead` bytes. When a read continues past
+ * the end of a stream the next download doubles the readahead, up to
+ * `max_readahead`, so sequential scans use few, large, requests.
+ *
+ * The network I/O happens outside the lock, concurrent calls use separate
+ * streams.
+ */
+class RandomAccessReaderImpl {
+ public:
+  RandomAccessReaderImpl(std::shared_ptr<RawClient> client,
+                         ReadObjectRangeRequest request,
+                         std::int64_t generation, std::int64_t size,
+                         RandomAccessReaderConfig config);
+  ~RandomAccessReaderImpl();
+
+  StatusOr<std::size_t> ReadAt(std::int64_t offset, char* buf, std::size_t n);
+
+  std::int64_t generation() const { return generation_; }
+  std::int64_t size() const { return size_; }
+
+  /// Closes all the idle streams.
+  void Close();
+
+  /// The number of idle streams, mostly for testing.
+  std::size_t idle_streams() const;
+
+ private:
+  struct Stream {
+    std::unique_ptr<ObjectReadSource> source;
+    // The position of the next byte returned by `source`, and the end of its
+    // range.
+    std::int64_t offset;
+    std::int64_t end;
+    std::int64_t readahead;
+  };
+
+  /// Removes the best idle stream to read from @p offset from the pool.
+  Stream CheckOut(std::int64_t offset);
+  /// Returns @p stream to the pool, evicting old streams if needed.
+  void Return(Stream stream);
+  /// Starts a download for at least @p n bytes at @p offset.
+  StatusOr<Stream> Open(std::int64_t offset, std::size_t n,
+                        std::int64_t readahead);
+
+  std::shared_ptr<RawClient> client_;
+  ReadObjectRangeRequest request_;
+  std::int64_t const generation_;
+  std::int64_t const size_;
+  RandomAccessReaderConfig const config_;
+
+  mutable std::mutex mu_;
+  // The idle streams, the most recently used first.
+  std::list<Stream> idle_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RANDOM_ACCESS_READER_IMPL_H
@@ -0,0 +1,307 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/random_access_reader_impl.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+using ::testing::Return;
+
+/// Serves a range of an object, in small pieces, like a real download.
+class FakeReadSource : public ObjectReadSource {
+ public:
+  explicit FakeReadSource(std::string contents)
+      : contents_(std::move(contents)) {}
+
+  bool IsOpen() const override { return open_; }
+  StatusOr<HttpResponse> Close() override {
+    open_ = false;
+    return HttpResponse{HttpStatusCode::kOk, {}, {}};
+  }
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override {
+    auto count = (std::min)({n, contents_.size() - offset_, std::size_t{7}});
+    std::memcpy(buf, contents_.data() + offset_, count);
+    offset_ += count;
+    ReadSourceResult result{count,
+                            HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+    if (offset_ == contents_.size()) {
+      open_ = false;
+      result.response.status_code = HttpStatusCode::kOk;
+    }
+    return result;
+  }
+
+ private:
+  std::string contents_;
+  std::size_t offset_ = 0;
+  bool open_ = true;
+};
+
+std::string MakeContents(std::size_t size) {
+  std::string contents(size, '\0');
+  for (std::size_t i = 0; i != size; ++i) {
+    contents[i] = static_cast<char>('a' + i % 26);
+  }
+  return contents;
+}
+
+/// Serves ranged reads of @p contents, and records the requested ranges.
+class FakeObject {
+ public:
+  explicit FakeObject(std::string contents) : contents_(std::move(contents)) {}
+
+  StatusOr<std::unique_ptr<ObjectReadSource>> operator()(
+      ReadObjectRangeRequest const& request) {
+    EXPECT_EQ(42, request.GetOption<Generation>().value_or(0));
+    auto const range = request.GetOption<ReadRange>().value();
+    std::lock_guard<std::mutex> lk(mu_);
+    ranges_.emplace_back(range.begin, range.end);
+    auto const end = (std::min)(static_cast<std::size_t>(range.end),
+                                contents_.size());
+    auto const begin = static_cast<std::size_t>(range.begin);
+    return std::unique_ptr<ObjectReadSource>(absl::make_unique<FakeReadSource>(
+        contents_.substr(begin, end - begin)));
+  }
+
+  std::vector<std::pair<std::int64_t, std::int64_t>> ranges() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return ranges_;
+  }
+
+ private:
+  std::string contents_;
+  std::mutex mu_;
+  std::vector<std::pair<std::int64_t, std::int64_t>> ranges_;
+};
+
+std::shared_ptr<RandomAccessReaderImpl> MakeReader(
+    std::shared_ptr<MockClient> mock, std::int64_t size,
+    std::size_t max_idle_streams = 4) {
+  return std::make_shared<RandomAccessReaderImpl>(
+      std::move(mock), ReadObjectRangeRequest("test-bucket", "test"), 42, size,
+      RandomAccessReaderConfig{100, 400, max_idle_streams});
+}
+
+std::string ReadAt(std::shared_ptr<RandomAccessReaderImpl> const& reader,
+                   std::int64_t offset, std::size_t n) {
+  std::string buffer(n, '\0');
+  auto r = reader->ReadAt(offset, &buffer[0], buffer.size());
+  EXPECT_STATUS_OK(r);
+  buffer.resize(r ? *r : 0);
+  return buffer;
+}
+
+TEST(RandomAccessReaderImplTest, Basic) {
+  auto const contents = MakeContents(1000);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillRepeatedly(std::ref(object));
+
+  auto reader = MakeReader(mock, 1000);
+  EXPECT_EQ(contents.substr(10, 20), ReadAt(reader, 10, 20));
+  EXPECT_THAT(object.ranges(), ElementsAre(Pair(10, 110)));
+  EXPECT_EQ(1, reader->idle_streams());
+}
+
+TEST(RandomAccessReaderImplTest, CoalescesNearbyReads) {
+  auto const contents = MakeContents(1000);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillRepeatedly(std::ref(object));
+
+  auto reader = MakeReader(mock, 1000);
+  EXPECT_EQ(contents.substr(0, 10), ReadAt(reader, 0, 10));
+  EXPECT_EQ(contents.substr(30, 10), ReadAt(reader, 30, 10));
+  EXPECT_EQ(contents.substr(60, 10), ReadAt(reader, 60, 10));
+  EXPECT_THAT(object.ranges(), ElementsAre(Pair(0, 100)));
+}
+
+TEST(RandomAccessReaderImplTest, SequentialReadsGrowReadahead) {
+  auto const contents = MakeContents(1000);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillRepeatedly(std::ref(object));
+
+  auto reader = MakeReader(mock, 1000);
+  std::string actual;
+  for (std::int64_t offset = 0; offset < 1000; offset += 100) {
+    actual += ReadAt(reader, offset, 100);
+  }
+  EXPECT_EQ(contents, actual);
+  EXPECT_THAT(object.ranges(), ElementsAre(Pair(0, 100), Pair(100, 300),
+                                           Pair(300, 700), Pair(700, 1000)));
+}
+
+TEST(RandomAccessReaderImplTest, DistantReadsUseSeparateStreams) {
+  auto const contents = MakeContents(1000);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillRepeatedly(std::ref(object));
+
+  auto reader = MakeReader(mock, 1000, 2);
+  EXPECT_EQ(contents.substr(0, 10), ReadAt(reader, 0, 10));
+  EXPECT_EQ(contents.substr(500, 10), ReadAt(reader, 500, 10));
+  EXPECT_EQ(2, reader->idle_streams());
+  // Both streams can be continued.
+  EXPECT_EQ(contents.substr(20, 10), ReadAt(reader, 20, 10));
+  EXPECT_EQ(contents.substr(520, 10), ReadAt(reader, 520, 10));
+  // A third stream evicts the least recently used.
+  EXPECT_EQ(contents.substr(800, 10), ReadAt(reader, 800, 10));
+  EXPECT_EQ(2, reader->idle_streams());
+  EXPECT_EQ(contents.substr(40, 10), ReadAt(reader, 40, 10));
+  EXPECT_THAT(object.ranges(), ElementsAre(Pair(0, 100), Pair(500, 600),
+                                           Pair(800, 900), Pair(40, 140)));
+
+  reader->Close();
+  EXPECT_EQ(0, reader->idle_streams());
+}
+
+TEST(RandomAccessReaderImplTest, EndOfObject) {
+  auto const contents = MakeContents(1000);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillRepeatedly(std::ref(object));
+
+  auto reader = MakeReader(mock, 1000);
+  EXPECT_EQ(contents.substr(990), ReadAt(reader, 990, 100));
+  EXPECT_EQ("", ReadAt(reader, 1000, 10));
+  EXPECT_EQ("", ReadAt(reader, 2000, 10));
+  char buffer[4];
+  EXPECT_THAT(reader->ReadAt(-1, buffer, sizeof(buffer)),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(object.ranges(), ElementsAre(Pair(990, 1000)));
+}
+
+TEST(RandomAccessReaderImplTest, ObjectShorterThanExpected) {
+  auto const contents = MakeContents(500);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillRepeatedly(std::ref(object));
+
+  auto reader = MakeReader(mock, 1000);
+  EXPECT_EQ(contents.substr(450), ReadAt(reader, 450, 100));
+  EXPECT_THAT(object.ranges(), ElementsAre(Pair(450, 550), Pair(500, 700)));
+}
+
+TEST(RandomAccessReaderImplTest, Error) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillOnce(Return(PermanentError()));
+
+  auto reader = MakeReader(mock, 1000);
+  char buffer[16];
+  EXPECT_THAT(reader->ReadAt(0, buffer, sizeof(buffer)),
+              StatusIs(PermanentError().code()));
+  EXPECT_EQ(0, reader->idle_streams());
+}
+
+TEST(RandomAccessReaderImplTest, Concurrent) {
+  auto const contents = MakeContents(100000);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject).WillRepeatedly(std::ref(object));
+
+  auto reader = MakeReader(mock, 100000);
+  auto worker = [&](int seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<std::int64_t> offsets(0, 100000);
+    std::uniform_int_distribution<std::size_t> sizes(1, 300);
+    for (int i = 0; i != 200; ++i) {
+      auto const offset = offsets(gen);
+      auto const n = sizes(gen);
+      std::string buffer(n, '\0');
+      auto r = reader->ReadAt(offset, &buffer[0], n);
+      ASSERT_STATUS_OK(r);
+      buffer.resize(*r);
+      EXPECT_EQ(contents.substr(static_cast<std::size_t>(offset), n), buffer);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 8; ++i) threads.emplace_back(worker, i);
+  for (auto& t : threads) t.join();
+  EXPECT_LE(reader->idle_streams(), 4);
+}
+
+TEST(RandomAccessReaderImplTest, OpenFromClient) {
+  auto const contents = MakeContents(1000);
+  FakeObject object(contents);
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata)
+      .WillOnce([](GetObjectMetadataRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test", request.object_name());
+        EXPECT_EQ("my-project", request.GetOption<UserProject>().value());
+        return ObjectMetadataParser::FromString(R"""({
+            "bucket": "test-bucket",
+            "name": "test",
+            "generation": "42",
+            "size": "1000"
+        })""");
+      });
+  EXPECT_CALL(*mock, ReadObject)
+      .WillRepeatedly([&object](ReadObjectRangeRequest const& request) {
+        EXPECT_EQ("my-project", request.GetOption<UserProject>().value());
+        return object(request);
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  auto reader = client.OpenRandomAccessReader("test-bucket", "test",
+                                              UserProject("my-project"));
+  ASSERT_STATUS_OK(reader);
+  EXPECT_EQ(1000, reader->size());
+  EXPECT_EQ(42, reader->generation());
+  std::vector<char> buffer(8);
+  auto n = reader->ReadAt(992, MutableBuffer(buffer));
+  ASSERT_STATUS_OK(n);
+  EXPECT_EQ(contents.substr(992), std::string(buffer.data(), *n));
+}
+
+TEST(RandomAccessReaderImplTest, OpenFromClientError) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata).WillOnce(Return(PermanentError()));
+  EXPECT_CALL(*mock, ReadObject).Times(0);
+
+  auto client = testing::ClientFromMock(mock);
+  auto reader = client.OpenRandomAccessReader("test-bucket", "test");
+  EXPECT_THAT(reader, StatusIs(PermanentError().code()));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
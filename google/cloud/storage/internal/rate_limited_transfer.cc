@@ -0,0 +1,84 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/rate_limited_transfer.h"
+#include "google/cloud/storage/options.h"
+#include "absl/memory/memory.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+template <typename Request>
+std::pair<std::shared_ptr<TransferRateLimiter>, TransferPriority>
+TransferRateLimit(Options const& options, Request const& request) {
+  auto limiter = request.template GetOption<UseTransferRateLimiter>().value_or(
+      options.get<storage_experimental::TransferRateLimiterOption>());
+  auto priority = request.template GetOption<WithTransferPriority>().value_or(
+      options.get<storage_experimental::TransferPriorityOption>());
+  return {std::move(limiter), priority};
+}
+
+}  // namespace
+
+StatusOr<ReadSourceResult> RateLimitedReadSource::Read(char* buf,
+                                                       std::size_t n) {
+  auto result = child_->Read(buf, n);
+  // The data is already received, but blocking here stops the reader from
+  // draining the socket, and the transport applies backpressure.
+  if (result) limiter_->Acquire(result->bytes_received, priority_);
+  return result;
+}
+
+StatusOr<ResumableUploadResponse> RateLimitedUploadSession::UploadChunk(
+    ConstBufferSequence const& buffers) {
+  limiter_->Acquire(TotalBytes(buffers), priority_);
+  return child_->UploadChunk(buffers);
+}
+
+StatusOr<ResumableUploadResponse> RateLimitedUploadSession::UploadFinalChunk(
+    ConstBufferSequence const& buffers, std::uint64_t upload_size,
+    HashValues const& full_object_hashes) {
+  limiter_->Acquire(TotalBytes(buffers), priority_);
+  return child_->UploadFinalChunk(buffers, upload_size, full_object_hashes);
+}
+
+std::unique_ptr<ObjectReadSource> RateLimitDownload(
+    Options const& options, ReadObjectRangeRequest const& request,
+    std::unique_ptr<ObjectReadSource> source) {
+  auto limit = TransferRateLimit(options, request);
+  if (!limit.first) return source;
+  return absl::make_unique<RateLimitedReadSource>(
+      std::move(source), std::move(limit.first), limit.second);
+}
+
+std::unique_ptr<ResumableUploadSession> RateLimitUpload(
+    Options const& options, ResumableUploadRequest const& request,
+    std::unique_ptr<ResumableUploadSession> session) {
+  auto limit = TransferRateLimit(options, request);
+  if (!limit.first) return session;
+  return absl::make_unique<RateLimitedUploadSession>(
+      std::move(session), std::move(limit.first), limit.second);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,116 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RATE_LIMITED_TRANSFER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RATE_LIMITED_TRANSFER_H
+
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/transfer_rate_limiter.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/options.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// Takes tokens from a `TransferRateLimiter` for each block downloaded.
+class RateLimitedReadSource : public ObjectReadSource {
+ public:
+  RateLimitedReadSource(std::unique_ptr<ObjectReadSource> child,
+                        std::shared_ptr<TransferRateLimiter> limiter,
+                        TransferPriority priority)
+      : child_(std::move(child)),
+        limiter_(std::move(limiter)),
+        priority_(priority) {}
+
+  bool IsOpen() const override { return child_->IsOpen(); }
+  StatusOr<HttpResponse> Close() override { return child_->Close(); }
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+
+ private:
+  std::unique_ptr<ObjectReadSource> child_;
+  std::shared_ptr<TransferRateLimiter> limiter_;
+  TransferPriority priority_;
+};
+
+/// Takes tokens from a `TransferRateLimiter` before each chunk is uploaded.
+class RateLimitedUploadSession : public ResumableUploadSession {
+ public:
+  RateLimitedUploadSession(std::unique_ptr<ResumableUploadSession> child,
+                           std::shared_ptr<TransferRateLimiter> limiter,
+                           TransferPriority priority)
+      : child_(std::move(child)),
+        limiter_(std::move(limiter)),
+        priority_(priority) {}
+
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      ConstBufferSequence const& buffers) override;
+  StatusOr<ResumableUploadResponse> UploadFinalChunk(
+      ConstBufferSequence const& buffers, std::uint64_t upload_size,
+      HashValues const& full_object_hashes) override;
+  StatusOr<ResumableUploadResponse> ResetSession() override {
+    return child_->ResetSession();
+  }
+  std::uint64_t next_expected_byte() const override {
+    return child_->next_expected_byte();
+  }
+  std::string const& session_id() const override {
+    return child_->session_id();
+  }
+  bool done() const override { return child_->done(); }
+  StatusOr<ResumableUploadResponse> const& last_response() const override {
+    return child_->last_response();
+  }
+  std::uint64_t failed_attempts() const override {
+    return child_->failed_attempts();
+  }
+
+ private:
+  std::unique_ptr<ResumableUploadSession> child_;
+  std::shared_ptr<TransferRateLimiter> limiter_;
+  TransferPriority priority_;
+};
+
+/**
+ * Wraps @p source in a `RateLimitedReadSource` if the download is rate
+ * limited.
+ *
+ * The request options, if set, override the limiter and priority in the
+ * client @p options.
+ */
+std::unique_ptr<ObjectReadSource> RateLimitDownload(
+    Options const& options, ReadObjectRangeRequest const& request,
+    std::unique_ptr<ObjectReadSource> source);
+
+/// Wraps @p session in a `RateLimitedUploadSession` if the upload is rate
+/// limited.
+std::unique_ptr<ResumableUploadSession> RateLimitUpload(
+    Options const& options, ResumableUploadRequest const& request,
+    std::unique_ptr<ResumableUploadSession> session);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RATE_LIMITED_TRANSFER_H
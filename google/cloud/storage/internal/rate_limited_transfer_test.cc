@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/rate_limited_transfer.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::Return;
+
+TEST(RateLimitedTransferTest, DownloadNotLimited) {
+  auto mock = absl::make_unique<testing::MockObjectReadSource>();
+  auto* expected = mock.get();
+  auto actual =
+      RateLimitDownload(Options{}, ReadObjectRangeRequest("b", "o"),
+                        std::move(mock));
+  EXPECT_EQ(expected, actual.get());
+}
+
+TEST(RateLimitedTransferTest, DownloadLimitedByClient) {
+  auto mock = absl::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read).WillOnce([](char*, std::size_t n) {
+    return make_status_or(ReadSourceResult{n, HttpResponse{200, {}, {}}});
+  });
+  EXPECT_CALL(*mock, IsOpen).WillOnce(Return(true));
+  auto* expected = mock.get();
+  auto options = Options{}.set<storage_experimental::TransferRateLimiterOption>(
+      TransferRateLimiter::Create(1024 * 1024));
+  auto actual = RateLimitDownload(options, ReadObjectRangeRequest("b", "o"),
+                                  std::move(mock));
+  EXPECT_NE(expected, actual.get());
+  std::vector<char> buffer(1024);
+  auto result = actual->Read(buffer.data(), buffer.size());
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(buffer.size(), result->bytes_received);
+  EXPECT_TRUE(actual->IsOpen());
+}
+
+TEST(RateLimitedTransferTest, UploadLimitedByRequest) {
+  auto limiter = TransferRateLimiter::Create(8 * 1024 * 1024, 256 * 1024);
+  auto mock = absl::make_unique<testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, UploadChunk).WillOnce([](ConstBufferSequence const&) {
+    return make_status_or(ResumableUploadResponse{
+        "", 0, {}, ResumableUploadResponse::kInProgress, {}});
+  });
+  EXPECT_CALL(*mock, failed_attempts).WillOnce(Return(3));
+  auto actual = RateLimitUpload(
+      Options{},
+      ResumableUploadRequest("b", "o")
+          .set_multiple_options(UseTransferRateLimiter(limiter),
+                                WithTransferPriority(
+                                    TransferPriority::kBackground)),
+      std::move(mock));
+  std::string const payload(2 * 1024 * 1024, 'x');
+  ASSERT_STATUS_OK(actual->UploadChunk({ConstBuffer(payload)}));
+  EXPECT_EQ(3, actual->failed_attempts());
+
+  // The chunk left the limiter in debt, acquiring more tokens must wait.
+  auto const start = std::chrono::steady_clock::now();
+  limiter->Acquire(1, TransferPriority::kBackground);
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(150));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/bucket_metadata.h"
 #include "google/cloud/storage/client_options.h"
+#include "google/cloud/storage/internal/batch_requests.h"
 #include "google/cloud/storage/internal/bucket_acl_requests.h"
 #include "google/cloud/storage/internal/bucket_requests.h"
 #include "google/cloud/storage/internal/default_object_acl_requests.h"
@@ -105,6 +106,18 @@ class RawClient {
   RestoreResumableSession(std::string const& session_id) = 0;
   virtual StatusOr<EmptyResponse> DeleteResumableUpload(
       DeleteResumableUploadRequest const& request) = 0;
+
+  /**
+   * Sends multiple object requests in a single `multipart/mixed` request.
+   *
+   * Not all transports support batches, the default implementation returns
+   * `kUnimplemented`.
+   */
+  virtual StatusOr<ExecuteBatchResponse> ExecuteBatch(
+      ExecuteBatchRequest const&) {
+    return Status(StatusCode::kUnimplemented,
+                  "batch requests are not supported by this client");
+  }
   //@}
 
   //@{
@@ -0,0 +1,73 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/read_block_cache.h"
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+ReadBlockCache::ReadBlockCache(std::size_t max_bytes, std::size_t block_size)
+    : max_bytes_(max_bytes), block_size_(block_size) {}
+
+std::shared_ptr<ReadBlockCache::Block const> ReadBlockCache::Lookup(
+    std::string const& object_key, std::int64_t index) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto i = index_.find(MakeKey(object_key, index));
+  if (i == index_.end()) return nullptr;
+  entries_.splice(entries_.begin(), entries_, i->second);
+  return i->second->block;
+}
+
+void ReadBlockCache::Insert(std::string const& object_key, std::int64_t index,
+                            std::shared_ptr<Block const> block) {
+  auto const block_bytes = block->data.size();
+  if (block_bytes > max_bytes_) return;
+  auto key = MakeKey(object_key, index);
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = index_.find(key);
+  if (i != index_.end()) Erase(lk, i->second);
+  while (!entries_.empty() && size_bytes_ + block_bytes > max_bytes_) {
+    Erase(lk, std::prev(entries_.end()));
+  }
+  entries_.push_front(Entry{key, std::move(block)});
+  index_.emplace(std::move(key), entries_.begin());
+  size_bytes_ += block_bytes;
+}
+
+std::size_t ReadBlockCache::size_bytes() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return size_bytes_;
+}
+
+std::string ReadBlockCache::MakeKey(std::string const& object_key,
+                                    std::int64_t index) {
+  return object_key + "#" + std::to_string(index);
+}
+
+void ReadBlockCache::Erase(std::unique_lock<std::mutex> const&,
+                           EntryList::iterator i) {
+  size_bytes_ -= i->block->data.size();
+  index_.erase(i->key);
+  entries_.erase(i);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READ_BLOCK_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READ_BLOCK_CACHE_H
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * An in-memory LRU cache of fixed-size blocks of object data.
+ *
+ * Objects are split into blocks of `block_size()` bytes, the last block may be
+ * shorter. The blocks are keyed by an object key, which must identify a
+ * specific object generation, and their index in the object. The cache evicts
+ * the least recently used blocks once the total size exceeds `max_bytes`.
+ */
+class ReadBlockCache {
+ public:
+  struct Block {
+    std::string data;
+    /// The full object size, or -1 if not known.
+    std::int64_t object_size = -1;
+  };
+
+  ReadBlockCache(std::size_t max_bytes, std::size_t block_size);
+
+  std::size_t block_size() const { return block_size_; }
+
+  /// Returns the block, or `nullptr` if it is not in the cache.
+  std::shared_ptr<Block const> Lookup(std::string const& object_key,
+                                      std::int64_t index);
+  void Insert(std::string const& object_key, std::int64_t index,
+              std::shared_ptr<Block const> block);
+
+  /// The total size of the cached blocks.
+  std::size_t size_bytes() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<Block const> block;
+  };
+  using EntryList = std::list<Entry>;
+
+  static std::string MakeKey(std::string const& object_key,
+                             std::int64_t index);
+  void Erase(std::unique_lock<std::mutex> const&, EntryList::iterator i);
+
+  std::size_t const max_bytes_;
+  std::size_t const block_size_;
+
+  mutable std::mutex mu_;
+  // The most recently used blocks are at the front.
+  EntryList entries_;           // GUARDED_BY(mu_)
+  std::size_t size_bytes_ = 0;  // GUARDED_BY(mu_)
+  // Map each key to its position in `entries_`.
+  std::unordered_map<std::string, EntryList::iterator>
+      index_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READ_BLOCK_CACHE_H
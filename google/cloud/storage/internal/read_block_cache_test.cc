@@ -0,0 +1,84 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/read_block_cache.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::shared_ptr<ReadBlockCache::Block const> MakeBlock(std::string data) {
+  auto block = std::make_shared<ReadBlockCache::Block>();
+  block->data = std::move(data);
+  return block;
+}
+
+TEST(ReadBlockCacheTest, InsertAndLookup) {
+  ReadBlockCache cache(64, 16);
+  EXPECT_EQ(16, cache.block_size());
+  EXPECT_EQ(nullptr, cache.Lookup("b/o#1", 0));
+  cache.Insert("b/o#1", 0, MakeBlock("0123456789abcdef"));
+  cache.Insert("b/o#1", 1, MakeBlock("ghij"));
+  EXPECT_EQ(20, cache.size_bytes());
+
+  auto block = cache.Lookup("b/o#1", 0);
+  ASSERT_NE(nullptr, block);
+  EXPECT_EQ("0123456789abcdef", block->data);
+  block = cache.Lookup("b/o#1", 1);
+  ASSERT_NE(nullptr, block);
+  EXPECT_EQ("ghij", block->data);
+  // Different generations are different objects.
+  EXPECT_EQ(nullptr, cache.Lookup("b/o#2", 0));
+}
+
+TEST(ReadBlockCacheTest, ReplaceBlock) {
+  ReadBlockCache cache(64, 16);
+  cache.Insert("b/o#1", 0, MakeBlock("abcd"));
+  cache.Insert("b/o#1", 0, MakeBlock("abcdefgh"));
+  EXPECT_EQ(8, cache.size_bytes());
+  auto block = cache.Lookup("b/o#1", 0);
+  ASSERT_NE(nullptr, block);
+  EXPECT_EQ("abcdefgh", block->data);
+}
+
+TEST(ReadBlockCacheTest, EvictsLeastRecentlyUsed) {
+  ReadBlockCache cache(32, 16);
+  cache.Insert("b/o#1", 0, MakeBlock(std::string(16, 'a')));
+  cache.Insert("b/o#1", 1, MakeBlock(std::string(16, 'b')));
+  ASSERT_NE(nullptr, cache.Lookup("b/o#1", 0));
+  // Block 1 is the least recently used block and gets evicted.
+  cache.Insert("b/o#1", 2, MakeBlock(std::string(16, 'c')));
+  EXPECT_EQ(32, cache.size_bytes());
+  EXPECT_NE(nullptr, cache.Lookup("b/o#1", 0));
+  EXPECT_EQ(nullptr, cache.Lookup("b/o#1", 1));
+  EXPECT_NE(nullptr, cache.Lookup("b/o#1", 2));
+}
+
+TEST(ReadBlockCacheTest, IgnoresLargeBlocks) {
+  ReadBlockCache cache(8, 16);
+  cache.Insert("b/o#1", 0, MakeBlock(std::string(16, 'a')));
+  EXPECT_EQ(0, cache.size_bytes());
+  EXPECT_EQ(nullptr, cache.Lookup("b/o#1", 0));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
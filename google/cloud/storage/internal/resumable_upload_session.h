@@ -85,6 +85,14 @@ class ResumableUploadSession {
 
   /// Returns the last upload response encountered during the upload.
   virtual StatusOr<ResumableUploadResponse> const& last_response() const = 0;
+
+  /**
+   * Returns the number of failed attempts to upload a chunk.
+   *
+   * This includes the attempts that were retried successfully. Only sessions
+   * that retry the uploads count failures, the default is always `0`.
+   */
+  virtual std::uint64_t failed_attempts() const { return 0; }
 };
 
 struct ResumableUploadResponse {
@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/retry_client.h"
+#include "google/cloud/storage/internal/caching_object_read_source.h"
 #include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
 #include "google/cloud/storage/internal/retry_object_read_source.h"
 #include "google/cloud/storage/internal/retry_resumable_upload_session.h"
 #include "google/cloud/internal/retry_policy.h"
 #include "absl/memory/memory.h"
+#include <algorithm>
 #include <sstream>
 #include <thread>
 
@@ -91,6 +93,15 @@ typename Signature<MemberFunction>::ReturnType MakeCall(
      << last_status.message();
   return error(std::move(os).str());
 }
+
+struct IsIdempotentVisitor {
+  template <typename Request>
+  bool operator()(Request const& request) const {
+    return policy.IsIdempotent(request);
+  }
+
+  IdempotencyPolicy const& policy;
+};
 }  // namespace
 
 RetryClient::RetryClient(std::shared_ptr<RawClient> client,
@@ -98,7 +109,16 @@ RetryClient::RetryClient(std::shared_ptr<RawClient> client,
     : client_(std::move(client)),
       retry_policy_prototype_(options.get<RetryPolicyOption>()->clone()),
       backoff_policy_prototype_(options.get<BackoffPolicyOption>()->clone()),
-      idempotency_policy_(options.get<IdempotencyPolicyOption>()->clone()) {}
+      idempotency_policy_(options.get<IdempotencyPolicyOption>()->clone()) {
+  auto const cache_size =
+      options.get<storage_experimental::ReadBlockCacheSizeOption>();
+  auto const block_size =
+      options.get<storage_experimental::ReadBlockCacheBlockSizeOption>();
+  if (cache_size != 0 && block_size != 0) {
+    read_block_cache_ =
+        std::make_shared<ReadBlockCache>(cache_size, block_size);
+  }
+}
 
 ClientOptions const& RetryClient::client_options() const {
   return client_->client_options();
@@ -282,6 +302,15 @@ StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObjectNotWrapped(
 
 StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObject(
     ReadObjectRangeRequest const& request) {
+  if (read_block_cache_ && CachingObjectReadSource::IsCacheable(request)) {
+    return std::unique_ptr<ObjectReadSource>(new CachingObjectReadSource(
+        shared_from_this(), request, read_block_cache_));
+  }
+  return ReadObjectWithoutCache(request);
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>>
+RetryClient::ReadObjectWithoutCache(ReadObjectRangeRequest const& request) {
   auto retry_policy = retry_policy_prototype_->clone();
   auto backoff_policy = backoff_policy_prototype_->clone();
   auto child = ReadObjectNotWrapped(request, *retry_policy, *backoff_policy);
@@ -397,6 +426,24 @@ StatusOr<EmptyResponse> RetryClient::DeleteResumableUpload(
                   __func__);
 }
 
+StatusOr<ExecuteBatchResponse> RetryClient::ExecuteBatch(
+    ExecuteBatchRequest const& request) {
+  auto retry_policy = retry_policy_prototype_->clone();
+  auto backoff_policy = backoff_policy_prototype_->clone();
+  // The batch is retried as a unit, only safe if every operation is.
+  IsIdempotentVisitor visitor{*idempotency_policy_};
+  auto const& operations = request.operations();
+  auto const idempotent = std::all_of(
+      operations.begin(), operations.end(),
+      [&visitor](ExecuteBatchRequest::Operation const& op) {
+        return absl::visit(visitor, op);
+      });
+  auto const idempotency =
+      idempotent ? Idempotency::kIdempotent : Idempotency::kNonIdempotent;
+  return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
+                  &RawClient::ExecuteBatch, request, __func__);
+}
+
 StatusOr<ListBucketAclResponse> RetryClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   auto retry_policy = retry_policy_prototype_->clone();
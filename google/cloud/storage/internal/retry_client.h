@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/idempotency_policy.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/internal/read_block_cache.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/version.h"
@@ -74,6 +75,9 @@ class RetryClient : public RawClient,
   /// Call ReadObject() but do not wrap the result in a RetryObjectReadSource.
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObjectNotWrapped(
       ReadObjectRangeRequest const&, RetryPolicy&, BackoffPolicy&);
+  /// Call ReadObject() but do not consult the read block cache.
+  StatusOr<std::unique_ptr<ObjectReadSource>> ReadObjectWithoutCache(
+      ReadObjectRangeRequest const&);
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) override;
 
@@ -93,6 +97,8 @@ class RetryClient : public RawClient,
       std::string const& request) override;
   StatusOr<EmptyResponse> DeleteResumableUpload(
       DeleteResumableUploadRequest const& request) override;
+  StatusOr<ExecuteBatchResponse> ExecuteBatch(
+      ExecuteBatchRequest const& request) override;
 
   StatusOr<ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const& request) override;
@@ -160,6 +166,7 @@ class RetryClient : public RawClient,
   std::shared_ptr<RetryPolicy const> retry_policy_prototype_;
   std::shared_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::shared_ptr<IdempotencyPolicy const> idempotency_policy_;
+  std::shared_ptr<ReadBlockCache> read_block_cache_;
 };
 
 }  // namespace internal
@@ -117,11 +117,13 @@ RetryResumableUploadSession::UploadGenericChunk(char const* caller,
          << ", intended to write=" << total_bytes
          << ", wrote=" << current_next_expected_byte - next_byte;
       last_status = Status(StatusCode::kUnavailable, os.str());
+      ++failed_attempts_;
       // Don't reset the session on a short write nor wait according to the
       // backoff policy - we did get a response from the server after all.
       continue;
     }
     last_status = std::move(result).status();
+    ++failed_attempts_;
     if (!retry_policy->OnFailure(last_status)) {
       return ReturnError(std::move(last_status), *retry_policy, __func__);
     }
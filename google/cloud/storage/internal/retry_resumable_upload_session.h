@@ -20,6 +20,7 @@
 #include "google/cloud/storage/version.h"
 #include "absl/functional/function_ref.h"
 #include "absl/types/optional.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -54,6 +55,7 @@ class RetryResumableUploadSession : public ResumableUploadSession {
   std::string const& session_id() const override;
   bool done() const override;
   StatusOr<ResumableUploadResponse> const& last_response() const override;
+  std::uint64_t failed_attempts() const override { return failed_attempts_; }
 
  private:
   using UploadChunkFunction =
@@ -73,6 +75,7 @@ class RetryResumableUploadSession : public ResumableUploadSession {
   std::unique_ptr<ResumableUploadSession> session_;
   std::unique_ptr<RetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
+  std::uint64_t failed_attempts_ = 0;
 };
 
 }  // namespace internal
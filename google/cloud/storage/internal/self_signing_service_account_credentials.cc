@@ -24,14 +24,20 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
+namespace {
+
 auto constexpr kExpiration = std::chrono::hours(1);
 auto constexpr kExpirationSlack = std::chrono::minutes(1);
 
-StatusOr<std::string> CreateBearerToken(
-    SelfSigningServiceAccountCredentialsInfo const& info,
-    std::chrono::system_clock::time_point tp) {
+std::string EncodedHeader(
+    SelfSigningServiceAccountCredentialsInfo const& info) {
   auto const header = nlohmann::json{
       {"alg", "HS256"}, {"typ", "JWT"}, {"kid", info.private_key_id}};
+  return UrlsafeBase64Encode(header.dump());
+}
+
+std::string Payload(SelfSigningServiceAccountCredentialsInfo const& info,
+                    std::chrono::system_clock::time_point tp) {
   auto const iat =
       std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch());
   auto const exp = iat + kExpiration;
@@ -40,10 +46,23 @@ StatusOr<std::string> CreateBearerToken(
       {"aud", info.audience},     {"iat", iat.count()},
       {"exp", exp.count()},
   };
-  return MakeJWTAssertionNoThrow(header.dump(), payload.dump(),
-                                 info.private_key);
+  return payload.dump();
 }
 
+}  // namespace
+
+StatusOr<std::string> CreateBearerToken(
+    SelfSigningServiceAccountCredentialsInfo const& info,
+    std::chrono::system_clock::time_point tp) {
+  auto key = PemPrivateKey::Parse(info.private_key);
+  if (!key) return std::move(key).status();
+  return MakeJWTAssertionNoThrow(EncodedHeader(info), Payload(info, tp), *key);
+}
+
+SelfSigningServiceAccountCredentials::SelfSigningServiceAccountCredentials(
+    SelfSigningServiceAccountCredentialsInfo info)
+    : info_(std::move(info)), encoded_header_(EncodedHeader(info_)) {}
+
 StatusOr<std::string>
 SelfSigningServiceAccountCredentials::AuthorizationHeader() {
   auto const now = std::chrono::system_clock::now();
@@ -51,7 +70,10 @@ SelfSigningServiceAccountCredentials::AuthorizationHeader() {
   if (now + kExpirationSlack <= expiration_time_) {
     return authorization_header_;
   }
-  auto token = CreateBearerToken(info_, now);
+  auto key = SigningKey();
+  if (!key) return std::move(key).status();
+  auto token =
+      MakeJWTAssertionNoThrow(encoded_header_, Payload(info_, now), *key);
   if (!token) return std::move(token).status();
   expiration_time_ = now + kExpiration;
   authorization_header_ = "Authorization: Bearer " + *std::move(token);
@@ -67,8 +89,18 @@ SelfSigningServiceAccountCredentials::SignBlob(
     return Status(StatusCode::kInvalidArgument,
                   "Cannot sign blobs for " + signing_account.value());
   }
-  return internal::SignStringWithPem(string_to_sign, info_.private_key,
-                                     oauth2::JwtSigningAlgorithms::RS256);
+  auto key = SigningKey();
+  if (!key) return std::move(key).status();
+  return key->Sign(string_to_sign, oauth2::JwtSigningAlgorithms::RS256);
+}
+
+StatusOr<PemPrivateKey> SelfSigningServiceAccountCredentials::SigningKey()
+    const {
+  std::lock_guard<std::mutex> lk(signing_key_mu_);
+  if (signing_key_) return *signing_key_;
+  auto key = PemPrivateKey::Parse(info_.private_key);
+  if (key) signing_key_ = *key;
+  return key;
 }
 
 std::string SelfSigningServiceAccountCredentials::AccountEmail() const {
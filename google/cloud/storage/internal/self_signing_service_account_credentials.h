@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SELF_SIGNING_SERVICE_ACCOUNT_CREDENTIALS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SELF_SIGNING_SERVICE_ACCOUNT_CREDENTIALS_H
 
+#include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/version.h"
+#include "absl/types/optional.h"
 #include <chrono>
 #include <mutex>
 #include <string>
@@ -42,8 +44,7 @@ class SelfSigningServiceAccountCredentials
     : public google::cloud::storage::oauth2::Credentials {
  public:
   explicit SelfSigningServiceAccountCredentials(
-      SelfSigningServiceAccountCredentialsInfo info)
-      : info_(std::move(info)) {}
+      SelfSigningServiceAccountCredentialsInfo info);
 
   StatusOr<std::string> AuthorizationHeader() override;
   StatusOr<std::vector<std::uint8_t>> SignBlob(
@@ -53,10 +54,17 @@ class SelfSigningServiceAccountCredentials
   std::string KeyId() const override;
 
  private:
+  /// Parses the private key on first use, parsing is expensive.
+  StatusOr<PemPrivateKey> SigningKey() const;
+
+  SelfSigningServiceAccountCredentialsInfo const info_;
+  // The header is the same for all the tokens, encode it only once.
+  std::string const encoded_header_;
   std::mutex mu_;
-  SelfSigningServiceAccountCredentialsInfo info_;
   std::chrono::system_clock::time_point expiration_time_;
   std::string authorization_header_;
+  mutable std::mutex signing_key_mu_;
+  mutable absl::optional<PemPrivateKey> signing_key_;
 };
 
 }  // namespace internal
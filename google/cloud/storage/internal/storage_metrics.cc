@@ -0,0 +1,75 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/storage_metrics.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+using ::google::cloud::internal::MetricsWrapper;
+
+std::unique_ptr<StorageStub::ObjectMediaStream> StorageMetrics::GetObjectMedia(
+    std::unique_ptr<grpc::ClientContext> context,
+    google::storage::v1::GetObjectMediaRequest const& request) {
+  return MetricsWrapper(
+      [this](std::unique_ptr<grpc::ClientContext> context,
+             google::storage::v1::GetObjectMediaRequest const& request) {
+        return child_->GetObjectMedia(std::move(context), request);
+      },
+      std::move(context), request, metrics_->Method("Storage.GetObjectMedia"));
+}
+
+std::unique_ptr<StorageStub::InsertStream> StorageMetrics::InsertObjectMedia(
+    std::unique_ptr<grpc::ClientContext> context) {
+  return MetricsWrapper(
+      [this](std::unique_ptr<grpc::ClientContext> context) {
+        return child_->InsertObjectMedia(std::move(context));
+      },
+      std::move(context), metrics_->Method("Storage.InsertObject"));
+}
+
+StatusOr<google::storage::v1::StartResumableWriteResponse>
+StorageMetrics::StartResumableWrite(
+    grpc::ClientContext& context,
+    google::storage::v1::StartResumableWriteRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::storage::v1::StartResumableWriteRequest const& request) {
+        return child_->StartResumableWrite(context, request);
+      },
+      context, request, metrics_->Method("Storage.StartResumableWrite"));
+}
+
+StatusOr<google::storage::v1::QueryWriteStatusResponse>
+StorageMetrics::QueryWriteStatus(
+    grpc::ClientContext& context,
+    google::storage::v1::QueryWriteStatusRequest const& request) {
+  return MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::storage::v1::QueryWriteStatusRequest const& request) {
+        return child_->QueryWriteStatus(context, request);
+      },
+      context, request, metrics_->Method("Storage.QueryWriteStatus"));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,69 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_STORAGE_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_STORAGE_METRICS_H
+
+#include "google/cloud/storage/internal/storage_stub.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/rpc_metrics.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A StorageStub that records the metrics for each request.
+ *
+ * Install this decorator as the outermost layer, so the resource accounting
+ * includes the work done by the other decorators.
+ */
+class StorageMetrics : public StorageStub {
+ public:
+  StorageMetrics(std::shared_ptr<StorageStub> child,
+                 std::shared_ptr<RpcMetrics> metrics)
+      : child_(std::move(child)), metrics_(std::move(metrics)) {}
+  ~StorageMetrics() override = default;
+
+  std::unique_ptr<ObjectMediaStream> GetObjectMedia(
+      std::unique_ptr<grpc::ClientContext> context,
+      google::storage::v1::GetObjectMediaRequest const& request) override;
+
+  std::unique_ptr<InsertStream> InsertObjectMedia(
+      std::unique_ptr<grpc::ClientContext> context) override;
+
+  StatusOr<google::storage::v1::StartResumableWriteResponse>
+  StartResumableWrite(
+      grpc::ClientContext& context,
+      google::storage::v1::StartResumableWriteRequest const& request) override;
+  StatusOr<google::storage::v1::QueryWriteStatusResponse> QueryWriteStatus(
+      grpc::ClientContext& context,
+      google::storage::v1::QueryWriteStatusRequest const& request) override;
+
+ private:
+  std::shared_ptr<StorageStub> child_;
+  std::shared_ptr<RpcMetrics> metrics_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_STORAGE_METRICS_H
@@ -0,0 +1,139 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/storage_metrics.h"
+#include "google/cloud/storage/testing/mock_storage_stub.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::MockStorageStub;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Return;
+
+class FakeAllocationCounter : public RpcAllocationCounter {
+ public:
+  std::int64_t Count() override { return count; }
+  std::int64_t count = 0;
+};
+
+TEST(StorageMetricsTest, GetObjectMedia) {
+  auto mock = std::make_shared<MockStorageStub>();
+  EXPECT_CALL(*mock, GetObjectMedia)
+      .WillOnce([](std::unique_ptr<grpc::ClientContext>,
+                   google::storage::v1::GetObjectMediaRequest const&) {
+        using ErrorStream = google::cloud::internal::StreamingReadRpcError<
+            google::storage::v1::GetObjectMediaResponse>;
+        return absl::make_unique<ErrorStream>(
+            Status(StatusCode::kPermissionDenied, "uh-oh"));
+      });
+  auto metrics = std::make_shared<RpcMetrics>();
+  StorageMetrics under_test(mock, metrics);
+  google::storage::v1::GetObjectMediaRequest request;
+  request.set_bucket("test-bucket");
+  auto stream = under_test.GetObjectMedia(
+      absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_NE(nullptr, stream);
+  EXPECT_THAT(
+      metrics->Snapshot(),
+      ElementsAre(AllOf(
+          Field(&RpcMethodMetricsSnapshot::method, "Storage.GetObjectMedia"),
+          Field(&RpcMethodMetricsSnapshot::calls, 1),
+          Field(&RpcMethodMetricsSnapshot::bytes_sent,
+                request.ByteSizeLong()))));
+}
+
+TEST(StorageMetricsTest, InsertObjectMedia) {
+  auto mock = std::make_shared<MockStorageStub>();
+  EXPECT_CALL(*mock, InsertObjectMedia)
+      .WillOnce([](std::unique_ptr<grpc::ClientContext>) {
+        using ErrorStream = google::cloud::internal::StreamingWriteRpcError<
+            google::storage::v1::InsertObjectRequest,
+            google::storage::v1::Object>;
+        return absl::make_unique<ErrorStream>(
+            Status(StatusCode::kPermissionDenied, "uh-oh"));
+      });
+  auto metrics = std::make_shared<RpcMetrics>();
+  StorageMetrics under_test(mock, metrics);
+  auto stream =
+      under_test.InsertObjectMedia(absl::make_unique<grpc::ClientContext>());
+  EXPECT_NE(nullptr, stream);
+  EXPECT_THAT(metrics->Snapshot(),
+              ElementsAre(AllOf(
+                  Field(&RpcMethodMetricsSnapshot::method,
+                        "Storage.InsertObject"),
+                  Field(&RpcMethodMetricsSnapshot::calls, 1))));
+}
+
+TEST(StorageMetricsTest, StartResumableWrite) {
+  auto mock = std::make_shared<MockStorageStub>();
+  EXPECT_CALL(*mock, StartResumableWrite)
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+  auto metrics = std::make_shared<RpcMetrics>();
+  StorageMetrics under_test(mock, metrics);
+  grpc::ClientContext context;
+  auto response = under_test.StartResumableWrite(
+      context, google::storage::v1::StartResumableWriteRequest{});
+  EXPECT_THAT(response, StatusIs(StatusCode::kUnavailable));
+  EXPECT_THAT(metrics->Snapshot(),
+              ElementsAre(AllOf(
+                  Field(&RpcMethodMetricsSnapshot::method,
+                        "Storage.StartResumableWrite"),
+                  Field(&RpcMethodMetricsSnapshot::calls, 1),
+                  Field(&RpcMethodMetricsSnapshot::errors, 1))));
+}
+
+TEST(StorageMetricsTest, QueryWriteStatusResourceAccounting) {
+  auto counter = std::make_shared<FakeAllocationCounter>();
+  auto mock = std::make_shared<MockStorageStub>();
+  EXPECT_CALL(*mock, QueryWriteStatus)
+      .WillOnce(
+          [&counter](grpc::ClientContext&,
+                     google::storage::v1::QueryWriteStatusRequest const&) {
+            counter->count += 5;
+            return make_status_or(
+                google::storage::v1::QueryWriteStatusResponse{});
+          });
+  auto metrics = std::make_shared<RpcMetrics>(RpcResourceAccounting{counter});
+  StorageMetrics under_test(mock, metrics);
+  grpc::ClientContext context;
+  auto response = under_test.QueryWriteStatus(
+      context, google::storage::v1::QueryWriteStatusRequest{});
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(metrics->Snapshot(),
+              ElementsAre(AllOf(
+                  Field(&RpcMethodMetricsSnapshot::method,
+                        "Storage.QueryWriteStatus"),
+                  Field(&RpcMethodMetricsSnapshot::allocations, 5))));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
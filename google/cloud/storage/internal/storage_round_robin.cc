@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/storage_round_robin.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -20,37 +22,129 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
+namespace {
+
+using ::google::cloud::internal::StreamingRpcMetadata;
+using ::google::storage::v1::GetObjectMediaResponse;
+
+// Hold the child's lease for the lifetime of the stream.
+class LeasedObjectMediaStream : public StorageStub::ObjectMediaStream {
+ public:
+  LeasedObjectMediaStream(std::unique_ptr<ObjectMediaStream> impl,
+                          std::shared_ptr<void> lease)
+      : impl_(std::move(impl)), lease_(std::move(lease)) {}
+  ~LeasedObjectMediaStream() override = default;
+
+  void Cancel() override { impl_->Cancel(); }
+  absl::variant<Status, GetObjectMediaResponse> Read() override {
+    return impl_->Read();
+  }
+  absl::variant<Status, std::shared_ptr<GetObjectMediaResponse const>>
+  ReadInArena() override {
+    return impl_->ReadInArena();
+  }
+  StreamingRpcMetadata GetRequestMetadata() const override {
+    return impl_->GetRequestMetadata();
+  }
+
+ private:
+  std::unique_ptr<ObjectMediaStream> impl_;
+  std::shared_ptr<void> lease_;
+};
+
+class LeasedInsertStream : public StorageStub::InsertStream {
+ public:
+  LeasedInsertStream(std::unique_ptr<InsertStream> impl,
+                     std::shared_ptr<void> lease)
+      : impl_(std::move(impl)), lease_(std::move(lease)) {}
+  ~LeasedInsertStream() override = default;
+
+  void Cancel() override { impl_->Cancel(); }
+  bool Write(google::storage::v1::InsertObjectRequest const& r,
+             grpc::WriteOptions o) override {
+    return impl_->Write(r, std::move(o));
+  }
+  StatusOr<google::storage::v1::Object> Close() override {
+    return impl_->Close();
+  }
+
+ private:
+  std::unique_ptr<InsertStream> impl_;
+  std::shared_ptr<void> lease_;
+};
+
+}  // namespace
+
+StorageRoundRobin::StorageRoundRobin(
+    std::vector<std::shared_ptr<StorageStub>> children)
+    : max_children_(children.size()) {
+  children_.reserve(children.size());
+  for (auto& c : children) {
+    children_.push_back(Slot{std::move(c), std::make_shared<int>(0)});
+  }
+}
+
+StorageRoundRobin::StorageRoundRobin(StubFactory factory, int max_children)
+    : factory_(std::move(factory)),
+      max_children_(static_cast<std::size_t>((std::max)(1, max_children))) {
+  children_.reserve(max_children_);
+}
+
+void StorageRoundRobin::CreateAllChildren() {
+  std::lock_guard<std::mutex> lk(mu_);
+  while (children_.size() < max_children_) AddChild(lk);
+}
+
 std::unique_ptr<StorageStub::ObjectMediaStream>
 StorageRoundRobin::GetObjectMedia(
     std::unique_ptr<grpc::ClientContext> context,
     google::storage::v1::GetObjectMediaRequest const& request) {
-  return Child()->GetObjectMedia(std::move(context), request);
+  auto child = Child();
+  return absl::make_unique<LeasedObjectMediaStream>(
+      child.first->GetObjectMedia(std::move(context), request),
+      std::move(child.second));
 }
 
 std::unique_ptr<StorageStub::InsertStream> StorageRoundRobin::InsertObjectMedia(
     std::unique_ptr<grpc::ClientContext> context) {
-  return Child()->InsertObjectMedia(std::move(context));
+  auto child = Child();
+  return absl::make_unique<LeasedInsertStream>(
+      child.first->InsertObjectMedia(std::move(context)),
+      std::move(child.second));
 }
 
 StatusOr<google::storage::v1::StartResumableWriteResponse>
 StorageRoundRobin::StartResumableWrite(
     grpc::ClientContext& context,
     google::storage::v1::StartResumableWriteRequest const& request) {
-  return Child()->StartResumableWrite(context, request);
+  return Child().first->StartResumableWrite(context, request);
 }
 
 StatusOr<google::storage::v1::QueryWriteStatusResponse>
 StorageRoundRobin::QueryWriteStatus(
     grpc::ClientContext& context,
     google::storage::v1::QueryWriteStatusRequest const& request) {
-  return Child()->QueryWriteStatus(context, request);
+  return Child().first->QueryWriteStatus(context, request);
 }
 
-std::shared_ptr<StorageStub> StorageRoundRobin::Child() {
+std::pair<std::shared_ptr<StorageStub>, StorageRoundRobin::Lease>
+StorageRoundRobin::Child() {
   std::lock_guard<std::mutex> lk(mu_);
-  auto child = children_[current_];
+  // `use_count()` is approximate with concurrent calls, but good enough to
+  // detect when the existing children are busy.
+  if (children_.size() < max_children_ &&
+      (children_.empty() || children_[current_].lease.use_count() > 1)) {
+    AddChild(lk);
+    current_ = children_.size() - 1;
+  }
+  auto const& child = children_[current_];
   current_ = (current_ + 1) % children_.size();
-  return child;
+  return {child.stub, child.lease};
+}
+
+void StorageRoundRobin::AddChild(std::lock_guard<std::mutex> const&) {
+  auto const id = static_cast<int>(children_.size());
+  children_.push_back(Slot{factory_(id), std::make_shared<int>(0)});
 }
 
 }  // namespace internal
@@ -17,7 +17,10 @@
 
 #include "google/cloud/storage/internal/storage_stub.h"
 #include "google/cloud/storage/version.h"
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 namespace google {
@@ -28,10 +31,26 @@ namespace internal {
 
 class StorageRoundRobin : public StorageStub {
  public:
-  explicit StorageRoundRobin(std::vector<std::shared_ptr<StorageStub>> children)
-      : children_(std::move(children)) {}
+  using StubFactory = std::function<std::shared_ptr<StorageStub>(int)>;
+
+  explicit StorageRoundRobin(
+      std::vector<std::shared_ptr<StorageStub>> children);
+
+  /**
+   * Creates the children on demand.
+   *
+   * The first call creates the first child, calling `factory(0)`. Later calls
+   * create a new child when the next child in the rotation is busy with other
+   * calls, until there are @p max_children. Applications that make only a few
+   * calls never pay for the channels they do not use.
+   */
+  StorageRoundRobin(StubFactory factory, int max_children);
+
   ~StorageRoundRobin() override = default;
 
+  /// Creates any missing children, used to warm up the channels.
+  void CreateAllChildren();
+
   std::unique_ptr<ObjectMediaStream> GetObjectMedia(
       std::unique_ptr<grpc::ClientContext> context,
       google::storage::v1::GetObjectMediaRequest const& request) override;
@@ -48,10 +67,21 @@ class StorageRoundRobin : public StorageStub {
       google::storage::v1::QueryWriteStatusRequest const& request) override;
 
  private:
-  std::shared_ptr<StorageStub> Child();
+  // Each child has a lease, copies of the lease are held by the calls (and
+  // streams) using the child, so a child is busy while its lease is shared.
+  using Lease = std::shared_ptr<void>;
+  struct Slot {
+    std::shared_ptr<StorageStub> stub;
+    Lease lease;
+  };
+
+  std::pair<std::shared_ptr<StorageStub>, Lease> Child();
+  void AddChild(std::lock_guard<std::mutex> const&);
 
-  std::vector<std::shared_ptr<StorageStub>> const children_;
+  StubFactory const factory_;
+  std::size_t const max_children_;
   std::mutex mu_;
+  std::vector<Slot> children_;
   std::size_t current_ = 0;
 };
 
@@ -27,6 +27,7 @@ namespace {
 
 using ::google::cloud::storage::testing::MockStorageStub;
 using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
 using ::testing::InSequence;
 using ::testing::Return;
 
@@ -143,6 +144,66 @@ TEST(StorageAuthTest, QueryWriteStatus) {
   }
 }
 
+TEST(StorageRoundRobinTest, LazyCreatesChildrenOnDemand) {
+  auto mocks = MakeMocks();
+  std::vector<int> created;
+  auto factory = [&](int id) -> std::shared_ptr<StorageStub> {
+    created.push_back(id);
+    return mocks[static_cast<std::size_t>(id)];
+  };
+  StorageRoundRobin under_test(factory, kMockCount);
+  EXPECT_TRUE(created.empty());
+
+  // Sequential calls reuse the first child.
+  EXPECT_CALL(*mocks[0], QueryWriteStatus)
+      .Times(kRepeats)
+      .WillRepeatedly(Return(Status(StatusCode::kPermissionDenied, "uh-oh")));
+  for (int i = 0; i != kRepeats; ++i) {
+    google::storage::v1::QueryWriteStatusRequest request;
+    grpc::ClientContext ctx;
+    auto response = under_test.QueryWriteStatus(ctx, request);
+    EXPECT_THAT(response, StatusIs(StatusCode::kPermissionDenied));
+  }
+  EXPECT_THAT(created, ElementsAre(0));
+
+  // While a stream is open its child is busy, and the next call creates a new
+  // child.
+  EXPECT_CALL(*mocks[0], GetObjectMedia).WillOnce(MakeObjectMediaStream);
+  EXPECT_CALL(*mocks[1], GetObjectMedia).WillOnce(MakeObjectMediaStream);
+  google::storage::v1::GetObjectMediaRequest request;
+  auto s0 = under_test.GetObjectMedia(absl::make_unique<grpc::ClientContext>(),
+                                      request);
+  auto s1 = under_test.GetObjectMedia(absl::make_unique<grpc::ClientContext>(),
+                                      request);
+  EXPECT_THAT(created, ElementsAre(0, 1));
+
+  under_test.CreateAllChildren();
+  EXPECT_THAT(created, ElementsAre(0, 1, 2));
+  under_test.CreateAllChildren();
+  EXPECT_THAT(created, ElementsAre(0, 1, 2));
+}
+
+TEST(StorageRoundRobinTest, LazyStopsAtMaxChildren) {
+  auto mock = std::make_shared<MockStorageStub>();
+  int created = 0;
+  StorageRoundRobin under_test(
+      [&](int) -> std::shared_ptr<StorageStub> {
+        ++created;
+        return mock;
+      },
+      2);
+
+  EXPECT_CALL(*mock, InsertObjectMedia)
+      .Times(4)
+      .WillRepeatedly(MakeInsertStream);
+  std::vector<std::unique_ptr<StorageStub::InsertStream>> streams;
+  for (int i = 0; i != 4; ++i) {
+    streams.push_back(
+        under_test.InsertObjectMedia(absl::make_unique<grpc::ClientContext>()));
+  }
+  EXPECT_EQ(2, created);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
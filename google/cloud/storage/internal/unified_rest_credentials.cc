@@ -18,6 +18,8 @@
 #include "google/cloud/storage/internal/impersonate_service_account_credentials.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include <nlohmann/json.hpp>
+#include <functional>
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -54,7 +56,14 @@ std::shared_ptr<oauth2::Credentials> MapCredentials(
       result = std::make_shared<AccessTokenCredentials>(config.access_token());
     }
     void visit(ImpersonateServiceAccountConfig& config) override {
-      result = std::make_shared<ImpersonateServiceAccountCredentials>(config);
+      // All the clients created from the same `Credentials` share the token.
+      std::function<std::shared_ptr<ImpersonateServiceAccountCredentials>()>
+          factory = [&config] {
+            return std::make_shared<ImpersonateServiceAccountCredentials>(
+                config);
+          };
+      // The REST credentials do not depend on the client options.
+      result = config.SharedCache(std::string{}, factory);
     }
     void visit(ServiceAccountConfig& cfg) override {
       auto credentials = google::cloud::storage::oauth2::
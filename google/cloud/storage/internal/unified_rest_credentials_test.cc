@@ -71,6 +71,20 @@ TEST_F(UnifiedRestCredentialsTest, AccessToken) {
   }
 }
 
+TEST_F(UnifiedRestCredentialsTest, ImpersonateSharesToken) {
+  auto config = google::cloud::MakeImpersonateServiceAccountCredentials(
+      MakeInsecureCredentials(), "test-only-invalid@test.invalid");
+  // Clients created from the same credentials share the token, and refresh it
+  // only once.
+  auto c0 = MapCredentials(config);
+  auto c1 = MapCredentials(config);
+  EXPECT_EQ(c0, c1);
+
+  auto other = google::cloud::MakeImpersonateServiceAccountCredentials(
+      MakeInsecureCredentials(), "test-only-invalid@test.invalid");
+  EXPECT_NE(c0, MapCredentials(other));
+}
+
 TEST_F(UnifiedRestCredentialsTest, LoadError) {
   // Create a name for a non-existing file, try to load it, and verify it
   // returns errors.
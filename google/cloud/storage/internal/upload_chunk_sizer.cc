@@ -0,0 +1,85 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/upload_chunk_sizer.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+auto constexpr kQuantum = UploadChunkRequest::kChunkSizeQuantum;
+// Larger chunks must improve the throughput by this factor to keep growing.
+auto constexpr kImprovement = 1.1;
+// The number of chunks uploaded without errors before growing again.
+auto constexpr kStableChunks = 4;
+
+std::size_t RoundUp(std::size_t size) {
+  return (std::max)(kQuantum, UploadChunkRequest::RoundUpToQuantum(size));
+}
+
+}  // namespace
+
+UploadChunkSizer::UploadChunkSizer(std::size_t initial_size,
+                                   std::size_t minimum_size,
+                                   std::size_t maximum_size)
+    : minimum_size_(RoundUp(minimum_size)),
+      maximum_size_((std::max)(minimum_size_, RoundUp(maximum_size))),
+      chunk_size_((std::min)(maximum_size_,
+                             (std::max)(minimum_size_, RoundUp(initial_size)))),
+      chunks_since_error_(kStableChunks) {}
+
+void UploadChunkSizer::OnChunk(std::size_t size,
+                               std::chrono::nanoseconds elapsed) {
+  ++chunks_since_error_;
+  // Only full chunks measure the throughput for the current size.
+  if (!growing_ || size < chunk_size_ || elapsed.count() <= 0) return;
+  auto const throughput =
+      static_cast<double>(size) /
+      std::chrono::duration_cast<std::chrono::duration<double>>(elapsed)
+          .count();
+  if (measured_size_ == chunk_size_) {
+    throughput_ = (std::max)(throughput_, throughput);
+  } else if (measured_size_ != 0 && throughput < kImprovement * throughput_) {
+    // The larger chunks did not help, keep the last size that did.
+    chunk_size_ = throughput < throughput_ ? measured_size_ : chunk_size_;
+    growing_ = false;
+    return;
+  } else {
+    measured_size_ = chunk_size_;
+    throughput_ = throughput;
+  }
+  if (chunks_since_error_ < kStableChunks) return;
+  chunk_size_ = (std::min)(maximum_size_, 2 * chunk_size_);
+}
+
+void UploadChunkSizer::OnErrors(std::size_t count) {
+  if (count == 0) return;
+  auto const half = chunk_size_ / 2 / kQuantum * kQuantum;
+  chunk_size_ = (std::max)(minimum_size_, half);
+  measured_size_ = 0;
+  throughput_ = 0;
+  growing_ = true;
+  chunks_since_error_ = 0;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
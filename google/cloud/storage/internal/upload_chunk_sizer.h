@@ -0,0 +1,71 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_CHUNK_SIZER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_CHUNK_SIZER_H
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Picks the chunk size for resumable uploads from the observed throughput.
+ *
+ * Small chunks waste round trips on fast networks, large chunks use more
+ * memory and are expensive to retry on unreliable networks. This class starts
+ * with the initial chunk size and doubles it while the throughput of each
+ * chunk keeps improving. Once the throughput stops improving the size is
+ * kept. After each failed attempt the size is halved, and it only grows again
+ * after a few chunks are uploaded without errors.
+ *
+ * All the sizes are multiples of the upload quantum (256 KiB) and remain
+ * within the given bounds.
+ */
+class UploadChunkSizer {
+ public:
+  UploadChunkSizer(std::size_t initial_size, std::size_t minimum_size,
+                   std::size_t maximum_size);
+
+  std::size_t chunk_size() const { return chunk_size_; }
+
+  /// Records a chunk of @p size bytes uploaded in @p elapsed time.
+  void OnChunk(std::size_t size, std::chrono::nanoseconds elapsed);
+
+  /// Records @p count failed attempts to upload a chunk.
+  void OnErrors(std::size_t count);
+
+ private:
+  std::size_t const minimum_size_;
+  std::size_t const maximum_size_;
+  std::size_t chunk_size_;
+  // The size of the chunks measured in `throughput_`, or 0 if none.
+  std::size_t measured_size_ = 0;
+  double throughput_ = 0;
+  bool growing_ = true;
+  int chunks_since_error_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_CHUNK_SIZER_H
@@ -0,0 +1,102 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/upload_chunk_sizer.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+auto constexpr kQuantum = UploadChunkRequest::kChunkSizeQuantum;
+
+std::chrono::nanoseconds ElapsedAt(std::size_t size, double throughput) {
+  return std::chrono::nanoseconds(
+      static_cast<std::int64_t>(static_cast<double>(size) / throughput * 1e9));
+}
+
+TEST(UploadChunkSizerTest, RoundsAndClamps) {
+  EXPECT_EQ(kQuantum, UploadChunkSizer(0, 0, 0).chunk_size());
+  EXPECT_EQ(2 * kQuantum,
+            UploadChunkSizer(kQuantum + 1, 0, 8 * kQuantum).chunk_size());
+  EXPECT_EQ(4 * kQuantum,
+            UploadChunkSizer(kQuantum, 4 * kQuantum, 8 * kQuantum)
+                .chunk_size());
+  EXPECT_EQ(8 * kQuantum,
+            UploadChunkSizer(64 * kQuantum, kQuantum, 8 * kQuantum)
+                .chunk_size());
+}
+
+TEST(UploadChunkSizerTest, GrowsWhileThroughputImproves) {
+  UploadChunkSizer tested(kQuantum, kQuantum, 4 * kQuantum);
+  tested.OnChunk(kQuantum, ElapsedAt(kQuantum, 1e6));
+  EXPECT_EQ(2 * kQuantum, tested.chunk_size());
+  tested.OnChunk(2 * kQuantum, ElapsedAt(2 * kQuantum, 2e6));
+  EXPECT_EQ(4 * kQuantum, tested.chunk_size());
+  tested.OnChunk(4 * kQuantum, ElapsedAt(4 * kQuantum, 4e6));
+  EXPECT_EQ(4 * kQuantum, tested.chunk_size());
+}
+
+TEST(UploadChunkSizerTest, RevertsWhenLargerIsWorse) {
+  UploadChunkSizer tested(kQuantum, kQuantum, 16 * kQuantum);
+  tested.OnChunk(kQuantum, ElapsedAt(kQuantum, 1e6));
+  tested.OnChunk(2 * kQuantum, ElapsedAt(2 * kQuantum, 2e6));
+  EXPECT_EQ(4 * kQuantum, tested.chunk_size());
+  tested.OnChunk(4 * kQuantum, ElapsedAt(4 * kQuantum, 1e6));
+  EXPECT_EQ(2 * kQuantum, tested.chunk_size());
+  // Once settled, the size does not change.
+  tested.OnChunk(2 * kQuantum, ElapsedAt(2 * kQuantum, 8e6));
+  EXPECT_EQ(2 * kQuantum, tested.chunk_size());
+}
+
+TEST(UploadChunkSizerTest, IgnoresPartialChunks) {
+  UploadChunkSizer tested(2 * kQuantum, kQuantum, 16 * kQuantum);
+  tested.OnChunk(kQuantum, ElapsedAt(kQuantum, 1e6));
+  EXPECT_EQ(2 * kQuantum, tested.chunk_size());
+}
+
+TEST(UploadChunkSizerTest, ShrinksOnErrors) {
+  UploadChunkSizer tested(8 * kQuantum, kQuantum, 16 * kQuantum);
+  tested.OnErrors(1);
+  EXPECT_EQ(4 * kQuantum, tested.chunk_size());
+  tested.OnErrors(2);
+  EXPECT_EQ(2 * kQuantum, tested.chunk_size());
+  tested.OnErrors(1);
+  tested.OnErrors(1);
+  EXPECT_EQ(kQuantum, tested.chunk_size());
+}
+
+TEST(UploadChunkSizerTest, WaitsForStableChunksAfterErrors) {
+  UploadChunkSizer tested(2 * kQuantum, kQuantum, 16 * kQuantum);
+  tested.OnErrors(1);
+  ASSERT_EQ(kQuantum, tested.chunk_size());
+  for (int i = 0; i != 3; ++i) {
+    tested.OnChunk(kQuantum, ElapsedAt(kQuantum, 1e6));
+    EXPECT_EQ(kQuantum, tested.chunk_size());
+  }
+  tested.OnChunk(kQuantum, ElapsedAt(kQuantum, 1e6));
+  EXPECT_EQ(2 * kQuantum, tested.chunk_size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
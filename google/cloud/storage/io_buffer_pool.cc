@@ -0,0 +1,147 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/io_buffer_pool.h"
+#include <algorithm>
+#include <iostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+// The size classes are the powers of two from 4 KiB to 64 MiB.
+std::size_t constexpr kMinClassSize = 4 * 1024;
+std::size_t constexpr kClassCount = 15;
+std::size_t constexpr kMaxClassSize = kMinClassSize << (kClassCount - 1);
+
+std::size_t SizeClass(std::size_t size) {
+  std::size_t c = 0;
+  while ((kMinClassSize << c) < size) ++c;
+  return c;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, IoBufferPoolStats const& rhs) {
+  return os << "hits=" << rhs.hits << ", misses=" << rhs.misses
+            << ", bytes_in_use=" << rhs.bytes_in_use
+            << ", bytes_cached=" << rhs.bytes_cached
+            << ", peak_bytes=" << rhs.peak_bytes;
+}
+
+IoBuffer::IoBuffer(std::size_t size)
+    : data_(size == 0 ? nullptr : new char[size]),
+      size_(size),
+      capacity_(size) {}
+
+IoBuffer::IoBuffer(std::unique_ptr<char[]> data, std::size_t size,
+                   std::size_t capacity, std::shared_ptr<IoBufferPool> pool)
+    : data_(std::move(data)),
+      size_(size),
+      capacity_(capacity),
+      pool_(std::move(pool)) {}
+
+IoBuffer::IoBuffer(IoBuffer&& rhs) noexcept
+    : data_(std::move(rhs.data_)),
+      size_(rhs.size_),
+      capacity_(rhs.capacity_),
+      pool_(std::move(rhs.pool_)) {
+  rhs.size_ = 0;
+  rhs.capacity_ = 0;
+}
+
+IoBuffer& IoBuffer::operator=(IoBuffer&& rhs) noexcept {
+  if (this == &rhs) return *this;
+  Release();
+  data_ = std::move(rhs.data_);
+  size_ = rhs.size_;
+  capacity_ = rhs.capacity_;
+  pool_ = std::move(rhs.pool_);
+  rhs.size_ = 0;
+  rhs.capacity_ = 0;
+  return *this;
+}
+
+void IoBuffer::Release() {
+  if (data_ && pool_) pool_->Release(std::move(data_), capacity_);
+  data_.reset();
+  size_ = 0;
+  capacity_ = 0;
+  pool_.reset();
+}
+
+std::shared_ptr<IoBufferPool> IoBufferPool::Create(
+    std::size_t max_cached_bytes) {
+  return std::shared_ptr<IoBufferPool>(new IoBufferPool(max_cached_bytes));
+}
+
+IoBufferPool::IoBufferPool(std::size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes), free_(kClassCount) {}
+
+IoBuffer IoBufferPool::Acquire(std::size_t size) {
+  if (size == 0) return IoBuffer{};
+  auto const pooled = size <= kMaxClassSize;
+  auto const c = pooled ? SizeClass(size) : 0;
+  auto const capacity = pooled ? kMinClassSize << c : size;
+  std::unique_ptr<char[]> data;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (pooled && !free_[c].empty()) {
+      data = std::move(free_[c].back());
+      free_[c].pop_back();
+      stats_.bytes_cached -= capacity;
+      ++stats_.hits;
+    } else {
+      ++stats_.misses;
+    }
+    stats_.bytes_in_use += capacity;
+    stats_.peak_bytes = (std::max)(stats_.peak_bytes,
+                                   stats_.bytes_in_use + stats_.bytes_cached);
+  }
+  // Allocate outside the lock, the contents are not initialized.
+  if (!data) data.reset(new char[capacity]);
+  return IoBuffer(std::move(data), size, capacity, shared_from_this());
+}
+
+IoBufferPoolStats IoBufferPool::stats() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return stats_;
+}
+
+void IoBufferPool::Release(std::unique_ptr<char[]> data,
+                           std::size_t capacity) {
+  std::lock_guard<std::mutex> lk(mu_);
+  stats_.bytes_in_use -= capacity;
+  if (capacity > kMaxClassSize ||
+      stats_.bytes_cached + capacity > max_cached_bytes_) {
+    return;
+  }
+  free_[SizeClass(capacity)].push_back(std::move(data));
+  stats_.bytes_cached += capacity;
+}
+
+namespace internal {
+IoBuffer MakeIoBuffer(std::shared_ptr<IoBufferPool> const& pool,
+                      std::size_t size) {
+  if (pool) return pool->Acquire(size);
+  return IoBuffer(size);
+}
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,150 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_IO_BUFFER_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_IO_BUFFER_POOL_H
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+class IoBufferPool;
+
+/// The statistics of an `IoBufferPool`.
+struct IoBufferPoolStats {
+  /// The number of buffers reused from the pool.
+  std::uint64_t hits = 0;
+  /// The number of buffers allocated because the pool had none to reuse.
+  std::uint64_t misses = 0;
+  /// The bytes in the buffers currently in use.
+  std::size_t bytes_in_use = 0;
+  /// The bytes in the buffers kept by the pool for reuse.
+  std::size_t bytes_cached = 0;
+  /// The maximum of `bytes_in_use + bytes_cached` since the pool was created.
+  std::size_t peak_bytes = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, IoBufferPoolStats const& rhs);
+
+/**
+ * A buffer used by the downloads and uploads.
+ *
+ * Buffers acquired from an `IoBufferPool` are returned to it when destroyed,
+ * other buffers are simply released. The contents are not initialized.
+ */
+class IoBuffer {
+ public:
+  IoBuffer() = default;
+  /// Allocates a buffer of @p size bytes that does not belong to any pool.
+  explicit IoBuffer(std::size_t size);
+  ~IoBuffer() { Release(); }
+
+  IoBuffer(IoBuffer&& rhs) noexcept;
+  IoBuffer& operator=(IoBuffer&& rhs) noexcept;
+  IoBuffer(IoBuffer const&) = delete;
+  IoBuffer& operator=(IoBuffer const&) = delete;
+
+  char* data() const { return data_.get(); }
+  /// The requested size, the buffer may have a larger capacity.
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  friend class IoBufferPool;
+  IoBuffer(std::unique_ptr<char[]> data, std::size_t size,
+           std::size_t capacity, std::shared_ptr<IoBufferPool> pool);
+
+  void Release();
+
+  std::unique_ptr<char[]> data_;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+  std::shared_ptr<IoBufferPool> pool_;
+};
+
+/**
+ * Reuses the buffers of the downloads and uploads.
+ *
+ * Each `ObjectReadStream` and `ObjectWriteStream` allocates a buffer, as does
+ * each download for the data libcurl delivers beyond what the application
+ * requested. Applications opening and closing many short streams allocate
+ * and release these buffers at a high rate. With a pool the buffers are
+ * returned to the pool when the stream is closed, and reused by the next
+ * stream.
+ *
+ * The buffers are grouped in size classes, the powers of two from 4 KiB to
+ * 64 MiB, and each request is rounded up to its class. Larger buffers are not
+ * pooled. The pool keeps at most @p max_cached_bytes in released buffers, any
+ * excess is returned to the allocator.
+ *
+ * Use `storage_experimental::IoBufferPoolOption` to configure the pool used
+ * by a `Client`. The same pool can be shared by many clients, use `stats()` to
+ * monitor its effectiveness.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * auto pool = gcs::IoBufferPool::Create(128 * 1024 * 1024);
+ * auto client = gcs::Client(google::cloud::Options{}.set<
+ *     gcs::storage_experimental::IoBufferPoolOption>(pool));
+ * // ... use the client ...
+ * std::cout << pool->stats() << "\n";
+ * @endcode
+ */
+class IoBufferPool : public std::enable_shared_from_this<IoBufferPool> {
+ public:
+  /// Creates a pool keeping up to @p max_cached_bytes in released buffers.
+  static std::shared_ptr<IoBufferPool> Create(
+      std::size_t max_cached_bytes = 64 * 1024 * 1024);
+
+  /// Returns a buffer of at least @p size bytes.
+  IoBuffer Acquire(std::size_t size);
+
+  IoBufferPoolStats stats() const;
+  std::size_t max_cached_bytes() const { return max_cached_bytes_; }
+
+ private:
+  friend class IoBuffer;
+  explicit IoBufferPool(std::size_t max_cached_bytes);
+
+  void Release(std::unique_ptr<char[]> data, std::size_t capacity);
+
+  std::size_t const max_cached_bytes_;
+  mutable std::mutex mu_;
+  // The released buffers, indexed by size class.
+  std::vector<std::vector<std::unique_ptr<char[]>>> free_;
+  IoBufferPoolStats stats_;
+};
+
+namespace internal {
+/// Acquires a buffer from @p pool, or allocates it if @p pool is null.
+IoBuffer MakeIoBuffer(std::shared_ptr<IoBufferPool> const& pool,
+                      std::size_t size);
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_IO_BUFFER_POOL_H
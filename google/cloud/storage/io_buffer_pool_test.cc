@@ -0,0 +1,132 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/io_buffer_pool.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+TEST(IoBufferPoolTest, RoundsUpToSizeClass) {
+  auto pool = IoBufferPool::Create();
+  auto b1 = pool->Acquire(1);
+  EXPECT_EQ(1, b1.size());
+  EXPECT_EQ(4 * 1024, b1.capacity());
+  auto b2 = pool->Acquire(100 * 1024);
+  EXPECT_EQ(100 * 1024, b2.size());
+  EXPECT_EQ(128 * 1024, b2.capacity());
+  EXPECT_TRUE(pool->Acquire(0).empty());
+
+  auto stats = pool->stats();
+  EXPECT_EQ(0, stats.hits);
+  EXPECT_EQ(2, stats.misses);
+  EXPECT_EQ(132 * 1024, stats.bytes_in_use);
+  EXPECT_EQ(0, stats.bytes_cached);
+}
+
+TEST(IoBufferPoolTest, ReusesReleasedBuffers) {
+  auto pool = IoBufferPool::Create();
+  char const* data;
+  {
+    auto buffer = pool->Acquire(100 * 1024);
+    data = buffer.data();
+  }
+  auto stats = pool->stats();
+  EXPECT_EQ(0, stats.bytes_in_use);
+  EXPECT_EQ(128 * 1024, stats.bytes_cached);
+
+  // Any size in the same class reuses the buffer.
+  auto buffer = pool->Acquire(128 * 1024);
+  EXPECT_EQ(data, buffer.data());
+  stats = pool->stats();
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(1, stats.misses);
+  EXPECT_EQ(128 * 1024, stats.bytes_in_use);
+  EXPECT_EQ(0, stats.bytes_cached);
+
+  // Other classes do not.
+  auto other = pool->Acquire(16 * 1024);
+  EXPECT_EQ(2, pool->stats().misses);
+}
+
+TEST(IoBufferPoolTest, LimitsCachedBytes) {
+  auto pool = IoBufferPool::Create(8 * 1024);
+  {
+    auto b1 = pool->Acquire(4 * 1024);
+    auto b2 = pool->Acquire(4 * 1024);
+    auto b3 = pool->Acquire(4 * 1024);
+  }
+  auto stats = pool->stats();
+  EXPECT_EQ(0, stats.bytes_in_use);
+  EXPECT_EQ(8 * 1024, stats.bytes_cached);
+  EXPECT_EQ(12 * 1024, stats.peak_bytes);
+}
+
+TEST(IoBufferPoolTest, PeakBytes) {
+  auto pool = IoBufferPool::Create();
+  { auto b = pool->Acquire(64 * 1024); }
+  {
+    auto b1 = pool->Acquire(64 * 1024);
+    auto b2 = pool->Acquire(16 * 1024);
+  }
+  auto stats = pool->stats();
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(2, stats.misses);
+  EXPECT_EQ(80 * 1024, stats.bytes_cached);
+  EXPECT_EQ(80 * 1024, stats.peak_bytes);
+}
+
+TEST(IoBufferPoolTest, MoveReturnsBufferOnce) {
+  auto pool = IoBufferPool::Create();
+  auto b1 = pool->Acquire(4 * 1024);
+  auto b2 = std::move(b1);
+  EXPECT_EQ(0, b1.size());  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(4 * 1024, b2.size());
+  b1 = pool->Acquire(8 * 1024);
+  b1 = std::move(b2);
+  auto stats = pool->stats();
+  EXPECT_EQ(4 * 1024, stats.bytes_in_use);
+  EXPECT_EQ(8 * 1024, stats.bytes_cached);
+}
+
+TEST(IoBufferPoolTest, WithoutPool) {
+  auto buffer = internal::MakeIoBuffer(nullptr, 1000);
+  EXPECT_EQ(1000, buffer.size());
+  EXPECT_EQ(1000, buffer.capacity());
+  EXPECT_NE(nullptr, buffer.data());
+}
+
+TEST(IoBufferPoolTest, StatsStream) {
+  IoBufferPoolStats stats;
+  stats.hits = 1;
+  stats.misses = 2;
+  stats.bytes_in_use = 3;
+  stats.bytes_cached = 4;
+  stats.peak_bytes = 5;
+  std::ostringstream os;
+  os << stats;
+  EXPECT_EQ(
+      "hits=1, misses=2, bytes_in_use=3, bytes_cached=4, peak_bytes=5",
+      os.str());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,66 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECT_SUMMARIES_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECT_SUMMARIES_READER_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/internal/pagination_range.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/**
+ * A compact view of an object, as returned by `Client::ListObjectSummaries()`.
+ *
+ * Inventory jobs listing millions of objects often need only a few fields for
+ * each object. This type holds just those fields, and uses a fraction of the
+ * memory required by `ObjectMetadata`.
+ */
+struct ObjectSummary {
+  std::string name;
+  std::uint64_t size = 0;
+  std::int64_t generation = 0;
+  /// The base64-encoded CRC32C checksum of the object data.
+  std::string crc32c;
+};
+
+inline bool operator==(ObjectSummary const& lhs, ObjectSummary const& rhs) {
+  return lhs.name == rhs.name && lhs.size == rhs.size &&
+         lhs.generation == rhs.generation && lhs.crc32c == rhs.crc32c;
+}
+
+inline bool operator!=(ObjectSummary const& lhs, ObjectSummary const& rhs) {
+  return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, ObjectSummary const& rhs);
+
+using ListObjectSummariesReader =
+    google::cloud::internal::PaginationRange<ObjectSummary>;
+
+using ListObjectSummariesIterator = ListObjectSummariesReader::iterator;
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECT_SUMMARIES_READER_H
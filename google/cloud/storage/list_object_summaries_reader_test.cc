@@ -0,0 +1,134 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/list_object_summaries_reader.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <nlohmann/json.hpp>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ListObjectsRequest;
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+ObjectSummary MakeSummary(int index) {
+  ObjectSummary summary;
+  summary.name = "object-" + std::to_string(index);
+  summary.size = 1024 * index;
+  summary.generation = 1000 + index;
+  summary.crc32c = "crc-" + std::to_string(index);
+  return summary;
+}
+
+TEST(ListObjectSummariesReaderTest, Basic) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillOnce([](ListObjectsRequest const& r) {
+        EXPECT_TRUE(r.summaries_only());
+        EXPECT_EQ(internal::ObjectSummaryFields(),
+                  r.GetOption<Fields>().value_or(""));
+        EXPECT_EQ("dir/", r.GetOption<Prefix>().value_or(""));
+        EXPECT_TRUE(r.page_token().empty());
+        ListObjectsResponse response;
+        response.next_page_token = "page-1";
+        response.summaries = {MakeSummary(0), MakeSummary(1)};
+        return make_status_or(response);
+      })
+      .WillOnce([](ListObjectsRequest const& r) {
+        EXPECT_EQ("page-1", r.page_token());
+        ListObjectsResponse response;
+        response.summaries = {MakeSummary(2)};
+        return make_status_or(response);
+      });
+
+  auto client = testing::ClientFromMock(mock);
+  std::vector<ObjectSummary> actual;
+  // The `Fields` option is replaced by the fields needed for the summaries.
+  for (auto& s : client.ListObjectSummaries("test-bucket", Prefix("dir/"),
+                                            Fields("items(name)"))) {
+    ASSERT_STATUS_OK(s);
+    actual.push_back(*std::move(s));
+  }
+  EXPECT_THAT(actual, ElementsAre(MakeSummary(0), MakeSummary(1),
+                                  MakeSummary(2)));
+}
+
+TEST(ListObjectSummariesReaderTest, FromFullItems) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects).WillOnce([](ListObjectsRequest const&) {
+    ListObjectsResponse response;
+    response.items.push_back(
+        internal::ObjectMetadataParser::FromJson(
+            nlohmann::json{{"name", "object-1"},
+                           {"size", "1024"},
+                           {"generation", "1001"},
+                           {"crc32c", "crc-1"},
+                           {"metadata", {{"key", "value"}}}})
+            .value());
+    return make_status_or(response);
+  });
+
+  auto client = testing::ClientFromMock(mock);
+  std::vector<ObjectSummary> actual;
+  for (auto& s : client.ListObjectSummaries("test-bucket")) {
+    ASSERT_STATUS_OK(s);
+    actual.push_back(*std::move(s));
+  }
+  EXPECT_THAT(actual, ElementsAre(MakeSummary(1)));
+}
+
+TEST(ListObjectSummariesReaderTest, PermanentFailure) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillOnce(
+          [](ListObjectsRequest const&) -> StatusOr<ListObjectsResponse> {
+            return PermanentError();
+          });
+
+  auto client = testing::ClientFromMock(mock);
+  auto reader = client.ListObjectSummaries("test-bucket");
+  auto it = reader.begin();
+  ASSERT_NE(it, reader.end());
+  EXPECT_THAT(*it, StatusIs(PermanentError().code()));
+}
+
+TEST(ListObjectSummariesReaderTest, Print) {
+  std::ostringstream os;
+  os << MakeSummary(2);
+  EXPECT_THAT(os.str(), HasSubstr("name=object-2"));
+  EXPECT_THAT(os.str(), HasSubstr("size=2048"));
+  EXPECT_THAT(os.str(), HasSubstr("generation=1002"));
+  EXPECT_THAT(os.str(), HasSubstr("crc32c=crc-2"));
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
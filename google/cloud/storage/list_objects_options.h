@@ -0,0 +1,56 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECTS_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECTS_OPTIONS_H
+
+#include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/**
+ * Load up to this many pages of results ahead of the application.
+ *
+ * By default `ListObjects()` and `ListObjectsAndPrefixes()` request the next
+ * page of results only after the application iterates over all the elements
+ * in the current page, so each page costs a full round-trip while the
+ * application waits. With a non-zero depth a background thread requests each
+ * page as soon as the previous one arrives, keeping up to `depth` pages
+ * buffered, so the application processes one page while the next ones are
+ * loaded.
+ *
+ * Each page depends on the token returned with the previous page, so the pages
+ * are still requested one at a time. To list large buckets with several
+ * concurrent requests see `ParallelListObjects()`.
+ */
+struct ListObjectsPrefetchDepth
+    : public internal::ComplexOption<ListObjectsPrefetchDepth, std::size_t> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  ListObjectsPrefetchDepth() = default;
+  static char const* name() { return "list-objects-prefetch-depth"; }
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECTS_OPTIONS_H
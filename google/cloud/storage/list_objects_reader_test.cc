@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/list_objects_reader.h"
+#include "google/cloud/storage/client.h"
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
@@ -158,6 +159,38 @@ TEST(ListObjectsReaderTest, PermanentFailure) {
   EXPECT_THAT(actual, ContainerEq(expected));
 }
 
+TEST(ListObjectsReaderTest, Prefetch) {
+  std::vector<ObjectMetadata> expected;
+  int const page_count = 4;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .Times(page_count)
+      .WillRepeatedly([&](ListObjectsRequest const& r) {
+        EXPECT_EQ("foo-bar-baz", r.bucket_name());
+        auto const i = r.page_token().empty() ? 0 : std::stoi(r.page_token());
+        ListObjectsResponse response;
+        if (i != page_count - 1) {
+          response.next_page_token = std::to_string(i + 1);
+        }
+        response.items.emplace_back(CreateElement(2 * i));
+        response.items.emplace_back(CreateElement(2 * i + 1));
+        return make_status_or(response);
+      });
+
+  auto client = internal::ClientImplDetails::CreateWithoutDecorations(mock);
+  std::vector<ObjectMetadata> actual;
+  for (auto&& object :
+       client.ListObjects("foo-bar-baz", ListObjectsPrefetchDepth(2))) {
+    ASSERT_STATUS_OK(object);
+    actual.emplace_back(std::move(object).value());
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
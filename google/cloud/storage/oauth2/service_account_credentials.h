@@ -185,8 +185,9 @@ class ServiceAccountCredentials : public Credentials {
                     "The current_credentials cannot sign blobs for " +
                         signing_account.value());
     }
-    return internal::SignStringWithPem(blob, info_.private_key,
-                                       JwtSigningAlgorithms::RS256);
+    auto key = SigningKey();
+    if (!key) return std::move(key).status();
+    return key->Sign(blob, JwtSigningAlgorithms::RS256);
   }
 
   std::string AccountEmail() const override { return info_.client_email; }
@@ -208,12 +209,23 @@ class ServiceAccountCredentials : public Credentials {
     return ParseServiceAccountRefreshResponse(*response, clock_.now());
   }
 
+  /// Parses the private key on first use, parsing is expensive.
+  StatusOr<internal::PemPrivateKey> SigningKey() const {
+    std::lock_guard<std::mutex> lk(signing_key_mu_);
+    if (signing_key_) return *signing_key_;
+    auto key = internal::PemPrivateKey::Parse(info_.private_key);
+    if (key) signing_key_ = *key;
+    return key;
+  }
+
   typename HttpRequestBuilderType::RequestType request_;
   std::string grant_type_;
   ServiceAccountCredentialsInfo info_;
   mutable std::mutex mu_;
   RefreshingCredentialsWrapper refreshing_creds_;
   ClockType clock_;
+  mutable std::mutex signing_key_mu_;
+  mutable absl::optional<internal::PemPrivateKey> signing_key_;
 };
 
 }  // namespace oauth2
@@ -0,0 +1,119 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_buffer_reader.h"
+#include "google/cloud/log.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+static_assert(std::is_move_assignable<ObjectBufferReader>::value,
+              "storage::ObjectBufferReader must be move assignable.");
+static_assert(std::is_move_constructible<ObjectBufferReader>::value,
+              "storage::ObjectBufferReader must be move constructible.");
+
+ObjectBufferReader::ObjectBufferReader()
+    : ObjectBufferReader(Status(StatusCode::kUnimplemented, "null reader")) {}
+
+ObjectBufferReader::ObjectBufferReader(
+    internal::ReadObjectRangeRequest const& request,
+    std::unique_ptr<internal::ObjectReadSource> source)
+    : source_(std::move(source)),
+      hash_function_(internal::CreateHashFunction(request)),
+      hash_validator_(internal::CreateHashValidator(request)) {}
+
+ObjectBufferReader::ObjectBufferReader(Status status)
+    : status_(std::move(status)) {}
+
+ObjectBufferReader::~ObjectBufferReader() {
+  if (!IsOpen()) return;
+  auto status = Close();
+  if (!status.ok()) {
+    GCP_LOG(INFO) << "Ignored error while trying to close reader: " << status;
+  }
+}
+
+StatusOr<std::size_t> ObjectBufferReader::Read(MutableBuffer buffer) {
+  if (!status_.ok()) return status_;
+  auto const n = ReadImpl(buffer);
+  if (n == 0 && !status_.ok()) return status_;
+  return n;
+}
+
+StatusOr<std::size_t> ObjectBufferReader::Read(
+    MutableBufferSequence const& buffers) {
+  if (!status_.ok()) return status_;
+  std::size_t total = 0;
+  for (auto const& buffer : buffers) {
+    auto const n = ReadImpl(buffer);
+    total += n;
+    // A short read means the download completed or failed.
+    if (n != buffer.size()) break;
+  }
+  if (total == 0 && !status_.ok()) return status_;
+  return total;
+}
+
+Status ObjectBufferReader::Close() {
+  if (!IsOpen()) return status_;
+  auto response = source_->Close();
+  if (!response && status_.ok()) status_ = std::move(response).status();
+  return status_;
+}
+
+std::size_t ObjectBufferReader::ReadImpl(MutableBuffer buffer) {
+  std::size_t offset = 0;
+  while (offset < buffer.size() && status_.ok() && IsOpen()) {
+    // The transport copies the data directly into the application buffer.
+    auto read = source_->Read(buffer.data() + offset, buffer.size() - offset);
+    if (!read) {
+      status_ = std::move(read).status();
+      break;
+    }
+    hash_function_->Update(buffer.data() + offset, read->bytes_received);
+    offset += read->bytes_received;
+    for (auto const& kv : read->response.headers) {
+      hash_validator_->ProcessHeader(kv.first, kv.second);
+      headers_.emplace(kv.first, kv.second);
+    }
+  }
+  // Only validate the checksums once the download is closed.
+  if (!IsOpen()) ValidateHashes();
+  return offset;
+}
+
+void ObjectBufferReader::ValidateHashes() {
+  if (!hash_validator_) return;
+  // After this point the validator is not usable.
+  auto function = std::move(hash_function_);
+  auto validator = std::move(hash_validator_);
+  auto result = std::move(*validator).Finish(std::move(*function).Finish());
+  computed_hash_ = internal::FormatComputedHashes(result);
+  received_hash_ = internal::FormatReceivedHashes(result);
+  // If there is an existing error, we should report that instead because it is
+  // more specific, for example, every permanent network error will produce
+  // invalid checksums, but that is not the interesting information.
+  if (!result.is_mismatch || !status_.ok()) return;
+  status_ = Status(StatusCode::kDataLoss,
+                   "ReadObjectToBuffers(): mismatched hashes in download"
+                   ", computed=" +
+                       computed_hash_ + ", received=" + received_hash_);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,148 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_BUFFER_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_BUFFER_READER_H
+
+#include "google/cloud/storage/internal/hash_function.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/object_read_stream.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/span.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/// A buffer owned by the application, filled by `ObjectBufferReader`.
+using MutableBuffer = absl::Span<char>;
+
+/// A sequence of application-owned buffers, filled in order.
+using MutableBufferSequence = std::vector<MutableBuffer>;
+
+/**
+ * Reads the contents of a GCS Object into application-provided buffers.
+ *
+ * Unlike `ObjectReadStream` this class does not implement
+ * `std::basic_istream<char>`. The data is copied by the transport (typically
+ * libcurl) directly into the buffers provided by the application, there is no
+ * intermediate buffering, and errors are reported as `Status` values
+ * independently of the exception settings.
+ *
+ * The checksums and hashes of the data are validated once the download
+ * completes, exactly as `ObjectReadStream` does.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * void ReadAll(gcs::Client client, std::string const& bucket,
+ *              std::string const& object) {
+ *   auto reader = client.ReadObjectToBuffers(bucket, object);
+ *   std::vector<char> buffer(1024 * 1024);
+ *   for (;;) {
+ *     auto n = reader.Read(gcs::MutableBuffer(buffer));
+ *     if (!n) throw std::runtime_error(n.status().message());
+ *     if (*n == 0) break;
+ *     // ... use the first `*n` bytes in `buffer` ...
+ *   }
+ * }
+ * @endcode
+ */
+class ObjectBufferReader {
+ public:
+  /**
+   * Creates a reader not associated with any download.
+   *
+   * Attempts to use this reader will result in failures.
+   */
+  ObjectBufferReader();
+
+  /// Creates a reader for the data in @p source.
+  ObjectBufferReader(internal::ReadObjectRangeRequest const& request,
+                     std::unique_ptr<internal::ObjectReadSource> source);
+
+  /// Creates a reader in a permanent error status.
+  explicit ObjectBufferReader(Status status);
+
+  ObjectBufferReader(ObjectBufferReader&&) noexcept = default;
+  ObjectBufferReader& operator=(ObjectBufferReader&&) noexcept = default;
+  ObjectBufferReader(ObjectBufferReader const&) = delete;
+  ObjectBufferReader& operator=(ObjectBufferReader const&) = delete;
+
+  /// Closes the download (if necessary).
+  ~ObjectBufferReader();
+
+  bool IsOpen() const { return source_ && source_->IsOpen(); }
+
+  /**
+   * Fills @p buffer with the next bytes in the download.
+   *
+   * Returns the number of bytes read, which is smaller than `buffer.size()`
+   * only at the end of the download. A value of `0` indicates that the
+   * download completed successfully. If an error is detected after some data
+   * was copied into `buffer` the function returns the number of bytes copied,
+   * and the error is returned by the next call.
+   */
+  StatusOr<std::size_t> Read(MutableBuffer buffer);
+
+  /**
+   * Fills each buffer in @p buffers, in order, with the next bytes in the
+   * download.
+   *
+   * Returns the total number of bytes read, with the same semantics as the
+   * single buffer version.
+   */
+  StatusOr<std::size_t> Read(MutableBufferSequence const& buffers);
+
+  /**
+   * Terminate the download, possibly before completing it.
+   */
+  Status Close();
+
+  //@{
+  /// @name Report the download status, see `ObjectReadStream` for details.
+  Status const& status() const { return status_; }
+  std::string const& received_hash() const { return received_hash_; }
+  std::string const& computed_hash() const { return computed_hash_; }
+  HeadersMap const& headers() const { return headers_; }
+  //@}
+
+ private:
+  std::size_t ReadImpl(MutableBuffer buffer);
+  void ValidateHashes();
+
+  std::unique_ptr<internal::ObjectReadSource> source_;
+  std::unique_ptr<internal::HashFunction> hash_function_;
+  std::unique_ptr<internal::HashValidator> hash_validator_;
+  std::string computed_hash_;
+  std::string received_hash_;
+  Status status_;
+  HeadersMap headers_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_BUFFER_READER_H
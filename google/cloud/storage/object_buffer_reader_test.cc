@@ -0,0 +1,179 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_buffer_reader.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ReadObjectRangeRequest;
+using ::google::cloud::storage::internal::ReadSourceResult;
+using ::google::cloud::storage::testing::MockObjectReadSource;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Not;
+using ::testing::Return;
+
+/// Create a mock source that returns @p contents in chunks of @p chunk bytes.
+std::unique_ptr<MockObjectReadSource> MakeSource(
+    std::string contents, std::size_t chunk,
+    internal::HttpResponse last_response = {}) {
+  auto source = absl::make_unique<MockObjectReadSource>();
+  auto offset = std::make_shared<std::size_t>(0);
+  auto const size = contents.size();
+  EXPECT_CALL(*source, IsOpen).WillRepeatedly([offset, size] {
+    return *offset < size;
+  });
+  EXPECT_CALL(*source, Read)
+      .WillRepeatedly([offset, chunk, contents, last_response](
+                          char* buf, std::size_t n) {
+        auto const count =
+            (std::min)({n, chunk, contents.size() - *offset});
+        std::memcpy(buf, contents.data() + *offset, count);
+        *offset += count;
+        if (*offset < contents.size()) {
+          return make_status_or(ReadSourceResult{count, {}});
+        }
+        return make_status_or(ReadSourceResult{count, last_response});
+      });
+  return source;
+}
+
+TEST(ObjectBufferReaderTest, Default) {
+  ObjectBufferReader reader;
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_THAT(reader.status(), StatusIs(StatusCode::kUnimplemented));
+  std::vector<char> buffer(16);
+  EXPECT_THAT(reader.Read(MutableBuffer(buffer)),
+              StatusIs(StatusCode::kUnimplemented));
+}
+
+TEST(ObjectBufferReaderTest, ErrorStatus) {
+  ObjectBufferReader reader(Status(StatusCode::kNotFound, "NOT FOUND"));
+  EXPECT_FALSE(reader.IsOpen());
+  std::vector<char> buffer(16);
+  EXPECT_THAT(reader.Read(MutableBuffer(buffer)),
+              StatusIs(StatusCode::kNotFound));
+  EXPECT_THAT(reader.Close(), StatusIs(StatusCode::kNotFound));
+}
+
+TEST(ObjectBufferReaderTest, ReadSingleBuffer) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  ObjectBufferReader reader(ReadObjectRangeRequest{},
+                            MakeSource(contents, 7));
+  std::vector<char> buffer(16);
+  std::string actual;
+  for (;;) {
+    auto n = reader.Read(MutableBuffer(buffer));
+    ASSERT_STATUS_OK(n);
+    if (*n == 0) break;
+    // Only the last read may be short.
+    if (*n != buffer.size()) {
+      EXPECT_FALSE(reader.IsOpen());
+    }
+    actual.append(buffer.data(), *n);
+  }
+  EXPECT_EQ(contents, actual);
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_STATUS_OK(reader.status());
+  EXPECT_THAT(reader.computed_hash(), Not(IsEmpty()));
+  EXPECT_STATUS_OK(reader.Close());
+}
+
+TEST(ObjectBufferReaderTest, ReadBufferSequence) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  ObjectBufferReader reader(ReadObjectRangeRequest{},
+                            MakeSource(contents, 5));
+  std::vector<char> b0(4);
+  std::vector<char> b1(10);
+  std::vector<char> b2(100);
+  auto n = reader.Read(MutableBufferSequence{
+      MutableBuffer(b0), MutableBuffer(b1), MutableBuffer(b2)});
+  ASSERT_STATUS_OK(n);
+  EXPECT_EQ(contents.size(), *n);
+  std::string actual;
+  actual.append(b0.data(), b0.size());
+  actual.append(b1.data(), b1.size());
+  actual.append(b2.data(), contents.size() - b0.size() - b1.size());
+  EXPECT_EQ(contents, actual);
+
+  n = reader.Read(MutableBufferSequence{MutableBuffer(b0)});
+  ASSERT_STATUS_OK(n);
+  EXPECT_EQ(0, *n);
+}
+
+TEST(ObjectBufferReaderTest, ErrorAfterPartialRead) {
+  auto source = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*source, IsOpen).WillRepeatedly(Return(true));
+  EXPECT_CALL(*source, Read)
+      .WillOnce(Return(ReadSourceResult{5, {}}))
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+  EXPECT_CALL(*source, Close)
+      .WillOnce(Return(internal::HttpResponse{200, {}, {}}));
+  ObjectBufferReader reader(ReadObjectRangeRequest{}, std::move(source));
+
+  std::vector<char> buffer(16);
+  auto n = reader.Read(MutableBuffer(buffer));
+  ASSERT_STATUS_OK(n);
+  EXPECT_EQ(5, *n);
+  n = reader.Read(MutableBuffer(buffer));
+  EXPECT_THAT(n, StatusIs(StatusCode::kUnavailable, HasSubstr("try-again")));
+  EXPECT_THAT(reader.status(), StatusIs(StatusCode::kUnavailable));
+}
+
+TEST(ObjectBufferReaderTest, HashMismatch) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  internal::HttpResponse last_response{
+      200, {}, {{"x-goog-hash", "crc32c=AAAAAA==,md5=AAAAAAAAAAAAAAAAAAAAAA=="}}};
+  ObjectBufferReader reader(ReadObjectRangeRequest{},
+                            MakeSource(contents, 1024, last_response));
+  std::vector<char> buffer(1024);
+  auto n = reader.Read(MutableBuffer(buffer));
+  ASSERT_STATUS_OK(n);
+  EXPECT_EQ(contents.size(), *n);
+  n = reader.Read(MutableBuffer(buffer));
+  EXPECT_THAT(n, StatusIs(StatusCode::kDataLoss,
+                          HasSubstr("mismatched hashes in download")));
+  EXPECT_THAT(reader.received_hash(), HasSubstr("AAAAAA=="));
+  EXPECT_EQ(1, reader.headers().count("x-goog-hash"));
+}
+
+TEST(ObjectBufferReaderTest, Close) {
+  auto source = absl::make_unique<MockObjectReadSource>();
+  auto open = std::make_shared<bool>(true);
+  EXPECT_CALL(*source, IsOpen).WillRepeatedly([open] { return *open; });
+  EXPECT_CALL(*source, Close).WillOnce([open] {
+    *open = false;
+    return Status(StatusCode::kInternal, "cannot close");
+  });
+  ObjectBufferReader reader(ReadObjectRangeRequest{}, std::move(source));
+  EXPECT_TRUE(reader.IsOpen());
+  EXPECT_THAT(reader.Close(), StatusIs(StatusCode::kInternal));
+  EXPECT_FALSE(reader.IsOpen());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -253,6 +253,7 @@ class ObjectMetadata : private internal::CommonMetadata<ObjectMetadata> {
 
  private:
   friend struct internal::ObjectMetadataParser;
+  friend class internal::ObjectMetadataSaxHandler;
   friend class internal::GrpcClient;
 
   friend std::ostream& operator<<(std::ostream& os, ObjectMetadata const& rhs);
@@ -16,7 +16,9 @@
 #include "google/cloud/storage/internal/object_access_control_parser.h"
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/internal/parse_rfc3339.h"
+#include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <nlohmann/json.hpp>
 
 namespace google {
 namespace cloud {
@@ -24,7 +26,9 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace {
 
-ObjectMetadata CreateObjectMetadataForTest() {
+using ::google::cloud::testing_util::StatusIs;
+
+std::string CreateObjectMetadataTextForTest() {
   // This metadata object has some impossible combination of fields in it. The
   // goal is to fully test the parsing, not to simulate valid objects.
   std::string text = R"""({
@@ -105,7 +109,13 @@ ObjectMetadata CreateObjectMetadataForTest() {
       "updated": "2018-05-19T19:31:24Z",
       "customTime": "2020-08-10T12:34:56Z"
 })""";
-  return internal::ObjectMetadataParser::FromString(text).value();
+  return text;
+}
+
+ObjectMetadata CreateObjectMetadataForTest() {
+  return internal::ObjectMetadataParser::FromString(
+             CreateObjectMetadataTextForTest())
+      .value();
 }
 
 /// @test Verify that we parse JSON objects into ObjectMetadata objects.
@@ -167,6 +177,87 @@ TEST(ObjectMetadataTest, Parse) {
                                       .count());
 }
 
+/// @test Verify the streaming parser and the DOM parser produce equal values.
+TEST(ObjectMetadataTest, ParseStreamingMatchesDom) {
+  auto const text = CreateObjectMetadataTextForTest();
+  auto const expected =
+      internal::ObjectMetadataParser::FromJson(nlohmann::json::parse(text));
+  ASSERT_STATUS_OK(expected);
+  auto const actual = internal::ObjectMetadataParser::FromString(text);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(*expected, *actual);
+  EXPECT_TRUE(actual->has_custom_time());
+  EXPECT_TRUE(actual->has_customer_encryption());
+  EXPECT_EQ("abc123", actual->customer_encryption().key_sha256);
+}
+
+/// @test Verify the streaming parser ignores unknown fields.
+TEST(ObjectMetadataTest, ParseIgnoresUnknownFields) {
+  auto const actual = internal::ObjectMetadataParser::FromString(R"""({
+      "name": "baz",
+      "unknownObject": {"a": [1, 2, {"b": null}], "name": "not-this-one"},
+      "unknownArray": [[], {}, "size"],
+      "unknownScalar": 42.5,
+      "size": "1024",
+      "generation": 7
+})""");
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("baz", actual->name());
+  EXPECT_EQ(1024, actual->size());
+  EXPECT_EQ(7, actual->generation());
+}
+
+/// @test Verify the streaming parser reports invalid fields.
+TEST(ObjectMetadataTest, ParseStreamingErrors) {
+  for (auto const* text : {
+           R"""("not-an-object")""",
+           R"""([{"name": "baz"}])""",
+           R"""({"name": "baz")""",
+           R"""({"generation": "not-a-number"})""",
+           R"""({"size": true})""",
+           R"""({"name": 42})""",
+           R"""({"temporaryHold": "maybe"})""",
+           R"""({"timeCreated": "not-a-timestamp"})""",
+           R"""({"acl": {"entity": "user-qux"}})""",
+           R"""({"acl": ["not-a-valid-acl"]})""",
+           R"""({"owner": "user-qux"})""",
+           R"""({"metadata": {"key": 42}})""",
+       }) {
+    SCOPED_TRACE("Testing with " + std::string(text));
+    auto const actual = internal::ObjectMetadataParser::FromString(text);
+    EXPECT_THAT(actual, StatusIs(StatusCode::kInvalidArgument));
+  }
+}
+
+/// @test Verify the streaming parser only fills the requested fields.
+TEST(ObjectMetadataTest, ParseNameSizeGeneration) {
+  auto const text = CreateObjectMetadataTextForTest();
+  internal::ObjectMetadataSaxHandler handler(
+      internal::ObjectMetadataFields::kNameSizeGeneration);
+  ASSERT_TRUE(nlohmann::json::sax_parse(text, &handler));
+  ASSERT_STATUS_OK(handler.status());
+  ASSERT_TRUE(handler.done());
+  auto const& actual = handler.result();
+  EXPECT_EQ("baz", actual.name());
+  EXPECT_EQ(102400, actual.size());
+  EXPECT_EQ(12345, actual.generation());
+  EXPECT_EQ(ObjectMetadata{}.bucket(), actual.bucket());
+  EXPECT_TRUE(actual.acl().empty());
+  EXPECT_TRUE(actual.metadata().empty());
+  EXPECT_FALSE(actual.has_owner());
+  EXPECT_EQ(0, actual.metageneration());
+
+  // The handler can be reused.
+  handler.Reset();
+  ASSERT_TRUE(nlohmann::json::sax_parse(
+      std::string(R"""({"name": "qux", "size": 7, "bucket": "b"})"""),
+      &handler));
+  EXPECT_EQ("qux", handler.result().name());
+  EXPECT_EQ(7, handler.result().size());
+  EXPECT_EQ(0, handler.result().generation());
+  EXPECT_TRUE(handler.result().bucket().empty());
+}
+
 /// @test Verify that the IOStream operator works as expected.
 TEST(ObjectMetadataTest, IOStream) {
   auto meta = CreateObjectMetadataForTest();
@@ -16,13 +16,16 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OPTIONS_H
 
 #include "google/cloud/storage/idempotency_policy.h"
+#include "google/cloud/storage/io_buffer_pool.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/transfer_rate_limiter.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/backoff_policy.h"
 #include "google/cloud/credentials.h"
 #include "google/cloud/options.h"
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -47,6 +50,277 @@ inline namespace STORAGE_CLIENT_NS {
 struct HttpVersionOption {
   using Type = std::string;
 };
+
+/**
+ * Run the downloads on background threads sharing libcurl multi handles.
+ *
+ * By default each download uses its own `CURLM*` handle, and the transfer is
+ * performed by the thread reading the data. If this option is set to a
+ * positive value the client creates that many background threads, each one
+ * owning a shared `CURLM*` handle, and assigns the downloads to them in
+ * round-robin order. Downloads running on the same thread share a connection
+ * cache, with HTTP/2 (see `HttpVersionOption`) concurrent downloads from the
+ * same host are multiplexed over a single connection, reducing the number of
+ * connections and TLS handshakes.
+ */
+struct SharedCurlMultiThreadsOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Split the connection pool into this many shards.
+ *
+ * Each shard has its own mutex, and threads prefer the shard selected by their
+ * id. With many threads using the same client this reduces the contention to
+ * get and release handles from the pool. By default the library uses one shard
+ * per hardware thread, up to the connection pool size.
+ */
+struct ConnectionPoolShardsOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Share the DNS and TLS session caches between all the handles.
+ *
+ * When enabled (the default) all the libcurl handles created by a client share
+ * a single `CURLSH*` handle. Requests can then reuse the DNS results and TLS
+ * sessions from any previous request, even if that request used a different
+ * handle. New connections resume a TLS session instead of performing a full
+ * handshake, even with `storage::ConnectionPoolSizeOption` set to zero.
+ *
+ * @note The connection cache is not shared. libcurl does not support using a
+ *     shared connection cache from multiple threads at the same time, so each
+ *     handle keeps its own connections.
+ */
+struct EnableCurlShareOption {
+  using Type = bool;
+};
+
+/**
+ * Open this many connections to the storage endpoint when creating a client.
+ *
+ * With this option the first requests after the application starts may find a
+ * connection in the pool, and avoid the DNS lookup, TCP and TLS handshakes.
+ * The connections are opened in parallel, and the client constructor blocks
+ * until they are established (or fail). Failures are ignored. The number of
+ * connections is capped by the `storage::ConnectionPoolSizeOption`, and
+ * this option has no effect if the pool size is zero.
+ *
+ * @note The connections are only available to the handles used for metadata
+ *     requests, downloads use a separate pool of `CURLM*` handles and do not
+ *     reuse them. With `EnableCurlShareOption` downloads can still resume the
+ *     TLS sessions established by these connections.
+ */
+struct ConnectionPoolPrewarmOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Cache the metadata for up to this many objects in the client.
+ *
+ * With a non-zero value `Client::GetObjectMetadata()` serves repeated requests
+ * for the same object from an in-memory LRU cache. Requests with a specific
+ * generation, a field mask, or preconditions other than `IfGenerationMatch`
+ * and `IfMatchEtag` always go to the service. Any uploads, copies, rewrites,
+ * updates, ACL changes and deletes made through the same client discard the
+ * cached entry, changes made by other clients are only observed when the
+ * entry expires, see `ObjectMetadataCacheTtlOption`.
+ *
+ * The default is zero, which disables the cache.
+ */
+struct ObjectMetadataCacheSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * How long the entries in the object metadata cache remain valid.
+ *
+ * Only used if `ObjectMetadataCacheSizeOption` is non-zero. The default is 10
+ * seconds.
+ */
+struct ObjectMetadataCacheTtlOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * Cache up to this many bucket IAM policies and permission checks.
+ *
+ * With a non-zero value `Client::GetNativeBucketIamPolicy()` and
+ * `Client::TestBucketIamPermissions()` serve repeated requests from in-memory
+ * LRU caches, each holding up to this many entries. Concurrent identical
+ * requests share a single call to the service. The cached permission checks
+ * for a bucket are discarded when a refreshed policy has a new ETag, and when
+ * the same client changes the bucket IAM policy, ACLs, or metadata. Other
+ * changes are only observed when the entries expire, see `IamCacheTtlOption`.
+ *
+ * The default is zero, which disables the cache.
+ */
+struct IamCacheSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * How long the entries in the IAM cache remain valid.
+ *
+ * Only used if `IamCacheSizeOption` is non-zero. The default is 10 seconds.
+ */
+struct IamCacheTtlOption {
+  using Type = std::chrono::milliseconds;
+};
+
+/**
+ * Cache up to this many bytes of object data in the client.
+ *
+ * With a non-zero value ranged reads (using `ReadRange` or `ReadFromOffset`)
+ * of a specific object generation (set via `Generation` or
+ * `IfGenerationMatch`) are served from an in-memory LRU cache of fixed-size
+ * blocks. Only the missing blocks are downloaded. This is most useful for
+ * applications that read the same parts of the same objects repeatedly.
+ *
+ * Full downloads, reads using `ReadLast`, encrypted objects, and reads without
+ * a generation always go to the service.
+ *
+ * The default is zero, which disables the cache.
+ */
+struct ReadBlockCacheSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The size of the blocks in the read block cache.
+ *
+ * Each cache miss downloads a full block, larger blocks reduce the number of
+ * requests, but may download data that is never used. Only used if
+ * `ReadBlockCacheSizeOption` is non-zero. The default is 1 MiB.
+ */
+struct ReadBlockCacheBlockSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The number of threads used by `Client::CreateV4SignedUrls()`.
+ *
+ * Signing with service account keys is CPU bound, and signing with other
+ * credentials requires a `SignBlob` request to the IAM service. Larger values
+ * sign multiple URLs concurrently. The default is 1, which signs all the URLs
+ * in the calling thread.
+ */
+struct SigningConcurrencyOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Write downloaded files using direct I/O, bypassing the page cache.
+ *
+ * Affects `Client::DownloadToFile()` and `ParallelDownloadFile()`. The data
+ * is received into aligned buffers, and each full buffer is written (with
+ * `O_DIRECT`) by a background thread while the next buffer is received. This
+ * avoids polluting the page cache with data the application may never read,
+ * which matters for large downloads to fast local disks. The first and last
+ * few KiB of each stream, which are not aligned, use the page cache.
+ *
+ * Ignored on platforms, or filesystems, without `O_DIRECT` support. The
+ * default is `false`.
+ */
+struct DirectFileIoOption {
+  using Type = bool;
+};
+
+/**
+ * The initial readahead for `Client::OpenRandomAccessReader()`.
+ *
+ * Each ranged download started by a `RandomAccessObjectReader` requests at
+ * least this many bytes. Reads that start within this many bytes after the
+ * current position of an open download are served from that download, the
+ * bytes in between are discarded. The default is 256 KiB.
+ */
+struct RandomAccessMinReadaheadOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The maximum readahead for `Client::OpenRandomAccessReader()`.
+ *
+ * When the application keeps reading past the end of a download the reader
+ * doubles the readahead for the next download, up to this limit. The default
+ * is 16 MiB.
+ */
+struct RandomAccessMaxReadaheadOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The number of idle downloads kept by each `RandomAccessObjectReader`.
+ *
+ * Concurrent reads use separate downloads. Once a read completes its download
+ * is kept open, so later reads of the following bytes can continue it. The
+ * least recently used downloads beyond this limit are closed. The default is
+ * 4.
+ */
+struct RandomAccessMaxIdleStreamsOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Adapt the chunk size of resumable uploads to the network.
+ *
+ * With this option `Client::WriteObject()` starts with chunks of
+ * `storage::UploadBufferSizeOption` bytes, doubles the chunk size while the
+ * upload throughput keeps improving, and halves it after failed attempts. The
+ * chunk size remains between `MinimumUploadBufferSizeOption` and
+ * `MaximumUploadBufferSizeOption`. Uploads using `UploadPipelineDepth` ignore
+ * this option. The default is `false`.
+ */
+struct AdaptiveUploadBufferSizeOption {
+  using Type = bool;
+};
+
+/// The minimum chunk size with `AdaptiveUploadBufferSizeOption`, 256 KiB by
+/// default.
+struct MinimumUploadBufferSizeOption {
+  using Type = std::size_t;
+};
+
+/// The maximum chunk size with `AdaptiveUploadBufferSizeOption`, 32 MiB by
+/// default.
+struct MaximumUploadBufferSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Limit the bandwidth of all the downloads and uploads in the client.
+ *
+ * The limiter applies to `Client::ReadObject()`, `Client::WriteObject()`, and
+ * the functions built on them, such as `Client::DownloadToFile()` and the
+ * resumable uploads in `Client::UploadFile()`. It can be shared by several
+ * clients. The `UseTransferRateLimiter` request option overrides this value
+ * for individual streams. The default is no limit.
+ */
+struct TransferRateLimiterOption {
+  using Type = std::shared_ptr<storage::TransferRateLimiter>;
+};
+
+/**
+ * The priority of the client transfers in their `TransferRateLimiter`.
+ *
+ * The `WithTransferPriority` request option overrides this value for
+ * individual streams. The default is `TransferPriority::kNormal`.
+ */
+struct TransferPriorityOption {
+  using Type = storage::TransferPriority;
+};
+
+/**
+ * Reuse the download and upload buffers from this pool.
+ *
+ * The streams returned by `Client::ReadObject()` and `Client::WriteObject()`,
+ * and the downloads made by the client, acquire their buffers from the pool
+ * and return them when closed. The pool can be shared by several clients.
+ * The default is no pool, each stream allocates its own buffers.
+ */
+struct IoBufferPoolOption {
+  using Type = std::shared_ptr<storage::IoBufferPool>;
+};
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage_experimental
 
@@ -236,7 +510,28 @@ using ClientOptionList = ::google::cloud::OptionList<
     MaximumCurlSocketRecvSizeOption, MaximumCurlSocketSendSizeOption,
     DownloadStallTimeoutOption, RetryPolicyOption, BackoffPolicyOption,
     IdempotencyPolicyOption, CARootsFilePathOption,
-    storage_experimental::HttpVersionOption>;
+    storage_experimental::HttpVersionOption,
+    storage_experimental::SharedCurlMultiThreadsOption,
+    storage_experimental::ConnectionPoolShardsOption,
+    storage_experimental::EnableCurlShareOption,
+    storage_experimental::ConnectionPoolPrewarmOption,
+    storage_experimental::ObjectMetadataCacheSizeOption,
+    storage_experimental::ObjectMetadataCacheTtlOption,
+    storage_experimental::IamCacheSizeOption,
+    storage_experimental::IamCacheTtlOption,
+    storage_experimental::ReadBlockCacheSizeOption,
+    storage_experimental::ReadBlockCacheBlockSizeOption,
+    storage_experimental::SigningConcurrencyOption,
+    storage_experimental::DirectFileIoOption,
+    storage_experimental::RandomAccessMinReadaheadOption,
+    storage_experimental::RandomAccessMaxReadaheadOption,
+    storage_experimental::RandomAccessMaxIdleStreamsOption,
+    storage_experimental::AdaptiveUploadBufferSizeOption,
+    storage_experimental::MinimumUploadBufferSizeOption,
+    storage_experimental::MaximumUploadBufferSizeOption,
+    storage_experimental::TransferRateLimiterOption,
+    storage_experimental::TransferPriorityOption,
+    storage_experimental::IoBufferPoolOption>;
 
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
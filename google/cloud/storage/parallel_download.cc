@@ -0,0 +1,106 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/storage/internal/file_region_sink.h"
+#include "google/cloud/storage/internal/hash_function_impl.h"
+#include <crc32c/crc32c.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+StatusOr<std::uint32_t> DownloadSliceToFile(ObjectReadStream stream,
+                                            PositionalFileWriter& writer,
+                                            ParallelDownloadSlice slice,
+                                            std::size_t buffer_size) {
+  auto report_error = [&writer, slice](char const* what,
+                                       Status const& status) {
+    std::ostringstream msg;
+    msg << "DownloadSliceToFile(" << writer.file_name()
+        << ", offset=" << slice.offset << ", size=" << slice.size
+        << "): " << what << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+  if (!stream.status().ok()) {
+    return report_error("cannot open download source object",
+                        stream.status());
+  }
+
+  // The data is received directly into the sink buffers, and written to the
+  // file while the next buffer is received.
+  FileRegionSink sink(writer, static_cast<std::uintmax_t>(slice.offset),
+                      buffer_size);
+  std::uint32_t crc = 0;
+  std::int64_t received = 0;
+  do {
+    auto buffer = sink.buffer();
+    stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    auto const n = static_cast<std::size_t>(stream.gcount());
+    if (n == 0) continue;
+    if (received + static_cast<std::int64_t>(n) > slice.size) {
+      return report_error(
+          "download source returned too much data",
+          Status(StatusCode::kInternal, "unexpected slice size"));
+    }
+    crc = crc32c::Extend(
+        crc, reinterpret_cast<std::uint8_t const*>(buffer.data()), n);
+    auto status = sink.Commit(n);
+    if (!status.ok()) {
+      return report_error("cannot write to download destination file",
+                          status);
+    }
+    received += static_cast<std::int64_t>(n);
+  } while (stream.good());
+  auto status = sink.Close();
+  if (!status.ok()) {
+    return report_error("cannot write to download destination file", status);
+  }
+
+  if (!stream.status().ok()) {
+    return report_error("error reading download source object",
+                        stream.status());
+  }
+  if (received != slice.size) {
+    return report_error("download source returned too little data",
+                        Status(StatusCode::kInternal, "unexpected slice size"));
+  }
+  return crc;
+}
+
+Status ValidateParallelDownloadCrc32c(
+    std::string const& expected_crc32c,
+    std::vector<ParallelDownloadSlice> const& slices,
+    std::vector<std::uint32_t> const& crc32c) {
+  if (expected_crc32c.empty()) return Status{};
+  Crc32cHashFunction function;
+  for (std::size_t i = 0; i != slices.size() && i != crc32c.size(); ++i) {
+    function.Concat(crc32c[i], static_cast<std::uintmax_t>(slices[i].size));
+  }
+  auto const actual = std::move(function).Finish().crc32c;
+  if (actual == expected_crc32c) return Status{};
+  return Status(StatusCode::kDataLoss,
+                "ParallelDownloadFile(): mismatched hashes in download" +
+                    std::string(", computed=") + actual +
+                    ", received=" + expected_crc32c);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,217 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/positional_file_writer.h"
+#include "google/cloud/storage/internal/tuple_filter.h"
+#include "google/cloud/storage/object_read_stream.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/internal/tuple.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// A contiguous range of an object, downloaded by a single stream.
+struct ParallelDownloadSlice {
+  std::int64_t offset;
+  std::int64_t size;
+};
+
+inline bool operator==(ParallelDownloadSlice const& a,
+                       ParallelDownloadSlice const& b) {
+  return a.offset == b.offset && a.size == b.size;
+}
+
+inline bool operator!=(ParallelDownloadSlice const& a,
+                       ParallelDownloadSlice const& b) {
+  return !(a == b);
+}
+
+/**
+ * Splits an object in slices to download in parallel.
+ *
+ * Uses the same `MaxStreams` and `MinStreamSize` options (and defaults) as
+ * `ParallelUploadFile()`. Returns an empty vector for empty objects.
+ */
+template <typename... Options>
+std::vector<ParallelDownloadSlice> ComputeParallelDownloadSlices(
+    std::int64_t object_size, std::tuple<Options...> const& options) {
+  std::vector<ParallelDownloadSlice> slices;
+  if (object_size <= 0) return slices;
+  auto const split_points = ComputeParallelFileUploadSplitPoints(
+      static_cast<std::uintmax_t>(object_size), options);
+  std::int64_t offset = 0;
+  for (auto const split : split_points) {
+    auto const end = static_cast<std::int64_t>(split);
+    slices.push_back(ParallelDownloadSlice{offset, end - offset});
+    offset = end;
+  }
+  slices.push_back(ParallelDownloadSlice{offset, object_size - offset});
+  return slices;
+}
+
+/**
+ * Copies the data in @p stream to @p writer, at the offset given by @p slice.
+ *
+ * @return the CRC32C checksum of the data, or an error if the stream fails, or
+ *     if it returns a different number of bytes than expected.
+ */
+StatusOr<std::uint32_t> DownloadSliceToFile(ObjectReadStream stream,
+                                            PositionalFileWriter& writer,
+                                            ParallelDownloadSlice slice,
+                                            std::size_t buffer_size);
+
+/**
+ * Validates the per-slice checksums against the checksum of the full object.
+ *
+ * @param expected_crc32c the (base64-encoded) checksum in the object metadata,
+ *     if empty, no validation is performed.
+ * @param slices the slices downloaded, in order.
+ * @param crc32c the checksum of each slice.
+ */
+Status ValidateParallelDownloadCrc32c(
+    std::string const& expected_crc32c,
+    std::vector<ParallelDownloadSlice> const& slices,
+    std::vector<std::uint32_t> const& crc32c);
+
+}  // namespace internal
+
+/**
+ * Download an object to a local file using multiple concurrent streams.
+ *
+ * The object is split in contiguous slices, each slice is downloaded by its
+ * own thread using a ranged read (see `ReadRange`), and written directly to
+ * its final position in a preallocated file. All the slices read the same
+ * object generation, even if the object is overwritten during the download.
+ *
+ * You can affect how many slices will be created by using the `MaxStreams` and
+ * `MinStreamSize` options. The streams share the client's connection pool,
+ * consider increasing `ConnectionPoolSizeOption` to match `MaxStreams`. Each
+ * stream writes its data in a background thread, overlapping the download and
+ * the disk writes, see also `storage_experimental::DirectFileIoOption`.
+ *
+ * Ranged reads cannot be validated by the service checksums, instead this
+ * function computes the CRC32C checksum of each slice, combines them, and
+ * compares the result against the checksum of the full object. Use
+ * `DisableCrc32cChecksum(true)` to skip this validation.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the object.
+ * @param object_name the name of the object to be downloaded.
+ * @param file_name the name of the destination file that will have the object
+ *     media.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `DisableCrc32cChecksum`,
+ *     `EncryptionKey`, `Generation`, `IfGenerationMatch`,
+ *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+ *     `IfMetagenerationNotMatch`, `MaxStreams`, `MinStreamSize`, and
+ *     `UserProject`.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent. Each ranged read is
+ * retried based on the client policies, but the operation stops on the first
+ * slice that fails. The destination file may be partially written on failure.
+ */
+template <typename... Options>
+Status ParallelDownloadFile(Client client, std::string const& bucket_name,
+                            std::string const& object_name,
+                            std::string const& file_name,
+                            Options&&... options) {
+  auto metadata = google::cloud::internal::apply(
+      internal::GetObjectMetadataApplyHelper{client, bucket_name,
+                                             object_name},
+      internal::StaticTupleFilter<internal::Among<
+          Generation, IfGenerationMatch, IfGenerationNotMatch,
+          IfMetagenerationMatch, IfMetagenerationNotMatch,
+          UserProject>::TPred>(std::tie(options...)));
+  if (!metadata) return std::move(metadata).status();
+
+  auto const object_size = static_cast<std::int64_t>(metadata->size());
+  auto const slices = internal::ComputeParallelDownloadSlices(
+      object_size, std::tie(options...));
+  auto const& client_options =
+      internal::ClientImplDetails::GetRawClient(client)->client_options();
+  auto writer = internal::PositionalFileWriter::Create(
+      file_name, metadata->size(),
+      internal::MakeOptions(client_options)
+          .get<storage_experimental::DirectFileIoOption>());
+  if (!writer) return std::move(writer).status();
+
+  auto const buffer_size = client_options.download_buffer_size();
+  auto read_options =
+      internal::StaticTupleFilter<
+          internal::Among<EncryptionKey, UserProject>::TPred>(
+          std::tie(options...));
+  auto const generation = metadata->generation();
+
+  std::vector<StatusOr<std::uint32_t>> results(slices.size());
+  std::vector<std::thread> threads;
+  threads.reserve(slices.size());
+  for (std::size_t i = 0; i != slices.size(); ++i) {
+    threads.emplace_back([&, i] {
+      auto const& slice = slices[i];
+      auto stream = google::cloud::internal::apply(
+          internal::ReadObjectApplyHelper{client, bucket_name, object_name},
+          std::tuple_cat(read_options,
+                         std::make_tuple(
+                             Generation(generation),
+                             ReadRange(slice.offset, slice.offset + slice.size),
+                             DisableCrc32cChecksum(true),
+                             DisableMD5Hash(true))));
+      results[i] = internal::DownloadSliceToFile(std::move(stream), **writer,
+                                                 slice, buffer_size);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<std::uint32_t> checksums;
+  checksums.reserve(results.size());
+  for (auto& r : results) {
+    if (!r) return std::move(r).status();
+    checksums.push_back(*r);
+  }
+  auto status = (*writer)->Close();
+  if (!status.ok()) return status;
+
+  auto disable_crc32c =
+      internal::ExtractFirstOccurrenceOfType<DisableCrc32cChecksum>(
+          std::tie(options...));
+  if (disable_crc32c && disable_crc32c->value_or(false)) return Status{};
+  return internal::ValidateParallelDownloadCrc32c(metadata->crc32c(), slices,
+                                                 checksums);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
@@ -0,0 +1,258 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/client_unit_test.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <crc32c/crc32c.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+
+std::string const kBucketName = "test-bucket";
+std::string const kObjectName = "test-object";
+std::int64_t const kGeneration = 1234;
+
+std::string Crc32c(std::string const& contents) {
+  return Base64Encode(
+      google::cloud::internal::EncodeBigEndian(crc32c::Crc32c(contents)));
+}
+
+ObjectMetadata MockObject(std::string const& contents,
+                          std::string const& crc32c) {
+  auto metadata = internal::ObjectMetadataParser::FromJson(nlohmann::json{
+      {"bucket", kBucketName},
+      {"name", kObjectName},
+      {"generation", kGeneration},
+      {"size", contents.size()},
+      {"crc32c", crc32c},
+  });
+  EXPECT_STATUS_OK(metadata);
+  return *metadata;
+}
+
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string{std::istreambuf_iterator<char>{is}, {}};
+}
+
+/// Returns a read source serving the range requested in @p request.
+std::unique_ptr<ObjectReadSource> MakeReadSource(
+    std::string const& contents, ReadObjectRangeRequest const& request) {
+  auto const range = request.GetOption<ReadRange>().value();
+  auto data = std::make_shared<std::string>(contents.substr(
+      static_cast<std::size_t>(range.begin),
+      static_cast<std::size_t>(range.end - range.begin)));
+  auto offset = std::make_shared<std::size_t>(0);
+  auto source = absl::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*source, IsOpen).WillRepeatedly(Return(true));
+  EXPECT_CALL(*source, Close)
+      .WillRepeatedly(Return(HttpResponse{200, "", {}}));
+  EXPECT_CALL(*source, Read).WillRepeatedly([data, offset](char* buf,
+                                                           std::size_t n) {
+    n = (std::min)(n, data->size() - *offset);
+    std::memcpy(buf, data->data() + *offset, n);
+    *offset += n;
+    return ReadSourceResult{n, HttpResponse{200, "", {}}};
+  });
+  return std::unique_ptr<ObjectReadSource>(std::move(source));
+}
+
+class ParallelDownloadTest
+    : public ::google::cloud::storage::testing::ClientUnitTest {};
+
+TEST(ParallelDownloadSlices, Empty) {
+  EXPECT_THAT(ComputeParallelDownloadSlices(0, std::make_tuple()), IsEmpty());
+}
+
+TEST(ParallelDownloadSlices, Simple) {
+  // Like `ParallelUploadFile()` the object is split in slices of (roughly)
+  // equal size, instead of `MinStreamSize` slices plus a smaller remainder.
+  EXPECT_THAT(ComputeParallelDownloadSlices(
+                  250, std::make_tuple(MinStreamSize(100), MaxStreams(10))),
+              ElementsAre(ParallelDownloadSlice{0, 84},
+                          ParallelDownloadSlice{84, 84},
+                          ParallelDownloadSlice{168, 82}));
+}
+
+TEST(ParallelDownloadSlices, LimitedByMaxStreams) {
+  EXPECT_THAT(ComputeParallelDownloadSlices(
+                  1000, std::make_tuple(MinStreamSize(10), MaxStreams(2))),
+              ElementsAre(ParallelDownloadSlice{0, 500},
+                          ParallelDownloadSlice{500, 500}));
+}
+
+TEST(ParallelDownloadSlices, SingleSlice) {
+  EXPECT_THAT(ComputeParallelDownloadSlices(10, std::make_tuple()),
+              ElementsAre(ParallelDownloadSlice{0, 10}));
+}
+
+TEST(ValidateParallelDownloadCrc32c, Success) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  std::vector<ParallelDownloadSlice> const slices{{0, 10}, {10, 20}, {30, 13}};
+  std::vector<std::uint32_t> checksums;
+  for (auto const& s : slices) {
+    checksums.push_back(crc32c::Crc32c(contents.substr(
+        static_cast<std::size_t>(s.offset), static_cast<std::size_t>(s.size))));
+  }
+  EXPECT_STATUS_OK(
+      ValidateParallelDownloadCrc32c(Crc32c(contents), slices, checksums));
+  EXPECT_THAT(ValidateParallelDownloadCrc32c(Crc32c("invalid"), slices,
+                                             checksums),
+              StatusIs(StatusCode::kDataLoss, HasSubstr("mismatched hashes")));
+  // No checksum in the metadata disables the validation.
+  EXPECT_STATUS_OK(ValidateParallelDownloadCrc32c("", slices, checksums));
+}
+
+TEST_F(ParallelDownloadTest, Success) {
+  std::string contents;
+  for (int i = 0; contents.size() < 1000; ++i) {
+    contents += std::to_string(i) + ",";
+  }
+  contents.resize(1000);
+
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce([&](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ(kBucketName, r.bucket_name());
+        EXPECT_EQ(kObjectName, r.object_name());
+        EXPECT_EQ(7, r.GetOption<IfMetagenerationMatch>().value_or(0));
+        return make_status_or(MockObject(contents, Crc32c(contents)));
+      });
+  std::mutex mu;
+  std::vector<std::pair<std::int64_t, std::int64_t>> ranges;
+  EXPECT_CALL(*mock_, ReadObject)
+      .Times(4)
+      .WillRepeatedly([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(kGeneration, r.GetOption<Generation>().value_or(0));
+        EXPECT_EQ("test-project", r.GetOption<UserProject>().value_or(""));
+        EXPECT_FALSE(r.HasOption<IfMetagenerationMatch>());
+        auto const range = r.GetOption<ReadRange>().value();
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          ranges.emplace_back(range.begin, range.end);
+        }
+        return make_status_or(MakeReadSource(contents, r));
+      });
+
+  testing::TempFile temp("");
+  auto client = ClientForMock();
+  auto status =
+      ParallelDownloadFile(client, kBucketName, kObjectName, temp.name(),
+                           MaxStreams(4), MinStreamSize(100),
+                           IfMetagenerationMatch(7),
+                           UserProject("test-project"));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(contents, ReadFile(temp.name()));
+  EXPECT_THAT(ranges, UnorderedElementsAre(std::make_pair(0, 250),
+                                           std::make_pair(250, 500),
+                                           std::make_pair(500, 750),
+                                           std::make_pair(750, 1000)));
+}
+
+TEST_F(ParallelDownloadTest, EmptyObject) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(make_status_or(MockObject("", Crc32c("")))));
+  EXPECT_CALL(*mock_, ReadObject).Times(0);
+
+  testing::TempFile temp("some previous contents");
+  auto client = ClientForMock();
+  ASSERT_STATUS_OK(
+      ParallelDownloadFile(client, kBucketName, kObjectName, temp.name()));
+  EXPECT_THAT(ReadFile(temp.name()), IsEmpty());
+}
+
+TEST_F(ParallelDownloadTest, ChecksumMismatch) {
+  std::string const contents(1000, 'x');
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillRepeatedly(Return(make_status_or(MockObject(contents, "AAAAAA=="))));
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillRepeatedly([&](ReadObjectRangeRequest const& r) {
+        return make_status_or(MakeReadSource(contents, r));
+      });
+
+  testing::TempFile temp("");
+  auto client = ClientForMock();
+  EXPECT_THAT(ParallelDownloadFile(client, kBucketName, kObjectName,
+                                   temp.name(), MinStreamSize(100)),
+              StatusIs(StatusCode::kDataLoss));
+  EXPECT_STATUS_OK(ParallelDownloadFile(client, kBucketName, kObjectName,
+                                        temp.name(), MinStreamSize(100),
+                                        DisableCrc32cChecksum(true)));
+  EXPECT_EQ(contents, ReadFile(temp.name()));
+}
+
+TEST_F(ParallelDownloadTest, MetadataFailure) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+  EXPECT_CALL(*mock_, ReadObject).Times(0);
+
+  testing::TempFile temp("");
+  auto client = ClientForMock();
+  EXPECT_THAT(
+      ParallelDownloadFile(client, kBucketName, kObjectName, temp.name()),
+      StatusIs(PermanentError().code()));
+}
+
+TEST_F(ParallelDownloadTest, SliceFailure) {
+  std::string const contents(1000, 'x');
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(make_status_or(MockObject(contents, Crc32c(contents)))));
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillRepeatedly([&](ReadObjectRangeRequest const& r)
+                          -> StatusOr<std::unique_ptr<ObjectReadSource>> {
+        if (r.GetOption<ReadRange>().value().begin == 500) {
+          return PermanentError();
+        }
+        return MakeReadSource(contents, r);
+      });
+
+  testing::TempFile temp("");
+  auto client = ClientForMock();
+  auto status = ParallelDownloadFile(client, kBucketName, kObjectName,
+                                     temp.name(), MinStreamSize(250));
+  EXPECT_THAT(status, StatusIs(PermanentError().code(),
+                               HasSubstr("offset=500")));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
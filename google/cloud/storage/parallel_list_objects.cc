@@ -0,0 +1,97 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_list_objects.h"
+#include "google/cloud/storage/internal/prefetching_paged_stream_reader.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ShardReader = PrefetchingPagedStreamReader<ObjectMetadata,
+                                                 ListObjectsRequest,
+                                                 ListObjectsResponse>;
+
+/// Returns the objects from each shard in turn.
+class ParallelListObjectsReader {
+ public:
+  explicit ParallelListObjectsReader(
+      std::vector<std::unique_ptr<ShardReader>> shards)
+      : shards_(std::move(shards)) {}
+
+  google::cloud::internal::StreamReader<ObjectMetadata>::result_type GetNext() {
+    while (current_ != shards_.size()) {
+      auto next = shards_[current_]->GetNext();
+      auto const* status = absl::get_if<Status>(&next);
+      if (status == nullptr || !status->ok()) return next;
+      // Release the resources for completed shards as soon as possible.
+      shards_[current_].reset();
+      ++current_;
+    }
+    return Status{};
+  }
+
+ private:
+  std::vector<std::unique_ptr<ShardReader>> shards_;
+  std::size_t current_ = 0;
+};
+}  // namespace
+
+ListObjectsReader MakeParallelListObjectsReader(
+    std::shared_ptr<RawClient> client, ListObjectsRequest const& request,
+    std::vector<std::string> boundaries) {
+  // An empty string means "unbounded" for both offsets.
+  auto const start = request.GetOption<StartOffset>().value_or("");
+  auto const end = request.GetOption<EndOffset>().value_or("");
+  boundaries.erase(std::remove_if(boundaries.begin(), boundaries.end(),
+                                  [&](std::string const& b) {
+                                    return b.empty() || b <= start ||
+                                           (!end.empty() && b >= end);
+                                  }),
+                   boundaries.end());
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(std::unique(boundaries.begin(), boundaries.end()),
+                   boundaries.end());
+  boundaries.insert(boundaries.begin(), start);
+  boundaries.push_back(end);
+
+  auto const depth = request.GetOption<ListObjectsPrefetchDepth>().value_or(1);
+  auto loader = [client](ListObjectsRequest const& r) {
+    return client->ListObjects(r);
+  };
+  auto extractor = [](ListObjectsResponse r) { return std::move(r.items); };
+  std::vector<std::unique_ptr<ShardReader>> shards;
+  for (std::size_t i = 0; i + 1 != boundaries.size(); ++i) {
+    auto shard = request;
+    if (!boundaries[i].empty()) shard.set_option(StartOffset(boundaries[i]));
+    if (!boundaries[i + 1].empty()) {
+      shard.set_option(EndOffset(boundaries[i + 1]));
+    }
+    shards.push_back(absl::make_unique<ShardReader>(std::move(shard), loader,
+                                                    extractor, depth));
+  }
+  auto reader = std::make_shared<ParallelListObjectsReader>(std::move(shards));
+  return google::cloud::internal::MakeStreamRange<ObjectMetadata>(
+      [reader] { return reader->GetNext(); });
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
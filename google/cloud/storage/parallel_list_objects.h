@@ -0,0 +1,82 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/list_objects_reader.h"
+#include "google/cloud/storage/version.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/// The implementation of `ParallelListObjects()`.
+ListObjectsReader MakeParallelListObjectsReader(
+    std::shared_ptr<RawClient> client, ListObjectsRequest const& request,
+    std::vector<std::string> boundaries);
+}  // namespace internal
+
+/**
+ * Lists the objects in a bucket using several concurrent listings.
+ *
+ * The object names are split into shards at each of the @p boundaries, and
+ * the shards are listed concurrently (using `StartOffset` and `EndOffset`),
+ * each with a background thread. The objects are returned in the same order
+ * as `Client::ListObjects()`, that is, sorted by name.
+ *
+ * The boundaries should split the bucket into shards of similar size, for
+ * example, if the object names start with a hexadecimal hash the boundaries
+ * could be `"1"`, `"2"`, ... `"f"`. Empty and duplicate boundaries are
+ * ignored.
+ *
+ * @param client the client used to list the objects.
+ * @param bucket_name the name of the bucket to list.
+ * @param boundaries the object names where each shard starts.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include the options for
+ *     `Client::ListObjects()`. Any `StartOffset` and `EndOffset` options
+ *     limit the range of names listed by all the shards.
+ *     `ListObjectsPrefetchDepth` limits the number of pages each shard loads
+ *     ahead of the application, by default each shard loads one page ahead.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent.
+ */
+template <typename... Options>
+ListObjectsReader ParallelListObjects(Client client,
+                                      std::string const& bucket_name,
+                                      std::vector<std::string> boundaries,
+                                      Options&&... options) {
+  internal::ListObjectsRequest request(bucket_name);
+  request.set_multiple_options(std::forward<Options>(options)...);
+  return internal::MakeParallelListObjectsReader(
+      internal::ClientImplDetails::GetRawClient(client), request,
+      std::move(boundaries));
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_H
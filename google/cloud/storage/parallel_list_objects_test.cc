@@ -0,0 +1,158 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_list_objects.h"
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <mutex>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ListObjectsRequest;
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+/// Simulates a bucket with a few objects, returning two objects per page.
+class ParallelListObjectsTest : public ::testing::Test {
+ protected:
+  ParallelListObjectsTest() {
+    for (auto const* prefix : {"a", "b", "c", "d"}) {
+      for (int i = 0; i != 5; ++i) {
+        names_.push_back(prefix + std::string("/") + std::to_string(i));
+      }
+    }
+    EXPECT_CALL(*mock_, ListObjects)
+        .WillRepeatedly(
+            [this](ListObjectsRequest const& r) { return List(r); });
+  }
+
+  StatusOr<ListObjectsResponse> List(ListObjectsRequest const& r) {
+    EXPECT_EQ("test-bucket", r.bucket_name());
+    auto const start = r.GetOption<StartOffset>().value_or("");
+    auto const end = r.GetOption<EndOffset>().value_or("");
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      ranges_.emplace(start, end);
+    }
+    std::vector<std::string> matching;
+    std::copy_if(names_.begin(), names_.end(), std::back_inserter(matching),
+                 [&](std::string const& n) {
+                   return n >= start && (end.empty() || n < end);
+                 });
+    std::size_t const offset =
+        r.page_token().empty() ? 0 : std::stoul(r.page_token());
+    ListObjectsResponse response;
+    for (auto i = offset; i < offset + 2 && i < matching.size(); ++i) {
+      response.items.push_back(Object(matching[i]));
+    }
+    if (offset + 2 < matching.size()) {
+      response.next_page_token = std::to_string(offset + 2);
+    }
+    return response;
+  }
+
+  static ObjectMetadata Object(std::string const& name) {
+    return internal::ObjectMetadataParser::FromJson(
+               nlohmann::json{{"bucket", "test-bucket"}, {"name", name}})
+        .value();
+  }
+
+  static std::vector<std::string> Names(ListObjectsReader reader) {
+    std::vector<std::string> names;
+    for (auto& o : reader) {
+      EXPECT_STATUS_OK(o);
+      if (o) names.push_back(o->name());
+    }
+    return names;
+  }
+
+  std::shared_ptr<MockClient> mock_ = std::make_shared<MockClient>();
+  Client client_ = internal::ClientImplDetails::CreateWithoutDecorations(mock_);
+  std::vector<std::string> names_;
+  std::mutex mu_;
+  std::set<std::pair<std::string, std::string>> ranges_;
+};
+
+TEST_F(ParallelListObjectsTest, Basic) {
+  auto actual = Names(ParallelListObjects(client_, "test-bucket",
+                                          {"c", "b/3", "b/3", "", "d"}));
+  EXPECT_THAT(actual, ElementsAreArray(names_));
+  std::lock_guard<std::mutex> lk(mu_);
+  EXPECT_THAT(ranges_, ElementsAre(std::make_pair("", "b/3"),
+                                   std::make_pair("b/3", "c"),
+                                   std::make_pair("c", "d"),
+                                   std::make_pair("d", "")));
+}
+
+TEST_F(ParallelListObjectsTest, NoBoundaries) {
+  auto actual = Names(ParallelListObjects(client_, "test-bucket", {},
+                                          ListObjectsPrefetchDepth(3)));
+  EXPECT_THAT(actual, ElementsAreArray(names_));
+}
+
+TEST_F(ParallelListObjectsTest, WithOffsets) {
+  auto actual = Names(
+      ParallelListObjects(client_, "test-bucket", {"a", "b", "c", "d"},
+                          StartOffset("b/2"), EndOffset("c/3")));
+  EXPECT_THAT(actual, ElementsAre("b/2", "b/3", "b/4", "c/0", "c/1", "c/2"));
+  std::lock_guard<std::mutex> lk(mu_);
+  EXPECT_THAT(ranges_, ElementsAre(std::make_pair("b/2", "c"),
+                                   std::make_pair("c", "c/3")));
+}
+
+TEST_F(ParallelListObjectsTest, PermanentFailure) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillRepeatedly([this](ListObjectsRequest const& r)
+                          -> StatusOr<ListObjectsResponse> {
+        if (r.GetOption<StartOffset>().value_or("") == "c") {
+          return PermanentError();
+        }
+        return List(r);
+      });
+  auto client = internal::ClientImplDetails::CreateWithoutDecorations(mock);
+  std::vector<std::string> actual;
+  Status status;
+  for (auto& o : ParallelListObjects(client, "test-bucket", {"b", "c"})) {
+    if (!o) {
+      status = std::move(o).status();
+      continue;
+    }
+    actual.push_back(o->name());
+  }
+  EXPECT_THAT(status, StatusIs(PermanentError().code()));
+  ASSERT_EQ(10, actual.size());
+  EXPECT_EQ("a/0", actual.front());
+  EXPECT_EQ("b/4", actual.back());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
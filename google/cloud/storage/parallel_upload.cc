@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/internal/hash_function_impl.h"
 #include "absl/memory/memory.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <sstream>
 
 namespace google {
@@ -87,7 +89,8 @@ StatusOr<ObjectWriteStream> ParallelUploadStateImpl::CreateStream(
   auto idx = streams_.size();
   ++num_unfinished_streams_;
   streams_.emplace_back(
-      StreamInfo{request.object_name(), (*session)->session_id(), {}, false});
+      StreamInfo{request.object_name(), (*session)->session_id(), {}, false,
+                 {}, 0});
   assert(idx < streams_.size());
   lk.unlock();
   return ObjectWriteStream(absl::make_unique<ParallelObjectWriteStreambuf>(
@@ -258,6 +261,8 @@ void ParallelUploadStateImpl::AllStreamsFinished(
     lk.lock();
     if (res) {
       deleter_->Enable(true);
+      auto status = ValidateComposedChecksum(*res);
+      if (!status.ok()) res = std::move(status);
     }
     res_ = std::move(res);
   }
@@ -291,6 +296,8 @@ void ParallelUploadStateImpl::StreamFinished(
     deleter_->Add(metadata);
     streams_[stream_idx].composition_arg =
         ComposeSourceObject{metadata.name(), metadata.generation(), {}};
+    streams_[stream_idx].crc32c = metadata.crc32c();
+    streams_[stream_idx].size = metadata.size();
   }
   if (num_unfinished_streams_ > 0) {
     return;
@@ -298,6 +305,24 @@ void ParallelUploadStateImpl::StreamFinished(
   AllStreamsFinished(lk);
 }
 
+Status ParallelUploadStateImpl::ValidateComposedChecksum(
+    ObjectMetadata const& composed) const {
+  // The shard checksums were validated as they were uploaded, combining them
+  // validates the composed object without reading its data again.
+  if (composed.crc32c().empty()) return Status{};
+  Crc32cHashFunction function;
+  for (auto const& stream : streams_) {
+    // Skip the validation if any shard is missing a usable checksum.
+    if (stream.crc32c.empty()) return Status{};
+    if (!function.Concat(stream.crc32c, stream.size).ok()) return Status{};
+  }
+  auto const computed = std::move(function).Finish().crc32c;
+  if (computed == composed.crc32c()) return Status{};
+  return Status(StatusCode::kDataLoss,
+                "ParallelUpload(): mismatched hashes in composed object, "
+                "computed=" + computed + ", received=" + composed.crc32c());
+}
+
 void ParallelUploadStateImpl::StreamDestroyed(std::size_t stream_idx) {
   std::unique_lock<std::mutex> lk(mu_);
   if (!streams_[stream_idx].finished) {
@@ -425,6 +450,126 @@ Status ParallelUploadFileShard::Upload() {
   return ostream_.metadata().status();
 }
 
+StreamingParallelUploadImpl::StreamingParallelUploadImpl(
+    std::shared_ptr<ParallelUploadStateImpl> state, PartFactory factory,
+    std::size_t part_size, std::size_t max_parts_in_flight)
+    : state_(std::move(state)),
+      factory_(std::move(factory)),
+      part_size_(part_size),
+      max_parts_in_flight_(max_parts_in_flight) {
+  // The parts are created lazily, keep the upload from composing the (empty)
+  // set of parts until `Close()` is called.
+  state_->PreventFromFinishing();
+  workers_.reserve(max_parts_in_flight_);
+  for (std::size_t i = 0; i != max_parts_in_flight_; ++i) {
+    workers_.emplace_back([this] { Worker(); });
+  }
+}
+
+StreamingParallelUploadImpl::~StreamingParallelUploadImpl() {
+  if (closed_) return;
+  Status status(StatusCode::kCancelled,
+                "StreamingParallelUpload destroyed before Close()");
+  state_->Fail(status);
+  std::unique_lock<std::mutex> lk(mu_);
+  // The workers suspend any parts that did not start uploading.
+  if (status_.ok()) status_ = std::move(status);
+  Shutdown(lk);
+  state_->AllowFinishing();
+}
+
+Status StreamingParallelUploadImpl::Write(char const* data, std::size_t size) {
+  if (closed_) {
+    return Status(StatusCode::kFailedPrecondition,
+                  "StreamingParallelUpload::Write() called after Close()");
+  }
+  while (size > 0) {
+    auto const n = (std::min)(size, part_size_ - current_.size());
+    current_.append(data, n);
+    data += n;
+    size -= n;
+    if (current_.size() < part_size_) break;
+    auto status = FlushPart();
+    if (!status.ok()) return status;
+  }
+  return Status();
+}
+
+StatusOr<ObjectMetadata> StreamingParallelUploadImpl::Close() {
+  if (closed_) {
+    return Status(StatusCode::kFailedPrecondition,
+                  "StreamingParallelUpload::Close() called twice");
+  }
+  closed_ = true;
+  Status status;
+  // An empty stream still needs one (empty) part to create the destination.
+  if (!current_.empty() || next_part_ == 0) status = FlushPart();
+
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return in_flight_ == 0; });
+  if (status.ok()) status = status_;
+  Shutdown(lk);
+  if (!status.ok()) state_->Fail(std::move(status));
+  state_->AllowFinishing();
+  return state_->WaitForCompletion().get();
+}
+
+Status StreamingParallelUploadImpl::FlushPart() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return in_flight_ < max_parts_in_flight_ || !status_.ok();
+  });
+  if (!status_.ok()) return status_;
+  lk.unlock();
+
+  auto stream = factory_(next_part_++);
+  lk.lock();
+  if (!stream) {
+    if (status_.ok()) status_ = stream.status();
+    return std::move(stream).status();
+  }
+  pending_.push_back(Part{*std::move(stream), std::move(current_)});
+  current_.clear();
+  ++in_flight_;
+  lk.unlock();
+  cv_.notify_all();
+  return Status();
+}
+
+void StreamingParallelUploadImpl::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) return;
+    auto part = std::move(pending_.front());
+    pending_.pop_front();
+    bool const skip = !status_.ok();
+    lk.unlock();
+    Status status;
+    if (skip) {
+      // There is no point in uploading more parts once the upload has failed.
+      std::move(part.stream).Suspend();
+    } else {
+      part.stream.write(part.data.data(),
+                        static_cast<std::streamsize>(part.data.size()));
+      part.stream.Close();
+      status = part.stream.metadata().status();
+    }
+    lk.lock();
+    if (!status.ok() && status_.ok()) status_ = std::move(status);
+    --in_flight_;
+    cv_.notify_all();
+  }
+}
+
+void StreamingParallelUploadImpl::Shutdown(std::unique_lock<std::mutex>& lk) {
+  shutdown_ = true;
+  lk.unlock();
+  cv_.notify_all();
+  for (auto& t : workers_) t.join();
+  workers_.clear();
+}
+
 StatusOr<std::pair<std::string, std::int64_t>> ParseResumableSessionId(
     std::string const& session_id) {
   auto starts_with = [](std::string const& s, std::string const& prefix) {
@@ -26,10 +26,13 @@
 #include "absl/types/optional.h"
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <fstream>
 #include <functional>
+#include <istream>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -69,10 +72,29 @@ class MinStreamSize {
   std::uintmax_t value_;
 };
 
+/**
+ * A parameter type indicating the size of each part in
+ * `ParallelUploadStream()` and `PrepareStreamingParallelUpload()`.
+ *
+ * The data is uploaded in parts of this size, except for the last part, which
+ * may be smaller. Up to `MaxStreams` parts are uploaded concurrently, and the
+ * upload buffers at most `MaxStreams + 1` parts in memory.
+ */
+class ParallelUploadPartSize {
+ public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ParallelUploadPartSize(std::size_t value) : value_(value) {}
+  std::size_t value() const { return value_; }
+
+ private:
+  std::size_t value_;
+};
+
 namespace internal {
 
 class ParallelUploadFileShard;
 struct CreateParallelUploadShards;
+struct CreateStreamingParallelUpload;
 
 /**
  * Return an empty option if Tuple contains an element of type T, otherwise
@@ -214,8 +236,14 @@ class ParallelUploadStateImpl
     std::string resumable_session_id;
     absl::optional<ComposeSourceObject> composition_arg;
     bool finished;
+    // The checksum and size of the uploaded shard, used to validate the
+    // checksum of the composed object.
+    std::string crc32c;
+    std::uint64_t size;
   };
 
+  Status ValidateComposedChecksum(ObjectMetadata const& composed) const;
+
   mutable std::mutex mu_;
   // Promises made via `WaitForCompletion()`
   mutable std::vector<promise<StatusOr<ObjectMetadata>>> res_promises_;
@@ -451,6 +479,7 @@ class NonResumableParallelUploadState {
   std::vector<ObjectWriteStream> shards_;
 
   friend struct CreateParallelUploadShards;
+  friend struct CreateStreamingParallelUpload;
 };
 
 /**
@@ -1113,6 +1142,121 @@ struct CreateParallelUploadShards {
   }
 };
 
+/**
+ * Uploads a stream of unknown length as a series of parts.
+ *
+ * The data written via `Write()` is cut into parts of a fixed size. Each part
+ * is uploaded as a temporary object by a pool of background threads, and the
+ * parts are composed into the destination object by `Close()`. The writer
+ * blocks when too many parts are waiting to be uploaded, this bounds the
+ * memory used by the upload.
+ *
+ * The member functions are not thread-safe, all the writes must happen on the
+ * same thread (or be serialized by the caller).
+ */
+class StreamingParallelUploadImpl {
+ public:
+  /// Creates the temporary object for the part with the given index.
+  using PartFactory = std::function<StatusOr<ObjectWriteStream>(std::size_t)>;
+
+  StreamingParallelUploadImpl(std::shared_ptr<ParallelUploadStateImpl> state,
+                              PartFactory factory, std::size_t part_size,
+                              std::size_t max_parts_in_flight);
+  ~StreamingParallelUploadImpl();
+
+  StreamingParallelUploadImpl(StreamingParallelUploadImpl const&) = delete;
+  StreamingParallelUploadImpl& operator=(StreamingParallelUploadImpl const&) =
+      delete;
+
+  Status Write(char const* data, std::size_t size);
+  StatusOr<ObjectMetadata> Close();
+  Status EagerCleanup() { return state_->EagerCleanup(); }
+
+ private:
+  struct Part {
+    ObjectWriteStream stream;
+    std::string data;
+  };
+
+  Status FlushPart();
+  void Worker();
+  void Shutdown(std::unique_lock<std::mutex>& lk);
+
+  std::shared_ptr<ParallelUploadStateImpl> state_;
+  PartFactory factory_;
+  std::size_t const part_size_;
+  std::size_t const max_parts_in_flight_;
+  std::string current_;
+  std::size_t next_part_ = 0;
+  bool closed_ = false;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Part> pending_;   // GUARDED_BY(mu_)
+  std::size_t in_flight_ = 0;  // GUARDED_BY(mu_)
+  Status status_;              // GUARDED_BY(mu_)
+  bool shutdown_ = false;      // GUARDED_BY(mu_)
+  std::vector<std::thread> workers_;
+};
+
+struct CreateStreamingParallelUpload {
+  /// The default part size for streaming parallel uploads.
+  static std::size_t constexpr kDefaultPartSize = 32 * 1024 * 1024;
+  /// The default number of parts uploaded concurrently.
+  static std::size_t constexpr kDefaultMaxStreams = 4;
+
+  template <typename... Options>
+  static StatusOr<std::unique_ptr<StreamingParallelUploadImpl>> Create(
+      Client client, std::string const& bucket_name,
+      std::string const& object_name, std::string const& prefix,
+      Options&&... options) {
+    static_assert(
+        NotAmong<typename std::decay<Options>::type...>::template TPred<
+            UseResumableUploadSession>::value,
+        "Streaming parallel uploads cannot be resumed");
+    // The upload outlives this function, keep copies of the options.
+    auto all_options = std::make_tuple(options...);
+    auto const max_streams =
+        ExtractFirstOccurrenceOfType<MaxStreams>(all_options)
+            .value_or(MaxStreams(kDefaultMaxStreams))
+            .value();
+    auto const part_size =
+        ExtractFirstOccurrenceOfType<ParallelUploadPartSize>(all_options)
+            .value_or(ParallelUploadPartSize(kDefaultPartSize))
+            .value();
+    if (max_streams == 0 || part_size == 0) {
+      return Status(StatusCode::kInvalidArgument,
+                    "MaxStreams and ParallelUploadPartSize must be positive");
+    }
+    auto forwarded_options =
+        StaticTupleFilter<NotAmong<MaxStreams, ParallelUploadPartSize>::TPred>(
+            std::move(all_options));
+    auto upload_options = StaticTupleFilter<
+        Among<ContentEncoding, ContentType, DisableCrc32cChecksum,
+              DisableMD5Hash, EncryptionKey, KmsKeyName, PredefinedAcl,
+              UserProject, WithObjectMetadata>::TPred>(forwarded_options);
+
+    // The parts are created as the data arrives, start without any streams.
+    auto state = NonResumableParallelUploadState::Create(
+        client, bucket_name, object_name, 0, prefix,
+        std::move(forwarded_options));
+    if (!state) return std::move(state).status();
+
+    auto impl = state->impl_;
+    auto raw_client = ClientImplDetails::GetRawClient(client);
+    auto factory = [raw_client, impl, bucket_name, prefix,
+                    upload_options](std::size_t part) {
+      ResumableUploadRequest request(
+          bucket_name, prefix + ".upload_shard_" + std::to_string(part));
+      google::cloud::internal::apply(SetOptionsApplyHelper(request),
+                                     upload_options);
+      return impl->CreateStream(*raw_client, request);
+    };
+    return absl::make_unique<StreamingParallelUploadImpl>(
+        std::move(impl), std::move(factory), part_size, max_streams);
+  }
+};
+
 /// @copydoc CreateParallelUploadShards::Create()
 template <typename... Options>
 StatusOr<std::vector<ParallelUploadFileShard>> CreateUploadShards(
@@ -1188,6 +1332,143 @@ StatusOr<ObjectMetadata> ParallelUploadFile(
   return res;
 }
 
+/**
+ * A parallel upload of data whose length is not known in advance.
+ *
+ * Objects of this type are created by `PrepareStreamingParallelUpload()`. The
+ * data written via `Write()` is cut into parts of `ParallelUploadPartSize`
+ * bytes, which are uploaded as temporary objects by up to `MaxStreams`
+ * background threads. `Close()` composes the temporary objects into the
+ * destination object.
+ *
+ * `Write()` blocks when `MaxStreams` parts are already waiting or being
+ * uploaded, which bounds the memory used by the upload. Destroying this object
+ * before calling `Close()` cancels the upload.
+ *
+ * This class is not thread-safe, the application must serialize all calls.
+ */
+class StreamingParallelUpload {
+ public:
+  StreamingParallelUpload(StreamingParallelUpload&&) = default;
+  StreamingParallelUpload& operator=(StreamingParallelUpload&&) = default;
+
+  /**
+   * Append @p size bytes to the upload.
+   *
+   * @return an error if this or a previous part failed to upload.
+   */
+  Status Write(char const* data, std::size_t size) {
+    return impl_->Write(data, size);
+  }
+
+  /// Upload any buffered data, wait for all parts, and compose them.
+  StatusOr<ObjectMetadata> Close() { return impl_->Close(); }
+
+  /**
+   * Cleanup all the temporary objects.
+   *
+   * As with `NonResumableParallelUploadState::EagerCleanup()`, the cleanup
+   * happens on destruction if this function is not called.
+   */
+  Status EagerCleanup() { return impl_->EagerCleanup(); }
+
+ private:
+  explicit StreamingParallelUpload(
+      std::unique_ptr<internal::StreamingParallelUploadImpl> impl)
+      : impl_(std::move(impl)) {}
+
+  template <typename... Options>
+  friend StatusOr<StreamingParallelUpload> PrepareStreamingParallelUpload(
+      Client client, std::string const& bucket_name,
+      std::string const& object_name, std::string const& prefix,
+      Options&&... options);
+
+  std::unique_ptr<internal::StreamingParallelUploadImpl> impl_;
+};
+
+/**
+ * Prepare a parallel upload of data whose length is not known in advance.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that will contain the object.
+ * @param object_name the uploaded object name.
+ * @param prefix the prefix with which temporary objects will be created.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `DestinationPredefinedAcl`,
+ *     `EncryptionKey`, `IfGenerationMatch`, `IfMetagenerationMatch`,
+ *     `KmsKeyName`, `MaxStreams`, `ParallelUploadPartSize`, `QuotaUser`,
+ *     `UserIp`, `UserProject`, `WithObjectMetadata`. The upload cannot be
+ *     resumed, `UseResumableUploadSession` is not supported.
+ *
+ * @return an object to write the data to, or the error preventing the upload.
+ */
+template <typename... Options>
+StatusOr<StreamingParallelUpload> PrepareStreamingParallelUpload(
+    Client client, std::string const& bucket_name,
+    std::string const& object_name, std::string const& prefix,
+    Options&&... options) {
+  auto impl = internal::CreateStreamingParallelUpload::Create(
+      std::move(client), bucket_name, object_name, prefix,
+      std::forward<Options>(options)...);
+  if (!impl) return std::move(impl).status();
+  return StreamingParallelUpload(*std::move(impl));
+}
+
+/**
+ * Perform a parallel upload of a stream whose length is not known in advance.
+ *
+ * The stream is read sequentially and uploaded in parts of
+ * `ParallelUploadPartSize` bytes, with up to `MaxStreams` parts uploaded
+ * concurrently.
+ *
+ * @param client the client on which to perform the operation.
+ * @param source the stream to upload, it is read until EOF.
+ * @param bucket_name the name of the bucket that will contain the object.
+ * @param object_name the uploaded object name.
+ * @param prefix the prefix with which temporary objects will be created.
+ * @param ignore_cleanup_failures treat failures to cleanup the temporary
+ *     objects as not fatal.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation are the same as in
+ *     `PrepareStreamingParallelUpload()`.
+ *
+ * @return the metadata of the object created by the upload.
+ *
+ * @par Idempotency
+ * This operation is not idempotent. While each request performed by this
+ * function is retried based on the client policies, the operation itself stops
+ * on the first request that fails.
+ */
+template <typename... Options>
+StatusOr<ObjectMetadata> ParallelUploadStream(
+    Client client, std::istream& source, std::string const& bucket_name,
+    std::string const& object_name, std::string const& prefix,
+    bool ignore_cleanup_failures, Options&&... options) {
+  auto upload = PrepareStreamingParallelUpload(
+      std::move(client), bucket_name, object_name, prefix,
+      std::forward<Options>(options)...);
+  if (!upload) return std::move(upload).status();
+
+  std::vector<char> buffer(64 * 1024);
+  for (;;) {
+    source.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (source.bad()) {
+      return Status(StatusCode::kInternal,
+                    "ParallelUploadStream(): cannot read from source stream");
+    }
+    auto status =
+        upload->Write(buffer.data(), static_cast<std::size_t>(source.gcount()));
+    if (!status.ok()) return status;
+    if (!source) break;
+  }
+  auto res = upload->Close();
+  auto cleanup_res = upload->EagerCleanup();
+  if (!cleanup_res.ok() && !ignore_cleanup_failures) {
+    return cleanup_res;
+  }
+  return res;
+}
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/bucket_metadata_parser.h"
+#include "google/cloud/storage/internal/hash_function_impl.h"
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/storage/parallel_upload.h"
@@ -26,6 +27,7 @@
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <cstdio>
+#include <sstream>
 #include <stack>
 #ifdef __linux__
 #include <sys/stat.h>
@@ -67,12 +69,13 @@ std::string ObjectId(std::string const& bucket, std::string const& object,
   return bucket + "/" + object + "/" + std::to_string(generation);
 }
 
-ObjectMetadata MockObject(std::string const& object_name, int generation) {
+ObjectMetadata MockObject(std::string const& object_name, int generation,
+                          std::string const& crc32c, std::uint64_t size) {
   auto metadata = internal::ObjectMetadataParser::FromJson(nlohmann::json{
       {"contentDisposition", "a-disposition"},
       {"contentLanguage", "a-language"},
       {"contentType", "application/octet-stream"},
-      {"crc32c", "d1e2f3"},
+      {"crc32c", crc32c},
       {"etag", "XYZ="},
       {"kind", "storage#object"},
       {"md5Hash", "xa1b2c3=="},
@@ -82,7 +85,7 @@ ObjectMetadata MockObject(std::string const& object_name, int generation) {
       {"metageneration", 4},
       {"selfLink", "https://storage.googleapis.com/storage/v1/b/" +
                        kBucketName + "/o/" + object_name},
-      {"size", 1024},
+      {"size", size},
       {"storageClass", "STANDARD"},
       {"timeCreated", "2018-05-19T19:31:14Z"},
       {"timeDeleted", "2018-05-19T19:32:24Z"},
@@ -96,6 +99,16 @@ ObjectMetadata MockObject(std::string const& object_name, int generation) {
   return *metadata;
 }
 
+ObjectMetadata MockObject(std::string const& object_name, int generation) {
+  return MockObject(object_name, generation, "d1e2f3", 1024);
+}
+
+std::string Crc32c(std::string const& contents) {
+  Crc32cHashFunction function;
+  function.Update(contents.data(), contents.size());
+  return std::move(function).Finish().crc32c;
+}
+
 class ExpectedDeletions {
  public:
   explicit ExpectedDeletions(
@@ -223,6 +236,23 @@ class ParallelUploadTest
     return res;
   }
 
+  void ExpectCreateSessionWithMetadata(std::string const& object_name,
+                                       ObjectMetadata const& metadata) {
+    auto session = absl::make_unique<testing::MockResumableUploadSession>();
+    auto& res = *session;
+    session_mocks_.emplace(std::move(session));
+    using internal::ResumableUploadResponse;
+
+    EXPECT_CALL(res, done()).WillRepeatedly(Return(false));
+    static std::string session_id(kIndividualSessionId);
+    EXPECT_CALL(res, session_id()).WillRepeatedly(ReturnRef(session_id));
+    EXPECT_CALL(res, next_expected_byte()).WillRepeatedly(Return(0));
+    EXPECT_CALL(res, UploadFinalChunk)
+        .WillOnce(Return(make_status_or(ResumableUploadResponse{
+            "fake-url", 0, metadata, ResumableUploadResponse::kDone, {}})));
+    AddNewExpectation(object_name);
+  }
+
   testing::MockResumableUploadSession& ExpectCreateSessionToSuspend(
       std::string const& object_name,
       absl::optional<std::string> const& resumable_session_id =
@@ -416,6 +446,69 @@ TEST_F(ParallelUploadTest, Success) {
   EXPECT_STATUS_OK(state->EagerCleanup());
 }
 
+TEST_F(ParallelUploadTest, ValidatesComposedChecksum) {
+  std::vector<std::string> const contents{"The quick", " brown fox",
+                                          " jumps over the lazy dog"};
+  auto constexpr kQuickFoxCrc32c = "ImIEBA==";
+  auto constexpr kInvalidCrc32c = "AAAAAA==";
+
+  for (auto const* composed_crc32c : {kQuickFoxCrc32c, kInvalidCrc32c}) {
+    SCOPED_TRACE(std::string("Testing with ") + composed_crc32c);
+    // The expectations need to be reversed.
+    for (int i = 2; i >= 0; --i) {
+      auto const name = kPrefix + ".upload_shard_" + std::to_string(i);
+      ExpectCreateSessionWithMetadata(
+          name, MockObject(name, 111 * (i + 1), Crc32c(contents[i]),
+                           contents[i].size()));
+    }
+    EXPECT_CALL(*mock_, InsertObjectMedia)
+        .WillOnce(expect_new_object(kPrefix, kUploadMarkerGeneration))
+        .WillOnce(expect_new_object(kPrefix + ".compose_many",
+                                    kComposeMarkerGeneration));
+    EXPECT_CALL(*mock_, ComposeObject)
+        .WillOnce(create_composition_check(
+            {{kPrefix + ".upload_shard_0", 111},
+             {kPrefix + ".upload_shard_1", 222},
+             {kPrefix + ".upload_shard_2", 333}},
+            kDestObjectName,
+            MockObject(kDestObjectName, kDestGeneration, composed_crc32c,
+                       43)));
+    // The temporary objects are removed even if the checksums mismatch.
+    ExpectedDeletions deletions(
+        {{{kPrefix + ".upload_shard_0", 111}, Status()},
+         {{kPrefix + ".upload_shard_1", 222}, Status()},
+         {{kPrefix + ".upload_shard_2", 333}, Status()}});
+    EXPECT_CALL(*mock_, DeleteObject)
+        .WillOnce(expect_deletion(kPrefix + ".compose_many",
+                                  kComposeMarkerGeneration))
+        .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+          return deletions(r);
+        })
+        .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+          return deletions(r);
+        })
+        .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+          return deletions(r);
+        })
+        .WillOnce(expect_deletion(kPrefix, kUploadMarkerGeneration));
+
+    auto client = ClientForMock();
+    auto state = PrepareParallelUpload(client, kBucketName, kDestObjectName,
+                                       3, kPrefix);
+    ASSERT_STATUS_OK(state);
+    auto res_future = state->WaitForCompletion();
+    state->shards().clear();
+    auto res = res_future.get();
+    if (composed_crc32c == kQuickFoxCrc32c) {
+      EXPECT_STATUS_OK(res);
+    } else {
+      EXPECT_THAT(res, StatusIs(StatusCode::kDataLoss,
+                                HasSubstr("mismatched hashes")));
+    }
+    EXPECT_STATUS_OK(state->EagerCleanup());
+  }
+}
+
 TEST_F(ParallelUploadTest, OneStreamFailsUponCration) {
   int const num_shards = 3;
   // The expectations need to be reversed.
@@ -995,6 +1088,166 @@ TEST_F(ParallelUploadTest, CleanupFailureIsNotIgnored) {
   ASSERT_FALSE(object_metadata);
 }
 
+TEST_F(ParallelUploadTest, StreamingSuccess) {
+  // The expectations need to be reversed.
+  ExpectCreateSession(kPrefix + ".upload_shard_2", 333, "g");
+  ExpectCreateSession(kPrefix + ".upload_shard_1", 222, "def");
+  ExpectCreateSession(kPrefix + ".upload_shard_0", 111, "abc");
+
+  EXPECT_CALL(*mock_, InsertObjectMedia)
+      .WillOnce(expect_new_object(kPrefix, kUploadMarkerGeneration))
+      .WillOnce(expect_new_object(kPrefix + ".compose_many",
+                                  kComposeMarkerGeneration));
+  EXPECT_CALL(*mock_, ComposeObject)
+      .WillOnce(create_composition_check(
+          {{kPrefix + ".upload_shard_0", 111},
+           {kPrefix + ".upload_shard_1", 222},
+           {kPrefix + ".upload_shard_2", 333}},
+          kDestObjectName, MockObject(kDestObjectName, kDestGeneration)));
+
+  ExpectedDeletions deletions({{{kPrefix + ".upload_shard_0", 111}, Status()},
+                               {{kPrefix + ".upload_shard_1", 222}, Status()},
+                               {{kPrefix + ".upload_shard_2", 333}, Status()}});
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce(
+          expect_deletion(kPrefix + ".compose_many", kComposeMarkerGeneration))
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce(expect_deletion(kPrefix, kUploadMarkerGeneration));
+
+  auto client = ClientForMock();
+  auto upload = PrepareStreamingParallelUpload(
+      client, kBucketName, kDestObjectName, kPrefix, MaxStreams(2),
+      ParallelUploadPartSize(3));
+  ASSERT_STATUS_OK(upload);
+  // The part boundaries do not need to match the writes.
+  EXPECT_STATUS_OK(upload->Write("ab", 2));
+  EXPECT_STATUS_OK(upload->Write("cdefg", 5));
+  auto res = upload->Close();
+  ASSERT_STATUS_OK(res);
+  EXPECT_EQ(kDestObjectName, res->name());
+  EXPECT_THAT(upload->Write("h", 1),
+              StatusIs(StatusCode::kFailedPrecondition));
+  EXPECT_STATUS_OK(upload->EagerCleanup());
+}
+
+TEST_F(ParallelUploadTest, StreamingEmpty) {
+  ExpectCreateSession(kPrefix + ".upload_shard_0", 111);
+
+  EXPECT_CALL(*mock_, InsertObjectMedia)
+      .WillOnce(expect_new_object(kPrefix, kUploadMarkerGeneration))
+      .WillOnce(expect_new_object(kPrefix + ".compose_many",
+                                  kComposeMarkerGeneration));
+  EXPECT_CALL(*mock_, ComposeObject)
+      .WillOnce(create_composition_check(
+          {{kPrefix + ".upload_shard_0", 111}}, kDestObjectName,
+          MockObject(kDestObjectName, kDestGeneration)));
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce(
+          expect_deletion(kPrefix + ".compose_many", kComposeMarkerGeneration))
+      .WillOnce(expect_deletion(kPrefix + ".upload_shard_0", 111))
+      .WillOnce(expect_deletion(kPrefix, kUploadMarkerGeneration));
+
+  auto client = ClientForMock();
+  std::istringstream source;
+  auto res = ParallelUploadStream(client, source, kBucketName,
+                                  kDestObjectName, kPrefix, false);
+  ASSERT_STATUS_OK(res);
+  EXPECT_EQ(kDestObjectName, res->name());
+}
+
+TEST_F(ParallelUploadTest, StreamingFromIstream) {
+  // The expectations need to be reversed.
+  ExpectCreateSession(kPrefix + ".upload_shard_1", 222, "de");
+  ExpectCreateSession(kPrefix + ".upload_shard_0", 111, "abc");
+
+  EXPECT_CALL(*mock_, InsertObjectMedia)
+      .WillOnce(expect_new_object(kPrefix, kUploadMarkerGeneration))
+      .WillOnce(expect_new_object(kPrefix + ".compose_many",
+                                  kComposeMarkerGeneration));
+  EXPECT_CALL(*mock_, ComposeObject)
+      .WillOnce(create_composition_check(
+          {{kPrefix + ".upload_shard_0", 111},
+           {kPrefix + ".upload_shard_1", 222}},
+          kDestObjectName, MockObject(kDestObjectName, kDestGeneration)));
+
+  ExpectedDeletions deletions({{{kPrefix + ".upload_shard_0", 111}, Status()},
+                               {{kPrefix + ".upload_shard_1", 222}, Status()}});
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce(
+          expect_deletion(kPrefix + ".compose_many", kComposeMarkerGeneration))
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce(expect_deletion(kPrefix, kUploadMarkerGeneration));
+
+  auto client = ClientForMock();
+  std::istringstream source("abcde");
+  auto res =
+      ParallelUploadStream(client, source, kBucketName, kDestObjectName,
+                           kPrefix, false, ParallelUploadPartSize(3));
+  ASSERT_STATUS_OK(res);
+  EXPECT_EQ(kDestObjectName, res->name());
+}
+
+TEST_F(ParallelUploadTest, StreamingBrokenPart) {
+  // The expectations need to be reversed.
+  ExpectCreateFailingSession(kPrefix + ".upload_shard_1", PermanentError());
+  ExpectCreateSession(kPrefix + ".upload_shard_0", 111, "a");
+
+  EXPECT_CALL(*mock_, InsertObjectMedia)
+      .WillOnce(expect_new_object(kPrefix, kUploadMarkerGeneration));
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce(expect_deletion(kPrefix + ".upload_shard_0", 111))
+      .WillOnce(expect_deletion(kPrefix, kUploadMarkerGeneration));
+
+  auto client = ClientForMock();
+  auto upload = PrepareStreamingParallelUpload(
+      client, kBucketName, kDestObjectName, kPrefix, MaxStreams(1),
+      ParallelUploadPartSize(1));
+  ASSERT_STATUS_OK(upload);
+  // With a single part in flight the third part waits for the second one to
+  // fail, and is never created.
+  EXPECT_THAT(upload->Write("abc", 3), StatusIs(PermanentError().code()));
+  EXPECT_THAT(upload->Close(), StatusIs(PermanentError().code()));
+}
+
+TEST_F(ParallelUploadTest, StreamingDestroyedBeforeClose) {
+  EXPECT_CALL(*mock_, InsertObjectMedia)
+      .WillOnce(expect_new_object(kPrefix, kUploadMarkerGeneration));
+  EXPECT_CALL(*mock_, ComposeObject).Times(0);
+  EXPECT_CALL(*mock_, DeleteObject)
+      .WillOnce(expect_deletion(kPrefix, kUploadMarkerGeneration));
+
+  auto client = ClientForMock();
+  auto upload = PrepareStreamingParallelUpload(
+      client, kBucketName, kDestObjectName, kPrefix, ParallelUploadPartSize(4));
+  ASSERT_STATUS_OK(upload);
+  EXPECT_STATUS_OK(upload->Write("ab", 2));
+}
+
+TEST_F(ParallelUploadTest, StreamingInvalidOptions) {
+  auto client = ClientForMock();
+  EXPECT_THAT(PrepareStreamingParallelUpload(client, kBucketName,
+                                             kDestObjectName, kPrefix,
+                                             MaxStreams(0)),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(PrepareStreamingParallelUpload(client, kBucketName,
+                                             kDestObjectName, kPrefix,
+                                             ParallelUploadPartSize(0)),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
 TEST(ParallelUploadPersistentState, NotJson) {
   auto res = ParallelUploadPersistentState::FromString("blah");
   EXPECT_THAT(res,
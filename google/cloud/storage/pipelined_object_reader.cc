@@ -0,0 +1,64 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/pipelined_object_reader.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::size_t DefaultPipelinedReadDepth() { return 8; }
+
+std::int64_t DefaultPipelinedReadMaxBytes() { return 256 * 1024 * 1024L; }
+
+PipelinedObjectReaderImpl::InputFunction MakePipelinedReadInput(
+    std::vector<ObjectReference> objects) {
+  struct State {
+    std::vector<ObjectReference> objects;
+    std::size_t index;
+  };
+  auto state = std::make_shared<State>(State{std::move(objects), 0});
+  return [state]() -> absl::optional<StatusOr<ObjectReference>> {
+    if (state->index == state->objects.size()) return absl::nullopt;
+    return make_status_or(std::move(state->objects[state->index++]));
+  };
+}
+
+PipelinedObjectReaderImpl::InputFunction MakePipelinedReadInput(
+    ListObjectsReader objects) {
+  struct State {
+    explicit State(ListObjectsReader r)
+        : reader(std::move(r)), current(reader.begin()) {}
+    ListObjectsReader reader;
+    ListObjectsReader::iterator current;
+  };
+  auto state = std::make_shared<State>(std::move(objects));
+  return [state]() -> absl::optional<StatusOr<ObjectReference>> {
+    if (state->current == state->reader.end()) return absl::nullopt;
+    auto metadata = *state->current;
+    ++state->current;
+    if (!metadata) return StatusOr<ObjectReference>(metadata.status());
+    return make_status_or(ObjectReference{
+        metadata->bucket(), metadata->name(), metadata->generation()});
+  };
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,210 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PIPELINED_OBJECT_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PIPELINED_OBJECT_READER_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/pipelined_object_reader_impl.h"
+#include "google/cloud/storage/internal/tuple_filter.h"
+#include "google/cloud/storage/list_objects_reader.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/internal/tuple.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/**
+ * A parameter type indicating the number of concurrent downloads in
+ * `ReadObjectsPipelined()`.
+ */
+class PipelinedReadDepth {
+ public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  PipelinedReadDepth(std::size_t value) : value_(value) {}
+  std::size_t value() const { return value_; }
+
+ private:
+  std::size_t value_;
+};
+
+/**
+ * A parameter type indicating how many bytes `ReadObjectsPipelined()` buffers
+ * before the application reads them.
+ */
+class PipelinedReadMaxBytes {
+ public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  PipelinedReadMaxBytes(std::int64_t value) : value_(value) {}
+  std::int64_t value() const { return value_; }
+
+ private:
+  std::int64_t value_;
+};
+
+/**
+ * Reads a sequence of objects, downloading several of them ahead of the
+ * application.
+ *
+ * Use `ReadObjectsPipelined()` to create these objects. Deleting the reader
+ * stops any downloads in progress, and discards the buffered data.
+ */
+class PipelinedObjectReader {
+ public:
+  explicit PipelinedObjectReader(
+      std::unique_ptr<internal::PipelinedObjectReaderImpl> impl)
+      : impl_(std::move(impl)) {}
+
+  /**
+   * Returns the next object, in the same order as the input.
+   *
+   * Blocks until the object is fully downloaded. The `stream` in the result
+   * reports any download errors, including checksum mismatches, through its
+   * `status()`. Errors listing the objects are returned as an error, and
+   * terminate the sequence. Returns an empty optional after the last object.
+   */
+  absl::optional<StatusOr<PipelinedObject>> Next() { return impl_->Next(); }
+
+ private:
+  std::unique_ptr<internal::PipelinedObjectReaderImpl> impl_;
+};
+
+namespace internal {
+
+/// The default value for `PipelinedReadDepth`.
+std::size_t DefaultPipelinedReadDepth();
+
+/// The default value for `PipelinedReadMaxBytes`.
+std::int64_t DefaultPipelinedReadMaxBytes();
+
+PipelinedObjectReaderImpl::InputFunction MakePipelinedReadInput(
+    std::vector<ObjectReference> objects);
+PipelinedObjectReaderImpl::InputFunction MakePipelinedReadInput(
+    ListObjectsReader objects);
+
+template <typename... Options>
+PipelinedObjectReader MakePipelinedObjectReader(
+    Client client, PipelinedObjectReaderImpl::InputFunction input,
+    Options&&... options) {
+  auto all_options = std::make_tuple(options...);
+  auto depth = ExtractFirstOccurrenceOfType<PipelinedReadDepth>(all_options);
+  auto max_bytes =
+      ExtractFirstOccurrenceOfType<PipelinedReadMaxBytes>(all_options);
+  auto read_options = StaticTupleFilter<
+      NotAmong<PipelinedReadDepth, PipelinedReadMaxBytes>::TPred>(all_options);
+  PipelinedReaderConfig config{
+      depth ? depth->value() : DefaultPipelinedReadDepth(),
+      max_bytes ? max_bytes->value() : DefaultPipelinedReadMaxBytes(),
+      ClientImplDetails::GetRawClient(client)
+          ->client_options()
+          .download_buffer_size()};
+  auto open = [client, read_options](ObjectReference const& o) mutable {
+    auto generation =
+        o.generation == 0 ? Generation() : Generation(o.generation);
+    return google::cloud::internal::apply(
+        ReadObjectApplyHelper{client, o.bucket, o.name},
+        std::tuple_cat(read_options, std::make_tuple(std::move(generation))));
+  };
+  return PipelinedObjectReader(absl::make_unique<PipelinedObjectReaderImpl>(
+      std::move(input), std::move(open), config));
+}
+
+}  // namespace internal
+
+/**
+ * Reads a sequence of objects, keeping several downloads in flight.
+ *
+ * Applications that read many small or medium objects, one after the other,
+ * spend most of their time waiting for each download to start. This function
+ * downloads up to `PipelinedReadDepth` objects concurrently, in background
+ * threads, into memory. The application receives the objects, in the original
+ * order, as soon as each download completes.
+ *
+ * The data downloaded but not yet returned by `PipelinedObjectReader::Next()`
+ * is bounded by `PipelinedReadMaxBytes`. The download of the next object is
+ * never blocked, so the buffered data may exceed this bound by the size of
+ * that object. The streams use the client's connection pool, consider
+ * increasing `ConnectionPoolSizeOption` to match `PipelinedReadDepth`.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * auto reader = gcs::ReadObjectsPipelined(
+ *     client, client.ListObjects("my-bucket", gcs::Prefix("shards/")),
+ *     gcs::PipelinedReadDepth(16));
+ * std::vector<char> buffer(1024 * 1024);
+ * for (auto o = reader.Next(); o.has_value(); o = reader.Next()) {
+ *   if (!*o) throw std::runtime_error(o->status().message());
+ *   auto& stream = (*o)->stream;
+ *   while (stream.read(buffer.data(), buffer.size()), stream.gcount() != 0) {
+ *     // ... use the first `stream.gcount()` bytes in `buffer` ...
+ *   }
+ *   if (!stream.status().ok()) throw std::runtime_error("...");
+ * }
+ * @endcode
+ *
+ * @param client the client on which to perform the operations.
+ * @param objects the objects to read, in order.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `PipelinedReadDepth`,
+ *     `PipelinedReadMaxBytes`, and the options for `Client::ReadObject()`,
+ *     other than `Generation`, `ReadFromOffset`, `ReadRange`, and `ReadLast`.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent. Each download is
+ * retried using the client's policies.
+ */
+template <typename... Options>
+PipelinedObjectReader ReadObjectsPipelined(Client client,
+                                           std::vector<ObjectReference> objects,
+                                           Options&&... options) {
+  return internal::MakePipelinedObjectReader(
+      std::move(client), internal::MakePipelinedReadInput(std::move(objects)),
+      std::forward<Options>(options)...);
+}
+
+/**
+ * Reads the objects returned by a listing, keeping several downloads in
+ * flight.
+ *
+ * Each object is read using the generation returned by the listing. See the
+ * previous overload for details.
+ */
+template <typename... Options>
+PipelinedObjectReader ReadObjectsPipelined(Client client,
+                                           ListObjectsReader objects,
+                                           Options&&... options) {
+  return internal::MakePipelinedObjectReader(
+      std::move(client), internal::MakePipelinedReadInput(std::move(objects)),
+      std::forward<Options>(options)...);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PIPELINED_OBJECT_READER_H
@@ -0,0 +1,105 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_RANDOM_ACCESS_OBJECT_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_RANDOM_ACCESS_OBJECT_READER_H
+
+#include "google/cloud/storage/internal/random_access_reader_impl.h"
+#include "google/cloud/storage/object_buffer_reader.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/**
+ * Reads arbitrary ranges of a GCS Object, possibly from multiple threads.
+ *
+ * Applications reading file formats with an index (Parquet, ORC, zip, etc.)
+ * issue many small reads at scattered offsets. Sending a ranged download for
+ * each read is slow. This class keeps the downloads open between reads, so a
+ * read that starts at (or shortly after) the point where a previous read
+ * stopped continues the same download. Reads close to each other share a
+ * single ranged request, and sequential scans use increasingly large
+ * downloads, see `storage_experimental::RandomAccessMinReadaheadOption` and
+ * `storage_experimental::RandomAccessMaxReadaheadOption`.
+ *
+ * All the reads use the object generation found when the reader was created,
+ * so they return consistent data even if the object is replaced. The
+ * checksums of the data are not validated, as the reads may not cover the
+ * full object.
+ *
+ * Copies of a reader share its downloads. It is safe to call `ReadAt()`
+ * concurrently from multiple threads, each concurrent call uses a separate
+ * download.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * void ReadFooter(gcs::Client client, std::string const& bucket,
+ *                 std::string const& object) {
+ *   auto reader = client.OpenRandomAccessReader(bucket, object);
+ *   if (!reader) throw std::runtime_error(reader.status().message());
+ *   std::vector<char> footer(8);
+ *   auto n = reader->ReadAt(reader->size() - 8, gcs::MutableBuffer(footer));
+ *   if (!n) throw std::runtime_error(n.status().message());
+ *   // ... use the first `*n` bytes in `footer` ...
+ * }
+ * @endcode
+ */
+class RandomAccessObjectReader {
+ public:
+  explicit RandomAccessObjectReader(
+      std::shared_ptr<internal::RandomAccessReaderImpl> impl)
+      : impl_(std::move(impl)) {}
+
+  /**
+   * Fills @p buffer with the object contents starting at @p offset.
+   *
+   * Returns the number of bytes read, which is smaller than `buffer.size()`
+   * only if the range extends past the end of the object. Returns `0` if
+   * @p offset is at (or past) the end of the object.
+   */
+  StatusOr<std::size_t> ReadAt(std::int64_t offset, MutableBuffer buffer) {
+    return impl_->ReadAt(offset, buffer.data(), buffer.size());
+  }
+
+  /// The size of the object.
+  std::int64_t size() const { return impl_->size(); }
+
+  /// The generation of the object.
+  std::int64_t generation() const { return impl_->generation(); }
+
+  /**
+   * Closes any idle downloads.
+   *
+   * The reader remains usable, further reads start new downloads.
+   */
+  void Close() { impl_->Close(); }
+
+ private:
+  std::shared_ptr<internal::RandomAccessReaderImpl> impl_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_RANDOM_ACCESS_OBJECT_READER_H
@@ -17,6 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 storage_client_grpc_unit_tests = [
+    "async_client_test.cc",
     "internal/grpc_client_failures_test.cc",
     "internal/grpc_client_insert_object_media_test.cc",
     "internal/grpc_client_object_request_test.cc",
@@ -25,6 +26,9 @@ storage_client_grpc_unit_tests = [
     "internal/grpc_object_read_source_test.cc",
     "internal/grpc_resumable_upload_session_test.cc",
     "internal/grpc_resumable_upload_session_url_test.cc",
+    "internal/hybrid_client_test.cc",
+    "internal/hybrid_router_test.cc",
     "internal/storage_auth_test.cc",
+    "internal/storage_metrics_test.cc",
     "internal/storage_round_robin_test.cc",
 ]
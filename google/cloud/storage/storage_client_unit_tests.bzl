@@ -18,9 +18,11 @@
 
 storage_client_unit_tests = [
     "auto_finalize_test.cc",
+    "batch_request_test.cc",
     "bucket_access_control_test.cc",
     "bucket_metadata_test.cc",
     "bucket_test.cc",
+    "bulk_operations_test.cc",
     "client_bucket_acl_test.cc",
     "client_default_object_acl_test.cc",
     "client_notifications_test.cc",
@@ -32,21 +34,28 @@ storage_client_unit_tests = [
     "client_sign_url_test.cc",
     "client_test.cc",
     "client_write_object_test.cc",
+    "directory_sync_test.cc",
     "hashing_options_test.cc",
     "hmac_key_metadata_test.cc",
     "idempotency_policy_test.cc",
     "internal/access_control_common_parser_test.cc",
     "internal/access_control_common_test.cc",
     "internal/access_token_credentials_test.cc",
+    "internal/batch_requests_test.cc",
     "internal/binary_data_as_debug_string_test.cc",
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
+    "internal/caching_object_read_source_test.cc",
     "internal/complex_option_test.cc",
     "internal/compute_engine_util_test.cc",
     "internal/const_buffer_test.cc",
+    "internal/crc32c_combine_test.cc",
     "internal/curl_client_test.cc",
     "internal/curl_handle_factory_test.cc",
     "internal/curl_handle_test.cc",
+    "internal/curl_multi_loop_test.cc",
+    "internal/curl_request_builder_test.cc",
+    "internal/curl_request_stats_test.cc",
     "internal/curl_resumable_upload_session_test.cc",
     "internal/curl_wrappers_disable_sigpipe_handler_test.cc",
     "internal/curl_wrappers_enable_sigpipe_handler_test.cc",
@@ -55,27 +64,39 @@ storage_client_unit_tests = [
     "internal/curl_wrappers_locking_enabled_test.cc",
     "internal/curl_wrappers_test.cc",
     "internal/default_object_acl_requests_test.cc",
+    "internal/file_region_sink_test.cc",
     "internal/generate_message_boundary_test.cc",
     "internal/generic_request_test.cc",
+    "internal/gzip_object_read_source_test.cc",
     "internal/hash_function_impl_test.cc",
     "internal/hash_validator_test.cc",
     "internal/hash_values_test.cc",
     "internal/hmac_key_requests_test.cc",
     "internal/http_response_test.cc",
+    "internal/iam_cache_client_test.cc",
     "internal/impersonate_service_account_credentials_test.cc",
     "internal/logging_client_test.cc",
     "internal/logging_resumable_upload_session_test.cc",
     "internal/make_jwt_assertion_test.cc",
+    "internal/mapped_file_test.cc",
     "internal/metadata_parser_test.cc",
     "internal/notification_requests_test.cc",
     "internal/object_acl_requests_test.cc",
+    "internal/object_metadata_cache_client_test.cc",
     "internal/object_read_streambuf_test.cc",
     "internal/object_requests_test.cc",
     "internal/object_write_streambuf_test.cc",
     "internal/openssl_util_test.cc",
     "internal/parameter_pack_validation_test.cc",
     "internal/patch_builder_test.cc",
+    "internal/pipelined_object_reader_impl_test.cc",
+    "internal/pipelined_resumable_upload_session_test.cc",
     "internal/policy_document_request_test.cc",
+    "internal/prefetching_paged_stream_reader_test.cc",
+    "internal/positional_file_writer_test.cc",
+    "internal/random_access_reader_impl_test.cc",
+    "internal/rate_limited_transfer_test.cc",
+    "internal/read_block_cache_test.cc",
     "internal/resumable_upload_session_test.cc",
     "internal/retry_client_test.cc",
     "internal/retry_object_read_source_test.cc",
@@ -87,9 +108,12 @@ storage_client_unit_tests = [
     "internal/signed_url_requests_test.cc",
     "internal/tuple_filter_test.cc",
     "internal/unified_rest_credentials_test.cc",
+    "internal/upload_chunk_sizer_test.cc",
+    "io_buffer_pool_test.cc",
     "lifecycle_rule_test.cc",
     "list_buckets_reader_test.cc",
     "list_hmac_keys_reader_test.cc",
+    "list_object_summaries_reader_test.cc",
     "list_objects_and_prefixes_reader_test.cc",
     "list_objects_reader_test.cc",
     "notification_metadata_test.cc",
@@ -100,9 +124,12 @@ storage_client_unit_tests = [
     "oauth2/google_credentials_test.cc",
     "oauth2/service_account_credentials_test.cc",
     "object_access_control_test.cc",
+    "object_buffer_reader_test.cc",
     "object_metadata_test.cc",
     "object_stream_test.cc",
     "object_test.cc",
+    "parallel_download_test.cc",
+    "parallel_list_objects_test.cc",
     "parallel_uploads_test.cc",
     "policy_document_test.cc",
     "retry_policy_test.cc",
@@ -112,6 +139,7 @@ storage_client_unit_tests = [
     "storage_iam_policy_test.cc",
     "storage_version_test.cc",
     "testing/remove_stale_buckets_test.cc",
+    "transfer_rate_limiter_test.cc",
     "well_known_headers_test.cc",
     "well_known_parameters_test.cc",
 ]
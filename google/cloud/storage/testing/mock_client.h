@@ -89,6 +89,8 @@ class MockClient : public google::cloud::storage::internal::RawClient {
               RestoreResumableSession, (std::string const&), (override));
   MOCK_METHOD(StatusOr<internal::EmptyResponse>, DeleteResumableUpload,
               (internal::DeleteResumableUploadRequest const&), (override));
+  MOCK_METHOD(StatusOr<internal::ExecuteBatchResponse>, ExecuteBatch,
+              (internal::ExecuteBatchRequest const&), (override));
 
   MOCK_METHOD(StatusOr<internal::ListBucketAclResponse>, ListBucketAcl,
               (internal::ListBucketAclRequest const&), (override));
@@ -175,6 +177,7 @@ class MockResumableUploadSession
   MOCK_METHOD(std::uint64_t, next_expected_byte, (), (const, override));
   MOCK_METHOD(std::string const&, session_id, (), (const, override));
   MOCK_METHOD(bool, done, (), (const, override));
+  MOCK_METHOD(std::uint64_t, failed_attempts, (), (const, override));
   MOCK_METHOD(StatusOr<internal::ResumableUploadResponse> const&, last_response,
               (), (const, override));
 };
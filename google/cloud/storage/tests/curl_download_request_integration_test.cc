@@ -20,6 +20,7 @@
 #include <gmock/gmock.h>
 #include <nlohmann/json.hpp>
 #include <chrono>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -77,6 +78,53 @@ TEST(CurlDownloadRequestTest, SimpleStream) {
   EXPECT_EQ(kDownloadedLines, count);
 }
 
+TEST(CurlDownloadRequestTest, SharedLoopConcurrentStreams) {
+  // httpbin can generate up to 100 lines, do not try to download more than
+  // that.
+  constexpr int kDownloadedLines = 100;
+  constexpr int kStreams = 4;
+
+  auto loop = std::make_shared<CurlMultiLoop>();
+  auto download = [&](std::size_t& count) {
+    count = 0;
+    CurlRequestBuilder builder(
+        HttpBinEndpoint() + "/stream/" + std::to_string(kDownloadedLines),
+        storage::internal::GetDefaultCurlHandleFactory());
+    builder.SetCurlMultiLoop(loop);
+    auto download = std::move(builder).BuildDownloadRequest();
+    // Use a small buffer, so the transfers are paused and resumed many times.
+    char buffer[128];
+    do {
+      auto n = sizeof(buffer);
+      auto result = download->Read(buffer, n);
+      if (!result) return std::move(result).status();
+      if (result->bytes_received > sizeof(buffer)) {
+        return Status{StatusCode::kUnknown, "invalid byte count"};
+      }
+      count += static_cast<std::size_t>(
+          std::count(buffer, buffer + result->bytes_received, '\n'));
+      if (result->response.status_code != 100) break;
+    } while (true);
+    return Status{};
+  };
+
+  std::vector<std::size_t> counts(kStreams);
+  std::vector<std::thread> tasks;
+  for (auto& count : counts) {
+    tasks.emplace_back([&download, &count] {
+      auto delay = std::chrono::seconds(1);
+      for (int i = 0; i != 3; ++i) {
+        auto result = download(count);
+        if (result.ok()) break;
+        std::this_thread::sleep_for(delay);
+        delay *= 2;
+      }
+    });
+  }
+  for (auto& t : tasks) t.join();
+  for (auto const count : counts) EXPECT_EQ(kDownloadedLines, count);
+}
+
 TEST(CurlDownloadRequestTest, HandlesReleasedOnRead) {
   auto constexpr kLineCount = 10;
   auto constexpr kTestPoolSize = 8;
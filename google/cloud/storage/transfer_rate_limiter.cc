@@ -0,0 +1,126 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/transfer_rate_limiter.h"
+#include <algorithm>
+#include <iostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+double Weight(TransferPriority priority) {
+  switch (priority) {
+    case TransferPriority::kBackground:
+      return 1.0;
+    case TransferPriority::kNormal:
+      return 4.0;
+    case TransferPriority::kInteractive:
+      return 16.0;
+  }
+  return 4.0;
+}
+
+std::size_t Index(TransferPriority priority) {
+  switch (priority) {
+    case TransferPriority::kBackground:
+      return 0;
+    case TransferPriority::kNormal:
+      return 1;
+    case TransferPriority::kInteractive:
+      return 2;
+  }
+  return 1;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, TransferPriority rhs) {
+  switch (rhs) {
+    case TransferPriority::kBackground:
+      return os << "background";
+    case TransferPriority::kNormal:
+      return os << "normal";
+    case TransferPriority::kInteractive:
+      return os << "interactive";
+  }
+  return os << "unknown";
+}
+
+std::shared_ptr<TransferRateLimiter> TransferRateLimiter::Create(
+    std::int64_t bytes_per_second, std::int64_t burst_bytes) {
+  bytes_per_second = (std::max)(bytes_per_second, std::int64_t{1});
+  if (burst_bytes <= 0) {
+    burst_bytes = (std::max)(bytes_per_second / 10, std::int64_t{256 * 1024});
+  }
+  return std::shared_ptr<TransferRateLimiter>(
+      new TransferRateLimiter(bytes_per_second, burst_bytes));
+}
+
+TransferRateLimiter::TransferRateLimiter(std::int64_t bytes_per_second,
+                                         std::int64_t burst_bytes)
+    : bytes_per_second_(bytes_per_second),
+      burst_bytes_(burst_bytes),
+      tokens_(static_cast<double>(burst_bytes)),
+      last_refill_(std::chrono::steady_clock::now()) {}
+
+void TransferRateLimiter::Acquire(std::size_t bytes,
+                                  TransferPriority priority) {
+  if (bytes == 0) return;
+  auto const size = static_cast<double>(bytes);
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& finish = finish_[Index(priority)];
+  auto const start = (std::max)(virtual_time_, finish);
+  finish = start + size / Weight(priority);
+  auto const key = std::make_pair(start, next_request_++);
+  waiting_.insert(key);
+  // Requests larger than the bucket would never find enough tokens, they wait
+  // for a full bucket and then leave it in debt.
+  auto const needed = (std::min)(size, static_cast<double>(burst_bytes_));
+  for (;;) {
+    if (*waiting_.begin() != key) {
+      cv_.wait(lk);
+      continue;
+    }
+    auto const now = std::chrono::steady_clock::now();
+    Refill(now);
+    if (tokens_ >= needed) break;
+    auto const wait = std::chrono::duration<double>(
+        (needed - tokens_) / static_cast<double>(bytes_per_second_));
+    cv_.wait_until(
+        lk, now + std::chrono::duration_cast<std::chrono::nanoseconds>(wait));
+  }
+  tokens_ -= size;
+  virtual_time_ = start;
+  waiting_.erase(waiting_.begin());
+  lk.unlock();
+  cv_.notify_all();
+}
+
+void TransferRateLimiter::Refill(std::chrono::steady_clock::time_point now) {
+  auto const elapsed =
+      std::chrono::duration<double>(now - last_refill_).count();
+  last_refill_ = now;
+  tokens_ = (std::min)(static_cast<double>(burst_bytes_),
+                       tokens_ + elapsed * static_cast<double>(
+                                               bytes_per_second_));
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,156 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_RATE_LIMITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_RATE_LIMITER_H
+
+#include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+/**
+ * The priority classes for transfers sharing a `TransferRateLimiter`.
+ *
+ * When several classes are waiting for bandwidth they share it in proportion
+ * to their weights: 1 for `kBackground`, 4 for `kNormal`, and 16 for
+ * `kInteractive`. A class that is not transferring any data does not use any
+ * of the bandwidth.
+ */
+enum class TransferPriority {
+  kBackground,
+  kNormal,
+  kInteractive,
+};
+
+std::ostream& operator<<(std::ostream& os, TransferPriority rhs);
+
+/**
+ * Limits the bandwidth used by a group of downloads and uploads.
+ *
+ * The limiter is a token bucket, refilled at @p bytes_per_second and holding
+ * at most @p burst_bytes. Downloads take tokens for each block of data
+ * received, uploads for each chunk before it is sent, and both block until
+ * enough tokens are available. Transfers larger than the bucket take all
+ * the tokens and leave it in debt, so the long term rate is still respected.
+ *
+ * The waiting transfers are served using start-time fair queueing: transfers
+ * in the same `TransferPriority` class take turns, and the classes share the
+ * bandwidth in proportion to their weights. This keeps bulk background
+ * copies from starving latency-sensitive reads sharing the same limiter.
+ *
+ * Use `storage_experimental::TransferRateLimiterOption` to limit all the
+ * transfers of a `Client`, or the `UseTransferRateLimiter` and
+ * `WithTransferPriority` request options to configure individual streams.
+ * The same limiter can be shared by many clients.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * auto limiter = gcs::TransferRateLimiter::Create(100 * 1024 * 1024);
+ * auto client = gcs::Client(google::cloud::Options{}.set<
+ *     gcs::storage_experimental::TransferRateLimiterOption>(limiter));
+ * auto reader = client.ReadObject(
+ *     "my-bucket", "my-object",
+ *     gcs::WithTransferPriority(gcs::TransferPriority::kInteractive));
+ * @endcode
+ */
+class TransferRateLimiter {
+ public:
+  /**
+   * Creates a limiter for @p bytes_per_second.
+   *
+   * If @p burst_bytes is zero the bucket holds 100ms worth of tokens, but no
+   * less than 256 KiB.
+   */
+  static std::shared_ptr<TransferRateLimiter> Create(
+      std::int64_t bytes_per_second, std::int64_t burst_bytes = 0);
+
+  /// Blocks until @p bytes can be transferred at the given @p priority.
+  void Acquire(std::size_t bytes, TransferPriority priority);
+
+  std::int64_t bytes_per_second() const { return bytes_per_second_; }
+  std::int64_t burst_bytes() const { return burst_bytes_; }
+
+ private:
+  TransferRateLimiter(std::int64_t bytes_per_second, std::int64_t burst_bytes);
+
+  void Refill(std::chrono::steady_clock::time_point now);
+
+  std::int64_t const bytes_per_second_;
+  std::int64_t const burst_bytes_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  double tokens_;
+  std::chrono::steady_clock::time_point last_refill_;
+  // The start tag of the last request served, and the finish tag of the last
+  // request queued for each priority class.
+  double virtual_time_ = 0;
+  double finish_[3] = {0, 0, 0};
+  // The waiting requests, ordered by their start tag and then by arrival.
+  std::set<std::pair<double, std::uint64_t>> waiting_;
+  std::uint64_t next_request_ = 0;
+};
+
+/**
+ * Limits the bandwidth of a download or upload with the given limiter.
+ *
+ * Overrides the `storage_experimental::TransferRateLimiterOption` set in the
+ * client, if any.
+ */
+struct UseTransferRateLimiter
+    : public internal::ComplexOption<UseTransferRateLimiter,
+                                     std::shared_ptr<TransferRateLimiter>> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  UseTransferRateLimiter() = default;
+  static char const* name() { return "use-transfer-rate-limiter"; }
+};
+
+/**
+ * The priority of a download or upload in its `TransferRateLimiter`.
+ *
+ * Overrides the `storage_experimental::TransferPriorityOption` set in the
+ * client, if any. Ignored if the transfer is not rate limited.
+ */
+struct WithTransferPriority
+    : public internal::ComplexOption<WithTransferPriority, TransferPriority> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  WithTransferPriority() = default;
+  static char const* name() { return "with-transfer-priority"; }
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TRANSFER_RATE_LIMITER_H
@@ -0,0 +1,97 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/transfer_rate_limiter.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ms = std::chrono::milliseconds;
+
+TEST(TransferRateLimiterTest, DefaultBurst) {
+  EXPECT_EQ(256 * 1024, TransferRateLimiter::Create(1024)->burst_bytes());
+  EXPECT_EQ(10 * 1024 * 1024,
+            TransferRateLimiter::Create(100 * 1024 * 1024)->burst_bytes());
+  EXPECT_EQ(4096, TransferRateLimiter::Create(1024, 4096)->burst_bytes());
+}
+
+TEST(TransferRateLimiterTest, LimitsRate) {
+  auto const kBlock = 256 * 1024;
+  auto limiter = TransferRateLimiter::Create(4 * 1024 * 1024, kBlock);
+  auto const start = std::chrono::steady_clock::now();
+  // The first block uses the initial burst, the next 4 blocks (1 MiB) take
+  // at least 250ms.
+  for (int i = 0; i != 5; ++i) {
+    limiter->Acquire(kBlock, TransferPriority::kNormal);
+  }
+  EXPECT_GE(std::chrono::steady_clock::now() - start, ms(200));
+}
+
+TEST(TransferRateLimiterTest, LargeRequestsRunIntoDebt) {
+  auto limiter = TransferRateLimiter::Create(8 * 1024 * 1024, 256 * 1024);
+  auto const start = std::chrono::steady_clock::now();
+  // Larger than the bucket, but it is full, so this does not block.
+  limiter->Acquire(2 * 1024 * 1024, TransferPriority::kNormal);
+  // This waits for the debt, (2 MiB - 256 KiB) at 8 MiB/s, ~218ms.
+  limiter->Acquire(1, TransferPriority::kNormal);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, ms(150));
+}
+
+TEST(TransferRateLimiterTest, PrioritiesShareBandwidth) {
+  auto const kBlock = 16 * 1024;
+  auto limiter = TransferRateLimiter::Create(8 * 1024 * 1024, kBlock);
+  std::atomic<bool> done{false};
+  auto transfer = [&](TransferPriority priority) {
+    std::int64_t blocks = 0;
+    while (!done.load()) {
+      limiter->Acquire(kBlock, priority);
+      ++blocks;
+    }
+    return blocks;
+  };
+  std::int64_t interactive = 0;
+  std::int64_t background = 0;
+  std::thread t1(
+      [&] { interactive = transfer(TransferPriority::kInteractive); });
+  std::thread t2([&] { background = transfer(TransferPriority::kBackground); });
+  std::this_thread::sleep_for(ms(500));
+  done.store(true);
+  t1.join();
+  t2.join();
+  // The weights are 16:1, leave plenty of room for scheduling noise, but the
+  // background transfer must not be starved either.
+  EXPECT_GT(interactive, 4 * background);
+  EXPECT_GT(background, 0);
+}
+
+TEST(TransferRateLimiterTest, PriorityStream) {
+  std::ostringstream os;
+  os << TransferPriority::kBackground << " " << TransferPriority::kNormal
+     << " " << TransferPriority::kInteractive;
+  EXPECT_EQ("background normal interactive", os.str());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
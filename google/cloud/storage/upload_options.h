@@ -18,6 +18,7 @@
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_headers.h"
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -93,6 +94,27 @@ struct UploadLimit
   static char const* name() { return "upload-limit"; }
 };
 
+/**
+ * Upload the data in the background, with up to this many chunk buffers.
+ *
+ * By default `WriteObject()` uploads each chunk (see `UploadBufferSizeOption`)
+ * and waits for the response before accepting more data, limiting the
+ * throughput to one buffer per round-trip. With a depth of 2 or more the
+ * stream copies each chunk to one of `depth - 1` background buffers and
+ * continues to accept data while the chunk is uploaded, which uses up to
+ * `depth` times the upload buffer memory. The chunks are still uploaded in
+ * order, one at a time, and retried as usual. Errors are reported by the
+ * next write or by `Close()`.
+ */
+struct UploadPipelineDepth
+    : public internal::ComplexOption<UploadPipelineDepth, std::size_t> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  UploadPipelineDepth() = default;
+  static char const* name() { return "upload-pipeline-depth"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -20,8 +20,10 @@
 #include "google/cloud/version.h"
 #include "absl/types/variant.h"
 #include <functional>
+#include <cstddef>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -54,9 +56,41 @@ namespace internal {
 template <typename T>
 using StreamReader = std::function<absl::variant<Status, T>()>;
 
+/**
+ * A function that repeatedly returns batches of `T`s, and ends with a `Status`.
+ *
+ * Each call appends the next batch of elements to the (initially empty)
+ * vector. Returning an OK `Status` with a non-empty batch indicates there may
+ * be more elements. Returning an OK `Status` with an empty batch indicates a
+ * successful end of stream. Returning a non-OK `Status` indicates an error, the
+ * elements in the batch, if any, are returned before the error. This function
+ * will not be invoked any more after it ends the stream.
+ *
+ * Prefer this over `StreamReader<T>` when the elements are naturally produced
+ * in groups, e.g., pages of a `List` RPC. The range then iterates each batch
+ * directly, instead of calling a `std::function` and unpacking a variant for
+ * every element.
+ *
+ * @par Example `BatchStreamReader` that returns the integers from 1-10.
+ *
+ * @code
+ * int counter = 0;
+ * auto reader = [&counter](std::vector<int>& batch) {
+ *   for (; counter < 10 && batch.size() < 4; ++counter) {
+ *     batch.push_back(counter + 1);
+ *   }
+ *   return Status{};  // OK, the batch is empty after the last element.
+ * };
+ * @endcode
+ */
+template <typename T>
+using BatchStreamReader = std::function<Status(std::vector<T>&)>;
+
 // Defined below.
 template <typename T>
 StreamRange<T> MakeStreamRange(StreamReader<T>);
+template <typename T>
+StreamRange<T> MakeBatchStreamRange(BatchStreamReader<T>);
 
 }  // namespace internal
 
@@ -91,7 +125,9 @@ class StreamRange {
   template <typename U>
   static constexpr bool IsMoveNoexcept() {
     return noexcept(StatusOr<U>(std::declval<U>()))&& noexcept(
-        internal::StreamReader<U>(std::declval<internal::StreamReader<U>>()));
+        internal::StreamReader<U>(std::declval<internal::StreamReader<U>>()))&&
+        noexcept(internal::BatchStreamReader<U>(
+            std::declval<internal::BatchStreamReader<U>>()));
   }
 
  public:
@@ -180,6 +216,7 @@ class StreamRange {
       is_end_ = true;
       return;
     }
+    if (batch_reader_) return NextFromBatch();
     struct UnpackVariant {
       StreamRange& sr;
       void operator()(Status&& status) {
@@ -195,8 +232,28 @@ class StreamRange {
     absl::visit(UnpackVariant{*this}, std::move(v));
   }
 
+  void NextFromBatch() {
+    if (batch_index_ == batch_.size()) {
+      if (batch_done_) {
+        is_end_ = batch_status_.ok();
+        if (!is_end_) current_ = std::move(batch_status_);
+        return;
+      }
+      batch_.clear();
+      batch_index_ = 0;
+      batch_status_ = batch_reader_(batch_);
+      batch_done_ = batch_.empty() || !batch_status_.ok();
+      if (batch_.empty()) return NextFromBatch();
+    }
+    is_end_ = false;
+    current_ = std::move(batch_[batch_index_++]);
+  }
+
   template <typename U>
   friend StreamRange<U> internal::MakeStreamRange(internal::StreamReader<U>);
+  template <typename U>
+  friend StreamRange<U> internal::MakeBatchStreamRange(
+      internal::BatchStreamReader<U>);
 
   /**
    * Constructs a `StreamRange<T>` that will use the given @p reader.
@@ -229,7 +286,18 @@ class StreamRange {
     Next();
   }
 
+  /// Constructs a `StreamRange<T>` that reads batches from @p reader.
+  explicit StreamRange(internal::BatchStreamReader<T> reader)
+      : batch_reader_(std::move(reader)) {
+    Next();
+  }
+
   internal::StreamReader<T> reader_;
+  internal::BatchStreamReader<T> batch_reader_;
+  std::vector<T> batch_;
+  std::size_t batch_index_ = 0;
+  Status batch_status_;
+  bool batch_done_ = false;
   StatusOr<T> current_;
   bool is_end_ = true;
 };
@@ -252,6 +320,18 @@ StreamRange<T> MakeStreamRange(StreamReader<T> reader) {
   return StreamRange<T>{std::move(reader)};
 }
 
+/**
+ * Factory to construct a `StreamRange<T>` with the given
+ * `BatchStreamReader<T>`.
+ *
+ * As with `MakeStreamRange()`, callers should explicitly specify the `T`
+ * parameter so lambdas implicitly convert to the `BatchStreamReader<T>`.
+ */
+template <typename T>
+StreamRange<T> MakeBatchStreamRange(BatchStreamReader<T> reader) {
+  return StreamRange<T>{std::move(reader)};
+}
+
 }  // namespace internal
 
 }  // namespace GOOGLE_CLOUD_CPP_NS
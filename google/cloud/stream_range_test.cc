@@ -170,6 +170,72 @@ TEST(StreamRange, StreamError) {
   EXPECT_EQ(it, sr.end());
 }
 
+TEST(StreamRange, BatchEmptyRange) {
+  StreamRange<int> sr = internal::MakeBatchStreamRange<int>(
+      [](std::vector<int>&) { return Status{}; });
+  EXPECT_EQ(sr.begin(), sr.end());
+}
+
+TEST(StreamRange, BatchElements) {
+  std::deque<std::vector<int>> batches{{1, 2, 3}, {4}, {5, 6}};
+  auto calls = 0;
+  auto reader = [&](std::vector<int>& batch) {
+    ++calls;
+    EXPECT_TRUE(batch.empty());
+    if (!batches.empty()) {
+      batch = std::move(batches.front());
+      batches.pop_front();
+    }
+    return Status{};
+  };
+
+  StreamRange<int> sr = internal::MakeBatchStreamRange<int>(std::move(reader));
+  std::vector<int> v;
+  for (StatusOr<int>& x : sr) {
+    ASSERT_STATUS_OK(x);
+    v.push_back(*x);
+  }
+  EXPECT_THAT(v, ElementsAre(1, 2, 3, 4, 5, 6));
+  // The reader is called once per batch, plus once to end the stream.
+  EXPECT_EQ(4, calls);
+}
+
+TEST(StreamRange, BatchErrorAfterElements) {
+  auto calls = 0;
+  auto reader = [&calls](std::vector<int>& batch) {
+    ++calls;
+    batch = {1, 2};
+    return Status(StatusCode::kUnknown, "oops");
+  };
+
+  StreamRange<int> sr = internal::MakeBatchStreamRange<int>(std::move(reader));
+  std::vector<StatusOr<int>> v;
+  for (auto& x : sr) v.push_back(std::move(x));
+  ASSERT_EQ(3, v.size());
+  EXPECT_THAT(v[0], StatusIs(StatusCode::kOk));
+  EXPECT_EQ(1, *v[0]);
+  EXPECT_EQ(2, *v[1]);
+  EXPECT_THAT(v[2], StatusIs(StatusCode::kUnknown, "oops"));
+  EXPECT_EQ(1, calls);
+}
+
+TEST(StreamRange, BatchMoveOnly) {
+  auto reader = [](std::vector<int>& batch) {
+    batch = {1, 2};
+    return Status{};
+  };
+  StreamRange<int> sr = internal::MakeBatchStreamRange<int>(reader);
+  auto it = sr.begin();
+  ASSERT_NE(it, sr.end());
+  EXPECT_EQ(1, **it);
+  StreamRange<int> moved = std::move(sr);
+  it = moved.begin();
+  ASSERT_NE(it, moved.end());
+  ++it;
+  ASSERT_NE(it, moved.end());
+  EXPECT_EQ(2, **it);
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -0,0 +1,64 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+// Updated from the replacement `operator new()` below. The RPCs run in many
+// threads, a relaxed atomic is cheap enough and does not miss the allocations
+// made by the gRPC threads.
+std::atomic<std::int64_t> allocation_count{0};
+}  // anonymous namespace
+
+// Defining these in the same translation unit as `AllocationCount()`
+// guarantees they are linked into any program using the counter. The
+// benchmark driver lives in a separate translation unit, as some compilers
+// warn about inlined `std::free()` calls on memory from `operator new()`.
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (auto* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  ::operator delete(ptr);
+}
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+std::int64_t AllocationCount() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
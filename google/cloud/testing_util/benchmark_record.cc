@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/benchmark_record.h"
+#include "google/cloud/internal/format_time_point.h"
+#include <iomanip>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+std::string JsonString(std::string const& value) {
+  std::ostringstream os;
+  os << '"';
+  for (auto c : value) {
+    switch (c) {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+             << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+          os << c;
+        }
+        break;
+    }
+  }
+  os << '"';
+  return os.str();
+}
+
+double PerOperation(std::int64_t value, std::int64_t count) {
+  if (count == 0) return 0;
+  return static_cast<double>(value) / static_cast<double>(count);
+}
+
+}  // namespace
+
+std::vector<OptionDescriptor> BenchmarkOutputOptions(
+    BenchmarkOutputConfig& config) {
+  return {
+      {"--output-format",
+       "the format for the results, 'csv' or 'json' (one object per line)",
+       [&config](std::string const& val) { config.format = val; }},
+      {"--label",
+       "a key=value pair added to the JSON results, may be repeated",
+       [&config](std::string const& val) {
+         auto const pos = val.find('=');
+         if (pos == std::string::npos) {
+           config.labels[val] = std::string{};
+           return;
+         }
+         config.labels[val.substr(0, pos)] = val.substr(pos + 1);
+       }},
+  };
+}
+
+Status ValidateBenchmarkOutputConfig(BenchmarkOutputConfig const& config) {
+  if (config.format != "csv" && config.format != "json") {
+    return Status(StatusCode::kInvalidArgument,
+                  "invalid --output-format option, must be 'csv' or 'json'");
+  }
+  for (auto const& kv : config.labels) {
+    if (!kv.first.empty()) continue;
+    return Status(StatusCode::kInvalidArgument,
+                  "invalid --label option, the key must not be empty");
+  }
+  return Status{};
+}
+
+std::string FormatJson(BenchmarkRecord const& record,
+                       BenchmarkOutputConfig const& config) {
+  auto labels = config.labels;
+  for (auto const& kv : record.labels) labels[kv.first] = kv.second;
+  auto const elapsed = static_cast<double>(record.elapsed.count());
+  auto const rate = [elapsed](std::int64_t v) {
+    return elapsed == 0 ? 0.0 : static_cast<double>(v) / elapsed;
+  };
+  auto const& latency = record.latency;
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << R"({"timestamp": )"
+     << JsonString(google::cloud::internal::FormatRfc3339(record.timestamp))
+     << R"(, "benchmark": )" << JsonString(record.benchmark)
+     << R"(, "op": )" << JsonString(record.operation) << R"(, "labels": {)";
+  char const* sep = "";
+  for (auto const& kv : labels) {
+    os << sep << JsonString(kv.first) << ": " << JsonString(kv.second);
+    sep = ", ";
+  }
+  os << R"(}, "iteration": )" << record.iteration
+     << R"(, "count": )" << record.count << R"(, "errors": )" << record.errors
+     << R"(, "bytes": )" << record.bytes
+     << R"(, "elapsed_us": )" << record.elapsed.count()
+     << R"(, "ops_per_second": )" << rate(record.count) * 1000000.0
+     << R"(, "MBs": )" << rate(record.bytes)
+     << R"(, "cpu_us": )" << record.usage.cpu_time.count()
+     << R"(, "cpu_us_per_op": )"
+     << PerOperation(record.usage.cpu_time.count(), record.count)
+     << R"(, "allocations": )" << record.usage.allocations
+     << R"(, "allocations_per_op": )"
+     << PerOperation(record.usage.allocations, record.count)
+     << R"(, "voluntary_context_switches": )"
+     << record.usage.voluntary_context_switches
+     << R"(, "involuntary_context_switches": )"
+     << record.usage.involuntary_context_switches
+     << R"(, "latency_count": )" << latency.count()
+     << R"(, "p50_us": )" << latency.Percentile(50).count()
+     << R"(, "p90_us": )" << latency.Percentile(90).count()
+     << R"(, "p99_us": )" << latency.Percentile(99).count()
+     << R"(, "p999_us": )" << latency.Percentile(99.9).count()
+     << R"(, "max_us": )" << latency.Percentile(100).count() << "}";
+  return os.str();
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,101 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_BENCHMARK_RECORD_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_BENCHMARK_RECORD_H
+
+#include "google/cloud/testing_util/command_line_parsing.h"
+#include "google/cloud/testing_util/latency_histogram.h"
+#include "google/cloud/testing_util/resource_usage.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/**
+ * The output configuration shared by all the benchmarks.
+ *
+ * The labels describe the configuration being measured, for example, the
+ * service, the transport, or the decorators enabled in the connection. They
+ * are included in each JSON record, so the results from different benchmarks
+ * and services can be loaded into the same table and compared.
+ */
+struct BenchmarkOutputConfig {
+  /// Either `csv` (the benchmark's own format) or `json`.
+  std::string format = "csv";
+  std::map<std::string, std::string> labels;
+};
+
+/**
+ * The command-line options for a `BenchmarkOutputConfig`.
+ *
+ * Benchmarks add these options to their own list of `OptionDescriptor`:
+ * `--output-format=(csv|json)` and `--label=key=value`, which may be
+ * repeated.
+ */
+std::vector<OptionDescriptor> BenchmarkOutputOptions(
+    BenchmarkOutputConfig& config);
+
+/// Returns an error if @p config is invalid.
+Status ValidateBenchmarkOutputConfig(BenchmarkOutputConfig const& config);
+
+/**
+ * The measurements of one benchmark operation over some period.
+ *
+ * A record may describe a single iteration or a complete run. The resource
+ * usage is for the whole process (see `ResourceUsage`), while the latency
+ * only includes the samples for this operation.
+ */
+struct BenchmarkRecord {
+  /// The name of the benchmark program, e.g. `pubsub/throughput`.
+  std::string benchmark;
+  /// The operation measured, e.g. `Publish` or `ReadRows`.
+  std::string operation;
+  std::map<std::string, std::string> labels;
+  std::chrono::system_clock::time_point timestamp =
+      std::chrono::system_clock::now();
+  std::int64_t iteration = 0;
+  std::int64_t count = 0;
+  std::int64_t errors = 0;
+  std::int64_t bytes = 0;
+  std::chrono::microseconds elapsed{0};
+  ResourceUsage usage;
+  LatencyHistogram::Snapshot latency;
+};
+
+/**
+ * Formats @p record as a single-line JSON object.
+ *
+ * All the benchmarks use the same field names, the per-operation rates and
+ * the latency percentiles are computed from the record. Any labels from
+ * @p config are added to the labels in the record.
+ */
+std::string FormatJson(BenchmarkRecord const& record,
+                       BenchmarkOutputConfig const& config = {});
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_BENCHMARK_RECORD_H
@@ -0,0 +1,108 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/benchmark_record.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+TEST(BenchmarkRecord, OutputOptions) {
+  BenchmarkOutputConfig config;
+  auto const desc = BenchmarkOutputOptions(config);
+  auto unparsed =
+      OptionsParse(desc, {"program", "--output-format=json",
+                          "--label=transport=grpc", "--label=layer=stub",
+                          "--label=empty", "positional"});
+  EXPECT_THAT(unparsed, ::testing::ElementsAre("program", "positional"));
+  EXPECT_EQ("json", config.format);
+  EXPECT_THAT(config.labels,
+              UnorderedElementsAre(Pair("transport", "grpc"),
+                                   Pair("layer", "stub"), Pair("empty", "")));
+  EXPECT_STATUS_OK(ValidateBenchmarkOutputConfig(config));
+}
+
+TEST(BenchmarkRecord, Validate) {
+  BenchmarkOutputConfig config;
+  EXPECT_STATUS_OK(ValidateBenchmarkOutputConfig(config));
+  config.format = "xml";
+  EXPECT_THAT(ValidateBenchmarkOutputConfig(config),
+              StatusIs(StatusCode::kInvalidArgument));
+  config.format = "json";
+  config.labels[""] = "value";
+  EXPECT_THAT(ValidateBenchmarkOutputConfig(config),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(BenchmarkRecord, FormatJson) {
+  LatencyHistogram histogram;
+  for (int i = 0; i != 100; ++i) histogram.Record(std::chrono::microseconds(100));
+
+  BenchmarkRecord record;
+  record.benchmark = "service/benchmark";
+  record.operation = "Read";
+  record.labels = {{"layer", "connection"}};
+  record.iteration = 2;
+  record.count = 100;
+  record.errors = 1;
+  record.bytes = 2000000;
+  record.elapsed = std::chrono::seconds(2);
+  record.usage.cpu_time = std::chrono::microseconds(5000);
+  record.usage.allocations = 250;
+  record.latency = histogram.Sample();
+
+  BenchmarkOutputConfig config;
+  config.labels = {{"transport", "grpc"}, {"layer", "ignored"}};
+  auto const json = FormatJson(record, config);
+  EXPECT_THAT(json, HasSubstr(R"("benchmark": "service/benchmark")"));
+  EXPECT_THAT(json, HasSubstr(R"("op": "Read")"));
+  // The labels in the record take precedence.
+  EXPECT_THAT(json, HasSubstr(
+                        R"("labels": {"layer": "connection", )"
+                        R"("transport": "grpc"})"));
+  EXPECT_THAT(json, HasSubstr(R"("iteration": 2, "count": 100, )"
+                              R"("errors": 1, "bytes": 2000000, )"
+                              R"("elapsed_us": 2000000)"));
+  EXPECT_THAT(json, HasSubstr(R"("ops_per_second": 50.000)"));
+  EXPECT_THAT(json, HasSubstr(R"("MBs": 1.000)"));
+  EXPECT_THAT(json, HasSubstr(R"("cpu_us_per_op": 50.000)"));
+  EXPECT_THAT(json, HasSubstr(R"("allocations_per_op": 2.500)"));
+  EXPECT_THAT(json, HasSubstr(R"("latency_count": 100, "p50_us": 112)"));
+  EXPECT_EQ(std::string::npos, json.find('\n'));
+}
+
+TEST(BenchmarkRecord, FormatJsonEscapes) {
+  BenchmarkRecord record;
+  record.benchmark = "quote\"back\\slash\nnewline\x01";
+  auto const json = FormatJson(record);
+  EXPECT_THAT(json,
+              HasSubstr(R"("benchmark": "quote\"back\\slash\nnewline\u0001")"));
+  EXPECT_THAT(json, HasSubstr(R"("ops_per_second": 0.000)"));
+  EXPECT_THAT(json, HasSubstr(R"("max_us": 0})"));
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,61 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/embedded_grpc_server.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/grpc_options.h"
+#include "absl/strings/str_cat.h"
+#include <chrono>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+EmbeddedGrpcServer::EmbeddedGrpcServer(
+    std::vector<grpc::Service*> const& services) {
+  int port = 0;
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort("localhost:0", grpc::InsecureServerCredentials(),
+                           &port);
+  for (auto* s : services) builder.RegisterService(s);
+  server_ = builder.BuildAndStart();
+  address_ = absl::StrCat("localhost:", port);
+}
+
+EmbeddedGrpcServer::~EmbeddedGrpcServer() { Shutdown(); }
+
+Options EmbeddedGrpcServer::ClientOptions() const {
+  return Options{}
+      .set<EndpointOption>(address_)
+      .set<GrpcCredentialOption>(grpc::InsecureChannelCredentials());
+}
+
+std::shared_ptr<grpc::Channel> EmbeddedGrpcServer::CreateChannel() const {
+  return grpc::CreateChannel(address_, grpc::InsecureChannelCredentials());
+}
+
+void EmbeddedGrpcServer::Shutdown() {
+  if (!server_) return;
+  // Cancel any pending RPCs right away, the benchmarks do not need them.
+  server_->Shutdown(std::chrono::system_clock::now());
+  server_->Wait();
+  server_.reset();
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,76 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_EMBEDDED_GRPC_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_EMBEDDED_GRPC_SERVER_H
+
+#include "google/cloud/options.h"
+#include "google/cloud/version.h"
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/**
+ * Runs gRPC services in the current process, listening on a local port.
+ *
+ * Benchmarks use this class to run the generated fake servers, which removes
+ * the network, and the service itself, as sources of variation when measuring
+ * the client libraries.
+ *
+ * @par Example
+ * @code
+ * FakeFooServiceServer fake(FakeServerConfig{});
+ * EmbeddedGrpcServer server({&fake});
+ * auto connection = MakeFooServiceConnection(server.ClientOptions());
+ * @endcode
+ */
+class EmbeddedGrpcServer {
+ public:
+  /// Starts a server for @p services, which must outlive this object.
+  explicit EmbeddedGrpcServer(std::vector<grpc::Service*> const& services);
+  ~EmbeddedGrpcServer();
+
+  EmbeddedGrpcServer(EmbeddedGrpcServer const&) = delete;
+  EmbeddedGrpcServer& operator=(EmbeddedGrpcServer const&) = delete;
+
+  /// The `host:port` address of the server.
+  std::string const& address() const { return address_; }
+
+  /// Options to connect a client library to the server.
+  Options ClientOptions() const;
+
+  /// Creates a new channel to the server.
+  std::shared_ptr<grpc::Channel> CreateChannel() const;
+
+  /// Stops the server, cancelling any pending RPCs. It is safe to call twice.
+  void Shutdown();
+
+ private:
+  std::unique_ptr<grpc::Server> server_;
+  std::string address_;
+};
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_EMBEDDED_GRPC_SERVER_H
@@ -0,0 +1,57 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/embedded_grpc_server.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/grpc_options.h"
+#include <google/longrunning/operations.grpc.pb.h>
+#include <gmock/gmock.h>
+#include <chrono>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+using ::testing::StartsWith;
+
+TEST(EmbeddedGrpcServer, Connect) {
+  // The base class returns UNIMPLEMENTED for all the RPCs, which is enough to
+  // verify the client reaches the server.
+  google::longrunning::Operations::Service service;
+  EmbeddedGrpcServer server({&service});
+  EXPECT_THAT(server.address(), StartsWith("localhost:"));
+  EXPECT_NE("localhost:0", server.address());
+
+  auto options = server.ClientOptions();
+  EXPECT_EQ(server.address(), options.get<EndpointOption>());
+  EXPECT_NE(nullptr, options.get<GrpcCredentialOption>());
+
+  auto stub = google::longrunning::Operations::NewStub(server.CreateChannel());
+  grpc::ClientContext context;
+  google::longrunning::GetOperationRequest request;
+  google::longrunning::Operation response;
+  auto status = stub->GetOperation(&context, request, &response);
+  EXPECT_EQ(grpc::StatusCode::UNIMPLEMENTED, status.error_code());
+  server.Shutdown();
+  server.Shutdown();
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,93 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/fake_rpc_tracer.h"
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+class FakeSpan : public RpcSpan {
+ public:
+  FakeSpan(std::mutex& mu, FakeSpanData& data) : mu_(mu), data_(data) {}
+
+  void SetAttribute(std::string const& key,
+                    std::string const& value) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    data_.attributes.emplace_back(key, value);
+  }
+  void AddEvent(std::string const& name, RpcTraceAttributes const&) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    data_.events.push_back(name);
+  }
+  void End(Status const& status) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    data_.ended = true;
+    data_.status = status;
+  }
+  RpcTraceAttributes ContextHeaders() const override {
+    std::lock_guard<std::mutex> lk(mu_);
+    return {{"x-fake-span", data_.name}};
+  }
+
+  std::string const& name() const { return data_.name; }
+
+ private:
+  std::mutex& mu_;
+  FakeSpanData& data_;
+};
+
+}  // namespace
+
+class ScopedFakeRpcTracer::Tracer : public RpcTracer {
+ public:
+  std::shared_ptr<RpcSpan> StartSpan(std::string const& name,
+                                     RpcSpan* parent) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    spans_.emplace_back(new FakeSpanData);
+    auto& data = *spans_.back();
+    data.name = name;
+    if (parent != nullptr) data.parent = static_cast<FakeSpan*>(parent)->name();
+    return std::make_shared<FakeSpan>(mu_, data);
+  }
+
+  std::vector<FakeSpanData> Spans() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<FakeSpanData> result;
+    for (auto const& s : spans_) result.push_back(*s);
+    return result;
+  }
+
+ private:
+  mutable std::mutex mu_;
+  std::vector<std::unique_ptr<FakeSpanData>> spans_;
+};
+
+ScopedFakeRpcTracer::ScopedFakeRpcTracer()
+    : tracer_(std::make_shared<Tracer>()) {
+  SetRpcTracer(tracer_);
+}
+
+ScopedFakeRpcTracer::~ScopedFakeRpcTracer() { SetRpcTracer(nullptr); }
+
+std::vector<FakeSpanData> ScopedFakeRpcTracer::Spans() const {
+  return tracer_->Spans();
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
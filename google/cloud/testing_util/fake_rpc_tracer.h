@@ -0,0 +1,62 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_FAKE_RPC_TRACER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_FAKE_RPC_TRACER_H
+
+#include "google/cloud/rpc_tracing.h"
+#include "google/cloud/version.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/// The information captured by `FakeRpcTracer` for each span.
+struct FakeSpanData {
+  std::string name;
+  std::string parent;
+  RpcTraceAttributes attributes;
+  std::vector<std::string> events;
+  bool ended = false;
+  Status status;
+};
+
+/**
+ * Installs a tracer that captures all the spans, and removes it on
+ * destruction.
+ */
+class ScopedFakeRpcTracer {
+ public:
+  ScopedFakeRpcTracer();
+  ~ScopedFakeRpcTracer();
+
+  /// The spans created so far, in the order they started.
+  std::vector<FakeSpanData> Spans() const;
+
+ private:
+  class Tracer;
+  std::shared_ptr<Tracer> tracer_;
+};
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_FAKE_RPC_TRACER_H
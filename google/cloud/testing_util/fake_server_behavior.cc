@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include <google/protobuf/descriptor.h>
+#include <random>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+using ::google::protobuf::FieldDescriptor;
+
+bool FillPayloadImpl(google::protobuf::Message& message,
+                     std::string const& payload) {
+  auto const* descriptor = message.GetDescriptor();
+  auto const* reflection = message.GetReflection();
+  for (int i = 0; i != descriptor->field_count(); ++i) {
+    auto const* field = descriptor->field(i);
+    if (field->cpp_type() != FieldDescriptor::CPPTYPE_STRING) continue;
+    if (field->is_repeated()) {
+      reflection->AddString(&message, field, payload);
+    } else {
+      reflection->SetString(&message, field, payload);
+    }
+    return true;
+  }
+  for (int i = 0; i != descriptor->field_count(); ++i) {
+    auto const* field = descriptor->field(i);
+    if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) continue;
+    if (field->is_repeated()) {
+      auto* child = reflection->AddMessage(&message, field);
+      if (FillPayloadImpl(*child, payload)) return true;
+      reflection->RemoveLast(&message, field);
+      continue;
+    }
+    auto* child = reflection->MutableMessage(&message, field);
+    if (FillPayloadImpl(*child, payload)) return true;
+    reflection->ClearField(&message, field);
+  }
+  return false;
+}
+
+}  // namespace
+
+FakeServerBehavior::FakeServerBehavior(FakeServerConfig config)
+    : config_(std::move(config)), generator_(internal::MakeDefaultPRNG()) {
+  // Random data does not compress well, which makes the benchmarks a bit more
+  // realistic.
+  payload_ = internal::Sample(
+      generator_, static_cast<int>(config_.payload_size),
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
+}
+
+grpc::Status FakeServerBehavior::Simulate() {
+  ++rpc_count_;
+  if (config_.latency.count() > 0) std::this_thread::sleep_for(config_.latency);
+  if (config_.error_rate <= 0.0) return grpc::Status::OK;
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const draw = std::uniform_real_distribution<double>(0, 1.0)(generator_);
+  lk.unlock();
+  if (draw >= config_.error_rate) return grpc::Status::OK;
+  ++error_count_;
+  return grpc::Status(config_.error_code, "injected error");
+}
+
+void FakeServerBehavior::FillPayload(google::protobuf::Message& message) const {
+  if (payload_.empty()) return;
+  (void)FillPayloadImpl(message, payload_);
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
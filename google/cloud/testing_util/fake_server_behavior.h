@@ -0,0 +1,97 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_FAKE_SERVER_BEHAVIOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_FAKE_SERVER_BEHAVIOR_H
+
+#include "google/cloud/internal/random.h"
+#include "google/cloud/version.h"
+#include <google/protobuf/message.h>
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/// Configures the canned behavior of the generated fake servers.
+struct FakeServerConfig {
+  /// How long each RPC, and each request in a bidirectional stream, waits.
+  std::chrono::microseconds latency{0};
+  /// The fraction of the RPCs that fail, in the `[0.0, 1.0]` range.
+  double error_rate = 0.0;
+  /// The code for the injected errors.
+  grpc::StatusCode error_code = grpc::StatusCode::UNAVAILABLE;
+  /// The size, in bytes, of the payload added to each canned response.
+  std::size_t payload_size = 0;
+  /// How many responses each streaming read RPC returns.
+  int stream_messages = 1;
+};
+
+/**
+ * Implements the behavior shared by all the generated fake servers.
+ *
+ * The generated `Fake*Server` classes implement each RPC by calling
+ * `Simulate()`, and then returning a canned response. The canned responses are
+ * created once, with `FillPayload()`, so the server does as little work as
+ * possible per RPC, and the benchmarks mostly measure the client library.
+ *
+ * This class is thread-safe, the gRPC server calls it from many threads.
+ */
+class FakeServerBehavior {
+ public:
+  explicit FakeServerBehavior(FakeServerConfig config);
+
+  FakeServerConfig const& config() const { return config_; }
+
+  /**
+   * Waits for the configured latency, then returns an error with the
+   * configured probability, or an OK status.
+   */
+  grpc::Status Simulate();
+
+  /**
+   * Adds `payload_size` bytes of random data to @p message.
+   *
+   * The data goes into the first string or bytes field, recursing into the
+   * first message field if there are no string fields. Messages without either
+   * kind of field are left unchanged.
+   */
+  void FillPayload(google::protobuf::Message& message) const;
+
+  std::int64_t rpc_count() const { return rpc_count_.load(); }
+  std::int64_t error_count() const { return error_count_.load(); }
+
+ private:
+  FakeServerConfig const config_;
+  std::string payload_;
+  std::atomic<std::int64_t> rpc_count_{0};
+  std::atomic<std::int64_t> error_count_{0};
+  std::mutex mu_;
+  internal::DefaultPRNG generator_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_FAKE_SERVER_BEHAVIOR_H
@@ -0,0 +1,106 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/fake_server_behavior.h"
+#include <google/protobuf/duration.pb.h>
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/wrappers.pb.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+TEST(FakeServerBehavior, NoErrors) {
+  FakeServerBehavior behavior{FakeServerConfig{}};
+  for (int i = 0; i != 10; ++i) EXPECT_TRUE(behavior.Simulate().ok());
+  EXPECT_EQ(10, behavior.rpc_count());
+  EXPECT_EQ(0, behavior.error_count());
+}
+
+TEST(FakeServerBehavior, AllErrors) {
+  FakeServerConfig config;
+  config.error_rate = 1.0;
+  config.error_code = grpc::StatusCode::RESOURCE_EXHAUSTED;
+  FakeServerBehavior behavior(config);
+  for (int i = 0; i != 10; ++i) {
+    auto status = behavior.Simulate();
+    EXPECT_EQ(grpc::StatusCode::RESOURCE_EXHAUSTED, status.error_code());
+  }
+  EXPECT_EQ(10, behavior.rpc_count());
+  EXPECT_EQ(10, behavior.error_count());
+}
+
+TEST(FakeServerBehavior, SomeErrors) {
+  FakeServerConfig config;
+  config.error_rate = 0.5;
+  FakeServerBehavior behavior(config);
+  for (int i = 0; i != 1000; ++i) (void)behavior.Simulate();
+  // With 1000 draws these bounds are extremely unlikely to flake.
+  EXPECT_GT(behavior.error_count(), 300);
+  EXPECT_LT(behavior.error_count(), 700);
+}
+
+TEST(FakeServerBehavior, Latency) {
+  FakeServerConfig config;
+  config.latency = std::chrono::milliseconds(5);
+  FakeServerBehavior behavior(config);
+  auto const start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(behavior.Simulate().ok());
+  EXPECT_GE(std::chrono::steady_clock::now() - start, config.latency);
+}
+
+TEST(FakeServerBehavior, FillPayloadString) {
+  FakeServerConfig config;
+  config.payload_size = 128;
+  FakeServerBehavior behavior(config);
+  google::protobuf::StringValue message;
+  behavior.FillPayload(message);
+  EXPECT_EQ(128, message.value().size());
+}
+
+TEST(FakeServerBehavior, FillPayloadNested) {
+  FakeServerConfig config;
+  config.payload_size = 64;
+  FakeServerBehavior behavior(config);
+  google::protobuf::ListValue message;
+  behavior.FillPayload(message);
+  ASSERT_EQ(1, message.values_size());
+  EXPECT_EQ(64, message.values(0).string_value().size());
+}
+
+TEST(FakeServerBehavior, FillPayloadNoStrings) {
+  FakeServerConfig config;
+  config.payload_size = 64;
+  FakeServerBehavior behavior(config);
+  google::protobuf::Duration message;
+  behavior.FillPayload(message);
+  EXPECT_EQ(0, message.ByteSizeLong());
+}
+
+TEST(FakeServerBehavior, FillPayloadEmpty) {
+  FakeServerBehavior behavior{FakeServerConfig{}};
+  google::protobuf::StringValue message;
+  behavior.FillPayload(message);
+  EXPECT_TRUE(message.value().empty());
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -26,6 +26,7 @@ google_cloud_cpp_testing_hdrs = [
     "example_driver.h",
     "expect_exception.h",
     "expect_future_error.h",
+    "fake_rpc_tracer.h",
     "integration_test.h",
     "scoped_environment.h",
     "scoped_log.h",
@@ -39,6 +40,7 @@ google_cloud_cpp_testing_srcs = [
     "command_line_parsing.cc",
     "crash_handler.cc",
     "example_driver.cc",
+    "fake_rpc_tracer.cc",
     "integration_test.cc",
     "scoped_environment.cc",
     "scoped_log.cc",
@@ -17,7 +17,9 @@
 """Automatically generated source lists for google_cloud_cpp_testing_grpc - DO NOT EDIT."""
 
 google_cloud_cpp_testing_grpc_hdrs = [
+    "embedded_grpc_server.h",
     "fake_completion_queue_impl.h",
+    "fake_server_behavior.h",
     "is_proto_equal.h",
     "mock_async_response_reader.h",
     "mock_completion_queue_impl.h",
@@ -26,7 +28,9 @@ google_cloud_cpp_testing_grpc_hdrs = [
 ]
 
 google_cloud_cpp_testing_grpc_srcs = [
+    "embedded_grpc_server.cc",
     "fake_completion_queue_impl.cc",
+    "fake_server_behavior.cc",
     "is_proto_equal.cc",
     "validate_metadata.cc",
 ]
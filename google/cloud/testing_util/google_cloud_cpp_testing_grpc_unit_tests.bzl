@@ -17,5 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 google_cloud_cpp_testing_grpc_unit_tests = [
+    "embedded_grpc_server_test.cc",
+    "fake_server_behavior_test.cc",
     "is_proto_equal_test.cc",
 ]
@@ -0,0 +1,108 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+std::size_t constexpr LatencyHistogram::kBuckets;
+
+std::int64_t LatencyHistogram::Snapshot::count() const {
+  return std::accumulate(buckets_.begin(), buckets_.end(), std::int64_t{0});
+}
+
+std::chrono::microseconds LatencyHistogram::Snapshot::Percentile(
+    double percentile) const {
+  auto const total = count();
+  if (total == 0) return std::chrono::microseconds(0);
+  // The number of samples that must be at or below the returned value.
+  auto const rank = (std::max)(
+      std::int64_t{1}, static_cast<std::int64_t>(std::ceil(
+                           percentile * static_cast<double>(total) / 100.0)));
+  std::int64_t cumulative = 0;
+  std::size_t i = 0;
+  for (; i + 1 < buckets_.size(); ++i) {
+    cumulative += buckets_[i];
+    if (cumulative >= rank) break;
+  }
+  return std::chrono::microseconds(
+      static_cast<std::chrono::microseconds::rep>(BucketLimit(i)));
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Snapshot::Since(
+    Snapshot const& previous) const {
+  Snapshot result = *this;
+  if (previous.buckets_.size() != buckets_.size()) return result;
+  std::transform(buckets_.begin(), buckets_.end(), previous.buckets_.begin(),
+                 result.buckets_.begin(), std::minus<std::int64_t>());
+  return result;
+}
+
+LatencyHistogram::Snapshot& LatencyHistogram::Snapshot::Merge(
+    Snapshot const& other) {
+  if (buckets_.empty()) buckets_.resize(other.buckets_.size());
+  if (other.buckets_.size() != buckets_.size()) return *this;
+  std::transform(buckets_.begin(), buckets_.end(), other.buckets_.begin(),
+                 buckets_.begin(), std::plus<std::int64_t>());
+  return *this;
+}
+
+LatencyHistogram::LatencyHistogram() {
+  for (auto& b : buckets_) b.store(0);
+}
+
+void LatencyHistogram::Record(std::chrono::microseconds latency) {
+  auto const us = static_cast<std::uint64_t>(
+      (std::max)(latency.count(), std::chrono::microseconds::rep{0}));
+  buckets_[BucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Sample() const {
+  Snapshot snapshot;
+  snapshot.buckets_.reserve(buckets_.size());
+  for (auto const& b : buckets_) {
+    snapshot.buckets_.push_back(b.load(std::memory_order_relaxed));
+  }
+  return snapshot;
+}
+
+// Values below 4 get their own bucket. Larger values use the position of their
+// most significant bit and the two bits that follow it.
+std::size_t LatencyHistogram::BucketIndex(std::uint64_t microseconds) {
+  if (microseconds < 4) return static_cast<std::size_t>(microseconds);
+  std::size_t msb = 0;
+  for (auto v = microseconds; v > 1; v >>= 1) ++msb;
+  auto const sub = static_cast<std::size_t>((microseconds >> (msb - 2)) & 3);
+  return (std::min)(4 * (msb - 1) + sub, kBuckets - 1);
+}
+
+// The (exclusive) upper limit of the values in the bucket.
+std::uint64_t LatencyHistogram::BucketLimit(std::size_t index) {
+  if (index < 4) return index + 1;
+  auto const msb = index / 4 + 1;
+  auto const sub = index % 4;
+  return static_cast<std::uint64_t>(5 + sub) << (msb - 2);
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,92 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_LATENCY_HISTOGRAM_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_LATENCY_HISTOGRAM_H
+
+#include "google/cloud/version.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/**
+ * A lock-free histogram of latencies, for use in the benchmarks.
+ *
+ * Recording a sample is a single atomic increment, so the benchmarks can record
+ * the latency of every message. The buckets are log-linear: each power of two
+ * is split into 4 buckets, so the reported percentiles are within 25% of the
+ * exact value. Latencies above 2^40 microseconds (about 12 days) are recorded
+ * in the last bucket.
+ */
+class LatencyHistogram {
+ public:
+  /// A copy of the bucket counts, used to compute percentiles.
+  class Snapshot {
+   public:
+    std::int64_t count() const;
+
+    /**
+     * Returns the @p percentile of the samples, rounded up to the bucket limit.
+     *
+     * Returns 0 if there are no samples.
+     *
+     * @param percentile a value in the (0, 100] range.
+     */
+    std::chrono::microseconds Percentile(double percentile) const;
+
+    /// The samples recorded after @p previous was taken.
+    Snapshot Since(Snapshot const& previous) const;
+
+    /**
+     * Adds the samples in @p other to this snapshot.
+     *
+     * All the histograms use the same buckets, so the merged percentiles are
+     * as accurate as the percentiles of each histogram. Benchmarks can record
+     * the latencies in one histogram per thread, and merge them at the end.
+     */
+    Snapshot& Merge(Snapshot const& other);
+
+   private:
+    friend class LatencyHistogram;
+    std::vector<std::int64_t> buckets_;
+  };
+
+  LatencyHistogram();
+
+  void Record(std::chrono::microseconds latency);
+  Snapshot Sample() const;
+
+  static std::size_t BucketIndex(std::uint64_t microseconds);
+  static std::uint64_t BucketLimit(std::size_t index);
+
+ private:
+  static std::size_t constexpr kBuckets = 4 * 40;
+  std::array<std::atomic<std::int64_t>, kBuckets> buckets_;
+};
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_LATENCY_HISTOGRAM_H
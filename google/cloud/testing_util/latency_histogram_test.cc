@@ -0,0 +1,96 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/latency_histogram.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+using std::chrono::microseconds;
+
+TEST(LatencyHistogram, BucketIndex) {
+  EXPECT_EQ(0, LatencyHistogram::BucketIndex(0));
+  EXPECT_EQ(3, LatencyHistogram::BucketIndex(3));
+  EXPECT_EQ(4, LatencyHistogram::BucketIndex(4));
+  EXPECT_EQ(7, LatencyHistogram::BucketIndex(7));
+  EXPECT_EQ(8, LatencyHistogram::BucketIndex(8));
+  EXPECT_EQ(8, LatencyHistogram::BucketIndex(9));
+  EXPECT_EQ(9, LatencyHistogram::BucketIndex(10));
+  EXPECT_EQ(4 * 40 - 1,
+            LatencyHistogram::BucketIndex(
+                (std::numeric_limits<std::uint64_t>::max)()));
+}
+
+TEST(LatencyHistogram, BucketLimit) {
+  for (std::uint64_t v : {0, 1, 3, 4, 5, 7, 8, 100, 1000, 123456}) {
+    auto const index = LatencyHistogram::BucketIndex(v);
+    SCOPED_TRACE("Testing with v=" + std::to_string(v));
+    EXPECT_LT(v, LatencyHistogram::BucketLimit(index));
+    EXPECT_EQ(index + 1, LatencyHistogram::BucketIndex(
+                             LatencyHistogram::BucketLimit(index)));
+  }
+}
+
+TEST(LatencyHistogram, Percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.Sample().count());
+  EXPECT_EQ(microseconds(0), histogram.Sample().Percentile(50));
+
+  for (int i = 0; i != 99; ++i) histogram.Record(microseconds(100));
+  histogram.Record(microseconds(10000));
+  auto const snapshot = histogram.Sample();
+  EXPECT_EQ(100, snapshot.count());
+  EXPECT_EQ(microseconds(112), snapshot.Percentile(50));
+  EXPECT_EQ(microseconds(112), snapshot.Percentile(99));
+  EXPECT_EQ(microseconds(10240), snapshot.Percentile(100));
+}
+
+TEST(LatencyHistogram, Since) {
+  LatencyHistogram histogram;
+  histogram.Record(microseconds(100));
+  auto const s0 = histogram.Sample();
+  histogram.Record(microseconds(10000));
+  histogram.Record(microseconds(10000));
+  auto const delta = histogram.Sample().Since(s0);
+  EXPECT_EQ(2, delta.count());
+  EXPECT_EQ(microseconds(10240), delta.Percentile(1));
+}
+
+TEST(LatencyHistogram, Merge) {
+  LatencyHistogram h1;
+  for (int i = 0; i != 50; ++i) h1.Record(microseconds(100));
+  LatencyHistogram h2;
+  for (int i = 0; i != 50; ++i) h2.Record(microseconds(10000));
+
+  LatencyHistogram::Snapshot merged;
+  EXPECT_EQ(0, merged.count());
+  merged.Merge(h1.Sample()).Merge(h2.Sample());
+  EXPECT_EQ(100, merged.count());
+  EXPECT_EQ(microseconds(112), merged.Percentile(50));
+  EXPECT_EQ(microseconds(10240), merged.Percentile(51));
+  EXPECT_EQ(microseconds(10240), merged.Percentile(100));
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,57 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/resource_usage.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+#include <sys/resource.h>
+#endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+ResourceUsage CurrentResourceUsage() {
+  ResourceUsage usage;
+  usage.allocations = AllocationCount();
+#if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+  auto as_usec = [](timeval const& tv) {
+    return std::chrono::microseconds(std::chrono::seconds(tv.tv_sec)) +
+           std::chrono::microseconds(tv.tv_usec);
+  };
+  struct rusage now {};
+  (void)getrusage(RUSAGE_SELF, &now);
+  usage.cpu_time = as_usec(now.ru_utime) + as_usec(now.ru_stime);
+  usage.voluntary_context_switches = now.ru_nvcsw;
+  usage.involuntary_context_switches = now.ru_nivcsw;
+#endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+  return usage;
+}
+
+ResourceUsage operator-(ResourceUsage const& lhs, ResourceUsage const& rhs) {
+  ResourceUsage r;
+  r.cpu_time = lhs.cpu_time - rhs.cpu_time;
+  r.allocations = lhs.allocations - rhs.allocations;
+  r.voluntary_context_switches =
+      lhs.voluntary_context_switches - rhs.voluntary_context_switches;
+  r.involuntary_context_switches =
+      lhs.involuntary_context_switches - rhs.involuntary_context_switches;
+  return r;
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,57 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_RESOURCE_USAGE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_RESOURCE_USAGE_H
+
+#include "google/cloud/version.h"
+#include <chrono>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/**
+ * The resources consumed by the benchmark process.
+ *
+ * The values are for the whole process, including the gRPC and completion
+ * queue threads, which do most of the work for the asynchronous operations.
+ * Note that with the embedded server this also includes the server work.
+ *
+ * The allocations are counted by the replacement `operator new()` in this
+ * library, see `AllocationCount()`. The CPU time and context switches come
+ * from `getrusage(2)`, they are always zero on platforms without it.
+ */
+struct ResourceUsage {
+  std::chrono::microseconds cpu_time{0};
+  std::int64_t allocations = 0;
+  std::int64_t voluntary_context_switches = 0;
+  std::int64_t involuntary_context_switches = 0;
+};
+
+/// Sample the resources used by this process since it started.
+ResourceUsage CurrentResourceUsage();
+
+/// The resources consumed between two samples.
+ResourceUsage operator-(ResourceUsage const& lhs, ResourceUsage const& rhs);
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_RESOURCE_USAGE_H
@@ -0,0 +1,57 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/resource_usage.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+TEST(ResourceUsage, CountsAllocations) {
+  auto const start = CurrentResourceUsage();
+  std::vector<std::unique_ptr<int>> v;
+  for (int i = 0; i != 100; ++i) v.push_back(std::unique_ptr<int>(new int(i)));
+  auto const usage = CurrentResourceUsage() - start;
+  EXPECT_GE(usage.allocations, 100);
+  EXPECT_GE(usage.cpu_time.count(), 0);
+}
+
+TEST(ResourceUsage, Difference) {
+  ResourceUsage a;
+  a.cpu_time = std::chrono::microseconds(30);
+  a.allocations = 20;
+  a.voluntary_context_switches = 10;
+  a.involuntary_context_switches = 5;
+  ResourceUsage b;
+  b.cpu_time = std::chrono::microseconds(10);
+  b.allocations = 5;
+  b.voluntary_context_switches = 4;
+  b.involuntary_context_switches = 1;
+  auto d = a - b;
+  EXPECT_EQ(20, d.cpu_time.count());
+  EXPECT_EQ(15, d.allocations);
+  EXPECT_EQ(6, d.voluntary_context_switches);
+  EXPECT_EQ(4, d.involuntary_context_switches);
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
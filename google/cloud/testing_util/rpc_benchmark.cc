@@ -0,0 +1,135 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/rpc_benchmark.h"
+#include "google/cloud/testing_util/resource_usage.h"
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+void Warmup(int iterations, std::function<Status()> const& rpc) {
+  for (int i = 0; i < iterations; ++i) (void)rpc();
+}
+
+// Each thread records into its own histogram, so the threads do not contend
+// on the bucket counters.
+void Measure(int iterations, std::function<Status()> const& rpc,
+             LatencyHistogram& latency, std::int64_t& errors) {
+  for (int i = 0; i < iterations; ++i) {
+    auto const start = std::chrono::steady_clock::now();
+    auto status = rpc();
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+    latency.Record(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+    if (!status.ok()) ++errors;
+  }
+}
+
+}  // namespace
+
+double RpcBenchmarkResult::CpuPerRpc() const {
+  if (rpc_count == 0) return 0;
+  return static_cast<double>(cpu_time.count()) /
+         static_cast<double>(rpc_count);
+}
+
+double RpcBenchmarkResult::AllocationsPerRpc() const {
+  if (rpc_count == 0) return 0;
+  return static_cast<double>(allocations) / static_cast<double>(rpc_count);
+}
+
+std::ostream& operator<<(std::ostream& os, RpcBenchmarkResult const& rhs) {
+  return os << "rpc_count=" << rhs.rpc_count
+            << ", error_count=" << rhs.error_count
+            << ", elapsed=" << rhs.elapsed.count() << "us"
+            << ", cpu_per_rpc=" << rhs.CpuPerRpc() << "us"
+            << ", allocations_per_rpc=" << rhs.AllocationsPerRpc()
+            << ", p50=" << rhs.p50_latency.count() << "us"
+            << ", p90=" << rhs.p90_latency.count() << "us"
+            << ", p99=" << rhs.p99_latency.count() << "us"
+            << ", max=" << rhs.max_latency.count() << "us";
+}
+
+RpcBenchmarkResult RunRpcBenchmark(RpcBenchmarkConfig const& config,
+                                   std::function<Status()> const& rpc) {
+  auto const thread_count = (std::max)(config.thread_count, 1);
+  auto const iterations = (std::max)(config.iterations, 0);
+  // Allocate all the histograms before the measurements start.
+  std::vector<LatencyHistogram> latencies(thread_count);
+  std::vector<std::int64_t> errors(thread_count);
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+
+  // Warm up (e.g. connect the channels) with the same number of threads, but
+  // do not count these RPCs.
+  for (int i = 0; i != thread_count; ++i) {
+    threads.emplace_back(Warmup, config.warmup_iterations, std::cref(rpc));
+  }
+  for (auto& t : threads) t.join();
+  threads.clear();
+
+  auto const start = std::chrono::steady_clock::now();
+  auto const start_usage = CurrentResourceUsage();
+  for (int i = 0; i != thread_count; ++i) {
+    threads.emplace_back(Measure, iterations, std::cref(rpc),
+                         std::ref(latencies[i]), std::ref(errors[i]));
+  }
+  for (auto& t : threads) t.join();
+  auto const usage = CurrentResourceUsage() - start_usage;
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  RpcBenchmarkResult result;
+  result.elapsed =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+  result.cpu_time = usage.cpu_time;
+  result.allocations = usage.allocations;
+  for (auto const& l : latencies) result.latency.Merge(l.Sample());
+  result.rpc_count = result.latency.count();
+  for (auto e : errors) result.error_count += e;
+  result.p50_latency = result.latency.Percentile(50);
+  result.p90_latency = result.latency.Percentile(90);
+  result.p99_latency = result.latency.Percentile(99);
+  result.max_latency = result.latency.Percentile(100);
+  return result;
+}
+
+BenchmarkRecord ToBenchmarkRecord(RpcBenchmarkResult const& result,
+                                  std::string benchmark,
+                                  std::string operation) {
+  BenchmarkRecord record;
+  record.benchmark = std::move(benchmark);
+  record.operation = std::move(operation);
+  record.count = result.rpc_count;
+  record.errors = result.error_count;
+  record.elapsed = result.elapsed;
+  record.usage.cpu_time = result.cpu_time;
+  record.usage.allocations = result.allocations;
+  record.latency = result.latency;
+  return record;
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
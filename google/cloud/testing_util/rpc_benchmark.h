@@ -0,0 +1,92 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_RPC_BENCHMARK_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_RPC_BENCHMARK_H
+
+#include "google/cloud/testing_util/benchmark_record.h"
+#include "google/cloud/testing_util/latency_histogram.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/// Configures `RunRpcBenchmark()`.
+struct RpcBenchmarkConfig {
+  /// The number of threads making RPCs.
+  int thread_count = 1;
+  /// The number of measured RPCs made by each thread.
+  int iterations = 1000;
+  /// The number of RPCs each thread makes before the measurements start.
+  int warmup_iterations = 100;
+};
+
+/**
+ * The results of `RunRpcBenchmark()`.
+ *
+ * The CPU time and allocations are for the whole process. They include the
+ * gRPC threads, and the fake server when it runs in the same process. Compare
+ * results from the same server configuration to isolate changes in the client
+ * library.
+ */
+struct RpcBenchmarkResult {
+  std::int64_t rpc_count = 0;
+  std::int64_t error_count = 0;
+  std::chrono::microseconds elapsed{0};
+  std::chrono::microseconds cpu_time{0};
+  std::int64_t allocations = 0;
+  std::chrono::microseconds p50_latency{0};
+  std::chrono::microseconds p90_latency{0};
+  std::chrono::microseconds p99_latency{0};
+  std::chrono::microseconds max_latency{0};
+  /// The latency of all the RPCs, merged from the histograms in each thread.
+  LatencyHistogram::Snapshot latency;
+
+  /// The CPU time, in microseconds, per RPC.
+  double CpuPerRpc() const;
+  /// The number of allocations per RPC.
+  double AllocationsPerRpc() const;
+};
+
+std::ostream& operator<<(std::ostream& os, RpcBenchmarkResult const& rhs);
+
+/// Converts @p result to the format shared by all the benchmarks.
+BenchmarkRecord ToBenchmarkRecord(RpcBenchmarkResult const& result,
+                                  std::string benchmark,
+                                  std::string operation);
+
+/**
+ * Calls @p rpc repeatedly, from several threads, and measures each call.
+ *
+ * @p rpc is called concurrently, it must be thread-safe. Each call is counted
+ * as one RPC, and as an error if it returns a non-OK status.
+ */
+RpcBenchmarkResult RunRpcBenchmark(RpcBenchmarkConfig const& config,
+                                   std::function<Status()> const& rpc);
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_RPC_BENCHMARK_H
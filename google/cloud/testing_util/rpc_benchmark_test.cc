@@ -0,0 +1,108 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/testing_util/rpc_benchmark.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <memory>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(RpcBenchmark, CountsRpcsAndErrors) {
+  std::atomic<int> calls{0};
+  RpcBenchmarkConfig config;
+  config.thread_count = 4;
+  config.iterations = 100;
+  config.warmup_iterations = 10;
+  auto result = RunRpcBenchmark(config, [&calls] {
+    if (++calls % 4 == 0) return Status(StatusCode::kUnavailable, "try-again");
+    return Status{};
+  });
+  EXPECT_EQ(4 * 110, calls.load());
+  EXPECT_EQ(400, result.rpc_count);
+  // The warmup RPCs are not counted, so the exact number of errors depends on
+  // the interleaving of the threads.
+  EXPECT_GT(result.error_count, 0);
+  EXPECT_LE(result.p50_latency, result.p90_latency);
+  EXPECT_LE(result.p90_latency, result.p99_latency);
+  EXPECT_LE(result.p99_latency, result.max_latency);
+}
+
+TEST(RpcBenchmark, MergesThreadLatencies) {
+  RpcBenchmarkConfig config;
+  config.thread_count = 3;
+  config.iterations = 20;
+  config.warmup_iterations = 0;
+  auto result = RunRpcBenchmark(config, [] { return Status{}; });
+  EXPECT_EQ(60, result.rpc_count);
+  EXPECT_EQ(60, result.latency.count());
+  EXPECT_EQ(result.latency.Percentile(100), result.max_latency);
+
+  auto const record = ToBenchmarkRecord(result, "common/rpc", "Noop");
+  EXPECT_EQ("common/rpc", record.benchmark);
+  EXPECT_EQ("Noop", record.operation);
+  EXPECT_EQ(60, record.count);
+  EXPECT_EQ(60, record.latency.count());
+  EXPECT_EQ(result.allocations, record.usage.allocations);
+}
+
+TEST(RpcBenchmark, CountsAllocations) {
+  RpcBenchmarkConfig config;
+  config.iterations = 10;
+  config.warmup_iterations = 0;
+  auto result = RunRpcBenchmark(config, [] {
+    auto p = std::make_shared<int>(42);
+    return *p == 42 ? Status{} : Status(StatusCode::kInternal, "bad");
+  });
+  EXPECT_EQ(10, result.rpc_count);
+  EXPECT_EQ(0, result.error_count);
+  EXPECT_GE(result.allocations, 10);
+  EXPECT_GE(result.AllocationsPerRpc(), 1.0);
+}
+
+TEST(RpcBenchmark, Empty) {
+  RpcBenchmarkConfig config;
+  config.iterations = 0;
+  config.warmup_iterations = 0;
+  auto result = RunRpcBenchmark(config, [] { return Status{}; });
+  EXPECT_EQ(0, result.rpc_count);
+  EXPECT_EQ(0, result.CpuPerRpc());
+  EXPECT_EQ(0, result.AllocationsPerRpc());
+}
+
+TEST(RpcBenchmark, Print) {
+  RpcBenchmarkResult result;
+  result.rpc_count = 10;
+  result.allocations = 50;
+  result.cpu_time = std::chrono::microseconds(200);
+  std::ostringstream os;
+  os << result;
+  EXPECT_THAT(os.str(), HasSubstr("rpc_count=10"));
+  EXPECT_THAT(os.str(), HasSubstr("allocations_per_rpc=5"));
+  EXPECT_THAT(os.str(), HasSubstr("cpu_per_rpc=20us"));
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -133,8 +133,9 @@ StatusOr<std::map<std::string, std::string> > ExtractMDFromHeader(
 StatusOr<std::map<std::string, std::string> > ExtractMDFromHeaders(
     std::multimap<std::string, std::string> const& headers) {
   auto param_header = headers.equal_range("x-goog-request-params");
+  // Methods without routing parameters do not send the header.
   if (param_header.first == param_header.second) {
-    return Status(StatusCode::kInvalidArgument, "Expected header not found");
+    return std::map<std::string, std::string>{};
   }
   if (std::distance(param_header.first, param_header.second) > 1U) {
     return Status(StatusCode::kInvalidArgument, "Multiple headers found");